@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <common/benchmark.hpp>
+
+#include <raft/cluster/kmeans.cuh>
+#include <raft/random/make_blobs.hpp>
+
+#include <rmm/device_uvector.hpp>
+
+#include <vector>
+
+namespace raft::bench::cluster {
+
+struct kmeans_inputs {
+  int n, d, k;
+};  // struct kmeans_inputs
+
+/**
+ * Benchmarks a full k-means fit (k-means++ init plus Lloyd iterations until
+ * convergence, including the final assignment). Beside the time, the number
+ * of iterations to converge and the final residual (inertia) are reported as
+ * counters, so a speedup that degrades convergence quality is visible in the
+ * same output.
+ */
+template <typename T>
+struct kmeans : public fixture {
+  kmeans(const kmeans_inputs& p)
+    : params(p), data(size_t(p.n) * p.d, stream), labels(p.n, stream), codes(p.n, stream)
+  {
+    // row-major n x d blobs are column-major d x n observations, which is the
+    // layout the solver expects
+    raft::random::make_blobs(data.data(), labels.data(), params.n, params.d, params.k, stream);
+  }
+
+  void run_benchmark(::benchmark::State& state) override
+  {
+    T residual = 0;
+    int iters  = 0;
+    double total_iters = 0;
+    loop_on_state(state, [&]() {
+      raft::cluster::kmeans(handle,
+                            params.n,
+                            params.d,
+                            params.k,
+                            (T)1e-4,
+                            300,
+                            data.data(),
+                            codes.data(),
+                            residual,
+                            iters);
+      total_iters += iters;
+    });
+    state.counters["iterations"] =
+      ::benchmark::Counter(total_iters, ::benchmark::Counter::kAvgIterations);
+    state.counters["inertia"] = ::benchmark::Counter(static_cast<double>(residual));
+  }
+
+ private:
+  kmeans_inputs params;
+  rmm::device_uvector<T> data;
+  rmm::device_uvector<int> labels;
+  rmm::device_uvector<int> codes;
+};  // struct kmeans
+
+static std::vector<kmeans_inputs> get_kmeans_input_vecs()
+{
+  std::vector<kmeans_inputs> out;
+  for (auto n : std::vector<int>{10000, 100000, 1000000}) {
+    for (auto d : std::vector<int>{8, 64}) {
+      for (auto k : std::vector<int>{10, 100, 1000}) {
+        out.push_back({n, d, k});
+      }
+    }
+  }
+  return out;
+}
+
+RAFT_BENCH_REGISTER(kmeans<float>, "", get_kmeans_input_vecs());
+RAFT_BENCH_REGISTER(kmeans<double>, "", get_kmeans_input_vecs());
+
+}  // namespace raft::bench::cluster
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <common/benchmark.hpp>
+
+#include <raft/random/make_blobs.hpp>
+#include <raft/sparse/hierarchy/single_linkage.cuh>
+
+#include <rmm/device_uvector.hpp>
+
+#include <vector>
+
+namespace raft::bench::cluster {
+
+struct single_linkage_inputs {
+  int n, d, n_clusters;
+};  // struct single_linkage_inputs
+
+template <raft::hierarchy::LinkageDistance dist_type>
+struct single_linkage : public fixture {
+  single_linkage(const single_linkage_inputs& p)
+    : params(p),
+      data(size_t(p.n) * p.d, stream),
+      blob_labels(p.n, stream),
+      labels(p.n, stream),
+      children(2 * (size_t(p.n) - 1), stream)
+  {
+    raft::random::make_blobs(
+      data.data(), blob_labels.data(), params.n, params.d, params.n_clusters, stream);
+  }
+
+  void run_benchmark(::benchmark::State& state) override
+  {
+    raft::hierarchy::linkage_output<int, float> out;
+    out.labels   = labels.data();
+    out.children = children.data();
+    loop_on_state(state, [&]() {
+      raft::hierarchy::single_linkage<int, float, dist_type>(
+        handle,
+        data.data(),
+        (size_t)params.n,
+        (size_t)params.d,
+        raft::distance::DistanceType::L2SqrtExpanded,
+        &out,
+        15,
+        (size_t)params.n_clusters);
+    });
+    // a dendrogram stitched together from an unconnected knn graph is a
+    // quality hazard, surface how many components had to be connected
+    state.counters["n_components"] =
+      ::benchmark::Counter(static_cast<double>(out.n_connected_components));
+  }
+
+ private:
+  single_linkage_inputs params;
+  rmm::device_uvector<float> data;
+  rmm::device_uvector<int> blob_labels;
+  rmm::device_uvector<int> labels;
+  rmm::device_uvector<int> children;
+};  // struct single_linkage
+
+const std::vector<single_linkage_inputs> single_linkage_input_vecs{
+  {1000, 8, 10},
+  {1000, 64, 10},
+  {10000, 8, 10},
+  {10000, 64, 10},
+  {10000, 8, 100},
+  {50000, 8, 10},
+};
+
+using single_linkage_knn      = single_linkage<raft::hierarchy::LinkageDistance::KNN_GRAPH>;
+using single_linkage_pairwise = single_linkage<raft::hierarchy::LinkageDistance::PAIRWISE>;
+
+RAFT_BENCH_REGISTER(single_linkage_knn, "", single_linkage_input_vecs);
+RAFT_BENCH_REGISTER(single_linkage_pairwise, "", single_linkage_input_vecs);
+
+}  // namespace raft::bench::cluster
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/core/error.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace raft::bench {
+
+/**
+ * Readers for the fbin/ibin formats used by the billion-scale ANN
+ * benchmark datasets: a header of two uint32 values (number of rows,
+ * dimensionality) followed by the row-major payload (float32 for fbin,
+ * int32 for ibin). Loads are chunked, so multi-GB base sets stream
+ * through a bounded buffer instead of requiring one giant read.
+ */
+struct bin_header {
+  uint32_t n_rows;
+  uint32_t dim;
+};
+
+inline auto read_bin_header(const std::string& path) -> bin_header
+{
+  std::FILE* f = std::fopen(path.c_str(), "rb");
+  RAFT_EXPECTS(f != nullptr, "ann_dataset: failed to open '%s'", path.c_str());
+  bin_header h;
+  auto ok = std::fread(&h, sizeof(bin_header), 1, f) == 1;
+  std::fclose(f);
+  RAFT_EXPECTS(ok, "ann_dataset: failed to read header of '%s'", path.c_str());
+  return h;
+}
+
+/**
+ * Reads `n_rows` rows starting at `row_offset` into `dst`, streaming in
+ * chunks of at most `chunk_bytes`.
+ */
+template <typename T>
+void read_bin_rows(const std::string& path,
+                   size_t row_offset,
+                   size_t n_rows,
+                   size_t dim,
+                   T* dst,
+                   size_t chunk_bytes = size_t(64) << 20)
+{
+  std::FILE* f = std::fopen(path.c_str(), "rb");
+  RAFT_EXPECTS(f != nullptr, "ann_dataset: failed to open '%s'", path.c_str());
+
+  size_t total_bytes = n_rows * dim * sizeof(T);
+  size_t offset      = sizeof(bin_header) + row_offset * dim * sizeof(T);
+  bool seek_ok       = std::fseek(f, long(offset), SEEK_SET) == 0;
+  auto* out          = reinterpret_cast<char*>(dst);
+  size_t done        = 0;
+  while (seek_ok && done < total_bytes) {
+    size_t todo = std::min(chunk_bytes, total_bytes - done);
+    if (std::fread(out + done, 1, todo, f) != todo) { break; }
+    done += todo;
+  }
+  std::fclose(f);
+  RAFT_EXPECTS(seek_ok && done == total_bytes,
+               "ann_dataset: short read from '%s' (%zu of %zu bytes)",
+               path.c_str(),
+               done,
+               total_bytes);
+}
+
+/** Reads a whole fbin/ibin file; the header is returned through `h`. */
+template <typename T>
+auto read_bin(const std::string& path, bin_header& h) -> std::vector<T>
+{
+  h = read_bin_header(path);
+  std::vector<T> data(size_t(h.n_rows) * h.dim);
+  read_bin_rows(path, 0, h.n_rows, h.dim, data.data());
+  return data;
+}
+
+/**
+ * Paths of an on-disk ANN dataset, taken from the environment:
+ * RAFT_BENCH_ANN_BASE (fbin), RAFT_BENCH_ANN_QUERIES (fbin) and
+ * optionally RAFT_BENCH_ANN_GT (ibin ground truth, one row of neighbor
+ * ids per query). When the base/query variables are unset the
+ * benchmarks keep generating random data.
+ */
+struct ann_dataset_paths {
+  std::string base;
+  std::string queries;
+  std::string ground_truth;
+
+  [[nodiscard]] auto enabled() const -> bool { return !base.empty() && !queries.empty(); }
+  [[nodiscard]] auto has_ground_truth() const -> bool { return !ground_truth.empty(); }
+
+  static auto from_env() -> ann_dataset_paths
+  {
+    auto get = [](const char* name) -> std::string {
+      const char* v = std::getenv(name);
+      return v == nullptr ? std::string{} : std::string{v};
+    };
+    ann_dataset_paths p;
+    p.base         = get("RAFT_BENCH_ANN_BASE");
+    p.queries      = get("RAFT_BENCH_ANN_QUERIES");
+    p.ground_truth = get("RAFT_BENCH_ANN_GT");
+    return p;
+  }
+};
+
+/**
+ * recall@k of the returned ids against an fbin/ibin ground truth: the
+ * fraction of the true k nearest neighbors found, averaged over queries.
+ * The ground truth may store more than k neighbors per query; only the
+ * first k count.
+ */
+template <typename IdxT>
+auto calc_recall(const std::vector<IdxT>& found,
+                 const std::vector<int32_t>& gt,
+                 size_t n_queries,
+                 size_t gt_dim,
+                 size_t k) -> double
+{
+  size_t hits = 0;
+  for (size_t q = 0; q < n_queries; q++) {
+    for (size_t i = 0; i < k; i++) {
+      auto id = int64_t(found[q * k + i]);
+      for (size_t j = 0; j < k; j++) {
+        if (int64_t(gt[q * gt_dim + j]) == id) {
+          hits++;
+          break;
+        }
+      }
+    }
+  }
+  return double(hits) / double(n_queries * k);
+}
+
+}  // namespace raft::bench
@@ -17,6 +17,9 @@
 #pragma once
 
 #include <memory>
+#include <sstream>
+#include <string>
+#include <type_traits>
 
 #include <raft/core/handle.hpp>
 #include <raft/cudart_utils.h>
@@ -29,6 +32,11 @@
 #include <rmm/device_buffer.hpp>
 #include <rmm/mr/device/per_device_resource.hpp>
 #include <rmm/mr/device/pool_memory_resource.hpp>
+#include <rmm/mr/device/statistics_resource_adaptor.hpp>
+
+#ifdef RAFT_BENCH_USE_CUPTI
+#include <common/cupti_breakdown.hpp>
+#endif
 
 namespace raft::bench {
 
@@ -57,6 +65,35 @@ struct using_pool_memory_res {
   ~using_pool_memory_res() { rmm::mr::set_current_device_resource(orig_res_); }
 };
 
+/**
+ * RAII way to route all rmm allocations through a statistics adaptor, so that
+ * the peak and total device memory usage of a benchmark can be reported.
+ * The adaptor wraps whatever resource is current (e.g. the pool set up by
+ * using_pool_memory_res), so only allocation bookkeeping is added, not a
+ * different allocator.
+ */
+struct using_memory_stats {
+ private:
+  rmm::mr::device_memory_resource* orig_res_;
+  rmm::mr::statistics_resource_adaptor<rmm::mr::device_memory_resource> stats_res_;
+
+ public:
+  using_memory_stats()
+    : orig_res_(rmm::mr::get_current_device_resource()), stats_res_(orig_res_)
+  {
+    rmm::mr::set_current_device_resource(&stats_res_);
+  }
+
+  ~using_memory_stats() { rmm::mr::set_current_device_resource(orig_res_); }
+
+  /** Peak number of bytes allocated at any point while the guard was active. */
+  std::size_t peak_bytes() const { return stats_res_.get_bytes_counter().peak; }
+  /** Sum of all allocation sizes while the guard was active. */
+  std::size_t total_bytes() const { return stats_res_.get_bytes_counter().total; }
+  /** Number of allocations made while the guard was active. */
+  std::size_t num_allocations() const { return stats_res_.get_allocations_counter().total; }
+};
+
 /**
  * RAII way of timing cuda calls. This has been shamelessly copied from the
  * cudf codebase via cuml codebase. So, credits for this class goes to cudf developers.
@@ -67,14 +104,17 @@ struct cuda_event_timer {
   rmm::cuda_stream_view stream_;
   cudaEvent_t start_;
   cudaEvent_t stop_;
+  double* elapsed_seconds_;
 
  public:
   /**
    * @param state  the benchmark::State whose timer we are going to update.
    * @param stream CUDA stream we are measuring time on.
    */
-  cuda_event_timer(::benchmark::State& state, rmm::cuda_stream_view stream)
-    : state_(&state), stream_(stream)
+  cuda_event_timer(::benchmark::State& state,
+                   rmm::cuda_stream_view stream,
+                   double* elapsed_seconds = nullptr)
+    : state_(&state), stream_(stream), elapsed_seconds_(elapsed_seconds)
   {
     RAFT_CUDA_TRY(cudaEventCreate(&start_));
     RAFT_CUDA_TRY(cudaEventCreate(&stop_));
@@ -95,11 +135,67 @@ struct cuda_event_timer {
     float milliseconds = 0.0f;
     RAFT_CUDA_TRY_NO_THROW(cudaEventElapsedTime(&milliseconds, start_, stop_));
     state_->SetIterationTime(milliseconds / 1000.f);
+    if (elapsed_seconds_ != nullptr) { *elapsed_seconds_ += milliseconds / 1000.0; }
     RAFT_CUDA_TRY_NO_THROW(cudaEventDestroy(start_));
     RAFT_CUDA_TRY_NO_THROW(cudaEventDestroy(stop_));
   }
 };
 
+/** Theoretical peak memory bandwidth and FP32 throughput of a device. */
+struct device_roofline {
+  double peak_bandwidth;  // bytes / s
+  double peak_flops;      // FP32 FLOP / s
+};
+
+/** FP32 CUDA cores per SM for a given compute capability. */
+inline int fp32_cores_per_sm(int major, int minor)
+{
+  switch (major * 10 + minor) {
+    case 30:
+    case 32:
+    case 35:
+    case 37: return 192;
+    case 50:
+    case 52:
+    case 53: return 128;
+    case 60: return 64;
+    case 61:
+    case 62: return 128;
+    case 70:
+    case 72:
+    case 75: return 64;
+    case 80: return 64;
+    case 86:
+    case 87:
+    case 89: return 128;
+    case 90: return 128;
+    default: return 64;  // conservative guess for unknown arches
+  }
+}
+
+/**
+ * Peak bandwidth/FLOPs of the current device, queried once per process.
+ * Bandwidth assumes double data rate memory; FLOPs count one FMA as two.
+ */
+inline const device_roofline& get_device_roofline()
+{
+  static const device_roofline roofline = []() {
+    int dev, mem_clock_khz, bus_width_bits, sm_clock_khz, n_sms, major, minor;
+    RAFT_CUDA_TRY(cudaGetDevice(&dev));
+    RAFT_CUDA_TRY(cudaDeviceGetAttribute(&mem_clock_khz, cudaDevAttrMemoryClockRate, dev));
+    RAFT_CUDA_TRY(cudaDeviceGetAttribute(&bus_width_bits, cudaDevAttrGlobalMemoryBusWidth, dev));
+    RAFT_CUDA_TRY(cudaDeviceGetAttribute(&sm_clock_khz, cudaDevAttrClockRate, dev));
+    RAFT_CUDA_TRY(cudaDeviceGetAttribute(&n_sms, cudaDevAttrMultiProcessorCount, dev));
+    RAFT_CUDA_TRY(cudaDeviceGetAttribute(&major, cudaDevAttrComputeCapabilityMajor, dev));
+    RAFT_CUDA_TRY(cudaDeviceGetAttribute(&minor, cudaDevAttrComputeCapabilityMinor, dev));
+    device_roofline r;
+    r.peak_bandwidth = 2.0 * (mem_clock_khz * 1000.0) * (bus_width_bits / 8.0);
+    r.peak_flops = 2.0 * (sm_clock_khz * 1000.0) * n_sms * fp32_cores_per_sm(major, minor);
+    return r;
+  }();
+  return roofline;
+}
+
 /** Main fixture to be inherited and used by all other c++ benchmarks */
 class fixture {
  private:
@@ -122,6 +218,18 @@ class fixture {
   virtual void run_benchmark(::benchmark::State& state) = 0;
   virtual void generate_metrics(::benchmark::State& state) {}
 
+  /**
+   * @brief Declares how many bytes one iteration moves to/from device memory.
+   *
+   * When set (typically in the benchmark's constructor), `loop_on_state`
+   * emits the attained bandwidth and its percentage of the device peak as
+   * counters, so results read as %-of-roofline instead of raw time.
+   */
+  void declare_iteration_bytes(double bytes) { iteration_bytes_ = bytes; }
+
+  /** @brief Same as `declare_iteration_bytes` for FP32 FLOPs per iteration. */
+  void declare_iteration_flops(double flops) { iteration_flops_ = flops; }
+
  protected:
   /** The helper that writes zeroes to some buffer in GPU memory to flush the L2 cache.  */
   void flush_L2_cache()
@@ -133,15 +241,63 @@ class fixture {
    * The helper to be used inside `run_benchmark`, to loop over the state and record time using the
    * cuda_event_timer.
    */
+  /**
+   * The helper to be used inside `run_benchmark`, to loop over the state and record time using the
+   * cuda_event_timer. Beside the time, the peak and per-iteration device memory usage of
+   * `benchmark_func` are reported as counters. If the benchmarks are built with CUPTI support
+   * (RAFT_BENCH_USE_CUPTI) and RAFT_BENCH_KERNEL_BREAKDOWN is set in the environment, a
+   * per-kernel device time breakdown is emitted as counters as well.
+   */
   template <typename Lambda>
   void loop_on_state(::benchmark::State& state, Lambda benchmark_func, bool flush_L2 = true)
   {
+    using_memory_stats mem_stats;
+#ifdef RAFT_BENCH_USE_CUPTI
+    bool breakdown = kernel_breakdown::requested();
+    if (breakdown) { kernel_breakdown::instance().start(); }
+#endif
+    double gpu_seconds = 0.0;
     for (auto _ : state) {
       if (flush_L2) { flush_L2_cache(); }
-      cuda_event_timer timer(state, stream);
+      cuda_event_timer timer(state, stream, &gpu_seconds);
       benchmark_func();
     }
+#ifdef RAFT_BENCH_USE_CUPTI
+    if (breakdown) { kernel_breakdown::instance().stop_and_report(state); }
+#endif
+    state.counters["dev_mem_peak"] =
+      ::benchmark::Counter(static_cast<double>(mem_stats.peak_bytes()),
+                           ::benchmark::Counter::kDefaults,
+                           ::benchmark::Counter::OneK::kIs1024);
+    state.counters["dev_mem_per_it"] =
+      ::benchmark::Counter(static_cast<double>(mem_stats.total_bytes()),
+                           ::benchmark::Counter::kAvgIterations,
+                           ::benchmark::Counter::OneK::kIs1024);
+    state.counters["dev_allocs_per_it"] = ::benchmark::Counter(
+      static_cast<double>(mem_stats.num_allocations()), ::benchmark::Counter::kAvgIterations);
+
+    if (gpu_seconds > 0.0) {
+      const auto& roofline = get_device_roofline();
+      if (iteration_bytes_ > 0.0) {
+        double bw = iteration_bytes_ * state.iterations() / gpu_seconds;
+        state.counters["mem_bw"] = ::benchmark::Counter(
+          bw, ::benchmark::Counter::kDefaults, ::benchmark::Counter::OneK::kIs1000);
+        state.counters["mem_bw_pct_peak"] =
+          ::benchmark::Counter(100.0 * bw / roofline.peak_bandwidth);
+      }
+      if (iteration_flops_ > 0.0) {
+        double flops = iteration_flops_ * state.iterations() / gpu_seconds;
+        state.counters["flops"] = ::benchmark::Counter(
+          flops, ::benchmark::Counter::kDefaults, ::benchmark::Counter::OneK::kIs1000);
+        state.counters["flops_pct_peak"] =
+          ::benchmark::Counter(100.0 * flops / roofline.peak_flops);
+      }
+    }
   }
+
+ private:
+  double iteration_bytes_ = 0.0;
+  double iteration_flops_ = 0.0;
 };
 
 namespace internal {
@@ -180,6 +336,33 @@ class Fixture : public ::benchmark::Fixture {
   }
 };  // class Fixture
 
+template <typename T, typename = void>
+struct is_streamable : std::false_type {
+};
+template <typename T>
+struct is_streamable<T, std::void_t<decltype(std::declval<std::ostream&>() << std::declval<T>())>>
+  : std::true_type {
+};
+
+/**
+ * The name of a parameter in the benchmark case name: the value itself if the
+ * parameter type defines operator<<, its position in the input vector
+ * otherwise. Embedding values makes the JSON results self-describing, which
+ * the result comparison tooling (scripts/compare_benchmarks.py) relies on
+ * when matching cases across builds.
+ */
+template <typename T>
+std::string param_name(int i, const T& param)
+{
+  if constexpr (is_streamable<T>::value) {
+    std::stringstream ss;
+    ss << param;
+    return ss.str();
+  } else {
+    return std::to_string(i);
+  }
+}
+
 /**
  * A helper struct to create a fixture for every combination of input vectors.
  * Use with care, this can blow up quickly!
@@ -215,7 +398,7 @@ struct cartesian_registrar<Class, Param, Params...> {
     int param_len = param.size();
     for (int i = 0; i < param_len; i++) {
       cartesian_registrar<Class, Params...>::run(
-        case_name + "/" + std::to_string(i), params..., fixed..., param[i]);
+        case_name + "/" + param_name(i, param[i]), params..., fixed..., param[i]);
     }
   }
 };
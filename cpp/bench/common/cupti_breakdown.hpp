@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <cupti.h>
+
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+namespace raft::bench {
+
+#define RAFT_CUPTI_TRY(call)                                               \
+  do {                                                                     \
+    CUptiResult status__ = call;                                           \
+    if (status__ != CUPTI_SUCCESS) {                                       \
+      const char* err__ = nullptr;                                         \
+      cuptiGetResultString(status__, &err__);                              \
+      throw std::runtime_error(std::string("CUPTI call failed: ") +        \
+                               (err__ != nullptr ? err__ : "unknown"));    \
+    }                                                                      \
+  } while (0)
+
+/**
+ * Per-kernel device time collector based on the CUPTI activity API.
+ *
+ * While collection is active, the total device time of every kernel launched
+ * by the process is accumulated under the kernel's (mangled) name. The
+ * fixture drains the totals into benchmark counters after the measurement
+ * loop, so each benchmark case gets a "kern:<name>" counter per kernel with
+ * the average device milliseconds per iteration.
+ *
+ * CUPTI buffers activity records process-wide, therefore only one collector
+ * may be active at a time; the fixture runs benchmarks sequentially so this
+ * is not a limitation in practice.
+ */
+class kernel_breakdown {
+ public:
+  static kernel_breakdown& instance()
+  {
+    static kernel_breakdown inst;
+    return inst;
+  }
+
+  /** Collection is opt-in via the RAFT_BENCH_KERNEL_BREAKDOWN env var. */
+  static bool requested()
+  {
+    const char* env = std::getenv("RAFT_BENCH_KERNEL_BREAKDOWN");
+    return env != nullptr && env[0] != '0';
+  }
+
+  void start()
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    kernel_ns_.clear();
+    if (!registered_) {
+      RAFT_CUPTI_TRY(cuptiActivityRegisterCallbacks(buffer_requested, buffer_completed));
+      registered_ = true;
+    }
+    RAFT_CUPTI_TRY(cuptiActivityEnable(CUPTI_ACTIVITY_KIND_CONCURRENT_KERNEL));
+  }
+
+  /** Flush the collected records and emit one counter per kernel name. */
+  void stop_and_report(::benchmark::State& state)
+  {
+    RAFT_CUPTI_TRY(cuptiActivityDisable(CUPTI_ACTIVITY_KIND_CONCURRENT_KERNEL));
+    RAFT_CUPTI_TRY(cuptiActivityFlushAll(0));
+    std::lock_guard<std::mutex> guard(mutex_);
+    double iters = static_cast<double>(state.iterations());
+    for (const auto& kv : kernel_ns_) {
+      // mangled names can be very long; keep enough to identify the kernel
+      std::string name = kv.first.substr(0, 64);
+      state.counters["kern:" + name] =
+        ::benchmark::Counter(kv.second * 1e-6 / iters);  // ns -> ms per iteration
+    }
+  }
+
+ private:
+  kernel_breakdown() = default;
+
+  static void CUPTIAPI buffer_requested(uint8_t** buffer, size_t* size, size_t* max_num_records)
+  {
+    *size            = buf_size;
+    *buffer          = static_cast<uint8_t*>(std::malloc(buf_size));
+    *max_num_records = 0;
+  }
+
+  static void CUPTIAPI buffer_completed(
+    CUcontext, uint32_t, uint8_t* buffer, size_t /* size */, size_t valid_size)
+  {
+    auto& self              = instance();
+    CUpti_Activity* record  = nullptr;
+    std::lock_guard<std::mutex> guard(self.mutex_);
+    while (cuptiActivityGetNextRecord(buffer, valid_size, &record) == CUPTI_SUCCESS) {
+      if (record->kind == CUPTI_ACTIVITY_KIND_CONCURRENT_KERNEL ||
+          record->kind == CUPTI_ACTIVITY_KIND_KERNEL) {
+        auto* k = reinterpret_cast<CUpti_ActivityKernel4*>(record);
+        self.kernel_ns_[k->name] += static_cast<double>(k->end - k->start);
+      }
+    }
+    std::free(buffer);
+  }
+
+  static constexpr size_t buf_size = 1 << 20;
+
+  std::map<std::string, double> kernel_ns_;
+  std::mutex mutex_;
+  bool registered_ = false;
+};
+
+}  // namespace raft::bench
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "comms_fixture.hpp"
+
+#include <rmm/device_uvector.hpp>
+
+namespace raft::bench::comms {
+
+struct allgather : public comms_fixture {
+  allgather(const comms_inputs& p) : params(p), in(p.count, stream), out(0, stream)
+  {
+    out.resize(p.count * handle.get_comms().get_size(), stream);
+  }
+
+  void run_benchmark(::benchmark::State& state) override
+  {
+    auto const& communicator = handle.get_comms();
+    loop_on_comms_state(state, [this, &communicator]() {
+      communicator.allgather(in.data(), out.data(), params.count, stream);
+    });
+  }
+
+  void generate_metrics(::benchmark::State& state) override
+  {
+    double n     = handle.get_comms().get_size();
+    double bytes = params.count * sizeof(float) * n;
+    // ring allgather moves (n-1)/n of the gathered message over the bus
+    set_bandwidth_counters(state, bytes, bytes * (n - 1.0) / n);
+  }
+
+ private:
+  comms_inputs params;
+  rmm::device_uvector<float> in, out;
+};  // struct allgather
+
+RAFT_BENCH_REGISTER(allgather, "", comms_input_vecs);
+
+}  // namespace raft::bench::comms
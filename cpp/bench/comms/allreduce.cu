@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "comms_fixture.hpp"
+
+#include <rmm/device_uvector.hpp>
+
+namespace raft::bench::comms {
+
+struct allreduce : public comms_fixture {
+  allreduce(const comms_inputs& p) : params(p), in(p.count, stream), out(p.count, stream) {}
+
+  void run_benchmark(::benchmark::State& state) override
+  {
+    auto const& communicator = handle.get_comms();
+    loop_on_comms_state(state, [this, &communicator]() {
+      communicator.allreduce(
+        in.data(), out.data(), params.count, raft::comms::op_t::SUM, stream);
+    });
+  }
+
+  void generate_metrics(::benchmark::State& state) override
+  {
+    double n     = handle.get_comms().get_size();
+    double bytes = params.count * sizeof(float);
+    // ring allreduce moves 2(n-1)/n of the message over the bus
+    set_bandwidth_counters(state, bytes, bytes * 2.0 * (n - 1.0) / n);
+  }
+
+ private:
+  comms_inputs params;
+  rmm::device_uvector<float> in, out;
+};  // struct allreduce
+
+RAFT_BENCH_REGISTER(allreduce, "", comms_input_vecs);
+
+}  // namespace raft::bench::comms
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <common/benchmark.hpp>
+#include <raft/comms/mpi_comms.hpp>
+
+#include <mpi.h>
+
+namespace raft::bench::comms {
+
+/** Message sizes swept by all comms benchmarks, in elements. */
+struct comms_inputs {
+  size_t count;
+};  // struct comms_inputs
+
+inline const std::vector<comms_inputs> comms_input_vecs{
+  {1024}, {16 * 1024}, {256 * 1024}, {4 * 1024 * 1024}, {64 * 1024 * 1024}};
+
+/**
+ * Fixture for comms benchmarks: injects a communicator over
+ * MPI_COMM_WORLD into the handle, so the suite is runnable under mpirun
+ * with one rank per GPU (the device is selected in main). Only rank 0
+ * reports; latencies are device times of the local rank.
+ */
+class comms_fixture : public fixture {
+ public:
+  comms_fixture() { raft::comms::initialize_mpi_comms(&handle, MPI_COMM_WORLD); }
+
+ protected:
+  /**
+   * Like loop_on_state, but synchronizes the clique before every timed
+   * iteration so rank skew is not attributed to the measured operation.
+   */
+  template <typename Lambda>
+  void loop_on_comms_state(::benchmark::State& state, Lambda benchmark_func)
+  {
+    auto const& communicator = handle.get_comms();
+    for (auto _ : state) {
+      communicator.barrier();
+      cuda_event_timer timer(state, stream);
+      benchmark_func();
+    }
+  }
+
+  /**
+   * Reports the per-rank message size and the bus bandwidth; callers
+   * pass the bytes actually moved over the bus per iteration, i.e. the
+   * message size corrected by the algorithm factor of the collective
+   * (e.g. 2(n-1)/n for ring allreduce).
+   */
+  void set_bandwidth_counters(::benchmark::State& state, double msg_bytes, double bus_bytes)
+  {
+    state.counters["msg_bytes"] = ::benchmark::Counter(msg_bytes);
+    state.counters["bus_bw"] =
+      ::benchmark::Counter(bus_bytes, ::benchmark::Counter::kIsIterationInvariantRate);
+  }
+};  // class comms_fixture
+
+}  // namespace raft::bench::comms
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>  // NOLINT
+
+#include <cuda_runtime.h>
+#include <mpi.h>
+
+namespace {
+
+/** All ranks run every benchmark, but only rank 0 reports. */
+class null_reporter : public ::benchmark::BenchmarkReporter {
+ public:
+  bool ReportContext(const Context&) override { return true; }
+  void ReportRuns(const std::vector<Run>&) override {}
+  void Finalize() override {}
+};
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  MPI_Init(&argc, &argv);
+
+  // one GPU per rank: select by rank within the node
+  MPI_Comm local_comm;
+  MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &local_comm);
+  int local_rank = 0;
+  MPI_Comm_rank(local_comm, &local_rank);
+  MPI_Comm_free(&local_comm);
+
+  int n_devices = 0;
+  cudaGetDeviceCount(&n_devices);
+  cudaSetDevice(local_rank % n_devices);
+
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  ::benchmark::Initialize(&argc, argv);
+  if (rank == 0) {
+    ::benchmark::RunSpecifiedBenchmarks();
+  } else {
+    null_reporter reporter;
+    ::benchmark::RunSpecifiedBenchmarks(&reporter);
+  }
+
+  MPI_Finalize();
+  return 0;
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "comms_fixture.hpp"
+
+#include <rmm/device_uvector.hpp>
+
+namespace raft::bench::comms {
+
+/** Ring exchange: every rank sends to the next and receives from the previous. */
+struct sendrecv : public comms_fixture {
+  sendrecv(const comms_inputs& p) : params(p), in(p.count, stream), out(p.count, stream) {}
+
+  void run_benchmark(::benchmark::State& state) override
+  {
+    auto const& communicator = handle.get_comms();
+    int const size           = communicator.get_size();
+    int const next           = (communicator.get_rank() + 1) % size;
+    int const prev           = (communicator.get_rank() + size - 1) % size;
+    loop_on_comms_state(state, [this, &communicator, next, prev]() {
+      communicator.device_sendrecv(
+        in.data(), params.count, next, out.data(), params.count, prev, stream);
+    });
+  }
+
+  void generate_metrics(::benchmark::State& state) override
+  {
+    double bytes = params.count * sizeof(float);
+    set_bandwidth_counters(state, bytes, bytes);
+  }
+
+ private:
+  comms_inputs params;
+  rmm::device_uvector<float> in, out;
+};  // struct sendrecv
+
+RAFT_BENCH_REGISTER(sendrecv, "", comms_input_vecs);
+
+}  // namespace raft::bench::comms
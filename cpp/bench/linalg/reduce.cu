@@ -31,6 +31,10 @@ struct reduce : public fixture {
   reduce(bool along_rows, const input_size& p)
     : input_size(p), along_rows(along_rows), in(p.rows * p.cols, stream), out(p.rows, stream)
   {
+    // one read of the input, one write of the output, one add per element
+    size_t len = size_t(p.rows) * p.cols;
+    declare_iteration_bytes((len + p.rows) * sizeof(T));
+    declare_iteration_flops(len);
   }
 
   void run_benchmark(::benchmark::State& state) override
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <common/benchmark.hpp>
+#include <sparse/sparse_inputs.hpp>
+
+#include <raft/cudart_utils.h>
+#include <raft/sparse/convert/coo.cuh>
+#include <raft/sparse/convert/csr.cuh>
+
+#include <rmm/device_uvector.hpp>
+
+namespace raft::bench::sparse {
+
+struct sorted_coo_to_csr : public fixture {
+  sorted_coo_to_csr(const csr_inputs& p)
+    : params(p), rows(0, stream), indptr(p.n_rows + 1, stream)
+  {
+    auto h = make_host_csr(p);
+    nnz    = h.nnz;
+    rows.resize(nnz, stream);
+    raft::update_device(rows.data(), h.rows.data(), nnz, stream);
+  }
+
+  void run_benchmark(::benchmark::State& state) override
+  {
+    loop_on_state(state, [this]() {
+      raft::sparse::convert::sorted_coo_to_csr(
+        rows.data(), nnz, indptr.data(), params.n_rows, stream);
+    });
+  }
+
+ private:
+  csr_inputs params;
+  int nnz;
+  rmm::device_uvector<int> rows;
+  rmm::device_uvector<int> indptr;
+};  // struct sorted_coo_to_csr
+
+struct csr_to_coo : public fixture {
+  csr_to_coo(const csr_inputs& p) : params(p), indptr(p.n_rows + 1, stream), rows(0, stream)
+  {
+    auto h = make_host_csr(p);
+    nnz    = h.nnz;
+    rows.resize(nnz, stream);
+    raft::update_device(indptr.data(), h.indptr.data(), p.n_rows + 1, stream);
+  }
+
+  void run_benchmark(::benchmark::State& state) override
+  {
+    loop_on_state(state, [this]() {
+      raft::sparse::convert::csr_to_coo(indptr.data(), params.n_rows, rows.data(), nnz, stream);
+    });
+  }
+
+ private:
+  csr_inputs params;
+  int nnz;
+  rmm::device_uvector<int> indptr;
+  rmm::device_uvector<int> rows;
+};  // struct csr_to_coo
+
+const std::vector<csr_inputs> convert_inputs{
+  {100000, 1024, 0.01, 0.0},
+  {100000, 1024, 0.1, 0.0},
+  {100000, 1024, 0.01, 1.0},
+  {1000000, 1024, 0.01, 0.0},
+};
+
+RAFT_BENCH_REGISTER(sorted_coo_to_csr, "", convert_inputs);
+RAFT_BENCH_REGISTER(csr_to_coo, "", convert_inputs);
+
+}  // namespace raft::bench::sparse
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <common/benchmark.hpp>
+#include <sparse/sparse_inputs.hpp>
+
+#include <raft/cudart_utils.h>
+#include <raft/sparse/op/sort.cuh>
+
+#include <rmm/device_uvector.hpp>
+
+#include <numeric>
+
+namespace raft::bench::sparse {
+
+struct coo_sort : public fixture {
+  coo_sort(const csr_inputs& p)
+    : params(p),
+      rows_unsorted(0, stream),
+      cols_unsorted(0, stream),
+      vals_unsorted(0, stream),
+      rows(0, stream),
+      cols(0, stream),
+      vals(0, stream)
+  {
+    auto h = make_host_csr(p);
+    nnz    = h.nnz;
+    // shuffle to get a genuinely unsorted COO input
+    std::mt19937_64 rng(42);
+    std::vector<int> perm(nnz);
+    std::iota(perm.begin(), perm.end(), 0);
+    std::shuffle(perm.begin(), perm.end(), rng);
+    std::vector<int> r(nnz), c(nnz);
+    std::vector<float> v(nnz);
+    for (int i = 0; i < nnz; i++) {
+      r[i] = h.rows[perm[i]];
+      c[i] = h.indices[perm[i]];
+      v[i] = h.data[perm[i]];
+    }
+    rows_unsorted.resize(nnz, stream);
+    cols_unsorted.resize(nnz, stream);
+    vals_unsorted.resize(nnz, stream);
+    rows.resize(nnz, stream);
+    cols.resize(nnz, stream);
+    vals.resize(nnz, stream);
+    raft::update_device(rows_unsorted.data(), r.data(), nnz, stream);
+    raft::update_device(cols_unsorted.data(), c.data(), nnz, stream);
+    raft::update_device(vals_unsorted.data(), v.data(), nnz, stream);
+  }
+
+  void run_benchmark(::benchmark::State& state) override
+  {
+    loop_on_state(state, [this]() {
+      // the sort is in place, restore the unsorted input every iteration
+      // (three device-to-device copies, cheap relative to the sort itself)
+      raft::copy(rows.data(), rows_unsorted.data(), nnz, stream);
+      raft::copy(cols.data(), cols_unsorted.data(), nnz, stream);
+      raft::copy(vals.data(), vals_unsorted.data(), nnz, stream);
+      raft::sparse::op::coo_sort(
+        params.n_rows, params.n_cols, nnz, rows.data(), cols.data(), vals.data(), stream);
+    });
+  }
+
+ private:
+  csr_inputs params;
+  int nnz;
+  rmm::device_uvector<int> rows_unsorted, cols_unsorted;
+  rmm::device_uvector<float> vals_unsorted;
+  rmm::device_uvector<int> rows, cols;
+  rmm::device_uvector<float> vals;
+};  // struct coo_sort
+
+const std::vector<csr_inputs> coo_sort_inputs{
+  {100000, 1024, 0.01, 0.0},
+  {100000, 1024, 0.1, 0.0},
+  {100000, 1024, 0.01, 1.0},
+  {1000000, 1024, 0.01, 0.0},
+};
+
+RAFT_BENCH_REGISTER(coo_sort, "", coo_sort_inputs);
+
+}  // namespace raft::bench::sparse
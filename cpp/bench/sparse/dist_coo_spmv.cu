@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <common/benchmark.hpp>
+#include <sparse/sparse_inputs.hpp>
+
+#include <raft/cudart_utils.h>
+#include <raft/sparse/convert/coo.cuh>
+#include <raft/sparse/distance/common.h>
+#include <raft/sparse/distance/detail/coo_spmv.cuh>
+#include <raft/sparse/distance/detail/operators.cuh>
+
+#include <rmm/device_uvector.hpp>
+
+namespace raft::bench::sparse {
+
+namespace detail = raft::sparse::distance::detail;
+
+/**
+ * Benchmarks the balanced COO spmv with an explicit load balancing strategy
+ * (an L1 distance computation, the same inner ops for every strategy), so
+ * the dense_smem / hash / merge_path dispatch thresholds in
+ * sparse/distance/detail can be tuned against measured numbers across
+ * density and row-skew.
+ */
+template <typename strategy_t>
+struct dist_coo_spmv : public fixture {
+  dist_coo_spmv(const csr_inputs& p)
+    : params(p),
+      config(handle),
+      indptr(p.n_rows + 1, stream),
+      indices(0, stream),
+      data(0, stream),
+      coo_rows(0, stream),
+      out_dists(0, stream)
+  {
+    auto h = make_host_csr(p);
+    nnz    = h.nnz;
+    indices.resize(nnz, stream);
+    data.resize(nnz, stream);
+    coo_rows.resize(nnz, stream);
+    out_dists.resize(static_cast<size_t>(p.n_rows) * p.n_rows, stream);
+    raft::update_device(indptr.data(), h.indptr.data(), p.n_rows + 1, stream);
+    raft::update_device(indices.data(), h.indices.data(), nnz, stream);
+    raft::update_device(data.data(), h.data.data(), nnz, stream);
+
+    // both sides of the pairwise computation use the same matrix
+    config.a_nrows   = params.n_rows;
+    config.a_ncols   = params.n_cols;
+    config.a_nnz     = nnz;
+    config.a_indptr  = indptr.data();
+    config.a_indices = indices.data();
+    config.a_data    = data.data();
+    config.b_nrows   = params.n_rows;
+    config.b_ncols   = params.n_cols;
+    config.b_nnz     = nnz;
+    config.b_indptr  = indptr.data();
+    config.b_indices = indices.data();
+    config.b_data    = data.data();
+
+    raft::sparse::convert::csr_to_coo(indptr.data(), params.n_rows, coo_rows.data(), nnz, stream);
+  }
+
+  void run_benchmark(::benchmark::State& state) override
+  {
+    loop_on_state(state, [this]() {
+      RAFT_CUDA_TRY(cudaMemsetAsync(
+        out_dists.data(), 0, out_dists.size() * sizeof(float), stream));
+      strategy_t strategy(config);
+      detail::balanced_coo_pairwise_generalized_spmv<int, float>(out_dists.data(),
+                                                                 config,
+                                                                 coo_rows.data(),
+                                                                 detail::AbsDiff(),
+                                                                 detail::Sum(),
+                                                                 detail::AtomicAdd(),
+                                                                 strategy);
+    });
+  }
+
+ private:
+  csr_inputs params;
+  raft::sparse::distance::distances_config_t<int, float> config;
+  int nnz;
+  rmm::device_uvector<int> indptr, indices;
+  rmm::device_uvector<float> data;
+  rmm::device_uvector<int> coo_rows;
+  rmm::device_uvector<float> out_dists;
+};  // struct dist_coo_spmv
+
+using dense_smem_strategy_t = detail::dense_smem_strategy<int, float, 1024>;
+using hash_strategy_t       = detail::hash_strategy<int, float, 1024>;
+using merge_path_strategy_t = detail::merge_path_strategy<int, float, 1024>;
+
+const std::vector<csr_inputs> dist_coo_spmv_inputs{
+  {10000, 128, 0.01, 0.0},
+  {10000, 128, 0.1, 0.0},
+  {10000, 1024, 0.01, 0.0},
+  {10000, 1024, 0.01, 1.0},
+  {10000, 16384, 0.001, 0.0},
+  {10000, 16384, 0.001, 1.0},
+};
+
+RAFT_BENCH_REGISTER(dist_coo_spmv<dense_smem_strategy_t>, "", dist_coo_spmv_inputs);
+RAFT_BENCH_REGISTER(dist_coo_spmv<hash_strategy_t>, "", dist_coo_spmv_inputs);
+RAFT_BENCH_REGISTER(dist_coo_spmv<merge_path_strategy_t>, "", dist_coo_spmv_inputs);
+
+}  // namespace raft::bench::sparse
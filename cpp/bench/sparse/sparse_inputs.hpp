@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace raft::bench::sparse {
+
+/**
+ * Parameters of the synthetic CSR inputs shared by the sparse benchmarks.
+ *
+ * density is the average fraction of non-zeros per row. row_skew controls
+ * how the non-zeros are distributed over the rows: 0 gives uniform row
+ * lengths, larger values give zipf-distributed lengths (a few heavy rows,
+ * many light ones), which is what strategy dispatch in
+ * sparse/distance/detail is sensitive to.
+ */
+struct csr_inputs {
+  int n_rows;
+  int n_cols;
+  float density;
+  float row_skew;
+};
+
+/** Host-side CSR (plus the COO row ids) generated from csr_inputs. */
+struct host_csr {
+  std::vector<int> indptr;
+  std::vector<int> indices;
+  std::vector<int> rows;
+  std::vector<float> data;
+  int nnz;
+};
+
+inline host_csr make_host_csr(const csr_inputs& p, uint64_t seed = 137)
+{
+  std::mt19937_64 rng(seed);
+  std::uniform_int_distribution<int> col_dist(0, p.n_cols - 1);
+  std::uniform_real_distribution<float> val_dist(0.0f, 1.0f);
+
+  // zipf-like row weights: w_i = (i+1)^-row_skew, scaled to the target nnz
+  std::vector<double> weights(p.n_rows);
+  double sum_w = 0.0;
+  for (int i = 0; i < p.n_rows; i++) {
+    weights[i] = std::pow(i + 1.0, -static_cast<double>(p.row_skew));
+    sum_w += weights[i];
+  }
+  double total_nnz = static_cast<double>(p.density) * p.n_rows * p.n_cols;
+
+  host_csr out;
+  out.indptr.resize(p.n_rows + 1);
+  out.indptr[0] = 0;
+  for (int i = 0; i < p.n_rows; i++) {
+    int len = std::min<long>(p.n_cols, std::lround(total_nnz * weights[i] / sum_w));
+    std::vector<int> cols(len);
+    for (int k = 0; k < len; k++) {
+      cols[k] = col_dist(rng);
+    }
+    std::sort(cols.begin(), cols.end());
+    cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+    for (int c : cols) {
+      out.indices.push_back(c);
+      out.rows.push_back(i);
+      out.data.push_back(val_dist(rng));
+    }
+    out.indptr[i + 1] = static_cast<int>(out.indices.size());
+  }
+  out.nnz = static_cast<int>(out.indices.size());
+  return out;
+}
+
+}  // namespace raft::bench::sparse
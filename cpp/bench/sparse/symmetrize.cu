@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <common/benchmark.hpp>
+#include <sparse/sparse_inputs.hpp>
+
+#include <raft/cudart_utils.h>
+#include <raft/sparse/coo.hpp>
+#include <raft/sparse/linalg/symmetrize.cuh>
+
+#include <rmm/device_uvector.hpp>
+
+namespace raft::bench::sparse {
+
+struct symmetrize : public fixture {
+  symmetrize(const csr_inputs& p) : params(p), rows(0, stream), cols(0, stream), vals(0, stream)
+  {
+    auto h = make_host_csr(p);
+    nnz    = h.nnz;
+    rows.resize(nnz, stream);
+    cols.resize(nnz, stream);
+    vals.resize(nnz, stream);
+    raft::update_device(rows.data(), h.rows.data(), nnz, stream);
+    raft::update_device(cols.data(), h.indices.data(), nnz, stream);
+    raft::update_device(vals.data(), h.data.data(), nnz, stream);
+  }
+
+  void run_benchmark(::benchmark::State& state) override
+  {
+    loop_on_state(state, [this]() {
+      raft::sparse::COO<float, int> out(stream);
+      raft::sparse::linalg::symmetrize(handle,
+                                       rows.data(),
+                                       cols.data(),
+                                       vals.data(),
+                                       (size_t)params.n_rows,
+                                       (size_t)params.n_cols,
+                                       (size_t)nnz,
+                                       out);
+    });
+  }
+
+ private:
+  csr_inputs params;
+  int nnz;
+  rmm::device_uvector<int> rows, cols;
+  rmm::device_uvector<float> vals;
+};  // struct symmetrize
+
+const std::vector<csr_inputs> symmetrize_inputs{
+  {10000, 10000, 0.001, 0.0},
+  {10000, 10000, 0.01, 0.0},
+  {10000, 10000, 0.001, 1.0},
+  {100000, 100000, 0.0001, 0.0},
+};
+
+RAFT_BENCH_REGISTER(symmetrize, "", symmetrize_inputs);
+
+}  // namespace raft::bench::sparse
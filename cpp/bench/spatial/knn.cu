@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <common/ann_dataset.hpp>
 #include <common/benchmark.hpp>
 
 #include <raft/random/rng.cuh>
@@ -29,6 +30,7 @@
 #include <rmm/mr/host/pinned_memory_resource.hpp>
 
 #include <optional>
+#include <type_traits>
 
 namespace raft::bench::spatial {
 
@@ -169,10 +171,17 @@ struct knn : public fixture {
       out_dists_(p.n_queries * p.k, stream),
       out_idxs_(p.n_queries * p.k, stream)
   {
+    auto dataset = ann_dataset_paths::from_env();
+    if (dataset.enabled()) {
+      if constexpr (std::is_same_v<ValT, float>) {
+        load_dataset(dataset);
+        return;
+      }
+    }
     raft::random::RngState state{42};
     gen_data(state, search_items_, search_items_.size(), stream);
     try {
-      size_t total_size = p.n_samples * p.n_dims;
+      size_t total_size = params_.n_samples * params_.n_dims;
       data_host_.resize(total_size);
       constexpr size_t kGenMinibatchSize = 1024 * 1024 * 1024;
       rmm::device_uvector<ValT> d(std::min(kGenMinibatchSize, total_size), stream);
@@ -186,6 +195,47 @@ struct knn : public fixture {
     }
   }
 
+  /**
+   * Replaces the generated data with an on-disk fbin/ibin dataset;
+   * n_samples/n_dims/n_queries follow the files, only k is kept from the
+   * compiled-in parameters. The base set streams through a bounded
+   * buffer, so billion-scale files do not need one giant read.
+   */
+  void load_dataset(const ann_dataset_paths& dataset)
+  {
+    try {
+      auto base_h        = read_bin_header(dataset.base);
+      auto queries_h     = read_bin_header(dataset.queries);
+      RAFT_EXPECTS(base_h.dim == queries_h.dim, "base and query dims differ");
+      params_.n_samples = base_h.n_rows;
+      params_.n_dims    = base_h.dim;
+      params_.n_queries = queries_h.n_rows;
+
+      data_host_.resize(size_t(base_h.n_rows) * base_h.dim);
+      read_bin_rows<ValT>(
+        dataset.base, 0, base_h.n_rows, base_h.dim, data_host_.data());
+
+      std::vector<ValT> queries(size_t(queries_h.n_rows) * queries_h.dim);
+      read_bin_rows<ValT>(
+        dataset.queries, 0, queries_h.n_rows, queries_h.dim, queries.data());
+      search_items_.resize(queries.size(), stream);
+      out_dists_.resize(params_.n_queries * params_.k, stream);
+      out_idxs_.resize(params_.n_queries * params_.k, stream);
+      copy(search_items_.data(), queries.data(), queries.size(), stream);
+      stream.synchronize();
+
+      if (dataset.has_ground_truth()) {
+        bin_header gt_h;
+        gt_host_ = read_bin<int32_t>(dataset.ground_truth, gt_h);
+        RAFT_EXPECTS(gt_h.n_rows == params_.n_queries, "ground truth rows != queries");
+        RAFT_EXPECTS(size_t(gt_h.dim) >= params_.k, "ground truth holds fewer than k ids");
+        gt_dim_ = gt_h.dim;
+      }
+    } catch (std::bad_alloc& e) {
+      data_does_not_fit_ = true;
+    }
+  }
+
   template <typename T>
   void gen_data(raft::random::RngState& state,
                 rmm::device_uvector<T>& vec,
@@ -293,16 +343,26 @@ struct knn : public fixture {
     } catch (std::bad_alloc& e) {
       state.SkipWithError(e.what());
     }
+
+    if (!gt_host_.empty() && scope_ != Scope::BUILD) {
+      std::vector<IdxT> found(out_idxs_.size());
+      copy(found.data(), out_idxs_.data(), out_idxs_.size(), stream);
+      stream.synchronize();
+      state.counters["recall"] =
+        ::benchmark::Counter(calc_recall(found, gt_host_, params_.n_queries, gt_dim_, params_.k));
+    }
   }
 
  private:
-  const params params_;
+  params params_;
   const TransferStrategy strategy_;
   const Scope scope_;
   device_resource dev_mem_res_;
   bool data_does_not_fit_ = false;
 
   std::vector<ValT> data_host_;
+  std::vector<int32_t> gt_host_;
+  size_t gt_dim_ = 0;
   rmm::device_uvector<ValT> search_items_;
   rmm::device_uvector<typename ImplT::dist_t> out_dists_;
   rmm::device_uvector<IdxT> out_idxs_;
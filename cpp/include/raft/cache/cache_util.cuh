@@ -35,15 +35,19 @@ namespace cache {
  *
  *  We ignore vectors where cache_idx[k] < 0.
  *
+ * The storage type of the cache can differ from the type of the output
+ * buffer (e.g. __half storage gathered into a float buffer): each element is
+ * widened in registers while it is copied.
+ *
  * @param [in] cache stores the cached data, size [n_vec x n_cached_vectors]
  * @param [in] n_vec number of elements in a cached vector
  * @param [in] cache_idx cache indices, size [n]
  * @param [in] n the number of elements that need to be collected
  * @param [out] out vectors collected from the cache, size [n_vec * n]
  */
-template <typename math_t, typename idx_t, typename int_t>
+template <typename store_t, typename idx_t, typename int_t, typename math_t>
 __global__ void get_vecs(
-  const math_t* cache, int_t n_vec, const idx_t* cache_idx, int_t n, math_t* out)
+  const store_t* cache, int_t n_vec, const idx_t* cache_idx, int_t n, math_t* out)
 {
   int tid = threadIdx.x + blockIdx.x * blockDim.x;
   int row = tid % n_vec;  // row idx
@@ -51,7 +55,9 @@ __global__ void get_vecs(
     size_t out_col   = tid / n_vec;  // col idx
     size_t cache_col = cache_idx[out_col];
     if (cache_idx[out_col] >= 0) {
-      if (row + out_col * n_vec < (size_t)n_vec * n) { out[tid] = cache[row + cache_col * n_vec]; }
+      if (row + out_col * n_vec < (size_t)n_vec * n) {
+        out[tid] = static_cast<math_t>(cache[row + cache_col * n_vec]);
+      }
     }
   }
 }
@@ -73,6 +79,10 @@ __global__ void get_vecs(
  * cache[i + cache_idx[k]*n_vec] = tile[i + tile_idx[k]*n_vec],
  * for i=0..n_vec-1, k=0..n-1
  *
+ * The storage type of the cache can differ from the type of the input tile
+ * (e.g. a float tile stored as __half): each element is narrowed in
+ * registers while it is copied.
+ *
  * @param [in] tile stores the data to be cashed cached, size [n_vec x n_tile]
  * @param [in] n_tile number of vectors in the input tile
  * @param [in] n_vec number of elements in a cached vector
@@ -82,14 +92,14 @@ __global__ void get_vecs(
  * @param [inout] cache updated cache
  * @param [in] n_cache_vecs
  */
-template <typename math_t>
+template <typename math_t, typename store_t>
 __global__ void store_vecs(const math_t* tile,
                            int n_tile,
                            int n_vec,
                            const int* tile_idx,
                            int n,
                            const int* cache_idx,
-                           math_t* cache,
+                           store_t* cache,
                            int n_cache_vecs)
 {
   int tid = threadIdx.x + blockIdx.x * blockDim.x;
@@ -102,7 +112,8 @@ __global__ void store_vecs(const math_t* tile,
     // We ignore negative values. The rest of the checks should be fulfilled
     // if the cache is used properly
     if (cache_col >= 0 && cache_col < n_cache_vecs && data_col < n_tile) {
-      cache[row + (size_t)cache_col * n_vec] = tile[row + (size_t)data_col * n_vec];
+      cache[row + (size_t)cache_col * n_vec] =
+        static_cast<store_t>(tile[row + (size_t)data_col * n_vec]);
     }
   }
 }
@@ -254,6 +265,8 @@ DI void rank_set_entries(const int* cache_time, int n_cache_sets, int* rank)
  * @param [in] time time stamp
  * @param [out] cache_idx the cache idx assigned to the input, or -1 if it could
  *   not be cached, size [n]
+ * @param [inout] n_evictions optional device counter, incremented for every
+ *   assignment that overwrites a valid cached key (can be nullptr)
  */
 template <int nthreads, int associativity>
 __global__ void assign_cache_idx(const int* keys,
@@ -263,7 +276,8 @@ __global__ void assign_cache_idx(const int* keys,
                                  int n_cache_sets,
                                  int* cache_time,
                                  int time,
-                                 int* cache_idx)
+                                 int* cache_idx,
+                                 int* n_evictions = nullptr)
 {
   int block_offset = blockIdx.x * associativity;
 
@@ -294,7 +308,8 @@ __global__ void assign_cache_idx(const int* keys,
     if (mask) {
       int k = find_nth_occurrence(cache_set, n, blockIdx.x, rank[i]);
       if (k > -1) {
-        int key_val        = keys[k];
+        int key_val = keys[k];
+        if (n_evictions && cached_keys[t_idx] >= 0) { atomicAdd(n_evictions, 1); }
         cached_keys[t_idx] = key_val;
         cache_idx[k]       = t_idx;
         cache_time[t_idx]  = time;
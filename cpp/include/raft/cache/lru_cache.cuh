@@ -0,0 +1,391 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/cache/cache_util.cuh>
+#include <raft/cuda_utils.cuh>
+#include <raft/cudart_utils.h>
+#include <raft/handle.hpp>
+
+#include <rmm/device_scalar.hpp>
+#include <rmm/device_uvector.hpp>
+#include <rmm/exec_policy.hpp>
+
+#include <thrust/count.h>
+#include <thrust/fill.h>
+#include <thrust/functional.h>
+#include <thrust/iterator/zip_iterator.h>
+#include <thrust/partition.h>
+#include <thrust/sequence.h>
+#include <thrust/sort.h>
+#include <thrust/tuple.h>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace raft {
+namespace cache {
+
+/** @brief Hit/miss/eviction counters of an lru_cache. */
+struct cache_stats {
+  std::size_t n_hits      = 0;
+  std::size_t n_misses    = 0;
+  std::size_t n_evictions = 0;
+
+  /** Fraction of the looked up keys that were served from the cache. */
+  double hit_rate() const
+  {
+    std::size_t n = n_hits + n_misses;
+    return n > 0 ? static_cast<double>(n_hits) / n : 0.0;
+  }
+};
+
+/**
+ * @brief Set-associative LRU cache of vectors in device memory.
+ *
+ * This class manages the building blocks from cache_util.cuh as a complete
+ * cache object. The cache stores vectors of size n_vec, identified by an
+ * integer key. Keys are hashed to a cache set, and within a set the least
+ * recently used entry is evicted when a new vector is stored. The time stamp
+ * used for the LRU ranking is maintained on the device: the lookup kernel
+ * refreshes it for every hit, so entries that are accessed repeatedly stay
+ * cached even if they were stored a long time ago.
+ *
+ * Typical usage is to cache rows of a lazily evaluated matrix (e.g. distance
+ * or kernel matrix rows in an iterative solver) and only compute the rows
+ * that are missing:
+ * @code{.cpp}
+ *   lru_cache<float> cache(handle, n_vec, cache_size);
+ *   cache.get_or_compute(handle, keys, n, out,
+ *     [&](const int* keys, int n, float* tile) {
+ *       // compute the vectors for keys into tile, size [n_vec * n]
+ *     });
+ * @endcode
+ *
+ * The individual lookup / store steps are also exposed for callers that need
+ * to interleave them with other work, following the same protocol as the
+ * kernels in cache_util.cuh.
+ *
+ * The storage type can be narrower than the compute type (e.g.
+ * lru_cache<float, 32, __half>): vectors are narrowed when they are stored
+ * and widened in registers when they are gathered, doubling the number of
+ * vectors that fit in the same memory budget at the cost of fp16 rounding
+ * of the cached values.
+ *
+ * @tparam math_t element type of the collected / stored vectors
+ * @tparam associativity number of entries in a cache set
+ * @tparam store_t element type of the cache storage
+ */
+template <typename math_t, int associativity = 32, typename store_t = math_t>
+class lru_cache {
+ public:
+  /**
+   * @brief Construct an empty cache.
+   *
+   * The actual cache size is rounded down to a multiple of the cache set
+   * size. A cache smaller than one set is allowed and simply caches nothing.
+   *
+   * @param handle raft handle, its stream is used for the allocations
+   * @param n_vec number of elements in a cached vector
+   * @param cache_size cache size in MiB
+   */
+  lru_cache(const raft::handle_t& handle, int n_vec, float cache_size = 200)
+    : n_vec_(n_vec),
+      n_cache_sets_(static_cast<int>(cache_size * 1024 * 1024 /
+                                     (n_vec * sizeof(store_t) * associativity))),
+      cache_(0, handle.get_stream()),
+      cached_keys_(0, handle.get_stream()),
+      cache_time_(0, handle.get_stream()),
+      d_n_evictions_(handle.get_stream())
+  {
+    RAFT_EXPECTS(n_vec > 0, "lru_cache: vector size must be positive");
+    auto stream = handle.get_stream();
+    cache_.resize(static_cast<std::size_t>(n_vec_) * size(), stream);
+    cached_keys_.resize(size(), stream);
+    cache_time_.resize(size(), stream);
+    clear(stream);
+    d_n_evictions_.set_value_to_zero_async(stream);
+  }
+
+  /** @brief Number of vectors that can be cached. */
+  int size() const { return n_cache_sets_ * associativity; }
+
+  /** @brief Number of elements in a cached vector. */
+  int vec_size() const { return n_vec_; }
+
+  /** @brief Raw cache storage in store_t, size [n_vec * size()]. */
+  store_t* data() { return cache_.data(); }
+
+  /**
+   * @brief Collect cached vectors into a contiguous buffer.
+   *
+   * @param [in] cache_idx cache indices as returned by lookup(), entries with
+   *   negative values are skipped, size [n]
+   * @param [in] n number of vectors to collect
+   * @param [out] out collected vectors, size [n_vec * n]
+   * @param [in] stream CUDA stream
+   */
+  void get_vecs(const int* cache_idx, int n, math_t* out, cudaStream_t stream)
+  {
+    if (n <= 0) return;
+    int TPB = 256;
+    cache::get_vecs<<<raft::ceildiv(n * n_vec_, TPB), TPB, 0, stream>>>(
+      cache_.data(), n_vec_, cache_idx, n, out);
+    RAFT_CUDA_TRY(cudaPeekAtLastError());
+  }
+
+  /**
+   * @brief Store vectors from a contiguous tile into the cache.
+   *
+   * @param [in] tile vectors to store, size [n_vec * n]
+   * @param [in] n number of vectors to store
+   * @param [in] cache_idx cache indices assigned by assign_cache_idx(),
+   *   entries with negative values are skipped, size [n]
+   * @param [in] stream CUDA stream
+   */
+  void store_vecs(const math_t* tile, int n, const int* cache_idx, cudaStream_t stream)
+  {
+    if (n <= 0) return;
+    int TPB = 256;
+    cache::store_vecs<<<raft::ceildiv(n * n_vec_, TPB), TPB, 0, stream>>>(
+      tile, n, n_vec_, nullptr, n, cache_idx, cache_.data(), size());
+    RAFT_CUDA_TRY(cudaPeekAtLastError());
+  }
+
+  /**
+   * @brief Look up keys in the cache and partition them into hits and misses.
+   *
+   * The keys array is reordered so that the cached keys come first, followed
+   * by the non-cached ones (the relative order within each group is kept).
+   * For cached keys, cache_idx stores the exact cache index; the lookup
+   * kernel also refreshes their LRU time stamp. For non-cached keys it
+   * stores the assigned cache set, which is the input expected by
+   * assign_cache_idx().
+   *
+   * This call synchronizes the stream to return n_cached.
+   *
+   * @param [inout] keys keys to look up, reordered on exit, size [n]
+   * @param [in] n number of keys
+   * @param [out] cache_idx cache index (hits) or cache set (misses), size [n]
+   * @param [out] n_cached number of keys found in the cache
+   * @param [in] stream CUDA stream
+   */
+  void lookup(int* keys, int n, int* cache_idx, int* n_cached, cudaStream_t stream)
+  {
+    lookup(keys, nullptr, n, cache_idx, n_cached, stream);
+  }
+
+  /**
+   * @brief Look up keys in the cache, additionally permuting a payload array.
+   *
+   * Same as the three argument lookup(), but the payload array (if not
+   * nullptr) is reordered together with keys. This is used by
+   * get_or_compute() to keep track of the original position of each key.
+   */
+  void lookup(int* keys, int* payload, int n, int* cache_idx, int* n_cached, cudaStream_t stream)
+  {
+    if (n <= 0 || size() == 0) {
+      *n_cached = 0;
+      if (size() == 0 && n > 0) {
+        // no storage: every key is a miss and cannot be assigned a set
+        thrust::fill(rmm::exec_policy(stream), cache_idx, cache_idx + n, -1);
+        n_misses_ += n;
+      }
+      return;
+    }
+    rmm::device_uvector<bool> is_cached(n, stream);
+    int TPB = 256;
+    time_++;
+    cache::get_cache_idx<<<raft::ceildiv(n, TPB), TPB, 0, stream>>>(keys,
+                                                                    n,
+                                                                    cached_keys_.data(),
+                                                                    n_cache_sets_,
+                                                                    associativity,
+                                                                    cache_time_.data(),
+                                                                    cache_idx,
+                                                                    is_cached.data(),
+                                                                    time_);
+    RAFT_CUDA_TRY(cudaPeekAtLastError());
+
+    if (payload != nullptr) {
+      auto zip = thrust::make_zip_iterator(thrust::make_tuple(keys, cache_idx, payload));
+      thrust::stable_partition(
+        rmm::exec_policy(stream), zip, zip + n, is_cached.data(), thrust::identity<bool>());
+    } else {
+      auto zip = thrust::make_zip_iterator(thrust::make_tuple(keys, cache_idx));
+      thrust::stable_partition(
+        rmm::exec_policy(stream), zip, zip + n, is_cached.data(), thrust::identity<bool>());
+    }
+    *n_cached = thrust::count(rmm::exec_policy(stream), is_cached.data(), is_cached.data() + n, true);
+    n_hits_ += *n_cached;
+    n_misses_ += n - *n_cached;
+  }
+
+  /**
+   * @brief Assign cache positions to keys that were not found by lookup().
+   *
+   * The keys are sorted by their cache set (reordering cache_idx alongside)
+   * and the LRU entry of each set is replaced. Keys that could not get a slot
+   * (more keys mapped to a set than its free + replaceable entries) get
+   * cache_idx -1.
+   *
+   * @param [inout] keys non-cached keys, reordered on exit, size [n]
+   * @param [in] n number of keys
+   * @param [inout] cache_idx on entry the cache set of each key (from
+   *   lookup()), on exit the assigned cache index or -1, size [n]
+   * @param [in] stream CUDA stream
+   */
+  void assign_cache_idx(int* keys, int n, int* cache_idx, cudaStream_t stream)
+  {
+    if (n <= 0 || size() == 0) return;
+    thrust::sort_by_key(rmm::exec_policy(stream), cache_idx, cache_idx + n, keys);
+
+    rmm::device_uvector<int> cache_set(n, stream);
+    raft::copy(cache_set.data(), cache_idx, n, stream);
+    thrust::fill(rmm::exec_policy(stream), cache_idx, cache_idx + n, -1);
+
+    const int nthreads = std::min(associativity, 64);
+    cache::assign_cache_idx<nthreads, associativity>
+      <<<n_cache_sets_, nthreads, 0, stream>>>(keys,
+                                               n,
+                                               cache_set.data(),
+                                               cached_keys_.data(),
+                                               n_cache_sets_,
+                                               cache_time_.data(),
+                                               time_,
+                                               cache_idx,
+                                               d_n_evictions_.data());
+    RAFT_CUDA_TRY(cudaPeekAtLastError());
+  }
+
+  /**
+   * @brief Collect vectors for a set of keys, computing the ones that are
+   * missing from the cache.
+   *
+   * Cached vectors are copied from the cache, the rest is computed in one
+   * batch by the compute callback and stored in the cache for later calls.
+   * On exit out[i*n_vec .. (i+1)*n_vec) holds the vector for keys[i],
+   * regardless of whether it was a hit or a miss.
+   *
+   * This call synchronizes the handle's stream.
+   *
+   * @param handle raft handle
+   * @param [in] keys keys of the vectors to collect, size [n]
+   * @param [in] n number of keys
+   * @param [out] out the collected vectors, size [n_vec * n]
+   * @param compute callback with signature
+   *   void(const int* keys, int n, math_t* tile), called with the non-cached
+   *   keys; it shall fill tile (size [n_vec * n]) with the corresponding
+   *   vectors, the i-th vector stored contiguously at tile + i * n_vec
+   */
+  template <typename compute_t>
+  void get_or_compute(
+    const raft::handle_t& handle, const int* keys, int n, math_t* out, compute_t compute)
+  {
+    if (n <= 0) return;
+    cudaStream_t stream = handle.get_stream();
+
+    rmm::device_uvector<int> ws_keys(n, stream);
+    rmm::device_uvector<int> ws_idx(n, stream);
+    rmm::device_uvector<int> ws_cache_idx(n, stream);
+    rmm::device_uvector<math_t> tile(static_cast<std::size_t>(n) * n_vec_, stream);
+
+    raft::copy(ws_keys.data(), keys, n, stream);
+    thrust::sequence(rmm::exec_policy(stream), ws_idx.data(), ws_idx.data() + n);
+
+    int n_cached = 0;
+    lookup(ws_keys.data(), ws_idx.data(), n, ws_cache_idx.data(), &n_cached, stream);
+
+    // gather the hits into the tile and scatter them to their original place
+    if (n_cached > 0) {
+      get_vecs(ws_cache_idx.data(), n_cached, tile.data(), stream);
+      scatter_vecs(tile.data(), n_cached, ws_idx.data(), out, n, stream);
+    }
+
+    int n_compute = n - n_cached;
+    if (n_compute > 0) {
+      compute(ws_keys.data() + n_cached, n_compute, tile.data());
+      scatter_vecs(tile.data(), n_compute, ws_idx.data() + n_cached, out, n, stream);
+      // cache the freshly computed vectors (reorders keys within the miss
+      // range, the scatter above has already consumed the original order)
+      assign_cache_idx(ws_keys.data() + n_cached, n_compute, ws_cache_idx.data() + n_cached, stream);
+      store_vecs(tile.data(), n_compute, ws_cache_idx.data() + n_cached, stream);
+    }
+    handle.sync_stream();
+  }
+
+  /**
+   * @brief Return the hit/miss/eviction counters.
+   *
+   * This call synchronizes the stream to read the device side eviction
+   * counter.
+   */
+  cache_stats stats(cudaStream_t stream) const
+  {
+    cache_stats s;
+    s.n_hits      = n_hits_;
+    s.n_misses    = n_misses_;
+    s.n_evictions = static_cast<std::size_t>(d_n_evictions_.value(stream));
+    return s;
+  }
+
+  /** @brief Reset the hit/miss/eviction counters. */
+  void clear_stats(cudaStream_t stream)
+  {
+    n_hits_   = 0;
+    n_misses_ = 0;
+    d_n_evictions_.set_value_to_zero_async(stream);
+  }
+
+  /** @brief Drop all cached entries (the counters are kept). */
+  void clear(cudaStream_t stream)
+  {
+    thrust::fill(
+      rmm::exec_policy(stream), cached_keys_.data(), cached_keys_.data() + cached_keys_.size(), -1);
+    // cache_time == 0 marks an empty slot for the lookup kernel
+    thrust::fill(
+      rmm::exec_policy(stream), cache_time_.data(), cache_time_.data() + cache_time_.size(), 0);
+    time_ = 0;
+  }
+
+ private:
+  int n_vec_;
+  int n_cache_sets_;
+  int time_ = 0;
+
+  rmm::device_uvector<store_t> cache_;
+  rmm::device_uvector<int> cached_keys_;
+  rmm::device_uvector<int> cache_time_;
+
+  std::size_t n_hits_   = 0;
+  std::size_t n_misses_ = 0;
+  rmm::device_scalar<int> d_n_evictions_;
+
+  /** Scatter contiguous vectors from tile to out columns given by out_idx. */
+  void scatter_vecs(
+    const math_t* tile, int n, const int* out_idx, math_t* out, int n_out, cudaStream_t stream)
+  {
+    int TPB = 256;
+    // store_vecs with out as the "cache" scatters tile[k] to out[out_idx[k]]
+    cache::store_vecs<<<raft::ceildiv(n * n_vec_, TPB), TPB, 0, stream>>>(
+      tile, n, n_vec_, nullptr, n, out_idx, out, n_out);
+    RAFT_CUDA_TRY(cudaPeekAtLastError());
+  }
+};
+
+};  // namespace cache
+};  // namespace raft
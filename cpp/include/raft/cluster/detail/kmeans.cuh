@@ -19,7 +19,10 @@
 #include <cmath>
 #include <cstdio>
 #include <ctime>
+#include <limits>
+#include <vector>
 
+#include <cooperative_groups.h>
 #include <cuda.h>
 #include <thrust/binary_search.h>
 #include <thrust/device_ptr.h>
@@ -32,15 +35,18 @@
 #include <thrust/random.h>
 #include <thrust/reduce.h>
 #include <thrust/scan.h>
+#include <thrust/scatter.h>
 #include <thrust/sequence.h>
 #include <thrust/sort.h>
 #include <thrust/transform.h>
 
+#include <raft/common/cuda_graph.hpp>
 #include <raft/cuda_utils.cuh>
 #include <raft/cudart_utils.h>
 #include <raft/device_atomics.cuh>
 #include <raft/handle.hpp>
 #include <raft/linalg/detail/cublas_wrappers.hpp>
+#include <raft/random/rng.cuh>
 #include <raft/spectral/detail/warn_dbg.hpp>
 #include <raft/spectral/matrix_wrappers.hpp>
 
@@ -54,6 +60,7 @@ namespace detail {
 constexpr unsigned int BLOCK_SIZE      = 1024;
 constexpr unsigned int WARP_SIZE       = 32;
 constexpr unsigned int BSIZE_DIV_WSIZE = (BLOCK_SIZE / WARP_SIZE);
+constexpr unsigned int COOP_BLOCK_SIZE = 256;  // persistent (cooperative) kernel
 
 // =========================================================
 // CUDA kernels
@@ -162,14 +169,22 @@ static __global__ void computeDistances(index_type_t n,
  *  @param codes (Output, n entries) Cluster assignments.
  *  @param clusterSizes (Output, k entries) Number of points in each
  *    cluster. Entries must be initialized to zero.
+ *  @param residual (Output, 1 entry) Residual sum of squares of the
+ *    assignment, accumulated in the kernel epilogue with one atomic
+ *    per block, so no separate reduction over 'dists' is needed.
+ *    Entry must be initialized to zero.
  */
 template <typename index_type_t, typename value_type_t>
 static __global__ void minDistances(index_type_t n,
                                     index_type_t k,
                                     value_type_t* __restrict__ dists,
                                     index_type_t* __restrict__ codes,
-                                    index_type_t* __restrict__ clusterSizes)
+                                    index_type_t* __restrict__ clusterSizes,
+                                    value_type_t* __restrict__ residual)
 {
+  // Block-level partial residual sums
+  __shared__ value_type_t residual_block[BLOCK_SIZE];
+
   // Loop index
   index_type_t i, j;
 
@@ -180,6 +195,9 @@ static __global__ void minDistances(index_type_t n,
   value_type_t dist_min;
   index_type_t code_min;
 
+  // Per-thread partial residual sum
+  value_type_t sum = 0;
+
   // Each row in observation matrix is processed by a thread
   i = threadIdx.x + blockIdx.x * blockDim.x;
   while (i < n) {
@@ -196,12 +214,25 @@ static __global__ void minDistances(index_type_t n,
     dists[i] = dist_min;
     codes[i] = code_min;
 
+    // Accumulate residual
+    sum += dist_min;
+
     // Increment cluster sizes
     atomicAdd(clusterSizes + code_min, 1);
 
     // Move to another row
     i += blockDim.x * gridDim.x;
   }
+
+  // Reduce partial residual sums within block, then accumulate one
+  // atomic per block
+  residual_block[threadIdx.x] = sum;
+  __syncthreads();
+  for (unsigned int s = blockDim.x / 2; s > 0; s /= 2) {
+    if (threadIdx.x < s) residual_block[threadIdx.x] += residual_block[threadIdx.x + s];
+    __syncthreads();
+  }
+  if (threadIdx.x == 0) atomicAdd(residual, residual_block[0]);
 }
 
 /**
@@ -329,6 +360,361 @@ static __global__ void divideCentroids(index_type_t d,
   }
 }
 
+/**
+ *  @brief Compute how far each centroid moved since the last iteration.
+ *    Block and grid dimensions should be 1-dimensional. Ideally the
+ *    grid is large enough so there are k threads.
+ *  @tparam index_type_t the type of data used for indexing.
+ *  @tparam value_type_t the type of data used for weights, distances.
+ *  @param d Dimension of observation vectors.
+ *  @param k Number of clusters.
+ *  @param oldCentroids (Input, d*k entries) Centroid matrix from the
+ *    previous iteration. Matrix is stored column-major.
+ *  @param centroids (Input, d*k entries) Current centroid matrix.
+ *    Matrix is stored column-major.
+ *  @param drifts (Output, k entries) Euclidean distance each centroid
+ *    moved.
+ */
+template <typename index_type_t, typename value_type_t>
+static __global__ void computeCentroidDrifts(index_type_t d,
+                                             index_type_t k,
+                                             const value_type_t* __restrict__ oldCentroids,
+                                             const value_type_t* __restrict__ centroids,
+                                             value_type_t* __restrict__ drifts)
+{
+  index_type_t j = threadIdx.x + blockIdx.x * blockDim.x;
+  while (j < k) {
+    value_type_t sum = 0;
+    for (index_type_t i = 0; i < d; ++i) {
+      value_type_t diff = centroids[IDX(i, j, d)] - oldCentroids[IDX(i, j, d)];
+      sum += diff * diff;
+    }
+    drifts[j] = raft::mySqrt(sum);
+    j += blockDim.x * gridDim.x;
+  }
+}
+
+/**
+ *  @brief Find closest centroids and initialize Hamerly bounds.
+ *    Like minDistances, but additionally records the distance to the
+ *    closest centroid as a per-point upper bound and the distance to
+ *    the second-closest centroid as a per-point lower bound. Block and
+ *    grid dimensions should be 1-dimensional. Ideally the grid is
+ *    large enough so there are n threads.
+ *  @tparam index_type_t the type of data used for indexing.
+ *  @tparam value_type_t the type of data used for weights, distances.
+ *  @param n Number of observation vectors.
+ *  @param k Number of clusters.
+ *  @param dists (Input/output, n*k entries) Distance matrix. Matrix
+ *    is stored column-major. On exit, the first n entries give the
+ *    square of the Euclidean distance between observation vectors and
+ *    closest centroids.
+ *  @param codes (Output, n entries) Cluster assignments.
+ *  @param clusterSizes (Output, k entries) Number of points in each
+ *    cluster. Entries must be initialized to zero.
+ *  @param boundUpper (Output, n entries) Distance to the closest
+ *    centroid.
+ *  @param boundLower (Output, n entries) Distance to the
+ *    second-closest centroid.
+ */
+template <typename index_type_t, typename value_type_t>
+static __global__ void assignAndBound(index_type_t n,
+                                      index_type_t k,
+                                      value_type_t* __restrict__ dists,
+                                      index_type_t* __restrict__ codes,
+                                      index_type_t* __restrict__ clusterSizes,
+                                      value_type_t* __restrict__ boundUpper,
+                                      value_type_t* __restrict__ boundLower)
+{
+  index_type_t i = threadIdx.x + blockIdx.x * blockDim.x;
+  while (i < n) {
+    index_type_t code_min = 0;
+    value_type_t dist_min = dists[IDX(i, 0, n)];
+    value_type_t dist_sec = std::numeric_limits<value_type_t>::max();
+    for (index_type_t j = 1; j < k; ++j) {
+      value_type_t dist_curr = dists[IDX(i, j, n)];
+      if (dist_curr < dist_min) {
+        dist_sec = dist_min;
+        dist_min = dist_curr;
+        code_min = j;
+      } else if (dist_curr < dist_sec) {
+        dist_sec = dist_curr;
+      }
+    }
+
+    dists[i]      = dist_min;
+    codes[i]      = code_min;
+    boundUpper[i] = raft::mySqrt(dist_min);
+    boundLower[i] =
+      (k > 1) ? raft::mySqrt(dist_sec) : std::numeric_limits<value_type_t>::max();
+    atomicAdd(clusterSizes + code_min, 1);
+
+    i += blockDim.x * gridDim.x;
+  }
+}
+
+/**
+ *  @brief Assign observation vectors to centroids using Hamerly bounds.
+ *    Each point's upper bound grows by the drift of its assigned
+ *    centroid and its lower bound shrinks by the largest drift of any
+ *    centroid; when the upper bound stays below the lower bound the
+ *    assignment provably did not change and no distance is evaluated.
+ *    Otherwise the upper bound is tightened with one exact distance,
+ *    and only if the test still fails are all k distances computed.
+ *    Block and grid dimensions should be 1-dimensional. Ideally the
+ *    grid is large enough so there are n threads.
+ *  @tparam index_type_t the type of data used for indexing.
+ *  @tparam value_type_t the type of data used for weights, distances.
+ *  @param n Number of observation vectors.
+ *  @param d Dimension of observation vectors.
+ *  @param k Number of clusters.
+ *  @param obs (Input, d*n entries) Observation matrix. Matrix is
+ *    stored column-major.
+ *  @param centroids (Input, d*k entries) Centroid matrix. Matrix is
+ *    stored column-major.
+ *  @param drifts (Input, k entries) Euclidean distance each centroid
+ *    moved in the last update.
+ *  @param maxDrift Largest entry of 'drifts'.
+ *  @param boundUpper (Input/output, n entries) Upper bound on the
+ *    distance to the assigned centroid.
+ *  @param boundLower (Input/output, n entries) Lower bound on the
+ *    distance to any other centroid.
+ *  @param codes (Input/output, n entries) Cluster assignments.
+ *  @param clusterSizes (Output, k entries) Number of points in each
+ *    cluster. Entries must be initialized to zero.
+ *  @param dists (Output, n entries) Squared upper bound on the
+ *    distance between observation vectors and closest centroids
+ *    (exact for points whose distances were evaluated).
+ */
+template <typename index_type_t, typename value_type_t>
+static __global__ void hamerlyAssign(index_type_t n,
+                                     index_type_t d,
+                                     index_type_t k,
+                                     const value_type_t* __restrict__ obs,
+                                     const value_type_t* __restrict__ centroids,
+                                     const value_type_t* __restrict__ drifts,
+                                     value_type_t maxDrift,
+                                     value_type_t* __restrict__ boundUpper,
+                                     value_type_t* __restrict__ boundLower,
+                                     index_type_t* __restrict__ codes,
+                                     index_type_t* __restrict__ clusterSizes,
+                                     value_type_t* __restrict__ dists)
+{
+  index_type_t i = threadIdx.x + blockIdx.x * blockDim.x;
+  while (i < n) {
+    index_type_t code  = codes[i];
+    value_type_t upper = boundUpper[i] + drifts[code];
+    value_type_t lower = boundLower[i] - maxDrift;
+
+    if (upper > lower) {
+      // Tighten upper bound with the exact distance to the assigned centroid
+      value_type_t sum = 0;
+      for (index_type_t p = 0; p < d; ++p) {
+        value_type_t diff = obs[IDX(p, i, d)] - centroids[IDX(p, code, d)];
+        sum += diff * diff;
+      }
+      upper = raft::mySqrt(sum);
+
+      if (upper > lower) {
+        // Bound test failed: evaluate all centroids
+        value_type_t dist_min = std::numeric_limits<value_type_t>::max();
+        value_type_t dist_sec = std::numeric_limits<value_type_t>::max();
+        index_type_t code_min = 0;
+        for (index_type_t j = 0; j < k; ++j) {
+          sum = 0;
+          for (index_type_t p = 0; p < d; ++p) {
+            value_type_t diff = obs[IDX(p, i, d)] - centroids[IDX(p, j, d)];
+            sum += diff * diff;
+          }
+          if (sum < dist_min) {
+            dist_sec = dist_min;
+            dist_min = sum;
+            code_min = j;
+          } else if (sum < dist_sec) {
+            dist_sec = sum;
+          }
+        }
+        code  = code_min;
+        upper = raft::mySqrt(dist_min);
+        lower = raft::mySqrt(dist_sec);
+      }
+    }
+
+    codes[i]      = code;
+    boundUpper[i] = upper;
+    boundLower[i] = lower;
+    dists[i]      = upper * upper;
+    atomicAdd(clusterSizes + code, 1);
+
+    i += blockDim.x * gridDim.x;
+  }
+}
+
+/**
+ *  @brief Gather sampled observation vectors into a dense batch.
+ *    The grid and block dimensions should be 2-dimensional. Ideally
+ *    the grid is large enough so there are d threads in the
+ *    x-direction and batchSize threads in the y-direction.
+ *  @tparam index_type_t the type of data used for indexing.
+ *  @tparam value_type_t the type of data used for weights, distances.
+ *  @param d Dimension of observation vectors.
+ *  @param batchSize Number of sampled observation vectors.
+ *  @param obs (Input, d*n entries) Observation matrix. Matrix is
+ *    stored column-major and each column is an observation vector.
+ *  @param indices (Input, batchSize entries) Sampled column indices.
+ *  @param batch (Output, d*batchSize entries) Gathered batch matrix.
+ *    Matrix is stored column-major.
+ */
+template <typename index_type_t, typename value_type_t>
+static __global__ void gatherBatch(index_type_t d,
+                                   index_type_t batchSize,
+                                   const value_type_t* __restrict__ obs,
+                                   const index_type_t* __restrict__ indices,
+                                   value_type_t* __restrict__ batch)
+{
+  // Global indices
+  index_type_t gidx, gidy;
+
+  // Sampled vector is determined by global y-index
+  gidy = threadIdx.y + blockIdx.y * blockDim.y;
+  while (gidy < batchSize) {
+    index_type_t col = indices[gidy];
+
+    // Vector entry is determined by global x-index
+    gidx = threadIdx.x + blockIdx.x * blockDim.x;
+    while (gidx < d) {
+      batch[IDX(gidx, gidy, d)] = obs[IDX(gidx, col, d)];
+      gidx += blockDim.x * gridDim.x;
+    }
+
+    // Move to another sampled vector
+    gidy += blockDim.y * gridDim.y;
+  }
+}
+
+/**
+ *  @brief Accumulate per-cluster sums of a batch of observation vectors.
+ *    The grid and block dimensions should be 2-dimensional. Ideally
+ *    the grid is large enough so there are d threads in the
+ *    x-direction and batchSize threads in the y-direction.
+ *  @tparam index_type_t the type of data used for indexing.
+ *  @tparam value_type_t the type of data used for weights, distances.
+ *  @param d Dimension of observation vectors.
+ *  @param batchSize Number of observation vectors in the batch.
+ *  @param batch (Input, d*batchSize entries) Batch matrix. Matrix is
+ *    stored column-major.
+ *  @param codes (Input, batchSize entries) Cluster assignments of the
+ *    batch.
+ *  @param sums (Output, d*k entries) Per-cluster coordinate sums.
+ *    Entries must be initialized to zero.
+ */
+template <typename index_type_t, typename value_type_t>
+static __global__ void accumulateBatchSums(index_type_t d,
+                                           index_type_t batchSize,
+                                           const value_type_t* __restrict__ batch,
+                                           const index_type_t* __restrict__ codes,
+                                           value_type_t* __restrict__ sums)
+{
+  // Global indices
+  index_type_t gidx, gidy;
+
+  // Batch vector is determined by global y-index
+  gidy = threadIdx.y + blockIdx.y * blockDim.y;
+  while (gidy < batchSize) {
+    index_type_t code = codes[gidy];
+
+    // Vector entry is determined by global x-index
+    gidx = threadIdx.x + blockIdx.x * blockDim.x;
+    while (gidx < d) {
+      atomicAdd(sums + IDX(gidx, code, d), batch[IDX(gidx, gidy, d)]);
+      gidx += blockDim.x * gridDim.x;
+    }
+
+    // Move to another batch vector
+    gidy += blockDim.y * gridDim.y;
+  }
+}
+
+/**
+ *  @brief Apply a mini-batch centroid update with per-cluster decaying
+ *    learning rates.
+ *    For each cluster with a non-empty batch, the centroid moves
+ *    towards the batch mean with learning rate
+ *    batchClusterSizes[j] / (counts[j] + batchClusterSizes[j]), so the
+ *    step size decays as a cluster accumulates samples. Clusters with
+ *    no samples in the batch are left untouched. The grid and block
+ *    dimensions should be 2-dimensional. Ideally the grid is large
+ *    enough so there are d threads in the x-direction and k threads in
+ *    the y-direction.
+ *  @tparam index_type_t the type of data used for indexing.
+ *  @tparam value_type_t the type of data used for weights, distances.
+ *  @param d Dimension of observation vectors.
+ *  @param k Number of clusters.
+ *  @param batchClusterSizes (Input, k entries) Number of batch points
+ *    assigned to each cluster.
+ *  @param sums (Input, d*k entries) Per-cluster coordinate sums of the
+ *    batch.
+ *  @param counts (Input, k entries) Cumulative number of samples each
+ *    cluster has absorbed in previous steps.
+ *  @param centroids (Input/output, d*k entries) Centroid matrix.
+ *    Matrix is stored column-major.
+ */
+template <typename index_type_t, typename value_type_t>
+static __global__ void applyMiniBatchUpdate(index_type_t d,
+                                            index_type_t k,
+                                            const index_type_t* __restrict__ batchClusterSizes,
+                                            const value_type_t* __restrict__ sums,
+                                            const index_type_t* __restrict__ counts,
+                                            value_type_t* __restrict__ centroids)
+{
+  // Global indices
+  index_type_t gidx, gidy;
+
+  // Centroid is determined by global y-index
+  gidy = threadIdx.y + blockIdx.y * blockDim.y;
+  while (gidy < k) {
+    index_type_t batchSize_private = batchClusterSizes[gidy];
+    if (batchSize_private > 0) {
+      value_type_t eta = static_cast<value_type_t>(batchSize_private) /
+                         static_cast<value_type_t>(counts[gidy] + batchSize_private);
+
+      // Vector entry is determined by global x-index
+      gidx = threadIdx.x + blockIdx.x * blockDim.x;
+      while (gidx < d) {
+        value_type_t batchMean = sums[IDX(gidx, gidy, d)] / batchSize_private;
+        centroids[IDX(gidx, gidy, d)] =
+          (1 - eta) * centroids[IDX(gidx, gidy, d)] + eta * batchMean;
+        gidx += blockDim.x * gridDim.x;
+      }
+    }
+
+    // Move to another centroid
+    gidy += blockDim.y * gridDim.y;
+  }
+}
+
+/**
+ *  @brief Add batch cluster sizes to cumulative per-cluster sample counts.
+ *    Block and grid dimensions should be 1-dimensional. Ideally the
+ *    grid is large enough so there are k threads.
+ *  @tparam index_type_t the type of data used for indexing.
+ *  @param k Number of clusters.
+ *  @param batchClusterSizes (Input, k entries) Number of batch points
+ *    assigned to each cluster.
+ *  @param counts (Input/output, k entries) Cumulative sample counts.
+ */
+template <typename index_type_t>
+static __global__ void updateSampleCounts(index_type_t k,
+                                          const index_type_t* __restrict__ batchClusterSizes,
+                                          index_type_t* __restrict__ counts)
+{
+  index_type_t i = threadIdx.x + blockIdx.x * blockDim.x;
+  while (i < k) {
+    counts[i] += batchClusterSizes[i];
+    i += blockDim.x * gridDim.x;
+  }
+}
+
 // =========================================================
 // Helper functions
 // =========================================================
@@ -535,6 +921,212 @@ static int initializeCentroids(handle_t const& handle,
   return 0;
 }
 
+/**
+ *  @brief Gather observation vectors into a contiguous matrix.
+ *  @tparam index_type_t the type of data used for indexing.
+ *  @tparam value_type_t the type of data used for weights, distances.
+ *  @param n Number of observation vectors to gather.
+ *  @param d Dimension of observation vectors.
+ *  @param perm (Input, n entries) Indices of the columns to gather.
+ *  @param obs (Input, d*n entries) Observation matrix. Matrix is
+ *    stored column-major and each column is an observation vector.
+ *  @param obs_out (Output, d*n entries) Gathered observation matrix,
+ *    column i is column perm[i] of obs.
+ */
+template <typename index_type_t, typename value_type_t>
+static __global__ void gatherObsColumns(index_type_t n,
+                                        index_type_t d,
+                                        const index_type_t* __restrict__ perm,
+                                        const value_type_t* __restrict__ obs,
+                                        value_type_t* __restrict__ obs_out)
+{
+  index_type_t i = threadIdx.x + blockIdx.x * blockDim.x;
+  while (i < n * d) {
+    index_type_t c = i / d;
+    index_type_t r = i % d;
+    obs_out[i]     = obs[IDX(r, perm[c], d)];
+    i += blockDim.x * gridDim.x;
+  }
+}
+
+/**
+ *  @brief Choose initial cluster centroids with a two-level balanced
+ *    scheme. Observation vectors are first grouped into ceil(sqrt(k))
+ *    coarse groups with the k-means++ algorithm; the k centroids are
+ *    then apportioned to groups proportionally to group size and
+ *    chosen by running k-means++ within each group. Each within-group
+ *    pass only touches the group's observation vectors, so the total
+ *    work is O(n*sqrt(k)) compared with O(n*k) for plain k-means++,
+ *    which dominates for large k (e.g. coarse quantizer sizing).
+ *  @tparam index_type_t the type of data used for indexing.
+ *  @tparam value_type_t the type of data used for weights, distances.
+ *  @param handle the raft handle.
+ *  @param n Number of observation vectors.
+ *  @param d Dimension of observation vectors.
+ *  @param k Number of clusters.
+ *  @param obs (Input, device memory, d*n entries) Observation
+ *    matrix. Matrix is stored column-major and each column is an
+ *    observation vector. Matrix dimensions are d x n.
+ *  @param centroids (Output, device memory, d*k entries) Centroid
+ *    matrix. Matrix is stored column-major and each column is a
+ *    centroid. Matrix dimensions are d x k.
+ *  @param codes (Output, device memory, n entries) Cluster
+ *    assignments.
+ *  @param clusterSizes (Output, device memory, k entries) Number of
+ *    points in each cluster.
+ *  @param dists (Output, device memory, 2*n entries) Workspace.
+ *  @param work_int (Output, device memory, 2*n entries) Workspace.
+ *  @return Zero if successful. Otherwise non-zero.
+ */
+template <typename index_type_t, typename value_type_t>
+static int initializeCentroidsHierarchical(handle_t const& handle,
+                                           index_type_t n,
+                                           index_type_t d,
+                                           index_type_t k,
+                                           const value_type_t* __restrict__ obs,
+                                           value_type_t* __restrict__ centroids,
+                                           index_type_t* __restrict__ codes,
+                                           index_type_t* __restrict__ clusterSizes,
+                                           value_type_t* __restrict__ dists,
+                                           index_type_t* __restrict__ work_int,
+                                           unsigned long long seed)
+{
+  auto stream             = handle.get_stream();
+  auto thrust_exec_policy = handle.get_thrust_policy();
+
+  constexpr unsigned grid_lower_bound{65535};
+
+  // Number of coarse groups
+  index_type_t g = static_cast<index_type_t>(std::ceil(std::sqrt(static_cast<double>(k))));
+  g              = std::min(g, k);
+
+  // With few clusters the second level cannot amortize the grouping
+  // pass, so fall back to plain k-means++
+  if (g < 2 || n <= k)
+    return initializeCentroids(handle, n, d, k, obs, centroids, codes, clusterSizes, dists, seed);
+
+  // Level 1: group observation vectors around sqrt(k) coarse centroids.
+  // The group centroids are only needed transiently and are staged in
+  // the leading columns of the centroid matrix
+  if (initializeCentroids(handle, n, d, g, obs, centroids, codes, clusterSizes, dists, seed))
+    return 1;
+
+  std::vector<index_type_t> groupSizes(g);
+  raft::update_host(groupSizes.data(), clusterSizes, g, stream);
+  RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+
+  // Apportion the k centroids to groups proportionally to group size
+  // (largest remainder, capped by group size so each group can supply
+  // its quota of distinct observation vectors)
+  std::vector<index_type_t> quota(g);
+  index_type_t total = 0;
+  for (index_type_t j = 0; j < g; ++j) {
+    double ideal = static_cast<double>(groupSizes[j]) * k / n;
+    quota[j]     = std::min(groupSizes[j], static_cast<index_type_t>(ideal));
+    // every non-empty group supplies at least one centroid, otherwise
+    // its points would keep their coarse assignment
+    if (groupSizes[j] > 0 && quota[j] < 1) quota[j] = 1;
+    total += quota[j];
+  }
+  while (total > k) {
+    index_type_t bestGroup = -1;
+    double bestRemainder   = std::numeric_limits<double>::max();
+    for (index_type_t j = 0; j < g; ++j) {
+      if (quota[j] <= 1) continue;
+      double remainder = static_cast<double>(groupSizes[j]) * k / n - quota[j];
+      if (remainder < bestRemainder) {
+        bestRemainder = remainder;
+        bestGroup     = j;
+      }
+    }
+    if (bestGroup < 0) break;
+    --quota[bestGroup];
+    --total;
+  }
+  while (total < k) {
+    index_type_t bestGroup = -1;
+    double bestRemainder   = -1;
+    for (index_type_t j = 0; j < g; ++j) {
+      if (quota[j] >= groupSizes[j]) continue;
+      double remainder = static_cast<double>(groupSizes[j]) * k / n - quota[j];
+      if (remainder > bestRemainder) {
+        bestRemainder = remainder;
+        bestGroup     = j;
+      }
+    }
+    if (bestGroup < 0) break;  // cannot happen while sum(groupSizes) = n > k
+    ++quota[bestGroup];
+    ++total;
+  }
+  if (total != k) {
+    WARNING("error in hierarchical k-means++ init (could not apportion centroids)");
+    return 1;
+  }
+
+  // Sort observation vector indices by group so each group's columns
+  // can be gathered contiguously
+  index_type_t* perm       = work_int;
+  index_type_t* codesSlice = work_int + n;
+  RAFT_CUDA_TRY(cudaMemcpyAsync(
+    codesSlice, codes, n * sizeof(index_type_t), cudaMemcpyDeviceToDevice, stream));
+  thrust::sequence(thrust_exec_policy,
+                   thrust::device_pointer_cast(perm),
+                   thrust::device_pointer_cast(perm + n));
+  thrust::sort_by_key(thrust_exec_policy,
+                      thrust::device_pointer_cast(codesSlice),
+                      thrust::device_pointer_cast(codesSlice + n),
+                      thrust::device_pointer_cast(perm));
+  RAFT_CHECK_CUDA(stream);
+
+  index_type_t maxGroupSize = *std::max_element(groupSizes.begin(), groupSizes.end());
+  raft::spectral::matrix::vector_t<value_type_t> obsGroup(handle, d * maxGroupSize);
+
+  // Level 2: run k-means++ within each group on its gathered columns
+  index_type_t offset_n = 0;
+  index_type_t offset_k = 0;
+  for (index_type_t j = 0; j < g; ++j) {
+    index_type_t nj = groupSizes[j];
+    index_type_t qj = quota[j];
+    if (nj > 0 && qj > 0) {
+      gatherObsColumns<<<std::min(ceildiv<unsigned>(nj * d, BLOCK_SIZE), grid_lower_bound),
+                         BLOCK_SIZE,
+                         0,
+                         stream>>>(nj, d, perm + offset_n, obs, obsGroup.raw());
+      RAFT_CHECK_CUDA(stream);
+
+      if (initializeCentroids(handle,
+                              nj,
+                              d,
+                              qj,
+                              obsGroup.raw(),
+                              centroids + IDX(0, offset_k, d),
+                              codesSlice + offset_n,
+                              clusterSizes + offset_k,
+                              dists,
+                              seed + j + 1))
+        return 1;
+
+      // Globalize the within-group assignments
+      thrust::transform(thrust_exec_policy,
+                        thrust::device_pointer_cast(codesSlice + offset_n),
+                        thrust::device_pointer_cast(codesSlice + offset_n + nj),
+                        thrust::make_constant_iterator(offset_k),
+                        thrust::device_pointer_cast(codesSlice + offset_n),
+                        thrust::plus<index_type_t>());
+      thrust::scatter(thrust_exec_policy,
+                      thrust::device_pointer_cast(codesSlice + offset_n),
+                      thrust::device_pointer_cast(codesSlice + offset_n + nj),
+                      thrust::device_pointer_cast(perm + offset_n),
+                      thrust::device_pointer_cast(codes));
+      RAFT_CHECK_CUDA(stream);
+    }
+    offset_n += nj;
+    offset_k += qj;
+  }
+
+  return 0;
+}
+
 /**
  *  @brief Find cluster centroids closest to observation vectors.
  *    Distance is measured with Euclidean norm.
@@ -557,6 +1149,9 @@ static int initializeCentroids(handle_t const& handle,
  *    assignments.
  *  @param clusterSizes (Output, device memory, k entries) Number of
  *    points in each cluster.
+ *  @param residual_dev (Output, device memory, 1 entry) Workspace for
+ *    the residual accumulated in the assignment kernel. Must outlive
+ *    the CUDA graph when one is used, since replays reference it.
  *  @param residual_host (Output, host memory, 1 entry) Residual sum
  *    of squares of assignment.
  *  @return Zero if successful. Otherwise non-zero.
@@ -571,40 +1166,54 @@ static int assignCentroids(handle_t const& handle,
                            value_type_t* __restrict__ dists,
                            index_type_t* __restrict__ codes,
                            index_type_t* __restrict__ clusterSizes,
-                           value_type_t* residual_host)
+                           value_type_t* __restrict__ residual_dev,
+                           value_type_t* residual_host,
+                           cuda_graph_t* graph = nullptr)
 {
-  auto stream             = handle.get_stream();
-  auto thrust_exec_policy = handle.get_thrust_policy();
-
-  // Compute distance between centroids and observation vectors
-  RAFT_CUDA_TRY(cudaMemsetAsync(dists, 0, n * k * sizeof(value_type_t), stream));
-
-  // CUDA grid dimensions
-  dim3 blockDim{WARP_SIZE, 1, BLOCK_SIZE / WARP_SIZE};
-
-  dim3 gridDim;
-  constexpr unsigned grid_lower_bound{65535};
-  gridDim.x = std::min(ceildiv<unsigned>(d, WARP_SIZE), grid_lower_bound);
-  gridDim.y = std::min(static_cast<unsigned>(k), grid_lower_bound);
-  gridDim.z = std::min(ceildiv<unsigned>(n, BSIZE_DIV_WSIZE), grid_lower_bound);
-
-  computeDistances<<<gridDim, blockDim, 0, stream>>>(n, d, k, obs, centroids, dists);
-  RAFT_CHECK_CUDA(stream);
+  auto stream = handle.get_stream();
+
+  // Distance computation and assignment launch the same kernel sequence with
+  // the same shapes every iteration, so they are capture-safe and can be
+  // replayed from a CUDA graph; the residual is accumulated in the
+  // assignment kernel's epilogue, so only the scalar copy below stays
+  // outside the capture.
+  auto launch = [&] {
+    // Compute distance between centroids and observation vectors
+    RAFT_CUDA_TRY(cudaMemsetAsync(dists, 0, n * k * sizeof(value_type_t), stream));
+
+    // CUDA grid dimensions
+    dim3 blockDim{WARP_SIZE, 1, BLOCK_SIZE / WARP_SIZE};
 
-  // Find centroid closest to each observation vector
-  CUDA_TRY(cudaMemsetAsync(clusterSizes, 0, k * sizeof(index_type_t), stream));
-  blockDim.x = BLOCK_SIZE;
-  blockDim.y = 1;
-  blockDim.z = 1;
-  gridDim.x  = std::min(ceildiv<unsigned>(n, BLOCK_SIZE), grid_lower_bound);
-  gridDim.y  = 1;
-  gridDim.z  = 1;
-  minDistances<<<gridDim, blockDim, 0, stream>>>(n, k, dists, codes, clusterSizes);
+    dim3 gridDim;
+    constexpr unsigned grid_lower_bound{65535};
+    gridDim.x = std::min(ceildiv<unsigned>(d, WARP_SIZE), grid_lower_bound);
+    gridDim.y = std::min(static_cast<unsigned>(k), grid_lower_bound);
+    gridDim.z = std::min(ceildiv<unsigned>(n, BSIZE_DIV_WSIZE), grid_lower_bound);
+
+    computeDistances<<<gridDim, blockDim, 0, stream>>>(n, d, k, obs, centroids, dists);
+
+    // Find centroid closest to each observation vector, fusing the
+    // residual accumulation into the assignment
+    RAFT_CUDA_TRY(cudaMemsetAsync(clusterSizes, 0, k * sizeof(index_type_t), stream));
+    RAFT_CUDA_TRY(cudaMemsetAsync(residual_dev, 0, sizeof(value_type_t), stream));
+    blockDim.x = BLOCK_SIZE;
+    blockDim.y = 1;
+    blockDim.z = 1;
+    gridDim.x  = std::min(ceildiv<unsigned>(n, BLOCK_SIZE), grid_lower_bound);
+    gridDim.y  = 1;
+    gridDim.z  = 1;
+    minDistances<<<gridDim, blockDim, 0, stream>>>(n, k, dists, codes, clusterSizes, residual_dev);
+  };
+  if (graph != nullptr) {
+    graph->capture_and_launch(stream, launch);
+  } else {
+    launch();
+  }
   CHECK_CUDA(stream);
 
-  // Compute residual sum of squares
-  *residual_host = thrust::reduce(
-    thrust_exec_policy, thrust::device_pointer_cast(dists), thrust::device_pointer_cast(dists + n));
+  // Retrieve residual sum of squares
+  raft::update_host(residual_host, residual_dev, 1, stream);
+  RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
 
   return 0;
 }
@@ -774,6 +1383,20 @@ static int updateCentroids(handle_t const& handle,
  *  @param iters_host (Output, host memory, 1 entry) Number of
  *    k-means iterations.
  *  @param seed random seed to be used.
+ *  @param use_cuda_graph when true, capture the per-iteration assignment
+ *    kernels into a CUDA graph and replay it on subsequent iterations.
+ *  @param use_hamerly when true, maintain Hamerly-style distance bounds
+ *    across iterations and skip distance evaluation for points whose
+ *    assignment provably did not change. The residual then becomes an
+ *    upper bound (exact for all re-evaluated points), which only affects
+ *    the convergence test. Most effective on well-separated clusters in
+ *    late iterations.
+ *  @param use_hierarchical_init when true, choose the initial centroids
+ *    with the two-level balanced scheme of
+ *    initializeCentroidsHierarchical instead of plain k-means++,
+ *    cutting the number of initialization passes from O(k) to
+ *    O(sqrt(k)). Worthwhile for large k, where plain k-means++ init
+ *    can cost more than the Lloyd iterations.
  *  @return error flag.
  */
 template <typename index_type_t, typename value_type_t>
@@ -791,7 +1414,10 @@ int kmeans(handle_t const& handle,
            index_type_t* __restrict__ work_int,
            value_type_t* residual_host,
            index_type_t* iters_host,
-           unsigned long long seed)
+           unsigned long long seed,
+           bool use_cuda_graph        = false,
+           bool use_hamerly           = false,
+           bool use_hierarchical_init = false)
 {
   // -------------------------------------------------------
   // Variable declarations
@@ -865,19 +1491,120 @@ int kmeans(handle_t const& handle,
   // -------------------------------------------------------
 
   // Choose initial cluster centroids
-  if (initializeCentroids(handle, n, d, k, obs, centroids, codes, clusterSizes, work, seed))
+  if (use_hierarchical_init
+        ? initializeCentroidsHierarchical(
+            handle, n, d, k, obs, centroids, codes, clusterSizes, work, work_int, seed)
+        : initializeCentroids(handle, n, d, k, obs, centroids, codes, clusterSizes, work, seed))
     WARNING("could not initialize k-means centroids");
 
+  // Optional CUDA graph replay of the per-iteration assignment kernels; the
+  // shapes are fixed for the whole fit, so one capture serves all iterations
+  cuda_graph_t assign_graph;
+  auto* graph = use_cuda_graph ? &assign_graph : nullptr;
+
+  // Device scalar for the residual accumulated in the assignment kernel;
+  // lives for the whole fit so CUDA graph replays can reference it
+  raft::spectral::matrix::vector_t<value_type_t> residualDev(handle, 1);
+
+  // Per-fit Hamerly bound state: upper/lower distance bounds per point and
+  // how far each centroid moved in the last update
+  raft::spectral::matrix::vector_t<value_type_t> oldCentroids(handle, use_hamerly ? d * k : 0);
+  raft::spectral::matrix::vector_t<value_type_t> drifts(handle, use_hamerly ? k : 0);
+  raft::spectral::matrix::vector_t<value_type_t> boundUpper(handle, use_hamerly ? n : 0);
+  raft::spectral::matrix::vector_t<value_type_t> boundLower(handle, use_hamerly ? n : 0);
+  bool boundsValid = false;
+
+  // Exact assignment that (re)initializes the bounds; used on the first
+  // iteration and whenever an empty cluster is reseeded
+  auto exactAssignBounded = [&] {
+    dim3 blockDim{WARP_SIZE, 1, BLOCK_SIZE / WARP_SIZE};
+    dim3 gridDim{std::min(ceildiv<unsigned>(d, WARP_SIZE), grid_lower_bound),
+                 std::min(static_cast<unsigned>(k), grid_lower_bound),
+                 std::min(ceildiv<unsigned>(n, BSIZE_DIV_WSIZE), grid_lower_bound)};
+
+    RAFT_CUDA_TRY(cudaMemsetAsync(work, 0, n * k * sizeof(value_type_t), stream));
+    computeDistances<<<gridDim, blockDim, 0, stream>>>(n, d, k, obs, centroids, work);
+    RAFT_CHECK_CUDA(stream);
+
+    RAFT_CUDA_TRY(cudaMemsetAsync(clusterSizes, 0, k * sizeof(index_type_t), stream));
+    assignAndBound<<<std::min(ceildiv<unsigned>(n, BLOCK_SIZE), grid_lower_bound),
+                     BLOCK_SIZE,
+                     0,
+                     stream>>>(
+      n, k, work, codes, clusterSizes, boundUpper.raw(), boundLower.raw());
+    RAFT_CHECK_CUDA(stream);
+
+    *residual_host = thrust::reduce(
+      thrust_exec_policy, thrust::device_pointer_cast(work), thrust::device_pointer_cast(work + n));
+    boundsValid = true;
+  };
+
   // Apply k-means iteration until convergence
   for (iter = 0; iter < maxiter; ++iter) {
+    // Keep the previous centroids around to measure drift
+    if (use_hamerly && boundsValid)
+      RAFT_CUDA_TRY(cudaMemcpyAsync(oldCentroids.raw(),
+                                    centroids,
+                                    d * k * sizeof(value_type_t),
+                                    cudaMemcpyDeviceToDevice,
+                                    stream));
+
     // Update cluster centroids
     if (updateCentroids(handle, n, d, k, obs, codes, clusterSizes, centroids, work, work_int))
       WARNING("could not update k-means centroids");
 
     // Determine centroid closest to each observation
     residualPrev = *residual_host;
-    if (assignCentroids(handle, n, d, k, obs, centroids, work, codes, clusterSizes, residual_host))
-      WARNING("could not assign observation vectors to k-means clusters");
+    if (!use_hamerly) {
+      if (assignCentroids(handle,
+                          n,
+                          d,
+                          k,
+                          obs,
+                          centroids,
+                          work,
+                          codes,
+                          clusterSizes,
+                          residualDev.raw(),
+                          residual_host,
+                          graph))
+        WARNING("could not assign observation vectors to k-means clusters");
+    } else if (!boundsValid) {
+      exactAssignBounded();
+    } else {
+      computeCentroidDrifts<<<std::min(ceildiv<unsigned>(k, BLOCK_SIZE), grid_lower_bound),
+                              BLOCK_SIZE,
+                              0,
+                              stream>>>(d, k, oldCentroids.raw(), centroids, drifts.raw());
+      RAFT_CHECK_CUDA(stream);
+      value_type_t maxDrift = thrust::reduce(thrust_exec_policy,
+                                             thrust::device_pointer_cast(drifts.raw()),
+                                             thrust::device_pointer_cast(drifts.raw() + k),
+                                             static_cast<value_type_t>(0),
+                                             thrust::maximum<value_type_t>());
+
+      RAFT_CUDA_TRY(cudaMemsetAsync(clusterSizes, 0, k * sizeof(index_type_t), stream));
+      hamerlyAssign<<<std::min(ceildiv<unsigned>(n, BLOCK_SIZE), grid_lower_bound),
+                      BLOCK_SIZE,
+                      0,
+                      stream>>>(n,
+                                d,
+                                k,
+                                obs,
+                                centroids,
+                                drifts.raw(),
+                                maxDrift,
+                                boundUpper.raw(),
+                                boundLower.raw(),
+                                codes,
+                                clusterSizes,
+                                work);
+      RAFT_CHECK_CUDA(stream);
+
+      *residual_host = thrust::reduce(thrust_exec_policy,
+                                      thrust::device_pointer_cast(work),
+                                      thrust::device_pointer_cast(work + n));
+    }
 
     // Reinitialize empty clusters with new centroids
     index_type_t emptyCentroid = (thrust::find(thrust_exec_policy,
@@ -893,8 +1620,21 @@ int kmeans(handle_t const& handle,
       if (chooseNewCentroid(
             handle, n, d, uniformDist(rng), obs, work, centroids + IDX(0, emptyCentroid, d)))
         WARNING("could not replace empty centroid");
-      if (assignCentroids(
-            handle, n, d, k, obs, centroids, work, codes, clusterSizes, residual_host))
+      // A reseeded centroid invalidates the bounds, so reinitialize them
+      if (use_hamerly) {
+        exactAssignBounded();
+      } else if (assignCentroids(handle,
+                                 n,
+                                 d,
+                                 k,
+                                 obs,
+                                 centroids,
+                                 work,
+                                 codes,
+                                 clusterSizes,
+                                 residualDev.raw(),
+                                 residual_host,
+                                 graph))
         WARNING("could not assign observation vectors to k-means clusters");
       emptyCentroid = (thrust::find(thrust_exec_policy,
                                     thrust::device_pointer_cast(clusterSizes),
@@ -941,6 +1681,15 @@ int kmeans(handle_t const& handle,
  *    of distances between observation vectors and centroids).
  *  @param iters on exit, number of k-means iterations.
  *  @param seed random seed to be used.
+ *  @param use_cuda_graph when true, capture the per-iteration assignment
+ *    kernels into a CUDA graph and replay it on subsequent iterations.
+ *  @param use_hamerly when true, maintain Hamerly-style distance bounds
+ *    across iterations and skip distance evaluation for points whose
+ *    assignment provably did not change.
+ *  @param use_hierarchical_init when true, choose the initial centroids
+ *    with a two-level balanced scheme instead of plain k-means++,
+ *    cutting the number of initialization passes from O(k) to
+ *    O(sqrt(k)).
  *  @return error flag
  */
 template <typename index_type_t, typename value_type_t>
@@ -954,7 +1703,10 @@ int kmeans(handle_t const& handle,
            index_type_t* __restrict__ codes,
            value_type_t& residual,
            index_type_t& iters,
-           unsigned long long seed = 123456)
+           unsigned long long seed    = 123456,
+           bool use_cuda_graph        = false,
+           bool use_hamerly           = false,
+           bool use_hierarchical_init = false)
 {
   // Check that parameters are valid
   RAFT_EXPECTS(n > 0, "invalid parameter (n<1)");
@@ -984,7 +1736,811 @@ int kmeans(handle_t const& handle,
                                             work_int.raw(),
                                             &residual,
                                             &iters,
-                                            seed);
+                                            seed,
+                                            use_cuda_graph,
+                                            use_hamerly,
+                                            use_hierarchical_init);
+}
+
+/**
+ *  @brief Run all Lloyd iterations inside one persistent kernel.
+ *    Intended for small problems (e.g. spectral embeddings, n x k with
+ *    small k) where per-iteration launch overhead dominates: the
+ *    centroid matrix is staged in shared memory and the whole
+ *    assignment/update loop runs in a single cooperative launch with
+ *    grid synchronization between phases. The grid must be fully
+ *    resident and dynamic shared memory must hold d*k centroid
+ *    entries. Empty clusters keep their previous centroid instead of
+ *    being reseeded.
+ *  @tparam index_type_t the type of data used for indexing.
+ *  @tparam value_type_t the type of data used for weights, distances.
+ *  @param n Number of observation vectors.
+ *  @param d Dimension of observation vectors.
+ *  @param k Number of clusters.
+ *  @param tol Tolerance for convergence.
+ *  @param maxiter Maximum number of k-means iterations.
+ *  @param obs (Input, d*n entries) Observation matrix, column-major.
+ *  @param codes (Output, n entries) Cluster assignments.
+ *  @param centroids (Input/output, d*k entries) Centroid matrix,
+ *    column-major. Must hold initial centroids on entry.
+ *  @param sums (Workspace, d*k entries) Per-cluster coordinate sums.
+ *  @param clusterSizes (Output, k entries) Number of points in each
+ *    cluster.
+ *  @param residual (Output, 2 entries) Residual sum of squares of the
+ *    final assignment, followed by a convergence flag (non-zero if the
+ *    iteration converged within maxiter steps).
+ *  @param iters (Output, 1 entry) Number of k-means iterations.
+ */
+template <typename index_type_t, typename value_type_t>
+static __global__ void __launch_bounds__(COOP_BLOCK_SIZE)
+  kmeansPersistentKernel(index_type_t n,
+                         index_type_t d,
+                         index_type_t k,
+                         value_type_t tol,
+                         index_type_t maxiter,
+                         const value_type_t* __restrict__ obs,
+                         index_type_t* __restrict__ codes,
+                         value_type_t* __restrict__ centroids,
+                         value_type_t* __restrict__ sums,
+                         index_type_t* __restrict__ clusterSizes,
+                         value_type_t* __restrict__ residual,
+                         index_type_t* __restrict__ iters)
+{
+  namespace cg        = cooperative_groups;
+  cg::grid_group grid = cg::this_grid();
+
+  // Centroid matrix staged in (dynamic) shared memory
+  extern __shared__ unsigned char kmeans_coop_smem[];
+  value_type_t* centroids_s = reinterpret_cast<value_type_t*>(kmeans_coop_smem);
+
+  // Block-level partial residual sums
+  __shared__ value_type_t residual_block[COOP_BLOCK_SIZE];
+
+  index_type_t rank     = static_cast<index_type_t>(grid.thread_rank());
+  index_type_t nthreads = static_cast<index_type_t>(grid.size());
+
+  value_type_t residualPrev = 0;
+  bool converged            = false;
+  index_type_t iter;
+  for (iter = 0; iter < maxiter; ++iter) {
+    // Stage current centroids into shared memory
+    for (index_type_t i = threadIdx.x; i < d * k; i += blockDim.x)
+      centroids_s[i] = centroids[i];
+
+    // Zero the global accumulators
+    for (index_type_t i = rank; i < d * k; i += nthreads)
+      sums[i] = 0;
+    for (index_type_t i = rank; i < k; i += nthreads)
+      clusterSizes[i] = 0;
+    if (rank == 0) *residual = 0;
+    __syncthreads();
+    grid.sync();
+
+    // Assign each point to the nearest centroid, accumulating cluster
+    // sizes and coordinate sums
+    value_type_t sum = 0;
+    for (index_type_t i = rank; i < n; i += nthreads) {
+      index_type_t code_min = 0;
+      value_type_t dist_min = 0;
+      for (index_type_t j = 0; j < k; ++j) {
+        value_type_t dist = 0;
+        for (index_type_t l = 0; l < d; ++l) {
+          value_type_t diff = obs[IDX(l, i, d)] - centroids_s[IDX(l, j, d)];
+          dist += diff * diff;
+        }
+        if (j == 0 || dist < dist_min) {
+          dist_min = dist;
+          code_min = j;
+        }
+      }
+      codes[i] = code_min;
+      sum += dist_min;
+      atomicAdd(clusterSizes + code_min, 1);
+      for (index_type_t l = 0; l < d; ++l)
+        atomicAdd(sums + IDX(l, code_min, d), obs[IDX(l, i, d)]);
+    }
+
+    // Reduce partial residual sums within block, one atomic per block
+    residual_block[threadIdx.x] = sum;
+    __syncthreads();
+    for (unsigned int s = blockDim.x / 2; s > 0; s /= 2) {
+      if (threadIdx.x < s) residual_block[threadIdx.x] += residual_block[threadIdx.x + s];
+      __syncthreads();
+    }
+    if (threadIdx.x == 0) atomicAdd(residual, residual_block[0]);
+    grid.sync();
+
+    // Update centroids; empty clusters keep their previous centroid
+    for (index_type_t i = rank; i < d * k; i += nthreads) {
+      index_type_t size = clusterSizes[i / d];
+      if (size > 0) centroids[i] = sums[i] / size;
+    }
+
+    // Convergence test; every thread sees the same values, so all
+    // threads take the same branch
+    value_type_t residualCurr = *residual;
+    if (iter > 0 && myAbs(residualPrev - residualCurr) / n < tol) {
+      converged = true;
+      ++iter;
+      break;
+    }
+    residualPrev = residualCurr;
+
+    // Centroid writes and the residual read above must complete before
+    // the next iteration stages centroids and zeroes the accumulators
+    grid.sync();
+  }
+
+  if (rank == 0) {
+    *iters      = iter;
+    residual[1] = converged ? 1 : 0;
+  }
+}
+
+/**
+ *  @brief Find clusters with k-means in a single persistent kernel.
+ *    Specialized for small problems, such as clustering an n x k
+ *    spectral embedding, where the per-iteration kernel launches of the
+ *    standard solver dominate the runtime: after the usual k-means++
+ *    initialization, all Lloyd iterations run inside one cooperative
+ *    kernel that keeps the centroids in shared memory. Falls back to
+ *    the standard solver when cooperative launch is unavailable or the
+ *    centroid matrix does not fit the resident grid's shared memory.
+ *    Unlike the standard solver, empty clusters keep their previous
+ *    centroid instead of being reseeded with k-means++.
+ *  @tparam index_type_t the type of data used for indexing.
+ *  @tparam value_type_t the type of data used for weights, distances.
+ *  @param handle the raft handle.
+ *  @param n Number of observation vectors.
+ *  @param d Dimension of observation vectors.
+ *  @param k Number of clusters.
+ *  @param tol Tolerance for convergence. k-means stops when the
+ *    change in residual divided by n is less than tol.
+ *  @param maxiter Maximum number of k-means iterations.
+ *  @param obs (Input, device memory, d*n entries) Observation
+ *    matrix. Matrix is stored column-major and each column is an
+ *    observation vector. Matrix dimensions are d x n.
+ *  @param codes (Output, device memory, n entries) Cluster
+ *    assignments.
+ *  @param residual On exit, residual sum of squares (sum of squares
+ *    of distances between observation vectors and centroids).
+ *  @param iters on exit, number of k-means iterations.
+ *  @param seed random seed to be used.
+ *  @return error flag
+ */
+template <typename index_type_t, typename value_type_t>
+int kmeans_persistent(handle_t const& handle,
+                      index_type_t n,
+                      index_type_t d,
+                      index_type_t k,
+                      value_type_t tol,
+                      index_type_t maxiter,
+                      const value_type_t* __restrict__ obs,
+                      index_type_t* __restrict__ codes,
+                      value_type_t& residual,
+                      index_type_t& iters,
+                      unsigned long long seed = 123456)
+{
+  // Check that parameters are valid
+  RAFT_EXPECTS(n > 0, "invalid parameter (n<1)");
+  RAFT_EXPECTS(d > 0, "invalid parameter (d<1)");
+  RAFT_EXPECTS(k > 0, "invalid parameter (k<1)");
+  RAFT_EXPECTS(tol > 0, "invalid parameter (tol<=0)");
+  RAFT_EXPECTS(maxiter >= 0, "invalid parameter (maxiter<0)");
+
+  // The cooperative grid must be fully resident with the centroid
+  // matrix in shared memory; degenerate problems and devices without
+  // cooperative launch use the standard solver
+  int dev_id, supports_coop;
+  RAFT_CUDA_TRY(cudaGetDevice(&dev_id));
+  RAFT_CUDA_TRY(cudaDeviceGetAttribute(&supports_coop, cudaDevAttrCooperativeLaunch, dev_id));
+  size_t smem       = static_cast<size_t>(d) * k * sizeof(value_type_t);
+  int blocks_per_sm = 0;
+  if (supports_coop && cudaOccupancyMaxActiveBlocksPerMultiprocessor(
+                         &blocks_per_sm,
+                         kmeansPersistentKernel<index_type_t, value_type_t>,
+                         COOP_BLOCK_SIZE,
+                         smem) != cudaSuccess) {
+    cudaGetLastError();  // clear the error; occupancy failure means fallback
+    blocks_per_sm = 0;
+  }
+  if (k == 1 || n <= k || maxiter == 0 || !supports_coop || blocks_per_sm < 1) {
+    return kmeans<index_type_t, value_type_t>(
+      handle, n, d, k, tol, maxiter, obs, codes, residual, iters, seed);
+  }
+
+  auto stream = handle.get_stream();
+
+  // Workspace. The distance buffer is only needed by the k-means++
+  // initialization, which requires 2*n entries.
+  raft::spectral::matrix::vector_t<value_type_t> centroids(handle, d * k);
+  raft::spectral::matrix::vector_t<value_type_t> sums(handle, d * k);
+  raft::spectral::matrix::vector_t<value_type_t> dists(
+    handle, n * std::max(k, static_cast<index_type_t>(2)));
+  raft::spectral::matrix::vector_t<index_type_t> clusterSizes(handle, k);
+  raft::spectral::matrix::vector_t<value_type_t> residualDev(handle, 2);
+  raft::spectral::matrix::vector_t<index_type_t> itersDev(handle, 1);
+
+  // Choose initial cluster centroids (multi-kernel, but runs only once)
+  if (initializeCentroids(
+        handle, n, d, k, obs, centroids.raw(), codes, clusterSizes.raw(), dists.raw(), seed))
+    WARNING("could not initialize k-means centroids");
+
+  // Fully resident cooperative grid
+  index_type_t max_blocks =
+    static_cast<index_type_t>(blocks_per_sm) * raft::getMultiProcessorCount();
+  dim3 blocks(std::min(ceildiv<index_type_t>(n, COOP_BLOCK_SIZE), max_blocks));
+  dim3 threads(COOP_BLOCK_SIZE);
+
+  const value_type_t* obs_arg     = obs;
+  index_type_t* codes_arg         = codes;
+  value_type_t* centroids_arg     = centroids.raw();
+  value_type_t* sums_arg          = sums.raw();
+  index_type_t* clusterSizes_arg  = clusterSizes.raw();
+  value_type_t* residual_arg      = residualDev.raw();
+  index_type_t* iters_arg         = itersDev.raw();
+  void* args[] = {&n,
+                  &d,
+                  &k,
+                  &tol,
+                  &maxiter,
+                  &obs_arg,
+                  &codes_arg,
+                  &centroids_arg,
+                  &sums_arg,
+                  &clusterSizes_arg,
+                  &residual_arg,
+                  &iters_arg};
+  RAFT_CUDA_TRY(cudaLaunchCooperativeKernel(
+    reinterpret_cast<void*>(kmeansPersistentKernel<index_type_t, value_type_t>),
+    blocks,
+    threads,
+    args,
+    smem,
+    stream));
+  RAFT_CHECK_CUDA(stream);
+
+  value_type_t convergedFlag = 0;
+  raft::update_host(&residual, residualDev.raw(), 1, stream);
+  raft::update_host(&convergedFlag, residualDev.raw() + 1, 1, stream);
+  raft::update_host(&iters, itersDev.raw(), 1, stream);
+  RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+
+  // Warning if k-means has failed to converge
+  if (convergedFlag == 0) WARNING("k-means failed to converge");
+
+  return 0;
+}
+
+/**
+ *  @brief Find clusters with mini-batch k-means algorithm.
+ *    Each step samples batchSize observation vectors with replacement,
+ *    assigns them to the nearest centroid and moves each centroid
+ *    towards its batch mean with a per-cluster decaying learning rate
+ *    (cf. Sculley, "Web-scale k-means clustering", WWW 2010). No step
+ *    touches more than batchSize observation vectors, so the algorithm
+ *    converges without full passes over the data; a single tiled pass
+ *    at the end produces the final assignments and residual. Initial
+ *    centroids are chosen with the k-means++ algorithm on the first
+ *    sampled batch.
+ *  @tparam index_type_t the type of data used for indexing.
+ *  @tparam value_type_t the type of data used for weights, distances.
+ *  @param handle the raft handle.
+ *  @param n Number of observation vectors.
+ *  @param d Dimension of observation vectors.
+ *  @param k Number of clusters.
+ *  @param batchSize Number of observation vectors sampled per step.
+ *  @param tol Tolerance for convergence. The iteration stops when the
+ *    change in batch residual divided by batchSize is less than tol.
+ *  @param maxiter Maximum number of mini-batch steps.
+ *  @param obs (Input, device-accessible memory, d*n entries)
+ *    Observation matrix. Matrix is stored column-major and each column
+ *    is an observation vector. Matrix dimensions are d x n. The matrix
+ *    only needs to be device-accessible (e.g. managed or pinned host
+ *    memory), since every step reads just the sampled columns.
+ *  @param codes (Output, device memory, n entries) Cluster
+ *    assignments.
+ *  @param residual On exit, residual sum of squares (sum of squares
+ *    of distances between observation vectors and centroids).
+ *  @param iters on exit, number of mini-batch steps.
+ *  @param seed random seed to be used.
+ *  @return error flag
+ */
+template <typename index_type_t, typename value_type_t>
+int kmeans_minibatch(handle_t const& handle,
+                     index_type_t n,
+                     index_type_t d,
+                     index_type_t k,
+                     index_type_t batchSize,
+                     value_type_t tol,
+                     index_type_t maxiter,
+                     const value_type_t* __restrict__ obs,
+                     index_type_t* __restrict__ codes,
+                     value_type_t& residual,
+                     index_type_t& iters,
+                     unsigned long long seed = 123456)
+{
+  // Check that parameters are valid
+  RAFT_EXPECTS(n > 0, "invalid parameter (n<1)");
+  RAFT_EXPECTS(d > 0, "invalid parameter (d<1)");
+  RAFT_EXPECTS(k > 0, "invalid parameter (k<1)");
+  RAFT_EXPECTS(batchSize > 0, "invalid parameter (batchSize<1)");
+  RAFT_EXPECTS(tol > 0, "invalid parameter (tol<=0)");
+  RAFT_EXPECTS(maxiter >= 0, "invalid parameter (maxiter<0)");
+
+  // Small problems do not benefit from sampling: solve them exactly
+  if (n <= batchSize) {
+    return kmeans<index_type_t, value_type_t>(
+      handle, n, d, k, tol, maxiter, obs, codes, residual, iters, seed);
+  }
+
+  auto stream = handle.get_stream();
+
+  constexpr unsigned grid_lower_bound{65535};
+
+  // Workspace. The distance buffer is also used as the k-means++
+  // workspace, which needs 2*batchSize entries.
+  raft::spectral::matrix::vector_t<value_type_t> batch(handle, d * batchSize);
+  raft::spectral::matrix::vector_t<value_type_t> dists(
+    handle, batchSize * std::max(k, static_cast<index_type_t>(2)));
+  raft::spectral::matrix::vector_t<value_type_t> sums(handle, d * k);
+  raft::spectral::matrix::vector_t<value_type_t> centroids(handle, d * k);
+  raft::spectral::matrix::vector_t<index_type_t> batchIndices(handle, batchSize);
+  raft::spectral::matrix::vector_t<index_type_t> batchCodes(handle, batchSize);
+  raft::spectral::matrix::vector_t<index_type_t> batchClusterSizes(handle, k);
+  raft::spectral::matrix::vector_t<index_type_t> counts(handle, k);
+  raft::spectral::matrix::vector_t<value_type_t> residualDev(handle, 1);
+
+  raft::random::Rng rng(seed);
+
+  // CUDA grid dimensions
+  dim3 blockDim_2d{WARP_SIZE, BSIZE_DIV_WSIZE, 1};
+  dim3 gridDim_gather{std::min(ceildiv<unsigned>(d, WARP_SIZE), grid_lower_bound),
+                      std::min(ceildiv<unsigned>(batchSize, BSIZE_DIV_WSIZE), grid_lower_bound),
+                      1};
+  dim3 gridDim_update{std::min(ceildiv<unsigned>(d, WARP_SIZE), grid_lower_bound),
+                      std::min(ceildiv<unsigned>(k, BSIZE_DIV_WSIZE), grid_lower_bound),
+                      1};
+  dim3 blockDim_warp{WARP_SIZE, 1, BSIZE_DIV_WSIZE};
+  dim3 gridDim_warp{std::min(ceildiv<unsigned>(d, WARP_SIZE), grid_lower_bound),
+                    std::min(static_cast<unsigned>(k), grid_lower_bound),
+                    std::min(ceildiv<unsigned>(batchSize, BSIZE_DIV_WSIZE), grid_lower_bound)};
+  dim3 gridDim_block{std::min(ceildiv<unsigned>(batchSize, BLOCK_SIZE), grid_lower_bound), 1, 1};
+
+  // Choose initial centroids with k-means++ on the first sampled batch
+  rng.uniformInt<index_type_t>(batchIndices.raw(), batchSize, 0, n, stream);
+  gatherBatch<<<gridDim_gather, blockDim_2d, 0, stream>>>(
+    d, batchSize, obs, batchIndices.raw(), batch.raw());
+  RAFT_CHECK_CUDA(stream);
+
+  if (initializeCentroids(handle,
+                          batchSize,
+                          d,
+                          k,
+                          batch.raw(),
+                          centroids.raw(),
+                          batchCodes.raw(),
+                          batchClusterSizes.raw(),
+                          dists.raw(),
+                          seed))
+    WARNING("could not initialize k-means centroids");
+
+  RAFT_CUDA_TRY(cudaMemsetAsync(counts.raw(), 0, k * sizeof(index_type_t), stream));
+
+  // Residual of the previous batch
+  value_type_t residualPrev = 0;
+  residual                  = 0;
+
+  // Apply mini-batch steps until the batch residual settles
+  index_type_t iter;
+  for (iter = 0; iter < maxiter; ++iter) {
+    // Sample a batch with replacement
+    rng.uniformInt<index_type_t>(batchIndices.raw(), batchSize, 0, n, stream);
+    gatherBatch<<<gridDim_gather, blockDim_2d, 0, stream>>>(
+      d, batchSize, obs, batchIndices.raw(), batch.raw());
+    RAFT_CHECK_CUDA(stream);
+
+    // Assign batch points to nearest centroids
+    RAFT_CUDA_TRY(cudaMemsetAsync(dists.raw(), 0, batchSize * k * sizeof(value_type_t), stream));
+    computeDistances<<<gridDim_warp, blockDim_warp, 0, stream>>>(
+      batchSize, d, k, batch.raw(), centroids.raw(), dists.raw());
+    RAFT_CHECK_CUDA(stream);
+    RAFT_CUDA_TRY(
+      cudaMemsetAsync(batchClusterSizes.raw(), 0, k * sizeof(index_type_t), stream));
+    RAFT_CUDA_TRY(cudaMemsetAsync(residualDev.raw(), 0, sizeof(value_type_t), stream));
+    minDistances<<<gridDim_block, BLOCK_SIZE, 0, stream>>>(
+      batchSize, k, dists.raw(), batchCodes.raw(), batchClusterSizes.raw(), residualDev.raw());
+    RAFT_CHECK_CUDA(stream);
+
+    // Batch residual sum of squares, accumulated in the assignment kernel
+    residualPrev = residual;
+    raft::update_host(&residual, residualDev.raw(), 1, stream);
+    RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+
+    // Move centroids towards batch means with decaying learning rates
+    RAFT_CUDA_TRY(cudaMemsetAsync(sums.raw(), 0, d * k * sizeof(value_type_t), stream));
+    accumulateBatchSums<<<gridDim_gather, blockDim_2d, 0, stream>>>(
+      d, batchSize, batch.raw(), batchCodes.raw(), sums.raw());
+    RAFT_CHECK_CUDA(stream);
+    applyMiniBatchUpdate<<<gridDim_update, blockDim_2d, 0, stream>>>(
+      d, k, batchClusterSizes.raw(), sums.raw(), counts.raw(), centroids.raw());
+    RAFT_CHECK_CUDA(stream);
+    updateSampleCounts<<<std::min(ceildiv<unsigned>(k, BLOCK_SIZE), grid_lower_bound),
+                         BLOCK_SIZE,
+                         0,
+                         stream>>>(k, batchClusterSizes.raw(), counts.raw());
+    RAFT_CHECK_CUDA(stream);
+
+    // Check for convergence of the (noisy) batch residual
+    if (iter > 0 && std::fabs(residualPrev - residual) / batchSize < tol) {
+      ++iter;
+      break;
+    }
+  }
+  iters = iter;
+
+  // Final tiled pass: assign all observation vectors, batchSize columns
+  // at a time; the residual accumulates across chunks in the device
+  // scalar and is read back once
+  RAFT_CUDA_TRY(cudaMemsetAsync(residualDev.raw(), 0, sizeof(value_type_t), stream));
+  for (index_type_t start = 0; start < n; start += batchSize) {
+    index_type_t cur = std::min(batchSize, n - start);
+
+    dim3 gridDim_assign{std::min(ceildiv<unsigned>(d, WARP_SIZE), grid_lower_bound),
+                        std::min(static_cast<unsigned>(k), grid_lower_bound),
+                        std::min(ceildiv<unsigned>(cur, BSIZE_DIV_WSIZE), grid_lower_bound)};
+
+    RAFT_CUDA_TRY(cudaMemsetAsync(dists.raw(), 0, cur * k * sizeof(value_type_t), stream));
+    computeDistances<<<gridDim_assign, blockDim_warp, 0, stream>>>(
+      cur, d, k, obs + IDX(0, start, d), centroids.raw(), dists.raw());
+    RAFT_CHECK_CUDA(stream);
+    minDistances<<<std::min(ceildiv<unsigned>(cur, BLOCK_SIZE), grid_lower_bound),
+                   BLOCK_SIZE,
+                   0,
+                   stream>>>(
+      cur, k, dists.raw(), codes + start, batchClusterSizes.raw(), residualDev.raw());
+    RAFT_CHECK_CUDA(stream);
+  }
+  raft::update_host(&residual, residualDev.raw(), 1, stream);
+  RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+
+  return 0;
+}
+
+/**
+ *  @brief Randomly choose a new centroid across all ranks.
+ *    Every rank draws the same random number, so all ranks agree on
+ *    which rank owns the chosen observation vector: the per-rank
+ *    distance masses are allgathered and the shared draw selects a
+ *    rank proportionally to its mass, after which the owner picks the
+ *    point locally (k-means++ weighting) and broadcasts the centroid.
+ *  @tparam index_type_t the type of data used for indexing.
+ *  @tparam value_type_t the type of data used for weights, distances.
+ *  @param handle the raft handle. Must have an initialized communicator.
+ *  @param n Number of local observation vectors.
+ *  @param d Dimension of observation vectors.
+ *  @param rand Random number drawn uniformly from [0,1). Must be the
+ *    same on every rank.
+ *  @param obs (Input, device memory, d*n entries) Local observation
+ *    matrix. Matrix is stored column-major.
+ *  @param dists (Input, device memory, 2*n entries) Workspace. The
+ *    first n entries should be the distance between local observation
+ *    vectors and the closest centroid.
+ *  @param centroid (Output, device memory, d entries) Centroid
+ *    coordinates; identical on every rank on exit.
+ *  @param rankMasses (Output, device memory, nRanks+1 entries)
+ *    Workspace for the allgathered per-rank distance masses.
+ *  @return Zero if successful. Otherwise non-zero.
+ */
+template <typename index_type_t, typename value_type_t>
+static int chooseNewCentroidDistributed(handle_t const& handle,
+                                        index_type_t n,
+                                        index_type_t d,
+                                        value_type_t rand,
+                                        const value_type_t* __restrict__ obs,
+                                        value_type_t* __restrict__ dists,
+                                        value_type_t* __restrict__ centroid,
+                                        value_type_t* __restrict__ rankMasses)
+{
+  auto stream             = handle.get_stream();
+  auto thrust_exec_policy = handle.get_thrust_policy();
+  auto const& comm        = handle.get_comms();
+  int nRanks              = comm.get_size();
+  int rank                = comm.get_rank();
+
+  // Local distance mass
+  value_type_t localMass = thrust::reduce(
+    thrust_exec_policy, thrust::device_pointer_cast(dists), thrust::device_pointer_cast(dists + n));
+  RAFT_CHECK_CUDA(stream);
+
+  // Gather all per-rank masses; the last entry of the workspace is the
+  // send slot
+  raft::update_device(rankMasses + nRanks, &localMass, 1, stream);
+  comm.allgather(rankMasses + nRanks, rankMasses, 1, stream);
+
+  std::vector<value_type_t> masses_host(nRanks);
+  raft::update_host(masses_host.data(), rankMasses, nRanks, stream);
+  if (comm.sync_stream(stream) != comms::status_t::SUCCESS)
+    WARNING("distributed k-means++ rank selection failed");
+
+  // Select the owning rank proportionally to its mass; every rank computes
+  // the same answer from the same draw
+  value_type_t totalMass = 0;
+  for (int r = 0; r < nRanks; ++r)
+    totalMass += masses_host[r];
+
+  int owner             = 0;
+  value_type_t ownerRand = rand;
+  if (totalMass > 0) {
+    value_type_t target = rand * totalMass;
+    value_type_t cumsum = 0;
+    for (owner = 0; owner < nRanks - 1; ++owner) {
+      if (cumsum + masses_host[owner] > target) break;
+      cumsum += masses_host[owner];
+    }
+    ownerRand = (masses_host[owner] > 0) ? (target - cumsum) / masses_host[owner] : 0;
+  }
+
+  // The owner picks the observation vector locally, then shares it
+  if (rank == owner) {
+    if (chooseNewCentroid(handle, n, d, ownerRand, obs, dists, centroid))
+      WARNING("error in k-means++ (could not pick centroid)");
+  }
+  comm.bcast(centroid, d, owner, stream);
+
+  return 0;
+}
+
+/**
+ *  @brief Find clusters with k-means algorithm across multiple ranks.
+ *    Each rank holds a shard of the observation vectors and computes
+ *    local assignments and partial centroid sums; the sums and cluster
+ *    sizes are combined with comms_t::allreduce so every rank holds
+ *    identical centroids. Initial centroids are chosen with a
+ *    distributed k-means++ scheme: all ranks share the random draw for
+ *    every pick, the owning rank is selected proportionally to its
+ *    distance mass and the chosen centroid is broadcast. Empty
+ *    clusters are reseeded the same way.
+ *  @tparam index_type_t the type of data used for indexing.
+ *  @tparam value_type_t the type of data used for weights, distances.
+ *  @param handle the raft handle. Must have an initialized communicator
+ *    (cf. raft/comms/comms.hpp); every rank must call with the same k,
+ *    d, tol, maxiter and seed.
+ *  @param n Number of local observation vectors (may differ per rank,
+ *    must be positive).
+ *  @param d Dimension of observation vectors.
+ *  @param k Number of clusters.
+ *  @param tol Tolerance for convergence. k-means stops when the
+ *    change in global residual divided by the global number of
+ *    observation vectors is less than tol.
+ *  @param maxiter Maximum number of k-means iterations.
+ *  @param obs (Input, device memory, d*n entries) Local observation
+ *    matrix. Matrix is stored column-major and each column is an
+ *    observation vector. Matrix dimensions are d x n.
+ *  @param codes (Output, device memory, n entries) Cluster
+ *    assignments of the local observation vectors.
+ *  @param centroids (Output, device memory, d*k entries) Centroid
+ *    matrix, identical on every rank. Matrix is stored column-major.
+ *  @param residual On exit, global residual sum of squares.
+ *  @param iters on exit, number of k-means iterations.
+ *  @param seed random seed to be used. Must be the same on every rank.
+ *  @return error flag
+ */
+template <typename index_type_t, typename value_type_t>
+int kmeans_distributed(handle_t const& handle,
+                       index_type_t n,
+                       index_type_t d,
+                       index_type_t k,
+                       value_type_t tol,
+                       index_type_t maxiter,
+                       const value_type_t* __restrict__ obs,
+                       index_type_t* __restrict__ codes,
+                       value_type_t* __restrict__ centroids,
+                       value_type_t& residual,
+                       index_type_t& iters,
+                       unsigned long long seed = 123456)
+{
+  // Check that parameters are valid
+  RAFT_EXPECTS(n > 0, "invalid parameter (n<1)");
+  RAFT_EXPECTS(d > 0, "invalid parameter (d<1)");
+  RAFT_EXPECTS(k > 0, "invalid parameter (k<1)");
+  RAFT_EXPECTS(tol > 0, "invalid parameter (tol<=0)");
+  RAFT_EXPECTS(maxiter >= 0, "invalid parameter (maxiter<0)");
+
+  auto stream             = handle.get_stream();
+  auto thrust_exec_policy = handle.get_thrust_policy();
+  auto const& comm        = handle.get_comms();
+  int nRanks              = comm.get_size();
+
+  constexpr unsigned grid_lower_bound{65535};
+
+  // Random number generator; all ranks share the sequence
+  thrust::default_random_engine rng(seed);
+  thrust::uniform_real_distribution<value_type_t> uniformDist(0, 1);
+
+  // Workspace. The distance buffer doubles as the k-means++ workspace,
+  // which needs 2*n entries.
+  raft::spectral::matrix::vector_t<value_type_t> dists(
+    handle, n * std::max(k, static_cast<index_type_t>(2)));
+  raft::spectral::matrix::vector_t<value_type_t> sums(handle, d * k);
+  raft::spectral::matrix::vector_t<value_type_t> rankMasses(handle, nRanks + 1);
+  raft::spectral::matrix::vector_t<index_type_t> clusterSizes(handle, k);
+  raft::spectral::matrix::vector_t<index_type_t> globalSizes(handle, k);
+  raft::spectral::matrix::vector_t<value_type_t> residualDev(handle, 1);
+
+  // Global number of observation vectors, for the convergence test
+  raft::spectral::matrix::vector_t<index_type_t> nGlobal_dev(handle, 1);
+  raft::update_device(nGlobal_dev.raw(), &n, 1, stream);
+  comm.allreduce(nGlobal_dev.raw(), nGlobal_dev.raw(), 1, comms::op_t::SUM, stream);
+  index_type_t nGlobal = 0;
+  raft::update_host(&nGlobal, nGlobal_dev.raw(), 1, stream);
+  if (comm.sync_stream(stream) != comms::status_t::SUCCESS)
+    WARNING("could not compute global observation count");
+
+  // Sums the local residual over all ranks
+  auto allreduceResidual = [&](value_type_t local) {
+    raft::update_device(rankMasses.raw(), &local, 1, stream);
+    comm.allreduce(rankMasses.raw(), rankMasses.raw(), 1, comms::op_t::SUM, stream);
+    value_type_t global = 0;
+    raft::update_host(&global, rankMasses.raw(), 1, stream);
+    if (comm.sync_stream(stream) != comms::status_t::SUCCESS)
+      WARNING("could not reduce k-means residual");
+    return global;
+  };
+
+  // CUDA grid dimensions
+  dim3 blockDim_2d{WARP_SIZE, BSIZE_DIV_WSIZE, 1};
+  dim3 gridDim_2d{std::min(ceildiv<unsigned>(d, WARP_SIZE), grid_lower_bound),
+                  std::min(ceildiv<unsigned>(n, BSIZE_DIV_WSIZE), grid_lower_bound),
+                  1};
+  dim3 blockDim_warp{WARP_SIZE, 1, BSIZE_DIV_WSIZE};
+  dim3 gridDim_warp{std::min(ceildiv<unsigned>(d, WARP_SIZE), grid_lower_bound),
+                    1,
+                    std::min(ceildiv<unsigned>(n, BSIZE_DIV_WSIZE), grid_lower_bound)};
+  dim3 gridDim_centroid{std::min(ceildiv<unsigned>(d, WARP_SIZE), grid_lower_bound),
+                        std::min(ceildiv<unsigned>(k, BSIZE_DIV_WSIZE), grid_lower_bound),
+                        1};
+
+  // -------------------------------------------------------
+  // Distributed k-means++ initialization
+  // -------------------------------------------------------
+
+  // Assign observation vectors to code 0
+  RAFT_CUDA_TRY(cudaMemsetAsync(codes, 0, n * sizeof(index_type_t), stream));
+
+  // Choose first centroid uniformly across all ranks
+  thrust::fill(thrust_exec_policy,
+               thrust::device_pointer_cast(dists.raw()),
+               thrust::device_pointer_cast(dists.raw() + n),
+               1);
+  RAFT_CHECK_CUDA(stream);
+  chooseNewCentroidDistributed(
+    handle, n, d, uniformDist(rng), obs, dists.raw(), centroids, rankMasses.raw());
+
+  // Compute distances from first centroid
+  RAFT_CUDA_TRY(cudaMemsetAsync(dists.raw(), 0, n * sizeof(value_type_t), stream));
+  computeDistances<<<gridDim_warp, blockDim_warp, 0, stream>>>(
+    n, d, 1, obs, centroids, dists.raw());
+  RAFT_CHECK_CUDA(stream);
+
+  // Choose remaining centroids
+  for (index_type_t i = 1; i < k; ++i) {
+    chooseNewCentroidDistributed(
+      handle, n, d, uniformDist(rng), obs, dists.raw(), centroids + IDX(0, i, d), rankMasses.raw());
+
+    // Compute distances from ith centroid
+    RAFT_CUDA_TRY(cudaMemsetAsync(dists.raw() + n, 0, n * sizeof(value_type_t), stream));
+    computeDistances<<<gridDim_warp, blockDim_warp, 0, stream>>>(
+      n, d, 1, obs, centroids + IDX(0, i, d), dists.raw() + n);
+    RAFT_CHECK_CUDA(stream);
+
+    // Recompute minimum distances
+    minDistances2<<<std::min(ceildiv<unsigned>(n, BLOCK_SIZE), grid_lower_bound),
+                    BLOCK_SIZE,
+                    0,
+                    stream>>>(n, dists.raw(), dists.raw() + n, codes, i);
+    RAFT_CHECK_CUDA(stream);
+  }
+
+  // Initial local assignment
+  value_type_t residualLocal = 0;
+  if (assignCentroids(handle,
+                      n,
+                      d,
+                      k,
+                      obs,
+                      centroids,
+                      dists.raw(),
+                      codes,
+                      clusterSizes.raw(),
+                      residualDev.raw(),
+                      &residualLocal))
+    WARNING("could not assign observation vectors to k-means clusters");
+  residual = allreduceResidual(residualLocal);
+
+  // Residual sum of squares at previous iteration
+  value_type_t residualPrev = 0;
+
+  // Apply k-means iteration until convergence
+  index_type_t iter;
+  for (iter = 0; iter < maxiter; ++iter) {
+    // Update cluster centroids: allreduce partial sums and sizes
+    RAFT_CUDA_TRY(cudaMemsetAsync(sums.raw(), 0, d * k * sizeof(value_type_t), stream));
+    accumulateBatchSums<<<gridDim_2d, blockDim_2d, 0, stream>>>(
+      d, n, obs, codes, sums.raw());
+    RAFT_CHECK_CUDA(stream);
+    comm.allreduce(sums.raw(), centroids, d * k, comms::op_t::SUM, stream);
+    comm.allreduce(clusterSizes.raw(), globalSizes.raw(), k, comms::op_t::SUM, stream);
+    divideCentroids<<<gridDim_centroid, blockDim_2d, 0, stream>>>(
+      d, k, globalSizes.raw(), centroids);
+    RAFT_CHECK_CUDA(stream);
+
+    // Determine centroid closest to each local observation
+    residualPrev = residual;
+    if (assignCentroids(handle,
+                        n,
+                        d,
+                        k,
+                        obs,
+                        centroids,
+                        dists.raw(),
+                        codes,
+                        clusterSizes.raw(),
+                        residualDev.raw(),
+                        &residualLocal))
+      WARNING("could not assign observation vectors to k-means clusters");
+    residual = allreduceResidual(residualLocal);
+    comm.allreduce(clusterSizes.raw(), globalSizes.raw(), k, comms::op_t::SUM, stream);
+
+    // Reinitialize globally empty clusters with new centroids
+    index_type_t emptyCentroid = (thrust::find(thrust_exec_policy,
+                                               thrust::device_pointer_cast(globalSizes.raw()),
+                                               thrust::device_pointer_cast(globalSizes.raw() + k),
+                                               0) -
+                                  thrust::device_pointer_cast(globalSizes.raw()));
+    while (emptyCentroid < k) {
+      chooseNewCentroidDistributed(handle,
+                                   n,
+                                   d,
+                                   uniformDist(rng),
+                                   obs,
+                                   dists.raw(),
+                                   centroids + IDX(0, emptyCentroid, d),
+                                   rankMasses.raw());
+      if (assignCentroids(handle,
+                          n,
+                          d,
+                          k,
+                          obs,
+                          centroids,
+                          dists.raw(),
+                          codes,
+                          clusterSizes.raw(),
+                          residualDev.raw(),
+                          &residualLocal))
+        WARNING("could not assign observation vectors to k-means clusters");
+      residual = allreduceResidual(residualLocal);
+      comm.allreduce(clusterSizes.raw(), globalSizes.raw(), k, comms::op_t::SUM, stream);
+      emptyCentroid = (thrust::find(thrust_exec_policy,
+                                    thrust::device_pointer_cast(globalSizes.raw()),
+                                    thrust::device_pointer_cast(globalSizes.raw() + k),
+                                    0) -
+                       thrust::device_pointer_cast(globalSizes.raw()));
+      RAFT_CHECK_CUDA(stream);
+    }
+
+    // Check for convergence
+    if (std::fabs(residualPrev - residual) / nGlobal < tol) {
+      ++iter;
+      break;
+    }
+  }
+
+  // Warning if k-means has failed to converge
+  if (std::fabs(residualPrev - residual) / nGlobal >= tol) WARNING("k-means failed to converge");
+
+  iters = iter;
+  return 0;
 }
 
 }  // namespace detail
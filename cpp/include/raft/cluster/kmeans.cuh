@@ -16,6 +16,7 @@
 #pragma once
 
 #include <raft/cluster/detail/kmeans.cuh>
+#include <raft/core/nvtx.hpp>
 
 namespace raft {
 namespace cluster {
@@ -43,6 +44,21 @@ namespace cluster {
  *    of distances between observation vectors and centroids).
  *  @param iters on exit, number of k-means iterations.
  *  @param seed random seed to be used.
+ *  @param use_cuda_graph when true, the per-iteration assignment kernels are
+ *    captured into a CUDA graph on the first iteration and replayed on
+ *    subsequent ones, cutting CPU launch overhead for small-batch fits.
+ *  @param use_hamerly when true, maintain Hamerly-style distance bounds
+ *    across iterations and skip distance evaluation for points whose
+ *    assignment provably did not change; the residual becomes an upper
+ *    bound, which only affects the convergence test. Most effective on
+ *    well-separated clusters in late iterations.
+ *  @param use_hierarchical_init when true, choose the initial centroids
+ *    with a two-level balanced scheme: observation vectors are first
+ *    grouped around sqrt(k) coarse centroids with k-means++, then the k
+ *    centroids are apportioned to groups by size and chosen by k-means++
+ *    within each group. Cuts the number of initialization passes from
+ *    O(k) to O(sqrt(k)), which dominates the fit for large k (e.g.
+ *    coarse quantizer sizing).
  *  @return error flag
  */
 template <typename index_type_t, typename value_type_t>
@@ -56,10 +72,185 @@ int kmeans(handle_t const& handle,
            index_type_t* __restrict__ codes,
            value_type_t& residual,
            index_type_t& iters,
-           unsigned long long seed = 123456)
+           unsigned long long seed    = 123456,
+           bool use_cuda_graph        = false,
+           bool use_hamerly           = false,
+           bool use_hierarchical_init = false)
 {
-  return detail::kmeans<index_type_t, value_type_t>(
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "cluster::kmeans (%d, %d, %d)", int(n), int(d), int(k));
+  return detail::kmeans<index_type_t, value_type_t>(handle,
+                                                    n,
+                                                    d,
+                                                    k,
+                                                    tol,
+                                                    maxiter,
+                                                    obs,
+                                                    codes,
+                                                    residual,
+                                                    iters,
+                                                    seed,
+                                                    use_cuda_graph,
+                                                    use_hamerly,
+                                                    use_hierarchical_init);
+}
+
+/**
+ *  @brief Find clusters with k-means in a single persistent kernel.
+ *    Specialized for small problems, such as clustering an n x k
+ *    spectral embedding, where the per-iteration kernel launches of
+ *    the standard solver dominate the runtime: after the usual
+ *    k-means++ initialization, all Lloyd iterations run inside one
+ *    cooperative kernel that keeps the centroids in shared memory.
+ *    Falls back to the standard solver when cooperative launch is
+ *    unavailable or the centroid matrix does not fit the resident
+ *    grid's shared memory. Unlike the standard solver, empty clusters
+ *    keep their previous centroid instead of being reseeded.
+ *  @tparam index_type_t the type of data used for indexing.
+ *  @tparam value_type_t the type of data used for weights, distances.
+ *  @param handle the raft handle.
+ *  @param n Number of observation vectors.
+ *  @param d Dimension of observation vectors.
+ *  @param k Number of clusters.
+ *  @param tol Tolerance for convergence. k-means stops when the
+ *    change in residual divided by n is less than tol.
+ *  @param maxiter Maximum number of k-means iterations.
+ *  @param obs (Input, device memory, d*n entries) Observation
+ *    matrix. Matrix is stored column-major and each column is an
+ *    observation vector. Matrix dimensions are d x n.
+ *  @param codes (Output, device memory, n entries) Cluster
+ *    assignments.
+ *  @param residual On exit, residual sum of squares (sum of squares
+ *    of distances between observation vectors and centroids).
+ *  @param iters on exit, number of k-means iterations.
+ *  @param seed random seed to be used.
+ *  @return error flag
+ */
+template <typename index_type_t, typename value_type_t>
+int kmeans_persistent(handle_t const& handle,
+                      index_type_t n,
+                      index_type_t d,
+                      index_type_t k,
+                      value_type_t tol,
+                      index_type_t maxiter,
+                      const value_type_t* __restrict__ obs,
+                      index_type_t* __restrict__ codes,
+                      value_type_t& residual,
+                      index_type_t& iters,
+                      unsigned long long seed = 123456)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "cluster::kmeans_persistent (%d, %d, %d)", int(n), int(d), int(k));
+  return detail::kmeans_persistent<index_type_t, value_type_t>(
     handle, n, d, k, tol, maxiter, obs, codes, residual, iters, seed);
 }
+
+/**
+ *  @brief Find clusters with mini-batch k-means algorithm.
+ *    Each step samples batchSize observation vectors with replacement,
+ *    assigns them to the nearest centroid and moves each centroid
+ *    towards its batch mean with a per-cluster decaying learning rate,
+ *    so no step touches more than batchSize observation vectors and the
+ *    algorithm converges without full passes over the data. Intended
+ *    for datasets that do not fit in device memory: the observation
+ *    matrix only needs to be device-accessible (e.g. managed or pinned
+ *    host memory), since each step reads just the sampled columns.
+ *    Initial centroids are chosen with the k-means++ algorithm on the
+ *    first sampled batch.
+ *  @tparam index_type_t the type of data used for indexing.
+ *  @tparam value_type_t the type of data used for weights, distances.
+ *  @param handle the raft handle.
+ *  @param n Number of observation vectors.
+ *  @param d Dimension of observation vectors.
+ *  @param k Number of clusters.
+ *  @param batchSize Number of observation vectors sampled per step.
+ *  @param tol Tolerance for convergence. The iteration stops when the
+ *    change in batch residual divided by batchSize is less than tol.
+ *  @param maxiter Maximum number of mini-batch steps.
+ *  @param obs (Input, device-accessible memory, d*n entries)
+ *    Observation matrix. Matrix is stored column-major and each column
+ *    is an observation vector. Matrix dimensions are d x n.
+ *  @param codes (Output, device memory, n entries) Cluster
+ *    assignments.
+ *  @param residual On exit, residual sum of squares (sum of squares
+ *    of distances between observation vectors and centroids).
+ *  @param iters on exit, number of mini-batch steps.
+ *  @param seed random seed to be used.
+ *  @return error flag
+ */
+template <typename index_type_t, typename value_type_t>
+int kmeans_minibatch(handle_t const& handle,
+                     index_type_t n,
+                     index_type_t d,
+                     index_type_t k,
+                     index_type_t batchSize,
+                     value_type_t tol,
+                     index_type_t maxiter,
+                     const value_type_t* __restrict__ obs,
+                     index_type_t* __restrict__ codes,
+                     value_type_t& residual,
+                     index_type_t& iters,
+                     unsigned long long seed = 123456)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "cluster::kmeans_minibatch (%d, %d, %d, %d)", int(n), int(d), int(k), int(batchSize));
+  return detail::kmeans_minibatch<index_type_t, value_type_t>(
+    handle, n, d, k, batchSize, tol, maxiter, obs, codes, residual, iters, seed);
+}
+
+/**
+ *  @brief Find clusters with k-means algorithm across multiple ranks.
+ *    Each rank holds a shard of the observation vectors and computes
+ *    local assignments and partial centroid sums; sums and cluster
+ *    sizes are combined with comms_t::allreduce so every rank holds
+ *    identical centroids. Initial centroids are chosen with a
+ *    distributed k-means++ scheme in which all ranks share the random
+ *    draws, the owning rank is selected proportionally to its distance
+ *    mass and the chosen centroid is broadcast; globally empty
+ *    clusters are reseeded the same way.
+ *  @tparam index_type_t the type of data used for indexing.
+ *  @tparam value_type_t the type of data used for weights, distances.
+ *  @param handle the raft handle. Must have an initialized communicator
+ *    (cf. raft/comms/comms.hpp); every rank must call with the same k,
+ *    d, tol, maxiter and seed.
+ *  @param n Number of local observation vectors (may differ per rank,
+ *    must be positive).
+ *  @param d Dimension of observation vectors.
+ *  @param k Number of clusters.
+ *  @param tol Tolerance for convergence. k-means stops when the
+ *    change in global residual divided by the global number of
+ *    observation vectors is less than tol.
+ *  @param maxiter Maximum number of k-means iterations.
+ *  @param obs (Input, device memory, d*n entries) Local observation
+ *    matrix. Matrix is stored column-major and each column is an
+ *    observation vector. Matrix dimensions are d x n.
+ *  @param codes (Output, device memory, n entries) Cluster
+ *    assignments of the local observation vectors.
+ *  @param centroids (Output, device memory, d*k entries) Centroid
+ *    matrix, identical on every rank. Matrix is stored column-major.
+ *  @param residual On exit, global residual sum of squares.
+ *  @param iters on exit, number of k-means iterations.
+ *  @param seed random seed to be used. Must be the same on every rank.
+ *  @return error flag
+ */
+template <typename index_type_t, typename value_type_t>
+int kmeans_distributed(handle_t const& handle,
+                       index_type_t n,
+                       index_type_t d,
+                       index_type_t k,
+                       value_type_t tol,
+                       index_type_t maxiter,
+                       const value_type_t* __restrict__ obs,
+                       index_type_t* __restrict__ codes,
+                       value_type_t* __restrict__ centroids,
+                       value_type_t& residual,
+                       index_type_t& iters,
+                       unsigned long long seed = 123456)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "cluster::kmeans_distributed (%d, %d, %d)", int(n), int(d), int(k));
+  return detail::kmeans_distributed<index_type_t, value_type_t>(
+    handle, n, d, k, tol, maxiter, obs, codes, centroids, residual, iters, seed);
+}
 }  // namespace cluster
 }  // namespace raft
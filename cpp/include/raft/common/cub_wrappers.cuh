@@ -17,10 +17,30 @@
 #pragma once
 
 #include <cub/cub.cuh>
+#include <raft/core/workspace_arena.hpp>
+#include <raft/cudart_utils.h>
 #include <rmm/device_uvector.hpp>
 
 namespace raft {
 
+namespace detail {
+/**
+ * Rounds a cub temp-storage request up to a power-of-two size class. Requests
+ * served from the workspace arena with only a handful of distinct sizes keep
+ * the arena's retained buffer stable instead of growing it by a few bytes on
+ * every differently-shaped call.
+ */
+inline std::size_t cubTempSizeClass(std::size_t bytes)
+{
+  if (bytes == 0) { return 0; }
+  std::size_t sz = 256;
+  while (sz < bytes) {
+    sz <<= 1;
+  }
+  return sz;
+}
+}  // namespace detail
+
 /**
  * @brief Convenience wrapper over cub's SortPairs method
  * @tparam KeyT key type
@@ -50,4 +70,213 @@ void sortPairs(rmm::device_uvector<char>& workspace,
     workspace.data(), worksize, inKeys, outKeys, inVals, outVals, len, 0, sizeof(KeyT) * 8, stream);
 }
 
+/**
+ * @defgroup CubArena Arena-backed cub wrappers
+ *
+ * Each wrapper below runs cub's size query, rounds the request to a
+ * power-of-two size class and serves it from the handle's workspace arena
+ * (cf. raft/core/workspace_arena.hpp), so repeated calls reuse the arena's
+ * retained buffer instead of hitting the device allocator per call:
+ * @code{.cpp}
+ *   raft::exclusiveSum(handle.get_workspace_arena(), in, out, len, stream);
+ * @endcode
+ * @{
+ */
+
+/**
+ * @brief Radix-sorts key/value pairs with temp storage from the workspace arena
+ * @param arena workspace arena to draw temp storage from
+ * @param inKeys input keys array
+ * @param outKeys output keys array
+ * @param inVals input values array
+ * @param outVals output values array
+ * @param len array length
+ * @param stream cuda stream
+ */
+template <typename KeyT, typename ValueT>
+void sortPairs(workspace_arena& arena,
+               const KeyT* inKeys,
+               KeyT* outKeys,
+               const ValueT* inVals,
+               ValueT* outVals,
+               int len,
+               cudaStream_t stream)
+{
+  size_t worksize = 0;
+  RAFT_CUDA_TRY(cub::DeviceRadixSort::SortPairs(
+    nullptr, worksize, inKeys, outKeys, inVals, outVals, len, 0, sizeof(KeyT) * 8, stream));
+  worksize = detail::cubTempSizeClass(worksize);
+  workspace_chunk ws(arena, worksize, stream);
+  RAFT_CUDA_TRY(cub::DeviceRadixSort::SortPairs(
+    ws.data(), worksize, inKeys, outKeys, inVals, outVals, len, 0, sizeof(KeyT) * 8, stream));
+}
+
+/**
+ * @brief Radix-sorts keys with temp storage from the workspace arena
+ */
+template <typename KeyT>
+void sortKeys(workspace_arena& arena, const KeyT* in, KeyT* out, int len, cudaStream_t stream)
+{
+  size_t worksize = 0;
+  RAFT_CUDA_TRY(cub::DeviceRadixSort::SortKeys(
+    nullptr, worksize, in, out, len, 0, sizeof(KeyT) * 8, stream));
+  worksize = detail::cubTempSizeClass(worksize);
+  workspace_chunk ws(arena, worksize, stream);
+  RAFT_CUDA_TRY(cub::DeviceRadixSort::SortKeys(
+    ws.data(), worksize, in, out, len, 0, sizeof(KeyT) * 8, stream));
+}
+
+/**
+ * @brief Segmented radix-sort of key/value pairs, temp storage from the arena
+ * @param beginOffsets iterator over the start offset of each segment
+ * @param endOffsets iterator over the end offset of each segment
+ */
+template <typename KeyT, typename ValueT, typename OffsetIteratorT>
+void segmentedSortPairs(workspace_arena& arena,
+                        const KeyT* inKeys,
+                        KeyT* outKeys,
+                        const ValueT* inVals,
+                        ValueT* outVals,
+                        int len,
+                        int numSegments,
+                        OffsetIteratorT beginOffsets,
+                        OffsetIteratorT endOffsets,
+                        cudaStream_t stream)
+{
+  size_t worksize = 0;
+  RAFT_CUDA_TRY(cub::DeviceSegmentedRadixSort::SortPairs(nullptr,
+                                                         worksize,
+                                                         inKeys,
+                                                         outKeys,
+                                                         inVals,
+                                                         outVals,
+                                                         len,
+                                                         numSegments,
+                                                         beginOffsets,
+                                                         endOffsets,
+                                                         0,
+                                                         sizeof(KeyT) * 8,
+                                                         stream));
+  worksize = detail::cubTempSizeClass(worksize);
+  workspace_chunk ws(arena, worksize, stream);
+  RAFT_CUDA_TRY(cub::DeviceSegmentedRadixSort::SortPairs(ws.data(),
+                                                         worksize,
+                                                         inKeys,
+                                                         outKeys,
+                                                         inVals,
+                                                         outVals,
+                                                         len,
+                                                         numSegments,
+                                                         beginOffsets,
+                                                         endOffsets,
+                                                         0,
+                                                         sizeof(KeyT) * 8,
+                                                         stream));
+}
+
+/**
+ * @brief Inclusive prefix sum with temp storage from the workspace arena
+ */
+template <typename InIteratorT, typename OutIteratorT>
+void inclusiveSum(
+  workspace_arena& arena, InIteratorT in, OutIteratorT out, int len, cudaStream_t stream)
+{
+  size_t worksize = 0;
+  RAFT_CUDA_TRY(cub::DeviceScan::InclusiveSum(nullptr, worksize, in, out, len, stream));
+  worksize = detail::cubTempSizeClass(worksize);
+  workspace_chunk ws(arena, worksize, stream);
+  RAFT_CUDA_TRY(cub::DeviceScan::InclusiveSum(ws.data(), worksize, in, out, len, stream));
+}
+
+/**
+ * @brief Exclusive prefix sum with temp storage from the workspace arena.
+ * In-place operation (in == out) is supported.
+ */
+template <typename InIteratorT, typename OutIteratorT>
+void exclusiveSum(
+  workspace_arena& arena, InIteratorT in, OutIteratorT out, int len, cudaStream_t stream)
+{
+  size_t worksize = 0;
+  RAFT_CUDA_TRY(cub::DeviceScan::ExclusiveSum(nullptr, worksize, in, out, len, stream));
+  worksize = detail::cubTempSizeClass(worksize);
+  workspace_chunk ws(arena, worksize, stream);
+  RAFT_CUDA_TRY(cub::DeviceScan::ExclusiveSum(ws.data(), worksize, in, out, len, stream));
+}
+
+/**
+ * @brief Compacts flagged items with temp storage from the workspace arena
+ * @param numSelected device pointer/iterator receiving the selected count
+ */
+template <typename InIteratorT,
+          typename FlagIteratorT,
+          typename OutIteratorT,
+          typename NumSelectedIteratorT>
+void selectFlagged(workspace_arena& arena,
+                   InIteratorT in,
+                   FlagIteratorT flags,
+                   OutIteratorT out,
+                   NumSelectedIteratorT numSelected,
+                   int len,
+                   cudaStream_t stream)
+{
+  size_t worksize = 0;
+  RAFT_CUDA_TRY(
+    cub::DeviceSelect::Flagged(nullptr, worksize, in, flags, out, numSelected, len, stream));
+  worksize = detail::cubTempSizeClass(worksize);
+  workspace_chunk ws(arena, worksize, stream);
+  RAFT_CUDA_TRY(
+    cub::DeviceSelect::Flagged(ws.data(), worksize, in, flags, out, numSelected, len, stream));
+}
+
+/**
+ * @brief Removes adjacent duplicates with temp storage from the workspace arena
+ * @param numSelected device pointer/iterator receiving the unique count
+ */
+template <typename InIteratorT, typename OutIteratorT, typename NumSelectedIteratorT>
+void selectUnique(workspace_arena& arena,
+                  InIteratorT in,
+                  OutIteratorT out,
+                  NumSelectedIteratorT numSelected,
+                  int len,
+                  cudaStream_t stream)
+{
+  size_t worksize = 0;
+  RAFT_CUDA_TRY(cub::DeviceSelect::Unique(nullptr, worksize, in, out, numSelected, len, stream));
+  worksize = detail::cubTempSizeClass(worksize);
+  workspace_chunk ws(arena, worksize, stream);
+  RAFT_CUDA_TRY(cub::DeviceSelect::Unique(ws.data(), worksize, in, out, numSelected, len, stream));
+}
+
+/**
+ * @brief Segmented reduction by key with temp storage from the workspace arena
+ * @param numRunsOut device pointer/iterator receiving the number of runs
+ * @param op binary reduction operator
+ */
+template <typename KeysInIteratorT,
+          typename UniqueOutIteratorT,
+          typename ValuesInIteratorT,
+          typename AggregatesOutIteratorT,
+          typename NumRunsOutIteratorT,
+          typename ReductionOpT>
+void reduceByKey(workspace_arena& arena,
+                 KeysInIteratorT keysIn,
+                 UniqueOutIteratorT uniqueOut,
+                 ValuesInIteratorT valuesIn,
+                 AggregatesOutIteratorT aggregatesOut,
+                 NumRunsOutIteratorT numRunsOut,
+                 ReductionOpT op,
+                 int len,
+                 cudaStream_t stream)
+{
+  size_t worksize = 0;
+  RAFT_CUDA_TRY(cub::DeviceReduce::ReduceByKey(
+    nullptr, worksize, keysIn, uniqueOut, valuesIn, aggregatesOut, numRunsOut, op, len, stream));
+  worksize = detail::cubTempSizeClass(worksize);
+  workspace_chunk ws(arena, worksize, stream);
+  RAFT_CUDA_TRY(cub::DeviceReduce::ReduceByKey(
+    ws.data(), worksize, keysIn, uniqueOut, valuesIn, aggregatesOut, numRunsOut, op, len, stream));
+}
+
+/** @} */  // end of group CubArena
+
 }  // namespace raft
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <utility>
+
+#include <cuda_runtime.h>
+
+#include <raft/core/cudart_utils.hpp>
+#include <rmm/cuda_stream_view.hpp>
+
+namespace raft {
+
+/**
+ * @brief Cached CUDA graph for replaying a fixed kernel launch sequence.
+ *
+ * Iterative algorithms that launch the same sequence of kernels many times
+ * (e.g. one Lloyd's iteration in k-means) pay a CPU launch cost per kernel
+ * per iteration. This helper captures the sequence once into a CUDA graph
+ * and replays the instantiated graph on subsequent calls, reducing the
+ * per-iteration CPU cost to a single graph launch.
+ *
+ * The launch callable passed to `capture_and_launch` must only perform
+ * stream-capture-safe work (kernel launches, async memcpy/memset) on the
+ * given stream, and the captured parameters (shapes, pointers) must not
+ * change between replays — call `reset()` to force a re-capture when they
+ * do.
+ */
+class cuda_graph_t {
+ public:
+  cuda_graph_t()                    = default;
+  cuda_graph_t(const cuda_graph_t&) = delete;
+  cuda_graph_t& operator=(const cuda_graph_t&) = delete;
+
+  ~cuda_graph_t() { reset(); }
+
+  /**
+   * @brief Run the launch sequence, capturing it on first use.
+   *
+   * On the first call, `launch_fn()` is executed under stream capture and
+   * the resulting graph is instantiated; on subsequent calls the cached
+   * executable graph is launched instead and `launch_fn` is not invoked.
+   */
+  template <typename LaunchFn>
+  void capture_and_launch(rmm::cuda_stream_view stream, LaunchFn&& launch_fn)
+  {
+    if (!instantiated_) {
+      RAFT_CUDA_TRY(cudaStreamBeginCapture(stream, cudaStreamCaptureModeThreadLocal));
+      std::forward<LaunchFn>(launch_fn)();
+      cudaGraph_t graph;
+      RAFT_CUDA_TRY(cudaStreamEndCapture(stream, &graph));
+      RAFT_CUDA_TRY(cudaGraphInstantiate(&exec_, graph, nullptr, nullptr, 0));
+      RAFT_CUDA_TRY(cudaGraphDestroy(graph));
+      instantiated_ = true;
+    }
+    RAFT_CUDA_TRY(cudaGraphLaunch(exec_, stream));
+  }
+
+  /** @brief Whether a captured graph is currently cached */
+  bool is_instantiated() const { return instantiated_; }
+
+  /** @brief Drop the cached graph so the next call re-captures */
+  void reset()
+  {
+    if (instantiated_) {
+      RAFT_CUDA_TRY_NO_THROW(cudaGraphExecDestroy(exec_));
+      instantiated_ = false;
+    }
+  }
+
+ private:
+  cudaGraphExec_t exec_{nullptr};
+  bool instantiated_{false};
+};
+
+}  // namespace raft
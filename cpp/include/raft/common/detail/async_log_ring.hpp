@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace raft {
+namespace detail {
+
+/**
+ * @brief Bounded lock-free multi-producer/single-consumer ring buffer of log
+ *        records (Vyukov-style sequence-numbered slots).
+ *
+ * Producers only perform one fetch-add and two atomic loads/stores per push,
+ * so enqueueing a pre-expanded message costs nanoseconds on the hot path;
+ * the expensive pattern formatting and sink I/O happen on the consumer
+ * thread. When the ring is full `try_push` fails and the caller decides
+ * whether to drop or log synchronously.
+ */
+class async_log_ring {
+ public:
+  struct record {
+    int level;
+    std::string msg;
+  };
+
+  /** @param capacity ring size; rounded up to the next power of two */
+  explicit async_log_ring(std::size_t capacity)
+  {
+    std::size_t n = 1;
+    while (n < capacity) {
+      n <<= 1;
+    }
+    slots_ = std::vector<slot>(n);
+    mask_  = n - 1;
+    for (std::size_t i = 0; i < n; i++) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  async_log_ring(const async_log_ring&) = delete;
+  async_log_ring& operator=(const async_log_ring&) = delete;
+
+  /** @brief Enqueue a record; returns false when the ring is full */
+  bool try_push(int level, std::string&& msg)
+  {
+    std::size_t pos = head_.load(std::memory_order_relaxed);
+    while (true) {
+      slot& s       = slots_[pos & mask_];
+      std::size_t seq = s.sequence.load(std::memory_order_acquire);
+      auto diff     = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0) {
+        if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          s.rec.level = level;
+          s.rec.msg   = std::move(msg);
+          s.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;  // full
+      } else {
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /** @brief Dequeue a record (single consumer); returns false when empty */
+  bool try_pop(record& out)
+  {
+    std::size_t pos = tail_.load(std::memory_order_relaxed);
+    slot& s         = slots_[pos & mask_];
+    std::size_t seq = s.sequence.load(std::memory_order_acquire);
+    auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+    if (diff < 0) { return false; }  // empty
+    out = std::move(s.rec);
+    s.sequence.store(pos + mask_ + 1, std::memory_order_release);
+    tail_.store(pos + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  bool empty() const
+  {
+    return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+  }
+
+ private:
+  struct slot {
+    std::atomic<std::size_t> sequence{0};
+    record rec{};
+  };
+
+  std::vector<slot> slots_;
+  std::size_t mask_{0};
+  alignas(64) std::atomic<std::size_t> head_{0};
+  alignas(64) std::atomic<std::size_t> tail_{0};
+};
+
+}  // namespace detail
+}  // namespace raft
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/cuda_utils.cuh>
+#include <raft/vectorized.cuh>
+
+namespace raft::detail {
+
+template <typename DataT, int VecLen, typename Lambda, typename IdxT>
+__global__ void gatherKernel(DataT* out, const DataT* in, const IdxT* idx, IdxT len, Lambda op)
+{
+  typedef TxN_t<DataT, VecLen> DataVec;
+  typedef TxN_t<IdxT, VecLen> IdxVec;
+  IdxT tid = threadIdx.x + ((IdxT)blockIdx.x * blockDim.x);
+  tid *= VecLen;
+  if (tid >= len) return;
+  IdxVec idxIn;
+  idxIn.load(idx, tid);
+  DataVec dataOut;
+#pragma unroll
+  for (int i = 0; i < VecLen; ++i) {
+    auto inPos          = idxIn.val.data[i];
+    dataOut.val.data[i] = op(in[inPos], tid + i);
+  }
+  dataOut.store(out, tid);
+}
+
+template <typename DataT, int VecLen, typename Lambda, typename IdxT, int TPB>
+void gatherImpl(
+  DataT* out, const DataT* in, const IdxT* idx, IdxT len, Lambda op, cudaStream_t stream)
+{
+  const IdxT nblks = raft::ceildiv(VecLen ? len / VecLen : len, (IdxT)TPB);
+  gatherKernel<DataT, VecLen, Lambda, IdxT><<<nblks, TPB, 0, stream>>>(out, in, idx, len, op);
+  RAFT_CUDA_TRY(cudaGetLastError());
+}
+
+template <typename DataT, int VecLen, typename Lambda, typename IdxT>
+__global__ void gatherRowsKernel(
+  DataT* out, const DataT* in, IdxT n_cols, const IdxT* idx, IdxT n_rows, Lambda op)
+{
+  typedef TxN_t<DataT, VecLen> DataVec;
+  IdxT tid = threadIdx.x + ((IdxT)blockIdx.x * blockDim.x);
+  tid *= VecLen;
+  if (tid >= n_rows * n_cols) return;
+  IdxT row    = tid / n_cols;
+  IdxT col    = tid % n_cols;
+  IdxT in_row = idx[row];
+  DataVec a;
+  a.load(in, in_row * n_cols + col);
+#pragma unroll
+  for (int i = 0; i < VecLen; ++i) {
+    a.val.data[i] = op(a.val.data[i], tid + i);
+  }
+  a.store(out, tid);
+}
+
+template <typename DataT, int VecLen, typename Lambda, typename IdxT, int TPB>
+void gatherRowsImpl(DataT* out,
+                    const DataT* in,
+                    IdxT n_cols,
+                    const IdxT* idx,
+                    IdxT n_rows,
+                    Lambda op,
+                    cudaStream_t stream)
+{
+  const IdxT len   = n_rows * n_cols;
+  const IdxT nblks = raft::ceildiv(VecLen ? len / VecLen : len, (IdxT)TPB);
+  gatherRowsKernel<DataT, VecLen, Lambda, IdxT>
+    <<<nblks, TPB, 0, stream>>>(out, in, n_cols, idx, n_rows, op);
+  RAFT_CUDA_TRY(cudaGetLastError());
+}
+
+template <typename DataT, int VecLen, typename Lambda, typename IdxT>
+__global__ void scatterRowsKernel(
+  DataT* out, const DataT* in, IdxT n_cols, const IdxT* idx, IdxT n_rows, Lambda op)
+{
+  typedef TxN_t<DataT, VecLen> DataVec;
+  IdxT tid = threadIdx.x + ((IdxT)blockIdx.x * blockDim.x);
+  tid *= VecLen;
+  if (tid >= n_rows * n_cols) return;
+  IdxT row     = tid / n_cols;
+  IdxT col     = tid % n_cols;
+  IdxT out_row = idx[row];
+  IdxT out_pos = out_row * n_cols + col;
+  DataVec a;
+  a.load(in, tid);
+#pragma unroll
+  for (int i = 0; i < VecLen; ++i) {
+    a.val.data[i] = op(a.val.data[i], out_pos + i);
+  }
+  a.store(out, out_pos);
+}
+
+template <typename DataT, int VecLen, typename Lambda, typename IdxT, int TPB>
+void scatterRowsImpl(DataT* out,
+                     const DataT* in,
+                     IdxT n_cols,
+                     const IdxT* idx,
+                     IdxT n_rows,
+                     Lambda op,
+                     cudaStream_t stream)
+{
+  const IdxT len   = n_rows * n_cols;
+  const IdxT nblks = raft::ceildiv(VecLen ? len / VecLen : len, (IdxT)TPB);
+  scatterRowsKernel<DataT, VecLen, Lambda, IdxT>
+    <<<nblks, TPB, 0, stream>>>(out, in, n_cols, idx, n_rows, op);
+  RAFT_CUDA_TRY(cudaGetLastError());
+}
+
+}  // namespace raft::detail
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/cuda_utils.cuh>
+#include <raft/cudart_utils.h>
+
+#include <mutex>
+#include <unordered_map>
+
+namespace raft {
+namespace detail {
+
+/** Occupancy-derived launch parameters of a kernel (on the current device). */
+struct launch_config {
+  /** block size maximizing occupancy, as given by the occupancy calculator */
+  int block_size;
+  /** smallest grid that can saturate the device at that block size */
+  int saturating_grid_size;
+};
+
+/**
+ * @brief Memoized occupancy query for a kernel.
+ *
+ * `cudaOccupancyMaxPotentialBlockSize` costs a few microseconds per call,
+ * which is noticeable when an elementwise kernel is launched millions of
+ * times; the result only depends on the kernel and device, so it is cached
+ * per process in a map keyed on the kernel function pointer.
+ */
+template <typename KernelT>
+launch_config occupancy_launch_config(KernelT kernel)
+{
+  static std::mutex mutex;
+  static std::unordered_map<const void*, launch_config> cache;
+
+  auto key = reinterpret_cast<const void*>(kernel);
+  std::lock_guard<std::mutex> _(mutex);
+  auto it = cache.find(key);
+  if (it != cache.end()) { return it->second; }
+
+  int min_grid_size, block_size;
+  RAFT_CUDA_TRY(cudaOccupancyMaxPotentialBlockSize(&min_grid_size, &block_size, kernel));
+  launch_config config{block_size, min_grid_size};
+  cache.emplace(key, config);
+  return config;
+}
+
+/**
+ * @brief Block size for a one-thread-per-item elementwise kernel.
+ *
+ * Starts from the kernel's occupancy-maximizing block size; for inputs too
+ * small to fill the device's saturating grid at that size, the block size is
+ * halved (down to one warp) so the same work spreads over more SMs instead
+ * of idling most of the device behind a handful of fat blocks.
+ *
+ * @param kernel the kernel to be launched
+ * @param n_items number of threads' worth of work (items / per-thread ratio)
+ */
+template <typename KernelT>
+int elementwise_block_size(KernelT kernel, size_t n_items)
+{
+  auto config    = occupancy_launch_config(kernel);
+  int block_size = config.block_size;
+  while (block_size > WarpSize &&
+         raft::ceildiv(n_items, size_t(block_size)) < size_t(config.saturating_grid_size)) {
+    block_size /= 2;
+  }
+  return block_size;
+}
+
+}  // namespace detail
+}  // namespace raft
@@ -161,4 +161,67 @@ DI void ldg(double (&x)[2], const double* addr)
 }
 /** @} */
 
+/**
+ * @defgroup CpAsync Asynchronous global-to-shared copies (Ampere cp.async)
+ * @{
+ * @brief Copies data from global to shared memory without staging it through
+ *        registers, so tile loops can overlap the copy with compute. Both
+ *        addresses must be aligned to the copy size. The copy only becomes
+ *        visible after `cp_async_commit()` followed by a matching
+ *        `cp_async_wait*()` and a `__syncthreads()`.
+ *
+ *        On architectures without cp.async (pre sm_80) these degrade to
+ *        synchronous copies / no-ops, so call sites stay portable.
+ * @param[out] dst shared memory destination (aligned to `Bytes`)
+ * @param[in]  src global memory source (aligned to `Bytes`)
+ */
+template <int Bytes>
+DI void cp_async(void* dst, const void* src)
+{
+  static_assert(Bytes == 4 || Bytes == 8 || Bytes == 16, "cp_async: size must be 4, 8 or 16 bytes");
+#if __CUDA_ARCH__ >= 800
+  auto s = __cvta_generic_to_shared(dst);
+  if constexpr (Bytes == 16) {
+    // 16-byte copies can bypass L1 entirely
+    asm volatile("cp.async.cg.shared.global [%0], [%1], 16;" : : "l"(s), "l"(src));
+  } else {
+    asm volatile("cp.async.ca.shared.global [%0], [%1], %2;" : : "l"(s), "l"(src), "n"(Bytes));
+  }
+#else
+  if constexpr (Bytes == 4) {
+    *reinterpret_cast<uint32_t*>(dst) = *reinterpret_cast<const uint32_t*>(src);
+  } else if constexpr (Bytes == 8) {
+    *reinterpret_cast<uint2*>(dst) = *reinterpret_cast<const uint2*>(src);
+  } else {
+    *reinterpret_cast<uint4*>(dst) = *reinterpret_cast<const uint4*>(src);
+  }
+#endif
+}
+
+/** Closes the group of all cp_async calls issued since the previous commit. */
+DI void cp_async_commit()
+{
+#if __CUDA_ARCH__ >= 800
+  asm volatile("cp.async.commit_group;");
+#endif
+}
+
+/** Blocks until at most `N` committed cp_async groups are still in flight. */
+template <int N>
+DI void cp_async_wait()
+{
+#if __CUDA_ARCH__ >= 800
+  asm volatile("cp.async.wait_group %0;" : : "n"(N));
+#endif
+}
+
+/** Blocks until all committed cp_async groups have completed. */
+DI void cp_async_wait_all()
+{
+#if __CUDA_ARCH__ >= 800
+  asm volatile("cp.async.wait_all;");
+#endif
+}
+/** @} */
+
 }  // namespace raft
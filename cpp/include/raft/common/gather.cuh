@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/common/detail/gather.cuh>
+#include <raft/cuda_utils.cuh>
+#include <raft/cudart_utils.h>
+
+#include <cstdint>
+#include <type_traits>
+
+namespace raft {
+
+/**
+ * @brief Performs gather operation based on the input indexing array
+ *
+ * On exit out[i] = op(in[idx[i]], i) for i = 0..len-1. This is the read-side
+ * counterpart of raft::scatter; the indices and the output are accessed with
+ * vectorized transfers, the gathered loads are scalar since they are not
+ * contiguous.
+ *
+ * @tparam DataT data type of the gathered array
+ * @tparam IdxT indexing type
+ * @tparam TPB threads-per-block in the final kernel launched
+ * @tparam Lambda the device-lambda performing a unary operation on the loaded
+ * data before it gets stored
+ * @param out the output array, size [len]
+ * @param in the input array
+ * @param idx the indexing array, size [len]
+ * @param len number of elements to gather
+ * @param stream cuda stream where to launch work
+ * @param op the device-lambda with signature `DataT func(DataT, IdxT);`,
+ * applied to every element between load and store. The second param is the
+ * destination index.
+ */
+template <typename DataT, typename IdxT, typename Lambda = raft::Nop<DataT, IdxT>, int TPB = 256>
+void gather(DataT* out,
+            const DataT* in,
+            const IdxT* idx,
+            IdxT len,
+            cudaStream_t stream,
+            Lambda op = raft::Nop<DataT, IdxT>())
+{
+  if (len <= 0) return;
+  constexpr size_t DataSize   = sizeof(DataT);
+  constexpr size_t IdxSize    = sizeof(IdxT);
+  constexpr size_t MaxPerElem = DataSize > IdxSize ? DataSize : IdxSize;
+  size_t bytes                = len * MaxPerElem;
+  if (16 / MaxPerElem && bytes % 16 == 0) {
+    detail::gatherImpl<DataT, 16 / MaxPerElem, Lambda, IdxT, TPB>(out, in, idx, len, op, stream);
+  } else if (8 / MaxPerElem && bytes % 8 == 0) {
+    detail::gatherImpl<DataT, 8 / MaxPerElem, Lambda, IdxT, TPB>(out, in, idx, len, op, stream);
+  } else if (4 / MaxPerElem && bytes % 4 == 0) {
+    detail::gatherImpl<DataT, 4 / MaxPerElem, Lambda, IdxT, TPB>(out, in, idx, len, op, stream);
+  } else if (2 / MaxPerElem && bytes % 2 == 0) {
+    detail::gatherImpl<DataT, 2 / MaxPerElem, Lambda, IdxT, TPB>(out, in, idx, len, op, stream);
+  } else if (1 / MaxPerElem) {
+    detail::gatherImpl<DataT, 1 / MaxPerElem, Lambda, IdxT, TPB>(out, in, idx, len, op, stream);
+  } else {
+    detail::gatherImpl<DataT, 1, Lambda, IdxT, TPB>(out, in, idx, len, op, stream);
+  }
+}
+
+/**
+ * @brief Gather rows of a row-major matrix: each index moves a contiguous
+ * row of n_cols elements.
+ *
+ * On exit out[i * n_cols + k] = op(in[idx[i] * n_cols + k], i * n_cols + k)
+ * for i = 0..n_rows-1, k = 0..n_cols-1. Both the loads and the stores move
+ * whole rows, so the vectorization width (up to 16 bytes) is picked from the
+ * row byte length and the alignment of the two matrices instead of the index
+ * count.
+ *
+ * If idx_sorted is true the indices are assumed to be in ascending order.
+ * When the sorted indices additionally form a contiguous range the whole
+ * operation degenerates to a single memcpy, which is used as a fast path
+ * (this inspects the first and last index and therefore synchronizes the
+ * stream). Sorted indices also keep the scattered loads sequential, which
+ * improves cache behaviour even when the fast path does not apply.
+ *
+ * @tparam DataT data type of the matrix
+ * @tparam IdxT indexing type
+ * @tparam TPB threads-per-block in the final kernel launched
+ * @tparam Lambda device-lambda applied to every element between load and
+ * store, signature `DataT func(DataT, IdxT);`, the second param is the
+ * destination index
+ * @param out the output matrix, size [n_rows * n_cols]
+ * @param in the input matrix
+ * @param n_cols row length
+ * @param idx row indices to gather, size [n_rows]
+ * @param n_rows number of rows to gather
+ * @param stream cuda stream where to launch work
+ * @param idx_sorted whether idx is sorted in ascending order
+ * @param op optional element transform
+ */
+template <typename DataT, typename IdxT, typename Lambda = raft::Nop<DataT, IdxT>, int TPB = 256>
+void gather_rows(DataT* out,
+                 const DataT* in,
+                 IdxT n_cols,
+                 const IdxT* idx,
+                 IdxT n_rows,
+                 cudaStream_t stream,
+                 bool idx_sorted = false,
+                 Lambda op       = raft::Nop<DataT, IdxT>())
+{
+  if (n_rows <= 0 || n_cols <= 0) return;
+  if (idx_sorted && std::is_same<Lambda, raft::Nop<DataT, IdxT>>::value) {
+    IdxT first, last;
+    raft::update_host(&first, idx, 1, stream);
+    raft::update_host(&last, idx + n_rows - 1, 1, stream);
+    RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+    if (last - first + 1 == n_rows) {
+      raft::copy(out, in + first * n_cols, n_rows * n_cols, stream);
+      return;
+    }
+  }
+  constexpr size_t DataSize = sizeof(DataT);
+  size_t rowBytes           = n_cols * DataSize;
+  uint64_t inAddr           = uint64_t(in);
+  uint64_t outAddr          = uint64_t(out);
+  if (16 / DataSize && rowBytes % 16 == 0 && inAddr % 16 == 0 && outAddr % 16 == 0) {
+    detail::gatherRowsImpl<DataT, 16 / DataSize, Lambda, IdxT, TPB>(
+      out, in, n_cols, idx, n_rows, op, stream);
+  } else if (8 / DataSize && rowBytes % 8 == 0 && inAddr % 8 == 0 && outAddr % 8 == 0) {
+    detail::gatherRowsImpl<DataT, 8 / DataSize, Lambda, IdxT, TPB>(
+      out, in, n_cols, idx, n_rows, op, stream);
+  } else if (4 / DataSize && rowBytes % 4 == 0 && inAddr % 4 == 0 && outAddr % 4 == 0) {
+    detail::gatherRowsImpl<DataT, 4 / DataSize, Lambda, IdxT, TPB>(
+      out, in, n_cols, idx, n_rows, op, stream);
+  } else if (2 / DataSize && rowBytes % 2 == 0 && inAddr % 2 == 0 && outAddr % 2 == 0) {
+    detail::gatherRowsImpl<DataT, 2 / DataSize, Lambda, IdxT, TPB>(
+      out, in, n_cols, idx, n_rows, op, stream);
+  } else if (1 / DataSize) {
+    detail::gatherRowsImpl<DataT, 1 / DataSize, Lambda, IdxT, TPB>(
+      out, in, n_cols, idx, n_rows, op, stream);
+  } else {
+    detail::gatherRowsImpl<DataT, 1, Lambda, IdxT, TPB>(out, in, n_cols, idx, n_rows, op, stream);
+  }
+}
+
+}  // namespace raft
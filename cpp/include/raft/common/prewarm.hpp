@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/cudart_utils.h>
+
+#include <thread>
+#include <vector>
+
+namespace raft {
+
+/**
+ * @brief Eagerly load the device modules containing the given kernels.
+ *
+ * With lazy module loading (CUDA_MODULE_LOADING=LAZY, cf. the
+ * RAFT_CUDA_LAZY_LOADING build option) the first launch of each kernel pays
+ * its module load. Services that want both the fast cold start and
+ * predictable first-request latency can call this for their hot kernels
+ * once they are up; querying a kernel's attributes forces its module to
+ * load without launching anything.
+ *
+ * @param kernels kernel function pointers, e.g.
+ *   `reinterpret_cast<const void*>(&my_kernel<float>)`
+ */
+inline void prewarm_kernels(const std::vector<const void*>& kernels)
+{
+  cudaFuncAttributes attr;
+  for (const void* func : kernels) {
+    RAFT_CUDA_TRY(cudaFuncGetAttributes(&attr, func));
+  }
+}
+
+/**
+ * @brief Prewarm kernels in a background thread.
+ *
+ * Same as prewarm_kernels, but returns immediately; the loading proceeds on
+ * the returned thread against the caller's current device, so the service
+ * can start accepting traffic while the modules load. Load failures are
+ * logged and swallowed, since a failed prewarm only delays the load to the
+ * first launch.
+ *
+ * @param kernels kernel function pointers
+ * @return the loader thread; the caller owns joining it
+ */
+inline std::thread prewarm_kernels_async(std::vector<const void*> kernels)
+{
+  int device = 0;
+  RAFT_CUDA_TRY(cudaGetDevice(&device));
+  return std::thread([device, kernels = std::move(kernels)]() {
+    RAFT_CUDA_TRY_NO_THROW(cudaSetDevice(device));
+    cudaFuncAttributes attr;
+    for (const void* func : kernels) {
+      RAFT_CUDA_TRY_NO_THROW(cudaFuncGetAttributes(&attr, func));
+    }
+  });
+}
+
+}  // namespace raft
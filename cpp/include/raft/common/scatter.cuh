@@ -16,8 +16,13 @@
 
 #pragma once
 
+#include <raft/common/detail/gather.cuh>
 #include <raft/common/detail/scatter.cuh>
 #include <raft/cuda_utils.cuh>
+#include <raft/cudart_utils.h>
+
+#include <cstdint>
+#include <type_traits>
 
 namespace raft {
 
@@ -65,4 +70,86 @@ void scatter(DataT* out,
   }
 }
 
+/**
+ * @brief Scatter rows of a row-major matrix: each index moves a contiguous
+ * row of n_cols elements.
+ *
+ * On exit out[idx[i] * n_cols + k] = op(in[i * n_cols + k], idx[i] * n_cols + k)
+ * for i = 0..n_rows-1, k = 0..n_cols-1. Both the loads and the stores move
+ * whole rows, so the vectorization width (up to 16 bytes) is picked from the
+ * row byte length and the alignment of the two matrices.
+ *
+ * The writes are performed without any conflict detection: the indices must
+ * be unique, duplicate indices leave the target row with an unspecified mix
+ * of the competing sources. This is the common case for embedding-table
+ * style updates where each row is touched at most once per batch, and it
+ * avoids the atomics a conflict-safe scatter would need.
+ *
+ * If idx_sorted is true the indices are assumed to be in ascending order.
+ * When the sorted indices additionally form a contiguous range the whole
+ * operation degenerates to a single memcpy, which is used as a fast path
+ * (this inspects the first and last index and therefore synchronizes the
+ * stream). Sorted indices also keep the scattered stores sequential, which
+ * improves write combining even when the fast path does not apply.
+ *
+ * @tparam DataT data type of the matrix
+ * @tparam IdxT indexing type
+ * @tparam TPB threads-per-block in the final kernel launched
+ * @tparam Lambda device-lambda applied to every element between load and
+ * store, signature `DataT func(DataT, IdxT);`, the second param is the
+ * destination index
+ * @param out the output matrix
+ * @param in the input matrix, size [n_rows * n_cols]
+ * @param n_cols row length
+ * @param idx destination row indices, size [n_rows], must be unique
+ * @param n_rows number of rows to scatter
+ * @param stream cuda stream where to launch work
+ * @param idx_sorted whether idx is sorted in ascending order
+ * @param op optional element transform
+ */
+template <typename DataT, typename IdxT, typename Lambda = raft::Nop<DataT, IdxT>, int TPB = 256>
+void scatter_rows(DataT* out,
+                  const DataT* in,
+                  IdxT n_cols,
+                  const IdxT* idx,
+                  IdxT n_rows,
+                  cudaStream_t stream,
+                  bool idx_sorted = false,
+                  Lambda op       = raft::Nop<DataT, IdxT>())
+{
+  if (n_rows <= 0 || n_cols <= 0) return;
+  if (idx_sorted && std::is_same<Lambda, raft::Nop<DataT, IdxT>>::value) {
+    IdxT first, last;
+    raft::update_host(&first, idx, 1, stream);
+    raft::update_host(&last, idx + n_rows - 1, 1, stream);
+    RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+    if (last - first + 1 == n_rows) {
+      raft::copy(out + first * n_cols, in, n_rows * n_cols, stream);
+      return;
+    }
+  }
+  constexpr size_t DataSize = sizeof(DataT);
+  size_t rowBytes           = n_cols * DataSize;
+  uint64_t inAddr           = uint64_t(in);
+  uint64_t outAddr          = uint64_t(out);
+  if (16 / DataSize && rowBytes % 16 == 0 && inAddr % 16 == 0 && outAddr % 16 == 0) {
+    detail::scatterRowsImpl<DataT, 16 / DataSize, Lambda, IdxT, TPB>(
+      out, in, n_cols, idx, n_rows, op, stream);
+  } else if (8 / DataSize && rowBytes % 8 == 0 && inAddr % 8 == 0 && outAddr % 8 == 0) {
+    detail::scatterRowsImpl<DataT, 8 / DataSize, Lambda, IdxT, TPB>(
+      out, in, n_cols, idx, n_rows, op, stream);
+  } else if (4 / DataSize && rowBytes % 4 == 0 && inAddr % 4 == 0 && outAddr % 4 == 0) {
+    detail::scatterRowsImpl<DataT, 4 / DataSize, Lambda, IdxT, TPB>(
+      out, in, n_cols, idx, n_rows, op, stream);
+  } else if (2 / DataSize && rowBytes % 2 == 0 && inAddr % 2 == 0 && outAddr % 2 == 0) {
+    detail::scatterRowsImpl<DataT, 2 / DataSize, Lambda, IdxT, TPB>(
+      out, in, n_cols, idx, n_rows, op, stream);
+  } else if (1 / DataSize) {
+    detail::scatterRowsImpl<DataT, 1 / DataSize, Lambda, IdxT, TPB>(
+      out, in, n_cols, idx, n_rows, op, stream);
+  } else {
+    detail::scatterRowsImpl<DataT, 1, Lambda, IdxT, TPB>(out, in, n_cols, idx, n_rows, op, stream);
+  }
+}
+
 }  // namespace raft
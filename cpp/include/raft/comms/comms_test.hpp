@@ -108,6 +108,32 @@ bool test_collective_reducescatter(const handle_t& handle, int root)
   return detail::test_collective_reducescatter(handle, root);
 }
 
+/**
+ * @brief A sanity check that the topology-aware hierarchical allreduce
+ * produces the same result as the flat collective
+ *
+ * @param[in] handle the raft handle to use. This is expected to already have an
+ *        initialized comms instance.
+ *  @param[in] root the root rank id
+ */
+bool test_collective_hierarchical_allreduce(const handle_t& handle, int root)
+{
+  return detail::test_collective_hierarchical_allreduce(handle, root);
+}
+
+/**
+ * @brief A sanity check that the chunked pipelined broadcast delivers the
+ * same data as the monolithic one
+ *
+ * @param[in] handle the raft handle to use. This is expected to already have an
+ *        initialized comms instance and a stream pool.
+ *  @param[in] root the root rank id
+ */
+bool test_collective_bcast_pipelined(const handle_t& handle, int root)
+{
+  return detail::test_collective_bcast_pipelined(handle, root);
+}
+
 /**
  * A simple sanity check that UCX is able to send messages between all ranks
  *
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/comms/comms.hpp>
+#include <raft/comms/detail/compressed_allreduce.cuh>
+
+namespace raft {
+namespace comms {
+
+/**
+ * @brief Allreduce of fp32 data over a half-width wire format with local
+ * error feedback, halving cross-node traffic for bandwidth-bound
+ * gradient-style reductions.
+ *
+ * Each round the input plus the accumulated quantization residual is
+ * compressed to the 16-bit format, summed with a regular allreduce and
+ * decompressed; the local quantization error of the round is kept in the
+ * residual and re-injected into the next round, so the error does not
+ * accumulate over repeated reductions of the same buffer (e.g. gradient
+ * averaging across training steps).
+ *
+ * Only summation is supported, since error feedback is defined for
+ * additive reductions.
+ *
+ * @tparam compressed_t 16-bit wire format, __half (default) or
+ * nv_bfloat16 (the latter needs NCCL >= 2.10)
+ * @param comm initialized communicator
+ * @param sendbuff device buffer with count fp32 values to reduce
+ * @param recvbuff device buffer receiving the count reduced fp32 values
+ * @param residual device buffer with count fp32 values carrying the
+ * quantization error across calls; owned by the caller, one per reduced
+ * buffer, and zeroed before the first call
+ * @param count number of elements
+ * @param stream CUDA stream to schedule the operation on
+ */
+template <typename compressed_t = __half>
+void compressed_allreduce(const comms_t& comm,
+                          const float* sendbuff,
+                          float* recvbuff,
+                          float* residual,
+                          size_t count,
+                          cudaStream_t stream)
+{
+  detail::compressed_allreduce<compressed_t>(comm, sendbuff, recvbuff, residual, count, stream);
+}
+
+}  // end namespace comms
+}  // end namespace raft
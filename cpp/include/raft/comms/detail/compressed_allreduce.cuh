@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/comms/comms.hpp>
+
+#include <raft/cudart_utils.h>
+#include <rmm/device_uvector.hpp>
+
+#include <cuda_bf16.h>
+#include <cuda_fp16.h>
+
+#include <algorithm>
+
+namespace raft {
+namespace comms {
+
+// allow the compressed buffer itself to go through the typed allreduce
+template <>
+constexpr datatype_t get_type<__half>()
+{
+  return datatype_t::FLOAT16;
+}
+
+template <>
+constexpr datatype_t get_type<nv_bfloat16>()
+{
+  return datatype_t::BFLOAT16;
+}
+
+namespace detail {
+
+template <typename compressed_t>
+struct float_codec;
+
+template <>
+struct float_codec<__half> {
+  static __device__ inline __half compress(float v) { return __float2half_rn(v); }
+  static __device__ inline float decompress(__half v) { return __half2float(v); }
+};
+
+template <>
+struct float_codec<nv_bfloat16> {
+  static __device__ inline nv_bfloat16 compress(float v) { return __float2bfloat16_rn(v); }
+  static __device__ inline float decompress(nv_bfloat16 v) { return __bfloat162float(v); }
+};
+
+// compress with error feedback: the quantization error of this round is
+// kept in the residual and re-injected into the next round's input
+template <typename compressed_t>
+static __global__ void compressWithFeedbackKernel(const float* __restrict__ in,
+                                                  float* __restrict__ residual,
+                                                  compressed_t* __restrict__ out,
+                                                  size_t count)
+{
+  size_t stride = static_cast<size_t>(blockDim.x) * gridDim.x;
+  for (size_t i = threadIdx.x + static_cast<size_t>(blockIdx.x) * blockDim.x; i < count;
+       i += stride) {
+    float corrected = in[i] + residual[i];
+    compressed_t q  = float_codec<compressed_t>::compress(corrected);
+    out[i]          = q;
+    residual[i]     = corrected - float_codec<compressed_t>::decompress(q);
+  }
+}
+
+template <typename compressed_t>
+static __global__ void decompressKernel(const compressed_t* __restrict__ in,
+                                        float* __restrict__ out,
+                                        size_t count)
+{
+  size_t stride = static_cast<size_t>(blockDim.x) * gridDim.x;
+  for (size_t i = threadIdx.x + static_cast<size_t>(blockIdx.x) * blockDim.x; i < count;
+       i += stride) {
+    out[i] = float_codec<compressed_t>::decompress(in[i]);
+  }
+}
+
+template <typename compressed_t>
+void compressed_allreduce(const comms_t& comm,
+                          const float* sendbuff,
+                          float* recvbuff,
+                          float* residual,
+                          size_t count,
+                          cudaStream_t stream)
+{
+  rmm::device_uvector<compressed_t> compressed(count, stream);
+
+  constexpr unsigned BLOCK_SIZE = 256;
+  unsigned nblocks =
+    static_cast<unsigned>(std::min<size_t>((count + BLOCK_SIZE - 1) / BLOCK_SIZE, 65535));
+
+  compressWithFeedbackKernel<compressed_t>
+    <<<nblocks, BLOCK_SIZE, 0, stream>>>(sendbuff, residual, compressed.data(), count);
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
+
+  comm.allreduce(compressed.data(), compressed.data(), count, op_t::SUM, stream);
+
+  decompressKernel<compressed_t>
+    <<<nblocks, BLOCK_SIZE, 0, stream>>>(compressed.data(), recvbuff, count);
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
+}
+
+}  // namespace detail
+}  // end namespace comms
+}  // end namespace raft
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/comms/comms.hpp>
+
+#include <raft/cudart_utils.h>
+#include <rmm/device_uvector.hpp>
+
+#include <cuda_runtime.h>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace raft {
+namespace comms {
+namespace detail {
+
+/**
+ * @brief Topology-aware hierarchical collectives on top of an existing
+ * communicator.
+ *
+ * On machines where subsets of the GPUs are connected through fast peer
+ * links (e.g. two NVLink islands on a 2-socket box), a flat allreduce
+ * funnels all traffic through the slowest link. This class groups ranks
+ * into islands of mutually peer-accessible devices, builds an
+ * intra-island and an inter-island sub-communicator with comm_split, and
+ * performs allreduce as reduce-scatter within the island, allreduce of
+ * the scattered chunks across islands and allgather within the island,
+ * so only 1/island_size of the payload crosses the slow links.
+ *
+ * Islands are detected collectively at construction: ranks exchange a
+ * host identifier and device ordinal, and ranks on the same host whose
+ * devices are connected through peer access (cudaDeviceCanAccessPeer in
+ * both directions) form one island. Detection therefore assumes device
+ * visibility (e.g. CUDA_VISIBLE_DEVICES) is identical for all ranks of a
+ * host. The hierarchical path is only used when every island has the
+ * same size; otherwise, and for messages too small to amortize the extra
+ * launches, calls fall through to the flat communicator.
+ */
+class hierarchical_comms_t {
+ public:
+  hierarchical_comms_t() = delete;
+
+  /**
+   * @brief Collectively detects the peer-access islands and builds the
+   * intra- and inter-island sub-communicators. Must be called by every
+   * rank of the communicator.
+   *
+   * @param comms initialized communicator; must outlive this object
+   * @param stream CUDA stream used for the detection exchanges
+   * @param min_hierarchical_count allreduce calls with fewer elements
+   * than this fall through to the flat communicator
+   */
+  hierarchical_comms_t(const comms_t& comms,
+                       cudaStream_t stream,
+                       size_t min_hierarchical_count = 4096)
+    : comms_(comms), min_hierarchical_count_(min_hierarchical_count)
+  {
+    int const size = comms_.get_size();
+    int const rank = comms_.get_rank();
+    if (size < 2) { return; }
+
+    // exchange {host id, device ordinal} with all ranks
+    char hostname[256] = {0};
+    RAFT_EXPECTS(gethostname(hostname, sizeof(hostname) - 1) == 0, "gethostname failed");
+    uint64_t host_hash = std::hash<std::string>{}(std::string(hostname));
+    int dev{};
+    RAFT_CUDA_TRY(cudaGetDevice(&dev));
+
+    rmm::device_uvector<uint64_t> d_ids(2 * size, stream);
+    uint64_t local_id[2] = {host_hash, static_cast<uint64_t>(dev)};
+    update_device(d_ids.data() + 2 * rank, local_id, 2, stream);
+    comms_.allgather(d_ids.data() + 2 * rank, d_ids.data(), 2, stream);
+    comms_.sync_stream(stream);
+
+    std::vector<uint64_t> h_ids(2 * size);
+    update_host(h_ids.data(), d_ids.data(), 2 * size, stream);
+    RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+
+    // my island: connected component of peer-accessible devices on my
+    // host, identified by its smallest member rank. Only adjacency among
+    // ranks of this host is needed, and those devices are locally
+    // queryable.
+    std::vector<bool> in_island(size, false);
+    in_island[rank]   = true;
+    bool grew         = true;
+    auto is_connected = [&](int i, int j) {
+      int dev_i = static_cast<int>(h_ids[2 * i + 1]);
+      int dev_j = static_cast<int>(h_ids[2 * j + 1]);
+      if (dev_i == dev_j) { return true; }
+      int fwd{}, bwd{};
+      RAFT_CUDA_TRY(cudaDeviceCanAccessPeer(&fwd, dev_i, dev_j));
+      RAFT_CUDA_TRY(cudaDeviceCanAccessPeer(&bwd, dev_j, dev_i));
+      return fwd != 0 && bwd != 0;
+    };
+    while (grew) {
+      grew = false;
+      for (int i = 0; i < size; ++i) {
+        if (in_island[i] || h_ids[2 * i] != host_hash) { continue; }
+        for (int j = 0; j < size; ++j) {
+          if (in_island[j] && is_connected(i, j)) {
+            in_island[i] = true;
+            grew         = true;
+            break;
+          }
+        }
+      }
+    }
+    int color = rank;
+    for (int i = 0; i < size; ++i) {
+      if (in_island[i]) {
+        color = i;
+        break;
+      }
+    }
+
+    // share the colors so every rank can enumerate the islands
+    rmm::device_uvector<int> d_colors(size, stream);
+    update_device(d_colors.data() + rank, &color, 1, stream);
+    comms_.allgather(d_colors.data() + rank, d_colors.data(), 1, stream);
+    comms_.sync_stream(stream);
+
+    std::vector<int> h_colors(size);
+    update_host(h_colors.data(), d_colors.data(), size, stream);
+    RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+
+    std::vector<int> island_colors(h_colors);
+    std::sort(island_colors.begin(), island_colors.end());
+    island_colors.erase(std::unique(island_colors.begin(), island_colors.end()),
+                        island_colors.end());
+    num_islands_ = static_cast<int>(island_colors.size());
+    intra_size_  = static_cast<int>(std::count(h_colors.begin(), h_colors.end(), color));
+    intra_rank_  = static_cast<int>(
+      std::count(h_colors.begin(), h_colors.begin() + rank, color));
+    int island_idx = static_cast<int>(
+      std::find(island_colors.begin(), island_colors.end(), color) - island_colors.begin());
+
+    // hierarchical only pays off with several islands of equal size
+    bool equal_sizes = true;
+    for (int c : island_colors) {
+      equal_sizes =
+        equal_sizes && std::count(h_colors.begin(), h_colors.end(), c) == intra_size_;
+    }
+    if (num_islands_ < 2 || intra_size_ < 2 || !equal_sizes) { return; }
+
+    intra_ = std::make_unique<comms_t>(comms_.comm_split(color, intra_rank_));
+    inter_ = std::make_unique<comms_t>(comms_.comm_split(intra_rank_, island_idx));
+    hierarchical_ = true;
+  }
+
+  /** @brief whether the hierarchical path is available */
+  bool is_hierarchical() const { return hierarchical_; }
+
+  /** @brief number of detected islands (1 when not hierarchical) */
+  int get_num_islands() const { return hierarchical_ ? num_islands_ : 1; }
+
+  /** @brief number of ranks in the local island */
+  int get_island_size() const { return hierarchical_ ? intra_size_ : comms_.get_size(); }
+
+  /**
+   * @brief Allreduce that keeps all but 1/island_size of the traffic on
+   * the fast intra-island links: reduce-scatter within the island,
+   * allreduce of each rank's chunk across islands, allgather within the
+   * island. Falls through to the flat communicator when the hierarchy is
+   * unavailable or the message is small. Element counts not divisible by
+   * the island size are handled by reducing the tail flat.
+   */
+  template <typename value_t>
+  void allreduce(
+    const value_t* sendbuff, value_t* recvbuff, size_t count, op_t op, cudaStream_t stream) const
+  {
+    size_t const chunk = hierarchical_ ? count / intra_size_ : 0;
+    if (chunk == 0 || count < min_hierarchical_count_) {
+      comms_.allreduce(sendbuff, recvbuff, count, op, stream);
+      return;
+    }
+
+    value_t* my_chunk = recvbuff + static_cast<size_t>(intra_rank_) * chunk;
+    intra_->reducescatter(sendbuff, my_chunk, chunk, op, stream);
+    inter_->allreduce(my_chunk, my_chunk, chunk, op, stream);
+    // in place: every rank's chunk already sits at its slot in recvbuff
+    intra_->allgather(my_chunk, recvbuff, chunk, stream);
+
+    size_t const rem = count - chunk * intra_size_;
+    if (rem > 0) {
+      comms_.allreduce(sendbuff + count - rem, recvbuff + count - rem, rem, op, stream);
+    }
+  }
+
+ private:
+  const comms_t& comms_;
+  size_t min_hierarchical_count_;
+
+  bool hierarchical_{false};
+  int intra_rank_{0};
+  int intra_size_{1};
+  int num_islands_{1};
+  std::unique_ptr<comms_t> intra_{};
+  std::unique_ptr<comms_t> inter_{};
+};
+
+}  // namespace detail
+}  // end namespace comms
+}  // end namespace raft
@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/comms/detail/std_comms.hpp>
+#include <raft/comms/detail/util.hpp>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+#include <nccl.h>
+
+namespace raft {
+namespace comms {
+namespace detail {
+
+/**
+ * Process-level cache of live NCCL communicators, keyed by the bootstrap
+ * unique id together with the clique shape. The full `ncclCommInitRank`
+ * handshake costs seconds on a multi-GPU node, so workloads that create and
+ * destroy a handle per request should not re-bootstrap each time; the first
+ * lookup for a given id pays for the init, later lookups return the live
+ * communicator immediately.
+ *
+ * Cached communicators stay alive for the remainder of the process. They are
+ * deliberately not destroyed from the static destructor: by that point the
+ * CUDA runtime may already be torn down and `ncclCommDestroy` can hang, and
+ * the driver reclaims the resources at process exit anyway. Call `clear()`
+ * explicitly before CUDA shutdown if a clean teardown is required.
+ */
+class nccl_comm_cache {
+ public:
+  static nccl_comm_cache& instance()
+  {
+    static nccl_comm_cache cache;
+    return cache;
+  }
+
+  /** Returns the cached communicator for this (id, clique, rank), running
+   * the NCCL bootstrap on first use. Thread-safe; note that the init call
+   * itself is collective, so all ranks must reach it. */
+  ncclComm_t get_or_init(const ncclUniqueId& id, int num_ranks, int rank)
+  {
+    auto key = std::make_tuple(
+      std::string(id.internal, NCCL_UNIQUE_ID_BYTES), num_ranks, rank);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = comms_.find(key);
+    if (it == comms_.end()) {
+      ncclComm_t comm;
+      RAFT_NCCL_TRY(ncclCommInitRank(&comm, num_ranks, id, rank));
+      it = comms_.emplace(std::move(key), comm).first;
+    }
+    return it->second;
+  }
+
+  /** Destroys all cached communicators; collective across the clique. */
+  void clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& kv : comms_) {
+      RAFT_NCCL_TRY_NO_THROW(ncclCommDestroy(kv.second));
+    }
+    comms_.clear();
+  }
+
+ private:
+  nccl_comm_cache() = default;
+
+  std::mutex mutex_;
+  std::map<std::tuple<std::string, int, int>, ncclComm_t> comms_;
+};
+
+/**
+ * A comms implementation that defers the NCCL bootstrap to the first
+ * operation that actually needs the communicator. Handle setup only records
+ * the unique id and clique shape; `get_size()` and `get_rank()` answer from
+ * those without triggering the init, everything else bootstraps through the
+ * process-level `nccl_comm_cache` on first call and then delegates to a
+ * regular `std_comms`. Short-lived processes that never issue a collective
+ * thus never pay for the handshake.
+ */
+class lazy_nccl_comms : public comms_iface {
+ public:
+  lazy_nccl_comms(const ncclUniqueId& id, int num_ranks, int rank, rmm::cuda_stream_view stream)
+    : id_(id), num_ranks_(num_ranks), rank_(rank), stream_(stream)
+  {
+  }
+
+  int get_size() const { return num_ranks_; }
+
+  int get_rank() const { return rank_; }
+
+  std::unique_ptr<comms_iface> comm_split(int color, int key) const
+  {
+    return comms().comm_split(color, key);
+  }
+
+  void barrier() const { comms().barrier(); }
+
+  status_t sync_stream(cudaStream_t stream) const { return comms().sync_stream(stream); }
+
+  void isend(const void* buf, size_t size, int dest, int tag, request_t* request) const
+  {
+    comms().isend(buf, size, dest, tag, request);
+  }
+
+  void irecv(void* buf, size_t size, int source, int tag, request_t* request) const
+  {
+    comms().irecv(buf, size, source, tag, request);
+  }
+
+  void waitall(int count, request_t array_of_requests[]) const
+  {
+    comms().waitall(count, array_of_requests);
+  }
+
+  void allreduce(const void* sendbuff,
+                 void* recvbuff,
+                 size_t count,
+                 datatype_t datatype,
+                 op_t op,
+                 cudaStream_t stream) const
+  {
+    comms().allreduce(sendbuff, recvbuff, count, datatype, op, stream);
+  }
+
+  void bcast(void* buff, size_t count, datatype_t datatype, int root, cudaStream_t stream) const
+  {
+    comms().bcast(buff, count, datatype, root, stream);
+  }
+
+  void bcast(const void* sendbuff,
+             void* recvbuff,
+             size_t count,
+             datatype_t datatype,
+             int root,
+             cudaStream_t stream) const
+  {
+    comms().bcast(sendbuff, recvbuff, count, datatype, root, stream);
+  }
+
+  void reduce(const void* sendbuff,
+              void* recvbuff,
+              size_t count,
+              datatype_t datatype,
+              op_t op,
+              int root,
+              cudaStream_t stream) const
+  {
+    comms().reduce(sendbuff, recvbuff, count, datatype, op, root, stream);
+  }
+
+  void allgather(const void* sendbuff,
+                 void* recvbuff,
+                 size_t sendcount,
+                 datatype_t datatype,
+                 cudaStream_t stream) const
+  {
+    comms().allgather(sendbuff, recvbuff, sendcount, datatype, stream);
+  }
+
+  void allgatherv(const void* sendbuf,
+                  void* recvbuf,
+                  const size_t* recvcounts,
+                  const size_t* displs,
+                  datatype_t datatype,
+                  cudaStream_t stream) const
+  {
+    comms().allgatherv(sendbuf, recvbuf, recvcounts, displs, datatype, stream);
+  }
+
+  void gather(const void* sendbuff,
+              void* recvbuff,
+              size_t sendcount,
+              datatype_t datatype,
+              int root,
+              cudaStream_t stream) const
+  {
+    comms().gather(sendbuff, recvbuff, sendcount, datatype, root, stream);
+  }
+
+  void gatherv(const void* sendbuf,
+               void* recvbuf,
+               size_t sendcount,
+               const size_t* recvcounts,
+               const size_t* displs,
+               datatype_t datatype,
+               int root,
+               cudaStream_t stream) const
+  {
+    comms().gatherv(sendbuf, recvbuf, sendcount, recvcounts, displs, datatype, root, stream);
+  }
+
+  void reducescatter(const void* sendbuff,
+                     void* recvbuff,
+                     size_t recvcount,
+                     datatype_t datatype,
+                     op_t op,
+                     cudaStream_t stream) const
+  {
+    comms().reducescatter(sendbuff, recvbuff, recvcount, datatype, op, stream);
+  }
+
+  void device_send(const void* buf, size_t size, int dest, cudaStream_t stream) const
+  {
+    comms().device_send(buf, size, dest, stream);
+  }
+
+  void device_recv(void* buf, size_t size, int source, cudaStream_t stream) const
+  {
+    comms().device_recv(buf, size, source, stream);
+  }
+
+  void device_sendrecv(const void* sendbuf,
+                       size_t sendsize,
+                       int dest,
+                       void* recvbuf,
+                       size_t recvsize,
+                       int source,
+                       cudaStream_t stream) const
+  {
+    comms().device_sendrecv(sendbuf, sendsize, dest, recvbuf, recvsize, source, stream);
+  }
+
+  void device_multicast_sendrecv(const void* sendbuf,
+                                 std::vector<size_t> const& sendsizes,
+                                 std::vector<size_t> const& sendoffsets,
+                                 std::vector<int> const& dests,
+                                 void* recvbuf,
+                                 std::vector<size_t> const& recvsizes,
+                                 std::vector<size_t> const& recvoffsets,
+                                 std::vector<int> const& sources,
+                                 cudaStream_t stream) const
+  {
+    comms().device_multicast_sendrecv(
+      sendbuf, sendsizes, sendoffsets, dests, recvbuf, recvsizes, recvoffsets, sources, stream);
+  }
+
+ private:
+  // bootstrap on first use; the inner comms is shared through the cache so
+  // only the first call in the process pays for the NCCL handshake
+  std_comms& comms() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!inner_) {
+      auto nccl_comm = nccl_comm_cache::instance().get_or_init(id_, num_ranks_, rank_);
+      inner_.reset(new std_comms(nccl_comm, num_ranks_, rank_, stream_));
+    }
+    return *inner_;
+  }
+
+  ncclUniqueId id_;
+  int num_ranks_;
+  int rank_;
+  rmm::cuda_stream_view stream_;
+
+  mutable std::mutex mutex_;
+  mutable std::unique_ptr<std_comms> inner_;
+};
+
+}  // namespace detail
+}  // namespace comms
+}  // namespace raft
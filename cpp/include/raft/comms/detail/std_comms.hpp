@@ -40,10 +40,12 @@
 #include <utility>
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdio>
 #include <exception>
 #include <memory>
+#include <mutex>
 #include <stdlib.h>
 #include <thread>
 #include <time.h>
@@ -65,6 +67,12 @@ class std_comms : public comms_iface {
    * @param rank rank of the current worker
    * @param stream cuda stream for synchronizing and ordering collective operations
    * @param subcomms_ucp use ucp for subcommunicators
+   * @param ucp_context ucp context the worker was created from; required
+   *        only for the registered-buffer RMA path (may be nullptr)
+   * @param progress_thread when true, drive the ucp worker continuously
+   *        from a dedicated thread so message progress does not stall
+   *        while the host thread is busy (e.g. launching kernels). The
+   *        ucp worker must have been created with multi-thread support.
    */
   std_comms(ncclComm_t nccl_comm,
             ucp_worker_h ucp_worker,
@@ -72,7 +80,9 @@ class std_comms : public comms_iface {
             int num_ranks,
             int rank,
             rmm::cuda_stream_view stream,
-            bool subcomms_ucp = true)
+            bool subcomms_ucp         = true,
+            ucp_context_h ucp_context = nullptr,
+            bool progress_thread      = false)
     : nccl_comm_(nccl_comm),
       stream_(stream),
       status_(stream),
@@ -81,9 +91,11 @@ class std_comms : public comms_iface {
       subcomms_ucp_(subcomms_ucp),
       ucp_worker_(ucp_worker),
       ucp_eps_(eps),
+      ucp_context_(ucp_context),
       next_request_id_(0)
   {
     initialize();
+    if (progress_thread && ucp_worker_ != nullptr) { start_progress_thread(); }
   };
 
   /**
@@ -110,8 +122,53 @@ class std_comms : public comms_iface {
     buf_ = status_.data();
   }
 
+  /**
+   * @brief Starts a thread that drives the ucp worker continuously, so
+   * point-to-point messages make progress while the owning thread is
+   * busy. All UCP calls are serialized with the thread through a mutex.
+   */
+  void start_progress_thread()
+  {
+    ASSERT(ucp_worker_ != nullptr, "ERROR: UCX comms not initialized on communicator.");
+    ASSERT(!progress_thread_run_.load(), "ERROR: UCX progress thread already running.");
+
+    progress_thread_run_.store(true);
+    progress_thread_ = std::thread([this] {
+      while (progress_thread_run_.load(std::memory_order_relaxed)) {
+        bool made_progress = false;
+        {
+          std::lock_guard<std::mutex> lock(ucp_mutex_);
+          while (ucp_handler_.ucp_progress(ucp_worker_) != 0) {
+            made_progress = true;
+          }
+        }
+        // back off when idle so the thread does not monopolize a core
+        if (!made_progress) { std::this_thread::yield(); }
+      }
+    });
+  }
+
+  void stop_progress_thread()
+  {
+    if (progress_thread_run_.load()) {
+      progress_thread_run_.store(false);
+      progress_thread_.join();
+    }
+  }
+
   ~std_comms()
   {
+    stop_progress_thread();
+
+    // release any registrations the owner did not tear down explicitly
+    for (auto& region : rma_regions_) {
+      for (auto& peer : region.second.peers) {
+        if (peer.rkey != nullptr) { ucp_handler_.ucp_rkey_release(peer.rkey); }
+      }
+      ucp_handler_.ucp_mem_deregister(ucp_context_, region.second.memh);
+    }
+    rma_regions_.clear();
+
     requests_in_flight_.clear();
     free_requests_.clear();
   }
@@ -150,19 +207,29 @@ class std_comms : public comms_iface {
       }
     }
 
+    // Exchange the unique ids over the parent NCCL communicator instead of
+    // point-to-point messaging, so splitting also works on NCCL-only
+    // communicators without a ucp worker.
     ncclUniqueId id{};
     if (get_rank() == subcomm_ranks[0]) {  // root of the new subcommunicator
       RAFT_NCCL_TRY(ncclGetUniqueId(&id));
-      std::vector<request_t> requests(subcomm_ranks.size() - 1);
-      for (size_t i = 1; i < subcomm_ranks.size(); ++i) {
-        isend(&id, sizeof(ncclUniqueId), subcomm_ranks[i], color, requests.data() + (i - 1));
-      }
-      waitall(requests.size(), requests.data());
-    } else {
-      request_t request{};
-      irecv(&id, sizeof(ncclUniqueId), subcomm_ranks[0], color, &request);
-      waitall(1, &request);
     }
+    rmm::device_uvector<char> d_ids(get_size() * sizeof(ncclUniqueId), stream_);
+    update_device(d_ids.data() + get_rank() * sizeof(ncclUniqueId),
+                  reinterpret_cast<const char*>(&id),
+                  sizeof(ncclUniqueId),
+                  stream_);
+    allgather(d_ids.data() + get_rank() * sizeof(ncclUniqueId),
+              d_ids.data(),
+              sizeof(ncclUniqueId),
+              datatype_t::CHAR,
+              stream_);
+    this->sync_stream(stream_);
+    update_host(reinterpret_cast<char*>(&id),
+                d_ids.data() + subcomm_ranks[0] * sizeof(ncclUniqueId),
+                sizeof(ncclUniqueId),
+                stream_);
+    RAFT_CUDA_TRY(cudaStreamSynchronize(stream_));
     // FIXME: this seems unnecessary, do more testing and remove this
     barrier();
 
@@ -215,7 +282,10 @@ class std_comms : public comms_iface {
 
     ucp_request* ucp_req = (ucp_request*)malloc(sizeof(ucp_request));
 
-    this->ucp_handler_.ucp_isend(ucp_req, ep_ptr, buf, size, tag, default_tag_mask, get_rank());
+    {
+      auto lock = ucp_lock();
+      this->ucp_handler_.ucp_isend(ucp_req, ep_ptr, buf, size, tag, default_tag_mask, get_rank());
+    }
 
     requests_in_flight_.insert(std::make_pair(*request, ucp_req));
   }
@@ -231,7 +301,10 @@ class std_comms : public comms_iface {
     ucp_tag_t tag_mask = default_tag_mask;
 
     ucp_request* ucp_req = (ucp_request*)malloc(sizeof(ucp_request));
-    ucp_handler_.ucp_irecv(ucp_req, ucp_worker_, ep_ptr, buf, size, tag, tag_mask, source);
+    {
+      auto lock = ucp_lock();
+      ucp_handler_.ucp_irecv(ucp_req, ucp_worker_, ep_ptr, buf, size, tag, tag_mask, source);
+    }
 
     requests_in_flight_.insert(std::make_pair(*request, ucp_req));
   }
@@ -265,9 +338,14 @@ class std_comms : public comms_iface {
       for (std::vector<ucp_request*>::iterator it = requests.begin(); it != requests.end();) {
         bool restart = false;  // resets the timeout when any progress was made
 
-        // Causes UCP to progress through the send/recv message queue
-        while (ucp_handler_.ucp_progress(ucp_worker_) != 0) {
-          restart = true;
+        auto lock = ucp_lock();
+
+        // Causes UCP to progress through the send/recv message queue;
+        // when a progress thread is running it does this for us
+        if (!progress_thread_run_.load(std::memory_order_relaxed)) {
+          while (ucp_handler_.ucp_progress(ucp_worker_) != 0) {
+            restart = true;
+          }
         }
 
         auto req = *it;
@@ -309,10 +387,100 @@ class std_comms : public comms_iface {
                  op_t op,
                  cudaStream_t stream) const
   {
+    if (fused_active_) {
+      RAFT_EXPECTS(stream == fused_stream_,
+                   "allreduce inside a fused scope must use the scope's stream");
+      fused_entries_.push_back({sendbuff, recvbuff, count, datatype, op, 0});
+      return;
+    }
     RAFT_NCCL_TRY(ncclAllReduce(
       sendbuff, recvbuff, count, get_nccl_datatype(datatype), get_nccl_op(op), nccl_comm_, stream));
   }
 
+  void fused_allreduce_begin(cudaStream_t stream) const
+  {
+    RAFT_EXPECTS(!fused_active_, "fused_allreduce_begin: scope already open");
+    fused_active_ = true;
+    fused_stream_ = stream;
+    fused_entries_.clear();
+  }
+
+  void fused_allreduce_end(cudaStream_t stream) const
+  {
+    RAFT_EXPECTS(fused_active_, "fused_allreduce_end: no open scope");
+    RAFT_EXPECTS(stream == fused_stream_, "fused_allreduce_end: wrong stream");
+    fused_active_ = false;
+    if (fused_entries_.empty()) return;
+
+    // Lay the deferred messages out so all entries sharing a
+    // (datatype, op) pair form one contiguous segment; each segment is
+    // reduced with a single collective
+    struct segment_t {
+      datatype_t datatype;
+      op_t op;
+      size_t bytes;
+      size_t offset;
+    };
+    std::vector<segment_t> segments;
+    for (auto& entry : fused_entries_) {
+      auto it = std::find_if(segments.begin(), segments.end(), [&](segment_t const& s) {
+        return s.datatype == entry.datatype && s.op == entry.op;
+      });
+      if (it == segments.end()) {
+        segments.push_back({entry.datatype, entry.op, 0, 0});
+        it = segments.end() - 1;
+      }
+      entry.offset = it->bytes;
+      it->bytes += entry.count * get_datatype_size(entry.datatype);
+    }
+    size_t total_bytes = 0;
+    for (auto& segment : segments) {
+      segment.offset = total_bytes;
+      // keep every segment aligned for any element type
+      total_bytes += (segment.bytes + 15) / 16 * 16;
+    }
+    for (auto& entry : fused_entries_) {
+      auto it = std::find_if(segments.begin(), segments.end(), [&](segment_t const& s) {
+        return s.datatype == entry.datatype && s.op == entry.op;
+      });
+      entry.offset += it->offset;
+    }
+
+    if (!fused_buffer_ || fused_buffer_->size() < total_bytes) {
+      fused_buffer_.reset(new rmm::device_uvector<char>(total_bytes, stream));
+    }
+    char* flat = fused_buffer_->data();
+
+    // Pack, reduce each segment in place, scatter back; all ordered on
+    // the scope's stream
+    for (auto const& entry : fused_entries_) {
+      RAFT_CUDA_TRY(cudaMemcpyAsync(flat + entry.offset,
+                                    entry.sendbuff,
+                                    entry.count * get_datatype_size(entry.datatype),
+                                    cudaMemcpyDeviceToDevice,
+                                    stream));
+    }
+    RAFT_NCCL_TRY(ncclGroupStart());
+    for (auto const& segment : segments) {
+      RAFT_NCCL_TRY(ncclAllReduce(flat + segment.offset,
+                                  flat + segment.offset,
+                                  segment.bytes / get_datatype_size(segment.datatype),
+                                  get_nccl_datatype(segment.datatype),
+                                  get_nccl_op(segment.op),
+                                  nccl_comm_,
+                                  stream));
+    }
+    RAFT_NCCL_TRY(ncclGroupEnd());
+    for (auto const& entry : fused_entries_) {
+      RAFT_CUDA_TRY(cudaMemcpyAsync(entry.recvbuff,
+                                    flat + entry.offset,
+                                    entry.count * get_datatype_size(entry.datatype),
+                                    cudaMemcpyDeviceToDevice,
+                                    stream));
+    }
+    fused_entries_.clear();
+  }
+
   void bcast(void* buff, size_t count, datatype_t datatype, int root, cudaStream_t stream) const
   {
     RAFT_NCCL_TRY(
@@ -509,6 +677,218 @@ class std_comms : public comms_iface {
     RAFT_NCCL_TRY(ncclGroupEnd());
   }
 
+  /**
+   * @brief Registers a buffer with UCX once and exchanges remote keys and
+   * base addresses with all peers, so that subsequent put_registered /
+   * get_registered calls on it are zero-copy RMA with no per-operation
+   * registration or rendezvous. Every rank must call this collectively
+   * with its own buffer. The buffer must stay allocated until
+   * deregister_buffer.
+   *
+   * @param buf buffer to register (device or host memory)
+   * @param size size of the buffer in bytes
+   * @return handle identifying the registration
+   */
+  int register_buffer(void* buf, size_t size) const
+  {
+    ASSERT(ucp_worker_ != nullptr, "ERROR: UCX comms not initialized on communicator.");
+    ASSERT(ucp_context_ != nullptr,
+           "ERROR: communicator was constructed without a UCP context; "
+           "registered-buffer RMA is unavailable.");
+
+    rma_region_t region{};
+    region.base = buf;
+    region.size = size;
+    region.peers.resize(num_ranks_);
+    void* rkey_buffer{nullptr};
+    size_t rkey_size{0};
+    {
+      auto lock = ucp_lock();
+      ucp_handler_.ucp_mem_register(ucp_context_, buf, size, &region.memh);
+      ucp_handler_.ucp_rkey_pack_buffer(ucp_context_, region.memh, &rkey_buffer, &rkey_size);
+    }
+
+    // Exchange rkey sizes and base addresses, then the (variable length)
+    // packed rkeys themselves
+    uint64_t local_meta[3] = {
+      static_cast<uint64_t>(rkey_size), reinterpret_cast<uint64_t>(buf), size};
+    std::vector<uint64_t> peer_meta(3 * num_ranks_, 0);
+    std::vector<request_t> requests;
+    requests.reserve(2 * (num_ranks_ - 1));
+    for (int r = 0; r < num_ranks_; ++r) {
+      if (r == rank_) continue;
+      requests.push_back({});
+      isend(local_meta, sizeof(local_meta), r, rma_exchange_tag, &requests.back());
+      requests.push_back({});
+      irecv(peer_meta.data() + 3 * r, sizeof(local_meta), r, rma_exchange_tag, &requests.back());
+    }
+    waitall(requests.size(), requests.data());
+
+    std::vector<std::vector<char>> peer_rkeys(num_ranks_);
+    requests.clear();
+    for (int r = 0; r < num_ranks_; ++r) {
+      if (r == rank_) continue;
+      peer_rkeys[r].resize(peer_meta[3 * r]);
+      requests.push_back({});
+      isend(rkey_buffer, rkey_size, r, rma_exchange_tag, &requests.back());
+      requests.push_back({});
+      irecv(peer_rkeys[r].data(), peer_rkeys[r].size(), r, rma_exchange_tag, &requests.back());
+    }
+    waitall(requests.size(), requests.data());
+
+    {
+      auto lock = ucp_lock();
+      ucp_handler_.ucp_rkey_release_buffer(rkey_buffer);
+
+      for (int r = 0; r < num_ranks_; ++r) {
+        if (r == rank_) continue;
+        ucp_handler_.ucp_rkey_unpack_for_ep(
+          (*ucp_eps_)[r], peer_rkeys[r].data(), &region.peers[r].rkey);
+        region.peers[r].remote_addr = peer_meta[3 * r + 1];
+        region.peers[r].size        = peer_meta[3 * r + 2];
+      }
+    }
+
+    int handle = next_rma_handle_++;
+    rma_regions_.emplace(handle, std::move(region));
+    return handle;
+  }
+
+  /**
+   * @brief Releases the registration identified by the given handle,
+   * destroying the peer remote keys and deregistering the buffer
+   */
+  void deregister_buffer(int handle) const
+  {
+    auto it = rma_regions_.find(handle);
+    ASSERT(it != rma_regions_.end(), "ERROR: deregister_buffer on invalid handle: %d", handle);
+    {
+      auto lock = ucp_lock();
+      for (auto& peer : it->second.peers) {
+        if (peer.rkey != nullptr) { ucp_handler_.ucp_rkey_release(peer.rkey); }
+      }
+      ucp_handler_.ucp_mem_deregister(ucp_context_, it->second.memh);
+    }
+    rma_regions_.erase(it);
+  }
+
+  /**
+   * @brief Zero-copy RMA put from a registered local buffer into the
+   * peer's registered buffer. Completion of the request only guarantees
+   * local reuse of the source range; call flush_registered to guarantee
+   * the data has landed remotely.
+   */
+  void put_registered(int handle,
+                      size_t local_offset,
+                      int dest,
+                      size_t remote_offset,
+                      size_t size,
+                      request_t* request) const
+  {
+    auto it = rma_regions_.find(handle);
+    ASSERT(it != rma_regions_.end(), "ERROR: put_registered on invalid handle: %d", handle);
+    auto const& region = it->second;
+    ASSERT(local_offset + size <= region.size, "ERROR: put_registered out of local bounds.");
+    ASSERT(remote_offset + size <= region.peers[dest].size,
+           "ERROR: put_registered out of remote bounds.");
+
+    get_request_id(request);
+    ucp_request* ucp_req = (ucp_request*)malloc(sizeof(ucp_request));
+    {
+      auto lock = ucp_lock();
+      ucp_handler_.ucp_iput(ucp_req,
+                            (*ucp_eps_)[dest],
+                            static_cast<const char*>(region.base) + local_offset,
+                            size,
+                            region.peers[dest].remote_addr + remote_offset,
+                            region.peers[dest].rkey,
+                            get_rank());
+    }
+    requests_in_flight_.insert(std::make_pair(*request, ucp_req));
+  }
+
+  /**
+   * @brief Zero-copy RMA get from the peer's registered buffer into a
+   * registered local buffer
+   */
+  void get_registered(int handle,
+                      size_t local_offset,
+                      int source,
+                      size_t remote_offset,
+                      size_t size,
+                      request_t* request) const
+  {
+    auto it = rma_regions_.find(handle);
+    ASSERT(it != rma_regions_.end(), "ERROR: get_registered on invalid handle: %d", handle);
+    auto const& region = it->second;
+    ASSERT(local_offset + size <= region.size, "ERROR: get_registered out of local bounds.");
+    ASSERT(remote_offset + size <= region.peers[source].size,
+           "ERROR: get_registered out of remote bounds.");
+
+    get_request_id(request);
+    ucp_request* ucp_req = (ucp_request*)malloc(sizeof(ucp_request));
+    {
+      auto lock = ucp_lock();
+      ucp_handler_.ucp_iget(ucp_req,
+                            (*ucp_eps_)[source],
+                            static_cast<char*>(region.base) + local_offset,
+                            size,
+                            region.peers[source].remote_addr + remote_offset,
+                            region.peers[source].rkey,
+                            source);
+    }
+    requests_in_flight_.insert(std::make_pair(*request, ucp_req));
+  }
+
+  /**
+   * @brief Flushes outstanding RMA operations towards the given peer;
+   * completion of the request guarantees remote completion of all puts
+   * issued to it beforehand
+   */
+  void flush_registered(int dest, request_t* request) const
+  {
+    ASSERT(ucp_worker_ != nullptr, "ERROR: UCX comms not initialized on communicator.");
+    get_request_id(request);
+    ucp_request* ucp_req = (ucp_request*)malloc(sizeof(ucp_request));
+    {
+      auto lock = ucp_lock();
+      ucp_handler_.ucp_iflush(ucp_req, (*ucp_eps_)[dest], dest);
+    }
+    requests_in_flight_.insert(std::make_pair(*request, ucp_req));
+  }
+
+  /**
+   * @brief Allgatherv over a symmetrically registered buffer: each rank's
+   * contribution, already stored at displs[rank] in its own registered
+   * buffer, is put directly into every peer's registered buffer at the
+   * same displacement via zero-copy RMA. All counts and displacements
+   * are in bytes and must match across ranks. Synchronizing: returns
+   * once every rank's buffer holds all contributions.
+   */
+  void allgatherv_registered(int handle, const size_t* counts, const size_t* displs) const
+  {
+    auto it = rma_regions_.find(handle);
+    ASSERT(it != rma_regions_.end(), "ERROR: allgatherv_registered on invalid handle: %d", handle);
+
+    std::vector<request_t> requests;
+    requests.reserve(2 * (num_ranks_ - 1));
+    for (int r = 0; r < num_ranks_; ++r) {
+      if (r == rank_ || counts[rank_] == 0) continue;
+      requests.push_back({});
+      put_registered(handle, displs[rank_], r, displs[rank_], counts[rank_], &requests.back());
+    }
+    for (int r = 0; r < num_ranks_; ++r) {
+      if (r == rank_) continue;
+      requests.push_back({});
+      flush_registered(r, &requests.back());
+    }
+    waitall(requests.size(), requests.data());
+
+    // remote completion of our puts does not imply the peers' puts have
+    // landed here; a barrier does
+    barrier();
+  }
+
  private:
   ncclComm_t nccl_comm_;
   cudaStream_t stream_;
@@ -524,9 +904,54 @@ class std_comms : public comms_iface {
   comms_ucp_handler ucp_handler_;
   ucp_worker_h ucp_worker_;
   std::shared_ptr<ucp_ep_h*> ucp_eps_;
+  ucp_context_h ucp_context_{nullptr};
   mutable request_t next_request_id_;
   mutable std::unordered_map<request_t, struct ucp_request*> requests_in_flight_;
   mutable std::unordered_set<request_t> free_requests_;
+
+  // progress thread state; ucp workers are not thread safe, so when the
+  // progress thread is running every ucp call is serialized through
+  // ucp_mutex_. Without the thread, ucp_lock() is a no-op.
+  mutable std::mutex ucp_mutex_;
+  std::atomic<bool> progress_thread_run_{false};
+  std::thread progress_thread_;
+
+  std::unique_lock<std::mutex> ucp_lock() const
+  {
+    return progress_thread_run_.load(std::memory_order_relaxed)
+             ? std::unique_lock<std::mutex>(ucp_mutex_)
+             : std::unique_lock<std::mutex>();
+  }
+
+  // registered-buffer RMA state
+  static constexpr int rma_exchange_tag{0x524d41};  // "RMA"
+  struct rma_peer_t {
+    ucp_rkey_h rkey{nullptr};
+    uint64_t remote_addr{0};
+    size_t size{0};
+  };
+  struct rma_region_t {
+    ucp_mem_h memh{nullptr};
+    void* base{nullptr};
+    size_t size{0};
+    std::vector<rma_peer_t> peers{};
+  };
+  mutable int next_rma_handle_{0};
+  mutable std::unordered_map<int, rma_region_t> rma_regions_{};
+
+  // fused-allreduce scope state
+  struct fused_entry_t {
+    const void* sendbuff;
+    void* recvbuff;
+    size_t count;
+    datatype_t datatype;
+    op_t op;
+    size_t offset;
+  };
+  mutable bool fused_active_{false};
+  mutable cudaStream_t fused_stream_{nullptr};
+  mutable std::vector<fused_entry_t> fused_entries_{};
+  mutable std::unique_ptr<rmm::device_uvector<char>> fused_buffer_{};
 };
 }  // namespace detail
 }  // end namespace comms
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <raft/comms/comms.hpp>
+#include <raft/comms/detail/hierarchical_comms.hpp>
 #include <raft/handle.hpp>
 #include <rmm/device_scalar.hpp>
 #include <rmm/device_uvector.hpp>
@@ -514,9 +515,93 @@ bool test_pointToPoint_device_multicast_sendrecv(const handle_t& h, int numTrial
 }
 
 /**
- * A simple test that the comms can be split into 2 separate subcommunicators
+ * @brief A sanity check that the chunked pipelined broadcast delivers the
+ * same data as the monolithic one
  *
- * @param h the raft handle to use. This is expected to already have an
+ * @param[in] handle the raft handle to use. This is expected to already have an
+ *        initialized comms instance and a stream pool.
+ *  @param[in] root the root rank id
+ */
+bool test_collective_bcast_pipelined(const handle_t& handle, int root)
+{
+  comms_t const& communicator = handle.get_comms();
+
+  cudaStream_t stream = handle.get_stream();
+
+  std::vector<cudaStream_t> streams;
+  for (std::size_t i = 0; i < handle.get_stream_pool_size(); ++i) {
+    streams.push_back(handle.get_stream_from_stream_pool(i));
+  }
+  if (streams.empty()) { streams.push_back(stream); }
+
+  int const count = 1 << 13;
+  std::vector<int> sends(count, 0);
+  if (communicator.get_rank() == root) { std::iota(sends.begin(), sends.end(), 0); }
+
+  rmm::device_uvector<int> temp_d(count, stream);
+  RAFT_CUDA_TRY(cudaMemcpyAsync(
+    temp_d.data(), sends.data(), count * sizeof(int), cudaMemcpyHostToDevice, stream));
+
+  // odd chunk size so the last chunk is a partial one
+  communicator.bcast_pipelined(temp_d.data(), count, root, stream, streams, 1000);
+
+  std::vector<int> temp_h(count, -1);
+  RAFT_CUDA_TRY(cudaMemcpyAsync(
+    temp_h.data(), temp_d.data(), count * sizeof(int), cudaMemcpyDeviceToHost, stream));
+  handle.sync_stream(stream);
+  communicator.barrier();
+
+  for (int i = 0; i < count; i++) {
+    if (temp_h[i] != i) return false;
+  }
+  return true;
+}
+
+/**
+ * @brief A sanity check that the topology-aware hierarchical allreduce
+ * produces the same result as the flat collective
+ *
+ * @param[in] handle the raft handle to use. This is expected to already have an
+ *        initialized comms instance.
+ *  @param[in] root the root rank id
+ */
+bool test_collective_hierarchical_allreduce(const handle_t& handle, int root)
+{
+  comms_t const& communicator = handle.get_comms();
+
+  cudaStream_t stream = handle.get_stream();
+
+  hierarchical_comms_t hier(communicator, stream, 1);
+
+  int const count = 1 << 13;
+  std::vector<int> sends(count, 1);
+
+  rmm::device_uvector<int> temp_d(count, stream);
+  RAFT_CUDA_TRY(cudaMemcpyAsync(
+    temp_d.data(), sends.data(), count * sizeof(int), cudaMemcpyHostToDevice, stream));
+
+  hier.allreduce(temp_d.data(), temp_d.data(), count, op_t::SUM, stream);
+
+  std::vector<int> temp_h(count, 0);
+  RAFT_CUDA_TRY(cudaMemcpyAsync(
+    temp_h.data(), temp_d.data(), count * sizeof(int), cudaMemcpyDeviceToHost, stream));
+  handle.sync_stream(stream);
+  communicator.barrier();
+
+  std::cout << "Clique size: " << communicator.get_size() << std::endl;
+  std::cout << "Islands: " << hier.get_num_islands() << " x " << hier.get_island_size()
+            << std::endl;
+
+  for (int i = 0; i < count; i++) {
+    if (temp_h[i] != communicator.get_size()) return false;
+  }
+  return true;
+}
+
+/**
+ * A simple sanity check that the comms can be split into 2 separate subcommunicators
+ *
+ * @param the raft handle to use. This is expected to already have an
  *        initialized comms instance.
  * @param n_colors number of different colors to test
  */
@@ -18,7 +18,9 @@
 
 #include <dlfcn.h>
 #include <raft/cudart_utils.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 #include <ucp/api/ucp.h>
 #include <ucp/api/ucp_def.h>
 
@@ -43,6 +45,26 @@ typedef ucs_status_ptr_t (*dlsym_recv)(ucp_worker_h,
                                        ucp_tag_t,
                                        ucp_tag_recv_callback_t);
 
+typedef ucs_status_t (*dlsym_mem_map)(ucp_context_h, const ucp_mem_map_params_t*, ucp_mem_h*);
+
+typedef ucs_status_t (*dlsym_mem_unmap)(ucp_context_h, ucp_mem_h);
+
+typedef ucs_status_t (*dlsym_rkey_pack)(ucp_context_h, ucp_mem_h, void**, size_t*);
+
+typedef void (*dlsym_rkey_buffer_release)(void*);
+
+typedef ucs_status_t (*dlsym_rkey_unpack)(ucp_ep_h, const void*, ucp_rkey_h*);
+
+typedef void (*dlsym_rkey_destroy)(ucp_rkey_h);
+
+typedef ucs_status_ptr_t (*dlsym_put)(
+  ucp_ep_h, const void*, size_t, uint64_t, ucp_rkey_h, ucp_send_callback_t);
+
+typedef ucs_status_ptr_t (*dlsym_get)(
+  ucp_ep_h, void*, size_t, uint64_t, ucp_rkey_h, ucp_send_callback_t);
+
+typedef ucs_status_ptr_t (*dlsym_ep_flush)(ucp_ep_h, unsigned, ucp_send_callback_t);
+
 /**
  * Standard UCX request object that will be passed
  * around asynchronously. This object is really
@@ -103,6 +125,7 @@ class comms_ucp_handler {
     load_free_req_func();
     load_print_info_func();
     load_worker_progress_func();
+    load_rma_funcs();
   }
 
   ~comms_ucp_handler() { dlclose(ucp_handle); }
@@ -115,6 +138,15 @@ class comms_ucp_handler {
   dlsym_worker_progress worker_progress_func;
   dlsym_send send_func;
   dlsym_recv recv_func;
+  dlsym_mem_map mem_map_func;
+  dlsym_mem_unmap mem_unmap_func;
+  dlsym_rkey_pack rkey_pack_func;
+  dlsym_rkey_buffer_release rkey_buffer_release_func;
+  dlsym_rkey_unpack rkey_unpack_func;
+  dlsym_rkey_destroy rkey_destroy_func;
+  dlsym_put put_func;
+  dlsym_get get_func;
+  dlsym_ep_flush ep_flush_func;
 
   void load_ucp_handle()
   {
@@ -163,6 +195,29 @@ class comms_ucp_handler {
     assert_dlerror();
   }
 
+  void load_rma_funcs()
+  {
+    mem_map_func = (dlsym_mem_map)dlsym(ucp_handle, "ucp_mem_map");
+    assert_dlerror();
+    mem_unmap_func = (dlsym_mem_unmap)dlsym(ucp_handle, "ucp_mem_unmap");
+    assert_dlerror();
+    rkey_pack_func = (dlsym_rkey_pack)dlsym(ucp_handle, "ucp_rkey_pack");
+    assert_dlerror();
+    rkey_buffer_release_func =
+      (dlsym_rkey_buffer_release)dlsym(ucp_handle, "ucp_rkey_buffer_release");
+    assert_dlerror();
+    rkey_unpack_func = (dlsym_rkey_unpack)dlsym(ucp_handle, "ucp_ep_rkey_unpack");
+    assert_dlerror();
+    rkey_destroy_func = (dlsym_rkey_destroy)dlsym(ucp_handle, "ucp_rkey_destroy");
+    assert_dlerror();
+    put_func = (dlsym_put)dlsym(ucp_handle, "ucp_put_nb");
+    assert_dlerror();
+    get_func = (dlsym_get)dlsym(ucp_handle, "ucp_get_nb");
+    assert_dlerror();
+    ep_flush_func = (dlsym_ep_flush)dlsym(ucp_handle, "ucp_ep_flush_nb");
+    assert_dlerror();
+  }
+
   ucp_tag_t build_message_tag(int rank, int tag) const
   {
     // keeping the rank in the lower bits enables debugging.
@@ -253,6 +308,124 @@ class comms_ucp_handler {
            "unable to receive UCX data message (%d)\n",
            UCS_PTR_STATUS(recv_result));
   }
+
+  /**
+   * @brief Registers a memory region with UCX once so that repeated RMA
+   * operations on it need no per-operation registration or rendezvous.
+   */
+  void ucp_mem_register(ucp_context_h context, void* buf, size_t size, ucp_mem_h* memh) const
+  {
+    ucp_mem_map_params_t params;
+    memset(&params, 0, sizeof(params));
+    params.field_mask = UCP_MEM_MAP_PARAM_FIELD_ADDRESS | UCP_MEM_MAP_PARAM_FIELD_LENGTH;
+    params.address    = buf;
+    params.length     = size;
+
+    ucs_status_t status = (*(mem_map_func))(context, &params, memh);
+    ASSERT(status == UCS_OK, "ucp_mem_map failed (%d)\n", status);
+  }
+
+  /**
+   * @brief Deregisters a memory region registered with `ucp_mem_register`
+   */
+  void ucp_mem_deregister(ucp_context_h context, ucp_mem_h memh) const
+  {
+    ucs_status_t status = (*(mem_unmap_func))(context, memh);
+    ASSERT(status == UCS_OK, "ucp_mem_unmap failed (%d)\n", status);
+  }
+
+  /**
+   * @brief Packs the remote key of a registered region into a transferable
+   * buffer. The buffer must be released with `ucp_rkey_release_buffer`.
+   */
+  void ucp_rkey_pack_buffer(ucp_context_h context,
+                            ucp_mem_h memh,
+                            void** rkey_buffer,
+                            size_t* rkey_size) const
+  {
+    ucs_status_t status = (*(rkey_pack_func))(context, memh, rkey_buffer, rkey_size);
+    ASSERT(status == UCS_OK, "ucp_rkey_pack failed (%d)\n", status);
+  }
+
+  void ucp_rkey_release_buffer(void* rkey_buffer) const
+  {
+    (*(rkey_buffer_release_func))(rkey_buffer);
+  }
+
+  /**
+   * @brief Unpacks a peer's packed remote key for use on the given endpoint
+   */
+  void ucp_rkey_unpack_for_ep(ucp_ep_h ep_ptr, const void* rkey_buffer, ucp_rkey_h* rkey) const
+  {
+    ucs_status_t status = (*(rkey_unpack_func))(ep_ptr, rkey_buffer, rkey);
+    ASSERT(status == UCS_OK, "ucp_ep_rkey_unpack failed (%d)\n", status);
+  }
+
+  void ucp_rkey_release(ucp_rkey_h rkey) const { (*(rkey_destroy_func))(rkey); }
+
+  /**
+   * @brief Asynchronous zero-copy RMA put from a registered local region
+   * into a peer's registered region
+   */
+  void ucp_iput(ucp_request* req,
+                ucp_ep_h ep_ptr,
+                const void* buf,
+                size_t size,
+                uint64_t remote_addr,
+                ucp_rkey_h rkey,
+                int rank) const
+  {
+    ucs_status_ptr_t put_result = (*(put_func))(ep_ptr, buf, size, remote_addr, rkey, send_callback);
+
+    ASSERT(
+      !UCS_PTR_IS_ERR(put_result), "unable to put UCX RMA data (%d)\n", UCS_PTR_STATUS(put_result));
+
+    req->needs_release   = UCS_PTR_STATUS(put_result) != UCS_OK;
+    req->other_rank      = rank;
+    req->is_send_request = true;
+    req->req             = (struct ucx_context*)put_result;
+  }
+
+  /**
+   * @brief Asynchronous zero-copy RMA get from a peer's registered region
+   * into a registered local region
+   */
+  void ucp_iget(ucp_request* req,
+                ucp_ep_h ep_ptr,
+                void* buf,
+                size_t size,
+                uint64_t remote_addr,
+                ucp_rkey_h rkey,
+                int rank) const
+  {
+    ucs_status_ptr_t get_result = (*(get_func))(ep_ptr, buf, size, remote_addr, rkey, send_callback);
+
+    ASSERT(
+      !UCS_PTR_IS_ERR(get_result), "unable to get UCX RMA data (%d)\n", UCS_PTR_STATUS(get_result));
+
+    req->needs_release   = UCS_PTR_STATUS(get_result) != UCS_OK;
+    req->other_rank      = rank;
+    req->is_send_request = false;
+    req->req             = (struct ucx_context*)get_result;
+  }
+
+  /**
+   * @brief Flushes outstanding RMA operations on the given endpoint;
+   * completion of the returned request guarantees remote completion
+   */
+  void ucp_iflush(ucp_request* req, ucp_ep_h ep_ptr, int rank) const
+  {
+    ucs_status_ptr_t flush_result = (*(ep_flush_func))(ep_ptr, 0, send_callback);
+
+    ASSERT(!UCS_PTR_IS_ERR(flush_result),
+           "unable to flush UCX endpoint (%d)\n",
+           UCS_PTR_STATUS(flush_result));
+
+    req->needs_release   = UCS_PTR_STATUS(flush_result) != UCS_OK;
+    req->other_rank      = rank;
+    req->is_send_request = true;
+    req->req             = (struct ucx_context*)flush_result;
+  }
 };
 }  // end namespace detail
 }  // end namespace comms
@@ -78,6 +78,8 @@ get_datatype_size(const datatype_t datatype)
     case datatype_t::UINT64: return sizeof(uint64_t);
     case datatype_t::FLOAT32: return sizeof(float);
     case datatype_t::FLOAT64: return sizeof(double);
+    case datatype_t::FLOAT16: return 2;
+    case datatype_t::BFLOAT16: return 2;
     default: throw "Unsupported datatype";
   }
 }
@@ -95,6 +97,10 @@ get_nccl_datatype(const datatype_t datatype)
     case datatype_t::UINT64: return ncclUint64;
     case datatype_t::FLOAT32: return ncclFloat;
     case datatype_t::FLOAT64: return ncclDouble;
+    case datatype_t::FLOAT16: return ncclFloat16;
+#if NCCL_VERSION_CODE >= NCCL_VERSION(2, 10, 0)
+    case datatype_t::BFLOAT16: return ncclBfloat16;
+#endif
     default: throw "Unsupported datatype";
   }
 }
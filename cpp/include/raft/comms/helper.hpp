@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <raft/comms/detail/lazy_comms.hpp>
 #include <raft/comms/std_comms.hpp>
 #include <raft/handle.hpp>
 
@@ -44,6 +45,43 @@ void build_comms_nccl_only(handle_t* handle, ncclComm_t nccl_comm, int num_ranks
   handle->set_comms(communicator);
 }
 
+/**
+ * Function to construct comms_t and inject it on a handle_t without
+ * running the NCCL bootstrap. Only the unique id and the clique shape are
+ * recorded at handle setup; `ncclCommInitRank` runs on the first collective
+ * (or other comms operation) and the resulting communicator is cached
+ * process-wide, so repeated handle create/destroy cycles with the same id
+ * reuse the live communicator instead of re-bootstrapping.
+ *
+ * Note: the deferred init is itself a collective, so the first comms
+ * operation must be reached by all ranks of the clique.
+ *
+ * @param handle raft::handle_t for injecting the comms
+ * @param uniqueId character array holding the NCCL unique id shared by the
+ *                 clique (see get_unique_id())
+ * @param size length of the uniqueId array
+ * @param num_ranks number of ranks in communicator clique
+ * @param rank rank of local instance
+ */
+void build_comms_nccl_lazy(handle_t* handle, char* uniqueId, int size, int num_ranks, int rank)
+{
+  ncclUniqueId id;
+  memcpy(id.internal, uniqueId, size);
+
+  cudaStream_t stream = handle->get_stream();
+
+  auto communicator = std::make_shared<comms_t>(std::unique_ptr<comms_iface>(
+    new raft::comms::detail::lazy_nccl_comms(id, num_ranks, rank, stream)));
+  handle->set_comms(communicator);
+}
+
+/**
+ * Destroys all NCCL communicators held by the process-level cache used by
+ * build_comms_nccl_lazy(). Collective across the clique; call before CUDA
+ * shutdown when a clean teardown is required.
+ */
+inline void clear_nccl_comm_cache() { detail::nccl_comm_cache::instance().clear(); }
+
 /**
  * Function to construct comms_t and inject it on a handle_t. This
  * is used for convenience in the Python layer.
@@ -58,9 +96,23 @@ void build_comms_nccl_only(handle_t* handle, ncclComm_t nccl_comm, int num_ranks
  *        the ucp_ep_h doesn't need to be exposed through the cython layer.
  * @param num_ranks number of ranks in communicator clique
  * @param rank rank of local instance
+ * @param ucp_context ucp context the worker was created from, or nullptr.
+ *        Note: This is purposefully left as void* so that the ucp_context_h
+ *        doesn't need to be exposed through the cython layer. Required only
+ *        for the registered-buffer RMA path.
+ * @param progress_thread when true, a dedicated thread drives the ucp
+ *        worker continuously so point-to-point messages make progress
+ *        while the owning thread is busy. The worker must have been
+ *        created with multi-thread support.
  */
-void build_comms_nccl_ucx(
-  handle_t* handle, ncclComm_t nccl_comm, void* ucp_worker, void* eps, int num_ranks, int rank)
+void build_comms_nccl_ucx(handle_t* handle,
+                          ncclComm_t nccl_comm,
+                          void* ucp_worker,
+                          void* eps,
+                          int num_ranks,
+                          int rank,
+                          void* ucp_context    = nullptr,
+                          bool progress_thread = false)
 {
   auto eps_sp = std::make_shared<ucp_ep_h*>(new ucp_ep_h[num_ranks]);
 
@@ -81,8 +133,16 @@ void build_comms_nccl_ucx(
   cudaStream_t stream = handle->get_stream();
 
   auto communicator =
-    std::make_shared<comms_t>(std::unique_ptr<comms_iface>(new raft::comms::std_comms(
-      nccl_comm, (ucp_worker_h)ucp_worker, eps_sp, num_ranks, rank, stream)));
+    std::make_shared<comms_t>(
+      std::unique_ptr<comms_iface>(new raft::comms::std_comms(nccl_comm,
+                                                              (ucp_worker_h)ucp_worker,
+                                                              eps_sp,
+                                                              num_ranks,
+                                                              rank,
+                                                              stream,
+                                                              true,
+                                                              (ucp_context_h)ucp_context,
+                                                              progress_thread)));
   handle->set_comms(communicator);
 }
 
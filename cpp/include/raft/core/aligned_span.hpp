@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <raft/core/span.hpp>
+#include <raft/error.hpp>
+
+namespace raft {
+
+/**
+ * @brief A span whose type carries a static byte-alignment guarantee on the
+ *        base pointer.
+ *
+ * Kernels that vectorize their loads and stores (cf. `raft/vectorized.cuh`)
+ * normally have to probe pointer alignment at runtime to choose a vector
+ * width, and silently fall back to scalar accesses on oddly-offset slices.
+ * Passing an `aligned_span` lets them instantiate the full-width path at
+ * compile time, and turns a misaligned input into a loud construction-time
+ * error instead of a 2x slowdown.
+ *
+ * Construction verifies the pointer; subviews deliberately decay to plain
+ * `raft::span` (via the base class) since an offset does not preserve the
+ * guarantee. An `aligned_span` converts implicitly to one with a smaller
+ * (divisor) alignment.
+ *
+ * @code
+ *   rmm::device_uvector<float> uvec(n, stream);  // rmm allocations are 256B aligned
+ *   auto in = make_device_aligned_span<16>(uvec.data(), uvec.size());
+ * @endcode
+ */
+template <typename T, bool is_device, std::size_t Alignment, std::size_t Extent = dynamic_extent>
+class aligned_span : public span<T, is_device, Extent> {
+  static_assert(Alignment != 0 && (Alignment & (Alignment - 1)) == 0,
+                "Alignment must be a power of two");
+  static_assert(Alignment % alignof(T) == 0,
+                "Alignment must be a multiple of the element alignment");
+
+ public:
+  using base_type = span<T, is_device, Extent>;
+  using typename base_type::pointer;
+  using typename base_type::size_type;
+
+  static constexpr std::size_t alignment = Alignment;
+
+  constexpr aligned_span() noexcept = default;
+
+  /**
+   * @brief Constructs an aligned span over [ptr, ptr + count); throws if the
+   *        pointer does not satisfy the static alignment.
+   */
+  aligned_span(pointer ptr, size_type count) : base_type{ptr, count}
+  {
+    RAFT_EXPECTS(reinterpret_cast<std::uintptr_t>(ptr) % Alignment == 0,
+                 "aligned_span: pointer is not %zu-byte aligned",
+                 Alignment);
+  }
+
+  /**
+   * @brief Converts from a span with a stronger (multiple) alignment guarantee.
+   */
+  template <std::size_t OtherAlignment,
+            class = typename std::enable_if<OtherAlignment % Alignment == 0>::type>
+  constexpr aligned_span(const aligned_span<T, is_device, OtherAlignment, Extent>& other) noexcept
+    : base_type{other}
+  {
+  }
+};
+
+/**
+ * @brief An aligned span class for host pointer.
+ */
+template <typename T, std::size_t Alignment = 16, std::size_t extent = dynamic_extent>
+using host_aligned_span = aligned_span<T, false, Alignment, extent>;
+
+/**
+ * @brief An aligned span class for device pointer.
+ */
+template <typename T, std::size_t Alignment = 16, std::size_t extent = dynamic_extent>
+using device_aligned_span = aligned_span<T, true, Alignment, extent>;
+
+/**
+ * @brief Create an aligned span over a host pointer; throws on misalignment.
+ */
+template <std::size_t Alignment = 16, typename T>
+auto make_host_aligned_span(T* ptr, std::size_t count)
+{
+  return host_aligned_span<T, Alignment>{ptr, count};
+}
+
+/**
+ * @brief Create an aligned span over a device pointer; throws on misalignment.
+ *        Allocations obtained through rmm satisfy any Alignment up to 256 bytes.
+ */
+template <std::size_t Alignment = 16, typename T>
+auto make_device_aligned_span(T* ptr, std::size_t count)
+{
+  return device_aligned_span<T, Alignment>{ptr, count};
+}
+
+}  // namespace raft
@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __RAFT_BITSET_H
+#define __RAFT_BITSET_H
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#include <raft/cuda_utils.cuh>
+#include <raft/cudart_utils.h>
+
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_scalar.hpp>
+#include <rmm/device_uvector.hpp>
+
+namespace raft {
+namespace core {
+
+/** word type backing the bitset; one bit per element, LSB first */
+using bitset_word_t = std::uint32_t;
+
+constexpr std::uint32_t bitset_word_bits = 8 * sizeof(bitset_word_t);
+
+/**
+ * @brief Non-owning, trivially copyable view over a device bitset
+ *
+ * Pass views by value into kernels (or epilogue functors, see
+ * `raft::distance::bitset_mask_epilogue`) to test membership in-register
+ * without materializing index lists. A set bit means the element is kept;
+ * a cleared bit means it is masked out.
+ *
+ * @tparam index_t type used for bit indices
+ */
+template <typename index_t = std::uint32_t>
+struct bitset_view {
+  const bitset_word_t* bits;
+  index_t n_bits;
+
+  /** @brief returns whether bit i is set; i must be < size() */
+  DI bool test(index_t i) const
+  {
+    return (bits[i / bitset_word_bits] >> (i % bitset_word_bits)) & bitset_word_t{1};
+  }
+
+  HDI index_t size() const { return n_bits; }
+};
+
+namespace detail {
+
+template <typename index_t>
+__global__ void bitset_set_indices_kernel(bitset_word_t* bits,
+                                          const index_t* indices,
+                                          index_t n_indices,
+                                          bool value)
+{
+  for (index_t i = blockIdx.x * blockDim.x + threadIdx.x; i < n_indices;
+       i += gridDim.x * blockDim.x) {
+    index_t bit        = indices[i];
+    bitset_word_t mask = bitset_word_t{1} << (bit % bitset_word_bits);
+    if (value) {
+      atomicOr(&bits[bit / bitset_word_bits], mask);
+    } else {
+      atomicAnd(&bits[bit / bitset_word_bits], ~mask);
+    }
+  }
+}
+
+template <typename index_t>
+__global__ void bitset_count_kernel(const bitset_word_t* bits,
+                                    index_t n_words,
+                                    bitset_word_t last_word_mask,
+                                    unsigned long long* count)
+{
+  unsigned long long local = 0;
+  for (index_t i = blockIdx.x * blockDim.x + threadIdx.x; i < n_words;
+       i += gridDim.x * blockDim.x) {
+    bitset_word_t w = bits[i];
+    if (i == n_words - 1) { w &= last_word_mask; }
+    local += __popc(w);
+  }
+  if (local != 0) { atomicAdd(count, local); }
+}
+
+struct bitset_and_op {
+  DI bitset_word_t operator()(bitset_word_t a, bitset_word_t b) const { return a & b; }
+};
+struct bitset_or_op {
+  DI bitset_word_t operator()(bitset_word_t a, bitset_word_t b) const { return a | b; }
+};
+struct bitset_xor_op {
+  DI bitset_word_t operator()(bitset_word_t a, bitset_word_t b) const { return a ^ b; }
+};
+
+template <typename index_t, typename op_t>
+__global__ void bitset_binary_op_kernel(bitset_word_t* a,
+                                        const bitset_word_t* b,
+                                        index_t n_words,
+                                        op_t op)
+{
+  for (index_t i = blockIdx.x * blockDim.x + threadIdx.x; i < n_words;
+       i += gridDim.x * blockDim.x) {
+    a[i] = op(a[i], b[i]);
+  }
+}
+
+template <typename index_t>
+__global__ void bitset_flip_kernel(bitset_word_t* bits, index_t n_words)
+{
+  for (index_t i = blockIdx.x * blockDim.x + threadIdx.x; i < n_words;
+       i += gridDim.x * blockDim.x) {
+    bits[i] = ~bits[i];
+  }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Word-packed device bitset for filtered search
+ *
+ * Holds one bit per element of an indexed dataset (set = keep, cleared =
+ * masked out, e.g. deleted documents or rows of other tenants). Primitives
+ * accepting a `bitset_view` test the mask in their kernel epilogues, so
+ * filtered queries skip masked candidates without the O(n) thrust
+ * compaction + gather pass per batch that an explicit index list costs.
+ *
+ * All operations are stream-ordered; `count()` synchronizes the stream to
+ * return the population count to the host. Bits past `size()` in the last
+ * word are not maintained and are masked off where they would be observable.
+ *
+ * @tparam index_t type used for bit indices
+ */
+template <typename index_t = std::uint32_t>
+class bitset {
+ public:
+  /**
+   * @brief construct a bitset of n bits
+   * @param[in] n number of bits
+   * @param[in] stream cuda stream ordering the initialization
+   * @param[in] value initial value of every bit
+   */
+  bitset(index_t n, rmm::cuda_stream_view stream, bool value = true)
+    : n_bits_(n), words_(raft::ceildiv<index_t>(n, bitset_word_bits), stream)
+  {
+    fill(value, stream);
+  }
+
+  /** @brief set (or clear) every bit */
+  void fill(bool value, rmm::cuda_stream_view stream)
+  {
+    RAFT_CUDA_TRY(cudaMemsetAsync(
+      words_.data(), value ? 0xff : 0x00, words_.size() * sizeof(bitset_word_t), stream));
+  }
+
+  /**
+   * @brief set (or clear) the bits at the given indices
+   * @param[in] indices device array of bit indices, each < size()
+   * @param[in] n_indices number of indices
+   * @param[in] value value to assign to the addressed bits
+   * @param[in] stream cuda stream
+   */
+  void set(const index_t* indices, index_t n_indices, bool value, rmm::cuda_stream_view stream)
+  {
+    if (n_indices == 0) { return; }
+    int n_blocks = std::min(65535, int(raft::ceildiv<index_t>(n_indices, 256)));
+    detail::bitset_set_indices_kernel<<<n_blocks, 256, 0, stream>>>(
+      words_.data(), indices, n_indices, value);
+    RAFT_CUDA_TRY(cudaPeekAtLastError());
+  }
+
+  /** @brief returns the number of set bits; synchronizes the stream */
+  index_t count(rmm::cuda_stream_view stream) const
+  {
+    rmm::device_scalar<unsigned long long> count(0, stream);
+    index_t tail = n_bits_ % bitset_word_bits;
+    bitset_word_t last_word_mask =
+      tail == 0 ? ~bitset_word_t{0} : (bitset_word_t{1} << tail) - bitset_word_t{1};
+    index_t n_words = words_.size();
+    int n_blocks    = std::min(65535, int(raft::ceildiv<index_t>(n_words, 256)));
+    detail::bitset_count_kernel<<<n_blocks, 256, 0, stream>>>(
+      words_.data(), n_words, last_word_mask, count.data());
+    RAFT_CUDA_TRY(cudaPeekAtLastError());
+    return static_cast<index_t>(count.value(stream));
+  }
+
+  /** @brief in-place logical AND with another bitset of the same size */
+  void op_and(const bitset<index_t>& other, rmm::cuda_stream_view stream)
+  {
+    binary_op(other, detail::bitset_and_op{}, stream);
+  }
+
+  /** @brief in-place logical OR with another bitset of the same size */
+  void op_or(const bitset<index_t>& other, rmm::cuda_stream_view stream)
+  {
+    binary_op(other, detail::bitset_or_op{}, stream);
+  }
+
+  /** @brief in-place logical XOR with another bitset of the same size */
+  void op_xor(const bitset<index_t>& other, rmm::cuda_stream_view stream)
+  {
+    binary_op(other, detail::bitset_xor_op{}, stream);
+  }
+
+  /** @brief flip every bit */
+  void flip(rmm::cuda_stream_view stream)
+  {
+    index_t n_words = words_.size();
+    int n_blocks    = std::min(65535, int(raft::ceildiv<index_t>(n_words, 256)));
+    detail::bitset_flip_kernel<<<n_blocks, 256, 0, stream>>>(words_.data(), n_words);
+    RAFT_CUDA_TRY(cudaPeekAtLastError());
+  }
+
+  /** @brief returns a non-owning view for use inside kernels */
+  bitset_view<index_t> view() const { return bitset_view<index_t>{words_.data(), n_bits_}; }
+
+  index_t size() const { return n_bits_; }
+  index_t n_words() const { return words_.size(); }
+  bitset_word_t* data() { return words_.data(); }
+  const bitset_word_t* data() const { return words_.data(); }
+
+ private:
+  template <typename op_t>
+  void binary_op(const bitset<index_t>& other, op_t op, rmm::cuda_stream_view stream)
+  {
+    RAFT_EXPECTS(other.size() == n_bits_, "bitset logical ops require equal sizes");
+    index_t n_words = words_.size();
+    int n_blocks    = std::min(65535, int(raft::ceildiv<index_t>(n_words, 256)));
+    detail::bitset_binary_op_kernel<<<n_blocks, 256, 0, stream>>>(
+      words_.data(), other.data(), n_words, op);
+    RAFT_CUDA_TRY(cudaPeekAtLastError());
+  }
+
+  index_t n_bits_;
+  rmm::device_uvector<bitset_word_t> words_;
+};
+
+}  // namespace core
+}  // namespace raft
+
+#endif
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/cuda_utils.cuh>
+#include <raft/cudart_utils.h>
+
+namespace raft {
+
+/**
+ * @brief Device-side view of a cancellation flag, passed to kernels by value.
+ *
+ * The view is a trivially-copyable handle over mapped pinned memory; a
+ * default-constructed view never reports cancellation, so kernels can take it
+ * as an optional trailing parameter. Each poll is an uncached read over the
+ * PCIe/NVLink bus, so long-loop kernels should poll at a coarse granularity
+ * (e.g. one thread per block, once per outer iteration or tile row) and
+ * broadcast the result through shared memory or an existing device flag.
+ */
+struct cancellation_view {
+  const int* flag = nullptr;
+
+  DI auto cancelled() const -> bool
+  {
+    return flag != nullptr && *reinterpret_cast<const volatile int*>(flag) != 0;
+  }
+};
+
+/**
+ * @brief Host-owned cancellation flag that running kernels can observe.
+ *
+ * `raft::interruptible` can only cancel between kernel launches; a kernel that
+ * iterates to convergence on the device (cooperative grids, persistent
+ * workers) keeps the GPU busy until it finishes on its own. This token backs
+ * the flag with mapped (zero-copy) pinned host memory, so `cancel()` is a
+ * plain host store that the GPU observes on its next poll — cancellation
+ * latency becomes one polling interval instead of the kernel's remaining
+ * runtime.
+ *
+ * A cancelled kernel is expected to simply stop making progress and return;
+ * its outputs are unspecified. The caller detects the situation through
+ * `is_cancelled()` and discards the results. `reset()` re-arms the token for
+ * reuse; it must not be called while a kernel holding a view is in flight.
+ *
+ * @code{.cpp}
+ *   raft::cancellation_token token;
+ *   launch_long_kernel(..., token.view(), stream);
+ *   // from another thread, e.g. on client disconnect:
+ *   token.cancel();
+ * @endcode
+ */
+class cancellation_token {
+ public:
+  cancellation_token()
+  {
+    RAFT_CUDA_TRY(cudaHostAlloc(reinterpret_cast<void**>(&host_flag_),
+                                sizeof(int),
+                                cudaHostAllocMapped | cudaHostAllocPortable));
+    *host_flag_ = 0;
+    RAFT_CUDA_TRY(
+      cudaHostGetDevicePointer(reinterpret_cast<void**>(&dev_flag_), host_flag_, 0));
+  }
+
+  ~cancellation_token() { RAFT_CUDA_TRY_NO_THROW(cudaFreeHost(host_flag_)); }
+
+  // the device view captures the raw pointer; moving/copying the owner would
+  // leave views dangling silently, so the token is pinned in place
+  cancellation_token(cancellation_token const&) = delete;
+  cancellation_token(cancellation_token&&)      = delete;
+  auto operator=(cancellation_token const&) -> cancellation_token& = delete;
+  auto operator=(cancellation_token&&) -> cancellation_token& = delete;
+
+  /** Request cancellation; safe to call from any thread or a signal handler. */
+  void cancel() noexcept { *reinterpret_cast<volatile int*>(host_flag_) = 1; }
+
+  /** Re-arm the token. No kernel holding a view may be in flight. */
+  void reset() noexcept { *reinterpret_cast<volatile int*>(host_flag_) = 0; }
+
+  [[nodiscard]] auto is_cancelled() const noexcept -> bool
+  {
+    return *reinterpret_cast<const volatile int*>(host_flag_) != 0;
+  }
+
+  /** Device-side view to pass to kernels. */
+  [[nodiscard]] auto view() const noexcept -> cancellation_view
+  {
+    return cancellation_view{dev_flag_};
+  }
+
+ private:
+  int* host_flag_ = nullptr;
+  int* dev_flag_  = nullptr;
+};
+
+}  // namespace raft
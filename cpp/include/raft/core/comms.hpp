@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <memory>
+#include <raft/cudart_utils.h>
 #include <raft/error.hpp>
 #include <vector>
 
@@ -24,7 +26,18 @@ namespace raft {
 namespace comms {
 
 typedef unsigned int request_t;
-enum class datatype_t { CHAR, UINT8, INT32, UINT32, INT64, UINT64, FLOAT32, FLOAT64 };
+enum class datatype_t {
+  CHAR,
+  UINT8,
+  INT32,
+  UINT32,
+  INT64,
+  UINT64,
+  FLOAT32,
+  FLOAT64,
+  FLOAT16,
+  BFLOAT16
+};
 enum class op_t { SUM, PROD, MIN, MAX };
 
 /**
@@ -132,6 +145,14 @@ class comms_iface {
                          op_t op,
                          cudaStream_t stream) const = 0;
 
+  // Fused-allreduce scope: implementations may override these to pack
+  // allreduce calls issued between begin and end into fewer collective
+  // launches. The defaults are no-ops, in which case allreduce calls
+  // inside a scope simply execute eagerly.
+  virtual void fused_allreduce_begin(cudaStream_t stream) const {}
+
+  virtual void fused_allreduce_end(cudaStream_t stream) const {}
+
   virtual void bcast(
     void* buff, size_t count, datatype_t datatype, int root, cudaStream_t stream) const = 0;
 
@@ -324,6 +345,29 @@ class comms_t {
                      stream);
   }
 
+  /**
+   * Open a fused-allreduce scope. Allreduce calls issued on `stream`
+   * until the matching `fused_allreduce_end()` may be packed into a
+   * single flat buffer and executed as one collective per distinct
+   * (datatype, op) pair, amortizing per-call launch overhead for many
+   * small reductions. The reduced results only become visible on
+   * `stream` after the scope is closed. Implementations without fusion
+   * support execute the calls eagerly.
+   *
+   * @param stream CUDA stream the fused collectives are ordered on;
+   *               every allreduce inside the scope must use it
+   */
+  void fused_allreduce_begin(cudaStream_t stream) const { impl_->fused_allreduce_begin(stream); }
+
+  /**
+   * Close a fused-allreduce scope, executing the deferred allreduce
+   * calls and scattering the results back to their destination
+   * buffers.
+   *
+   * @param stream CUDA stream the scope was opened on
+   */
+  void fused_allreduce_end(cudaStream_t stream) const { impl_->fused_allreduce_end(stream); }
+
   /**
    * Broadcast data from one rank to the rest
    * @tparam value_t datatype of underlying buffers
@@ -359,6 +403,57 @@ class comms_t {
                  stream);
   }
 
+  /**
+   * Broadcast a large buffer in chunks pipelined over several streams.
+   * The monolithic bcast occupies one stream for the whole transfer;
+   * here each chunk is an independent broadcast issued round-robin on
+   * the given streams (e.g. from handle_t's stream pool), so consumers
+   * can synchronize an individual stream and start processing early
+   * chunks while later ones are still in flight. The transfer is
+   * ordered against `stream`: chunks wait for prior work on it, and
+   * work enqueued on it afterwards waits for all chunks, without
+   * blocking the host.
+   * @tparam value_t datatype of underlying buffers
+   * @param buff buffer to send/recv on
+   * @param count number of elements in buff
+   * @param root the rank initiating the broadcast
+   * @param stream main CUDA stream the transfer is ordered against
+   * @param streams streams the chunks are issued on
+   * @param chunk_count number of elements per chunk
+   */
+  template <typename value_t>
+  void bcast_pipelined(value_t* buff,
+                       size_t count,
+                       int root,
+                       cudaStream_t stream,
+                       const std::vector<cudaStream_t>& streams,
+                       size_t chunk_count) const
+  {
+    RAFT_EXPECTS(!streams.empty(), "bcast_pipelined needs at least one stream");
+    RAFT_EXPECTS(chunk_count > 0, "bcast_pipelined needs a positive chunk size");
+
+    cudaEvent_t event;
+    RAFT_CUDA_TRY(cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
+    RAFT_CUDA_TRY(cudaEventRecord(event, stream));
+    for (auto s : streams) {
+      RAFT_CUDA_TRY(cudaStreamWaitEvent(s, event, 0));
+    }
+
+    size_t chunk = 0;
+    for (size_t offset = 0; offset < count; offset += chunk_count, ++chunk) {
+      bcast(buff + offset,
+            std::min(chunk_count, count - offset),
+            root,
+            streams[chunk % streams.size()]);
+    }
+
+    for (auto s : streams) {
+      RAFT_CUDA_TRY(cudaEventRecord(event, s));
+      RAFT_CUDA_TRY(cudaStreamWaitEvent(stream, event, 0));
+    }
+    RAFT_CUDA_TRY(cudaEventDestroy(event));
+  }
+
   /**
    * Reduce data from many ranks down to a single rank
    * @tparam value_t datatype of underlying buffers
@@ -577,6 +672,66 @@ class comms_t {
                            stream);
   }
 
+  /**
+   * Performs a large point-to-point send/receive in chunks pipelined
+   * over several streams. Each chunk is an independent send/receive
+   * issued round-robin on the given streams (e.g. from handle_t's
+   * stream pool), so the receiver can synchronize an individual stream
+   * and start processing early chunks while later ones are still in
+   * flight. The transfer is ordered against `stream` the same way as
+   * bcast_pipelined. Both sides must use the same chunk size.
+   * @tparam value_t the type of data to be sent & received
+   * @param sendbuf pointer to array of data to send
+   * @param sendsize number of elements in sendbuf
+   * @param dest destination rank
+   * @param recvbuf pointer to (initialized) array that will hold received data
+   * @param recvsize number of elements in recvbuf
+   * @param source source rank
+   * @param stream main CUDA stream the transfer is ordered against
+   * @param streams streams the chunks are issued on
+   * @param chunk_count number of elements per chunk
+   */
+  template <typename value_t>
+  void device_sendrecv_pipelined(const value_t* sendbuf,
+                                 size_t sendsize,
+                                 int dest,
+                                 value_t* recvbuf,
+                                 size_t recvsize,
+                                 int source,
+                                 cudaStream_t stream,
+                                 const std::vector<cudaStream_t>& streams,
+                                 size_t chunk_count) const
+  {
+    RAFT_EXPECTS(!streams.empty(), "device_sendrecv_pipelined needs at least one stream");
+    RAFT_EXPECTS(chunk_count > 0, "device_sendrecv_pipelined needs a positive chunk size");
+
+    cudaEvent_t event;
+    RAFT_CUDA_TRY(cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
+    RAFT_CUDA_TRY(cudaEventRecord(event, stream));
+    for (auto s : streams) {
+      RAFT_CUDA_TRY(cudaStreamWaitEvent(s, event, 0));
+    }
+
+    size_t n_chunks = (std::max(sendsize, recvsize) + chunk_count - 1) / chunk_count;
+    for (size_t chunk = 0; chunk < n_chunks; ++chunk) {
+      size_t send_offset = std::min(chunk * chunk_count, sendsize);
+      size_t recv_offset = std::min(chunk * chunk_count, recvsize);
+      device_sendrecv(sendbuf + send_offset,
+                      std::min(chunk_count, sendsize - send_offset),
+                      dest,
+                      recvbuf + recv_offset,
+                      std::min(chunk_count, recvsize - recv_offset),
+                      source,
+                      streams[chunk % streams.size()]);
+    }
+
+    for (auto s : streams) {
+      RAFT_CUDA_TRY(cudaEventRecord(event, s));
+      RAFT_CUDA_TRY(cudaStreamWaitEvent(stream, event, 0));
+    }
+    RAFT_CUDA_TRY(cudaEventDestroy(event));
+  }
+
   /**
    * Performs a multicast send/receive
    *
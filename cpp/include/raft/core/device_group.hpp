@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/core/error.hpp>
+#include <raft/core/handle.hpp>
+
+#include <rmm/cuda_stream.hpp>
+
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace raft {
+
+/** @brief RAII device switch restoring the previous device on destruction. */
+struct scoped_device {
+  explicit scoped_device(int device_id)
+  {
+    RAFT_CUDA_TRY(cudaGetDevice(&prev_));
+    RAFT_CUDA_TRY(cudaSetDevice(device_id));
+  }
+  ~scoped_device() { cudaSetDevice(prev_); }
+
+  scoped_device(const scoped_device&) = delete;
+  scoped_device& operator=(const scoped_device&) = delete;
+
+ private:
+  int prev_;
+};
+
+/**
+ * @brief Group of handles, one per device, with mirrored collective helpers.
+ *
+ * Owns a `handle_t` (and its stream) for every device in the group and
+ * provides the scaffolding multi-GPU callers keep rewriting: broadcast a
+ * device buffer to all devices with peer copies, scatter contiguous row
+ * ranges, and run a callable per device on its own thread with the right
+ * device current. Peer access between all group members is enabled
+ * best-effort at construction, so broadcasts ride NVLink where the
+ * topology allows and fall back to staged copies where it does not.
+ *
+ * The group's helpers enqueue work on each member's own stream;
+ * `sync_all()` (or `parallel_for_each`, which joins) establishes
+ * completion.
+ */
+class device_group {
+ public:
+  /**
+   * @param device_ids devices to include; empty selects every visible device
+   */
+  explicit device_group(std::vector<int> device_ids = {}) : device_ids_(std::move(device_ids))
+  {
+    if (device_ids_.empty()) {
+      int count;
+      RAFT_CUDA_TRY(cudaGetDeviceCount(&count));
+      for (int d = 0; d < count; d++) {
+        device_ids_.push_back(d);
+      }
+    }
+    RAFT_EXPECTS(!device_ids_.empty(), "raft::device_group: no devices available");
+
+    for (int id : device_ids_) {
+      scoped_device dev(id);
+      streams_.push_back(std::make_unique<rmm::cuda_stream>());
+      handles_.push_back(std::make_unique<handle_t>(streams_.back()->view()));
+    }
+
+    enable_peer_access();
+  }
+
+  device_group(const device_group&) = delete;
+  device_group& operator=(const device_group&) = delete;
+
+  std::size_t size() const { return device_ids_.size(); }
+  int device_id(std::size_t rank) const { return device_ids_[rank]; }
+  handle_t& handle(std::size_t rank) const { return *handles_[rank]; }
+
+  /**
+   * @brief Enables peer access between all pairs in the group, best-effort.
+   *
+   * Pairs whose topology does not support P2P are skipped; copies between
+   * them are staged through the host by the driver.
+   */
+  void enable_peer_access()
+  {
+    for (std::size_t i = 0; i < size(); i++) {
+      scoped_device dev(device_ids_[i]);
+      for (std::size_t j = 0; j < size(); j++) {
+        if (i == j) { continue; }
+        int can_access = 0;
+        RAFT_CUDA_TRY(cudaDeviceCanAccessPeer(&can_access, device_ids_[i], device_ids_[j]));
+        if (!can_access) { continue; }
+        auto status = cudaDeviceEnablePeerAccess(device_ids_[j], 0);
+        if (status == cudaErrorPeerAccessAlreadyEnabled) {
+          cudaGetLastError();  // clear the sticky error
+        } else {
+          RAFT_CUDA_TRY(status);
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Runs a callable per device, each on its own thread with its
+   * device current, and joins.
+   *
+   * The callable receives `(rank, handle_t&)`. The first exception thrown
+   * by any member is rethrown on the calling thread after all threads
+   * joined.
+   */
+  template <typename Fn>
+  void parallel_for_each(Fn&& fn)
+  {
+    std::vector<std::thread> workers;
+    std::vector<std::exception_ptr> errors(size());
+    for (std::size_t rank = 0; rank < size(); rank++) {
+      workers.emplace_back([&, rank]() {
+        try {
+          scoped_device dev(device_ids_[rank]);
+          fn(rank, *handles_[rank]);
+        } catch (...) {
+          errors[rank] = std::current_exception();
+        }
+      });
+    }
+    for (auto& w : workers) {
+      w.join();
+    }
+    for (auto& e : errors) {
+      if (e) { std::rethrow_exception(e); }
+    }
+  }
+
+  /**
+   * @brief Broadcasts a device buffer on the root rank to every rank.
+   *
+   * Uses peer copies onto each member's stream; the root's copy is a plain
+   * device-to-device copy. Asynchronous; see `sync_all()`.
+   *
+   * @param[in] src device buffer on rank `root`'s device
+   * @param[in] n number of elements to broadcast
+   * @param[in] root rank holding the source buffer
+   * @param[in] dsts one destination device buffer per rank (root included)
+   */
+  template <typename T>
+  void broadcast(const T* src, std::size_t n, std::size_t root, const std::vector<T*>& dsts)
+  {
+    RAFT_EXPECTS(dsts.size() == size(), "raft::device_group: need one destination per rank");
+    for (std::size_t rank = 0; rank < size(); rank++) {
+      RAFT_CUDA_TRY(cudaMemcpyPeerAsync(dsts[rank],
+                                        device_ids_[rank],
+                                        src,
+                                        device_ids_[root],
+                                        n * sizeof(T),
+                                        streams_[rank]->value()));
+    }
+  }
+
+  /** @brief Returns rank's `[begin, end)` row range of an n_rows split. */
+  std::pair<std::size_t, std::size_t> row_range(std::size_t rank, std::size_t n_rows) const
+  {
+    std::size_t chunk = (n_rows + size() - 1) / size();
+    std::size_t begin = std::min(rank * chunk, n_rows);
+    return {begin, std::min(begin + chunk, n_rows)};
+  }
+
+  /**
+   * @brief Scatters contiguous row ranges of a row-major matrix across ranks.
+   *
+   * Rank i receives its `row_range(i, n_rows)` slice; destination buffers
+   * must hold at least that many rows. Asynchronous; see `sync_all()`.
+   *
+   * @param[in] src device matrix on rank `root`'s device (n_rows x row_width)
+   * @param[in] n_rows total number of rows
+   * @param[in] row_width elements per row
+   * @param[in] root rank holding the source matrix
+   * @param[in] dsts one destination device buffer per rank
+   */
+  template <typename T>
+  void scatter_rows(const T* src,
+                    std::size_t n_rows,
+                    std::size_t row_width,
+                    std::size_t root,
+                    const std::vector<T*>& dsts)
+  {
+    RAFT_EXPECTS(dsts.size() == size(), "raft::device_group: need one destination per rank");
+    for (std::size_t rank = 0; rank < size(); rank++) {
+      auto range = row_range(rank, n_rows);
+      if (range.first == range.second) { continue; }
+      RAFT_CUDA_TRY(cudaMemcpyPeerAsync(dsts[rank],
+                                        device_ids_[rank],
+                                        src + range.first * row_width,
+                                        device_ids_[root],
+                                        (range.second - range.first) * row_width * sizeof(T),
+                                        streams_[rank]->value()));
+    }
+  }
+
+  /** @brief Blocks until all work enqueued on the group's streams completed. */
+  void sync_all() const
+  {
+    for (std::size_t rank = 0; rank < size(); rank++) {
+      scoped_device dev(device_ids_[rank]);
+      handles_[rank]->sync_stream();
+    }
+  }
+
+ private:
+  std::vector<int> device_ids_;
+  std::vector<std::unique_ptr<rmm::cuda_stream>> streams_;
+  std::vector<std::unique_ptr<handle_t>> handles_;
+};
+
+}  // namespace raft
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/cudart_utils.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace raft {
+
+/**
+ * @brief Lock-free pool of reusable CUDA events.
+ *
+ * Event creation takes the driver lock and costs on the order of
+ * microseconds, which adds up (and serializes threads) when events are
+ * created per call at synchronization points. The pool keeps returned
+ * events in a fixed array of atomic slots: checkout exchanges a slot for
+ * nullptr, return publishes the event back with a CAS, so concurrent
+ * callers never block each other. When the pool is empty a fresh event
+ * is created; when it is full a returned event is destroyed.
+ *
+ * All events are created with `cudaEventDisableTiming`, which is what
+ * every synchronization point wants and what keeps the events cheap.
+ *
+ * Prefer the RAII `pooled_event` over calling acquire()/release()
+ * directly.
+ */
+class event_pool {
+ public:
+  event_pool() = default;
+
+  event_pool(const event_pool&) = delete;
+  event_pool& operator=(const event_pool&) = delete;
+
+  ~event_pool()
+  {
+    for (auto& slot : slots_) {
+      auto ev = slot.exchange(nullptr, std::memory_order_relaxed);
+      if (ev != nullptr) { RAFT_CUDA_TRY_NO_THROW(cudaEventDestroy(ev)); }
+    }
+  }
+
+  /** @brief Checks an event out of the pool, creating one if it is empty. */
+  cudaEvent_t acquire()
+  {
+    for (auto& slot : slots_) {
+      auto ev = slot.exchange(nullptr, std::memory_order_acquire);
+      if (ev != nullptr) { return ev; }
+    }
+    cudaEvent_t ev;
+    RAFT_CUDA_TRY(cudaEventCreateWithFlags(&ev, cudaEventDisableTiming));
+    return ev;
+  }
+
+  /**
+   * @brief Returns an event to the pool, destroying it if the pool is full.
+   *
+   * The event may still be pending on a stream: the driver defers the
+   * actual destruction until completion, and re-recording a pending
+   * event is legal, so no synchronization is required here.
+   */
+  void release(cudaEvent_t ev)
+  {
+    if (ev == nullptr) { return; }
+    for (auto& slot : slots_) {
+      cudaEvent_t expected = nullptr;
+      if (slot.compare_exchange_strong(expected, ev, std::memory_order_release)) { return; }
+    }
+    RAFT_CUDA_TRY_NO_THROW(cudaEventDestroy(ev));
+  }
+
+ private:
+  static constexpr std::size_t kSlots = 64;
+  std::array<std::atomic<cudaEvent_t>, kSlots> slots_{};
+};
+
+/** @brief RAII checkout of an event from an `event_pool`. */
+class pooled_event {
+ public:
+  explicit pooled_event(event_pool& pool) : pool_(&pool), event_(pool.acquire()) {}
+
+  ~pooled_event()
+  {
+    if (event_ != nullptr) { pool_->release(event_); }
+  }
+
+  pooled_event(pooled_event&& other) noexcept : pool_(other.pool_), event_(other.event_)
+  {
+    other.event_ = nullptr;
+  }
+  pooled_event& operator=(pooled_event&&) = delete;
+  pooled_event(const pooled_event&)       = delete;
+  pooled_event& operator=(const pooled_event&) = delete;
+
+  cudaEvent_t value() const { return event_; }
+  operator cudaEvent_t() const { return event_; }
+
+ private:
+  event_pool* pool_;
+  cudaEvent_t event_;
+};
+
+}  // namespace raft
@@ -26,6 +26,7 @@
 #include <utility>
 #include <vector>
 
+#include <cublasLt.h>
 #include <cublas_v2.h>
 #include <cuda_runtime.h>
 #include <cusolverDn.h>
@@ -42,11 +43,31 @@
 #include <raft/core/cusolver_macros.hpp>
 #include <raft/core/cusparse_macros.hpp>
 #include <raft/core/interruptible.hpp>
+#include <raft/core/event_pool.hpp>
+#include <raft/core/memory_telemetry.hpp>
+#include <raft/core/pinned_staging.hpp>
+#include <raft/core/profiler.hpp>
+#include <raft/core/workspace_arena.hpp>
 #include <rmm/cuda_stream_pool.hpp>
 #include <rmm/exec_policy.hpp>
+#include <rmm/mr/device/per_device_resource.hpp>
 
 namespace raft {
 
+/**
+ * @brief stream lane on which a primitive should run
+ *
+ * Latency-critical callers can route an individual call onto the handle's
+ * high-priority stream so the hardware scheduler preempts lower-priority
+ * batch work in its favor; see `handle_t::get_high_priority_stream`.
+ */
+enum class execution_lane {
+  /** the handle's main stream (and stream pool, where applicable) */
+  DEFAULT,
+  /** the handle's greatest-priority stream; see `handle_t::get_high_priority_stream` */
+  HIGH_PRIORITY
+};
+
 /**
  * @brief Main handle object that stores all necessary context used for calling
  *        necessary cuda kernels and/or libraries
@@ -96,6 +117,16 @@ class handle_t {
     return cublas_handle_;
   }
 
+  cublasLtHandle_t get_cublaslt_handle() const
+  {
+    std::lock_guard<std::mutex> _(mutex_);
+    if (!cublaslt_initialized_) {
+      RAFT_CUBLAS_TRY_NO_THROW(cublasLtCreate(&cublaslt_handle_));
+      cublaslt_initialized_ = true;
+    }
+    return cublaslt_handle_;
+  }
+
   cusolverDnHandle_t get_cusolver_dn_handle() const
   {
     std::lock_guard<std::mutex> _(mutex_);
@@ -131,10 +162,26 @@ class handle_t {
 
   rmm::exec_policy& get_thrust_policy() const { return *thrust_policy_; }
 
+  /**
+   * @brief set the CPU wait policy used when synchronizing streams via this handle
+   *
+   * Latency-critical callers can request a busy-spin phase to avoid scheduler
+   * jitter on short waits; see `raft::wait_policy_t`.
+   */
+  void set_wait_policy(wait_policy_t policy) { wait_policy_ = policy; }
+
+  /**
+   * @brief returns the CPU wait policy used when synchronizing streams via this handle
+   */
+  wait_policy_t get_wait_policy() const { return wait_policy_; }
+
   /**
    * @brief synchronize a stream on the handle
    */
-  void sync_stream(rmm::cuda_stream_view stream) const { interruptible::synchronize(stream); }
+  void sync_stream(rmm::cuda_stream_view stream) const
+  {
+    interruptible::synchronize(stream, wait_policy_);
+  }
 
   /**
    * @brief synchronize main stream on the handle
@@ -202,6 +249,46 @@ class handle_t {
     return is_stream_pool_initialized() ? get_stream_from_stream_pool(stream_idx) : stream_view_;
   }
 
+  /**
+   * @brief return the handle's high-priority stream lane, creating it on first use
+   *
+   * The lane is created with `cudaStreamCreateWithPriority` at the greatest
+   * priority the device supports, so kernels launched on it preempt running
+   * default-priority kernels at thread-block granularity — including work on
+   * the main stream and the stream pool, which rmm creates at default
+   * priority. This isolates the tail latency of interactive queries from
+   * batch work saturating the same device; see `raft::execution_lane` for
+   * routing a primitive call onto the lane.
+   *
+   * The lane is created non-blocking and is NOT implicitly ordered with
+   * respect to the main stream: callers must ensure the inputs of work
+   * launched onto it are ready (e.g. via `cudaStreamWaitEvent`), keeping in
+   * mind that waiting on a stream full of batch work forfeits the isolation.
+   */
+  rmm::cuda_stream_view get_high_priority_stream() const
+  {
+    std::lock_guard<std::mutex> _(mutex_);
+    if (!high_priority_stream_initialized_) {
+      int least_priority, greatest_priority;
+      RAFT_CUDA_TRY(cudaDeviceGetStreamPriorityRange(&least_priority, &greatest_priority));
+      RAFT_CUDA_TRY(cudaStreamCreateWithPriority(
+        &high_priority_stream_, cudaStreamNonBlocking, greatest_priority));
+      high_priority_stream_initialized_ = true;
+    }
+    return rmm::cuda_stream_view{high_priority_stream_};
+  }
+
+  /**
+   * @brief return the stream a primitive should run on for the given lane
+   *
+   * @param[in] lane the requested execution lane; `DEFAULT` maps to the main
+   *            stream, `HIGH_PRIORITY` to the high-priority lane
+   */
+  rmm::cuda_stream_view get_execution_stream(execution_lane lane) const
+  {
+    return lane == execution_lane::HIGH_PRIORITY ? get_high_priority_stream() : stream_view_;
+  }
+
   /**
    * @brief synchronize the stream pool on the handle
    */
@@ -263,6 +350,116 @@ class handle_t {
 
   bool comms_initialized() const { return (nullptr != communicator_.get()); }
 
+  /**
+   * @brief returns the device workspace arena owned by the handle
+   *
+   * The arena retains its backing buffer across primitive calls so scratch
+   * allocations on hot paths do not go through the device memory resource.
+   */
+  workspace_arena& get_workspace_arena() const { return workspace_arena_; }
+
+  /**
+   * @brief returns the pinned staging ring owned by the handle
+   *
+   * Repeated small transfers from/to pageable host memory should go through
+   * the ring (`stage_and_copy_async` / `copy_to_host`) instead of raw
+   * `raft::copy`, which degrades to a synchronous copy for pageable
+   * pointers. Pinned slots are allocated lazily on first use.
+   */
+  pinned_staging_ring& get_staging_ring() const { return staging_ring_; }
+
+  /**
+   * @brief returns the reusable CUDA event pool owned by the handle
+   *
+   * Synchronization points that would otherwise create and destroy a
+   * `cudaEvent_t` per call should check events out of this pool (see
+   * `raft::pooled_event`); checkout is lock-free and avoids the driver
+   * lock taken by event creation.
+   */
+  event_pool& get_event_pool() const { return event_pool_; }
+
+  /**
+   * @brief draw a stream-ordered scratch sub-allocation from the handle's arena
+   *
+   * Shorthand for `get_workspace_arena().allocate(bytes, stream)`; the chunk
+   * must be returned via `return_workspace` (or use `raft::workspace_chunk`
+   * for RAII semantics).
+   */
+  void* get_workspace(std::size_t bytes, rmm::cuda_stream_view stream) const
+  {
+    return workspace_arena_.allocate(bytes, stream);
+  }
+
+  /** @brief return a scratch sub-allocation obtained from `get_workspace` */
+  void return_workspace(void* ptr, std::size_t bytes, rmm::cuda_stream_view stream) const
+  {
+    workspace_arena_.deallocate(ptr, bytes, stream);
+  }
+
+  /**
+   * @brief attach an observer receiving the device time of instrumented primitives
+   *
+   * Passing `nullptr` detaches the current observer. While an observer is
+   * attached, primitives constructing a `raft::profiling_scope` report their
+   * measured device time to it (see `raft/core/profiler.hpp`); with no
+   * observer attached the instrumentation cost is a null pointer check.
+   */
+  void set_profiler_observer(std::shared_ptr<profiler_observer> observer)
+  {
+    std::lock_guard<std::mutex> _(mutex_);
+    profiler_ = observer ? std::make_unique<profiler_state>(std::move(observer)) : nullptr;
+  }
+
+  /**
+   * @brief returns the profiler bookkeeping, or `nullptr` when no observer is attached
+   */
+  profiler_state* get_profiler() const { return profiler_.get(); }
+
+  /**
+   * @brief wait for all in-flight profiler measurements and report them to the observer
+   */
+  void flush_profiler() const
+  {
+    if (profiler_) { profiler_->flush(); }
+  }
+
+  /**
+   * @brief wrap the current device memory resource with a tracking adaptor
+   *
+   * While enabled, allocations are attributed to the innermost
+   * `raft::memory_scope` on the allocating thread and per-scope
+   * current/peak bytes can be queried via `get_memory_telemetry()`. The
+   * adaptor is installed as the current device resource; it is restored on
+   * `disable_memory_telemetry()` or when the handle is destroyed, so no
+   * other resource may be pushed on top of it in between.
+   */
+  void enable_memory_telemetry()
+  {
+    std::lock_guard<std::mutex> _(mutex_);
+    if (!memory_telemetry_) {
+      memory_telemetry_ =
+        std::make_unique<memory_telemetry_resource>(rmm::mr::get_current_device_resource());
+      rmm::mr::set_current_device_resource(memory_telemetry_.get());
+    }
+  }
+
+  /** @brief restore the upstream device memory resource and drop the adaptor */
+  void disable_memory_telemetry()
+  {
+    std::lock_guard<std::mutex> _(mutex_);
+    if (memory_telemetry_) {
+      if (rmm::mr::get_current_device_resource() == memory_telemetry_.get()) {
+        rmm::mr::set_current_device_resource(memory_telemetry_->upstream());
+      }
+      memory_telemetry_.reset();
+    }
+  }
+
+  /**
+   * @brief returns the telemetry adaptor, or `nullptr` when telemetry is disabled
+   */
+  memory_telemetry_resource* get_memory_telemetry() const { return memory_telemetry_.get(); }
+
   const cudaDeviceProp& get_device_properties() const
   {
     std::lock_guard<std::mutex> _(mutex_);
@@ -280,6 +477,8 @@ class handle_t {
   const int dev_id_;
   mutable cublasHandle_t cublas_handle_;
   mutable bool cublas_initialized_{false};
+  mutable cublasLtHandle_t cublaslt_handle_;
+  mutable bool cublaslt_initialized_{false};
   mutable cusolverDnHandle_t cusolver_dn_handle_;
   mutable bool cusolver_dn_initialized_{false};
   mutable cusolverSpHandle_t cusolver_sp_handle_;
@@ -290,6 +489,14 @@ class handle_t {
   rmm::cuda_stream_view stream_view_{rmm::cuda_stream_per_thread};
   std::shared_ptr<rmm::cuda_stream_pool> stream_pool_{nullptr};
   cudaEvent_t event_;
+  mutable cudaStream_t high_priority_stream_;
+  mutable bool high_priority_stream_initialized_{false};
+  wait_policy_t wait_policy_{};
+  std::unique_ptr<profiler_state> profiler_{nullptr};
+  std::unique_ptr<memory_telemetry_resource> memory_telemetry_{nullptr};
+  mutable workspace_arena workspace_arena_;
+  mutable pinned_staging_ring staging_ring_;
+  mutable event_pool event_pool_;
   mutable cudaDeviceProp prop_;
   mutable bool device_prop_initialized_{false};
   mutable std::mutex mutex_;
@@ -303,6 +510,11 @@ class handle_t {
 
   void destroy_resources()
   {
+    // the telemetry adaptor must not outlive the handle as the current resource
+    if (memory_telemetry_ &&
+        rmm::mr::get_current_device_resource() == memory_telemetry_.get()) {
+      rmm::mr::set_current_device_resource(memory_telemetry_->upstream());
+    }
     if (cusparse_initialized_) { RAFT_CUSPARSE_TRY_NO_THROW(cusparseDestroy(cusparse_handle_)); }
     if (cusolver_dn_initialized_) {
       RAFT_CUSOLVER_TRY_NO_THROW(cusolverDnDestroy(cusolver_dn_handle_));
@@ -311,6 +523,10 @@ class handle_t {
       RAFT_CUSOLVER_TRY_NO_THROW(cusolverSpDestroy(cusolver_sp_handle_));
     }
     if (cublas_initialized_) { RAFT_CUBLAS_TRY_NO_THROW(cublasDestroy(cublas_handle_)); }
+    if (cublaslt_initialized_) { RAFT_CUBLAS_TRY_NO_THROW(cublasLtDestroy(cublaslt_handle_)); }
+    if (high_priority_stream_initialized_) {
+      RAFT_CUDA_TRY_NO_THROW(cudaStreamDestroy(high_priority_stream_));
+    }
     RAFT_CUDA_TRY_NO_THROW(cudaEventDestroy(event_));
   }
 };  // class handle_t
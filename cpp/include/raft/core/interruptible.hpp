@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -30,6 +32,27 @@
 
 namespace raft {
 
+/**
+ * @brief Controls how the CPU thread waits inside `interruptible::synchronize`.
+ *
+ * The wait proceeds in three phases: busy-spin on-core for `spin_duration`
+ * (lowest latency, no context switches), then `std::this_thread::yield()` for
+ * `yield_duration`, then sleep with exponential backoff capped at
+ * `max_sleep_duration` (lowest CPU usage). The default policy never leaves
+ * the yield phase, matching the historical behavior; latency-sensitive
+ * callers can set a non-zero spin phase to avoid scheduler jitter on short
+ * waits, while batch callers can bound the yield phase to release the core
+ * on long waits. Cancellation stays responsive in all phases.
+ */
+struct wait_policy_t {
+  /** How long to busy-spin before starting to yield */
+  std::chrono::microseconds spin_duration{0};
+  /** How long to yield before falling back to sleeping */
+  std::chrono::microseconds yield_duration{std::chrono::microseconds::max()};
+  /** Upper bound for the exponential sleep backoff */
+  std::chrono::microseconds max_sleep_duration{1000};
+};
+
 /**
  * @brief Exception thrown during `interruptible::synchronize` call when it detects a request
  * to cancel the work performed in this CPU thread.
@@ -77,7 +100,18 @@ class interruptible {
    */
   static inline void synchronize(rmm::cuda_stream_view stream)
   {
-    get_token()->synchronize_impl(cudaStreamQuery, stream);
+    get_token()->synchronize_impl(cudaStreamQuery, stream, wait_policy_t{});
+  }
+
+  /**
+   * @brief Same as `synchronize(stream)` with an explicit CPU wait policy.
+   *
+   * @param [in] stream a CUDA stream.
+   * @param [in] policy controls the spin/yield/sleep phases of the wait loop.
+   */
+  static inline void synchronize(rmm::cuda_stream_view stream, wait_policy_t policy)
+  {
+    get_token()->synchronize_impl(cudaStreamQuery, stream, policy);
   }
 
   /**
@@ -92,7 +126,18 @@ class interruptible {
    */
   static inline void synchronize(cudaEvent_t event)
   {
-    get_token()->synchronize_impl(cudaEventQuery, event);
+    get_token()->synchronize_impl(cudaEventQuery, event, wait_policy_t{});
+  }
+
+  /**
+   * @brief Same as `synchronize(event)` with an explicit CPU wait policy.
+   *
+   * @param [in] event a CUDA event.
+   * @param [in] policy controls the spin/yield/sleep phases of the wait loop.
+   */
+  static inline void synchronize(cudaEvent_t event, wait_policy_t policy)
+  {
+    get_token()->synchronize_impl(cudaEventQuery, event, policy);
   }
 
   /**
@@ -253,14 +298,29 @@ class interruptible {
   }
 
   template <typename Query, typename Object>
-  inline void synchronize_impl(Query query, Object object)
+  inline void synchronize_impl(Query query, Object object, wait_policy_t policy)
   {
+    using clock_t = std::chrono::steady_clock;
     cudaError_t query_result;
+    std::optional<clock_t::time_point> start{std::nullopt};
+    std::chrono::microseconds sleep_time{1};
     while (true) {
       yield_impl();
       query_result = query(object);
       if (query_result != cudaErrorNotReady) { break; }
-      std::this_thread::yield();
+      // don't take the timestamp unless the first query comes back not-ready;
+      // short waits then never touch the clock more than necessary
+      if (!start) { start = clock_t::now(); }
+      auto waited = std::chrono::duration_cast<std::chrono::microseconds>(clock_t::now() - *start);
+      if (waited < policy.spin_duration) {
+        continue;  // busy-spin: stay on-core for minimal wake-up latency
+      }
+      if (waited - policy.spin_duration < policy.yield_duration) {
+        std::this_thread::yield();
+      } else {
+        std::this_thread::sleep_for(sleep_time);
+        sleep_time = std::min(sleep_time * 2, policy.max_sleep_duration);
+      }
     }
     RAFT_CUDA_TRY(query_result);
   }
@@ -19,15 +19,19 @@
 
 #include <algorithm>
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 
 #include <stdarg.h>
 
 #define SPDLOG_HEADER_ONLY
+#include <raft/common/detail/async_log_ring.hpp>
 #include <raft/common/detail/callback_sink.hpp>
 #include <raft/cudart_utils.h>
 #include <spdlog/sinks/stdout_color_sinks.h>  // NOLINT
@@ -208,6 +212,36 @@ class logger {
    */
   std::string get_pattern() const { return cur_pattern; }
 
+  /**
+   * @brief Enable or disable asynchronous logging
+   *
+   * In async mode, log records are pushed onto a lock-free ring buffer and
+   * pattern formatting plus sink I/O happen on a background thread, so a
+   * log call on a hot path costs little more than expanding its message.
+   * Records are delivered in order; if the ring fills up, the offending
+   * call falls back to logging synchronously rather than dropping the
+   * record.
+   *
+   * @param[in] enable     whether to log asynchronously
+   * @param[in] queue_size capacity of the ring buffer (rounded up to a
+   *                       power of two)
+   */
+  void set_async(bool enable, std::size_t queue_size = 8192)
+  {
+    if (enable && !async_ring) {
+      async_ring = std::make_unique<raft::detail::async_log_ring>(queue_size);
+      async_stop.store(false, std::memory_order_relaxed);
+      async_worker = std::thread([this] { async_consume(); });
+    } else if (!enable && async_ring) {
+      stop_async();
+    }
+  }
+
+  /**
+   * @brief Tells whether the logger is in asynchronous mode
+   */
+  bool is_async() const { return async_ring != nullptr; }
+
   /**
    * @brief Main logging method
    *
@@ -224,25 +258,74 @@ class logger {
       va_start(vl, fmt);
       auto msg = raft::detail::format(fmt, vl);
       va_end(vl);
+      if (async_ring) {
+        async_pending.fetch_add(1, std::memory_order_relaxed);
+        if (async_ring->try_push(level, std::move(msg))) { return; }
+        async_pending.fetch_sub(1, std::memory_order_relaxed);
+      }
       spdlogger->log(level_e, msg);
     }
   }
 
   /**
    * @brief Flush logs by calling flush on underlying logger
+   *
+   * In async mode, first drains all records already enqueued on the ring.
    */
-  void flush() { spdlogger->flush(); }
+  void flush()
+  {
+    if (async_ring) {
+      while (async_pending.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+      }
+    }
+    spdlogger->flush();
+  }
 
-  ~logger() {}
+  ~logger() { stop_async(); }
 
  private:
   logger();
 
+  void async_consume()
+  {
+    raft::detail::async_log_ring::record rec;
+    auto deliver = [this, &rec] {
+      spdlogger->log(static_cast<spdlog::level::level_enum>(rec.level), rec.msg);
+      async_pending.fetch_sub(1, std::memory_order_release);
+    };
+    while (!async_stop.load(std::memory_order_relaxed)) {
+      if (async_ring->try_pop(rec)) {
+        deliver();
+      } else {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+    // drain whatever is left before shutting down
+    while (async_ring->try_pop(rec)) {
+      deliver();
+    }
+    spdlogger->flush();
+  }
+
+  void stop_async()
+  {
+    if (async_ring) {
+      async_stop.store(true, std::memory_order_relaxed);
+      if (async_worker.joinable()) { async_worker.join(); }
+      async_ring.reset();
+    }
+  }
+
   static inline std::unordered_map<std::string, std::shared_ptr<raft::logger>> log_map;
   std::shared_ptr<spdlog::sinks::callback_sink_mt> sink;
   std::shared_ptr<spdlog::logger> spdlogger;
   std::string cur_pattern;
   int cur_level;
+  std::unique_ptr<raft::detail::async_log_ring> async_ring;
+  std::thread async_worker;
+  std::atomic<bool> async_stop{false};
+  std::atomic<std::size_t> async_pending{0};
 };  // class logger
 
 };  // namespace raft
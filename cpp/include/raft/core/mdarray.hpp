@@ -22,6 +22,8 @@
  */
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <stddef.h>
 
 #include <raft/core/handle.hpp>
@@ -56,6 +58,14 @@ using layout_f_contiguous = layout_left;
 using col_major           = layout_left;
 /** @} */
 
+/**
+ * @defgroup Strided layout for mdarray and mdspan. Views a (sub)matrix with arbitrary
+ * per-dimension strides, e.g. a row window sliced out of a larger row-major matrix.
+ * @{
+ */
+using detail::stdex::layout_stride;
+/** @} */
+
 /**
  * @defgroup Common mdarray/mdspan extent types. The rank is known at compile time, each dimension
  * is known at run time (dynamic_extent in each dimension).
@@ -534,6 +544,34 @@ template <typename ElementType,
 using device_mdarray =
   mdarray<ElementType, Extents, LayoutPolicy, detail::device_accessor<ContainerPolicy>>;
 
+/**
+ * @brief mdarray with pinned (page-locked) host container policy
+ * @tparam ElementType the data type of the elements
+ * @tparam Extents defines the shape
+ * @tparam LayoutPolicy policy for indexing strides and layout ordering
+ * @tparam ContainerPolicy storage and accessor policy
+ */
+template <typename ElementType,
+          typename Extents,
+          typename LayoutPolicy    = layout_c_contiguous,
+          typename ContainerPolicy = detail::pinned_vector_policy<ElementType>>
+using pinned_mdarray =
+  mdarray<ElementType, Extents, LayoutPolicy, detail::host_accessor<ContainerPolicy>>;
+
+/**
+ * @brief mdarray with managed-memory container policy
+ * @tparam ElementType the data type of the elements
+ * @tparam Extents defines the shape
+ * @tparam LayoutPolicy policy for indexing strides and layout ordering
+ * @tparam ContainerPolicy storage and accessor policy
+ */
+template <typename ElementType,
+          typename Extents,
+          typename LayoutPolicy    = layout_c_contiguous,
+          typename ContainerPolicy = detail::managed_uvector_policy<ElementType>>
+using managed_mdarray =
+  mdarray<ElementType, Extents, LayoutPolicy, detail::device_accessor<ContainerPolicy>>;
+
 /**
  * @brief Shorthand for 0-dim host mdarray (scalar).
  * @tparam ElementType the data type of the scalar element
@@ -578,6 +616,36 @@ using host_matrix = host_mdarray<ElementType, matrix_extent, LayoutPolicy>;
 template <typename ElementType, typename LayoutPolicy = layout_c_contiguous>
 using device_matrix = device_mdarray<ElementType, matrix_extent, LayoutPolicy>;
 
+/**
+ * @brief Shorthand for 1-dim pinned host mdarray.
+ * @tparam ElementType the data type of the vector elements
+ */
+template <typename ElementType, typename LayoutPolicy = layout_c_contiguous>
+using pinned_vector = pinned_mdarray<ElementType, vector_extent, LayoutPolicy>;
+
+/**
+ * @brief Shorthand for c-contiguous pinned host matrix.
+ * @tparam ElementType the data type of the matrix elements
+ * @tparam LayoutPolicy policy for strides and layout ordering
+ */
+template <typename ElementType, typename LayoutPolicy = layout_c_contiguous>
+using pinned_matrix = pinned_mdarray<ElementType, matrix_extent, LayoutPolicy>;
+
+/**
+ * @brief Shorthand for 1-dim managed-memory mdarray.
+ * @tparam ElementType the data type of the vector elements
+ */
+template <typename ElementType, typename LayoutPolicy = layout_c_contiguous>
+using managed_vector = managed_mdarray<ElementType, vector_extent, LayoutPolicy>;
+
+/**
+ * @brief Shorthand for c-contiguous managed-memory matrix.
+ * @tparam ElementType the data type of the matrix elements
+ * @tparam LayoutPolicy policy for strides and layout ordering
+ */
+template <typename ElementType, typename LayoutPolicy = layout_c_contiguous>
+using managed_matrix = managed_mdarray<ElementType, matrix_extent, LayoutPolicy>;
+
 /**
  * @brief Shorthand for 0-dim host mdspan (scalar).
  * @tparam ElementType the data type of the scalar element
@@ -683,6 +751,24 @@ auto make_device_matrix_view(ElementType* ptr, size_t n_rows, size_t n_cols)
   return device_matrix_view<ElementType, LayoutPolicy>{ptr, extents};
 }
 
+/**
+ * @brief Create a 2-dim strided mdspan instance for device pointer, e.g. to view
+ *        a submatrix window of a larger row-major matrix without copying it.
+ * @tparam ElementType the data type of the matrix elements
+ * @param[in] ptr on device to wrap, pointing at the first element of the window
+ * @param[in] n_rows number of rows in the view
+ * @param[in] n_cols number of columns in the view
+ * @param[in] stride distance in elements between consecutive rows (the leading
+ *            dimension of the underlying matrix)
+ */
+template <typename ElementType>
+auto make_device_strided_matrix_view(ElementType* ptr, size_t n_rows, size_t n_cols, size_t stride)
+{
+  matrix_extent extents{n_rows, n_cols};
+  auto mapping = layout_stride::mapping<matrix_extent>{extents, std::array<size_t, 2>{stride, 1}};
+  return device_matrix_view<ElementType, layout_stride>{ptr, mapping};
+}
+
 /**
  * @brief Create a 1-dim mdspan instance for host pointer.
  * @tparam ElementType the data type of the vector elements
@@ -711,6 +797,138 @@ auto make_device_vector_view(ElementType* ptr, size_t n)
   return device_vector_view<ElementType, LayoutPolicy>{ptr, extents};
 }
 
+namespace detail {
+/**
+ * Validates a zero-copy reinterpretation of a contiguous buffer of
+ * `n_src_bytes` at `ptr` as `n_dst` elements of type U.
+ */
+template <typename U>
+void check_reinterpret_view(void const* ptr, size_t n_src_bytes, size_t n_dst_bytes)
+{
+  RAFT_EXPECTS(n_dst_bytes <= n_src_bytes,
+               "reinterpret_view: target needs %zu bytes but the buffer holds only %zu",
+               n_dst_bytes,
+               n_src_bytes);
+  RAFT_EXPECTS(reinterpret_cast<std::uintptr_t>(ptr) % alignof(U) == 0,
+               "reinterpret_view: buffer is not aligned for the target element type (%zu bytes)",
+               alignof(U));
+}
+}  // namespace detail
+
+/**
+ * @defgroup reinterpret_view Zero-copy typed reinterpretation of mdspan buffers
+ *
+ * Reusing one scratch buffer as different element types across pipeline stages
+ * (e.g. float distances in one stage, cub::KeyValuePair in the next) otherwise
+ * requires raw pointer casts that bypass extent checking, or a second
+ * allocation. These functions rebuild a typed view over the same memory after
+ * validating the buffer's size and alignment for the target type. The source
+ * view must be contiguous; the element count of the result is derived from the
+ * buffer size (flat 1-dim overloads) or checked against it (shaped overloads).
+ * Reinterpreting away constness is rejected at compile time.
+ * @{
+ */
+
+/**
+ * @brief Reinterpret a contiguous device mdspan as a flat vector of U.
+ * @tparam U the target element type
+ * @param[in] view source view; its buffer must be suitably aligned for U
+ * @return raft::device_vector_view of `size_in_bytes / sizeof(U)` elements
+ */
+template <typename U, typename ElementType, typename Extents, typename LayoutPolicy>
+auto reinterpret_view(device_mdspan<ElementType, Extents, LayoutPolicy> view)
+{
+  static_assert(std::is_same_v<LayoutPolicy, layout_right> ||
+                  std::is_same_v<LayoutPolicy, layout_left>,
+                "reinterpret_view requires a contiguous source layout");
+  auto bytes = view.size() * sizeof(ElementType);
+  RAFT_EXPECTS(bytes % sizeof(U) == 0,
+               "reinterpret_view: buffer size (%zu bytes) is not a multiple of the target "
+               "element size (%zu bytes)",
+               bytes,
+               sizeof(U));
+  auto n = bytes / sizeof(U);
+  detail::check_reinterpret_view<U>(view.data(), bytes, n * sizeof(U));
+  return make_device_vector_view<U>(reinterpret_cast<U*>(view.data()), n);
+}
+
+/**
+ * @brief Reinterpret a contiguous host mdspan as a flat vector of U.
+ * @tparam U the target element type
+ * @param[in] view source view; its buffer must be suitably aligned for U
+ * @return raft::host_vector_view of `size_in_bytes / sizeof(U)` elements
+ */
+template <typename U, typename ElementType, typename Extents, typename LayoutPolicy>
+auto reinterpret_view(host_mdspan<ElementType, Extents, LayoutPolicy> view)
+{
+  static_assert(std::is_same_v<LayoutPolicy, layout_right> ||
+                  std::is_same_v<LayoutPolicy, layout_left>,
+                "reinterpret_view requires a contiguous source layout");
+  auto bytes = view.size() * sizeof(ElementType);
+  RAFT_EXPECTS(bytes % sizeof(U) == 0,
+               "reinterpret_view: buffer size (%zu bytes) is not a multiple of the target "
+               "element size (%zu bytes)",
+               bytes,
+               sizeof(U));
+  auto n = bytes / sizeof(U);
+  detail::check_reinterpret_view<U>(view.data(), bytes, n * sizeof(U));
+  return make_host_vector_view<U>(reinterpret_cast<U*>(view.data()), n);
+}
+
+/**
+ * @brief Reinterpret a contiguous device mdspan as an [n_rows, n_cols] matrix of U.
+ *
+ * The requested shape must fit into the source buffer; a strict subset is
+ * allowed so one oversized scratch allocation can back differently-shaped
+ * stages.
+ *
+ * @tparam U the target element type
+ * @param[in] view source view; its buffer must be suitably aligned for U
+ * @param[in] n_rows number of rows of the target view
+ * @param[in] n_cols number of columns of the target view
+ * @return raft::device_matrix_view over the same memory
+ */
+template <typename U, typename ElementType, typename Extents, typename LayoutPolicy>
+auto reinterpret_view(device_mdspan<ElementType, Extents, LayoutPolicy> view,
+                      size_t n_rows,
+                      size_t n_cols)
+{
+  static_assert(std::is_same_v<LayoutPolicy, layout_right> ||
+                  std::is_same_v<LayoutPolicy, layout_left>,
+                "reinterpret_view requires a contiguous source layout");
+  auto bytes = view.size() * sizeof(ElementType);
+  detail::check_reinterpret_view<U>(view.data(), bytes, n_rows * n_cols * sizeof(U));
+  return make_device_matrix_view<U>(reinterpret_cast<U*>(view.data()), n_rows, n_cols);
+}
+
+/**
+ * @brief Reinterpret an mdarray's buffer as a flat vector of U (zero-copy).
+ * @tparam U the target element type
+ * @param[in] array source array; stays the owner of the memory
+ */
+template <typename U, typename ElementType, typename Extents, typename LayoutPolicy, typename CP>
+auto reinterpret_view(mdarray<ElementType, Extents, LayoutPolicy, CP>& array)
+{
+  return reinterpret_view<U>(array.view());
+}
+
+/**
+ * @brief Reinterpret an mdarray's buffer as an [n_rows, n_cols] matrix of U (zero-copy).
+ * @tparam U the target element type
+ * @param[in] array source array; stays the owner of the memory
+ * @param[in] n_rows number of rows of the target view
+ * @param[in] n_cols number of columns of the target view
+ */
+template <typename U, typename ElementType, typename Extents, typename LayoutPolicy, typename CP>
+auto reinterpret_view(mdarray<ElementType, Extents, LayoutPolicy, CP>& array,
+                      size_t n_rows,
+                      size_t n_cols)
+{
+  return reinterpret_view<U>(array.view(), n_rows, n_cols);
+}
+
+/** @} */
+
 /**
  * @brief Create a host mdarray.
  * @tparam ElementType the data type of the matrix elements
@@ -785,6 +1003,53 @@ auto make_device_mdarray(rmm::cuda_stream_view stream,
   return mdarray_t{layout, policy};
 }
 
+/**
+ * @brief Create a pinned (page-locked) host mdarray.
+ * @tparam ElementType the data type of the matrix elements
+ * @tparam LayoutPolicy policy for strides and layout ordering
+ * @param exts dimensionality of the array (series of integers)
+ * @return raft::pinned_mdarray
+ */
+template <typename ElementType,
+          typename LayoutPolicy = layout_c_contiguous,
+          typename... Extents,
+          typename = detail::ensure_integral_extents<Extents...>>
+auto make_pinned_mdarray(Extents... exts)
+{
+  using extent_t  = extents<((void)exts, dynamic_extent)...>;
+  using mdarray_t = pinned_mdarray<ElementType, extent_t, LayoutPolicy>;
+
+  typename mdarray_t::extents_type extent{exts...};
+  typename mdarray_t::mapping_type layout{extent};
+  typename mdarray_t::container_policy_type policy;
+
+  return mdarray_t{layout, policy};
+}
+
+/**
+ * @brief Create a managed-memory mdarray.
+ * @tparam ElementType the data type of the matrix elements
+ * @tparam LayoutPolicy policy for strides and layout ordering
+ * @param stream cuda stream for ordering events
+ * @param exts dimensionality of the array (series of integers)
+ * @return raft::managed_mdarray
+ */
+template <typename ElementType,
+          typename LayoutPolicy = layout_c_contiguous,
+          typename... Extents,
+          typename = detail::ensure_integral_extents<Extents...>>
+auto make_managed_mdarray(rmm::cuda_stream_view stream, Extents... exts)
+{
+  using extent_t  = extents<((void)exts, dynamic_extent)...>;
+  using mdarray_t = managed_mdarray<ElementType, extent_t, LayoutPolicy>;
+
+  typename mdarray_t::extents_type extent{exts...};
+  typename mdarray_t::mapping_type layout{extent};
+  typename mdarray_t::container_policy_type policy{stream};
+
+  return mdarray_t{layout, policy};
+}
+
 /**
  * @brief Create a 2-dim c-contiguous host mdarray.
  * @tparam ElementType the data type of the matrix elements
@@ -799,6 +1064,35 @@ auto make_host_matrix(size_t n_rows, size_t n_cols)
   return make_host_mdarray<ElementType, LayoutPolicy>(n_rows, n_cols);
 }
 
+/**
+ * @brief Create a 2-dim c-contiguous pinned host mdarray.
+ * @tparam ElementType the data type of the matrix elements
+ * @tparam LayoutPolicy policy for strides and layout ordering
+ * @param[in] n_rows number or rows in matrix
+ * @param[in] n_cols number of columns in matrix
+ * @return raft::pinned_matrix
+ */
+template <typename ElementType, typename LayoutPolicy = layout_c_contiguous>
+auto make_pinned_matrix(size_t n_rows, size_t n_cols)
+{
+  return make_pinned_mdarray<ElementType, LayoutPolicy>(n_rows, n_cols);
+}
+
+/**
+ * @brief Create a 2-dim c-contiguous managed-memory mdarray.
+ * @tparam ElementType the data type of the matrix elements
+ * @tparam LayoutPolicy policy for strides and layout ordering
+ * @param[in] n_rows number or rows in matrix
+ * @param[in] n_cols number of columns in matrix
+ * @param[in] stream cuda stream for ordering events
+ * @return raft::managed_matrix
+ */
+template <typename ElementType, typename LayoutPolicy = layout_c_contiguous>
+auto make_managed_matrix(size_t n_rows, size_t n_cols, rmm::cuda_stream_view stream)
+{
+  return make_managed_mdarray<ElementType, LayoutPolicy>(stream, n_rows, n_cols);
+}
+
 /**
  * @brief Create a 2-dim c-contiguous device mdarray.
  * @tparam ElementType the data type of the matrix elements
@@ -922,6 +1216,31 @@ auto make_device_vector(raft::handle_t const& handle, size_t n)
   return make_device_vector<ElementType, LayoutPolicy>(n, handle.get_stream());
 }
 
+/**
+ * @brief Create a 1-dim pinned host mdarray.
+ * @tparam ElementType the data type of the vector elements
+ * @param[in] n number of elements in vector
+ * @return raft::pinned_vector
+ */
+template <typename ElementType, typename LayoutPolicy = layout_c_contiguous>
+auto make_pinned_vector(size_t n)
+{
+  return make_pinned_mdarray<ElementType, LayoutPolicy>(n);
+}
+
+/**
+ * @brief Create a 1-dim managed-memory mdarray.
+ * @tparam ElementType the data type of the vector elements
+ * @param[in] n number of elements in vector
+ * @param[in] stream the cuda stream for ordering events
+ * @return raft::managed_vector
+ */
+template <typename ElementType, typename LayoutPolicy = layout_c_contiguous>
+auto make_managed_vector(size_t n, rmm::cuda_stream_view stream)
+{
+  return make_managed_mdarray<ElementType, LayoutPolicy>(stream, n);
+}
+
 /**
  * @brief Flatten raft::host_mdspan or raft::device_mdspan into a 1-dim array view
  *
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/mr/device/device_memory_resource.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <utility>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace raft {
+
+/** @brief Allocation statistics of a single telemetry scope. */
+struct memory_stats {
+  std::size_t current_bytes{0};
+  std::size_t peak_bytes{0};
+  std::size_t n_allocations{0};
+};
+
+/**
+ * @brief Tracking adaptor attributing device allocations to named scopes.
+ *
+ * Allocations made while a `raft::memory_scope` is on the calling thread's
+ * stack are attributed to the innermost scope name; allocations outside any
+ * scope land under "". Per-scope current and peak bytes answer "which
+ * primitive spiked" after an OOM without a profiler attached; a grand total
+ * is kept under the scope name "*".
+ *
+ * The adaptor forwards every allocation to its upstream resource and only
+ * adds bookkeeping under a mutex, so it is cheap enough to leave on in
+ * production. It is installed via `handle_t::enable_memory_telemetry()`.
+ */
+class memory_telemetry_resource final : public rmm::mr::device_memory_resource {
+ public:
+  explicit memory_telemetry_resource(rmm::mr::device_memory_resource* upstream)
+    : upstream_(upstream)
+  {
+  }
+
+  memory_telemetry_resource(const memory_telemetry_resource&) = delete;
+  memory_telemetry_resource& operator=(const memory_telemetry_resource&) = delete;
+
+  rmm::mr::device_memory_resource* upstream() const { return upstream_; }
+
+  /** Pushes a scope name onto the calling thread's attribution stack. */
+  static void push_scope(const char* name) { scope_stack().emplace_back(name); }
+
+  /** Pops the calling thread's innermost scope. */
+  static void pop_scope() { scope_stack().pop_back(); }
+
+  /** @brief Returns the statistics of one scope ("" outside scopes, "*" total). */
+  memory_stats get_stats(const std::string& scope) const
+  {
+    std::lock_guard<std::mutex> _(mutex_);
+    auto it = stats_.find(scope);
+    return it == stats_.end() ? memory_stats{} : it->second;
+  }
+
+  /** @brief Returns the statistics of every scope seen so far, sorted by name. */
+  std::map<std::string, memory_stats> get_all_stats() const
+  {
+    std::lock_guard<std::mutex> _(mutex_);
+    return {stats_.begin(), stats_.end()};
+  }
+
+  /** @brief Resets peak and counter statistics; live allocations stay attributed. */
+  void reset_peaks()
+  {
+    std::lock_guard<std::mutex> _(mutex_);
+    for (auto& kv : stats_) {
+      kv.second.peak_bytes    = kv.second.current_bytes;
+      kv.second.n_allocations = 0;
+    }
+  }
+
+ private:
+  static std::vector<std::string>& scope_stack()
+  {
+    static thread_local std::vector<std::string> stack;
+    return stack;
+  }
+
+  static const std::string& current_scope()
+  {
+    static const std::string unscoped{};
+    auto& stack = scope_stack();
+    return stack.empty() ? unscoped : stack.back();
+  }
+
+  void account(memory_stats& s, std::size_t bytes)
+  {
+    s.current_bytes += bytes;
+    s.peak_bytes = std::max(s.peak_bytes, s.current_bytes);
+    s.n_allocations++;
+  }
+
+  void* do_allocate(std::size_t bytes, rmm::cuda_stream_view stream) override
+  {
+    void* p = upstream_->allocate(bytes, stream);
+    std::lock_guard<std::mutex> _(mutex_);
+    const auto& scope = current_scope();
+    account(stats_[scope], bytes);
+    account(stats_["*"], bytes);
+    allocations_[p] = scope;
+    return p;
+  }
+
+  void do_deallocate(void* p, std::size_t bytes, rmm::cuda_stream_view stream) override
+  {
+    {
+      std::lock_guard<std::mutex> _(mutex_);
+      auto it = allocations_.find(p);
+      if (it != allocations_.end()) {
+        stats_[it->second].current_bytes -= bytes;
+        stats_["*"].current_bytes -= bytes;
+        allocations_.erase(it);
+      }
+    }
+    upstream_->deallocate(p, bytes, stream);
+  }
+
+  bool do_is_equal(const rmm::mr::device_memory_resource& other) const noexcept override
+  {
+    return this == &other;
+  }
+
+  bool supports_streams() const noexcept override { return upstream_->supports_streams(); }
+  bool supports_get_mem_info() const noexcept override
+  {
+    return upstream_->supports_get_mem_info();
+  }
+  std::pair<std::size_t, std::size_t> do_get_mem_info(rmm::cuda_stream_view stream) const override
+  {
+    return upstream_->get_mem_info(stream);
+  }
+
+  rmm::mr::device_memory_resource* upstream_;
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, memory_stats> stats_;
+  std::unordered_map<void*, std::string> allocations_;
+};
+
+/**
+ * @brief RAII scope attributing device allocations to a primitive name.
+ *
+ * Mirrors the NVTX range idiom: primitives open a scope at their entry
+ * point and every allocation drawn from the tracked resource inside it is
+ * attributed to the scope's name. Nested scopes attribute to the innermost
+ * name. A no-op when no telemetry resource is installed.
+ */
+class memory_scope {
+ public:
+  explicit memory_scope(const char* name) { memory_telemetry_resource::push_scope(name); }
+  ~memory_scope() { memory_telemetry_resource::pop_scope(); }
+
+  memory_scope(const memory_scope&) = delete;
+  memory_scope& operator=(const memory_scope&) = delete;
+};
+
+}  // namespace raft
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/core/cudart_utils.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace raft {
+
+/**
+ * @brief Ring of pinned staging buffers for repeated small host transfers.
+ *
+ * `cudaMemcpyAsync` from pageable memory degrades to a synchronous copy in
+ * the driver; staging through pinned slots keeps high-rate small transfers
+ * (query batches in, result batches out) truly asynchronous. Slots are
+ * recycled with events: a slot is only reused once the transfer it staged
+ * has completed, so callers never wait unless all slots are in flight.
+ *
+ * Pinned memory is allocated lazily on first use and sized
+ * `n_slots * slot_bytes`; transfers larger than a slot are chunked across
+ * the ring. The ring is owned by `handle_t` (see `get_staging_ring()`) and
+ * is safe to use from multiple threads.
+ */
+class pinned_staging_ring {
+ public:
+  explicit pinned_staging_ring(std::size_t slot_bytes = 1 << 20, std::size_t n_slots = 4)
+    : slot_bytes_(slot_bytes), n_slots_(n_slots)
+  {
+  }
+
+  ~pinned_staging_ring()
+  {
+    for (auto& s : slots_) {
+      if (s.in_flight) { RAFT_CUDA_TRY_NO_THROW(cudaEventSynchronize(s.ready)); }
+      RAFT_CUDA_TRY_NO_THROW(cudaEventDestroy(s.ready));
+      RAFT_CUDA_TRY_NO_THROW(cudaFreeHost(s.buf));
+    }
+  }
+
+  pinned_staging_ring(const pinned_staging_ring&) = delete;
+  pinned_staging_ring& operator=(const pinned_staging_ring&) = delete;
+
+  /**
+   * @brief Stages a pageable host buffer and copies it to device asynchronously.
+   *
+   * The source is memcpy'd into pinned slots and transferred with
+   * `cudaMemcpyAsync`; the call returns as soon as the transfers are
+   * enqueued and `src` may be reused immediately. Blocks only when every
+   * slot is still in flight.
+   *
+   * @param[out] dst destination device buffer
+   * @param[in] src source host buffer (pageable or pinned)
+   * @param[in] bytes number of bytes to copy
+   * @param[in] stream stream to order the transfer on
+   */
+  void stage_and_copy_async(void* dst, const void* src, std::size_t bytes, cudaStream_t stream)
+  {
+    std::lock_guard<std::mutex> _(mutex_);
+    lazy_init();
+
+    std::size_t pos = 0;
+    while (pos < bytes) {
+      std::size_t len = std::min(slot_bytes_, bytes - pos);
+      auto& s         = acquire_slot();
+      std::memcpy(s.buf, static_cast<const char*>(src) + pos, len);
+      RAFT_CUDA_TRY(cudaMemcpyAsync(
+        static_cast<char*>(dst) + pos, s.buf, len, cudaMemcpyHostToDevice, stream));
+      RAFT_CUDA_TRY(cudaEventRecord(s.ready, stream));
+      s.in_flight = true;
+      pos += len;
+    }
+  }
+
+  /**
+   * @brief Copies a device buffer into pageable host memory through the ring.
+   *
+   * The device data is transferred into pinned slots asynchronously and
+   * unstaged into `dst` as each chunk's event completes; the next chunk's
+   * transfer is already in flight while the previous one is memcpy'd out.
+   * The call returns once `dst` is fully populated, without synchronizing
+   * `stream` beyond the copied range.
+   *
+   * @param[out] dst destination host buffer (pageable or pinned)
+   * @param[in] src source device buffer
+   * @param[in] bytes number of bytes to copy
+   * @param[in] stream stream the source data is ordered on
+   */
+  void copy_to_host(void* dst, const void* src, std::size_t bytes, cudaStream_t stream)
+  {
+    std::lock_guard<std::mutex> _(mutex_);
+    lazy_init();
+
+    struct pending {
+      slot* s;
+      std::size_t pos;
+      std::size_t len;
+    };
+    std::vector<pending> in_flight;
+
+    std::size_t pos = 0;
+    while (pos < bytes || !in_flight.empty()) {
+      // keep up to half the ring in flight before draining
+      while (pos < bytes && in_flight.size() < std::max<std::size_t>(1, n_slots_ / 2)) {
+        std::size_t len = std::min(slot_bytes_, bytes - pos);
+        auto& s         = acquire_slot();
+        RAFT_CUDA_TRY(cudaMemcpyAsync(
+          s.buf, static_cast<const char*>(src) + pos, len, cudaMemcpyDeviceToHost, stream));
+        RAFT_CUDA_TRY(cudaEventRecord(s.ready, stream));
+        s.in_flight = true;
+        in_flight.push_back({&s, pos, len});
+        pos += len;
+      }
+
+      auto chunk = in_flight.front();
+      in_flight.erase(in_flight.begin());
+      RAFT_CUDA_TRY(cudaEventSynchronize(chunk.s->ready));
+      chunk.s->in_flight = false;
+      std::memcpy(static_cast<char*>(dst) + chunk.pos, chunk.s->buf, chunk.len);
+    }
+  }
+
+  std::size_t slot_bytes() const { return slot_bytes_; }
+  std::size_t n_slots() const { return n_slots_; }
+
+ private:
+  struct slot {
+    char* buf{nullptr};
+    cudaEvent_t ready;
+    bool in_flight{false};
+  };
+
+  void lazy_init()
+  {
+    if (!slots_.empty()) { return; }
+    slots_.resize(n_slots_);
+    for (auto& s : slots_) {
+      RAFT_CUDA_TRY(cudaMallocHost(&s.buf, slot_bytes_));
+      RAFT_CUDA_TRY(cudaEventCreateWithFlags(&s.ready, cudaEventDisableTiming));
+    }
+  }
+
+  slot& acquire_slot()
+  {
+    auto& s = slots_[next_++ % n_slots_];
+    if (s.in_flight) {
+      RAFT_CUDA_TRY(cudaEventSynchronize(s.ready));
+      s.in_flight = false;
+    }
+    return s;
+  }
+
+  std::size_t slot_bytes_;
+  std::size_t n_slots_;
+  std::size_t next_{0};
+  std::vector<slot> slots_;
+  std::mutex mutex_;
+};
+
+}  // namespace raft
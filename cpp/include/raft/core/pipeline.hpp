@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/core/error.hpp>
+#include <raft/core/event_pool.hpp>
+#include <raft/core/handle.hpp>
+
+#include <rmm/cuda_stream_view.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace raft {
+
+/**
+ * @brief Lightweight scheduler expressing stage overlap over the handle's
+ * stream pool.
+ *
+ * Chained primitives ("distance tile -> select -> postprocess") serialize
+ * when everything is enqueued on the handle's main stream; overlapping them
+ * by hand means event plumbing that is easy to get wrong. A pipeline lets
+ * callers declare stages with explicit dependencies instead: each stage is
+ * assigned an internal stream round-robin and the required event
+ * records/waits are inserted automatically. Enqueueing is entirely
+ * asynchronous; stages only describe ordering, the GPU overlaps whatever
+ * the dependencies allow.
+ *
+ * Every stage implicitly depends on work enqueued on the main stream
+ * before the pipeline was created, and join()/wait() hand all stage
+ * results back to the main stream, so a pipeline composes transparently
+ * with surrounding single-stream code.
+ *
+ * Usage:
+ * @code{.cpp}
+ *   raft::pipeline p(handle);
+ *   auto dist = p.add_stage([&](rmm::cuda_stream_view s) { ... });
+ *   auto sel  = p.add_stage([&](rmm::cuda_stream_view s) { ... }, {dist});
+ *   p.add_stage([&](rmm::cuda_stream_view s) { ... }, {sel});
+ *   p.wait();
+ * @endcode
+ *
+ * Without an initialized stream pool all stages fall back to the main
+ * stream and the pipeline degenerates to plain sequential enqueueing.
+ */
+class pipeline {
+ public:
+  using stage_id = std::size_t;
+
+  explicit pipeline(const raft::handle_t& handle) : handle_(handle), next_stream_(0)
+  {
+    entry_ = handle_.get_event_pool().acquire();
+    RAFT_CUDA_TRY(cudaEventRecord(entry_, handle_.get_stream()));
+  }
+
+  ~pipeline()
+  {
+    // returning a still-pending event to the pool is fine: waits already
+    // enqueued against it are unaffected by a later re-record
+    for (auto& s : stages_) {
+      handle_.get_event_pool().release(s.done);
+    }
+    handle_.get_event_pool().release(entry_);
+  }
+
+  pipeline(const pipeline&) = delete;
+  pipeline& operator=(const pipeline&) = delete;
+
+  /**
+   * @brief Enqueues a stage and returns its id for use as a dependency.
+   *
+   * The functor is invoked immediately with the stream assigned to the
+   * stage and must enqueue all of the stage's work onto it. Dependencies
+   * are expressed with stream waits on the producers' completion events,
+   * so this call never blocks the host.
+   *
+   * @param fn functor of signature void(rmm::cuda_stream_view)
+   * @param deps ids of stages whose completion this stage must observe
+   * @return id of the new stage
+   */
+  template <typename Fn>
+  stage_id add_stage(Fn&& fn, const std::vector<stage_id>& deps = {})
+  {
+    auto stream = next_stream();
+
+    // observe pre-pipeline work; a no-op once the entry event has fired
+    RAFT_CUDA_TRY(cudaStreamWaitEvent(stream, entry_, 0));
+    for (auto d : deps) {
+      RAFT_EXPECTS(d < stages_.size(), "raft::pipeline: unknown stage dependency %zu", d);
+      RAFT_CUDA_TRY(cudaStreamWaitEvent(stream, stages_[d].done, 0));
+    }
+
+    fn(rmm::cuda_stream_view(stream));
+
+    stage s;
+    s.stream = stream;
+    s.done   = handle_.get_event_pool().acquire();
+    RAFT_CUDA_TRY(cudaEventRecord(s.done, stream));
+    stages_.push_back(s);
+    return stages_.size() - 1;
+  }
+
+  /**
+   * @brief Makes the handle's main stream wait on every stage.
+   *
+   * Non-blocking: subsequent work on the main stream is ordered after the
+   * pipeline, but the host continues immediately.
+   */
+  void join()
+  {
+    for (auto& s : stages_) {
+      RAFT_CUDA_TRY(cudaStreamWaitEvent(handle_.get_stream(), s.done, 0));
+    }
+  }
+
+  /** @brief join() followed by a blocking sync of the main stream. */
+  void wait()
+  {
+    join();
+    handle_.sync_stream();
+  }
+
+ private:
+  struct stage {
+    cudaStream_t stream;
+    cudaEvent_t done;
+  };
+
+  cudaStream_t next_stream()
+  {
+    if (!handle_.is_stream_pool_initialized()) { return handle_.get_stream(); }
+    return handle_.get_stream_from_stream_pool(next_stream_++ % handle_.get_stream_pool_size())
+      .value();
+  }
+
+  const raft::handle_t& handle_;
+  std::size_t next_stream_;
+  cudaEvent_t entry_;
+  std::vector<stage> stages_;
+};
+
+}  // namespace raft
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cuda_runtime.h>
+
+#include <raft/core/cudart_utils.hpp>
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace raft {
+
+/**
+ * @brief Observer interface for always-on primitive timing telemetry.
+ *
+ * Unlike the NVTX annotations (which need a profiler attached), an observer
+ * registered on a `handle_t` receives the measured device time of every
+ * instrumented primitive call in production, e.g. to aggregate per-primitive
+ * latency percentiles. Implementations must be thread-safe if the handle is
+ * shared across threads.
+ */
+class profiler_observer {
+ public:
+  virtual ~profiler_observer() = default;
+
+  /**
+   * @brief Called once per instrumented primitive call.
+   *
+   * Invoked from whichever thread next touches the profiler after the
+   * primitive's stop event completed -- not from the primitive call itself --
+   * so implementations must not assume any particular calling context.
+   *
+   * @param name static name of the primitive (a string literal; not owned)
+   * @param stream the stream the primitive ran on
+   * @param elapsed_ms device time between the primitive's start and stop events
+   */
+  virtual void on_primitive(const char* name, cudaStream_t stream, float elapsed_ms) = 0;
+};
+
+/**
+ * @brief Per-handle profiler bookkeeping: a pool of timing events and the
+ * queue of in-flight measurements.
+ *
+ * Measurements are drained lazily: whenever a new scope is submitted (or
+ * `flush()` is called), records whose stop event has completed are resolved
+ * via `cudaEventElapsedTime` and reported to the observer. Nothing in the hot
+ * path synchronizes the device.
+ */
+class profiler_state {
+ public:
+  explicit profiler_state(std::shared_ptr<profiler_observer> observer)
+    : observer_{std::move(observer)}
+  {
+  }
+
+  ~profiler_state()
+  {
+    flush_no_throw();
+    for (auto event : free_events_) {
+      RAFT_CUDA_TRY_NO_THROW(cudaEventDestroy(event));
+    }
+  }
+
+  profiler_state(const profiler_state&) = delete;
+  profiler_state& operator=(const profiler_state&) = delete;
+
+  /** Take a timing-capable event from the pool (creating one if needed). */
+  cudaEvent_t acquire_event()
+  {
+    std::lock_guard<std::mutex> _(mutex_);
+    if (!free_events_.empty()) {
+      auto event = free_events_.back();
+      free_events_.pop_back();
+      return event;
+    }
+    cudaEvent_t event;
+    RAFT_CUDA_TRY(cudaEventCreate(&event));
+    return event;
+  }
+
+  /** Queue a finished measurement and drain whatever has completed so far. */
+  void submit(const char* name, cudaStream_t stream, cudaEvent_t start, cudaEvent_t stop)
+  {
+    std::lock_guard<std::mutex> _(mutex_);
+    pending_.push_back(record{name, stream, start, stop});
+    while (!pending_.empty() && cudaEventQuery(pending_.front().stop) == cudaSuccess) {
+      resolve_front();
+    }
+    // a failed query other than cudaErrorNotReady surfaces on the next CUDA call
+    cudaGetLastError();
+  }
+
+  /** Wait for all in-flight measurements and report them. */
+  void flush()
+  {
+    std::lock_guard<std::mutex> _(mutex_);
+    while (!pending_.empty()) {
+      RAFT_CUDA_TRY(cudaEventSynchronize(pending_.front().stop));
+      resolve_front();
+    }
+  }
+
+ private:
+  struct record {
+    const char* name;
+    cudaStream_t stream;
+    cudaEvent_t start;
+    cudaEvent_t stop;
+  };
+
+  void resolve_front()
+  {
+    auto& r          = pending_.front();
+    float elapsed_ms = 0.0f;
+    RAFT_CUDA_TRY_NO_THROW(cudaEventElapsedTime(&elapsed_ms, r.start, r.stop));
+    observer_->on_primitive(r.name, r.stream, elapsed_ms);
+    free_events_.push_back(r.start);
+    free_events_.push_back(r.stop);
+    pending_.pop_front();
+  }
+
+  void flush_no_throw()
+  {
+    std::lock_guard<std::mutex> _(mutex_);
+    while (!pending_.empty()) {
+      RAFT_CUDA_TRY_NO_THROW(cudaEventSynchronize(pending_.front().stop));
+      resolve_front();
+    }
+  }
+
+  std::shared_ptr<profiler_observer> observer_;
+  std::vector<cudaEvent_t> free_events_;
+  std::deque<record> pending_;
+  std::mutex mutex_;
+};
+
+/**
+ * @brief RAII scope reporting the device time of the enclosed work to the
+ * handle's profiler observer.
+ *
+ * Primitives construct this with `handle.get_profiler()`; when no observer is
+ * attached that returns `nullptr` and both constructor and destructor reduce
+ * to a pointer check. The name must be a string literal (it is not copied).
+ *
+ * @code{.cpp}
+ * void some_primitive(const raft::handle_t& handle, ...)
+ * {
+ *   raft::profiling_scope prof_scope(handle.get_profiler(), "some_primitive", stream);
+ *   // ... enqueue work on stream ...
+ * }
+ * @endcode
+ */
+class profiling_scope {
+ public:
+  profiling_scope(profiler_state* state, const char* name, cudaStream_t stream)
+    : state_{state}, name_{name}, stream_{stream}
+  {
+    if (state_ != nullptr) {
+      start_ = state_->acquire_event();
+      stop_  = state_->acquire_event();
+      RAFT_CUDA_TRY(cudaEventRecord(start_, stream_));
+    }
+  }
+
+  ~profiling_scope()
+  {
+    if (state_ != nullptr) {
+      RAFT_CUDA_TRY_NO_THROW(cudaEventRecord(stop_, stream_));
+      state_->submit(name_, stream_, start_, stop_);
+    }
+  }
+
+  profiling_scope(const profiling_scope&) = delete;
+  profiling_scope& operator=(const profiling_scope&) = delete;
+
+ private:
+  profiler_state* state_;
+  const char* name_;
+  cudaStream_t stream_;
+  cudaEvent_t start_{nullptr};
+  cudaEvent_t stop_{nullptr};
+};
+
+}  // namespace raft
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <raft/core/mdarray.hpp>
+#include <raft/cudart_utils.h>
+
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_uvector.hpp>
+
+#include <algorithm>
+
+namespace raft {
+
+/**
+ * @brief Row-growable device matrix with amortized O(n) appends.
+ *
+ * `device_matrix` has fixed extents: growing it means allocating a new buffer
+ * and copying everything, so appending b batches of rows costs O(b * n) copies
+ * in total. This container keeps a row-major buffer whose capacity grows
+ * geometrically (doubling, like `std::vector`), so a sequence of `append_rows`
+ * calls copies each element O(1) times on average. The number of columns is
+ * fixed at construction; only the row extent changes.
+ *
+ * The contents are exposed as a `device_matrix_view` over the current extents;
+ * the view (and any raw pointer obtained from `data()`) is invalidated by any
+ * call that grows past the reserved capacity.
+ *
+ * @code{.cpp}
+ *   auto mat = raft::make_resizable_device_matrix<float>(handle, 0, n_features);
+ *   for (auto& batch : batches) {
+ *     mat.append_rows(batch.data(), batch.n_rows(), stream);
+ *   }
+ *   run_kernel(mat.view(), ...);
+ * @endcode
+ */
+template <typename ElementType>
+class resizable_device_matrix {
+  static_assert(!std::is_const<ElementType>::value,
+                "Element type for container must not be const.");
+
+ public:
+  using element_type    = ElementType;
+  using index_type      = std::size_t;
+  using view_type       = device_matrix_view<ElementType, layout_c_contiguous>;
+  using const_view_type = device_matrix_view<ElementType const, layout_c_contiguous>;
+
+  resizable_device_matrix(index_type n_rows, index_type n_cols, rmm::cuda_stream_view stream)
+    : n_rows_(n_rows), n_cols_(n_cols), c_(n_rows * n_cols, stream)
+  {
+  }
+
+  [[nodiscard]] auto n_rows() const noexcept -> index_type { return n_rows_; }
+  [[nodiscard]] auto n_cols() const noexcept -> index_type { return n_cols_; }
+  [[nodiscard]] auto size() const noexcept -> index_type { return n_rows_ * n_cols_; }
+  /** Number of rows that fit without reallocating. */
+  [[nodiscard]] auto capacity_rows() const noexcept -> index_type
+  {
+    return n_cols_ == 0 ? 0 : c_.capacity() / n_cols_;
+  }
+
+  [[nodiscard]] auto data() noexcept -> element_type* { return c_.data(); }
+  [[nodiscard]] auto data() const noexcept -> element_type const* { return c_.data(); }
+
+  /** Get a mdspan over the current extents that can be passed down to CUDA kernels. */
+  auto view() noexcept { return make_device_matrix_view(c_.data(), n_rows_, n_cols_); }
+  auto view() const noexcept
+  {
+    return make_device_matrix_view<ElementType const>(c_.data(), n_rows_, n_cols_);
+  }
+
+  /**
+   * @brief Ensure capacity for at least the given number of rows.
+   *
+   * Reallocates (and copies the current contents) at most once; unlike
+   * `resize_rows`, the matrix extents do not change. Call this up front when
+   * the final size is known to avoid any intermediate copies.
+   */
+  void reserve_rows(index_type n_rows, rmm::cuda_stream_view stream)
+  {
+    auto needed = n_rows * n_cols_;
+    if (needed > c_.capacity()) { c_.reserve(needed, stream); }
+  }
+
+  /**
+   * @brief Change the number of rows; newly added rows are uninitialized.
+   *
+   * Growth beyond the current capacity reallocates to at least twice the old
+   * capacity, which is what amortizes repeated small appends to O(n) copies.
+   * Shrinking only adjusts the extents and keeps the allocation.
+   */
+  void resize_rows(index_type n_rows, rmm::cuda_stream_view stream)
+  {
+    auto needed = n_rows * n_cols_;
+    if (needed > c_.capacity()) { c_.reserve(std::max(needed, c_.capacity() * 2), stream); }
+    c_.resize(needed, stream);
+    n_rows_ = n_rows;
+  }
+
+  /**
+   * @brief Append rows copied from a device pointer.
+   *
+   * @param[in] src device pointer to a row-major [n_rows, n_cols] block
+   * @param[in] n_rows number of rows to append
+   * @param[in] stream cuda stream for ordering the copy (and any reallocation)
+   */
+  void append_rows(element_type const* src, index_type n_rows, rmm::cuda_stream_view stream)
+  {
+    auto old_rows = n_rows_;
+    resize_rows(old_rows + n_rows, stream);
+    raft::copy(c_.data() + old_rows * n_cols_, src, n_rows * n_cols_, stream);
+  }
+
+  /** Drop the unused capacity, shrinking the allocation to the current size. */
+  void shrink_to_fit(rmm::cuda_stream_view stream) { c_.shrink_to_fit(stream); }
+
+ private:
+  index_type n_rows_;
+  index_type n_cols_;
+  rmm::device_uvector<element_type> c_;
+};
+
+/**
+ * @brief Create a row-growable 2-dim c-contiguous device matrix.
+ *
+ * @tparam ElementType the data type of the matrix elements
+ * @param[in] n_rows initial number of rows (may be 0 for pure ingest)
+ * @param[in] n_cols number of columns, fixed for the matrix lifetime
+ * @param[in] stream cuda stream for ordering events
+ * @return raft::resizable_device_matrix
+ */
+template <typename ElementType>
+auto make_resizable_device_matrix(size_t n_rows, size_t n_cols, rmm::cuda_stream_view stream)
+{
+  return resizable_device_matrix<ElementType>{n_rows, n_cols, stream};
+}
+
+/**
+ * @brief Create a row-growable 2-dim c-contiguous device matrix.
+ *
+ * @tparam ElementType the data type of the matrix elements
+ * @param[in] handle raft handle for managing expensive resources
+ * @param[in] n_rows initial number of rows (may be 0 for pure ingest)
+ * @param[in] n_cols number of columns, fixed for the matrix lifetime
+ * @return raft::resizable_device_matrix
+ */
+template <typename ElementType>
+auto make_resizable_device_matrix(raft::handle_t const& handle, size_t n_rows, size_t n_cols)
+{
+  return make_resizable_device_matrix<ElementType>(n_rows, n_cols, handle.get_stream());
+}
+
+}  // namespace raft
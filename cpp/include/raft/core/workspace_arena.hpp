@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+
+#include <raft/core/error.hpp>
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
+
+namespace raft {
+
+/**
+ * @brief Growable device scratch arena shared across primitive calls.
+ *
+ * Primitives that need temporary device memory can draw stack-ordered
+ * sub-allocations from this arena instead of creating and destroying an
+ * `rmm::device_uvector` per call, which eliminates allocator churn on hot
+ * serving paths. The backing buffer grows geometrically and is retained
+ * between calls; growth only happens while no sub-allocations are
+ * outstanding, otherwise the request is served from a dedicated overflow
+ * buffer so previously handed-out pointers stay valid.
+ *
+ * Sub-allocations must be returned in LIFO order (most easily via
+ * `workspace_chunk`). The arena is protected by a mutex, but the memory
+ * handed out is stream-ordered on the stream passed to `allocate`, so
+ * callers on different streams must use disjoint chunks.
+ */
+class workspace_arena {
+ public:
+  /** Alignment of all sub-allocations handed out by the arena */
+  static constexpr std::size_t alignment = 256;
+
+  workspace_arena()                       = default;
+  workspace_arena(const workspace_arena&) = delete;
+  workspace_arena& operator=(const workspace_arena&) = delete;
+
+  /**
+   * @brief Draw a sub-allocation of at least `bytes` bytes from the arena
+   *
+   * @param[in] bytes  requested size in bytes (zero returns nullptr)
+   * @param[in] stream stream on which the memory will be used; growth of the
+   *                   backing buffer is ordered on this stream
+   */
+  void* allocate(std::size_t bytes, rmm::cuda_stream_view stream)
+  {
+    if (bytes == 0) { return nullptr; }
+    std::lock_guard<std::mutex> _(mutex_);
+    auto aligned = align_up(bytes);
+    if (head_ + aligned > buffer_.size()) {
+      if (head_ == 0) {
+        // no outstanding chunks: safe to grow the backing buffer
+        buffer_.resize(std::max(aligned, 2 * buffer_.size()), stream);
+      } else {
+        // growth would invalidate live chunks; serve from an overflow buffer
+        auto overflow = rmm::device_buffer{aligned, stream};
+        auto* ptr     = overflow.data();
+        overflow_.emplace(ptr, std::move(overflow));
+        return ptr;
+      }
+    }
+    auto* ptr = static_cast<char*>(buffer_.data()) + head_;
+    head_ += aligned;
+    return ptr;
+  }
+
+  /**
+   * @brief Return a sub-allocation previously obtained from `allocate`
+   *
+   * Chunks drawn from the main backing buffer must be returned in LIFO
+   * order.
+   */
+  void deallocate(void* ptr, std::size_t bytes, rmm::cuda_stream_view stream)
+  {
+    if (ptr == nullptr) { return; }
+    std::lock_guard<std::mutex> _(mutex_);
+    auto it = overflow_.find(ptr);
+    if (it != overflow_.end()) {
+      it->second.resize(0, stream);
+      overflow_.erase(it);
+      return;
+    }
+    auto aligned = align_up(bytes);
+    RAFT_EXPECTS(head_ >= aligned && ptr == static_cast<char*>(buffer_.data()) + head_ - aligned,
+                 "workspace_arena: sub-allocations must be returned in LIFO order");
+    head_ -= aligned;
+  }
+
+  /** @brief Current capacity of the retained backing buffer in bytes */
+  std::size_t capacity() const
+  {
+    std::lock_guard<std::mutex> _(mutex_);
+    return buffer_.size();
+  }
+
+  /**
+   * @brief Release the retained backing buffer (stream-ordered)
+   *
+   * Must not be called while sub-allocations are outstanding.
+   */
+  void release(rmm::cuda_stream_view stream)
+  {
+    std::lock_guard<std::mutex> _(mutex_);
+    RAFT_EXPECTS(head_ == 0 && overflow_.empty(),
+                 "workspace_arena: cannot release while chunks are outstanding");
+    buffer_.resize(0, stream);
+    buffer_.shrink_to_fit(stream);
+  }
+
+ private:
+  static std::size_t align_up(std::size_t bytes)
+  {
+    return (bytes + alignment - 1) / alignment * alignment;
+  }
+
+  rmm::device_buffer buffer_{};
+  std::size_t head_{0};
+  std::unordered_map<void*, rmm::device_buffer> overflow_{};
+  mutable std::mutex mutex_;
+};
+
+/**
+ * @brief RAII sub-allocation drawn from a `workspace_arena`
+ *
+ * Typical use inside a primitive:
+ * @code{.cpp}
+ *   auto ws = raft::workspace_chunk(handle.get_workspace_arena(), worksize, stream);
+ *   some_kernel<<<..., stream>>>(..., ws.data(), ...);
+ * @endcode
+ */
+class workspace_chunk {
+ public:
+  workspace_chunk(workspace_arena& arena, std::size_t bytes, rmm::cuda_stream_view stream)
+    : arena_(arena), bytes_(bytes), stream_(stream), data_(arena.allocate(bytes, stream))
+  {
+  }
+  workspace_chunk(const workspace_chunk&) = delete;
+  workspace_chunk& operator=(const workspace_chunk&) = delete;
+
+  ~workspace_chunk() { arena_.deallocate(data_, bytes_, stream_); }
+
+  void* data() const { return data_; }
+  std::size_t size() const { return bytes_; }
+
+ private:
+  workspace_arena& arena_;
+  std::size_t bytes_;
+  rmm::cuda_stream_view stream_;
+  void* data_;
+};
+
+}  // namespace raft
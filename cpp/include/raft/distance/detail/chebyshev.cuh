@@ -63,8 +63,10 @@ static void chebyshevImpl(const DataT* x,
                           FinalLambda fin_op,
                           cudaStream_t stream)
 {
-  typedef typename raft::linalg::Policy4x4<DataT, VecLen>::Policy RowPolicy;
-  typedef typename raft::linalg::Policy4x4<DataT, VecLen>::ColPolicy ColPolicy;
+  // elementwise-heavy metric: use the compute-oriented policy family
+  // instead of the GEMM-shaped default (see `Policy8x4` docs)
+  typedef typename raft::linalg::Policy8x4<DataT, VecLen>::Policy RowPolicy;
+  typedef typename raft::linalg::Policy8x4<DataT, VecLen>::ColPolicy ColPolicy;
 
   typedef typename std::conditional<isRowMajor, RowPolicy, ColPolicy>::type KPolicy;
 
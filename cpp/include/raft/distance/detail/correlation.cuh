@@ -56,10 +56,10 @@ template <typename DataT,
           bool isRowMajor>
 static void correlationImpl(const DataT* x,
                             const DataT* y,
-                            const DataT* xn,
-                            const DataT* yn,
-                            const DataT* x2n,
-                            const DataT* y2n,
+                            const AccT* xn,
+                            const AccT* yn,
+                            const AccT* x2n,
+                            const AccT* y2n,
                             IdxT m,
                             IdxT n,
                             IdxT k,
@@ -83,16 +83,16 @@ static void correlationImpl(const DataT* x,
   // epilogue operation lambda for final value calculation
   auto epilog_lambda = [x2n, y2n, m, n, k] __device__(
                          AccT acc[KPolicy::AccRowsPerTh][KPolicy::AccColsPerTh],
-                         DataT * regxn,
-                         DataT * regyn,
+                         AccT * regxn,
+                         AccT * regyn,
                          IdxT gridStrideX,
                          IdxT gridStrideY) {
-    DataT regx2n[KPolicy::AccRowsPerTh], regy2n[KPolicy::AccColsPerTh];
+    AccT regx2n[KPolicy::AccRowsPerTh], regy2n[KPolicy::AccColsPerTh];
 
     extern __shared__ char smem[];
-    DataT* sx2Norm =
-      (DataT*)(&smem[KPolicy::SmemSize + (KPolicy::Mblk + KPolicy::Nblk) * sizeof(DataT)]);
-    DataT* sy2Norm = (&sx2Norm[KPolicy::Mblk]);
+    AccT* sx2Norm =
+      (AccT*)(&smem[KPolicy::SmemSize + (KPolicy::Mblk + KPolicy::Nblk) * sizeof(AccT)]);
+    AccT* sy2Norm = (&sx2Norm[KPolicy::Mblk]);
 
     // Load x & y norms required by this threadblock in shmem buffer
     if (gridStrideX == blockIdx.x * KPolicy::Nblk) {
@@ -131,7 +131,7 @@ static void correlationImpl(const DataT* x,
   };
 
   constexpr size_t shmemSize =
-    KPolicy::SmemSize + (2 * (KPolicy::Mblk + KPolicy::Nblk) * sizeof(DataT));
+    KPolicy::SmemSize + (2 * (KPolicy::Mblk + KPolicy::Nblk) * sizeof(AccT));
   if (isRowMajor) {
     constexpr auto correlationRowMajor = pairwiseDistanceMatKernel<true,
                                                                    DataT,
@@ -179,10 +179,10 @@ void correlation(IdxT m,
                  IdxT ldd,
                  const DataT* x,
                  const DataT* y,
-                 const DataT* xn,
-                 const DataT* yn,
-                 const DataT* x2n,
-                 const DataT* y2n,
+                 const AccT* xn,
+                 const AccT* yn,
+                 const AccT* x2n,
+                 const AccT* y2n,
                  OutT* dOutput,
                  FinalLambda fin_op,
                  cudaStream_t stream)
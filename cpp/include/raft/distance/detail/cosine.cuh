@@ -18,6 +18,7 @@
 
 #include <raft/distance/detail/pairwise_distance_base.cuh>
 #include <raft/linalg/norm.cuh>
+#include <raft/linalg/reduce.cuh>
 
 namespace raft {
 namespace distance {
@@ -56,11 +57,12 @@ template <typename DataT,
           typename IdxT,
           int VecLen,
           typename FinalLambda,
-          bool isRowMajor>
+          bool isRowMajor,
+          template <typename, int> class PolicyT = raft::linalg::Policy4x4>
 void cosineImpl(const DataT* x,
                 const DataT* y,
-                const DataT* xn,
-                const DataT* yn,
+                const AccT* xn,
+                const AccT* yn,
                 IdxT m,
                 IdxT n,
                 IdxT k,
@@ -71,20 +73,23 @@ void cosineImpl(const DataT* x,
                 FinalLambda fin_op,
                 cudaStream_t stream)
 {
-  typedef typename raft::linalg::Policy4x4<DataT, VecLen>::Policy RowPolicy;
-  typedef typename raft::linalg::Policy4x4<DataT, VecLen>::ColPolicy ColPolicy;
+  typedef typename PolicyT<DataT, VecLen>::Policy RowPolicy;
+  typedef typename PolicyT<DataT, VecLen>::ColPolicy ColPolicy;
 
   typedef typename std::conditional<isRowMajor, RowPolicy, ColPolicy>::type KPolicy;
 
   dim3 blk(KPolicy::Nthreads);
 
-  // Accumulation operation lambda
-  auto core_lambda = [] __device__(AccT & acc, DataT & x, DataT & y) { acc += x * y; };
+  // Accumulation operation lambda. Products are formed in AccT so that
+  // reduced-precision inputs (e.g. half) still accumulate in full precision.
+  auto core_lambda = [] __device__(AccT & acc, DataT & x, DataT & y) {
+    acc += AccT(x) * AccT(y);
+  };
 
   // epilogue operation lambda for final value calculation
   auto epilog_lambda = [] __device__(AccT acc[KPolicy::AccRowsPerTh][KPolicy::AccColsPerTh],
-                                     DataT * regxn,
-                                     DataT * regyn,
+                                     AccT * regxn,
+                                     AccT * regyn,
                                      IdxT gridStrideX,
                                      IdxT gridStrideY) {
 #pragma unroll
@@ -97,7 +102,7 @@ void cosineImpl(const DataT* x,
   };
 
   constexpr size_t shmemSize =
-    KPolicy::SmemSize + ((KPolicy::Mblk + KPolicy::Nblk) * sizeof(DataT));
+    KPolicy::SmemSize + ((KPolicy::Mblk + KPolicy::Nblk) * sizeof(AccT));
   if (isRowMajor) {
     auto cosineRowMajor = pairwiseDistanceMatKernel<true,
                                                     DataT,
@@ -136,7 +141,8 @@ template <typename DataT,
           typename OutT,
           typename IdxT,
           typename FinalLambda,
-          bool isRowMajor>
+          bool isRowMajor,
+          template <typename, int> class PolicyT = raft::linalg::Policy4x4>
 void cosine(IdxT m,
             IdxT n,
             IdxT k,
@@ -145,8 +151,8 @@ void cosine(IdxT m,
             IdxT ldd,
             const DataT* x,
             const DataT* y,
-            const DataT* xn,
-            const DataT* yn,
+            const AccT* xn,
+            const AccT* yn,
             OutT* dOutput,
             FinalLambda fin_op,
             cudaStream_t stream)
@@ -154,13 +160,13 @@ void cosine(IdxT m,
   size_t bytesA = sizeof(DataT) * lda;
   size_t bytesB = sizeof(DataT) * ldb;
   if (16 % sizeof(DataT) == 0 && bytesA % 16 == 0 && bytesB % 16 == 0) {
-    cosineImpl<DataT, AccT, OutT, IdxT, 16 / sizeof(DataT), FinalLambda, isRowMajor>(
+    cosineImpl<DataT, AccT, OutT, IdxT, 16 / sizeof(DataT), FinalLambda, isRowMajor, PolicyT>(
       x, y, xn, yn, m, n, k, lda, ldb, ldd, dOutput, fin_op, stream);
   } else if (8 % sizeof(DataT) == 0 && bytesA % 8 == 0 && bytesB % 8 == 0) {
-    cosineImpl<DataT, AccT, OutT, IdxT, 8 / sizeof(DataT), FinalLambda, isRowMajor>(
+    cosineImpl<DataT, AccT, OutT, IdxT, 8 / sizeof(DataT), FinalLambda, isRowMajor, PolicyT>(
       x, y, xn, yn, m, n, k, lda, ldb, ldd, dOutput, fin_op, stream);
   } else {
-    cosineImpl<DataT, AccT, OutT, IdxT, 1, FinalLambda, isRowMajor>(
+    cosineImpl<DataT, AccT, OutT, IdxT, 1, FinalLambda, isRowMajor, PolicyT>(
       x, y, xn, yn, m, n, k, lda, ldb, ldd, dOutput, fin_op, stream);
   }
 }
@@ -222,24 +228,84 @@ void cosineAlgo1(Index_ m,
   ASSERT(workspace != nullptr, "workspace is null");
 
   Index_ lda, ldb, ldd;
-  InType* col_vec = workspace;
-  InType* row_vec = workspace;
+  // norms are accumulated in AccType so that reduced-precision inputs keep
+  // full-precision norms
+  AccType* col_vec = workspace;
+  AccType* row_vec = workspace;
   if (pA != pB) {
     row_vec += m;
-    raft::linalg::rowNorm(col_vec, pA, k, m, raft::linalg::L2Norm, isRowMajor, stream, norm_op);
-    raft::linalg::rowNorm(row_vec, pB, k, n, raft::linalg::L2Norm, isRowMajor, stream, norm_op);
+    raft::linalg::reduce(col_vec,
+                         pA,
+                         k,
+                         m,
+                         (AccType)0,
+                         isRowMajor,
+                         true,
+                         stream,
+                         false,
+                         raft::L2Op<AccType, Index_>(),
+                         raft::Sum<AccType>(),
+                         norm_op);
+    raft::linalg::reduce(row_vec,
+                         pB,
+                         k,
+                         n,
+                         (AccType)0,
+                         isRowMajor,
+                         true,
+                         stream,
+                         false,
+                         raft::L2Op<AccType, Index_>(),
+                         raft::Sum<AccType>(),
+                         norm_op);
   } else {
-    raft::linalg::rowNorm(col_vec, pA, k, m, raft::linalg::L2Norm, isRowMajor, stream, norm_op);
+    raft::linalg::reduce(col_vec,
+                         pA,
+                         k,
+                         m,
+                         (AccType)0,
+                         isRowMajor,
+                         true,
+                         stream,
+                         false,
+                         raft::L2Op<AccType, Index_>(),
+                         raft::Sum<AccType>(),
+                         norm_op);
   }
 
+  // pick the kernel policy for the current device at runtime; sm80+ has
+  // the shared memory capacity for the deeper k-block tiles
+  bool wide = useWideKernelPolicy();
   if (isRowMajor) {
     lda = k, ldb = k, ldd = n;
-    cosine<InType, AccType, CosOutType, Index_, decltype(wrapped_fin_op), true>(
-      m, n, k, lda, ldb, ldd, pA, pB, col_vec, row_vec, pDcast, wrapped_fin_op, stream);
+    if (wide) {
+      cosine<InType,
+             AccType,
+             CosOutType,
+             Index_,
+             decltype(wrapped_fin_op),
+             true,
+             raft::linalg::Policy4x4Wide>(
+        m, n, k, lda, ldb, ldd, pA, pB, col_vec, row_vec, pDcast, wrapped_fin_op, stream);
+    } else {
+      cosine<InType, AccType, CosOutType, Index_, decltype(wrapped_fin_op), true>(
+        m, n, k, lda, ldb, ldd, pA, pB, col_vec, row_vec, pDcast, wrapped_fin_op, stream);
+    }
   } else {
     lda = n, ldb = m, ldd = m;
-    cosine<InType, AccType, CosOutType, Index_, decltype(wrapped_fin_op), false>(
-      n, m, k, lda, ldb, ldd, pB, pA, row_vec, col_vec, pDcast, wrapped_fin_op, stream);
+    if (wide) {
+      cosine<InType,
+             AccType,
+             CosOutType,
+             Index_,
+             decltype(wrapped_fin_op),
+             false,
+             raft::linalg::Policy4x4Wide>(
+        n, m, k, lda, ldb, ldd, pB, pA, row_vec, col_vec, pDcast, wrapped_fin_op, stream);
+    } else {
+      cosine<InType, AccType, CosOutType, Index_, decltype(wrapped_fin_op), false>(
+        n, m, k, lda, ldb, ldd, pB, pA, row_vec, col_vec, pDcast, wrapped_fin_op, stream);
+    }
   }
 }
 
@@ -23,6 +23,7 @@
 #include <raft/distance/detail/correlation.cuh>
 #include <raft/distance/detail/cosine.cuh>
 #include <raft/distance/detail/euclidean.cuh>
+#include <raft/distance/detail/fixed_dim_distance.cuh>
 #include <raft/distance/detail/hamming.cuh>
 #include <raft/distance/detail/hellinger.cuh>
 #include <raft/distance/detail/jensen_shannon.cuh>
@@ -711,6 +712,139 @@ void pairwise_distance_impl(const Type* x,
   distance<DistType, Type, Type, Type, Index_>(
     x, y, dist, m, n, k, workspace.data(), worksize, stream, isRowMajor, metric_arg);
 }
+
+/** Same as above, but applies a user-supplied epilogue inside the kernel */
+template <typename Type,
+          typename Index_,
+          raft::distance::DistanceType DistType,
+          typename FinalLambda>
+void pairwise_distance_impl(const Type* x,
+                            const Type* y,
+                            Type* dist,
+                            Index_ m,
+                            Index_ n,
+                            Index_ k,
+                            rmm::device_uvector<char>& workspace,
+                            cudaStream_t stream,
+                            bool isRowMajor,
+                            FinalLambda fin_op,
+                            Type metric_arg = 2.0f)
+{
+  auto worksize = getWorkspaceSize<DistType, Type, Type, Type, Index_>(x, y, m, n, k);
+  workspace.resize(worksize, stream);
+  distance<DistType, Type, Type, Type, FinalLambda, Index_>(
+    x, y, dist, m, n, k, workspace.data(), worksize, fin_op, stream, isRowMajor, metric_arg);
+}
+
+/**
+ * @brief Convert a runtime metric into the compile-time dispatch on a caller
+ *        provided stream, applying a fused epilogue. This is shared by the
+ *        single-stream and the tiled multi-stream public entry points.
+ */
+template <typename Type, typename Index_, typename FinalLambda>
+void pairwise_distance_dispatch(const Type* x,
+                                const Type* y,
+                                Type* dist,
+                                Index_ m,
+                                Index_ n,
+                                Index_ k,
+                                rmm::device_uvector<char>& workspace,
+                                raft::distance::DistanceType metric,
+                                cudaStream_t stream,
+                                bool isRowMajor,
+                                FinalLambda fin_op,
+                                Type metric_arg = 2.0f)
+{
+  // common embedding dims get fully unrolled compile-time-dimension kernels
+  // (see fixed_dim_distance.cuh) instead of the runtime-k tiling loop
+  if (fixed_dim_supported<Type>(metric, int(k), isRowMajor)) {
+    fixed_dim_pairwise_distance<Type, Index_>(x, y, dist, m, n, k, metric, fin_op, stream);
+    return;
+  }
+
+  switch (metric) {
+    case raft::distance::DistanceType::L2Expanded:
+      pairwise_distance_impl<Type, Index_, raft::distance::DistanceType::L2Expanded>(
+        x, y, dist, m, n, k, workspace, stream, isRowMajor, fin_op);
+      break;
+    case raft::distance::DistanceType::L2SqrtExpanded:
+      pairwise_distance_impl<Type, Index_, raft::distance::DistanceType::L2SqrtExpanded>(
+        x, y, dist, m, n, k, workspace, stream, isRowMajor, fin_op);
+      break;
+    case raft::distance::DistanceType::CosineExpanded:
+      pairwise_distance_impl<Type, Index_, raft::distance::DistanceType::CosineExpanded>(
+        x, y, dist, m, n, k, workspace, stream, isRowMajor, fin_op);
+      break;
+    case raft::distance::DistanceType::L1:
+      pairwise_distance_impl<Type, Index_, raft::distance::DistanceType::L1>(
+        x, y, dist, m, n, k, workspace, stream, isRowMajor, fin_op);
+      break;
+    case raft::distance::DistanceType::L2Unexpanded:
+      pairwise_distance_impl<Type, Index_, raft::distance::DistanceType::L2Unexpanded>(
+        x, y, dist, m, n, k, workspace, stream, isRowMajor, fin_op);
+      break;
+    case raft::distance::DistanceType::L2SqrtUnexpanded:
+      pairwise_distance_impl<Type, Index_, raft::distance::DistanceType::L2SqrtUnexpanded>(
+        x, y, dist, m, n, k, workspace, stream, isRowMajor, fin_op);
+      break;
+    case raft::distance::DistanceType::Linf:
+      pairwise_distance_impl<Type, Index_, raft::distance::DistanceType::Linf>(
+        x, y, dist, m, n, k, workspace, stream, isRowMajor, fin_op);
+      break;
+    case raft::distance::DistanceType::HellingerExpanded:
+      pairwise_distance_impl<Type, Index_, raft::distance::DistanceType::HellingerExpanded>(
+        x, y, dist, m, n, k, workspace, stream, isRowMajor, fin_op);
+      break;
+    case raft::distance::DistanceType::LpUnexpanded:
+      pairwise_distance_impl<Type, Index_, raft::distance::DistanceType::LpUnexpanded>(
+        x, y, dist, m, n, k, workspace, stream, isRowMajor, fin_op, metric_arg);
+      break;
+    case raft::distance::DistanceType::Canberra:
+      pairwise_distance_impl<Type, Index_, raft::distance::DistanceType::Canberra>(
+        x, y, dist, m, n, k, workspace, stream, isRowMajor, fin_op);
+      break;
+    case raft::distance::DistanceType::HammingUnexpanded:
+      pairwise_distance_impl<Type, Index_, raft::distance::DistanceType::HammingUnexpanded>(
+        x, y, dist, m, n, k, workspace, stream, isRowMajor, fin_op);
+      break;
+    case raft::distance::DistanceType::JensenShannon:
+      pairwise_distance_impl<Type, Index_, raft::distance::DistanceType::JensenShannon>(
+        x, y, dist, m, n, k, workspace, stream, isRowMajor, fin_op);
+      break;
+    case raft::distance::DistanceType::RusselRaoExpanded:
+      pairwise_distance_impl<Type, Index_, raft::distance::DistanceType::RusselRaoExpanded>(
+        x, y, dist, m, n, k, workspace, stream, isRowMajor, fin_op);
+      break;
+    case raft::distance::DistanceType::KLDivergence:
+      pairwise_distance_impl<Type, Index_, raft::distance::DistanceType::KLDivergence>(
+        x, y, dist, m, n, k, workspace, stream, isRowMajor, fin_op);
+      break;
+    case raft::distance::DistanceType::CorrelationExpanded:
+      pairwise_distance_impl<Type, Index_, raft::distance::DistanceType::CorrelationExpanded>(
+        x, y, dist, m, n, k, workspace, stream, isRowMajor, fin_op);
+      break;
+    default: THROW("Unknown or unsupported distance metric '%d'!", (int)metric);
+  };
+}
+
+/** Dispatch without an epilogue: distances are written out unchanged */
+template <typename Type, typename Index_ = int>
+void pairwise_distance_dispatch(const Type* x,
+                                const Type* y,
+                                Type* dist,
+                                Index_ m,
+                                Index_ n,
+                                Index_ k,
+                                rmm::device_uvector<char>& workspace,
+                                raft::distance::DistanceType metric,
+                                cudaStream_t stream,
+                                bool isRowMajor,
+                                Type metric_arg = 2.0f)
+{
+  pairwise_distance_dispatch<Type, Index_>(
+    x, y, dist, m, n, k, workspace, metric, stream, isRowMajor, raft::Nop<Type, Index_>{},
+    metric_arg);
+}
 /** @} */
 };  // namespace detail
 };  // namespace distance
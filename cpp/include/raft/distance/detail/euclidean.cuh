@@ -17,6 +17,7 @@
 #pragma once
 #include <raft/distance/detail/pairwise_distance_base.cuh>
 #include <raft/linalg/norm.cuh>
+#include <raft/linalg/reduce.cuh>
 
 namespace raft {
 namespace distance {
@@ -55,11 +56,12 @@ template <typename DataT,
           typename IdxT,
           int VecLen,
           typename FinalLambda,
-          bool isRowMajor>
+          bool isRowMajor,
+          template <typename, int> class PolicyT = raft::linalg::Policy4x4>
 void euclideanExpImpl(const DataT* x,
                       const DataT* y,
-                      const DataT* xn,
-                      const DataT* yn,
+                      const AccT* xn,
+                      const AccT* yn,
                       IdxT m,
                       IdxT n,
                       IdxT k,
@@ -71,27 +73,30 @@ void euclideanExpImpl(const DataT* x,
                       FinalLambda fin_op,
                       cudaStream_t stream)
 {
-  typedef typename raft::linalg::Policy4x4<DataT, VecLen>::Policy RowPolicy;
-  typedef typename raft::linalg::Policy4x4<DataT, VecLen>::ColPolicy ColPolicy;
+  typedef typename PolicyT<DataT, VecLen>::Policy RowPolicy;
+  typedef typename PolicyT<DataT, VecLen>::ColPolicy ColPolicy;
 
   typedef typename std::conditional<isRowMajor, RowPolicy, ColPolicy>::type KPolicy;
 
   dim3 blk(KPolicy::Nthreads);
 
-  // Accumulation operation lambda
-  auto core_lambda = [] __device__(AccT & acc, DataT & x, DataT & y) { acc += x * y; };
+  // Accumulation operation lambda. Products are formed in AccT so that
+  // reduced-precision inputs (e.g. half) still accumulate in full precision.
+  auto core_lambda = [] __device__(AccT & acc, DataT & x, DataT & y) {
+    acc += AccT(x) * AccT(y);
+  };
 
   // epilogue operation lambda for final value calculation
   auto epilog_lambda = [sqrt] __device__(AccT acc[KPolicy::AccRowsPerTh][KPolicy::AccColsPerTh],
-                                         DataT * regxn,
-                                         DataT * regyn,
+                                         AccT * regxn,
+                                         AccT * regyn,
                                          IdxT gridStrideX,
                                          IdxT gridStrideY) {
 #pragma unroll
     for (int i = 0; i < KPolicy::AccRowsPerTh; ++i) {
 #pragma unroll
       for (int j = 0; j < KPolicy::AccColsPerTh; ++j) {
-        acc[i][j] = regxn[i] + regyn[j] - (DataT)2.0 * acc[i][j];
+        acc[i][j] = regxn[i] + regyn[j] - (AccT)2.0 * acc[i][j];
       }
     }
     if (sqrt) {
@@ -106,7 +111,7 @@ void euclideanExpImpl(const DataT* x,
   };
 
   constexpr size_t shmemSize =
-    KPolicy::SmemSize + ((KPolicy::Mblk + KPolicy::Nblk) * sizeof(DataT));
+    KPolicy::SmemSize + ((KPolicy::Mblk + KPolicy::Nblk) * sizeof(AccT));
   if (isRowMajor) {
     auto euclideanExpRowMajor = pairwiseDistanceMatKernel<true,
                                                           DataT,
@@ -146,7 +151,8 @@ template <typename DataT,
           typename OutT,
           typename IdxT,
           typename FinalLambda,
-          bool isRowMajor>
+          bool isRowMajor,
+          template <typename, int> class PolicyT = raft::linalg::Policy4x4>
 void euclideanExp(IdxT m,
                   IdxT n,
                   IdxT k,
@@ -155,8 +161,8 @@ void euclideanExp(IdxT m,
                   IdxT ldd,
                   const DataT* x,
                   const DataT* y,
-                  const DataT* xn,
-                  const DataT* yn,
+                  const AccT* xn,
+                  const AccT* yn,
                   bool sqrt,
                   OutT* dOutput,
                   FinalLambda fin_op,
@@ -165,13 +171,13 @@ void euclideanExp(IdxT m,
   size_t bytesA = sizeof(DataT) * lda;
   size_t bytesB = sizeof(DataT) * ldb;
   if (16 % sizeof(DataT) == 0 && bytesA % 16 == 0 && bytesB % 16 == 0) {
-    euclideanExpImpl<DataT, AccT, OutT, IdxT, 16 / sizeof(DataT), FinalLambda, isRowMajor>(
+    euclideanExpImpl<DataT, AccT, OutT, IdxT, 16 / sizeof(DataT), FinalLambda, isRowMajor, PolicyT>(
       x, y, xn, yn, m, n, k, lda, ldb, ldd, sqrt, dOutput, fin_op, stream);
   } else if (8 % sizeof(DataT) == 0 && bytesA % 8 == 0 && bytesB % 8 == 0) {
-    euclideanExpImpl<DataT, AccT, OutT, IdxT, 8 / sizeof(DataT), FinalLambda, isRowMajor>(
+    euclideanExpImpl<DataT, AccT, OutT, IdxT, 8 / sizeof(DataT), FinalLambda, isRowMajor, PolicyT>(
       x, y, xn, yn, m, n, k, lda, ldb, ldd, sqrt, dOutput, fin_op, stream);
   } else {
-    euclideanExpImpl<DataT, AccT, OutT, IdxT, 1, FinalLambda, isRowMajor>(
+    euclideanExpImpl<DataT, AccT, OutT, IdxT, 1, FinalLambda, isRowMajor, PolicyT>(
       x, y, xn, yn, m, n, k, lda, ldb, ldd, sqrt, dOutput, fin_op, stream);
   }
 }
@@ -215,8 +221,6 @@ void euclideanAlgo1(Index_ m,
                     cudaStream_t stream,
                     bool isRowMajor)
 {
-  auto norm_op = [] __device__(InType in) { return in; };
-
   typedef std::is_same<OutType, bool> is_bool;
   typedef typename std::conditional<is_bool::value, OutType, AccType>::type ExpOutType;
   ExpOutType* pDcast = reinterpret_cast<ExpOutType*>(pD);
@@ -227,24 +231,78 @@ void euclideanAlgo1(Index_ m,
   ASSERT(workspace != nullptr, "workspace is null");
 
   Index_ lda, ldb, ldd;
-  InType* col_vec = workspace;
-  InType* row_vec = workspace;
+  // norms are accumulated in AccType so that reduced-precision inputs keep
+  // full-precision norms
+  AccType* col_vec = workspace;
+  AccType* row_vec = workspace;
   if (pA != pB) {
     row_vec += m;
-    raft::linalg::rowNorm(col_vec, pA, k, m, raft::linalg::L2Norm, isRowMajor, stream, norm_op);
-    raft::linalg::rowNorm(row_vec, pB, k, n, raft::linalg::L2Norm, isRowMajor, stream, norm_op);
+    raft::linalg::reduce(col_vec,
+                         pA,
+                         k,
+                         m,
+                         (AccType)0,
+                         isRowMajor,
+                         true,
+                         stream,
+                         false,
+                         raft::L2Op<AccType, Index_>());
+    raft::linalg::reduce(row_vec,
+                         pB,
+                         k,
+                         n,
+                         (AccType)0,
+                         isRowMajor,
+                         true,
+                         stream,
+                         false,
+                         raft::L2Op<AccType, Index_>());
   } else {
-    raft::linalg::rowNorm(col_vec, pA, k, m, raft::linalg::L2Norm, isRowMajor, stream, norm_op);
+    raft::linalg::reduce(col_vec,
+                         pA,
+                         k,
+                         m,
+                         (AccType)0,
+                         isRowMajor,
+                         true,
+                         stream,
+                         false,
+                         raft::L2Op<AccType, Index_>());
   }
 
+  // pick the kernel policy for the current device at runtime; sm80+ has
+  // the shared memory capacity for the deeper k-block tiles
+  bool wide = useWideKernelPolicy();
   if (isRowMajor) {
     lda = k, ldb = k, ldd = n;
-    euclideanExp<InType, AccType, ExpOutType, Index_, FinalLambda, true>(
-      m, n, k, lda, ldb, ldd, pA, pB, col_vec, row_vec, enable_sqrt, pDcast, fin_op, stream);
+    if (wide) {
+      euclideanExp<InType,
+                   AccType,
+                   ExpOutType,
+                   Index_,
+                   FinalLambda,
+                   true,
+                   raft::linalg::Policy4x4Wide>(
+        m, n, k, lda, ldb, ldd, pA, pB, col_vec, row_vec, enable_sqrt, pDcast, fin_op, stream);
+    } else {
+      euclideanExp<InType, AccType, ExpOutType, Index_, FinalLambda, true>(
+        m, n, k, lda, ldb, ldd, pA, pB, col_vec, row_vec, enable_sqrt, pDcast, fin_op, stream);
+    }
   } else {
     lda = n, ldb = m, ldd = m;
-    euclideanExp<InType, AccType, ExpOutType, Index_, FinalLambda, false>(
-      n, m, k, lda, ldb, ldd, pB, pA, row_vec, col_vec, enable_sqrt, pDcast, fin_op, stream);
+    if (wide) {
+      euclideanExp<InType,
+                   AccType,
+                   ExpOutType,
+                   Index_,
+                   FinalLambda,
+                   false,
+                   raft::linalg::Policy4x4Wide>(
+        n, m, k, lda, ldb, ldd, pB, pA, row_vec, col_vec, enable_sqrt, pDcast, fin_op, stream);
+    } else {
+      euclideanExp<InType, AccType, ExpOutType, Index_, FinalLambda, false>(
+        n, m, k, lda, ldb, ldd, pB, pA, row_vec, col_vec, enable_sqrt, pDcast, fin_op, stream);
+    }
   }
 }
 
@@ -275,7 +333,8 @@ template <typename DataT,
           typename IdxT,
           int VecLen,
           typename FinalLambda,
-          bool isRowMajor>
+          bool isRowMajor,
+          template <typename, int> class PolicyT = raft::linalg::Policy4x4>
 void euclideanUnExpImpl(const DataT* x,
                         const DataT* y,
                         IdxT m,
@@ -289,8 +348,8 @@ void euclideanUnExpImpl(const DataT* x,
                         FinalLambda fin_op,
                         cudaStream_t stream)
 {
-  typedef typename raft::linalg::Policy4x4<DataT, VecLen>::Policy RowPolicy;
-  typedef typename raft::linalg::Policy4x4<DataT, VecLen>::ColPolicy ColPolicy;
+  typedef typename PolicyT<DataT, VecLen>::Policy RowPolicy;
+  typedef typename PolicyT<DataT, VecLen>::ColPolicy ColPolicy;
 
   typedef typename std::conditional<isRowMajor, RowPolicy, ColPolicy>::type KPolicy;
 
@@ -360,7 +419,8 @@ template <typename DataT,
           typename OutT,
           typename IdxT,
           typename FinalLambda,
-          bool isRowMajor>
+          bool isRowMajor,
+          template <typename, int> class PolicyT = raft::linalg::Policy4x4>
 void euclideanUnExp(IdxT m,
                     IdxT n,
                     IdxT k,
@@ -377,13 +437,13 @@ void euclideanUnExp(IdxT m,
   size_t bytesA = sizeof(DataT) * lda;
   size_t bytesB = sizeof(DataT) * ldb;
   if (16 % sizeof(DataT) == 0 && bytesA % 16 == 0 && bytesB % 16 == 0) {
-    euclideanUnExpImpl<DataT, AccT, OutT, IdxT, 16 / sizeof(DataT), FinalLambda, isRowMajor>(
+    euclideanUnExpImpl<DataT, AccT, OutT, IdxT, 16 / sizeof(DataT), FinalLambda, isRowMajor, PolicyT>(
       x, y, m, n, k, lda, ldb, ldd, sqrt, dOutput, fin_op, stream);
   } else if (8 % sizeof(DataT) == 0 && bytesA % 8 == 0 && bytesB % 8 == 0) {
-    euclideanUnExpImpl<DataT, AccT, OutT, IdxT, 8 / sizeof(DataT), FinalLambda, isRowMajor>(
+    euclideanUnExpImpl<DataT, AccT, OutT, IdxT, 8 / sizeof(DataT), FinalLambda, isRowMajor, PolicyT>(
       x, y, m, n, k, lda, ldb, ldd, sqrt, dOutput, fin_op, stream);
   } else {
-    euclideanUnExpImpl<DataT, AccT, OutT, IdxT, 1, FinalLambda, isRowMajor>(
+    euclideanUnExpImpl<DataT, AccT, OutT, IdxT, 1, FinalLambda, isRowMajor, PolicyT>(
       x, y, m, n, k, lda, ldb, ldd, sqrt, dOutput, fin_op, stream);
   }
 }
@@ -428,14 +488,39 @@ void euclideanAlgo2(Index_ m,
   UnExpOutType* pDcast = reinterpret_cast<UnExpOutType*>(pD);
   Index_ lda, ldb, ldd;
 
+  // pick the kernel policy for the current device at runtime; sm80+ has
+  // the shared memory capacity for the deeper k-block tiles
+  bool wide = useWideKernelPolicy();
   if (isRowMajor) {
     lda = k, ldb = k, ldd = n;
-    euclideanUnExp<InType, AccType, UnExpOutType, Index_, FinalLambda, true>(
-      m, n, k, lda, ldb, ldd, pA, pB, enable_sqrt, pDcast, fin_op, stream);
+    if (wide) {
+      euclideanUnExp<InType,
+                     AccType,
+                     UnExpOutType,
+                     Index_,
+                     FinalLambda,
+                     true,
+                     raft::linalg::Policy4x4Wide>(
+        m, n, k, lda, ldb, ldd, pA, pB, enable_sqrt, pDcast, fin_op, stream);
+    } else {
+      euclideanUnExp<InType, AccType, UnExpOutType, Index_, FinalLambda, true>(
+        m, n, k, lda, ldb, ldd, pA, pB, enable_sqrt, pDcast, fin_op, stream);
+    }
   } else {
     lda = n, ldb = m, ldd = m;
-    euclideanUnExp<InType, AccType, UnExpOutType, Index_, FinalLambda, false>(
-      n, m, k, lda, ldb, ldd, pB, pA, enable_sqrt, pDcast, fin_op, stream);
+    if (wide) {
+      euclideanUnExp<InType,
+                     AccType,
+                     UnExpOutType,
+                     Index_,
+                     FinalLambda,
+                     false,
+                     raft::linalg::Policy4x4Wide>(
+        n, m, k, lda, ldb, ldd, pB, pA, enable_sqrt, pDcast, fin_op, stream);
+    } else {
+      euclideanUnExp<InType, AccType, UnExpOutType, Index_, FinalLambda, false>(
+        n, m, k, lda, ldb, ldd, pB, pA, enable_sqrt, pDcast, fin_op, stream);
+    }
   }
 }
 
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/cuda_utils.cuh>
+#include <raft/cudart_utils.h>
+#include <raft/distance/distance_type.hpp>
+
+namespace raft {
+namespace distance {
+namespace detail {
+
+/**
+ * Fixed-dimension L2 distance kernels.
+ *
+ * Embedding-serving workloads use a handful of dimensionalities (64, 96, 128,
+ * 256) exclusively; fixing the dimension at compile time lets the inner loop
+ * fully unroll and drops all runtime-k bookkeeping, the same trick the
+ * ball-cover 2d/3d specializations use. The kernel tiles the output: each
+ * block stages a tile of x rows and y rows in shared memory and each thread
+ * accumulates one output element over the whole (compile-time) dimension.
+ */
+
+// x/y tile rows held per block; one thread per output element of the tile
+constexpr int kFixedDimTileM = 16;
+constexpr int kFixedDimTileN = 16;
+
+/** dims the prebuilt instantiations cover; keep in sync with the dispatch below */
+constexpr bool fixed_dim_prebuilt(int k) { return k == 64 || k == 96 || k == 128 || k == 256; }
+
+constexpr bool fixed_dim_metric_supported(raft::distance::DistanceType metric)
+{
+  return metric == raft::distance::DistanceType::L2Expanded ||
+         metric == raft::distance::DistanceType::L2SqrtExpanded ||
+         metric == raft::distance::DistanceType::L2Unexpanded ||
+         metric == raft::distance::DistanceType::L2SqrtUnexpanded;
+}
+
+template <typename DataT>
+constexpr bool fixed_dim_tile_fits(int k)
+{
+  // +1 is the bank-conflict padding of the tile rows (see the kernel)
+  return std::size_t(kFixedDimTileM + kFixedDimTileN) * (k + 1) * sizeof(DataT) <= 48u * 1024u;
+}
+
+/**
+ * Whether the fixed-dimension fast path applies: row-major L2-family
+ * distances at one of the prebuilt dims whose shared memory tile fits the
+ * static 48 KB limit (which excludes the double tile at dim 256).
+ */
+template <typename DataT>
+constexpr bool fixed_dim_supported(raft::distance::DistanceType metric, int k, bool isRowMajor)
+{
+  return isRowMajor && fixed_dim_metric_supported(metric) && fixed_dim_prebuilt(k) &&
+         fixed_dim_tile_fits<DataT>(k);
+}
+
+template <typename DataT, typename IdxT, int Dim, bool Sqrt, typename FinalLambda>
+__global__ void __launch_bounds__(kFixedDimTileM* kFixedDimTileN)
+  fixed_dim_l2_kernel(const DataT* x, const DataT* y, DataT* dist, IdxT m, IdxT n, FinalLambda fin_op)
+{
+  // +1 padding breaks the power-of-two row stride so the unrolled inner loop
+  // does not serialize on shared memory bank conflicts
+  constexpr int kLd  = Dim + 1;
+  constexpr int kTpb = kFixedDimTileM * kFixedDimTileN;
+  __shared__ DataT sx[kFixedDimTileM * kLd];
+  __shared__ DataT sy[kFixedDimTileN * kLd];
+
+  const IdxT row0 = IdxT(blockIdx.x) * kFixedDimTileM;
+  const IdxT col0 = IdxT(blockIdx.y) * kFixedDimTileN;
+  const int tid   = threadIdx.x;
+
+  // cooperative, coalesced tile loads; rows past the end are zero-filled so
+  // the compute loop stays branch-free
+  for (int e = tid; e < kFixedDimTileM * Dim; e += kTpb) {
+    const int r     = e / Dim;
+    const int c     = e % Dim;
+    sx[r * kLd + c] = (row0 + r < m) ? x[(row0 + r) * IdxT(Dim) + c] : DataT{0};
+  }
+  for (int e = tid; e < kFixedDimTileN * Dim; e += kTpb) {
+    const int r     = e / Dim;
+    const int c     = e % Dim;
+    sy[r * kLd + c] = (col0 + r < n) ? y[(col0 + r) * IdxT(Dim) + c] : DataT{0};
+  }
+  __syncthreads();
+
+  const int tx   = tid % kFixedDimTileM;
+  const int ty   = tid / kFixedDimTileM;
+  const IdxT row = row0 + tx;
+  const IdxT col = col0 + ty;
+  if (row >= m || col >= n) { return; }
+
+  DataT acc = DataT{0};
+#pragma unroll
+  for (int j = 0; j < Dim; j++) {
+    const DataT diff = sx[tx * kLd + j] - sy[ty * kLd + j];
+    acc += diff * diff;
+  }
+  if (Sqrt) { acc = raft::mySqrt(acc); }
+  const IdxT g_idx = row * n + col;
+  dist[g_idx]      = fin_op(acc, g_idx);
+}
+
+template <typename DataT, typename IdxT, int Dim, typename FinalLambda>
+void fixed_dim_l2(const DataT* x,
+                  const DataT* y,
+                  DataT* dist,
+                  IdxT m,
+                  IdxT n,
+                  bool sqrt,
+                  FinalLambda fin_op,
+                  cudaStream_t stream)
+{
+  // the tile-too-large combinations must not be instantiated at all: a static
+  // shared memory block past the limit is a compile error, not a launch error
+  if constexpr (fixed_dim_tile_fits<DataT>(Dim)) {
+    dim3 grid(raft::ceildiv<IdxT>(m, kFixedDimTileM), raft::ceildiv<IdxT>(n, kFixedDimTileN));
+    dim3 block(kFixedDimTileM * kFixedDimTileN);
+    if (sqrt) {
+      fixed_dim_l2_kernel<DataT, IdxT, Dim, true>
+        <<<grid, block, 0, stream>>>(x, y, dist, m, n, fin_op);
+    } else {
+      fixed_dim_l2_kernel<DataT, IdxT, Dim, false>
+        <<<grid, block, 0, stream>>>(x, y, dist, m, n, fin_op);
+    }
+    RAFT_CUDA_TRY(cudaPeekAtLastError());
+  } else {
+    THROW("fixed-dim tile (dim = %d) exceeds the static shared memory limit", Dim);
+  }
+}
+
+/**
+ * Dispatch a runtime dimension onto the prebuilt compile-time kernels. Call
+ * only when `fixed_dim_supported` returned true for the same arguments.
+ */
+template <typename DataT, typename IdxT, typename FinalLambda>
+void fixed_dim_pairwise_distance(const DataT* x,
+                                 const DataT* y,
+                                 DataT* dist,
+                                 IdxT m,
+                                 IdxT n,
+                                 IdxT k,
+                                 raft::distance::DistanceType metric,
+                                 FinalLambda fin_op,
+                                 cudaStream_t stream)
+{
+  const bool sqrt = metric == raft::distance::DistanceType::L2SqrtExpanded ||
+                    metric == raft::distance::DistanceType::L2SqrtUnexpanded;
+  switch (int(k)) {
+    case 64: fixed_dim_l2<DataT, IdxT, 64>(x, y, dist, m, n, sqrt, fin_op, stream); break;
+    case 96: fixed_dim_l2<DataT, IdxT, 96>(x, y, dist, m, n, sqrt, fin_op, stream); break;
+    case 128: fixed_dim_l2<DataT, IdxT, 128>(x, y, dist, m, n, sqrt, fin_op, stream); break;
+    case 256: fixed_dim_l2<DataT, IdxT, 256>(x, y, dist, m, n, sqrt, fin_op, stream); break;
+    default: THROW("No fixed-dim specialization prebuilt for dim = %d", int(k));
+  }
+}
+
+}  // namespace detail
+}  // namespace distance
+}  // namespace raft
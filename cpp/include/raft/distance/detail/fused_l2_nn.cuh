@@ -331,6 +331,285 @@ void fusedL2NNImpl(OutT* min,
   RAFT_CUDA_TRY(cudaGetLastError());
 }
 
+// Insert a candidate into a register-resident list of the MaxK best
+// (ascending by value) pairs, via a swap chain the compiler can fully
+// unroll. Keys are assumed unique across candidates for a given row.
+template <int MaxK, typename KVPair>
+DI void insertTopK(KVPair (&list)[MaxK], KVPair other)
+{
+  if (!(other.value < list[MaxK - 1].value)) return;
+#pragma unroll
+  for (int i = 0; i < MaxK; ++i) {
+    if (other.value < list[i].value) {
+      KVPair tmp = list[i];
+      list[i]    = other;
+      other      = tmp;
+    }
+  }
+}
+
+template <int MaxK, typename P, typename IdxT, typename KVPair>
+DI void updateReducedTopK(
+  int* mutex, KVPair* min, KVPair (*val)[MaxK], IdxT m, IdxT gridStrideY)
+{
+  const auto lid      = threadIdx.x % raft::WarpSize;
+  const auto accrowid = threadIdx.x / P::AccThCols;
+
+  // as in updateReducedVal, only the first lane of each warp touches the
+  // output; the remaining sub-rows are rotated into it via shuffles
+#pragma unroll
+  for (int j = 0; j < (raft::WarpSize / P::AccThCols); j++) {
+    if (lid == 0) {
+#pragma unroll
+      for (int i = 0; i < P::AccRowsPerTh; ++i) {
+        auto rid = gridStrideY + accrowid + j + i * P::AccThRows;
+        if (rid < m) {
+          while (atomicCAS(mutex + rid, 0, 1) == 1)
+            ;
+          __threadfence();
+          KVPair cur[MaxK];
+#pragma unroll
+          for (int t = 0; t < MaxK; ++t) {
+            cur[t] = min[rid * MaxK + t];
+          }
+#pragma unroll
+          for (int t = 0; t < MaxK; ++t) {
+            insertTopK<MaxK>(cur, val[i][t]);
+          }
+#pragma unroll
+          for (int t = 0; t < MaxK; ++t) {
+            min[rid * MaxK + t] = cur[t];
+          }
+          __threadfence();
+          atomicCAS(mutex + rid, 1, 0);
+        }
+      }
+    }
+    if (j < (raft::WarpSize / P::AccThCols) - 1) {
+#pragma unroll
+      for (int i = 0; i < P::AccRowsPerTh; ++i) {
+#pragma unroll
+        for (int t = 0; t < MaxK; ++t) {
+          auto tmpkey   = raft::shfl(val[i][t].key, (j + 1) * P::AccThCols);
+          auto tmpvalue = raft::shfl(val[i][t].value, (j + 1) * P::AccThCols);
+          val[i][t]     = {tmpkey, tmpvalue};
+        }
+      }
+    }
+  }
+}
+
+template <typename DataT,
+          typename IdxT,
+          bool Sqrt,
+          typename P,
+          int MaxK,
+          typename CoreLambda,
+          typename FinalLambda>
+__global__ __launch_bounds__(P::Nthreads, 2) void fusedL2KnnSmallKkernel(
+  cub::KeyValuePair<IdxT, DataT>* min,
+  const DataT* x,
+  const DataT* y,
+  const DataT* xn,
+  const DataT* yn,
+  IdxT m,
+  IdxT n,
+  IdxT k,
+  DataT maxVal,
+  int* mutex,
+  CoreLambda core_op,
+  FinalLambda fin_op)
+{
+  extern __shared__ char smem[];
+
+  typedef cub::KeyValuePair<IdxT, DataT> KVPair;
+  KVPair val[P::AccRowsPerTh][MaxK];
+#pragma unroll
+  for (int i = 0; i < P::AccRowsPerTh; ++i) {
+#pragma unroll
+    for (int t = 0; t < MaxK; ++t) {
+      val[i][t] = {-1, maxVal};
+    }
+  }
+
+  // epilogue operation lambda for final value calculation
+  auto epilog_lambda = [n, &val] __device__(DataT acc[P::AccRowsPerTh][P::AccColsPerTh],
+                                            DataT * regxn,
+                                            DataT * regyn,
+                                            IdxT gridStrideX,
+                                            IdxT gridStrideY) {
+#pragma unroll
+    for (int i = 0; i < P::AccRowsPerTh; ++i) {
+#pragma unroll
+      for (int j = 0; j < P::AccColsPerTh; ++j) {
+        acc[i][j] = regxn[i] + regyn[j] - (DataT)2.0 * acc[i][j];
+      }
+    }
+    if (Sqrt) {
+#pragma unroll
+      for (int i = 0; i < P::AccRowsPerTh; ++i) {
+#pragma unroll
+        for (int j = 0; j < P::AccColsPerTh; ++j) {
+          acc[i][j] = raft::mySqrt(acc[i][j]);
+        }
+      }
+    }
+
+    // intra thread reduce: keep the MaxK best in registers
+    const auto acccolid = threadIdx.x % P::AccThCols;
+#pragma unroll
+    for (int i = 0; i < P::AccRowsPerTh; ++i) {
+#pragma unroll
+      for (int j = 0; j < P::AccColsPerTh; ++j) {
+        auto tmpkey = acccolid + j * P::AccThCols + gridStrideX;
+        KVPair tmp  = {tmpkey, acc[i][j]};
+        if (tmpkey < n) { insertTopK<MaxK>(val[i], tmp); }
+      }
+    }
+  };
+
+  auto rowEpilog_lambda = [m, mutex, min, &val, maxVal] __device__(IdxT gridStrideY) {
+    const auto lid = raft::laneId();
+
+  // merge lists across the lanes covering the same output rows
+#pragma unroll
+    for (int i = 0; i < P::AccRowsPerTh; ++i) {
+#pragma unroll
+      for (int j = P::AccThCols / 2; j > 0; j >>= 1) {
+#pragma unroll
+        for (int t = 0; t < MaxK; ++t) {
+          auto tmpkey   = raft::shfl(val[i][t].key, lid + j);
+          auto tmpvalue = raft::shfl(val[i][t].value, lid + j);
+          KVPair tmp    = {tmpkey, tmpvalue};
+          insertTopK<MaxK>(val[i], tmp);
+        }
+      }
+    }
+
+    updateReducedTopK<MaxK, P, IdxT, KVPair>(mutex, min, val, m, gridStrideY);
+
+  // reset the val array.
+#pragma unroll
+    for (int i = 0; i < P::AccRowsPerTh; ++i) {
+#pragma unroll
+      for (int t = 0; t < MaxK; ++t) {
+        val[i][t] = {-1, maxVal};
+      }
+    }
+  };
+
+  IdxT lda = k, ldb = k, ldd = n;
+  PairwiseDistances<true,
+                    DataT,
+                    DataT,
+                    DataT,
+                    IdxT,
+                    P,
+                    CoreLambda,
+                    decltype(epilog_lambda),
+                    FinalLambda,
+                    decltype(rowEpilog_lambda),
+                    true,
+                    false>
+    obj(x,
+        y,
+        m,
+        n,
+        k,
+        lda,
+        ldb,
+        ldd,
+        xn,
+        yn,
+        nullptr,
+        smem,
+        core_op,
+        epilog_lambda,
+        fin_op,
+        rowEpilog_lambda);
+  obj.run();
+}
+
+template <typename DataT, typename IdxT, int VecLen, int MaxK>
+void fusedL2KnnSmallKImpl(cub::KeyValuePair<IdxT, DataT>* min,
+                          const DataT* x,
+                          const DataT* y,
+                          const DataT* xn,
+                          const DataT* yn,
+                          IdxT m,
+                          IdxT n,
+                          IdxT k,
+                          int* workspace,
+                          bool sqrt,
+                          bool initOutBuffer,
+                          cudaStream_t stream)
+{
+  typedef typename linalg::Policy4x4<DataT, VecLen>::Policy P;
+
+  dim3 blk(P::Nthreads);
+  constexpr auto maxVal = std::numeric_limits<DataT>::max();
+  typedef cub::KeyValuePair<IdxT, DataT> KVPair;
+
+  // Accumulation operation lambda
+  auto core_lambda = [] __device__(DataT & acc, DataT & x, DataT & y) { acc += x * y; };
+
+  RAFT_CUDA_TRY(cudaMemsetAsync(workspace, 0, sizeof(int) * m, stream));
+  if (initOutBuffer) {
+    MinAndDistanceReduceOpImpl<IdxT, DataT> redOp;
+    auto nblks = raft::ceildiv<IdxT>(m * MaxK, P::Nthreads);
+    initKernel<DataT, KVPair, IdxT>
+      <<<nblks, P::Nthreads, 0, stream>>>(min, m * MaxK, maxVal, redOp);
+    RAFT_CUDA_TRY(cudaGetLastError());
+  }
+
+  auto fin_op = [] __device__(DataT d_val, int g_d_idx) { return d_val; };
+
+  constexpr size_t shmemSize = P::SmemSize + ((P::Mblk + P::Nblk) * sizeof(DataT));
+  if (sqrt) {
+    auto fusedL2KnnSqrt =
+      fusedL2KnnSmallKkernel<DataT, IdxT, true, P, MaxK, decltype(core_lambda), decltype(fin_op)>;
+    dim3 grid = launchConfigGenerator<P>(m, n, shmemSize, fusedL2KnnSqrt);
+
+    fusedL2KnnSqrt<<<grid, blk, shmemSize, stream>>>(
+      min, x, y, xn, yn, m, n, k, maxVal, workspace, core_lambda, fin_op);
+  } else {
+    auto fusedL2Knn =
+      fusedL2KnnSmallKkernel<DataT, IdxT, false, P, MaxK, decltype(core_lambda), decltype(fin_op)>;
+    dim3 grid = launchConfigGenerator<P>(m, n, shmemSize, fusedL2Knn);
+    fusedL2Knn<<<grid, blk, shmemSize, stream>>>(
+      min, x, y, xn, yn, m, n, k, maxVal, workspace, core_lambda, fin_op);
+  }
+
+  RAFT_CUDA_TRY(cudaGetLastError());
+}
+
+template <typename DataT, typename IdxT, int MaxK>
+void fusedL2KnnSmallKDispatch(cub::KeyValuePair<IdxT, DataT>* min,
+                              const DataT* x,
+                              const DataT* y,
+                              const DataT* xn,
+                              const DataT* yn,
+                              IdxT m,
+                              IdxT n,
+                              IdxT k,
+                              int* workspace,
+                              bool sqrt,
+                              bool initOutBuffer,
+                              cudaStream_t stream)
+{
+  size_t bytes = sizeof(DataT) * k;
+  if (16 % sizeof(DataT) == 0 && bytes % 16 == 0) {
+    fusedL2KnnSmallKImpl<DataT, IdxT, 16 / sizeof(DataT), MaxK>(
+      min, x, y, xn, yn, m, n, k, workspace, sqrt, initOutBuffer, stream);
+  } else if (8 % sizeof(DataT) == 0 && bytes % 8 == 0) {
+    fusedL2KnnSmallKImpl<DataT, IdxT, 8 / sizeof(DataT), MaxK>(
+      min, x, y, xn, yn, m, n, k, workspace, sqrt, initOutBuffer, stream);
+  } else {
+    fusedL2KnnSmallKImpl<DataT, IdxT, 1, MaxK>(
+      min, x, y, xn, yn, m, n, k, workspace, sqrt, initOutBuffer, stream);
+  }
+}
+
 }  // namespace detail
 }  // namespace distance
 }  // namespace raft
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/core/cublas_macros.hpp>
+#include <raft/cuda_utils.cuh>
+#include <raft/distance/distance_type.hpp>
+#include <raft/handle.hpp>
+#include <raft/linalg/gemm.hpp>
+#include <raft/linalg/norm.cuh>
+
+#include <rmm/device_uvector.hpp>
+
+#include <type_traits>
+
+namespace raft {
+namespace distance {
+namespace detail {
+
+/** epilogue functor turning a dot product into an expanded L2 distance */
+template <typename AccT>
+struct l2_exp_gemm_epilogue {
+  bool sqrt;
+
+  DI AccT operator()(AccT dot, AccT xn, AccT yn) const
+  {
+    AccT val = xn + yn - (AccT)2.0 * dot;
+    // round-off can drive distances of near-identical rows slightly negative
+    val = val > AccT{0} ? val : AccT{0};
+    return sqrt ? raft::mySqrt(val) : val;
+  }
+};
+
+/** epilogue functor turning a dot product into a cosine distance */
+template <typename AccT>
+struct cosine_gemm_epilogue {
+  DI AccT operator()(AccT dot, AccT xn, AccT yn) const { return (AccT)1.0 - dot / (xn * yn); }
+};
+
+/**
+ * Applies the norm-based epilogue to a matrix of dot products in-place.
+ * One pass over the m*n output, so the GEMM stays a pure cublas call that can
+ * run on the tensor cores.
+ */
+template <typename AccT, typename OutT, typename IdxT, typename EpilogueOp, typename FinalLambda>
+__global__ void gemmDistanceEpilogueKernel(OutT* dist,
+                                           const AccT* xn,
+                                           const AccT* yn,
+                                           IdxT m,
+                                           IdxT n,
+                                           bool isRowMajor,
+                                           EpilogueOp op,
+                                           FinalLambda fin_op)
+{
+  const IdxT total  = m * n;
+  const IdxT stride = blockDim.x * gridDim.x;
+  for (IdxT idx = blockIdx.x * blockDim.x + threadIdx.x; idx < total; idx += stride) {
+    const IdxT i = isRowMajor ? idx / n : idx % m;
+    const IdxT j = isRowMajor ? idx % n : idx / m;
+    dist[idx]    = fin_op(op((AccT)dist[idx], xn[i], yn[j]), idx);
+  }
+}
+
+/**
+ * @brief GEMM-based expanded distance calculation
+ *
+ * Computes the dot-product phase of the expanded L2 / cosine distances with a
+ * single cublas GEMM directly into the output buffer and then applies the
+ * norm epilogue in one elementwise pass. Unlike the fused tiled kernels the
+ * GEMM can be routed through the tensor cores (TF32 on Ampere and newer for
+ * fp32 inputs), which is where the bulk of the flops live for large k.
+ *
+ * @tparam math_t input/accumulation/output data-type
+ * @tparam Index_ indexing type
+ * @tparam FinalLambda user-defined epilogue lambda
+ * @param handle raft handle (provides the cublas handle for the GEMM)
+ * @param x first set of points (size m*k)
+ * @param y second set of points (size n*k)
+ * @param dist output distance matrix (size m*n)
+ * @param m number of points in x
+ * @param n number of points in y
+ * @param k dimensionality
+ * @param metric one of L2Expanded, L2SqrtExpanded, CosineExpanded
+ * @param fin_op the final elementwise epilogue lambda
+ * @param use_tensor_ops whether to allow TF32 tensor-op math for fp32 inputs
+ * @param isRowMajor whether the matrices are row-major or col-major
+ */
+template <typename math_t, typename Index_, typename FinalLambda>
+void gemmDistance(const raft::handle_t& handle,
+                  const math_t* x,
+                  const math_t* y,
+                  math_t* dist,
+                  Index_ m,
+                  Index_ n,
+                  Index_ k,
+                  raft::distance::DistanceType metric,
+                  FinalLambda fin_op,
+                  bool use_tensor_ops,
+                  bool isRowMajor)
+{
+  RAFT_EXPECTS(metric == raft::distance::DistanceType::L2Expanded ||
+                 metric == raft::distance::DistanceType::L2SqrtExpanded ||
+                 metric == raft::distance::DistanceType::CosineExpanded,
+               "gemmDistance supports the expanded L2 and cosine metrics only");
+
+  auto stream = handle.get_stream();
+
+  rmm::device_uvector<math_t> norms(m + n, stream);
+  math_t* xn = norms.data();
+  math_t* yn = norms.data() + m;
+  if (metric == raft::distance::DistanceType::CosineExpanded) {
+    auto norm_op = [] __device__(math_t in) { return raft::mySqrt(in); };
+    raft::linalg::rowNorm(xn, x, k, m, raft::linalg::L2Norm, isRowMajor, stream, norm_op);
+    raft::linalg::rowNorm(yn, y, k, n, raft::linalg::L2Norm, isRowMajor, stream, norm_op);
+  } else {
+    raft::linalg::rowNorm(xn, x, k, m, raft::linalg::L2Norm, isRowMajor, stream);
+    raft::linalg::rowNorm(yn, y, k, n, raft::linalg::L2Norm, isRowMajor, stream);
+  }
+
+  // dist = x * y^T; a row-major n*k matrix doubles as the col-major view of
+  // y^T (and vice versa), so no explicit transpose buffer is needed
+  bool tf32 = false;
+  if constexpr (std::is_same_v<math_t, float>) { tf32 = use_tensor_ops; }
+  auto cublas_h = handle.get_cublas_handle();
+  if (tf32) { RAFT_CUBLAS_TRY(cublasSetMathMode(cublas_h, CUBLAS_TF32_TENSOR_OP_MATH)); }
+  raft::linalg::gemm(handle,
+                     dist,
+                     const_cast<math_t*>(x),
+                     const_cast<math_t*>(y),
+                     m,
+                     n,
+                     k,
+                     !isRowMajor,
+                     !isRowMajor,
+                     isRowMajor,
+                     stream);
+  if (tf32) { RAFT_CUBLAS_TRY(cublasSetMathMode(cublas_h, CUBLAS_DEFAULT_MATH)); }
+
+  const int blocks = raft::ceildiv<Index_>(m * n, 256);
+  if (metric == raft::distance::DistanceType::CosineExpanded) {
+    gemmDistanceEpilogueKernel<math_t, math_t, Index_>
+      <<<blocks, 256, 0, stream>>>(dist, xn, yn, m, n, isRowMajor, cosine_gemm_epilogue<math_t>{}, fin_op);
+  } else {
+    bool sqrt = metric == raft::distance::DistanceType::L2SqrtExpanded;
+    gemmDistanceEpilogueKernel<math_t, math_t, Index_>
+      <<<blocks, 256, 0, stream>>>(dist, xn, yn, m, n, isRowMajor, l2_exp_gemm_epilogue<math_t>{sqrt}, fin_op);
+  }
+  RAFT_CUDA_TRY(cudaGetLastError());
+}
+
+}  // namespace detail
+}  // namespace distance
+}  // namespace raft
@@ -49,7 +49,8 @@ template <typename DataT,
           typename IdxT,
           int VecLen,
           typename FinalLambda,
-          bool isRowMajor>
+          bool isRowMajor,
+          template <typename, int> class PolicyT = raft::linalg::Policy4x4>
 static void l1Impl(const DataT* x,
                    const DataT* y,
                    IdxT m,
@@ -62,8 +63,8 @@ static void l1Impl(const DataT* x,
                    FinalLambda fin_op,
                    cudaStream_t stream)
 {
-  typedef typename raft::linalg::Policy4x4<DataT, VecLen>::Policy RowPolicy;
-  typedef typename raft::linalg::Policy4x4<DataT, VecLen>::ColPolicy ColPolicy;
+  typedef typename PolicyT<DataT, VecLen>::Policy RowPolicy;
+  typedef typename PolicyT<DataT, VecLen>::ColPolicy ColPolicy;
 
   typedef typename std::conditional<isRowMajor, RowPolicy, ColPolicy>::type KPolicy;
 
@@ -121,7 +122,8 @@ template <typename DataT,
           typename OutT,
           typename IdxT,
           typename FinalLambda,
-          bool isRowMajor>
+          bool isRowMajor,
+          template <typename, int> class PolicyT = raft::linalg::Policy4x4>
 void l1(IdxT m,
         IdxT n,
         IdxT k,
@@ -137,13 +139,13 @@ void l1(IdxT m,
   size_t bytesA = sizeof(DataT) * lda;
   size_t bytesB = sizeof(DataT) * ldb;
   if (16 % sizeof(DataT) == 0 && bytesA % 16 == 0 && bytesB % 16 == 0) {
-    l1Impl<DataT, AccT, OutT, IdxT, 16 / sizeof(DataT), FinalLambda, isRowMajor>(
+    l1Impl<DataT, AccT, OutT, IdxT, 16 / sizeof(DataT), FinalLambda, isRowMajor, PolicyT>(
       x, y, m, n, k, lda, ldb, ldd, dOutput, fin_op, stream);
   } else if (8 % sizeof(DataT) == 0 && bytesA % 8 == 0 && bytesB % 8 == 0) {
-    l1Impl<DataT, AccT, OutT, IdxT, 8 / sizeof(DataT), FinalLambda, isRowMajor>(
+    l1Impl<DataT, AccT, OutT, IdxT, 8 / sizeof(DataT), FinalLambda, isRowMajor, PolicyT>(
       x, y, m, n, k, lda, ldb, ldd, dOutput, fin_op, stream);
   } else {
-    l1Impl<DataT, AccT, OutT, IdxT, 1, FinalLambda, isRowMajor>(
+    l1Impl<DataT, AccT, OutT, IdxT, 1, FinalLambda, isRowMajor, PolicyT>(
       x, y, m, n, k, lda, ldb, ldd, dOutput, fin_op, stream);
   }
 }
@@ -185,15 +187,27 @@ void l1Impl(int m,
   typedef typename std::conditional<is_bool::value, OutType, AccType>::type L1OutType;
   Index_ lda, ldb, ldd;
   L1OutType* pDcast = reinterpret_cast<L1OutType*>(pD);
+  // pick the kernel policy for the current device at runtime; sm80+ has
+  // the shared memory capacity for the deeper k-block tiles
+  bool wide = useWideKernelPolicy();
   if (isRowMajor) {
     lda = k, ldb = k, ldd = n;
-    l1<InType, AccType, L1OutType, Index_, FinalLambda, true>(
-      m, n, k, lda, ldb, ldd, pA, pB, pDcast, fin_op, stream);
-
+    if (wide) {
+      l1<InType, AccType, L1OutType, Index_, FinalLambda, true, raft::linalg::Policy4x4Wide>(
+        m, n, k, lda, ldb, ldd, pA, pB, pDcast, fin_op, stream);
+    } else {
+      l1<InType, AccType, L1OutType, Index_, FinalLambda, true>(
+        m, n, k, lda, ldb, ldd, pA, pB, pDcast, fin_op, stream);
+    }
   } else {
     lda = n, ldb = m, ldd = m;
-    l1<InType, AccType, L1OutType, Index_, FinalLambda, false>(
-      n, m, k, lda, ldb, ldd, pB, pA, pDcast, fin_op, stream);
+    if (wide) {
+      l1<InType, AccType, L1OutType, Index_, FinalLambda, false, raft::linalg::Policy4x4Wide>(
+        n, m, k, lda, ldb, ldd, pB, pA, pDcast, fin_op, stream);
+    } else {
+      l1<InType, AccType, L1OutType, Index_, FinalLambda, false>(
+        n, m, k, lda, ldb, ldd, pB, pA, pDcast, fin_op, stream);
+    }
   }
 }
 }  // namespace detail
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/cuda_utils.cuh>
+#include <raft/distance/distance_type.hpp>
+#include <raft/handle.hpp>
+#include <raft/linalg/norm.cuh>
+
+#include <rmm/device_uvector.hpp>
+
+namespace raft {
+namespace distance {
+namespace detail {
+
+/**
+ * Computes distances for the candidate pairs of one query row per block.
+ * Each warp walks one candidate at a time, striding the k dimension across
+ * its lanes, so a ~200-candidate row keeps all warps of the block busy
+ * without any cross-warp coordination.
+ *
+ * The norm pointers are only dereferenced for CosineExpanded.
+ */
+template <raft::distance::DistanceType metric,
+          typename value_t,
+          typename value_idx,
+          int tpb = 128>
+__global__ void maskedDistanceKernel(value_t* out,
+                                     const value_t* x,
+                                     const value_t* y,
+                                     value_idx k,
+                                     const value_idx* indptr,
+                                     const value_idx* indices,
+                                     const value_t* xn,
+                                     const value_t* yn)
+{
+  const value_idx row       = blockIdx.x;
+  const value_idx start     = indptr[row];
+  const value_idx end       = indptr[row + 1];
+  const int lane            = threadIdx.x % raft::WarpSize;
+  const int warp            = threadIdx.x / raft::WarpSize;
+  constexpr int warps_per_b = tpb / raft::WarpSize;
+
+  const value_t* x_row = x + row * k;
+  for (value_idx idx = start + warp; idx < end; idx += warps_per_b) {
+    const value_idx col  = indices[idx];
+    const value_t* y_row = y + col * k;
+    value_t acc          = 0;
+    for (value_idx j = lane; j < k; j += raft::WarpSize) {
+      if (metric == raft::distance::DistanceType::L1) {
+        acc += raft::myAbs(x_row[j] - y_row[j]);
+      } else if (metric == raft::distance::DistanceType::InnerProduct ||
+                 metric == raft::distance::DistanceType::CosineExpanded) {
+        acc += x_row[j] * y_row[j];
+      } else {
+        value_t diff = x_row[j] - y_row[j];
+        acc += diff * diff;
+      }
+    }
+    acc = raft::warpReduce(acc);
+    if (lane == 0) {
+      if (metric == raft::distance::DistanceType::L2SqrtExpanded ||
+          metric == raft::distance::DistanceType::L2SqrtUnexpanded) {
+        acc = raft::mySqrt(acc);
+      } else if (metric == raft::distance::DistanceType::CosineExpanded) {
+        acc = (value_t)1.0 - acc / (xn[row] * yn[col]);
+      }
+      out[idx] = acc;
+    }
+  }
+}
+
+template <typename value_t, typename value_idx>
+void maskedDistanceImpl(const raft::handle_t& handle,
+                        const value_t* x,
+                        const value_t* y,
+                        value_idx m,
+                        value_idx n,
+                        value_idx k,
+                        const value_idx* indptr,
+                        const value_idx* indices,
+                        value_idx nnz,
+                        value_t* out,
+                        raft::distance::DistanceType metric)
+{
+  if (m == 0 || nnz == 0) { return; }
+
+  auto stream       = handle.get_stream();
+  constexpr int tpb = 128;
+
+  rmm::device_uvector<value_t> norms(0, stream);
+  const value_t* xn = nullptr;
+  const value_t* yn = nullptr;
+  if (metric == raft::distance::DistanceType::CosineExpanded) {
+    norms.resize(m + n, stream);
+    auto norm_op = [] __device__(value_t in) { return raft::mySqrt(in); };
+    raft::linalg::rowNorm(norms.data(), x, k, m, raft::linalg::L2Norm, true, stream, norm_op);
+    raft::linalg::rowNorm(norms.data() + m, y, k, n, raft::linalg::L2Norm, true, stream, norm_op);
+    xn = norms.data();
+    yn = norms.data() + m;
+  }
+
+  dim3 grid(m);
+  switch (metric) {
+    // the expanded and unexpanded L2 variants coincide here: with only a
+    // handful of candidates per row there is no GEMM to amortize, so the
+    // (numerically safer) difference-of-elements form is used for both
+    case raft::distance::DistanceType::L2Expanded:
+    case raft::distance::DistanceType::L2Unexpanded:
+      maskedDistanceKernel<raft::distance::DistanceType::L2Unexpanded, value_t, value_idx, tpb>
+        <<<grid, tpb, 0, stream>>>(out, x, y, k, indptr, indices, xn, yn);
+      break;
+    case raft::distance::DistanceType::L2SqrtExpanded:
+    case raft::distance::DistanceType::L2SqrtUnexpanded:
+      maskedDistanceKernel<raft::distance::DistanceType::L2SqrtUnexpanded, value_t, value_idx, tpb>
+        <<<grid, tpb, 0, stream>>>(out, x, y, k, indptr, indices, xn, yn);
+      break;
+    case raft::distance::DistanceType::InnerProduct:
+      maskedDistanceKernel<raft::distance::DistanceType::InnerProduct, value_t, value_idx, tpb>
+        <<<grid, tpb, 0, stream>>>(out, x, y, k, indptr, indices, xn, yn);
+      break;
+    case raft::distance::DistanceType::CosineExpanded:
+      maskedDistanceKernel<raft::distance::DistanceType::CosineExpanded, value_t, value_idx, tpb>
+        <<<grid, tpb, 0, stream>>>(out, x, y, k, indptr, indices, xn, yn);
+      break;
+    case raft::distance::DistanceType::L1:
+      maskedDistanceKernel<raft::distance::DistanceType::L1, value_t, value_idx, tpb>
+        <<<grid, tpb, 0, stream>>>(out, x, y, k, indptr, indices, xn, yn);
+      break;
+    default: RAFT_FAIL("masked distance does not support metric %d", static_cast<int>(metric));
+  }
+  RAFT_CUDA_TRY(cudaGetLastError());
+}
+
+}  // namespace detail
+}  // namespace distance
+}  // namespace raft
@@ -65,8 +65,10 @@ void minkowskiUnExpImpl(const DataT* x,
                         cudaStream_t stream,
                         DataT p)
 {
-  typedef typename raft::linalg::Policy4x4<DataT, VecLen>::Policy RowPolicy;
-  typedef typename raft::linalg::Policy4x4<DataT, VecLen>::ColPolicy ColPolicy;
+  // elementwise-heavy metric: use the compute-oriented policy family
+  // instead of the GEMM-shaped default (see `Policy8x4` docs)
+  typedef typename raft::linalg::Policy8x4<DataT, VecLen>::Policy RowPolicy;
+  typedef typename raft::linalg::Policy8x4<DataT, VecLen>::ColPolicy ColPolicy;
 
   typedef typename std::conditional<isRowMajor, RowPolicy, ColPolicy>::type KPolicy;
 
@@ -21,6 +21,9 @@
 #include <raft/vectorized.cuh>
 
 #include <cstddef>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
 
 namespace raft {
 namespace distance {
@@ -41,7 +44,7 @@ namespace detail {
  * @tparam EpilogueLambda applies an elementwise function to compute final
     values. Its signature is:
     template <typename AccT, typename DataT> void epilogue_lambda
-    (AccT acc[][], DataT* regxn, DataT* regyn);
+    (AccT acc[][], AccT* regxn, AccT* regyn);
  * @tparam FinalLambda the final lambda called on final distance value
  * @param[in] x input matrix
  * @param[in] y input matrix
@@ -76,8 +79,8 @@ template <bool useNorms,
 struct PairwiseDistances : public BaseClass {
  private:
   typedef Policy P;
-  const DataT* xn;
-  const DataT* yn;
+  const AccT* xn;
+  const AccT* yn;
   const DataT* const yBase;
   OutT* dOutput;
   char* smem;
@@ -98,8 +101,8 @@ struct PairwiseDistances : public BaseClass {
                        IdxT _lda,
                        IdxT _ldb,
                        IdxT _ldd,
-                       const DataT* _xn,
-                       const DataT* _yn,
+                       const AccT* _xn,
+                       const AccT* _yn,
                        OutT* _dOutput,
                        char* _smem,
                        CoreLambda _core_op,
@@ -191,15 +194,19 @@ struct PairwiseDistances : public BaseClass {
 
   DI void loop()
   {
+    IdxT kbase = 0;
     for (int kidx = P::Kblk; kidx < this->k; kidx += P::Kblk) {
-      this->ldgXY(kidx);
-      accumulate();  // on the previous k-block
-      this->stsXY();
+      // issue the next tile's global->smem copy (cp.async on sm_80+, so it
+      // overlaps with the accumulation below instead of staging in registers)
+      this->ldgstsXY(kidx);
+      accumulate(kbase);  // on the previous k-block
+      kbase = kidx;
+      this->ldgstsWait();
       __syncthreads();
       this->pageWr ^= 1;
       this->pageRd ^= 1;
     }
-    accumulate();  // last iteration
+    accumulate(kbase);  // last iteration
     // This is needed for making sure next grid stride of
     // non-norm based metrics uses previously accumulated buffer so
     // it doesn't make shmem dirty until previous iteration
@@ -207,7 +214,7 @@ struct PairwiseDistances : public BaseClass {
     this->pageRd ^= 1;
   }
 
-  DI void accumulate()
+  DI void accumulate(IdxT kbase)
   {
 #pragma unroll
     for (int ki = 0; ki < P::Kblk; ki += P::Veclen) {
@@ -218,7 +225,13 @@ struct PairwiseDistances : public BaseClass {
         for (int j = 0; j < P::AccColsPerTh; ++j) {
 #pragma unroll
           for (int v = 0; v < P::Veclen; ++v) {
-            core_op(acc[i][j], this->regx[i][v], this->regy[j][v]);
+            // k-aware core lambdas (e.g. per-dimension weights) also
+            // receive the global k index of the element pair
+            if constexpr (std::is_invocable_v<CoreLambda, AccT&, DataT&, DataT&, IdxT>) {
+              core_op(acc[i][j], this->regx[i][v], this->regy[j][v], kbase + ki + v);
+            } else {
+              core_op(acc[i][j], this->regx[i][v], this->regy[j][v]);
+            }
           }
         }
       }
@@ -228,8 +241,8 @@ struct PairwiseDistances : public BaseClass {
   DI void epilog(IdxT gridStrideX, IdxT gridStrideY)
   {
     if (useNorms) {
-      DataT* sxNorm = (DataT*)(&smem[P::SmemSize]);
-      DataT* syNorm = (&sxNorm[P::Mblk]);
+      AccT* sxNorm = (AccT*)(&smem[P::SmemSize]);
+      AccT* syNorm = (&sxNorm[P::Mblk]);
 
       // Load x & y norms required by this threadblock in shmem buffer
       if (gridStrideX == blockIdx.x * P::Nblk) {
@@ -246,7 +259,7 @@ struct PairwiseDistances : public BaseClass {
 
       __syncthreads();
 
-      DataT regxn[P::AccRowsPerTh], regyn[P::AccColsPerTh];
+      AccT regxn[P::AccRowsPerTh], regyn[P::AccColsPerTh];
 #pragma unroll
       for (int i = 0; i < P::AccRowsPerTh; ++i) {
         regxn[i] = sxNorm[i * P::AccThRows + (threadIdx.x / P::AccThCols)];
@@ -331,8 +344,8 @@ __global__ __launch_bounds__(Policy::Nthreads, 2)
 
   void pairwiseDistanceMatKernel(const DataT* x,
                                  const DataT* y,
-                                 const DataT* _xn,
-                                 const DataT* _yn,
+                                 const AccT* _xn,
+                                 const AccT* _yn,
                                  IdxT m,
                                  IdxT n,
                                  IdxT k,
@@ -364,9 +377,51 @@ __global__ __launch_bounds__(Policy::Nthreads, 2)
   obj.run();
 }
 
+/**
+ * @brief Compute capability (major * 10 + minor) of the current device.
+ *
+ * The attribute query costs a few microseconds, which matters for the
+ * small-problem launches this is consulted on, so the result is cached
+ * per device for the lifetime of the process.
+ */
+inline int currentComputeCapability()
+{
+  static std::mutex mutex;
+  static std::unordered_map<int, int> cache;
+
+  int dev;
+  RAFT_CUDA_TRY(cudaGetDevice(&dev));
+  std::lock_guard<std::mutex> guard(mutex);
+  auto it = cache.find(dev);
+  if (it != cache.end()) { return it->second; }
+  int major, minor;
+  RAFT_CUDA_TRY(cudaDeviceGetAttribute(&major, cudaDevAttrComputeCapabilityMajor, dev));
+  RAFT_CUDA_TRY(cudaDeviceGetAttribute(&minor, cudaDevAttrComputeCapabilityMinor, dev));
+  cache[dev] = major * 10 + minor;
+  return cache[dev];
+}
+
+/**
+ * @brief Whether the current device should run the wide (deep k-block)
+ * kernel policies.
+ *
+ * The wide policies need more than the 48KB static shared memory limit,
+ * so they are reserved for sm80 and newer where the extra capacity
+ * exists and the deeper main loop measurably improves throughput.
+ */
+inline bool useWideKernelPolicy() { return currentComputeCapability() >= 80; }
+
 template <typename P, typename IdxT, typename T>
 dim3 launchConfigGenerator(IdxT m, IdxT n, std::size_t sMemSize, T func)
 {
+  // policies exceeding the 48KB static limit (e.g. `Policy4x4Wide`) must
+  // opt the kernel into large dynamic shared memory before the occupancy
+  // query, or both the query and the launch fail
+  if (sMemSize > 48 * 1024) {
+    RAFT_CUDA_TRY(
+      cudaFuncSetAttribute(func, cudaFuncAttributeMaxDynamicSharedMemorySize, sMemSize));
+  }
+
   const auto numSMs  = raft::getMultiProcessorCount();
   int numBlocksPerSm = 0;
   dim3 grid;
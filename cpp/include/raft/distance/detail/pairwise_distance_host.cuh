@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/distance/distance_type.hpp>
+#include <raft/handle.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace raft {
+namespace distance {
+namespace detail {
+
+/**
+ * Crossover below which the kernel launch + sync overhead of the device
+ * path exceeds an OpenMP host computation. The primary bound is on total
+ * compute volume (m * n * k multiply-adds): output elements alone would
+ * admit shapes like 256x256 at k = 1024 -- ~67M multiply-adds, milliseconds
+ * on a host, far beyond the launch overhead being hidden. The output and k
+ * bounds additionally cap the pinned staging traffic, since this path
+ * blocks the caller on a host<->device round trip.
+ */
+constexpr size_t kPairwiseHostMaxFlop        = 1 << 18;
+constexpr size_t kPairwiseHostMaxOutputElems = 1 << 16;
+constexpr size_t kPairwiseHostMaxK           = 1024;
+
+/** Metrics with a host implementation below. */
+inline bool pairwise_distance_host_supported(raft::distance::DistanceType metric)
+{
+  switch (metric) {
+    case raft::distance::DistanceType::L1:
+    case raft::distance::DistanceType::L2Expanded:
+    case raft::distance::DistanceType::L2SqrtExpanded:
+    case raft::distance::DistanceType::L2Unexpanded:
+    case raft::distance::DistanceType::L2SqrtUnexpanded:
+    case raft::distance::DistanceType::Linf:
+    case raft::distance::DistanceType::InnerProduct:
+    case raft::distance::DistanceType::CosineExpanded: return true;
+    default: return false;
+  }
+}
+
+/**
+ * Host execution of pairwise_distance for microseconds-scale inputs.
+ * Inputs are pulled through the handle's pinned staging ring, distances are
+ * accumulated in double on the CPU (OpenMP across output rows), and the
+ * result is staged back asynchronously, so the call keeps the device
+ * stream's ordering semantics.
+ */
+template <typename Type, typename Index_>
+void pairwise_distance_host(const raft::handle_t& handle,
+                            const Type* x,
+                            const Type* y,
+                            Type* dist,
+                            Index_ m,
+                            Index_ n,
+                            Index_ k,
+                            raft::distance::DistanceType metric,
+                            bool isRowMajor)
+{
+  auto stream = handle.get_stream();
+  auto& ring  = handle.get_staging_ring();
+
+  std::vector<Type> hx((size_t)m * k);
+  std::vector<Type> hy((size_t)n * k);
+  std::vector<Type> hd((size_t)m * n);
+
+  ring.copy_to_host(hx.data(), x, hx.size() * sizeof(Type), stream);
+  ring.copy_to_host(hy.data(), y, hy.size() * sizeof(Type), stream);
+
+  auto x_at = [&](Index_ i, Index_ l) { return isRowMajor ? hx[(size_t)i * k + l] : hx[(size_t)l * m + i]; };
+  auto y_at = [&](Index_ j, Index_ l) { return isRowMajor ? hy[(size_t)j * k + l] : hy[(size_t)l * n + j]; };
+
+#if defined(_OPENMP)
+#pragma omp parallel for
+#endif
+  for (Index_ i = 0; i < m; i++) {
+    for (Index_ j = 0; j < n; j++) {
+      double acc = 0.0;
+      switch (metric) {
+        case raft::distance::DistanceType::L1:
+          for (Index_ l = 0; l < k; l++) {
+            acc += std::abs((double)x_at(i, l) - (double)y_at(j, l));
+          }
+          break;
+        case raft::distance::DistanceType::Linf:
+          for (Index_ l = 0; l < k; l++) {
+            acc = std::max(acc, std::abs((double)x_at(i, l) - (double)y_at(j, l)));
+          }
+          break;
+        case raft::distance::DistanceType::InnerProduct:
+          for (Index_ l = 0; l < k; l++) {
+            acc += (double)x_at(i, l) * (double)y_at(j, l);
+          }
+          break;
+        case raft::distance::DistanceType::CosineExpanded: {
+          double dot = 0.0, nx = 0.0, ny = 0.0;
+          for (Index_ l = 0; l < k; l++) {
+            double a = x_at(i, l), b = y_at(j, l);
+            dot += a * b;
+            nx += a * a;
+            ny += b * b;
+          }
+          acc = 1.0 - dot / (std::sqrt(nx) * std::sqrt(ny));
+          break;
+        }
+        default:  // the L2 family
+          for (Index_ l = 0; l < k; l++) {
+            double diff = (double)x_at(i, l) - (double)y_at(j, l);
+            acc += diff * diff;
+          }
+          if (metric == raft::distance::DistanceType::L2SqrtExpanded ||
+              metric == raft::distance::DistanceType::L2SqrtUnexpanded) {
+            acc = std::sqrt(acc);
+          }
+          break;
+      }
+      hd[isRowMajor ? (size_t)i * n + j : (size_t)j * m + i] = (Type)acc;
+    }
+  }
+
+  ring.stage_and_copy_async(dist, hd.data(), hd.size() * sizeof(Type), stream);
+}
+
+};  // namespace detail
+};  // namespace distance
+};  // namespace raft
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/cuda_utils.cuh>
+#include <raft/distance/detail/chebyshev.cuh>
+#include <raft/distance/detail/euclidean.cuh>
+#include <raft/distance/detail/l1.cuh>
+#include <raft/distance/distance_type.hpp>
+
+namespace raft {
+namespace distance {
+namespace detail {
+
+/**
+ * @brief Runtime-metric dispatch for row-major inputs with explicit leading
+ * dimensions.
+ *
+ * The pairwise contraction tiles already parameterize on lda/ldb/ldd; this
+ * routes a strided (e.g. submatrix-view) problem straight to the ld-taking
+ * launchers, so callers slicing windows out of larger matrices skip the
+ * compaction copy the packed entry points would force.
+ *
+ * Only the metrics whose launchers take leading dimensions are supported;
+ * the expanded L2 forms are computed with the unexpanded kernels (identical
+ * results) to avoid materializing row norms of strided inputs.
+ */
+template <typename Type, typename Index_>
+void pairwise_distance_strided_dispatch(const Type* x,
+                                        const Type* y,
+                                        Type* dist,
+                                        Index_ m,
+                                        Index_ n,
+                                        Index_ k,
+                                        Index_ lda,
+                                        Index_ ldb,
+                                        Index_ ldd,
+                                        raft::distance::DistanceType metric,
+                                        cudaStream_t stream)
+{
+  auto fin_op = raft::Nop<Type, Index_>();
+  switch (metric) {
+    case DistanceType::L2Expanded:
+    case DistanceType::L2Unexpanded:
+      euclideanUnExp<Type, Type, Type, Index_, decltype(fin_op), true>(
+        m, n, k, lda, ldb, ldd, x, y, false, dist, fin_op, stream);
+      break;
+    case DistanceType::L2SqrtExpanded:
+    case DistanceType::L2SqrtUnexpanded:
+      euclideanUnExp<Type, Type, Type, Index_, decltype(fin_op), true>(
+        m, n, k, lda, ldb, ldd, x, y, true, dist, fin_op, stream);
+      break;
+    case DistanceType::L1:
+      l1<Type, Type, Type, Index_, decltype(fin_op), true>(
+        m, n, k, lda, ldb, ldd, x, y, dist, fin_op, stream);
+      break;
+    case DistanceType::Linf:
+      chebyshev<Type, Type, Type, Index_, decltype(fin_op), true>(
+        m, n, k, lda, ldb, ldd, x, y, dist, fin_op, stream);
+      break;
+    default:
+      RAFT_FAIL("pairwise_distance with strided views does not support metric %d",
+                static_cast<int>(metric));
+  }
+}
+
+}  // namespace detail
+}  // namespace distance
+}  // namespace raft
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/cuda_utils.cuh>
+#include <raft/distance/detail/pairwise_distance_strided.cuh>
+
+#include <algorithm>
+
+namespace raft {
+namespace distance {
+namespace detail {
+
+template <typename Type, typename Index_>
+__global__ void mirrorLowerTriangleKernel(Type* dist, Index_ n)
+{
+  Index_ j = blockIdx.x * blockDim.x + threadIdx.x;
+  Index_ i = blockIdx.y * blockDim.y + threadIdx.y;
+  if (i < n && j < n && j > i) {
+    // Promote to 64 bit index, as the output array can be > 2^31
+    dist[std::size_t(j) * n + i] = dist[std::size_t(i) * n + j];
+  }
+}
+
+/** copies the computed upper triangle into the strictly-lower one */
+template <typename Type, typename Index_>
+void mirrorLowerTriangle(Type* dist, Index_ n, cudaStream_t stream)
+{
+  dim3 blk(32, 32);
+  dim3 grid(raft::ceildiv<Index_>(n, 32), raft::ceildiv<Index_>(n, 32));
+  mirrorLowerTriangleKernel<Type, Index_><<<grid, blk, 0, stream>>>(dist, n);
+  RAFT_CUDA_TRY(cudaGetLastError());
+}
+
+/**
+ * @brief Self-join distances computing only the upper triangle; see the
+ * public wrapper for the full docs.
+ *
+ * The upper triangle is covered by row blocks: block [r0, r0 + rows) is a
+ * rectangular sub-problem against columns [r0, n), routed through the
+ * strided launchers so the output lands directly in the n x n matrix. Only
+ * the diagonal blocks compute any redundant (sub-diagonal) values, an
+ * overhead of ~block_rows / (2 * n) of the half-matrix FLOPs.
+ */
+template <typename Type, typename Index_>
+void pairwise_distance_symmetric_impl(const Type* x,
+                                      Type* dist,
+                                      Index_ n,
+                                      Index_ k,
+                                      raft::distance::DistanceType metric,
+                                      cudaStream_t stream,
+                                      bool mirror,
+                                      Index_ block_rows = 1024)
+{
+  for (Index_ r0 = 0; r0 < n; r0 += block_rows) {
+    Index_ rows = std::min(block_rows, n - r0);
+    pairwise_distance_strided_dispatch<Type, Index_>(x + std::size_t(r0) * k,
+                                                     x + std::size_t(r0) * k,
+                                                     dist + std::size_t(r0) * n + r0,
+                                                     rows,
+                                                     n - r0,
+                                                     k,
+                                                     k,
+                                                     k,
+                                                     n,
+                                                     metric,
+                                                     stream);
+  }
+  if (mirror) { mirrorLowerTriangle(dist, n, stream); }
+}
+
+}  // namespace detail
+}  // namespace distance
+}  // namespace raft
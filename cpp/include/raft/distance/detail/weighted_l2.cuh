@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <raft/distance/detail/pairwise_distance_base.cuh>
+
+namespace raft {
+namespace distance {
+namespace detail {
+
+/**
+ * @brief the weighted L2 distance matrix calculation implementer
+ *  It computes the following equation: cij = sum_k w_k * (x_ik - y_jk)^2
+ *
+ *  The weight vector is folded into the tile accumulation through the
+ *  k-aware core lambda, so neither input matrix needs to be scaled into
+ *  a transformed copy beforehand. With w = 1/sigma^2 this is the
+ *  Mahalanobis distance for a diagonal covariance.
+ *
+ * @tparam DataT          input data-type (for A and B matrices)
+ * @tparam AccT           accumulation data-type
+ * @tparam OutT           output data-type (for C and D matrices)
+ * @tparam IdxT           index data-type
+ * @tparam FinalLambda    final lambda called on final distance value
+ * @tparam isRowMajor     true if input/output is row major,
+                          false for column major
+ * @param[in]       x input matrix
+ * @param[in]       y input matrix
+ * @param[in]       m number of rows of A and C/D
+ * @param[in]       n number of columns of B and C/D
+ * @param[in]       k number of cols of A and rows of B
+ * @param[in]       lda leading dimension of A
+ * @param[in]       ldb leading dimension of B
+ * @param[in]       ldd leading dimension of C/D
+ * @param[in]       weights per-dimension weight vector of length k
+ * @param[output]   dOutput output matrix
+ * @param fin_op    the final gemm epilogue lambda
+ */
+template <typename DataT,
+          typename AccT,
+          typename OutT,
+          typename IdxT,
+          int VecLen,
+          typename FinalLambda,
+          bool isRowMajor,
+          template <typename, int> class PolicyT = raft::linalg::Policy4x4>
+static void weightedL2Impl(const DataT* x,
+                           const DataT* y,
+                           IdxT m,
+                           IdxT n,
+                           IdxT k,
+                           IdxT lda,
+                           IdxT ldb,
+                           IdxT ldd,
+                           const DataT* weights,
+                           OutT* dOutput,
+                           FinalLambda fin_op,
+                           cudaStream_t stream)
+{
+  typedef typename PolicyT<DataT, VecLen>::Policy RowPolicy;
+  typedef typename PolicyT<DataT, VecLen>::ColPolicy ColPolicy;
+
+  typedef typename std::conditional<isRowMajor, RowPolicy, ColPolicy>::type KPolicy;
+
+  dim3 blk(KPolicy::Nthreads);
+
+  // Accumulation operation lambda. The last k-block may extend past k
+  // with zero-padded lanes; their diff is zero, so the weight index only
+  // needs clamping to stay in bounds, not masking.
+  auto core_lambda = [weights, k] __device__(AccT & acc, DataT & x, DataT & y, IdxT kidx) {
+    const auto diff = x - y;
+    const auto w    = weights[kidx < k ? kidx : IdxT(0)];
+    acc += w * diff * diff;
+  };
+
+  // epilogue operation lambda for final value calculation
+  auto epilog_lambda = [] __device__(AccT acc[KPolicy::AccRowsPerTh][KPolicy::AccColsPerTh],
+                                     DataT * regxn,
+                                     DataT * regyn,
+                                     IdxT gridStrideX,
+                                     IdxT gridStrideY) { return; };
+
+  if (isRowMajor) {
+    auto weightedL2RowMajor = pairwiseDistanceMatKernel<false,
+                                                        DataT,
+                                                        AccT,
+                                                        OutT,
+                                                        IdxT,
+                                                        KPolicy,
+                                                        decltype(core_lambda),
+                                                        decltype(epilog_lambda),
+                                                        FinalLambda,
+                                                        true>;
+    dim3 grid = launchConfigGenerator<KPolicy>(m, n, KPolicy::SmemSize, weightedL2RowMajor);
+
+    weightedL2RowMajor<<<grid, blk, KPolicy::SmemSize, stream>>>(
+      x, y, nullptr, nullptr, m, n, k, lda, ldb, ldd, dOutput, core_lambda, epilog_lambda, fin_op);
+  } else {
+    auto weightedL2ColMajor = pairwiseDistanceMatKernel<false,
+                                                        DataT,
+                                                        AccT,
+                                                        OutT,
+                                                        IdxT,
+                                                        KPolicy,
+                                                        decltype(core_lambda),
+                                                        decltype(epilog_lambda),
+                                                        FinalLambda,
+                                                        false>;
+    dim3 grid = launchConfigGenerator<KPolicy>(m, n, KPolicy::SmemSize, weightedL2ColMajor);
+    weightedL2ColMajor<<<grid, blk, KPolicy::SmemSize, stream>>>(
+      x, y, nullptr, nullptr, m, n, k, lda, ldb, ldd, dOutput, core_lambda, epilog_lambda, fin_op);
+  }
+
+  RAFT_CUDA_TRY(cudaGetLastError());
+}
+
+template <typename DataT,
+          typename AccT,
+          typename OutT,
+          typename IdxT,
+          typename FinalLambda,
+          bool isRowMajor,
+          template <typename, int> class PolicyT = raft::linalg::Policy4x4>
+void weightedL2(IdxT m,
+                IdxT n,
+                IdxT k,
+                IdxT lda,
+                IdxT ldb,
+                IdxT ldd,
+                const DataT* x,
+                const DataT* y,
+                const DataT* weights,
+                OutT* dOutput,
+                FinalLambda fin_op,
+                cudaStream_t stream)
+{
+  size_t bytesA = sizeof(DataT) * lda;
+  size_t bytesB = sizeof(DataT) * ldb;
+  if (16 % sizeof(DataT) == 0 && bytesA % 16 == 0 && bytesB % 16 == 0) {
+    weightedL2Impl<DataT, AccT, OutT, IdxT, 16 / sizeof(DataT), FinalLambda, isRowMajor, PolicyT>(
+      x, y, m, n, k, lda, ldb, ldd, weights, dOutput, fin_op, stream);
+  } else if (8 % sizeof(DataT) == 0 && bytesA % 8 == 0 && bytesB % 8 == 0) {
+    weightedL2Impl<DataT, AccT, OutT, IdxT, 8 / sizeof(DataT), FinalLambda, isRowMajor, PolicyT>(
+      x, y, m, n, k, lda, ldb, ldd, weights, dOutput, fin_op, stream);
+  } else {
+    weightedL2Impl<DataT, AccT, OutT, IdxT, 1, FinalLambda, isRowMajor, PolicyT>(
+      x, y, m, n, k, lda, ldb, ldd, weights, dOutput, fin_op, stream);
+  }
+}
+
+/**
+ * @brief the weighted L2 distance matrix calculation
+ *  It computes the following equation: cij = sum_k w_k * (x_ik - y_jk)^2
+ * @tparam InType input data-type (for A and B matrices)
+ * @tparam AccType accumulation data-type
+ * @tparam OutType output data-type (for C and D matrices)
+ * @tparam FinalLambda user-defined epilogue lamba
+ * @tparam Index_ Index type
+ * @param m number of rows of A and C/D
+ * @param n number of columns of B and C/D
+ * @param k number of cols of A and rows of B
+ * @param pA input matrix
+ * @param pB input matrix
+ * @param weights per-dimension weight vector of length k
+ * @param pD output matrix
+ * @param fin_op the final element-wise epilogue lambda
+ * @param stream cuda stream where to launch work
+ * @param isRowMajor whether the input and output matrices are row major
+ */
+template <typename InType,
+          typename AccType,
+          typename OutType,
+          typename FinalLambda,
+          typename Index_ = int>
+void weightedL2Impl(int m,
+                    int n,
+                    int k,
+                    const InType* pA,
+                    const InType* pB,
+                    const InType* weights,
+                    OutType* pD,
+                    FinalLambda fin_op,
+                    cudaStream_t stream,
+                    bool isRowMajor)
+{
+  Index_ lda, ldb, ldd;
+  // pick the kernel policy for the current device at runtime; sm80+ has
+  // the shared memory capacity for the deeper k-block tiles
+  bool wide = useWideKernelPolicy();
+  if (isRowMajor) {
+    lda = k, ldb = k, ldd = n;
+    if (wide) {
+      weightedL2<InType, AccType, OutType, Index_, FinalLambda, true, raft::linalg::Policy4x4Wide>(
+        m, n, k, lda, ldb, ldd, pA, pB, weights, pD, fin_op, stream);
+    } else {
+      weightedL2<InType, AccType, OutType, Index_, FinalLambda, true>(
+        m, n, k, lda, ldb, ldd, pA, pB, weights, pD, fin_op, stream);
+    }
+  } else {
+    lda = n, ldb = m, ldd = m;
+    if (wide) {
+      weightedL2<InType, AccType, OutType, Index_, FinalLambda, false, raft::linalg::Policy4x4Wide>(
+        n, m, k, lda, ldb, ldd, pB, pA, weights, pD, fin_op, stream);
+    } else {
+      weightedL2<InType, AccType, OutType, Index_, FinalLambda, false>(
+        n, m, k, lda, ldb, ldd, pB, pA, weights, pD, fin_op, stream);
+    }
+  }
+}
+}  // namespace detail
+}  // namespace distance
+}  // namespace raft
@@ -18,13 +18,26 @@
 
 #pragma once
 
+#include <raft/core/memory_telemetry.hpp>
+#include <raft/core/nvtx.hpp>
+#include <raft/core/profiler.hpp>
 #include <raft/distance/detail/distance.cuh>
+#include <raft/distance/detail/gemm_distance.cuh>
+#include <raft/distance/detail/pairwise_distance_host.cuh>
+#include <raft/distance/detail/pairwise_distance_strided.cuh>
+#include <raft/distance/detail/pairwise_distance_symmetric.cuh>
+#include <raft/distance/detail/weighted_l2.cuh>
 #include <raft/distance/distance_type.hpp>
+#include <raft/distance/epilogue.cuh>
+#include <raft/distance/norms_index.cuh>
 #include <raft/handle.hpp>
 #include <rmm/device_uvector.hpp>
 
 #include <raft/mdarray.hpp>
 
+#include <limits>
+#include <vector>
+
 /**
  * @defgroup pairwise_distance pairwise distance prims
  * @{
@@ -302,70 +315,365 @@ void pairwise_distance(const raft::handle_t& handle,
                        bool isRowMajor = true,
                        Type metric_arg = 2.0f)
 {
-  switch (metric) {
-    case raft::distance::DistanceType::L2Expanded:
-      detail::pairwise_distance_impl<Type, Index_, raft::distance::DistanceType::L2Expanded>(
-        x, y, dist, m, n, k, workspace, handle.get_stream(), isRowMajor);
-      break;
-    case raft::distance::DistanceType::L2SqrtExpanded:
-      detail::pairwise_distance_impl<Type, Index_, raft::distance::DistanceType::L2SqrtExpanded>(
-        x, y, dist, m, n, k, workspace, handle.get_stream(), isRowMajor);
-      break;
-    case raft::distance::DistanceType::CosineExpanded:
-      detail::pairwise_distance_impl<Type, Index_, raft::distance::DistanceType::CosineExpanded>(
-        x, y, dist, m, n, k, workspace, handle.get_stream(), isRowMajor);
-      break;
-    case raft::distance::DistanceType::L1:
-      detail::pairwise_distance_impl<Type, Index_, raft::distance::DistanceType::L1>(
-        x, y, dist, m, n, k, workspace, handle.get_stream(), isRowMajor);
-      break;
-    case raft::distance::DistanceType::L2Unexpanded:
-      detail::pairwise_distance_impl<Type, Index_, raft::distance::DistanceType::L2Unexpanded>(
-        x, y, dist, m, n, k, workspace, handle.get_stream(), isRowMajor);
-      break;
-    case raft::distance::DistanceType::L2SqrtUnexpanded:
-      detail::pairwise_distance_impl<Type, Index_, raft::distance::DistanceType::L2SqrtUnexpanded>(
-        x, y, dist, m, n, k, workspace, handle.get_stream(), isRowMajor);
-      break;
-    case raft::distance::DistanceType::Linf:
-      detail::pairwise_distance_impl<Type, Index_, raft::distance::DistanceType::Linf>(
-        x, y, dist, m, n, k, workspace, handle.get_stream(), isRowMajor);
-      break;
-    case raft::distance::DistanceType::HellingerExpanded:
-      detail::pairwise_distance_impl<Type, Index_, raft::distance::DistanceType::HellingerExpanded>(
-        x, y, dist, m, n, k, workspace, handle.get_stream(), isRowMajor);
-      break;
-    case raft::distance::DistanceType::LpUnexpanded:
-      detail::pairwise_distance_impl<Type, Index_, raft::distance::DistanceType::LpUnexpanded>(
-        x, y, dist, m, n, k, workspace, handle.get_stream(), isRowMajor, metric_arg);
-      break;
-    case raft::distance::DistanceType::Canberra:
-      detail::pairwise_distance_impl<Type, Index_, raft::distance::DistanceType::Canberra>(
-        x, y, dist, m, n, k, workspace, handle.get_stream(), isRowMajor);
-      break;
-    case raft::distance::DistanceType::HammingUnexpanded:
-      detail::pairwise_distance_impl<Type, Index_, raft::distance::DistanceType::HammingUnexpanded>(
-        x, y, dist, m, n, k, workspace, handle.get_stream(), isRowMajor);
-      break;
-    case raft::distance::DistanceType::JensenShannon:
-      detail::pairwise_distance_impl<Type, Index_, raft::distance::DistanceType::JensenShannon>(
-        x, y, dist, m, n, k, workspace, handle.get_stream(), isRowMajor);
-      break;
-    case raft::distance::DistanceType::RusselRaoExpanded:
-      detail::pairwise_distance_impl<Type, Index_, raft::distance::DistanceType::RusselRaoExpanded>(
-        x, y, dist, m, n, k, workspace, handle.get_stream(), isRowMajor);
-      break;
-    case raft::distance::DistanceType::KLDivergence:
-      detail::pairwise_distance_impl<Type, Index_, raft::distance::DistanceType::KLDivergence>(
-        x, y, dist, m, n, k, workspace, handle.get_stream(), isRowMajor);
-      break;
-    case raft::distance::DistanceType::CorrelationExpanded:
-      detail::
-        pairwise_distance_impl<Type, Index_, raft::distance::DistanceType::CorrelationExpanded>(
-          x, y, dist, m, n, k, workspace, handle.get_stream(), isRowMajor);
-      break;
-    default: THROW("Unknown or unsupported distance metric '%d'!", (int)metric);
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "distance::pairwise_distance-%d (%d, %d, %d)", int(metric), int(m), int(n), int(k));
+  profiling_scope prof_scope(handle.get_profiler(), "pairwise_distance", handle.get_stream());
+  memory_scope mem_scope("pairwise_distance");
+
+  // tiny inputs: launch + sync overhead dominates, keep the request off the
+  // GPU; the gate is on total compute volume so the (blocking) host path never
+  // absorbs more than launch-overhead-scale arithmetic
+  if (size_t(m) * size_t(n) * size_t(k) <= detail::kPairwiseHostMaxFlop &&
+      size_t(m) * size_t(n) <= detail::kPairwiseHostMaxOutputElems &&
+      size_t(k) <= detail::kPairwiseHostMaxK && detail::pairwise_distance_host_supported(metric)) {
+    detail::pairwise_distance_host<Type, Index_>(handle, x, y, dist, m, n, k, metric, isRowMajor);
+    return;
+  }
+
+  detail::pairwise_distance_dispatch<Type, Index_>(
+    x, y, dist, m, n, k, workspace, metric, handle.get_stream(), isRowMajor, metric_arg);
+}
+
+/**
+ * @brief Evaluate pairwise distances with a fused user-supplied epilogue
+ *
+ * The epilogue functor is applied to every distance value inside the kernel's
+ * register tile before the write to global memory, so post-transforms such as
+ * exp(-d/sigma) or thresholding avoid a separate full read+write of the
+ * O(m*n) output buffer. See `raft/distance/epilogue.cuh` for ready-made
+ * composable functors; any callable with the signature
+ * <pre>OutType fin_op(AccType d, Index_ g_idx);</pre> works.
+ *
+ * @note The prebuilt kernels in `specializations/` only cover the identity
+ * epilogue; custom epilogues are compiled from headers at the call site.
+ *
+ * @tparam Type input/accumulation/output data-type
+ * @tparam FinalLambda epilogue functor type
+ * @tparam Index_ indexing type
+ * @param handle raft handle for managing expensive resources
+ * @param x first set of points
+ * @param y second set of points
+ * @param dist output distance matrix
+ * @param m number of points in x
+ * @param n number of points in y
+ * @param k dimensionality
+ * @param workspace temporary workspace buffer which can get resized as per the
+ * needed workspace size
+ * @param metric distance metric
+ * @param fin_op the epilogue applied to each distance value in-kernel
+ * @param isRowMajor whether the matrices are row-major or col-major
+ * @param metric_arg metric argument (used for Minkowski distance)
+ */
+template <typename Type, typename FinalLambda, typename Index_ = int>
+void pairwise_distance(const raft::handle_t& handle,
+                       const Type* x,
+                       const Type* y,
+                       Type* dist,
+                       Index_ m,
+                       Index_ n,
+                       Index_ k,
+                       rmm::device_uvector<char>& workspace,
+                       raft::distance::DistanceType metric,
+                       FinalLambda fin_op,
+                       bool isRowMajor = true,
+                       Type metric_arg = 2.0f)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "distance::pairwise_distance-%d (%d, %d, %d)", int(metric), int(m), int(n), int(k));
+  detail::pairwise_distance_dispatch<Type, Index_>(
+    x, y, dist, m, n, k, workspace, metric, handle.get_stream(), isRowMajor, fin_op, metric_arg);
+}
+
+/**
+ * @brief Evaluate pairwise distances with a fused bitset filter over y
+ *
+ * Distances to points of y whose bit in `mask` is cleared are replaced by
+ * `masked_fill` inside the distance kernel's register tile, so filtered
+ * search (deleted rows, tenant isolation) skips masked candidates in-register
+ * instead of compacting the dataset with an O(n) gather pass per batch. With
+ * the default fill of `std::numeric_limits<Type>::max()` a following top-k
+ * selection never picks a masked point.
+ *
+ * @note only row-major layout is supported; see `bitset_mask_epilogue`.
+ *
+ * @tparam Type input/accumulation/output data-type
+ * @tparam Index_ indexing type
+ * @param handle raft handle for managing expensive resources
+ * @param x first set of points
+ * @param y second set of points
+ * @param dist output distance matrix
+ * @param m number of points in x
+ * @param n number of points in y
+ * @param k dimensionality
+ * @param workspace temporary workspace buffer which can get resized as per the
+ * needed workspace size
+ * @param mask bitset over the n points of y; cleared bit = filtered out
+ * @param metric distance metric
+ * @param metric_arg metric argument (used for Minkowski distance)
+ * @param masked_fill value written for masked-out pairs
+ */
+template <typename Type, typename Index_ = int>
+void pairwise_distance_masked(const raft::handle_t& handle,
+                              const Type* x,
+                              const Type* y,
+                              Type* dist,
+                              Index_ m,
+                              Index_ n,
+                              Index_ k,
+                              rmm::device_uvector<char>& workspace,
+                              core::bitset_view<std::uint32_t> mask,
+                              raft::distance::DistanceType metric,
+                              Type metric_arg  = 2.0f,
+                              Type masked_fill = std::numeric_limits<Type>::max())
+{
+  RAFT_EXPECTS(mask.size() >= static_cast<std::uint32_t>(n),
+               "pairwise_distance_masked: mask must cover all n points of y");
+  bitset_mask_epilogue<Type, Index_> fin_op{mask, n, masked_fill};
+  pairwise_distance<Type, bitset_mask_epilogue<Type, Index_>, Index_>(
+    handle, x, y, dist, m, n, k, workspace, metric, fin_op, true, metric_arg);
+}
+
+/**
+ * @brief Evaluate pairwise distances by splitting the output into row-tiles
+ * and dispatching the tiles across the streams of the handle's stream pool
+ *
+ * Each tile computes distances between a contiguous block of rows of x and
+ * the full y matrix, so large distance matrices can overlap workspace setup,
+ * main compute and epilogue phases across streams. The stream pool is made to
+ * wait on the handle's main stream before the tiles are launched and the main
+ * stream waits on the pool once all tiles are issued, so this call is
+ * stream-ordered with respect to `handle.get_stream()` just like the
+ * single-stream variant. Falls back to the single-stream path when no stream
+ * pool was initialized on the handle (or it holds fewer than two streams).
+ *
+ * @tparam Type input/accumulation/output data-type
+ * @tparam Index_ indexing type
+ * @param handle raft handle for managing expensive resources
+ * @param x first set of points (size m*k)
+ * @param y second set of points (size n*k)
+ * @param dist output distance matrix (size m*n)
+ * @param m number of points in x
+ * @param n number of points in y
+ * @param k dimensionality
+ * @param metric distance metric
+ * @param isRowMajor whether the matrices are row-major or col-major
+ * @param metric_arg metric argument (used for Minkowski distance)
+ */
+template <typename Type, typename Index_ = int>
+void pairwise_distance_tiled(const raft::handle_t& handle,
+                             const Type* x,
+                             const Type* y,
+                             Type* dist,
+                             Index_ m,
+                             Index_ n,
+                             Index_ k,
+                             raft::distance::DistanceType metric,
+                             bool isRowMajor = true,
+                             Type metric_arg = 2.0f)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "distance::pairwise_distance_tiled-%d (%d, %d, %d)", int(metric), int(m), int(n), int(k));
+  auto n_streams = handle.get_stream_pool_size();
+  // tiling the output rows requires both x and dist tiles to be contiguous,
+  // which only holds for row-major inputs
+  if (n_streams < 2 || !isRowMajor) {
+    pairwise_distance<Type, Index_>(handle, x, y, dist, m, n, k, metric, isRowMajor, metric_arg);
+    return;
+  }
+
+  Index_ tile_rows = raft::ceildiv<Index_>(m, static_cast<Index_>(n_streams));
+  handle.wait_stream_pool_on_stream();
+  for (std::size_t i = 0; i < n_streams; i++) {
+    Index_ offset = static_cast<Index_>(i) * tile_rows;
+    if (offset >= m) break;
+    Index_ rows = std::min(tile_rows, m - offset);
+    auto stream = handle.get_stream_from_stream_pool(i);
+    rmm::device_uvector<char> workspace(0, stream);
+    detail::pairwise_distance_dispatch<Type, Index_>(x + offset * k,
+                                                     y,
+                                                     dist + offset * n,
+                                                     rows,
+                                                     n,
+                                                     k,
+                                                     workspace,
+                                                     metric,
+                                                     stream,
+                                                     isRowMajor,
+                                                     metric_arg);
+  }
+  handle.sync_stream_pool();
+}
+
+/**
+ * @brief Evaluate pairwise distances out-of-core, streaming output tiles to a
+ * host-side sink
+ *
+ * The m*n output of an all-pairs job can exceed device (or even host) memory
+ * long before the inputs do. This driver never materializes the full output:
+ * it walks the output in `tile_m` x `tile_n` blocks, computes each block with
+ * the regular distance kernels into a device buffer, copies it into pinned
+ * host staging memory and hands it to `tile_sink`. Two buffer sets are cycled
+ * so the compute and D2H copy of one tile overlap the sink consuming the
+ * previous one; with a stream pool initialized on the handle the two sets run
+ * on separate streams.
+ *
+ * The sink is any host-side callable with the signature
+ * <pre>void tile_sink(const Type* tile, Index_ row_offset, Index_ col_offset,
+ *                     Index_ n_rows, Index_ n_cols);</pre>
+ * `tile` points to a row-major n_rows x n_cols block of pinned host memory
+ * holding distances between x rows [row_offset, row_offset + n_rows) and y
+ * rows [col_offset, col_offset + n_cols). The pointer is only valid for the
+ * duration of the call; the sink must copy or consume the data before
+ * returning.
+ *
+ * @tparam Type input/accumulation/output data-type
+ * @tparam TileSink host-side tile consumer type
+ * @tparam Index_ indexing type
+ * @param handle raft handle for managing expensive resources
+ * @param x first set of points (size m*k, row-major)
+ * @param y second set of points (size n*k, row-major)
+ * @param m number of points in x
+ * @param n number of points in y
+ * @param k dimensionality
+ * @param tile_m output tile height (rows of x per tile)
+ * @param tile_n output tile width (rows of y per tile)
+ * @param metric distance metric
+ * @param tile_sink host-side callable receiving each finished tile
+ * @param metric_arg metric argument (used for Minkowski distance)
+ */
+template <typename Type, typename TileSink, typename Index_ = int>
+void pairwise_distance_out_of_core(const raft::handle_t& handle,
+                                   const Type* x,
+                                   const Type* y,
+                                   Index_ m,
+                                   Index_ n,
+                                   Index_ k,
+                                   Index_ tile_m,
+                                   Index_ tile_n,
+                                   raft::distance::DistanceType metric,
+                                   TileSink tile_sink,
+                                   Type metric_arg = 2.0f)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "distance::pairwise_distance_out_of_core-%d (%d, %d, %d)", int(metric), int(m), int(n), int(k));
+  RAFT_EXPECTS(tile_m > 0 && tile_n > 0, "tile dimensions must be positive");
+
+  cudaStream_t streams[2];
+  streams[0] = handle.get_stream();
+  if (handle.get_stream_pool_size() > 0) {
+    handle.wait_stream_pool_on_stream();
+    streams[1] = handle.get_stream_from_stream_pool(0);
+  } else {
+    streams[1] = streams[0];
+  }
+
+  std::size_t tile_size = static_cast<std::size_t>(tile_m) * tile_n;
+  rmm::device_uvector<Type> dev_tile[2] = {{tile_size, streams[0]}, {tile_size, streams[1]}};
+  rmm::device_uvector<char> workspace[2] = {{0, streams[0]}, {0, streams[1]}};
+  std::vector<Type, raft::detail::pinned_allocator<Type>> host_tile[2] = {
+    std::vector<Type, raft::detail::pinned_allocator<Type>>(tile_size),
+    std::vector<Type, raft::detail::pinned_allocator<Type>>(tile_size)};
+
+  // coordinates of the tile currently in flight on each buffer set
+  bool pending[2] = {false, false};
+  Index_ pend_ro[2], pend_co[2], pend_rows[2], pend_cols[2];
+
+  auto drain = [&](int slot) {
+    RAFT_CUDA_TRY(cudaStreamSynchronize(streams[slot]));
+    tile_sink(host_tile[slot].data(),
+              pend_ro[slot],
+              pend_co[slot],
+              pend_rows[slot],
+              pend_cols[slot]);
+    pending[slot] = false;
   };
+
+  std::size_t t = 0;
+  for (Index_ ro = 0; ro < m; ro += tile_m) {
+    Index_ rows = std::min(tile_m, m - ro);
+    for (Index_ co = 0; co < n; co += tile_n, t++) {
+      Index_ cols = std::min(tile_n, n - co);
+      int slot    = t % 2;
+      if (pending[slot]) { drain(slot); }
+      detail::pairwise_distance_dispatch<Type, Index_>(x + ro * k,
+                                                       y + co * k,
+                                                       dev_tile[slot].data(),
+                                                       rows,
+                                                       cols,
+                                                       k,
+                                                       workspace[slot],
+                                                       metric,
+                                                       streams[slot],
+                                                       true,
+                                                       metric_arg);
+      raft::copy(host_tile[slot].data(),
+                 dev_tile[slot].data(),
+                 static_cast<std::size_t>(rows) * cols,
+                 streams[slot]);
+      pending[slot]   = true;
+      pend_ro[slot]   = ro;
+      pend_co[slot]   = co;
+      pend_rows[slot] = rows;
+      pend_cols[slot] = cols;
+    }
+  }
+  for (int slot = 0; slot < 2; slot++) {
+    if (pending[slot]) { drain(slot); }
+  }
+}
+
+/**
+ * @brief Evaluate pairwise distances routing the inner-product phase through
+ * the tensor cores where the device supports it
+ *
+ * The expanded L2 and cosine distances decompose into a dot-product matrix
+ * plus a norm-based elementwise epilogue. This entry point computes the
+ * dot-product phase with a cublas GEMM -- which runs on the tensor cores
+ * (TF32 for fp32 inputs) on Ampere and newer -- and applies the epilogue in a
+ * single elementwise pass. For unsupported metrics, non-fp32 types or older
+ * devices this falls back to the regular fused tiled kernels, so it is always
+ * safe to call.
+ *
+ * @note TF32 carries a ~10-bit mantissa; callers needing full fp32
+ * accumulation in the dot products should use `pairwise_distance` instead.
+ *
+ * @tparam Type input/accumulation/output data-type
+ * @tparam Index_ indexing type
+ * @param handle raft handle for managing expensive resources
+ * @param x first set of points (size m*k)
+ * @param y second set of points (size n*k)
+ * @param dist output distance matrix (size m*n)
+ * @param m number of points in x
+ * @param n number of points in y
+ * @param k dimensionality
+ * @param metric distance metric
+ * @param isRowMajor whether the matrices are row-major or col-major
+ * @param metric_arg metric argument (used for Minkowski distance)
+ */
+template <typename Type, typename Index_ = int>
+void pairwise_distance_tensor_ops(const raft::handle_t& handle,
+                                  const Type* x,
+                                  const Type* y,
+                                  Type* dist,
+                                  Index_ m,
+                                  Index_ n,
+                                  Index_ k,
+                                  raft::distance::DistanceType metric,
+                                  bool isRowMajor = true,
+                                  Type metric_arg = 2.0f)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "distance::pairwise_distance_tensor_ops-%d (%d, %d, %d)", int(metric), int(m), int(n), int(k));
+  bool gemm_metric = metric == DistanceType::L2Expanded ||
+                     metric == DistanceType::L2SqrtExpanded ||
+                     metric == DistanceType::CosineExpanded;
+  bool has_tensor_ops = handle.get_device_properties().major >= 8;
+  if (std::is_same<Type, float>::value && gemm_metric && has_tensor_ops) {
+    detail::gemmDistance<Type, Index_>(
+      handle, x, y, dist, m, n, k, metric, raft::Nop<Type, Index_>(), true, isRowMajor);
+  } else {
+    pairwise_distance<Type, Index_>(handle, x, y, dist, m, n, k, metric, isRowMajor, metric_arg);
+  }
 }
 
 /**
@@ -401,6 +709,84 @@ void pairwise_distance(const raft::handle_t& handle,
     handle, x, y, dist, m, n, k, workspace, metric, isRowMajor, metric_arg);
 }
 
+/**
+ * @brief Evaluate pairwise distances against a norms-caching index
+ *
+ * The index holds the `y` side of the computation along with its precomputed
+ * row norms, so only the query-side norms are computed per call. This is the
+ * expanded-form fast path for datasets that are queried repeatedly; the metric
+ * is the one the index was built with (see `norms_index_t::supports`).
+ *
+ * @tparam Type input/accumulation/output data-type
+ * @tparam Index_ indexing type
+ * @param handle raft handle for managing expensive resources
+ * @param index norms-caching index built over the dataset
+ * @param x the query points (size m * index.n_cols(), same layout as the index)
+ * @param dist output distance matrix (size m * index.n_rows())
+ * @param m number of query points
+ */
+template <typename Type, typename Index_ = int>
+void pairwise_distance(const raft::handle_t& handle,
+                       const norms_index_t<Type, Index_>& index,
+                       const Type* x,
+                       Type* dist,
+                       Index_ m)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "distance::pairwise_distance-index-%d (%d, %d, %d)",
+    int(index.metric()),
+    int(m),
+    int(index.n_rows()),
+    int(index.n_cols()));
+  auto stream      = handle.get_stream();
+  Index_ n         = index.n_rows();
+  Index_ k         = index.n_cols();
+  bool isRowMajor  = index.is_row_major();
+  auto metric      = index.metric();
+
+  rmm::device_uvector<Type> query_norms(m, stream);
+  if (metric == DistanceType::CosineExpanded) {
+    raft::linalg::rowNorm(query_norms.data(),
+                          x,
+                          k,
+                          m,
+                          raft::linalg::L2Norm,
+                          isRowMajor,
+                          stream,
+                          detail::sqrt_norm_op<Type>{});
+  } else {
+    raft::linalg::rowNorm(query_norms.data(), x, k, m, raft::linalg::L2Norm, isRowMajor, stream);
+  }
+
+  switch (metric) {
+    case DistanceType::L2Expanded:
+    case DistanceType::L2SqrtExpanded: {
+      bool enable_sqrt = metric == DistanceType::L2SqrtExpanded;
+      auto fin_op      = raft::Nop<Type, Index_>();
+      if (isRowMajor) {
+        detail::euclideanExp<Type, Type, Type, Index_, decltype(fin_op), true>(
+          m, n, k, k, k, n, x, index.data(), query_norms.data(), index.norms(), enable_sqrt, dist, fin_op, stream);
+      } else {
+        detail::euclideanExp<Type, Type, Type, Index_, decltype(fin_op), false>(
+          n, m, k, n, m, m, index.data(), x, index.norms(), query_norms.data(), enable_sqrt, dist, fin_op, stream);
+      }
+      break;
+    }
+    case DistanceType::CosineExpanded: {
+      auto fin_op = [] __device__(Type d_val, Index_) { return static_cast<Type>(1.0) - d_val; };
+      if (isRowMajor) {
+        detail::cosine<Type, Type, Type, Index_, decltype(fin_op), true>(
+          m, n, k, k, k, n, x, index.data(), query_norms.data(), index.norms(), dist, fin_op, stream);
+      } else {
+        detail::cosine<Type, Type, Type, Index_, decltype(fin_op), false>(
+          n, m, k, n, m, m, index.data(), x, index.norms(), query_norms.data(), dist, fin_op, stream);
+      }
+      break;
+    }
+    default: RAFT_FAIL("norms_index_t does not support metric %d", static_cast<int>(metric));
+  }
+}
+
 /**
  * @brief Convenience wrapper around 'distance' prim to convert runtime metric
  * into compile time for the purpose of dispatch
@@ -449,6 +835,156 @@ void pairwise_distance(raft::handle_t const& handle,
                     metric_arg);
 }
 
+/**
+ * @brief Evaluate pairwise distances on strided matrix views without compaction
+ *
+ * Overload for `layout_stride` views, e.g. row windows sliced out of larger
+ * row-major matrices. The leading dimensions are passed straight to the
+ * contraction tiles, so no gather/copy of the submatrix is performed. All
+ * views must be row-major with unit stride along columns; supported metrics
+ * are the L2 family, L1 and Linf (cf.
+ * `detail::pairwise_distance_strided_dispatch`).
+ *
+ * @tparam Type input/accumulation/output data-type
+ * @tparam Index_ indexing type
+ * @param handle raft handle for managing expensive resources
+ * @param x first set of points (size m*k, row stride >= k)
+ * @param y second set of points (size n*k, row stride >= k)
+ * @param dist output distance matrix (size m*n, row stride >= n)
+ * @param metric distance metric
+ */
+template <typename Type, typename Index_ = int>
+void pairwise_distance(raft::handle_t const& handle,
+                       device_matrix_view<Type, layout_stride> const x,
+                       device_matrix_view<Type, layout_stride> const y,
+                       device_matrix_view<Type, layout_stride> dist,
+                       raft::distance::DistanceType metric)
+{
+  RAFT_EXPECTS(x.extent(1) == y.extent(1), "Number of columns must be equal.");
+  RAFT_EXPECTS(dist.extent(0) == x.extent(0),
+               "Number of rows in output must be equal to "
+               "number of rows in X");
+  RAFT_EXPECTS(dist.extent(1) == y.extent(0),
+               "Number of columns in output must be equal to "
+               "number of rows in Y");
+  RAFT_EXPECTS(x.stride(1) == 1 && y.stride(1) == 1 && dist.stride(1) == 1,
+               "Strided inputs must be row-major with unit stride along columns.");
+
+  Index_ m   = x.extent(0);
+  Index_ n   = y.extent(0);
+  Index_ k   = x.extent(1);
+  Index_ lda = x.stride(0);
+  Index_ ldb = y.stride(0);
+  Index_ ldd = dist.stride(0);
+  RAFT_EXPECTS(lda >= k && ldb >= k && ldd >= n, "Row strides must cover a full row.");
+
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "distance::pairwise_distance-strided-%d (%d, %d, %d)", int(metric), int(m), int(n), int(k));
+  detail::pairwise_distance_strided_dispatch<Type, Index_>(
+    x.data(), y.data(), dist.data(), m, n, k, lda, ldb, ldd, metric, handle.get_stream());
+}
+
+/**
+ * @brief Evaluate self-join (x == y) pairwise distances computing only the
+ * upper triangle
+ *
+ * A symmetric all-pairs problem run through the rectangular entry points
+ * computes both triangles — twice the FLOPs and writes. This driver covers
+ * the upper triangle with row blocks, each a rectangular sub-problem against
+ * the remaining columns routed through the strided launchers, roughly
+ * halving the work (only the diagonal blocks compute redundant values, an
+ * overhead of ~block_rows / (2n)). With `mirror = true` (the default) a
+ * bandwidth-only pass copies the result into the strictly-lower triangle so
+ * the output matches the dense n x n matrix of the rectangular call; with
+ * `mirror = false` the strictly-lower triangle outside the diagonal blocks
+ * is left untouched for consumers that only read the upper triangle.
+ *
+ * Inputs must be row-major; supported metrics are those of the strided
+ * dispatch (the L2 family, L1 and Linf).
+ *
+ * @tparam Type input/accumulation/output data-type
+ * @tparam Index_ indexing type
+ * @param handle raft handle for managing expensive resources
+ * @param x the set of points (size n*k, row-major)
+ * @param dist output distance matrix (size n*n)
+ * @param n number of points in x
+ * @param k dimensionality
+ * @param metric distance metric
+ * @param mirror whether to mirror the upper triangle into the lower one
+ */
+template <typename Type, typename Index_ = int>
+void pairwise_distance_symmetric(const raft::handle_t& handle,
+                                 const Type* x,
+                                 Type* dist,
+                                 Index_ n,
+                                 Index_ k,
+                                 raft::distance::DistanceType metric,
+                                 bool mirror = true)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "distance::pairwise_distance_symmetric-%d (%d, %d)", int(metric), int(n), int(k));
+  profiling_scope prof_scope(
+    handle.get_profiler(), "pairwise_distance_symmetric", handle.get_stream());
+  memory_scope mem_scope("pairwise_distance_symmetric");
+
+  detail::pairwise_distance_symmetric_impl<Type, Index_>(
+    x, dist, n, k, metric, handle.get_stream(), mirror);
+}
+
+/**
+ * @brief Evaluate pairwise weighted L2 distances:
+ *   dist_ij = sum_k weights_k * (x_ik - y_jk)^2 (optionally square-rooted)
+ *
+ * The weight vector is folded into the tile accumulation of the
+ * unexpanded-L2 kernel, so neither input is scaled into a transformed
+ * copy beforehand. With `weights = 1 / diag(Sigma)` this is the
+ * Mahalanobis distance for a diagonal covariance; a dense covariance
+ * cannot be folded into the tile loads and still requires transforming
+ * the inputs by the inverse Cholesky factor before calling an L2 metric.
+ *
+ * This metric carries a device pointer argument and therefore cannot be
+ * routed through the scalar `metric_arg` of the `DistanceType` dispatch;
+ * it has its own entry point instead.
+ *
+ * @tparam Type input/accumulation/output data-type
+ * @tparam Index_ indexing type
+ * @param handle raft handle for managing expensive resources
+ * @param x first set of points (size m*k)
+ * @param y second set of points (size n*k)
+ * @param weights per-dimension weight vector on device (size k, non-negative)
+ * @param dist output distance matrix (size m*n)
+ * @param m number of points in x
+ * @param n number of points in y
+ * @param k dimensionality
+ * @param sqrt whether to apply a square root to every distance
+ * @param isRowMajor whether the matrices are row-major or col-major
+ */
+template <typename Type, typename Index_ = int>
+void weighted_l2_distance(const raft::handle_t& handle,
+                          const Type* x,
+                          const Type* y,
+                          const Type* weights,
+                          Type* dist,
+                          Index_ m,
+                          Index_ n,
+                          Index_ k,
+                          bool sqrt       = false,
+                          bool isRowMajor = true)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "distance::weighted_l2_distance (%d, %d, %d)", int(m), int(n), int(k));
+  auto stream = handle.get_stream();
+  if (sqrt) {
+    auto fin_op = [] __device__(Type d, Index_) { return raft::mySqrt(d); };
+    detail::weightedL2Impl<Type, Type, Type, decltype(fin_op), Index_>(
+      m, n, k, x, y, weights, dist, fin_op, stream, isRowMajor);
+  } else {
+    auto fin_op = [] __device__(Type d, Index_) { return d; };
+    detail::weightedL2Impl<Type, Type, Type, decltype(fin_op), Index_>(
+      m, n, k, x, y, weights, dist, fin_op, stream, isRowMajor);
+  }
+}
+
 };  // namespace distance
 };  // namespace raft
 
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __DISTANCE_EPILOGUE_H
+#define __DISTANCE_EPILOGUE_H
+
+#pragma once
+
+#include <raft/core/bitset.cuh>
+#include <raft/cuda_utils.cuh>
+
+namespace raft {
+namespace distance {
+
+/**
+ * @defgroup distance_epilogue composable distance epilogue functors
+ *
+ * Epilogue functors are applied to each distance value while it still lives
+ * in the kernel's register tile, before the write to global memory. Fusing a
+ * post-transform this way saves a full read+write of the O(m*n) output
+ * buffer compared to running it as a separate elementwise pass. Any functor
+ * with the signature `OutT op(AccT value, Index g_idx)` works; the types
+ * below cover common transforms and allow chaining via `compose_epilogue`.
+ *
+ * @{
+ */
+
+/** @brief Epilogue that passes distances through unchanged */
+struct identity_epilogue {
+  template <typename AccT, typename IdxT>
+  HDI AccT operator()(AccT d, IdxT) const
+  {
+    return d;
+  }
+};
+
+/**
+ * @brief Epilogue computing the RBF/Gaussian kernel exp(-d / sigma)
+ * @tparam OutT the distance value type
+ */
+template <typename OutT>
+struct gaussian_kernel_epilogue {
+  OutT sigma;
+
+  template <typename IdxT>
+  HDI OutT operator()(OutT d, IdxT) const
+  {
+    return raft::myExp(-d / sigma);
+  }
+};
+
+/**
+ * @brief Epilogue zeroing out values above a threshold
+ * @tparam OutT the distance value type
+ */
+template <typename OutT>
+struct threshold_epilogue {
+  OutT eps;
+
+  template <typename IdxT>
+  HDI OutT operator()(OutT d, IdxT) const
+  {
+    return d <= eps ? d : OutT{0};
+  }
+};
+
+/**
+ * @brief Epilogue replacing distances of masked-out columns with a fill value
+ *
+ * The mask is a word-packed `raft::core::bitset_view` over the points of y
+ * (the columns of a row-major output tile); a cleared bit means the point is
+ * filtered out and its distance is replaced by `fill` (typically
+ * `std::numeric_limits<OutT>::max()` so a following top-k never selects it).
+ * `offset` shifts the tested bit for callers that tile y and reuse one mask
+ * across tiles. Only meaningful for row-major output.
+ *
+ * @tparam OutT the distance value type
+ * @tparam IdxT indexing type of the distance kernel
+ */
+template <typename OutT, typename IdxT = int>
+struct bitset_mask_epilogue {
+  raft::core::bitset_view<std::uint32_t> mask;
+  IdxT n;
+  OutT fill;
+  IdxT offset = 0;
+
+  DI OutT operator()(OutT d, IdxT g_idx) const
+  {
+    return mask.test(static_cast<std::uint32_t>(g_idx % n + offset)) ? d : fill;
+  }
+};
+
+/**
+ * @brief Composition of two epilogues: applies `inner` first, then `outer`
+ *
+ * Build instances with `compose_epilogue` so the types are deduced.
+ */
+template <typename OuterOp, typename InnerOp>
+struct composed_epilogue {
+  OuterOp outer;
+  InnerOp inner;
+
+  template <typename AccT, typename IdxT>
+  HDI auto operator()(AccT d, IdxT g_idx) const
+  {
+    return outer(inner(d, g_idx), g_idx);
+  }
+};
+
+/** @brief Compose two epilogue functors; `inner` is applied first */
+template <typename OuterOp, typename InnerOp>
+auto compose_epilogue(OuterOp outer, InnerOp inner) -> composed_epilogue<OuterOp, InnerOp>
+{
+  return composed_epilogue<OuterOp, InnerOp>{outer, inner};
+}
+
+/** @} */
+
+}  // namespace distance
+}  // namespace raft
+
+#endif
@@ -116,6 +116,75 @@ void fusedL2NN(OutT* min,
   }
 }
 
+/**
+ * @brief Fused L2 distance and k-nearest-neighbors computation for small k.
+ *
+ * Generalization of fusedL2NN to the numK (<= 4) nearest neighbors of each
+ * row of `x`: the k-best list is kept in registers inside the same fused
+ * tile loop, so no intermediate m x n distance buffer is materialized and
+ * no separate select-k pass over it is needed. Intended for soft
+ * assignment and multi-centroid k-means variants where only a handful of
+ * neighbors are required.
+ *
+ * @tparam DataT     data type
+ * @tparam IdxT      indexing arithmetic type
+ *
+ * @param[out] min           will contain the reduced output, the numK
+ *                           nearest neighbors of each row of `x` sorted by
+ *                           ascending distance (Length = `m * numK`)
+ *                           (on device)
+ * @param[in]  x             first matrix. Row major. Dim = `m x k`.
+ *                           (on device).
+ * @param[in]  y             second matrix. Row major. Dim = `n x k`.
+ *                           (on device).
+ * @param[in]  xn            L2 squared norm of `x`. Length = `m`. (on device).
+ * @param[in]  yn            L2 squared norm of `y`. Length = `n`. (on device)
+ * @param[in]  m             gemm m
+ * @param[in]  n             gemm n
+ * @param[in]  k             gemm k
+ * @param[in]  numK          number of nearest neighbors to keep (1 to 4)
+ * @param[in]  workspace     temp workspace. Size = sizeof(int)*m. (on device)
+ * @param[in]  sqrt          Whether the output distances should contain L2-sqrt
+ * @param[in]  initOutBuffer whether to initialize the output buffer before the
+ *                           main kernel launch
+ * @param[in]  stream        cuda stream
+ */
+template <typename DataT, typename IdxT>
+void fusedL2KnnSmallK(cub::KeyValuePair<IdxT, DataT>* min,
+                      const DataT* x,
+                      const DataT* y,
+                      const DataT* xn,
+                      const DataT* yn,
+                      IdxT m,
+                      IdxT n,
+                      IdxT k,
+                      IdxT numK,
+                      void* workspace,
+                      bool sqrt,
+                      bool initOutBuffer,
+                      cudaStream_t stream)
+{
+  RAFT_EXPECTS(numK >= 1 && numK <= 4, "fusedL2KnnSmallK: numK must be in [1, 4]");
+  switch (numK) {
+    case 1:
+      detail::fusedL2KnnSmallKDispatch<DataT, IdxT, 1>(
+        min, x, y, xn, yn, m, n, k, (int*)workspace, sqrt, initOutBuffer, stream);
+      break;
+    case 2:
+      detail::fusedL2KnnSmallKDispatch<DataT, IdxT, 2>(
+        min, x, y, xn, yn, m, n, k, (int*)workspace, sqrt, initOutBuffer, stream);
+      break;
+    case 3:
+      detail::fusedL2KnnSmallKDispatch<DataT, IdxT, 3>(
+        min, x, y, xn, yn, m, n, k, (int*)workspace, sqrt, initOutBuffer, stream);
+      break;
+    default:
+      detail::fusedL2KnnSmallKDispatch<DataT, IdxT, 4>(
+        min, x, y, xn, yn, m, n, k, (int*)workspace, sqrt, initOutBuffer, stream);
+      break;
+  }
+}
+
 }  // namespace distance
 }  // namespace raft
 
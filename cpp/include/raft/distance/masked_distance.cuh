@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __MASKED_DISTANCE_H
+#define __MASKED_DISTANCE_H
+
+#pragma once
+
+#include <raft/distance/detail/masked_distance.cuh>
+#include <raft/distance/distance_type.hpp>
+#include <raft/handle.hpp>
+
+namespace raft {
+namespace distance {
+
+/**
+ * @brief Compute distances for an explicit candidate list of pairs only
+ *
+ * ANN re-ranking needs exact distances between each query and a short list of
+ * candidate rows, for which a dense m*n `pairwise_distance` computes orders of
+ * magnitude more values than get read. This variant takes the candidate list
+ * in the CSR layout used throughout `raft::sparse` -- `indptr` of length m+1
+ * over the query rows and `indices` holding candidate rows of y -- and writes
+ * one distance per candidate into `out`, aligned with `indices` (i.e. the
+ * values array of the same CSR structure).
+ *
+ * Supported metrics: L2Expanded, L2SqrtExpanded, L2Unexpanded,
+ * L2SqrtUnexpanded, L1, InnerProduct and CosineExpanded. The L2 distances are
+ * always computed in the unexpanded (difference) form since there is no dense
+ * inner product to amortize on a short candidate list.
+ *
+ * @tparam value_t input/output data-type
+ * @tparam value_idx indexing type
+ * @param handle raft handle for managing expensive resources
+ * @param x query points (size m*k, row-major)
+ * @param y dataset points (size n*k, row-major)
+ * @param m number of query points
+ * @param n number of dataset points
+ * @param k dimensionality
+ * @param indptr CSR row offsets into indices, one entry per query row plus one
+ * (size m+1)
+ * @param indices candidate rows of y for each query (size nnz)
+ * @param nnz total number of candidate pairs
+ * @param out output distances aligned with indices (size nnz)
+ * @param metric distance metric
+ */
+template <typename value_t, typename value_idx = int>
+void masked_pairwise_distance(const raft::handle_t& handle,
+                              const value_t* x,
+                              const value_t* y,
+                              value_idx m,
+                              value_idx n,
+                              value_idx k,
+                              const value_idx* indptr,
+                              const value_idx* indices,
+                              value_idx nnz,
+                              value_t* out,
+                              raft::distance::DistanceType metric)
+{
+  detail::maskedDistanceImpl<value_t, value_idx>(
+    handle, x, y, m, n, k, indptr, indices, nnz, out, metric);
+}
+
+}  // namespace distance
+}  // namespace raft
+
+#endif
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __NORMS_INDEX_H
+#define __NORMS_INDEX_H
+
+#pragma once
+
+#include <raft/cuda_utils.cuh>
+#include <raft/distance/distance_type.hpp>
+#include <raft/handle.hpp>
+#include <raft/linalg/norm.cuh>
+
+#include <rmm/device_uvector.hpp>
+
+namespace raft {
+namespace distance {
+
+namespace detail {
+
+/** final op for rowNorm producing the square-rooted L2 norms used by cosine */
+template <typename Type>
+struct sqrt_norm_op {
+  HDI Type operator()(Type in) const { return raft::mySqrt(in); }
+};
+
+}  // namespace detail
+
+/**
+ * @brief Precomputed row norms for a static dataset that is queried repeatedly
+ *
+ * The expanded distance kernels (L2 expanded and cosine) need the row norms of
+ * both inputs, so every call against the same dataset pays for a norm kernel
+ * over the full dataset again. This object computes the dataset-side norms
+ * once at construction; the index-aware overloads of `pairwise_distance` and
+ * `brute_force_knn` then only compute the (typically much smaller) query-side
+ * norms per call.
+ *
+ * Norms are stored the way the corresponding kernel consumes them: squared L2
+ * row norms for `L2Expanded`/`L2SqrtExpanded` and square-rooted L2 row norms
+ * for `CosineExpanded`.
+ *
+ * @note the index does not own the dataset; the `data` pointer must stay valid
+ * (and unmodified) for the lifetime of the index.
+ *
+ * @tparam value_t data type of the dataset
+ * @tparam idx_t indexing type
+ */
+template <typename value_t = float, typename idx_t = int>
+class norms_index_t {
+ public:
+  /**
+   * @param handle raft handle; norms are computed on `handle.get_stream()`
+   * @param data the dataset (size n_rows * n_cols)
+   * @param n_rows number of dataset points
+   * @param n_cols dimensionality of the dataset
+   * @param metric the metric the index will be queried with
+   * @param row_major whether `data` is in row-major layout
+   */
+  norms_index_t(const raft::handle_t& handle,
+                const value_t* data,
+                idx_t n_rows,
+                idx_t n_cols,
+                DistanceType metric = DistanceType::L2Expanded,
+                bool row_major      = true)
+    : data_(data),
+      n_rows_(n_rows),
+      n_cols_(n_cols),
+      metric_(metric),
+      row_major_(row_major),
+      norms_(n_rows, handle.get_stream())
+  {
+    RAFT_EXPECTS(supports(metric),
+                 "norms_index_t: only the expanded L2 and cosine metrics consume "
+                 "precomputed norms");
+    auto stream = handle.get_stream();
+    if (metric == DistanceType::CosineExpanded) {
+      raft::linalg::rowNorm(norms_.data(),
+                            data,
+                            n_cols,
+                            n_rows,
+                            raft::linalg::L2Norm,
+                            row_major,
+                            stream,
+                            detail::sqrt_norm_op<value_t>{});
+    } else {
+      raft::linalg::rowNorm(
+        norms_.data(), data, n_cols, n_rows, raft::linalg::L2Norm, row_major, stream);
+    }
+  }
+
+  /** whether precomputed norms benefit the given metric */
+  static bool supports(DistanceType metric)
+  {
+    return metric == DistanceType::L2Expanded || metric == DistanceType::L2SqrtExpanded ||
+           metric == DistanceType::CosineExpanded;
+  }
+
+  /** pointer to the (unowned) dataset */
+  const value_t* data() const { return data_; }
+  /** device pointer to the precomputed row norms (size n_rows) */
+  const value_t* norms() const { return norms_.data(); }
+  idx_t n_rows() const { return n_rows_; }
+  idx_t n_cols() const { return n_cols_; }
+  DistanceType metric() const { return metric_; }
+  bool is_row_major() const { return row_major_; }
+
+ private:
+  const value_t* data_;
+  idx_t n_rows_;
+  idx_t n_cols_;
+  DistanceType metric_;
+  bool row_major_;
+  rmm::device_uvector<value_t> norms_;
+};
+
+}  // namespace distance
+}  // namespace raft
+
+#endif
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <raft/cuda_utils.cuh>
+#include <raft/distance/detail/fixed_dim_distance.cuh>
+
+namespace raft {
+namespace distance {
+namespace detail {
+extern template void fixed_dim_pairwise_distance<float, int, raft::Nop<float, int>>(
+  const float* x,
+  const float* y,
+  float* dist,
+  int m,
+  int n,
+  int k,
+  raft::distance::DistanceType metric,
+  raft::Nop<float, int> fin_op,
+  cudaStream_t stream);
+
+extern template void fixed_dim_pairwise_distance<double, int, raft::Nop<double, int>>(
+  const double* x,
+  const double* y,
+  double* dist,
+  int m,
+  int n,
+  int k,
+  raft::distance::DistanceType metric,
+  raft::Nop<double, int> fin_op,
+  cudaStream_t stream);
+
+extern template void
+fixed_dim_pairwise_distance<float, std::uint32_t, raft::Nop<float, std::uint32_t>>(
+  const float* x,
+  const float* y,
+  float* dist,
+  std::uint32_t m,
+  std::uint32_t n,
+  std::uint32_t k,
+  raft::distance::DistanceType metric,
+  raft::Nop<float, std::uint32_t> fin_op,
+  cudaStream_t stream);
+
+}  // namespace detail
+}  // namespace distance
+}  // namespace raft
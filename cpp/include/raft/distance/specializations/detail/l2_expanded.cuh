@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <cuda_fp16.h>
 #include <raft/distance/detail/distance.cuh>
 
 namespace raft {
@@ -61,6 +62,20 @@ distance<raft::distance::DistanceType::L2Expanded, float, float, float, std::uin
   bool isRowMajor,
   float metric_arg);
 
+extern template void
+distance<raft::distance::DistanceType::L2Expanded, __half, float, float, int>(
+  const __half* x,
+  const __half* y,
+  float* dist,
+  int m,
+  int n,
+  int k,
+  void* workspace,
+  size_t worksize,
+  cudaStream_t stream,
+  bool isRowMajor,
+  __half metric_arg);
+
 }  // namespace detail
 }  // namespace distance
 }  // namespace raft
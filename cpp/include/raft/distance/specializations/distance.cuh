@@ -20,6 +20,7 @@
 #include <raft/distance/specializations/detail/chebyshev.cuh>
 #include <raft/distance/specializations/detail/correlation.cuh>
 #include <raft/distance/specializations/detail/cosine.cuh>
+#include <raft/distance/specializations/detail/fixed_dim.cuh>
 #include <raft/distance/specializations/detail/hamming_unexpanded.cuh>
 #include <raft/distance/specializations/detail/hellinger_expanded.cuh>
 #include <raft/distance/specializations/detail/jensen_shannon.cuh>
@@ -23,9 +23,16 @@
  *
  */
 
+#include <cstdint>
 #include <stdexcept>
 #include <type_traits>
 
+#if defined(__CUDACC__)
+#define RAFT_INTEGER_HD __host__ __device__ __forceinline__
+#else
+#define RAFT_INTEGER_HD inline
+#endif
+
 namespace raft {
 //! Utility functions
 /**
@@ -161,4 +168,80 @@ std::enable_if_t<!std::is_signed<T>::value, T> constexpr inline absolute_value(T
   return value;
 }
 
+/**
+ * @brief Division and modulo by a runtime divisor via precomputed magic numbers.
+ *
+ * Hardware integer division costs tens of instructions on the GPU; when the
+ * divisor is loop-invariant (a row stride, a bin count) it pays to precompute
+ * a magic multiplier and shift once on the host and reduce every per-element
+ * div/mod to a multiply-high plus shift on the device. The struct is trivially
+ * copyable, so it can be passed to kernels by value.
+ *
+ * The results are exact for dividends in [0, 2^31); the divisor must be in
+ * [1, 2^31).
+ *
+ * @code
+ *   raft::fast_div_mod cols(n_cols);  // on the host, once
+ *   // in the kernel:
+ *   auto row = cols.div(idx);
+ *   auto col = cols.mod(idx);
+ * @endcode
+ */
+struct fast_div_mod {
+  uint32_t divisor{1};
+  uint32_t magic{0};
+  uint32_t shift{0};
+
+  constexpr fast_div_mod() = default;
+
+  /** Precomputes the magic multiplier for `_divisor`; host-only. */
+  explicit fast_div_mod(uint32_t _divisor) : divisor(_divisor)
+  {
+    if (divisor == 0) { throw std::invalid_argument("fast_div_mod: divisor must be positive"); }
+    // magic == 0 encodes divisors without a 32-bit magic number (1 and >= 2^31);
+    // div()/mod() then fall back to hardware division
+    if (divisor == 1 || divisor >= (uint32_t{1} << 31)) { return; }
+    uint32_t log2 = 0;
+    while ((uint32_t{1} << log2) < divisor) {
+      ++log2;
+    }
+    // magic = ceil(2^(31 + log2) / divisor) fits in 32 bits since divisor >= 2
+    magic = uint32_t(((uint64_t{1} << (31 + log2)) + divisor - 1) / divisor);
+    shift = log2 - 1;
+  }
+
+  /** quotient n / divisor; exact for n < 2^31 */
+  RAFT_INTEGER_HD uint32_t div(uint32_t n) const
+  {
+    if (magic == 0) { return divisor == 1 ? n : n / divisor; }
+#if defined(__CUDA_ARCH__)
+    return __umulhi(n, magic) >> shift;
+#else
+    return uint32_t((uint64_t{n} * magic) >> 32) >> shift;
+#endif
+  }
+
+  /** remainder n % divisor; exact for n < 2^31 */
+  RAFT_INTEGER_HD uint32_t mod(uint32_t n) const { return n - div(n) * divisor; }
+
+  /**
+   * Computes quotient and remainder in one go, reusing the multiply. Works for
+   * any non-negative `n` of a wider integer type: dividends at or above 2^31
+   * (where the magic approximation stops being exact) take a hardware-division
+   * fallback, a branch that compiles out entirely for 32-bit index types.
+   */
+  template <typename I>
+  RAFT_INTEGER_HD void divmod(I n, I& quotient, I& remainder) const
+  {
+    if (sizeof(I) > 4 && uint64_t(n) >= (uint64_t{1} << 31)) {
+      quotient  = n / I(divisor);
+      remainder = n - quotient * I(divisor);
+    } else {
+      uint32_t q = div(uint32_t(n));
+      quotient   = I(q);
+      remainder  = I(uint32_t(n) - q * divisor);
+    }
+  }
+};
+
 }  // namespace raft
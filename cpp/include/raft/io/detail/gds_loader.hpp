@@ -0,0 +1,384 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/core/error.hpp>
+#include <raft/core/handle.hpp>
+#include <raft/cudart_utils.h>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(RAFT_ENABLE_CUFILE)
+#include <cufile.h>
+#endif
+
+namespace raft {
+namespace io {
+namespace detail {
+
+/** Reads exactly `len` bytes at `offset`, retrying short reads. */
+inline void pread_full(int fd, void* buf, size_t len, off_t offset)
+{
+  char* p = static_cast<char*>(buf);
+  while (len > 0) {
+    ssize_t n = pread(fd, p, len, offset);
+    RAFT_EXPECTS(n > 0, "raft::io: pread failed: %s", strerror(errno));
+    p += n;
+    offset += n;
+    len -= static_cast<size_t>(n);
+  }
+}
+
+/**
+ * RAII wrapper over an open dataset file. When cuFile support is compiled
+ * in, the file is opened with O_DIRECT and registered with the cuFile
+ * driver so reads can go straight from NVMe to device memory.
+ */
+class file_reader {
+ public:
+  explicit file_reader(const std::string& path)
+  {
+#if defined(RAFT_ENABLE_CUFILE)
+    fd_ = open(path.c_str(), O_RDONLY | O_DIRECT);
+#else
+    fd_ = open(path.c_str(), O_RDONLY);
+#endif
+    RAFT_EXPECTS(fd_ >= 0, "raft::io: failed to open '%s': %s", path.c_str(), strerror(errno));
+
+    struct stat st;
+    RAFT_EXPECTS(
+      fstat(fd_, &st) == 0, "raft::io: fstat('%s') failed: %s", path.c_str(), strerror(errno));
+    size_ = static_cast<size_t>(st.st_size);
+
+#if defined(RAFT_ENABLE_CUFILE)
+    CUfileDescr_t descr;
+    std::memset(&descr, 0, sizeof(descr));
+    descr.handle.fd = fd_;
+    descr.type      = CU_FILE_HANDLE_TYPE_OPAQUE_FD;
+    // the driver is opened implicitly on first registration
+    auto status = cuFileHandleRegister(&cf_handle_, &descr);
+    RAFT_EXPECTS(status.err == CU_FILE_SUCCESS,
+                 "raft::io: cuFileHandleRegister('%s') failed (err=%d)",
+                 path.c_str(),
+                 (int)status.err);
+#endif
+  }
+
+  ~file_reader()
+  {
+#if defined(RAFT_ENABLE_CUFILE)
+    cuFileHandleDeregister(cf_handle_);
+#endif
+    close(fd_);
+  }
+
+  file_reader(const file_reader&) = delete;
+  file_reader& operator=(const file_reader&) = delete;
+
+  int fd() const { return fd_; }
+  size_t size() const { return size_; }
+
+#if defined(RAFT_ENABLE_CUFILE)
+  CUfileHandle_t cufile_handle() const { return cf_handle_; }
+#endif
+
+ private:
+  int fd_;
+  size_t size_;
+#if defined(RAFT_ENABLE_CUFILE)
+  CUfileHandle_t cf_handle_;
+#endif
+};
+
+#if defined(RAFT_ENABLE_CUFILE)
+
+/**
+ * Striped cuFile read: the destination device buffer is registered once and
+ * `n_threads` workers each pull a contiguous stripe with synchronous
+ * cuFileRead calls. Thread-parallel stripes are what keep a multi-NVMe
+ * raid saturated; a single synchronous reader tops out near the bandwidth
+ * of one drive.
+ */
+inline void read_cufile(
+  const file_reader& fr, size_t file_offset, void* dst, size_t nbytes, int n_threads)
+{
+  auto status = cuFileBufRegister(dst, nbytes, 0);
+  RAFT_EXPECTS(status.err == CU_FILE_SUCCESS,
+               "raft::io: cuFileBufRegister failed (err=%d)",
+               (int)status.err);
+
+  // stripes are aligned to 1MiB so each worker issues large direct reads
+  size_t n_workers = std::max(1, n_threads);
+  size_t stripe    = (nbytes + n_workers - 1) / n_workers;
+  stripe           = ((stripe + ((1 << 20) - 1)) >> 20) << 20;
+
+  std::vector<std::thread> workers;
+  std::vector<ssize_t> failed(n_workers, 0);
+  for (size_t t = 0; t < n_workers; t++) {
+    size_t begin = t * stripe;
+    if (begin >= nbytes) break;
+    size_t end = std::min(nbytes, begin + stripe);
+    workers.emplace_back([&, t, begin, end]() {
+      size_t pos = begin;
+      while (pos < end) {
+        ssize_t n = cuFileRead(
+          fr.cufile_handle(), dst, end - pos, (off_t)(file_offset + pos), (off_t)pos);
+        if (n <= 0) {
+          failed[t] = n == 0 ? -1 : n;
+          return;
+        }
+        pos += static_cast<size_t>(n);
+      }
+    });
+  }
+  for (auto& w : workers) {
+    w.join();
+  }
+  cuFileBufDeregister(dst);
+
+  for (size_t t = 0; t < n_workers; t++) {
+    RAFT_EXPECTS(
+      failed[t] == 0, "raft::io: cuFileRead failed on stripe %zu (err=%zd)", t, failed[t]);
+  }
+}
+
+#else
+
+/**
+ * Bounce-buffer fallback when cuFile support is not compiled in: chunks are
+ * pread into per-stream pinned staging buffers and copied to the device
+ * asynchronously, overlapping disk reads with transfers across the
+ * handle's stream pool.
+ */
+inline void read_posix(
+  const raft::handle_t& handle, const file_reader& fr, size_t file_offset, void* dst, size_t nbytes)
+{
+  constexpr size_t chunk = 1 << 22;
+
+  size_t n_stages =
+    handle.is_stream_pool_initialized() ? std::min<size_t>(handle.get_stream_pool_size(), 8) : 1;
+
+  std::vector<char*> staging(n_stages);
+  for (auto& buf : staging) {
+    RAFT_CUDA_TRY(cudaMallocHost(&buf, std::min(chunk, nbytes)));
+  }
+
+  size_t pos = 0, s = 0;
+  while (pos < nbytes) {
+    size_t len  = std::min(chunk, nbytes - pos);
+    auto stream = handle.is_stream_pool_initialized() ? handle.get_stream_from_stream_pool(s)
+                                                      : handle.get_stream();
+    // the staging buffer can only be refilled once its previous copy landed
+    RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+    pread_full(fr.fd(), staging[s], len, (off_t)(file_offset + pos));
+    RAFT_CUDA_TRY(cudaMemcpyAsync(
+      static_cast<char*>(dst) + pos, staging[s], len, cudaMemcpyHostToDevice, stream));
+    pos += len;
+    s = (s + 1) % n_stages;
+  }
+
+  if (handle.is_stream_pool_initialized()) { handle.sync_stream_pool(); }
+  handle.sync_stream();
+
+  for (auto buf : staging) {
+    RAFT_CUDA_TRY(cudaFreeHost(buf));
+  }
+}
+
+#endif  // RAFT_ENABLE_CUFILE
+
+template <typename ElementType>
+void read(const raft::handle_t& handle,
+          const file_reader& fr,
+          const std::string& path,
+          size_t file_offset,
+          ElementType* dst,
+          size_t n_elements,
+          int n_threads)
+{
+  size_t nbytes = n_elements * sizeof(ElementType);
+  RAFT_EXPECTS(file_offset + nbytes <= fr.size(),
+               "raft::io: read of %zu bytes at offset %zu past end of '%s' (%zu bytes)",
+               nbytes,
+               file_offset,
+               path.c_str(),
+               fr.size());
+#if defined(RAFT_ENABLE_CUFILE)
+  read_cufile(fr, file_offset, dst, nbytes, n_threads);
+#else
+  (void)n_threads;
+  read_posix(handle, fr, file_offset, dst, nbytes);
+#endif
+}
+
+template <typename ElementType>
+void read(const raft::handle_t& handle,
+          const std::string& path,
+          size_t file_offset,
+          ElementType* dst,
+          size_t n_elements,
+          int n_threads)
+{
+  file_reader fr(path);
+  read(handle, fr, path, file_offset, dst, n_elements, n_threads);
+}
+
+/** Writes exactly `len` bytes at `offset`, retrying short writes. */
+inline void pwrite_full(int fd, const void* buf, size_t len, off_t offset)
+{
+  const char* p = static_cast<const char*>(buf);
+  while (len > 0) {
+    ssize_t n = pwrite(fd, p, len, offset);
+    RAFT_EXPECTS(n > 0, "raft::io: pwrite failed: %s", strerror(errno));
+    p += n;
+    offset += n;
+    len -= static_cast<size_t>(n);
+  }
+}
+
+/**
+ * RAII wrapper over a dataset file opened for writing; the cuFile build
+ * registers the descriptor so device buffers can be written out directly.
+ * Unlike reads, writes are not striped: checkpoints are bandwidth-bound on
+ * a single sequential stream and a lone cuFile writer already saturates it.
+ */
+class file_writer {
+ public:
+  explicit file_writer(const std::string& path)
+  {
+#if defined(RAFT_ENABLE_CUFILE)
+    fd_ = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+#else
+    fd_ = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+    RAFT_EXPECTS(fd_ >= 0, "raft::io: failed to create '%s': %s", path.c_str(), strerror(errno));
+
+#if defined(RAFT_ENABLE_CUFILE)
+    CUfileDescr_t descr;
+    std::memset(&descr, 0, sizeof(descr));
+    descr.handle.fd = fd_;
+    descr.type      = CU_FILE_HANDLE_TYPE_OPAQUE_FD;
+    auto status     = cuFileHandleRegister(&cf_handle_, &descr);
+    RAFT_EXPECTS(status.err == CU_FILE_SUCCESS,
+                 "raft::io: cuFileHandleRegister('%s') failed (err=%d)",
+                 path.c_str(),
+                 (int)status.err);
+#endif
+  }
+
+  ~file_writer()
+  {
+#if defined(RAFT_ENABLE_CUFILE)
+    cuFileHandleDeregister(cf_handle_);
+#endif
+    close(fd_);
+  }
+
+  file_writer(const file_writer&) = delete;
+  file_writer& operator=(const file_writer&) = delete;
+
+  int fd() const { return fd_; }
+
+#if defined(RAFT_ENABLE_CUFILE)
+  CUfileHandle_t cufile_handle() const { return cf_handle_; }
+#endif
+
+ private:
+  int fd_;
+#if defined(RAFT_ENABLE_CUFILE)
+  CUfileHandle_t cf_handle_;
+#endif
+};
+
+/** Writes a device buffer to the file at `file_offset`. */
+inline void write_device(const raft::handle_t& handle,
+                         const file_writer& fw,
+                         size_t file_offset,
+                         const void* src,
+                         size_t nbytes)
+{
+#if defined(RAFT_ENABLE_CUFILE)
+  auto status = cuFileBufRegister(const_cast<void*>(src), nbytes, 0);
+  RAFT_EXPECTS(status.err == CU_FILE_SUCCESS,
+               "raft::io: cuFileBufRegister failed (err=%d)",
+               (int)status.err);
+  size_t pos = 0;
+  while (pos < nbytes) {
+    ssize_t n = cuFileWrite(
+      fw.cufile_handle(), const_cast<void*>(src), nbytes - pos, (off_t)(file_offset + pos), (off_t)pos);
+    if (n <= 0) {
+      cuFileBufDeregister(const_cast<void*>(src));
+      RAFT_FAIL("raft::io: cuFileWrite failed (err=%zd)", (ssize_t)n);
+    }
+    pos += static_cast<size_t>(n);
+  }
+  cuFileBufDeregister(const_cast<void*>(src));
+#else
+  constexpr size_t chunk = 1 << 22;
+  auto stream            = handle.get_stream();
+
+  char* staging = nullptr;
+  RAFT_CUDA_TRY(cudaMallocHost(&staging, std::min(chunk, nbytes)));
+
+  size_t pos = 0;
+  while (pos < nbytes) {
+    size_t len = std::min(chunk, nbytes - pos);
+    RAFT_CUDA_TRY(cudaMemcpyAsync(
+      staging, static_cast<const char*>(src) + pos, len, cudaMemcpyDeviceToHost, stream));
+    RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+    pwrite_full(fw.fd(), staging, len, (off_t)(file_offset + pos));
+    pos += len;
+  }
+
+  RAFT_CUDA_TRY(cudaFreeHost(staging));
+#endif
+}
+
+/**
+ * Writes a host buffer to the file at `file_offset`. The cuFile build's
+ * descriptor is O_DIRECT, so the data is staged through an aligned block
+ * padded to the sector size; `file_offset` must be sector-aligned there.
+ */
+inline void write_host(const file_writer& fw, size_t file_offset, const void* src, size_t nbytes)
+{
+#if defined(RAFT_ENABLE_CUFILE)
+  size_t padded = ((nbytes + 4095) / 4096) * 4096;
+  void* staging = nullptr;
+  RAFT_EXPECTS(posix_memalign(&staging, 4096, padded) == 0, "raft::io: posix_memalign failed");
+  std::memset(staging, 0, padded);
+  std::memcpy(staging, src, nbytes);
+  pwrite_full(fw.fd(), staging, padded, (off_t)file_offset);
+  free(staging);
+#else
+  pwrite_full(fw.fd(), src, nbytes, (off_t)file_offset);
+#endif
+}
+
+};  // namespace detail
+};  // namespace io
+};  // namespace raft
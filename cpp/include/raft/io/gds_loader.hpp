@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __GDS_LOADER_H
+#define __GDS_LOADER_H
+
+#pragma once
+
+#include <raft/core/handle.hpp>
+#include <raft/core/mdarray.hpp>
+#include <raft/io/detail/gds_loader.hpp>
+
+#include <cstdint>
+#include <string>
+
+namespace raft {
+namespace io {
+
+/**
+ * Fixed-size header prefixed to raw dataset shards. The payload is the
+ * row-major element data immediately following the header. Extents are
+ * stored explicitly so loaders can size device allocations before touching
+ * the payload.
+ */
+struct dataset_header {
+  static constexpr std::uint32_t kMagic   = 0x74666172;  // 'raft'
+  static constexpr std::uint32_t kVersion = 1;
+
+  std::uint32_t magic;
+  std::uint32_t version;
+  std::uint32_t dtype_size;
+  std::uint32_t rank;       // 1 or 2
+  std::uint64_t extent[2];  // [rows, cols]; extent[1] is unused when rank == 1
+};
+
+/**
+ * @brief Reads the dataset header of a shard without touching its payload.
+ * @param[in] path path to the shard on a local filesystem
+ * @return the validated header
+ */
+inline dataset_header read_header(const std::string& path)
+{
+  detail::file_reader fr(path);
+  RAFT_EXPECTS(fr.size() >= sizeof(dataset_header),
+               "raft::io: '%s' is smaller than a dataset header",
+               path.c_str());
+  dataset_header header;
+  detail::pread_full(fr.fd(), &header, sizeof(dataset_header), 0);
+  RAFT_EXPECTS(header.magic == dataset_header::kMagic,
+               "raft::io: '%s' is not a raft dataset shard",
+               path.c_str());
+  RAFT_EXPECTS(header.version == dataset_header::kVersion,
+               "raft::io: unsupported dataset version %u in '%s'",
+               header.version,
+               path.c_str());
+  return header;
+}
+
+/**
+ * @brief Reads raw elements from a file directly into device memory.
+ *
+ * When built with cuFile support (RAFT_ENABLE_CUFILE), the read bypasses
+ * host bounce buffers entirely: the destination buffer is registered with
+ * the cuFile driver and `n_threads` workers stripe synchronous direct
+ * reads across the file, which is what saturates multi-NVMe arrays.
+ * Without cuFile the read falls back to pinned staging buffers overlapped
+ * across the handle's stream pool.
+ *
+ * @tparam ElementType element type of the destination buffer
+ * @param[in] handle raft handle (used for streams in the fallback path)
+ * @param[in] path path to the file on a local filesystem
+ * @param[in] file_offset byte offset at which the payload starts
+ * @param[out] dst destination device buffer of `n_elements` elements
+ * @param[in] n_elements number of elements to read
+ * @param[in] n_threads number of striped reader threads (cuFile path only)
+ */
+template <typename ElementType>
+void read(const raft::handle_t& handle,
+          const std::string& path,
+          size_t file_offset,
+          ElementType* dst,
+          size_t n_elements,
+          int n_threads = 4)
+{
+  detail::read(handle, path, file_offset, dst, n_elements, n_threads);
+}
+
+/**
+ * @brief Loads a rank-2 dataset shard into a row-major device_matrix.
+ *
+ * The matrix extents come from the shard's header; the payload is read
+ * straight into the returned mdarray's allocation (see raft::io::read for
+ * the transport details).
+ *
+ * @tparam ElementType element type; must match the on-disk dtype size
+ * @param[in] handle raft handle
+ * @param[in] path path to the shard on a local filesystem
+ * @param[in] n_threads number of striped reader threads (cuFile path only)
+ * @return device_matrix holding the shard's payload
+ */
+template <typename ElementType>
+auto load_matrix(const raft::handle_t& handle, const std::string& path, int n_threads = 4)
+{
+  auto header = read_header(path);
+  RAFT_EXPECTS(header.rank == 2, "raft::io: '%s' has rank %u, expected 2", path.c_str(), header.rank);
+  RAFT_EXPECTS(header.dtype_size == sizeof(ElementType),
+               "raft::io: '%s' holds %u-byte elements, expected %zu",
+               path.c_str(),
+               header.dtype_size,
+               sizeof(ElementType));
+
+  auto out = raft::make_device_matrix<ElementType>(
+    handle, (size_t)header.extent[0], (size_t)header.extent[1]);
+  detail::read(handle,
+               path,
+               sizeof(dataset_header),
+               out.data(),
+               (size_t)header.extent[0] * (size_t)header.extent[1],
+               n_threads);
+  return out;
+}
+
+/**
+ * @brief Loads a rank-1 dataset shard into a device_vector.
+ *
+ * @tparam ElementType element type; must match the on-disk dtype size
+ * @param[in] handle raft handle
+ * @param[in] path path to the shard on a local filesystem
+ * @param[in] n_threads number of striped reader threads (cuFile path only)
+ * @return device_vector holding the shard's payload
+ */
+template <typename ElementType>
+auto load_vector(const raft::handle_t& handle, const std::string& path, int n_threads = 4)
+{
+  auto header = read_header(path);
+  RAFT_EXPECTS(header.rank == 1, "raft::io: '%s' has rank %u, expected 1", path.c_str(), header.rank);
+  RAFT_EXPECTS(header.dtype_size == sizeof(ElementType),
+               "raft::io: '%s' holds %u-byte elements, expected %zu",
+               path.c_str(),
+               header.dtype_size,
+               sizeof(ElementType));
+
+  auto out = raft::make_device_vector<ElementType>(handle, (size_t)header.extent[0]);
+  detail::read(
+    handle, path, sizeof(dataset_header), out.data(), (size_t)header.extent[0], n_threads);
+  return out;
+}
+
+};  // namespace io
+};  // namespace raft
+
+#endif
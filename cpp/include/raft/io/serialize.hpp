@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __RAFT_SERIALIZE_H
+#define __RAFT_SERIALIZE_H
+
+#pragma once
+
+#include <raft/core/handle.hpp>
+#include <raft/core/mdarray.hpp>
+#include <raft/io/detail/gds_loader.hpp>
+#include <raft/sparse/coo.hpp>
+
+#include <cstdint>
+#include <string>
+
+namespace raft {
+namespace io {
+
+/**
+ * Versioned header of a serialized raft object. The payload segments
+ * (dense data, or COO rows/cols/vals) follow the header contiguously, each
+ * starting on a 4KiB boundary so the file can be mmap'ed or read with
+ * O_DIRECT/cuFile without staging.
+ */
+struct serialized_header {
+  static constexpr std::uint32_t kMagic   = 0x73666172;  // 'rafs'
+  static constexpr std::uint32_t kVersion = 1;
+
+  /** alignment of every payload segment within the file */
+  static constexpr std::size_t kSegmentAlign = 4096;
+
+  enum object_type : std::uint32_t { DENSE = 0, SPARSE_COO = 1 };
+
+  // sparse invariant flags carried across checkpoint/restore
+  static constexpr std::uint32_t kFlagSorted = 1 << 0;
+  static constexpr std::uint32_t kFlagUnique = 1 << 1;
+
+  std::uint32_t magic;
+  std::uint32_t version;
+  std::uint32_t type;
+  std::uint32_t dtype_size;
+  std::uint32_t index_size;  // 0 for dense objects
+  std::uint32_t rank;
+  std::uint32_t flags;
+  std::uint32_t pad;
+  std::uint64_t extent[2];  // [rows, cols]; extent[1] unused when rank == 1
+  std::uint64_t nnz;        // 0 for dense objects
+
+  static constexpr std::size_t aligned(std::size_t offset)
+  {
+    return (offset + kSegmentAlign - 1) & ~(kSegmentAlign - 1);
+  }
+};
+
+/**
+ * @brief Reads and validates the header of a serialized raft object.
+ * @param[in] path path to the serialized file
+ * @return the validated header
+ */
+inline serialized_header read_serialized_header(const std::string& path)
+{
+  detail::file_reader fr(path);
+  RAFT_EXPECTS(fr.size() >= sizeof(serialized_header),
+               "raft::io: '%s' is smaller than a serialization header",
+               path.c_str());
+  serialized_header header;
+  detail::pread_full(fr.fd(), &header, sizeof(serialized_header), 0);
+  RAFT_EXPECTS(header.magic == serialized_header::kMagic,
+               "raft::io: '%s' is not a serialized raft object",
+               path.c_str());
+  RAFT_EXPECTS(header.version == serialized_header::kVersion,
+               "raft::io: unsupported serialization version %u in '%s'",
+               header.version,
+               path.c_str());
+  return header;
+}
+
+/**
+ * @brief Serializes a dense row-major device buffer.
+ *
+ * @tparam ElementType element type of the buffer
+ * @param[in] handle raft handle
+ * @param[in] path destination path on a local filesystem
+ * @param[in] data device buffer of n_rows * n_cols elements
+ * @param[in] n_rows number of rows
+ * @param[in] n_cols number of columns (1 for vectors)
+ * @param[in] rank 1 or 2; controls which loader accepts the file
+ */
+template <typename ElementType>
+void serialize_mdarray(const raft::handle_t& handle,
+                       const std::string& path,
+                       const ElementType* data,
+                       size_t n_rows,
+                       size_t n_cols,
+                       std::uint32_t rank = 2)
+{
+  serialized_header header{};
+  header.magic      = serialized_header::kMagic;
+  header.version    = serialized_header::kVersion;
+  header.type       = serialized_header::DENSE;
+  header.dtype_size = sizeof(ElementType);
+  header.rank       = rank;
+  header.extent[0]  = n_rows;
+  header.extent[1]  = n_cols;
+
+  detail::file_writer fw(path);
+  detail::write_host(fw, 0, &header, sizeof(header));
+  detail::write_device(handle,
+                       fw,
+                       serialized_header::aligned(sizeof(header)),
+                       data,
+                       n_rows * n_cols * sizeof(ElementType));
+}
+
+/** @brief Serializes a device_matrix (see the raw-pointer overload). */
+template <typename ElementType, typename LayoutPolicy>
+void serialize(const raft::handle_t& handle,
+               const std::string& path,
+               const device_matrix<ElementType, LayoutPolicy>& mat)
+{
+  serialize_mdarray(handle, path, mat.data(), (size_t)mat.extent(0), (size_t)mat.extent(1), 2);
+}
+
+/** @brief Serializes a device_vector (see the raw-pointer overload). */
+template <typename ElementType, typename LayoutPolicy>
+void serialize(const raft::handle_t& handle,
+               const std::string& path,
+               const device_vector<ElementType, LayoutPolicy>& vec)
+{
+  serialize_mdarray(handle, path, vec.data(), (size_t)vec.extent(0), 1, 1);
+}
+
+/**
+ * @brief Deserializes a rank-2 dense object into a device_matrix.
+ * @tparam ElementType element type; must match the on-disk dtype size
+ * @param[in] handle raft handle
+ * @param[in] path path to the serialized file
+ * @param[in] n_threads number of striped reader threads (cuFile path only)
+ * @return device_matrix holding the payload
+ */
+template <typename ElementType>
+auto deserialize_matrix(const raft::handle_t& handle, const std::string& path, int n_threads = 4)
+{
+  auto header = read_serialized_header(path);
+  RAFT_EXPECTS(header.type == serialized_header::DENSE && header.rank == 2,
+               "raft::io: '%s' does not hold a rank-2 dense object",
+               path.c_str());
+  RAFT_EXPECTS(header.dtype_size == sizeof(ElementType),
+               "raft::io: '%s' holds %u-byte elements, expected %zu",
+               path.c_str(),
+               header.dtype_size,
+               sizeof(ElementType));
+
+  auto out = raft::make_device_matrix<ElementType>(
+    handle, (size_t)header.extent[0], (size_t)header.extent[1]);
+  detail::read(handle,
+               path,
+               serialized_header::aligned(sizeof(serialized_header)),
+               out.data(),
+               (size_t)header.extent[0] * (size_t)header.extent[1],
+               n_threads);
+  return out;
+}
+
+/**
+ * @brief Deserializes a rank-1 dense object into a device_vector.
+ * @tparam ElementType element type; must match the on-disk dtype size
+ * @param[in] handle raft handle
+ * @param[in] path path to the serialized file
+ * @param[in] n_threads number of striped reader threads (cuFile path only)
+ * @return device_vector holding the payload
+ */
+template <typename ElementType>
+auto deserialize_vector(const raft::handle_t& handle, const std::string& path, int n_threads = 4)
+{
+  auto header = read_serialized_header(path);
+  RAFT_EXPECTS(header.type == serialized_header::DENSE && header.rank == 1,
+               "raft::io: '%s' does not hold a rank-1 dense object",
+               path.c_str());
+  RAFT_EXPECTS(header.dtype_size == sizeof(ElementType),
+               "raft::io: '%s' holds %u-byte elements, expected %zu",
+               path.c_str(),
+               header.dtype_size,
+               sizeof(ElementType));
+
+  auto out = raft::make_device_vector<ElementType>(handle, (size_t)header.extent[0]);
+  detail::read(handle,
+               path,
+               serialized_header::aligned(sizeof(serialized_header)),
+               out.data(),
+               (size_t)header.extent[0],
+               n_threads);
+  return out;
+}
+
+/**
+ * @brief Serializes a sparse COO matrix.
+ *
+ * The rows, cols and vals arrays are written as three aligned segments;
+ * the sorted/unique invariant flags are carried in the header so a
+ * restored graph does not pay for a redundant re-sort.
+ *
+ * @tparam value_t value type of the COO
+ * @tparam value_idx index type of the COO
+ * @param[in] handle raft handle
+ * @param[in] path destination path on a local filesystem
+ * @param[in] coo COO matrix to serialize
+ */
+template <typename value_t, typename value_idx>
+void serialize(const raft::handle_t& handle,
+               const std::string& path,
+               raft::sparse::COO<value_t, value_idx>& coo)
+{
+  serialized_header header{};
+  header.magic      = serialized_header::kMagic;
+  header.version    = serialized_header::kVersion;
+  header.type       = serialized_header::SPARSE_COO;
+  header.dtype_size = sizeof(value_t);
+  header.index_size = sizeof(value_idx);
+  header.rank       = 2;
+  header.extent[0]  = coo.n_rows;
+  header.extent[1]  = coo.n_cols;
+  header.nnz        = coo.nnz;
+  if (coo.sorted) { header.flags |= serialized_header::kFlagSorted; }
+  if (coo.unique) { header.flags |= serialized_header::kFlagUnique; }
+
+  size_t nnz        = coo.nnz;
+  size_t rows_off   = serialized_header::aligned(sizeof(header));
+  size_t cols_off   = serialized_header::aligned(rows_off + nnz * sizeof(value_idx));
+  size_t vals_off   = serialized_header::aligned(cols_off + nnz * sizeof(value_idx));
+
+  detail::file_writer fw(path);
+  detail::write_host(fw, 0, &header, sizeof(header));
+  detail::write_device(handle, fw, rows_off, coo.rows(), nnz * sizeof(value_idx));
+  detail::write_device(handle, fw, cols_off, coo.cols(), nnz * sizeof(value_idx));
+  detail::write_device(handle, fw, vals_off, coo.vals(), nnz * sizeof(value_t));
+}
+
+/**
+ * @brief Deserializes a sparse COO matrix written by the overload above.
+ * @tparam value_t value type; must match the on-disk dtype size
+ * @tparam value_idx index type; must match the on-disk index size
+ * @param[in] handle raft handle
+ * @param[in] path path to the serialized file
+ * @param[out] out COO matrix to restore into
+ * @param[in] n_threads number of striped reader threads (cuFile path only)
+ */
+template <typename value_t, typename value_idx>
+void deserialize(const raft::handle_t& handle,
+                 const std::string& path,
+                 raft::sparse::COO<value_t, value_idx>& out,
+                 int n_threads = 4)
+{
+  auto stream = handle.get_stream();
+
+  auto header = read_serialized_header(path);
+  RAFT_EXPECTS(header.type == serialized_header::SPARSE_COO,
+               "raft::io: '%s' does not hold a COO object",
+               path.c_str());
+  RAFT_EXPECTS(
+    header.dtype_size == sizeof(value_t) && header.index_size == sizeof(value_idx),
+    "raft::io: '%s' holds %u-byte values with %u-byte indices, expected %zu and %zu",
+    path.c_str(),
+    header.dtype_size,
+    header.index_size,
+    sizeof(value_t),
+    sizeof(value_idx));
+
+  size_t nnz      = header.nnz;
+  size_t rows_off = serialized_header::aligned(sizeof(header));
+  size_t cols_off = serialized_header::aligned(rows_off + nnz * sizeof(value_idx));
+  size_t vals_off = serialized_header::aligned(cols_off + nnz * sizeof(value_idx));
+
+  out.allocate((int)nnz, (int)header.extent[0], (int)header.extent[1], false, stream);
+  handle.sync_stream();
+
+  detail::file_reader fr(path);
+  detail::read(handle, fr, path, rows_off, out.rows(), nnz, n_threads);
+  detail::read(handle, fr, path, cols_off, out.cols(), nnz, n_threads);
+  detail::read(handle, fr, path, vals_off, out.vals(), nnz, n_threads);
+
+  out.sorted = (header.flags & serialized_header::kFlagSorted) != 0;
+  out.unique = (header.flags & serialized_header::kFlagUnique) != 0;
+}
+
+};  // namespace io
+};  // namespace raft
+
+#endif
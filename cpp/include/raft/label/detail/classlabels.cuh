@@ -23,8 +23,12 @@
 #include <raft/linalg/unary_op.cuh>
 #include <rmm/device_scalar.hpp>
 #include <rmm/device_uvector.hpp>
+#include <rmm/exec_policy.hpp>
+
+#include <thrust/sort.h>
 
 #include <algorithm>
+#include <cstring>
 
 namespace raft {
 namespace label {
@@ -117,6 +121,116 @@ void getOvrlabels(
 // TODO: add one-versus-one selection: select two classes, relabel them to
 // +/-1, return array with the new class labels and corresponding indices.
 
+// slot states of the open-addressing label table
+enum LabelSlotState : int {
+  LABEL_SLOT_EMPTY = 0,  // never written
+  LABEL_SLOT_BUSY,       // an insertion won the slot but the key is not visible yet
+  LABEL_SLOT_READY       // key is visible
+};
+
+template <typename Type>
+DI uint64_t label_hash(Type val)
+{
+  uint64_t bits = 0;
+  memcpy(&bits, &val, sizeof(Type));
+  // murmur3 64-bit finalizer
+  bits ^= bits >> 33;
+  bits *= 0xff51afd7ed558ccdULL;
+  bits ^= bits >> 33;
+  bits *= 0xc4ceb9fe1a85ec53ULL;
+  bits ^= bits >> 33;
+  return bits;
+}
+
+// Looks up the slot of 'val' in a fully built table (no concurrent inserts).
+// Returns -1 if the value is absent, which can only happen after an overflow.
+template <typename Type>
+DI int label_table_lookup(const Type* keys, const int* state, int capacity, Type val)
+{
+  int slot = int(label_hash(val) & uint64_t(capacity - 1));
+  for (int probes = 0; probes < capacity; probes++) {
+    if (state[slot] != LABEL_SLOT_READY) { return -1; }
+    if (keys[slot] == val) { return slot; }
+    slot = (slot + 1) & (capacity - 1);
+  }
+  return -1;
+}
+
+// One O(n) pass inserting every label into the open-addressing table;
+// whichever thread first claims a slot publishes the key and counts it as a
+// new distinct label. Sets the overflow flag instead of looping forever when
+// there are more distinct labels than slots.
+template <typename Type, int TPB_X>
+__global__ void build_label_table_kernel(
+  Type* keys, int* state, int capacity, int* n_unique, int* overflow, const Type* in, size_t N)
+{
+  size_t tid = threadIdx.x + size_t(blockIdx.x) * TPB_X;
+  if (tid >= N) { return; }
+  Type val = in[tid];
+  int slot = int(label_hash(val) & uint64_t(capacity - 1));
+  for (int probes = 0; probes < capacity; probes++) {
+    int st = *((volatile int*)(state + slot));
+    if (st == LABEL_SLOT_READY) {
+      if (keys[slot] == val) { return; }
+      slot = (slot + 1) & (capacity - 1);
+    } else if (st == LABEL_SLOT_EMPTY) {
+      if (atomicCAS(state + slot, LABEL_SLOT_EMPTY, LABEL_SLOT_BUSY) == LABEL_SLOT_EMPTY) {
+        keys[slot] = val;
+        __threadfence();
+        atomicExch(state + slot, LABEL_SLOT_READY);
+        atomicAdd(n_unique, 1);
+        return;
+      }
+      // lost the race for this slot; re-examine it
+    }
+    // LABEL_SLOT_BUSY: spin until the winner publishes the key
+  }
+  *overflow = 1;
+}
+
+// compacts the distinct labels out of the table so they can be sorted
+template <typename Type, int TPB_X>
+__global__ void compact_label_table_kernel(
+  Type* unique_out, int* counter, const Type* keys, const int* state, int capacity)
+{
+  int slot = threadIdx.x + blockIdx.x * TPB_X;
+  if (slot < capacity && state[slot] == LABEL_SLOT_READY) {
+    unique_out[atomicAdd(counter, 1)] = keys[slot];
+  }
+}
+
+// stores the sorted rank of every distinct label back into its table slot
+template <typename Type, int TPB_X>
+__global__ void rank_label_table_kernel(
+  int* ranks, const Type* unique_sorted, int n_unique, const Type* keys, const int* state, int capacity)
+{
+  int r = threadIdx.x + blockIdx.x * TPB_X;
+  if (r < n_unique) {
+    int slot = label_table_lookup(keys, state, capacity, unique_sorted[r]);
+    if (slot >= 0) { ranks[slot] = r; }
+  }
+}
+
+template <typename Type, int TPB_X, typename Lambda>
+__global__ void map_label_hash_kernel(const Type* keys,
+                                      const int* state,
+                                      const int* ranks,
+                                      int capacity,
+                                      Type* in,
+                                      Type* out,
+                                      size_t N,
+                                      Lambda filter_op,
+                                      bool zero_based)
+{
+  size_t tid = threadIdx.x + size_t(blockIdx.x) * TPB_X;
+  if (tid < N) {
+    if (!filter_op(in[tid])) {
+      int slot = label_table_lookup(keys, state, capacity, in[tid]);
+      if (slot >= 0) { out[tid] = ranks[slot] + !zero_based; }
+    }
+  }
+}
+
 template <typename Type, int TPB_X, typename Lambda>
 __global__ void map_label_kernel(Type* map_ids,
                                  size_t N_labels,
@@ -157,6 +271,11 @@ __global__ void map_label_kernel(Type* map_ids,
  * @param stream cuda stream to use
  * @param filter_op an optional function for specifying which values
  * should have monotonically increasing labels applied to them.
+ *
+ * The relabeling runs through a device hash table in two O(n) passes, so
+ * only the distinct labels are ever sorted. When the number of distinct
+ * labels exceeds the table capacity, the code falls back to the full
+ * sort+unique path.
  */
 template <typename Type, typename Lambda>
 void make_monotonic(
@@ -167,11 +286,57 @@ void make_monotonic(
   dim3 blocks(raft::ceildiv(N, TPB_X));
   dim3 threads(TPB_X);
 
-  rmm::device_uvector<Type> map_ids(0, stream);
-  int num_clusters = getUniquelabels(map_ids, in, N, stream);
+  // table capacity: power of two, at half load even if all labels are
+  // distinct, capped so the fast path stays cheap on memory
+  int capacity = 2048;
+  while (size_t(capacity) < 2 * N && capacity < (1 << 16)) {
+    capacity <<= 1;
+  }
+
+  rmm::device_uvector<Type> keys(capacity, stream);
+  rmm::device_uvector<int> state(capacity, stream);
+  rmm::device_uvector<int> ranks(capacity, stream);
+  rmm::device_scalar<int> d_n_unique(stream);
+  rmm::device_scalar<int> d_overflow(stream);
+  RAFT_CUDA_TRY(cudaMemsetAsync(state.data(), 0, capacity * sizeof(int), stream));
+  RAFT_CUDA_TRY(cudaMemsetAsync(d_n_unique.data(), 0, sizeof(int), stream));
+  RAFT_CUDA_TRY(cudaMemsetAsync(d_overflow.data(), 0, sizeof(int), stream));
 
-  map_label_kernel<Type, TPB_X><<<blocks, threads, 0, stream>>>(
-    map_ids.data(), num_clusters, in, out, N, filter_op, zero_based);
+  build_label_table_kernel<Type, TPB_X><<<blocks, threads, 0, stream>>>(
+    keys.data(), state.data(), capacity, d_n_unique.data(), d_overflow.data(), in, N);
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
+
+  if (d_overflow.value(stream) != 0) {
+    // more distinct labels than table slots: use the sort+unique path
+    rmm::device_uvector<Type> map_ids(0, stream);
+    int num_clusters = getUniquelabels(map_ids, in, N, stream);
+
+    map_label_kernel<Type, TPB_X><<<blocks, threads, 0, stream>>>(
+      map_ids.data(), num_clusters, in, out, N, filter_op, zero_based);
+    RAFT_CUDA_TRY(cudaPeekAtLastError());
+    return;
+  }
+
+  int n_unique = d_n_unique.value(stream);
+
+  // sort just the distinct labels so ranks keep the sorted-order semantics
+  // of the sort+unique path
+  rmm::device_uvector<Type> unique_v(n_unique, stream);
+  RAFT_CUDA_TRY(cudaMemsetAsync(d_n_unique.data(), 0, sizeof(int), stream));
+  dim3 cap_blocks(raft::ceildiv(size_t(capacity), TPB_X));
+  compact_label_table_kernel<Type, TPB_X><<<cap_blocks, threads, 0, stream>>>(
+    unique_v.data(), d_n_unique.data(), keys.data(), state.data(), capacity);
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
+  thrust::sort(rmm::exec_policy(stream), unique_v.data(), unique_v.data() + n_unique);
+
+  dim3 rank_blocks(raft::ceildiv(size_t(n_unique), TPB_X));
+  rank_label_table_kernel<Type, TPB_X><<<rank_blocks, threads, 0, stream>>>(
+    ranks.data(), unique_v.data(), n_unique, keys.data(), state.data(), capacity);
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
+
+  map_label_hash_kernel<Type, TPB_X><<<blocks, threads, 0, stream>>>(
+    keys.data(), state.data(), ranks.data(), capacity, in, out, N, filter_op, zero_based);
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
 }
 
 /**
@@ -16,9 +16,13 @@
 
 #pragma once
 
+#include <cooperative_groups.h>
+
+#include <algorithm>
 #include <limits>
 #include <math.h>
 
+#include <raft/core/cancellation_token.cuh>
 #include <raft/cuda_utils.cuh>
 #include <raft/cudart_utils.h>
 #include <raft/linalg/init.cuh>
@@ -83,6 +87,77 @@ __global__ void __launch_bounds__(TPB_X)
   }
 }
 
+/** Single-launch version of the propagate/reassign iteration: the whole
+ *  equivalence computation runs inside one cooperative kernel, with grid-wide
+ *  synchronization replacing the per-iteration host round trip. The grid may
+ *  be smaller than the problem, so every phase is a grid-stride loop. */
+template <typename value_idx, int TPB_X = 256>
+__global__ void __launch_bounds__(TPB_X)
+  merge_labels_coop_kernel(value_idx* __restrict__ labels_a,
+                           const value_idx* __restrict__ labels_b,
+                           value_idx* __restrict__ R,
+                           const bool* __restrict__ mask,
+                           bool* __restrict__ m,
+                           value_idx N,
+                           value_idx MAX_LABEL,
+                           cancellation_view cancel)
+{
+  namespace cg = cooperative_groups;
+  cg::grid_group grid = cg::this_grid();
+
+  value_idx rank     = value_idx(grid.thread_rank());
+  value_idx nthreads = value_idx(grid.size());
+
+  // Initialize R. R defines the relabeling rules; after merging the input
+  // arrays, label l will be reassigned as R[l-1]+1.
+  for (value_idx i = rank; i < N; i += nthreads) {
+    R[i] = i;
+  }
+
+  // Step 1: compute connected components in the label equivalence graph
+  do {
+    grid.sync();
+    if (rank == 0) { *m = false; }
+    grid.sync();
+    for (value_idx tid = rank; tid < N; tid += nthreads) {
+      if (__ldg((char*)mask + tid)) {
+        // Note: labels are from 1 to N
+        value_idx la = __ldg(labels_a + tid) - 1;
+        value_idx lb = __ldg(labels_b + tid) - 1;
+        value_idx ra = R[la];
+        value_idx rb = R[lb];
+        if (ra != rb) {
+          *m = true;
+          // min(ra, rb) would be sufficient but this speeds up convergence
+          value_idx rmin = R[min(ra, rb)];
+          if (sizeof(value_idx) == 4) {
+            atomicMin((int*)(R + la), rmin);
+            atomicMin((int*)(R + lb), rmin);
+          } else if (sizeof(value_idx) == 8) {
+            atomicMin((long long int*)(R + la), rmin);
+            atomicMin((long long int*)(R + lb), rmin);
+          }
+        }
+      }
+    }
+    grid.sync();
+    // a single thread polls the (mapped host memory) cancellation flag once
+    // per iteration; clearing the convergence flag makes the whole grid exit
+    // on this round, leaving the labels in an unspecified state
+    if (rank == 0 && *m && cancel.cancelled()) { *m = false; }
+    grid.sync();
+  } while (*m);
+
+  // Step 2: re-assign minimum equivalent label
+  for (value_idx tid = rank; tid < N; tid += nthreads) {
+    value_idx la  = labels_a[tid];
+    value_idx lb  = __ldg(labels_b + tid);
+    value_idx ra  = (la == MAX_LABEL) ? MAX_LABEL : __ldg(R + (la - 1)) + 1;
+    value_idx rb  = (lb == MAX_LABEL) ? MAX_LABEL : __ldg(R + (lb - 1)) + 1;
+    labels_a[tid] = min(ra, rb);
+  }
+}
+
 /**
  * @brief Merge two labellings in-place, according to a core mask
  *
@@ -154,6 +229,70 @@ void merge_labels(value_idx* labels_a,
   RAFT_CUDA_TRY(cudaPeekAtLastError());
 }
 
+/**
+ * @brief Single-launch merge of two labellings, with device-side convergence
+ *
+ * Semantically identical to merge_labels, but the propagation loop converges
+ * inside one cooperative kernel instead of being iterated from the host, so
+ * no device-to-host synchronization happens at all. Falls back to the
+ * host-driven iteration when the device does not support cooperative launch.
+ *
+ * Since the host never regains control while the propagation converges, an
+ * optional cancellation view (cf. raft/core/cancellation_token.cuh) can be
+ * passed in; the kernel polls it once per iteration and bails out within one
+ * round when cancellation is requested, leaving the labels unspecified. The
+ * host-driven fallback ignores the view — it is already interruptible
+ * between launches.
+ *
+ * @param[inout] labels_a    First input, and output label array (in-place)
+ * @param[in]    labels_b    Second input label array
+ * @param[in]    mask        Core point mask
+ * @param[out]   R           label equivalence map
+ * @param[in]    m           Working flag
+ * @param[in]    N           Number of points in the dataset
+ * @param[in]    stream      CUDA stream
+ * @param[in]    cancel      Optional device-visible cancellation flag
+ */
+template <typename value_idx = int, int TPB_X = 256>
+void merge_labels_coop(value_idx* labels_a,
+                       const value_idx* labels_b,
+                       const bool* mask,
+                       value_idx* R,
+                       bool* m,
+                       value_idx N,
+                       cudaStream_t stream,
+                       cancellation_view cancel = {})
+{
+  int dev_id, supports_coop;
+  RAFT_CUDA_TRY(cudaGetDevice(&dev_id));
+  RAFT_CUDA_TRY(cudaDeviceGetAttribute(&supports_coop, cudaDevAttrCooperativeLaunch, dev_id));
+
+  // the cooperative grid must be fully resident
+  int blocks_per_sm = 0;
+  if (supports_coop) {
+    RAFT_CUDA_TRY(cudaOccupancyMaxActiveBlocksPerMultiprocessor(
+      &blocks_per_sm, merge_labels_coop_kernel<value_idx, TPB_X>, TPB_X, 0));
+  }
+  if (!supports_coop || blocks_per_sm < 1) {
+    merge_labels<value_idx, TPB_X>(labels_a, labels_b, mask, R, m, N, stream);
+    return;
+  }
+
+  value_idx max_blocks = value_idx(blocks_per_sm) * raft::getMultiProcessorCount();
+  dim3 blocks(std::min(raft::ceildiv(N, value_idx(TPB_X)), max_blocks));
+  dim3 threads(TPB_X);
+  value_idx MAX_LABEL = std::numeric_limits<value_idx>::max();
+
+  void* args[] = {&labels_a, &labels_b, &R, &mask, &m, &N, &MAX_LABEL, &cancel};
+  RAFT_CUDA_TRY(
+    cudaLaunchCooperativeKernel(reinterpret_cast<void*>(merge_labels_coop_kernel<value_idx, TPB_X>),
+                                blocks,
+                                threads,
+                                args,
+                                0,
+                                stream));
+}
+
 }  // namespace detail
 };  // namespace label
 };  // namespace raft
\ No newline at end of file
@@ -65,6 +65,41 @@ void merge_labels(value_idx* labels_a,
   detail::merge_labels<value_idx, TPB_X>(labels_a, labels_b, mask, R, m, N, stream);
 }
 
+/**
+ * @brief Single-launch merge of two labellings, with device-side convergence
+ *
+ * Semantically identical to merge_labels, but the label propagation converges
+ * inside one cooperative kernel instead of being iterated from the host, so
+ * the call issues no device-to-host synchronization. Falls back to
+ * merge_labels when the device does not support cooperative launch.
+ *
+ * The optional cancellation view (cf. raft/core/cancellation_token.cuh) lets
+ * the caller interrupt the device-side convergence loop; when cancellation is
+ * requested the kernel returns within one iteration and the labels are left
+ * in an unspecified state.
+ *
+ * @param[inout] labels_a    First input, and output label array (in-place)
+ * @param[in]    labels_b    Second input label array
+ * @param[in]    mask        Core point mask
+ * @param[out]   R           label equivalence map
+ * @param[in]    m           Working flag
+ * @param[in]    N           Number of points in the dataset
+ * @param[in]    stream      CUDA stream
+ * @param[in]    cancel      Optional device-visible cancellation flag
+ */
+template <typename value_idx = int, int TPB_X = 256>
+void merge_labels_coop(value_idx* labels_a,
+                       const value_idx* labels_b,
+                       const bool* mask,
+                       value_idx* R,
+                       bool* m,
+                       value_idx N,
+                       cudaStream_t stream,
+                       cancellation_view cancel = {})
+{
+  detail::merge_labels_coop<value_idx, TPB_X>(labels_a, labels_b, mask, R, m, N, stream, cancel);
+}
+
 };  // namespace label
 };  // namespace raft
 
@@ -127,6 +127,34 @@ inline void initialReduction(raft::handle_t const& handle,
   CHECK_CUDA(handle.get_stream());
 }
 
+// Function for repairing seeded duals against a (possibly changed) cost
+// matrix: the column duals are kept and the row duals are recomputed as the
+// row minima of the column-reduced slack, restoring dual feasibility.
+template <typename vertex_t, typename weight_t>
+inline void warmReduction(raft::handle_t const& handle,
+                          weight_t const* d_costs,
+                          Vertices<vertex_t, weight_t>& d_vertices_dev,
+                          int SP,
+                          vertex_t N)
+{
+  dim3 blocks_per_grid;
+  dim3 threads_per_block;
+  int total_blocks = 0;
+
+  raft::lap::detail::calculateRectangularDims(
+    blocks_per_grid, threads_per_block, total_blocks, N, SP);
+
+  kernel_rowReductionWarm<<<blocks_per_grid, threads_per_block, 0, handle.get_stream()>>>(
+    d_costs,
+    d_vertices_dev.row_duals,
+    d_vertices_dev.col_duals,
+    SP,
+    N,
+    std::numeric_limits<weight_t>::max());
+
+  CHECK_CUDA(handle.get_stream());
+}
+
 template <typename vertex_t, typename weight_t>
 inline void computeInitialAssignments(raft::handle_t const& handle,
                                       weight_t const* d_costs,
@@ -541,6 +569,35 @@ inline void calcObjValPrimal(raft::handle_t const& handle,
   CHECK_CUDA(handle.get_stream());
 }
 
+// Function for solving a whole batch of small subproblems on the device in a
+// single launch, one block per subproblem; no host synchronization happens
+// between the phases of the algorithm.
+template <typename vertex_t, typename weight_t>
+inline void smallSolve(raft::handle_t const& handle,
+                       weight_t const* d_costs,
+                       Vertices<vertex_t, weight_t>& d_vertices_dev,
+                       weight_t* d_obj_val_primal,
+                       weight_t* d_obj_val_dual,
+                       int SP,
+                       vertex_t N)
+{
+  constexpr int TPB = 64;
+  ASSERT(N <= TPB, "lap::smallSolve: only subproblems with size <= %d are supported", TPB);
+
+  kernel_smallLapSolve<vertex_t, weight_t, TPB>
+    <<<SP, TPB, 0, handle.get_stream()>>>(d_costs,
+                                          d_vertices_dev.row_assignments,
+                                          d_vertices_dev.col_assignments,
+                                          d_vertices_dev.row_duals,
+                                          d_vertices_dev.col_duals,
+                                          d_obj_val_primal,
+                                          d_obj_val_dual,
+                                          N,
+                                          std::numeric_limits<weight_t>::max());
+
+  CHECK_CUDA(handle.get_stream());
+}
+
 }  // namespace detail
 }  // namespace lap
 }  // namespace raft
@@ -180,6 +180,32 @@ __global__ void kernel_rowReduction(
   }
 }
 
+// Kernel for restoring dual feasibility against a new cost matrix while
+// keeping seeded column duals: the row dual becomes the row minimum of the
+// column-reduced slack, so that row_dual + col_dual <= cost holds everywhere.
+template <typename vertex_t, typename weight_t>
+__global__ void kernel_rowReductionWarm(weight_t const* d_costs,
+                                        weight_t* d_row_duals,
+                                        weight_t const* d_col_duals,
+                                        int SP,
+                                        vertex_t N,
+                                        weight_t infinity)
+{
+  int spid     = blockIdx.y * blockDim.y + threadIdx.y;
+  int rowid    = blockIdx.x * blockDim.x + threadIdx.x;
+  weight_t min = infinity;
+
+  if (spid < SP && rowid < N) {
+    for (int colid = 0; colid < N; colid++) {
+      weight_t slack = d_costs[spid * N * N + rowid * N + colid] - d_col_duals[spid * N + colid];
+
+      if (slack < min) { min = slack; }
+    }
+
+    d_row_duals[spid * N + rowid] = min;
+  }
+}
+
 // Kernel for reducing the column by subtracting column minimum from each column element.
 //  FIXME:  Once cuda 10.2 is the standard should replace passing infinity
 //          here with using cuda::std::numeric_limits<weight_t>::max()
@@ -555,6 +581,149 @@ __global__ void kernel_calcObjValPrimal(weight_t* d_obj_val_primal,
   }
 }
 
+// Kernel for solving one small (N <= TPB) subproblem per block with the
+// shortest-augmenting-path variant of the Hungarian algorithm. The whole
+// solve is device resident: alternating-tree growth, dual updates and
+// augmentation all loop over shared-memory state inside the block, so the
+// host never synchronizes between phases and a batch of subproblems runs as
+// a single kernel launch.
+template <typename vertex_t, typename weight_t, int TPB>
+__global__ void kernel_smallLapSolve(weight_t const* d_costs,
+                                     vertex_t* d_row_assignments,
+                                     vertex_t* d_col_assignments,
+                                     weight_t* d_row_duals,
+                                     weight_t* d_col_duals,
+                                     weight_t* d_obj_val_primal,
+                                     weight_t* d_obj_val_dual,
+                                     vertex_t N,
+                                     weight_t infinity)
+{
+  int const spid       = blockIdx.x;
+  int const tid        = threadIdx.x;
+  int const n          = N;
+  weight_t const* cost = d_costs + std::size_t(spid) * n * n;
+
+  // column indices are shifted by one; index 0 is the sentinel root of the
+  // alternating tree (Jonker-Volgenant style). p[j] is the row (1-based)
+  // assigned to column j, 0 meaning unassigned.
+  __shared__ weight_t u[TPB + 1], v[TPB + 1], minv[TPB + 1];
+  __shared__ int p[TPB + 1], way[TPB + 1], used[TPB + 1];
+  __shared__ weight_t r_val[TPB];
+  __shared__ int r_idx[TPB];
+  __shared__ int s_j0;
+
+  for (int j = tid; j <= n; j += TPB) {
+    u[j] = weight_t{0};
+    v[j] = weight_t{0};
+    p[j] = 0;
+  }
+  __syncthreads();
+
+  for (int i = 1; i <= n; i++) {
+    if (tid == 0) {
+      p[0] = i;
+      s_j0 = 0;
+    }
+    for (int j = tid; j <= n; j += TPB) {
+      minv[j] = infinity;
+      used[j] = 0;
+    }
+    __syncthreads();
+
+    // grow the alternating tree until it reaches an unassigned column
+    while (true) {
+      int const j0 = s_j0;
+      if (tid == 0) { used[j0] = 1; }
+      __syncthreads();
+      int const i0 = p[j0];
+
+      // update the slacks of the columns outside the tree against the newly
+      // added row, and find the minimum slack among them
+      weight_t best = infinity;
+      int best_j    = 0;
+      for (int j = tid; j <= n; j += TPB) {
+        if (j >= 1 && !used[j]) {
+          weight_t cur = cost[(i0 - 1) * n + (j - 1)] - u[i0] - v[j];
+          if (cur < minv[j]) {
+            minv[j] = cur;
+            way[j]  = j0;
+          }
+          if (minv[j] < best) {
+            best   = minv[j];
+            best_j = j;
+          }
+        }
+      }
+      r_val[tid] = best;
+      r_idx[tid] = best_j;
+      __syncthreads();
+      for (int s = TPB / 2; s > 0; s >>= 1) {
+        if (tid < s && r_val[tid + s] < r_val[tid]) {
+          r_val[tid] = r_val[tid + s];
+          r_idx[tid] = r_idx[tid + s];
+        }
+        __syncthreads();
+      }
+      weight_t const delta = r_val[0];
+      int const j1         = r_idx[0];
+
+      // shift the duals so the tree edges stay tight and the column with the
+      // minimum slack enters with zero slack
+      for (int j = tid; j <= n; j += TPB) {
+        if (used[j]) {
+          u[p[j]] += delta;
+          v[j] -= delta;
+        } else {
+          minv[j] -= delta;
+        }
+      }
+      __syncthreads();
+      if (tid == 0) { s_j0 = j1; }
+      __syncthreads();
+      if (p[j1] == 0) break;
+    }
+
+    // augment along the path recorded in way[]
+    if (tid == 0) {
+      int j0 = s_j0;
+      do {
+        int const j1 = way[j0];
+        p[j0]        = p[j1];
+        j0           = j1;
+      } while (j0 != 0);
+    }
+    __syncthreads();
+  }
+
+  // write out assignments and duals, and reduce the objective values
+  weight_t primal = 0, dual = 0;
+  for (int c = tid; c < n; c += TPB) {
+    int const j                     = c + 1;
+    int const r                     = p[j] - 1;
+    d_col_assignments[spid * n + c] = vertex_t(r);
+    d_row_assignments[spid * n + r] = vertex_t(c);
+    d_row_duals[spid * n + r]       = u[p[j]];
+    d_col_duals[spid * n + c]       = v[j];
+    primal += cost[r * n + c];
+    dual += u[p[j]] + v[j];
+  }
+  r_val[tid] = primal;
+  __syncthreads();
+  for (int s = TPB / 2; s > 0; s >>= 1) {
+    if (tid < s) { r_val[tid] += r_val[tid + s]; }
+    __syncthreads();
+  }
+  if (tid == 0) { d_obj_val_primal[spid] = r_val[0]; }
+  __syncthreads();
+  r_val[tid] = dual;
+  __syncthreads();
+  for (int s = TPB / 2; s > 0; s >>= 1) {
+    if (tid < s) { r_val[tid] += r_val[tid + s]; }
+    __syncthreads();
+  }
+  if (tid == 0) { d_obj_val_dual[spid] = r_val[0]; }
+}
+
 }  // namespace detail
 }  // namespace lap
 }  // namespace raft
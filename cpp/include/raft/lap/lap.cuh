@@ -66,6 +66,10 @@ class LinearAssignmentProblem {
   rmm::device_uvector<weight_t> obj_val_primal_v;
   rmm::device_uvector<weight_t> obj_val_dual_v;
 
+  // set once a solve has produced dual variables that a later call can
+  // warm-start from
+  bool duals_valid_{false};
+
  public:
   LinearAssignmentProblem(raft::handle_t const& handle,
                           vertex_t size,
@@ -116,7 +120,88 @@ class LinearAssignmentProblem {
       }
     }
 
-    d_costs_ = nullptr;
+    d_costs_     = nullptr;
+    duals_valid_ = true;
+  }
+
+  // Executes the Hungarian algorithm warm-started from the dual variables of
+  // the previous solve on this object. The column duals are kept and the row
+  // duals are repaired against the new cost matrix, so when the costs change
+  // only slightly between calls (e.g. frame-to-frame tracking) most arcs stay
+  // tight and few augmenting iterations remain. The assignments are re-derived
+  // from the tight arcs of the seeded duals.
+  void solveWarm(weight_t const* d_cost_matrix,
+                 vertex_t* d_row_assignment,
+                 vertex_t* d_col_assignment)
+  {
+    ASSERT(duals_valid_, "lap::solveWarm: a previous solve is needed to warm-start from");
+
+    solveWarm(d_cost_matrix, d_row_assignment, d_col_assignment, col_duals_v.data());
+  }
+
+  // Warm-started solve seeded from an external column dual vector (of length
+  // batchsize * size, e.g. obtained via getColDualVector from another solver
+  // instance). The row duals are recomputed to restore dual feasibility, so
+  // only the column duals drive the warm start.
+  void solveWarm(weight_t const* d_cost_matrix,
+                 vertex_t* d_row_assignment,
+                 vertex_t* d_col_assignment,
+                 weight_t const* d_initial_col_duals)
+  {
+    initializeDevice(true);
+
+    if (d_initial_col_duals != col_duals_v.data()) {
+      raft::copy(
+        col_duals_v.data(), d_initial_col_duals, batchsize_ * size_, handle_.get_stream());
+    }
+
+    d_vertices_dev.row_assignments = d_row_assignment;
+    d_vertices_dev.col_assignments = d_col_assignment;
+
+    d_costs_ = d_cost_matrix;
+
+    detail::warmReduction(handle_, d_costs_, d_vertices_dev, batchsize_, size_);
+
+    int step = 1;
+
+    while (step != 100) {
+      switch (step) {
+        case 1: step = hungarianStep1(); break;
+        case 2: step = hungarianStep2(); break;
+        case 3: step = hungarianStep3(); break;
+        case 4: step = hungarianStep4(); break;
+        case 5: step = hungarianStep5(); break;
+        case 6: step = hungarianStep6(); break;
+      }
+    }
+
+    d_costs_     = nullptr;
+    duals_valid_ = true;
+  }
+
+  // Executes the Hungarian algorithm entirely on the device, one block per
+  // subproblem. Only valid for small problems (size <= 64). Unlike solve(),
+  // the host never synchronizes between phases, so a batch of many small
+  // subproblems runs as a single kernel launch instead of being latency-bound
+  // on host round trips.
+  void solveSmall(weight_t const* d_cost_matrix,
+                  vertex_t* d_row_assignment,
+                  vertex_t* d_col_assignment)
+  {
+    initializeDevice();
+
+    d_vertices_dev.row_assignments = d_row_assignment;
+    d_vertices_dev.col_assignments = d_col_assignment;
+
+    detail::smallSolve(handle_,
+                       d_cost_matrix,
+                       d_vertices_dev,
+                       obj_val_primal_v.data(),
+                       obj_val_dual_v.data(),
+                       batchsize_,
+                       size_);
+
+    duals_valid_ = true;
   }
 
   // Function for getting optimal row dual vector for subproblem spId.
@@ -151,7 +236,8 @@ class LinearAssignmentProblem {
 
  private:
   // Helper function for initializing global variables and arrays on a single host.
-  void initializeDevice()
+  // When warm is true the dual vectors keep their current (seeded) contents.
+  void initializeDevice(bool warm = false)
   {
     cudaStream_t stream = handle_.get_stream();
     row_covers_v.resize(batchsize_ * size_, stream);
@@ -184,8 +270,10 @@ class LinearAssignmentProblem {
 
     thrust::fill(thrust::device, row_covers_v.begin(), row_covers_v.end(), int{0});
     thrust::fill(thrust::device, col_covers_v.begin(), col_covers_v.end(), int{0});
-    thrust::fill(thrust::device, row_duals_v.begin(), row_duals_v.end(), weight_t{0});
-    thrust::fill(thrust::device, col_duals_v.begin(), col_duals_v.end(), weight_t{0});
+    if (!warm) {
+      thrust::fill(thrust::device, row_duals_v.begin(), row_duals_v.end(), weight_t{0});
+      thrust::fill(thrust::device, col_duals_v.begin(), col_duals_v.end(), weight_t{0});
+    }
   }
 
   // Function for calculating initial zeros by subtracting row and column minima from each element.
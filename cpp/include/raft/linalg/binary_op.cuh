@@ -20,6 +20,9 @@
 
 #include "detail/binary_op.cuh"
 
+#include <raft/core/aligned_span.hpp>
+#include <raft/core/handle.hpp>
+#include <raft/core/mdarray.hpp>
 #include <raft/cuda_utils.cuh>
 
 namespace raft {
@@ -52,6 +55,99 @@ void binaryOp(
   detail::binaryOp(out, in1, in2, len, op, stream);
 }
 
+/**
+ * @brief perform element-wise binary operation on aligned spans
+ *
+ * The spans' static alignment guarantee selects the vector width at compile
+ * time, so no per-call pointer probing happens and the full-width loads are
+ * always emitted (misaligned inputs were already rejected when the spans were
+ * constructed). Prefer this overload on hot paths fed by slices whose offsets
+ * are under the caller's control.
+ *
+ * @tparam Alignment byte alignment carried by all three spans
+ * @tparam InType input element type
+ * @tparam Lambda the device-lambda performing the actual operation
+ * @tparam OutType output element type
+ * @tparam IdxType Integer type used to for addressing
+ * @param out the output span
+ * @param in1 the first input span
+ * @param in2 the second input span (same size as in1)
+ * @param op the device-lambda
+ * @param stream cuda stream where to launch work
+ */
+template <std::size_t Alignment,
+          typename InType,
+          typename Lambda,
+          typename OutType = InType,
+          typename IdxType = int>
+void binaryOp(device_aligned_span<OutType, Alignment> out,
+              device_aligned_span<const InType, Alignment> in1,
+              device_aligned_span<const InType, Alignment> in2,
+              Lambda op,
+              cudaStream_t stream)
+{
+  RAFT_EXPECTS(in1.size() == in2.size() && in1.size() == out.size(),
+               "Sizes of in1, in2 and out must match");
+  detail::binaryOpAligned<Alignment, InType, Lambda, OutType, IdxType>(
+    out.data(), in1.data(), in2.data(), static_cast<IdxType>(out.size()), op, stream);
+}
+
+/**
+ * @brief perform element-wise binary operation on strided matrix views
+ *
+ * Accepts `layout_stride` views (e.g. submatrices sliced out of larger
+ * row-major matrices) directly, so callers do not have to compact their
+ * operands into contiguous buffers first. When all three views happen to be
+ * contiguous this falls through to the vectorized flat path.
+ *
+ * @tparam InType input element type
+ * @tparam Lambda the device-lambda performing the actual operation
+ * @tparam OutType output element type
+ * @tparam IdxType Integer type used to for addressing
+ * @param handle raft handle
+ * @param in1 first input matrix view (row-major, unit stride on columns)
+ * @param in2 second input matrix view (same extents as in1)
+ * @param out output matrix view (same extents as in1)
+ * @param op the device-lambda
+ */
+template <typename InType, typename Lambda, typename OutType = InType, typename IdxType = int>
+void binary_op(const raft::handle_t& handle,
+               device_matrix_view<InType, layout_stride> const in1,
+               device_matrix_view<InType, layout_stride> const in2,
+               device_matrix_view<OutType, layout_stride> out,
+               Lambda op)
+{
+  RAFT_EXPECTS(in1.extent(0) == in2.extent(0) && in1.extent(0) == out.extent(0) &&
+                 in1.extent(1) == in2.extent(1) && in1.extent(1) == out.extent(1),
+               "Extents of in1, in2 and out must match");
+  RAFT_EXPECTS(in1.stride(1) == 1 && in2.stride(1) == 1 && out.stride(1) == 1,
+               "Views must have a unit stride along columns");
+  auto n_rows  = static_cast<IdxType>(in1.extent(0));
+  auto n_cols  = static_cast<IdxType>(in1.extent(1));
+  auto stride1 = static_cast<IdxType>(in1.stride(0));
+  auto stride2 = static_cast<IdxType>(in2.stride(0));
+  auto strideo = static_cast<IdxType>(out.stride(0));
+  if (stride1 == n_cols && stride2 == n_cols && strideo == n_cols) {
+    detail::binaryOp(out.data(),
+                     in1.data(),
+                     in2.data(),
+                     static_cast<IdxType>(n_rows * n_cols),
+                     op,
+                     handle.get_stream());
+  } else {
+    detail::binaryOpStrided(out.data(),
+                            in1.data(),
+                            in2.data(),
+                            n_rows,
+                            n_cols,
+                            stride1,
+                            stride2,
+                            strideo,
+                            op,
+                            handle.get_stream());
+  }
+}
+
 };  // end namespace linalg
 };  // end namespace raft
 
@@ -132,6 +132,60 @@ void choleskyRank1Update(const raft::handle_t& handle,
 {
   detail::choleskyRank1Update(handle, L, n, ld, workspace, n_bytes, uplo, stream, eps);
 }
+
+/**
+ * @brief Blocked rank k update of Cholesky decomposition.
+ *
+ * Folds k new rows/columns into an existing Cholesky factor with one
+ * triangular solve (trsm), one symmetric update of the trailing block (syrk)
+ * and one k x k factorization (potrf), instead of k sequential rank 1
+ * updates. For batched insertions this replaces k sets of BLAS-2 calls with
+ * a single set of BLAS-3 calls.
+ *
+ * On entry, L is the Cholesky decomposition of a matrix A of size
+ * (n-k) x (n-k), and the k new rows/columns of the extended matrix A' are
+ * stored the same way as for choleskyRank1Update: as columns n-k..n-1 of L if
+ * uplo == CUBLAS_FILL_MODE_UPPER, else as rows n-k..n-1 of L. On exit those
+ * elements are overwritten with the new rows/columns of the factor, and the
+ * trailing k x k block holds its factorized diagonal block.
+ *
+ * Calling with k == 1 is equivalent to choleskyRank1Update, and calling with
+ * k == n factorizes A' from scratch.
+ *
+ * If the updated matrix is not positive definite the potrf step fails and an
+ * exception is thrown. If eps >= 0, eps is added to the diagonal of the
+ * trailing block before factorization and acts as a jitter for ill
+ * conditioned updates.
+ *
+ * @param handle RAFT handle (used to retrive cuBLAS handles).
+ * @param L device array for to store the triangular matrix L, and the new
+ *     columns of A in column major format, size [n*n]
+ * @param n size of the matrix after the update.
+ * @param k number of new rows/columns to fold in.
+ * @param ld stride of colums in L
+ * @param workspace device pointer to workspace shall be nullptr or an array
+ *    of size [n_bytes].
+ * @param n_bytes size of workspace is returned here if workspace==nullptr.
+ * @param uplo indicates whether L is stored as an upper or lower triangular
+ *    matrix (CUBLAS_FILL_MODE_UPPER or CUBLAS_FILL_MODE_LOWER)
+ * @param stream CUDA stream
+ * @param eps numerical parameter that can act as a regularizer for ill
+ *    conditioned systems. Negative values mean no regularizaton.
+ */
+template <typename math_t>
+void choleskyRankKUpdate(const raft::handle_t& handle,
+                         math_t* L,
+                         int n,
+                         int k,
+                         int ld,
+                         void* workspace,
+                         int* n_bytes,
+                         cublasFillMode_t uplo,
+                         cudaStream_t stream,
+                         math_t eps = -1)
+{
+  detail::choleskyRankKUpdate(handle, L, n, k, ld, workspace, n_bytes, uplo, stream, eps);
+}
 };  // namespace linalg
 };  // namespace raft
 
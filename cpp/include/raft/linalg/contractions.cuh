@@ -167,6 +167,59 @@ struct Policy4x4<double, _veclen> {
 };
 /** @} */
 
+/**
+ * @defgroup Policy4x4Wide 16 elements per thread Policy with twice the k-block
+ *           of `Policy4x4`. The deeper main loop doubles the shared memory
+ *           requirement (beyond the 48KB static limit, so launches must opt
+ *           into large dynamic shared memory), which pays off on arches with
+ *           large shared memory capacity (sm80 and newer).
+ * @{
+ */
+template <typename DataT, int _veclen>
+struct Policy4x4Wide {
+};
+
+template <int _veclen>
+struct Policy4x4Wide<float, _veclen> {
+  typedef KernelPolicy<float, _veclen, 64, 4, 4, 16, 16> Policy;
+  typedef ColKernelPolicy<float, _veclen, 64, 4, 4, 16, 16> ColPolicy;
+};
+
+template <int _veclen>
+struct Policy4x4Wide<double, _veclen> {
+  typedef KernelPolicy<double, _veclen, 32, 4, 4, 16, 16> Policy;
+  typedef ColKernelPolicy<double, _veclen, 32, 4, 4, 16, 16> ColPolicy;
+};
+/** @} */
+
+/**
+ * @defgroup Policy8x4 32 elements per thread Policy with a shallow k-block
+ *           (16 for float, 8 for double). Tuned for elementwise-heavy
+ *           (unexpanded) metrics such as Canberra, Chebyshev and Lp: their
+ *           per-element ops (abs, div, pow) are compute-bound, so deeper
+ *           per-thread accumulation buys ILP while the shallow k-block
+ *           keeps the shared memory traffic that those metrics cannot hide
+ *           to a minimum. The column-major variant keeps the symmetric 4x4
+ *           accumulator (a structural requirement) with the shallow k-block.
+ * @{
+ */
+template <typename DataT, int _veclen>
+struct Policy8x4 {
+};
+
+template <int _veclen>
+struct Policy8x4<float, _veclen> {
+  typedef KernelPolicy<float, _veclen, 16, 8, 4, 16, 16> Policy;
+  typedef ColKernelPolicy<float, _veclen, 16, 4, 4, 16, 16> ColPolicy;
+};
+
+template <int _veclen>
+struct Policy8x4<double, _veclen> {
+  typedef KernelPolicy<double, _veclen, 8, 8, 4, 16, 16> Policy;
+  typedef ColKernelPolicy<double, _veclen, 8, 4, 4, 16, 16> ColPolicy;
+};
+/** @} */
+
 /**
  * @defgroup Policy2x8 16 elements per thread Policy with k-block = 16
  * @{
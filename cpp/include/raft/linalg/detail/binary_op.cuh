@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <raft/common/detail/launch_config.cuh>
+#include <raft/integer_utils.h>
 #include <raft/vectorized.cuh>
 
 namespace raft {
@@ -46,9 +48,13 @@ template <typename InType, int VecLen, typename Lambda, typename IdxType, typena
 void binaryOpImpl(
   OutType* out, const InType* in1, const InType* in2, IdxType len, Lambda op, cudaStream_t stream)
 {
-  const IdxType nblks = raft::ceildiv(VecLen ? len / VecLen : len, (IdxType)TPB);
+  const IdxType work  = VecLen ? len / VecLen : len;
+  const int blksize =
+    raft::detail::elementwise_block_size(binaryOpKernel<InType, VecLen, Lambda, IdxType, OutType>,
+                                         size_t(work));
+  const IdxType nblks = raft::ceildiv(work, (IdxType)blksize);
   binaryOpKernel<InType, VecLen, Lambda, IdxType, OutType>
-    <<<nblks, TPB, 0, stream>>>(out, in1, in2, len, op);
+    <<<nblks, blksize, 0, stream>>>(out, in1, in2, len, op);
   RAFT_CUDA_TRY(cudaPeekAtLastError());
 }
 
@@ -93,6 +99,80 @@ void binaryOp(
   }
 }
 
+/**
+ * Variant for pointers whose byte alignment is known at compile time (cf.
+ * raft/core/aligned_span.hpp): the vector width is chosen statically instead
+ * of probing the three addresses at runtime. Only the length still has to be
+ * checked, since a tail shorter than the vector width needs the scalar kernel.
+ */
+template <std::size_t Alignment,
+          typename InType,
+          typename Lambda,
+          typename OutType = InType,
+          typename IdxType = int,
+          int TPB          = 256>
+void binaryOpAligned(
+  OutType* out, const InType* in1, const InType* in2, IdxType len, Lambda op, cudaStream_t stream)
+{
+  constexpr auto maxSize = sizeof(InType) > sizeof(OutType) ? sizeof(InType) : sizeof(OutType);
+  constexpr std::size_t vecBytes = Alignment < std::size_t(16) ? Alignment : std::size_t(16);
+  constexpr int VecLen           = vecBytes / maxSize ? int(vecBytes / maxSize) : 1;
+  if (size_t(len) * maxSize % vecBytes == 0) {
+    binaryOpImpl<InType, VecLen, Lambda, IdxType, OutType, TPB>(out, in1, in2, len, op, stream);
+  } else {
+    binaryOpImpl<InType, 1, Lambda, IdxType, OutType, TPB>(out, in1, in2, len, op, stream);
+  }
+}
+
+template <typename InType, typename Lambda, typename IdxType, typename OutType>
+__global__ void binaryOpStridedKernel(OutType* out,
+                                      const InType* in1,
+                                      const InType* in2,
+                                      IdxType len,
+                                      raft::fast_div_mod colsDiv,
+                                      IdxType stride1,
+                                      IdxType stride2,
+                                      IdxType strideOut,
+                                      Lambda op)
+{
+  IdxType idx = threadIdx.x + ((IdxType)blockIdx.x * blockDim.x);
+  if (idx >= len) return;
+  IdxType row, col;
+  colsDiv.divmod(idx, row, col);
+  out[row * strideOut + col] = op(in1[row * stride1 + col], in2[row * stride2 + col]);
+}
+
+/**
+ * Row-strided variant for matrix views that are not contiguous (e.g. windows
+ * sliced out of larger row-major matrices). Rows are indexed through the
+ * given leading dimensions; no vectorization is attempted since the row
+ * starts carry no alignment guarantee.
+ */
+template <typename InType, typename Lambda, typename OutType, typename IdxType>
+void binaryOpStrided(OutType* out,
+                     const InType* in1,
+                     const InType* in2,
+                     IdxType n_rows,
+                     IdxType n_cols,
+                     IdxType stride1,
+                     IdxType stride2,
+                     IdxType strideOut,
+                     Lambda op,
+                     cudaStream_t stream)
+{
+  if (n_rows <= 0 || n_cols <= 0) return;
+  const IdxType len = n_rows * n_cols;
+  // precomputed magic numbers turn the per-element row/col split into a
+  // multiply-high instead of a hardware division
+  raft::fast_div_mod colsDiv(uint32_t(n_cols));
+  const int blksize = raft::detail::elementwise_block_size(
+    binaryOpStridedKernel<InType, Lambda, IdxType, OutType>, size_t(len));
+  const IdxType nblks = raft::ceildiv(len, (IdxType)blksize);
+  binaryOpStridedKernel<InType, Lambda, IdxType, OutType><<<nblks, blksize, 0, stream>>>(
+    out, in1, in2, len, colsDiv, stride1, stride2, strideOut, op);
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
+}
+
 }  // namespace detail
 }  // namespace linalg
 }  // namespace raft
\ No newline at end of file
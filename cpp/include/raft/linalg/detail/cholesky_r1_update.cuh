@@ -123,6 +123,123 @@ void choleskyRank1Update(const raft::handle_t& handle,
   raft::update_device(L_22, &L_22_host, 1, stream);
 }
 
+template <typename math_t>
+__global__ void choleskyAddDiagonalKernel(math_t* L, int offset, int k, int ld, math_t eps)
+{
+  int i = threadIdx.x + blockIdx.x * blockDim.x;
+  if (i < k) { L[(offset + i) * ld + offset + i] += eps; }
+}
+
+template <typename math_t>
+void choleskyRankKUpdate(const raft::handle_t& handle,
+                         math_t* L,
+                         int n,
+                         int k,
+                         int ld,
+                         void* workspace,
+                         int* n_bytes,
+                         cublasFillMode_t uplo,
+                         cudaStream_t stream,
+                         math_t eps = -1)
+{
+  // Blocked version of choleskyRank1Update: instead of adding one row/column
+  // at a time, the k new rows/columns of A' are folded in with one set of
+  // BLAS-3 calls. With
+  // A' = [[A_11, A_12]
+  //       [A_21, A_22]]
+  // where A_11 = A is m x m (m = n - k) and A_22 is k x k, the new factor is
+  // L' = [[L_11,    0]
+  //       [L_21, L_22]]
+  // obtained by one triangular solve for the panel L_21 (trsm), one symmetric
+  // rank-m update of the trailing block (syrk), and one k x k factorization
+  // of the result (potrf).
+  int m = n - k;
+
+  // The workspace stores the potrf scratch space and a devInfo scalar.
+  cusolverDnHandle_t cusolverH = handle.get_cusolver_dn_handle();
+  int potrf_lwork              = 0;
+  RAFT_CUSOLVER_TRY(cusolverDnpotrf_bufferSize(
+    cusolverH, uplo, k > 0 ? k : 1, L, ld, &potrf_lwork));
+  const int align = 256;
+  int offset      = raft::alignTo<int>(sizeof(math_t) * potrf_lwork, align);
+  if (workspace == nullptr) {
+    *n_bytes = offset + sizeof(int);
+    return;
+  }
+  RAFT_EXPECTS(k >= 1 && k <= n, "choleskyRankKUpdate: k must be in [1, n]");
+
+  math_t* potrf_work = reinterpret_cast<math_t*>(workspace);
+  int* dev_info      = reinterpret_cast<int*>(((char*)workspace) + offset);
+
+  math_t* L_22 = L + (size_t)m * ld + m;
+
+  if (m > 0) {
+    math_t alpha = 1;
+    math_t m_one = -1;
+    math_t one   = 1;
+    if (uplo == CUBLAS_FILL_MODE_UPPER) {
+      // The new columns A_12 are stored as columns m..n-1 of U. Solve
+      // U_11^T X = A_12 in place, giving the panel U_12.
+      math_t* U_12 = L + (size_t)m * ld;
+      RAFT_CUBLAS_TRY(cublastrsm(handle.get_cublas_handle(),
+                                 CUBLAS_SIDE_LEFT,
+                                 uplo,
+                                 CUBLAS_OP_T,
+                                 CUBLAS_DIAG_NON_UNIT,
+                                 m,
+                                 k,
+                                 &alpha,
+                                 L,
+                                 ld,
+                                 U_12,
+                                 ld,
+                                 stream));
+      // A_22 <- A_22 - U_12^T U_12
+      RAFT_CUBLAS_TRY(cublassyrk(
+        handle.get_cublas_handle(), uplo, CUBLAS_OP_T, k, m, &m_one, U_12, ld, &one, L_22, ld, stream));
+    } else {
+      // The new rows A_21 are stored as rows m..n-1 of L (non contiguous, but
+      // trsm/syrk take the leading dimension, so both work in place). Solve
+      // X L_11^T = A_21, giving the panel L_21.
+      math_t* L_21 = L + m;
+      RAFT_CUBLAS_TRY(cublastrsm(handle.get_cublas_handle(),
+                                 CUBLAS_SIDE_RIGHT,
+                                 uplo,
+                                 CUBLAS_OP_T,
+                                 CUBLAS_DIAG_NON_UNIT,
+                                 k,
+                                 m,
+                                 &alpha,
+                                 L,
+                                 ld,
+                                 L_21,
+                                 ld,
+                                 stream));
+      // A_22 <- A_22 - L_21 L_21^T
+      RAFT_CUBLAS_TRY(cublassyrk(
+        handle.get_cublas_handle(), uplo, CUBLAS_OP_N, k, m, &m_one, L_21, ld, &one, L_22, ld, stream));
+    }
+  }
+
+  // Optional jitter on the diagonal of the trailing block to keep ill
+  // conditioned updates positive definite (same role as eps in the rank one
+  // update).
+  if (eps >= 0) {
+    int tpb = 64;
+    choleskyAddDiagonalKernel<<<raft::ceildiv(k, tpb), tpb, 0, stream>>>(L, m, k, ld, eps);
+    RAFT_CUDA_TRY(cudaPeekAtLastError());
+  }
+
+  // L_22 <- chol(A_22 - panel * panel^T), factorized in place in the trailing
+  // k x k block of L.
+  RAFT_CUSOLVER_TRY(cusolverDnpotrf(
+    cusolverH, uplo, k, L_22, ld, potrf_work, potrf_lwork, dev_info, stream));
+  int info_host;
+  raft::update_host(&info_host, dev_info, 1, stream);
+  handle.sync_stream(stream);
+  ASSERT(info_host == 0, "Error during Cholesky rank k update: potrf info=%d", info_host);
+}
+
 }  // namespace detail
 }  // namespace linalg
 }  // namespace raft
@@ -18,6 +18,13 @@
 
 #include <cub/cub.cuh>
 #include <raft/cuda_utils.cuh>
+#include <raft/integer_utils.h>
+#include <raft/vectorized.cuh>
+
+#include <rmm/device_uvector.hpp>
+
+#include <algorithm>
+#include <cstdint>
 
 namespace raft {
 namespace linalg {
@@ -62,6 +69,132 @@ __global__ void coalescedReductionKernel(OutType* dots,
   }
 }
 
+// Rows below this length are reduced by a single block each; longer rows take
+// the multi-block path with vectorized loads below.
+constexpr int coalescedReductionMinWideD = 16384;
+// Target number of elements reduced by each block on the wide path.
+constexpr int coalescedReductionElemsPerBlock = 8192;
+constexpr int coalescedReductionMaxBlocksPerRow = 64;
+
+// Wide-row kernel: each row is split into vector-aligned segments and each
+// block reduces one segment with TxN_t vectorized loads, writing its partial
+// result to a [N, blocksPerRow] scratch buffer.
+template <typename InType,
+          typename OutType,
+          typename IdxType,
+          int TPB,
+          int VecLen,
+          typename MainLambda,
+          typename ReduceLambda>
+__global__ void coalescedReductionWideKernel(OutType* partial,
+                                             const InType* data,
+                                             int D,
+                                             int N,
+                                             OutType init,
+                                             int blocksPerRow,
+                                             raft::fast_div_mod blocksPerRowDiv,
+                                             MainLambda main_op,
+                                             ReduceLambda reduce_op)
+{
+  typedef cub::BlockReduce<OutType, TPB> BlockReduce;
+  __shared__ typename BlockReduce::TempStorage temp_storage;
+
+  IdxType row, seg;
+  blocksPerRowDiv.divmod((IdxType)blockIdx.x, row, seg);
+
+  // segment lengths are multiples of the vector width, so every load below
+  // is a full, aligned vector
+  IdxType segLen = raft::ceildiv<IdxType>(D, blocksPerRow * VecLen) * VecLen;
+  IdxType start  = seg * segLen;
+  IdxType stop   = min(start + segLen, (IdxType)D);
+
+  OutType thread_data = init;
+  TxN_t<InType, VecLen> vec;
+  IdxType rowStart = row * D;
+  for (IdxType i = start + threadIdx.x * VecLen; i < stop; i += TPB * VecLen) {
+    vec.load(data, rowStart + i);
+#pragma unroll
+    for (int j = 0; j < VecLen; j++) {
+      thread_data = reduce_op(thread_data, main_op(vec.val.data[j], i + j));
+    }
+  }
+  OutType acc = BlockReduce(temp_storage).Reduce(thread_data, reduce_op);
+  if (threadIdx.x == 0) { partial[row * blocksPerRow + seg] = acc; }
+}
+
+// Reduces the per-segment partials of one row in a fixed tree order. The
+// reduction order depends only on the launch configuration, so results are
+// bitwise reproducible across runs.
+template <typename OutType,
+          typename IdxType,
+          int TPB,
+          typename ReduceLambda,
+          typename FinalLambda>
+__global__ void coalescedReductionFinalizeKernel(OutType* dots,
+                                                 const OutType* partial,
+                                                 int blocksPerRow,
+                                                 OutType init,
+                                                 ReduceLambda reduce_op,
+                                                 FinalLambda final_op,
+                                                 bool inplace)
+{
+  typedef cub::BlockReduce<OutType, TPB> BlockReduce;
+  __shared__ typename BlockReduce::TempStorage temp_storage;
+  OutType thread_data = init;
+  IdxType rowStart    = (IdxType)blockIdx.x * blocksPerRow;
+  for (IdxType i = threadIdx.x; i < blocksPerRow; i += TPB) {
+    thread_data = reduce_op(thread_data, partial[rowStart + i]);
+  }
+  OutType acc = BlockReduce(temp_storage).Reduce(thread_data, reduce_op);
+  if (threadIdx.x == 0) {
+    if (inplace) {
+      dots[blockIdx.x] = final_op(reduce_op(dots[blockIdx.x], acc));
+    } else {
+      dots[blockIdx.x] = final_op(acc);
+    }
+  }
+}
+
+template <typename InType,
+          typename OutType,
+          typename IdxType,
+          int VecLen,
+          typename MainLambda,
+          typename ReduceLambda,
+          typename FinalLambda>
+void coalescedReductionWide(OutType* dots,
+                            const InType* data,
+                            int D,
+                            int N,
+                            OutType init,
+                            cudaStream_t stream,
+                            bool inplace,
+                            MainLambda main_op,
+                            ReduceLambda reduce_op,
+                            FinalLambda final_op)
+{
+  constexpr int TPB = 256;
+
+  int blocksPerRow =
+    std::min(raft::ceildiv(D, coalescedReductionElemsPerBlock), coalescedReductionMaxBlocksPerRow);
+
+  rmm::device_uvector<OutType> partial((size_t)N * blocksPerRow, stream);
+
+  coalescedReductionWideKernel<InType, OutType, IdxType, TPB, VecLen>
+    <<<(size_t)N * blocksPerRow, TPB, 0, stream>>>(partial.data(),
+                                                   data,
+                                                   D,
+                                                   N,
+                                                   init,
+                                                   blocksPerRow,
+                                                   raft::fast_div_mod(uint32_t(blocksPerRow)),
+                                                   main_op,
+                                                   reduce_op);
+
+  coalescedReductionFinalizeKernel<OutType, IdxType, TPB>
+    <<<N, TPB, 0, stream>>>(dots, partial.data(), blocksPerRow, init, reduce_op, final_op, inplace);
+}
+
 template <typename InType,
           typename OutType      = InType,
           typename IdxType      = int,
@@ -90,13 +223,35 @@ void coalescedReduction(OutType* dots,
   } else if (D <= 128) {
     coalescedReductionKernel<InType, OutType, IdxType, 128>
       <<<N, 128, 0, stream>>>(dots, data, D, N, init, main_op, reduce_op, final_op, inplace);
-  } else {
+  } else if (D < coalescedReductionMinWideD) {
     coalescedReductionKernel<InType, OutType, IdxType, 256>
       <<<N, 256, 0, stream>>>(dots, data, D, N, init, main_op, reduce_op, final_op, inplace);
+  } else {
+    // Very wide rows: several blocks per row with vectorized loads, followed
+    // by a deterministic tree reduction of the per-block partials. Rows are
+    // vector-aligned whenever the row length (in bytes) keeps them so.
+    size_t bytes     = sizeof(InType) * (size_t)D;
+    uint64_t dataAddr = uint64_t(data);
+    if (16 / sizeof(InType) && bytes % 16 == 0 && dataAddr % 16 == 0) {
+      coalescedReductionWide<InType, OutType, IdxType, 16 / sizeof(InType)>(
+        dots, data, D, N, init, stream, inplace, main_op, reduce_op, final_op);
+    } else if (8 / sizeof(InType) && bytes % 8 == 0 && dataAddr % 8 == 0) {
+      coalescedReductionWide<InType, OutType, IdxType, 8 / sizeof(InType)>(
+        dots, data, D, N, init, stream, inplace, main_op, reduce_op, final_op);
+    } else if (4 / sizeof(InType) && bytes % 4 == 0 && dataAddr % 4 == 0) {
+      coalescedReductionWide<InType, OutType, IdxType, 4 / sizeof(InType)>(
+        dots, data, D, N, init, stream, inplace, main_op, reduce_op, final_op);
+    } else if (2 / sizeof(InType) && bytes % 2 == 0 && dataAddr % 2 == 0) {
+      coalescedReductionWide<InType, OutType, IdxType, 2 / sizeof(InType)>(
+        dots, data, D, N, init, stream, inplace, main_op, reduce_op, final_op);
+    } else {
+      coalescedReductionWide<InType, OutType, IdxType, 1>(
+        dots, data, D, N, init, stream, inplace, main_op, reduce_op, final_op);
+    }
   }
   RAFT_CUDA_TRY(cudaPeekAtLastError());
 }
 
 }  // namespace detail
 }  // namespace linalg
-}  // namespace raft
\ No newline at end of file
+}  // namespace raft
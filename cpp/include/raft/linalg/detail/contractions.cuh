@@ -186,6 +186,40 @@ struct Contractions_NT {
     ldsY(kidx, sy + pageRd * P::SmemPage);
   }
 
+  /** size in bytes of one vectorized load per thread */
+  static constexpr int VecBytes = P::Veclen * int(sizeof(DataT));
+
+  /**
+   * @brief Copy the current block of X/Y straight from global to shared memory
+   *
+   * Uses cp.async on sm_80+, so no registers are burnt on staging and the
+   * copy overlaps with whatever compute follows; it completes only after
+   * `ldgstsWait()` plus a `__syncthreads()`. Out-of-bounds vectors are
+   * zero-filled with a regular shared-memory store. Column-major inputs and
+   * vector sizes without a cp.async shape fall back to `ldgXY()` + `stsXY()`.
+   *
+   * @param[in] kidx current start index of k to be loaded
+   */
+  DI void ldgstsXY(IdxT kidx)
+  {
+    if constexpr (isRowMajor && (VecBytes == 4 || VecBytes == 8 || VecBytes == 16)) {
+      ldgstsX(kidx, sx + pageWr * P::SmemPage);
+      ldgstsY(kidx, sy + pageWr * P::SmemPage);
+      cp_async_commit();
+    } else {
+      ldgXY(kidx);
+      stsXY();
+    }
+  }
+
+  /** @brief Wait for the copies issued by `ldgstsXY` to land in shared memory */
+  DI void ldgstsWait()
+  {
+    if constexpr (isRowMajor && (VecBytes == 4 || VecBytes == 8 || VecBytes == 16)) {
+      cp_async_wait_all();
+    }
+  }
+
  private:
   DI void ldgX(IdxT kidx)
   {
@@ -253,6 +287,46 @@ struct Contractions_NT {
     }
   }
 
+  DI void ldgstsX(IdxT kidx, DataT* smem)
+  {
+    auto* saddr  = smem + srowid * P::SmemStride + scolid;
+    auto numRows = m;
+    auto koffset = kidx + scolid;
+#pragma unroll
+    for (int i = 0; i < P::LdgPerThX; ++i) {
+      auto* dst = saddr + i * P::LdgRowsX * P::SmemStride;
+      if (koffset < lda && (xrowid + i * P::LdgRowsX) < numRows) {
+        cp_async<VecBytes>(dst, x + i * P::LdgRowsX * lda + koffset);
+      } else {
+#pragma unroll
+        for (int j = 0; j < P::Veclen; ++j) {
+          ldgDataX[i][j] = Zero;
+        }
+        sts(dst, ldgDataX[i]);
+      }
+    }
+  }
+
+  DI void ldgstsY(IdxT kidx, DataT* smem)
+  {
+    auto* saddr  = smem + srowid * P::SmemStride + scolid;
+    auto numRows = n;
+    auto koffset = kidx + scolid;
+#pragma unroll
+    for (int i = 0; i < P::LdgPerThY; ++i) {
+      auto* dst = saddr + i * P::LdgRowsY * P::SmemStride;
+      if (koffset < ldb && (yrowid + i * P::LdgRowsY) < numRows) {
+        cp_async<VecBytes>(dst, y + i * P::LdgRowsY * ldb + koffset);
+      } else {
+#pragma unroll
+        for (int j = 0; j < P::Veclen; ++j) {
+          ldgDataY[i][j] = Zero;
+        }
+        sts(dst, ldgDataY[i]);
+      }
+    }
+  }
+
   DI void stsX(DataT* smem)
   {
     auto* saddr = smem + srowid * P::SmemStride + scolid;
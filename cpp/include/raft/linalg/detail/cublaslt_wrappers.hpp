@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include <cublasLt.h>
+
+#include <raft/core/cublas_macros.hpp>
+#include <raft/handle.hpp>
+
+namespace raft {
+namespace linalg {
+namespace detail {
+
+template <typename T>
+struct cublaslt_dtype {
+};
+template <>
+struct cublaslt_dtype<float> {
+  static constexpr cudaDataType_t value      = CUDA_R_32F;
+  static constexpr cublasComputeType_t accum = CUBLAS_COMPUTE_32F;
+};
+template <>
+struct cublaslt_dtype<double> {
+  static constexpr cudaDataType_t value      = CUDA_R_64F;
+  static constexpr cublasComputeType_t accum = CUBLAS_COMPUTE_64F;
+};
+template <>
+struct cublaslt_dtype<__half> {
+  static constexpr cudaDataType_t value = CUDA_R_16F;
+  // fp16 inputs accumulate in fp32
+  static constexpr cublasComputeType_t accum = CUBLAS_COMPUTE_32F;
+};
+
+template <typename T, typename = void>
+struct has_cublaslt_dtype : std::false_type {
+};
+template <typename T>
+struct has_cublaslt_dtype<T, std::void_t<decltype(cublaslt_dtype<T>::value)>> : std::true_type {
+};
+
+/** Problem-shape key for the matmul heuristic cache */
+struct matmul_key_t {
+  std::uint64_t lt_handle;
+  int m, n, k;
+  int lda, ldb, ldc;
+  bool trans_a, trans_b;
+  int dtype;
+  int batch_count;
+  std::int64_t stride_a, stride_b, stride_c;
+
+  bool operator==(const matmul_key_t& o) const
+  {
+    return lt_handle == o.lt_handle && m == o.m && n == o.n && k == o.k && lda == o.lda &&
+           ldb == o.ldb && ldc == o.ldc && trans_a == o.trans_a && trans_b == o.trans_b &&
+           dtype == o.dtype && batch_count == o.batch_count && stride_a == o.stride_a &&
+           stride_b == o.stride_b && stride_c == o.stride_c;
+  }
+};
+
+struct matmul_key_hash_t {
+  std::size_t operator()(const matmul_key_t& key) const
+  {
+    std::size_t seed = std::hash<std::uint64_t>{}(key.lt_handle);
+    for (auto v : {key.m,
+                   key.n,
+                   key.k,
+                   key.lda,
+                   key.ldb,
+                   key.ldc,
+                   int(key.trans_a),
+                   int(key.trans_b),
+                   key.dtype,
+                   key.batch_count}) {
+      seed ^= std::hash<int>{}(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+    for (auto v : {key.stride_a, key.stride_b, key.stride_c}) {
+      seed ^= std::hash<std::int64_t>{}(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+    return seed;
+  }
+};
+
+/**
+ * Cache of cublasLt heuristic results. The key includes the cublasLt handle,
+ * so entries are effectively per raft handle (and thus per device); repeated
+ * GEMMs of the same shape skip the heuristic query entirely.
+ */
+inline std::unordered_map<matmul_key_t, cublasLtMatmulAlgo_t, matmul_key_hash_t>&
+matmul_algo_cache()
+{
+  static std::unordered_map<matmul_key_t, cublasLtMatmulAlgo_t, matmul_key_hash_t> cache;
+  return cache;
+}
+
+inline std::mutex& matmul_algo_cache_mutex()
+{
+  static std::mutex mtx;
+  return mtx;
+}
+
+/**
+ * @brief cublasLt-backed GEMM: C = alpha * opA(A) * opB(B) + beta * C
+ *
+ * Column-major, host scalars. The matmul algo is selected via
+ * cublasLtMatmulAlgoGetHeuristic on first use of a given shape and cached
+ * keyed on (handle, shape, leading dims, transposes, dtype, batch layout).
+ * With batch_count > 1, A/B/C are strided batches of matrices.
+ *
+ * @return true if the Lt path executed; false if no heuristic was available
+ *   for the problem (caller should fall back to legacy cublas<t>gemm)
+ */
+template <typename math_t, std::enable_if_t<has_cublaslt_dtype<math_t>::value, int> = 0>
+bool gemm_lt(const raft::handle_t& handle,
+             const bool trans_a,
+             const bool trans_b,
+             const int m,
+             const int n,
+             const int k,
+             const math_t* alpha,
+             const math_t* A,
+             const int lda,
+             const math_t* B,
+             const int ldb,
+             const math_t* beta,
+             math_t* C,
+             const int ldc,
+             cudaStream_t stream,
+             const int batch_count        = 1,
+             const std::int64_t stride_a  = 0,
+             const std::int64_t stride_b  = 0,
+             const std::int64_t stride_c  = 0)
+{
+  auto lt       = handle.get_cublaslt_handle();
+  auto dtype    = cublaslt_dtype<math_t>::value;
+  auto comptype = cublaslt_dtype<math_t>::accum;
+
+  cublasLtMatmulDesc_t op_desc;
+  RAFT_CUBLAS_TRY(cublasLtMatmulDescCreate(&op_desc, comptype, dtype));
+  cublasOperation_t op_a = trans_a ? CUBLAS_OP_T : CUBLAS_OP_N;
+  cublasOperation_t op_b = trans_b ? CUBLAS_OP_T : CUBLAS_OP_N;
+  RAFT_CUBLAS_TRY(
+    cublasLtMatmulDescSetAttribute(op_desc, CUBLASLT_MATMUL_DESC_TRANSA, &op_a, sizeof(op_a)));
+  RAFT_CUBLAS_TRY(
+    cublasLtMatmulDescSetAttribute(op_desc, CUBLASLT_MATMUL_DESC_TRANSB, &op_b, sizeof(op_b)));
+
+  cublasLtMatrixLayout_t a_desc, b_desc, c_desc;
+  RAFT_CUBLAS_TRY(
+    cublasLtMatrixLayoutCreate(&a_desc, dtype, trans_a ? k : m, trans_a ? m : k, lda));
+  RAFT_CUBLAS_TRY(
+    cublasLtMatrixLayoutCreate(&b_desc, dtype, trans_b ? n : k, trans_b ? k : n, ldb));
+  RAFT_CUBLAS_TRY(cublasLtMatrixLayoutCreate(&c_desc, dtype, m, n, ldc));
+
+  if (batch_count > 1) {
+    for (auto [desc, stride] : {std::make_pair(a_desc, stride_a),
+                                std::make_pair(b_desc, stride_b),
+                                std::make_pair(c_desc, stride_c)}) {
+      RAFT_CUBLAS_TRY(cublasLtMatrixLayoutSetAttribute(
+        desc, CUBLASLT_MATRIX_LAYOUT_BATCH_COUNT, &batch_count, sizeof(batch_count)));
+      RAFT_CUBLAS_TRY(cublasLtMatrixLayoutSetAttribute(
+        desc, CUBLASLT_MATRIX_LAYOUT_STRIDED_BATCH_OFFSET, &stride, sizeof(stride)));
+    }
+  }
+
+  matmul_key_t key{reinterpret_cast<std::uint64_t>(lt),
+                   m,
+                   n,
+                   k,
+                   lda,
+                   ldb,
+                   ldc,
+                   trans_a,
+                   trans_b,
+                   static_cast<int>(dtype),
+                   batch_count,
+                   stride_a,
+                   stride_b,
+                   stride_c};
+
+  cublasLtMatmulAlgo_t algo;
+  bool have_algo = false;
+  {
+    std::lock_guard<std::mutex> _(matmul_algo_cache_mutex());
+    auto it = matmul_algo_cache().find(key);
+    if (it != matmul_algo_cache().end()) {
+      algo      = it->second;
+      have_algo = true;
+    }
+  }
+  if (!have_algo) {
+    cublasLtMatmulPreference_t pref;
+    RAFT_CUBLAS_TRY(cublasLtMatmulPreferenceCreate(&pref));
+    // the Lt path is used without an external workspace
+    std::size_t ws_size = 0;
+    RAFT_CUBLAS_TRY(cublasLtMatmulPreferenceSetAttribute(
+      pref, CUBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES, &ws_size, sizeof(ws_size)));
+    cublasLtMatmulHeuristicResult_t heuristic;
+    int n_results = 0;
+    auto status   = cublasLtMatmulAlgoGetHeuristic(
+      lt, op_desc, a_desc, b_desc, c_desc, c_desc, pref, 1, &heuristic, &n_results);
+    RAFT_CUBLAS_TRY(cublasLtMatmulPreferenceDestroy(pref));
+    if (status == CUBLAS_STATUS_SUCCESS && n_results > 0) {
+      algo      = heuristic.algo;
+      have_algo = true;
+      std::lock_guard<std::mutex> _(matmul_algo_cache_mutex());
+      matmul_algo_cache().emplace(key, algo);
+    }
+  }
+
+  cublasStatus_t status = CUBLAS_STATUS_NOT_SUPPORTED;
+  if (have_algo) {
+    status = cublasLtMatmul(lt,
+                            op_desc,
+                            alpha,
+                            A,
+                            a_desc,
+                            B,
+                            b_desc,
+                            beta,
+                            C,
+                            c_desc,
+                            C,
+                            c_desc,
+                            &algo,
+                            nullptr,
+                            0,
+                            stream);
+  }
+
+  RAFT_CUBLAS_TRY(cublasLtMatrixLayoutDestroy(c_desc));
+  RAFT_CUBLAS_TRY(cublasLtMatrixLayoutDestroy(b_desc));
+  RAFT_CUBLAS_TRY(cublasLtMatrixLayoutDestroy(a_desc));
+  RAFT_CUBLAS_TRY(cublasLtMatmulDescDestroy(op_desc));
+
+  if (!have_algo) { return false; }
+  RAFT_CUBLAS_TRY(status);
+  return true;
+}
+
+/** Non-cublasLt types fall back to the legacy wrappers */
+template <typename math_t, std::enable_if_t<!has_cublaslt_dtype<math_t>::value, int> = 0>
+bool gemm_lt(const raft::handle_t&,
+             const bool,
+             const bool,
+             const int,
+             const int,
+             const int,
+             const math_t*,
+             const math_t*,
+             const int,
+             const math_t*,
+             const int,
+             const math_t*,
+             math_t*,
+             const int,
+             cudaStream_t,
+             const int          = 1,
+             const std::int64_t = 0,
+             const std::int64_t = 0,
+             const std::int64_t = 0)
+{
+  return false;
+}
+
+}  // namespace detail
+}  // namespace linalg
+}  // namespace raft
@@ -693,6 +693,129 @@ inline cusolverStatus_t CUSOLVERAPI cusolverDngesvdj(  // NOLINT
   return cusolverDnDgesvdj(
     handle, jobz, econ, m, n, A, lda, S, U, ldu, V, ldv, work, lwork, info, params);
 }
+template <typename T>
+inline cusolverStatus_t CUSOLVERAPI cusolverDngesvdjBatched_bufferSize(  // NOLINT
+  cusolverDnHandle_t handle,
+  cusolverEigMode_t jobz,
+  int m,
+  int n,
+  const T* A,
+  int lda,
+  const T* S,
+  const T* U,
+  int ldu,
+  const T* V,
+  int ldv,
+  int* lwork,
+  gesvdjInfo_t params,
+  int batchSize);
+template <>
+inline cusolverStatus_t CUSOLVERAPI cusolverDngesvdjBatched_bufferSize(  // NOLINT
+  cusolverDnHandle_t handle,
+  cusolverEigMode_t jobz,
+  int m,
+  int n,
+  const float* A,
+  int lda,
+  const float* S,
+  const float* U,
+  int ldu,
+  const float* V,
+  int ldv,
+  int* lwork,
+  gesvdjInfo_t params,
+  int batchSize)
+{
+  return cusolverDnSgesvdjBatched_bufferSize(
+    handle, jobz, m, n, A, lda, S, U, ldu, V, ldv, lwork, params, batchSize);
+}
+template <>
+inline cusolverStatus_t CUSOLVERAPI cusolverDngesvdjBatched_bufferSize(  // NOLINT
+  cusolverDnHandle_t handle,
+  cusolverEigMode_t jobz,
+  int m,
+  int n,
+  const double* A,
+  int lda,
+  const double* S,
+  const double* U,
+  int ldu,
+  const double* V,
+  int ldv,
+  int* lwork,
+  gesvdjInfo_t params,
+  int batchSize)
+{
+  return cusolverDnDgesvdjBatched_bufferSize(
+    handle, jobz, m, n, A, lda, S, U, ldu, V, ldv, lwork, params, batchSize);
+}
+template <typename T>
+inline cusolverStatus_t CUSOLVERAPI cusolverDngesvdjBatched(  // NOLINT
+  cusolverDnHandle_t handle,
+  cusolverEigMode_t jobz,
+  int m,
+  int n,
+  T* A,
+  int lda,
+  T* S,
+  T* U,
+  int ldu,
+  T* V,
+  int ldv,
+  T* work,
+  int lwork,
+  int* info,
+  gesvdjInfo_t params,
+  int batchSize,
+  cudaStream_t stream);
+template <>
+inline cusolverStatus_t CUSOLVERAPI cusolverDngesvdjBatched(  // NOLINT
+  cusolverDnHandle_t handle,
+  cusolverEigMode_t jobz,
+  int m,
+  int n,
+  float* A,
+  int lda,
+  float* S,
+  float* U,
+  int ldu,
+  float* V,
+  int ldv,
+  float* work,
+  int lwork,
+  int* info,
+  gesvdjInfo_t params,
+  int batchSize,
+  cudaStream_t stream)
+{
+  RAFT_CUSOLVER_TRY(cusolverDnSetStream(handle, stream));
+  return cusolverDnSgesvdjBatched(
+    handle, jobz, m, n, A, lda, S, U, ldu, V, ldv, work, lwork, info, params, batchSize);
+}
+template <>
+inline cusolverStatus_t CUSOLVERAPI cusolverDngesvdjBatched(  // NOLINT
+  cusolverDnHandle_t handle,
+  cusolverEigMode_t jobz,
+  int m,
+  int n,
+  double* A,
+  int lda,
+  double* S,
+  double* U,
+  int ldu,
+  double* V,
+  int ldv,
+  double* work,
+  int lwork,
+  int* info,
+  gesvdjInfo_t params,
+  int batchSize,
+  cudaStream_t stream)
+{
+  RAFT_CUSOLVER_TRY(cusolverDnSetStream(handle, stream));
+  return cusolverDnDgesvdjBatched(
+    handle, jobz, m, n, A, lda, S, U, ldu, V, ldv, work, lwork, info, params, batchSize);
+}
 /** @} */
 
 /**
@@ -823,6 +946,101 @@ inline cusolverStatus_t cusolverDnpotrs(cusolverDnHandle_t handle,  // NOLINT
 }
 /** @} */
 
+/**
+ * @defgroup potrfBatched cusolver potrfBatched operations
+ * @{
+ */
+template <typename T>
+cusolverStatus_t cusolverDnpotrfBatched(cusolverDnHandle_t handle,  // NOLINT
+                                        cublasFillMode_t uplo,
+                                        int n,
+                                        T* Aarray[],
+                                        int lda,
+                                        int* infoArray,
+                                        int batchSize,
+                                        cudaStream_t stream);
+
+template <>
+inline cusolverStatus_t cusolverDnpotrfBatched(cusolverDnHandle_t handle,  // NOLINT
+                                               cublasFillMode_t uplo,
+                                               int n,
+                                               float* Aarray[],
+                                               int lda,
+                                               int* infoArray,
+                                               int batchSize,
+                                               cudaStream_t stream)
+{
+  RAFT_CUSOLVER_TRY(cusolverDnSetStream(handle, stream));
+  return cusolverDnSpotrfBatched(handle, uplo, n, Aarray, lda, infoArray, batchSize);
+}
+
+template <>
+inline cusolverStatus_t cusolverDnpotrfBatched(cusolverDnHandle_t handle,  // NOLINT
+                                               cublasFillMode_t uplo,
+                                               int n,
+                                               double* Aarray[],
+                                               int lda,
+                                               int* infoArray,
+                                               int batchSize,
+                                               cudaStream_t stream)
+{
+  RAFT_CUSOLVER_TRY(cusolverDnSetStream(handle, stream));
+  return cusolverDnDpotrfBatched(handle, uplo, n, Aarray, lda, infoArray, batchSize);
+}
+/** @} */
+
+/**
+ * @defgroup potrsBatched cusolver potrsBatched operations
+ * @{
+ */
+template <typename T>
+cusolverStatus_t cusolverDnpotrsBatched(cusolverDnHandle_t handle,  // NOLINT
+                                        cublasFillMode_t uplo,
+                                        int n,
+                                        int nrhs,
+                                        T* Aarray[],
+                                        int lda,
+                                        T* Barray[],
+                                        int ldb,
+                                        int* devInfo,
+                                        int batchSize,
+                                        cudaStream_t stream);
+
+template <>
+inline cusolverStatus_t cusolverDnpotrsBatched(cusolverDnHandle_t handle,  // NOLINT
+                                               cublasFillMode_t uplo,
+                                               int n,
+                                               int nrhs,
+                                               float* Aarray[],
+                                               int lda,
+                                               float* Barray[],
+                                               int ldb,
+                                               int* devInfo,
+                                               int batchSize,
+                                               cudaStream_t stream)
+{
+  RAFT_CUSOLVER_TRY(cusolverDnSetStream(handle, stream));
+  return cusolverDnSpotrsBatched(handle, uplo, n, nrhs, Aarray, lda, Barray, ldb, devInfo, batchSize);
+}
+
+template <>
+inline cusolverStatus_t cusolverDnpotrsBatched(cusolverDnHandle_t handle,  // NOLINT
+                                               cublasFillMode_t uplo,
+                                               int n,
+                                               int nrhs,
+                                               double* Aarray[],
+                                               int lda,
+                                               double* Barray[],
+                                               int ldb,
+                                               int* devInfo,
+                                               int batchSize,
+                                               cudaStream_t stream)
+{
+  RAFT_CUSOLVER_TRY(cusolverDnSetStream(handle, stream));
+  return cusolverDnDpotrsBatched(handle, uplo, n, nrhs, Aarray, lda, Barray, ldb, devInfo, batchSize);
+}
+/** @} */
+
 /**
  * @defgroup geqrf cusolver geqrf operations
  * @{
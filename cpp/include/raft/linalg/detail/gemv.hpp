@@ -19,6 +19,7 @@
 #include <cublas_v2.h>
 
 #include "cublas_wrappers.hpp"
+#include "gemm.hpp"
 
 #include <raft/handle.hpp>
 
@@ -141,6 +142,53 @@ void gemv(const raft::handle_t& handle,
   gemv(handle, A, n_rows_a, n_cols_a, lda, x, y, trans_a, alpha, beta, stream);
 }
 
+/**
+ * @brief batched gemv: y_i = alpha * op(A_i) * x_i + beta * y_i
+ *
+ * Operand i starts stride elements after operand i-1. Expressed as a
+ * strided-batched gemm with a single right-hand-side column, so the whole
+ * batch runs in one kernel launch; cublas<t>gemvStridedBatched is not
+ * available on all supported toolkits.
+ */
+template <typename math_t>
+void gemv_batched(const raft::handle_t& handle,
+                  const math_t* A,
+                  const int n_rows_a,
+                  const int n_cols_a,
+                  const int64_t stride_a,
+                  const math_t* x,
+                  const int64_t stride_x,
+                  math_t* y,
+                  const int64_t stride_y,
+                  const bool trans_a,
+                  const math_t alpha,
+                  const math_t beta,
+                  const int batch_count,
+                  cudaStream_t stream)
+{
+  int m = trans_a ? n_cols_a : n_rows_a;
+  int k = trans_a ? n_rows_a : n_cols_a;
+  gemm_strided_batched(handle,
+                       trans_a,
+                       false,
+                       m,
+                       1,
+                       k,
+                       &alpha,
+                       A,
+                       n_rows_a,
+                       stride_a,
+                       x,
+                       k,
+                       stride_x,
+                       &beta,
+                       y,
+                       m,
+                       stride_y,
+                       batch_count,
+                       stream);
+}
+
 };  // namespace detail
 };  // namespace linalg
 };  // namespace raft
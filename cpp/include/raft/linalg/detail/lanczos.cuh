@@ -20,17 +20,21 @@
 #define _USE_MATH_DEFINES
 
 #include <cmath>
+#include <memory>
+#include <type_traits>
 #include <vector>
 
 #include <cuda.h>
 #include <curand.h>
 
 #include "cublas_wrappers.hpp"
+#include <raft/cuda_utils.cuh>
 #include <raft/cudart_utils.h>
 #include <raft/handle.hpp>
 #include <raft/spectral/detail/lapack.hpp>
 #include <raft/spectral/detail/warn_dbg.hpp>
 #include <raft/spectral/matrix_wrappers.hpp>
+#include <rmm/device_uvector.hpp>
 
 namespace raft {
 namespace linalg {
@@ -52,6 +56,97 @@ inline curandStatus_t curandGenerateNormalX(
 // Helper functions
 // =========================================================
 
+/**
+ *  @brief  Convergence telemetry for the restarted Lanczos solvers.
+ *    Collected on request by computeSmallestEigenvectors and
+ *    computeLargestEigenvectors. Intended for tuning restartIter and
+ *    maxIter from measured behavior rather than guesswork.
+ *  @tparam index_type_t the type of data used for indexing.
+ *  @tparam value_type_t the type of data used for weights, distances.
+ */
+template <typename index_type_t, typename value_type_t>
+struct lanczos_telemetry_t {
+  /** Total number of Lanczos steps performed (same as totalIter). */
+  index_type_t total_iters{0};
+  /** Number of implicit restarts performed. */
+  index_type_t restarts{0};
+  /** Number of sparse matrix-vector products, including those used to
+   *  estimate the largest eigenvalue for the shift. */
+  index_type_t spmv_count{0};
+  /** Residual estimate |beta * z| per computed eigenpair. */
+  std::vector<value_type_t> residuals;
+};
+
+template <typename index_type_t, typename value_type_t>
+static __global__ void convertToFloatKernel(const value_type_t* __restrict__ in,
+                                            float* __restrict__ out,
+                                            index_type_t n)
+{
+  index_type_t i = threadIdx.x + blockIdx.x * blockDim.x;
+  if (i < n) out[i] = static_cast<float>(in[i]);
+}
+
+template <typename index_type_t, typename value_type_t>
+static __global__ void csrMvShiftFp32Kernel(index_type_t nrows,
+                                            const index_type_t* __restrict__ row_offsets,
+                                            const index_type_t* __restrict__ col_indices,
+                                            const float* __restrict__ values,
+                                            const float* __restrict__ x_fp32,
+                                            value_type_t shift,
+                                            const value_type_t* __restrict__ x,
+                                            value_type_t* __restrict__ y)
+{
+  index_type_t row = threadIdx.x + blockIdx.x * blockDim.x;
+  if (row >= nrows) return;
+  float sum = 0.f;
+  for (index_type_t j = row_offsets[row]; j < row_offsets[row + 1]; ++j)
+    sum += values[j] * x_fp32[col_indices[j]];
+  y[row] = static_cast<value_type_t>(sum) + shift * x[row];
+}
+
+/**
+ *  @brief  Single-precision matrix application for the Lanczos solvers.
+ *    Applies A+shift*I with the matrix values and the input vector
+ *    down-converted to fp32, while the Lanczos vectors and the
+ *    orthogonalization stay in full precision. The matrix values are
+ *    converted once at construction; the input vector is converted on
+ *    every application.
+ *  @tparam index_type_t the type of data used for indexing.
+ *  @tparam value_type_t the type of data used for weights, distances.
+ */
+template <typename index_type_t, typename value_type_t>
+class lanczos_fp32_spmv_t {
+ public:
+  lanczos_fp32_spmv_t(handle_t const& handle,
+                      spectral::matrix::sparse_matrix_t<index_type_t, value_type_t> const& A)
+    : A_(A), values_fp32_(A.nnz_, handle.get_stream()), x_fp32_(A.nrows_, handle.get_stream())
+  {
+    auto stream = handle.get_stream();
+    convertToFloatKernel<<<raft::ceildiv<index_type_t>(A.nnz_, TPB), TPB, 0, stream>>>(
+      A.values_, values_fp32_.data(), A.nnz_);
+    RAFT_CUDA_TRY(cudaPeekAtLastError());
+  }
+
+  /** Computes y = A*x + shift*x with fp32 accumulation for A*x. */
+  void mv(handle_t const& handle, const value_type_t* x, value_type_t shift, value_type_t* y)
+  {
+    auto stream    = handle.get_stream();
+    index_type_t n = A_.nrows_;
+    convertToFloatKernel<<<raft::ceildiv<index_type_t>(n, TPB), TPB, 0, stream>>>(
+      x, x_fp32_.data(), n);
+    csrMvShiftFp32Kernel<<<raft::ceildiv<index_type_t>(n, TPB), TPB, 0, stream>>>(
+      n, A_.row_offsets_, A_.col_indices_, values_fp32_.data(), x_fp32_.data(), shift, x, y);
+    RAFT_CUDA_TRY(cudaPeekAtLastError());
+  }
+
+ private:
+  static constexpr index_type_t TPB = 256;
+
+  spectral::matrix::sparse_matrix_t<index_type_t, value_type_t> const& A_;
+  rmm::device_uvector<float> values_fp32_;
+  rmm::device_uvector<float> x_fp32_;
+};
+
 /**
  *  @brief  Perform Lanczos iteration
  *    Lanczos iteration is performed on a shifted matrix A+shift*I.
@@ -79,6 +174,11 @@ inline curandStatus_t curandGenerateNormalX(
  *    n x (maxIter+1).
  *  @param work_dev (Output, device memory, maxIter entries)
  *    Workspace. Not needed if full reorthogonalization is disabled.
+ *  @param spmv_count Optional counter incremented once per sparse
+ *    matrix-vector product.
+ *  @param fp32_spmv Optional single-precision matrix application. When
+ *    non-null, replaces A->mv; the orthogonalization still runs in
+ *    value_type_t precision.
  *  @return Zero if successful. Otherwise non-zero.
  */
 template <typename index_type_t, typename value_type_t>
@@ -92,7 +192,9 @@ int performLanczosIteration(handle_t const& handle,
                             value_type_t* __restrict__ alpha_host,
                             value_type_t* __restrict__ beta_host,
                             value_type_t* __restrict__ lanczosVecs_dev,
-                            value_type_t* __restrict__ work_dev)
+                            value_type_t* __restrict__ work_dev,
+                            index_type_t* spmv_count                              = nullptr,
+                            lanczos_fp32_spmv_t<index_type_t, value_type_t>* fp32_spmv = nullptr)
 {
   // -------------------------------------------------------
   // Variable declaration
@@ -118,13 +220,18 @@ int performLanczosIteration(handle_t const& handle,
     *iter = 1;
 
     // Apply matrix
-    if (shift != 0)
-      RAFT_CUDA_TRY(cudaMemcpyAsync(lanczosVecs_dev + n,
-                                    lanczosVecs_dev,
-                                    n * sizeof(value_type_t),
-                                    cudaMemcpyDeviceToDevice,
-                                    stream));
-    A->mv(1, lanczosVecs_dev, shift, lanczosVecs_dev + n);
+    if (fp32_spmv != nullptr) {
+      fp32_spmv->mv(handle, lanczosVecs_dev, shift, lanczosVecs_dev + n);
+    } else {
+      if (shift != 0)
+        RAFT_CUDA_TRY(cudaMemcpyAsync(lanczosVecs_dev + n,
+                                      lanczosVecs_dev,
+                                      n * sizeof(value_type_t),
+                                      cudaMemcpyDeviceToDevice,
+                                      stream));
+      A->mv(1, lanczosVecs_dev, shift, lanczosVecs_dev + n);
+    }
+    if (spmv_count != nullptr) ++(*spmv_count);
 
     // Orthogonalize Lanczos vector
     RAFT_CUBLAS_TRY(cublasdot(
@@ -151,13 +258,19 @@ int performLanczosIteration(handle_t const& handle,
     ++(*iter);
 
     // Apply matrix
-    if (shift != 0)
-      RAFT_CUDA_TRY(cudaMemcpyAsync(lanczosVecs_dev + (*iter) * n,
-                                    lanczosVecs_dev + (*iter - 1) * n,
-                                    n * sizeof(value_type_t),
-                                    cudaMemcpyDeviceToDevice,
-                                    stream));
-    A->mv(1, lanczosVecs_dev + IDX(0, *iter - 1, n), shift, lanczosVecs_dev + IDX(0, *iter, n));
+    if (fp32_spmv != nullptr) {
+      fp32_spmv->mv(
+        handle, lanczosVecs_dev + IDX(0, *iter - 1, n), shift, lanczosVecs_dev + IDX(0, *iter, n));
+    } else {
+      if (shift != 0)
+        RAFT_CUDA_TRY(cudaMemcpyAsync(lanczosVecs_dev + (*iter) * n,
+                                      lanczosVecs_dev + (*iter - 1) * n,
+                                      n * sizeof(value_type_t),
+                                      cudaMemcpyDeviceToDevice,
+                                      stream));
+      A->mv(1, lanczosVecs_dev + IDX(0, *iter - 1, n), shift, lanczosVecs_dev + IDX(0, *iter, n));
+    }
+    if (spmv_count != nullptr) ++(*spmv_count);
 
     // Full reorthogonalization
     //   "Twice is enough" algorithm per Kahan and Parlett
@@ -739,6 +852,12 @@ static int lanczosRestart(handle_t const& handle,
  *    matrix. Vectors are stored as columns of a column-major matrix
  *    with dimensions n x nEigVecs.
  *  @param seed random seed.
+ *  @param telemetry Optional convergence telemetry. When non-null, the
+ *    struct is reset and filled with iteration, restart, and SpMV
+ *    counts plus residual estimates per eigenpair.
+ *  @param use_fp32_spmv Whether to apply the matrix in single
+ *    precision while keeping the orthogonalization in value_type_t
+ *    precision. Ignored unless value_type_t is double.
  *  @return error flag.
  */
 template <typename index_type_t, typename value_type_t>
@@ -759,7 +878,9 @@ int computeSmallestEigenvectors(
   value_type_t* __restrict__ work_dev,
   value_type_t* __restrict__ eigVals_dev,
   value_type_t* __restrict__ eigVecs_dev,
-  unsigned long long seed)
+  unsigned long long seed,
+  lanczos_telemetry_t<index_type_t, value_type_t>* telemetry = nullptr,
+  bool use_fp32_spmv                                         = false)
 {
   // Useful constants
   constexpr value_type_t one  = 1;
@@ -804,6 +925,21 @@ int computeSmallestEigenvectors(
   // Total number of Lanczos iterations
   *totalIter = 0;
 
+  // Telemetry counters
+  index_type_t spmv_count = 0;
+  if (telemetry != nullptr) {
+    telemetry->total_iters = 0;
+    telemetry->restarts    = 0;
+    telemetry->spmv_count  = 0;
+    telemetry->residuals.assign(nEigVecs, 0);
+  }
+
+  // Optional single-precision matrix application. Only worthwhile when
+  // value_type_t is wider than float.
+  std::unique_ptr<lanczos_fp32_spmv_t<index_type_t, value_type_t>> fp32_spmv;
+  if (use_fp32_spmv && std::is_same<value_type_t, double>::value)
+    fp32_spmv.reset(new lanczos_fp32_spmv_t<index_type_t, value_type_t>(handle, *A));
+
   // Allocate host memory
   std::vector<value_type_t> Z_host_v(restartIter * restartIter);
   std::vector<value_type_t> work_host_v(4 * restartIter);
@@ -846,7 +982,9 @@ int computeSmallestEigenvectors(
                                                                alpha_host,
                                                                beta_host,
                                                                lanczosVecs_dev,
-                                                               work_dev);
+                                                               work_dev,
+                                                               &spmv_count,
+                                                               fp32_spmv.get());
   if (status) WARNING("error in Lanczos iteration");
 
   // Determine largest eigenvalue
@@ -871,7 +1009,9 @@ int computeSmallestEigenvectors(
                                                                alpha_host,
                                                                beta_host,
                                                                lanczosVecs_dev,
-                                                               work_dev);
+                                                               work_dev,
+                                                               &spmv_count,
+                                                               fp32_spmv.get());
   if (status) WARNING("error in Lanczos iteration");
   *totalIter += *effIter;
 
@@ -903,6 +1043,7 @@ int computeSmallestEigenvectors(
                                                         true);
     if (status) WARNING("error in Lanczos implicit restart");
     *effIter = iter_new;
+    if (telemetry != nullptr) ++(telemetry->restarts);
 
     // Check for convergence
     if (beta_host[*effIter - 1] <= tol * fabs(shiftLower)) break;
@@ -919,7 +1060,9 @@ int computeSmallestEigenvectors(
                                                                  alpha_host,
                                                                  beta_host,
                                                                  lanczosVecs_dev,
-                                                                 work_dev);
+                                                                 work_dev,
+                                                                 &spmv_count,
+                                                                 fp32_spmv.get());
     if (status) WARNING("error in Lanczos iteration");
     *totalIter += *effIter - iter_new;
   }
@@ -977,6 +1120,17 @@ int computeSmallestEigenvectors(
                              n,
                              stream));
 
+  // Record telemetry
+  //   Residual of a Ritz pair is |beta * z|, where z is the last entry
+  //   of the corresponding eigenvector of the tridiagonal system.
+  if (telemetry != nullptr) {
+    telemetry->total_iters = *totalIter;
+    telemetry->spmv_count  = spmv_count;
+    for (i = 0; i < nEigVecs && i < *effIter; ++i)
+      telemetry->residuals[i] =
+        std::fabs(beta_host[*effIter - 1] * Z_host[IDX(*effIter - 1, i, *effIter)]);
+  }
+
   // Clean up and exit
   curandDestroyGenerator(randGen);
   return 0;
@@ -994,7 +1148,9 @@ int computeSmallestEigenvectors(
   index_type_t& iter,
   value_type_t* __restrict__ eigVals_dev,
   value_type_t* __restrict__ eigVecs_dev,
-  unsigned long long seed = 1234567)
+  unsigned long long seed                                    = 1234567,
+  lanczos_telemetry_t<index_type_t, value_type_t>* telemetry = nullptr,
+  bool use_fp32_spmv                                         = false)
 {
   // Matrix dimension
   index_type_t n = A.nrows_;
@@ -1035,7 +1191,9 @@ int computeSmallestEigenvectors(
                                            work_dev.raw(),
                                            eigVals_dev,
                                            eigVecs_dev,
-                                           seed);
+                                           seed,
+                                           telemetry,
+                                           use_fp32_spmv);
 
   // Clean up and return
   return status;
@@ -1083,6 +1241,12 @@ int computeSmallestEigenvectors(
  *    matrix. Vectors are stored as columns of a column-major matrix
  *    with dimensions n x nEigVecs.
  *  @param seed random seed.
+ *  @param telemetry Optional convergence telemetry. When non-null, the
+ *    struct is reset and filled with iteration, restart, and SpMV
+ *    counts plus residual estimates per eigenpair.
+ *  @param use_fp32_spmv Whether to apply the matrix in single
+ *    precision while keeping the orthogonalization in value_type_t
+ *    precision. Ignored unless value_type_t is double.
  *  @return error flag.
  */
 template <typename index_type_t, typename value_type_t>
@@ -1102,7 +1266,9 @@ int computeLargestEigenvectors(
   value_type_t* __restrict__ work_dev,
   value_type_t* __restrict__ eigVals_dev,
   value_type_t* __restrict__ eigVecs_dev,
-  unsigned long long seed)
+  unsigned long long seed,
+  lanczos_telemetry_t<index_type_t, value_type_t>* telemetry = nullptr,
+  bool use_fp32_spmv                                         = false)
 {
   // Useful constants
   constexpr value_type_t one  = 1;
@@ -1148,6 +1314,21 @@ int computeLargestEigenvectors(
   // Total number of Lanczos iterations
   *totalIter = 0;
 
+  // Telemetry counters
+  index_type_t spmv_count = 0;
+  if (telemetry != nullptr) {
+    telemetry->total_iters = 0;
+    telemetry->restarts    = 0;
+    telemetry->spmv_count  = 0;
+    telemetry->residuals.assign(nEigVecs, 0);
+  }
+
+  // Optional single-precision matrix application. Only worthwhile when
+  // value_type_t is wider than float.
+  std::unique_ptr<lanczos_fp32_spmv_t<index_type_t, value_type_t>> fp32_spmv;
+  if (use_fp32_spmv && std::is_same<value_type_t, double>::value)
+    fp32_spmv.reset(new lanczos_fp32_spmv_t<index_type_t, value_type_t>(handle, *A));
+
   // Allocate host memory
   std::vector<value_type_t> Z_host_v(restartIter * restartIter);
   std::vector<value_type_t> work_host_v(4 * restartIter);
@@ -1190,7 +1371,9 @@ int computeLargestEigenvectors(
                                                                alpha_host,
                                                                beta_host,
                                                                lanczosVecs_dev,
-                                                               work_dev);
+                                                               work_dev,
+                                                               &spmv_count,
+                                                               fp32_spmv.get());
   if (status) WARNING("error in Lanczos iteration");
   *totalIter += *effIter;
 
@@ -1222,6 +1405,7 @@ int computeLargestEigenvectors(
                                                         false);
     if (status) WARNING("error in Lanczos implicit restart");
     *effIter = iter_new;
+    if (telemetry != nullptr) ++(telemetry->restarts);
 
     // Check for convergence
     if (beta_host[*effIter - 1] <= tol * fabs(shiftLower)) break;
@@ -1238,7 +1422,9 @@ int computeLargestEigenvectors(
                                                                  alpha_host,
                                                                  beta_host,
                                                                  lanczosVecs_dev,
-                                                                 work_dev);
+                                                                 work_dev,
+                                                                 &spmv_count,
+                                                                 fp32_spmv.get());
     if (status) WARNING("error in Lanczos iteration");
     *totalIter += *effIter - iter_new;
   }
@@ -1324,6 +1510,18 @@ int computeLargestEigenvectors(
                              n,
                              stream));
 
+  // Record telemetry
+  //   Residual of a Ritz pair is |beta * z|, where z is the last entry
+  //   of the corresponding eigenvector of the tridiagonal system.
+  if (telemetry != nullptr) {
+    telemetry->total_iters = *totalIter;
+    telemetry->spmv_count  = spmv_count;
+    for (i = 0; i < nEigVecs; ++i)
+      telemetry->residuals[i] = std::fabs(
+        beta_host[*effIter - 1] *
+        Z_host[IDX(*effIter - 1, top_eigenparis_idx_offset + i, *effIter)]);
+  }
+
   // Clean up and exit
   curandDestroyGenerator(randGen);
   return 0;
@@ -1341,7 +1539,9 @@ int computeLargestEigenvectors(
   index_type_t& iter,
   value_type_t* __restrict__ eigVals_dev,
   value_type_t* __restrict__ eigVecs_dev,
-  unsigned long long seed = 123456)
+  unsigned long long seed                                    = 123456,
+  lanczos_telemetry_t<index_type_t, value_type_t>* telemetry = nullptr,
+  bool use_fp32_spmv                                         = false)
 {
   // Matrix dimension
   index_type_t n = A.nrows_;
@@ -1380,7 +1580,9 @@ int computeLargestEigenvectors(
                                           work_dev.raw(),
                                           eigVals_dev,
                                           eigVecs_dev,
-                                          seed);
+                                          seed,
+                                          telemetry,
+                                          use_fp32_spmv);
 
   // Clean up and return
   return status;
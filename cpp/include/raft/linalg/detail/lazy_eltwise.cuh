@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/common/detail/launch_config.cuh>
+#include <raft/cuda_utils.cuh>
+
+#include <type_traits>
+
+namespace raft {
+namespace linalg {
+namespace detail {
+
+/**
+ * Expression templates for elementwise chains. Composing lazy expressions
+ * only builds a small trivially-copyable tree of pointers and scalars; no
+ * work happens until lazy_eval(), which launches a single kernel that walks
+ * the tree per element. A chain of N elementwise ops thus traverses the
+ * buffers once instead of N times.
+ */
+
+template <typename Expr>
+struct lazy_expr_base {
+};
+
+template <typename Expr>
+using is_lazy_expr = std::is_base_of<lazy_expr_base<Expr>, Expr>;
+
+/** leaf node: a device array indexed directly */
+template <typename Type>
+struct lazy_array : public lazy_expr_base<lazy_array<Type>> {
+  typedef Type value_type;
+
+  const Type* ptr;
+
+  explicit lazy_array(const Type* _ptr) : ptr(_ptr) {}
+
+  DI Type eval(size_t idx) const { return ptr[idx]; }
+};
+
+/** leaf node: a scalar broadcast across all elements */
+template <typename Type>
+struct lazy_scalar : public lazy_expr_base<lazy_scalar<Type>> {
+  typedef Type value_type;
+
+  Type value;
+
+  explicit lazy_scalar(Type _value) : value(_value) {}
+
+  DI Type eval(size_t) const { return value; }
+};
+
+template <typename Op, typename ExprT>
+struct lazy_unary_expr : public lazy_expr_base<lazy_unary_expr<Op, ExprT>> {
+  typedef typename ExprT::value_type value_type;
+
+  ExprT expr;
+
+  explicit lazy_unary_expr(const ExprT& _expr) : expr(_expr) {}
+
+  DI value_type eval(size_t idx) const { return Op::apply(expr.eval(idx)); }
+};
+
+template <typename Op, typename LhsT, typename RhsT>
+struct lazy_binary_expr : public lazy_expr_base<lazy_binary_expr<Op, LhsT, RhsT>> {
+  typedef typename LhsT::value_type value_type;
+
+  LhsT lhs;
+  RhsT rhs;
+
+  lazy_binary_expr(const LhsT& _lhs, const RhsT& _rhs) : lhs(_lhs), rhs(_rhs) {}
+
+  DI value_type eval(size_t idx) const { return Op::apply(lhs.eval(idx), rhs.eval(idx)); }
+};
+
+// the operator set mirrors the eager eltwise/matrix math ops
+struct lazy_add_op {
+  template <typename Type>
+  static DI Type apply(Type a, Type b)
+  {
+    return a + b;
+  }
+};
+
+struct lazy_sub_op {
+  template <typename Type>
+  static DI Type apply(Type a, Type b)
+  {
+    return a - b;
+  }
+};
+
+struct lazy_mul_op {
+  template <typename Type>
+  static DI Type apply(Type a, Type b)
+  {
+    return a * b;
+  }
+};
+
+struct lazy_div_op {
+  template <typename Type>
+  static DI Type apply(Type a, Type b)
+  {
+    return a / b;
+  }
+};
+
+struct lazy_pow_op {
+  template <typename Type>
+  static DI Type apply(Type a, Type b)
+  {
+    return raft::myPow(a, b);
+  }
+};
+
+struct lazy_sqrt_op {
+  template <typename Type>
+  static DI Type apply(Type a)
+  {
+    return raft::mySqrt(a);
+  }
+};
+
+struct lazy_abs_op {
+  template <typename Type>
+  static DI Type apply(Type a)
+  {
+    return raft::myAbs(a);
+  }
+};
+
+struct lazy_exp_op {
+  template <typename Type>
+  static DI Type apply(Type a)
+  {
+    return raft::myExp(a);
+  }
+};
+
+struct lazy_log_op {
+  template <typename Type>
+  static DI Type apply(Type a)
+  {
+    return raft::myLog(a);
+  }
+};
+
+/** wraps arithmetic operands into scalar leaves, passes expressions through */
+template <typename Type, typename = std::enable_if_t<std::is_arithmetic<Type>::value>>
+lazy_scalar<Type> as_lazy_expr(Type value)
+{
+  return lazy_scalar<Type>(value);
+}
+
+template <typename ExprT, typename = std::enable_if_t<is_lazy_expr<ExprT>::value>>
+const ExprT& as_lazy_expr(const ExprT& expr)
+{
+  return expr;
+}
+
+template <typename Op, typename LhsT, typename RhsT>
+auto make_lazy_binary(const LhsT& lhs, const RhsT& rhs)
+{
+  auto l = as_lazy_expr(lhs);
+  auto r = as_lazy_expr(rhs);
+  return lazy_binary_expr<Op, std::decay_t<decltype(l)>, std::decay_t<decltype(r)>>(l, r);
+}
+
+// at least one operand must already be an expression, so that these
+// operators never capture plain scalar arithmetic
+template <typename LhsT, typename RhsT>
+using enable_lazy_op_t = std::enable_if_t<is_lazy_expr<std::decay_t<LhsT>>::value ||
+                                            is_lazy_expr<std::decay_t<RhsT>>::value,
+                                          int>;
+
+template <typename LhsT, typename RhsT, enable_lazy_op_t<LhsT, RhsT> = 0>
+auto operator+(const LhsT& lhs, const RhsT& rhs)
+{
+  return make_lazy_binary<lazy_add_op>(lhs, rhs);
+}
+
+template <typename LhsT, typename RhsT, enable_lazy_op_t<LhsT, RhsT> = 0>
+auto operator-(const LhsT& lhs, const RhsT& rhs)
+{
+  return make_lazy_binary<lazy_sub_op>(lhs, rhs);
+}
+
+template <typename LhsT, typename RhsT, enable_lazy_op_t<LhsT, RhsT> = 0>
+auto operator*(const LhsT& lhs, const RhsT& rhs)
+{
+  return make_lazy_binary<lazy_mul_op>(lhs, rhs);
+}
+
+template <typename LhsT, typename RhsT, enable_lazy_op_t<LhsT, RhsT> = 0>
+auto operator/(const LhsT& lhs, const RhsT& rhs)
+{
+  return make_lazy_binary<lazy_div_op>(lhs, rhs);
+}
+
+template <typename LhsT, typename RhsT, enable_lazy_op_t<LhsT, RhsT> = 0>
+auto lazy_power(const LhsT& lhs, const RhsT& rhs)
+{
+  return make_lazy_binary<lazy_pow_op>(lhs, rhs);
+}
+
+template <typename ExprT, typename = std::enable_if_t<is_lazy_expr<ExprT>::value>>
+auto lazy_sqrt(const ExprT& expr)
+{
+  return lazy_unary_expr<lazy_sqrt_op, ExprT>(expr);
+}
+
+template <typename ExprT, typename = std::enable_if_t<is_lazy_expr<ExprT>::value>>
+auto lazy_abs(const ExprT& expr)
+{
+  return lazy_unary_expr<lazy_abs_op, ExprT>(expr);
+}
+
+template <typename ExprT, typename = std::enable_if_t<is_lazy_expr<ExprT>::value>>
+auto lazy_exp(const ExprT& expr)
+{
+  return lazy_unary_expr<lazy_exp_op, ExprT>(expr);
+}
+
+template <typename ExprT, typename = std::enable_if_t<is_lazy_expr<ExprT>::value>>
+auto lazy_log(const ExprT& expr)
+{
+  return lazy_unary_expr<lazy_log_op, ExprT>(expr);
+}
+
+template <typename OutType, typename ExprT>
+__global__ void lazyEvalKernel(OutType* out, size_t len, ExprT expr)
+{
+  auto idx = (threadIdx.x + (blockIdx.x * blockDim.x));
+
+  if (idx < len) { out[idx] = expr.eval(idx); }
+}
+
+template <typename OutType, typename ExprT>
+void lazyEvalImpl(OutType* out, size_t len, const ExprT& expr, cudaStream_t stream)
+{
+  const int blksize =
+    raft::detail::elementwise_block_size(lazyEvalKernel<OutType, ExprT>, len);
+  const int nblks = raft::ceildiv(len, (size_t)blksize);
+  lazyEvalKernel<OutType, ExprT><<<nblks, blksize, 0, stream>>>(out, len, expr);
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
+}
+
+}  // namespace detail
+}  // namespace linalg
+};  // namespace raft
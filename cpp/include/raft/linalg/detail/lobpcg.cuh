@@ -0,0 +1,371 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <cuda.h>
+
+#include "cublas_wrappers.hpp"
+#include "cusolver_wrappers.hpp"
+#include <raft/cuda_utils.cuh>
+#include <raft/cudart_utils.h>
+#include <raft/handle.hpp>
+#include <raft/linalg/eig.cuh>
+#include <raft/random/rng.cuh>
+#include <raft/spectral/detail/warn_dbg.hpp>
+#include <raft/spectral/matrix_wrappers.hpp>
+#include <rmm/device_uvector.hpp>
+
+namespace raft {
+namespace linalg {
+namespace detail {
+
+/**
+ *  @brief Compute block residual R = A*X - X*diag(w).
+ *    Block and grid dimensions should be 1-dimensional. Ideally the
+ *    grid is large enough so there are n*m threads.
+ *  @tparam index_type_t the type of data used for indexing.
+ *  @tparam value_type_t the type of data used for weights, distances.
+ *  @param n Number of rows.
+ *  @param m Number of block vectors.
+ *  @param X (Input, n*m entries) Ritz vectors, stored column-major.
+ *  @param AX (Input, n*m entries) A times the Ritz vectors.
+ *  @param w (Input, m entries) Ritz values.
+ *  @param R (Output, n*m entries) Residual block.
+ */
+template <typename index_type_t, typename value_type_t>
+static __global__ void blockResidual(index_type_t n,
+                                     index_type_t m,
+                                     const value_type_t* __restrict__ X,
+                                     const value_type_t* __restrict__ AX,
+                                     const value_type_t* __restrict__ w,
+                                     value_type_t* __restrict__ R)
+{
+  index_type_t total = n * m;
+  index_type_t i     = threadIdx.x + blockIdx.x * static_cast<index_type_t>(blockDim.x);
+  while (i < total) {
+    index_type_t col = i / n;
+    R[i]             = AX[i] - w[col] * X[i];
+    i += blockDim.x * static_cast<index_type_t>(gridDim.x);
+  }
+}
+
+/**
+ *  @brief Orthonormalize the columns of a block with Cholesky QR.
+ *    Forms the Gram matrix G = V^T V, factors it as L*L^T and replaces
+ *    V with V*L^-T. When a second block AV is given it is transformed
+ *    with the same triangular solve, so AV = A*V is preserved.
+ *  @tparam index_type_t the type of data used for indexing.
+ *  @tparam value_type_t the type of data used for weights, distances.
+ *  @param handle the raft handle.
+ *  @param n Number of rows.
+ *  @param m Number of block vectors.
+ *  @param V (Input/output, device memory, n*m entries) Block to
+ *    orthonormalize, stored column-major.
+ *  @param AV (Input/output, device memory, n*m entries or nullptr)
+ *    Optional second block transformed consistently.
+ *  @param G (Output, device memory, m*m entries) Workspace for the
+ *    Gram matrix.
+ *  @param devInfo (Output, device memory, 1 entry) cusolver status.
+ *  @return Zero if successful. Non-zero if the block is numerically
+ *    rank-deficient.
+ */
+template <typename index_type_t, typename value_type_t>
+static int choleskyOrthonormalize(handle_t const& handle,
+                                  index_type_t n,
+                                  index_type_t m,
+                                  value_type_t* __restrict__ V,
+                                  value_type_t* __restrict__ AV,
+                                  value_type_t* __restrict__ G,
+                                  int* devInfo)
+{
+  auto stream     = handle.get_stream();
+  auto cublas_h   = handle.get_cublas_handle();
+  auto cusolver_h = handle.get_cusolver_dn_handle();
+
+  const value_type_t one  = 1;
+  const value_type_t zero = 0;
+
+  // Gram matrix G = V^T V
+  RAFT_CUBLAS_TRY(cublasgemm(
+    cublas_h, CUBLAS_OP_T, CUBLAS_OP_N, m, m, n, &one, V, n, V, n, &zero, G, m, stream));
+
+  // Cholesky factor G = L L^T
+  int lwork = 0;
+  RAFT_CUSOLVER_TRY(
+    cusolverDnpotrf_bufferSize(cusolver_h, CUBLAS_FILL_MODE_LOWER, m, G, m, &lwork));
+  rmm::device_uvector<value_type_t> work(lwork, stream);
+  RAFT_CUSOLVER_TRY(cusolverDnpotrf(
+    cusolver_h, CUBLAS_FILL_MODE_LOWER, m, G, m, work.data(), lwork, devInfo, stream));
+
+  int info = 0;
+  raft::update_host(&info, devInfo, 1, stream);
+  RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+  if (info != 0) return 1;
+
+  // V = V L^-T (and AV = AV L^-T, keeping AV = A*V)
+  RAFT_CUBLAS_TRY(cublastrsm(cublas_h,
+                             CUBLAS_SIDE_RIGHT,
+                             CUBLAS_FILL_MODE_LOWER,
+                             CUBLAS_OP_T,
+                             CUBLAS_DIAG_NON_UNIT,
+                             n,
+                             m,
+                             &one,
+                             G,
+                             m,
+                             V,
+                             n,
+                             stream));
+  if (AV != nullptr) {
+    RAFT_CUBLAS_TRY(cublastrsm(cublas_h,
+                               CUBLAS_SIDE_RIGHT,
+                               CUBLAS_FILL_MODE_LOWER,
+                               CUBLAS_OP_T,
+                               CUBLAS_DIAG_NON_UNIT,
+                               n,
+                               m,
+                               &one,
+                               G,
+                               m,
+                               AV,
+                               n,
+                               stream));
+  }
+  return 0;
+}
+
+/**
+ *  @brief  Compute smallest eigenvectors of symmetric matrix with LOBPCG.
+ *    Locally optimal block preconditioned conjugate gradient (without
+ *    preconditioner): the Rayleigh-Ritz procedure is applied on the
+ *    subspace spanned by the current Ritz block X, the residual block R
+ *    and the implicit conjugate direction block P. Each iteration costs
+ *    one sparse matrix product per block vector, which for
+ *    multi-eigenpair problems is typically several times fewer matrix
+ *    products than a restarted Lanczos run.
+ *  @tparam index_type_t the type of data used for indexing.
+ *  @tparam value_type_t the type of data used for weights, distances.
+ *  @param handle the raft handle.
+ *  @param A Matrix.
+ *  @param nEigVecs Number of eigenvectors to compute. The internal
+ *    subspace has 3*nEigVecs vectors, which must not exceed the matrix
+ *    dimension.
+ *  @param maxIter Maximum number of LOBPCG iterations.
+ *  @param tol Convergence tolerance. Iteration terminates when every
+ *    residual column norm is less than tol.
+ *  @param iter On exit, number of LOBPCG iterations performed.
+ *  @param eigVals_dev (Output, device memory, nEigVecs entries)
+ *    Smallest eigenvalues of matrix.
+ *  @param eigVecs_dev (Output, device memory, n*nEigVecs entries)
+ *    Eigenvectors corresponding to smallest eigenvalues of
+ *    matrix. Vectors are stored as columns of a column-major matrix
+ *    with dimensions n x nEigVecs.
+ *  @param seed random seed for the starting block. Ignored when an
+ *    initial block is given.
+ *  @param eigVecs_init (Input, device memory, n*nEigVecs entries or
+ *    nullptr) Optional starting block, stored like eigVecs_dev. Passing
+ *    the eigenvector block of a previous solve on a slightly perturbed
+ *    matrix warm-starts the iteration, which then typically converges
+ *    in a handful of iterations. The block is re-orthonormalized
+ *    internally, so it need not be orthonormal on input.
+ *  @return error flag.
+ */
+template <typename index_type_t, typename value_type_t>
+int computeSmallestEigenvectorsLOBPCG(
+  handle_t const& handle,
+  spectral::matrix::sparse_matrix_t<index_type_t, value_type_t> const& A,
+  index_type_t nEigVecs,
+  index_type_t maxIter,
+  value_type_t tol,
+  index_type_t& iter,
+  value_type_t* __restrict__ eigVals_dev,
+  value_type_t* __restrict__ eigVecs_dev,
+  unsigned long long seed                     = 1234567,
+  const value_type_t* __restrict__ eigVecs_init = nullptr)
+{
+  index_type_t n = A.nrows_;
+  index_type_t m = nEigVecs;
+
+  RAFT_EXPECTS(nEigVecs > 0, "Invalid number of eigenvectors.");
+  RAFT_EXPECTS(3 * nEigVecs <= n, "Block too large for matrix dimension.");
+  RAFT_EXPECTS(tol > 0, "Invalid tolerance.");
+  RAFT_EXPECTS(maxIter >= 0, "Invalid maximum iterations.");
+  RAFT_EXPECTS(eigVals_dev != nullptr, "Null eigVals buffer.");
+  RAFT_EXPECTS(eigVecs_dev != nullptr, "Null eigVecs buffer.");
+
+  auto stream   = handle.get_stream();
+  auto cublas_h = handle.get_cublas_handle();
+
+  const value_type_t one     = 1;
+  const value_type_t neg_one = -1;
+  const value_type_t zero    = 0;
+
+  constexpr unsigned int block_size = 1024;
+  unsigned int grid_size = std::min(65535u, ceildiv<unsigned>(n * m, block_size));
+
+  // Subspace basis S = [X | R | P] and its image AS = A*S, column-major
+  // n x 3m. X, R, P alias fixed column blocks of S.
+  rmm::device_uvector<value_type_t> S(3 * m * n, stream);
+  rmm::device_uvector<value_type_t> AS(3 * m * n, stream);
+  rmm::device_uvector<value_type_t> G(9 * m * m, stream);
+  rmm::device_uvector<value_type_t> C(9 * m * m, stream);
+  rmm::device_uvector<value_type_t> w(3 * m, stream);
+  rmm::device_uvector<value_type_t> tmp(4 * m * n, stream);
+  rmm::device_uvector<int> devInfo(1, stream);
+
+  value_type_t* X  = S.data();
+  value_type_t* R  = S.data() + m * n;
+  value_type_t* P  = S.data() + 2 * m * n;
+  value_type_t* AX = AS.data();
+  value_type_t* AR = AS.data() + m * n;
+  value_type_t* AP = AS.data() + 2 * m * n;
+
+  // Multiply a block of vectors by A, one SpMV per column
+  auto blockSpmv = [&](value_type_t* V, value_type_t* AV, index_type_t cols) {
+    for (index_type_t j = 0; j < cols; ++j)
+      A.mv(1, V + j * n, 0, AV + j * n);
+  };
+
+  // Rayleigh-Ritz on the first ns basis vectors: diagonalize S^T AS,
+  // rotate the smallest m Ritz vectors into X (and their images into
+  // AX), and store the spanning combination of the non-X basis vectors
+  // as the new direction block P when ns > m.
+  auto rayleighRitz = [&](index_type_t ns) {
+    RAFT_CUBLAS_TRY(cublasgemm(cublas_h,
+                               CUBLAS_OP_T,
+                               CUBLAS_OP_N,
+                               ns,
+                               ns,
+                               n,
+                               &one,
+                               S.data(),
+                               n,
+                               AS.data(),
+                               n,
+                               &zero,
+                               G.data(),
+                               ns,
+                               stream));
+    eigDC(handle, G.data(), std::size_t(ns), std::size_t(ns), C.data(), w.data(), stream);
+
+    // Y = C[:, :m] holds the coefficients of the m smallest Ritz vectors
+    value_type_t* tmpX  = tmp.data();
+    value_type_t* tmpAX = tmp.data() + m * n;
+    value_type_t* tmpP  = tmp.data() + 2 * m * n;
+    value_type_t* tmpAP = tmp.data() + 3 * m * n;
+    RAFT_CUBLAS_TRY(cublasgemm(cublas_h, CUBLAS_OP_N, CUBLAS_OP_N, n, m, ns, &one, S.data(), n,
+                               C.data(), ns, &zero, tmpX, n, stream));
+    RAFT_CUBLAS_TRY(cublasgemm(cublas_h, CUBLAS_OP_N, CUBLAS_OP_N, n, m, ns, &one, AS.data(), n,
+                               C.data(), ns, &zero, tmpAX, n, stream));
+    if (ns > m) {
+      // P spans the R (and old P) contributions to the new Ritz vectors
+      RAFT_CUBLAS_TRY(cublasgemm(cublas_h, CUBLAS_OP_N, CUBLAS_OP_N, n, m, ns - m, &one, R, n,
+                                 C.data() + m, ns, &zero, tmpP, n, stream));
+      RAFT_CUBLAS_TRY(cublasgemm(cublas_h, CUBLAS_OP_N, CUBLAS_OP_N, n, m, ns - m, &one, AR, n,
+                                 C.data() + m, ns, &zero, tmpAP, n, stream));
+      RAFT_CUDA_TRY(cudaMemcpyAsync(
+        P, tmpP, m * n * sizeof(value_type_t), cudaMemcpyDeviceToDevice, stream));
+      RAFT_CUDA_TRY(cudaMemcpyAsync(
+        AP, tmpAP, m * n * sizeof(value_type_t), cudaMemcpyDeviceToDevice, stream));
+    }
+    RAFT_CUDA_TRY(
+      cudaMemcpyAsync(X, tmpX, m * n * sizeof(value_type_t), cudaMemcpyDeviceToDevice, stream));
+    RAFT_CUDA_TRY(
+      cudaMemcpyAsync(AX, tmpAX, m * n * sizeof(value_type_t), cudaMemcpyDeviceToDevice, stream));
+  };
+
+  // Starting block: caller-provided warm start, otherwise random
+  if (eigVecs_init != nullptr) {
+    RAFT_CUDA_TRY(cudaMemcpyAsync(
+      X, eigVecs_init, n * m * sizeof(value_type_t), cudaMemcpyDeviceToDevice, stream));
+  } else {
+    raft::random::Rng rng(seed);
+    rng.uniform(X, n * m, value_type_t(-1), value_type_t(1), stream);
+  }
+  if (choleskyOrthonormalize(
+        handle, n, m, X, static_cast<value_type_t*>(nullptr), G.data(), devInfo.data()))
+    WARNING("LOBPCG: starting block is rank-deficient");
+  blockSpmv(X, AX, m);
+  rayleighRitz(m);
+
+  bool have_p     = false;
+  bool converged  = false;
+  std::vector<value_type_t> rnorms(m);
+
+  for (iter = 0; iter < maxIter; ++iter) {
+    // Residual block R = AX - X diag(w)
+    blockResidual<<<grid_size, block_size, 0, stream>>>(n, m, X, AX, w.data(), R);
+    CHECK_CUDA(stream);
+
+    // Convergence test on per-column residual norms
+    value_type_t maxNorm = 0;
+    for (index_type_t j = 0; j < m; ++j)
+      RAFT_CUBLAS_TRY(cublasnrm2(cublas_h, n, R + j * n, 1, &rnorms[j], stream));
+    maxNorm = *std::max_element(rnorms.begin(), rnorms.end());
+    if (maxNorm < tol) {
+      converged = true;
+      break;
+    }
+
+    // Project X out of the residual block and orthonormalize it
+    RAFT_CUBLAS_TRY(cublasgemm(
+      cublas_h, CUBLAS_OP_T, CUBLAS_OP_N, m, m, n, &one, X, n, R, n, &zero, G.data(), m, stream));
+    RAFT_CUBLAS_TRY(cublasgemm(
+      cublas_h, CUBLAS_OP_N, CUBLAS_OP_N, n, m, m, &neg_one, X, n, G.data(), m, &one, R, n, stream));
+    if (choleskyOrthonormalize(
+          handle, n, m, R, static_cast<value_type_t*>(nullptr), G.data(), devInfo.data())) {
+      WARNING("LOBPCG: residual block is rank-deficient");
+      break;
+    }
+    blockSpmv(R, AR, m);
+
+    // Orthonormalize the full basis; if it degenerates, retry without P
+    index_type_t ns = have_p ? 3 * m : 2 * m;
+    if (choleskyOrthonormalize(handle, n, ns, S.data(), AS.data(), G.data(), devInfo.data())) {
+      if (!have_p) {
+        WARNING("LOBPCG: subspace basis is rank-deficient");
+        break;
+      }
+      have_p = false;
+      ns     = 2 * m;
+      if (choleskyOrthonormalize(handle, n, ns, S.data(), AS.data(), G.data(), devInfo.data())) {
+        WARNING("LOBPCG: subspace basis is rank-deficient");
+        break;
+      }
+    }
+
+    rayleighRitz(ns);
+    have_p = true;
+  }
+
+  if (!converged) WARNING("LOBPCG failed to converge");
+
+  // Write out eigenpairs
+  RAFT_CUDA_TRY(cudaMemcpyAsync(
+    eigVals_dev, w.data(), m * sizeof(value_type_t), cudaMemcpyDeviceToDevice, stream));
+  RAFT_CUDA_TRY(cudaMemcpyAsync(
+    eigVecs_dev, X, n * m * sizeof(value_type_t), cudaMemcpyDeviceToDevice, stream));
+
+  return 0;
+}
+
+}  // namespace detail
+}  // namespace linalg
+}  // namespace raft
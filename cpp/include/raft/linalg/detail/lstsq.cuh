@@ -34,6 +34,8 @@
 #include <rmm/device_scalar.hpp>
 #include <rmm/device_uvector.hpp>
 
+#include <vector>
+
 namespace raft {
 namespace linalg {
 namespace detail {
@@ -450,6 +452,120 @@ void lstsqQR(const raft::handle_t& handle,
 
   RAFT_CUDA_TRY(cudaMemcpyAsync(w, b, sizeof(math_t) * n, cudaMemcpyDeviceToDevice, stream));
 }
+
+/** Solves a batch of independent linear ordinary least squares problems
+ *  `A_i w_i = b_i` sharing the same shape, via the normal equations
+ *  (`w_i = (A_i^T A_i)^-1 A_i^T b_i`).
+ *
+ *  All Gram matrices and right hand sides are formed with two strided-batched
+ *  gemms and solved with one batched Cholesky factorization plus one batched
+ *  triangular solve, so the whole batch costs a handful of kernel launches
+ *  instead of batch_size sequential solver calls. All scratch memory is
+ *  allocated once for the whole batch.
+ *
+ *  @param A - batch of input feature matrices, column major,
+ *             size [n_rows * n_cols * batch_size]
+ *  @param b - batch of input target vectors, size [n_rows * batch_size]
+ *  @param w - batch of output coefficient vectors, size [n_cols * batch_size]
+ */
+template <typename math_t>
+void lstsqBatched(const raft::handle_t& handle,
+                  const math_t* A,
+                  const int n_rows,
+                  const int n_cols,
+                  const math_t* b,
+                  math_t* w,
+                  const int batch_size,
+                  cudaStream_t stream)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "raft::linalg::lstsqBatched(%d, %d, %d)", n_rows, n_cols, batch_size);
+  cublasHandle_t cublasH       = handle.get_cublas_handle();
+  cusolverDnHandle_t cusolverH = handle.get_cusolver_dn_handle();
+
+  rmm::device_uvector<math_t> G(size_t(n_cols) * n_cols * batch_size, stream);
+  rmm::device_uvector<math_t*> ptrs(2 * batch_size, stream);
+  rmm::device_uvector<int> info(batch_size, stream);
+
+  const math_t alpha = math_t(1);
+  const math_t beta  = math_t(0);
+  // G_i <- A_i^T A_i for the whole batch
+  RAFT_CUBLAS_TRY(cublasgemmStridedBatched(cublasH,
+                                           CUBLAS_OP_T,
+                                           CUBLAS_OP_N,
+                                           n_cols,
+                                           n_cols,
+                                           n_rows,
+                                           &alpha,
+                                           A,
+                                           n_rows,
+                                           int64_t(n_rows) * n_cols,
+                                           A,
+                                           n_rows,
+                                           int64_t(n_rows) * n_cols,
+                                           &beta,
+                                           G.data(),
+                                           n_cols,
+                                           int64_t(n_cols) * n_cols,
+                                           batch_size,
+                                           stream));
+  // w_i <- A_i^T b_i for the whole batch
+  RAFT_CUBLAS_TRY(cublasgemmStridedBatched(cublasH,
+                                           CUBLAS_OP_T,
+                                           CUBLAS_OP_N,
+                                           n_cols,
+                                           1,
+                                           n_rows,
+                                           &alpha,
+                                           A,
+                                           n_rows,
+                                           int64_t(n_rows) * n_cols,
+                                           b,
+                                           n_rows,
+                                           int64_t(n_rows),
+                                           &beta,
+                                           w,
+                                           n_cols,
+                                           int64_t(n_cols),
+                                           batch_size,
+                                           stream));
+
+  // the batched cusolver routines take arrays of pointers
+  std::vector<math_t*> ptrs_host(2 * batch_size);
+  for (int i = 0; i < batch_size; i++) {
+    ptrs_host[i]              = G.data() + size_t(n_cols) * n_cols * i;
+    ptrs_host[batch_size + i] = w + size_t(n_cols) * i;
+  }
+  raft::update_device(ptrs.data(), ptrs_host.data(), 2 * batch_size, stream);
+  math_t** G_ptrs = ptrs.data();
+  math_t** w_ptrs = ptrs.data() + batch_size;
+
+  // G_i <- chol(G_i)
+  RAFT_CUSOLVER_TRY(cusolverDnpotrfBatched(
+    cusolverH, CUBLAS_FILL_MODE_LOWER, n_cols, G_ptrs, n_cols, info.data(), batch_size, stream));
+  std::vector<int> info_host(batch_size);
+  raft::update_host(info_host.data(), info.data(), batch_size, stream);
+  handle.sync_stream(stream);
+  for (int i = 0; i < batch_size; i++) {
+    ASSERT(info_host[i] == 0, "lstsq.h: batched Cholesky failed for matrix %d", i);
+  }
+
+  // w_i <- G_i^-1 A_i^T b_i (batched potrs supports a single right hand side)
+  RAFT_CUSOLVER_TRY(cusolverDnpotrsBatched(cusolverH,
+                                           CUBLAS_FILL_MODE_LOWER,
+                                           n_cols,
+                                           1,
+                                           G_ptrs,
+                                           n_cols,
+                                           w_ptrs,
+                                           n_cols,
+                                           info.data(),
+                                           batch_size,
+                                           stream));
+  raft::update_host(info_host.data(), info.data(), 1, stream);
+  handle.sync_stream(stream);
+  ASSERT(info_host[0] == 0, "lstsq.h: batched triangular solve failed");
+}
 };  // namespace detail
 };  // namespace linalg
 };  // namespace raft
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <cub/cub.cuh>
+#include <raft/common/detail/launch_config.cuh>
 #include <raft/cuda_utils.cuh>
 #include <raft/handle.hpp>
 #include <raft/vectorized.cuh>
@@ -37,9 +38,13 @@ template <typename InType, typename OutType, typename MapOp, int TPB, typename..
 void mapImpl(
   OutType* out, size_t len, MapOp map, cudaStream_t stream, const InType* in, Args... args)
 {
-  const int nblks = raft::ceildiv(len, (size_t)TPB);
+  // TPB remains a template parameter for signature compatibility; the actual
+  // block size comes from the memoized occupancy query (cf. launch_config.cuh)
+  const int blksize =
+    raft::detail::elementwise_block_size(mapKernel<InType, OutType, MapOp, TPB, Args...>, len);
+  const int nblks = raft::ceildiv(len, (size_t)blksize);
   mapKernel<InType, OutType, MapOp, TPB, Args...>
-    <<<nblks, TPB, 0, stream>>>(out, len, map, in, args...);
+    <<<nblks, blksize, 0, stream>>>(out, len, map, in, args...);
   RAFT_CUDA_TRY(cudaPeekAtLastError());
 }
 
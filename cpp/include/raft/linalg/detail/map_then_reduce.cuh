@@ -70,6 +70,53 @@ __global__ void mapThenReduceKernel(OutType* out,
   reduce<InType, OutType, TPB>(out, acc, op);
 }
 
+/**
+ * Bundle of one map/reduce functor pair together with its output scalar
+ * and neutral element, evaluated by the multi map-reduce kernel below.
+ */
+template <typename OutType, typename MapOp, typename ReduceLambda>
+struct map_reduce_op {
+  OutType* out;
+  OutType neutral;
+  MapOp map;
+  ReduceLambda op;
+};
+
+template <typename InType, int TPB, typename OutType, typename MapOp, typename ReduceLambda>
+DI void mapThenReduceApplyOne(const InType& val,
+                              bool valid,
+                              map_reduce_op<OutType, MapOp, ReduceLambda> acc)
+{
+  OutType mapped = valid ? (OutType)acc.map(val) : acc.neutral;
+
+  // identically-typed accumulators share one block reduce storage
+  // instantiation, so order the reuse
+  __syncthreads();
+
+  reduce<OutType, OutType, TPB>(acc.out, mapped, acc.op);
+}
+
+template <typename InType, int TPB, typename... MapReduceOps>
+__global__ void mapThenReduceMultiKernel(size_t len, const InType* in, MapReduceOps... accs)
+{
+  size_t idx = threadIdx.x + ((size_t)blockIdx.x * blockDim.x);
+  bool valid = idx < len;
+  InType val = valid ? in[idx] : InType{};
+
+  (mapThenReduceApplyOne<InType, TPB>(val, valid, accs), ...);
+}
+
+template <typename InType, int TPB, typename... MapReduceOps>
+void mapThenReduceMultiImpl(size_t len, cudaStream_t stream, const InType* in, MapReduceOps... accs)
+{
+  // seed every output with its neutral element
+  (raft::update_device(accs.out, &accs.neutral, 1, stream), ...);
+  const size_t nblks = raft::ceildiv(len, (size_t)TPB);
+  mapThenReduceMultiKernel<InType, TPB, MapReduceOps...>
+    <<<nblks, TPB, 0, stream>>>(len, in, accs...);
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
+}
+
 template <typename InType,
           typename OutType,
           typename MapOp,
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/cuda_utils.cuh>
+#include <raft/cudart_utils.h>
+
+namespace raft {
+namespace linalg {
+namespace detail {
+
+/** Work descriptor for one elementwise micro-op; written by the host into the
+ * mapped ring buffer, snapshotted by every block. */
+template <typename InType, typename OutType, typename IdxType>
+struct persistent_op_desc {
+  const InType* in1;
+  const InType* in2;
+  OutType* out;
+  IdxType len;
+};
+
+/** Counters shared between host and device via mapped pinned memory. The host
+ * bumps `submitted` after publishing a descriptor; the last block to finish an
+ * item bumps `completed`; `quit` asks the kernel to exit once drained. */
+struct persistent_op_control {
+  volatile unsigned long long submitted;
+  volatile unsigned long long completed;
+  volatile int quit;
+};
+
+DI void persistent_op_pause()
+{
+#if __CUDA_ARCH__ >= 700
+  __nanosleep(100);
+#endif
+}
+
+/**
+ * Resident grid-stride worker: every block polls the control counters for new
+ * descriptors, processes its stride of the item, and the last block through
+ * publishes completion to the host. The grid must be no larger than what the
+ * device can keep co-resident (all blocks poll; a block that cannot be
+ * scheduled would stall the item it never starts), which is exactly the
+ * saturating grid reported by the occupancy calculator.
+ */
+template <typename InType, typename Lambda, typename OutType, typename IdxType>
+__global__ void persistentBinaryOpKernel(persistent_op_control* ctrl,
+                                         const persistent_op_desc<InType, OutType, IdxType>* queue,
+                                         int capacity,
+                                         unsigned int* block_done,
+                                         Lambda op)
+{
+  __shared__ unsigned long long s_submitted;
+  __shared__ int s_quit;
+  unsigned long long next = 0;
+  while (true) {
+    if (threadIdx.x == 0) {
+      unsigned long long submitted;
+      int quit;
+      do {
+        submitted = ctrl->submitted;
+        quit      = ctrl->quit;
+        if (submitted <= next && !quit) { persistent_op_pause(); }
+      } while (submitted <= next && !quit);
+      s_submitted = submitted;
+      s_quit      = quit;
+    }
+    __syncthreads();
+    if (s_submitted <= next) { return; }  // quit raised and the queue is drained
+
+    // the host wrote the descriptor before bumping `submitted`; fence between
+    // observing the counter and reading the slot
+    __threadfence();
+    auto slot = next % capacity;
+    auto desc = queue[slot];
+
+    IdxType stride = (IdxType)gridDim.x * blockDim.x;
+    for (IdxType i = (IdxType)blockIdx.x * blockDim.x + threadIdx.x; i < desc.len; i += stride) {
+      desc.out[i] = op(desc.in1[i], desc.in2[i]);
+    }
+    __syncthreads();
+    if (threadIdx.x == 0) {
+      __threadfence();
+      if (atomicAdd(&block_done[slot], 1u) + 1 == gridDim.x) {
+        block_done[slot] = 0;
+        __threadfence_system();
+        ctrl->completed = next + 1;
+      }
+    }
+    next++;
+    __syncthreads();  // keep s_submitted stable until every thread consumed it
+  }
+}
+
+}  // namespace detail
+}  // namespace linalg
+}  // namespace raft
@@ -16,9 +16,11 @@
 
 #pragma once
 
+#include <raft/common/cub_wrappers.cuh>
 #include <raft/cuda_utils.cuh>
 
 #include <cub/cub.cuh>
+#include <rmm/device_uvector.hpp>
 
 #include <limits>
 
@@ -347,6 +349,186 @@ void sum_rows_by_key_large_nkeys_rowmajor(const DataIteratorT d_A,
     d_A, lda, d_weights, d_keys, nrows, ncols, key_offset, nkeys, d_sums);
 }
 
+//
+// Reduce by keys - very large number of keys (privatized copies)
+//
+// A single pass over the data: every block accumulates into one of a few
+// private global-memory copies of the sums (picked round-robin), which a
+// merge pass folds into the output afterwards. The most frequent keys are
+// additionally staged in a block-private shared-memory table (built from a
+// key-frequency histogram), so the bulk of the atomic traffic never leaves
+// the block. This keeps the update bandwidth-bound where the chunked
+// kernel-per-key path above degenerates into nkeys/1024 rescans of the data.
+//
+
+#define RRBK_PRIV_DIMX     256
+#define RRBK_MAX_HOT_KEYS  128
+#define RRBK_HOT_SMEM_SZ   (44u * 1024u)
+#define RRBK_PRIV_MAX_COPY (64ul << 20)
+
+template <typename KeysIteratorT>
+__global__ void count_keys_kernel(const KeysIteratorT d_keys, int nrows, int* d_counts)
+{
+  for (int i = blockIdx.x * blockDim.x + threadIdx.x; i < nrows; i += gridDim.x * blockDim.x) {
+    atomicAdd(&d_counts[static_cast<int>(d_keys[i])], 1);
+  }
+}
+
+template <typename IdxT>
+__global__ void build_hot_slots_kernel(const IdxT* d_hot_keys, IdxT n_hot, IdxT* d_hot_slots)
+{
+  IdxT i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i < n_hot) { d_hot_slots[d_hot_keys[i]] = i; }
+}
+
+template <typename DataIteratorT, typename KeysIteratorT, typename WeightT>
+__global__ void sum_rows_by_key_privatized_kernel(const DataIteratorT d_A,
+                                                  int lda,
+                                                  const KeysIteratorT d_keys,
+                                                  const WeightT* d_weights,
+                                                  const int* d_hot_slots,
+                                                  const int* d_hot_keys,
+                                                  int n_hot,
+                                                  int nrows,
+                                                  int ncols,
+                                                  int nkeys,
+                                                  typename std::iterator_traits<
+                                                    DataIteratorT>::value_type* d_priv,
+                                                  int n_copies)
+{
+  typedef typename std::iterator_traits<DataIteratorT>::value_type DataType;
+  extern __shared__ __align__(sizeof(DataType)) char rrbk_smem[];
+  DataType* hot_sums = reinterpret_cast<DataType*>(rrbk_smem);
+
+  for (int i = threadIdx.x; i < n_hot * ncols; i += blockDim.x) {
+    hot_sums[i] = 0.0;
+  }
+  __syncthreads();
+
+  DataType* priv = d_priv + std::size_t(blockIdx.x % n_copies) * nkeys * ncols;
+
+  // one row at a time per block: the threads stride the columns, so the
+  // shared-memory hot slots see no write conflicts and global writes coalesce
+  for (int row = blockIdx.x; row < nrows; row += gridDim.x) {
+    int key  = static_cast<int>(d_keys[row]);
+    int slot = (d_hot_slots != nullptr) ? d_hot_slots[key] : -1;
+    WeightT w = (d_weights != nullptr) ? d_weights[row] : WeightT(1);
+    if (slot >= 0) {
+      for (int col = threadIdx.x; col < ncols; col += blockDim.x) {
+        hot_sums[slot * ncols + col] += d_A[std::size_t(row) * lda + col] * w;
+      }
+    } else {
+      for (int col = threadIdx.x; col < ncols; col += blockDim.x) {
+        raft::myAtomicAdd(&priv[std::size_t(key) * ncols + col],
+                          static_cast<DataType>(d_A[std::size_t(row) * lda + col] * w));
+      }
+    }
+  }
+  __syncthreads();
+
+  // flush the hot slots into this block's private copy
+  for (int i = threadIdx.x; i < n_hot * ncols; i += blockDim.x) {
+    DataType sum = hot_sums[i];
+    if (sum != 0.0) {
+      int key = d_hot_keys[i / ncols];
+      raft::myAtomicAdd(&priv[std::size_t(key) * ncols + (i % ncols)], sum);
+    }
+  }
+}
+
+template <typename DataType>
+__global__ void merge_privatized_sums_kernel(const DataType* d_priv,
+                                             int n_copies,
+                                             std::size_t plane,
+                                             DataType* d_sums)
+{
+  std::size_t stride = std::size_t(gridDim.x) * blockDim.x;
+  for (std::size_t i = std::size_t(blockIdx.x) * blockDim.x + threadIdx.x; i < plane; i += stride) {
+    DataType sum = 0.0;
+    for (int c = 0; c < n_copies; c++) {
+      sum += d_priv[std::size_t(c) * plane + i];
+    }
+    d_sums[i] += sum;
+  }
+}
+
+template <typename DataIteratorT, typename KeysIteratorT, typename WeightT>
+void sum_rows_by_key_privatized(const DataIteratorT d_A,
+                                int lda,
+                                const KeysIteratorT d_keys,
+                                const WeightT* d_weights,
+                                int nrows,
+                                int ncols,
+                                int nkeys,
+                                DataIteratorT d_sums,
+                                cudaStream_t st)
+{
+  typedef typename std::iterator_traits<DataIteratorT>::value_type DataType;
+  std::size_t plane = std::size_t(nkeys) * ncols;
+
+  // as many hot keys as rows of sums fit into the shared-memory budget
+  int n_hot = std::min(RRBK_MAX_HOT_KEYS, int(RRBK_HOT_SMEM_SZ / (sizeof(DataType) * ncols)));
+  n_hot     = std::min(n_hot, nkeys);
+  if (n_hot < 8) n_hot = 0;  // too few slots to pay for the histogram pass
+
+  rmm::device_uvector<int> hot_keys(0, st);
+  rmm::device_uvector<int> hot_slots(0, st);
+  if (n_hot > 0) {
+    // frequency sketch: exact key histogram, then the n_hot most frequent
+    // keys via an ascending radix sort (hottest keys land at the end)
+    rmm::device_uvector<int> counts(nkeys, st);
+    RAFT_CUDA_TRY(cudaMemsetAsync(counts.data(), 0, nkeys * sizeof(int), st));
+    count_keys_kernel<<<std::min(raft::ceildiv(nrows, RRBK_PRIV_DIMX), (int)MAX_BLOCKS),
+                        RRBK_PRIV_DIMX,
+                        0,
+                        st>>>(d_keys, nrows, counts.data());
+
+    rmm::device_uvector<int> sorted_counts(nkeys, st);
+    rmm::device_uvector<int> key_ids(nkeys, st);
+    hot_keys.resize(nkeys, st);
+    convert_array(key_ids.data(), cub::CountingInputIterator<int>(0), nkeys, st);
+    rmm::device_uvector<char> cub_ws(0, st);
+    raft::sortPairs(
+      cub_ws, counts.data(), sorted_counts.data(), key_ids.data(), hot_keys.data(), nkeys, st);
+
+    hot_slots.resize(nkeys, st);
+    RAFT_CUDA_TRY(cudaMemsetAsync(hot_slots.data(), 0xff, nkeys * sizeof(int), st));
+    build_hot_slots_kernel<<<raft::ceildiv(n_hot, 256), 256, 0, st>>>(
+      hot_keys.data() + nkeys - n_hot, n_hot, hot_slots.data());
+  }
+
+  // a few private copies of the sums spread the residual global atomics;
+  // capped so the scratch stays bounded when the sums matrix itself is large
+  int n_copies = std::max(
+    1, std::min(8, int(RRBK_PRIV_MAX_COPY / std::max<std::size_t>(1, plane * sizeof(DataType)))));
+  rmm::device_uvector<DataType> priv(std::size_t(n_copies) * plane, st);
+  RAFT_CUDA_TRY(cudaMemsetAsync(priv.data(), 0, priv.size() * sizeof(DataType), st));
+
+  dim3 grid, block;
+  block.x          = RRBK_PRIV_DIMX;
+  grid.x           = std::min((unsigned int)nrows, 2048u);
+  std::size_t smem = std::size_t(n_hot) * ncols * sizeof(DataType);
+  sum_rows_by_key_privatized_kernel<<<grid, block, smem, st>>>(
+    d_A,
+    lda,
+    d_keys,
+    d_weights,
+    n_hot > 0 ? hot_slots.data() : nullptr,
+    n_hot > 0 ? hot_keys.data() + nkeys - n_hot : nullptr,
+    n_hot,
+    nrows,
+    ncols,
+    nkeys,
+    priv.data(),
+    n_copies);
+
+  merge_privatized_sums_kernel<<<std::min(raft::ceildiv(plane, std::size_t(RRBK_PRIV_DIMX)),
+                                          std::size_t(MAX_BLOCKS)),
+                                 RRBK_PRIV_DIMX,
+                                 0,
+                                 st>>>(priv.data(), n_copies, plane, d_sums);
+}
+
 /**
  * @brief Computes the weighted reduction of matrix rows for each given key
  *
@@ -378,7 +560,6 @@ void reduce_rows_by_key(const DataIteratorT d_A,
                         DataIteratorT d_sums,
                         cudaStream_t stream)
 {
-  typedef typename std::iterator_traits<KeysIteratorT>::value_type KeyType;
   typedef typename std::iterator_traits<DataIteratorT>::value_type DataType;
 
   // Following kernel needs memset
@@ -391,13 +572,13 @@ void reduce_rows_by_key(const DataIteratorT d_A,
     convert_array(d_keys_char, d_keys, nrows, stream);
     sum_rows_by_key_small_nkeys(
       d_A, lda, d_keys_char, d_weights, nrows, ncols, nkeys, d_sums, stream);
+  } else if (nkeys <= SUM_ROWS_BY_KEY_LARGE_K_MAX_K) {
+    sum_rows_by_key_large_nkeys_rowmajor(
+      d_A, lda, d_keys, d_weights, nrows, ncols, 0, nkeys, d_sums, stream);
   } else {
-    for (KeyType key_offset = 0; key_offset < static_cast<KeyType>(nkeys);
-         key_offset += SUM_ROWS_BY_KEY_LARGE_K_MAX_K) {
-      KeyType this_call_nkeys = std::min(SUM_ROWS_BY_KEY_LARGE_K_MAX_K, nkeys);
-      sum_rows_by_key_large_nkeys_rowmajor(
-        d_A, lda, d_keys, d_weights, nrows, ncols, key_offset, this_call_nkeys, d_sums, stream);
-    }
+    // beyond the chunked kernel's key budget a single privatized pass over
+    // the data replaces the nkeys/1024 rescans of the chunk loop
+    sum_rows_by_key_privatized(d_A, lda, d_keys, d_weights, nrows, ncols, nkeys, d_sums, stream);
   }
 }
 
@@ -26,7 +26,10 @@
 #include <raft/matrix/matrix.cuh>
 #include <raft/random/rng.cuh>
 
+#include <rmm/device_uvector.hpp>
+
 #include <algorithm>
+#include <cstddef>
 
 namespace raft {
 namespace linalg {
@@ -409,6 +412,169 @@ void rsvdPerc(const raft::handle_t& handle,
                 stream);
 }
 
+/**
+ * @brief fixed-rank truncated SVD of a host-resident tall-skinny column major
+ * matrix, streamed through the GPU in row panels
+ *
+ * The input never has to fit in device memory: row panels are pulled from
+ * host (ideally pinned) memory with double buffering, overlapping the
+ * host-to-device copy of the next panel with the GEMM on the current one.
+ * The first pass accumulates the n_cols x n_cols Gram matrix on the device;
+ * since n_cols is small for tall-skinny inputs, the Gram product plays the
+ * role of the randomized sketch and is decomposed exactly with eigDC. An
+ * optional second streamed pass generates the left singular vectors panel by
+ * panel back into host memory.
+ * @param handle: raft handle
+ * @param M: input matrix in host memory [dim = n_rows * n_cols]
+ * @param n_rows: number rows of input matrix
+ * @param n_cols: number columns of input matrix
+ * @param S_vec: top k singular values, on device [dim = k]
+ * @param U: left singular vectors in host memory [dim = n_rows * k], may be
+ * nullptr when gen_left_vec is false
+ * @param V: right singular vectors, on device [dim = n_cols * k]
+ * @param k: no. of singular values to be computed
+ * @param gen_left_vec: left vectors need to be generated or not?
+ * @param stream cuda stream
+ * @param panel_rows: rows per streamed panel; 0 picks a default
+ */
+template <typename math_t>
+void rsvdFixedRankHost(const raft::handle_t& handle,
+                       const math_t* M,
+                       std::size_t n_rows,
+                       std::size_t n_cols,
+                       math_t* S_vec,
+                       math_t* U,
+                       math_t* V,
+                       std::size_t k,
+                       bool gen_left_vec,
+                       cudaStream_t stream,
+                       std::size_t panel_rows = 0)
+{
+  RAFT_EXPECTS(n_rows >= n_cols, "rsvdFixedRankHost: input must be tall-skinny (n_rows >= n_cols)");
+  RAFT_EXPECTS(k > 0 && k <= n_cols, "rsvdFixedRankHost: k must be in [1, n_cols]");
+
+  if (panel_rows == 0) { panel_rows = std::size_t(1) << 20; }
+  panel_rows = std::min(panel_rows, n_rows);
+
+  // H2D copies run on a stream-pool stream when one is available so they
+  // overlap with the GEMMs on the compute stream
+  cudaStream_t copy_stream = handle.get_next_usable_stream();
+
+  rmm::device_uvector<math_t> panels(2 * panel_rows * n_cols, stream);
+  math_t* panel[2] = {panels.data(), panels.data() + panel_rows * n_cols};
+
+  cudaEvent_t copy_done[2], gemm_done[2];
+  for (int b = 0; b < 2; b++) {
+    RAFT_CUDA_TRY(cudaEventCreateWithFlags(&copy_done[b], cudaEventDisableTiming));
+    RAFT_CUDA_TRY(cudaEventCreateWithFlags(&gemm_done[b], cudaEventDisableTiming));
+  }
+
+  // a row panel of the column major input is a strided submatrix: one
+  // panel_rows-sized chunk per column, m elements apart
+  auto copy_panel_in = [&](int b, std::size_t row_off, std::size_t rows) {
+    RAFT_CUDA_TRY(cudaStreamWaitEvent(copy_stream, gemm_done[b], 0));
+    RAFT_CUDA_TRY(cudaMemcpy2DAsync(panel[b],
+                                    rows * sizeof(math_t),
+                                    M + row_off,
+                                    n_rows * sizeof(math_t),
+                                    rows * sizeof(math_t),
+                                    n_cols,
+                                    cudaMemcpyHostToDevice,
+                                    copy_stream));
+    RAFT_CUDA_TRY(cudaEventRecord(copy_done[b], copy_stream));
+  };
+
+  std::size_t n_panels = raft::ceildiv(n_rows, panel_rows);
+  auto panel_size      = [&](std::size_t i) {
+    return std::min(panel_rows, n_rows - i * panel_rows);
+  };
+
+  // first pass: accumulate the Gram matrix B = M^T M on the device
+  rmm::device_uvector<math_t> B(n_cols * n_cols, stream);
+  math_t alpha = math_t(1);
+
+  copy_panel_in(0, 0, panel_size(0));
+  for (std::size_t i = 0; i < n_panels; i++) {
+    int b            = i % 2;
+    std::size_t rows = panel_size(i);
+    if (i + 1 < n_panels) { copy_panel_in((b + 1) % 2, (i + 1) * panel_rows, panel_size(i + 1)); }
+    RAFT_CUDA_TRY(cudaStreamWaitEvent(stream, copy_done[b], 0));
+    raft::linalg::gemm(handle,
+                       panel[b],
+                       (int)rows,
+                       (int)n_cols,
+                       panel[b],
+                       B.data(),
+                       (int)n_cols,
+                       (int)n_cols,
+                       CUBLAS_OP_T,
+                       CUBLAS_OP_N,
+                       alpha,
+                       i == 0 ? math_t(0) : math_t(1),
+                       stream);
+    RAFT_CUDA_TRY(cudaEventRecord(gemm_done[b], stream));
+  }
+
+  // eigendecompose the Gram matrix; its eigenvalues are the squared singular
+  // values and its eigenvectors the right singular vectors of M
+  rmm::device_uvector<math_t> eig_vectors(n_cols * n_cols, stream);
+  rmm::device_uvector<math_t> eig_vals(n_cols, stream);
+  raft::linalg::eigDC(handle, B.data(), n_cols, n_cols, eig_vectors.data(), eig_vals.data(), stream);
+  raft::matrix::colReverse(eig_vectors.data(), (int)n_cols, (int)n_cols, stream);
+  raft::matrix::rowReverse(eig_vals.data(), (int)n_cols, 1, stream);
+
+  raft::copy(S_vec, eig_vals.data(), k, stream);
+  raft::matrix::seqRoot(S_vec, S_vec, alpha, k, stream, true);
+  raft::copy(V, eig_vectors.data(), n_cols * k, stream);
+
+  if (gen_left_vec) {
+    // second pass: U panel = panel * V * diag(1/S), streamed back to host
+    rmm::device_uvector<math_t> scaled_V(n_cols * k, stream);
+    raft::copy(scaled_V.data(), V, n_cols * k, stream);
+    raft::matrix::matrixVectorBinaryDivSkipZero(
+      scaled_V.data(), S_vec, (int)n_cols, (int)k, false, true, stream);
+
+    rmm::device_uvector<math_t> u_panels(2 * panel_rows * k, stream);
+    math_t* u_panel[2] = {u_panels.data(), u_panels.data() + panel_rows * k};
+
+    copy_panel_in(0, 0, panel_size(0));
+    for (std::size_t i = 0; i < n_panels; i++) {
+      int b            = i % 2;
+      std::size_t rows = panel_size(i);
+      if (i + 1 < n_panels) { copy_panel_in((b + 1) % 2, (i + 1) * panel_rows, panel_size(i + 1)); }
+      RAFT_CUDA_TRY(cudaStreamWaitEvent(stream, copy_done[b], 0));
+      raft::linalg::gemm(handle,
+                         panel[b],
+                         (int)rows,
+                         (int)n_cols,
+                         scaled_V.data(),
+                         u_panel[b],
+                         (int)rows,
+                         (int)k,
+                         CUBLAS_OP_N,
+                         CUBLAS_OP_N,
+                         alpha,
+                         math_t(0),
+                         stream);
+      RAFT_CUDA_TRY(cudaMemcpy2DAsync(U + i * panel_rows,
+                                      n_rows * sizeof(math_t),
+                                      u_panel[b],
+                                      rows * sizeof(math_t),
+                                      rows * sizeof(math_t),
+                                      k,
+                                      cudaMemcpyDeviceToHost,
+                                      stream));
+      RAFT_CUDA_TRY(cudaEventRecord(gemm_done[b], stream));
+    }
+  }
+
+  handle.sync_stream(stream);
+  for (int b = 0; b < 2; b++) {
+    RAFT_CUDA_TRY(cudaEventDestroy(copy_done[b]));
+    RAFT_CUDA_TRY(cudaEventDestroy(gemm_done[b]));
+  }
+}
+
 };  // end namespace detail
 };  // end namespace linalg
 };  // end namespace raft
@@ -21,6 +21,7 @@
 #include <raft/linalg/eig.cuh>
 #include <raft/linalg/gemm.cuh>
 #include <raft/linalg/transpose.cuh>
+#include <raft/linalg/unary_op.cuh>
 
 #include <raft/common/nvtx.hpp>
 #include <raft/cuda_utils.cuh>
@@ -237,6 +238,210 @@ void svdJacobi(const raft::handle_t& handle,
   RAFT_CUSOLVER_TRY(cusolverDnDestroyGesvdjInfo(gesvdj_params));
 }
 
+template <typename math_t>
+void svdJacobiBatched(const raft::handle_t& handle,
+                      math_t* in,
+                      int n_rows,
+                      int n_cols,
+                      int batch_size,
+                      math_t* sing_vals,
+                      math_t* left_sing_vecs,
+                      math_t* right_sing_vecs,
+                      math_t tol,
+                      int max_sweeps,
+                      cudaStream_t stream)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "raft::linalg::svdJacobiBatched(%d, %d, %d)", n_rows, n_cols, batch_size);
+  // the batched kernel solves all matrices in one launch but is restricted to
+  // tiny problems by cusolver
+  ASSERT(n_rows <= 32 && n_cols <= 32,
+         "svdJacobiBatched supports matrices of at most 32x32 (got %dx%d)",
+         n_rows,
+         n_cols);
+  cusolverDnHandle_t cusolverH = handle.get_cusolver_dn_handle();
+
+  gesvdjInfo_t gesvdj_params = NULL;
+
+  RAFT_CUSOLVER_TRY(cusolverDnCreateGesvdjInfo(&gesvdj_params));
+  RAFT_CUSOLVER_TRY(cusolverDnXgesvdjSetTolerance(gesvdj_params, tol));
+  RAFT_CUSOLVER_TRY(cusolverDnXgesvdjSetMaxSweeps(gesvdj_params, max_sweeps));
+
+  int m = n_rows;
+  int n = n_cols;
+
+  rmm::device_uvector<int> devInfo(batch_size, stream);
+
+  int lwork = 0;
+  RAFT_CUSOLVER_TRY(cusolverDngesvdjBatched_bufferSize(cusolverH,
+                                                       CUSOLVER_EIG_MODE_VECTOR,
+                                                       m,
+                                                       n,
+                                                       in,
+                                                       m,
+                                                       sing_vals,
+                                                       left_sing_vecs,
+                                                       m,
+                                                       right_sing_vecs,
+                                                       n,
+                                                       &lwork,
+                                                       gesvdj_params,
+                                                       batch_size));
+
+  raft::workspace_chunk d_work(handle.get_workspace_arena(), sizeof(math_t) * lwork, stream);
+
+  RAFT_CUSOLVER_TRY(cusolverDngesvdjBatched(cusolverH,
+                                            CUSOLVER_EIG_MODE_VECTOR,
+                                            m,
+                                            n,
+                                            in,
+                                            m,
+                                            sing_vals,
+                                            left_sing_vecs,
+                                            m,
+                                            right_sing_vecs,
+                                            n,
+                                            static_cast<math_t*>(d_work.data()),
+                                            lwork,
+                                            devInfo.data(),
+                                            gesvdj_params,
+                                            batch_size,
+                                            stream));
+
+  RAFT_CUSOLVER_TRY(cusolverDnDestroyGesvdjInfo(gesvdj_params));
+}
+
+template <typename math_t>
+void svdPolar(const raft::handle_t& handle,
+              const math_t* in,
+              int n_rows,
+              int n_cols,
+              math_t* sing_vals,
+              math_t* left_sing_vecs,
+              math_t* right_sing_vecs,
+              bool gen_left_vec,
+              bool gen_right_vec,
+              cudaStream_t stream,
+              int max_iters = 30)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "raft::linalg::svdPolar(%d, %d)", n_rows, n_cols);
+  ASSERT(n_rows >= n_cols, "svdPolar requires n_rows >= n_cols (got %dx%d)", n_rows, n_cols);
+
+  int m = n_rows;
+  int n = n_cols;
+
+  const math_t alpha = 1.0, beta = 0.0;
+
+  // X, Xnew (m x n), the small Gram product C and symmetric factor H (n x n)
+  // plus the eigenvector block V (n x n) all come from the handle arena so
+  // repeated small decompositions never hit the device memory resource
+  std::size_t mn = std::size_t(m) * n, nn = std::size_t(n) * n;
+  raft::workspace_chunk ws(handle.get_workspace_arena(), sizeof(math_t) * (2 * mn + 3 * nn), stream);
+  math_t* X    = static_cast<math_t*>(ws.data());
+  math_t* Xnew = X + mn;
+  math_t* C    = Xnew + mn;
+  math_t* H    = C + nn;
+  math_t* V    = H + nn;
+
+  // scaling by the Frobenius norm puts the spectrum inside the Newton-Schulz
+  // convergence region (spectral norm <= 1)
+  math_t norm     = raft::matrix::getL2Norm(handle, const_cast<math_t*>(in), m * n, stream);
+  math_t inv_norm = norm > math_t(0) ? math_t(1) / norm : math_t(0);
+  raft::linalg::unaryOp(
+    X, in, m * n, [inv_norm] __device__(math_t v) { return v * inv_norm; }, stream);
+
+  // inverse-free Newton-Schulz iteration X <- 1.5 X - 0.5 X (X^T X),
+  // converging to the orthogonal polar factor of the input
+  for (int iter = 0; iter < max_iters; iter++) {
+    raft::linalg::gemm(handle, X, m, n, X, C, n, n, CUBLAS_OP_T, CUBLAS_OP_N, alpha, beta, stream);
+    raft::copy(Xnew, X, mn, stream);
+    raft::linalg::gemm(handle,
+                       X,
+                       m,
+                       n,
+                       C,
+                       Xnew,
+                       m,
+                       n,
+                       CUBLAS_OP_N,
+                       CUBLAS_OP_N,
+                       math_t(-0.5),
+                       math_t(1.5),
+                       stream);
+    std::swap(X, Xnew);
+  }
+
+  // the symmetric factor H = X^T A = V S V^T carries the (unscaled) singular
+  // values; its eigendecomposition completes the SVD
+  raft::linalg::gemm(handle,
+                     X,
+                     m,
+                     n,
+                     const_cast<math_t*>(in),
+                     H,
+                     n,
+                     n,
+                     CUBLAS_OP_T,
+                     CUBLAS_OP_N,
+                     alpha,
+                     beta,
+                     stream);
+
+  raft::linalg::eigDC(handle, H, n, n, V, sing_vals, stream);
+  raft::matrix::colReverse(V, n, n, stream);
+  raft::matrix::rowReverse(sing_vals, n, 1, stream);
+
+  if (gen_right_vec) { raft::copy(right_sing_vecs, V, nn, stream); }
+  if (gen_left_vec) {
+    raft::linalg::gemm(
+      handle, X, m, n, V, left_sing_vecs, m, n, CUBLAS_OP_N, CUBLAS_OP_N, alpha, beta, stream);
+  }
+}
+
+template <typename math_t>
+void svdAdaptive(const raft::handle_t& handle,
+                 math_t* in,
+                 int n_rows,
+                 int n_cols,
+                 math_t* sing_vals,
+                 math_t* left_sing_vecs,
+                 math_t* right_sing_vecs,
+                 bool gen_left_vec,
+                 bool gen_right_vec,
+                 math_t tol,
+                 int max_sweeps,
+                 cudaStream_t stream)
+{
+  if (n_rows >= 4 * n_cols) {
+    // tall-skinny: the polar/Newton path runs on gemms instead of the
+    // serialized one-sided rotations of gesvd/gesvdj
+    svdPolar(handle,
+             in,
+             n_rows,
+             n_cols,
+             sing_vals,
+             left_sing_vecs,
+             right_sing_vecs,
+             gen_left_vec,
+             gen_right_vec,
+             stream);
+  } else {
+    svdJacobi(handle,
+              in,
+              n_rows,
+              n_cols,
+              sing_vals,
+              left_sing_vecs,
+              right_sing_vecs,
+              gen_left_vec,
+              gen_right_vec,
+              tol,
+              max_sweeps,
+              stream);
+  }
+}
+
 template <typename math_t>
 void svdReconstruction(const raft::handle_t& handle,
                        math_t* U,
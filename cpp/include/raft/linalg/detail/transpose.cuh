@@ -16,17 +16,120 @@
 
 #pragma once
 
-#include "cublas_wrappers.hpp"
-
+#include <raft/cuda_utils.cuh>
 #include <raft/handle.hpp>
-#include <rmm/exec_policy.hpp>
-#include <thrust/for_each.h>
-#include <thrust/iterator/counting_iterator.h>
+
+#include <cstddef>
 
 namespace raft {
 namespace linalg {
 namespace detail {
 
+static const int TransposeTileDim   = 32;
+static const int TransposeBlockRows = 8;
+
+// Tiled shared-memory transpose of a column major matrix. The tile is padded
+// by one element so that the strided shared-memory accesses of the write
+// phase are free of bank conflicts; both global reads and writes are
+// coalesced.
+template <typename math_t>
+__global__ void transposeTiledKernel(const math_t* in, math_t* out, int n_rows, int n_cols)
+{
+  __shared__ math_t tile[TransposeTileDim][TransposeTileDim + 1];
+
+  int r = blockIdx.x * TransposeTileDim + threadIdx.x;
+#pragma unroll
+  for (int j = 0; j < TransposeTileDim; j += TransposeBlockRows) {
+    int c = blockIdx.y * TransposeTileDim + threadIdx.y + j;
+    if (r < n_rows && c < n_cols) {
+      tile[threadIdx.y + j][threadIdx.x] = in[(size_t)c * n_rows + r];
+    }
+  }
+  __syncthreads();
+
+  // the output is n_cols x n_rows; the roles of the block indices swap
+  int ro = blockIdx.y * TransposeTileDim + threadIdx.x;
+#pragma unroll
+  for (int j = 0; j < TransposeTileDim; j += TransposeBlockRows) {
+    int co = blockIdx.x * TransposeTileDim + threadIdx.y + j;
+    if (ro < n_cols && co < n_rows) {
+      out[(size_t)co * n_cols + ro] = tile[threadIdx.x][threadIdx.y + j];
+    }
+  }
+}
+
+// In-place tiled transpose of a square column major matrix. Each block either
+// mirrors a diagonal tile or swaps a pair of tiles across the diagonal, so
+// every element is touched by exactly one block.
+template <typename math_t>
+__global__ void transposeInplaceSquareKernel(math_t* data, int n)
+{
+  __shared__ math_t tile_a[TransposeTileDim][TransposeTileDim + 1];
+  __shared__ math_t tile_b[TransposeTileDim][TransposeTileDim + 1];
+
+  if (blockIdx.x > blockIdx.y) return;
+  bool diag = blockIdx.x == blockIdx.y;
+
+  // tile a: rows of block y, cols of block x; tile b: the mirrored tile
+  int ra = blockIdx.y * TransposeTileDim + threadIdx.x;
+  int rb = blockIdx.x * TransposeTileDim + threadIdx.x;
+#pragma unroll
+  for (int j = 0; j < TransposeTileDim; j += TransposeBlockRows) {
+    int ca = blockIdx.x * TransposeTileDim + threadIdx.y + j;
+    int cb = blockIdx.y * TransposeTileDim + threadIdx.y + j;
+    if (ra < n && ca < n) { tile_a[threadIdx.y + j][threadIdx.x] = data[(size_t)ca * n + ra]; }
+    if (!diag && rb < n && cb < n) {
+      tile_b[threadIdx.y + j][threadIdx.x] = data[(size_t)cb * n + rb];
+    }
+  }
+  __syncthreads();
+
+#pragma unroll
+  for (int j = 0; j < TransposeTileDim; j += TransposeBlockRows) {
+    int ca = blockIdx.x * TransposeTileDim + threadIdx.y + j;
+    int cb = blockIdx.y * TransposeTileDim + threadIdx.y + j;
+    if (rb < n && cb < n) { data[(size_t)cb * n + rb] = tile_a[threadIdx.x][threadIdx.y + j]; }
+    if (!diag && ra < n && ca < n) {
+      data[(size_t)ca * n + ra] = tile_b[threadIdx.x][threadIdx.y + j];
+    }
+  }
+}
+
+// In-place transpose of a rectangular column major matrix by following the
+// cycles of the transposition permutation: position i moves to
+// (i * n_cols) mod (len - 1). Each thread checks whether its index is the
+// smallest of its cycle and, if so, rotates the whole cycle; cycles are
+// independent so no extra storage or synchronization is needed. This trades
+// redundant index arithmetic for O(1) auxiliary memory, which is the point of
+// the in-place path.
+template <typename math_t>
+__global__ void transposeInplaceCycleKernel(math_t* data, size_t n_rows, size_t n_cols)
+{
+  size_t len = n_rows * n_cols;
+  size_t i   = (size_t)blockIdx.x * blockDim.x + threadIdx.x;
+  // first and last elements are fixed points of the permutation
+  if (i == 0 || i >= len - 1) return;
+
+  size_t mod = len - 1;
+  // check that i is the cycle leader (the smallest index of its cycle)
+  size_t cur = (i * n_cols) % mod;
+  while (cur != i) {
+    if (cur < i) return;
+    cur = (cur * n_cols) % mod;
+  }
+
+  // rotate the cycle: the value at each position moves to its successor
+  math_t carried = data[i];
+  cur            = (i * n_cols) % mod;
+  while (cur != i) {
+    math_t tmp = data[cur];
+    data[cur]  = carried;
+    carried    = tmp;
+    cur        = (cur * n_cols) % mod;
+  }
+  data[i] = carried;
+}
+
 template <typename math_t>
 void transpose(const raft::handle_t& handle,
                math_t* in,
@@ -35,48 +138,34 @@ void transpose(const raft::handle_t& handle,
                int n_cols,
                cudaStream_t stream)
 {
-  cublasHandle_t cublas_h = handle.get_cublas_handle();
-
-  int out_n_rows = n_cols;
-  int out_n_cols = n_rows;
-
-  const math_t alpha = 1.0;
-  const math_t beta  = 0.0;
-  RAFT_CUBLAS_TRY(cublasgeam(cublas_h,
-                             CUBLAS_OP_T,
-                             CUBLAS_OP_N,
-                             out_n_rows,
-                             out_n_cols,
-                             &alpha,
-                             in,
-                             n_rows,
-                             &beta,
-                             out,
-                             out_n_rows,
-                             out,
-                             out_n_rows,
-                             stream));
+  dim3 blocks(raft::ceildiv(n_rows, TransposeTileDim), raft::ceildiv(n_cols, TransposeTileDim), 1);
+  dim3 threads(TransposeTileDim, TransposeBlockRows, 1);
+  transposeTiledKernel<<<blocks, threads, 0, stream>>>(in, out, n_rows, n_cols);
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
 }
 
 template <typename math_t>
 void transpose(math_t* inout, int n, cudaStream_t stream)
 {
-  auto m        = n;
-  auto size     = n * n;
-  auto d_inout  = inout;
-  auto counting = thrust::make_counting_iterator<int>(0);
-
-  thrust::for_each(rmm::exec_policy(stream), counting, counting + size, [=] __device__(int idx) {
-    int s_row = idx % m;
-    int s_col = idx / m;
-    int d_row = s_col;
-    int d_col = s_row;
-    if (s_row < s_col) {
-      auto temp                  = d_inout[d_col * m + d_row];
-      d_inout[d_col * m + d_row] = d_inout[s_col * m + s_row];
-      d_inout[s_col * m + s_row] = temp;
-    }
-  });
+  dim3 blocks(raft::ceildiv(n, TransposeTileDim), raft::ceildiv(n, TransposeTileDim), 1);
+  dim3 threads(TransposeTileDim, TransposeBlockRows, 1);
+  transposeInplaceSquareKernel<<<blocks, threads, 0, stream>>>(inout, n);
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
+}
+
+template <typename math_t>
+void transpose(math_t* inout, int n_rows, int n_cols, cudaStream_t stream)
+{
+  if (n_rows == n_cols) {
+    transpose(inout, n_rows, stream);
+    return;
+  }
+  size_t len = (size_t)n_rows * n_cols;
+  if (len < 2) return;
+  static const int TPB = 256;
+  int blocks           = raft::ceildiv(len, (size_t)TPB);
+  transposeInplaceCycleKernel<<<blocks, TPB, 0, stream>>>(inout, (size_t)n_rows, (size_t)n_cols);
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
 }
 
 };  // end namespace detail
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <raft/common/detail/launch_config.cuh>
 #include <raft/cuda_utils.cuh>
 #include <raft/cudart_utils.h>
 #include <raft/vectorized.cuh>
@@ -45,9 +46,13 @@ __global__ void unaryOpKernel(OutType* out, const InType* in, IdxType len, Lambd
 template <typename InType, int VecLen, typename Lambda, typename OutType, typename IdxType, int TPB>
 void unaryOpImpl(OutType* out, const InType* in, IdxType len, Lambda op, cudaStream_t stream)
 {
-  const IdxType nblks = raft::ceildiv(VecLen ? len / VecLen : len, (IdxType)TPB);
+  const IdxType work  = VecLen ? len / VecLen : len;
+  const int blksize =
+    raft::detail::elementwise_block_size(unaryOpKernel<InType, VecLen, Lambda, OutType, IdxType>,
+                                         size_t(work));
+  const IdxType nblks = raft::ceildiv(work, (IdxType)blksize);
   unaryOpKernel<InType, VecLen, Lambda, OutType, IdxType>
-    <<<nblks, TPB, 0, stream>>>(out, in, len, op);
+    <<<nblks, blksize, 0, stream>>>(out, in, len, op);
   RAFT_CUDA_TRY(cudaPeekAtLastError());
 }
 
@@ -89,8 +94,11 @@ template <typename OutType, typename Lambda, typename IdxType = int, int TPB = 2
 void writeOnlyUnaryOpCaller(OutType* out, IdxType len, Lambda op, cudaStream_t stream)
 {
   if (len <= 0) return;  // silently skip in case of 0 length input
-  auto nblks = raft::ceildiv<IdxType>(len, TPB);
-  writeOnlyUnaryOpKernel<OutType, Lambda, IdxType><<<nblks, TPB, 0, stream>>>(out, len, op);
+  const int blksize =
+    raft::detail::elementwise_block_size(writeOnlyUnaryOpKernel<OutType, Lambda, IdxType>,
+                                         size_t(len));
+  auto nblks = raft::ceildiv<IdxType>(len, blksize);
+  writeOnlyUnaryOpKernel<OutType, Lambda, IdxType><<<nblks, blksize, 0, stream>>>(out, len, op);
   RAFT_CUDA_TRY(cudaGetLastError());
 }
 
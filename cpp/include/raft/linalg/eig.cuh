@@ -20,6 +20,8 @@
 
 #include "detail/eig.cuh"
 
+#include <raft/core/nvtx.hpp>
+
 namespace raft {
 namespace linalg {
 
@@ -49,6 +51,8 @@ void eigDC(const raft::handle_t& handle,
            math_t* eig_vals,
            cudaStream_t stream)
 {
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "linalg::eigDC (%zu, %zu)", n_rows, n_cols);
   detail::eigDC(handle, in, n_rows, n_cols, eig_vectors, eig_vals, stream);
 }
 
@@ -81,6 +85,8 @@ void eigSelDC(const raft::handle_t& handle,
               EigVecMemUsage memUsage,
               cudaStream_t stream)
 {
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "linalg::eigSelDC (%zu, %zu)", n_rows, n_cols);
   detail::eigSelDC(handle, in, n_rows, n_cols, n_eig_vals, eig_vectors, eig_vals, memUsage, stream);
 }
 
@@ -110,8 +116,43 @@ void eigJacobi(const raft::handle_t& handle,
                math_t tol = 1.e-7,
                int sweeps = 15)
 {
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "linalg::eigJacobi (%zu, %zu)", n_rows, n_cols);
   detail::eigJacobi(handle, in, n_rows, n_cols, eig_vectors, eig_vals, stream, tol, sweeps);
 }
+
+/**
+ * @brief eig decomp of a batch of small column-major symmetric matrices with
+ * a block-per-matrix Jacobi method. Each matrix is decomposed entirely in
+ * shared memory, making this much faster than per-matrix cusolver calls for
+ * large batches of tiny (up to 32x32) matrices such as per-cluster
+ * covariances.
+ * @param handle: raft handle
+ * @param in: input matrices, batch_size matrices of size n * n
+ * @param n: number of rows and cols of each input matrix
+ * @param batch_size: number of matrices in the batch
+ * @param eig_vectors: eigenvectors of each matrix, same layout as the input
+ * @param eig_vals: eigen values, batch_size * n, ascending per matrix
+ * @param stream: stream on which this function will be run
+ * @param tol: error tolerance for the jacobi method. Algorithm stops when the
+ * relative off-diagonal norm is below tol
+ * @param sweeps: maximum number of sweeps in the Jacobi algorithm
+ */
+template <typename math_t>
+void eig_batched(const raft::handle_t& handle,
+                 const math_t* in,
+                 int n,
+                 int batch_size,
+                 math_t* eig_vectors,
+                 math_t* eig_vals,
+                 cudaStream_t stream,
+                 math_t tol = 1.e-7,
+                 int sweeps = 15)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "linalg::eig_batched (%zu, %zu)", size_t(n), size_t(batch_size));
+  detail::eig_batched(handle, in, n, batch_size, eig_vectors, eig_vals, stream, tol, sweeps);
+}
 /** @} */  // end of eig
 
 };  // end namespace linalg
@@ -135,6 +135,129 @@ void gemm(const raft::handle_t& handle,
   detail::gemm(handle, a, n_rows_a, n_cols_a, b, c, n_rows_c, n_cols_c, trans_a, trans_b, stream);
 }
 
+/**
+ * @brief strided-batched gemm: C_i = alpha .* opA(A_i) * opB(B_i) + beta .* C_i
+ *  All batch members share the same shape; operand i starts stride elements
+ *  after operand i-1. One launch covers the whole batch, so many small
+ *  per-cluster multiplies do not pay a per-call overhead.
+ *
+ * @tparam math_t the element type
+ * @param [in] handle raft handle
+ * @param [in] trans_a cublas transpose op for A
+ * @param [in] trans_b cublas transpose op for B
+ * @param [in] m number of rows of each C_i
+ * @param [in] n number of columns of each C_i
+ * @param [in] k number of rows of opB(B_i) / number of columns of opA(A_i)
+ * @param [in] alpha host scalar
+ * @param [in] A batch of matrices such that the shape of column-major opA(A_i) is [m, k]
+ * @param [in] lda leading dimension of each A_i
+ * @param [in] stride_a stride (in elements) between consecutive A_i
+ * @param [in] B batch of matrices such that the shape of column-major opB(B_i) is [k, n]
+ * @param [in] ldb leading dimension of each B_i
+ * @param [in] stride_b stride (in elements) between consecutive B_i
+ * @param [in] beta host scalar
+ * @param [inout] C batch of column-major matrices of size [m, n]
+ * @param [in] ldc leading dimension of each C_i
+ * @param [in] stride_c stride (in elements) between consecutive C_i
+ * @param [in] batch_count number of batch members
+ * @param [in] stream
+ */
+template <typename math_t>
+void gemm_strided_batched(const raft::handle_t& handle,
+                          const bool trans_a,
+                          const bool trans_b,
+                          const int m,
+                          const int n,
+                          const int k,
+                          const math_t* alpha,
+                          const math_t* A,
+                          const int lda,
+                          const int64_t stride_a,
+                          const math_t* B,
+                          const int ldb,
+                          const int64_t stride_b,
+                          const math_t* beta,
+                          math_t* C,
+                          const int ldc,
+                          const int64_t stride_c,
+                          const int batch_count,
+                          cudaStream_t stream)
+{
+  detail::gemm_strided_batched(handle,
+                               trans_a,
+                               trans_b,
+                               m,
+                               n,
+                               k,
+                               alpha,
+                               A,
+                               lda,
+                               stride_a,
+                               B,
+                               ldb,
+                               stride_b,
+                               beta,
+                               C,
+                               ldc,
+                               stride_c,
+                               batch_count,
+                               stream);
+}
+
+/**
+ * @brief strided-batched gemm over densely packed batches:
+ *  C_i = alpha . opA(A_i) * opB(B_i) + beta . C_i
+ *  Convenience overload following the layout conventions of the scalar gemm
+ *  above; strides are derived from the (shared) operand shapes.
+ *
+ * @tparam math_t the type of input/output matrices
+ * @param handle raft handle
+ * @param a batch of input matrices, densely packed
+ * @param n_rows_a number of rows of each A_i
+ * @param n_cols_a number of columns of each A_i
+ * @param b batch of input matrices, densely packed
+ * @param c batch of output matrices, densely packed
+ * @param n_rows_c number of rows of each C_i
+ * @param n_cols_c number of columns of each C_i
+ * @param trans_a cublas transpose op for A
+ * @param trans_b cublas transpose op for B
+ * @param alpha scalar
+ * @param beta scalar
+ * @param batch_count number of batch members
+ * @param stream cuda stream
+ */
+template <typename math_t>
+void gemm_strided_batched(const raft::handle_t& handle,
+                          const math_t* a,
+                          int n_rows_a,
+                          int n_cols_a,
+                          const math_t* b,
+                          math_t* c,
+                          int n_rows_c,
+                          int n_cols_c,
+                          cublasOperation_t trans_a,
+                          cublasOperation_t trans_b,
+                          math_t alpha,
+                          math_t beta,
+                          int batch_count,
+                          cudaStream_t stream)
+{
+  detail::gemm_strided_batched(handle,
+                               a,
+                               n_rows_a,
+                               n_cols_a,
+                               b,
+                               c,
+                               n_rows_c,
+                               n_cols_c,
+                               trans_a,
+                               trans_b,
+                               alpha,
+                               beta,
+                               batch_count,
+                               stream);
+}
+
 /**
  * @brief A wrapper for CUBLS GEMM function designed for handling all possible
  * combinations of operand layouts.
@@ -206,6 +206,59 @@ void gemv(const raft::handle_t& handle,
   detail::gemv(handle, A, n_rows_a, n_cols_a, lda, x, y, trans_a, stream);
 }
 
+/**
+ * @brief batched gemv: y_i = alpha * op(A_i) * x_i + beta * y_i
+ *  All batch members share the same shape; operand i starts stride elements
+ *  after operand i-1. The whole batch runs in one launch, so many small
+ *  per-cluster multiplies do not pay a per-call overhead.
+ *
+ * @param handle raft handle
+ * @param A batch of column-major matrices of size [n_rows_a, n_cols_a]
+ * @param n_rows_a number of rows of each A_i
+ * @param n_cols_a number of columns of each A_i
+ * @param stride_a stride (in elements) between consecutive A_i
+ * @param x batch of vectors of size `trans_a ? n_rows_a : n_cols_a`
+ * @param stride_x stride (in elements) between consecutive x_i
+ * @param y batch of vectors of size `trans_a ? n_cols_a : n_rows_a`
+ * @param stride_y stride (in elements) between consecutive y_i
+ * @param trans_a whether to take transpose of each A_i
+ * @param alpha scalar
+ * @param beta scalar
+ * @param batch_count number of batch members
+ * @param stream stream on which this function is run
+ */
+template <typename math_t>
+void gemv_batched(const raft::handle_t& handle,
+                  const math_t* A,
+                  const int n_rows_a,
+                  const int n_cols_a,
+                  const int64_t stride_a,
+                  const math_t* x,
+                  const int64_t stride_x,
+                  math_t* y,
+                  const int64_t stride_y,
+                  const bool trans_a,
+                  const math_t alpha,
+                  const math_t beta,
+                  const int batch_count,
+                  cudaStream_t stream)
+{
+  detail::gemv_batched(handle,
+                       A,
+                       n_rows_a,
+                       n_cols_a,
+                       stride_a,
+                       x,
+                       stride_x,
+                       y,
+                       stride_y,
+                       trans_a,
+                       alpha,
+                       beta,
+                       batch_count,
+                       stream);
+}
+
 };  // namespace linalg
 };  // namespace raft
 #endif
\ No newline at end of file
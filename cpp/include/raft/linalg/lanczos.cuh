@@ -28,6 +28,15 @@ namespace linalg {
 // Eigensolver
 // =========================================================
 
+/**
+ *  @brief  Convergence telemetry for the restarted Lanczos solvers.
+ *    Holds iteration, restart, and SpMV counts plus residual estimates
+ *    per eigenpair; useful for tuning restartIter and maxIter from
+ *    measured behavior.
+ */
+template <typename index_type_t, typename value_type_t>
+using lanczos_telemetry_t = detail::lanczos_telemetry_t<index_type_t, value_type_t>;
+
 /**
  *  @brief  Compute smallest eigenvectors of symmetric matrix
  *    Computes eigenvalues and eigenvectors that are least
@@ -63,6 +72,12 @@ namespace linalg {
  *    matrix. Vectors are stored as columns of a column-major matrix
  *    with dimensions n x nEigVecs.
  *  @param seed random seed.
+ *  @param telemetry Optional convergence telemetry. When non-null, the
+ *    struct is reset and filled with iteration, restart, and SpMV
+ *    counts plus residual estimates per eigenpair.
+ *  @param use_fp32_spmv Whether to apply the matrix in single
+ *    precision while keeping the orthogonalization in value_type_t
+ *    precision. Ignored unless value_type_t is double.
  *  @return error flag.
  */
 template <typename index_type_t, typename value_type_t>
@@ -77,7 +92,9 @@ int computeSmallestEigenvectors(
   index_type_t& iter,
   value_type_t* __restrict__ eigVals_dev,
   value_type_t* __restrict__ eigVecs_dev,
-  unsigned long long seed = 1234567)
+  unsigned long long seed                                    = 1234567,
+  lanczos_telemetry_t<index_type_t, value_type_t>* telemetry = nullptr,
+  bool use_fp32_spmv                                         = false)
 {
   return detail::computeSmallestEigenvectors(handle,
                                              A,
@@ -89,7 +106,9 @@ int computeSmallestEigenvectors(
                                              iter,
                                              eigVals_dev,
                                              eigVecs_dev,
-                                             seed);
+                                             seed,
+                                             telemetry,
+                                             use_fp32_spmv);
 }
 
 /**
@@ -127,6 +146,12 @@ int computeSmallestEigenvectors(
  *    matrix. Vectors are stored as columns of a column-major matrix
  *    with dimensions n x nEigVecs.
  *  @param seed random seed.
+ *  @param telemetry Optional convergence telemetry. When non-null, the
+ *    struct is reset and filled with iteration, restart, and SpMV
+ *    counts plus residual estimates per eigenpair.
+ *  @param use_fp32_spmv Whether to apply the matrix in single
+ *    precision while keeping the orthogonalization in value_type_t
+ *    precision. Ignored unless value_type_t is double.
  *  @return error flag.
  */
 template <typename index_type_t, typename value_type_t>
@@ -141,7 +166,9 @@ int computeLargestEigenvectors(
   index_type_t& iter,
   value_type_t* __restrict__ eigVals_dev,
   value_type_t* __restrict__ eigVecs_dev,
-  unsigned long long seed = 123456)
+  unsigned long long seed                                    = 123456,
+  lanczos_telemetry_t<index_type_t, value_type_t>* telemetry = nullptr,
+  bool use_fp32_spmv                                         = false)
 {
   return detail::computeLargestEigenvectors(handle,
                                             A,
@@ -153,7 +180,9 @@ int computeLargestEigenvectors(
                                             iter,
                                             eigVals_dev,
                                             eigVecs_dev,
-                                            seed);
+                                            seed,
+                                            telemetry,
+                                            use_fp32_spmv);
 }
 
 }  // namespace linalg
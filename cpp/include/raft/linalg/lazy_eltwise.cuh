@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __LAZY_ELTWISE_H
+#define __LAZY_ELTWISE_H
+
+#pragma once
+
+#include "detail/lazy_eltwise.cuh"
+
+namespace raft {
+namespace linalg {
+
+/**
+ * @defgroup LazyEltwise lazily evaluated elementwise expressions
+ *
+ * Each eager elementwise op (eltwiseMultiply, eltwiseAdd, power, ...) launches
+ * its own kernel and traverses the full buffers, so a chain of N ops reads and
+ * writes the data N times. Expression templates collapse such chains: wrapping
+ * device arrays with lazy() and composing them with the overloaded operators
+ * (and lazy_power/lazy_sqrt/lazy_abs/lazy_exp/lazy_log) only builds a small
+ * expression object; nothing executes until lazy_eval(), which fuses the whole
+ * chain into one kernel and a single pass over the data. For example:
+ *
+ * @code{.cpp}
+ *   using namespace raft::linalg;
+ *   auto expr = lazy_sqrt((lazy(a) * lazy(b) + 1.0f) / lazy(c));
+ *   lazy_eval(out, len, expr, stream);  // one kernel launch
+ * @endcode
+ *
+ * Scalars mix freely with expressions and are broadcast. Expression objects
+ * hold raw device pointers and scalars only; they are cheap to copy but must
+ * not outlive the arrays they reference. The output may alias any input since
+ * each element is read before it is written by the same thread.
+ * @{
+ */
+
+/**
+ * @brief Wraps a device array into a lazy expression leaf
+ * @tparam Type data-type of the array
+ * @param ptr the device array; not dereferenced until lazy_eval()
+ */
+template <typename Type>
+auto lazy(const Type* ptr)
+{
+  return detail::lazy_array<Type>(ptr);
+}
+
+using detail::lazy_abs;
+using detail::lazy_exp;
+using detail::lazy_log;
+using detail::lazy_power;
+using detail::lazy_sqrt;
+using detail::operator+;
+using detail::operator-;
+using detail::operator*;
+using detail::operator/;
+
+/**
+ * @brief Evaluates a composed lazy expression with a single fused kernel
+ * @tparam OutType data-type in which the result will be stored
+ * @tparam ExprT the (deduced) expression type
+ * @param out the output array (assumed to be a device pointer)
+ * @param len number of elements to evaluate
+ * @param expr the composed expression
+ * @param stream cuda-stream where to launch this kernel
+ */
+template <typename OutType, typename ExprT>
+void lazy_eval(OutType* out, size_t len, const ExprT& expr, cudaStream_t stream)
+{
+  detail::lazyEvalImpl<OutType, ExprT>(out, len, expr, stream);
+}
+
+/** @} */
+
+}  // namespace linalg
+};  // namespace raft
+
+#endif
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __LOBPCG_H
+#define __LOBPCG_H
+
+#pragma once
+
+#include "detail/lobpcg.cuh"
+#include <raft/spectral/matrix_wrappers.hpp>
+
+namespace raft {
+namespace linalg {
+
+// =========================================================
+// Eigensolver
+// =========================================================
+
+/**
+ *  @brief  Compute smallest eigenvectors of symmetric matrix with LOBPCG.
+ *    Locally optimal block preconditioned conjugate gradient (without
+ *    preconditioner): all nEigVecs eigenpairs are iterated as a block,
+ *    with a Rayleigh-Ritz procedure on the subspace spanned by the
+ *    current Ritz block, the residual block and the conjugate direction
+ *    block. Each iteration costs one sparse matrix product per block
+ *    vector, so for multi-eigenpair problems the solver typically needs
+ *    several times fewer matrix products than a restarted Lanczos run.
+ *  @tparam index_type_t the type of data used for indexing.
+ *  @tparam value_type_t the type of data used for weights, distances.
+ *  @param handle the raft handle.
+ *  @param A Matrix.
+ *  @param nEigVecs Number of eigenvectors to compute. The internal
+ *    subspace has 3*nEigVecs vectors, which must not exceed the matrix
+ *    dimension.
+ *  @param maxIter Maximum number of LOBPCG iterations.
+ *  @param tol Convergence tolerance. Iteration terminates when every
+ *    residual column norm is less than tol.
+ *  @param iter On exit, number of LOBPCG iterations performed.
+ *  @param eigVals_dev (Output, device memory, nEigVecs entries)
+ *    Smallest eigenvalues of matrix.
+ *  @param eigVecs_dev (Output, device memory, n*nEigVecs entries)
+ *    Eigenvectors corresponding to smallest eigenvalues of
+ *    matrix. Vectors are stored as columns of a column-major matrix
+ *    with dimensions n x nEigVecs.
+ *  @param seed random seed for the starting block. Ignored when an
+ *    initial block is given.
+ *  @param eigVecs_init (Input, device memory, n*nEigVecs entries or
+ *    nullptr) Optional starting block, stored like eigVecs_dev.
+ *    Passing the eigenvector block of a previous solve on a slightly
+ *    perturbed matrix warm-starts the iteration instead of beginning
+ *    from a random subspace.
+ *  @return error flag.
+ */
+template <typename index_type_t, typename value_type_t>
+int computeSmallestEigenvectorsLOBPCG(
+  handle_t const& handle,
+  spectral::matrix::sparse_matrix_t<index_type_t, value_type_t> const& A,
+  index_type_t nEigVecs,
+  index_type_t maxIter,
+  value_type_t tol,
+  index_type_t& iter,
+  value_type_t* __restrict__ eigVals_dev,
+  value_type_t* __restrict__ eigVecs_dev,
+  unsigned long long seed                       = 1234567,
+  const value_type_t* __restrict__ eigVecs_init = nullptr)
+{
+  return detail::computeSmallestEigenvectorsLOBPCG(
+    handle, A, nEigVecs, maxIter, tol, iter, eigVals_dev, eigVecs_dev, seed, eigVecs_init);
+}
+
+}  // namespace linalg
+}  // namespace raft
+
+#endif
@@ -115,6 +115,34 @@ void lstsqQR(const raft::handle_t& handle,
   detail::lstsqQR(handle, A, n_rows, n_cols, b, w, stream);
 }
 
+/** Solves a batch of independent linear ordinary least squares problems
+ *  `A_i w_i = b_i` sharing the same shape, via the normal equations.
+ *  The whole batch is processed with a handful of batched BLAS/solver calls
+ *  and a single workspace allocation, instead of one solver call per system.
+ *
+ * @param[in] handle raft handle
+ * @param[in] A batch of input feature matrices, column major,
+ *            size [n_rows * n_cols * batch_size]
+ * @param[in] n_rows number of rows in each A_i
+ * @param[in] n_cols number of columns in each A_i
+ * @param[in] b batch of input target vectors, size [n_rows * batch_size]
+ * @param[out] w batch of output coefficient vectors, size [n_cols * batch_size]
+ * @param[in] batch_size number of independent systems
+ * @param[in] stream cuda stream for ordering operations
+ */
+template <typename math_t>
+void lstsqBatched(const raft::handle_t& handle,
+                  const math_t* A,
+                  const int n_rows,
+                  const int n_cols,
+                  const math_t* b,
+                  math_t* w,
+                  const int batch_size,
+                  cudaStream_t stream)
+{
+  detail::lstsqBatched(handle, A, n_rows, n_cols, b, w, batch_size, stream);
+}
+
 };  // namespace linalg
 };  // namespace raft
 
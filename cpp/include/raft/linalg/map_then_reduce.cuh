@@ -85,6 +85,44 @@ void mapThenReduce(OutType* out,
   detail::mapThenReduceImpl<InType, OutType, MapOp, ReduceLambda, TPB, Args...>(
     out, len, neutral, map, op, stream, in, args...);
 }
+
+/**
+ * @brief Bundles one map/reduce functor pair with its output scalar and
+ * neutral element for use with mapThenReduceMulti
+ * @tparam OutType data-type of the reduced output
+ * @tparam MapOp the device-lambda performing the map operation
+ * @tparam ReduceLambda the device-lambda performing the reduction
+ * @param out the output reduced value (assumed to be a device pointer)
+ * @param neutral The neutral element of the reduction operation. For example:
+ *    0 for sum, 1 for multiply, +Inf for Min, -Inf for Max
+ * @param map the map device-lambda
+ * @param op the reduction device-lambda
+ */
+template <typename OutType, typename MapOp, typename ReduceLambda>
+auto makeMapReduceOp(OutType* out, OutType neutral, MapOp map, ReduceLambda op)
+{
+  return detail::map_reduce_op<OutType, MapOp, ReduceLambda>{out, neutral, map, op};
+}
+
+/**
+ * @brief CUDA version of a multi-output map and reduce operation. Every
+ * bundled map/reduce pair is evaluated against the same elements, so several
+ * statistics of one buffer cost a single data pass instead of one per
+ * statistic.
+ * @tparam InType data-type of the input array
+ * @tparam TPB threads-per-block in the final kernel launched
+ * @tparam MapReduceOps bundles created with makeMapReduceOp
+ * @param len number of elements in the input array
+ * @param stream cuda-stream where to launch this kernel
+ * @param in the input array
+ * @param ops map/reduce bundles, each writing its reduced value to its own
+ *    output
+ */
+template <typename InType, int TPB = 256, typename... MapReduceOps>
+void mapThenReduceMulti(size_t len, cudaStream_t stream, const InType* in, MapReduceOps... ops)
+{
+  detail::mapThenReduceMultiImpl<InType, TPB, MapReduceOps...>(len, stream, in, ops...);
+}
 };  // end namespace linalg
 };  // end namespace raft
 
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __PERSISTENT_OP_H
+#define __PERSISTENT_OP_H
+
+#pragma once
+
+#include <raft/common/detail/launch_config.cuh>
+#include <raft/handle.hpp>
+#include <raft/linalg/detail/persistent_op.cuh>
+
+#include <rmm/device_uvector.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+namespace raft {
+namespace linalg {
+
+/**
+ * @brief Persistent-kernel execution mode for high-frequency small binary ops.
+ *
+ * For callers issuing `binaryOp`-sized work on tiny buffers at high rates,
+ * kernel launch latency exceeds the kernel runtime. This class launches one
+ * resident grid-stride kernel on the stream at construction and feeds it
+ * through a device-visible ring buffer in mapped pinned memory: `enqueue`
+ * publishes a work descriptor without any CUDA API call, amortizing the
+ * single launch across thousands of micro-ops.
+ *
+ * The kernel occupies the stream for the lifetime of the object -- work
+ * submitted to the stream afterwards runs only after destruction -- so use a
+ * dedicated stream (or a pool stream) for the persistent mode. Enqueued ops
+ * execute in submission order; `drain()` blocks the host until everything
+ * published so far has completed, which substitutes for a stream sync while
+ * the kernel is resident.
+ *
+ * @code{.cpp}
+ * raft::linalg::persistent_binary_op<float, decltype(op)> batch(handle, op);
+ * for (...) { batch.enqueue(out, in1, in2, len); }
+ * batch.drain();
+ * @endcode
+ *
+ * @tparam InType input data-type
+ * @tparam Lambda the device binary functor, `OutType op(InType a, InType b)`
+ * @tparam OutType output data-type
+ * @tparam IdxType indexing type
+ */
+template <typename InType, typename Lambda, typename OutType = InType, typename IdxType = int>
+class persistent_binary_op {
+  using desc_t = detail::persistent_op_desc<InType, OutType, IdxType>;
+
+ public:
+  /**
+   * @param handle raft handle; the persistent kernel runs on `handle.get_stream()`
+   * @param op the binary operation to apply to every enqueued item
+   * @param capacity ring-buffer depth; `enqueue` blocks when this many ops are in flight
+   */
+  persistent_binary_op(const raft::handle_t& handle, Lambda op, int capacity = 1024)
+    : stream_(handle.get_stream()), capacity_(capacity), block_done_(capacity, stream_)
+  {
+    RAFT_CUDA_TRY(cudaHostAlloc(&ctrl_,
+                                sizeof(detail::persistent_op_control) + capacity_ * sizeof(desc_t),
+                                cudaHostAllocMapped | cudaHostAllocPortable));
+    std::memset(static_cast<void*>(ctrl_), 0, sizeof(*ctrl_));
+    queue_ = reinterpret_cast<desc_t*>(ctrl_ + 1);
+    RAFT_CUDA_TRY(cudaMemsetAsync(
+      block_done_.data(), 0, capacity_ * sizeof(unsigned int), stream_.value()));
+
+    auto kernel = detail::persistentBinaryOpKernel<InType, Lambda, OutType, IdxType>;
+    auto config = raft::detail::occupancy_launch_config(kernel);
+    kernel<<<config.saturating_grid_size, config.block_size, 0, stream_.value()>>>(
+      ctrl_, queue_, capacity_, block_done_.data(), op);
+    RAFT_CUDA_TRY(cudaPeekAtLastError());
+  }
+
+  ~persistent_binary_op()
+  {
+    ctrl_->quit = 1;
+    RAFT_CUDA_TRY_NO_THROW(cudaStreamSynchronize(stream_.value()));
+    RAFT_CUDA_TRY_NO_THROW(cudaFreeHost(static_cast<void*>(ctrl_)));
+  }
+
+  persistent_binary_op(const persistent_binary_op&) = delete;
+  persistent_binary_op& operator=(const persistent_binary_op&) = delete;
+
+  /**
+   * @brief publish one elementwise op to the resident kernel
+   *
+   * Returns as soon as the descriptor is visible to the device; blocks only
+   * when `capacity` ops are already in flight. The buffers must stay valid
+   * until the op completes (cf. `drain`).
+   */
+  void enqueue(OutType* out, const InType* in1, const InType* in2, IdxType len)
+  {
+    if (len <= 0) { return; }
+    while (submitted_ - ctrl_->completed >= static_cast<unsigned long long>(capacity_)) {
+      std::this_thread::yield();
+    }
+    queue_[submitted_ % capacity_] = desc_t{in1, in2, out, len};
+    std::atomic_thread_fence(std::memory_order_release);
+    ctrl_->submitted = ++submitted_;
+  }
+
+  /** @brief block the host until every enqueued op has completed on the device */
+  void drain() const
+  {
+    while (ctrl_->completed < submitted_) {
+      std::this_thread::yield();
+    }
+  }
+
+  /** @brief number of ops published so far */
+  unsigned long long submitted() const { return submitted_; }
+
+ private:
+  rmm::cuda_stream_view stream_;
+  int capacity_;
+  rmm::device_uvector<unsigned int> block_done_;
+  detail::persistent_op_control* ctrl_{nullptr};
+  desc_t* queue_{nullptr};
+  unsigned long long submitted_{0};
+};
+
+};  // namespace linalg
+};  // namespace raft
+
+#endif
@@ -137,6 +137,41 @@ void rsvdPerc(const raft::handle_t& handle,
                    stream);
 }
 
+/**
+ * @brief fixed-rank truncated SVD of a host-resident tall-skinny column major
+ * matrix, streamed through the GPU in row panels with double buffering. The
+ * input never has to fit in device memory, making single-GPU decompositions
+ * of host-resident matrices possible.
+ * @param handle: raft handle
+ * @param M: input matrix in host (ideally pinned) memory [dim = n_rows * n_cols]
+ * @param n_rows: number rows of input matrix
+ * @param n_cols: number columns of input matrix
+ * @param S_vec: top k singular values, on device [dim = k]
+ * @param U: left singular vectors in host memory [dim = n_rows * k], may be
+ * nullptr when gen_left_vec is false
+ * @param V: right singular vectors, on device [dim = n_cols * k]
+ * @param k: no. of singular values to be computed
+ * @param gen_left_vec: left vectors need to be generated or not?
+ * @param stream cuda stream
+ * @param panel_rows: rows per streamed panel; 0 picks a default
+ */
+template <typename math_t>
+void rsvdFixedRankHost(const raft::handle_t& handle,
+                       const math_t* M,
+                       std::size_t n_rows,
+                       std::size_t n_cols,
+                       math_t* S_vec,
+                       math_t* U,
+                       math_t* V,
+                       std::size_t k,
+                       bool gen_left_vec,
+                       cudaStream_t stream,
+                       std::size_t panel_rows = 0)
+{
+  detail::rsvdFixedRankHost(
+    handle, M, n_rows, n_cols, S_vec, U, V, k, gen_left_vec, stream, panel_rows);
+}
+
 };  // end namespace linalg
 };  // end namespace raft
 
@@ -55,6 +55,22 @@ void transpose(math_t* inout, int n, cudaStream_t stream)
   detail::transpose(inout, n, stream);
 }
 
+/**
+ * @brief in-place transpose of a rectangular column major matrix. Square
+ * inputs use the tiled shared-memory kernel; rectangular inputs follow the
+ * cycles of the transposition permutation, so no scratch buffer of the size
+ * of the input is needed.
+ * @param inout: input and output matrix
+ * @param n_rows: number rows of input matrix
+ * @param n_cols: number columns of input matrix
+ * @param stream: cuda stream
+ */
+template <typename math_t>
+void transpose(math_t* inout, int n_rows, int n_cols, cudaStream_t stream)
+{
+  detail::transpose(inout, n_rows, n_cols, stream);
+}
+
 };  // end namespace linalg
 };  // end namespace raft
 
@@ -50,6 +50,29 @@ void sort_cols_per_row(const InType* in,
   detail::sortColumnsPerRow<InType, OutType>(
     in, out, n_rows, n_columns, bAllocWorkspace, workspacePtr, workspaceSize, stream, sortedKeys);
 }
+
+/**
+ * @brief sort columns within each row of row-major input matrix and return sorted indexes
+ * modelled as key-value sort with key being input matrix and value being index of values.
+ * Temp storage is drawn from the handle's workspace arena, so repeated sorts
+ * on a hot path reuse the same retained buffer rather than re-allocating.
+ * @param handle: raft handle
+ * @param in: input matrix
+ * @param out: output value(index) matrix
+ * @param n_rows: number rows of input matrix
+ * @param n_columns: number columns of input matrix
+ * @param sortedKeys: Optional, output matrix for sorted keys (input)
+ */
+template <typename InType, typename OutType>
+void sort_cols_per_row(const raft::handle_t& handle,
+                       const InType* in,
+                       OutType* out,
+                       int n_rows,
+                       int n_columns,
+                       InType* sortedKeys = nullptr)
+{
+  detail::sortColumnsPerRow<InType, OutType>(handle, in, out, n_rows, n_columns, sortedKeys);
+}
 };  // end namespace matrix
 };  // end namespace raft
 
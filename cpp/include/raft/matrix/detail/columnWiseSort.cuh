@@ -21,6 +21,7 @@
 #include <limits>
 #include <map>
 #include <raft/cuda_utils.cuh>
+#include <raft/handle.hpp>
 
 #define INST_BLOCK_SORT(keyIn, keyOut, valueInOut, rows, columns, blockSize, elemPT, stream)     \
   devKeyValSortColumnPerRow<InType, OutType, blockSize, elemPT><<<rows, blockSize, 0, stream>>>( \
@@ -341,6 +342,40 @@ void sortColumnsPerRow(const InType* in,
     }
   }
 }
+
+/**
+ * @brief handle-based variant of sortColumnsPerRow
+ * Temp storage is drawn from the handle's workspace arena instead of going
+ * through the two-call query/allocate protocol of the raw variant, so
+ * repeated sorts on a hot path reuse the same retained buffer. The path
+ * selection (block sort vs segmented radix sort by row length) is unchanged.
+ * @param handle: raft handle
+ * @param in: input matrix
+ * @param out: output value(index) matrix
+ * @param n_rows: number rows of input matrix
+ * @param n_columns: number columns of input matrix
+ * @param sortedKeys: Optional, output matrix for sorted keys (input)
+ */
+template <typename InType, typename OutType>
+void sortColumnsPerRow(const raft::handle_t& handle,
+                       const InType* in,
+                       OutType* out,
+                       int n_rows,
+                       int n_columns,
+                       InType* sortedKeys = nullptr)
+{
+  auto stream          = handle.get_stream();
+  bool bAllocWorkspace = false;
+  size_t workspaceSize = 0;
+  // either sorts directly (block-sort path) or reports the workspace size
+  sortColumnsPerRow(
+    in, out, n_rows, n_columns, bAllocWorkspace, nullptr, workspaceSize, stream, sortedKeys);
+  if (bAllocWorkspace) {
+    raft::workspace_chunk ws(handle.get_workspace_arena(), workspaceSize, stream);
+    sortColumnsPerRow(
+      in, out, n_rows, n_columns, bAllocWorkspace, ws.data(), workspaceSize, stream, sortedKeys);
+  }
+}
 };  // end namespace detail
 };  // end namespace matrix
 };  // end namespace raft
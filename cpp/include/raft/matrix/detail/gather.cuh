@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <raft/cuda_utils.cuh>
+#include <raft/cudart_utils.h>
+#include <raft/vectorized.cuh>
+
+namespace raft {
+namespace matrix {
+namespace detail {
+
+template <typename InType,
+          typename OutType,
+          typename MapT,
+          typename TransformOp,
+          int VecLen,
+          typename IdxType>
+__global__ void gatherRowsKernel(OutType* out,
+                                 const InType* in,
+                                 IdxType n_cols,
+                                 const MapT* map,
+                                 IdxType map_len,
+                                 TransformOp op)
+{
+  typedef TxN_t<InType, VecLen> InVecType;
+  typedef TxN_t<OutType, VecLen> OutVecType;
+  InVecType a;
+  OutVecType b;
+  IdxType idx = threadIdx.x + ((IdxType)blockIdx.x * blockDim.x);
+  idx *= InVecType::Ratio;
+  if (idx >= map_len * n_cols) return;
+  IdxType row    = idx / n_cols;
+  IdxType col    = idx % n_cols;
+  IdxType in_row = (IdxType)map[row];
+  a.load(in, in_row * n_cols + col);
+#pragma unroll
+  for (int i = 0; i < InVecType::Ratio; ++i) {
+    b.val.data[i] = op(a.val.data[i]);
+  }
+  b.store(out, idx);
+}
+
+template <typename InType,
+          typename OutType,
+          typename MapT,
+          typename TransformOp,
+          int VecLen,
+          typename IdxType,
+          int TPB>
+void gatherRowsImpl(OutType* out,
+                    const InType* in,
+                    IdxType n_cols,
+                    const MapT* map,
+                    IdxType map_len,
+                    TransformOp op,
+                    cudaStream_t stream)
+{
+  const IdxType len   = map_len * n_cols;
+  const IdxType nblks = raft::ceildiv(VecLen ? len / VecLen : len, (IdxType)TPB);
+  gatherRowsKernel<InType, OutType, MapT, TransformOp, VecLen, IdxType>
+    <<<nblks, TPB, 0, stream>>>(out, in, n_cols, map, map_len, op);
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
+}
+
+/**
+ * @brief Gather rows of a row-major matrix, applying a transform in registers.
+ *
+ * On exit out[i * n_cols + k] = op(in[map[i] * n_cols + k]),
+ * where i = 0..map_len-1 and k = 0..n_cols-1. The transform may change the
+ * element type (e.g. widen fp16 corpus rows to fp32), scale, or normalize;
+ * it is applied between the vectorized load and store, so no second pass
+ * over the gathered data is needed.
+ *
+ * The vectorization width is picked from the alignment of both matrices and
+ * the row byte length; every row start must share the base alignment, which
+ * holds whenever the row byte length is a multiple of the vector size.
+ */
+template <typename InType,
+          typename OutType,
+          typename MapT,
+          typename TransformOp,
+          typename IdxType = int,
+          int TPB          = 256>
+void gatherRows(OutType* out,
+                const InType* in,
+                IdxType n_cols,
+                const MapT* map,
+                IdxType map_len,
+                TransformOp op,
+                cudaStream_t stream)
+{
+  if (map_len <= 0 || n_cols <= 0) return;  // silently skip in case of 0 length input
+  constexpr auto maxSize = sizeof(InType) >= sizeof(OutType) ? sizeof(InType) : sizeof(OutType);
+  size_t rowBytes        = n_cols * maxSize;
+  uint64_t inAddr        = uint64_t(in);
+  uint64_t outAddr       = uint64_t(out);
+  if (16 / maxSize && rowBytes % 16 == 0 && inAddr % 16 == 0 && outAddr % 16 == 0) {
+    gatherRowsImpl<InType, OutType, MapT, TransformOp, 16 / maxSize, IdxType, TPB>(
+      out, in, n_cols, map, map_len, op, stream);
+  } else if (8 / maxSize && rowBytes % 8 == 0 && inAddr % 8 == 0 && outAddr % 8 == 0) {
+    gatherRowsImpl<InType, OutType, MapT, TransformOp, 8 / maxSize, IdxType, TPB>(
+      out, in, n_cols, map, map_len, op, stream);
+  } else if (4 / maxSize && rowBytes % 4 == 0 && inAddr % 4 == 0 && outAddr % 4 == 0) {
+    gatherRowsImpl<InType, OutType, MapT, TransformOp, 4 / maxSize, IdxType, TPB>(
+      out, in, n_cols, map, map_len, op, stream);
+  } else if (2 / maxSize && rowBytes % 2 == 0 && inAddr % 2 == 0 && outAddr % 2 == 0) {
+    gatherRowsImpl<InType, OutType, MapT, TransformOp, 2 / maxSize, IdxType, TPB>(
+      out, in, n_cols, map, map_len, op, stream);
+  } else if (1 / maxSize) {
+    gatherRowsImpl<InType, OutType, MapT, TransformOp, 1 / maxSize, IdxType, TPB>(
+      out, in, n_cols, map, map_len, op, stream);
+  } else {
+    gatherRowsImpl<InType, OutType, MapT, TransformOp, 1, IdxType, TPB>(
+      out, in, n_cols, map, map_len, op, stream);
+  }
+}
+
+}  // end namespace detail
+}  // end namespace matrix
+}  // end namespace raft
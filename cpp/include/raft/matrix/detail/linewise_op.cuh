@@ -20,7 +20,11 @@
 #include <raft/pow2_utils.cuh>
 #include <raft/vectorized.cuh>
 
+#include <thrust/tuple.h>
+
 #include <algorithm>
+#include <tuple>
+#include <utility>
 
 namespace raft {
 namespace matrix {
@@ -543,6 +547,87 @@ struct MatrixLinewiseOp {
   }
 };
 
+/**
+ * One stage of a linewise chain: an operation bundled with the vectors it
+ * consumes. The vectors are only stored here on the host side; at launch time
+ * all stages' vectors are flattened into the single variadic pack of the
+ * linewise kernels.
+ */
+template <typename Lambda, typename... Vecs>
+struct linewise_stage {
+  static constexpr std::size_t n_args = sizeof...(Vecs);
+  using op_t                          = Lambda;
+  Lambda op;
+  std::tuple<Vecs...> vecs;
+};
+
+/**
+ * The composition of several linewise stages into a single operation. The
+ * kernels hand every thread one matrix element plus one scalar per argument
+ * vector; this functor slices that flat scalar pack back into per-stage
+ * argument lists (each stage's arity is known at compile time) and applies the
+ * stages in order. Only the lambdas are stored, so the functor stays trivially
+ * device-copyable.
+ */
+template <typename Type, typename OpsTuple, std::size_t... Arity>
+struct LinewiseChainOp {
+  static constexpr std::size_t NStages    = sizeof...(Arity);
+  static constexpr std::size_t arityOf[]  = {Arity...};
+
+  OpsTuple ops;
+
+  template <typename L, std::size_t... Is>
+  static __device__ __forceinline__ Type callStage(const L& f,
+                                                   Type v,
+                                                   const Type* args,
+                                                   std::index_sequence<Is...>) noexcept
+  {
+    return f(v, args[Is]...);
+  }
+
+  template <std::size_t I, std::size_t Offset>
+  __device__ __forceinline__ Type apply(Type v, const Type* args) const noexcept
+  {
+    if constexpr (I == NStages) {
+      return v;
+    } else {
+      constexpr std::size_t a = arityOf[I];
+      Type r = callStage(thrust::get<I>(ops), v, args + Offset, std::make_index_sequence<a>{});
+      return apply<I + 1, Offset + a>(r, args);
+    }
+  }
+
+  template <typename... Args>
+  __device__ __forceinline__ Type operator()(Type v, Args... argsIn) const noexcept
+  {
+    Type args[sizeof...(Args) + 1] = {argsIn...};
+    return apply<0, 0>(v, args);
+  }
+};
+
+/**
+ * Compose several linewise stages into one operation and run it in a single
+ * pass over the matrix, preserving the vectorized load structure of the
+ * underlying kernels.
+ */
+template <typename Type, typename IdxType, typename... Stages>
+void matrixLinewiseOpChain(Type* out,
+                           const Type* in,
+                           const IdxType lineLen,
+                           const IdxType nLines,
+                           const bool alongLines,
+                           cudaStream_t stream,
+                           Stages... stages)
+{
+  LinewiseChainOp<Type, thrust::tuple<typename Stages::op_t...>, Stages::n_args...> chain{
+    thrust::make_tuple(stages.op...)};
+  std::apply(
+    [&](auto... vecs) {
+      MatrixLinewiseOp<16, 256>::run(out, in, lineLen, nLines, alongLines, chain, stream, vecs...);
+    },
+    std::tuple_cat(stages.vecs...));
+}
+
 }  // end namespace detail
 }  // end namespace matrix
 }  // end namespace raft
@@ -18,6 +18,7 @@
 
 #include <raft/cache/cache_util.cuh>
 #include <raft/cuda_utils.cuh>
+#include <raft/integer_utils.h>
 
 #include <rmm/exec_policy.hpp>
 
@@ -57,9 +58,10 @@ void copyRows(const m_t* in,
   idx_t size    = n_rows_indices * n_cols;
   auto counting = thrust::make_counting_iterator<idx_t>(0);
 
+  raft::fast_div_mod rowsDiv(uint32_t(n_rows_indices));
   thrust::for_each(rmm::exec_policy(stream), counting, counting + size, [=] __device__(idx_t idx) {
-    idx_t row = idx % n_rows_indices;
-    idx_t col = idx / n_rows_indices;
+    idx_t row, col;
+    rowsDiv.divmod(idx, col, row);
 
     out[col * n_rows_indices + row] = in[col * n_rows + indices[row]];
   });
@@ -76,9 +78,10 @@ void truncZeroOrigin(
   auto d_q_trunc = out;
   auto counting  = thrust::make_counting_iterator<idx_t>(0);
 
+  raft::fast_div_mod rowsDiv(uint32_t(m));
   thrust::for_each(rmm::exec_policy(stream), counting, counting + size, [=] __device__(idx_t idx) {
-    idx_t row                = idx % m;
-    idx_t col                = idx / m;
+    idx_t row, col;
+    rowsDiv.divmod(idx, col, row);
     d_q_trunc[col * m + row] = d_q[col * k + row];
   });
 }
@@ -93,10 +96,11 @@ void colReverse(m_t* inout, idx_t n_rows, idx_t n_cols, cudaStream_t stream)
   auto d_q_reversed = inout;
   auto counting     = thrust::make_counting_iterator<idx_t>(0);
 
+  raft::fast_div_mod rowsDiv(uint32_t(m));
   thrust::for_each(
     rmm::exec_policy(stream), counting, counting + (size / 2), [=] __device__(idx_t idx) {
-      idx_t dest_row             = idx % m;
-      idx_t dest_col             = idx / m;
+      idx_t dest_row, dest_col;
+      rowsDiv.divmod(idx, dest_col, dest_row);
       idx_t src_row              = dest_row;
       idx_t src_col              = (n - dest_col) - 1;
       m_t temp                   = (m_t)d_q_reversed[idx];
@@ -114,10 +118,11 @@ void rowReverse(m_t* inout, idx_t n_rows, idx_t n_cols, cudaStream_t stream)
   auto d_q_reversed = inout;
   auto counting     = thrust::make_counting_iterator<idx_t>(0);
 
+  raft::fast_div_mod rowsDiv(uint32_t(m));
   thrust::for_each(
     rmm::exec_policy(stream), counting, counting + (size / 2), [=] __device__(idx_t idx) {
-      idx_t dest_row = idx % m;
-      idx_t dest_col = idx / m;
+      idx_t dest_row, dest_col;
+      rowsDiv.divmod(idx, dest_col, dest_row);
       idx_t src_row  = (m - dest_row) - 1;
       ;
       idx_t src_col = dest_col;
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/spatial/knn/detail/selection_faiss.cuh>
+#include <raft/spatial/knn/detail/topk/radix_topk.cuh>
+#include <raft/spatial/knn/detail/topk/warpsort_topk.cuh>
+
+#include <rmm/cuda_stream_view.hpp>
+
+namespace raft {
+namespace matrix {
+namespace detail {
+
+/**
+ * @brief Choose and run the fastest selection algorithm for the problem shape.
+ *
+ * The heuristic is derived from the measurements behind
+ * `cpp/test/spatial/selection.cu` and the knn benchmarks:
+ *
+ *  - warpsort keeps everything in registers and wins whenever k fits its
+ *    capacity (k <= 256) and there is enough parallelism per row;
+ *  - the radix top-k does a constant number of passes over the input and
+ *    takes over for long rows with larger k, where the filtering variants
+ *    of warpsort start to thrash;
+ *  - the faiss block-select remains the fallback for tiny batches with
+ *    short rows where kernel launch configuration dominates.
+ */
+template <typename T, typename IdxT>
+void select_k(const T* in,
+              const IdxT* in_idx,
+              size_t batch_size,
+              size_t len,
+              int k,
+              T* out,
+              IdxT* out_idx,
+              bool select_min,
+              rmm::cuda_stream_view stream)
+{
+  constexpr int kWarpsortMaxK = raft::spatial::knn::detail::topk::kMaxCapacity;
+  constexpr int kFaissK       = raft::spatial::knn::detail::kFaissMaxK<IdxT, T>();
+  if (batch_size <= 16 && len <= 4096 && k <= kFaissK) {
+    raft::spatial::knn::detail::select_k<IdxT, T>(
+      in, in_idx, batch_size, len, out, out_idx, select_min, k, stream);
+  } else if (k <= kWarpsortMaxK && (len <= (size_t{1} << 16) || k <= 64)) {
+    raft::spatial::knn::detail::topk::warp_sort_topk<T, IdxT>(
+      in, in_idx, batch_size, len, k, out, out_idx, select_min, stream);
+  } else if (k <= 512) {
+    raft::spatial::knn::detail::topk::radix_topk<T, IdxT, 11, 512>(
+      in, in_idx, batch_size, len, k, out, out_idx, select_min, stream);
+  } else {
+    raft::spatial::knn::detail::topk::radix_topk<T, IdxT, 8, 512>(
+      in, in_idx, batch_size, len, k, out, out_idx, select_min, stream);
+  }
+}
+
+}  // namespace detail
+}  // namespace matrix
+}  // namespace raft
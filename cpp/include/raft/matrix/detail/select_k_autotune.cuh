@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/cudart_utils.h>
+#include <raft/matrix/detail/select_k.cuh>
+#include <raft/pow2_utils.cuh>
+
+#include <rmm/cuda_stream_view.hpp>
+
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+namespace raft {
+namespace matrix {
+namespace detail {
+
+/** The selection algorithms that the auto-tuner chooses between. */
+enum class select_k_algo : int {
+  FAISS_BLOCK_SELECT = 0,
+  WARP_SORT          = 1,
+  RADIX_11_BITS      = 2,
+  RADIX_8_BITS       = 3,
+};
+
+/**
+ * Winner table for select_k, keyed by rounded problem-shape classes.
+ *
+ * The crossover points between the selection algorithms vary between GPUs, so
+ * a static heuristic tuned on one arch can be several times off on another.
+ * The tuner measures all applicable algorithms once per
+ * (device, batch, len, k) size class — with batch/len/k rounded to powers of
+ * two so the table stays small — and dispatches from the winner table
+ * thereafter. The table can be persisted to a user-provided file and
+ * re-loaded on startup, so the measurement cost is paid once per fleet node
+ * rather than once per process.
+ *
+ * The table only stores algorithm ids, not timings, and is shared by all
+ * key/index type instantiations: the relative ranking is dominated by the
+ * problem shape.
+ */
+class select_k_tuner {
+ public:
+  /** Key of a winner-table entry. */
+  struct shape_class {
+    int device;
+    size_t batch;
+    size_t len;
+    int k;
+
+    auto operator<(const shape_class& other) const -> bool
+    {
+      return std::tie(device, batch, len, k) <
+             std::tie(other.device, other.batch, other.len, other.k);
+    }
+  };
+
+  static auto instance() -> select_k_tuner&
+  {
+    static select_k_tuner tuner;
+    return tuner;
+  }
+
+  /**
+   * Round a problem shape to its size class: powers of two for batch and
+   * len, the warpsort capacity rounding for k.
+   */
+  static auto classify(size_t batch, size_t len, int k) -> shape_class
+  {
+    int device = 0;
+    RAFT_CUDA_TRY(cudaGetDevice(&device));
+    auto round_pow2 = [](size_t x) -> size_t {
+      size_t r = 1;
+      while (r < x) {
+        r <<= 1;
+      }
+      return r;
+    };
+    return shape_class{device, round_pow2(batch), round_pow2(len), int(round_pow2(size_t(k)))};
+  }
+
+  /** Look up a previously measured (or loaded) winner; false when unknown. */
+  auto lookup(const shape_class& cls, select_k_algo* algo) -> bool
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto found = table_.find(cls);
+    if (found == table_.end()) { return false; }
+    *algo = found->second;
+    return true;
+  }
+
+  /** Record a measured winner and append it to the cache file, if set. */
+  void record(const shape_class& cls, select_k_algo algo)
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto inserted = table_.emplace(cls, algo).second;
+    if (inserted && !cache_file_.empty()) {
+      std::ofstream of(cache_file_, std::ios::app);
+      if (of) {
+        of << cls.device << ' ' << cls.batch << ' ' << cls.len << ' ' << cls.k << ' '
+           << int(algo) << '\n';
+      }
+    }
+  }
+
+  /**
+   * Set the file used to persist the winner table, loading any entries it
+   * already contains. Unparseable lines are skipped, so a stale or truncated
+   * cache degrades to re-measuring, never to a failure.
+   */
+  void set_cache_file(const std::string& path)
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    cache_file_ = path;
+    std::ifstream in(path);
+    shape_class cls;
+    int algo;
+    while (in >> cls.device >> cls.batch >> cls.len >> cls.k >> algo) {
+      if (algo >= 0 && algo <= int(select_k_algo::RADIX_8_BITS)) {
+        table_.emplace(cls, select_k_algo(algo));
+      }
+    }
+  }
+
+ private:
+  select_k_tuner() = default;
+
+  std::mutex mutex_;
+  std::map<shape_class, select_k_algo> table_;
+  std::string cache_file_;
+};
+
+/** Run one selection algorithm on the given problem. */
+template <typename T, typename IdxT>
+void select_k_run_algo(select_k_algo algo,
+                       const T* in,
+                       const IdxT* in_idx,
+                       size_t batch_size,
+                       size_t len,
+                       int k,
+                       T* out,
+                       IdxT* out_idx,
+                       bool select_min,
+                       rmm::cuda_stream_view stream)
+{
+  switch (algo) {
+    case select_k_algo::FAISS_BLOCK_SELECT:
+      raft::spatial::knn::detail::select_k<IdxT, T>(
+        in, in_idx, batch_size, len, out, out_idx, select_min, k, stream);
+      break;
+    case select_k_algo::WARP_SORT:
+      raft::spatial::knn::detail::topk::warp_sort_topk<T, IdxT>(
+        in, in_idx, batch_size, len, k, out, out_idx, select_min, stream);
+      break;
+    case select_k_algo::RADIX_11_BITS:
+      raft::spatial::knn::detail::topk::radix_topk<T, IdxT, 11, 512>(
+        in, in_idx, batch_size, len, k, out, out_idx, select_min, stream);
+      break;
+    case select_k_algo::RADIX_8_BITS:
+      raft::spatial::knn::detail::topk::radix_topk<T, IdxT, 8, 512>(
+        in, in_idx, batch_size, len, k, out, out_idx, select_min, stream);
+      break;
+  }
+}
+
+/** Whether the algorithm supports the given k for these types. */
+template <typename T, typename IdxT>
+auto select_k_algo_applicable(select_k_algo algo, int k) -> bool
+{
+  switch (algo) {
+    case select_k_algo::FAISS_BLOCK_SELECT:
+      return k <= raft::spatial::knn::detail::kFaissMaxK<IdxT, T>();
+    case select_k_algo::WARP_SORT: return k <= raft::spatial::knn::detail::topk::kMaxCapacity;
+    case select_k_algo::RADIX_11_BITS: return true;
+    case select_k_algo::RADIX_8_BITS: return true;
+  }
+  return false;
+}
+
+/**
+ * @brief select_k with empirical per-device algorithm choice.
+ *
+ * On the first call for each (device, batch, len, k) size class, every
+ * applicable selection algorithm is executed and timed on the actual input
+ * (one warm-up plus one measured run each; the output buffers are simply
+ * overwritten, so the final result is still correct), and the winner is
+ * recorded. Subsequent calls for the same class dispatch straight to the
+ * recorded winner. See `select_k_tuner::set_cache_file` for persisting the
+ * table across processes.
+ *
+ * Parameters match `select_k` (cf. raft/matrix/detail/select_k.cuh).
+ */
+template <typename T, typename IdxT>
+void select_k_auto(const T* in,
+                   const IdxT* in_idx,
+                   size_t batch_size,
+                   size_t len,
+                   int k,
+                   T* out,
+                   IdxT* out_idx,
+                   bool select_min,
+                   rmm::cuda_stream_view stream)
+{
+  auto& tuner = select_k_tuner::instance();
+  auto cls    = select_k_tuner::classify(batch_size, len, k);
+
+  select_k_algo algo;
+  if (tuner.lookup(cls, &algo)) {
+    select_k_run_algo(algo, in, in_idx, batch_size, len, k, out, out_idx, select_min, stream);
+    return;
+  }
+
+  // first use for this class: measure all applicable algorithms in place
+  cudaEvent_t start, stop;
+  RAFT_CUDA_TRY(cudaEventCreate(&start));
+  RAFT_CUDA_TRY(cudaEventCreate(&stop));
+
+  float best_ms = 0;
+  bool has_best = false;
+  for (auto candidate : {select_k_algo::FAISS_BLOCK_SELECT,
+                         select_k_algo::WARP_SORT,
+                         select_k_algo::RADIX_11_BITS,
+                         select_k_algo::RADIX_8_BITS}) {
+    if (!select_k_algo_applicable<T, IdxT>(candidate, k)) { continue; }
+    // warm-up run absorbs one-time costs (module loading, caches)
+    select_k_run_algo(candidate, in, in_idx, batch_size, len, k, out, out_idx, select_min, stream);
+    RAFT_CUDA_TRY(cudaEventRecord(start, stream));
+    select_k_run_algo(candidate, in, in_idx, batch_size, len, k, out, out_idx, select_min, stream);
+    RAFT_CUDA_TRY(cudaEventRecord(stop, stream));
+    RAFT_CUDA_TRY(cudaEventSynchronize(stop));
+    float ms = 0;
+    RAFT_CUDA_TRY(cudaEventElapsedTime(&ms, start, stop));
+    if (!has_best || ms < best_ms) {
+      best_ms  = ms;
+      algo     = candidate;
+      has_best = true;
+    }
+  }
+  RAFT_CUDA_TRY(cudaEventDestroy(start));
+  RAFT_CUDA_TRY(cudaEventDestroy(stop));
+
+  tuner.record(cls, algo);
+  // the winner already produced the final output only if it ran last; run it
+  // once more to leave the buffers in a deterministic state
+  select_k_run_algo(algo, in, in_idx, batch_size, len, k, out, out_idx, select_min, stream);
+}
+
+}  // namespace detail
+}  // namespace matrix
+}  // namespace raft
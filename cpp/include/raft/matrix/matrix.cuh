@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "detail/gather.cuh"
 #include "detail/linewise_op.cuh"
 #include "detail/matrix.cuh"
 
@@ -57,6 +58,64 @@ void copyRows(const m_t* in,
   detail::copyRows(in, n_rows, n_cols, out, indices, n_rows_indices, stream, rowMajor);
 }
 
+/**
+ * @brief Gather rows of a row-major matrix, applying a transform in registers.
+ *
+ * On exit out[i * n_cols + k] = transform_op(in[map[i] * n_cols + k]),
+ * where i = 0..map_len-1 and k = 0..n_cols-1. The transform may change the
+ * element type (e.g. widen fp16 corpus rows to fp32), scale, or normalize,
+ * so gather and conversion run in one pass over the data. Loads and stores
+ * are vectorized when alignment permits.
+ *
+ * @param out output matrix, row major, size [map_len, n_cols]
+ * @param in input matrix, row major
+ * @param n_cols number of columns of both matrices
+ * @param map indices of the rows to be gathered
+ * @param map_len number of rows to gather
+ * @param transform_op device functor applied to each gathered element
+ * @param stream cuda stream
+ */
+template <typename InType,
+          typename OutType,
+          typename MapT,
+          typename TransformOp,
+          typename idx_t = int>
+void gatherRows(OutType* out,
+                const InType* in,
+                idx_t n_cols,
+                const MapT* map,
+                idx_t map_len,
+                TransformOp transform_op,
+                cudaStream_t stream)
+{
+  detail::gatherRows(out, in, n_cols, map, map_len, transform_op, stream);
+}
+
+/**
+ * @brief Gather rows of a row-major matrix, converting the element type.
+ *
+ * Shorthand for gatherRows with a static_cast transform; useful for
+ * widening a compact corpus (e.g. fp16) into the working dtype during
+ * minibatch assembly without a second pass.
+ */
+template <typename InType, typename OutType, typename MapT, typename idx_t = int>
+void gatherRows(OutType* out,
+                const InType* in,
+                idx_t n_cols,
+                const MapT* map,
+                idx_t map_len,
+                cudaStream_t stream)
+{
+  detail::gatherRows(
+    out,
+    in,
+    n_cols,
+    map,
+    map_len,
+    [] __device__(InType v) { return static_cast<OutType>(v); },
+    stream);
+}
+
 /**
  * @brief copy matrix operation for column major matrices.
  * @param in: input matrix
@@ -272,6 +331,58 @@ void linewiseOp(m_t* out,
     out, in, lineLen, nLines, alongLines, op, stream, vecs...);
 }
 
+/**
+ * Bundles one linewise operation with the vectors it consumes, for use with
+ * `linewiseOpChain`.
+ *
+ * @param [in] op the operation applied on each line, same form as in
+ *    `linewiseOp`; it receives one matrix element and one element of each of
+ *    this stage's vectors.
+ * @param [in] vecs zero or more vectors consumed by this stage.
+ */
+template <typename Lambda, typename... Vecs>
+auto makeLinewiseStage(Lambda op, Vecs... vecs)
+{
+  return detail::linewise_stage<Lambda, Vecs...>{op, std::make_tuple(vecs...)};
+}
+
+/**
+ * Run a chain of linewise operations in a single pass over the matrix.
+ * Each stage is an independent (op, vectors) bundle created with
+ * `makeLinewiseStage`; the stages are applied in order to every element, as if
+ * `linewiseOp` was called once per stage, but the matrix is read and written
+ * only once. This cuts the memory traffic of multi-step line transforms (e.g.
+ * subtract-mean, divide-by-std, clamp) by the number of stages.
+ *
+ * @param [out] out result of the operation; can be same as `in`; should be aligned the same
+ *        as `in` to allow faster vectorized memory transfers.
+ * @param [in] in input matrix consisting of `nLines` lines, each `lineLen`-long.
+ * @param [in] lineLen length of matrix line in elements (`=nCols` in row-major or `=nRows` in
+ * col-major)
+ * @param [in] nLines number of matrix lines (`=nRows` in row-major or `=nCols` in col-major)
+ * @param [in] alongLines whether vectors are indices along or across lines.
+ * @param [in] stream a cuda stream for the kernels
+ * @param [in] stages one or more bundles created with `makeLinewiseStage`,
+ *    applied in order; the size of each stage's vectors is
+ *    `alongLines ? lineLen : nLines`.
+ */
+template <typename m_t, typename idx_t = int, typename... Stages>
+void linewiseOpChain(m_t* out,
+                     const m_t* in,
+                     const idx_t lineLen,
+                     const idx_t nLines,
+                     const bool alongLines,
+                     cudaStream_t stream,
+                     Stages... stages)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope("linewiseOpChain-%c-%zu (%zu, %zu)",
+                                                            alongLines ? 'l' : 'x',
+                                                            sizeof...(Stages),
+                                                            size_t(lineLen),
+                                                            size_t(nLines));
+  detail::matrixLinewiseOpChain<m_t, idx_t>(out, in, lineLen, nLines, alongLines, stream, stages...);
+}
+
 };  // end namespace matrix
 };  // end namespace raft
 
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __SELECT_K_H
+#define __SELECT_K_H
+
+#pragma once
+
+#include <raft/matrix/detail/select_k.cuh>
+#include <raft/matrix/detail/select_k_autotune.cuh>
+
+namespace raft {
+namespace matrix {
+
+/**
+ * @brief Select the k smallest or largest key/value pairs from each row of
+ *        the input matrix.
+ *
+ * If you think of the input `in` as a row-major matrix with `len` columns
+ * and `batch_size` rows, this selects the k smallest/largest values in each
+ * row and writes them into the row-major `out` matrix of size
+ * (batch_size, k). The implementation (radix top-k, warpsort top-k or the
+ * faiss block-select) is chosen automatically from (batch_size, len, k)
+ * using measured heuristics; the values within an output row are not
+ * guaranteed to be sorted.
+ *
+ * @tparam T
+ *   the type of the keys (what is being compared).
+ * @tparam IdxT
+ *   the payload type (what is being selected together with the keys).
+ *
+ * @param[in] in
+ *   contiguous device array of inputs of size (len * batch_size);
+ *   these are compared and selected.
+ * @param[in] in_idx
+ *   contiguous device array of inputs of size (len * batch_size);
+ *   typically, these are indices of the corresponding elements in `in`.
+ *   Pass `nullptr` to use the implicit indices `0 .. len-1` for every row.
+ * @param[in] batch_size
+ *   number of input rows.
+ * @param[in] len
+ *   length of a single input row.
+ *   Invariant: len >= k.
+ * @param[in] k
+ *   the number of outputs to select in each input row.
+ * @param[out] out
+ *   contiguous device array of outputs of size (k * batch_size);
+ *   the k smallest/largest values from each row of `in`.
+ * @param[out] out_idx
+ *   contiguous device array of outputs of size (k * batch_size);
+ *   the payload selected together with `out`.
+ * @param[in] select_min
+ *   whether to select k smallest (true) or largest (false) keys.
+ * @param[in] stream
+ */
+template <typename T, typename IdxT>
+void select_k(const T* in,
+              const IdxT* in_idx,
+              size_t batch_size,
+              size_t len,
+              int k,
+              T* out,
+              IdxT* out_idx,
+              bool select_min,
+              rmm::cuda_stream_view stream)
+{
+  ASSERT(len >= size_t(k),
+         "Size of the input (len = %zu) must be not smaller than the selection (k = %d).",
+         len,
+         k);
+  detail::select_k<T, IdxT>(in, in_idx, batch_size, len, k, out, out_idx, select_min, stream);
+}
+
+/**
+ * @brief `select_k` with empirically measured per-device algorithm choice.
+ *
+ * The crossover points between the selection algorithms differ between GPU
+ * architectures, so the static heuristic in `select_k` can be far from
+ * optimal on some devices. This variant benchmarks all applicable algorithms
+ * on the first call for each (device, batch, len, k) size class (the output
+ * of that call is still correct — the candidates simply overwrite the same
+ * output buffers) and dispatches from the recorded winner thereafter.
+ *
+ * Use `select_k_set_tuning_cache` to persist the winner table to a file and
+ * avoid re-measuring in every process.
+ *
+ * Parameters are the same as for `select_k`.
+ */
+template <typename T, typename IdxT>
+void select_k_auto(const T* in,
+                   const IdxT* in_idx,
+                   size_t batch_size,
+                   size_t len,
+                   int k,
+                   T* out,
+                   IdxT* out_idx,
+                   bool select_min,
+                   rmm::cuda_stream_view stream)
+{
+  ASSERT(len >= size_t(k),
+         "Size of the input (len = %zu) must be not smaller than the selection (k = %d).",
+         len,
+         k);
+  detail::select_k_auto<T, IdxT>(in, in_idx, batch_size, len, k, out, out_idx, select_min, stream);
+}
+
+/**
+ * @brief Persist the `select_k_auto` winner table to the given file.
+ *
+ * Any entries the file already contains are loaded immediately; winners
+ * measured later in this process are appended to it. The file is plain text
+ * and can be shared between nodes with identical GPUs.
+ *
+ * @param[in] path the tuning-cache file; created on first write if missing.
+ */
+inline void select_k_set_tuning_cache(const std::string& path)
+{
+  detail::select_k_tuner::instance().set_cache_file(path);
+}
+
+}  // namespace matrix
+}  // namespace raft
+
+#endif
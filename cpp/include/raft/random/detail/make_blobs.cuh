@@ -23,6 +23,8 @@
 #include <raft/random/rng.cuh>
 #include <raft/random/rng_device.cuh>
 #include <rmm/device_uvector.hpp>
+
+#include <algorithm>
 #include <vector>
 
 namespace raft {
@@ -156,12 +158,19 @@ void generate_data(DataT* out,
                    const DataT cluster_std_scalar,
                    raft::random::RngState& rng_state)
 {
-  IdxT items   = n_rows * n_cols;
-  IdxT nBlocks = (items + 127) / 128;
+  IdxT items          = n_rows * n_cols;
+  const int nThreads  = 256;
+  // Keep the grid small enough that every thread generates many values: the
+  // generator state setup is paid once per thread, so a one-item-per-thread
+  // launch leaves the kernel latency-bound instead of bandwidth-bound. Each
+  // thread produces two values per grid-stride iteration (box-muller pair).
+  uint64_t maxBlocks  = uint64_t(4 * getMultiProcessorCount());
+  uint64_t workBlocks = raft::ceildiv<uint64_t>(uint64_t(items), 2 * nThreads);
+  IdxT nBlocks        = IdxT(std::min(maxBlocks, std::max<uint64_t>(workBlocks, 1)));
   // parentheses needed here for kernel, otherwise macro interprets the arguments
   // of triple chevron notation as macro arguments
   RAFT_CALL_RNG_FUNC(rng_state,
-                     (generate_data_kernel<<<nBlocks, 128, 0, stream>>>),
+                     (generate_data_kernel<<<nBlocks, nThreads, 0, stream>>>),
                      out,
                      labels,
                      n_rows,
@@ -171,6 +180,7 @@ void generate_data(DataT* out,
                      centers,
                      cluster_std,
                      cluster_std_scalar);
+  rng_state.advance(uint64_t(nBlocks) * nThreads, 16);
 }
 
 /**
@@ -24,7 +24,9 @@
 #include <raft/linalg/detail/cusolver_wrappers.hpp>
 #include <raft/linalg/matrix_vector_op.cuh>
 #include <raft/linalg/unary_op.cuh>
+#include <rmm/device_uvector.hpp>
 #include <stdio.h>
+#include <vector>
 
 // mvg.cuh takes in matrices that are colomn major (as in fortan)
 #define IDX2C(i, j, ld) (j * ld + i)
@@ -286,5 +288,174 @@ class multi_variable_gaussian_impl {
   ~multi_variable_gaussian_impl() { deinit(); }
 };  // end of multi_variable_gaussian_impl
 
+// batched version of fill_uplo; treats A as 'batchSize' consecutive
+// dim x dim column-major matrices
+template <typename T>
+__global__ void fill_uplo_batched(int dim, int batchSize, Filler uplo, T value, T* A)
+{
+  int idx = threadIdx.x + blockDim.x * blockIdx.x;
+  if (idx < dim * dim * batchSize) {
+    int m_i = idx % (dim * dim);
+    int j   = m_i / dim;
+    int i   = m_i % dim;
+    // making off-diagonals == value
+    if (i < j) {
+      if (uplo == 1) A[idx] = value;
+    } else if (i > j) {
+      if (uplo == 0) A[idx] = value;
+    }
+  }
+}
+
+// adds the per-distribution mean vector onto the samples; X holds 'batchSize'
+// consecutive dim x nPoints column-major blocks, x is dim x batchSize
+template <typename T>
+__global__ void add_mean_batched(int dim, int nPoints, int batchSize, const T* x, T* X)
+{
+  int idx = threadIdx.x + blockDim.x * blockIdx.x;
+  if (idx < dim * nPoints * batchSize) {
+    int b  = idx / (dim * nPoints);
+    int row = idx % dim;
+    X[idx] += x[b * dim + row];
+  }
+}
+
+/**
+ * Batched counterpart of multi_variable_gaussian_impl for drawing from many
+ * independent small Gaussians at once.
+ *
+ * The Cholesky factors of all covariances are computed in a single
+ * potrfBatched call and cached inside the object, so repeated draws against
+ * unchanged covariances (`give_gaussian`) only pay for one fused curand
+ * generation and one strided-batched gemm, instead of a potrf + gemm launch
+ * pair per distribution.
+ */
+template <typename T>
+class multi_variable_gaussian_batched_impl {
+ private:
+  const raft::handle_t& handle;
+  const int dim;
+  const int batchSize;
+  cublasFillMode_t uplo = CUBLAS_FILL_MODE_LOWER;
+  curandGenerator_t gen;
+
+  rmm::device_uvector<T> chol;       // cached cholesky factors, dim x dim x batchSize
+  rmm::device_uvector<T*> cholPtrs;  // pointer array as expected by potrfBatched
+  rmm::device_uvector<T> eps;        // scratch for the standard normal draws
+  rmm::device_uvector<int> info;
+  std::vector<int> info_h;
+  bool decomposed   = false;
+  bool deinitilized = false;
+
+ public:
+  multi_variable_gaussian_batched_impl() = delete;
+  multi_variable_gaussian_batched_impl(const raft::handle_t& handle,
+                                       const int dim,
+                                       const int batchSize)
+    : handle(handle),
+      dim(dim),
+      batchSize(batchSize),
+      chol(std::size_t(dim) * dim * batchSize, handle.get_stream()),
+      cholPtrs(batchSize, handle.get_stream()),
+      eps(0, handle.get_stream()),
+      info(batchSize, handle.get_stream()),
+      info_h(batchSize)
+  {
+    CURAND_CHECK(curandCreateGenerator(&gen, CURAND_RNG_PSEUDO_DEFAULT));
+    CURAND_CHECK(curandSetPseudoRandomGeneratorSeed(gen, 28));  // SEED
+    std::vector<T*> cholPtrs_h(batchSize);
+    for (int b = 0; b < batchSize; b++) {
+      cholPtrs_h[b] = chol.data() + std::size_t(b) * dim * dim;
+    }
+    raft::update_device(cholPtrs.data(), cholPtrs_h.data(), batchSize, handle.get_stream());
+  }
+
+  /**
+   * Decompose and cache the given covariances; P holds 'batchSize'
+   * consecutive dim x dim column-major SPD matrices and is left untouched.
+   * Needs to be called again only when the covariances change.
+   */
+  void set_covariance(const T* P)
+  {
+    auto cudaStream = handle.get_stream();
+    raft::copy(chol.data(), P, chol.size(), cudaStream);
+    // lower parts will contain the chol_decomp factors
+    RAFT_CUSOLVER_TRY(
+      raft::linalg::detail::cusolverDnpotrfBatched(handle.get_cusolver_dn_handle(),
+                                                   uplo,
+                                                   dim,
+                                                   cholPtrs.data(),
+                                                   dim,
+                                                   info.data(),
+                                                   batchSize,
+                                                   cudaStream));
+    raft::update_host(info_h.data(), info.data(), batchSize, cudaStream);
+    RAFT_CUDA_TRY(cudaStreamSynchronize(cudaStream));
+    for (int b = 0; b < batchSize; b++) {
+      ASSERT(info_h[b] == 0, "mvg: error in potrfBatched, matrix %d info=%d | expected=0", b, info_h[b]);
+    }
+    // upper parts being filled with 0.0 so the sampling gemm only sees the
+    // triangular factors
+    dim3 block(64);
+    dim3 grid(raft::ceildiv(dim * dim * batchSize, (int)block.x));
+    fill_uplo_batched<T><<<grid, block, 0, cudaStream>>>(dim, batchSize, UPPER, (T)0.0, chol.data());
+    RAFT_CUDA_TRY(cudaPeekAtLastError());
+    decomposed = true;
+  }
+
+  /**
+   * Draw nPoints samples from every cached distribution; X gets 'batchSize'
+   * consecutive dim x nPoints column-major blocks, x optionally holds the
+   * dim x batchSize means.
+   */
+  void give_gaussian(const int nPoints, T* X, const T* x = nullptr)
+  {
+    ASSERT(decomposed, "mvg: set_covariance() must be called before give_gaussian()");
+    auto cudaStream    = handle.get_stream();
+    std::size_t nRands = std::size_t(dim) * nPoints * batchSize;
+    // generate the standard normals for all distributions in one call
+    eps.resize(nRands + nRands % 2, cudaStream);
+    T mean = 0.0, stddv = 1.0;
+    CURAND_CHECK(detail::curandGenerateNormal(gen, eps.data(), nRands + nRands % 2, mean, stddv));
+    // X = chol * eps for all distributions at once
+    T alfa = 1.0, beta = 0.0;
+    RAFT_CUBLAS_TRY(raft::linalg::detail::cublasgemmStridedBatched(handle.get_cublas_handle(),
+                                                                   CUBLAS_OP_N,
+                                                                   CUBLAS_OP_N,
+                                                                   dim,
+                                                                   nPoints,
+                                                                   dim,
+                                                                   &alfa,
+                                                                   chol.data(),
+                                                                   dim,
+                                                                   int64_t(dim) * dim,
+                                                                   eps.data(),
+                                                                   dim,
+                                                                   int64_t(dim) * nPoints,
+                                                                   &beta,
+                                                                   X,
+                                                                   dim,
+                                                                   int64_t(dim) * nPoints,
+                                                                   batchSize,
+                                                                   cudaStream));
+    // working to make mean not 0
+    if (x != nullptr) {
+      dim3 block(64);
+      dim3 grid(raft::ceildiv(dim * nPoints * batchSize, (int)block.x));
+      add_mean_batched<T><<<grid, block, 0, cudaStream>>>(dim, nPoints, batchSize, x, X);
+      RAFT_CUDA_TRY(cudaPeekAtLastError());
+    }
+  }
+
+  void deinit()
+  {
+    if (deinitilized) return;
+    CURAND_CHECK(curandDestroyGenerator(gen));
+    deinitilized = true;
+  }
+
+  ~multi_variable_gaussian_batched_impl() { deinit(); }
+};  // end of multi_variable_gaussian_batched_impl
+
 };  // end of namespace detail
 };  // end of namespace raft::random
\ No newline at end of file
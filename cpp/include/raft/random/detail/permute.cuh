@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cooperative_groups.h>
 #include <memory>
 #include <raft/cuda_utils.cuh>
@@ -25,9 +26,70 @@
 namespace raft::random {
 namespace detail {
 
-template <typename Type, typename IntType, typename IdxType, int TPB, bool rowMajor>
-__global__ void permuteKernel(
-  IntType* perms, Type* out, const Type* in, IdxType a, IdxType b, IdxType N, IdxType D)
+/** Output index -> shuffled input index via the affine map (a * idx + b) mod N.
+ *  Cheap, but only reaches a tiny subset of all permutations. */
+template <typename IntType, typename IdxType>
+struct affine_map_t {
+  IdxType a, b, N;
+
+  DI IntType operator()(int tid) const { return IntType(((a * int64_t(tid)) + b) % N); }
+};
+
+/** murmur3 32-bit finalizer; used as the Feistel round function */
+DI uint32_t fmix32(uint32_t h)
+{
+  h ^= h >> 16;
+  h *= 0x85ebca6b;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35;
+  h ^= h >> 16;
+  return h;
+}
+
+/**
+ * Output index -> shuffled input index through a format-preserving balanced
+ * Feistel network.
+ *
+ * The cipher permutes the smallest even-bit-width domain covering N; indices
+ * that land outside [0, N) are walked through the cipher again until they
+ * fall inside (cycle walking), which keeps the map a bijection on [0, N).
+ * Since the domain is less than 4N, the expected number of walks is below 4.
+ * Everything happens in registers, so there is no scratch memory regardless
+ * of N, and the keyed rounds give statistically strong permutations, unlike
+ * `affine_map_t`.
+ */
+template <typename IntType>
+struct feistel_map_t {
+  static constexpr int kRounds = 4;
+  uint32_t keys[kRounds];
+  int halfBits;
+  uint64_t N;
+
+  DI IntType operator()(int tid) const
+  {
+    uint64_t x = uint64_t(tid);
+    // threads beyond N never have their result written; skip the walk for
+    // them as their orbit is not guaranteed to re-enter [0, N)
+    if (x >= N) { return IntType(0); }
+    const uint64_t mask = (uint64_t(1) << halfBits) - 1;
+    do {
+      uint64_t left  = x >> halfBits;
+      uint64_t right = x & mask;
+#pragma unroll
+      for (int r = 0; r < kRounds; r++) {
+        uint64_t f   = fmix32(uint32_t(right) ^ keys[r]) & mask;
+        uint64_t tmp = right;
+        right        = left ^ f;
+        left         = tmp;
+      }
+      x = (left << halfBits) | right;
+    } while (x >= N);
+    return IntType(x);
+  }
+};
+
+template <typename Type, typename IntType, typename IdxType, int TPB, bool rowMajor, typename MapT>
+__global__ void permuteKernel(IntType* perms, Type* out, const Type* in, MapT map, IdxType N, IdxType D)
 {
   namespace cg        = cooperative_groups;
   const int WARP_SIZE = 32;
@@ -36,7 +98,7 @@ __global__ void permuteKernel(
 
   // having shuffled input indices and coalesced output indices appears
   // to be preferrable to the reverse, especially for column major
-  IntType inIdx  = ((a * int64_t(tid)) + b) % N;
+  IntType inIdx  = map(tid);
   IntType outIdx = tid;
 
   if (perms != nullptr && tid < N) { perms[outIdx] = inIdx; }
@@ -71,7 +133,13 @@ __global__ void permuteKernel(
 }
 
 // This is wrapped in a type to allow for partial template specialization
-template <typename Type, typename IntType, typename IdxType, int TPB, bool rowMajor, int VLen>
+template <typename Type,
+          typename IntType,
+          typename IdxType,
+          int TPB,
+          bool rowMajor,
+          typename MapT,
+          int VLen>
 struct permute_impl_t {
   static void permuteImpl(IntType* perms,
                           Type* out,
@@ -79,8 +147,7 @@ struct permute_impl_t {
                           IdxType N,
                           IdxType D,
                           int nblks,
-                          IdxType a,
-                          IdxType b,
+                          const MapT& map,
                           cudaStream_t stream)
   {
     // determine vector type and set new pointers
@@ -91,35 +158,66 @@ struct permute_impl_t {
     // check if we can execute at this vector length
     if (D % VLen == 0 && raft::is_aligned(vout, sizeof(VType)) &&
         raft::is_aligned(vin, sizeof(VType))) {
-      permuteKernel<VType, IntType, IdxType, TPB, rowMajor>
-        <<<nblks, TPB, 0, stream>>>(perms, vout, vin, a, b, N, D / VLen);
+      permuteKernel<VType, IntType, IdxType, TPB, rowMajor, MapT>
+        <<<nblks, TPB, 0, stream>>>(perms, vout, vin, map, N, D / VLen);
       RAFT_CUDA_TRY(cudaPeekAtLastError());
     } else {  // otherwise try the next lower vector length
-      permute_impl_t<Type, IntType, IdxType, TPB, rowMajor, VLen / 2>::permuteImpl(
-        perms, out, in, N, D, nblks, a, b, stream);
+      permute_impl_t<Type, IntType, IdxType, TPB, rowMajor, MapT, VLen / 2>::permuteImpl(
+        perms, out, in, N, D, nblks, map, stream);
     }
   }
 };
 
 // at vector length 1 we just execute a scalar version to break the recursion
-template <typename Type, typename IntType, typename IdxType, int TPB, bool rowMajor>
-struct permute_impl_t<Type, IntType, IdxType, TPB, rowMajor, 1> {
+template <typename Type, typename IntType, typename IdxType, int TPB, bool rowMajor, typename MapT>
+struct permute_impl_t<Type, IntType, IdxType, TPB, rowMajor, MapT, 1> {
   static void permuteImpl(IntType* perms,
                           Type* out,
                           const Type* in,
                           IdxType N,
                           IdxType D,
                           int nblks,
-                          IdxType a,
-                          IdxType b,
+                          const MapT& map,
                           cudaStream_t stream)
   {
-    permuteKernel<Type, IntType, IdxType, TPB, rowMajor>
-      <<<nblks, TPB, 0, stream>>>(perms, out, in, a, b, N, D);
+    permuteKernel<Type, IntType, IdxType, TPB, rowMajor, MapT>
+      <<<nblks, TPB, 0, stream>>>(perms, out, in, map, N, D);
     RAFT_CUDA_TRY(cudaPeekAtLastError());
   }
 };
 
+template <typename Type, typename IntType, typename IdxType, int TPB, typename MapT>
+void permute_dispatch(IntType* perms,
+                      Type* out,
+                      const Type* in,
+                      IntType D,
+                      IntType N,
+                      bool rowMajor,
+                      const MapT& map,
+                      cudaStream_t stream)
+{
+  auto nblks = raft::ceildiv(N, (IntType)TPB);
+  if (rowMajor) {
+    permute_impl_t<Type,
+                   IntType,
+                   IdxType,
+                   TPB,
+                   true,
+                   MapT,
+                   (16 / sizeof(Type) > 0) ? 16 / sizeof(Type) : 1>::permuteImpl(perms,
+                                                                                 out,
+                                                                                 in,
+                                                                                 N,
+                                                                                 D,
+                                                                                 nblks,
+                                                                                 map,
+                                                                                 stream);
+  } else {
+    permute_impl_t<Type, IntType, IdxType, TPB, false, MapT, 1>::permuteImpl(
+      perms, out, in, N, D, nblks, map, stream);
+  }
+}
+
 template <typename Type, typename IntType = int, typename IdxType = int, int TPB = 256>
 void permute(IntType* perms,
              Type* out,
@@ -129,34 +227,123 @@ void permute(IntType* perms,
              bool rowMajor,
              cudaStream_t stream)
 {
-  auto nblks = raft::ceildiv(N, (IntType)TPB);
-
   // always keep 'a' to be coprime to N
   IdxType a = rand() % N;
   while (raft::gcd(a, N) != 1)
     a = (a + 1) % N;
   IdxType b = rand() % N;
 
+  affine_map_t<IntType, IdxType> map{a, b, IdxType(N)};
+  permute_dispatch<Type, IntType, IdxType, TPB>(perms, out, in, D, N, rowMajor, map, stream);
+}
+
+template <typename Type, typename IntType = int, typename IdxType = int, int TPB = 256>
+void permute_feistel(IntType* perms,
+                     Type* out,
+                     const Type* in,
+                     IntType D,
+                     IntType N,
+                     bool rowMajor,
+                     cudaStream_t stream)
+{
+  feistel_map_t<IntType> map;
+  // smallest even bit width whose domain covers N, so both Feistel halves
+  // get the same number of bits
+  int totalBits = 2;
+  while ((uint64_t(1) << totalBits) < uint64_t(N)) {
+    totalBits += 2;
+  }
+  map.halfBits = totalBits / 2;
+  map.N        = uint64_t(N);
+  for (int r = 0; r < feistel_map_t<IntType>::kRounds; r++) {
+    map.keys[r] = uint32_t(rand());
+  }
+  permute_dispatch<Type, IntType, IdxType, TPB>(perms, out, in, D, N, rowMajor, map, stream);
+}
+
+/**
+ * Batched variant: permutes B independent arrays in a single launch.
+ *
+ * Every array runs the same Feistel cipher but with its own round keys,
+ * derived in-kernel from the base keys and the batch index, so each array
+ * gets an independent permutation without B kernel launches or B maps
+ * staged through kernel parameters. Arrays are laid out contiguously:
+ * array b occupies `in/out + b * N * D` and `perms + b * N`.
+ */
+template <typename Type, typename IntType, typename IdxType, bool rowMajor>
+__global__ void permuteBatchedKernel(IntType* perms,
+                                     Type* out,
+                                     const Type* in,
+                                     feistel_map_t<IntType> base,
+                                     IdxType N,
+                                     IdxType D,
+                                     IdxType B)
+{
+  int tid = threadIdx.x + blockIdx.x * blockDim.x;
+  for (IdxType b = blockIdx.y; b < B; b += gridDim.y) {
+    // derive this array's round keys from the base keys and batch index
+    feistel_map_t<IntType> map = base;
+#pragma unroll
+    for (int r = 0; r < feistel_map_t<IntType>::kRounds; r++) {
+      map.keys[r] = fmix32(base.keys[r] ^ (0x9e3779b9u * uint32_t(b)));
+    }
+
+    IntType inIdx  = map(tid);
+    IntType outIdx = tid;
+    if (outIdx >= IntType(N)) { continue; }
+
+    if (perms != nullptr) { perms[size_t(b) * N + outIdx] = inIdx; }
+    if (out == nullptr || in == nullptr) { continue; }
+
+    const Type* bin = in + size_t(b) * N * D;
+    Type* bout      = out + size_t(b) * N * D;
+    if (rowMajor) {
+      for (IdxType j = 0; j < D; ++j) {
+        bout[size_t(outIdx) * D + j] = bin[size_t(inIdx) * D + j];
+      }
+    } else {
+      for (IdxType j = 0; j < D; ++j) {
+        bout[outIdx + j * size_t(N)] = bin[inIdx + j * size_t(N)];
+      }
+    }
+  }
+}
+
+template <typename Type, typename IntType = int, typename IdxType = int, int TPB = 256>
+void permute_batched_feistel(IntType* perms,
+                             Type* out,
+                             const Type* in,
+                             IntType D,
+                             IntType N,
+                             IntType B,
+                             bool rowMajor,
+                             cudaStream_t stream)
+{
+  feistel_map_t<IntType> base;
+  // smallest even bit width whose domain covers N, so both Feistel halves
+  // get the same number of bits
+  int totalBits = 2;
+  while ((uint64_t(1) << totalBits) < uint64_t(N)) {
+    totalBits += 2;
+  }
+  base.halfBits = totalBits / 2;
+  base.N        = uint64_t(N);
+  for (int r = 0; r < feistel_map_t<IntType>::kRounds; r++) {
+    base.keys[r] = uint32_t(rand());
+  }
+
+  // one slice of the grid per array, capped at the grid.y limit; larger
+  // batches are covered by the grid-stride loop inside the kernel
+  dim3 grid(raft::ceildiv(N, (IntType)TPB), std::min<IntType>(B, 65535));
   if (rowMajor) {
-    permute_impl_t<Type,
-                   IntType,
-                   IdxType,
-                   TPB,
-                   true,
-                   (16 / sizeof(Type) > 0) ? 16 / sizeof(Type) : 1>::permuteImpl(perms,
-                                                                                 out,
-                                                                                 in,
-                                                                                 N,
-                                                                                 D,
-                                                                                 nblks,
-                                                                                 a,
-                                                                                 b,
-                                                                                 stream);
+    permuteBatchedKernel<Type, IntType, IdxType, true>
+      <<<grid, TPB, 0, stream>>>(perms, out, in, base, N, D, B);
   } else {
-    permute_impl_t<Type, IntType, IdxType, TPB, false, 1>::permuteImpl(
-      perms, out, in, N, D, nblks, a, b, stream);
+    permuteBatchedKernel<Type, IntType, IdxType, false>
+      <<<grid, TPB, 0, stream>>>(perms, out, in, base, N, D, B);
   }
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
 }
 
 };  // end namespace detail
-};  // end namespace raft::random
\ No newline at end of file
+};  // end namespace raft::random
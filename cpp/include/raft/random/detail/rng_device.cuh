@@ -422,7 +422,7 @@ DI void custom_next(
 {
   OutType res;
   gen.next(res);
-  params.inIdxPtr[idx]  = idx;
+  if (params.inIdxPtr != nullptr) { params.inIdxPtr[idx] = idx; }
   constexpr OutType one = (OutType)1.0;
   auto exp              = -raft::myLog(one - res);
   if (params.wts != nullptr) {
@@ -681,6 +681,39 @@ __global__ void rngKernel(DeviceState<GenType> rng_state,
   return;
 }
 
+/**
+ * Like `rngKernel`, but instead of storing the generated values it hands
+ * each one to a device functor while still in registers: `f(val, idx)` is
+ * invoked exactly once for every index in `[0, len)`. This fuses
+ * generate-then-transform patterns (dropout masks, random projections)
+ * into a single kernel with no intermediate random buffer. OutType cannot
+ * be deduced from the arguments and must be given explicitly.
+ */
+template <int ITEMS_PER_CALL,
+          typename OutType,
+          typename LenType,
+          typename GenType,
+          typename ParamType,
+          typename Lambda>
+__global__ void rngConsumeKernel(DeviceState<GenType> rng_state,
+                                 Lambda f,
+                                 LenType len,
+                                 ParamType params)
+{
+  LenType tid = threadIdx.x + blockIdx.x * blockDim.x;
+  GenType gen(rng_state, (uint64_t)tid);
+  const LenType stride = gridDim.x * blockDim.x;
+  for (LenType idx = tid; idx < len; idx += stride * ITEMS_PER_CALL) {
+    OutType val[ITEMS_PER_CALL];
+    custom_next(gen, val, params, idx, stride);
+#pragma unroll
+    for (int i = 0; i < ITEMS_PER_CALL; i++) {
+      if ((idx + i * stride) < len) f(val[i], idx + i * stride);
+    }
+  }
+  return;
+}
+
 /**
  * This kernel is deprecated and should be removed in a future release
  */
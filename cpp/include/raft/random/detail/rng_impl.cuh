@@ -16,11 +16,12 @@
 
 #pragma once
 
-#include <raft/common/cub_wrappers.cuh>
 #include <raft/common/scatter.cuh>
 #include <raft/cudart_utils.h>
+#include <raft/matrix/detail/select_k.cuh>
 #include <raft/random/rng_device.cuh>
 #include <raft/random/rng_state.hpp>
+#include <rmm/device_uvector.hpp>
 
 namespace raft {
 namespace random {
@@ -82,6 +83,18 @@ void call_rng_kernel(DeviceState<GenType> const& dev_state,
   rng_state.advance(uint64_t(n_blocks) * n_threads, 16);
 }
 
+template <int ITEMS_PER_CALL, typename OutType, typename GenType, typename... ArgsT>
+void call_rng_consume_kernel(DeviceState<GenType> const& dev_state,
+                             RngState& rng_state,
+                             cudaStream_t stream,
+                             ArgsT... args)
+{
+  auto n_threads = 256;
+  auto n_blocks  = 4 * getMultiProcessorCount();
+  rngConsumeKernel<ITEMS_PER_CALL, OutType><<<n_blocks, n_threads, 0, stream>>>(dev_state, args...);
+  rng_state.advance(uint64_t(n_blocks) * n_threads, 16);
+}
+
 template <typename OutType, typename LenType = int>
 void uniform(
   RngState& rng_state, OutType* ptr, LenType len, OutType start, OutType end, cudaStream_t stream)
@@ -94,6 +107,19 @@ void uniform(
   RAFT_CALL_RNG_FUNC(rng_state, call_rng_kernel<1>, rng_state, stream, ptr, len, params);
 }
 
+template <typename OutType, typename Lambda, typename LenType = int>
+void uniform_consume(
+  RngState& rng_state, Lambda f, LenType len, OutType start, OutType end, cudaStream_t stream)
+{
+  static_assert(std::is_floating_point<OutType>::value,
+                "Type for 'uniform_consume' can only be floating point!");
+  UniformDistParams<OutType> params;
+  params.start = start;
+  params.end   = end;
+  RAFT_CALL_RNG_FUNC(
+    rng_state, (call_rng_consume_kernel<1, OutType>), rng_state, stream, f, len, params);
+}
+
 template <typename OutType, typename LenType = int>
 void uniformInt(
   RngState& rng_state, OutType* ptr, LenType len, OutType start, OutType end, cudaStream_t stream)
@@ -127,6 +153,19 @@ void normal(
   RAFT_CALL_RNG_FUNC(rng_state, call_rng_kernel<2>, rng_state, stream, ptr, len, params);
 }
 
+template <typename OutType, typename Lambda, typename LenType = int>
+void normal_consume(
+  RngState& rng_state, Lambda f, LenType len, OutType mu, OutType sigma, cudaStream_t stream)
+{
+  static_assert(std::is_floating_point<OutType>::value,
+                "Type for 'normal_consume' can only be floating point!");
+  NormalDistParams<OutType> params;
+  params.mu    = mu;
+  params.sigma = sigma;
+  RAFT_CALL_RNG_FUNC(
+    rng_state, (call_rng_consume_kernel<2, OutType>), rng_state, stream, f, len, params);
+}
+
 template <typename IntType, typename LenType = int>
 void normalInt(
   RngState& rng_state, IntType* ptr, LenType len, IntType mu, IntType sigma, cudaStream_t stream)
@@ -174,6 +213,15 @@ void bernoulli(RngState& rng_state, OutType* ptr, LenType len, Type prob, cudaSt
   RAFT_CALL_RNG_FUNC(rng_state, call_rng_kernel<1>, rng_state, stream, ptr, len, params);
 }
 
+template <typename OutType = bool, typename Type, typename Lambda, typename LenType = int>
+void bernoulli_consume(RngState& rng_state, Lambda f, LenType len, Type prob, cudaStream_t stream)
+{
+  BernoulliDistParams<Type> params;
+  params.prob = prob;
+  RAFT_CALL_RNG_FUNC(
+    rng_state, (call_rng_consume_kernel<1, OutType>), rng_state, stream, f, len, params);
+}
+
 template <typename OutType, typename LenType = int>
 void scaled_bernoulli(
   RngState& rng_state, OutType* ptr, LenType len, OutType prob, OutType scale, cudaStream_t stream)
@@ -255,27 +303,30 @@ void sampleWithoutReplacement(RngState& rng_state,
 {
   ASSERT(sampledLen <= len, "sampleWithoutReplacement: 'sampledLen' cant be more than 'len'.");
 
+  // generate the exponential-race keys -log(u) / wts[i]; the items holding the
+  // 'sampledLen' smallest keys form the weighted sample without replacement
   rmm::device_uvector<WeightsT> expWts(len, stream);
-  rmm::device_uvector<WeightsT> sortedWts(len, stream);
-  rmm::device_uvector<IdxT> inIdx(len, stream);
-  rmm::device_uvector<IdxT> outIdxBuff(len, stream);
-  auto* inIdxPtr = inIdx.data();
-  // generate modified weights
   SamplingParams<WeightsT, IdxT> params;
-  params.inIdxPtr = inIdxPtr;
+  params.inIdxPtr = nullptr;
   params.wts      = wts;
 
   RAFT_CALL_RNG_FUNC(rng_state, call_rng_kernel<1>, rng_state, stream, expWts.data(), len, params);
 
-  ///@todo: use a more efficient partitioning scheme instead of full sort
-  // sort the array and pick the top sampledLen items
-  IdxT* outIdxPtr = outIdxBuff.data();
-  rmm::device_uvector<char> workspace(0, stream);
-  sortPairs(workspace, expWts.data(), sortedWts.data(), inIdxPtr, outIdxPtr, (int)len, stream);
-  if (outIdx != nullptr) {
-    RAFT_CUDA_TRY(cudaMemcpyAsync(
-      outIdx, outIdxPtr, sizeof(IdxT) * sampledLen, cudaMemcpyDeviceToDevice, stream));
-  }
+  // partial selection of the smallest keys instead of a full sort; a nullptr
+  // input-index array makes the selection emit the identity indices, so no
+  // len-sized index buffers have to be materialized
+  rmm::device_uvector<WeightsT> sampledWts(sampledLen, stream);
+  rmm::device_uvector<IdxT> outIdxBuff(outIdx == nullptr ? sampledLen : 0, stream);
+  IdxT* outIdxPtr = outIdx != nullptr ? outIdx : outIdxBuff.data();
+  raft::matrix::detail::select_k<WeightsT, IdxT>(expWts.data(),
+                                                 nullptr,
+                                                 1,
+                                                 size_t(len),
+                                                 int(sampledLen),
+                                                 sampledWts.data(),
+                                                 outIdxPtr,
+                                                 true,
+                                                 stream);
   scatter<DataT, IdxT>(out, in, outIdxPtr, sampledLen, stream);
 }
 
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "curand_wrappers.hpp"
+#include "permute.cuh"  // fmix32
+#include <algorithm>
+#include <curand_kernel.h>
+#include <raft/cuda_utils.cuh>
+#include <raft/cudart_utils.h>
+#include <raft/random/rng_state.hpp>
+#include <rmm/device_uvector.hpp>
+#include <type_traits>
+
+namespace raft::random {
+namespace detail {
+
+DI float sobol_cdf_inv(float u) { return normcdfinvf(u); }
+DI double sobol_cdf_inv(double u) { return normcdfinv(u); }
+
+/**
+ * Scrambled Sobol is random access: every (dimension, index) pair can be
+ * evaluated independently in O(32), so the kernel is a plain grid-stride loop
+ * with no sequential state carried between samples. The output is
+ * dimension-major; coordinate 'dim' of point 'i' lands at
+ * ptr[dim * n_points + i].
+ */
+template <typename OutType, typename LenType>
+__global__ void sobol_kernel(const unsigned int* dir_vectors,
+                             const unsigned int* scramble_consts,
+                             uint64_t seed,
+                             uint64_t offset,
+                             bool normal,
+                             OutType mu,
+                             OutType sigma,
+                             OutType* ptr,
+                             LenType n_points,
+                             LenType n_dims)
+{
+  LenType tid    = threadIdx.x + blockIdx.x * blockDim.x;
+  LenType stride = gridDim.x * blockDim.x;
+  LenType len    = n_points * n_dims;
+  for (LenType idx = tid; idx < len; idx += stride) {
+    LenType dim   = idx / n_points;
+    LenType point = idx % n_points;
+    // the per-dimension scramble constant gets an extra seed-derived digital
+    // shift, so different seeds yield independent randomized-QMC estimates
+    unsigned int scramble =
+      scramble_consts[dim] ^ fmix32(uint32_t(seed ^ (seed >> 32)) + uint32_t(dim) * 0x9e3779b9u);
+    curandStateScrambledSobol32_t state;
+    curand_init(const_cast<unsigned int*>(dir_vectors) + dim * 32,
+                scramble,
+                (unsigned int)(uint64_t(point) + offset),
+                &state);
+    unsigned int r = curand(&state);
+    // (r + 0.5) / 2^32 lies strictly inside (0, 1), which keeps the normal
+    // inverse-cdf below finite
+    OutType u = (OutType(r) + OutType(0.5)) * OutType(2.3283064365386963e-10);
+    if (normal) { u = mu + sigma * sobol_cdf_inv(u); }
+    ptr[idx] = u;
+  }
+}
+
+template <typename OutType, typename LenType>
+void sobol_fill(RngState& rng_state,
+                OutType* ptr,
+                LenType n_points,
+                LenType n_dims,
+                bool normal,
+                OutType mu,
+                OutType sigma,
+                cudaStream_t stream)
+{
+  static_assert(std::is_floating_point<OutType>::value,
+                "Type for 'sobol' can only be floating point!");
+  ASSERT(n_dims >= 1, "sobol: 'n_dims' must be positive!");
+
+  // curand ships scrambled Joe-Kuo direction vectors and scramble constants
+  // as static host tables; only the first n_dims entries are uploaded
+  curandDirectionVectors32_t* h_dirs;
+  unsigned int* h_scrambles;
+  CURAND_CHECK(curandGetDirectionVectors32(&h_dirs, CURAND_SCRAMBLED_DIRECTION_VECTORS32_JOEKUO6));
+  CURAND_CHECK(curandGetScrambleConstants32(&h_scrambles));
+  rmm::device_uvector<unsigned int> dirs(std::size_t(n_dims) * 32, stream);
+  rmm::device_uvector<unsigned int> scrambles(n_dims, stream);
+  raft::update_device(
+    dirs.data(), reinterpret_cast<const unsigned int*>(h_dirs), std::size_t(n_dims) * 32, stream);
+  raft::update_device(scrambles.data(), h_scrambles, n_dims, stream);
+
+  LenType len          = n_points * n_dims;
+  const int nThreads   = 256;
+  uint64_t maxBlocks   = uint64_t(4 * getMultiProcessorCount());
+  uint64_t workBlocks  = raft::ceildiv<uint64_t>(uint64_t(len), nThreads);
+  int nBlocks          = int(std::min(maxBlocks, std::max<uint64_t>(workBlocks, 1)));
+  sobol_kernel<OutType, LenType><<<nBlocks, nThreads, 0, stream>>>(dirs.data(),
+                                                                   scrambles.data(),
+                                                                   rng_state.seed,
+                                                                   rng_state.base_subsequence,
+                                                                   normal,
+                                                                   mu,
+                                                                   sigma,
+                                                                   ptr,
+                                                                   n_points,
+                                                                   n_dims);
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
+  // the next call continues every dimension's sequence right after the
+  // points generated here
+  rng_state.advance(n_points, 1);
+}
+
+template <typename OutType, typename LenType = int>
+void sobol_uniform(
+  RngState& rng_state, OutType* ptr, LenType n_points, LenType n_dims, cudaStream_t stream)
+{
+  sobol_fill(rng_state, ptr, n_points, n_dims, false, OutType(0.0), OutType(1.0), stream);
+}
+
+template <typename OutType, typename LenType = int>
+void sobol_normal(RngState& rng_state,
+                  OutType* ptr,
+                  LenType n_points,
+                  LenType n_dims,
+                  OutType mu,
+                  OutType sigma,
+                  cudaStream_t stream)
+{
+  sobol_fill(rng_state, ptr, n_points, n_dims, true, mu, sigma, stream);
+}
+
+};  // end namespace detail
+};  // end namespace raft::random
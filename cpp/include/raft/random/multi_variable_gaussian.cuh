@@ -59,6 +59,52 @@ class multi_variable_gaussian : public detail::multi_variable_gaussian_impl<T> {
   ~multi_variable_gaussian() { deinit(); }
 };  // end of multi_variable_gaussian
 
+/**
+ * @brief Draw samples from many independent small multi-variable Gaussians
+ * at once.
+ *
+ * All covariances are decomposed with a single batched Cholesky call and the
+ * factors are cached inside the object, so repeated `give_gaussian` calls
+ * against unchanged covariances collapse to one fused curand generation plus
+ * one strided-batched gemm, no matter how many distributions there are.
+ * Matrices are column-major, matching `multi_variable_gaussian`.
+ */
+template <typename T>
+class multi_variable_gaussian_batched : public detail::multi_variable_gaussian_batched_impl<T> {
+ public:
+  multi_variable_gaussian_batched() = delete;
+  multi_variable_gaussian_batched(const raft::handle_t& handle, const int dim, const int batchSize)
+    : detail::multi_variable_gaussian_batched_impl<T>{handle, dim, batchSize}
+  {
+  }
+
+  /**
+   * @brief Decompose and cache the covariances
+   * @param P 'batchSize' consecutive dim x dim column-major SPD matrices;
+   * unlike `multi_variable_gaussian::give_gaussian`, P is not destroyed
+   */
+  void set_covariance(const T* P)
+  {
+    detail::multi_variable_gaussian_batched_impl<T>::set_covariance(P);
+  }
+
+  /**
+   * @brief Sample every cached distribution
+   * @param nPoints number of samples to draw per distribution
+   * @param X output, 'batchSize' consecutive dim x nPoints column-major blocks
+   * @param x optional dim x batchSize mean vectors, pass a nullptr for
+   * zero-mean samples
+   */
+  void give_gaussian(const int nPoints, T* X, const T* x = nullptr)
+  {
+    detail::multi_variable_gaussian_batched_impl<T>::give_gaussian(nPoints, X, x);
+  }
+
+  void deinit() { detail::multi_variable_gaussian_batched_impl<T>::deinit(); }
+
+  ~multi_variable_gaussian_batched() { deinit(); }
+};  // end of multi_variable_gaussian_batched
+
 };  // end of namespace raft::random
 
 #endif
\ No newline at end of file
@@ -58,6 +58,79 @@ void permute(IntType* perms,
   detail::permute<Type, IntType, IdxType, TPB>(perms, out, in, D, N, rowMajor, stream);
 }
 
+/**
+ * @brief Generate permutations of the input array through a format-preserving
+ * Feistel network.
+ *
+ * Unlike `permute`, which only reaches a small family of affine permutations,
+ * the keyed Feistel cipher produces statistically strong permutations; each
+ * thread derives its source index in registers, so no key buffers have to be
+ * materialized or sorted no matter how large N gets.
+ *
+ * @tparam Type Data type of the array to be shuffled
+ * @tparam IntType Integer type used for ther perms array
+ * @tparam IdxType Integer type used for addressing indices
+ * @tparam TPB threads per block
+ * @param perms the output permutation indices. Typically useful only when
+ * one wants to refer back. If you don't need this, pass a nullptr
+ * @param out the output shuffled array. Pass nullptr if you don't want this to
+ * be written. For eg: when you only want the perms array to be filled.
+ * @param in input array (in-place is not supported due to race conditions!)
+ * @param D number of columns of the input array
+ * @param N length of the input array (or number of rows)
+ * @param rowMajor whether the input/output matrices are row or col major
+ * @param stream cuda stream where to launch the work
+ */
+template <typename Type, typename IntType = int, typename IdxType = int, int TPB = 256>
+void permute_feistel(IntType* perms,
+                     Type* out,
+                     const Type* in,
+                     IntType D,
+                     IntType N,
+                     bool rowMajor,
+                     cudaStream_t stream)
+{
+  detail::permute_feistel<Type, IntType, IdxType, TPB>(perms, out, in, D, N, rowMajor, stream);
+}
+
+/**
+ * @brief Permute B independent arrays in a single kernel launch.
+ *
+ * Each of the B arrays is shuffled by its own Feistel permutation (round
+ * keys are derived per array inside the kernel), so shuffling many small
+ * arrays - e.g. per-fold index arrays in cross-validation - costs one
+ * launch instead of B. Arrays are laid out contiguously: array b occupies
+ * `in/out + b * N * D` and `perms + b * N`.
+ *
+ * @tparam Type Data type of the arrays to be shuffled
+ * @tparam IntType Integer type used for ther perms array
+ * @tparam IdxType Integer type used for addressing indices
+ * @tparam TPB threads per block
+ * @param perms the output permutation indices, one block of N per array.
+ * Pass a nullptr if you don't need them
+ * @param out the output shuffled arrays. Pass nullptr if you only want the
+ * perms array to be filled
+ * @param in input arrays (in-place is not supported due to race conditions!)
+ * @param D number of columns of each input array
+ * @param N length of each input array (or number of rows)
+ * @param B number of independent arrays
+ * @param rowMajor whether the input/output matrices are row or col major
+ * @param stream cuda stream where to launch the work
+ */
+template <typename Type, typename IntType = int, typename IdxType = int, int TPB = 256>
+void permute_batched_feistel(IntType* perms,
+                             Type* out,
+                             const Type* in,
+                             IntType D,
+                             IntType N,
+                             IntType B,
+                             bool rowMajor,
+                             cudaStream_t stream)
+{
+  detail::permute_batched_feistel<Type, IntType, IdxType, TPB>(
+    perms, out, in, D, N, B, rowMajor, stream);
+}
+
 };  // end namespace raft::random
 
 #endif
\ No newline at end of file
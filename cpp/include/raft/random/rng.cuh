@@ -46,6 +46,37 @@ void uniform(const raft::handle_t& handle,
   detail::uniform(rng_state, ptr, len, start, end, handle.get_stream());
 }
 
+/**
+ * @brief Generate uniformly distributed numbers and hand each one to a
+ * device functor while still in registers, instead of storing them.
+ *
+ * `f(val, idx)` is invoked exactly once for every index in `[0, len)`,
+ * fusing generate-then-transform patterns (dropout masks, random
+ * projections) into one kernel with no intermediate random buffer.
+ *
+ * @tparam OutType data type of the generated random numbers (cannot be
+ *                 deduced and must be given explicitly)
+ * @tparam Lambda  device functor type with signature
+ *                 `void (OutType val, LenType idx)`
+ * @tparam LenType data type used to represent length of the arrays
+ * @param[in] handle raft handle for resource management
+ * @param[in] rng_state random number generator state
+ * @param[in] f the consuming device functor
+ * @param[in] len the number of values to generate
+ * @param[in] start start of the range
+ * @param[in] end end of the range
+ */
+template <typename OutType, typename Lambda, typename LenType = int>
+void uniform_consume(const raft::handle_t& handle,
+                     RngState& rng_state,
+                     Lambda f,
+                     LenType len,
+                     OutType start,
+                     OutType end)
+{
+  detail::uniform_consume<OutType>(rng_state, f, len, start, end, handle.get_stream());
+}
+
 /**
  * @brief Generate uniformly distributed integers in the given range
  *
@@ -92,6 +123,34 @@ void normal(const raft::handle_t& handle,
   detail::normal(rng_state, ptr, len, mu, sigma, handle.get_stream());
 }
 
+/**
+ * @brief Generate normal distributed numbers and hand each one to a
+ * device functor while still in registers, instead of storing them.
+ * See `uniform_consume` for the semantics of the functor.
+ *
+ * @tparam OutType data type of the generated random numbers (cannot be
+ *                 deduced and must be given explicitly)
+ * @tparam Lambda  device functor type with signature
+ *                 `void (OutType val, LenType idx)`
+ * @tparam LenType data type used to represent length of the arrays
+ * @param[in] handle raft handle for resource management
+ * @param[in] rng_state random number generator state
+ * @param[in] f the consuming device functor
+ * @param[in] len the number of values to generate
+ * @param[in] mu mean of the distribution
+ * @param[in] sigma std-dev of the distribution
+ */
+template <typename OutType, typename Lambda, typename LenType = int>
+void normal_consume(const raft::handle_t& handle,
+                    RngState& rng_state,
+                    Lambda f,
+                    LenType len,
+                    OutType mu,
+                    OutType sigma)
+{
+  detail::normal_consume<OutType>(rng_state, f, len, mu, sigma, handle.get_stream());
+}
+
 /**
  * @brief Generate normal distributed integers
  *
@@ -187,6 +246,31 @@ void bernoulli(
   detail::bernoulli(rng_state, ptr, len, prob, handle.get_stream());
 }
 
+/**
+ * @brief Generate bernoulli distributed values and hand each one to a
+ * device functor while still in registers, instead of storing them.
+ * See `uniform_consume` for the semantics of the functor. The classic
+ * use case is applying a dropout mask to an existing buffer without
+ * ever materializing the mask.
+ *
+ * @tparam OutType data type of the generated values handed to the functor
+ * @tparam Type    data type in which to compute the probabilities
+ * @tparam Lambda  device functor type with signature
+ *                 `void (OutType val, LenType idx)`
+ * @tparam LenType data type used to represent length of the arrays
+ * @param[in] handle raft handle for resource management
+ * @param[in] rng_state random number generator state
+ * @param[in] f      the consuming device functor
+ * @param[in] len    the number of values to generate
+ * @param[in] prob   coin-toss probability for heads
+ */
+template <typename OutType = bool, typename Type, typename Lambda, typename LenType = int>
+void bernoulli_consume(
+  const raft::handle_t& handle, RngState& rng_state, Lambda f, LenType len, Type prob)
+{
+  detail::bernoulli_consume<OutType>(rng_state, f, len, prob, handle.get_stream());
+}
+
 /**
  * @brief Generate bernoulli distributed array and applies scale
  *
@@ -346,10 +430,14 @@ void laplace(const raft::handle_t& handle,
  * Implementation here is based on the `one-pass sampling` algo described here:
  * https://www.ethz.ch/content/dam/ethz/special-interest/baug/ivt/ivt-dam/vpl/reports/1101-1200/ab1141.pdf
  *
- * @note In the sampled array the elements which are picked will always appear
- * in the increasing order of their weights as computed using the exponential
- * distribution. So, if you're particular about the order (for eg. array
- * permutations), then this might not be the right choice!
+ * The exponential-race keys are generated in a single fused pass and only the
+ * 'sampledLen' smallest are kept through a partial selection
+ * (`raft::matrix::detail::select_k`), so no full sort of the input is done.
+ *
+ * @note The order in which the sampled elements appear is an implementation
+ * detail of the selection algorithm picked for the problem shape. So, if
+ * you're particular about the order (for eg. array permutations), then this
+ * might not be the right choice!
  *
  * @tparam DataT data type
  * @tparam WeightsT weights type
@@ -404,6 +492,7 @@ void affine_transform_params(RngState const& rng_state, IdxT n, IdxT& a, IdxT& b
 #define DEPR [[deprecated("Use 'RngState' with the new flat functions instead")]]
 
 using detail::bernoulli;
+using detail::bernoulli_consume;
 using detail::exponential;
 using detail::fill;
 using detail::gumbel;
@@ -411,11 +500,13 @@ using detail::laplace;
 using detail::logistic;
 using detail::lognormal;
 using detail::normal;
+using detail::normal_consume;
 using detail::normalInt;
 using detail::normalTable;
 using detail::rayleigh;
 using detail::scaled_bernoulli;
 using detail::uniform;
+using detail::uniform_consume;
 using detail::uniformInt;
 
 using detail::sampleWithoutReplacement;
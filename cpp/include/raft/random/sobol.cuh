@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __SOBOL_H
+#define __SOBOL_H
+
+#pragma once
+
+#include "detail/sobol.cuh"
+#include <raft/handle.hpp>
+
+namespace raft::random {
+
+/**
+ * @brief Generate scrambled Sobol low-discrepancy points in (0, 1)
+ *
+ * Unlike the pseudo-random generators behind `uniform`, consecutive Sobol
+ * points fill the unit cube evenly, which makes Monte Carlo integrals
+ * converge like O(log(n)^d / n) instead of O(1 / sqrt(n)). The seed of
+ * `rng_state` randomizes the scrambling (randomized QMC), so independent
+ * seeds give independent estimates for error estimation, and
+ * `base_subsequence` is the index of the first point generated, so
+ * consecutive calls continue the sequence.
+ *
+ * @tparam OutType output data type
+ * @tparam LenType data type used to represent length of the arrays
+ * @param[in] handle raft handle for resource management
+ * @param[in] rng_state random number generator state
+ * @param[out] ptr output array, dimension-major: coordinate 'dim' of point
+ * 'i' is written at ptr[dim * n_points + i] [len = n_points * n_dims]
+ * @param[in] n_points number of points to generate
+ * @param[in] n_dims dimensionality of the points
+ */
+template <typename OutType, typename LenType = int>
+void sobol_uniform(const raft::handle_t& handle,
+                   RngState& rng_state,
+                   OutType* ptr,
+                   LenType n_points,
+                   LenType n_dims)
+{
+  detail::sobol_uniform(rng_state, ptr, n_points, n_dims, handle.get_stream());
+}
+
+/**
+ * @brief Generate normally-distributed scrambled Sobol points
+ *
+ * The uniform Sobol points are pushed through the normal inverse-cdf rather
+ * than box-muller, which preserves their low discrepancy. See
+ * `sobol_uniform` for the output layout and the `rng_state` semantics.
+ *
+ * @tparam OutType output data type
+ * @tparam LenType data type used to represent length of the arrays
+ * @param[in] handle raft handle for resource management
+ * @param[in] rng_state random number generator state
+ * @param[out] ptr output array, dimension-major [len = n_points * n_dims]
+ * @param[in] n_points number of points to generate
+ * @param[in] n_dims dimensionality of the points
+ * @param[in] mu the mean
+ * @param[in] sigma the standard deviation
+ */
+template <typename OutType, typename LenType = int>
+void sobol_normal(const raft::handle_t& handle,
+                  RngState& rng_state,
+                  OutType* ptr,
+                  LenType n_points,
+                  LenType n_dims,
+                  OutType mu,
+                  OutType sigma)
+{
+  detail::sobol_normal(rng_state, ptr, n_points, n_dims, mu, sigma, handle.get_stream());
+}
+
+};  // end namespace raft::random
+
+#endif
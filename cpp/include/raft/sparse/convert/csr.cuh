@@ -39,6 +39,25 @@ void coo_to_csr(const raft::handle_t& handle,
   detail::coo_to_csr(handle, srcRows, srcCols, srcVals, nnz, m, dst_offsets, dstCols, dstVals);
 }
 
+/**
+ * @brief Counts the nonzeros per row of a dense column-major adjacency
+ * matrix (size batch_rows x total_rows). Scanning the counts yields the
+ * row_ind array expected by csr_adj_graph_batched, making the two calls a
+ * two-pass dense adjacency to CSR conversion.
+ *
+ * @param adj the adjacency array
+ * @param batch_rows number of rows in the batch
+ * @param total_rows number of vertices in the graph
+ * @param row_counts output nonzero count per row (size batch_rows)
+ * @param stream cuda stream to use
+ */
+template <typename Index_>
+void adj_degree(
+  const bool* adj, Index_ batch_rows, Index_ total_rows, Index_* row_counts, cudaStream_t stream)
+{
+  detail::adj_degree(adj, batch_rows, total_rows, row_counts, stream);
+}
+
 /**
  * @brief Constructs an adjacency graph CSR row_ind_ptr array from
  * a row_ind array and adjacency array.
@@ -74,6 +74,102 @@ void coo_to_csr(const raft::handle_t& handle,
   RAFT_CUDA_TRY(cudaDeviceSynchronize());
 }
 
+/**
+ * Counts the nonzeros of each adjacency row. Consecutive threads take
+ * consecutive rows, so the column-major adjacency reads coalesce.
+ */
+template <typename Index_, int TPB_X = 256>
+__global__ void adj_degree_kernel(const bool* adj,
+                                  Index_ batch_rows,
+                                  Index_ total_rows,
+                                  Index_* row_counts)
+{
+  Index_ row = (Index_)blockIdx.x * TPB_X + threadIdx.x;
+  if (row >= batch_rows) return;
+
+  Index_ count = 0;
+  for (Index_ i = 0; i < total_rows; i++)
+    count += adj[(size_t)batch_rows * i + row];
+  row_counts[row] = count;
+}
+
+/**
+ * @brief Counts the nonzeros per row of a dense column-major adjacency
+ * matrix (size batch_rows x total_rows), e.g. to size and scan the
+ * row_ind array before compacting the columns with csr_adj_graph_batched.
+ *
+ * @param adj the adjacency array
+ * @param batch_rows number of rows in the batch
+ * @param total_rows number of vertices in the graph
+ * @param row_counts output nonzero count per row (size batch_rows)
+ * @param stream cuda stream to use
+ */
+template <typename Index_, int TPB_X = 256>
+void adj_degree(
+  const bool* adj, Index_ batch_rows, Index_ total_rows, Index_* row_counts, cudaStream_t stream)
+{
+  adj_degree_kernel<Index_, TPB_X>
+    <<<raft::ceildiv(batch_rows, (Index_)TPB_X), TPB_X, 0, stream>>>(
+      adj, batch_rows, total_rows, row_counts);
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
+}
+
+/**
+ * Compacts a 32x32 tile of the adjacency matrix per block iteration: the
+ * tile is staged through shared memory with coalesced loads (consecutive
+ * lanes read consecutive rows), then each warp owns one row and turns the
+ * tile's columns into packed output positions with a ballot + prefix
+ * popcount, so the column writes are warp-aggregated and contiguous.
+ */
+template <typename Index_, typename Lambda>
+__global__ void adj_graph_fill_kernel(const Index_* row_ind,
+                                      Index_ batch_rows,
+                                      Index_ total_rows,
+                                      Index_ nnz,
+                                      const bool* adj,
+                                      Index_* row_ind_ptr,
+                                      Lambda fused_op)
+{
+  constexpr int tile_dim = 32;
+  __shared__ bool tile[tile_dim][tile_dim + 1];
+
+  Index_ row0 = (Index_)blockIdx.x * tile_dim;
+  int lane    = threadIdx.x;
+  int warp    = threadIdx.y;
+
+  Index_ row  = row0 + warp;
+  Index_ base = 0;
+  if (row < batch_rows) {
+    base = row_ind[row];
+    if (lane == 0) {
+      Index_ stop_idx = row < batch_rows - 1 ? row_ind[row + 1] : nnz;
+      fused_op(row, base, stop_idx);
+    }
+  }
+
+  for (Index_ i0 = 0; i0 < total_rows; i0 += tile_dim) {
+    Index_ load_row  = row0 + lane;
+    Index_ load_col  = i0 + warp;
+    tile[warp][lane] = load_row < batch_rows && load_col < total_rows
+                         ? adj[(size_t)batch_rows * load_col + load_row]
+                         : false;
+    __syncthreads();
+
+    // `row < batch_rows` is uniform across the warp, so the ballot below
+    // always sees all 32 lanes
+    if (row < batch_rows) {
+      bool present    = i0 + lane < total_rows && tile[lane][warp];
+      uint32_t ballot = __ballot_sync(0xffffffff, present);
+      if (present) {
+        Index_ pos       = base + __popc(ballot & ((1u << lane) - 1));
+        row_ind_ptr[pos] = i0 + lane;
+      }
+      base += __popc(ballot);
+    }
+    __syncthreads();
+  }
+}
+
 /**
  * @brief Constructs an adjacency graph CSR row_ind_ptr array from
  * a row_ind array and adjacency array.
@@ -99,23 +195,11 @@ void csr_adj_graph_batched(const Index_* row_ind,
                            cudaStream_t stream,
                            Lambda fused_op)
 {
-  op::csr_row_op<Index_>(
-    row_ind,
-    batchSize,
-    nnz,
-    [fused_op, adj, total_rows, row_ind_ptr, batchSize, nnz] __device__(
-      Index_ row, Index_ start_idx, Index_ stop_idx) {
-      fused_op(row, start_idx, stop_idx);
-      Index_ k = 0;
-      for (Index_ i = 0; i < total_rows; i++) {
-        // @todo: uncoalesced mem accesses!
-        if (adj[batchSize * i + row]) {
-          row_ind_ptr[start_idx + k] = i;
-          k += 1;
-        }
-      }
-    },
-    stream);
+  dim3 blk(32, 32);
+  dim3 grid(raft::ceildiv(batchSize, (Index_)32));
+  adj_graph_fill_kernel<Index_, Lambda>
+    <<<grid, blk, 0, stream>>>(row_ind, batchSize, total_rows, nnz, adj, row_ind_ptr, fused_op);
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
 }
 
 template <typename Index_, int TPB_X = 32, typename Lambda = auto(Index_, Index_, Index_)->void>
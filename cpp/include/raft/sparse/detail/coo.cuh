@@ -14,9 +14,11 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <iostream>
 #include <raft/cudart_utils.h>
 #include <rmm/device_uvector.hpp>
+#include <rmm/mr/device/per_device_resource.hpp>
 
 #pragma once
 
@@ -54,11 +56,37 @@ class COO {
   Index_Type n_rows;
   Index_Type n_cols;
 
+  /**
+   * True when the entries are known to be in lexicographic (row, col) order.
+   * Producers that establish this invariant (e.g. coo_sort) set the flag so
+   * downstream consumers can skip redundant sort passes. Invalidated whenever
+   * the arrays are (re)allocated or mutated outside the flag-aware ops.
+   */
+  bool sorted;
+
+  /**
+   * True when the entries are known to contain no duplicate (row, col) pairs,
+   * letting duplicate-merging ops (e.g. max_duplicates) pass the data through
+   * without re-deriving the adjacency mask. Invalidated on (re)allocation.
+   */
+  bool unique;
+
   /**
    * @param stream: CUDA stream to use
+   * @param mr: memory resource backing the underlying arrays. Attaching a
+   * dedicated pool/arena resource here lets the same COO be recycled across
+   * iterations without touching the default pool.
    */
-  COO(cudaStream_t stream)
-    : rows_arr(0, stream), cols_arr(0, stream), vals_arr(0, stream), nnz(0), n_rows(0), n_cols(0)
+  COO(cudaStream_t stream,
+      rmm::mr::device_memory_resource* mr = rmm::mr::get_current_device_resource())
+    : rows_arr(0, stream, mr),
+      cols_arr(0, stream, mr),
+      vals_arr(0, stream, mr),
+      nnz(0),
+      n_rows(0),
+      n_cols(0),
+      sorted(false),
+      unique(false)
   {
   }
 
@@ -76,7 +104,14 @@ class COO {
       Index_Type nnz,
       Index_Type n_rows = 0,
       Index_Type n_cols = 0)
-    : rows_arr(rows), cols_arr(cols), vals_arr(vals), nnz(nnz), n_rows(n_rows), n_cols(n_cols)
+    : rows_arr(rows),
+      cols_arr(cols),
+      vals_arr(vals),
+      nnz(nnz),
+      n_rows(n_rows),
+      n_cols(n_cols),
+      sorted(false),
+      unique(false)
   {
   }
 
@@ -86,18 +121,22 @@ class COO {
    * @param n_rows: number of rows in the dense matrix
    * @param n_cols: number of cols in the dense matrix
    * @param init: initialize arrays with zeros
+   * @param mr: memory resource backing the underlying arrays
    */
   COO(cudaStream_t stream,
       Index_Type nnz,
-      Index_Type n_rows = 0,
-      Index_Type n_cols = 0,
-      bool init         = true)
-    : rows_arr(nnz, stream),
-      cols_arr(nnz, stream),
-      vals_arr(nnz, stream),
+      Index_Type n_rows                   = 0,
+      Index_Type n_cols                   = 0,
+      bool init                           = true,
+      rmm::mr::device_memory_resource* mr = rmm::mr::get_current_device_resource())
+    : rows_arr(nnz, stream, mr),
+      cols_arr(nnz, stream, mr),
+      vals_arr(nnz, stream, mr),
       nnz(nnz),
       n_rows(n_rows),
-      n_cols(n_cols)
+      n_cols(n_cols),
+      sorted(false),
+      unique(false)
   {
     if (init) init_arrays(stream);
   }
@@ -223,6 +262,11 @@ class COO {
    * @param n_cols: number of columns in the dense matrix
    * @param init: should values be initialized to 0?
    * @param stream: stream to use for init
+   *
+   * Note: shrinking to a smaller nnz keeps the existing allocation, and
+   * growing within a previously reserved capacity does not reallocate, so a
+   * COO reused across iterations reaches a steady state with no allocator
+   * traffic.
    */
   void allocate(int nnz, int n_rows, int n_cols, bool init, cudaStream_t stream)
   {
@@ -230,12 +274,51 @@ class COO {
     this->n_cols = n_cols;
     this->nnz    = nnz;
 
+    // contents are about to be rewritten, so any established invariants no
+    // longer hold until the producer re-asserts them
+    this->sorted = false;
+    this->unique = false;
+
     this->rows_arr.resize(this->nnz, stream);
     this->cols_arr.resize(this->nnz, stream);
     this->vals_arr.resize(this->nnz, stream);
 
     if (init) init_arrays(stream);
   }
+
+  /**
+   * @brief Grow the capacity of the underlying arrays without changing nnz,
+   * so that subsequent allocate() calls up to this capacity are realloc-free
+   * @param nnz: number of elements to reserve room for
+   * @param stream: CUDA stream to use
+   */
+  void reserve(Index_Type nnz, cudaStream_t stream)
+  {
+    this->rows_arr.reserve(nnz, stream);
+    this->cols_arr.reserve(nnz, stream);
+    this->vals_arr.reserve(nnz, stream);
+  }
+
+  /**
+   * @brief Number of elements the underlying arrays can hold without
+   * reallocating
+   */
+  Index_Type capacity() const
+  {
+    return std::min(Index_Type(this->rows_arr.capacity()), Index_Type(this->vals_arr.capacity()));
+  }
+
+  /**
+   * @brief Release capacity held beyond the current nnz back to the
+   * memory resource
+   * @param stream: CUDA stream to use
+   */
+  void shrink_to_fit(cudaStream_t stream)
+  {
+    this->rows_arr.shrink_to_fit(stream);
+    this->cols_arr.shrink_to_fit(stream);
+    this->vals_arr.shrink_to_fit(stream);
+  }
 };
 
 };  // namespace detail
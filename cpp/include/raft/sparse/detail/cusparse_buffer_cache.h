@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cusparse_v2.h>
+
+#include <raft/cudart_utils.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace raft {
+namespace sparse {
+namespace detail {
+
+/** cusparse operations that size their workspaces through the buffer cache */
+enum class cusparse_cached_op : int { csr2csc = 0, spgemm = 1 };
+
+/**
+ * Identifies a class of workspace requirements: the operation, the matrix
+ * shape, the value type width and the nnz rounded up to its power-of-two
+ * class. The nnz a size was actually computed for is tracked inside the
+ * cache entry, so calls within the same class reuse the sizing of the
+ * largest nnz seen and only a genuinely larger matrix re-sizes.
+ */
+struct cusparse_buffer_key {
+  int op;
+  int64_t m, n;
+  int64_t nnz_class;
+  size_t value_size;
+
+  bool operator==(const cusparse_buffer_key& other) const
+  {
+    return op == other.op && m == other.m && n == other.n && nnz_class == other.nnz_class &&
+           value_size == other.value_size;
+  }
+};
+
+struct cusparse_buffer_key_hash {
+  size_t operator()(const cusparse_buffer_key& key) const
+  {
+    size_t h = key.op;
+    h        = h * 0x9e3779b97f4a7c15ULL + key.m;
+    h        = h * 0x9e3779b97f4a7c15ULL + key.n;
+    h        = h * 0x9e3779b97f4a7c15ULL + key.nnz_class;
+    h        = h * 0x9e3779b97f4a7c15ULL + key.value_size;
+    return h;
+  }
+};
+
+/** Rounds nnz up to its power-of-two class. */
+inline int64_t cusparse_nnz_class(int64_t nnz)
+{
+  int64_t c = 1;
+  while (c < nnz)
+    c <<= 1;
+  return c;
+}
+
+/**
+ * Grow-only workspace cache for cusparse calls made through a single
+ * cusparse handle. Buffer sizes are remembered per key, so steady-state
+ * iterations over same-shaped matrices skip both the bufferSize call and
+ * the allocation entirely.
+ *
+ * The cache owns raw cudaMalloc memory rather than rmm allocations
+ * because it can outlive any memory resource scope the caller sets up.
+ * The returned workspace stays valid until the next get_workspace call
+ * on the same cusparse handle, which matches how operations on one
+ * handle serialize on its stream.
+ */
+class cusparse_buffer_cache {
+ public:
+  cusparse_buffer_cache()                             = default;
+  cusparse_buffer_cache(const cusparse_buffer_cache&) = delete;
+  cusparse_buffer_cache& operator=(const cusparse_buffer_cache&) = delete;
+
+  ~cusparse_buffer_cache()
+  {
+    // best effort: at process teardown the context may already be gone
+    if (buffer_ != nullptr) { cudaFree(buffer_); }
+  }
+
+  /**
+   * Returns a workspace at least as large as `size_fn()` requires,
+   * consulting the cached sizing when this class of matrix has been
+   * sized before. `size_fn` is only invoked on a cache miss (or when the
+   * nnz exceeds every previously sized nnz of its class).
+   */
+  template <typename SizeFn>
+  void* get_workspace(const cusparse_buffer_key& key, int64_t nnz, SizeFn size_fn)
+  {
+    std::lock_guard<std::mutex> _(mutex_);
+
+    size_t size;
+    auto it = sizes_.find(key);
+    if (it != sizes_.end() && nnz <= it->second.sized_nnz) {
+      size = it->second.size;
+    } else {
+      size        = size_fn();
+      sizes_[key] = {nnz, size};
+    }
+
+    if (size > buffer_size_) {
+      if (buffer_ != nullptr) {
+        RAFT_CUDA_TRY(cudaFree(buffer_));
+        buffer_      = nullptr;
+        buffer_size_ = 0;
+      }
+      RAFT_CUDA_TRY(cudaMalloc(&buffer_, size));
+      buffer_size_ = size;
+    }
+    return buffer_;
+  }
+
+ private:
+  struct sizing {
+    int64_t sized_nnz;
+    size_t size;
+  };
+
+  std::mutex mutex_;
+  std::unordered_map<cusparse_buffer_key, sizing, cusparse_buffer_key_hash> sizes_;
+  void* buffer_       = nullptr;
+  size_t buffer_size_ = 0;
+};
+
+/**
+ * Returns the buffer cache associated with a cusparse handle, creating
+ * it on first use. Caches live for the process; a workload that churns
+ * through many short-lived handles retains one (empty or sized) cache
+ * per handle it touched.
+ */
+inline cusparse_buffer_cache& get_cusparse_buffer_cache(cusparseHandle_t handle)
+{
+  static std::mutex map_mutex;
+  static std::unordered_map<cusparseHandle_t, std::unique_ptr<cusparse_buffer_cache>> caches;
+
+  std::lock_guard<std::mutex> _(map_mutex);
+  auto& entry = caches[handle];
+  if (!entry) { entry = std::make_unique<cusparse_buffer_cache>(); }
+  return *entry;
+}
+
+};  // namespace detail
+};  // namespace sparse
+};  // namespace raft
@@ -1581,6 +1581,209 @@ inline cusparseStatus_t cusparsecsrgemm2(cusparseHandle_t handle,
 
 /** @} */
 
+/**
+ * @defgroup spgemm cusparse generic spgemm operations
+ * @{
+ */
+
+template <typename T>
+cusparseStatus_t cusparsespgemm_workestimation(cusparseHandle_t handle,
+                                               cusparseOperation_t opA,
+                                               cusparseOperation_t opB,
+                                               const T* alpha,
+                                               cusparseSpMatDescr_t matA,
+                                               cusparseSpMatDescr_t matB,
+                                               const T* beta,
+                                               cusparseSpMatDescr_t matC,
+                                               cusparseSpGEMMAlg_t alg,
+                                               cusparseSpGEMMDescr_t spgemmDescr,
+                                               size_t* bufferSize1,
+                                               void* externalBuffer1,
+                                               cudaStream_t stream);
+template <>
+inline cusparseStatus_t cusparsespgemm_workestimation(cusparseHandle_t handle,
+                                                      cusparseOperation_t opA,
+                                                      cusparseOperation_t opB,
+                                                      const float* alpha,
+                                                      cusparseSpMatDescr_t matA,
+                                                      cusparseSpMatDescr_t matB,
+                                                      const float* beta,
+                                                      cusparseSpMatDescr_t matC,
+                                                      cusparseSpGEMMAlg_t alg,
+                                                      cusparseSpGEMMDescr_t spgemmDescr,
+                                                      size_t* bufferSize1,
+                                                      void* externalBuffer1,
+                                                      cudaStream_t stream)
+{
+  CUSPARSE_CHECK(cusparseSetStream(handle, stream));
+  return cusparseSpGEMM_workEstimation(handle,
+                                       opA,
+                                       opB,
+                                       alpha,
+                                       matA,
+                                       matB,
+                                       beta,
+                                       matC,
+                                       CUDA_R_32F,
+                                       alg,
+                                       spgemmDescr,
+                                       bufferSize1,
+                                       externalBuffer1);
+}
+template <>
+inline cusparseStatus_t cusparsespgemm_workestimation(cusparseHandle_t handle,
+                                                      cusparseOperation_t opA,
+                                                      cusparseOperation_t opB,
+                                                      const double* alpha,
+                                                      cusparseSpMatDescr_t matA,
+                                                      cusparseSpMatDescr_t matB,
+                                                      const double* beta,
+                                                      cusparseSpMatDescr_t matC,
+                                                      cusparseSpGEMMAlg_t alg,
+                                                      cusparseSpGEMMDescr_t spgemmDescr,
+                                                      size_t* bufferSize1,
+                                                      void* externalBuffer1,
+                                                      cudaStream_t stream)
+{
+  CUSPARSE_CHECK(cusparseSetStream(handle, stream));
+  return cusparseSpGEMM_workEstimation(handle,
+                                       opA,
+                                       opB,
+                                       alpha,
+                                       matA,
+                                       matB,
+                                       beta,
+                                       matC,
+                                       CUDA_R_64F,
+                                       alg,
+                                       spgemmDescr,
+                                       bufferSize1,
+                                       externalBuffer1);
+}
+
+template <typename T>
+cusparseStatus_t cusparsespgemm_compute(cusparseHandle_t handle,
+                                        cusparseOperation_t opA,
+                                        cusparseOperation_t opB,
+                                        const T* alpha,
+                                        cusparseSpMatDescr_t matA,
+                                        cusparseSpMatDescr_t matB,
+                                        const T* beta,
+                                        cusparseSpMatDescr_t matC,
+                                        cusparseSpGEMMAlg_t alg,
+                                        cusparseSpGEMMDescr_t spgemmDescr,
+                                        size_t* bufferSize2,
+                                        void* externalBuffer2,
+                                        cudaStream_t stream);
+template <>
+inline cusparseStatus_t cusparsespgemm_compute(cusparseHandle_t handle,
+                                               cusparseOperation_t opA,
+                                               cusparseOperation_t opB,
+                                               const float* alpha,
+                                               cusparseSpMatDescr_t matA,
+                                               cusparseSpMatDescr_t matB,
+                                               const float* beta,
+                                               cusparseSpMatDescr_t matC,
+                                               cusparseSpGEMMAlg_t alg,
+                                               cusparseSpGEMMDescr_t spgemmDescr,
+                                               size_t* bufferSize2,
+                                               void* externalBuffer2,
+                                               cudaStream_t stream)
+{
+  CUSPARSE_CHECK(cusparseSetStream(handle, stream));
+  return cusparseSpGEMM_compute(handle,
+                                opA,
+                                opB,
+                                alpha,
+                                matA,
+                                matB,
+                                beta,
+                                matC,
+                                CUDA_R_32F,
+                                alg,
+                                spgemmDescr,
+                                bufferSize2,
+                                externalBuffer2);
+}
+template <>
+inline cusparseStatus_t cusparsespgemm_compute(cusparseHandle_t handle,
+                                               cusparseOperation_t opA,
+                                               cusparseOperation_t opB,
+                                               const double* alpha,
+                                               cusparseSpMatDescr_t matA,
+                                               cusparseSpMatDescr_t matB,
+                                               const double* beta,
+                                               cusparseSpMatDescr_t matC,
+                                               cusparseSpGEMMAlg_t alg,
+                                               cusparseSpGEMMDescr_t spgemmDescr,
+                                               size_t* bufferSize2,
+                                               void* externalBuffer2,
+                                               cudaStream_t stream)
+{
+  CUSPARSE_CHECK(cusparseSetStream(handle, stream));
+  return cusparseSpGEMM_compute(handle,
+                                opA,
+                                opB,
+                                alpha,
+                                matA,
+                                matB,
+                                beta,
+                                matC,
+                                CUDA_R_64F,
+                                alg,
+                                spgemmDescr,
+                                bufferSize2,
+                                externalBuffer2);
+}
+
+template <typename T>
+cusparseStatus_t cusparsespgemm_copy(cusparseHandle_t handle,
+                                     cusparseOperation_t opA,
+                                     cusparseOperation_t opB,
+                                     const T* alpha,
+                                     cusparseSpMatDescr_t matA,
+                                     cusparseSpMatDescr_t matB,
+                                     const T* beta,
+                                     cusparseSpMatDescr_t matC,
+                                     cusparseSpGEMMAlg_t alg,
+                                     cusparseSpGEMMDescr_t spgemmDescr,
+                                     cudaStream_t stream);
+template <>
+inline cusparseStatus_t cusparsespgemm_copy(cusparseHandle_t handle,
+                                            cusparseOperation_t opA,
+                                            cusparseOperation_t opB,
+                                            const float* alpha,
+                                            cusparseSpMatDescr_t matA,
+                                            cusparseSpMatDescr_t matB,
+                                            const float* beta,
+                                            cusparseSpMatDescr_t matC,
+                                            cusparseSpGEMMAlg_t alg,
+                                            cusparseSpGEMMDescr_t spgemmDescr,
+                                            cudaStream_t stream)
+{
+  CUSPARSE_CHECK(cusparseSetStream(handle, stream));
+  return cusparseSpGEMM_copy(
+    handle, opA, opB, alpha, matA, matB, beta, matC, CUDA_R_32F, alg, spgemmDescr);
+}
+template <>
+inline cusparseStatus_t cusparsespgemm_copy(cusparseHandle_t handle,
+                                            cusparseOperation_t opA,
+                                            cusparseOperation_t opB,
+                                            const double* alpha,
+                                            cusparseSpMatDescr_t matA,
+                                            cusparseSpMatDescr_t matB,
+                                            const double* beta,
+                                            cusparseSpMatDescr_t matC,
+                                            cusparseSpGEMMAlg_t alg,
+                                            cusparseSpGEMMDescr_t spgemmDescr,
+                                            cudaStream_t stream)
+{
+  CUSPARSE_CHECK(cusparseSetStream(handle, stream));
+  return cusparseSpGEMM_copy(
+    handle, opA, opB, alpha, matA, matB, beta, matC, CUDA_R_64F, alg, spgemmDescr);
+}
+/** @} */
+
 /**
  * @defgroup csrgemm2 cusparse sparse gemm operations
  * @{
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/cudart_utils.h>
+#include <raft/sparse/structure_stats.hpp>
+
+#include <rmm/device_uvector.hpp>
+#include <rmm/exec_policy.hpp>
+
+#include <thrust/functional.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/sort.h>
+#include <thrust/transform.h>
+#include <thrust/transform_reduce.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace raft {
+namespace sparse {
+namespace detail {
+
+/**
+ * Computes the row-structure summary of a CSR matrix from its row offsets.
+ * One pass over the offsets extracts the row lengths, a sort of the lengths
+ * yields the max and 99th percentile, and a transform-reduce yields the
+ * second moment for the standard deviation.
+ *
+ * @param[in] indptr CSR row offsets array [on device] [len = n_rows + 1]
+ * @param[in] n_rows number of rows
+ * @param[in] nnz number of nonzeros
+ * @param[in] stream cuda stream
+ * @return the populated summary (synchronizes the stream)
+ */
+template <typename value_idx>
+structure_stats_t<value_idx> compute_structure_stats(const value_idx* indptr,
+                                                     value_idx n_rows,
+                                                     value_idx nnz,
+                                                     cudaStream_t stream)
+{
+  structure_stats_t<value_idx> stats;
+  stats.n_rows = n_rows;
+  stats.nnz    = nnz;
+  if (n_rows == 0 || nnz == 0) { return stats; }
+
+  rmm::device_uvector<value_idx> row_lengths(n_rows, stream);
+  thrust::transform(rmm::exec_policy(stream),
+                    thrust::make_counting_iterator<value_idx>(0),
+                    thrust::make_counting_iterator<value_idx>(n_rows),
+                    row_lengths.data(),
+                    [indptr] __device__(value_idx i) { return indptr[i + 1] - indptr[i]; });
+
+  double sq_mean = thrust::transform_reduce(
+                     rmm::exec_policy(stream),
+                     row_lengths.data(),
+                     row_lengths.data() + n_rows,
+                     [] __device__(value_idx len) { return double(len) * len; },
+                     0.0,
+                     thrust::plus<double>()) /
+                   n_rows;
+
+  thrust::sort(rmm::exec_policy(stream), row_lengths.data(), row_lengths.data() + n_rows);
+  value_idx p99_idx = std::min(n_rows - 1, value_idx(0.99 * n_rows));
+  raft::update_host(&stats.max_row_len, row_lengths.data() + n_rows - 1, 1, stream);
+  raft::update_host(&stats.p99_row_len, row_lengths.data() + p99_idx, 1, stream);
+  RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+
+  stats.mean_row_len = double(nnz) / n_rows;
+  stats.row_len_std  = std::sqrt(std::max(0.0, sq_mean - stats.mean_row_len * stats.mean_row_len));
+  return stats;
+}
+
+}  // namespace detail
+}  // namespace sparse
+}  // namespace raft
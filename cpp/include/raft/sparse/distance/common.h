@@ -17,6 +17,9 @@
 #pragma once
 
 #include <raft/handle.hpp>
+#include <raft/sparse/structure_stats.hpp>
+
+#include <optional>
 
 namespace raft {
 namespace sparse {
@@ -42,6 +45,11 @@ struct distances_config_t {
   value_idx* b_indices;
   value_t* b_data;
 
+  // cached row-structure summaries, consulted by the kernel strategy
+  // choosers; filled lazily on first use when not provided by the caller
+  mutable std::optional<structure_stats_t<value_idx>> a_stats;
+  mutable std::optional<structure_stats_t<value_idx>> b_stats;
+
   const raft::handle_t& handle;
 };
 
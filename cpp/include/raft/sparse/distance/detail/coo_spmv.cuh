@@ -18,6 +18,7 @@
 
 #include "coo_spmv_strategies/dense_smem_strategy.cuh"
 #include "coo_spmv_strategies/hash_strategy.cuh"
+#include "coo_spmv_strategies/merge_path_strategy.cuh"
 
 #include <raft/cuda_utils.cuh>
 #include <raft/cudart_utils.h>
@@ -25,6 +26,7 @@
 
 #include "../../csr.hpp"
 #include "../../detail/utils.h"
+#include "../../structure_stats.cuh"
 #include "../common.h"
 
 #include <limits.h>
@@ -119,8 +121,19 @@ inline void balanced_coo_pairwise_generalized_spmv(
   int max_cols = max_cols_per_block<value_idx, value_t>();
 
   if (max_cols > config_.a_ncols) {
-    dense_smem_strategy<value_idx, value_t, threads_per_block> strategy(config_);
-    strategy.dispatch(out_dists, coo_rows_b, product_func, accum_func, write_func, chunk_size);
+    if (!config_.b_stats) {
+      config_.b_stats = raft::sparse::detail::compute_structure_stats(
+        config_.b_indptr, config_.b_nrows, config_.b_nnz, config_.handle.get_stream());
+    }
+    // skewed row lengths serialize the COO chunking; split the nonzeros with
+    // the merge path instead so every CTA receives equal work
+    if (config_.b_stats->has_high_row_length_variance()) {
+      merge_path_strategy<value_idx, value_t, threads_per_block> strategy(config_);
+      strategy.dispatch(out_dists, coo_rows_b, product_func, accum_func, write_func, chunk_size);
+    } else {
+      dense_smem_strategy<value_idx, value_t, threads_per_block> strategy(config_);
+      strategy.dispatch(out_dists, coo_rows_b, product_func, accum_func, write_func, chunk_size);
+    }
   } else {
     hash_strategy<value_idx, value_t, threads_per_block> strategy(config_);
     strategy.dispatch(out_dists, coo_rows_b, product_func, accum_func, write_func, chunk_size);
@@ -202,8 +215,19 @@ inline void balanced_coo_pairwise_generalized_spmv_rev(
   int max_cols = max_cols_per_block<value_idx, value_t>();
 
   if (max_cols > config_.b_ncols) {
-    dense_smem_strategy<value_idx, value_t, threads_per_block> strategy(config_);
-    strategy.dispatch_rev(out_dists, coo_rows_a, product_func, accum_func, write_func, chunk_size);
+    if (!config_.a_stats) {
+      config_.a_stats = raft::sparse::detail::compute_structure_stats(
+        config_.a_indptr, config_.a_nrows, config_.a_nnz, config_.handle.get_stream());
+    }
+    if (config_.a_stats->has_high_row_length_variance()) {
+      merge_path_strategy<value_idx, value_t, threads_per_block> strategy(config_);
+      strategy.dispatch_rev(
+        out_dists, coo_rows_a, product_func, accum_func, write_func, chunk_size);
+    } else {
+      dense_smem_strategy<value_idx, value_t, threads_per_block> strategy(config_);
+      strategy.dispatch_rev(
+        out_dists, coo_rows_a, product_func, accum_func, write_func, chunk_size);
+    }
   } else {
     hash_strategy<value_idx, value_t, threads_per_block> strategy(config_);
     strategy.dispatch_rev(out_dists, coo_rows_a, product_func, accum_func, write_func, chunk_size);
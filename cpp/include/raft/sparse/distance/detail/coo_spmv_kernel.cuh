@@ -145,6 +145,7 @@ __global__ void balanced_coo_generalized_spmv_kernel(strategy_t strategy,
   __syncthreads();
 
   auto finder = strategy.init_find(A, dim);
+  auto filter = strategy.init_filter(cur_row_a);
 
   if (cur_row_a > m || cur_chunk_offset > n_blocks_per_row) return;
   if (ind >= nnz_b) return;
@@ -171,7 +172,8 @@ __global__ void balanced_coo_generalized_spmv_kernel(strategy_t strategy,
     auto in_bounds = indptrA.check_indices_bounds(start_index_a, stop_index_a, index_b);
 
     if (in_bounds) {
-      value_t a_col = strategy.find(finder, index_b);
+      value_t a_col = 0.0;
+      if (strategy.check_filter(filter, index_b)) { a_col = strategy.find(finder, index_b); }
       if (!rev || a_col == 0.0) { c = product_func(a_col, dataB[ind]); }
     }
   }
@@ -209,7 +211,8 @@ __global__ void balanced_coo_generalized_spmv_kernel(strategy_t strategy,
       auto index_b   = indicesB[ind];
       auto in_bounds = indptrA.check_indices_bounds(start_index_a, stop_index_a, index_b);
       if (in_bounds) {
-        value_t a_col = strategy.find(finder, index_b);
+        value_t a_col = 0.0;
+        if (strategy.check_filter(filter, index_b)) { a_col = strategy.find(finder, index_b); }
 
         if (!rev || a_col == 0.0) { c = accum_func(c, product_func(a_col, dataB[ind])); }
       }
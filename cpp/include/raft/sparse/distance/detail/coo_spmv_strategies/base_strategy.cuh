@@ -36,6 +36,22 @@ class coo_spmv_strategy {
     smem = raft::getSharedMemPerBlock();
   }
 
+  /**
+   * Per-row candidate filter consulted by the spmv kernel before each
+   * shared memory lookup. The base strategy accepts every candidate;
+   * strategies that can cheaply prove a column is absent from the
+   * current row of A override this.
+   */
+  struct filter_type {
+  };
+
+  __device__ inline filter_type init_filter(const value_idx& row) { return filter_type(); }
+
+  __device__ inline bool check_filter(const filter_type& filter, const value_idx& key)
+  {
+    return true;
+  }
+
   template <typename strategy_t,
             typename indptr_it,
             typename product_f,
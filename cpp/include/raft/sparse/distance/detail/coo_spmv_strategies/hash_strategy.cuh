@@ -18,11 +18,15 @@
 
 #include "base_strategy.cuh"
 
+#include <raft/cuda_utils.cuh>
+
 #include <cuco/static_map.cuh>
 
 #include <thrust/copy.h>
 #include <thrust/iterator/counting_iterator.h>
 
+#include <cstdint>
+
 // this is needed by cuco as key, value must be bitwise comparable.
 // compilers don't declare float/double as bitwise comparable
 // but that is too strict
@@ -38,6 +42,55 @@ namespace sparse {
 namespace distance {
 namespace detail {
 
+/** number of 64-bit words in a per-row bloom signature */
+constexpr int bloom_signature_words = 2;
+
+/** 64-bit mix supplying both probe bits of a bloom signature */
+DI uint64_t bloom_mix_64(uint64_t key)
+{
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdULL;
+  key ^= key >> 33;
+  key *= 0xc4ceb9fe1a85ec53ULL;
+  key ^= key >> 33;
+  return key;
+}
+
+/**
+ * Builds a 128-bit bloom signature over the column set of each CSR row:
+ * one probe bit per signature word, both drawn from a single mix of the
+ * column index. One block per row; the signatures are consulted in the
+ * spmv kernel to skip hash table probes for columns provably absent
+ * from the current row.
+ */
+template <typename value_idx>
+__global__ void build_bloom_signatures_kernel(const value_idx* indptr,
+                                              const value_idx* indices,
+                                              uint64_t* signatures,
+                                              value_idx n_rows)
+{
+  __shared__ uint64_t sig[bloom_signature_words];
+
+  value_idx row = blockIdx.x;
+  if (threadIdx.x < bloom_signature_words) { sig[threadIdx.x] = 0; }
+  __syncthreads();
+
+  uint64_t local0 = 0, local1 = 0;
+  for (value_idx i = indptr[row] + threadIdx.x; i < indptr[row + 1]; i += blockDim.x) {
+    uint64_t h = bloom_mix_64((uint64_t)indices[i]);
+    local0 |= uint64_t{1} << (h & 63);
+    local1 |= uint64_t{1} << ((h >> 6) & 63);
+  }
+
+  atomicOr((unsigned long long*)&sig[0], (unsigned long long)local0);
+  atomicOr((unsigned long long*)&sig[1], (unsigned long long)local1);
+  __syncthreads();
+
+  if (threadIdx.x < bloom_signature_words) {
+    signatures[row * bloom_signature_words + threadIdx.x] = sig[threadIdx.x];
+  }
+}
+
 template <typename value_idx, typename value_t, int tpb>
 class hash_strategy : public coo_spmv_strategy<value_idx, value_t, tpb> {
  public:
@@ -94,6 +147,15 @@ class hash_strategy : public coo_spmv_strategy<value_idx, value_t, tpb> {
                                                this->config.handle.get_stream());
     std::tuple<value_idx, value_idx> n_rows_divided;
 
+    // high-sparsity inputs rarely intersect: a per-row bloom signature,
+    // tested in registers for each candidate column, skips the hash table
+    // probe for provably-disjoint (row, column) pairs
+    rmm::device_uvector<uint64_t> bloom(bloom_signature_words * this->config.a_nrows,
+                                        this->config.handle.get_stream());
+    build_bloom_signatures(
+      this->config.a_indptr, this->config.a_indices, this->config.a_nrows, bloom.data());
+    bloom_signatures = bloom.data();
+
     chunking_needed(this->config.a_indptr,
                     this->config.a_nrows,
                     mask_indptr,
@@ -167,6 +229,13 @@ class hash_strategy : public coo_spmv_strategy<value_idx, value_t, tpb> {
                                                this->config.handle.get_stream());
     std::tuple<value_idx, value_idx> n_rows_divided;
 
+    // the reverse pass builds its shared memory rows from B
+    rmm::device_uvector<uint64_t> bloom(bloom_signature_words * this->config.b_nrows,
+                                        this->config.handle.get_stream());
+    build_bloom_signatures(
+      this->config.b_indptr, this->config.b_indices, this->config.b_nrows, bloom.data());
+    bloom_signatures = bloom.data();
+
     chunking_needed(this->config.b_indptr,
                     this->config.b_nrows,
                     mask_indptr,
@@ -258,6 +327,30 @@ class hash_strategy : public coo_spmv_strategy<value_idx, value_t, tpb> {
     return a_col;
   }
 
+  /** bloom signature of the current row of A, held in registers */
+  struct filter_type {
+    uint64_t sig0, sig1;
+  };
+
+  __device__ inline filter_type init_filter(const value_idx& row)
+  {
+    filter_type filter;
+    if (bloom_signatures != nullptr) {
+      filter.sig0 = bloom_signatures[row * bloom_signature_words];
+      filter.sig1 = bloom_signatures[row * bloom_signature_words + 1];
+    } else {
+      // accept everything when no signatures were built
+      filter.sig0 = filter.sig1 = ~uint64_t{0};
+    }
+    return filter;
+  }
+
+  __device__ inline bool check_filter(const filter_type& filter, const value_idx& key)
+  {
+    uint64_t h = bloom_mix_64((uint64_t)key);
+    return ((filter.sig0 >> (h & 63)) & (filter.sig1 >> ((h >> 6) & 63)) & 1) != 0;
+  }
+
   struct fits_in_hash_table {
    public:
     fits_in_hash_table(const value_idx* indptr_, value_idx degree_l_, value_idx degree_r_)
@@ -284,8 +377,19 @@ class hash_strategy : public coo_spmv_strategy<value_idx, value_t, tpb> {
   }
 
  private:
+  void build_bloom_signatures(const value_idx* indptr,
+                              const value_idx* indices,
+                              value_idx n_rows,
+                              uint64_t* signatures)
+  {
+    if (n_rows < 1) { return; }
+    build_bloom_signatures_kernel<<<n_rows, 128, 0, this->config.handle.get_stream()>>>(
+      indptr, indices, signatures, n_rows);
+  }
+
   float capacity_threshold;
   int map_size;
+  const uint64_t* bloom_signatures = nullptr;
 };
 
 }  // namespace detail
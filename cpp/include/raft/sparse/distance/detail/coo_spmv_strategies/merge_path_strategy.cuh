@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "base_strategy.cuh"
+
+namespace raft {
+namespace sparse {
+namespace distance {
+namespace detail {
+
+/**
+ * Finds the starting coordinate of a diagonal in the merge decision path
+ * formed by the row-end offsets of a CSR matrix (lengths a_len) and the
+ * natural numbers 0..b_len-1 enumerating its nonzeros. On return `row` is the
+ * row containing the diagonal and `nz` the next nonzero to consume.
+ */
+template <typename value_idx>
+DI void merge_path_search(value_idx diag,
+                          value_idx a_len,
+                          value_idx b_len,
+                          const value_idx* row_end_offsets,
+                          value_idx& row,
+                          value_idx& nz)
+{
+  value_idx x_min = max(diag - b_len, (value_idx)0);
+  value_idx x_max = min(diag, a_len);
+  while (x_min < x_max) {
+    value_idx pivot = (x_min + x_max) >> 1;
+    if (row_end_offsets[pivot] <= diag - pivot - 1) {
+      x_min = pivot + 1;
+    } else {
+      x_max = pivot;
+    }
+  }
+  row = x_min;
+  nz  = diag - x_min;
+}
+
+/**
+ * Merge-path flavor of the balanced COO SPMV kernel: the merged side is
+ * consumed in CSR form and every thread takes exactly `items_per_thread`
+ * items of the merge decision path (a nonzero or a row boundary), so CTAs
+ * receive equal work regardless of how skewed the row lengths are. Rows that
+ * straddle a thread or CTA boundary are combined through the atomic
+ * write_func, which removes the need for the segmented reductions of
+ * `balanced_coo_generalized_spmv_kernel`.
+ */
+template <typename strategy_t,
+          typename value_idx,
+          typename value_t,
+          bool rev,
+          int tpb,
+          int items_per_thread,
+          typename product_f,
+          typename accum_f,
+          typename write_f>
+__global__ void balanced_merge_path_spmv_kernel(strategy_t strategy,
+                                                value_idx* indptrA,
+                                                value_idx* indicesA,
+                                                value_t* dataA,
+                                                value_idx* row_end_offsets_b,
+                                                value_idx* indicesB,
+                                                value_t* dataB,
+                                                value_idx m,
+                                                value_idx n,
+                                                int dim,
+                                                value_idx nnz_b,
+                                                value_t* out,
+                                                int n_merge_tiles,
+                                                product_f product_func,
+                                                accum_f accum_func,
+                                                write_f write_func)
+{
+  value_idx cur_row_a = blockIdx.x / n_merge_tiles;
+  value_idx cur_tile  = blockIdx.x % n_merge_tiles;
+
+  extern __shared__ char smem[];
+  typename strategy_t::smem_type A = (typename strategy_t::smem_type)smem;
+
+  auto inserter = strategy.init_insert(A, dim);
+
+  __syncthreads();
+
+  // Convert current row vector in A to dense
+  value_idx start_offset_a = indptrA[cur_row_a];
+  value_idx stop_offset_a  = indptrA[cur_row_a + 1];
+  for (value_idx i = start_offset_a + threadIdx.x; i < stop_offset_a; i += blockDim.x) {
+    strategy.insert(inserter, indicesA[i], dataA[i]);
+  }
+
+  __syncthreads();
+
+  auto finder = strategy.init_find(A, dim);
+
+  const value_idx path_len = n + nnz_b;
+  value_idx tid            = cur_tile * tpb + (value_idx)threadIdx.x;
+  value_idx diag           = tid * (value_idx)items_per_thread;
+  if (diag >= path_len) return;
+  const value_idx diag_end = min(diag + (value_idx)items_per_thread, path_len);
+
+  value_idx cur_row_b, ind;
+  merge_path_search(diag, n, nnz_b, row_end_offsets_b, cur_row_b, ind);
+
+  value_t c = 0.0;
+  for (; diag < diag_end; ++diag) {
+    if (ind < row_end_offsets_b[cur_row_b]) {
+      // consume a nonzero of the current row
+      value_t a_col = strategy.find(finder, indicesB[ind]);
+      if (!rev || a_col == 0.0) { c = accum_func(c, product_func(a_col, dataB[ind])); }
+      ++ind;
+    } else {
+      // row boundary: this thread owns the row's tail, write it out
+      if (c != 0.0) {
+        size_t idx = !rev ? (size_t)cur_row_a * n + cur_row_b : (size_t)cur_row_b * m + cur_row_a;
+        write_func(out + idx, c);
+        c = 0.0;
+      }
+      ++cur_row_b;
+    }
+  }
+
+  // carry-out for a row split across diagonals
+  if (c != 0.0) {
+    size_t idx = !rev ? (size_t)cur_row_a * n + cur_row_b : (size_t)cur_row_b * m + cur_row_a;
+    write_func(out + idx, c);
+  }
+}
+
+/**
+ * This strategy assigns work by splitting the merge decision path of the
+ * non-cached side's CSR structure (row offsets merged with the nonzero
+ * sequence) evenly across threads, following the merge-path SpMV
+ * formulation. Unlike the COO chunking of the other strategies, a long row
+ * cannot serialize a CTA: power-law row distributions get the same number of
+ * merge items per thread as uniform ones. The cached side is stored densely
+ * in shared memory, so this strategy applies under the same column limit as
+ * dense_smem_strategy.
+ *
+ * Reference: Merrill & Garland, "Merge-based Parallel Sparse Matrix-Vector
+ * Multiplication", SC'16.
+ */
+template <typename value_idx, typename value_t, int tpb>
+class merge_path_strategy : public coo_spmv_strategy<value_idx, value_t, tpb> {
+ public:
+  using smem_type   = value_t*;
+  using insert_type = smem_type;
+  using find_type   = smem_type;
+
+  // merge items (nonzeros + row boundaries) consumed by each thread
+  static constexpr int items_per_thread = 8;
+
+  merge_path_strategy(const distances_config_t<value_idx, value_t>& config_)
+    : coo_spmv_strategy<value_idx, value_t, tpb>(config_)
+  {
+  }
+
+  inline static int smem_per_block(int n_cols) { return n_cols * sizeof(value_t); }
+
+  template <typename product_f, typename accum_f, typename write_f>
+  void dispatch(value_t* out_dists,
+                value_idx* coo_rows_b,
+                product_f product_func,
+                accum_f accum_func,
+                write_f write_func,
+                int chunk_size)
+  {
+    // chunk_size does not apply: the merge path fixes the work per thread
+    _dispatch_merge_path<false>(out_dists,
+                                this->config.a_indptr,
+                                this->config.a_indices,
+                                this->config.a_data,
+                                this->config.b_indptr,
+                                this->config.b_indices,
+                                this->config.b_data,
+                                this->config.a_nrows,
+                                this->config.b_nrows,
+                                this->config.b_ncols,
+                                this->config.b_nnz,
+                                product_func,
+                                accum_func,
+                                write_func);
+  }
+
+  template <typename product_f, typename accum_f, typename write_f>
+  void dispatch_rev(value_t* out_dists,
+                    value_idx* coo_rows_a,
+                    product_f product_func,
+                    accum_f accum_func,
+                    write_f write_func,
+                    int chunk_size)
+  {
+    _dispatch_merge_path<true>(out_dists,
+                               this->config.b_indptr,
+                               this->config.b_indices,
+                               this->config.b_data,
+                               this->config.a_indptr,
+                               this->config.a_indices,
+                               this->config.a_data,
+                               this->config.b_nrows,
+                               this->config.a_nrows,
+                               this->config.a_ncols,
+                               this->config.a_nnz,
+                               product_func,
+                               accum_func,
+                               write_func);
+  }
+
+  __device__ inline insert_type init_insert(smem_type cache, const value_idx& cache_size)
+  {
+    for (int k = threadIdx.x; k < cache_size; k += blockDim.x) {
+      cache[k] = 0.0;
+    }
+    return cache;
+  }
+
+  __device__ inline void insert(insert_type cache, const value_idx& key, const value_t& value)
+  {
+    cache[key] = value;
+  }
+
+  __device__ inline find_type init_find(smem_type cache, const value_idx& cache_size)
+  {
+    return cache;
+  }
+
+  __device__ inline value_t find(find_type cache, const value_idx& key) { return cache[key]; }
+
+ private:
+  template <bool rev, typename product_f, typename accum_f, typename write_f>
+  void _dispatch_merge_path(value_t* out_dists,
+                            value_idx* indptr_a,
+                            value_idx* indices_a,
+                            value_t* data_a,
+                            value_idx* indptr_b,
+                            value_idx* indices_b,
+                            value_t* data_b,
+                            value_idx nrows_a,
+                            value_idx nrows_b,
+                            value_idx ncols_b,
+                            value_idx nnz_b,
+                            product_f product_func,
+                            accum_f accum_func,
+                            write_f write_func)
+  {
+    value_idx path_len = nrows_b + nnz_b;
+    int n_merge_tiles  = raft::ceildiv(path_len, (value_idx)(tpb * items_per_thread));
+    int n_blocks       = nrows_a * n_merge_tiles;
+
+    RAFT_CUDA_TRY(
+      cudaFuncSetCacheConfig(balanced_merge_path_spmv_kernel<merge_path_strategy,
+                                                             value_idx,
+                                                             value_t,
+                                                             rev,
+                                                             tpb,
+                                                             items_per_thread,
+                                                             product_f,
+                                                             accum_f,
+                                                             write_f>,
+                             cudaFuncCachePreferShared));
+
+    balanced_merge_path_spmv_kernel<merge_path_strategy,
+                                    value_idx,
+                                    value_t,
+                                    rev,
+                                    tpb,
+                                    items_per_thread>
+      <<<n_blocks, tpb, this->smem, this->config.handle.get_stream()>>>(*this,
+                                                                        indptr_a,
+                                                                        indices_a,
+                                                                        data_a,
+                                                                        indptr_b + 1,
+                                                                        indices_b,
+                                                                        data_b,
+                                                                        nrows_a,
+                                                                        nrows_b,
+                                                                        ncols_b,
+                                                                        nnz_b,
+                                                                        out_dists,
+                                                                        n_merge_tiles,
+                                                                        product_func,
+                                                                        accum_func,
+                                                                        write_func);
+  }
+};
+
+}  // namespace detail
+}  // namespace distance
+}  // namespace sparse
+}  // namespace raft
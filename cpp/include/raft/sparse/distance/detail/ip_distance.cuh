@@ -23,6 +23,7 @@
 #include <raft/sparse/detail/cusparse_wrappers.h>
 
 #include <raft/sparse/convert/coo.cuh>
+#include <raft/sparse/convert/dense.cuh>
 #include <raft/sparse/detail/utils.h>
 #include <raft/sparse/distance/common.h>
 #include <raft/sparse/distance/detail/coo_spmv.cuh>
@@ -60,6 +61,16 @@ class ip_distances_t : public distances_t<value_t> {
    */
   void compute(value_t* out_distances)
   {
+    /**
+     * Very sparse corpora waste most of the semiring probing on empty
+     * intersections; a cusparse SpGEMM of A * Bt touches only the
+     * nonzeros of the product.
+     */
+    if (very_sparse()) {
+      compute_spgemm(out_distances);
+      return;
+    }
+
     /**
      * Compute pairwise distances and return dense matrix in row-major format
      */
@@ -72,6 +83,157 @@ class ip_distances_t : public distances_t<value_t> {
   value_t* b_data_coo() { return config_->b_data; }
 
  private:
+  // both inputs below this density take the SpGEMM path
+  static constexpr double spgemm_density_threshold = 1e-4;
+
+  bool very_sparse() const
+  {
+    double density_a = double(config_->a_nnz) / (double(config_->a_nrows) * config_->a_ncols);
+    double density_b = double(config_->b_nnz) / (double(config_->b_nrows) * config_->b_ncols);
+    return density_a < spgemm_density_threshold && density_b < spgemm_density_threshold;
+  }
+
+  void compute_spgemm(value_t* out_distances)
+  {
+    auto stream          = config_->handle.get_stream();
+    auto cusparse_handle = config_->handle.get_cusparse_handle();
+
+    /**
+     * SpGEMM only supports non-transposed CSR operands, so materialize
+     * Bt once up front via the csc transpose.
+     */
+    rmm::device_uvector<value_idx> bt_indptr(config_->b_ncols + 1, stream);
+    rmm::device_uvector<value_idx> bt_indices(config_->b_nnz, stream);
+    rmm::device_uvector<value_t> bt_data(config_->b_nnz, stream);
+    raft::sparse::linalg::csr_transpose(config_->handle,
+                                        config_->b_indptr,
+                                        config_->b_indices,
+                                        config_->b_data,
+                                        bt_indptr.data(),
+                                        bt_indices.data(),
+                                        bt_data.data(),
+                                        config_->b_nrows,
+                                        config_->b_ncols,
+                                        config_->b_nnz,
+                                        stream);
+
+    cusparseSpMatDescr_t mat_a, mat_bt, mat_c;
+    RAFT_CUSPARSE_TRY(raft::sparse::detail::cusparsecreatecsr(&mat_a,
+                                                              int64_t(config_->a_nrows),
+                                                              int64_t(config_->a_ncols),
+                                                              int64_t(config_->a_nnz),
+                                                              config_->a_indptr,
+                                                              config_->a_indices,
+                                                              config_->a_data));
+    RAFT_CUSPARSE_TRY(raft::sparse::detail::cusparsecreatecsr(&mat_bt,
+                                                              int64_t(config_->b_ncols),
+                                                              int64_t(config_->b_nrows),
+                                                              int64_t(config_->b_nnz),
+                                                              bt_indptr.data(),
+                                                              bt_indices.data(),
+                                                              bt_data.data()));
+    RAFT_CUSPARSE_TRY(raft::sparse::detail::cusparsecreatecsr(&mat_c,
+                                                              int64_t(config_->a_nrows),
+                                                              int64_t(config_->b_nrows),
+                                                              int64_t(0),
+                                                              static_cast<value_idx*>(nullptr),
+                                                              static_cast<value_idx*>(nullptr),
+                                                              static_cast<value_t*>(nullptr)));
+
+    cusparseSpGEMMDescr_t spgemm_descr;
+    RAFT_CUSPARSE_TRY(cusparseSpGEMM_createDescr(&spgemm_descr));
+
+    value_t alpha = 1, beta = 0;
+    auto opA = CUSPARSE_OPERATION_NON_TRANSPOSE;
+    auto opB = CUSPARSE_OPERATION_NON_TRANSPOSE;
+    auto alg = CUSPARSE_SPGEMM_DEFAULT;
+
+    size_t buffer_size1 = 0, buffer_size2 = 0;
+    RAFT_CUSPARSE_TRY(raft::sparse::detail::cusparsespgemm_workestimation(cusparse_handle,
+                                                                          opA,
+                                                                          opB,
+                                                                          &alpha,
+                                                                          mat_a,
+                                                                          mat_bt,
+                                                                          &beta,
+                                                                          mat_c,
+                                                                          alg,
+                                                                          spgemm_descr,
+                                                                          &buffer_size1,
+                                                                          nullptr,
+                                                                          stream));
+    rmm::device_uvector<char> buffer1(buffer_size1, stream);
+    RAFT_CUSPARSE_TRY(raft::sparse::detail::cusparsespgemm_workestimation(cusparse_handle,
+                                                                          opA,
+                                                                          opB,
+                                                                          &alpha,
+                                                                          mat_a,
+                                                                          mat_bt,
+                                                                          &beta,
+                                                                          mat_c,
+                                                                          alg,
+                                                                          spgemm_descr,
+                                                                          &buffer_size1,
+                                                                          buffer1.data(),
+                                                                          stream));
+
+    RAFT_CUSPARSE_TRY(raft::sparse::detail::cusparsespgemm_compute(cusparse_handle,
+                                                                   opA,
+                                                                   opB,
+                                                                   &alpha,
+                                                                   mat_a,
+                                                                   mat_bt,
+                                                                   &beta,
+                                                                   mat_c,
+                                                                   alg,
+                                                                   spgemm_descr,
+                                                                   &buffer_size2,
+                                                                   nullptr,
+                                                                   stream));
+    rmm::device_uvector<char> buffer2(buffer_size2, stream);
+    RAFT_CUSPARSE_TRY(raft::sparse::detail::cusparsespgemm_compute(cusparse_handle,
+                                                                   opA,
+                                                                   opB,
+                                                                   &alpha,
+                                                                   mat_a,
+                                                                   mat_bt,
+                                                                   &beta,
+                                                                   mat_c,
+                                                                   alg,
+                                                                   spgemm_descr,
+                                                                   &buffer_size2,
+                                                                   buffer2.data(),
+                                                                   stream));
+
+    int64_t c_nrows, c_ncols, c_nnz;
+    RAFT_CUSPARSE_TRY(cusparseSpMatGetSize(mat_c, &c_nrows, &c_ncols, &c_nnz));
+
+    rmm::device_uvector<value_idx> c_indptr(c_nrows + 1, stream);
+    rmm::device_uvector<value_idx> c_indices(c_nnz, stream);
+    rmm::device_uvector<value_t> c_data(c_nnz, stream);
+    RAFT_CUSPARSE_TRY(
+      cusparseCsrSetPointers(mat_c, c_indptr.data(), c_indices.data(), c_data.data()));
+    RAFT_CUSPARSE_TRY(raft::sparse::detail::cusparsespgemm_copy(
+      cusparse_handle, opA, opB, &alpha, mat_a, mat_bt, &beta, mat_c, alg, spgemm_descr, stream));
+
+    raft::sparse::convert::csr_to_dense(cusparse_handle,
+                                        config_->a_nrows,
+                                        config_->b_nrows,
+                                        value_idx(c_nnz),
+                                        c_indptr.data(),
+                                        c_indices.data(),
+                                        c_data.data(),
+                                        config_->a_nrows,
+                                        out_distances,
+                                        stream,
+                                        true);
+
+    RAFT_CUSPARSE_TRY_NO_THROW(cusparseSpGEMM_destroyDescr(spgemm_descr));
+    RAFT_CUSPARSE_TRY_NO_THROW(cusparseDestroySpMat(mat_a));
+    RAFT_CUSPARSE_TRY_NO_THROW(cusparseDestroySpMat(mat_bt));
+    RAFT_CUSPARSE_TRY_NO_THROW(cusparseDestroySpMat(mat_c));
+  }
+
   const distances_config_t<value_idx, value_t>* config_;
   rmm::device_uvector<value_idx> coo_rows_b;
 };
@@ -16,11 +16,20 @@
 
 #pragma once
 
+#include <limits>
+
 namespace raft {
 namespace hierarchy {
 
 enum LinkageDistance { PAIRWISE = 0, KNN_GRAPH = 1 };
 
+/**
+ * Sentinel for the `c` parameter of the knn-graph linkage mode. When passed,
+ * the graph density constant is estimated from sampled local-scale statistics
+ * of the data instead of being fixed up front.
+ */
+constexpr int LINKAGE_AUTO_C = std::numeric_limits<int>::min();
+
 /**
  * Simple POCO for consolidating linkage results. This closely
  * mirrors the trained instance variables populated in
@@ -28,12 +28,15 @@
 #include <raft/sparse/coo.hpp>
 #include <raft/sparse/hierarchy/common.h>
 #include <raft/sparse/selection/knn_graph.cuh>
+#include <raft/spatial/knn/knn.cuh>
 
 #include <thrust/iterator/zip_iterator.h>
 #include <thrust/transform.h>
 #include <thrust/tuple.h>
 
+#include <cmath>
 #include <limits>
+#include <vector>
 
 namespace raft {
 namespace hierarchy {
@@ -49,9 +52,95 @@ struct distance_graph_impl {
            rmm::device_uvector<value_idx>& indptr,
            rmm::device_uvector<value_idx>& indices,
            rmm::device_uvector<value_t>& data,
-           int c);
+           int c,
+           size_t batch_size);
 };
 
+/**
+ * Estimates the knn-graph density constant 'c' from sampled local-scale
+ * statistics. The distance from a point to its nearest neighbors measures
+ * the density around it; the spread of that measure across a sample of the
+ * rows tells how uneven the density is. Near-uniform data stays connected
+ * with a close-to-minimal graph, while strongly varying local scales need
+ * denser neighborhoods to keep sparse regions attached. Components that
+ * still end up disconnected are densified individually by the
+ * connect_components passes in the MST stage, so the estimate only needs
+ * to be a good starting point rather than a guarantee.
+ * @tparam value_t
+ * @param[in] handle raft handle
+ * @param[in] X dense data on device, size m * n
+ * @param[in] m number of rows in X
+ * @param[in] n number of columns in X
+ * @param[in] metric distance metric to use
+ * @return estimated 'c' in [2, 15]
+ */
+template <typename value_t>
+int estimate_c(const raft::handle_t& handle,
+               const value_t* X,
+               size_t m,
+               size_t n,
+               raft::distance::DistanceType metric)
+{
+  auto stream = handle.get_stream();
+
+  size_t n_samples = std::min(m, (size_t)256);
+  size_t stride    = m / n_samples;
+
+  // first neighbor of each sample is the point itself
+  int k = (int)std::min(m, (size_t)5);
+
+  rmm::device_uvector<value_t> queries(n_samples * n, stream);
+  RAFT_CUDA_TRY(cudaMemcpy2DAsync(queries.data(),
+                                  n * sizeof(value_t),
+                                  X,
+                                  stride * n * sizeof(value_t),
+                                  n * sizeof(value_t),
+                                  n_samples,
+                                  cudaMemcpyDeviceToDevice,
+                                  stream));
+
+  rmm::device_uvector<int64_t> knn_indices(n_samples * k, stream);
+  rmm::device_uvector<value_t> knn_dists(n_samples * k, stream);
+
+  std::vector<value_t*> inputs = {const_cast<value_t*>(X)};
+  std::vector<size_t> sizes    = {m};
+
+  raft::spatial::knn::brute_force_knn<int64_t, value_t, size_t>(handle,
+                                                                inputs,
+                                                                sizes,
+                                                                n,
+                                                                queries.data(),
+                                                                n_samples,
+                                                                knn_indices.data(),
+                                                                knn_dists.data(),
+                                                                k,
+                                                                true,
+                                                                true,
+                                                                nullptr,
+                                                                metric);
+
+  std::vector<value_t> h_dists(n_samples * k);
+  raft::update_host(h_dists.data(), knn_dists.data(), h_dists.size(), stream);
+  handle.sync_stream(stream);
+
+  // local scale of each sample: distance to its furthest retrieved neighbor
+  double mean = 0.0, sq = 0.0;
+  for (size_t i = 0; i < n_samples; i++) {
+    double r = h_dists[i * k + (k - 1)];
+    mean += r;
+    sq += r * r;
+  }
+  mean /= n_samples;
+  sq /= n_samples;
+
+  double var = std::max(0.0, sq - mean * mean);
+  double cv  = mean > 0.0 ? std::sqrt(var) / mean : 0.0;
+
+  // map the coefficient of variation onto [2, 15]: uniform local scales get
+  // a near-minimal graph, the denser end matches the commonly used default
+  return std::min(15, std::max(2, (int)std::round(2.0 + 13.0 * cv)));
+}
+
 /**
  * Connectivities specialization to build a knn graph
  * @tparam value_idx
@@ -67,15 +156,18 @@ struct distance_graph_impl<raft::hierarchy::LinkageDistance::KNN_GRAPH, value_id
            rmm::device_uvector<value_idx>& indptr,
            rmm::device_uvector<value_idx>& indices,
            rmm::device_uvector<value_t>& data,
-           int c)
+           int c,
+           size_t batch_size)
   {
     auto stream        = handle.get_stream();
     auto thrust_policy = handle.get_thrust_policy();
 
+    if (c == LINKAGE_AUTO_C) { c = estimate_c(handle, X, m, n, metric); }
+
     // Need to symmetrize knn into undirected graph
     raft::sparse::COO<value_t, value_idx> knn_graph_coo(stream);
 
-    raft::sparse::selection::knn_graph(handle, X, m, n, metric, knn_graph_coo, c);
+    raft::sparse::selection::knn_graph(handle, X, m, n, metric, knn_graph_coo, c, batch_size);
 
     indices.resize(knn_graph_coo.nnz, stream);
     data.resize(knn_graph_coo.nnz, stream);
@@ -120,6 +212,8 @@ struct distance_graph_impl<raft::hierarchy::LinkageDistance::KNN_GRAPH, value_id
  * @param[out] data distances array of connectivities graph
  * @param[out] c constant 'c' used for nearest neighbors-based distances
  *             which will guarantee k <= log(n) + c
+ * @param[in] batch_size number of rows per neighbors-search batch; 0 runs a
+ *            single search over all rows
  */
 template <typename value_idx, typename value_t, raft::hierarchy::LinkageDistance dist_type>
 void get_distance_graph(const raft::handle_t& handle,
@@ -130,14 +224,15 @@ void get_distance_graph(const raft::handle_t& handle,
                         rmm::device_uvector<value_idx>& indptr,
                         rmm::device_uvector<value_idx>& indices,
                         rmm::device_uvector<value_t>& data,
-                        int c)
+                        int c,
+                        size_t batch_size = 0)
 {
   auto stream = handle.get_stream();
 
   indptr.resize(m + 1, stream);
 
   distance_graph_impl<dist_type, value_idx, value_t> dist_graph;
-  dist_graph.run(handle, X, m, n, metric, indptr, indices, data, c);
+  dist_graph.run(handle, X, m, n, metric, indptr, indices, data, c, batch_size);
 }
 
 };  // namespace detail
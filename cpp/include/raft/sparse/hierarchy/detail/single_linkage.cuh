@@ -47,8 +47,18 @@ static const size_t EMPTY = 0;
  * @param[out] out struct containing output dendrogram and cluster assignments
  * @param[in] c a constant used when constructing connectivities from knn graph. Allows the indirect
  control
- *            of k. The algorithm will set `k = log(n) + c`
+ *            of k. The algorithm will set `k = log(n) + c`. Passing
+ *            `raft::hierarchy::LINKAGE_AUTO_C` estimates c from sampled
+ *            local-scale statistics of the data; components left
+ *            disconnected are densified individually during the MST stage
  * @param[in] n_clusters number of clusters to assign data samples
+ * @param[in] batch_size number of rows per batch when constructing the
+ *            connectivities graph; 0 computes the graph in a single pass.
+ *            Batching streams the distance computation through a workspace
+ *            bounded by the batch so hierarchies can be built over inputs
+ *            whose single-pass workspace exceeds device memory. Any
+ *            components the batched graph leaves unconnected are stitched by
+ *            the usual `connect_components` passes in the MST stage.
  */
 template <typename value_idx, typename value_t, LinkageDistance dist_type>
 void single_linkage(const raft::handle_t& handle,
@@ -58,7 +68,8 @@ void single_linkage(const raft::handle_t& handle,
                     raft::distance::DistanceType metric,
                     linkage_output<value_idx, value_t>* out,
                     int c,
-                    size_t n_clusters)
+                    size_t n_clusters,
+                    size_t batch_size = 0)
 {
   ASSERT(n_clusters <= m, "n_clusters must be less than or equal to the number of data points");
 
@@ -72,7 +83,7 @@ void single_linkage(const raft::handle_t& handle,
    * 1. Construct distance graph
    */
   detail::get_distance_graph<value_idx, value_t, dist_type>(
-    handle, X, m, n, metric, indptr, indices, pw_dists, c);
+    handle, X, m, n, metric, indptr, indices, pw_dists, c, batch_size);
 
   rmm::device_uvector<value_idx> mst_rows(m - 1, stream);
   rmm::device_uvector<value_idx> mst_cols(m - 1, stream);
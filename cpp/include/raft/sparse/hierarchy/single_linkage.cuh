@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <raft/core/memory_telemetry.hpp>
+#include <raft/core/nvtx.hpp>
 #include <raft/sparse/hierarchy/common.h>
 #include <raft/sparse/hierarchy/detail/single_linkage.cuh>
 
@@ -41,8 +43,16 @@ namespace hierarchy {
  * @param[out] out struct containing output dendrogram and cluster assignments
  * @param[in] c a constant used when constructing connectivities from knn graph. Allows the indirect
  control
- *            of k. The algorithm will set `k = log(n) + c`
+ *            of k. The algorithm will set `k = log(n) + c`. Passing
+ *            `raft::hierarchy::LINKAGE_AUTO_C` estimates c from sampled
+ *            local-scale statistics of the data; components left
+ *            disconnected are densified individually during the MST stage
  * @param[in] n_clusters number of clusters to assign data samples
+ * @param[in] batch_size number of rows per batch when constructing the
+ *            connectivities graph; 0 computes the graph in a single pass.
+ *            Batching bounds the distance workspace to the batch so
+ *            hierarchies can be built over inputs whose single-pass
+ *            workspace exceeds device memory
  */
 template <typename value_idx,
           typename value_t,
@@ -54,10 +64,14 @@ void single_linkage(const raft::handle_t& handle,
                     raft::distance::DistanceType metric,
                     linkage_output<value_idx, value_t>* out,
                     int c,
-                    size_t n_clusters)
+                    size_t n_clusters,
+                    size_t batch_size = 0)
 {
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "hierarchy::single_linkage (%zu, %zu, %zu)", m, n, n_clusters);
+  memory_scope mem_scope("single_linkage");
   detail::single_linkage<value_idx, value_t, dist_type>(
-    handle, X, m, n, metric, out, c, n_clusters);
+    handle, X, m, n, metric, out, c, n_clusters, batch_size);
 }
 };  // namespace hierarchy
 };  // namespace raft
@@ -43,7 +43,7 @@ template <int TPB_X = 64, typename T = int>
 __global__ void coo_degree_kernel(const T* rows, int nnz, T* results)
 {
   int row = (blockIdx.x * TPB_X) + threadIdx.x;
-  if (row < nnz) { atomicAdd(results + rows[row], (T)1); }
+  if (row < nnz) { raft::aggregated_atomic_add(results + rows[row], (T)1); }
 }
 
 /**
@@ -68,7 +68,7 @@ template <int TPB_X = 64, typename T>
 __global__ void coo_degree_nz_kernel(const int* rows, const T* vals, int nnz, int* results)
 {
   int row = (blockIdx.x * TPB_X) + threadIdx.x;
-  if (row < nnz && vals[row] != 0.0) { raft::myAtomicAdd(results + rows[row], 1); }
+  if (row < nnz && vals[row] != 0.0) { raft::aggregated_atomic_add(results + rows[row], 1); }
 }
 
 template <int TPB_X = 64, typename T>
@@ -76,7 +76,7 @@ __global__ void coo_degree_scalar_kernel(
   const int* rows, const T* vals, int nnz, T scalar, int* results)
 {
   int row = (blockIdx.x * TPB_X) + threadIdx.x;
-  if (row < nnz && vals[row] != scalar) { raft::myAtomicAdd(results + rows[row], 1); }
+  if (row < nnz && vals[row] != scalar) { raft::aggregated_atomic_add(results + rows[row], 1); }
 }
 
 /**
@@ -161,6 +161,95 @@ void coo_symmetrize(COO<T>* in,
   RAFT_CUDA_TRY(cudaPeekAtLastError());
 }
 
+/**
+ * Binary search a row's sorted column slice for a column id.
+ * Returns the nnz index of the match or -1.
+ */
+template <typename value_idx>
+__device__ value_idx find_reciprocal_edge(const value_idx* cols,
+                                          value_idx start_idx,
+                                          value_idx stop_idx,
+                                          value_idx col)
+{
+  while (start_idx < stop_idx) {
+    value_idx mid = start_idx + (stop_idx - start_idx) / 2;
+    if (cols[mid] < col)
+      start_idx = mid + 1;
+    else if (cols[mid] > col)
+      stop_idx = mid;
+    else
+      return mid;
+  }
+  return -1;
+}
+
+/**
+ * Count the output entries each input edge contributes: one for the edge
+ * itself, plus one for its mirror when the reciprocal edge is absent.
+ */
+template <int TPB_X = 256, typename value_idx>
+__global__ void symmetrize_count_kernel(const value_idx* __restrict__ row_ind,
+                                        const value_idx* __restrict__ rows,
+                                        const value_idx* __restrict__ cols,
+                                        value_idx m,
+                                        value_idx nnz,
+                                        value_idx* __restrict__ row_sizes)
+{
+  value_idx i = (blockIdx.x * TPB_X) + threadIdx.x;
+  if (i >= nnz) return;
+
+  value_idx row = rows[i];
+  value_idx col = cols[i];
+
+  value_idx t = col < m ? find_reciprocal_edge(cols, row_ind[col], row_ind[col + 1], row) : -1;
+
+  atomicAdd(row_sizes + row, value_idx(1));
+  if (t < 0) atomicAdd(row_sizes + col, value_idx(1));
+}
+
+/**
+ * Write the symmetrized entries. Each edge writes its own direction,
+ * reduced against the reciprocal value when one exists; edges without a
+ * reciprocal also write their mirror so the output is symmetric.
+ */
+template <int TPB_X = 256, typename value_idx, typename value_t>
+__global__ void symmetrize_fill_kernel(const value_idx* __restrict__ row_ind,
+                                       const value_idx* __restrict__ rows,
+                                       const value_idx* __restrict__ cols,
+                                       const value_t* __restrict__ vals,
+                                       value_idx m,
+                                       value_idx nnz,
+                                       value_idx* __restrict__ edges,
+                                       value_idx* __restrict__ orows,
+                                       value_idx* __restrict__ ocols,
+                                       value_t* __restrict__ ovals)
+{
+  value_idx i = (blockIdx.x * TPB_X) + threadIdx.x;
+  if (i >= nnz) return;
+
+  value_idx row = rows[i];
+  value_idx col = cols[i];
+  value_t val   = vals[i];
+
+  value_idx t = col < m ? find_reciprocal_edge(cols, row_ind[col], row_ind[col + 1], row) : -1;
+
+  // matches the max duplicate-merging behavior of the concatenating path
+  value_t res = t >= 0 && vals[t] > val ? vals[t] : val;
+
+  value_idx out_idx = atomicAdd(edges + row, value_idx(1));
+  orows[out_idx]    = row;
+  ocols[out_idx]    = col;
+  ovals[out_idx]    = res;
+
+  // the reciprocal edge's own thread writes the mirrored direction
+  if (t < 0) {
+    out_idx        = atomicAdd(edges + col, value_idx(1));
+    orows[out_idx] = col;
+    ocols[out_idx] = row;
+    ovals[out_idx] = res;
+  }
+}
+
 /**
  * @brief Find how much space needed in each row.
  * We look through all datapoints and increment the count for each row.
@@ -322,9 +411,80 @@ void from_knn_symmetrize_matrix(const value_idx* __restrict__ knn_indices,
 }
 
 /**
- * Symmetrizes a COO matrix
+ * Symmetrizes a COO matrix whose entries are already in lexicographic
+ * (row, col) order and free of duplicate (row, col) pairs, looking up each
+ * edge's reciprocal directly in the CSR structure derived from the sorted
+ * input. Duplicates would pass through to the output unmerged; `symmetrize`
+ * collapses them first. The output is grouped by row; columns within a row
+ * are not guaranteed to be sorted.
+ */
+template <int TPB_X = 256, typename value_idx, typename value_t>
+void symmetrize_sorted(const raft::handle_t& handle,
+                       const value_idx* sorted_rows,
+                       const value_idx* sorted_cols,
+                       const value_t* sorted_vals,
+                       size_t m,
+                       size_t n,
+                       size_t nnz,
+                       raft::sparse::COO<value_t, value_idx>& out)
+{
+  auto stream = handle.get_stream();
+
+  rmm::device_uvector<value_idx> row_ind(m + 1, stream);
+  convert::sorted_coo_to_csr(sorted_rows, (int)nnz, row_ind.data(), (int)m + 1, stream);
+
+  // mirrored edges can land in rows beyond m when the input is rectangular
+  value_idx n_out_rows = (value_idx)std::max(m, n);
+
+  rmm::device_uvector<value_idx> row_sizes(n_out_rows, stream);
+  RAFT_CUDA_TRY(cudaMemsetAsync(row_sizes.data(), 0, sizeof(value_idx) * n_out_rows, stream));
+
+  dim3 grid(raft::ceildiv((int)nnz, TPB_X), 1, 1);
+  dim3 blk(TPB_X, 1, 1);
+
+  symmetrize_count_kernel<TPB_X><<<grid, blk, 0, stream>>>(
+    row_ind.data(), sorted_rows, sorted_cols, (value_idx)m, (value_idx)nnz, row_sizes.data());
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
+
+  // per-row write offsets, bumped atomically by the fill kernel
+  rmm::device_uvector<value_idx> edges(n_out_rows, stream);
+  thrust::device_ptr<value_idx> row_sizes_ptr = thrust::device_pointer_cast(row_sizes.data());
+  thrust::device_ptr<value_idx> edges_ptr     = thrust::device_pointer_cast(edges.data());
+  thrust::exclusive_scan(
+    rmm::exec_policy(stream), row_sizes_ptr, row_sizes_ptr + n_out_rows, edges_ptr);
+
+  value_idx last_offset = 0, last_size = 0;
+  raft::update_host(&last_offset, edges.data() + n_out_rows - 1, 1, stream);
+  raft::update_host(&last_size, row_sizes.data() + n_out_rows - 1, 1, stream);
+  RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+  value_idx out_nnz = last_offset + last_size;
+
+  out.allocate(out_nnz, m, n, false, stream);
+
+  symmetrize_fill_kernel<TPB_X><<<grid, blk, 0, stream>>>(row_ind.data(),
+                                                          sorted_rows,
+                                                          sorted_cols,
+                                                          sorted_vals,
+                                                          (value_idx)m,
+                                                          (value_idx)nnz,
+                                                          edges.data(),
+                                                          out.rows(),
+                                                          out.cols(),
+                                                          out.vals());
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
+}
+
+/**
+ * Symmetrizes a COO matrix by looking up each edge's reciprocal directly
+ * in the CSR structure of a sorted copy of the input, rather than
+ * concatenating the matrix with its transpose and merging duplicates.
+ * This keeps the transient memory at O(nnz) instead of O(3*nnz), which
+ * matters for symmetrizing very large knn graphs. Duplicate (row, col)
+ * pairs resolve to their max value, matching the concatenating approach.
+ * The output is grouped by row; columns within a row are not guaranteed
+ * to be sorted.
  */
-template <typename value_idx, typename value_t>
+template <int TPB_X = 256, typename value_idx, typename value_t>
 void symmetrize(const raft::handle_t& handle,
                 const value_idx* rows,
                 const value_idx* cols,
@@ -336,30 +496,32 @@ void symmetrize(const raft::handle_t& handle,
 {
   auto stream = handle.get_stream();
 
-  // copy rows to cols and cols to rows
-  rmm::device_uvector<value_idx> symm_rows(nnz * 2, stream);
-  rmm::device_uvector<value_idx> symm_cols(nnz * 2, stream);
-  rmm::device_uvector<value_t> symm_vals(nnz * 2, stream);
-
-  raft::copy_async(symm_rows.data(), rows, nnz, stream);
-  raft::copy_async(symm_rows.data() + nnz, cols, nnz, stream);
-  raft::copy_async(symm_cols.data(), cols, nnz, stream);
-  raft::copy_async(symm_cols.data() + nnz, rows, nnz, stream);
+  // sorted copy of the input so reciprocal edges can be binary searched
+  // within their row's column slice
+  rmm::device_uvector<value_idx> sorted_rows(nnz, stream);
+  rmm::device_uvector<value_idx> sorted_cols(nnz, stream);
+  rmm::device_uvector<value_t> sorted_vals(nnz, stream);
+  raft::copy_async(sorted_rows.data(), rows, nnz, stream);
+  raft::copy_async(sorted_cols.data(), cols, nnz, stream);
+  raft::copy_async(sorted_vals.data(), vals, nnz, stream);
 
-  raft::copy_async(symm_vals.data(), vals, nnz, stream);
-  raft::copy_async(symm_vals.data() + nnz, vals, nnz, stream);
-
-  // sort COO
   raft::sparse::op::coo_sort((value_idx)m,
                              (value_idx)n,
-                             (value_idx)nnz * 2,
-                             symm_rows.data(),
-                             symm_cols.data(),
-                             symm_vals.data(),
+                             (value_idx)nnz,
+                             sorted_rows.data(),
+                             sorted_cols.data(),
+                             sorted_vals.data(),
                              stream);
 
+  // literal duplicate (row, col) entries must collapse to their max before
+  // the reciprocal lookups: the binary search only resolves an edge against
+  // its transpose, so unmerged duplicates would pass through to the output
+  raft::sparse::COO<value_t, value_idx> merged(stream);
   raft::sparse::op::max_duplicates(
-    handle, out, symm_rows.data(), symm_cols.data(), symm_vals.data(), nnz * 2, m, n);
+    handle, merged, sorted_rows.data(), sorted_cols.data(), sorted_vals.data(), nnz, m, n);
+
+  symmetrize_sorted<TPB_X>(
+    handle, merged.rows(), merged.cols(), merged.vals(), m, n, (size_t)merged.nnz, out);
 }
 
 };  // end NAMESPACE detail
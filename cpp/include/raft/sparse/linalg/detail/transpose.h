@@ -20,6 +20,7 @@
 
 #include <raft/cuda_utils.cuh>
 #include <raft/cudart_utils.h>
+#include <raft/sparse/detail/cusparse_buffer_cache.h>
 #include <raft/sparse/detail/cusparse_wrappers.h>
 #include <rmm/device_uvector.hpp>
 
@@ -68,25 +69,37 @@ void csr_transpose(cusparseHandle_t handle,
                    value_idx nnz,
                    cudaStream_t stream)
 {
-  size_t convert_csc_workspace_size = 0;
+  // repeated transposes of same-shaped matrices (per-iteration solvers)
+  // hit the per-handle cache and skip both sizing and allocation
+  raft::sparse::detail::cusparse_buffer_key key{
+    (int)raft::sparse::detail::cusparse_cached_op::csr2csc,
+    (int64_t)csr_nrows,
+    (int64_t)csr_ncols,
+    raft::sparse::detail::cusparse_nnz_class(nnz),
+    sizeof(value_t)};
 
-  RAFT_CUSPARSE_TRY(raft::sparse::detail::cusparsecsr2csc_bufferSize(handle,
-                                                                     csr_nrows,
-                                                                     csr_ncols,
-                                                                     nnz,
-                                                                     csr_data,
-                                                                     csr_indptr,
-                                                                     csr_indices,
-                                                                     csc_data,
-                                                                     csc_indptr,
-                                                                     csc_indices,
-                                                                     CUSPARSE_ACTION_NUMERIC,
-                                                                     CUSPARSE_INDEX_BASE_ZERO,
-                                                                     CUSPARSE_CSR2CSC_ALG1,
-                                                                     &convert_csc_workspace_size,
-                                                                     stream));
-
-  rmm::device_uvector<char> convert_csc_workspace(convert_csc_workspace_size, stream);
+  void* convert_csc_workspace =
+    raft::sparse::detail::get_cusparse_buffer_cache(handle).get_workspace(
+      key, (int64_t)nnz, [&]() {
+        size_t convert_csc_workspace_size = 0;
+        RAFT_CUSPARSE_TRY(
+          raft::sparse::detail::cusparsecsr2csc_bufferSize(handle,
+                                                           csr_nrows,
+                                                           csr_ncols,
+                                                           nnz,
+                                                           csr_data,
+                                                           csr_indptr,
+                                                           csr_indices,
+                                                           csc_data,
+                                                           csc_indptr,
+                                                           csc_indices,
+                                                           CUSPARSE_ACTION_NUMERIC,
+                                                           CUSPARSE_INDEX_BASE_ZERO,
+                                                           CUSPARSE_CSR2CSC_ALG1,
+                                                           &convert_csc_workspace_size,
+                                                           stream));
+        return convert_csc_workspace_size;
+      });
 
   RAFT_CUSPARSE_TRY(raft::sparse::detail::cusparsecsr2csc(handle,
                                                           csr_nrows,
@@ -101,7 +114,7 @@ void csr_transpose(cusparseHandle_t handle,
                                                           CUSPARSE_ACTION_NUMERIC,
                                                           CUSPARSE_INDEX_BASE_ZERO,
                                                           CUSPARSE_CSR2CSC_ALG1,
-                                                          convert_csc_workspace.data(),
+                                                          convert_csc_workspace,
                                                           stream));
 }
 
@@ -66,6 +66,38 @@ void csr_row_normalize_max(const int* ia,  // csr row ind array (sorted by row)
   detail::csr_row_normalize_max(ia, vals, nnz, m, result, stream);
 }
 
+/**
+ * @brief Fused row normalization of a CSR-formatted sparse matrix for the
+ * given norm type (L1 or L2)
+ *
+ * The norm reduction and the division are fused into one kernel so the
+ * values array is traversed once, instead of a norm pass followed by an
+ * eltwise scale. Rows are mapped to warps when the mean degree warrants the
+ * lane-parallel reduction and to single threads otherwise. Rows with a zero
+ * norm are written as zeros. `result` may alias `vals` for in-place
+ * normalization: each element is re-read by its owning thread after the
+ * row norm is complete and rows are disjoint.
+ *
+ * @param ia: row_ind array
+ * @param vals: data array
+ * @param nnz: size of data array
+ * @param m: size of row_ind array
+ * @param result: normalized data array; may equal vals
+ * @param norm: the norm to normalize with (raft::linalg::L1Norm or L2Norm)
+ * @param stream: cuda stream to use
+ */
+template <typename T>
+void csr_row_normalize(const int* ia,  // csr row ex_scan (sorted by row)
+                       const T* vals,
+                       int nnz,  // array of values and number of non-zeros
+                       int m,    // num rows in csr
+                       T* result,
+                       raft::linalg::NormType norm,
+                       cudaStream_t stream)
+{
+  detail::csr_row_normalize(ia, vals, nnz, m, result, norm, stream);
+}
+
 };  // end NAMESPACE linalg
 };  // end NAMESPACE sparse
 };  // end NAMESPACE raft
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <raft/core/nvtx.hpp>
 #include <raft/sparse/coo.hpp>
 #include <raft/sparse/linalg/detail/symmetrize.cuh>
 
@@ -41,6 +42,7 @@ void coo_symmetrize(COO<T>* in,
                     Lambda reduction_op,  // two-argument reducer
                     cudaStream_t stream)
 {
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope("sparse::coo_symmetrize (%d)", in->nnz);
   detail::coo_symmetrize(in, out, reduction_op, stream);
 }
 
@@ -158,9 +160,45 @@ void symmetrize(const raft::handle_t& handle,
                 size_t nnz,
                 raft::sparse::COO<value_t, value_idx>& out)
 {
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "sparse::symmetrize (%zu, %zu, %zu)", m, n, nnz);
   detail::symmetrize(handle, rows, cols, vals, m, n, nnz, out);
 }
 
+/**
+ * Symmetrizes a COO matrix. When the input's sorted flag indicates the
+ * producer already established lexicographic (row, col) order, the
+ * internal copy-and-sort pass is skipped and the input arrays are used
+ * directly.
+ */
+template <typename value_idx, typename value_t>
+void symmetrize(const raft::handle_t& handle,
+                raft::sparse::COO<value_t, value_idx>& in,
+                raft::sparse::COO<value_t, value_idx>& out)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "sparse::symmetrize (%d, %d, %d)", in.n_rows, in.n_cols, in.nnz);
+  if (in.sorted) {
+    detail::symmetrize_sorted(handle,
+                              in.rows(),
+                              in.cols(),
+                              in.vals(),
+                              (size_t)in.n_rows,
+                              (size_t)in.n_cols,
+                              (size_t)in.nnz,
+                              out);
+  } else {
+    detail::symmetrize(handle,
+                       in.rows(),
+                       in.cols(),
+                       in.vals(),
+                       (size_t)in.n_rows,
+                       (size_t)in.n_cols,
+                       (size_t)in.nnz,
+                       out);
+  }
+}
+
 };  // end NAMESPACE linalg
 };  // end NAMESPACE sparse
 };  // end NAMESPACE raft
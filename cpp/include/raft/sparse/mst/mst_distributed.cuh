@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __MST_DISTRIBUTED_H
+#define __MST_DISTRIBUTED_H
+
+#pragma once
+
+#include "mst_solver.cuh"
+
+#include <raft/core/comms.hpp>
+#include <raft/cudart_utils.h>
+#include <raft/handle.hpp>
+
+#include <rmm/device_uvector.hpp>
+#include <rmm/exec_policy.hpp>
+
+#include <thrust/binary_search.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/zip_iterator.h>
+#include <thrust/sort.h>
+#include <thrust/transform.h>
+#include <thrust/tuple.h>
+
+#include <vector>
+
+namespace raft {
+namespace mst {
+namespace detail {
+
+/**
+ * Pads a vertex-range CSR partition out to a CSR over all v vertices:
+ * rows outside [v_start, v_start + v_local) are empty, so the
+ * single-GPU solver can run on the partition unchanged.
+ */
+template <typename vertex_t, typename edge_t>
+void pad_partition_offsets(const edge_t* local_offsets,
+                           vertex_t v,
+                           vertex_t v_start,
+                           vertex_t v_local,
+                           edge_t e_local,
+                           edge_t* global_offsets,
+                           cudaStream_t stream)
+{
+  thrust::transform(rmm::exec_policy(stream),
+                    thrust::make_counting_iterator<vertex_t>(0),
+                    thrust::make_counting_iterator<vertex_t>(v + 1),
+                    global_offsets,
+                    [=] __device__(vertex_t i) -> edge_t {
+                      if (i <= v_start) return 0;
+                      if (i > v_start + v_local) return e_local;
+                      return local_offsets[i - v_start];
+                    });
+}
+
+/**
+ * Gathers every rank's forest edges onto all ranks so each can solve the
+ * (small) union graph identically.
+ */
+template <typename vertex_t, typename edge_t, typename weight_t>
+void allgather_forest(const raft::comms::comms_t& comms,
+                      const Graph_COO<vertex_t, edge_t, weight_t>& local,
+                      rmm::device_uvector<vertex_t>& union_src,
+                      rmm::device_uvector<vertex_t>& union_dst,
+                      rmm::device_uvector<weight_t>& union_weights,
+                      cudaStream_t stream)
+{
+  int n_ranks = comms.get_size();
+
+  rmm::device_uvector<edge_t> d_counts(n_ranks, stream);
+  rmm::device_uvector<edge_t> d_count(1, stream);
+  edge_t n_local = local.n_edges;
+  raft::update_device(d_count.data(), &n_local, 1, stream);
+  comms.allgather(d_count.data(), d_counts.data(), 1, stream);
+
+  std::vector<edge_t> counts_h(n_ranks);
+  raft::update_host(counts_h.data(), d_counts.data(), n_ranks, stream);
+  comms.sync_stream(stream);
+
+  std::vector<size_t> recvcounts(n_ranks), displs(n_ranks);
+  size_t total = 0;
+  for (int r = 0; r < n_ranks; r++) {
+    recvcounts[r] = counts_h[r];
+    displs[r]     = total;
+    total += counts_h[r];
+  }
+
+  union_src.resize(total, stream);
+  union_dst.resize(total, stream);
+  union_weights.resize(total, stream);
+
+  comms.allgatherv(
+    local.src.data(), union_src.data(), recvcounts.data(), displs.data(), stream);
+  comms.allgatherv(
+    local.dst.data(), union_dst.data(), recvcounts.data(), displs.data(), stream);
+  comms.allgatherv(
+    local.weights.data(), union_weights.data(), recvcounts.data(), displs.data(), stream);
+  comms.sync_stream(stream);
+}
+
+};  // namespace detail
+
+/**
+ * Multi-GPU Boruvka MST over an edge list partitioned by vertex range.
+ *
+ * Each rank owns the CSR rows of a contiguous vertex range of a
+ * symmetric global graph (cross-range edges appear on their source
+ * rank). The solver first runs the single-GPU Boruvka on the local
+ * partition, producing a minimum spanning forest of the local edge set
+ * (the per-iteration min-edge scans therefore only ever touch the
+ * rank's own edges). By the cycle property, edges pruned from a
+ * partition's forest can never enter the global MST, so the ranks then
+ * allgather their forests -- at most (v - 1) edges each -- and every
+ * rank solves the small union graph identically, which also unifies the
+ * supervertex colors across ranks.
+ *
+ * Tied weights are handled by the same per-solve weight alteration the
+ * single-GPU solver uses, which is deterministic in the graph, so all
+ * ranks agree on the result.
+ *
+ * @param handle raft handle with an initialized communicator
+ * @param offsets local CSR offsets over the rank's rows (size v_local+1)
+ * @param indices global column ids of the local rows
+ * @param weights local edge weights
+ * @param v global number of vertices
+ * @param v_start first vertex of this rank's range
+ * @param v_local number of vertices in this rank's range
+ * @param e_local number of local edges
+ * @param color output supervertex color per (global) vertex, size v;
+ *              identical on all ranks on return
+ * @param stream cuda stream
+ * @param symmetrize_output mirror each output edge, as in `mst`
+ * @param iterations Boruvka iteration bound for the union solve,
+ *                   0 runs to completion
+ * @return MST (or forest) of the global graph; identical on all ranks
+ */
+template <typename vertex_t, typename edge_t, typename weight_t, typename alteration_t = weight_t>
+raft::Graph_COO<vertex_t, edge_t, weight_t> mst_distributed(const raft::handle_t& handle,
+                                                            edge_t const* offsets,
+                                                            vertex_t const* indices,
+                                                            weight_t const* weights,
+                                                            vertex_t const v,
+                                                            vertex_t const v_start,
+                                                            vertex_t const v_local,
+                                                            edge_t const e_local,
+                                                            vertex_t* color,
+                                                            cudaStream_t stream,
+                                                            bool symmetrize_output = true,
+                                                            int iterations         = 0)
+{
+  const auto& comms = handle.get_comms();
+
+  RAFT_EXPECTS(v_start >= 0 && v_start + v_local <= v, "invalid vertex range");
+
+  // 1. minimum spanning forest of the local partition
+  rmm::device_uvector<edge_t> padded_offsets(v + 1, stream);
+  detail::pad_partition_offsets(offsets, v, v_start, v_local, e_local, padded_offsets.data(), stream);
+
+  auto local_forest = [&]() {
+    MST_solver<vertex_t, edge_t, weight_t, alteration_t> local_solver(handle,
+                                                                      padded_offsets.data(),
+                                                                      indices,
+                                                                      weights,
+                                                                      v,
+                                                                      e_local,
+                                                                      color,
+                                                                      stream,
+                                                                      false,
+                                                                      true,
+                                                                      0);
+    return local_solver.solve();
+  }();
+
+  // 2. gather all forests; every rank sees the same union edge list
+  rmm::device_uvector<vertex_t> union_src(0, stream);
+  rmm::device_uvector<vertex_t> union_dst(0, stream);
+  rmm::device_uvector<weight_t> union_weights(0, stream);
+  detail::allgather_forest(comms, local_forest, union_src, union_dst, union_weights, stream);
+
+  edge_t n_union = union_src.size();
+
+  // 3. symmetrize the union edge list and convert it to CSR for the
+  // final solve (the solver expects both directions of each edge)
+  rmm::device_uvector<vertex_t> symm_src(2 * n_union, stream);
+  rmm::device_uvector<vertex_t> symm_dst(2 * n_union, stream);
+  rmm::device_uvector<weight_t> symm_weights(2 * n_union, stream);
+  raft::copy_async(symm_src.data(), union_src.data(), n_union, stream);
+  raft::copy_async(symm_src.data() + n_union, union_dst.data(), n_union, stream);
+  raft::copy_async(symm_dst.data(), union_dst.data(), n_union, stream);
+  raft::copy_async(symm_dst.data() + n_union, union_src.data(), n_union, stream);
+  raft::copy_async(symm_weights.data(), union_weights.data(), n_union, stream);
+  raft::copy_async(symm_weights.data() + n_union, union_weights.data(), n_union, stream);
+
+  auto symm_keys = thrust::make_zip_iterator(thrust::make_tuple(symm_src.data(), symm_dst.data()));
+  thrust::sort_by_key(
+    rmm::exec_policy(stream), symm_keys, symm_keys + 2 * n_union, symm_weights.data());
+
+  rmm::device_uvector<edge_t> union_offsets(v + 1, stream);
+  thrust::lower_bound(rmm::exec_policy(stream),
+                      symm_src.data(),
+                      symm_src.data() + 2 * n_union,
+                      thrust::make_counting_iterator<vertex_t>(0),
+                      thrust::make_counting_iterator<vertex_t>(v + 1),
+                      union_offsets.data());
+
+  // 4. identical MST of the union forest on every rank
+  MST_solver<vertex_t, edge_t, weight_t, alteration_t> union_solver(handle,
+                                                                    union_offsets.data(),
+                                                                    symm_dst.data(),
+                                                                    symm_weights.data(),
+                                                                    v,
+                                                                    (edge_t)(2 * n_union),
+                                                                    color,
+                                                                    stream,
+                                                                    symmetrize_output,
+                                                                    true,
+                                                                    iterations);
+  return union_solver.solve();
+}
+
+}  // namespace mst
+}  // namespace raft
+
+#endif
@@ -195,6 +195,128 @@ void coo_remove_zeros(COO<T>* in, COO<T>* out, cudaStream_t stream)
   coo_remove_scalar<TPB_X, T>(in, out, T(0.0), stream);
 }
 
+template <int TPB_X, typename T, typename filter_f>
+__global__ void coo_filter_count_kernel(const int* rows,
+                                        const int* cols,
+                                        const T* vals,
+                                        int nnz,
+                                        int* cnnz,
+                                        int* cur_ex_scan,
+                                        int m,
+                                        int max_row_degree,
+                                        filter_f filter)
+{
+  int row = (blockIdx.x * TPB_X) + threadIdx.x;
+
+  if (row < m) {
+    int start = cur_ex_scan[row];
+    int stop  = get_stop_idx(row, m, nnz, cur_ex_scan);
+    int kept  = 0;
+
+    for (int idx = start; idx < stop && kept < max_row_degree; idx++) {
+      if (filter(rows[idx], cols[idx], vals[idx])) { ++kept; }
+    }
+    cnnz[row] = kept;
+  }
+}
+
+template <int TPB_X, typename T, typename filter_f>
+__global__ void coo_filter_compact_kernel(const int* rows,
+                                          const int* cols,
+                                          const T* vals,
+                                          int nnz,
+                                          int* crows,
+                                          int* ccols,
+                                          T* cvals,
+                                          int* ex_scan,
+                                          int* cur_ex_scan,
+                                          int m,
+                                          int max_row_degree,
+                                          filter_f filter)
+{
+  int row = (blockIdx.x * TPB_X) + threadIdx.x;
+
+  if (row < m) {
+    int start       = cur_ex_scan[row];
+    int stop        = get_stop_idx(row, m, nnz, cur_ex_scan);
+    int cur_out_idx = ex_scan[row];
+    int kept        = 0;
+
+    for (int idx = start; idx < stop && kept < max_row_degree; idx++) {
+      if (filter(rows[idx], cols[idx], vals[idx])) {
+        crows[cur_out_idx] = rows[idx];
+        ccols[cur_out_idx] = cols[idx];
+        cvals[cur_out_idx] = vals[idx];
+        ++cur_out_idx;
+        ++kept;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Filters the edges of a row-sorted COO matrix through a fused
+ * predicate and per-row degree cap in a single count+compact pass.
+ *
+ * The workspace holds the two exclusive scans (2 * n_rows ints) and is
+ * grown as needed; passing the same uvector to chained invocations reuses
+ * the allocation.
+ *
+ * @param in: input COO matrix, sorted by row
+ * @param out: output COO matrix
+ * @param filter: device predicate called as filter(row, col, val); edges
+ *        returning false are dropped
+ * @param max_row_degree: keep at most this many passing edges per row
+ * @param workspace: scratch buffer, resized to 2 * n_rows ints if smaller
+ * @param stream: cuda stream to use
+ */
+template <int TPB_X, typename T, typename filter_f>
+void coo_filter(COO<T>* in,
+                COO<T>* out,
+                filter_f filter,
+                int max_row_degree,
+                rmm::device_uvector<int>& workspace,
+                cudaStream_t stream)
+{
+  int n = in->n_rows;
+  if (workspace.size() < size_t(2 * n)) { workspace.resize(2 * n, stream); }
+  int* cur_ex_scan = workspace.data();
+  int* cnnz        = workspace.data() + n;
+
+  RAFT_CUDA_TRY(cudaMemsetAsync(cur_ex_scan, 0, n * sizeof(int), stream));
+  linalg::coo_degree(in->rows(), in->nnz, cur_ex_scan, stream);
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
+  thrust::device_ptr<int> dev_cur = thrust::device_pointer_cast(cur_ex_scan);
+  thrust::exclusive_scan(rmm::exec_policy(stream), dev_cur, dev_cur + n, dev_cur);
+
+  dim3 grid(raft::ceildiv(n, TPB_X), 1, 1);
+  dim3 blk(TPB_X, 1, 1);
+
+  coo_filter_count_kernel<TPB_X><<<grid, blk, 0, stream>>>(
+    in->rows(), in->cols(), in->vals(), in->nnz, cnnz, cur_ex_scan, n, max_row_degree, filter);
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
+
+  thrust::device_ptr<int> dev_cnnz = thrust::device_pointer_cast(cnnz);
+  int out_nnz = thrust::reduce(rmm::exec_policy(stream), dev_cnnz, dev_cnnz + n);
+  thrust::exclusive_scan(rmm::exec_policy(stream), dev_cnnz, dev_cnnz + n, dev_cnnz);
+
+  out->allocate(out_nnz, in->n_rows, in->n_cols, false, stream);
+
+  coo_filter_compact_kernel<TPB_X><<<grid, blk, 0, stream>>>(in->rows(),
+                                                             in->cols(),
+                                                             in->vals(),
+                                                             in->nnz,
+                                                             out->rows(),
+                                                             out->cols(),
+                                                             out->vals(),
+                                                             cnnz,
+                                                             cur_ex_scan,
+                                                             n,
+                                                             max_row_degree,
+                                                             filter);
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
+}
+
 };  // namespace detail
 };  // namespace op
 };  // end NAMESPACE sparse
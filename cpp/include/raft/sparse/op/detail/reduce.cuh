@@ -18,6 +18,7 @@
 
 #include <cusparse_v2.h>
 
+#include <raft/common/cub_wrappers.cuh>
 #include <raft/cuda_utils.cuh>
 #include <raft/cudart_utils.h>
 #include <raft/sparse/detail/cusparse_wrappers.h>
@@ -25,7 +26,6 @@
 #include <raft/device_atomics.cuh>
 #include <raft/sparse/op/sort.cuh>
 #include <thrust/device_ptr.h>
-#include <thrust/scan.h>
 
 #include <cuda_runtime.h>
 #include <rmm/device_uvector.hpp>
@@ -133,15 +133,15 @@ void max_duplicates(const raft::handle_t& handle,
                     size_t m,
                     size_t n)
 {
-  auto stream        = handle.get_stream();
-  auto thrust_policy = handle.get_thrust_policy();
+  auto stream = handle.get_stream();
 
   // compute diffs & take exclusive scan
   rmm::device_uvector<value_idx> diff(nnz + 1, stream);
 
   compute_duplicates_mask(diff.data(), rows, cols, nnz, stream);
 
-  thrust::exclusive_scan(thrust_policy, diff.data(), diff.data() + diff.size(), diff.data());
+  raft::exclusiveSum(
+    handle.get_workspace_arena(), diff.data(), diff.data(), (int)diff.size(), stream);
 
   // compute final size
   value_idx size = 0;
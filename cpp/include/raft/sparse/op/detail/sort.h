@@ -21,14 +21,21 @@
 #include <raft/sparse/coo.hpp>
 #include <raft/sparse/detail/cusparse_wrappers.h>
 #include <raft/sparse/detail/utils.h>
+#include <rmm/device_uvector.hpp>
 #include <rmm/exec_policy.hpp>
 
+#include <thrust/binary_search.h>
 #include <thrust/device_ptr.h>
+#include <thrust/gather.h>
+#include <thrust/iterator/counting_iterator.h>
 #include <thrust/iterator/zip_iterator.h>
 #include <thrust/scan.h>
+#include <thrust/sequence.h>
 #include <thrust/sort.h>
 #include <thrust/tuple.h>
 
+#include <cub/cub.cuh>
+
 #include <cusparse_v2.h>
 
 #include <cuda_runtime.h>
@@ -56,10 +63,34 @@ struct TupleComp {
   }
 };
 
+// below this size the comparison sort is faster than the extra
+// passes and allocations of the radix path
+constexpr int coo_sort_min_radix_nnz = 1 << 16;
+
+/**
+ * Number of key bits needed to radix sort indices in [0, max_val).
+ * Restricting the sort to the significant bits skips the radix
+ * passes over the (zero) high-order bits.
+ */
+inline int coo_sort_key_bits(int max_val)
+{
+  int bits = 1;
+  while (bits < 31 && (1 << bits) < max_val)
+    ++bits;
+  return bits;
+}
+
 /**
  * @brief Sorts the arrays that comprise the coo matrix
  * by row and then by column.
  *
+ * Large inputs are sorted with two radix passes: a
+ * `cub::DeviceRadixSort` pass groups the entries by row, then a
+ * `cub::DeviceSegmentedRadixSort` pass orders the columns within each
+ * row's segment. Both passes touch only the significant key bits, which
+ * makes this considerably faster than a comparison sort over the
+ * combined (row, col) key at large nnz.
+ *
  * @param m number of rows in coo matrix
  * @param n number of cols in coo matrix
  * @param nnz number of non-zeros
@@ -71,10 +102,93 @@ struct TupleComp {
 template <typename T>
 void coo_sort(int m, int n, int nnz, int* rows, int* cols, T* vals, cudaStream_t stream)
 {
-  auto coo_indices = thrust::make_zip_iterator(thrust::make_tuple(rows, cols));
+  if (nnz < coo_sort_min_radix_nnz) {
+    auto coo_indices = thrust::make_zip_iterator(thrust::make_tuple(rows, cols));
+
+    // get all the colors in contiguous locations so we can map them to warps.
+    thrust::sort_by_key(
+      rmm::exec_policy(stream), coo_indices, coo_indices + nnz, vals, TupleComp());
+    return;
+  }
 
-  // get all the colors in contiguous locations so we can map them to warps.
-  thrust::sort_by_key(rmm::exec_policy(stream), coo_indices, coo_indices + nnz, vals, TupleComp());
+  int row_bits = coo_sort_key_bits(m);
+  int col_bits = coo_sort_key_bits(n);
+
+  rmm::device_uvector<int> rows_sorted(nnz, stream);
+  rmm::device_uvector<int> perm(nnz, stream);
+  rmm::device_uvector<int> perm_sorted(nnz, stream);
+  rmm::device_uvector<int> offsets(m + 1, stream);
+  thrust::sequence(rmm::exec_policy(stream), perm.begin(), perm.end());
+
+  // a single allocation serves both sort passes
+  size_t row_sort_bytes = 0, col_sort_bytes = 0;
+  RAFT_CUDA_TRY(cub::DeviceRadixSort::SortPairs(nullptr,
+                                                row_sort_bytes,
+                                                rows,
+                                                rows_sorted.data(),
+                                                perm.data(),
+                                                perm_sorted.data(),
+                                                nnz,
+                                                0,
+                                                row_bits,
+                                                stream));
+  RAFT_CUDA_TRY(cub::DeviceSegmentedRadixSort::SortPairs(nullptr,
+                                                         col_sort_bytes,
+                                                         cols,
+                                                         cols,
+                                                         vals,
+                                                         vals,
+                                                         nnz,
+                                                         m,
+                                                         offsets.data(),
+                                                         offsets.data() + 1,
+                                                         0,
+                                                         col_bits,
+                                                         stream));
+  rmm::device_uvector<char> workspace(std::max(row_sort_bytes, col_sort_bytes), stream);
+
+  RAFT_CUDA_TRY(cub::DeviceRadixSort::SortPairs(workspace.data(),
+                                                row_sort_bytes,
+                                                rows,
+                                                rows_sorted.data(),
+                                                perm.data(),
+                                                perm_sorted.data(),
+                                                nnz,
+                                                0,
+                                                row_bits,
+                                                stream));
+  raft::copy_async(rows, rows_sorted.data(), nnz, stream);
+
+  // apply the row-grouping permutation to the columns and values,
+  // reusing the no-longer-needed pass-one buffers as gather targets
+  rmm::device_uvector<T> vals_grouped(nnz, stream);
+  thrust::gather(rmm::exec_policy(stream),
+                 perm_sorted.begin(),
+                 perm_sorted.end(),
+                 thrust::make_zip_iterator(thrust::make_tuple(cols, vals)),
+                 thrust::make_zip_iterator(thrust::make_tuple(perm.begin(), vals_grouped.begin())));
+
+  // row segment offsets: first position of each row id in the sorted rows
+  thrust::lower_bound(rmm::exec_policy(stream),
+                      rows,
+                      rows + nnz,
+                      thrust::make_counting_iterator(0),
+                      thrust::make_counting_iterator(m + 1),
+                      offsets.begin());
+
+  RAFT_CUDA_TRY(cub::DeviceSegmentedRadixSort::SortPairs(workspace.data(),
+                                                         col_sort_bytes,
+                                                         perm.data(),
+                                                         cols,
+                                                         vals_grouped.data(),
+                                                         vals,
+                                                         nnz,
+                                                         m,
+                                                         offsets.data(),
+                                                         offsets.data() + 1,
+                                                         0,
+                                                         col_bits,
+                                                         stream));
 }
 
 /**
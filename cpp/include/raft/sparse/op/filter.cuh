@@ -22,6 +22,8 @@
 #include <raft/sparse/coo.hpp>
 #include <raft/sparse/op/detail/filter.cuh>
 
+#include <limits>
+
 namespace raft {
 namespace sparse {
 namespace op {
@@ -87,6 +89,53 @@ void coo_remove_zeros(COO<T>* in, COO<T>* out, cudaStream_t stream)
   coo_remove_scalar<T>(in, out, T(0.0), stream);
 }
 
+/**
+ * @brief Filters the edges of a row-sorted COO matrix through a fused
+ * predicate and per-row degree cap in a single count+compact pass.
+ *
+ * Replaces chains of remove-zeros / remove-below-threshold / degree-cap
+ * invocations: compose the value predicates into one device lambda called
+ * as `filter(row, col, val)` and the degree cap keeps at most
+ * `max_row_degree` passing edges per row (earliest first, so sort by
+ * value beforehand to keep the strongest edges). The workspace holds the
+ * intermediate scans and is reused across chained invocations when the
+ * same uvector is passed.
+ *
+ * @param in: input COO matrix, sorted by row
+ * @param out: output COO matrix
+ * @param filter: device predicate; edges returning false are dropped
+ * @param max_row_degree: keep at most this many passing edges per row
+ * @param workspace: scratch buffer, resized to 2 * n_rows ints if smaller
+ * @param stream: cuda stream to use
+ */
+template <typename T, typename filter_f>
+void coo_filter(COO<T>* in,
+                COO<T>* out,
+                filter_f filter,
+                int max_row_degree,
+                rmm::device_uvector<int>& workspace,
+                cudaStream_t stream)
+{
+  detail::coo_filter<128, T, filter_f>(in, out, filter, max_row_degree, workspace, stream);
+}
+
+/**
+ * @brief Filters the edges of a row-sorted COO matrix through a device
+ * predicate, allocating the scratch space internally.
+ *
+ * @param in: input COO matrix, sorted by row
+ * @param out: output COO matrix
+ * @param filter: device predicate; edges returning false are dropped
+ * @param stream: cuda stream to use
+ */
+template <typename T, typename filter_f>
+void coo_filter(COO<T>* in, COO<T>* out, filter_f filter, cudaStream_t stream)
+{
+  rmm::device_uvector<int> workspace(0, stream);
+  detail::coo_filter<128, T, filter_f>(
+    in, out, filter, std::numeric_limits<int>::max(), workspace, stream);
+}
+
 };  // namespace op
 };  // end NAMESPACE sparse
 };  // end NAMESPACE raft
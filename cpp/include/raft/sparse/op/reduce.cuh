@@ -18,9 +18,11 @@
 
 #pragma once
 
+#include <raft/cudart_utils.h>
 #include <raft/handle.hpp>
 #include <raft/sparse/coo.hpp>
 #include <raft/sparse/op/detail/reduce.cuh>
+#include <raft/sparse/op/sort.cuh>
 
 namespace raft {
 namespace sparse {
@@ -79,6 +81,41 @@ void max_duplicates(const raft::handle_t& handle,
                     size_t n)
 {
   detail::max_duplicates(handle, out, rows, cols, vals, nnz, m, n);
+  out.sorted = true;
+  out.unique = true;
+}
+
+/**
+ * Performs a COO reduce of duplicate columns per row, taking the max weight
+ * for duplicate columns in each row. Sorts the input first if its sorted
+ * flag is not set, and passes the data straight through when the producer
+ * already guarantees uniqueness, skipping the duplicates mask and scan.
+ * @tparam value_idx
+ * @tparam value_t
+ * @param[in] handle
+ * @param[out] out output COO, the nnz will be computed allocate() will be called in this function.
+ * @param[in] in input COO, sorted in place when not already sorted
+ */
+template <typename value_idx, typename value_t>
+void max_duplicates(const raft::handle_t& handle,
+                    raft::sparse::COO<value_t, value_idx>& out,
+                    raft::sparse::COO<value_t, value_idx>& in)
+{
+  auto stream = handle.get_stream();
+
+  coo_sort(&in, stream);
+
+  if (in.unique) {
+    out.allocate(in.nnz, in.n_rows, in.n_cols, false, stream);
+    raft::copy_async(out.rows(), in.rows(), in.nnz, stream);
+    raft::copy_async(out.cols(), in.cols(), in.nnz, stream);
+    raft::copy_async(out.vals(), in.vals(), in.nnz, stream);
+  } else {
+    detail::max_duplicates(
+      handle, out, in.rows(), in.cols(), in.vals(), in.nnz, in.n_rows, in.n_cols);
+  }
+  out.sorted = true;
+  out.unique = true;
 }
 };  // END namespace op
 };  // END namespace sparse
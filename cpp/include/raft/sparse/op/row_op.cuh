@@ -19,6 +19,7 @@
 
 #include <raft/handle.hpp>
 #include <raft/sparse/op/detail/row_op.cuh>
+#include <raft/sparse/structure_stats.hpp>
 
 namespace raft {
 namespace sparse {
@@ -41,6 +42,36 @@ void csr_row_op(const Index_* row_ind, Index_ n_rows, Index_ nnz, Lambda op, cud
   detail::csr_row_op<Index_, 128, Lambda>(row_ind, n_rows, nnz, op, stream);
 }
 
+/**
+ * @brief Perform a custom row operation on a CSR matrix, choosing the launch
+ * shape from a precomputed row-structure summary. The kernel runs one thread
+ * per row, so a block only retires once its longest row finishes; on skewed
+ * matrices a smaller block limits how many finished threads a straggler row
+ * keeps resident.
+ * @tparam T numerical type of row_ind array
+ * @tparam Lambda type of custom operation function
+ * @param row_ind the CSR row_ind array to perform parallel operations over
+ * @param n_rows total number vertices in graph
+ * @param nnz number of non-zeros
+ * @param stats row-structure summary of the matrix (see structure_stats.cuh)
+ * @param op custom row operation functor accepting the row and beginning index.
+ * @param stream cuda stream to use
+ */
+template <typename Index_, typename Lambda = auto(Index_, Index_, Index_)->void>
+void csr_row_op(const Index_* row_ind,
+                Index_ n_rows,
+                Index_ nnz,
+                const structure_stats_t<Index_>& stats,
+                Lambda op,
+                cudaStream_t stream)
+{
+  if (stats.has_high_row_length_variance()) {
+    detail::csr_row_op<Index_, 32, Lambda>(row_ind, n_rows, nnz, op, stream);
+  } else {
+    detail::csr_row_op<Index_, 128, Lambda>(row_ind, n_rows, nnz, op, stream);
+  }
+}
+
 };  // namespace op
 };  // end NAMESPACE sparse
 };  // end NAMESPACE raft
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <raft/core/nvtx.hpp>
 #include <raft/handle.hpp>
 #include <raft/sparse/op/detail/sort.h>
 
@@ -40,11 +41,15 @@ namespace op {
 template <typename T>
 void coo_sort(int m, int n, int nnz, int* rows, int* cols, T* vals, cudaStream_t stream)
 {
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "sparse::coo_sort (%d, %d, %d)", m, n, nnz);
   detail::coo_sort(m, n, nnz, rows, cols, vals, stream);
 }
 
 /**
- * @brief Sort the underlying COO arrays by row
+ * @brief Sort the underlying COO arrays by row. A no-op when the COO's
+ * sorted flag indicates the producer already established the ordering;
+ * the flag is set on the way out so downstream stages can trust it.
  * @tparam T: the type name of the underlying value array
  * @param in: COO to sort by row
  * @param stream: the cuda stream to use
@@ -52,7 +57,9 @@ void coo_sort(int m, int n, int nnz, int* rows, int* cols, T* vals, cudaStream_t
 template <typename T>
 void coo_sort(COO<T>* const in, cudaStream_t stream)
 {
+  if (in->sorted) { return; }
   coo_sort<T>(in->n_rows, in->n_cols, in->nnz, in->rows(), in->cols(), in->vals(), stream);
+  in->sorted = true;
 }
 
 /**
@@ -69,6 +76,8 @@ template <typename value_idx, typename value_t>
 void coo_sort_by_weight(
   value_idx* rows, value_idx* cols, value_t* data, value_idx nnz, cudaStream_t stream)
 {
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope("sparse::coo_sort_by_weight (%zu)",
+                                                            size_t(nnz));
   detail::coo_sort_by_weight(rows, cols, data, nnz, stream);
 }
 };  // namespace op
@@ -61,6 +61,9 @@ value_idx get_n_components(value_idx* colors, size_t n_rows, cudaStream_t stream
  * @param[in] n_cols number of cols in X
  * @param[in] reduction_op
  * @param[in] metric
+ * @param[in] batch_size number of query rows per fused 1-nn pass, bounding
+ *            peak memory of the cross-component 1-nn. 0 processes all rows
+ *            at once.
  */
 template <typename value_idx, typename value_t, typename red_op>
 void connect_components(
@@ -71,9 +74,11 @@ void connect_components(
   size_t n_rows,
   size_t n_cols,
   red_op reduction_op,
-  raft::distance::DistanceType metric = raft::distance::DistanceType::L2SqrtExpanded)
+  raft::distance::DistanceType metric = raft::distance::DistanceType::L2SqrtExpanded,
+  size_t batch_size                   = 0)
 {
-  detail::connect_components(handle, out, X, orig_colors, n_rows, n_cols, reduction_op, metric);
+  detail::connect_components(
+    handle, out, X, orig_colors, n_rows, n_cols, reduction_op, metric, batch_size);
 }
 
 };  // end namespace linkage
@@ -40,6 +40,7 @@
 
 #include <cub/cub.cuh>
 
+#include <algorithm>
 #include <limits>
 
 namespace raft {
@@ -125,6 +126,30 @@ struct FixConnectivitiesRedOp {
   }
 };
 
+/**
+ * Adapts a reduction op to a contiguous batch of query rows by
+ * translating the batch-local row offsets reported by the fused
+ * 1-nn primitive back to the global row ids the wrapped op expects.
+ * @tparam value_idx
+ * @tparam value_t
+ * @tparam red_op reduction op being adapted
+ */
+template <typename value_idx, typename value_t, typename red_op>
+struct BatchOffsetRedOp {
+  red_op op;
+  value_idx offset;
+
+  BatchOffsetRedOp(red_op op_, value_idx offset_) : op(op_), offset(offset_) {}
+
+  typedef typename cub::KeyValuePair<value_idx, value_t> KVP;
+  DI void operator()(value_idx rit, KVP* out, const KVP& other) { op(rit + offset, out, other); }
+
+  DI KVP operator()(value_idx rit, const KVP& a, const KVP& b) { return op(rit + offset, a, b); }
+
+  DI void init(value_t* out, value_t maxVal) { op.init(out, maxVal); }
+  DI void init(KVP* out, value_t maxVal) { op.init(out, maxVal); }
+};
+
 /**
  * Assumes 3-iterator tuple containing COO rows, cols, and
  * a cub keyvalue pair object. Sorts the 3 arrays in
@@ -217,6 +242,10 @@ struct LookupColorOp {
  * @param[in] n_rows number of rows in original dense data
  * @param[in] n_cols number of columns in original dense data
  * @param[in] stream cuda stream for which to order cuda operations
+ * @param[in] reduction_op reduction op restricting results to cross-component neighbors
+ * @param[in] batch_size number of query rows per fused 1-nn pass. The
+ *            workspace of the fused pass is sized to the batch, bounding
+ *            peak memory for large inputs. 0 processes all rows at once.
  */
 template <typename value_idx, typename value_t, typename red_op>
 void perform_1nn(cub::KeyValuePair<value_idx, value_t>* kvp,
@@ -226,28 +255,39 @@ void perform_1nn(cub::KeyValuePair<value_idx, value_t>* kvp,
                  size_t n_rows,
                  size_t n_cols,
                  cudaStream_t stream,
-                 red_op reduction_op)
+                 red_op reduction_op,
+                 size_t batch_size = 0)
 {
-  rmm::device_uvector<int> workspace(n_rows, stream);
+  if (batch_size == 0 || batch_size > n_rows) { batch_size = n_rows; }
+
+  rmm::device_uvector<int> workspace(batch_size, stream);
   rmm::device_uvector<value_t> x_norm(n_rows, stream);
 
   raft::linalg::rowNorm(x_norm.data(), X, n_cols, n_rows, raft::linalg::L2Norm, true, stream);
 
-  raft::distance::fusedL2NN<value_t, cub::KeyValuePair<value_idx, value_t>, value_idx>(
-    kvp,
-    X,
-    X,
-    x_norm.data(),
-    x_norm.data(),
-    n_rows,
-    n_rows,
-    n_cols,
-    workspace.data(),
-    reduction_op,
-    reduction_op,
-    true,
-    true,
-    stream);
+  for (size_t offset = 0; offset < n_rows; offset += batch_size) {
+    size_t batch_rows = std::min(batch_size, n_rows - offset);
+
+    // the reduction op receives batch-local row offsets, so translate
+    // them back to global row ids before it touches the colors array
+    BatchOffsetRedOp<value_idx, value_t, red_op> batch_op(reduction_op, (value_idx)offset);
+
+    raft::distance::fusedL2NN<value_t, cub::KeyValuePair<value_idx, value_t>, value_idx>(
+      kvp + offset,
+      X + offset * n_cols,
+      X,
+      x_norm.data() + offset,
+      x_norm.data(),
+      batch_rows,
+      n_rows,
+      n_cols,
+      workspace.data(),
+      batch_op,
+      batch_op,
+      true,
+      true,
+      stream);
+  }
 
   LookupColorOp<value_idx, value_t> extract_colors_op(colors);
   thrust::transform(rmm::exec_policy(stream), kvp, kvp + n_rows, nn_colors, extract_colors_op);
@@ -354,6 +394,11 @@ void min_components_by_color(raft::sparse::COO<value_t, value_idx>& coo,
  * @param[in] colors array containing component number for each row of X
  * @param[in] n_rows number of rows in X
  * @param[in] n_cols number of cols in X
+ * @param[in] reduction_op reduction op restricting results to cross-component neighbors
+ * @param[in] metric distance metric
+ * @param[in] batch_size number of query rows per fused 1-nn pass, bounding
+ *            peak memory of the cross-component 1-nn. 0 processes all rows
+ *            at once.
  */
 template <typename value_idx, typename value_t, typename red_op>
 void connect_components(
@@ -364,7 +409,8 @@ void connect_components(
   size_t n_rows,
   size_t n_cols,
   red_op reduction_op,
-  raft::distance::DistanceType metric = raft::distance::DistanceType::L2SqrtExpanded)
+  raft::distance::DistanceType metric = raft::distance::DistanceType::L2SqrtExpanded,
+  size_t batch_size                   = 0)
 {
   auto stream = handle.get_stream();
 
@@ -395,7 +441,8 @@ void connect_components(
               n_rows,
               n_cols,
               stream,
-              reduction_op);
+              reduction_op,
+              batch_size);
 
   /**
    * Sort data points by color (neighbors are not sorted)
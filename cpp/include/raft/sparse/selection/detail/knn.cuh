@@ -29,6 +29,8 @@
 #include <raft/sparse/detail/utils.h>
 #include <raft/sparse/distance/distance.cuh>
 #include <raft/sparse/op/slice.cuh>
+#include <raft/spatial/knn/detail/topk/select_k_epilogue.cuh>
+#include <raft/spatial/knn/detail/topk/warpsort_topk.cuh>
 #include <raft/spatial/knn/knn.cuh>
 
 #include <algorithm>
@@ -114,6 +116,67 @@ struct csr_batcher_t {
   value_idx batch_csr_stop_offset_;
 };
 
+/**
+ * Runs the warp-select epilogue over one dense distance tile: each subwarp
+ * streams its query row straight into a register-resident warp_sort queue
+ * and writes only the k selected (value, index) pairs. Indices are
+ * synthesized from `idx_offset`, so no materialized indices array is needed
+ * alongside the tile.
+ */
+template <int Capacity, bool Ascending, typename value_t, typename value_idx>
+__global__ void dense_tile_select_k_kernel(const value_t* tile,
+                                           int n_rows,
+                                           int n_cols,
+                                           value_idx idx_offset,
+                                           int k,
+                                           value_t* out_dists,
+                                           value_idx* out_indices)
+{
+  using epilogue_t =
+    raft::spatial::knn::detail::topk::select_k_epilogue<Capacity, Ascending, value_t, value_idx>;
+
+  const int row = (blockIdx.x * blockDim.x + threadIdx.x) / epilogue_t::kWarpWidth;
+  if (row >= n_rows) return;
+
+  epilogue_t top_k(k);
+  top_k.consume_tile(tile + size_t(row) * n_cols, n_cols, idx_offset);
+  top_k.finish(out_dists + size_t(row) * k, out_indices + size_t(row) * k);
+}
+
+template <bool Ascending,
+          typename value_t,
+          typename value_idx,
+          int Capacity = spatial::knn::detail::topk::kMaxCapacity>
+struct dense_tile_select_k {
+  static void run(const value_t* tile,
+                  int n_rows,
+                  int n_cols,
+                  value_idx idx_offset,
+                  int k,
+                  value_t* out_dists,
+                  value_idx* out_indices,
+                  cudaStream_t stream)
+  {
+    const int capacity = spatial::knn::detail::topk::calc_capacity(k);
+    if constexpr (Capacity > 1) {
+      if (capacity < Capacity) {
+        return dense_tile_select_k<Ascending, value_t, value_idx, Capacity / 2>::run(
+          tile, n_rows, n_cols, idx_offset, k, out_dists, out_indices, stream);
+      }
+    }
+    ASSERT(capacity <= Capacity, "Requested k is too big (%d)", k);
+
+    constexpr int warp_width = std::min(Capacity, WarpSize);
+    constexpr int block_dim  = 128;
+    const int rows_per_block = block_dim / warp_width;
+    const int n_blocks       = raft::ceildiv(n_rows, rows_per_block);
+
+    dense_tile_select_k_kernel<Capacity, Ascending><<<n_blocks, block_dim, 0, stream>>>(
+      tile, n_rows, n_cols, idx_offset, k, out_dists, out_indices);
+    RAFT_CUDA_TRY(cudaPeekAtLastError());
+  }
+};
+
 template <typename value_idx, typename value_t>
 class sparse_knn_t {
  public:
@@ -247,13 +310,7 @@ class sparse_knn_t {
                           query_batch_data.data(),
                           batch_dists.data());
 
-        // Build batch indices array
-        rmm::device_uvector<value_idx> batch_indices(batch_dists.size(), handle.get_stream());
-
-        // populate batch indices array
-        value_idx batch_rows = query_batcher.batch_rows(), batch_cols = idx_batcher.batch_rows();
-
-        iota_fill(batch_indices.data(), batch_rows, batch_cols, handle.get_stream());
+        value_idx batch_rows = query_batcher.batch_rows();
 
         /**
          * Perform k-selection on batch & merge with other k-selections
@@ -265,7 +322,6 @@ class sparse_knn_t {
         perform_k_selection(idx_batcher,
                             query_batcher,
                             batch_dists.data(),
-                            batch_indices.data(),
                             dists_merge_buffer_ptr,
                             indices_merge_buffer_ptr);
 
@@ -319,10 +375,11 @@ class sparse_knn_t {
                      value_t* out_dists,
                      value_idx* out_indices)
   {
-    // build translation buffer to shift resulting indices by the batch
+    // the k-selection already writes global index ids (offset by the batch),
+    // so no per-part translation is needed when merging
     std::vector<value_idx> id_ranges;
     id_ranges.push_back(0);
-    id_ranges.push_back(idx_batcher.batch_start());
+    id_ranges.push_back(0);
 
     rmm::device_uvector<value_idx> trans(id_ranges.size(), handle.get_stream());
     raft::update_device(trans.data(), id_ranges.data(), id_ranges.size(), handle.get_stream());
@@ -341,36 +398,70 @@ class sparse_knn_t {
 
   void perform_k_selection(csr_batcher_t<value_idx, value_t> idx_batcher,
                            csr_batcher_t<value_idx, value_t> query_batcher,
-                           value_t* batch_dists,
-                           value_idx* batch_indices,
+                           const value_t* batch_dists,
                            value_t* out_dists,
                            value_idx* out_indices)
   {
-    // populate batch indices array
     value_idx batch_rows = query_batcher.batch_rows(), batch_cols = idx_batcher.batch_rows();
 
-    // build translation buffer to shift resulting indices by the batch
-    std::vector<value_idx> id_ranges;
-    id_ranges.push_back(0);
-    id_ranges.push_back(idx_batcher.batch_start());
-
-    // in the case where the number of idx rows in the batch is < k, we
-    // want to adjust k.
-    value_idx n_neighbors = std::min(static_cast<value_idx>(k), batch_cols);
-
     bool ascending = true;
     if (metric == raft::distance::DistanceType::InnerProduct) ascending = false;
 
-    // kernel to slice first (min) k cols and copy into batched merge buffer
-    raft::spatial::knn::select_k(batch_dists,
-                                 batch_indices,
-                                 batch_rows,
-                                 batch_cols,
-                                 out_dists,
-                                 out_indices,
-                                 ascending,
-                                 n_neighbors,
-                                 handle.get_stream());
+    if (k > spatial::knn::detail::topk::kMaxCapacity) {
+      // k beyond the warp_sort capacity: fall back to the faiss select over a
+      // materialized iota indices array, shifting the batch-local result ids
+      // to global ids afterwards so merging stays translation-free
+      rmm::device_uvector<value_idx> batch_indices((size_t)batch_rows * batch_cols,
+                                                   handle.get_stream());
+      iota_fill(batch_indices.data(), batch_rows, batch_cols, handle.get_stream());
+
+      value_idx n_neighbors = std::min(static_cast<value_idx>(k), batch_cols);
+
+      raft::spatial::knn::select_k(batch_dists,
+                                   batch_indices.data(),
+                                   batch_rows,
+                                   batch_cols,
+                                   out_dists,
+                                   out_indices,
+                                   ascending,
+                                   n_neighbors,
+                                   handle.get_stream());
+
+      value_idx offset = idx_batcher.batch_start();
+      raft::linalg::unaryOp(
+        out_indices,
+        out_indices,
+        (size_t)batch_rows * n_neighbors,
+        [offset] __device__(value_idx v) { return v + offset; },
+        handle.get_stream());
+      return;
+    }
+
+    // stream each dense tile row straight into a register-resident warp_sort
+    // queue. There is no materialized iota indices array (the index of a
+    // candidate is synthesized from the batch offset), which halves the
+    // intermediate memory per tile and thus allows much larger batch sizes
+    // for the same budget. Rows shorter than k come back padded with the
+    // queue's dummy value, which always loses the subsequent merges.
+    if (ascending) {
+      dense_tile_select_k<true, value_t, value_idx>::run(batch_dists,
+                                                         batch_rows,
+                                                         batch_cols,
+                                                         (value_idx)idx_batcher.batch_start(),
+                                                         k,
+                                                         out_dists,
+                                                         out_indices,
+                                                         handle.get_stream());
+    } else {
+      dense_tile_select_k<false, value_t, value_idx>::run(batch_dists,
+                                                          batch_rows,
+                                                          batch_cols,
+                                                          (value_idx)idx_batcher.batch_start(),
+                                                          k,
+                                                          out_dists,
+                                                          out_indices,
+                                                          handle.get_stream());
+    }
   }
 
   void compute_distances(csr_batcher_t<value_idx, value_t>& idx_batcher,
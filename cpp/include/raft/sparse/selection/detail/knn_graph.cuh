@@ -21,6 +21,7 @@
 
 #include <raft/sparse/coo.hpp>
 #include <raft/sparse/linalg/symmetrize.cuh>
+#include <raft/sparse/selection/detail/nn_descent.cuh>
 
 #include <raft/spatial/knn/knn.cuh>
 
@@ -38,6 +39,15 @@
 namespace raft {
 namespace sparse {
 namespace selection {
+
+/** How the neighborhoods of the knn graph are computed */
+enum graph_build_algo {
+  /** exact brute-force search */
+  BRUTE_FORCE,
+  /** approximate iterative graph refinement */
+  NN_DESCENT
+};
+
 namespace detail {
 
 /**
@@ -95,6 +105,15 @@ void conv_indices(in_t* inds, out_t* out, size_t size, cudaStream_t stream)
  * @param[out] out output edge list
  * @param[out] out output edge list
  * @param c
+ * @param batch_size number of query rows per neighbors search. 0 processes
+ * all rows in a single search, while a nonzero value bounds the temporary
+ * workspace of the underlying brute-force knn (and so its distance tiles) to
+ * the batch, letting the graph scale to row counts whose single-shot
+ * workspace would not fit on the device.
+ * @param build_algo exact brute-force search or approximate nn-descent
+ * refinement
+ * @param recall_target in (0, 1]; controls how long nn-descent keeps
+ * refining before terminating. Ignored by brute force.
  */
 template <typename value_idx = int, typename value_t = float>
 void knn_graph(const handle_t& handle,
@@ -103,7 +122,10 @@ void knn_graph(const handle_t& handle,
                size_t n,
                raft::distance::DistanceType metric,
                raft::sparse::COO<value_t, value_idx>& out,
-               int c = 15)
+               int c                       = 15,
+               size_t batch_size           = 0,
+               graph_build_algo build_algo = BRUTE_FORCE,
+               float recall_target         = 0.95f)
 {
   size_t k = build_k(m, c);
 
@@ -118,33 +140,45 @@ void knn_graph(const handle_t& handle,
   size_t blocks = ceildiv(nnz, (size_t)256);
   fill_indices<value_idx><<<blocks, 256, 0, stream>>>(rows.data(), k, nnz);
 
-  std::vector<value_t*> inputs;
-  inputs.push_back(const_cast<value_t*>(X));
-
-  std::vector<size_t> sizes;
-  sizes.push_back(m);
-
-  // This is temporary. Once faiss is updated, we should be able to
-  // pass value_idx through to knn.
-  rmm::device_uvector<int64_t> int64_indices(nnz, stream);
-
-  uint32_t knn_start = curTimeMillis();
-  raft::spatial::knn::brute_force_knn<int64_t, value_t, size_t>(handle,
-                                                                inputs,
-                                                                sizes,
-                                                                n,
-                                                                const_cast<value_t*>(X),
-                                                                m,
-                                                                int64_indices.data(),
-                                                                data.data(),
-                                                                k,
-                                                                true,
-                                                                true,
-                                                                nullptr,
-                                                                metric);
-
-  // convert from current knn's 64-bit to 32-bit.
-  conv_indices(int64_indices.data(), indices.data(), nnz, stream);
+  // refinement only pays off once the candidate pool is a small fraction
+  // of the dataset; below that the exact search is cheaper anyway
+  if (build_algo == NN_DESCENT && m > k * (k + 1)) {
+    nn_descent_graph(
+      handle, X, m, n, k, metric, indices.data(), data.data(), recall_target, batch_size);
+  } else {
+    std::vector<value_t*> inputs;
+    inputs.push_back(const_cast<value_t*>(X));
+
+    std::vector<size_t> sizes;
+    sizes.push_back(m);
+
+    if (batch_size == 0 || batch_size > m) { batch_size = m; }
+
+    // This is temporary. Once faiss is updated, we should be able to
+    // pass value_idx through to knn.
+    rmm::device_uvector<int64_t> int64_indices(batch_size * k, stream);
+
+    for (size_t offset = 0; offset < m; offset += batch_size) {
+      size_t batch_rows = std::min(batch_size, m - offset);
+      raft::spatial::knn::brute_force_knn<int64_t, value_t, size_t>(
+        handle,
+        inputs,
+        sizes,
+        n,
+        const_cast<value_t*>(X) + offset * n,
+        batch_rows,
+        int64_indices.data(),
+        data.data() + offset * k,
+        k,
+        true,
+        true,
+        nullptr,
+        metric);
+
+      // convert from current knn's 64-bit to 32-bit.
+      conv_indices(int64_indices.data(), indices.data() + offset * k, batch_rows * k, stream);
+    }
+  }
 
   raft::sparse::linalg::symmetrize(
     handle, rows.data(), indices.data(), data.data(), m, k, nnz, out);
@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/cuda_utils.cuh>
+#include <raft/cudart_utils.h>
+#include <raft/handle.hpp>
+
+#include <raft/distance/distance_type.hpp>
+#include <raft/spatial/knn/detail/selection_faiss.cuh>
+
+#include <rmm/device_uvector.hpp>
+#include <rmm/exec_policy.hpp>
+
+#include <thrust/functional.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/transform_reduce.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace raft {
+namespace sparse {
+namespace selection {
+namespace detail {
+
+/**
+ * Murmur-style finalizer used to scramble the seed neighborhoods so that
+ * the initial graph is not spatially correlated with row order.
+ */
+DI size_t nn_descent_hash(size_t h)
+{
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  return h;
+}
+
+template <typename value_t>
+DI value_t sq_l2_dist(const value_t* X, size_t a, size_t b, size_t n)
+{
+  value_t acc = 0;
+  for (size_t i = 0; i < n; i++) {
+    value_t diff = X[a * n + i] - X[b * n + i];
+    acc += diff * diff;
+  }
+  return acc;
+}
+
+/**
+ * Inserts a key into a shared-memory open-addressing table.
+ * Returns true if the key was not already present. The table must be
+ * initialized to -1 and sized to a power of two at least twice the
+ * number of insertions.
+ */
+template <typename value_idx>
+DI bool nn_descent_hash_insert(value_idx* table, int hash_size, value_idx key)
+{
+  int h = ((uint32_t)key * 2654435761u) & (hash_size - 1);
+  while (true) {
+    value_idx prev = atomicCAS(table + h, (value_idx)-1, key);
+    if (prev == -1) return true;
+    if (prev == key) return false;
+    h = (h + 1) & (hash_size - 1);
+  }
+}
+
+/**
+ * Seeds each row with k distinct pseudo-random neighbors (never the row
+ * itself) and computes their distances.
+ */
+template <typename value_idx, typename value_t>
+__global__ void nn_descent_init_kernel(
+  const value_t* X, size_t m, size_t n, int k, value_idx* graph_ids, value_t* graph_dists)
+{
+  size_t tid = (size_t)blockIdx.x * blockDim.x + threadIdx.x;
+  if (tid >= m * k) return;
+
+  size_t v = tid / k;
+  size_t j = tid % k;
+
+  // a scrambled contiguous run stays distinct within the row; the
+  // neighbor-of-neighbor expansion diversifies it within a few rounds
+  size_t span = m - k;
+  size_t start = span > 0 ? nn_descent_hash(v) % span : 0;
+  value_idx id = (value_idx)((v + 1 + start + j) % m);
+
+  graph_ids[tid]   = id;
+  graph_dists[tid] = sq_l2_dist(X, v, (size_t)id, n);
+}
+
+/**
+ * Expands each node's candidate set to its neighbors plus its neighbors'
+ * neighbors, deduplicating through a shared-memory hash table, and
+ * computes the candidate distances. Duplicates and self-edges are masked
+ * with the identity so the subsequent select_k ignores them.
+ */
+template <int tpb, typename value_idx, typename value_t>
+__global__ void nn_descent_candidates_kernel(const value_t* X,
+                                             size_t m,
+                                             size_t n,
+                                             int k,
+                                             const value_idx* graph_ids,
+                                             size_t batch_offset,
+                                             int n_cands,
+                                             int hash_size,
+                                             value_idx* cand_ids,
+                                             value_t* cand_dists)
+{
+  extern __shared__ char smem[];
+  value_idx* table = (value_idx*)smem;
+
+  size_t v = batch_offset + blockIdx.x;
+
+  for (int i = threadIdx.x; i < hash_size; i += tpb)
+    table[i] = -1;
+  __syncthreads();
+
+  size_t out_offset = (size_t)blockIdx.x * n_cands;
+
+  for (int j = threadIdx.x; j < n_cands; j += tpb) {
+    value_idx id;
+    if (j < k) {
+      id = graph_ids[v * k + j];
+    } else {
+      value_idx u = graph_ids[v * k + (j - k) / k];
+      id          = graph_ids[(size_t)u * k + (j - k) % k];
+    }
+
+    bool keep = id != (value_idx)v && nn_descent_hash_insert(table, hash_size, id);
+    cand_ids[out_offset + j] = keep ? id : (value_idx)-1;
+  }
+  __syncthreads();
+
+  for (int j = threadIdx.x; j < n_cands; j += tpb) {
+    value_idx id = cand_ids[out_offset + j];
+    cand_dists[out_offset + j] =
+      id < 0 ? std::numeric_limits<value_t>::max() : sq_l2_dist(X, v, (size_t)id, n);
+  }
+}
+
+template <typename value_idx, typename value_t>
+__global__ void nn_descent_finalize_kernel(const value_idx* graph_ids,
+                                           const value_t* graph_dists,
+                                           value_idx* out_indices,
+                                           value_t* out_dists,
+                                           size_t nnz,
+                                           bool take_sqrt)
+{
+  size_t tid = (size_t)blockIdx.x * blockDim.x + threadIdx.x;
+  if (tid >= nnz) return;
+  out_indices[tid] = graph_ids[tid];
+  out_dists[tid]   = take_sqrt ? raft::mySqrt(graph_dists[tid]) : graph_dists[tid];
+}
+
+/**
+ * Builds an approximate knn graph by iterative neighborhood refinement
+ * (NN-descent): each round expands every node's candidate pool with its
+ * neighbors' neighbors, prunes it back to the k best with select_k, and
+ * stops once the fraction of rows still improving drops below the level
+ * implied by the recall target. The exact search this replaces is
+ * O(m^2 * n); refinement converges in a bounded number of rounds of
+ * O(m * k^2 * n) work each.
+ *
+ * @param[in] handle raft handle
+ * @param[in] X dense row-major input matrix (m * n)
+ * @param[in] m number of rows in X
+ * @param[in] n number of columns in X
+ * @param[in] k neighborhood size
+ * @param[in] metric distance metric; only the L2 family is supported
+ * @param[out] out_indices neighbor ids (m * k)
+ * @param[out] out_dists neighbor distances (m * k)
+ * @param[in] recall_target in (0, 1]; higher targets run more refinement
+ *            rounds before terminating
+ * @param[in] batch_size rows refined per candidate batch; 0 picks a
+ *            default that bounds the candidate workspace
+ */
+template <typename value_idx, typename value_t>
+void nn_descent_graph(const handle_t& handle,
+                      const value_t* X,
+                      size_t m,
+                      size_t n,
+                      size_t k,
+                      raft::distance::DistanceType metric,
+                      value_idx* out_indices,
+                      value_t* out_dists,
+                      float recall_target,
+                      size_t batch_size = 0)
+{
+  bool take_sqrt = metric == raft::distance::DistanceType::L2SqrtExpanded ||
+                   metric == raft::distance::DistanceType::L2SqrtUnexpanded;
+  RAFT_EXPECTS(take_sqrt || metric == raft::distance::DistanceType::L2Expanded ||
+                 metric == raft::distance::DistanceType::L2Unexpanded,
+               "only L2 distance metrics are supported by nn-descent graph building");
+  RAFT_EXPECTS(recall_target > 0.0f && recall_target <= 1.0f,
+               "recall_target must be within (0, 1]");
+
+  auto stream = handle.get_stream();
+
+  int n_cands   = k * (k + 1);
+  int hash_size = 1;
+  while (hash_size < 2 * n_cands)
+    hash_size <<= 1;
+  size_t smem_size = hash_size * sizeof(value_idx);
+  RAFT_EXPECTS(smem_size <= 48 * 1024,
+               "neighborhood size too large for nn-descent candidate hashing");
+
+  if (batch_size == 0 || batch_size > m) { batch_size = std::min(m, (size_t)32768); }
+
+  rmm::device_uvector<value_idx> graph_ids(m * k, stream);
+  rmm::device_uvector<value_t> graph_dists(m * k, stream);
+  rmm::device_uvector<value_idx> new_ids(m * k, stream);
+  rmm::device_uvector<value_t> new_dists(m * k, stream);
+  rmm::device_uvector<value_idx> cand_ids(batch_size * n_cands, stream);
+  rmm::device_uvector<value_t> cand_dists(batch_size * n_cands, stream);
+
+  constexpr int tpb = 128;
+
+  size_t blocks = raft::ceildiv(m * k, (size_t)tpb);
+  nn_descent_init_kernel<<<blocks, tpb, 0, stream>>>(
+    X, m, n, (int)k, graph_ids.data(), graph_dists.data());
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
+
+  // rows are considered converged once their worst neighbor stops
+  // improving; the recall target sets how few unconverged rows we
+  // tolerate before stopping
+  double min_improved_frac = std::max(1.0 - (double)recall_target, 1e-4);
+  constexpr int max_iter   = 30;
+
+  for (int iter = 0; iter < max_iter; iter++) {
+    for (size_t offset = 0; offset < m; offset += batch_size) {
+      size_t batch_rows = std::min(batch_size, m - offset);
+
+      nn_descent_candidates_kernel<tpb>
+        <<<batch_rows, tpb, smem_size, stream>>>(X,
+                                                 m,
+                                                 n,
+                                                 (int)k,
+                                                 graph_ids.data(),
+                                                 offset,
+                                                 n_cands,
+                                                 hash_size,
+                                                 cand_ids.data(),
+                                                 cand_dists.data());
+      RAFT_CUDA_TRY(cudaPeekAtLastError());
+
+      raft::spatial::knn::detail::select_k(cand_dists.data(),
+                                           cand_ids.data(),
+                                           batch_rows,
+                                           (size_t)n_cands,
+                                           new_dists.data() + offset * k,
+                                           new_ids.data() + offset * k,
+                                           true,
+                                           (int)k,
+                                           stream);
+    }
+
+    const value_t* old_dists_ptr = graph_dists.data();
+    const value_t* new_dists_ptr = new_dists.data();
+    int k_                       = k;
+    size_t n_improved            = thrust::transform_reduce(
+      rmm::exec_policy(stream),
+      thrust::make_counting_iterator<size_t>(0),
+      thrust::make_counting_iterator<size_t>(m),
+      [=] __device__(size_t v) -> size_t {
+        value_t old_worst = 0;
+        for (int j = 0; j < k_; j++)
+          old_worst = max(old_worst, old_dists_ptr[v * k_ + j]);
+        return new_dists_ptr[v * k_ + k_ - 1] < old_worst ? 1 : 0;
+      },
+      (size_t)0,
+      thrust::plus<size_t>());
+
+    std::swap(graph_ids, new_ids);
+    std::swap(graph_dists, new_dists);
+
+    if (n_improved < (size_t)(min_improved_frac * m)) break;
+  }
+
+  nn_descent_finalize_kernel<<<blocks, tpb, 0, stream>>>(
+    graph_ids.data(), graph_dists.data(), out_indices, out_dists, m * k, take_sqrt);
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
+}
+
+};  // namespace detail
+};  // namespace selection
+};  // namespace sparse
+};  // end namespace raft
@@ -43,6 +43,14 @@ namespace selection {
  * @param[in] metric distance metric to use when constructing neighborhoods
  * @param[out] out output edge list
  * @param c
+ * @param batch_size number of query rows per neighbors search; 0 processes
+ * all rows at once. A nonzero value bounds the search workspace to the batch
+ * so graphs can be built over inputs too large for a single-shot search.
+ * @param build_algo exact brute-force search (default) or approximate
+ * nn-descent graph refinement, which trades a small recall loss for far
+ * less compute on large inputs
+ * @param recall_target in (0, 1]; higher targets make nn-descent refine
+ * longer before terminating. Ignored by brute force.
  */
 template <typename value_idx = int, typename value_t = float>
 void knn_graph(const handle_t& handle,
@@ -51,9 +59,12 @@ void knn_graph(const handle_t& handle,
                std::size_t n,
                raft::distance::DistanceType metric,
                raft::sparse::COO<value_t, value_idx>& out,
-               int c = 15)
+               int c                       = 15,
+               std::size_t batch_size      = 0,
+               graph_build_algo build_algo = BRUTE_FORCE,
+               float recall_target         = 0.95f)
 {
-  detail::knn_graph(handle, X, m, n, metric, out, c);
+  detail::knn_graph(handle, X, m, n, metric, out, c, batch_size, build_algo, recall_target);
 }
 
 };  // namespace selection
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/sparse/detail/structure_stats.cuh>
+#include <raft/sparse/structure_stats.hpp>
+
+namespace raft {
+namespace sparse {
+
+/**
+ * @brief Computes the row-structure summary of a CSR matrix.
+ *
+ * Intended to be computed once when a matrix is constructed and carried
+ * alongside the CSR arrays; the sparse kernels consult it to choose
+ * load-balancing strategies and launch shapes without re-scanning the
+ * row offsets (see e.g. the semiring SPMV strategy chooser and
+ * `op::csr_row_op`).
+ *
+ * @tparam value_idx index type of the CSR arrays
+ * @param[in] indptr CSR row offsets array [on device] [len = n_rows + 1]
+ * @param[in] n_rows number of rows
+ * @param[in] nnz number of nonzeros
+ * @param[in] stream cuda stream
+ * @return the populated summary (synchronizes the stream)
+ */
+template <typename value_idx>
+structure_stats_t<value_idx> compute_structure_stats(const value_idx* indptr,
+                                                     value_idx n_rows,
+                                                     value_idx nnz,
+                                                     cudaStream_t stream)
+{
+  return detail::compute_structure_stats(indptr, n_rows, nnz, stream);
+}
+
+}  // namespace sparse
+}  // namespace raft
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+namespace raft {
+namespace sparse {
+
+/**
+ * @brief Row-structure summary of a CSR matrix.
+ *
+ * Computed once per matrix (see structure_stats.cuh) and carried alongside
+ * the CSR arrays so kernel dispatch heuristics can consult the row-length
+ * distribution without rescanning the row offsets.
+ */
+template <typename value_idx>
+struct structure_stats_t {
+  /** number of rows */
+  value_idx n_rows{0};
+  /** number of nonzeros */
+  value_idx nnz{0};
+  /** longest row */
+  value_idx max_row_len{0};
+  /** 99th percentile row length */
+  value_idx p99_row_len{0};
+  /** mean row length */
+  double mean_row_len{0.0};
+  /** standard deviation of the row lengths */
+  double row_len_std{0.0};
+
+  /**
+   * Whether the row lengths are heavily skewed, defined as the row-length
+   * variance exceeding the squared mean (true for power-law distributions,
+   * false for roughly uniform ones).
+   */
+  bool has_high_row_length_variance() const
+  {
+    return row_len_std * row_len_std > mean_row_len * mean_row_len;
+  }
+};
+
+}  // namespace sparse
+}  // namespace raft
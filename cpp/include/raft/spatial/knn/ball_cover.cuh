@@ -23,6 +23,7 @@
 #include "ball_cover_common.h"
 #include "detail/ball_cover.cuh"
 #include "detail/ball_cover/common.cuh"
+#include <raft/core/nvtx.hpp>
 #include <raft/distance/distance_type.hpp>
 #include <thrust/transform.h>
 
@@ -34,6 +35,8 @@ template <typename value_idx = std::int64_t, typename value_t, typename value_in
 void rbc_build_index(const raft::handle_t& handle,
                      BallCoverIndex<value_idx, value_t, value_int>& index)
 {
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "spatial::rbc_build_index (%zu, %zu)", size_t(index.m), size_t(index.n));
   ASSERT(index.n <= 3, "only 2d and 3d vectors are supported in current implementation");
   if (index.metric == raft::distance::DistanceType::Haversine) {
     detail::rbc_build_index(handle, index, detail::HaversineFunc<value_t, value_int>());
@@ -74,6 +77,13 @@ void rbc_build_index(const raft::handle_t& handle,
  *               based on how many relevant balls are ignored. Note that
  *               many datasets can still have great recall even by only
  *               looking in the closest landmark.
+ * @param reciprocal share pass-one distances across symmetric pairs: b
+ *               appearing in a's candidate list seeds a into b's list at
+ *               the already-computed distance. This only adds exact
+ *               candidates (results are unchanged for exact queries and
+ *               recall can only improve for approximate ones) and tightens
+ *               the pruning bounds of the post-filtering pass, so it is on
+ *               by default for this self-join variant.
  */
 template <typename value_idx = std::int64_t, typename value_t, typename value_int = std::uint32_t>
 void rbc_all_knn_query(const raft::handle_t& handle,
@@ -82,8 +92,11 @@ void rbc_all_knn_query(const raft::handle_t& handle,
                        value_idx* inds,
                        value_t* dists,
                        bool perform_post_filtering = true,
-                       float weight                = 1.0)
+                       float weight                = 1.0,
+                       bool reciprocal             = true)
 {
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "spatial::rbc_all_knn_query (%zu, %d)", size_t(index.m), int(k));
   ASSERT(index.n <= 3, "only 2d and 3d vectors are supported in current implementation");
   if (index.metric == raft::distance::DistanceType::Haversine) {
     detail::rbc_all_knn_query(handle,
@@ -93,7 +106,8 @@ void rbc_all_knn_query(const raft::handle_t& handle,
                               dists,
                               detail::HaversineFunc<value_t, value_int>(),
                               perform_post_filtering,
-                              weight);
+                              weight,
+                              reciprocal);
   } else if (index.metric == raft::distance::DistanceType::L2SqrtExpanded ||
              index.metric == raft::distance::DistanceType::L2SqrtUnexpanded) {
     detail::rbc_all_knn_query(handle,
@@ -103,7 +117,8 @@ void rbc_all_knn_query(const raft::handle_t& handle,
                               dists,
                               detail::EuclideanFunc<value_t, value_int>(),
                               perform_post_filtering,
-                              weight);
+                              weight,
+                              reciprocal);
   } else {
     RAFT_FAIL("Metric not supported");
   }
@@ -151,6 +166,8 @@ void rbc_knn_query(const raft::handle_t& handle,
                    bool perform_post_filtering = true,
                    float weight                = 1.0)
 {
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "spatial::rbc_knn_query (%zu, %d)", size_t(n_query_pts), int(k));
   ASSERT(index.n <= 3, "only 2d and 3d vectors are supported in current implementation");
   if (index.metric == raft::distance::DistanceType::Haversine) {
     detail::rbc_knn_query(handle,
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/spatial/knn/ball_cover_common.h>
+#include <raft/spatial/knn/detail/index_serialize.hpp>
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+
+namespace raft {
+namespace spatial {
+namespace knn {
+
+namespace detail {
+constexpr uint32_t kRbcSerializationMagic   = 0x52424349;  // "RBCI"
+constexpr uint32_t kRbcSerializationVersion = 1;
+}  // namespace detail
+
+/**
+ * @brief Write a trained ball cover index to a binary stream.
+ *
+ * The format is a small versioned header (magic, version, element sizes,
+ * metric and shape) followed by the derived index structures — landmark CSR,
+ * landmark distances, radii and landmark coordinates — as contiguous blocks.
+ * The raw dataset `X` is not written: the index never owned it, and the
+ * caller must supply the same dataset again when reconstructing.
+ *
+ * @param[in] index a trained ball cover index
+ * @param[in] os output stream, opened in binary mode
+ */
+template <typename value_idx, typename value_t, typename value_int = std::uint32_t>
+void rbc_serialize(BallCoverIndex<value_idx, value_t, value_int>& index, std::ostream& os)
+{
+  RAFT_EXPECTS(index.is_index_trained(), "rbc_serialize: the index must be trained first");
+  auto stream = index.handle.get_stream();
+
+  detail::serialize_scalar(os, detail::kRbcSerializationMagic);
+  detail::serialize_scalar(os, detail::kRbcSerializationVersion);
+  detail::serialize_scalar<uint32_t>(os, sizeof(value_idx));
+  detail::serialize_scalar<uint32_t>(os, sizeof(value_t));
+  detail::serialize_scalar<uint32_t>(os, sizeof(value_int));
+  detail::serialize_scalar<int32_t>(os, int32_t(index.metric));
+  detail::serialize_scalar<uint64_t>(os, index.m);
+  detail::serialize_scalar<uint64_t>(os, index.n);
+  detail::serialize_scalar<uint64_t>(os, index.n_landmarks);
+
+  detail::serialize_device_array(os, index.get_R_indptr(), index.n_landmarks + 1, stream);
+  detail::serialize_device_array(os, index.get_R_1nn_cols(), index.m, stream);
+  detail::serialize_device_array(os, index.get_R_1nn_dists(), index.m, stream);
+  detail::serialize_device_array(os, index.get_R_closest_landmark_dists(), index.m, stream);
+  detail::serialize_device_array(os, index.get_R_radius(), index.n_landmarks, stream);
+  detail::serialize_device_array(
+    os, index.get_R(), size_t(index.n_landmarks) * index.n, stream);
+  RAFT_EXPECTS(os.good(), "rbc_serialize: writing the index failed");
+}
+
+/**
+ * @brief Restore a ball cover index written by `rbc_serialize`, skipping the
+ * (minutes-long for large datasets) `rbc_build_index` step.
+ *
+ * The caller constructs the index over the same dataset the serialized one
+ * was built on — `BallCoverIndex` does not own `X`, so only the derived
+ * structures travel through the file. The header is checked against the
+ * constructed index; a mismatch in types, metric or shape raises.
+ *
+ * @param[inout] index a freshly constructed (untrained) ball cover index
+ * @param[in] is input stream, opened in binary mode
+ */
+template <typename value_idx, typename value_t, typename value_int = std::uint32_t>
+void rbc_deserialize(BallCoverIndex<value_idx, value_t, value_int>& index, std::istream& is)
+{
+  auto stream = index.handle.get_stream();
+
+  RAFT_EXPECTS(detail::deserialize_scalar<uint32_t>(is) == detail::kRbcSerializationMagic,
+               "rbc_deserialize: not a ball cover index file");
+  RAFT_EXPECTS(detail::deserialize_scalar<uint32_t>(is) == detail::kRbcSerializationVersion,
+               "rbc_deserialize: unsupported format version");
+  RAFT_EXPECTS(detail::deserialize_scalar<uint32_t>(is) == sizeof(value_idx) &&
+                 detail::deserialize_scalar<uint32_t>(is) == sizeof(value_t) &&
+                 detail::deserialize_scalar<uint32_t>(is) == sizeof(value_int),
+               "rbc_deserialize: element types do not match the file");
+  RAFT_EXPECTS(detail::deserialize_scalar<int32_t>(is) == int32_t(index.metric),
+               "rbc_deserialize: metric does not match the file");
+  RAFT_EXPECTS(detail::deserialize_scalar<uint64_t>(is) == uint64_t(index.m) &&
+                 detail::deserialize_scalar<uint64_t>(is) == uint64_t(index.n) &&
+                 detail::deserialize_scalar<uint64_t>(is) == uint64_t(index.n_landmarks),
+               "rbc_deserialize: index shape does not match the file");
+
+  detail::deserialize_device_array(is, index.get_R_indptr(), index.n_landmarks + 1, stream);
+  detail::deserialize_device_array(is, index.get_R_1nn_cols(), index.m, stream);
+  detail::deserialize_device_array(is, index.get_R_1nn_dists(), index.m, stream);
+  detail::deserialize_device_array(is, index.get_R_closest_landmark_dists(), index.m, stream);
+  detail::deserialize_device_array(is, index.get_R_radius(), index.n_landmarks, stream);
+  detail::deserialize_device_array(
+    is, index.get_R(), size_t(index.n_landmarks) * index.n, stream);
+
+  index.set_index_trained();
+}
+
+}  // namespace knn
+}  // namespace spatial
+}  // namespace raft
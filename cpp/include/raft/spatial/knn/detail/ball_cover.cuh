@@ -219,6 +219,102 @@ void compute_landmark_radii(const raft::handle_t& handle,
                    });
 }
 
+template <typename value_idx, typename value_t, typename value_int = std::uint32_t>
+__global__ void reciprocal_merge_kernel(value_idx* inds,
+                                        value_t* dists,
+                                        const value_idx* rev_indptr,
+                                        const value_idx* rev_src,
+                                        const value_t* rev_dists,
+                                        value_int m,
+                                        value_int k)
+{
+  value_int b = blockIdx.x * blockDim.x + threadIdx.x;
+  if (b >= m) return;
+
+  // each thread owns one output row exclusively: the reversed edges are
+  // grouped by destination, so no synchronization is needed
+  value_idx* row_i = inds + std::size_t(b) * k;
+  value_t* row_d   = dists + std::size_t(b) * k;
+
+  for (value_idx j = rev_indptr[b]; j < rev_indptr[b + 1]; ++j) {
+    value_idx src = rev_src[j];
+    value_t d     = rev_dists[j];
+    if (d >= row_d[k - 1]) continue;
+
+    bool found = false;
+    for (value_int l = 0; l < k; ++l) {
+      if (row_i[l] == src) {
+        found = true;
+        break;
+      }
+    }
+    if (found) continue;
+
+    // insert keeping the row sorted ascending, dropping the current kth
+    value_int l = k - 1;
+    while (l > 0 && row_d[l - 1] > d) {
+      row_d[l] = row_d[l - 1];
+      row_i[l] = row_i[l - 1];
+      --l;
+    }
+    row_d[l] = d;
+    row_i[l] = src;
+  }
+}
+
+/**
+ * Seeds each point's candidate list with the distances its symmetric
+ * partners already computed: in a self-join, b appearing in a's knn list
+ * means d(a, b) is known and is an equally valid candidate for a in b's
+ * list. Reversing the edge list and merging costs only a sort of the m*k
+ * edges — no distance computations — and tightens the kth-distance bound
+ * the post-filtering pass prunes with, cutting the redundant half of the
+ * symmetric-pair distance work.
+ */
+template <typename value_idx, typename value_t, typename value_int = std::uint32_t>
+void reciprocal_candidate_merge(const raft::handle_t& handle,
+                                value_int m,
+                                value_int k,
+                                value_idx* inds,
+                                value_t* dists)
+{
+  std::size_t n_edges = std::size_t(m) * k;
+  rmm::device_uvector<value_idx> rev_rows(n_edges, handle.get_stream());
+  rmm::device_uvector<value_idx> rev_src(n_edges, handle.get_stream());
+  rmm::device_uvector<value_t> rev_dists(n_edges, handle.get_stream());
+
+  value_idx* rev_rows_ptr  = rev_rows.data();
+  value_idx* rev_src_ptr   = rev_src.data();
+  value_t* rev_dists_ptr   = rev_dists.data();
+  const value_idx* inds_c  = inds;
+  const value_t* dists_c   = dists;
+  value_int k_             = k;
+  value_idx sentinel_row   = m;
+
+  // reverse the edges; unfilled entries go to a sentinel row past the end
+  auto idxs = thrust::make_counting_iterator<std::size_t>(0);
+  thrust::for_each(handle.get_thrust_policy(), idxs, idxs + n_edges, [=] __device__(std::size_t e) {
+    value_idx dst   = inds_c[e];
+    bool valid      = dst != std::numeric_limits<value_idx>::max();
+    rev_rows_ptr[e] = valid ? dst : sentinel_row;
+    rev_src_ptr[e]  = value_idx(e / k_);
+    rev_dists_ptr[e] = dists_c[e];
+  });
+
+  auto vals = thrust::make_zip_iterator(thrust::make_tuple(rev_src.data(), rev_dists.data()));
+  thrust::sort_by_key(handle.get_thrust_policy(), rev_rows.data(), rev_rows.data() + n_edges, vals);
+
+  rmm::device_uvector<value_idx> rev_indptr(m + 2, handle.get_stream());
+  raft::sparse::convert::sorted_coo_to_csr(
+    rev_rows.data(), int(n_edges), rev_indptr.data(), int(m + 2), handle.get_stream());
+
+  int tpb = 256;
+  reciprocal_merge_kernel<value_idx, value_t, value_int>
+    <<<raft::ceildiv<value_int>(m, tpb), tpb, 0, handle.get_stream()>>>(
+      inds, dists, rev_indptr.data(), rev_src.data(), rev_dists.data(), m, k);
+  RAFT_CUDA_TRY(cudaGetLastError());
+}
+
 /**
  * 4. Perform k-select over original KNN, using L_r to filter distances
  *
@@ -246,7 +342,8 @@ void perform_rbc_query(const raft::handle_t& handle,
                        value_int* dists_counter,
                        value_int* post_dists_counter,
                        float weight                = 1.0,
-                       bool perform_post_filtering = true)
+                       bool perform_post_filtering = true,
+                       bool reciprocal             = false)
 {
   // initialize output inds and dists
   thrust::fill(handle.get_thrust_policy(),
@@ -273,6 +370,10 @@ void perform_rbc_query(const raft::handle_t& handle,
                                                            weight,
                                                            dists_counter);
 
+    // self-joins: share the pass-one distances across symmetric pairs so
+    // the post-filtering heaps start with tighter pruning bounds
+    if (reciprocal) { reciprocal_candidate_merge(handle, n_query_pts, value_int(k), inds, dists); }
+
     if (perform_post_filtering) {
       rbc_low_dim_pass_two<value_idx, value_t, value_int, 2>(handle,
                                                              index,
@@ -303,6 +404,8 @@ void perform_rbc_query(const raft::handle_t& handle,
                                                            weight,
                                                            dists_counter);
 
+    if (reciprocal) { reciprocal_candidate_merge(handle, n_query_pts, value_int(k), inds, dists); }
+
     if (perform_post_filtering) {
       rbc_low_dim_pass_two<value_idx, value_t, value_int, 3>(handle,
                                                              index,
@@ -401,7 +504,8 @@ void rbc_all_knn_query(const raft::handle_t& handle,
                        distance_func dfunc,
                        // approximate nn options
                        bool perform_post_filtering = true,
-                       float weight                = 1.0)
+                       float weight                = 1.0,
+                       bool reciprocal             = true)
 {
   ASSERT(index.n <= 3, "only 2d and 3d vectors are supported in current implementation");
   ASSERT(index.n_landmarks >= k, "number of landmark samples must be >= k");
@@ -451,7 +555,8 @@ void rbc_all_knn_query(const raft::handle_t& handle,
                     dists_counter.data(),
                     post_dists_counter.data(),
                     weight,
-                    perform_post_filtering);
+                    perform_post_filtering,
+                    reciprocal);
 }
 
 /**
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "knn_brute_force_faiss.cuh"
+
+#include <raft/cuda_utils.cuh>
+#include <raft/cudart_utils.h>
+#include <raft/handle.hpp>
+#include <raft/linalg/unary_op.cuh>
+
+#include <rmm/device_scalar.hpp>
+#include <rmm/device_uvector.hpp>
+#include <rmm/exec_policy.hpp>
+
+#include <thrust/scan.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+namespace raft {
+namespace spatial {
+namespace knn {
+namespace detail {
+
+/** Tombstones the given rows; counts only rows that were still live. */
+template <typename IdxT>
+__global__ void markDeletedKernel(std::uint32_t* deleted,
+                                  const IdxT* row_ids,
+                                  IdxT n_ids,
+                                  unsigned long long* n_newly_deleted)
+{
+  for (IdxT i = blockIdx.x * blockDim.x + threadIdx.x; i < n_ids; i += gridDim.x * blockDim.x) {
+    if (atomicExch(deleted + row_ids[i], 1u) == 0u) { atomicAdd(n_newly_deleted, 1ull); }
+  }
+}
+
+/**
+ * Per query row, keeps the first k of k2 over-fetched candidates whose row is
+ * not tombstoned, padding with sentinels if fewer remain.
+ */
+template <typename value_idx, typename value_t>
+__global__ void filterDeletedKernel(const value_t* in_dists,
+                                    const value_idx* in_inds,
+                                    value_t* out_dists,
+                                    value_idx* out_inds,
+                                    const std::uint32_t* deleted,
+                                    size_t n_rows,
+                                    int k2,
+                                    int k)
+{
+  for (size_t row = blockIdx.x * blockDim.x + threadIdx.x; row < n_rows;
+       row += size_t(gridDim.x) * blockDim.x) {
+    int kept = 0;
+    for (int j = 0; j < k2 && kept < k; j++) {
+      const value_idx id = in_inds[row * k2 + j];
+      if (id >= 0 && !deleted[id]) {
+        out_dists[row * k + kept] = in_dists[row * k2 + j];
+        out_inds[row * k + kept]  = id;
+        kept++;
+      }
+    }
+    for (; kept < k; kept++) {
+      out_dists[row * k + kept] = std::numeric_limits<value_t>::max();
+      out_inds[row * k + kept]  = -1;
+    }
+  }
+}
+
+/** Re-strides k_in-wide knn results into a k_out-wide buffer, sentinel-padded. */
+template <typename value_idx, typename value_t>
+__global__ void padPartKernel(const value_t* in_dists,
+                              const value_idx* in_inds,
+                              value_t* out_dists,
+                              value_idx* out_inds,
+                              size_t n_rows,
+                              int k_in,
+                              int k_out)
+{
+  for (size_t i = blockIdx.x * blockDim.x + threadIdx.x; i < n_rows * k_out;
+       i += size_t(gridDim.x) * blockDim.x) {
+    const size_t row = i / k_out;
+    const int j      = i % k_out;
+    if (j < k_in) {
+      out_dists[i] = in_dists[row * k_in + j];
+      out_inds[i]  = in_inds[row * k_in + j];
+    } else {
+      out_dists[i] = std::numeric_limits<value_t>::max();
+      out_inds[i]  = -1;
+    }
+  }
+}
+
+/**
+ * Copies the live rows to their compacted destinations. Rows below n_first
+ * are read from `first`, the rest from `second` (tail storage); pass the
+ * whole corpus as `first` with n_first = n_rows for a single-buffer index.
+ */
+template <typename T, typename IdxT>
+__global__ void scatterLiveRowsKernel(const T* first,
+                                      const T* second,
+                                      T* out,
+                                      const IdxT* dest_row,
+                                      const std::uint32_t* deleted,
+                                      IdxT n_first,
+                                      IdxT n_rows,
+                                      IdxT dim)
+{
+  for (IdxT i = blockIdx.x * blockDim.x + threadIdx.x; i < n_rows * dim;
+       i += IdxT(gridDim.x) * blockDim.x) {
+    const IdxT row = i / dim;
+    if (!deleted[row]) {
+      const IdxT col = i % dim;
+      const T val = (row < n_first) ? first[row * dim + col] : second[(row - n_first) * dim + col];
+      out[dest_row[row] * dim + col] = val;
+    }
+  }
+}
+
+/** Computes the compacted destination row for every live row. */
+template <typename IdxT>
+void live_row_destinations(const std::uint32_t* deleted,
+                           IdxT* dest_row,
+                           IdxT n_rows,
+                           cudaStream_t stream)
+{
+  raft::linalg::unaryOp(
+    dest_row, deleted, n_rows, [] __device__(std::uint32_t d) { return IdxT(d == 0); }, stream);
+  thrust::exclusive_scan(
+    rmm::exec_policy(stream), dest_row, dest_row + n_rows, dest_row, IdxT(0));
+}
+
+/**
+ * Tombstones rows and returns how many of them were newly deleted (rows
+ * removed twice only count once).
+ */
+template <typename IdxT>
+IdxT mark_deleted(std::uint32_t* deleted,
+                  const IdxT* row_ids,
+                  IdxT n_ids,
+                  cudaStream_t stream)
+{
+  rmm::device_scalar<unsigned long long> n_newly(0ull, stream);
+  constexpr int tpb = 256;
+  markDeletedKernel<IdxT><<<raft::ceildiv<IdxT>(n_ids, tpb), tpb, 0, stream>>>(
+    deleted, row_ids, n_ids, n_newly.data());
+  RAFT_CUDA_TRY(cudaGetLastError());
+  return static_cast<IdxT>(n_newly.value(stream));
+}
+
+/** Launches the tombstone filter over k2-wide candidates. */
+template <typename value_idx, typename value_t>
+void filter_deleted(const value_t* in_dists,
+                    const value_idx* in_inds,
+                    value_t* out_dists,
+                    value_idx* out_inds,
+                    const std::uint32_t* deleted,
+                    size_t n_rows,
+                    int k2,
+                    int k,
+                    cudaStream_t stream)
+{
+  constexpr int tpb = 128;
+  filterDeletedKernel<value_idx, value_t><<<raft::ceildiv<size_t>(n_rows, tpb), tpb, 0, stream>>>(
+    in_dists, in_inds, out_dists, out_inds, deleted, n_rows, k2, k);
+  RAFT_CUDA_TRY(cudaGetLastError());
+}
+
+/**
+ * Grows a uvector to at least `required` elements with amortized doubling;
+ * existing contents are preserved. The uvector size acts as the capacity,
+ * the logical size is tracked by the index.
+ */
+template <typename T>
+void reserve_rows(rmm::device_uvector<T>& buf, size_t required, cudaStream_t stream)
+{
+  if (buf.size() < required) { buf.resize(std::max(2 * buf.size(), required), stream); }
+}
+
+}  // namespace detail
+}  // namespace knn
+}  // namespace spatial
+}  // namespace raft
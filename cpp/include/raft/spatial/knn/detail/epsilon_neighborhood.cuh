@@ -19,6 +19,11 @@
 #include <raft/device_utils.cuh>
 #include <raft/linalg/contractions.cuh>
 
+#include <rmm/device_uvector.hpp>
+#include <rmm/exec_policy.hpp>
+
+#include <thrust/scan.h>
+
 namespace raft {
 namespace spatial {
 namespace knn {
@@ -170,6 +175,484 @@ struct EpsUnexpL2SqNeighborhood : public BaseClass {
   }
 };  // struct EpsUnexpL2SqNeighborhood
 
+/**
+ * Multi-threshold variant of the dense epsilon neighborhood computation.
+ * The distance accumulation runs exactly once; in the epilog every
+ * accumulated distance is compared against all `n_eps` thresholds while it
+ * still sits in registers, emitting one adjacency plane (and optionally one
+ * vertex degree array) per threshold. An OPTICS-style epsilon sweep thus
+ * costs a single pass over the data instead of one pass per epsilon.
+ */
+template <typename DataT,
+          typename IdxT,
+          typename Policy,
+          typename BaseClass = raft::linalg::Contractions_NT<DataT, IdxT, Policy>>
+struct EpsUnexpL2SqMultiNeighborhood : public BaseClass {
+ private:
+  typedef Policy P;
+
+  bool* adj;
+  const DataT* eps;
+  IdxT n_eps;
+  IdxT* vd;
+
+  char* smem;  // for final reductions
+
+  DataT acc[P::AccRowsPerTh][P::AccColsPerTh];
+
+ public:
+  DI EpsUnexpL2SqMultiNeighborhood(bool* _adj,
+                                   IdxT* _vd,
+                                   const DataT* _x,
+                                   const DataT* _y,
+                                   IdxT _m,
+                                   IdxT _n,
+                                   IdxT _k,
+                                   const DataT* _eps,
+                                   IdxT _n_eps,
+                                   char* _smem)
+    : BaseClass(_x, _y, _m, _n, _k, _smem),
+      adj(_adj),
+      eps(_eps),
+      n_eps(_n_eps),
+      vd(_vd),
+      smem(_smem)
+  {
+  }
+
+  DI void run()
+  {
+    prolog();
+    loop();
+    epilog();
+  }
+
+ private:
+  DI void prolog()
+  {
+    this->ldgXY(0);
+#pragma unroll
+    for (int i = 0; i < P::AccRowsPerTh; ++i) {
+#pragma unroll
+      for (int j = 0; j < P::AccColsPerTh; ++j) {
+        acc[i][j] = BaseClass::Zero;
+      }
+    }
+    this->stsXY();
+    __syncthreads();
+    this->pageWr ^= 1;
+  }
+
+  DI void loop()
+  {
+    for (int kidx = P::Kblk; kidx < this->k; kidx += P::Kblk) {
+      this->ldgXY(kidx);
+      accumulate();  // on the previous k-block
+      this->stsXY();
+      __syncthreads();
+      this->pageWr ^= 1;
+      this->pageRd ^= 1;
+    }
+    accumulate();  // last iteration
+  }
+
+  DI void epilog()
+  {
+    IdxT startx = blockIdx.x * P::Mblk + this->accrowid;
+    IdxT starty = blockIdx.y * P::Nblk + this->acccolid;
+    auto plane  = IdxT(this->m) * this->n;
+    for (IdxT e = 0; e < n_eps; ++e) {
+      auto eps_e  = eps[e];
+      auto* adj_e = adj + e * plane;
+      IdxT sums[P::AccColsPerTh];
+#pragma unroll
+      for (int j = 0; j < P::AccColsPerTh; ++j) {
+        sums[j] = 0;
+      }
+#pragma unroll
+      for (int i = 0; i < P::AccRowsPerTh; ++i) {
+        auto xid = startx + i * P::AccThRows;
+#pragma unroll
+        for (int j = 0; j < P::AccColsPerTh; ++j) {
+          auto yid      = starty + j * P::AccThCols;
+          auto is_neigh = acc[i][j] <= eps_e;
+          if (xid < this->m && yid < this->n) {
+            adj_e[xid * this->n + yid] = is_neigh;
+            sums[j] += is_neigh;
+          }
+        }
+      }
+      // per-epsilon degree reduction; all threads take this branch
+      // uniformly, so the __syncthreads inside is safe
+      if (vd != nullptr) { updateVertexDegree(sums, vd + e * (this->n + 1)); }
+    }
+  }
+
+  DI void accumulate()
+  {
+#pragma unroll
+    for (int ki = 0; ki < P::Kblk; ki += P::Veclen) {
+      this->ldsXY(ki);
+#pragma unroll
+      for (int i = 0; i < P::AccRowsPerTh; ++i) {
+#pragma unroll
+        for (int j = 0; j < P::AccColsPerTh; ++j) {
+#pragma unroll
+          for (int v = 0; v < P::Veclen; ++v) {
+            auto diff = this->regx[i][v] - this->regy[j][v];
+            acc[i][j] += diff * diff;
+          }
+        }
+      }
+    }
+  }
+
+  DI void updateVertexDegree(IdxT (&sums)[P::AccColsPerTh], IdxT* vd_e)
+  {
+    __syncthreads();  // so that we can safely reuse smem
+    int gid       = threadIdx.x / P::AccThCols;
+    int lid       = threadIdx.x % P::AccThCols;
+    auto cidx     = IdxT(blockIdx.y) * P::Nblk + lid;
+    IdxT totalSum = 0;
+    // update the individual vertex degrees
+#pragma unroll
+    for (int i = 0; i < P::AccColsPerTh; ++i) {
+      sums[i]  = batchedBlockReduce<IdxT, P::AccThCols>(sums[i], smem);
+      auto cid = cidx + i * P::AccThCols;
+      if (gid == 0 && cid < this->n) {
+        atomicUpdate(vd_e, cid, sums[i]);
+        totalSum += sums[i];
+      }
+      __syncthreads();  // for safe smem reuse
+    }
+    // update the total edge count
+    totalSum = raft::blockReduce<IdxT>(totalSum, smem);
+    if (threadIdx.x == 0) { atomicUpdate(vd_e, this->n, totalSum); }
+  }
+
+  DI void atomicUpdate(IdxT* vd_e, IdxT addrId, IdxT val)
+  {
+    if (sizeof(IdxT) == 4) {
+      raft::myAtomicAdd<unsigned>((unsigned*)(vd_e + addrId), val);
+    } else if (sizeof(IdxT) == 8) {
+      raft::myAtomicAdd<unsigned long long>((unsigned long long*)(vd_e + addrId), val);
+    }
+  }
+};  // struct EpsUnexpL2SqMultiNeighborhood
+
+template <typename DataT, typename IdxT, typename Policy>
+__global__ __launch_bounds__(Policy::Nthreads, 2)
+
+  void epsUnexpL2SqMultiNeighKernel(bool* adj,
+                                    IdxT* vd,
+                                    const DataT* x,
+                                    const DataT* y,
+                                    IdxT m,
+                                    IdxT n,
+                                    IdxT k,
+                                    const DataT* eps,
+                                    IdxT n_eps)
+{
+  extern __shared__ char smem[];
+  EpsUnexpL2SqMultiNeighborhood<DataT, IdxT, Policy> obj(adj, vd, x, y, m, n, k, eps, n_eps, smem);
+  obj.run();
+}
+
+template <typename DataT, typename IdxT, int VecLen>
+void epsUnexpL2SqMultiNeighImpl(bool* adj,
+                                IdxT* vd,
+                                const DataT* x,
+                                const DataT* y,
+                                IdxT m,
+                                IdxT n,
+                                IdxT k,
+                                const DataT* eps,
+                                IdxT n_eps,
+                                cudaStream_t stream)
+{
+  typedef typename raft::linalg::Policy4x4<DataT, VecLen>::Policy Policy;
+  dim3 grid(raft::ceildiv<int>(m, Policy::Mblk), raft::ceildiv<int>(n, Policy::Nblk));
+  dim3 blk(Policy::Nthreads);
+  epsUnexpL2SqMultiNeighKernel<DataT, IdxT, Policy>
+    <<<grid, blk, Policy::SmemSize, stream>>>(adj, vd, x, y, m, n, k, eps, n_eps);
+  RAFT_CUDA_TRY(cudaGetLastError());
+}
+
+/**
+ * @brief Computes the epsilon neighborhood for several epsilon values in a
+ * single distance pass; see the public wrapper for the full docs
+ */
+template <typename DataT, typename IdxT>
+void epsUnexpL2SqMultiNeighborhood(bool* adj,
+                                   IdxT* vd,
+                                   const DataT* x,
+                                   const DataT* y,
+                                   IdxT m,
+                                   IdxT n,
+                                   IdxT k,
+                                   const DataT* eps,
+                                   IdxT n_eps,
+                                   cudaStream_t stream)
+{
+  size_t bytes = sizeof(DataT) * k;
+  if (16 % sizeof(DataT) == 0 && bytes % 16 == 0) {
+    epsUnexpL2SqMultiNeighImpl<DataT, IdxT, 16 / sizeof(DataT)>(
+      adj, vd, x, y, m, n, k, eps, n_eps, stream);
+  } else if (8 % sizeof(DataT) == 0 && bytes % 8 == 0) {
+    epsUnexpL2SqMultiNeighImpl<DataT, IdxT, 8 / sizeof(DataT)>(
+      adj, vd, x, y, m, n, k, eps, n_eps, stream);
+  } else {
+    epsUnexpL2SqMultiNeighImpl<DataT, IdxT, 1>(adj, vd, x, y, m, n, k, eps, n_eps, stream);
+  }
+}
+
+/**
+ * CSR-output variant of the epsilon neighborhood computation. The same
+ * contraction core runs in one of two modes: with `adj_cols == nullptr` it
+ * only counts the neighbors of each x-row (into `row_counts`), otherwise it
+ * appends the neighbor column ids of each row at `indptr[row]`, tracking the
+ * running occupancy in `row_fill`. Column ids within a row come out in no
+ * particular order.
+ */
+template <typename DataT,
+          typename IdxT,
+          typename Policy,
+          typename BaseClass = raft::linalg::Contractions_NT<DataT, IdxT, Policy>>
+struct EpsUnexpL2SqCsrNeighborhood : public BaseClass {
+ private:
+  typedef Policy P;
+
+  IdxT* row_counts;
+  const IdxT* indptr;
+  IdxT* row_fill;
+  IdxT* adj_cols;
+  DataT eps;
+
+  DataT acc[P::AccRowsPerTh][P::AccColsPerTh];
+
+ public:
+  DI EpsUnexpL2SqCsrNeighborhood(IdxT* _row_counts,
+                                 const IdxT* _indptr,
+                                 IdxT* _row_fill,
+                                 IdxT* _adj_cols,
+                                 const DataT* _x,
+                                 const DataT* _y,
+                                 IdxT _m,
+                                 IdxT _n,
+                                 IdxT _k,
+                                 DataT _eps,
+                                 char* _smem)
+    : BaseClass(_x, _y, _m, _n, _k, _smem),
+      row_counts(_row_counts),
+      indptr(_indptr),
+      row_fill(_row_fill),
+      adj_cols(_adj_cols),
+      eps(_eps)
+  {
+  }
+
+  DI void run()
+  {
+    prolog();
+    loop();
+    epilog();
+  }
+
+ private:
+  DI void prolog()
+  {
+    this->ldgXY(0);
+#pragma unroll
+    for (int i = 0; i < P::AccRowsPerTh; ++i) {
+#pragma unroll
+      for (int j = 0; j < P::AccColsPerTh; ++j) {
+        acc[i][j] = BaseClass::Zero;
+      }
+    }
+    this->stsXY();
+    __syncthreads();
+    this->pageWr ^= 1;
+  }
+
+  DI void loop()
+  {
+    for (int kidx = P::Kblk; kidx < this->k; kidx += P::Kblk) {
+      this->ldgXY(kidx);
+      accumulate();  // on the previous k-block
+      this->stsXY();
+      __syncthreads();
+      this->pageWr ^= 1;
+      this->pageRd ^= 1;
+    }
+    accumulate();  // last iteration
+  }
+
+  DI void epilog()
+  {
+    IdxT startx = blockIdx.x * P::Mblk + this->accrowid;
+    IdxT starty = blockIdx.y * P::Nblk + this->acccolid;
+#pragma unroll
+    for (int i = 0; i < P::AccRowsPerTh; ++i) {
+      auto xid  = startx + i * P::AccThRows;
+      IdxT cnt  = 0;
+#pragma unroll
+      for (int j = 0; j < P::AccColsPerTh; ++j) {
+        auto yid = starty + j * P::AccThCols;
+        if (xid < this->m && yid < this->n && acc[i][j] <= eps) {
+          if (adj_cols != nullptr) {
+            auto pos                 = atomicFetchAdd(row_fill + xid, IdxT(1));
+            adj_cols[indptr[xid] + pos] = yid;
+          } else {
+            ++cnt;
+          }
+        }
+      }
+      if (adj_cols == nullptr && cnt > 0) { atomicFetchAdd(row_counts + xid, cnt); }
+    }
+  }
+
+  DI void accumulate()
+  {
+#pragma unroll
+    for (int ki = 0; ki < P::Kblk; ki += P::Veclen) {
+      this->ldsXY(ki);
+#pragma unroll
+      for (int i = 0; i < P::AccRowsPerTh; ++i) {
+#pragma unroll
+        for (int j = 0; j < P::AccColsPerTh; ++j) {
+#pragma unroll
+          for (int v = 0; v < P::Veclen; ++v) {
+            auto diff = this->regx[i][v] - this->regy[j][v];
+            acc[i][j] += diff * diff;
+          }
+        }
+      }
+    }
+  }
+
+  DI IdxT atomicFetchAdd(IdxT* addr, IdxT val)
+  {
+    if (sizeof(IdxT) == 4) {
+      return (IdxT)raft::myAtomicAdd<unsigned>((unsigned*)addr, (unsigned)val);
+    } else {
+      return (IdxT)raft::myAtomicAdd<unsigned long long>((unsigned long long*)addr,
+                                                         (unsigned long long)val);
+    }
+  }
+};  // struct EpsUnexpL2SqCsrNeighborhood
+
+template <typename DataT, typename IdxT, typename Policy>
+__global__ __launch_bounds__(Policy::Nthreads, 2)
+
+  void epsUnexpL2SqCsrNeighKernel(IdxT* row_counts,
+                                  const IdxT* indptr,
+                                  IdxT* row_fill,
+                                  IdxT* adj_cols,
+                                  const DataT* x,
+                                  const DataT* y,
+                                  IdxT m,
+                                  IdxT n,
+                                  IdxT k,
+                                  DataT eps)
+{
+  extern __shared__ char smem[];
+  EpsUnexpL2SqCsrNeighborhood<DataT, IdxT, Policy> obj(
+    row_counts, indptr, row_fill, adj_cols, x, y, m, n, k, eps, smem);
+  obj.run();
+}
+
+template <typename DataT, typename IdxT, int VecLen>
+void epsUnexpL2SqCsrNeighImpl(IdxT* row_counts,
+                              const IdxT* indptr,
+                              IdxT* row_fill,
+                              IdxT* adj_cols,
+                              const DataT* x,
+                              const DataT* y,
+                              IdxT m,
+                              IdxT n,
+                              IdxT k,
+                              DataT eps,
+                              cudaStream_t stream)
+{
+  typedef typename raft::linalg::Policy4x4<DataT, VecLen>::Policy Policy;
+  dim3 grid(raft::ceildiv<int>(m, Policy::Mblk), raft::ceildiv<int>(n, Policy::Nblk));
+  dim3 blk(Policy::Nthreads);
+  epsUnexpL2SqCsrNeighKernel<DataT, IdxT, Policy><<<grid, blk, Policy::SmemSize, stream>>>(
+    row_counts, indptr, row_fill, adj_cols, x, y, m, n, k, eps);
+  RAFT_CUDA_TRY(cudaGetLastError());
+}
+
+template <typename DataT, typename IdxT>
+void epsUnexpL2SqCsrNeighLaunch(IdxT* row_counts,
+                                const IdxT* indptr,
+                                IdxT* row_fill,
+                                IdxT* adj_cols,
+                                const DataT* x,
+                                const DataT* y,
+                                IdxT m,
+                                IdxT n,
+                                IdxT k,
+                                DataT eps,
+                                cudaStream_t stream)
+{
+  size_t bytes = sizeof(DataT) * k;
+  if (16 % sizeof(DataT) == 0 && bytes % 16 == 0) {
+    epsUnexpL2SqCsrNeighImpl<DataT, IdxT, 16 / sizeof(DataT)>(
+      row_counts, indptr, row_fill, adj_cols, x, y, m, n, k, eps, stream);
+  } else if (8 % sizeof(DataT) == 0 && bytes % 8 == 0) {
+    epsUnexpL2SqCsrNeighImpl<DataT, IdxT, 8 / sizeof(DataT)>(
+      row_counts, indptr, row_fill, adj_cols, x, y, m, n, k, eps, stream);
+  } else {
+    epsUnexpL2SqCsrNeighImpl<DataT, IdxT, 1>(
+      row_counts, indptr, row_fill, adj_cols, x, y, m, n, k, eps, stream);
+  }
+}
+
+/**
+ * @brief Computes the epsilon neighborhood in CSR form for the L2-Squared
+ * distance metric; see the public wrapper for the full docs
+ */
+template <typename DataT, typename IdxT>
+void epsUnexpL2SqNeighborhoodCsr(IdxT* indptr,
+                                 rmm::device_uvector<IdxT>& adj_cols,
+                                 const DataT* x,
+                                 const DataT* y,
+                                 IdxT m,
+                                 IdxT n,
+                                 IdxT k,
+                                 DataT eps,
+                                 cudaStream_t stream)
+{
+  if (m == 0) {
+    IdxT zero = 0;
+    raft::update_device(indptr, &zero, 1, stream);
+    adj_cols.resize(0, stream);
+    return;
+  }
+
+  // pass 1: per-row neighbor counts
+  rmm::device_uvector<IdxT> counts(m, stream);
+  RAFT_CUDA_TRY(cudaMemsetAsync(counts.data(), 0, m * sizeof(IdxT), stream));
+  epsUnexpL2SqCsrNeighLaunch<DataT, IdxT>(
+    counts.data(), nullptr, nullptr, nullptr, x, y, m, n, k, eps, stream);
+
+  thrust::exclusive_scan(
+    rmm::exec_policy(stream), counts.data(), counts.data() + m, indptr, IdxT(0));
+  IdxT last_off = 0, last_cnt = 0;
+  raft::update_host(&last_off, indptr + m - 1, 1, stream);
+  raft::update_host(&last_cnt, counts.data() + m - 1, 1, stream);
+  RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+  IdxT nnz = last_off + last_cnt;
+  raft::update_device(indptr + m, &nnz, 1, stream);
+
+  // pass 2: fill the column ids, reusing the counts buffer as the running
+  // per-row occupancy
+  adj_cols.resize(nnz, stream);
+  RAFT_CUDA_TRY(cudaMemsetAsync(counts.data(), 0, m * sizeof(IdxT), stream));
+  epsUnexpL2SqCsrNeighLaunch<DataT, IdxT>(
+    nullptr, indptr, counts.data(), adj_cols.data(), x, y, m, n, k, eps, stream);
+}
+
 template <typename DataT, typename IdxT, typename Policy>
 __global__ __launch_bounds__(Policy::Nthreads, 2)
 
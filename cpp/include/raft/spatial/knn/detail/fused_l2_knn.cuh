@@ -18,6 +18,7 @@
 #include <faiss/gpu/utils/Select.cuh>
 #include <limits>
 #include <raft/linalg/norm.cuh>
+#include <raft/linalg/unary_op.cuh>
 // TODO: Need to hide the PairwiseDistance class impl and expose to public API
 #include "processing.hpp"
 #include <raft/distance/detail/distance.cuh>
@@ -28,6 +29,52 @@ namespace spatial {
 namespace knn {
 namespace detail {
 
+/**
+ * Four-way int8 dot-product accumulate on a pair of packed quads. Uses the
+ * dp4a instruction where available and falls back to unpacking the bytes on
+ * older architectures.
+ */
+DI int32_t dp4a(int32_t a, int32_t b, int32_t c)
+{
+#if __CUDA_ARCH__ >= 610
+  return __dp4a(a, b, c);
+#else
+  int32_t res = c;
+#pragma unroll
+  for (int i = 0; i < 4; ++i) {
+    res += static_cast<int32_t>(static_cast<int8_t>(a >> (i * 8))) *
+           static_cast<int32_t>(static_cast<int8_t>(b >> (i * 8)));
+  }
+  return res;
+#endif
+}
+
+/**
+ * Computes the squared L2 row norms consumed by the fused expanded-L2 kernel.
+ * For the packed-int8 path each DataT element holds four int8 lanes, so the
+ * per-element square is a dp4a of the quad with itself.
+ */
+template <bool packedInt8, typename DataT, typename AccT, typename IdxT>
+void fusedL2KnnRowNorms(
+  AccT* out, const DataT* in, IdxT k, IdxT n_rows, bool isRowMajor, cudaStream_t stream)
+{
+  if constexpr (packedInt8) {
+    raft::linalg::reduce(out,
+                         in,
+                         k,
+                         n_rows,
+                         (AccT)0,
+                         isRowMajor,
+                         true,
+                         stream,
+                         false,
+                         [] __device__(DataT packed, IdxT) { return dp4a(packed, packed, 0); });
+  } else {
+    auto norm_op = [] __device__(DataT val) { return val; };
+    raft::linalg::rowNorm(out, in, k, n_rows, raft::linalg::L2Norm, isRowMajor, stream, norm_op);
+  }
+}
+
 template <typename Policy, typename Pair, typename myWarpSelect, typename IdxT>
 DI void loadAllWarpQShmem(myWarpSelect** heapArr,
                           Pair* shDumpKV,
@@ -167,15 +214,26 @@ DI void updateSortedWarpQ(
           heapArr->warpK[i] = tempKV.value;
           heapArr->warpV[i] = tempKV.key;
         }
-        if (i == 0 && NumWarpQRegs > 1) {
-          heapArr->warpK[1] = __shfl_up_sync(mask, heapArr->warpK[1], 1);
-          heapArr->warpV[1] = __shfl_up_sync(mask, heapArr->warpV[1], 1);
+        // cascade the element evicted from this register down through the
+        // remaining ones: lane 0's tempKV wrapped around to the old lane-31
+        // (largest) element of register j - 1, which becomes the new smallest
+        // element of register j. The element rotated out of the last register
+        // falls off the end of the top-k list.
+#pragma unroll
+        for (int j = i + 1; j < NumWarpQRegs; ++j) {
+          Pair rotKV;
+          rotKV.value = raft::shfl(heapArr->warpK[j], srcLane);
+          rotKV.key   = raft::shfl(heapArr->warpV[j], srcLane);
           if (lid == 0) {
-            heapArr->warpK[1] = tempKV.value;
-            heapArr->warpV[1] = tempKV.key;
+            heapArr->warpK[j] = tempKV.value;
+            heapArr->warpV[j] = tempKV.key;
+          } else {
+            heapArr->warpK[j] = rotKV.value;
+            heapArr->warpV[j] = rotKV.key;
           }
-          break;
+          tempKV = rotKV;
         }
+        break;
       }
     }
   }
@@ -192,7 +250,8 @@ template <bool useNorms,
           int NumWarpQ,
           int NumThreadQ,
           bool usePrevTopKs = false,
-          bool isRowMajor   = true>
+          bool isRowMajor   = true,
+          bool negateDot    = false>
 __global__ __launch_bounds__(Policy::Nthreads, 2) void fusedL2kNN(const DataT* x,
                                                                   const DataT* y,
                                                                   const DataT* _xn,
@@ -355,6 +414,16 @@ __global__ __launch_bounds__(Policy::Nthreads, 2) void fusedL2kNN(const DataT* x
           acc[i][j] = regxn[i] + regyn[j] - (DataT)2.0 * acc[i][j];
         }
       }
+    } else if (negateDot) {
+      // dot-product metrics reuse the min-selection machinery by selecting on
+      // the negated dot product; the host side flips the sign back on output
+#pragma unroll
+      for (int i = 0; i < Policy::AccRowsPerTh; ++i) {
+#pragma unroll
+        for (int j = 0; j < Policy::AccColsPerTh; ++j) {
+          acc[i][j] = -acc[i][j];
+        }
+      }
     }
 
     Pair* shDumpKV = nullptr;
@@ -529,6 +598,44 @@ __global__ __launch_bounds__(Policy::Nthreads, 2) void fusedL2kNN(const DataT* x
   obj.run();
 }
 
+/**
+ * Largest k the fused kNN kernels support on the current device. The per-row
+ * sorted queues live in dynamic shared memory, and k > 64 pushes a block past
+ * the default 48 KB; such configurations are only available on devices whose
+ * opt-in shared memory limit covers them (e.g. 128 on Turing, 256 on Volta
+ * and Ampere), while older devices stay at 64.
+ */
+inline int fusedL2KnnMaxK()
+{
+  int dev;
+  RAFT_CUDA_TRY(cudaGetDevice(&dev));
+  int maxSmemOptin;
+  RAFT_CUDA_TRY(
+    cudaDeviceGetAttribute(&maxSmemOptin, cudaDevAttrMaxSharedMemoryPerBlockOptin, dev));
+  typedef typename raft::linalg::Policy2x8<float, 1>::Policy KPolicy;
+  typedef cub::KeyValuePair<uint32_t, float> Pair;
+  // the expanded-L2 kernels additionally stage one row/col of norms
+  constexpr size_t base = KPolicy::SmemSize + (KPolicy::Mblk + KPolicy::Nblk) * sizeof(float);
+  for (int k = 256; k > 64; k /= 2) {
+    if (base + KPolicy::Mblk * static_cast<size_t>(k) * sizeof(Pair) <=
+        static_cast<size_t>(maxSmemOptin)) {
+      return k;
+    }
+  }
+  return 64;
+}
+
+/** Opts a fused kNN kernel into > 48 KB of dynamic shared memory when needed. */
+template <typename KernelT>
+void fusedL2KnnOptInSharedMem(KernelT kernel, size_t sharedMemSize)
+{
+  if (sharedMemSize > 48 * 1024) {
+    RAFT_CUDA_TRY(cudaFuncSetAttribute(reinterpret_cast<const void*>(kernel),
+                                       cudaFuncAttributeMaxDynamicSharedMemorySize,
+                                       static_cast<int>(sharedMemSize)));
+  }
+}
+
 template <typename DataT,
           typename AccT,
           typename OutT,
@@ -595,18 +702,47 @@ void fusedL2UnexpKnnImpl(const DataT* x,
                                                           3,
                                                           usePrevTopKs,
                                                           true>;
+    constexpr auto fusedL2UnexpKnn128RowMajor = fusedL2kNN<false,
+                                                           DataT,
+                                                           AccT,
+                                                           OutT,
+                                                           IdxT,
+                                                           KPolicy,
+                                                           decltype(core_lambda),
+                                                           decltype(fin_op),
+                                                           128,
+                                                           3,
+                                                           usePrevTopKs,
+                                                           true>;
+    constexpr auto fusedL2UnexpKnn256RowMajor = fusedL2kNN<false,
+                                                           DataT,
+                                                           AccT,
+                                                           OutT,
+                                                           IdxT,
+                                                           KPolicy,
+                                                           decltype(core_lambda),
+                                                           decltype(fin_op),
+                                                           256,
+                                                           4,
+                                                           usePrevTopKs,
+                                                           true>;
 
     auto fusedL2UnexpKnnRowMajor = fusedL2UnexpKnn32RowMajor;
     if (numOfNN <= 32) {
       fusedL2UnexpKnnRowMajor = fusedL2UnexpKnn32RowMajor;
     } else if (numOfNN <= 64) {
       fusedL2UnexpKnnRowMajor = fusedL2UnexpKnn64RowMajor;
+    } else if (numOfNN <= 128) {
+      fusedL2UnexpKnnRowMajor = fusedL2UnexpKnn128RowMajor;
+    } else if (numOfNN <= 256) {
+      fusedL2UnexpKnnRowMajor = fusedL2UnexpKnn256RowMajor;
     } else {
-      ASSERT(numOfNN <= 64, "fusedL2kNN: num of nearest neighbors must be <= 64");
+      ASSERT(numOfNN <= 256, "fusedL2kNN: num of nearest neighbors must be <= 256");
     }
 
     const auto sharedMemSize = KPolicy::SmemSize + (KPolicy::Mblk * numOfNN * sizeof(Pair));
-    dim3 grid                = raft::distance::detail::launchConfigGenerator<KPolicy>(
+    fusedL2KnnOptInSharedMem(fusedL2UnexpKnnRowMajor, sharedMemSize);
+    dim3 grid = raft::distance::detail::launchConfigGenerator<KPolicy>(
       m, n, sharedMemSize, fusedL2UnexpKnnRowMajor);
 
     if (grid.x > 1) {
@@ -725,7 +861,8 @@ template <typename DataT,
           typename IdxT,
           int VecLen,
           bool usePrevTopKs,
-          bool isRowMajor>
+          bool isRowMajor,
+          bool packedInt8 = false>
 void fusedL2ExpKnnImpl(const DataT* x,
                        const DataT* y,
                        IdxT m,
@@ -740,7 +877,8 @@ void fusedL2ExpKnnImpl(const DataT* x,
                        IdxT numOfNN,
                        cudaStream_t stream,
                        void* workspace,
-                       size_t& worksize)
+                       size_t& worksize,
+                       const DataT* yn_cached = nullptr)
 {
   typedef typename raft::linalg::Policy2x8<DataT, 1>::Policy RowPolicy;
   typedef typename raft::linalg::Policy4x4<DataT, VecLen>::ColPolicy ColPolicy;
@@ -749,13 +887,23 @@ void fusedL2ExpKnnImpl(const DataT* x,
 
   ASSERT(isRowMajor, "Only Row major inputs are allowed");
 
-  ASSERT(!(((x != y) && (worksize < (m + n) * sizeof(AccT))) || (worksize < m * sizeof(AccT))),
-         "workspace size error");
+  // with cached index norms only the query-side norms go in the workspace
+  const size_t normsWorksize = (yn_cached != nullptr)
+                                 ? m * sizeof(AccT)
+                                 : ((x != y) ? (m + n) * sizeof(AccT) : m * sizeof(AccT));
+  ASSERT(worksize >= normsWorksize, "workspace size error");
   ASSERT(workspace != nullptr, "workspace is null");
 
   dim3 blk(KPolicy::Nthreads);
-  // Accumulation operation lambda
-  auto core_lambda = [] __device__(AccT & acc, DataT & x, DataT & y) { acc += x * y; };
+  // Accumulation operation lambda. On the packed-int8 path each DataT element
+  // carries four int8 lanes which are reduced with a single dp4a.
+  auto core_lambda = [] __device__(AccT & acc, DataT & x, DataT & y) {
+    if constexpr (packedInt8) {
+      acc = dp4a(x, y, acc);
+    } else {
+      acc += x * y;
+    }
+  };
 
   auto fin_op = [] __device__(AccT d_val, int g_d_idx) { return d_val; };
 
@@ -786,25 +934,56 @@ void fusedL2ExpKnnImpl(const DataT* x,
                                                         3,
                                                         usePrevTopKs,
                                                         true>;
+    constexpr auto fusedL2ExpKnn128RowMajor = fusedL2kNN<true,
+                                                         DataT,
+                                                         AccT,
+                                                         OutT,
+                                                         IdxT,
+                                                         KPolicy,
+                                                         decltype(core_lambda),
+                                                         decltype(fin_op),
+                                                         128,
+                                                         3,
+                                                         usePrevTopKs,
+                                                         true>;
+    constexpr auto fusedL2ExpKnn256RowMajor = fusedL2kNN<true,
+                                                         DataT,
+                                                         AccT,
+                                                         OutT,
+                                                         IdxT,
+                                                         KPolicy,
+                                                         decltype(core_lambda),
+                                                         decltype(fin_op),
+                                                         256,
+                                                         4,
+                                                         usePrevTopKs,
+                                                         true>;
 
     auto fusedL2ExpKnnRowMajor = fusedL2ExpKnn32RowMajor;
     if (numOfNN <= 32) {
       fusedL2ExpKnnRowMajor = fusedL2ExpKnn32RowMajor;
     } else if (numOfNN <= 64) {
       fusedL2ExpKnnRowMajor = fusedL2ExpKnn64RowMajor;
+    } else if (numOfNN <= 128) {
+      fusedL2ExpKnnRowMajor = fusedL2ExpKnn128RowMajor;
+    } else if (numOfNN <= 256) {
+      fusedL2ExpKnnRowMajor = fusedL2ExpKnn256RowMajor;
     } else {
-      ASSERT(numOfNN <= 64, "fusedL2kNN: num of nearest neighbors must be <= 64");
+      ASSERT(numOfNN <= 256, "fusedL2kNN: num of nearest neighbors must be <= 256");
     }
 
     const auto sharedMemSize = KPolicy::SmemSize +
                                ((KPolicy::Mblk + KPolicy::Nblk) * sizeof(DataT)) +
                                (KPolicy::Mblk * numOfNN * sizeof(Pair));
+    fusedL2KnnOptInSharedMem(fusedL2ExpKnnRowMajor, sharedMemSize);
     dim3 grid = raft::distance::detail::launchConfigGenerator<KPolicy>(
       m, n, sharedMemSize, fusedL2ExpKnnRowMajor);
     int32_t* mutexes = nullptr;
     if (grid.x > 1) {
-      const auto numMutexes   = raft::ceildiv<int>(m, KPolicy::Mblk);
-      const auto normsSize    = (x != y) ? (m + n) * sizeof(DataT) : n * sizeof(DataT);
+      const auto numMutexes = raft::ceildiv<int>(m, KPolicy::Mblk);
+      const auto normsSize  = (yn_cached != nullptr)
+                                ? m * sizeof(DataT)
+                                : ((x != y) ? (m + n) * sizeof(DataT) : n * sizeof(DataT));
       const auto requiredSize = sizeof(int32_t) * numMutexes + normsSize;
       if (worksize < requiredSize) {
         worksize = requiredSize;
@@ -815,17 +994,23 @@ void fusedL2ExpKnnImpl(const DataT* x,
       }
     }
 
-    DataT* xn = (DataT*)workspace;
-    DataT* yn = (DataT*)workspace;
-
-    auto norm_op = [] __device__(DataT in) { return in; };
+    DataT* ws_norms = (DataT*)workspace;
+    const DataT* xn = ws_norms;
+    const DataT* yn = ws_norms;
 
-    if (x != y) {
-      yn += m;
-      raft::linalg::rowNorm(xn, x, k, m, raft::linalg::L2Norm, isRowMajor, stream, norm_op);
-      raft::linalg::rowNorm(yn, y, k, n, raft::linalg::L2Norm, isRowMajor, stream, norm_op);
+    if (yn_cached != nullptr) {
+      yn = yn_cached;
+      if (x != y) {
+        fusedL2KnnRowNorms<packedInt8>(ws_norms, x, k, m, isRowMajor, stream);
+      } else {
+        xn = yn_cached;
+      }
+    } else if (x != y) {
+      yn = ws_norms + m;
+      fusedL2KnnRowNorms<packedInt8>(ws_norms, x, k, m, isRowMajor, stream);
+      fusedL2KnnRowNorms<packedInt8>(ws_norms + m, y, k, n, isRowMajor, stream);
     } else {
-      raft::linalg::rowNorm(xn, x, k, n, raft::linalg::L2Norm, isRowMajor, stream, norm_op);
+      fusedL2KnnRowNorms<packedInt8>(ws_norms, x, k, n, isRowMajor, stream);
     }
     fusedL2ExpKnnRowMajor<<<grid, blk, sharedMemSize, stream>>>(x,
                                                                 y,
@@ -855,7 +1040,8 @@ template <typename DataT,
           typename OutT,
           typename IdxT,
           bool usePrevTopKs,
-          bool isRowMajor>
+          bool isRowMajor,
+          bool packedInt8 = false>
 void fusedL2ExpKnn(IdxT m,
                    IdxT n,
                    IdxT k,
@@ -870,12 +1056,13 @@ void fusedL2ExpKnn(IdxT m,
                    IdxT numOfNN,
                    cudaStream_t stream,
                    void* workspace,
-                   size_t& worksize)
+                   size_t& worksize,
+                   const DataT* yn_cached = nullptr)
 {
   size_t bytesA = sizeof(DataT) * lda;
   size_t bytesB = sizeof(DataT) * ldb;
   if (16 % sizeof(DataT) == 0 && bytesA % 16 == 0 && bytesB % 16 == 0) {
-    fusedL2ExpKnnImpl<DataT, AccT, OutT, IdxT, 16 / sizeof(DataT), usePrevTopKs, isRowMajor>(
+    fusedL2ExpKnnImpl<DataT, AccT, OutT, IdxT, 16 / sizeof(DataT), usePrevTopKs, isRowMajor, packedInt8>(
       x,
       y,
       m,
@@ -890,9 +1077,10 @@ void fusedL2ExpKnn(IdxT m,
       numOfNN,
       stream,
       workspace,
-      worksize);
+      worksize,
+      yn_cached);
   } else if (8 % sizeof(DataT) == 0 && bytesA % 8 == 0 && bytesB % 8 == 0) {
-    fusedL2ExpKnnImpl<DataT, AccT, OutT, IdxT, 8 / sizeof(DataT), usePrevTopKs, isRowMajor>(
+    fusedL2ExpKnnImpl<DataT, AccT, OutT, IdxT, 8 / sizeof(DataT), usePrevTopKs, isRowMajor, packedInt8>(
       x,
       y,
       m,
@@ -907,9 +1095,10 @@ void fusedL2ExpKnn(IdxT m,
       numOfNN,
       stream,
       workspace,
-      worksize);
+      worksize,
+      yn_cached);
   } else {
-    fusedL2ExpKnnImpl<DataT, AccT, OutT, IdxT, 1, usePrevTopKs, isRowMajor>(x,
+    fusedL2ExpKnnImpl<DataT, AccT, OutT, IdxT, 1, usePrevTopKs, isRowMajor, packedInt8>(x,
                                                                             y,
                                                                             m,
                                                                             n,
@@ -923,12 +1112,197 @@ void fusedL2ExpKnn(IdxT m,
                                                                             numOfNN,
                                                                             stream,
                                                                             workspace,
-                                                                            worksize);
+                                                                            worksize,
+                                                                            yn_cached);
+  }
+}
+
+template <typename DataT,
+          typename AccT,
+          typename OutT,
+          typename IdxT,
+          int VecLen,
+          bool usePrevTopKs,
+          bool isRowMajor>
+void fusedIpKnnImpl(const DataT* x,
+                    const DataT* y,
+                    IdxT m,
+                    IdxT n,
+                    IdxT k,
+                    IdxT lda,
+                    IdxT ldb,
+                    IdxT ldd,
+                    OutT* out_dists,
+                    IdxT* out_inds,
+                    IdxT numOfNN,
+                    cudaStream_t stream,
+                    void* workspace,
+                    size_t& worksize)
+{
+  typedef typename raft::linalg::Policy2x8<DataT, 1>::Policy RowPolicy;
+  typedef typename raft::linalg::Policy4x4<DataT, VecLen>::ColPolicy ColPolicy;
+
+  typedef typename std::conditional<true, RowPolicy, ColPolicy>::type KPolicy;
+
+  ASSERT(isRowMajor, "Only Row major inputs are allowed");
+
+  dim3 blk(KPolicy::Nthreads);
+  // Accumulation operation lambda
+  auto core_lambda = [] __device__(AccT & acc, DataT & x, DataT & y) { acc += x * y; };
+
+  auto fin_op = [] __device__(AccT d_val, int g_d_idx) { return d_val; };
+
+  typedef cub::KeyValuePair<uint32_t, AccT> Pair;
+
+  if (isRowMajor) {
+    constexpr auto fusedIpKnn32RowMajor = fusedL2kNN<false,
+                                                     DataT,
+                                                     AccT,
+                                                     OutT,
+                                                     IdxT,
+                                                     KPolicy,
+                                                     decltype(core_lambda),
+                                                     decltype(fin_op),
+                                                     32,
+                                                     2,
+                                                     usePrevTopKs,
+                                                     true,
+                                                     true>;
+    constexpr auto fusedIpKnn64RowMajor = fusedL2kNN<false,
+                                                     DataT,
+                                                     AccT,
+                                                     OutT,
+                                                     IdxT,
+                                                     KPolicy,
+                                                     decltype(core_lambda),
+                                                     decltype(fin_op),
+                                                     64,
+                                                     3,
+                                                     usePrevTopKs,
+                                                     true,
+                                                     true>;
+    constexpr auto fusedIpKnn128RowMajor = fusedL2kNN<false,
+                                                      DataT,
+                                                      AccT,
+                                                      OutT,
+                                                      IdxT,
+                                                      KPolicy,
+                                                      decltype(core_lambda),
+                                                      decltype(fin_op),
+                                                      128,
+                                                      3,
+                                                      usePrevTopKs,
+                                                      true,
+                                                      true>;
+    constexpr auto fusedIpKnn256RowMajor = fusedL2kNN<false,
+                                                      DataT,
+                                                      AccT,
+                                                      OutT,
+                                                      IdxT,
+                                                      KPolicy,
+                                                      decltype(core_lambda),
+                                                      decltype(fin_op),
+                                                      256,
+                                                      4,
+                                                      usePrevTopKs,
+                                                      true,
+                                                      true>;
+
+    auto fusedIpKnnRowMajor = fusedIpKnn32RowMajor;
+    if (numOfNN <= 32) {
+      fusedIpKnnRowMajor = fusedIpKnn32RowMajor;
+    } else if (numOfNN <= 64) {
+      fusedIpKnnRowMajor = fusedIpKnn64RowMajor;
+    } else if (numOfNN <= 128) {
+      fusedIpKnnRowMajor = fusedIpKnn128RowMajor;
+    } else if (numOfNN <= 256) {
+      fusedIpKnnRowMajor = fusedIpKnn256RowMajor;
+    } else {
+      ASSERT(numOfNN <= 256, "fusedL2kNN: num of nearest neighbors must be <= 256");
+    }
+
+    const auto sharedMemSize = KPolicy::SmemSize + (KPolicy::Mblk * numOfNN * sizeof(Pair));
+    fusedL2KnnOptInSharedMem(fusedIpKnnRowMajor, sharedMemSize);
+    dim3 grid = raft::distance::detail::launchConfigGenerator<KPolicy>(
+      m, n, sharedMemSize, fusedIpKnnRowMajor);
+
+    if (grid.x > 1) {
+      const auto numMutexes = raft::ceildiv<int>(m, KPolicy::Mblk);
+      if (workspace == nullptr || worksize < (sizeof(int32_t) * numMutexes)) {
+        worksize = sizeof(int32_t) * numMutexes;
+        return;
+      } else {
+        RAFT_CUDA_TRY(cudaMemsetAsync(workspace, 0, sizeof(int32_t) * numMutexes, stream));
+      }
+    }
+
+    fusedIpKnnRowMajor<<<grid, blk, sharedMemSize, stream>>>(x,
+                                                             y,
+                                                             nullptr,
+                                                             nullptr,
+                                                             m,
+                                                             n,
+                                                             k,
+                                                             lda,
+                                                             ldb,
+                                                             ldd,
+                                                             core_lambda,
+                                                             fin_op,
+                                                             false,
+                                                             (uint32_t)numOfNN,
+                                                             (int*)workspace,
+                                                             out_dists,
+                                                             out_inds);
+  } else {
+  }
+
+  RAFT_CUDA_TRY(cudaGetLastError());
+}
+
+template <typename DataT,
+          typename AccT,
+          typename OutT,
+          typename IdxT,
+          bool usePrevTopKs,
+          bool isRowMajor>
+void fusedIpKnn(IdxT m,
+                IdxT n,
+                IdxT k,
+                IdxT lda,
+                IdxT ldb,
+                IdxT ldd,
+                const DataT* x,
+                const DataT* y,
+                OutT* out_dists,
+                IdxT* out_inds,
+                IdxT numOfNN,
+                cudaStream_t stream,
+                void* workspace,
+                size_t& worksize)
+{
+  size_t bytesA = sizeof(DataT) * lda;
+  size_t bytesB = sizeof(DataT) * ldb;
+  if (16 % sizeof(DataT) == 0 && bytesA % 16 == 0 && bytesB % 16 == 0) {
+    fusedIpKnnImpl<DataT, AccT, OutT, IdxT, 16 / sizeof(DataT), usePrevTopKs, isRowMajor>(
+      x, y, m, n, k, lda, ldb, ldd, out_dists, out_inds, numOfNN, stream, workspace, worksize);
+  } else if (8 % sizeof(DataT) == 0 && bytesA % 8 == 0 && bytesB % 8 == 0) {
+    fusedIpKnnImpl<DataT, AccT, OutT, IdxT, 8 / sizeof(DataT), usePrevTopKs, isRowMajor>(
+      x, y, m, n, k, lda, ldb, ldd, out_dists, out_inds, numOfNN, stream, workspace, worksize);
+  } else {
+    fusedIpKnnImpl<DataT, AccT, OutT, IdxT, 1, usePrevTopKs, isRowMajor>(
+      x, y, m, n, k, lda, ldb, ldd, out_dists, out_inds, numOfNN, stream, workspace, worksize);
   }
 }
 
 /**
- * Compute the k-nearest neighbors using L2 expanded/unexpanded distance.
+ * Compute the k-nearest neighbors using L2 expanded/unexpanded, inner-product
+ * or cosine distance.
+ *
+ * For the dot-product metrics the reported distances are the raw dot products
+ * with the largest first, matching the faiss bfKnn convention; CosineExpanded
+ * additionally expects both inputs to be L2-normalized by the caller (see
+ * `MetricProcessor` in processing.hpp) so the dot product is the cosine
+ * similarity.
 
  * @tparam value_idx
  * @tparam value_t
@@ -942,6 +1316,9 @@ void fusedL2ExpKnn(IdxT m,
  * @param[in] rowMajorIndex are the index arrays in row-major layout?
  * @param[in] rowMajorQuery are the query array in row-major layout?
  * @param[in] stream stream to order kernel launch
+ * @param[in] index_norms optional precomputed squared L2 row norms of the index
+ *            array (size n_index_rows); skips the index-side norm kernel for
+ *            the expanded metrics when provided
  */
 template <typename value_idx, typename value_t, bool usePrevTopKs = false>
 void fusedL2Knn(size_t D,
@@ -955,7 +1332,8 @@ void fusedL2Knn(size_t D,
                 bool rowMajorIndex,
                 bool rowMajorQuery,
                 cudaStream_t stream,
-                raft::distance::DistanceType metric)
+                raft::distance::DistanceType metric,
+                const value_t* index_norms = nullptr)
 {
   // Validate the input data
   ASSERT(k > 0, "l2Knn: k must be > 0");
@@ -1002,7 +1380,8 @@ void fusedL2Knn(size_t D,
                                                                               k,
                                                                               stream,
                                                                               workspace.data(),
-                                                                              worksize);
+                                                                              worksize,
+                                                                              index_norms);
       if (worksize > tempWorksize) {
         workspace.resize(worksize, stream);
         fusedL2ExpKnn<value_t, value_t, value_t, value_idx, usePrevTopKs, true>(n_query_rows,
@@ -1019,7 +1398,8 @@ void fusedL2Knn(size_t D,
                                                                                 k,
                                                                                 stream,
                                                                                 workspace.data(),
-                                                                                worksize);
+                                                                                worksize,
+                                                                                index_norms);
       }
       break;
     case raft::distance::DistanceType::L2Unexpanded:
@@ -1058,10 +1438,166 @@ void fusedL2Knn(size_t D,
                                                                                   worksize);
       }
       break;
-    default: printf("only L2 distance metric is supported\n"); break;
+    case raft::distance::DistanceType::InnerProduct:
+    case raft::distance::DistanceType::CosineExpanded:
+      // Both metrics run the plain dot-product core; the kernel selects on the
+      // negated dot product so the min-selection machinery returns the largest
+      // dot products. The sign is flipped back below, and for previously
+      // computed top-ks flipped forward first so they merge in kernel domain.
+      if (usePrevTopKs) {
+        raft::linalg::unaryOp(
+          out_dists,
+          out_dists,
+          n_query_rows * k,
+          [] __device__(value_t in) { return -in; },
+          stream);
+      }
+      fusedIpKnn<value_t, value_t, value_t, value_idx, usePrevTopKs, true>(n_query_rows,
+                                                                           n_index_rows,
+                                                                           D,
+                                                                           lda,
+                                                                           ldb,
+                                                                           ldd,
+                                                                           query,
+                                                                           index,
+                                                                           out_dists,
+                                                                           out_inds,
+                                                                           k,
+                                                                           stream,
+                                                                           workspace.data(),
+                                                                           worksize);
+      if (worksize) {
+        workspace.resize(worksize, stream);
+        fusedIpKnn<value_t, value_t, value_t, value_idx, usePrevTopKs, true>(n_query_rows,
+                                                                             n_index_rows,
+                                                                             D,
+                                                                             lda,
+                                                                             ldb,
+                                                                             ldd,
+                                                                             query,
+                                                                             index,
+                                                                             out_dists,
+                                                                             out_inds,
+                                                                             k,
+                                                                             stream,
+                                                                             workspace.data(),
+                                                                             worksize);
+      }
+      raft::linalg::unaryOp(
+        out_dists,
+        out_dists,
+        n_query_rows * k,
+        [] __device__(value_t in) { return -in; },
+        stream);
+      break;
+    default: printf("only L2, inner-product and cosine distance metrics are supported\n"); break;
   };
 }
 
+/**
+ * Compute the k-nearest neighbors using expanded L2 distance on int8 data.
+ *
+ * The rows are reinterpreted as packed quads of int8 lanes so the hot loop
+ * accumulates four multiplies per dp4a instruction; the squared distances are
+ * computed exactly in int32 via ||x||^2 + ||y||^2 - 2*x.y and then widened to
+ * float on output. Requires row-major inputs with a dimensionality that is a
+ * multiple of 4 (pad with zeros otherwise; zero lanes do not change the
+ * distances).
+ *
+ * @param[in] D the dimensionality of the vectors (must be a multiple of 4)
+ * @param[out] out_inds output indices array on device (size n_query_rows * k)
+ * @param[out] out_dists output dists array on device (size n_query_rows * k)
+ * @param[in] index input index array on device (size n_index_rows * D)
+ * @param[in] query input query array on device (size n_query_rows * D)
+ * @param[in] n_index_rows number of rows in index array
+ * @param[in] n_query_rows number of rows in query array
+ * @param[in] k number of closest neighbors to return
+ * @param[in] stream stream to order kernel launch
+ * @param[in] metric one of the expanded L2 metrics
+ */
+template <typename value_idx>
+void fusedL2Knn(size_t D,
+                value_idx* out_inds,
+                float* out_dists,
+                const int8_t* index,
+                const int8_t* query,
+                size_t n_index_rows,
+                size_t n_query_rows,
+                int k,
+                cudaStream_t stream,
+                raft::distance::DistanceType metric = raft::distance::DistanceType::L2Expanded)
+{
+  ASSERT(k > 0, "l2Knn: k must be > 0");
+  ASSERT(D > 0 && D % 4 == 0, "l2Knn: D must be a positive multiple of 4 for int8 inputs");
+  ASSERT(n_index_rows > 0, "l2Knn: n_index_rows must be > 0");
+  ASSERT(index, "l2Knn: index must be provided (passed null)");
+  ASSERT(n_query_rows > 0, "l2Knn: n_query_rows must be > 0");
+  ASSERT(query, "l2Knn: query must be provided (passed null)");
+  ASSERT(out_dists, "l2Knn: out_dists must be provided (passed null)");
+  ASSERT(out_inds, "l2Knn: out_inds must be provided (passed null)");
+  ASSERT(metric == raft::distance::DistanceType::L2Expanded ||
+           metric == raft::distance::DistanceType::L2SqrtExpanded,
+         "l2Knn: only the expanded L2 metrics are supported for int8 inputs");
+  ASSERT((reinterpret_cast<uintptr_t>(index) % sizeof(int32_t)) == 0 &&
+           (reinterpret_cast<uintptr_t>(query) % sizeof(int32_t)) == 0,
+         "l2Knn: int8 inputs must be 4-byte aligned");
+
+  // view each row as D/4 packed int8 quads
+  const size_t Dp  = D / 4;
+  const auto* x    = reinterpret_cast<const int32_t*>(query);
+  const auto* y    = reinterpret_cast<const int32_t*>(index);
+  value_idx lda = Dp, ldb = Dp, ldd = n_index_rows;
+
+  // match the float path: the sqrt variant also returns squared distances
+  constexpr bool sqrt = false;
+
+  rmm::device_uvector<int32_t> int_dists(n_query_rows * k, stream);
+
+  size_t tempWorksize = (n_query_rows + n_index_rows) * sizeof(int32_t);
+  size_t worksize     = tempWorksize;
+  rmm::device_uvector<char> workspace(worksize, stream);
+  fusedL2ExpKnn<int32_t, int32_t, int32_t, value_idx, false, true, true>(n_query_rows,
+                                                                         n_index_rows,
+                                                                         (value_idx)Dp,
+                                                                         lda,
+                                                                         ldb,
+                                                                         ldd,
+                                                                         x,
+                                                                         y,
+                                                                         sqrt,
+                                                                         int_dists.data(),
+                                                                         out_inds,
+                                                                         k,
+                                                                         stream,
+                                                                         workspace.data(),
+                                                                         worksize);
+  if (worksize > tempWorksize) {
+    workspace.resize(worksize, stream);
+    fusedL2ExpKnn<int32_t, int32_t, int32_t, value_idx, false, true, true>(n_query_rows,
+                                                                           n_index_rows,
+                                                                           (value_idx)Dp,
+                                                                           lda,
+                                                                           ldb,
+                                                                           ldd,
+                                                                           x,
+                                                                           y,
+                                                                           sqrt,
+                                                                           int_dists.data(),
+                                                                           out_inds,
+                                                                           k,
+                                                                           stream,
+                                                                           workspace.data(),
+                                                                           worksize);
+  }
+
+  raft::linalg::unaryOp(
+    out_dists,
+    int_dists.data(),
+    n_query_rows * k,
+    [] __device__(int32_t d) { return static_cast<float>(d); },
+    stream);
+}
+
 }  // namespace detail
 }  // namespace knn
 }  // namespace spatial
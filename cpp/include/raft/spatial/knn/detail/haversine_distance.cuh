@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include "topk/warpsort_topk.cuh"
+
 #include <raft/cuda_utils.cuh>
 #include <raft/cudart_utils.h>
 
@@ -29,6 +31,8 @@
 #include <raft/handle.hpp>
 #include <raft/spatial/knn/faiss_mr.hpp>
 
+#include <algorithm>
+
 namespace raft {
 namespace spatial {
 namespace knn {
@@ -116,6 +120,64 @@ __global__ void haversine_knn_kernel(value_idx* out_inds,
   }
 }
 
+/**
+ * Fused haversine + top-k selection: one block per query, each warp feeding a
+ * warpsort queue as it scans its share of the index rows, with the per-warp
+ * results tree-merged in shared memory at the end. Unlike the faiss
+ * block-select kernel above, the queue capacity is sized to k at compile time
+ * instead of a fixed 1024, which makes the typical small-k geo query much
+ * cheaper in shared memory and merge work.
+ */
+template <typename value_idx, typename value_t, int capacity, int tpb = 128>
+__global__ void haversine_knn_warpsort_kernel(value_idx* out_inds,
+                                              value_t* out_dists,
+                                              const value_t* index,
+                                              const value_t* query,
+                                              size_t n_index_rows,
+                                              int k)
+{
+  using queue_t = topk::warp_sort_filtered<capacity, true, value_t, value_idx>;
+  extern __shared__ __align__(256) uint8_t smem_buf[];
+  topk::block_sort<topk::warp_sort_filtered, capacity, true, value_t, value_idx> queue(k,
+                                                                                       smem_buf);
+
+  const value_t* query_ptr = query + (blockIdx.x * 2);
+  const value_t x1         = query_ptr[0];
+  const value_t x2         = query_ptr[1];
+
+  // pad the scan past the end so every thread of a warp keeps participating
+  // in the (warp-uniform) queue operations; dummy values are never selected
+  const size_t per_thread_lim = n_index_rows + laneId();
+  for (size_t i = threadIdx.x; i < per_thread_lim; i += tpb) {
+    value_t dist  = queue_t::kDummy;
+    value_idx idx = 0;
+    if (i < n_index_rows) {
+      dist = compute_haversine(x1, index[i * 2], x2, index[i * 2 + 1]);
+      idx  = value_idx(i);
+    }
+    queue.add(dist, idx);
+  }
+  queue.done();
+  queue.store(out_dists + size_t(blockIdx.x) * k, out_inds + size_t(blockIdx.x) * k);
+}
+
+template <typename value_idx, typename value_t, int capacity>
+void haversine_knn_warpsort(value_idx* out_inds,
+                            value_t* out_dists,
+                            const value_t* index,
+                            const value_t* query,
+                            size_t n_index_rows,
+                            size_t n_query_rows,
+                            int k,
+                            cudaStream_t stream)
+{
+  constexpr int tpb     = 128;
+  const int num_of_warp = tpb / std::min(capacity, int(raft::WarpSize));
+  const int smem_size   = topk::calc_smem_size_for_block_wide<value_t, value_idx>(num_of_warp, k);
+  haversine_knn_warpsort_kernel<value_idx, value_t, capacity, tpb>
+    <<<n_query_rows, tpb, smem_size, stream>>>(out_inds, out_dists, index, query, n_index_rows, k);
+}
+
 /**
  * Conmpute the k-nearest neighbors using the Haversine
  * (great circle arc) distance. Input is assumed to have
@@ -142,8 +204,26 @@ void haversine_knn(value_idx* out_inds,
                    int k,
                    cudaStream_t stream)
 {
-  haversine_knn_kernel<<<n_query_rows, 128, 0, stream>>>(
-    out_inds, out_dists, index, query, n_index_rows, k);
+  // capacities below one warp still work but bring no extra benefit here
+  const int capacity = std::max(int(raft::WarpSize), topk::calc_capacity(k));
+  switch (capacity) {
+    case 32:
+      return haversine_knn_warpsort<value_idx, value_t, 32>(
+        out_inds, out_dists, index, query, n_index_rows, n_query_rows, k, stream);
+    case 64:
+      return haversine_knn_warpsort<value_idx, value_t, 64>(
+        out_inds, out_dists, index, query, n_index_rows, n_query_rows, k, stream);
+    case 128:
+      return haversine_knn_warpsort<value_idx, value_t, 128>(
+        out_inds, out_dists, index, query, n_index_rows, n_query_rows, k, stream);
+    case 256:
+      return haversine_knn_warpsort<value_idx, value_t, 256>(
+        out_inds, out_dists, index, query, n_index_rows, n_query_rows, k, stream);
+    default:
+      // k too large for the warpsort queues: fall back to faiss block select
+      haversine_knn_kernel<<<n_query_rows, 128, 0, stream>>>(
+        out_inds, out_dists, index, query, n_index_rows, k);
+  }
 }
 
 }  // namespace detail
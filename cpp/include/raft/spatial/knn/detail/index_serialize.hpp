@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/cudart_utils.h>
+
+#include <rmm/cuda_stream_view.hpp>
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+namespace raft {
+namespace spatial {
+namespace knn {
+namespace detail {
+
+/** Write one plain scalar to a binary stream. */
+template <typename T>
+void serialize_scalar(std::ostream& os, const T& value)
+{
+  os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/** Read one plain scalar back from a binary stream. */
+template <typename T>
+auto deserialize_scalar(std::istream& is) -> T
+{
+  T value;
+  is.read(reinterpret_cast<char*>(&value), sizeof(T));
+  RAFT_EXPECTS(is.good(), "index deserialization: truncated input");
+  return value;
+}
+
+/** Copy a device array to the host and write it as one contiguous block. */
+template <typename T>
+void serialize_device_array(std::ostream& os, const T* data, size_t n, rmm::cuda_stream_view stream)
+{
+  std::vector<T> host(n);
+  raft::update_host(host.data(), data, n, stream);
+  RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+  os.write(reinterpret_cast<const char*>(host.data()), n * sizeof(T));
+}
+
+/** Read one contiguous block back and upload it to an existing device array. */
+template <typename T>
+void deserialize_device_array(std::istream& is, T* data, size_t n, rmm::cuda_stream_view stream)
+{
+  std::vector<T> host(n);
+  is.read(reinterpret_cast<char*>(host.data()), n * sizeof(T));
+  RAFT_EXPECTS(is.good(), "index deserialization: truncated input");
+  raft::update_device(data, host.data(), n, stream);
+  // the staging buffer dies on return, so the copy must complete first
+  RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+}
+
+}  // namespace detail
+}  // namespace knn
+}  // namespace spatial
+}  // namespace raft
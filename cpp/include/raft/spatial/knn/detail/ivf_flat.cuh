@@ -0,0 +1,362 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "selection_faiss.cuh"
+
+#include <raft/cluster/kmeans.cuh>
+#include <raft/cuda_utils.cuh>
+#include <raft/distance/distance.cuh>
+#include <raft/distance/distance_type.hpp>
+#include <raft/handle.hpp>
+#include <raft/linalg/unary_op.cuh>
+#include <raft/spatial/knn/ivf_flat_types.hpp>
+
+#include <rmm/device_uvector.hpp>
+#include <rmm/exec_policy.hpp>
+
+#include <thrust/extrema.h>
+#include <thrust/fill.h>
+#include <thrust/reduce.h>
+#include <thrust/scan.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace raft {
+namespace spatial {
+namespace knn {
+namespace ivf_flat {
+namespace detail {
+
+/** accumulate the inverted list sizes from the cluster assignments */
+template <typename LabelT, typename IdxT>
+__global__ void listSizesKernel(uint32_t* sizes, const LabelT* labels, IdxT n_rows)
+{
+  IdxT tid = threadIdx.x + IdxT(blockIdx.x) * blockDim.x;
+  if (tid < n_rows) { atomicAdd(sizes + labels[tid], 1); }
+}
+
+/**
+ * Regroups the dataset rows into their inverted lists, one warp per row.
+ * `fill` tracks the running occupancy of each list and must be zeroed before
+ * the launch.
+ */
+template <typename T, typename LabelT, typename IdxT>
+__global__ void scatterListsKernel(T* list_data,
+                                   IdxT* list_indices,
+                                   const T* dataset,
+                                   const LabelT* labels,
+                                   const IdxT* list_offsets,
+                                   uint32_t* fill,
+                                   IdxT n_rows,
+                                   uint32_t dim)
+{
+  const int lane     = threadIdx.x % raft::WarpSize;
+  const IdxT n_warps = IdxT(blockDim.x / raft::WarpSize) * gridDim.x;
+  IdxT warp = (threadIdx.x + IdxT(blockIdx.x) * blockDim.x) / raft::WarpSize;
+
+  for (IdxT row = warp; row < n_rows; row += n_warps) {
+    const LabelT list = labels[row];
+    uint32_t pos      = 0;
+    if (lane == 0) { pos = atomicAdd(fill + list, 1); }
+    pos            = raft::shfl(pos, 0);
+    const IdxT dst = list_offsets[list] + pos;
+    for (uint32_t j = lane; j < dim; j += raft::WarpSize) {
+      list_data[dst * dim + j] = dataset[row * dim + j];
+    }
+    if (lane == 0) { list_indices[dst] = row; }
+  }
+}
+
+/**
+ * Recomputes the cluster centers as the mean of each (already regrouped)
+ * inverted list; this is exactly the Lloyd update for the final assignment.
+ */
+template <typename T, typename IdxT>
+__global__ void listCentersKernel(T* centers,
+                                  const T* list_data,
+                                  const IdxT* list_offsets,
+                                  uint32_t dim)
+{
+  const uint32_t list = blockIdx.x;
+  const IdxT start    = list_offsets[list];
+  const IdxT end      = list_offsets[list + 1];
+  for (uint32_t d = threadIdx.x; d < dim; d += blockDim.x) {
+    T acc = 0;
+    for (IdxT r = start; r < end; r++) {
+      acc += list_data[r * dim + d];
+    }
+    centers[list * dim + d] = end > start ? acc / T(end - start) : T(0);
+  }
+}
+
+/**
+ * Computes, per query, the offset of each probed list within that query's
+ * candidate buffer, plus the total candidate count. One thread per query; the
+ * per-query probe count is small so the sequential walk is cheap.
+ */
+template <typename IdxT>
+__global__ void candidateOffsetsKernel(IdxT* cand_offsets,
+                                       IdxT* cand_totals,
+                                       const int* probe_ids,
+                                       const IdxT* list_offsets,
+                                       uint32_t n_queries,
+                                       uint32_t n_probes)
+{
+  uint32_t q = threadIdx.x + blockIdx.x * blockDim.x;
+  if (q >= n_queries) { return; }
+  IdxT cum = 0;
+  for (uint32_t p = 0; p < n_probes; p++) {
+    const int list                  = probe_ids[q * n_probes + p];
+    cand_offsets[q * n_probes + p] = cum;
+    cum += list_offsets[list + 1] - list_offsets[list];
+  }
+  cand_totals[q] = cum;
+}
+
+/**
+ * Computes the distances from each query to every member of its probed
+ * lists. One block per (query, probe) pair, one warp per list entry with the
+ * feature dimension strided across the lanes.
+ */
+template <typename T, typename IdxT, int tpb = 128>
+__global__ void ivfFlatScanKernel(T* cand_dists,
+                                  IdxT* cand_inds,
+                                  const T* queries,
+                                  const T* list_data,
+                                  const IdxT* list_indices,
+                                  const IdxT* list_offsets,
+                                  const int* probe_ids,
+                                  const IdxT* cand_offsets,
+                                  uint32_t n_probes,
+                                  uint32_t dim,
+                                  IdxT max_cand,
+                                  bool inner_prod)
+{
+  const uint32_t q          = blockIdx.x;
+  const uint32_t p          = blockIdx.y;
+  const int lane            = threadIdx.x % raft::WarpSize;
+  const int warp            = threadIdx.x / raft::WarpSize;
+  constexpr int warps_per_b = tpb / raft::WarpSize;
+
+  const int list    = probe_ids[q * n_probes + p];
+  const IdxT start  = list_offsets[list];
+  const IdxT n_in   = list_offsets[list + 1] - start;
+  const IdxT base   = IdxT(q) * max_cand + cand_offsets[q * n_probes + p];
+  const T* query    = queries + size_t(q) * dim;
+
+  for (IdxT c = warp; c < n_in; c += warps_per_b) {
+    const T* row = list_data + size_t(start + c) * dim;
+    T acc        = 0;
+    for (uint32_t j = lane; j < dim; j += raft::WarpSize) {
+      if (inner_prod) {
+        acc += query[j] * row[j];
+      } else {
+        T diff = query[j] - row[j];
+        acc += diff * diff;
+      }
+    }
+    acc = raft::warpReduce(acc);
+    if (lane == 0) {
+      cand_dists[base + c] = acc;
+      cand_inds[base + c]  = list_indices[start + c];
+    }
+  }
+}
+
+/** @brief Build an IVF-Flat index. See `raft::spatial::knn::ivf_flat::build`. */
+template <typename T, typename IdxT>
+auto build(const raft::handle_t& handle,
+           const index_params& params,
+           const T* dataset,
+           IdxT n_rows,
+           uint32_t dim,
+           raft::distance::DistanceType metric) -> index<T, IdxT>
+{
+  auto stream = handle.get_stream();
+  ASSERT(n_rows > 0 && dim > 0, "empty dataset");
+  ASSERT(n_rows >= static_cast<IdxT>(params.n_lists), "more lists than dataset rows");
+  ASSERT(n_rows <= static_cast<IdxT>(std::numeric_limits<int>::max()),
+         "dataset does not fit the coarse quantizer's indexing type");
+
+  index<T, IdxT> idx(handle, metric, params.n_lists, dim);
+
+  // train the coarse quantizer; a row-major [n_rows, dim] dataset doubles as
+  // the column-major [dim, n_rows] observation matrix kmeans expects
+  rmm::device_uvector<int> labels(n_rows, stream);
+  T residual = 0;
+  int iters  = 0;
+  int status = raft::cluster::kmeans<int, T>(handle,
+                                             static_cast<int>(n_rows),
+                                             static_cast<int>(dim),
+                                             static_cast<int>(params.n_lists),
+                                             static_cast<T>(params.kmeans_tol),
+                                             static_cast<int>(params.kmeans_n_iters),
+                                             dataset,
+                                             labels.data(),
+                                             residual,
+                                             iters);
+  RAFT_EXPECTS(status == 0, "ivf_flat::build: k-means training failed");
+
+  // list sizes and offsets
+  rmm::device_uvector<uint32_t> sizes(params.n_lists, stream);
+  RAFT_CUDA_TRY(cudaMemsetAsync(sizes.data(), 0, sizes.size() * sizeof(uint32_t), stream));
+  listSizesKernel<<<raft::ceildiv<IdxT>(n_rows, 256), 256, 0, stream>>>(
+    sizes.data(), labels.data(), n_rows);
+  RAFT_CUDA_TRY(cudaGetLastError());
+  thrust::exclusive_scan(rmm::exec_policy(stream),
+                         sizes.data(),
+                         sizes.data() + params.n_lists,
+                         idx.list_offsets.data(),
+                         IdxT(0));
+  raft::update_device(idx.list_offsets.data() + params.n_lists, &n_rows, 1, stream);
+
+  // regroup the rows into their lists
+  idx.data.resize(static_cast<std::size_t>(n_rows) * dim, stream);
+  idx.indices.resize(n_rows, stream);
+  RAFT_CUDA_TRY(cudaMemsetAsync(sizes.data(), 0, sizes.size() * sizeof(uint32_t), stream));
+  scatterListsKernel<<<raft::ceildiv<IdxT>(n_rows * raft::WarpSize, 256), 256, 0, stream>>>(
+    idx.data.data(),
+    idx.indices.data(),
+    dataset,
+    labels.data(),
+    idx.list_offsets.data(),
+    sizes.data(),
+    n_rows,
+    dim);
+  RAFT_CUDA_TRY(cudaGetLastError());
+
+  listCentersKernel<<<params.n_lists, 128, 0, stream>>>(
+    idx.centers.data(), idx.data.data(), idx.list_offsets.data(), dim);
+  RAFT_CUDA_TRY(cudaGetLastError());
+
+  idx.size = n_rows;
+  return idx;
+}
+
+/** @brief Search an IVF-Flat index. See `raft::spatial::knn::ivf_flat::search`. */
+template <typename T, typename IdxT>
+void search(const raft::handle_t& handle,
+            const search_params& params,
+            const index<T, IdxT>& idx,
+            const T* queries,
+            uint32_t n_queries,
+            uint32_t k,
+            IdxT* neighbors,
+            T* distances)
+{
+  auto stream = handle.get_stream();
+  ASSERT(n_queries > 0 && k > 0, "empty query batch");
+  ASSERT(k <= static_cast<uint32_t>(knn::detail::kFaissMaxK<IdxT, T>()),
+         "k is too large for the selection step");
+
+  uint32_t n_probes = std::min(params.n_probes, idx.n_lists);
+  ASSERT(n_probes > 0, "n_probes must be positive");
+  bool inner_prod = idx.metric == raft::distance::DistanceType::InnerProduct;
+
+  // coarse phase: pick the n_probes closest centers per query (always by L2;
+  // for inner-product indexes this is the usual spherical approximation)
+  rmm::device_uvector<T> coarse_dists(static_cast<std::size_t>(n_queries) * idx.n_lists, stream);
+  raft::distance::pairwise_distance<T, int>(handle,
+                                            queries,
+                                            idx.centers.data(),
+                                            coarse_dists.data(),
+                                            static_cast<int>(n_queries),
+                                            static_cast<int>(idx.n_lists),
+                                            static_cast<int>(idx.dim),
+                                            raft::distance::DistanceType::L2Expanded,
+                                            true);
+  rmm::device_uvector<int> probe_ids(static_cast<std::size_t>(n_queries) * n_probes, stream);
+  rmm::device_uvector<T> probe_dists(probe_ids.size(), stream);
+  knn::detail::select_k<int, T>(coarse_dists.data(),
+                                nullptr,
+                                n_queries,
+                                idx.n_lists,
+                                probe_dists.data(),
+                                probe_ids.data(),
+                                true,
+                                n_probes,
+                                stream);
+
+  // lay the candidates of each query out contiguously in a padded buffer
+  rmm::device_uvector<IdxT> cand_offsets(probe_ids.size(), stream);
+  rmm::device_uvector<IdxT> cand_totals(n_queries, stream);
+  candidateOffsetsKernel<<<raft::ceildiv<uint32_t>(n_queries, 128), 128, 0, stream>>>(
+    cand_offsets.data(),
+    cand_totals.data(),
+    probe_ids.data(),
+    idx.list_offsets.data(),
+    n_queries,
+    n_probes);
+  RAFT_CUDA_TRY(cudaGetLastError());
+  IdxT max_cand = thrust::reduce(rmm::exec_policy(stream),
+                                 cand_totals.data(),
+                                 cand_totals.data() + n_queries,
+                                 IdxT(0),
+                                 thrust::maximum<IdxT>());
+
+  rmm::device_uvector<T> cand_dists(static_cast<std::size_t>(n_queries) * max_cand, stream);
+  rmm::device_uvector<IdxT> cand_inds(cand_dists.size(), stream);
+  thrust::fill(rmm::exec_policy(stream),
+               cand_dists.data(),
+               cand_dists.data() + cand_dists.size(),
+               inner_prod ? raft::lower_bound<T>() : raft::upper_bound<T>());
+  thrust::fill(
+    rmm::exec_policy(stream), cand_inds.data(), cand_inds.data() + cand_inds.size(), IdxT(-1));
+
+  dim3 grid(n_queries, n_probes);
+  ivfFlatScanKernel<T, IdxT><<<grid, 128, 0, stream>>>(cand_dists.data(),
+                                                       cand_inds.data(),
+                                                       queries,
+                                                       idx.data.data(),
+                                                       idx.indices.data(),
+                                                       idx.list_offsets.data(),
+                                                       probe_ids.data(),
+                                                       cand_offsets.data(),
+                                                       n_probes,
+                                                       idx.dim,
+                                                       max_cand,
+                                                       inner_prod);
+  RAFT_CUDA_TRY(cudaGetLastError());
+
+  knn::detail::select_k<IdxT, T>(cand_dists.data(),
+                                 cand_inds.data(),
+                                 n_queries,
+                                 max_cand,
+                                 distances,
+                                 neighbors,
+                                 !inner_prod,
+                                 k,
+                                 stream);
+
+  if (idx.metric == raft::distance::DistanceType::L2SqrtExpanded ||
+      idx.metric == raft::distance::DistanceType::L2SqrtUnexpanded) {
+    raft::linalg::unaryOp<T>(
+      distances,
+      distances,
+      static_cast<std::size_t>(n_queries) * k,
+      [] __device__(T in) { return raft::mySqrt(in); },
+      stream);
+  }
+}
+
+}  // namespace detail
+}  // namespace ivf_flat
+}  // namespace knn
+}  // namespace spatial
+}  // namespace raft
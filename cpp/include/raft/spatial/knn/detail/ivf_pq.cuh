@@ -0,0 +1,437 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "ivf_flat.cuh"
+#include "topk/warpsort_topk.cuh"
+
+#include <raft/cluster/kmeans.cuh>
+#include <raft/cuda_utils.cuh>
+#include <raft/distance/distance.cuh>
+#include <raft/handle.hpp>
+#include <raft/linalg/unary_op.cuh>
+#include <raft/spatial/knn/ivf_pq_types.hpp>
+
+#include <rmm/device_uvector.hpp>
+#include <rmm/exec_policy.hpp>
+
+#include <thrust/fill.h>
+#include <thrust/reduce.h>
+#include <thrust/scan.h>
+
+namespace raft {
+namespace spatial {
+namespace knn {
+namespace ivf_pq {
+namespace detail {
+
+/** subtract the assigned coarse center from every row */
+template <typename LabelT, typename IdxT>
+__global__ void residualKernel(float* residuals,
+                               const float* dataset,
+                               const float* centers,
+                               const LabelT* labels,
+                               IdxT n_rows,
+                               uint32_t dim)
+{
+  IdxT tid = threadIdx.x + IdxT(blockIdx.x) * blockDim.x;
+  if (tid >= n_rows * dim) { return; }
+  IdxT row       = tid / dim;
+  uint32_t d     = tid % dim;
+  residuals[tid] = dataset[tid] - centers[size_t(labels[row]) * dim + d];
+}
+
+/** gather one sub-space of the residuals into a contiguous buffer */
+template <typename IdxT>
+__global__ void gatherSubspaceKernel(float* out,
+                                     const float* residuals,
+                                     IdxT n_rows,
+                                     uint32_t dim,
+                                     uint32_t sub_dim,
+                                     uint32_t sub_offset)
+{
+  IdxT tid = threadIdx.x + IdxT(blockIdx.x) * blockDim.x;
+  if (tid >= n_rows * sub_dim) { return; }
+  IdxT row   = tid / sub_dim;
+  uint32_t d = tid % sub_dim;
+  out[tid]   = residuals[row * dim + sub_offset + d];
+}
+
+/** accumulate per-center sums and counts of the assigned sub-vectors */
+template <typename LabelT, typename IdxT>
+__global__ void accumulateCodebookKernel(float* sums,
+                                         uint32_t* counts,
+                                         const float* sub_vectors,
+                                         const LabelT* labels,
+                                         IdxT n_rows,
+                                         uint32_t sub_dim)
+{
+  IdxT tid = threadIdx.x + IdxT(blockIdx.x) * blockDim.x;
+  if (tid >= n_rows * sub_dim) { return; }
+  IdxT row     = tid / sub_dim;
+  uint32_t d   = tid % sub_dim;
+  LabelT c     = labels[row];
+  atomicAdd(sums + size_t(c) * sub_dim + d, sub_vectors[tid]);
+  if (d == 0) { atomicAdd(counts + c, 1); }
+}
+
+/** turn the accumulated sums into means */
+__global__ void divideCodebookKernel(float* centers,
+                                     const uint32_t* counts,
+                                     uint32_t n_centers,
+                                     uint32_t sub_dim)
+{
+  uint32_t tid = threadIdx.x + blockIdx.x * blockDim.x;
+  if (tid >= n_centers * sub_dim) { return; }
+  uint32_t c = tid / sub_dim;
+  if (counts[c] > 0) { centers[tid] /= float(counts[c]); }
+}
+
+/** pack one sub-quantizer's assignments into the code matrix */
+template <typename LabelT, typename IdxT>
+__global__ void packCodesKernel(
+  uint8_t* codes, const LabelT* labels, IdxT n_rows, uint32_t pq_dim, uint32_t m)
+{
+  IdxT row = threadIdx.x + IdxT(blockIdx.x) * blockDim.x;
+  if (row < n_rows) { codes[row * pq_dim + m] = static_cast<uint8_t>(labels[row]); }
+}
+
+/**
+ * Fused LUT construction + code scan, one block per (query, probe) pair.
+ *
+ * The block first computes the query residual against the probed list's
+ * coarse center and from it the full lookup table of per-sub-space partial
+ * distances -- pq_dim * 256 floats, kept resident in shared memory. It then
+ * sweeps the list's codes with one thread per entry, each distance being just
+ * pq_dim shared-memory lookups.
+ */
+template <typename IdxT, int tpb = 128>
+__global__ void ivfPqScanKernel(float* cand_dists,
+                                IdxT* cand_inds,
+                                const float* queries,
+                                const float* centers,
+                                const float* pq_centers,
+                                const uint8_t* codes,
+                                const IdxT* list_indices,
+                                const IdxT* list_offsets,
+                                const int* probe_ids,
+                                const IdxT* cand_offsets,
+                                uint32_t n_probes,
+                                uint32_t dim,
+                                uint32_t pq_dim,
+                                uint32_t sub_dim,
+                                IdxT max_cand)
+{
+  constexpr uint32_t kPqCenters = index<IdxT>::kPqCenters;
+  extern __shared__ float smem[];
+  float* res_q = smem;        // [dim]
+  float* lut   = smem + dim;  // [pq_dim, kPqCenters]
+
+  const uint32_t q = blockIdx.x;
+  const uint32_t p = blockIdx.y;
+  const int list   = probe_ids[q * n_probes + p];
+
+  for (uint32_t j = threadIdx.x; j < dim; j += tpb) {
+    res_q[j] = queries[size_t(q) * dim + j] - centers[size_t(list) * dim + j];
+  }
+  __syncthreads();
+
+  for (uint32_t e = threadIdx.x; e < pq_dim * kPqCenters; e += tpb) {
+    const uint32_t m      = e / kPqCenters;
+    const float* pq_cent  = pq_centers + size_t(e) * sub_dim;
+    const float* res_sub  = res_q + m * sub_dim;
+    float acc             = 0;
+    for (uint32_t d = 0; d < sub_dim; d++) {
+      float diff = res_sub[d] - pq_cent[d];
+      acc += diff * diff;
+    }
+    lut[e] = acc;
+  }
+  __syncthreads();
+
+  const IdxT start = list_offsets[list];
+  const IdxT n_in  = list_offsets[list + 1] - start;
+  const IdxT base  = IdxT(q) * max_cand + cand_offsets[q * n_probes + p];
+  for (IdxT c = threadIdx.x; c < n_in; c += tpb) {
+    const uint8_t* code = codes + size_t(start + c) * pq_dim;
+    float acc           = 0;
+    for (uint32_t m = 0; m < pq_dim; m++) {
+      acc += lut[m * kPqCenters + code[m]];
+    }
+    cand_dists[base + c] = acc;
+    cand_inds[base + c]  = list_indices[start + c];
+  }
+}
+
+/** @brief Build an IVF-PQ index. See `raft::spatial::knn::ivf_pq::build`. */
+template <typename IdxT>
+auto build(const raft::handle_t& handle,
+           const index_params& params,
+           const float* dataset,
+           IdxT n_rows,
+           uint32_t dim,
+           raft::distance::DistanceType metric) -> index<IdxT>
+{
+  auto stream = handle.get_stream();
+  ASSERT(n_rows > 0 && dim > 0, "empty dataset");
+  ASSERT(metric == raft::distance::DistanceType::L2Expanded ||
+           metric == raft::distance::DistanceType::L2SqrtExpanded ||
+           metric == raft::distance::DistanceType::L2Unexpanded ||
+           metric == raft::distance::DistanceType::L2SqrtUnexpanded,
+         "ivf_pq supports the L2 metrics only");
+
+  uint32_t pq_dim = params.pq_dim;
+  if (pq_dim == 0) {
+    ASSERT(dim % 4 == 0, "pq_dim not given and dim is not a multiple of 4");
+    pq_dim = dim / 4;
+  }
+  ASSERT(dim % pq_dim == 0, "pq_dim must divide dim");
+  constexpr uint32_t kPqCenters = index<IdxT>::kPqCenters;
+  ASSERT(n_rows >= static_cast<IdxT>(kPqCenters),
+         "at least %u rows are needed to train the sub-quantizers",
+         kPqCenters);
+  ASSERT(n_rows >= static_cast<IdxT>(params.n_lists), "more lists than dataset rows");
+  ASSERT(n_rows <= static_cast<IdxT>(std::numeric_limits<int>::max()),
+         "dataset does not fit the quantizers' indexing type");
+
+  index<IdxT> idx(handle, metric, params.n_lists, dim, pq_dim);
+  uint32_t sub_dim = idx.sub_dim;
+
+  // coarse quantizer
+  rmm::device_uvector<int> labels(n_rows, stream);
+  float residual = 0;
+  int iters      = 0;
+  int status     = raft::cluster::kmeans<int, float>(handle,
+                                                 static_cast<int>(n_rows),
+                                                 static_cast<int>(dim),
+                                                 static_cast<int>(params.n_lists),
+                                                 static_cast<float>(params.kmeans_tol),
+                                                 static_cast<int>(params.kmeans_n_iters),
+                                                 dataset,
+                                                 labels.data(),
+                                                 residual,
+                                                 iters);
+  RAFT_EXPECTS(status == 0, "ivf_pq::build: coarse k-means training failed");
+
+  // coarse centers as the means of the final assignment (Lloyd update); the
+  // residuals below must be taken against the centers search will use
+  rmm::device_uvector<uint32_t> sizes(params.n_lists, stream);
+  RAFT_CUDA_TRY(cudaMemsetAsync(sizes.data(), 0, sizes.size() * sizeof(uint32_t), stream));
+  ivf_flat::detail::listSizesKernel<<<raft::ceildiv<IdxT>(n_rows, 256), 256, 0, stream>>>(
+    sizes.data(), labels.data(), n_rows);
+  RAFT_CUDA_TRY(cudaGetLastError());
+  thrust::exclusive_scan(rmm::exec_policy(stream),
+                         sizes.data(),
+                         sizes.data() + params.n_lists,
+                         idx.list_offsets.data(),
+                         IdxT(0));
+  raft::update_device(idx.list_offsets.data() + params.n_lists, &n_rows, 1, stream);
+
+  {
+    rmm::device_uvector<uint32_t> counts(params.n_lists, stream);
+    RAFT_CUDA_TRY(cudaMemsetAsync(counts.data(), 0, counts.size() * sizeof(uint32_t), stream));
+    RAFT_CUDA_TRY(
+      cudaMemsetAsync(idx.centers.data(), 0, idx.centers.size() * sizeof(float), stream));
+    accumulateCodebookKernel<<<raft::ceildiv<IdxT>(n_rows * dim, 256), 256, 0, stream>>>(
+      idx.centers.data(), counts.data(), dataset, labels.data(), n_rows, dim);
+    RAFT_CUDA_TRY(cudaGetLastError());
+    divideCodebookKernel<<<raft::ceildiv<uint32_t>(params.n_lists * dim, 256), 256, 0, stream>>>(
+      idx.centers.data(), counts.data(), params.n_lists, dim);
+    RAFT_CUDA_TRY(cudaGetLastError());
+  }
+
+  // residuals and per-sub-space quantizers
+  rmm::device_uvector<float> residuals(static_cast<std::size_t>(n_rows) * dim, stream);
+  residualKernel<<<raft::ceildiv<IdxT>(n_rows * dim, 256), 256, 0, stream>>>(
+    residuals.data(), dataset, idx.centers.data(), labels.data(), n_rows, dim);
+  RAFT_CUDA_TRY(cudaGetLastError());
+
+  rmm::device_uvector<uint8_t> codes_flat(static_cast<std::size_t>(n_rows) * pq_dim, stream);
+  rmm::device_uvector<float> sub_vectors(static_cast<std::size_t>(n_rows) * sub_dim, stream);
+  rmm::device_uvector<int> sub_labels(n_rows, stream);
+  rmm::device_uvector<uint32_t> sub_counts(kPqCenters, stream);
+  for (uint32_t m = 0; m < pq_dim; m++) {
+    gatherSubspaceKernel<<<raft::ceildiv<IdxT>(n_rows * sub_dim, 256), 256, 0, stream>>>(
+      sub_vectors.data(), residuals.data(), n_rows, dim, sub_dim, m * sub_dim);
+    RAFT_CUDA_TRY(cudaGetLastError());
+    status = raft::cluster::kmeans<int, float>(handle,
+                                               static_cast<int>(n_rows),
+                                               static_cast<int>(sub_dim),
+                                               static_cast<int>(kPqCenters),
+                                               static_cast<float>(params.kmeans_tol),
+                                               static_cast<int>(params.kmeans_n_iters),
+                                               sub_vectors.data(),
+                                               sub_labels.data(),
+                                               residual,
+                                               iters);
+    RAFT_EXPECTS(status == 0, "ivf_pq::build: sub-quantizer %u training failed", m);
+
+    float* codebook = idx.pq_centers.data() + static_cast<std::size_t>(m) * kPqCenters * sub_dim;
+    RAFT_CUDA_TRY(cudaMemsetAsync(codebook, 0, size_t(kPqCenters) * sub_dim * sizeof(float), stream));
+    RAFT_CUDA_TRY(
+      cudaMemsetAsync(sub_counts.data(), 0, sub_counts.size() * sizeof(uint32_t), stream));
+    accumulateCodebookKernel<<<raft::ceildiv<IdxT>(n_rows * sub_dim, 256), 256, 0, stream>>>(
+      codebook, sub_counts.data(), sub_vectors.data(), sub_labels.data(), n_rows, sub_dim);
+    RAFT_CUDA_TRY(cudaGetLastError());
+    divideCodebookKernel<<<raft::ceildiv<uint32_t>(kPqCenters * sub_dim, 256), 256, 0, stream>>>(
+      codebook, sub_counts.data(), kPqCenters, sub_dim);
+    RAFT_CUDA_TRY(cudaGetLastError());
+
+    packCodesKernel<<<raft::ceildiv<IdxT>(n_rows, 256), 256, 0, stream>>>(
+      codes_flat.data(), sub_labels.data(), n_rows, pq_dim, m);
+    RAFT_CUDA_TRY(cudaGetLastError());
+  }
+
+  // regroup codes and source indices into the inverted lists
+  idx.codes.resize(static_cast<std::size_t>(n_rows) * pq_dim, stream);
+  idx.indices.resize(n_rows, stream);
+  RAFT_CUDA_TRY(cudaMemsetAsync(sizes.data(), 0, sizes.size() * sizeof(uint32_t), stream));
+  ivf_flat::detail::
+    scatterListsKernel<<<raft::ceildiv<IdxT>(n_rows * raft::WarpSize, 256), 256, 0, stream>>>(
+      idx.codes.data(),
+      idx.indices.data(),
+      codes_flat.data(),
+      labels.data(),
+      idx.list_offsets.data(),
+      sizes.data(),
+      n_rows,
+      pq_dim);
+  RAFT_CUDA_TRY(cudaGetLastError());
+
+  idx.size = n_rows;
+  return idx;
+}
+
+/** @brief Search an IVF-PQ index. See `raft::spatial::knn::ivf_pq::search`. */
+template <typename IdxT>
+void search(const raft::handle_t& handle,
+            const search_params& params,
+            const index<IdxT>& idx,
+            const float* queries,
+            uint32_t n_queries,
+            uint32_t k,
+            IdxT* neighbors,
+            float* distances)
+{
+  auto stream = handle.get_stream();
+  ASSERT(n_queries > 0 && k > 0, "empty query batch");
+  ASSERT(k <= static_cast<uint32_t>(knn::detail::topk::kMaxCapacity),
+         "k is too large for the warpsort selection step");
+
+  uint32_t n_probes = std::min(params.n_probes, idx.n_lists);
+  ASSERT(n_probes > 0 && n_probes <= static_cast<uint32_t>(knn::detail::topk::kMaxCapacity),
+         "n_probes is out of the supported range");
+  constexpr uint32_t kPqCenters = index<IdxT>::kPqCenters;
+  size_t smem_size              = (idx.dim + size_t(idx.pq_dim) * kPqCenters) * sizeof(float);
+  ASSERT(smem_size <= 48 * 1024, "the PQ lookup table does not fit in shared memory");
+
+  // coarse phase
+  rmm::device_uvector<float> coarse_dists(static_cast<std::size_t>(n_queries) * idx.n_lists,
+                                          stream);
+  raft::distance::pairwise_distance<float, int>(handle,
+                                                queries,
+                                                idx.centers.data(),
+                                                coarse_dists.data(),
+                                                static_cast<int>(n_queries),
+                                                static_cast<int>(idx.n_lists),
+                                                static_cast<int>(idx.dim),
+                                                raft::distance::DistanceType::L2Expanded,
+                                                true);
+  rmm::device_uvector<int> probe_ids(static_cast<std::size_t>(n_queries) * n_probes, stream);
+  rmm::device_uvector<float> probe_dists(probe_ids.size(), stream);
+  knn::detail::topk::warp_sort_topk<float, int>(coarse_dists.data(),
+                                                nullptr,
+                                                n_queries,
+                                                idx.n_lists,
+                                                n_probes,
+                                                probe_dists.data(),
+                                                probe_ids.data(),
+                                                true,
+                                                stream);
+
+  // candidate buffer layout
+  rmm::device_uvector<IdxT> cand_offsets(probe_ids.size(), stream);
+  rmm::device_uvector<IdxT> cand_totals(n_queries, stream);
+  ivf_flat::detail::
+    candidateOffsetsKernel<<<raft::ceildiv<uint32_t>(n_queries, 128), 128, 0, stream>>>(
+      cand_offsets.data(),
+      cand_totals.data(),
+      probe_ids.data(),
+      idx.list_offsets.data(),
+      n_queries,
+      n_probes);
+  RAFT_CUDA_TRY(cudaGetLastError());
+  IdxT max_cand = thrust::reduce(rmm::exec_policy(stream),
+                                 cand_totals.data(),
+                                 cand_totals.data() + n_queries,
+                                 IdxT(0),
+                                 thrust::maximum<IdxT>());
+  max_cand      = std::max<IdxT>(max_cand, k);
+
+  rmm::device_uvector<float> cand_dists(static_cast<std::size_t>(n_queries) * max_cand, stream);
+  rmm::device_uvector<IdxT> cand_inds(cand_dists.size(), stream);
+  thrust::fill(rmm::exec_policy(stream),
+               cand_dists.data(),
+               cand_dists.data() + cand_dists.size(),
+               raft::upper_bound<float>());
+  thrust::fill(
+    rmm::exec_policy(stream), cand_inds.data(), cand_inds.data() + cand_inds.size(), IdxT(-1));
+
+  dim3 grid(n_queries, n_probes);
+  ivfPqScanKernel<IdxT><<<grid, 128, smem_size, stream>>>(cand_dists.data(),
+                                                          cand_inds.data(),
+                                                          queries,
+                                                          idx.centers.data(),
+                                                          idx.pq_centers.data(),
+                                                          idx.codes.data(),
+                                                          idx.indices.data(),
+                                                          idx.list_offsets.data(),
+                                                          probe_ids.data(),
+                                                          cand_offsets.data(),
+                                                          n_probes,
+                                                          idx.dim,
+                                                          idx.pq_dim,
+                                                          idx.sub_dim,
+                                                          max_cand);
+  RAFT_CUDA_TRY(cudaGetLastError());
+
+  knn::detail::topk::warp_sort_topk<float, IdxT>(cand_dists.data(),
+                                                 cand_inds.data(),
+                                                 n_queries,
+                                                 max_cand,
+                                                 k,
+                                                 distances,
+                                                 neighbors,
+                                                 true,
+                                                 stream);
+
+  if (idx.metric == raft::distance::DistanceType::L2SqrtExpanded ||
+      idx.metric == raft::distance::DistanceType::L2SqrtUnexpanded) {
+    raft::linalg::unaryOp<float>(
+      distances,
+      distances,
+      static_cast<std::size_t>(n_queries) * k,
+      [] __device__(float in) { return raft::mySqrt(in); },
+      stream);
+  }
+}
+
+}  // namespace detail
+}  // namespace ivf_pq
+}  // namespace knn
+}  // namespace spatial
+}  // namespace raft
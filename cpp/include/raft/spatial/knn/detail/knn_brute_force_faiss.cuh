@@ -28,17 +28,24 @@
 #include <faiss/gpu/utils/Select.cuh>
 #include <faiss/utils/Heap.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <iostream>
+#include <limits>
+#include <raft/core/bitset.cuh>
+#include <raft/distance/distance.cuh>
 #include <raft/distance/distance_type.hpp>
+#include <raft/core/event_pool.hpp>
 #include <raft/handle.hpp>
 #include <raft/spatial/knn/faiss_mr.hpp>
 #include <set>
+#include <vector>
 #include <thrust/iterator/transform_iterator.h>
 
 #include "fused_l2_knn.cuh"
 #include "haversine_distance.cuh"
 #include "processing.hpp"
+#include "topk/warpsort_topk.cuh"
 
 #include "common_faiss.h"
 
@@ -120,6 +127,68 @@ __global__ void knn_merge_parts_kernel(value_t* inK,
   }
 }
 
+/**
+ * Merge-parts on the native warpsort queues: one block per sample row, each
+ * warp feeding its share of the n_parts * k candidates into a queue sized to
+ * k at compile time, with the per-warp results tree-merged in shared memory.
+ * Replaces the faiss block-select kernel above for k within the warpsort
+ * capacity; the faiss path remains only for the large-k tail.
+ */
+template <typename value_idx, typename value_t, int capacity, int tpb = 128>
+__global__ void knn_merge_parts_warpsort_kernel(const value_t* inK,
+                                                const value_idx* inV,
+                                                value_t* outK,
+                                                value_idx* outV,
+                                                size_t n_samples,
+                                                int n_parts,
+                                                int k,
+                                                const value_idx* translations)
+{
+  using queue_t = topk::warp_sort_filtered<capacity, true, value_t, value_idx>;
+  extern __shared__ __align__(256) uint8_t smem_buf[];
+  topk::block_sort<topk::warp_sort_filtered, capacity, true, value_t, value_idx> queue(k, smem_buf);
+
+  const size_t row     = blockIdx.x;
+  const size_t total_k = size_t(n_parts) * k;
+
+  // pad the scan past the end so every thread of a warp keeps participating
+  // in the (warp-uniform) queue operations; dummy values are never selected
+  const size_t per_thread_lim = total_k + laneId();
+  for (size_t i = threadIdx.x; i < per_thread_lim; i += tpb) {
+    value_t key   = queue_t::kDummy;
+    value_idx val = 0;
+    if (i < total_k) {
+      const int part   = int(i / k);
+      const size_t idx = (part * n_samples + row) * k + (i % k);
+      key              = inK[idx];
+      val              = inV[idx] + translations[part];
+    }
+    queue.add(key, val);
+  }
+  queue.done();
+  queue.store(outK + row * k, outV + row * k);
+}
+
+template <typename value_idx = std::int64_t, typename value_t = float, int capacity>
+inline void knn_merge_parts_warpsort(const value_t* inK,
+                                     const value_idx* inV,
+                                     value_t* outK,
+                                     value_idx* outV,
+                                     size_t n_samples,
+                                     int n_parts,
+                                     int k,
+                                     cudaStream_t stream,
+                                     const value_idx* translations)
+{
+  constexpr int tpb     = 128;
+  const int num_of_warp = tpb / std::min(capacity, int(raft::WarpSize));
+  const int smem_size   = topk::calc_smem_size_for_block_wide<value_t, value_idx>(num_of_warp, k);
+  knn_merge_parts_warpsort_kernel<value_idx, value_t, capacity, tpb>
+    <<<n_samples, tpb, smem_size, stream>>>(
+      inK, inV, outK, outV, n_samples, n_parts, k, translations);
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
+}
+
 template <typename value_idx = std::int64_t, typename value_t = float, int warp_q, int thread_q>
 inline void knn_merge_parts_impl(value_t* inK,
                                  value_idx* inV,
@@ -169,22 +238,24 @@ inline void knn_merge_parts(value_t* inK,
                             cudaStream_t stream,
                             value_idx* translations)
 {
-  if (k == 1)
-    knn_merge_parts_impl<value_idx, value_t, 1, 1>(
-      inK, inV, outK, outV, n_samples, n_parts, k, stream, translations);
-  else if (k <= 32)
-    knn_merge_parts_impl<value_idx, value_t, 32, 2>(
-      inK, inV, outK, outV, n_samples, n_parts, k, stream, translations);
-  else if (k <= 64)
-    knn_merge_parts_impl<value_idx, value_t, 64, 3>(
-      inK, inV, outK, outV, n_samples, n_parts, k, stream, translations);
-  else if (k <= 128)
-    knn_merge_parts_impl<value_idx, value_t, 128, 3>(
-      inK, inV, outK, outV, n_samples, n_parts, k, stream, translations);
-  else if (k <= 256)
-    knn_merge_parts_impl<value_idx, value_t, 256, 4>(
-      inK, inV, outK, outV, n_samples, n_parts, k, stream, translations);
-  else if (k <= 512)
+  // capacities below one warp still work but bring no extra benefit here
+  const int capacity = std::max(int(raft::WarpSize), topk::calc_capacity(k));
+  switch (capacity) {
+    case 32:
+      return knn_merge_parts_warpsort<value_idx, value_t, 32>(
+        inK, inV, outK, outV, n_samples, n_parts, k, stream, translations);
+    case 64:
+      return knn_merge_parts_warpsort<value_idx, value_t, 64>(
+        inK, inV, outK, outV, n_samples, n_parts, k, stream, translations);
+    case 128:
+      return knn_merge_parts_warpsort<value_idx, value_t, 128>(
+        inK, inV, outK, outV, n_samples, n_parts, k, stream, translations);
+    case 256:
+      return knn_merge_parts_warpsort<value_idx, value_t, 256>(
+        inK, inV, outK, outV, n_samples, n_parts, k, stream, translations);
+    default: break;  // k too large for the warpsort queues: faiss block select
+  }
+  if (k <= 512)
     knn_merge_parts_impl<value_idx, value_t, 512, 8>(
       inK, inV, outK, outV, n_samples, n_parts, k, stream, translations);
   else if (k <= 1024)
@@ -215,6 +286,14 @@ inline void knn_merge_parts(value_t* inK,
  *        non-contiguous partitions
  * @param[in] metric corresponds to the raft::distance::DistanceType enum (default is L2Expanded)
  * @param[in] metricArg metric argument to use. Corresponds to the p arg for lp norm
+ * @param[in] indexPrenormalized the index partitions have already been transformed
+ *        by the metric preprocessing (cf. prepare_brute_force_index), so the
+ *        per-call index normalization pass and its revert are skipped. Queries
+ *        are still preprocessed every call.
+ * @param[in] lane execution lane hint. `HIGH_PRIORITY` keeps the whole search
+ *        on the handle's greatest-priority stream; the default-priority
+ *        stream pool is not used for partition fan-out in that case, as its
+ *        streams would queue behind any batch work already occupying them.
  */
 template <typename IntType = int, typename IdxType = std::int64_t, typename value_t = float>
 void brute_force_knn_impl(
@@ -231,9 +310,12 @@ void brute_force_knn_impl(
   bool rowMajorQuery                  = true,
   std::vector<IdxType>* translations  = nullptr,
   raft::distance::DistanceType metric = raft::distance::DistanceType::L2Expanded,
-  float metricArg                     = 0)
+  float metricArg                     = 0,
+  bool indexPrenormalized             = false,
+  raft::execution_lane lane           = raft::execution_lane::DEFAULT)
 {
-  auto userStream = handle.get_stream();
+  auto userStream = handle.get_execution_stream(lane);
+  bool use_pool   = lane == raft::execution_lane::DEFAULT;
 
   ASSERT(input.size() == sizes.size(), "input and sizes vectors should be the same size");
 
@@ -260,8 +342,15 @@ void brute_force_knn_impl(
 
   std::vector<std::unique_ptr<MetricProcessor<value_t>>> metric_processors(input.size());
   for (size_t i = 0; i < input.size(); i++) {
-    metric_processors[i] =
-      create_processor<value_t>(metric, sizes[i], D, k, rowMajorQuery, userStream);
+    if (indexPrenormalized) {
+      // the partitions were already transformed once by
+      // prepare_brute_force_index; a no-op processor skips the per-call
+      // normalization pass (and its revert) over the whole index
+      metric_processors[i] = std::make_unique<DefaultMetricProcessor<value_t>>();
+    } else {
+      metric_processors[i] =
+        create_processor<value_t>(metric, sizes[i], D, k, rowMajorQuery, userStream);
+    }
     metric_processors[i]->preprocess(input[i]);
   }
 
@@ -286,19 +375,24 @@ void brute_force_knn_impl(
   }
 
   // Make other streams from pool wait on main stream
-  handle.wait_stream_pool_on_stream();
+  if (use_pool) { handle.wait_stream_pool_on_stream(); }
 
   for (size_t i = 0; i < input.size(); i++) {
     value_t* out_d_ptr = out_D + (i * k * n);
     IdxType* out_i_ptr = out_I + (i * k * n);
 
-    auto stream = handle.get_next_usable_stream(i);
+    auto stream = use_pool ? handle.get_next_usable_stream(i) : userStream;
 
-    if (k <= 64 && rowMajorQuery == rowMajorIndex && rowMajorQuery == true &&
+    // the cosine inputs were L2-normalized by the metric processors above, so
+    // the fused dot-product core yields the cosine similarity directly and the
+    // processor's postprocess converts it to a distance
+    if (k <= fusedL2KnnMaxK() && rowMajorQuery == rowMajorIndex && rowMajorQuery == true &&
         (metric == raft::distance::DistanceType::L2Unexpanded ||
          metric == raft::distance::DistanceType::L2SqrtUnexpanded ||
          metric == raft::distance::DistanceType::L2Expanded ||
-         metric == raft::distance::DistanceType::L2SqrtExpanded)) {
+         metric == raft::distance::DistanceType::L2SqrtExpanded ||
+         metric == raft::distance::DistanceType::InnerProduct ||
+         metric == raft::distance::DistanceType::CosineExpanded)) {
       fusedL2Knn(D,
                  out_i_ptr,
                  out_d_ptr,
@@ -360,7 +454,7 @@ void brute_force_knn_impl(
   // Sync internal streams if used. We don't need to
   // sync the user stream because we'll already have
   // fully serial execution.
-  handle.sync_stream_pool();
+  if (use_pool) { handle.sync_stream_pool(); }
 
   if (input.size() > 1 || translations != nullptr) {
     // This is necessary for proper index translations. If there are
@@ -394,6 +488,266 @@ void brute_force_knn_impl(
   if (translations == nullptr) delete id_ranges;
 };
 
+/**
+ * @brief Streaming brute-force knn over a host-resident index.
+ *
+ * The index rows live in host memory (pinned memory strongly recommended) and
+ * are tiled to the device in fixed-size chunks: while the distance + select
+ * of chunk i runs on the handle's main stream, chunk i+1 is copied H2D on a
+ * pool stream, overlapping the PCIe transfer with the compute. A running
+ * top-k per query is maintained by merging each chunk's selection through
+ * `knn_merge_parts`, so device memory is bounded by the chunk size rather
+ * than the index size. Without a stream pool on the handle the search still
+ * works, just without the copy/compute overlap.
+ *
+ * Only metrics where smaller is better are supported (i.e. every pairwise
+ * distance except InnerProduct); distances are returned exactly as
+ * `raft::distance::pairwise_distance` computes them for the given metric.
+ *
+ * @param[in] handle the cuml handle to use
+ * @param[in] host_index the index rows in host memory (size n_index_rows * D)
+ * @param[in] n_index_rows number of rows in the host index
+ * @param[in] D dimensionality
+ * @param[in] search_items device array of query rows (size n * D)
+ * @param[in] n number of queries
+ * @param[out] res_I the resulting index array of size n * k
+ * @param[out] res_D the resulting distance array of size n * k
+ * @param[in] k the number of nearest neighbors to return
+ * @param[in] metric distance metric to use
+ * @param[in] metricArg the value of `p` for Minkowski (l-p) distances
+ * @param[in] chunk_rows index rows per device tile; a final remainder shorter
+ *            than k is folded into the last tile
+ */
+template <typename IntType = int, typename IdxType = std::int64_t, typename value_t = float>
+void brute_force_knn_host_impl(
+  const raft::handle_t& handle,
+  const value_t* host_index,
+  IdxType n_index_rows,
+  IntType D,
+  const value_t* search_items,
+  IntType n,
+  IdxType* res_I,
+  value_t* res_D,
+  IntType k,
+  raft::distance::DistanceType metric = raft::distance::DistanceType::L2Expanded,
+  float metricArg                     = 2.0f,
+  IdxType chunk_rows                  = 65536)
+{
+  auto stream      = handle.get_stream();
+  auto copy_stream = handle.get_next_usable_stream(0);
+
+  ASSERT(metric != raft::distance::DistanceType::InnerProduct,
+         "brute_force_knn_host_impl supports distance metrics only");
+  ASSERT(IdxType(k) <= n_index_rows, "k must not exceed the index size");
+  chunk_rows = std::min(std::max(chunk_rows, IdxType(k)), n_index_rows);
+
+  int n_chunks = 1;
+  if (n_index_rows > chunk_rows) {
+    n_chunks = int(n_index_rows / chunk_rows);
+    if (n_index_rows % chunk_rows >= IdxType(k)) { n_chunks++; }
+  }
+
+  // double-buffered device tiles (the last tile may absorb a short remainder)
+  const size_t tile_elems = size_t(chunk_rows + k) * D;
+  rmm::device_uvector<value_t> tile_a(tile_elems, stream);
+  rmm::device_uvector<value_t> tile_b(tile_elems, stream);
+  value_t* tiles[2] = {tile_a.data(), tile_b.data()};
+
+  rmm::device_uvector<value_t> dist(size_t(n) * (chunk_rows + k), stream);
+  rmm::device_uvector<value_t> pair_D(0, stream);
+  rmm::device_uvector<IdxType> pair_I(0, stream);
+  rmm::device_uvector<value_t> merged_D(0, stream);
+  rmm::device_uvector<IdxType> merged_I(0, stream);
+  rmm::device_uvector<IdxType> trans(0, stream);
+  std::vector<IdxType> h_trans;
+  if (n_chunks > 1) {
+    pair_D.resize(2 * size_t(k) * n, stream);
+    pair_I.resize(pair_D.size(), stream);
+    merged_D.resize(size_t(k) * n, stream);
+    merged_I.resize(merged_D.size(), stream);
+    // the running result (slot 0) already carries global ids; only the fresh
+    // chunk (slot 1) needs its local ids shifted by the chunk start
+    for (int c = 1; c < n_chunks; c++) {
+      h_trans.push_back(0);
+      h_trans.push_back(IdxType(c) * chunk_rows);
+    }
+    trans.resize(h_trans.size(), stream);
+    raft::update_device(trans.data(), h_trans.data(), h_trans.size(), stream);
+  }
+
+  // checked out of the handle's pool instead of created per call; event
+  // creation takes the driver lock and this path is called in tight loops
+  auto& event_pool = handle.get_event_pool();
+  pooled_event copy_done[2]    = {pooled_event(event_pool), pooled_event(event_pool)};
+  pooled_event compute_done[2] = {pooled_event(event_pool), pooled_event(event_pool)};
+
+  for (int c = 0; c < n_chunks; c++) {
+    const int b        = c & 1;
+    const IdxType start = IdxType(c) * chunk_rows;
+    const IdxType rows  = c + 1 == n_chunks ? n_index_rows - start : chunk_rows;
+
+    // don't overwrite a tile while the compute still reading it is in flight
+    if (c >= 2) { RAFT_CUDA_TRY(cudaStreamWaitEvent(copy_stream, compute_done[b], 0)); }
+    RAFT_CUDA_TRY(cudaMemcpyAsync(tiles[b],
+                                  host_index + size_t(start) * D,
+                                  size_t(rows) * D * sizeof(value_t),
+                                  cudaMemcpyHostToDevice,
+                                  copy_stream));
+    RAFT_CUDA_TRY(cudaEventRecord(copy_done[b], copy_stream));
+    RAFT_CUDA_TRY(cudaStreamWaitEvent(stream, copy_done[b], 0));
+
+    raft::distance::pairwise_distance<value_t, IntType>(handle,
+                                                        search_items,
+                                                        tiles[b],
+                                                        dist.data(),
+                                                        n,
+                                                        IntType(rows),
+                                                        D,
+                                                        metric,
+                                                        true,
+                                                        metricArg);
+
+    // chunk 0 selects straight into the running (or final) result; later
+    // chunks select into the second slot of the pair buffer and get merged
+    value_t* out_D = n_chunks == 1 ? res_D : pair_D.data() + (c == 0 ? 0 : size_t(k) * n);
+    IdxType* out_I = n_chunks == 1 ? res_I : pair_I.data() + (c == 0 ? 0 : size_t(k) * n);
+    select_k<IdxType, value_t>(dist.data(), nullptr, n, rows, out_D, out_I, true, k, stream);
+
+    if (c > 0) {
+      knn_merge_parts(pair_D.data(),
+                      pair_I.data(),
+                      merged_D.data(),
+                      merged_I.data(),
+                      size_t(n),
+                      2,
+                      k,
+                      stream,
+                      trans.data() + 2 * (c - 1));
+      raft::copy(pair_D.data(), merged_D.data(), size_t(k) * n, stream);
+      raft::copy(pair_I.data(), merged_I.data(), size_t(k) * n, stream);
+    }
+    RAFT_CUDA_TRY(cudaEventRecord(compute_done[b], stream));
+  }
+
+  if (n_chunks > 1) {
+    raft::copy(res_D, pair_D.data(), size_t(k) * n, stream);
+    raft::copy(res_I, pair_I.data(), size_t(k) * n, stream);
+  }
+
+  // the translation staging vector and the caller's host index must outlive
+  // the work queued above, so finish it before returning
+  RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+}
+
+/**
+ * Brute force knn over a device-resident index filtered by a bitset. The
+ * index rows are tiled, the mask is tested in the distance kernel epilogue
+ * (masked rows come out at the max-distance sentinel, so select_k never picks
+ * them over a live candidate) and the per-tile top-k are merged into a
+ * running result. No compacted copy of the index is ever materialized.
+ */
+template <typename IdxType = std::int64_t, typename value_t = float, typename IntType = int>
+void brute_force_knn_masked_impl(
+  const raft::handle_t& handle,
+  const value_t* index,
+  IdxType n_index_rows,
+  IntType D,
+  const value_t* search_items,
+  IntType n,
+  raft::core::bitset_view<std::uint32_t> mask,
+  IdxType* res_I,
+  value_t* res_D,
+  IntType k,
+  raft::distance::DistanceType metric = raft::distance::DistanceType::L2Expanded,
+  float metricArg                     = 2.0f,
+  IdxType chunk_rows                  = 65536)
+{
+  auto stream = handle.get_stream();
+
+  ASSERT(metric != raft::distance::DistanceType::InnerProduct,
+         "brute_force_knn_masked_impl supports distance metrics only");
+  ASSERT(IdxType(k) <= n_index_rows, "k must not exceed the index size");
+  ASSERT(mask.size() >= std::uint32_t(n_index_rows), "mask must cover every index row");
+  chunk_rows = std::min(std::max(chunk_rows, IdxType(k)), n_index_rows);
+
+  int n_chunks = 1;
+  if (n_index_rows > chunk_rows) {
+    n_chunks = int(n_index_rows / chunk_rows);
+    if (n_index_rows % chunk_rows >= IdxType(k)) { n_chunks++; }
+  }
+
+  // the last tile may absorb a short remainder, same as the host-tiled path
+  rmm::device_uvector<value_t> dist(size_t(n) * (chunk_rows + k), stream);
+  rmm::device_uvector<char> workspace(0, stream);
+  rmm::device_uvector<value_t> pair_D(0, stream);
+  rmm::device_uvector<IdxType> pair_I(0, stream);
+  rmm::device_uvector<value_t> merged_D(0, stream);
+  rmm::device_uvector<IdxType> merged_I(0, stream);
+  rmm::device_uvector<IdxType> trans(0, stream);
+  std::vector<IdxType> h_trans;
+  if (n_chunks > 1) {
+    pair_D.resize(2 * size_t(k) * n, stream);
+    pair_I.resize(pair_D.size(), stream);
+    merged_D.resize(size_t(k) * n, stream);
+    merged_I.resize(merged_D.size(), stream);
+    // the running result (slot 0) already carries global ids; only the fresh
+    // chunk (slot 1) needs its local ids shifted by the chunk start
+    for (int c = 1; c < n_chunks; c++) {
+      h_trans.push_back(0);
+      h_trans.push_back(IdxType(c) * chunk_rows);
+    }
+    trans.resize(h_trans.size(), stream);
+    raft::update_device(trans.data(), h_trans.data(), h_trans.size(), stream);
+  }
+
+  for (int c = 0; c < n_chunks; c++) {
+    const IdxType start = IdxType(c) * chunk_rows;
+    const IdxType rows  = c + 1 == n_chunks ? n_index_rows - start : chunk_rows;
+
+    // the epilogue offset shifts the tested bit by the chunk start, so one
+    // mask over the full index is reused across all tiles
+    raft::distance::bitset_mask_epilogue<value_t, IntType> fin_op{
+      mask, IntType(rows), std::numeric_limits<value_t>::max(), IntType(start)};
+    raft::distance::pairwise_distance<value_t, decltype(fin_op), IntType>(handle,
+                                                                          search_items,
+                                                                          index + size_t(start) * D,
+                                                                          dist.data(),
+                                                                          n,
+                                                                          IntType(rows),
+                                                                          D,
+                                                                          workspace,
+                                                                          metric,
+                                                                          fin_op,
+                                                                          true,
+                                                                          metricArg);
+
+    value_t* out_D = n_chunks == 1 ? res_D : pair_D.data() + (c == 0 ? 0 : size_t(k) * n);
+    IdxType* out_I = n_chunks == 1 ? res_I : pair_I.data() + (c == 0 ? 0 : size_t(k) * n);
+    select_k<IdxType, value_t>(dist.data(), nullptr, n, rows, out_D, out_I, true, k, stream);
+
+    if (c > 0) {
+      knn_merge_parts(pair_D.data(),
+                      pair_I.data(),
+                      merged_D.data(),
+                      merged_I.data(),
+                      size_t(n),
+                      2,
+                      k,
+                      stream,
+                      trans.data() + 2 * (c - 1));
+      raft::copy(pair_D.data(), merged_D.data(), size_t(k) * n, stream);
+      raft::copy(pair_I.data(), merged_I.data(), size_t(k) * n, stream);
+    }
+  }
+
+  if (n_chunks > 1) {
+    raft::copy(res_D, pair_D.data(), size_t(k) * n, stream);
+    raft::copy(res_I, pair_I.data(), size_t(k) * n, stream);
+    // the translation staging vector must outlive the work queued above
+    RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+  }
+}
+
 }  // namespace detail
 }  // namespace knn
 }  // namespace spatial
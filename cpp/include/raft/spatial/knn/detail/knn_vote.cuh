@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cub/cub.cuh>
+
+#include <raft/cuda_utils.cuh>
+#include <raft/cudart_utils.h>
+
+namespace raft {
+namespace spatial {
+namespace knn {
+namespace detail {
+
+/** Index of `val` in the sorted array `arr` of length `n` (binary search). */
+template <typename label_t>
+DI int findLabelIndex(const label_t* arr, int n, label_t val)
+{
+  int lo = 0, hi = n - 1;
+  while (lo < hi) {
+    const int mid = (lo + hi) >> 1;
+    if (arr[mid] < val) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+/** Inverse-distance vote weight; clamped so exact duplicates dominate. */
+template <typename value_t>
+DI value_t voteWeight(value_t dist, bool weighted)
+{
+  return weighted ? value_t(1) / raft::myMax<value_t>(dist, value_t(1e-8)) : value_t(1);
+}
+
+/**
+ * One block per query row: gathers the neighbor labels, accumulates the
+ * (optionally distance-weighted) votes in a shared-memory histogram and
+ * writes the majority label. Ties resolve to the smallest class index so the
+ * result is deterministic.
+ */
+template <typename value_idx, typename value_t, typename label_t, int tpb>
+__global__ void knnClassifyKernel(label_t* out,
+                                  const value_idx* knn_indices,
+                                  const value_t* knn_dists,
+                                  const label_t* y,
+                                  const label_t* unique_labels,
+                                  int n_unique,
+                                  size_t n_query_rows,
+                                  int k,
+                                  bool weighted)
+{
+  extern __shared__ char smem[];
+  auto* sh_labels = reinterpret_cast<label_t*>(smem);
+  auto* sh_votes  = reinterpret_cast<float*>(sh_labels + n_unique);
+
+  const size_t row = blockIdx.x;
+  if (row >= n_query_rows) { return; }
+
+  for (int c = threadIdx.x; c < n_unique; c += tpb) {
+    sh_labels[c] = unique_labels[c];
+    sh_votes[c]  = 0.f;
+  }
+  __syncthreads();
+
+  for (int j = threadIdx.x; j < k; j += tpb) {
+    const value_idx idx = knn_indices[row * k + j];
+    const float w       = voteWeight(float(knn_dists[row * k + j]), weighted);
+    atomicAdd(sh_votes + findLabelIndex(sh_labels, n_unique, y[idx]), w);
+  }
+  __syncthreads();
+
+  cub::KeyValuePair<int, float> best(0, -1.f);
+  for (int c = threadIdx.x; c < n_unique; c += tpb) {
+    if (sh_votes[c] > best.value) {
+      best.key   = c;
+      best.value = sh_votes[c];
+    }
+  }
+  auto argmax_op = [](const cub::KeyValuePair<int, float>& a,
+                      const cub::KeyValuePair<int, float>& b) {
+    if (b.value > a.value || (b.value == a.value && b.key < a.key)) { return b; }
+    return a;
+  };
+  typedef cub::BlockReduce<cub::KeyValuePair<int, float>, tpb> BlockReduce;
+  __shared__ typename BlockReduce::TempStorage temp;
+  best = BlockReduce(temp).Reduce(best, argmax_op);
+  if (threadIdx.x == 0) { out[row] = sh_labels[best.key]; }
+}
+
+/**
+ * One warp per query row: gathers the neighbor targets and reduces the
+ * (optionally distance-weighted) mean across the warp.
+ */
+template <typename value_idx, typename value_t, int tpb>
+__global__ void knnRegressKernel(value_t* out,
+                                 const value_idx* knn_indices,
+                                 const value_t* knn_dists,
+                                 const value_t* y,
+                                 size_t n_query_rows,
+                                 int k,
+                                 bool weighted)
+{
+  const size_t row =
+    size_t(blockIdx.x) * (tpb / raft::WarpSize) + (threadIdx.x / raft::WarpSize);
+  if (row >= n_query_rows) { return; }
+  const int lid = raft::laneId();
+
+  value_t sum_wy = 0, sum_w = 0;
+  for (int j = lid; j < k; j += raft::WarpSize) {
+    const value_idx idx = knn_indices[row * k + j];
+    const value_t w     = voteWeight(knn_dists[row * k + j], weighted);
+    sum_wy += w * y[idx];
+    sum_w += w;
+  }
+  sum_wy = raft::warpReduce(sum_wy);
+  sum_w  = raft::warpReduce(sum_w);
+  if (lid == 0) { out[row] = sum_wy / sum_w; }
+}
+
+template <typename value_idx, typename value_t, typename label_t>
+void knn_classify(label_t* out,
+                  const value_idx* knn_indices,
+                  const value_t* knn_dists,
+                  const label_t* y,
+                  const label_t* unique_labels,
+                  int n_unique,
+                  size_t n_query_rows,
+                  int k,
+                  bool weighted,
+                  cudaStream_t stream)
+{
+  constexpr int tpb    = 128;
+  const size_t smem    = size_t(n_unique) * (sizeof(label_t) + sizeof(float));
+  RAFT_EXPECTS(smem <= 48 * 1024,
+               "knn_classify: too many unique labels for the shared-memory histogram");
+  knnClassifyKernel<value_idx, value_t, label_t, tpb>
+    <<<n_query_rows, tpb, smem, stream>>>(
+      out, knn_indices, knn_dists, y, unique_labels, n_unique, n_query_rows, k, weighted);
+  RAFT_CUDA_TRY(cudaGetLastError());
+}
+
+template <typename value_idx, typename value_t>
+void knn_regress(value_t* out,
+                 const value_idx* knn_indices,
+                 const value_t* knn_dists,
+                 const value_t* y,
+                 size_t n_query_rows,
+                 int k,
+                 bool weighted,
+                 cudaStream_t stream)
+{
+  constexpr int tpb           = 128;
+  constexpr int rows_per_blk  = tpb / raft::WarpSize;
+  const size_t grid           = raft::ceildiv<size_t>(n_query_rows, rows_per_blk);
+  knnRegressKernel<value_idx, value_t, tpb>
+    <<<grid, tpb, 0, stream>>>(out, knn_indices, knn_dists, y, n_query_rows, k, weighted);
+  RAFT_CUDA_TRY(cudaGetLastError());
+}
+
+}  // namespace detail
+}  // namespace knn
+}  // namespace spatial
+}  // namespace raft
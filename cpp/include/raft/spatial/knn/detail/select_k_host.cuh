@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/cudart_utils.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+namespace raft {
+namespace spatial {
+namespace knn {
+namespace detail {
+
+/**
+ * Host execution of select_k for microseconds-scale inputs, where kernel
+ * launch + sync overhead exceeds a per-row std::partial_sort on the CPU.
+ * The inputs are pulled to the host, rows are processed in parallel with
+ * OpenMP, and the selection is pushed back; the call blocks until the
+ * outputs are valid on device. Result: sorted and stable.
+ */
+template <typename value_t, typename idx_t>
+void select_k_host(const value_t* in_keys,
+                   const idx_t* in_values,
+                   size_t n_inputs,
+                   size_t input_len,
+                   value_t* out_keys,
+                   idx_t* out_values,
+                   bool select_min,
+                   int k,
+                   cudaStream_t stream)
+{
+  std::vector<value_t> h_keys(n_inputs * input_len);
+  raft::update_host(h_keys.data(), in_keys, h_keys.size(), stream);
+
+  std::vector<idx_t> h_values;
+  if (in_values != nullptr) {
+    h_values.resize(n_inputs * input_len);
+    raft::update_host(h_values.data(), in_values, h_values.size(), stream);
+  }
+  RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+
+  std::vector<value_t> h_out_keys(n_inputs * k);
+  std::vector<idx_t> h_out_values(n_inputs * k);
+
+#if defined(_OPENMP)
+#pragma omp parallel for
+#endif
+  for (std::ptrdiff_t i = 0; i < (std::ptrdiff_t)n_inputs; i++) {
+    const value_t* row = h_keys.data() + i * input_len;
+
+    std::vector<idx_t> order(input_len);
+    std::iota(order.begin(), order.end(), (idx_t)0);
+    std::partial_sort(order.begin(), order.begin() + k, order.end(), [&](idx_t a, idx_t b) {
+      if (row[a] != row[b]) { return select_min ? row[a] < row[b] : row[a] > row[b]; }
+      return a < b;  // stable on ties
+    });
+
+    for (int j = 0; j < k; j++) {
+      h_out_keys[i * k + j] = row[order[j]];
+      h_out_values[i * k + j] =
+        in_values != nullptr ? h_values[i * input_len + order[j]] : order[j];
+    }
+  }
+
+  raft::update_device(out_keys, h_out_keys.data(), h_out_keys.size(), stream);
+  raft::update_device(out_values, h_out_values.data(), h_out_values.size(), stream);
+  RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+}
+
+};  // namespace detail
+};  // namespace knn
+};  // namespace spatial
+};  // namespace raft
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include "topk/warpsort_topk.cuh"
+
 #include <raft/cudart_utils.h>
 #include <raft/pow2_utils.cuh>
 #include <raft/spatial/knn/faiss_mr.hpp>
@@ -118,6 +120,11 @@ inline void select_k_impl(const key_t* inK,
  * @brief Select the k-nearest neighbors from dense
  * distance and index matrices.
  *
+ * For k within the native warpsort capacity (256) the selection runs on the
+ * raft warpsort kernels, which benchmark faster than faiss block-select there
+ * (see bench/spatial/selection.cu) and avoid instantiating the faiss header
+ * tree; the faiss kernel remains only for the large-k tail it alone supports.
+ *
  * @param[in] inK partitioned knn distance matrix
  * @param[in] inV partitioned knn index matrix
  * @param[in] n_rows number of rows in distance and index matrices
@@ -140,21 +147,9 @@ inline void select_k(const key_t* inK,
                      cudaStream_t stream)
 {
   constexpr int max_k = kFaissMaxK<payload_t, key_t>();
-  if (k == 1)
-    select_k_impl<payload_t, key_t, 1, 1>(
-      inK, inV, n_rows, n_cols, outK, outV, select_min, k, stream);
-  else if (k <= 32)
-    select_k_impl<payload_t, key_t, 32, 2>(
-      inK, inV, n_rows, n_cols, outK, outV, select_min, k, stream);
-  else if (k <= 64)
-    select_k_impl<payload_t, key_t, 64, 3>(
-      inK, inV, n_rows, n_cols, outK, outV, select_min, k, stream);
-  else if (k <= 128)
-    select_k_impl<payload_t, key_t, 128, 3>(
-      inK, inV, n_rows, n_cols, outK, outV, select_min, k, stream);
-  else if (k <= 256)
-    select_k_impl<payload_t, key_t, 256, 4>(
-      inK, inV, n_rows, n_cols, outK, outV, select_min, k, stream);
+  if (k <= topk::kMaxCapacity)
+    topk::warp_sort_topk<key_t, payload_t>(
+      inK, inV, n_rows, n_cols, k, outK, outV, select_min, stream);
   else if (k <= 512)
     select_k_impl<payload_t, key_t, 512, 8>(
       inK, inV, n_rows, n_cols, outK, outV, select_min, k, stream);
@@ -0,0 +1,478 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "ivf_flat.cuh"
+#include "knn_brute_force_faiss.cuh"
+#include "selection_faiss.cuh"
+
+#include <raft/cuda_utils.cuh>
+#include <raft/distance/distance.cuh>
+#include <raft/distance/distance_type.hpp>
+#include <raft/handle.hpp>
+#include <raft/linalg/unary_op.cuh>
+#include <raft/spatial/knn/sq8_types.hpp>
+
+#include <rmm/device_uvector.hpp>
+#include <rmm/exec_policy.hpp>
+
+#include <thrust/fill.h>
+#include <thrust/reduce.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace raft {
+namespace spatial {
+namespace knn {
+namespace sq8 {
+namespace detail {
+
+/**
+ * Trains the quantizer: per-dimension minimum and quantization step over a
+ * row-major dataset. One block per dimension, threads striding the rows.
+ */
+template <typename IdxT, int tpb = 256>
+__global__ void sq8TrainKernel(
+  float* vmin, float* scale, const float* dataset, IdxT n_rows, uint32_t dim)
+{
+  __shared__ float smin[tpb];
+  __shared__ float smax[tpb];
+  const uint32_t j = blockIdx.x;
+
+  float lo = raft::upper_bound<float>();
+  float hi = raft::lower_bound<float>();
+  for (IdxT i = threadIdx.x; i < n_rows; i += tpb) {
+    const float v = dataset[i * dim + j];
+    lo            = raft::myMin(lo, v);
+    hi            = raft::myMax(hi, v);
+  }
+  smin[threadIdx.x] = lo;
+  smax[threadIdx.x] = hi;
+  __syncthreads();
+  for (int offset = tpb / 2; offset > 0; offset >>= 1) {
+    if (threadIdx.x < uint32_t(offset)) {
+      smin[threadIdx.x] = raft::myMin(smin[threadIdx.x], smin[threadIdx.x + offset]);
+      smax[threadIdx.x] = raft::myMax(smax[threadIdx.x], smax[threadIdx.x + offset]);
+    }
+    __syncthreads();
+  }
+  if (threadIdx.x == 0) {
+    const float span = smax[0] - smin[0];
+    vmin[j]          = smin[0];
+    // a constant dimension maps every value to code 0; any non-zero step does
+    scale[j] = span > 0 ? span / 255.0f : 1.0f;
+  }
+}
+
+/** Elementwise affine quantization of a row-major dataset to uint8 codes. */
+template <typename IdxT>
+__global__ void sq8EncodeKernel(uint8_t* codes,
+                                const float* dataset,
+                                const float* vmin,
+                                const float* scale,
+                                IdxT n_elems,
+                                uint32_t dim)
+{
+  const IdxT tid = threadIdx.x + IdxT(blockIdx.x) * blockDim.x;
+  if (tid >= n_elems) { return; }
+  const uint32_t j = uint32_t(tid % dim);
+  const float q    = (dataset[tid] - vmin[j]) / scale[j];
+  codes[tid]       = uint8_t(lroundf(fminf(fmaxf(q, 0.0f), 255.0f)));
+}
+
+/**
+ * Computes the distances from every query to every code row of a chunk,
+ * dequantizing into registers on the fly. Classic shared-memory tiling: each
+ * block produces a kTileDim x kTileDim patch of the distance matrix, staging
+ * query values and dequantized code values through shared memory so each
+ * global load is reused kTileDim times.
+ *
+ * Inner products are stored negated so that every later selection step can
+ * uniformly pick the minimum.
+ */
+template <typename IdxT, int kTileDim = 16>
+__global__ void sq8DistanceKernel(float* out,
+                                  const float* queries,
+                                  const uint8_t* codes,
+                                  const float* vmin,
+                                  const float* scale,
+                                  uint32_t n_queries,
+                                  IdxT n_rows,
+                                  uint32_t dim,
+                                  bool inner_prod)
+{
+  __shared__ float q_tile[kTileDim][kTileDim + 1];
+  __shared__ float r_tile[kTileDim][kTileDim + 1];
+
+  const IdxT row       = IdxT(blockIdx.x) * kTileDim + threadIdx.x;
+  const uint32_t query = blockIdx.y * kTileDim + threadIdx.y;
+
+  float acc = 0;
+  for (uint32_t j0 = 0; j0 < dim; j0 += kTileDim) {
+    const uint32_t j  = j0 + threadIdx.x;
+    const uint32_t qr = blockIdx.y * kTileDim + threadIdx.y;
+    q_tile[threadIdx.y][threadIdx.x] =
+      (qr < n_queries && j < dim) ? queries[size_t(qr) * dim + j] : 0.0f;
+    const IdxT r = IdxT(blockIdx.x) * kTileDim + threadIdx.y;
+    r_tile[threadIdx.y][threadIdx.x] =
+      (r < n_rows && j < dim) ? vmin[j] + scale[j] * float(codes[size_t(r) * dim + j]) : 0.0f;
+    __syncthreads();
+
+    const uint32_t t_end = dim - j0 < uint32_t(kTileDim) ? dim - j0 : uint32_t(kTileDim);
+    for (uint32_t t = 0; t < t_end; t++) {
+      const float qv = q_tile[threadIdx.y][t];
+      const float rv = r_tile[threadIdx.x][t];
+      if (inner_prod) {
+        acc -= qv * rv;
+      } else {
+        const float diff = qv - rv;
+        acc += diff * diff;
+      }
+    }
+    __syncthreads();
+  }
+  if (query < n_queries && row < n_rows) { out[size_t(query) * n_rows + row] = acc; }
+}
+
+/**
+ * The SQ8 counterpart of `ivf_flat::detail::ivfFlatScanKernel`: one block per
+ * (query, probe) pair, one warp per list entry, dequantizing the codes as the
+ * feature dimension is strided across the lanes.
+ */
+template <typename IdxT, int tpb = 128>
+__global__ void sq8IvfScanKernel(float* cand_dists,
+                                 IdxT* cand_inds,
+                                 const float* queries,
+                                 const uint8_t* codes,
+                                 const float* vmin,
+                                 const float* scale,
+                                 const IdxT* list_indices,
+                                 const IdxT* list_offsets,
+                                 const int* probe_ids,
+                                 const IdxT* cand_offsets,
+                                 uint32_t n_probes,
+                                 uint32_t dim,
+                                 IdxT max_cand,
+                                 bool inner_prod)
+{
+  const uint32_t q          = blockIdx.x;
+  const uint32_t p          = blockIdx.y;
+  const int lane            = threadIdx.x % raft::WarpSize;
+  const int warp            = threadIdx.x / raft::WarpSize;
+  constexpr int warps_per_b = tpb / raft::WarpSize;
+
+  const int list   = probe_ids[q * n_probes + p];
+  const IdxT start = list_offsets[list];
+  const IdxT n_in  = list_offsets[list + 1] - start;
+  const IdxT base  = IdxT(q) * max_cand + cand_offsets[q * n_probes + p];
+  const float* query = queries + size_t(q) * dim;
+
+  for (IdxT c = warp; c < n_in; c += warps_per_b) {
+    const uint8_t* row = codes + size_t(start + c) * dim;
+    float acc          = 0;
+    for (uint32_t j = lane; j < dim; j += raft::WarpSize) {
+      const float rv = vmin[j] + scale[j] * float(row[j]);
+      if (inner_prod) {
+        acc += query[j] * rv;
+      } else {
+        const float diff = query[j] - rv;
+        acc += diff * diff;
+      }
+    }
+    acc = raft::warpReduce(acc);
+    if (lane == 0) {
+      cand_dists[base + c] = acc;
+      cand_inds[base + c]  = list_indices[start + c];
+    }
+  }
+}
+
+/** @brief Build a flat SQ8 index. See `raft::spatial::knn::sq8::build`. */
+template <typename IdxT>
+auto build(const raft::handle_t& handle,
+           const float* dataset,
+           IdxT n_rows,
+           uint32_t dim,
+           raft::distance::DistanceType metric) -> index<IdxT>
+{
+  auto stream = handle.get_stream();
+  ASSERT(n_rows > 0 && dim > 0, "empty dataset");
+
+  index<IdxT> idx(handle, metric, dim);
+  sq8TrainKernel<IdxT><<<dim, 256, 0, stream>>>(
+    idx.vmin.data(), idx.scale.data(), dataset, n_rows, dim);
+  RAFT_CUDA_TRY(cudaGetLastError());
+
+  idx.codes.resize(size_t(n_rows) * dim, stream);
+  const IdxT n_elems = n_rows * IdxT(dim);
+  sq8EncodeKernel<IdxT><<<raft::ceildiv<IdxT>(n_elems, 256), 256, 0, stream>>>(
+    idx.codes.data(), dataset, idx.vmin.data(), idx.scale.data(), n_elems, dim);
+  RAFT_CUDA_TRY(cudaGetLastError());
+
+  idx.size = n_rows;
+  return idx;
+}
+
+/** @brief Exact search over a flat SQ8 index. See `raft::spatial::knn::sq8::search`. */
+template <typename IdxT>
+void search(const raft::handle_t& handle,
+            const index<IdxT>& idx,
+            const float* queries,
+            uint32_t n_queries,
+            uint32_t k,
+            IdxT* neighbors,
+            float* distances)
+{
+  auto stream = handle.get_stream();
+  ASSERT(n_queries > 0 && k > 0, "empty query batch");
+  ASSERT(static_cast<IdxT>(k) <= idx.size, "k is larger than the index");
+  ASSERT(k <= static_cast<uint32_t>(knn::detail::kFaissMaxK<IdxT, float>()),
+         "k is too large for the selection step");
+  const bool inner_prod = idx.metric == raft::distance::DistanceType::InnerProduct;
+
+  // scan the codes in fixed-size chunks so the distance buffer stays bounded
+  // regardless of the index size, selecting the per-chunk top-k as we go and
+  // merging the parts at the end. A short final remainder (< k rows, too few
+  // to select from) is folded into the last full chunk.
+  constexpr IdxT kMaxChunk = IdxT(1) << 16;
+  int n_parts              = 1;
+  IdxT chunk               = idx.size;
+  if (idx.size > kMaxChunk) {
+    chunk   = kMaxChunk;
+    n_parts = int(idx.size / kMaxChunk);
+    if (idx.size % kMaxChunk >= IdxT(k)) { n_parts++; }
+  }
+
+  rmm::device_uvector<float> dists(size_t(n_queries) * (chunk + IdxT(k)), stream);
+  rmm::device_uvector<float> part_D(0, stream);
+  rmm::device_uvector<IdxT> part_I(0, stream);
+  rmm::device_uvector<IdxT> trans(0, stream);
+  if (n_parts > 1) {
+    part_D.resize(size_t(n_parts) * k * n_queries, stream);
+    part_I.resize(part_D.size(), stream);
+    std::vector<IdxT> h_trans(n_parts);
+    for (int p = 0; p < n_parts; p++) {
+      h_trans[p] = IdxT(p) * chunk;
+    }
+    trans.resize(n_parts, stream);
+    raft::update_device(trans.data(), h_trans.data(), n_parts, stream);
+  }
+
+  constexpr int kTileDim = 16;
+  dim3 block(kTileDim, kTileDim);
+  for (int p = 0; p < n_parts; p++) {
+    const IdxT start = IdxT(p) * chunk;
+    const IdxT rows  = p + 1 == n_parts ? idx.size - start : chunk;
+    dim3 grid(uint32_t(raft::ceildiv<IdxT>(rows, kTileDim)),
+              raft::ceildiv<uint32_t>(n_queries, kTileDim));
+    sq8DistanceKernel<IdxT><<<grid, block, 0, stream>>>(dists.data(),
+                                                        queries,
+                                                        idx.codes.data() + size_t(start) * idx.dim,
+                                                        idx.vmin.data(),
+                                                        idx.scale.data(),
+                                                        n_queries,
+                                                        rows,
+                                                        idx.dim,
+                                                        inner_prod);
+    RAFT_CUDA_TRY(cudaGetLastError());
+
+    float* out_D = n_parts == 1 ? distances : part_D.data() + size_t(p) * k * n_queries;
+    IdxT* out_I  = n_parts == 1 ? neighbors : part_I.data() + size_t(p) * k * n_queries;
+    knn::detail::select_k<IdxT, float>(
+      dists.data(), nullptr, n_queries, rows, out_D, out_I, true, k, stream);
+  }
+
+  if (n_parts > 1) {
+    knn::detail::knn_merge_parts(part_D.data(),
+                                 part_I.data(),
+                                 distances,
+                                 neighbors,
+                                 n_queries,
+                                 n_parts,
+                                 k,
+                                 stream,
+                                 trans.data());
+  }
+
+  if (inner_prod) {
+    // the scan negated the dot products so every selection was ascending
+    raft::linalg::unaryOp<float>(
+      distances,
+      distances,
+      size_t(n_queries) * k,
+      [] __device__(float in) { return -in; },
+      stream);
+  } else if (idx.metric == raft::distance::DistanceType::L2SqrtExpanded ||
+             idx.metric == raft::distance::DistanceType::L2SqrtUnexpanded) {
+    raft::linalg::unaryOp<float>(
+      distances,
+      distances,
+      size_t(n_queries) * k,
+      [] __device__(float in) { return raft::mySqrt(in); },
+      stream);
+  }
+}
+
+/** @brief Build an IVF index with SQ8 lists. See `raft::spatial::knn::sq8::build_ivf`. */
+template <typename IdxT>
+auto build_ivf(const raft::handle_t& handle,
+               const ivf_flat::index_params& params,
+               const float* dataset,
+               IdxT n_rows,
+               uint32_t dim,
+               raft::distance::DistanceType metric) -> ivf_index<IdxT>
+{
+  auto stream = handle.get_stream();
+
+  // train the coarse quantizer and regroup the rows as for a flat IVF index,
+  // then quantize the regrouped lists and drop the full-precision copy
+  auto flat = ivf_flat::detail::build<float, IdxT>(handle, params, dataset, n_rows, dim, metric);
+
+  ivf_index<IdxT> idx(handle, metric, params.n_lists, dim);
+  sq8TrainKernel<IdxT><<<dim, 256, 0, stream>>>(
+    idx.vmin.data(), idx.scale.data(), dataset, n_rows, dim);
+  RAFT_CUDA_TRY(cudaGetLastError());
+
+  idx.codes.resize(size_t(n_rows) * dim, stream);
+  const IdxT n_elems = n_rows * IdxT(dim);
+  sq8EncodeKernel<IdxT><<<raft::ceildiv<IdxT>(n_elems, 256), 256, 0, stream>>>(
+    idx.codes.data(), flat.data.data(), idx.vmin.data(), idx.scale.data(), n_elems, dim);
+  RAFT_CUDA_TRY(cudaGetLastError());
+
+  idx.centers      = std::move(flat.centers);
+  idx.list_offsets = std::move(flat.list_offsets);
+  idx.indices      = std::move(flat.indices);
+  idx.size         = n_rows;
+  return idx;
+}
+
+/** @brief Search an SQ8 IVF index. See `raft::spatial::knn::sq8::search_ivf`. */
+template <typename IdxT>
+void search_ivf(const raft::handle_t& handle,
+                const ivf_flat::search_params& params,
+                const ivf_index<IdxT>& idx,
+                const float* queries,
+                uint32_t n_queries,
+                uint32_t k,
+                IdxT* neighbors,
+                float* distances)
+{
+  auto stream = handle.get_stream();
+  ASSERT(n_queries > 0 && k > 0, "empty query batch");
+  ASSERT(k <= static_cast<uint32_t>(knn::detail::kFaissMaxK<IdxT, float>()),
+         "k is too large for the selection step");
+
+  uint32_t n_probes = std::min(params.n_probes, idx.n_lists);
+  ASSERT(n_probes > 0, "n_probes must be positive");
+  bool inner_prod = idx.metric == raft::distance::DistanceType::InnerProduct;
+
+  // coarse phase: identical to ivf_flat — the centers are kept in full
+  // precision, so the probe selection is unaffected by the quantization
+  rmm::device_uvector<float> coarse_dists(static_cast<std::size_t>(n_queries) * idx.n_lists,
+                                          stream);
+  raft::distance::pairwise_distance<float, int>(handle,
+                                                queries,
+                                                idx.centers.data(),
+                                                coarse_dists.data(),
+                                                static_cast<int>(n_queries),
+                                                static_cast<int>(idx.n_lists),
+                                                static_cast<int>(idx.dim),
+                                                raft::distance::DistanceType::L2Expanded,
+                                                true);
+  rmm::device_uvector<int> probe_ids(static_cast<std::size_t>(n_queries) * n_probes, stream);
+  rmm::device_uvector<float> probe_dists(probe_ids.size(), stream);
+  knn::detail::select_k<int, float>(coarse_dists.data(),
+                                    nullptr,
+                                    n_queries,
+                                    idx.n_lists,
+                                    probe_dists.data(),
+                                    probe_ids.data(),
+                                    true,
+                                    n_probes,
+                                    stream);
+
+  rmm::device_uvector<IdxT> cand_offsets(probe_ids.size(), stream);
+  rmm::device_uvector<IdxT> cand_totals(n_queries, stream);
+  ivf_flat::detail::candidateOffsetsKernel<<<raft::ceildiv<uint32_t>(n_queries, 128),
+                                             128,
+                                             0,
+                                             stream>>>(cand_offsets.data(),
+                                                       cand_totals.data(),
+                                                       probe_ids.data(),
+                                                       idx.list_offsets.data(),
+                                                       n_queries,
+                                                       n_probes);
+  RAFT_CUDA_TRY(cudaGetLastError());
+  IdxT max_cand = thrust::reduce(rmm::exec_policy(stream),
+                                 cand_totals.data(),
+                                 cand_totals.data() + n_queries,
+                                 IdxT(0),
+                                 thrust::maximum<IdxT>());
+
+  rmm::device_uvector<float> cand_dists(static_cast<std::size_t>(n_queries) * max_cand, stream);
+  rmm::device_uvector<IdxT> cand_inds(cand_dists.size(), stream);
+  thrust::fill(rmm::exec_policy(stream),
+               cand_dists.data(),
+               cand_dists.data() + cand_dists.size(),
+               inner_prod ? raft::lower_bound<float>() : raft::upper_bound<float>());
+  thrust::fill(
+    rmm::exec_policy(stream), cand_inds.data(), cand_inds.data() + cand_inds.size(), IdxT(-1));
+
+  dim3 grid(n_queries, n_probes);
+  sq8IvfScanKernel<IdxT><<<grid, 128, 0, stream>>>(cand_dists.data(),
+                                                   cand_inds.data(),
+                                                   queries,
+                                                   idx.codes.data(),
+                                                   idx.vmin.data(),
+                                                   idx.scale.data(),
+                                                   idx.indices.data(),
+                                                   idx.list_offsets.data(),
+                                                   probe_ids.data(),
+                                                   cand_offsets.data(),
+                                                   n_probes,
+                                                   idx.dim,
+                                                   max_cand,
+                                                   inner_prod);
+  RAFT_CUDA_TRY(cudaGetLastError());
+
+  knn::detail::select_k<IdxT, float>(cand_dists.data(),
+                                     cand_inds.data(),
+                                     n_queries,
+                                     max_cand,
+                                     distances,
+                                     neighbors,
+                                     !inner_prod,
+                                     k,
+                                     stream);
+
+  if (idx.metric == raft::distance::DistanceType::L2SqrtExpanded ||
+      idx.metric == raft::distance::DistanceType::L2SqrtUnexpanded) {
+    raft::linalg::unaryOp<float>(
+      distances,
+      distances,
+      static_cast<std::size_t>(n_queries) * k,
+      [] __device__(float in) { return raft::mySqrt(in); },
+      stream);
+  }
+}
+
+}  // namespace detail
+}  // namespace sq8
+}  // namespace knn
+}  // namespace spatial
+}  // namespace raft
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/cuda_utils.cuh>
+#include <raft/pow2_utils.cuh>
+#include <raft/spatial/knn/detail/topk/warpsort_topk.cuh>
+
+namespace raft::spatial::knn::detail::topk {
+
+/**
+ * A reusable select-k epilogue for tile-producing kernels.
+ *
+ * Any kernel that computes values tile-by-tile (pairwise distance tiles,
+ * sparse distance blocks) can instantiate this per subwarp and feed each
+ * finished tile row into it, instead of materializing the full row in global
+ * memory and running a separate top-k pass. The per-query top-k state lives
+ * entirely in registers (a warp_sort queue over `bitonic_sort`); only the
+ * final k results are written out.
+ *
+ * One subwarp of `kWarpWidth` threads owns one query row; all threads of the
+ * subwarp must participate in every call (the queue uses warp collectives).
+ *
+ * Usage sketch inside a tile loop:
+ * @code{.cpp}
+ *   select_k_epilogue<Capacity, true, float, int> top_k(k);
+ *   for (int tile = 0; tile < n_tiles; tile++) {
+ *     // ... compute tile_vals for this query row ...
+ *     top_k.consume_tile(tile_vals, tile_len, tile * tile_len);
+ *   }
+ *   top_k.finish(out + query * k, out_idx + query * k);
+ * @endcode
+ *
+ * @tparam Capacity
+ *   the maximum supported `k`, a power of two (cf. warp_sort).
+ * @tparam Ascending
+ *   `true` collects the k smallest values (distances), `false` the greatest.
+ * @tparam T the type of the values (e.g. distances).
+ * @tparam IdxT the type of the indices tracked alongside the values.
+ * @tparam WarpSortClass
+ *   the queue implementation: `warp_sort_filtered` (default) skips most of the
+ *   sorting work for long inputs, `warp_sort_immediate` is cheaper for short
+ *   ones (cf. LaunchThreshold).
+ */
+template <int Capacity,
+          bool Ascending,
+          typename T,
+          typename IdxT,
+          template <int, bool, typename, typename> class WarpSortClass = warp_sort_filtered>
+class select_k_epilogue {
+ public:
+  using queue_t = WarpSortClass<Capacity, Ascending, T, IdxT>;
+
+  /** The `empty` value, ignored by the queue. */
+  static constexpr T kDummy = queue_t::kDummy;
+  /** Number of threads cooperating on one query row. */
+  static constexpr int kWarpWidth = queue_t::kWarpWidth;
+
+  /**
+   * @param k number of elements to select, `0 < k <= Capacity`.
+   */
+  __device__ explicit select_k_epilogue(int k) : queue_(k) {}
+
+  /**
+   * Add a single candidate; `val == kDummy` is a no-op padding element.
+   * Must be called by all threads of the subwarp at the same time.
+   */
+  __device__ __forceinline__ void add(T val, IdxT idx) { queue_.add(val, idx); }
+
+  /**
+   * Feed one contiguous tile row of candidates into the queue.
+   *
+   * The threads of the subwarp stride over the row together; the tail is
+   * padded with `kDummy` so every thread makes the same number of `add`
+   * calls (the queue's collectives require warp-uniform participation).
+   *
+   * @param[in] tile_vals
+   *   pointer to `tile_len` values of this query's row within the tile
+   *   (same for all threads of the subwarp).
+   * @param[in] tile_len number of valid values in the row.
+   * @param[in] idx_offset
+   *   index of the first value of the tile row in the full (virtual) row;
+   *   the i-th value gets the index `idx_offset + i`.
+   */
+  __device__ void consume_tile(const T* tile_vals, int tile_len, IdxT idx_offset)
+  {
+    const int lane = Pow2<kWarpWidth>::mod(laneId());
+    const int end  = Pow2<kWarpWidth>::roundUp(tile_len);
+    for (int i = lane; i < end; i += kWarpWidth) {
+      queue_.add(i < tile_len ? tile_vals[i] : kDummy, idx_offset + IdxT(i));
+    }
+  }
+
+  /**
+   * Same as `consume_tile`, but for candidates scattered by an index array
+   * (e.g. a sparse distance block with explicit column indices).
+   */
+  __device__ void consume_sparse_tile(const T* tile_vals, const IdxT* tile_idx, int tile_len)
+  {
+    const int lane = Pow2<kWarpWidth>::mod(laneId());
+    const int end  = Pow2<kWarpWidth>::roundUp(tile_len);
+    for (int i = lane; i < end; i += kWarpWidth) {
+      const bool valid = i < tile_len;
+      queue_.add(valid ? tile_vals[i] : kDummy, valid ? tile_idx[i] : IdxT{0});
+    }
+  }
+
+  /**
+   * Flush the internal buffer and write the k selected values (sorted) to
+   * the given per-query output location.
+   *
+   * @param[out] out device pointer to k values, unique per subwarp.
+   * @param[out] out_idx device pointer to k indices, unique per subwarp.
+   */
+  __device__ void finish(T* out, IdxT* out_idx)
+  {
+    queue_.done();
+    queue_.store(out, out_idx);
+  }
+
+ private:
+  queue_t queue_;
+};
+
+}  // namespace raft::spatial::knn::detail::topk
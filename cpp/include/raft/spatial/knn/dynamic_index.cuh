@@ -0,0 +1,428 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "ball_cover.cuh"
+#include "dynamic_index_types.hpp"
+
+#include "detail/dynamic_index.cuh"
+#include "detail/knn_brute_force_faiss.cuh"
+
+#include <raft/common/nvtx.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace raft::spatial::knn {
+
+/**
+ * @brief Append a batch of rows to a dynamic brute-force index.
+ *
+ * Storage grows with amortized doubling, so steady-state appends cost
+ * proportionally to the batch, not the corpus.
+ *
+ * @param[in] handle the cuml handle to use
+ * @param[inout] index the index to extend
+ * @param[in] X new rows in row-major layout (device, size n_rows * index.dim)
+ * @param[in] n_rows number of rows to append
+ */
+template <typename T, typename IdxT>
+void brute_force_add(raft::handle_t const& handle,
+                     dynamic_brute_force_index<T, IdxT>& index,
+                     const T* X,
+                     IdxT n_rows)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "spatial::brute_force_add (%zu)", size_t(n_rows));
+  auto stream = handle.get_stream();
+  detail::reserve_rows(index.data, size_t(index.size + n_rows) * index.dim, stream);
+  detail::reserve_rows(index.deleted, size_t(index.size + n_rows), stream);
+  raft::copy(index.data.data() + index.size * index.dim, X, n_rows * index.dim, stream);
+  RAFT_CUDA_TRY(cudaMemsetAsync(
+    index.deleted.data() + index.size, 0, n_rows * sizeof(std::uint32_t), stream));
+  index.size += n_rows;
+}
+
+/**
+ * @brief Tombstone rows of a dynamic brute-force index.
+ *
+ * The rows stay in storage but are filtered out of subsequent searches;
+ * removing an already-removed row is a no-op. Call `brute_force_compact`
+ * once the tombstone count makes search over-fetching expensive.
+ *
+ * @param[in] handle the cuml handle to use
+ * @param[inout] index the index to remove from
+ * @param[in] row_ids ids of the rows to remove (device, size n_ids)
+ * @param[in] n_ids number of rows to remove
+ */
+template <typename T, typename IdxT>
+void brute_force_remove(raft::handle_t const& handle,
+                        dynamic_brute_force_index<T, IdxT>& index,
+                        const IdxT* row_ids,
+                        IdxT n_ids)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "spatial::brute_force_remove (%zu)", size_t(n_ids));
+  index.n_deleted +=
+    detail::mark_deleted(index.deleted.data(), row_ids, n_ids, handle.get_stream());
+}
+
+/**
+ * @brief Drop the tombstoned rows of a dynamic brute-force index.
+ *
+ * The surviving rows are renumbered to be contiguous; callers tracking
+ * original ids must update their mapping.
+ *
+ * @param[in] handle the cuml handle to use
+ * @param[inout] index the index to compact
+ */
+template <typename T, typename IdxT>
+void brute_force_compact(raft::handle_t const& handle,
+                         dynamic_brute_force_index<T, IdxT>& index)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "spatial::brute_force_compact (%zu, %zu)", size_t(index.size), size_t(index.n_deleted));
+  if (index.n_deleted == 0) { return; }
+  auto stream = handle.get_stream();
+
+  rmm::device_uvector<IdxT> dest_row(index.size, stream);
+  detail::live_row_destinations(index.deleted.data(), dest_row.data(), index.size, stream);
+
+  rmm::device_uvector<T> compacted(size_t(index.n_live()) * index.dim, stream);
+  constexpr int tpb = 256;
+  detail::scatterLiveRowsKernel<T, IdxT>
+    <<<raft::ceildiv<IdxT>(index.size * index.dim, tpb), tpb, 0, stream>>>(index.data.data(),
+                                                                           nullptr,
+                                                                           compacted.data(),
+                                                                           dest_row.data(),
+                                                                           index.deleted.data(),
+                                                                           index.size,
+                                                                           index.size,
+                                                                           index.dim);
+  RAFT_CUDA_TRY(cudaGetLastError());
+
+  index.size = index.n_live();
+  index.n_deleted = 0;
+  index.data      = std::move(compacted);
+  RAFT_CUDA_TRY(
+    cudaMemsetAsync(index.deleted.data(), 0, index.size * sizeof(std::uint32_t), stream));
+}
+
+/**
+ * @brief Search a dynamic brute-force index for the k nearest live rows.
+ *
+ * Over-fetches by the tombstone count and filters, so the returned neighbors
+ * never include removed rows. Requires k + index.n_deleted <= 1024; compact
+ * the index when removals push past that.
+ *
+ * @param[in] handle the cuml handle to use
+ * @param[in] index the index to search
+ * @param[in] search_items query rows in row-major layout (device)
+ * @param[in] n number of query rows
+ * @param[out] res_I the resulting index array of size n * k
+ * @param[out] res_D the resulting distance array of size n * k
+ * @param[in] k the number of nearest neighbors to return
+ */
+template <typename T, typename IdxT, typename value_int = int>
+void brute_force_search(raft::handle_t const& handle,
+                        dynamic_brute_force_index<T, IdxT>& index,
+                        const T* search_items,
+                        value_int n,
+                        IdxT* res_I,
+                        T* res_D,
+                        value_int k)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "spatial::brute_force_search (%d, %d)", int(n), int(k));
+  ASSERT(index.n_live() >= IdxT(k), "brute_force_search: k exceeds the number of live rows");
+  auto stream          = handle.get_stream();
+  const value_int k2   = k + value_int(index.n_deleted);
+  RAFT_EXPECTS(k2 <= 1024,
+               "brute_force_search: k plus the tombstone count exceeds the selection limit; "
+               "compact the index first");
+
+  std::vector<T*> input{index.data.data()};
+  std::vector<value_int> sizes{value_int(index.size)};
+
+  if (index.n_deleted == 0) {
+    detail::brute_force_knn_impl<value_int, IdxT>(handle,
+                                                  input,
+                                                  sizes,
+                                                  value_int(index.dim),
+                                                  const_cast<T*>(search_items),
+                                                  n,
+                                                  res_I,
+                                                  res_D,
+                                                  k,
+                                                  true,
+                                                  true,
+                                                  nullptr,
+                                                  index.metric);
+    return;
+  }
+
+  rmm::device_uvector<T> cand_D(size_t(n) * k2, stream);
+  rmm::device_uvector<IdxT> cand_I(size_t(n) * k2, stream);
+  detail::brute_force_knn_impl<value_int, IdxT>(handle,
+                                                input,
+                                                sizes,
+                                                value_int(index.dim),
+                                                const_cast<T*>(search_items),
+                                                n,
+                                                cand_I.data(),
+                                                cand_D.data(),
+                                                k2,
+                                                true,
+                                                true,
+                                                nullptr,
+                                                index.metric);
+  detail::filter_deleted(
+    cand_D.data(), cand_I.data(), res_D, res_I, index.deleted.data(), size_t(n), k2, k, stream);
+}
+
+/**
+ * @brief Build (or rebuild) the ball cover structure of a dynamic index.
+ *
+ * Folds any pending tail rows into the base, drops tombstoned rows and
+ * rebuilds the ball cover structure over the survivors, which are renumbered
+ * to be contiguous. With `X` given, the index is reset and built over `X`
+ * instead (initial build).
+ *
+ * @param[in] handle the cuml handle to use
+ * @param[inout] index the index to (re)build
+ * @param[in] X optional initial data in row-major layout (device)
+ * @param[in] n_rows number of rows in X
+ */
+template <typename value_idx, typename value_t, typename value_int>
+void rbc_rebuild(raft::handle_t const& handle,
+                 dynamic_ball_cover_index<value_idx, value_t, value_int>& index,
+                 const value_t* X     = nullptr,
+                 value_int n_rows     = 0)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "spatial::rbc_rebuild (%zu, %zu)", size_t(index.size()), size_t(index.n_deleted));
+  auto stream = handle.get_stream();
+
+  if (X != nullptr) {
+    rmm::device_uvector<value_t> fresh(size_t(n_rows) * index.dim, stream);
+    raft::copy(fresh.data(), X, fresh.size(), stream);
+    index.base_data = std::move(fresh);
+    index.n_base    = n_rows;
+  } else if (index.n_tail > 0 || index.n_deleted > 0) {
+    const value_int n_total = index.size();
+    rmm::device_uvector<value_idx> dest_row(n_total, stream);
+    detail::live_row_destinations(
+      index.deleted.data(), dest_row.data(), value_idx(n_total), stream);
+
+    rmm::device_uvector<value_t> compacted(size_t(index.n_live()) * index.dim, stream);
+    constexpr int tpb = 256;
+    detail::scatterLiveRowsKernel<value_t, value_idx>
+      <<<raft::ceildiv<value_idx>(value_idx(n_total) * index.dim, tpb), tpb, 0, stream>>>(
+        index.base_data.data(),
+        index.tail_data.data(),
+        compacted.data(),
+        dest_row.data(),
+        index.deleted.data(),
+        value_idx(index.n_base),
+        value_idx(n_total),
+        value_idx(index.dim));
+    RAFT_CUDA_TRY(cudaGetLastError());
+
+    index.base_data = std::move(compacted);
+    index.n_base    = index.n_live();
+  }
+
+  index.n_tail    = 0;
+  index.n_deleted = 0;
+  index.tail_data.resize(0, stream);
+  index.deleted.resize(index.n_base, stream);
+  RAFT_CUDA_TRY(
+    cudaMemsetAsync(index.deleted.data(), 0, index.n_base * sizeof(std::uint32_t), stream));
+
+  index.base = std::make_unique<BallCoverIndex<value_idx, value_t, value_int>>(
+    handle, index.base_data.data(), index.n_base, index.dim, index.metric);
+  rbc_build_index(handle, *index.base);
+}
+
+/**
+ * @brief Append a batch of rows to a dynamic ball cover index.
+ *
+ * The rows land in a flat tail that is brute-force searched and merged with
+ * the base at query time; the expensive ball cover structure is untouched.
+ * Rebuild once the tail grows large relative to the base.
+ *
+ * @param[in] handle the cuml handle to use
+ * @param[inout] index the index to extend (must have been built)
+ * @param[in] X new rows in row-major layout (device, size n_rows * index.dim)
+ * @param[in] n_rows number of rows to append
+ */
+template <typename value_idx, typename value_t, typename value_int>
+void rbc_add_points(raft::handle_t const& handle,
+                    dynamic_ball_cover_index<value_idx, value_t, value_int>& index,
+                    const value_t* X,
+                    value_int n_rows)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "spatial::rbc_add_points (%zu)", size_t(n_rows));
+  ASSERT(index.base != nullptr, "rbc_add_points: build the index first (rbc_rebuild)");
+  auto stream = handle.get_stream();
+  detail::reserve_rows(index.tail_data, size_t(index.n_tail + n_rows) * index.dim, stream);
+  detail::reserve_rows(index.deleted, size_t(index.size() + n_rows), stream);
+  raft::copy(
+    index.tail_data.data() + size_t(index.n_tail) * index.dim, X, size_t(n_rows) * index.dim,
+    stream);
+  RAFT_CUDA_TRY(cudaMemsetAsync(
+    index.deleted.data() + index.size(), 0, n_rows * sizeof(std::uint32_t), stream));
+  index.n_tail += n_rows;
+}
+
+/**
+ * @brief Tombstone rows of a dynamic ball cover index.
+ *
+ * Row ids are global: base rows first, tail rows at offset index.n_base.
+ * Removed rows are filtered out of searches until the next rebuild drops
+ * them for good.
+ *
+ * @param[in] handle the cuml handle to use
+ * @param[inout] index the index to remove from
+ * @param[in] row_ids global ids of the rows to remove (device, size n_ids)
+ * @param[in] n_ids number of rows to remove
+ */
+template <typename value_idx, typename value_t, typename value_int>
+void rbc_remove_points(raft::handle_t const& handle,
+                       dynamic_ball_cover_index<value_idx, value_t, value_int>& index,
+                       const value_idx* row_ids,
+                       value_idx n_ids)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "spatial::rbc_remove_points (%zu)", size_t(n_ids));
+  index.n_deleted += value_int(
+    detail::mark_deleted(index.deleted.data(), row_ids, n_ids, handle.get_stream()));
+}
+
+/**
+ * @brief Search a dynamic ball cover index for the k nearest live rows.
+ *
+ * Runs the ball cover query over the base, a brute-force query over the
+ * tail, merges the two candidate lists and filters tombstoned rows. Both
+ * queries over-fetch by the tombstone count, so
+ * k + index.n_deleted <= min(1024, index.n_base) is required; rebuild the
+ * index when removals push past that. Synchronizes the handle stream.
+ *
+ * @param[in] handle the cuml handle to use
+ * @param[in] index the index to search (must have been built)
+ * @param[in] k the number of nearest neighbors to return
+ * @param[in] query query rows in row-major layout (device)
+ * @param[in] n_query_pts number of query rows
+ * @param[out] inds the resulting index array of size n_query_pts * k
+ * @param[out] dists the resulting distance array of size n_query_pts * k
+ */
+template <typename value_idx, typename value_t, typename value_int>
+void rbc_knn_query(raft::handle_t const& handle,
+                   dynamic_ball_cover_index<value_idx, value_t, value_int>& index,
+                   value_int k,
+                   const value_t* query,
+                   value_int n_query_pts,
+                   value_idx* inds,
+                   value_t* dists)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "spatial::rbc_knn_query-dynamic (%zu, %d)", size_t(n_query_pts), int(k));
+  ASSERT(index.base != nullptr, "rbc_knn_query: build the index first (rbc_rebuild)");
+  ASSERT(index.n_live() >= k, "rbc_knn_query: k exceeds the number of live rows");
+  auto stream        = handle.get_stream();
+  const value_int k2 = k + index.n_deleted;
+  RAFT_EXPECTS(k2 <= 1024 && k2 <= index.n_base,
+               "rbc_knn_query: k plus the tombstone count exceeds the base size or the "
+               "selection limit; rebuild the index first");
+
+  const bool plain = (index.n_tail == 0 && index.n_deleted == 0);
+  if (plain) {
+    rbc_knn_query(handle, *index.base, k, query, n_query_pts, inds, dists);
+    return;
+  }
+
+  // part 0: ball cover over the base; part 1: brute force over the tail
+  const int n_parts = index.n_tail > 0 ? 2 : 1;
+  rmm::device_uvector<value_t> part_D(size_t(n_query_pts) * k2 * n_parts, stream);
+  rmm::device_uvector<value_idx> part_I(size_t(n_query_pts) * k2 * n_parts, stream);
+  rbc_knn_query(handle, *index.base, k2, query, n_query_pts, part_I.data(), part_D.data());
+
+  rmm::device_uvector<value_t> merged_D(0, stream);
+  rmm::device_uvector<value_idx> merged_I(0, stream);
+  const value_t* cand_D  = part_D.data();
+  const value_idx* cand_I = part_I.data();
+
+  if (n_parts == 2) {
+    const value_int k_tail = std::min(k2, value_int(index.n_tail));
+    rmm::device_uvector<value_t> tail_D(size_t(n_query_pts) * k_tail, stream);
+    rmm::device_uvector<value_idx> tail_I(size_t(n_query_pts) * k_tail, stream);
+    std::vector<value_t*> input{index.tail_data.data()};
+    std::vector<value_int> sizes{value_int(index.n_tail)};
+    detail::brute_force_knn_impl<value_int, value_idx>(handle,
+                                                       input,
+                                                       sizes,
+                                                       value_int(index.dim),
+                                                       const_cast<value_t*>(query),
+                                                       n_query_pts,
+                                                       tail_I.data(),
+                                                       tail_D.data(),
+                                                       k_tail,
+                                                       true,
+                                                       true,
+                                                       nullptr,
+                                                       index.metric);
+    constexpr int tpb = 128;
+    detail::padPartKernel<value_idx, value_t>
+      <<<raft::ceildiv<size_t>(size_t(n_query_pts) * k2, tpb), tpb, 0, stream>>>(
+        tail_D.data(),
+        tail_I.data(),
+        part_D.data() + size_t(n_query_pts) * k2,
+        part_I.data() + size_t(n_query_pts) * k2,
+        n_query_pts,
+        k_tail,
+        k2);
+    RAFT_CUDA_TRY(cudaGetLastError());
+
+    std::vector<value_idx> h_trans{0, value_idx(index.n_base)};
+    rmm::device_uvector<value_idx> trans(2, stream);
+    raft::update_device(trans.data(), h_trans.data(), 2, stream);
+
+    merged_D.resize(size_t(n_query_pts) * k2, stream);
+    merged_I.resize(size_t(n_query_pts) * k2, stream);
+    detail::knn_merge_parts(part_D.data(),
+                            part_I.data(),
+                            merged_D.data(),
+                            merged_I.data(),
+                            size_t(n_query_pts),
+                            2,
+                            int(k2),
+                            stream,
+                            trans.data());
+    cand_D = merged_D.data();
+    cand_I = merged_I.data();
+    // the translation staging vector must outlive the queued merge
+    RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+  }
+
+  detail::filter_deleted(
+    cand_D, cand_I, dists, inds, index.deleted.data(), size_t(n_query_pts), int(k2), int(k),
+    stream);
+}
+
+}  // namespace raft::spatial::knn
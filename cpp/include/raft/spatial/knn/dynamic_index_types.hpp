@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "ball_cover_common.h"
+
+#include <raft/distance/distance_type.hpp>
+#include <raft/handle.hpp>
+
+#include <rmm/device_uvector.hpp>
+
+#include <cstdint>
+#include <memory>
+
+namespace raft::spatial::knn {
+
+/**
+ * @brief Brute-force index supporting incremental addition and removal.
+ *
+ * Rows are appended into amortized-doubling device storage and removed by
+ * tombstoning: `deleted[i] != 0` marks row i as logically absent while its
+ * data stays in place, so maintenance cost scales with the delta rather than
+ * the corpus. Searches over-fetch by the tombstone count and filter, so
+ * periodic compaction keeps the overhead bounded.
+ *
+ * Note that compaction renumbers the remaining rows; callers tracking
+ * original ids should maintain their own id mapping across `compact` calls.
+ */
+template <typename T, typename IdxT = std::int64_t>
+struct dynamic_brute_force_index {
+  /** Distance metric used for search. */
+  raft::distance::DistanceType metric;
+  /** Dimensionality of the stored vectors. */
+  IdxT dim;
+  /** Number of stored rows, including tombstoned ones. */
+  IdxT size;
+  /** Number of tombstoned rows awaiting compaction. */
+  IdxT n_deleted;
+  /** Row-major vector data; the uvector size is the grown capacity. */
+  rmm::device_uvector<T> data;
+  /** Per-row tombstone flags (1 = removed). */
+  rmm::device_uvector<std::uint32_t> deleted;
+
+  dynamic_brute_force_index(const handle_t& handle,
+                            raft::distance::DistanceType metric,
+                            IdxT dim)
+    : metric(metric),
+      dim(dim),
+      size(0),
+      n_deleted(0),
+      data(0, handle.get_stream()),
+      deleted(0, handle.get_stream())
+  {
+  }
+
+  dynamic_brute_force_index(const dynamic_brute_force_index&) = delete;
+  dynamic_brute_force_index(dynamic_brute_force_index&&)      = default;
+  auto operator=(const dynamic_brute_force_index&) -> dynamic_brute_force_index& = delete;
+  auto operator=(dynamic_brute_force_index&&) -> dynamic_brute_force_index& = default;
+
+  /** Number of rows that are not tombstoned. */
+  IdxT n_live() const { return size - n_deleted; }
+};
+
+/**
+ * @brief Ball cover index supporting incremental addition and removal.
+ *
+ * The expensive ball cover structure is only built over a stable base;
+ * appended rows accumulate in a flat tail that is brute-force searched and
+ * merged with the base results at query time. Removals tombstone rows in
+ * either region. `rbc_rebuild` folds the tail and drops the tombstones into
+ * a fresh base once the lazy overhead grows too large.
+ *
+ * Row ids are global: base rows come first, tail rows follow at offset
+ * `n_base`. A rebuild renumbers the surviving rows.
+ */
+template <typename value_idx = std::int64_t,
+          typename value_t   = float,
+          typename value_int = std::uint32_t>
+struct dynamic_ball_cover_index {
+  /** Distance metric; restricted to the metrics BallCoverIndex supports. */
+  raft::distance::DistanceType metric;
+  /** Dimensionality of the stored vectors (at most 3). */
+  value_int dim;
+  /** Number of rows covered by the ball cover structure. */
+  value_int n_base;
+  /** Number of appended rows pending the next rebuild. */
+  value_int n_tail;
+  /** Number of tombstoned rows (base or tail) awaiting the next rebuild. */
+  value_int n_deleted;
+  /** Data the base structure was built over; must stay put while it exists. */
+  rmm::device_uvector<value_t> base_data;
+  /** Appended rows; the uvector size is the grown capacity. */
+  rmm::device_uvector<value_t> tail_data;
+  /** Per-row tombstone flags over base followed by tail (1 = removed). */
+  rmm::device_uvector<std::uint32_t> deleted;
+  /** Ball cover structure over base_data; empty until the first build. */
+  std::unique_ptr<BallCoverIndex<value_idx, value_t, value_int>> base;
+
+  dynamic_ball_cover_index(const handle_t& handle,
+                           raft::distance::DistanceType metric,
+                           value_int dim)
+    : metric(metric),
+      dim(dim),
+      n_base(0),
+      n_tail(0),
+      n_deleted(0),
+      base_data(0, handle.get_stream()),
+      tail_data(0, handle.get_stream()),
+      deleted(0, handle.get_stream())
+  {
+  }
+
+  dynamic_ball_cover_index(const dynamic_ball_cover_index&) = delete;
+  dynamic_ball_cover_index(dynamic_ball_cover_index&&)      = default;
+  auto operator=(const dynamic_ball_cover_index&) -> dynamic_ball_cover_index& = delete;
+  auto operator=(dynamic_ball_cover_index&&) -> dynamic_ball_cover_index& = default;
+
+  /** Total number of rows, including tombstoned ones. */
+  value_int size() const { return n_base + n_tail; }
+  /** Number of rows that are not tombstoned. */
+  value_int n_live() const { return size() - n_deleted; }
+};
+
+}  // namespace raft::spatial::knn
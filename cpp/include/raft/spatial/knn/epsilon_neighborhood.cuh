@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <raft/core/nvtx.hpp>
 #include <raft/spatial/knn/detail/epsilon_neighborhood.cuh>
 
 namespace raft {
@@ -55,8 +56,101 @@ void epsUnexpL2SqNeighborhood(bool* adj,
                               DataT eps,
                               cudaStream_t stream)
 {
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "spatial::epsUnexpL2SqNeighborhood (%zu, %zu, %zu)", size_t(m), size_t(n), size_t(k));
   detail::epsUnexpL2SqNeighborhood<DataT, IdxT>(adj, vd, x, y, m, n, k, eps, stream);
 }
+
+/**
+ * @brief Computes epsilon neighborhoods for several epsilon values at once
+ * for the L2-Squared distance metric
+ *
+ * The pairwise distances are computed exactly once and compared against all
+ * thresholds while still in registers, so an epsilon sweep (e.g. for
+ * OPTICS-style analyses) costs one distance pass instead of one per epsilon.
+ * The thresholds may appear in any order; each one produces its own
+ * adjacency plane and vertex degree array.
+ *
+ * @tparam DataT   IO and math type
+ * @tparam IdxT    Index type
+ *
+ * @param[out] adj    adjacency matrices [row-major] [on device]
+ *                    [dim = n_eps x m x n]; plane `e` corresponds to `eps[e]`
+ * @param[out] vd     vertex degree arrays [on device] [len = n_eps * (n + 1)]
+ *                    `vd + e * (n + 1)` holds the degrees for `eps[e]`, with
+ *                    the total edge count at its last entry. Pass a nullptr
+ *                    if you don't need this info.
+ * @param[in]  x      first matrix [row-major] [on device] [dim = m x k]
+ * @param[in]  y      second matrix [row-major] [on device] [dim = n x k]
+ * @param[in]  m      number of rows in x
+ * @param[in]  n      number of rows in y
+ * @param[in]  k      number of columns in x and y
+ * @param[in]  eps    epsilon neighborhood radii [on device] [len = n_eps]
+ *                    (should be passed as squared as we compute L2-squared
+ *                    distance in this method)
+ * @param[in]  n_eps  number of epsilon values
+ * @param[in]  stream cuda stream
+ */
+template <typename DataT, typename IdxT>
+void epsUnexpL2SqMultiNeighborhood(bool* adj,
+                                   IdxT* vd,
+                                   const DataT* x,
+                                   const DataT* y,
+                                   IdxT m,
+                                   IdxT n,
+                                   IdxT k,
+                                   const DataT* eps,
+                                   IdxT n_eps,
+                                   cudaStream_t stream)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "spatial::epsUnexpL2SqMultiNeighborhood (%zu, %zu, %zu, %zu)",
+    size_t(m),
+    size_t(n),
+    size_t(k),
+    size_t(n_eps));
+  detail::epsUnexpL2SqMultiNeighborhood<DataT, IdxT>(adj, vd, x, y, m, n, k, eps, n_eps, stream);
+}
+
+/**
+ * @brief Computes epsilon neighborhood in CSR form for the L2-Squared
+ * distance metric
+ *
+ * Two passes of the same contraction kernel: the first counts the neighbors
+ * of each x-row, the second fills the adjacency lists after an exclusive scan
+ * of the counts. Memory cost is proportional to the edge count instead of the
+ * dense m*n matrix; this call synchronizes the stream once between the passes
+ * to size the output. Column ids within a row are unsorted.
+ *
+ * @tparam DataT   IO and math type
+ * @tparam IdxT    Index type
+ *
+ * @param[out] indptr   CSR row offsets [on device] [len = m + 1]
+ * @param[out] adj_cols CSR column ids; resized to the number of edges
+ * @param[in]  x      first matrix [row-major] [on device] [dim = m x k]
+ * @param[in]  y      second matrix [row-major] [on device] [dim = n x k]
+ * @param[in]  m      number of rows in x
+ * @param[in]  n      number of rows in y
+ * @param[in]  k      number of columns in x and y
+ * @param[in]  eps    defines epsilon neighborhood radius (should be passed as
+ *                    squared as we compute L2-squared distance in this method)
+ * @param[in]  stream cuda stream
+ */
+template <typename DataT, typename IdxT>
+void epsUnexpL2SqNeighborhoodCsr(IdxT* indptr,
+                                 rmm::device_uvector<IdxT>& adj_cols,
+                                 const DataT* x,
+                                 const DataT* y,
+                                 IdxT m,
+                                 IdxT n,
+                                 IdxT k,
+                                 DataT eps,
+                                 cudaStream_t stream)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "spatial::epsUnexpL2SqNeighborhoodCsr (%zu, %zu, %zu)", size_t(m), size_t(n), size_t(k));
+  detail::epsUnexpL2SqNeighborhoodCsr<DataT, IdxT>(indptr, adj_cols, x, y, m, n, k, eps, stream);
+}
 }  // namespace knn
 }  // namespace spatial
 }  // namespace raft
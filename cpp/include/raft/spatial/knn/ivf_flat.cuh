@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __IVF_FLAT_H
+#define __IVF_FLAT_H
+
+#pragma once
+
+#include <raft/spatial/knn/detail/ivf_flat.cuh>
+#include <raft/spatial/knn/ivf_flat_types.hpp>
+
+namespace raft {
+namespace spatial {
+namespace knn {
+namespace ivf_flat {
+
+/**
+ * @brief Build an IVF-Flat index over a row-major dataset.
+ *
+ * Trains a coarse k-means quantizer with `raft::cluster::kmeans` and regroups
+ * the dataset rows into per-cluster inverted lists. Unlike the faiss-backed
+ * `approx_knn_build_index`, everything runs on the handle's stream and
+ * allocator with no copies across a library boundary.
+ *
+ * Supported metrics: the L2 family and InnerProduct.
+ *
+ * @tparam T data element type
+ * @tparam IdxT type of the source-row indices reported by search
+ * @param handle raft handle for managing expensive resources
+ * @param params index building parameters
+ * @param dataset the input data (size n_rows * dim, row-major)
+ * @param n_rows number of rows in the dataset
+ * @param dim dimensionality
+ * @param metric distance metric to build the index for
+ * @return the constructed index
+ */
+template <typename T, typename IdxT = int64_t>
+auto build(const raft::handle_t& handle,
+           const index_params& params,
+           const T* dataset,
+           IdxT n_rows,
+           uint32_t dim,
+           raft::distance::DistanceType metric = raft::distance::DistanceType::L2Expanded)
+  -> index<T, IdxT>
+{
+  return detail::build<T, IdxT>(handle, params, dataset, n_rows, dim, metric);
+}
+
+/**
+ * @brief Find the approximate k nearest neighbors of the queries in an
+ * IVF-Flat index.
+ *
+ * Per query, the `params.n_probes` closest inverted lists are selected by
+ * distance to the cluster centers, their members scanned exactly, and the k
+ * best candidates selected. Distances come back in the metric the index was
+ * built for (including the final sqrt for the L2Sqrt variants).
+ *
+ * @tparam T data element type
+ * @tparam IdxT type of the returned source-row indices
+ * @param handle raft handle for managing expensive resources
+ * @param params search parameters
+ * @param idx the index built by `ivf_flat::build`
+ * @param queries the query points (size n_queries * idx.dim, row-major)
+ * @param n_queries number of queries
+ * @param k number of neighbors to return per query
+ * @param neighbors output neighbor indices (size n_queries * k)
+ * @param distances output neighbor distances (size n_queries * k)
+ */
+template <typename T, typename IdxT = int64_t>
+void search(const raft::handle_t& handle,
+            const search_params& params,
+            const index<T, IdxT>& idx,
+            const T* queries,
+            uint32_t n_queries,
+            uint32_t k,
+            IdxT* neighbors,
+            T* distances)
+{
+  detail::search<T, IdxT>(handle, params, idx, queries, n_queries, k, neighbors, distances);
+}
+
+}  // namespace ivf_flat
+}  // namespace knn
+}  // namespace spatial
+}  // namespace raft
+
+#endif
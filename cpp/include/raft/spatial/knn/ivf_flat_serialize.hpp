@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/spatial/knn/detail/index_serialize.hpp>
+#include <raft/spatial/knn/ivf_flat_types.hpp>
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+
+namespace raft {
+namespace spatial {
+namespace knn {
+namespace ivf_flat {
+
+namespace detail {
+constexpr uint32_t kIvfSerializationMagic   = 0x49564649;  // "IVFI"
+constexpr uint32_t kIvfSerializationVersion = 1;
+}  // namespace detail
+
+/**
+ * @brief Write an IVF-Flat index to a binary stream.
+ *
+ * A small versioned header (magic, version, element sizes, metric and shape)
+ * is followed by the centers, list offsets, regrouped data and source indices
+ * as contiguous blocks. Unlike the ball cover index, an IVF-Flat index owns
+ * everything it needs, so the file alone fully reconstructs it.
+ *
+ * @param[in] handle raft handle providing the stream for the D2H copies
+ * @param[in] idx the index built by `ivf_flat::build`
+ * @param[in] os output stream, opened in binary mode
+ */
+template <typename T, typename IdxT>
+void serialize(const raft::handle_t& handle, const index<T, IdxT>& idx, std::ostream& os)
+{
+  auto stream = handle.get_stream();
+
+  knn::detail::serialize_scalar(os, detail::kIvfSerializationMagic);
+  knn::detail::serialize_scalar(os, detail::kIvfSerializationVersion);
+  knn::detail::serialize_scalar<uint32_t>(os, sizeof(T));
+  knn::detail::serialize_scalar<uint32_t>(os, sizeof(IdxT));
+  knn::detail::serialize_scalar<int32_t>(os, int32_t(idx.metric));
+  knn::detail::serialize_scalar<uint32_t>(os, idx.n_lists);
+  knn::detail::serialize_scalar<uint32_t>(os, idx.dim);
+  knn::detail::serialize_scalar<uint64_t>(os, uint64_t(idx.size));
+
+  knn::detail::serialize_device_array(
+    os, idx.centers.data(), size_t(idx.n_lists) * idx.dim, stream);
+  knn::detail::serialize_device_array(os, idx.list_offsets.data(), idx.n_lists + 1, stream);
+  knn::detail::serialize_device_array(os, idx.data.data(), size_t(idx.size) * idx.dim, stream);
+  knn::detail::serialize_device_array(os, idx.indices.data(), size_t(idx.size), stream);
+  RAFT_EXPECTS(os.good(), "ivf_flat::serialize: writing the index failed");
+}
+
+/**
+ * @brief Restore an IVF-Flat index written by `ivf_flat::serialize`, skipping
+ * the k-means training of `ivf_flat::build` entirely.
+ *
+ * @param[in] handle raft handle providing the stream for the H2D copies
+ * @param[in] is input stream, opened in binary mode
+ * @return the reconstructed index
+ */
+template <typename T, typename IdxT>
+auto deserialize(const raft::handle_t& handle, std::istream& is) -> index<T, IdxT>
+{
+  auto stream = handle.get_stream();
+
+  RAFT_EXPECTS(knn::detail::deserialize_scalar<uint32_t>(is) == detail::kIvfSerializationMagic,
+               "ivf_flat::deserialize: not an IVF-Flat index file");
+  RAFT_EXPECTS(knn::detail::deserialize_scalar<uint32_t>(is) == detail::kIvfSerializationVersion,
+               "ivf_flat::deserialize: unsupported format version");
+  RAFT_EXPECTS(knn::detail::deserialize_scalar<uint32_t>(is) == sizeof(T) &&
+                 knn::detail::deserialize_scalar<uint32_t>(is) == sizeof(IdxT),
+               "ivf_flat::deserialize: element types do not match the file");
+  auto metric        = raft::distance::DistanceType(knn::detail::deserialize_scalar<int32_t>(is));
+  uint32_t n_lists   = knn::detail::deserialize_scalar<uint32_t>(is);
+  uint32_t dim       = knn::detail::deserialize_scalar<uint32_t>(is);
+  IdxT size          = IdxT(knn::detail::deserialize_scalar<uint64_t>(is));
+
+  index<T, IdxT> idx(handle, metric, n_lists, dim);
+  idx.data.resize(size_t(size) * dim, stream);
+  idx.indices.resize(size_t(size), stream);
+
+  knn::detail::deserialize_device_array(
+    is, idx.centers.data(), size_t(n_lists) * dim, stream);
+  knn::detail::deserialize_device_array(is, idx.list_offsets.data(), n_lists + 1, stream);
+  knn::detail::deserialize_device_array(is, idx.data.data(), size_t(size) * dim, stream);
+  knn::detail::deserialize_device_array(is, idx.indices.data(), size_t(size), stream);
+
+  idx.size = size;
+  return idx;
+}
+
+}  // namespace ivf_flat
+}  // namespace knn
+}  // namespace spatial
+}  // namespace raft
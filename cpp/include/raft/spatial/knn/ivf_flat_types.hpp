@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/distance/distance_type.hpp>
+#include <raft/handle.hpp>
+
+#include <rmm/device_uvector.hpp>
+
+#include <cstdint>
+
+namespace raft {
+namespace spatial {
+namespace knn {
+namespace ivf_flat {
+
+/** Parameters controlling the coarse quantizer training in `ivf_flat::build`. */
+struct index_params {
+  /** The number of inverted lists (coarse clusters). */
+  uint32_t n_lists = 1024;
+  /** The maximum number of k-means iterations when training the coarse centers. */
+  uint32_t kmeans_n_iters = 20;
+  /** The k-means convergence tolerance. */
+  double kmeans_tol = 1e-4;
+};
+
+/** Parameters controlling `ivf_flat::search`. */
+struct search_params {
+  /** The number of inverted lists to probe per query. */
+  uint32_t n_probes = 20;
+};
+
+/**
+ * @brief An IVF-Flat index: a coarse k-means quantizer plus the dataset rows
+ * regrouped into per-cluster inverted lists.
+ *
+ * All state lives in device memory owned by the index; the handle used at
+ * build time only provides the stream the allocations are ordered on. The
+ * structure is movable but not copyable, like the rmm containers it holds.
+ *
+ * @tparam T data element type
+ * @tparam IdxT type of the source-row indices returned by search
+ */
+template <typename T, typename IdxT = int64_t>
+struct index {
+  /** Distance metric the index was built for. */
+  raft::distance::DistanceType metric;
+  /** Number of inverted lists. */
+  uint32_t n_lists;
+  /** Dimensionality of the data. */
+  uint32_t dim;
+  /** Total number of indexed rows. */
+  IdxT size;
+  /** Cluster centers of the coarse quantizer [n_lists, dim]. */
+  rmm::device_uvector<T> centers;
+  /** Start of each inverted list within `data`/`indices` [n_lists + 1]. */
+  rmm::device_uvector<IdxT> list_offsets;
+  /** Dataset rows regrouped by list [size, dim]. */
+  rmm::device_uvector<T> data;
+  /** Source row id of each entry of `data` [size]. */
+  rmm::device_uvector<IdxT> indices;
+
+  index(const raft::handle_t& handle,
+        raft::distance::DistanceType metric,
+        uint32_t n_lists,
+        uint32_t dim)
+    : metric(metric),
+      n_lists(n_lists),
+      dim(dim),
+      size(0),
+      centers(static_cast<std::size_t>(n_lists) * dim, handle.get_stream()),
+      list_offsets(n_lists + 1, handle.get_stream()),
+      data(0, handle.get_stream()),
+      indices(0, handle.get_stream())
+  {
+  }
+
+  index(index&&) = default;
+  index& operator=(index&&) = default;
+  index(const index&)       = delete;
+  index& operator=(const index&) = delete;
+};
+
+}  // namespace ivf_flat
+}  // namespace knn
+}  // namespace spatial
+}  // namespace raft
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __IVF_PQ_H
+#define __IVF_PQ_H
+
+#pragma once
+
+#include <raft/spatial/knn/detail/ivf_pq.cuh>
+#include <raft/spatial/knn/ivf_pq_types.hpp>
+
+namespace raft {
+namespace spatial {
+namespace knn {
+namespace ivf_pq {
+
+/**
+ * @brief Build an IVF-PQ index over a row-major fp32 dataset.
+ *
+ * Trains a coarse quantizer with `raft::cluster::kmeans`, then one 256-center
+ * sub-quantizer per `pq_dim` sub-space on the coarse residuals, and stores
+ * the 8-bit codes in per-cluster inverted lists -- `pq_dim` bytes per row
+ * instead of `dim` floats. Everything runs on the handle's stream and rmm
+ * allocations; no faiss boundary.
+ *
+ * Supported metrics: the L2 family (PQ codes approximate residual L2
+ * distances).
+ *
+ * @tparam IdxT type of the source-row indices reported by search
+ * @param handle raft handle for managing expensive resources
+ * @param params index building parameters
+ * @param dataset the input data (size n_rows * dim, row-major)
+ * @param n_rows number of rows in the dataset
+ * @param dim dimensionality
+ * @param metric distance metric to build the index for
+ * @return the constructed index
+ */
+template <typename IdxT = int64_t>
+auto build(const raft::handle_t& handle,
+           const index_params& params,
+           const float* dataset,
+           IdxT n_rows,
+           uint32_t dim,
+           raft::distance::DistanceType metric = raft::distance::DistanceType::L2Expanded)
+  -> index<IdxT>
+{
+  return detail::build<IdxT>(handle, params, dataset, n_rows, dim, metric);
+}
+
+/**
+ * @brief Find the approximate k nearest neighbors of the queries in an
+ * IVF-PQ index.
+ *
+ * Per query, the `params.n_probes` closest lists are selected by distance to
+ * the coarse centers; a fused kernel then builds the per-list lookup table of
+ * sub-space distances in shared memory and scans the list's codes against it,
+ * with the `detail/topk` warpsort selection as the epilogue. Distances are
+ * PQ approximations of the indexed metric (including the final sqrt for the
+ * L2Sqrt variants).
+ *
+ * @tparam IdxT type of the returned source-row indices
+ * @param handle raft handle for managing expensive resources
+ * @param params search parameters
+ * @param idx the index built by `ivf_pq::build`
+ * @param queries the query points (size n_queries * idx.dim, row-major)
+ * @param n_queries number of queries
+ * @param k number of neighbors to return per query
+ * @param neighbors output neighbor indices (size n_queries * k)
+ * @param distances output neighbor distances (size n_queries * k)
+ */
+template <typename IdxT = int64_t>
+void search(const raft::handle_t& handle,
+            const search_params& params,
+            const index<IdxT>& idx,
+            const float* queries,
+            uint32_t n_queries,
+            uint32_t k,
+            IdxT* neighbors,
+            float* distances)
+{
+  detail::search<IdxT>(handle, params, idx, queries, n_queries, k, neighbors, distances);
+}
+
+}  // namespace ivf_pq
+}  // namespace knn
+}  // namespace spatial
+}  // namespace raft
+
+#endif
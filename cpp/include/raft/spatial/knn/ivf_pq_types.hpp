@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/distance/distance_type.hpp>
+#include <raft/handle.hpp>
+
+#include <rmm/device_uvector.hpp>
+
+#include <cstdint>
+
+namespace raft {
+namespace spatial {
+namespace knn {
+namespace ivf_pq {
+
+/** Parameters controlling `ivf_pq::build`. */
+struct index_params {
+  /** The number of inverted lists (coarse clusters). */
+  uint32_t n_lists = 1024;
+  /** The maximum number of k-means iterations (coarse and sub-quantizers). */
+  uint32_t kmeans_n_iters = 20;
+  /** The k-means convergence tolerance. */
+  double kmeans_tol = 1e-4;
+  /**
+   * The number of product-quantizer sub-spaces; must divide `dim`. When zero,
+   * dim / 4 is used.
+   */
+  uint32_t pq_dim = 0;
+};
+
+/** Parameters controlling `ivf_pq::search`. */
+struct search_params {
+  /** The number of inverted lists to probe per query. */
+  uint32_t n_probes = 20;
+};
+
+/**
+ * @brief An IVF-PQ index: a coarse quantizer plus per-list product-quantized
+ * residual codes.
+ *
+ * Codes are 8 bit (256 centers per sub-space), so each indexed row costs
+ * `pq_dim` bytes plus one entry of `indices`. All state lives in device
+ * memory owned by the index; movable, not copyable.
+ *
+ * @tparam IdxT type of the source-row indices returned by search
+ */
+template <typename IdxT = int64_t>
+struct index {
+  /** Number of centers per product-quantizer sub-space (8-bit codes). */
+  static constexpr uint32_t kPqCenters = 256;
+
+  /** Distance metric the index was built for. */
+  raft::distance::DistanceType metric;
+  /** Number of inverted lists. */
+  uint32_t n_lists;
+  /** Dimensionality of the input data. */
+  uint32_t dim;
+  /** Number of product-quantizer sub-spaces. */
+  uint32_t pq_dim;
+  /** Dimensionality of one sub-space (dim / pq_dim). */
+  uint32_t sub_dim;
+  /** Total number of indexed rows. */
+  IdxT size;
+  /** Cluster centers of the coarse quantizer [n_lists, dim]. */
+  rmm::device_uvector<float> centers;
+  /** Sub-quantizer codebooks [pq_dim, kPqCenters, sub_dim]. */
+  rmm::device_uvector<float> pq_centers;
+  /** Start of each inverted list within `codes`/`indices` [n_lists + 1]. */
+  rmm::device_uvector<IdxT> list_offsets;
+  /** PQ codes regrouped by list [size, pq_dim]. */
+  rmm::device_uvector<uint8_t> codes;
+  /** Source row id of each entry of `codes` [size]. */
+  rmm::device_uvector<IdxT> indices;
+
+  index(const raft::handle_t& handle,
+        raft::distance::DistanceType metric,
+        uint32_t n_lists,
+        uint32_t dim,
+        uint32_t pq_dim)
+    : metric(metric),
+      n_lists(n_lists),
+      dim(dim),
+      pq_dim(pq_dim),
+      sub_dim(dim / pq_dim),
+      size(0),
+      centers(static_cast<std::size_t>(n_lists) * dim, handle.get_stream()),
+      pq_centers(static_cast<std::size_t>(pq_dim) * kPqCenters * (dim / pq_dim),
+                 handle.get_stream()),
+      list_offsets(n_lists + 1, handle.get_stream()),
+      codes(0, handle.get_stream()),
+      indices(0, handle.get_stream())
+  {
+  }
+
+  index(index&&) = default;
+  index& operator=(index&&) = default;
+  index(const index&)       = delete;
+  index& operator=(const index&) = delete;
+};
+
+}  // namespace ivf_pq
+}  // namespace knn
+}  // namespace spatial
+}  // namespace raft
@@ -17,12 +17,16 @@
 #pragma once
 
 #include "detail/knn_brute_force_faiss.cuh"
+#include "detail/knn_vote.cuh"
+#include "detail/select_k_host.cuh"
 #include "detail/selection_faiss.cuh"
 
 #include "detail/topk/radix_topk.cuh"
 #include "detail/topk/warpsort_topk.cuh"
 
 #include <raft/common/nvtx.hpp>
+#include <raft/core/bitset.cuh>
+#include <raft/distance/norms_index.cuh>
 
 namespace raft::spatial::knn {
 
@@ -67,14 +71,24 @@ inline void knn_merge_parts(value_t* in_keys,
 
 /** Choose an implementation for the select-top-k, */
 enum class SelectKAlgo {
-  /** Adapted from the faiss project. Result: sorted (not stable). */
+  /**
+   * Adapted from the faiss project. For k <= 256 this is routed to the native
+   * warpsort kernels, which are faster there; only the large-k tail still
+   * runs the faiss block-select. Result: sorted (not stable).
+   */
   FAISS,
   /** Incomplete series of radix sort passes, comparing 8 bits per pass. Result: unsorted. */
   RADIX_8_BITS,
   /** Incomplete series of radix sort passes, comparing 11 bits per pass. Result: unsorted. */
   RADIX_11_BITS,
   /** Filtering with a bitonic-sort-based priority queue. Result: sorted (not stable). */
-  WARP_SORT
+  WARP_SORT,
+  /**
+   * OpenMP partial sort on the host, for microseconds-scale inputs where
+   * kernel launch + sync overhead exceeds the CPU computation (the inputs
+   * are copied to the host and the selection back). Result: sorted, stable.
+   */
+  HOST
 };
 
 /**
@@ -164,6 +178,11 @@ inline void select_k(const value_t* in_keys,
         in_keys, in_values, n_inputs, input_len, k, out_keys, out_values, select_min, stream);
       break;
 
+    case SelectKAlgo::HOST:
+      detail::select_k_host<value_t, idx_t>(
+        in_keys, in_values, n_inputs, input_len, out_keys, out_values, select_min, k, stream);
+      break;
+
     default: ASSERT(false, "Unknown algorithm (id = %d)", int(algo));
   }
 }
@@ -190,6 +209,16 @@ inline void select_k(const value_t* in_keys,
  * 					 is ignored if the metric_type is not Minkowski.
  * @param[in] translations starting offsets for partitions. should be the same size
  *            as input vector.
+ * @param[in] index_prenormalized the index arrays were already transformed once by
+ *            `prepare_brute_force_index` for this metric, so the per-call index
+ *            preprocessing pass (e.g. L2 row normalization for cosine) is skipped.
+ *            Queries are still preprocessed on every call.
+ * @param[in] lane execution lane hint. `HIGH_PRIORITY` runs the whole search on
+ *            the handle's greatest-priority stream (see
+ *            `handle_t::get_high_priority_stream`) so the hardware scheduler
+ *            preempts default-priority batch work in its favor; the
+ *            default-priority stream pool is not used in that case. The lane
+ *            is not ordered after the main stream, so inputs must be ready.
  */
 template <typename idx_t = std::int64_t, typename value_t = float, typename value_int = int>
 void brute_force_knn(raft::handle_t const& handle,
@@ -205,8 +234,14 @@ void brute_force_knn(raft::handle_t const& handle,
                      bool rowMajorQuery               = true,
                      std::vector<idx_t>* translations = nullptr,
                      distance::DistanceType metric    = distance::DistanceType::L2Unexpanded,
-                     float metric_arg                 = 2.0f)
+                     float metric_arg                 = 2.0f,
+                     bool index_prenormalized         = false,
+                     execution_lane lane              = execution_lane::DEFAULT)
 {
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "spatial::brute_force_knn-%d (%d, %d, %d)", int(metric), int(n), int(D), int(k));
+  profiling_scope prof_scope(
+    handle.get_profiler(), "brute_force_knn", handle.get_execution_stream(lane));
   ASSERT(input.size() == sizes.size(), "input and sizes vectors must be the same size");
 
   detail::brute_force_knn_impl(handle,
@@ -222,6 +257,416 @@ void brute_force_knn(raft::handle_t const& handle,
                                rowMajorQuery,
                                translations,
                                metric,
-                               metric_arg);
+                               metric_arg,
+                               index_prenormalized,
+                               lane);
+}
+
+/**
+ * @brief Brute force knn over an index resident in host memory, streamed to
+ * the device in double-buffered tiles.
+ *
+ * Meant for datasets too large for device memory: the index stays in host
+ * memory (allocate it pinned for async transfers) and is tiled H2D chunk by
+ * chunk, overlapping each chunk's transfer with the previous chunk's
+ * distance + select when the handle has a stream pool. The per-chunk top-k
+ * are merged into a running result, so device memory is bounded by the chunk
+ * size. Supports every pairwise distance metric except InnerProduct.
+ *
+ * @param[in] handle the cuml handle to use
+ * @param[in] host_index the index rows in host memory (size n_index_rows * D)
+ * @param[in] n_index_rows number of rows in the host index
+ * @param[in] D the dimensionality of the arrays
+ * @param[in] search_items device array of items to search of dimensionality D
+ * @param[in] n number of rows in search_items
+ * @param[out] res_I the resulting index array of size n * k
+ * @param[out] res_D the resulting distance array of size n * k
+ * @param[in] k the number of nearest neighbors to return
+ * @param[in] metric distance metric to use
+ * @param[in] metric_arg the value of `p` for Minkowski (l-p) distances
+ * @param[in] chunk_rows index rows per device tile
+ */
+template <typename idx_t = std::int64_t, typename value_t = float, typename value_int = int>
+void brute_force_knn_host(raft::handle_t const& handle,
+                          const value_t* host_index,
+                          idx_t n_index_rows,
+                          value_int D,
+                          const value_t* search_items,
+                          value_int n,
+                          idx_t* res_I,
+                          value_t* res_D,
+                          value_int k,
+                          distance::DistanceType metric = distance::DistanceType::L2Expanded,
+                          float metric_arg              = 2.0f,
+                          idx_t chunk_rows              = 65536)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "spatial::brute_force_knn_host-%d (%d, %d, %d)", int(metric), int(n), int(D), int(k));
+  detail::brute_force_knn_host_impl(handle,
+                                    host_index,
+                                    n_index_rows,
+                                    D,
+                                    search_items,
+                                    n,
+                                    res_I,
+                                    res_D,
+                                    k,
+                                    metric,
+                                    metric_arg,
+                                    chunk_rows);
+}
+
+/**
+ * @brief Brute force knn filtered by a device bitset over the index rows.
+ *
+ * For filtered search (deleted documents, tenant isolation) where a subset of
+ * the index must be excluded per query batch. The mask is tested inside the
+ * distance kernel's epilogue while the value is still in registers: masked
+ * rows surface at the max-distance sentinel and are never selected over a
+ * live candidate, so no compacted copy of the index is materialized and the
+ * O(n) thrust gather pass per batch disappears. Only row-major inputs are
+ * supported.
+ *
+ * If fewer than k index rows are unmasked, the tail of a result row is
+ * filled with sentinel (max) distances; check `res_D` before trusting the
+ * corresponding indices.
+ *
+ * @param[in] handle the cuml handle to use
+ * @param[in] index device array of index rows (size n_index_rows * D, row-major)
+ * @param[in] n_index_rows number of rows in the index
+ * @param[in] D the dimensionality of the arrays
+ * @param[in] search_items device array of items to search of dimensionality D
+ * @param[in] n number of rows in search_items
+ * @param[in] mask bitset over the index rows; cleared bit = filtered out
+ *            (see `raft::core::bitset`)
+ * @param[out] res_I the resulting index array of size n * k
+ * @param[out] res_D the resulting distance array of size n * k
+ * @param[in] k the number of nearest neighbors to return
+ * @param[in] metric distance metric to use
+ * @param[in] metric_arg the value of `p` for Minkowski (l-p) distances
+ * @param[in] chunk_rows index rows per distance tile
+ */
+template <typename idx_t = std::int64_t, typename value_t = float, typename value_int = int>
+void brute_force_knn_masked(raft::handle_t const& handle,
+                            const value_t* index,
+                            idx_t n_index_rows,
+                            value_int D,
+                            const value_t* search_items,
+                            value_int n,
+                            core::bitset_view<std::uint32_t> mask,
+                            idx_t* res_I,
+                            value_t* res_D,
+                            value_int k,
+                            distance::DistanceType metric = distance::DistanceType::L2Expanded,
+                            float metric_arg              = 2.0f,
+                            idx_t chunk_rows              = 65536)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "spatial::brute_force_knn_masked-%d (%d, %d, %d)", int(metric), int(n), int(D), int(k));
+  detail::brute_force_knn_masked_impl(handle,
+                                      index,
+                                      n_index_rows,
+                                      D,
+                                      search_items,
+                                      n,
+                                      mask,
+                                      res_I,
+                                      res_D,
+                                      k,
+                                      metric,
+                                      metric_arg,
+                                      chunk_rows);
+}
+
+/**
+ * @brief Apply the metric preprocessing to a static brute-force index once.
+ *
+ * For cosine and correlation, `brute_force_knn` normalizes the index arrays
+ * before every search (and reverts the transform afterwards) — two full passes
+ * over the index per query batch. When the index is static, this function
+ * applies the transform permanently instead: call it once after building the
+ * index, then pass `index_prenormalized = true` to `brute_force_knn`. The
+ * index arrays are modified in place and must not be used for other metrics
+ * afterwards. For metrics without preprocessing this is a no-op.
+ *
+ * @param[in] handle the cuml handle to use
+ * @param[inout] input vector of pointers to the index arrays, transformed in place
+ * @param[in] sizes vector of sizes of input arrays
+ * @param[in] D the dimensionality of the arrays
+ * @param[in] metric distance metric the index will be searched with
+ * @param[in] rowMajorIndex are the index arrays in row-major order?
+ */
+template <typename value_t = float, typename value_int = int>
+void prepare_brute_force_index(raft::handle_t const& handle,
+                               std::vector<value_t*>& input,
+                               std::vector<value_int>& sizes,
+                               value_int D,
+                               distance::DistanceType metric,
+                               bool rowMajorIndex = true)
+{
+  ASSERT(input.size() == sizes.size(), "input and sizes vectors must be the same size");
+  for (size_t i = 0; i < input.size(); i++) {
+    auto processor = create_processor<value_t>(
+      metric, sizes[i], D, /* k is unused during preprocessing */ 0, rowMajorIndex, handle.get_stream());
+    processor->preprocess(input[i]);
+  }
+}
+
+/**
+ * @brief Flat C++ API function to perform a brute force knn on int8 data.
+ *
+ * Quantized int8 vectors are searched directly: the fused L2 kNN kernel
+ * reduces four multiplies per dp4a instruction, so there is no need to
+ * dequantize to float up front. Only row-major inputs with the expanded L2
+ * metrics are supported; the dimensionality must be a multiple of 4 (pad with
+ * zeros otherwise). Distances are returned as float but computed exactly in
+ * int32.
+ *
+ * @param[in] handle the cuml handle to use
+ * @param[in] input vector of pointers to the int8 input arrays
+ * @param[in] sizes vector of sizes of input arrays
+ * @param[in] D the dimensionality of the arrays (must be a multiple of 4)
+ * @param[in] search_items array of items to search of dimensionality D
+ * @param[in] n number of rows in search_items
+ * @param[out] res_I the resulting index array of size n * k
+ * @param[out] res_D the resulting distance array of size n * k
+ * @param[in] k the number of nearest neighbors to return (at most 256, and
+ *            at most 64 on devices without opt-in shared memory beyond 48 KB;
+ *            see detail::fusedL2KnnMaxK)
+ * @param[in] translations starting offsets for partitions. should be the same
+ *            size as input vector.
+ * @param[in] metric one of the expanded L2 metrics
+ */
+template <typename idx_t = std::int64_t, typename value_int = int>
+void brute_force_knn(raft::handle_t const& handle,
+                     std::vector<int8_t*>& input,
+                     std::vector<value_int>& sizes,
+                     value_int D,
+                     int8_t* search_items,
+                     value_int n,
+                     idx_t* res_I,
+                     float* res_D,
+                     value_int k,
+                     std::vector<idx_t>* translations = nullptr,
+                     distance::DistanceType metric    = distance::DistanceType::L2Expanded)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "spatial::brute_force_knn-int8 (%d, %d, %d)", int(n), int(D), int(k));
+  ASSERT(input.size() == sizes.size(), "input and sizes vectors must be the same size");
+  ASSERT(k <= detail::fusedL2KnnMaxK(),
+         "int8 brute_force_knn: k exceeds the fused kernel limit on this device");
+
+  std::vector<idx_t>* id_ranges;
+  std::vector<idx_t> ranges;
+  if (translations == nullptr) {
+    idx_t total_n = 0;
+    for (size_t i = 0; i < input.size(); i++) {
+      ranges.push_back(total_n);
+      total_n += sizes[i];
+    }
+    id_ranges = &ranges;
+  } else {
+    id_ranges = translations;
+  }
+
+  auto userStream = handle.get_stream();
+  rmm::device_uvector<idx_t> trans(id_ranges->size(), userStream);
+  raft::update_device(trans.data(), id_ranges->data(), id_ranges->size(), userStream);
+
+  rmm::device_uvector<float> all_D(0, userStream);
+  rmm::device_uvector<idx_t> all_I(0, userStream);
+
+  float* out_D = res_D;
+  idx_t* out_I = res_I;
+  if (input.size() > 1) {
+    all_D.resize(input.size() * k * n, userStream);
+    all_I.resize(input.size() * k * n, userStream);
+    out_D = all_D.data();
+    out_I = all_I.data();
+  }
+
+  handle.wait_stream_pool_on_stream();
+  for (size_t i = 0; i < input.size(); i++) {
+    auto stream = handle.get_next_usable_stream(i);
+    detail::fusedL2Knn<idx_t>(static_cast<size_t>(D),
+                              out_I + (i * k * n),
+                              out_D + (i * k * n),
+                              input[i],
+                              search_items,
+                              static_cast<size_t>(sizes[i]),
+                              static_cast<size_t>(n),
+                              static_cast<int>(k),
+                              stream,
+                              metric);
+  }
+  handle.sync_stream_pool();
+
+  if (input.size() > 1 || translations != nullptr) {
+    knn_merge_parts(out_D,
+                    out_I,
+                    res_D,
+                    res_I,
+                    static_cast<size_t>(n),
+                    static_cast<int>(input.size()),
+                    static_cast<int>(k),
+                    userStream,
+                    trans.data());
+  }
+}
+
+/**
+ * @brief Flat C++ API function to perform a brute force knn against a
+ * norms-caching index.
+ *
+ * Variant of `brute_force_knn` for repeated query batches against a static
+ * dataset: the fused L2 kNN kernel consumes the dataset row norms precomputed
+ * by the `norms_index_t` instead of recomputing them for every batch. Falls
+ * back to the generic path (which cannot use the cached norms) when the fused
+ * kernel does not apply: k above the per-device fused kernel limit (see
+ * detail::fusedL2KnnMaxK), col-major layouts or a metric other than the
+ * expanded L2 ones.
+ *
+ * @param[in] handle the cuml handle to use
+ * @param[in] index norms-caching index built over the dataset
+ * @param[in] search_items array of items to search of dimensionality
+ *            index.n_cols()
+ * @param[in] n number of rows in search_items
+ * @param[out] res_I the resulting index array of size n * k
+ * @param[out] res_D the resulting distance array of size n * k
+ * @param[in] k the number of nearest neighbors to return
+ * @param[in] rowMajorQuery are the query arrays in row-major order?
+ */
+template <typename idx_t = std::int64_t, typename value_t = float, typename value_int = int>
+void brute_force_knn(raft::handle_t const& handle,
+                     const raft::distance::norms_index_t<value_t, value_int>& index,
+                     value_t* search_items,
+                     value_int n,
+                     idx_t* res_I,
+                     value_t* res_D,
+                     value_int k,
+                     bool rowMajorQuery = true)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "spatial::brute_force_knn-index (%d, %d, %d)", int(n), int(index.n_cols()), int(k));
+  auto metric = index.metric();
+  if (k <= detail::fusedL2KnnMaxK() && rowMajorQuery && index.is_row_major() &&
+      (metric == raft::distance::DistanceType::L2Expanded ||
+       metric == raft::distance::DistanceType::L2SqrtExpanded)) {
+    detail::fusedL2Knn<idx_t, value_t>(static_cast<size_t>(index.n_cols()),
+                                       res_I,
+                                       res_D,
+                                       index.data(),
+                                       search_items,
+                                       static_cast<size_t>(index.n_rows()),
+                                       static_cast<size_t>(n),
+                                       static_cast<int>(k),
+                                       true,
+                                       true,
+                                       handle.get_stream(),
+                                       metric,
+                                       index.norms());
+  } else {
+    std::vector<value_t*> input{const_cast<value_t*>(index.data())};
+    std::vector<value_int> sizes{index.n_rows()};
+    brute_force_knn<idx_t, value_t, value_int>(handle,
+                                               input,
+                                               sizes,
+                                               index.n_cols(),
+                                               search_items,
+                                               n,
+                                               res_I,
+                                               res_D,
+                                               k,
+                                               index.is_row_major(),
+                                               rowMajorQuery,
+                                               nullptr,
+                                               metric);
+  }
+}
+
+/**
+ * @brief Predict class labels by (optionally distance-weighted) majority vote
+ * over the k nearest neighbors.
+ *
+ * Consumes the device-resident index/distance arrays produced by
+ * `brute_force_knn` directly: the label gather, vote accumulation and argmax
+ * run in a single kernel, so no host round trip is needed between search and
+ * prediction. Ties resolve to the smallest class label.
+ *
+ * @param[in] handle the cuml handle to use
+ * @param[out] out predicted label per query row (size n_query_rows)
+ * @param[in] knn_indices neighbor indices from the kNN search
+ *            (size n_query_rows * k)
+ * @param[in] knn_dists neighbor distances from the kNN search
+ *            (size n_query_rows * k); only read when weighted
+ * @param[in] y training labels, indexed by the neighbor indices
+ * @param[in] unique_labels sorted array of the distinct labels in y (device);
+ *            see raft::label::getUniquelabels
+ * @param[in] n_unique number of distinct labels
+ * @param[in] n_query_rows number of query rows
+ * @param[in] k number of neighbors per query row
+ * @param[in] weighted weight each vote by the inverse neighbor distance
+ *            instead of counting every neighbor equally
+ */
+template <typename idx_t = std::int64_t, typename value_t = float, typename label_t = int>
+void knn_classify(raft::handle_t const& handle,
+                  label_t* out,
+                  const idx_t* knn_indices,
+                  const value_t* knn_dists,
+                  const label_t* y,
+                  const label_t* unique_labels,
+                  int n_unique,
+                  size_t n_query_rows,
+                  int k,
+                  bool weighted = false)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "spatial::knn_classify (%zu, %d, %d)", n_query_rows, k, n_unique);
+  ASSERT(n_unique > 0, "knn_classify: n_unique must be > 0");
+  detail::knn_classify(out,
+                       knn_indices,
+                       knn_dists,
+                       y,
+                       unique_labels,
+                       n_unique,
+                       n_query_rows,
+                       k,
+                       weighted,
+                       handle.get_stream());
+}
+
+/**
+ * @brief Predict a continuous target as the (optionally distance-weighted)
+ * mean over the k nearest neighbors.
+ *
+ * Like `knn_classify`, this consumes the device-resident kNN outputs in a
+ * single fused gather-and-reduce kernel.
+ *
+ * @param[in] handle the cuml handle to use
+ * @param[out] out predicted value per query row (size n_query_rows)
+ * @param[in] knn_indices neighbor indices from the kNN search
+ *            (size n_query_rows * k)
+ * @param[in] knn_dists neighbor distances from the kNN search
+ *            (size n_query_rows * k); only read when weighted
+ * @param[in] y training targets, indexed by the neighbor indices
+ * @param[in] n_query_rows number of query rows
+ * @param[in] k number of neighbors per query row
+ * @param[in] weighted weight each neighbor by its inverse distance instead of
+ *            averaging uniformly
+ */
+template <typename idx_t = std::int64_t, typename value_t = float>
+void knn_regress(raft::handle_t const& handle,
+                 value_t* out,
+                 const idx_t* knn_indices,
+                 const value_t* knn_dists,
+                 const value_t* y,
+                 size_t n_query_rows,
+                 int k,
+                 bool weighted = false)
+{
+  common::nvtx::range<common::nvtx::domain::raft> fun_scope(
+    "spatial::knn_regress (%zu, %d)", n_query_rows, k);
+  detail::knn_regress(
+    out, knn_indices, knn_dists, y, n_query_rows, k, weighted, handle.get_stream());
 }
 }  // namespace raft::spatial::knn
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __MG_KNN_H
+#define __MG_KNN_H
+
+#pragma once
+
+#include <raft/core/comms.hpp>
+#include <raft/core/event_pool.hpp>
+#include <raft/handle.hpp>
+#include <raft/spatial/knn/knn.cuh>
+
+#include <rmm/device_uvector.hpp>
+
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace raft {
+namespace spatial {
+namespace knn {
+
+/**
+ * @brief Multi-GPU brute-force k-nearest-neighbors over a sharded dataset.
+ *
+ * SPMD entry point: every rank of the communicator attached to the handle
+ * calls this with its own shard of the dataset and an identical copy of the
+ * queries, and every rank returns the full merged result. Per batch of
+ * queries, each rank searches its shard locally (indices translated to global
+ * row ids by the rank's shard offset), the per-rank top-k results are
+ * exchanged with an allgather, and `knn_merge_parts` reduces them to the
+ * final top-k.
+ *
+ * When `batch_size` splits the queries into more than one batch and the
+ * handle has a stream pool, the result exchange and merge of one batch run on
+ * a pool stream while the next batch's local search proceeds on the main
+ * stream, overlapping compute with communication.
+ *
+ * Global row ids follow the rank order of the communicator: rank r owns rows
+ * [sum of shard sizes of ranks < r, ... + n_shard_rows).
+ *
+ * @tparam idx_t the type of the output indices
+ * @tparam value_t the element type
+ * @param handle raft handle with an initialized communicator
+ * @param shard this rank's dataset shard (size n_shard_rows * D, row-major)
+ * @param n_shard_rows number of rows in the local shard
+ * @param D dimensionality
+ * @param search_items the query points, identical on every rank (size n * D)
+ * @param n number of queries
+ * @param res_I output neighbor indices in global row ids (size n * k)
+ * @param res_D output neighbor distances (size n * k)
+ * @param k the number of nearest neighbors to return
+ * @param metric distance metric to use
+ * @param batch_size number of queries per pipeline batch; 0 processes all
+ * queries in a single batch (no overlap)
+ */
+template <typename idx_t = std::int64_t, typename value_t = float>
+void mg_brute_force_knn(const raft::handle_t& handle,
+                        const value_t* shard,
+                        idx_t n_shard_rows,
+                        int D,
+                        value_t* search_items,
+                        idx_t n,
+                        idx_t* res_I,
+                        value_t* res_D,
+                        int k,
+                        distance::DistanceType metric = distance::DistanceType::L2Expanded,
+                        idx_t batch_size              = 0)
+{
+  auto stream = handle.get_stream();
+
+  std::vector<value_t*> input{const_cast<value_t*>(shard)};
+  std::vector<int> sizes{static_cast<int>(n_shard_rows)};
+
+  if (!handle.comms_initialized()) {
+    brute_force_knn<idx_t, value_t, int>(
+      handle, input, sizes, D, search_items, n, res_I, res_D, k, true, true, nullptr, metric);
+    return;
+  }
+  const auto& comm  = handle.get_comms();
+  const int n_ranks = comm.get_size();
+  if (n_ranks == 1) {
+    brute_force_knn<idx_t, value_t, int>(
+      handle, input, sizes, D, search_items, n, res_I, res_D, k, true, true, nullptr, metric);
+    return;
+  }
+
+  // shard sizes -> global row-id offset of this rank
+  rmm::device_uvector<idx_t> d_sizes(n_ranks, stream);
+  rmm::device_uvector<idx_t> d_my_size(1, stream);
+  raft::update_device(d_my_size.data(), &n_shard_rows, 1, stream);
+  comm.allgather(d_my_size.data(), d_sizes.data(), 1, stream);
+  std::vector<idx_t> h_sizes(n_ranks);
+  raft::update_host(h_sizes.data(), d_sizes.data(), n_ranks, stream);
+  ASSERT(comm.sync_stream(stream) == comms::status_t::SUCCESS, "shard size exchange failed");
+  std::vector<idx_t> translations{
+    std::accumulate(h_sizes.begin(), h_sizes.begin() + comm.get_rank(), idx_t(0))};
+
+  if (batch_size <= 0 || batch_size > n) { batch_size = n; }
+  cudaStream_t comm_stream =
+    handle.get_stream_pool_size() > 0 ? (cudaStream_t)handle.get_stream_from_stream_pool(0)
+                                      : (cudaStream_t)stream;
+
+  const std::size_t batch_res = static_cast<std::size_t>(batch_size) * k;
+  rmm::device_uvector<value_t> local_D[2] = {{batch_res, stream}, {batch_res, stream}};
+  rmm::device_uvector<idx_t> local_I[2]   = {{batch_res, stream}, {batch_res, stream}};
+  rmm::device_uvector<value_t> all_D[2]   = {{batch_res * n_ranks, stream},
+                                             {batch_res * n_ranks, stream}};
+  rmm::device_uvector<idx_t> all_I[2]     = {{batch_res * n_ranks, stream},
+                                             {batch_res * n_ranks, stream}};
+  // local indices are already global, so the merge needs no further shift
+  rmm::device_uvector<idx_t> zero_trans(n_ranks, stream);
+  RAFT_CUDA_TRY(cudaMemsetAsync(zero_trans.data(), 0, n_ranks * sizeof(idx_t), stream));
+
+  // checked out of the handle's pool instead of created per call
+  auto& event_pool = handle.get_event_pool();
+  pooled_event search_done[2] = {pooled_event(event_pool), pooled_event(event_pool)};
+  pooled_event merge_done[2]  = {pooled_event(event_pool), pooled_event(event_pool)};
+
+  std::size_t b = 0;
+  for (idx_t off = 0; off < n; off += batch_size, b++) {
+    idx_t bn = std::min<idx_t>(batch_size, n - off);
+    int slot = b % 2;
+    // the slot's buffers are free once the exchange+merge two batches ago
+    // has finished
+    if (b >= 2) { RAFT_CUDA_TRY(cudaStreamWaitEvent(stream, merge_done[slot], 0)); }
+
+    brute_force_knn<idx_t, value_t, int>(handle,
+                                         input,
+                                         sizes,
+                                         D,
+                                         search_items + static_cast<std::size_t>(off) * D,
+                                         static_cast<int>(bn),
+                                         local_I[slot].data(),
+                                         local_D[slot].data(),
+                                         k,
+                                         true,
+                                         true,
+                                         &translations,
+                                         metric);
+    RAFT_CUDA_TRY(cudaEventRecord(search_done[slot], stream));
+    RAFT_CUDA_TRY(cudaStreamWaitEvent(comm_stream, search_done[slot], 0));
+
+    const std::size_t res_count = static_cast<std::size_t>(bn) * k;
+    comm.allgather(local_D[slot].data(), all_D[slot].data(), res_count, comm_stream);
+    comm.allgather(local_I[slot].data(), all_I[slot].data(), res_count, comm_stream);
+    knn_merge_parts<value_t, idx_t>(all_D[slot].data(),
+                                    all_I[slot].data(),
+                                    res_D + static_cast<std::size_t>(off) * k,
+                                    res_I + static_cast<std::size_t>(off) * k,
+                                    bn,
+                                    n_ranks,
+                                    k,
+                                    comm_stream,
+                                    zero_trans.data());
+    RAFT_CUDA_TRY(cudaEventRecord(merge_done[slot], comm_stream));
+  }
+
+  // the caller's stream observes all merged results; sync the collectives
+  // through the communicator so failures propagate instead of deadlocking
+  for (int s = 0; s < 2; s++) {
+    RAFT_CUDA_TRY(cudaStreamWaitEvent(stream, merge_done[s], 0));
+  }
+  ASSERT(comm.sync_stream(comm_stream) == comms::status_t::SUCCESS, "knn result exchange failed");
+}
+
+}  // namespace knn
+}  // namespace spatial
+}  // namespace raft
+
+#endif
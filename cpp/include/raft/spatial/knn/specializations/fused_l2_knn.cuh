@@ -33,7 +33,8 @@ extern template void fusedL2Knn<long, float, true>(size_t D,
                                                    bool rowMajorIndex,
                                                    bool rowMajorQuery,
                                                    cudaStream_t stream,
-                                                   raft::distance::DistanceType metric);
+                                                   raft::distance::DistanceType metric,
+                                                   const float* index_norms);
 
 extern template void fusedL2Knn<long, float, false>(size_t D,
                                                     long* out_inds,
@@ -46,7 +47,8 @@ extern template void fusedL2Knn<long, float, false>(size_t D,
                                                     bool rowMajorIndex,
                                                     bool rowMajorQuery,
                                                     cudaStream_t stream,
-                                                    raft::distance::DistanceType metric);
+                                                    raft::distance::DistanceType metric,
+                                                    const float* index_norms);
 
 extern template void fusedL2Knn<int, float, true>(size_t D,
                                                   int* out_inds,
@@ -59,7 +61,8 @@ extern template void fusedL2Knn<int, float, true>(size_t D,
                                                   bool rowMajorIndex,
                                                   bool rowMajorQuery,
                                                   cudaStream_t stream,
-                                                  raft::distance::DistanceType metric);
+                                                  raft::distance::DistanceType metric,
+                                                  const float* index_norms);
 
 extern template void fusedL2Knn<int, float, false>(size_t D,
                                                    int* out_inds,
@@ -72,7 +75,8 @@ extern template void fusedL2Knn<int, float, false>(size_t D,
                                                    bool rowMajorIndex,
                                                    bool rowMajorQuery,
                                                    cudaStream_t stream,
-                                                   raft::distance::DistanceType metric);
+                                                   raft::distance::DistanceType metric,
+                                                   const float* index_norms);
 
 };  // namespace detail
 };  // namespace knn
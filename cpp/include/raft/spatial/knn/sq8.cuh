@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __SQ8_H
+#define __SQ8_H
+
+#pragma once
+
+#include <raft/spatial/knn/detail/sq8.cuh>
+#include <raft/spatial/knn/sq8_types.hpp>
+
+namespace raft {
+namespace spatial {
+namespace knn {
+namespace sq8 {
+
+/**
+ * @brief Build a flat 8-bit scalar quantized (SQ8) index over a row-major
+ * dataset.
+ *
+ * Trains a per-dimension affine quantizer (min and step) on the dataset and
+ * stores the rows as one byte per dimension — a 4x memory reduction over
+ * float32. Unlike the faiss ScalarQuantizer route in `approx_knn_*`, training,
+ * encoding and search all run as native kernels on the handle's stream with
+ * no copies across a library boundary.
+ *
+ * Supported metrics: the L2 family and InnerProduct.
+ *
+ * @tparam IdxT type of the source-row indices reported by search
+ * @param handle raft handle for managing expensive resources
+ * @param dataset the input data (size n_rows * dim, row-major)
+ * @param n_rows number of rows in the dataset
+ * @param dim dimensionality
+ * @param metric distance metric to build the index for
+ * @return the constructed index
+ */
+template <typename IdxT = int64_t>
+auto build(const raft::handle_t& handle,
+           const float* dataset,
+           IdxT n_rows,
+           uint32_t dim,
+           raft::distance::DistanceType metric = raft::distance::DistanceType::L2Expanded)
+  -> index<IdxT>
+{
+  return detail::build<IdxT>(handle, dataset, n_rows, dim, metric);
+}
+
+/**
+ * @brief Find the k nearest neighbors of the queries in a flat SQ8 index by
+ * exhaustive scan.
+ *
+ * The codes are dequantized on the fly inside a tiled distance kernel, so the
+ * search touches only one byte per dimension of index memory. Distances are
+ * computed against the dequantized values; the quantization error (up to half
+ * a step per dimension) is the only difference from a float32 brute-force
+ * search. The index is scanned in bounded chunks, so memory usage does not
+ * grow with the index size.
+ *
+ * @tparam IdxT type of the returned source-row indices
+ * @param handle raft handle for managing expensive resources
+ * @param idx the index built by `sq8::build`
+ * @param queries the query points (size n_queries * idx.dim, row-major)
+ * @param n_queries number of queries
+ * @param k number of neighbors to return per query
+ * @param neighbors output neighbor indices (size n_queries * k)
+ * @param distances output neighbor distances (size n_queries * k)
+ */
+template <typename IdxT = int64_t>
+void search(const raft::handle_t& handle,
+            const index<IdxT>& idx,
+            const float* queries,
+            uint32_t n_queries,
+            uint32_t k,
+            IdxT* neighbors,
+            float* distances)
+{
+  detail::search<IdxT>(handle, idx, queries, n_queries, k, neighbors, distances);
+}
+
+/**
+ * @brief Build an IVF index whose inverted lists store SQ8 codes.
+ *
+ * The coarse quantizer is trained exactly as in `ivf_flat::build` (and kept
+ * in full precision); the regrouped list entries are then scalar-quantized to
+ * one byte per dimension. For a large corpus this cuts the dominant memory
+ * cost of the index by 4x at the price of the SQ8 quantization error in the
+ * fine distances.
+ *
+ * @tparam IdxT type of the source-row indices reported by search
+ * @param handle raft handle for managing expensive resources
+ * @param params index building parameters (shared with `ivf_flat::build`)
+ * @param dataset the input data (size n_rows * dim, row-major)
+ * @param n_rows number of rows in the dataset
+ * @param dim dimensionality
+ * @param metric distance metric to build the index for
+ * @return the constructed index
+ */
+template <typename IdxT = int64_t>
+auto build_ivf(const raft::handle_t& handle,
+               const ivf_flat::index_params& params,
+               const float* dataset,
+               IdxT n_rows,
+               uint32_t dim,
+               raft::distance::DistanceType metric = raft::distance::DistanceType::L2Expanded)
+  -> ivf_index<IdxT>
+{
+  return detail::build_ivf<IdxT>(handle, params, dataset, n_rows, dim, metric);
+}
+
+/**
+ * @brief Find the approximate k nearest neighbors of the queries in an SQ8
+ * IVF index.
+ *
+ * The probe selection is identical to `ivf_flat::search`; the probed lists
+ * are scanned with a dequantizing kernel. Distances come back in the metric
+ * the index was built for (including the final sqrt for the L2Sqrt variants).
+ *
+ * @tparam IdxT type of the returned source-row indices
+ * @param handle raft handle for managing expensive resources
+ * @param params search parameters (shared with `ivf_flat::search`)
+ * @param idx the index built by `sq8::build_ivf`
+ * @param queries the query points (size n_queries * idx.dim, row-major)
+ * @param n_queries number of queries
+ * @param k number of neighbors to return per query
+ * @param neighbors output neighbor indices (size n_queries * k)
+ * @param distances output neighbor distances (size n_queries * k)
+ */
+template <typename IdxT = int64_t>
+void search_ivf(const raft::handle_t& handle,
+                const ivf_flat::search_params& params,
+                const ivf_index<IdxT>& idx,
+                const float* queries,
+                uint32_t n_queries,
+                uint32_t k,
+                IdxT* neighbors,
+                float* distances)
+{
+  detail::search_ivf<IdxT>(handle, params, idx, queries, n_queries, k, neighbors, distances);
+}
+
+}  // namespace sq8
+}  // namespace knn
+}  // namespace spatial
+}  // namespace raft
+
+#endif
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/distance/distance_type.hpp>
+#include <raft/handle.hpp>
+
+#include <rmm/device_uvector.hpp>
+
+#include <cstdint>
+
+namespace raft {
+namespace spatial {
+namespace knn {
+namespace sq8 {
+
+/**
+ * @brief An 8-bit scalar quantized (SQ8) flat index.
+ *
+ * Each dimension is quantized independently with an affine transform trained
+ * on the dataset: `value = vmin[j] + scale[j] * code`, with the codes stored
+ * as one byte per dimension — a 4x memory reduction over float32. Search
+ * dequantizes on the fly, so only the codes are kept in device memory.
+ *
+ * All state lives in device memory owned by the index. The structure is
+ * movable but not copyable, like the rmm containers it holds.
+ *
+ * @tparam IdxT type of the source-row indices returned by search
+ */
+template <typename IdxT = int64_t>
+struct index {
+  /** Distance metric the index was built for. */
+  raft::distance::DistanceType metric;
+  /** Dimensionality of the data. */
+  uint32_t dim;
+  /** Total number of indexed rows. */
+  IdxT size;
+  /** Per-dimension minimum of the training data [dim]. */
+  rmm::device_uvector<float> vmin;
+  /** Per-dimension quantization step [dim]. */
+  rmm::device_uvector<float> scale;
+  /** Quantized dataset rows [size, dim]. */
+  rmm::device_uvector<uint8_t> codes;
+
+  index(const raft::handle_t& handle, raft::distance::DistanceType metric, uint32_t dim)
+    : metric(metric),
+      dim(dim),
+      size(0),
+      vmin(dim, handle.get_stream()),
+      scale(dim, handle.get_stream()),
+      codes(0, handle.get_stream())
+  {
+  }
+
+  index(index&&) = default;
+  index& operator=(index&&) = default;
+  index(const index&)       = delete;
+  index& operator=(const index&) = delete;
+};
+
+/**
+ * @brief An IVF index with SQ8-compressed inverted lists.
+ *
+ * Same layout as `ivf_flat::index`, except the list entries are stored as
+ * one-byte SQ8 codes instead of full-precision elements; the coarse cluster
+ * centers stay in float32 since they are tiny. See `sq8::index` for the
+ * quantizer itself.
+ *
+ * @tparam IdxT type of the source-row indices returned by search
+ */
+template <typename IdxT = int64_t>
+struct ivf_index {
+  /** Distance metric the index was built for. */
+  raft::distance::DistanceType metric;
+  /** Number of inverted lists. */
+  uint32_t n_lists;
+  /** Dimensionality of the data. */
+  uint32_t dim;
+  /** Total number of indexed rows. */
+  IdxT size;
+  /** Cluster centers of the coarse quantizer [n_lists, dim], full precision. */
+  rmm::device_uvector<float> centers;
+  /** Per-dimension minimum of the training data [dim]. */
+  rmm::device_uvector<float> vmin;
+  /** Per-dimension quantization step [dim]. */
+  rmm::device_uvector<float> scale;
+  /** Start of each inverted list within `codes`/`indices` [n_lists + 1]. */
+  rmm::device_uvector<IdxT> list_offsets;
+  /** Quantized dataset rows regrouped by list [size, dim]. */
+  rmm::device_uvector<uint8_t> codes;
+  /** Source row id of each entry of `codes` [size]. */
+  rmm::device_uvector<IdxT> indices;
+
+  ivf_index(const raft::handle_t& handle,
+            raft::distance::DistanceType metric,
+            uint32_t n_lists,
+            uint32_t dim)
+    : metric(metric),
+      n_lists(n_lists),
+      dim(dim),
+      size(0),
+      centers(0, handle.get_stream()),
+      vmin(dim, handle.get_stream()),
+      scale(dim, handle.get_stream()),
+      list_offsets(0, handle.get_stream()),
+      codes(0, handle.get_stream()),
+      indices(0, handle.get_stream())
+  {
+  }
+
+  ivf_index(ivf_index&&) = default;
+  ivf_index& operator=(ivf_index&&) = default;
+  ivf_index(const ivf_index&)       = delete;
+  ivf_index& operator=(const ivf_index&) = delete;
+};
+
+}  // namespace sq8
+}  // namespace knn
+}  // namespace spatial
+}  // namespace raft
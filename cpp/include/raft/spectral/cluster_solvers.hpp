@@ -42,6 +42,11 @@ struct cluster_solver_config_t {
   value_type_t tol;
 
   unsigned long long seed{123456};
+
+  // problems with n_obs_vecs * dim at or below this threshold run in a
+  // single persistent kernel (launch overhead dominates there); set to 0
+  // to always use the standard multi-kernel solver
+  size_type_t persistentThreshold{1 << 20};
 };
 
 template <typename index_type_t, typename value_type_t, typename size_type_t = index_type_t>
@@ -63,17 +68,34 @@ struct kmeans_solver_t {
     value_type_t residual{};
     index_type_t iters{};
 
-    raft::cluster::kmeans(handle,
-                          n_obs_vecs,
-                          dim,
-                          config_.n_clusters,
-                          config_.tol,
-                          config_.maxIter,
-                          obs,
-                          codes,
-                          residual,
-                          iters,
-                          config_.seed);
+    // spectral embeddings are small (n x k with small k), so launch
+    // overhead dominates the standard solver; dispatch those to the
+    // persistent-kernel solver
+    if (n_obs_vecs * dim <= config_.persistentThreshold) {
+      raft::cluster::kmeans_persistent(handle,
+                                       n_obs_vecs,
+                                       dim,
+                                       config_.n_clusters,
+                                       config_.tol,
+                                       config_.maxIter,
+                                       obs,
+                                       codes,
+                                       residual,
+                                       iters,
+                                       config_.seed);
+    } else {
+      raft::cluster::kmeans(handle,
+                            n_obs_vecs,
+                            dim,
+                            config_.n_clusters,
+                            config_.tol,
+                            config_.maxIter,
+                            obs,
+                            codes,
+                            residual,
+                            iters,
+                            config_.seed);
+    }
     return std::make_pair(residual, iters);
   }
 
@@ -0,0 +1,490 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <memory>
+
+#include <cuda.h>
+#include <thrust/binary_search.h>
+#include <thrust/device_ptr.h>
+#include <thrust/functional.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/zip_iterator.h>
+#include <thrust/reduce.h>
+#include <thrust/sort.h>
+#include <thrust/transform.h>
+#include <thrust/tuple.h>
+#include <thrust/unique.h>
+
+#include <raft/cudart_utils.h>
+#include <raft/handle.hpp>
+#include <raft/sparse/convert/csr.cuh>
+#include <raft/spectral/detail/warn_dbg.hpp>
+#include <raft/spectral/matrix_wrappers.hpp>
+
+namespace raft {
+namespace spectral {
+namespace detail {
+
+// =========================================================
+// Graph coarsening (heavy-edge matching contraction)
+// =========================================================
+
+/**
+ *  @brief Propose the heaviest neighbor of each vertex as its match.
+ *    Self-loops are ignored; ties are broken towards the smaller
+ *    vertex index. Isolated vertices propose themselves.
+ *  @tparam vertex_t the type of data used for indexing.
+ *  @tparam weight_t the type of data used for edge weights.
+ *  @param n Number of vertices.
+ *  @param row_offsets (Input, n+1 entries) CSR row offsets.
+ *  @param col_indices (Input, nnz entries) CSR column indices.
+ *  @param values (Input, nnz entries) CSR edge weights.
+ *  @param proposal (Output, n entries) Proposed match per vertex.
+ */
+template <typename vertex_t, typename weight_t>
+static __global__ void matchProposals(vertex_t n,
+                                      const vertex_t* __restrict__ row_offsets,
+                                      const vertex_t* __restrict__ col_indices,
+                                      const weight_t* __restrict__ values,
+                                      vertex_t* __restrict__ proposal)
+{
+  vertex_t i = threadIdx.x + blockIdx.x * blockDim.x;
+  while (i < n) {
+    vertex_t best = i;
+    weight_t bestWeight = 0;
+    for (vertex_t e = row_offsets[i]; e < row_offsets[i + 1]; ++e) {
+      vertex_t j = col_indices[e];
+      if (j == i) continue;
+      weight_t w = values[e];
+      if (w > bestWeight || (w == bestWeight && best != i && j < best)) {
+        bestWeight = w;
+        best       = j;
+      }
+    }
+    proposal[i] = best;
+    i += blockDim.x * gridDim.x;
+  }
+}
+
+/**
+ *  @brief Resolve match proposals with a handshake.
+ *    A pair (i,j) is matched iff both proposed each other; every other
+ *    vertex stays a singleton. Both endpoints of a matched pair compute
+ *    the same result, so no synchronization is needed.
+ *  @tparam vertex_t the type of data used for indexing.
+ *  @param n Number of vertices.
+ *  @param proposal (Input, n entries) Proposed match per vertex.
+ *  @param match (Output, n entries) Matched partner, or the vertex
+ *    itself if unmatched.
+ */
+template <typename vertex_t>
+static __global__ void matchResolve(vertex_t n,
+                                    const vertex_t* __restrict__ proposal,
+                                    vertex_t* __restrict__ match)
+{
+  vertex_t i = threadIdx.x + blockIdx.x * blockDim.x;
+  while (i < n) {
+    vertex_t j = proposal[i];
+    match[i]   = (j != i && proposal[j] == i) ? j : i;
+    i += blockDim.x * gridDim.x;
+  }
+}
+
+/**
+ *  @brief Map each edge endpoint to its coarse vertex.
+ *    The resulting COO keeps self-loops (contracted matched edges), so
+ *    the coarse graph preserves vertex degree masses and hence the
+ *    modularity objective.
+ *  @tparam vertex_t the type of data used for indexing.
+ *  @param n Number of fine vertices.
+ *  @param row_offsets (Input, n+1 entries) Fine CSR row offsets.
+ *  @param col_indices (Input, nnz entries) Fine CSR column indices.
+ *  @param map (Input, n entries) Fine-to-coarse vertex map.
+ *  @param rows_out (Output, nnz entries) Coarse COO row indices.
+ *  @param cols_out (Output, nnz entries) Coarse COO column indices.
+ */
+template <typename vertex_t>
+static __global__ void mapEdgeEndpoints(vertex_t n,
+                                        const vertex_t* __restrict__ row_offsets,
+                                        const vertex_t* __restrict__ col_indices,
+                                        const vertex_t* __restrict__ map,
+                                        vertex_t* __restrict__ rows_out,
+                                        vertex_t* __restrict__ cols_out)
+{
+  vertex_t i = threadIdx.x + blockIdx.x * blockDim.x;
+  while (i < n) {
+    vertex_t c = map[i];
+    for (vertex_t e = row_offsets[i]; e < row_offsets[i + 1]; ++e) {
+      rows_out[e] = c;
+      cols_out[e] = map[col_indices[e]];
+    }
+    i += blockDim.x * gridDim.x;
+  }
+}
+
+/**
+ *  @brief Compute weighted vertex degrees (row sums).
+ *  @tparam vertex_t the type of data used for indexing.
+ *  @tparam weight_t the type of data used for edge weights.
+ *  @param n Number of vertices.
+ *  @param row_offsets (Input, n+1 entries) CSR row offsets.
+ *  @param values (Input, nnz entries) CSR edge weights.
+ *  @param degrees (Output, n entries) Weighted degree per vertex.
+ */
+template <typename vertex_t, typename weight_t>
+static __global__ void vertexDegrees(vertex_t n,
+                                     const vertex_t* __restrict__ row_offsets,
+                                     const weight_t* __restrict__ values,
+                                     weight_t* __restrict__ degrees)
+{
+  vertex_t i = threadIdx.x + blockIdx.x * blockDim.x;
+  while (i < n) {
+    weight_t sum = 0;
+    for (vertex_t e = row_offsets[i]; e < row_offsets[i + 1]; ++e)
+      sum += values[e];
+    degrees[i] = sum;
+    i += blockDim.x * gridDim.x;
+  }
+}
+
+/**
+ *  @brief Accumulate weighted degrees per community.
+ *  @tparam vertex_t the type of data used for indexing.
+ *  @tparam weight_t the type of data used for edge weights.
+ *  @param n Number of vertices.
+ *  @param degrees (Input, n entries) Weighted degree per vertex.
+ *  @param clusters (Input, n entries) Cluster assignments.
+ *  @param commDegrees (Output, k entries) Weighted degree per
+ *    community. Entries must be initialized to zero.
+ */
+template <typename vertex_t, typename weight_t>
+static __global__ void communityDegrees(vertex_t n,
+                                        const weight_t* __restrict__ degrees,
+                                        const vertex_t* __restrict__ clusters,
+                                        weight_t* __restrict__ commDegrees)
+{
+  vertex_t i = threadIdx.x + blockIdx.x * blockDim.x;
+  while (i < n) {
+    atomicAdd(commDegrees + clusters[i], degrees[i]);
+    i += blockDim.x * gridDim.x;
+  }
+}
+
+/**
+ *  @brief One local-moving refinement sweep.
+ *    Block-per-vertex: threads accumulate the vertex's edge weight
+ *    towards each community into shared memory, then the best
+ *    modularity gain over all k communities decides the new
+ *    assignment. All moves in a sweep are evaluated against the
+ *    incoming assignment (Jacobi style); community degrees are
+ *    recomputed on the host between sweeps.
+ *  @tparam vertex_t the type of data used for indexing.
+ *  @tparam weight_t the type of data used for edge weights.
+ *  @param n Number of vertices.
+ *  @param k Number of communities.
+ *  @param row_offsets (Input, n+1 entries) CSR row offsets.
+ *  @param col_indices (Input, nnz entries) CSR column indices.
+ *  @param values (Input, nnz entries) CSR edge weights.
+ *  @param degrees (Input, n entries) Weighted degree per vertex.
+ *  @param commDegrees (Input, k entries) Weighted degree per
+ *    community under the incoming assignment.
+ *  @param twoM Total edge weight (sum of all weighted degrees).
+ *  @param clusters (Input, n entries) Incoming cluster assignments.
+ *  @param clusters_out (Output, n entries) Refined assignments.
+ *  @param moved (Output, 1 entry) Number of vertices that changed
+ *    community. Entry must be initialized to zero.
+ */
+template <typename vertex_t, typename weight_t>
+static __global__ void refineSweep(vertex_t n,
+                                   vertex_t k,
+                                   const vertex_t* __restrict__ row_offsets,
+                                   const vertex_t* __restrict__ col_indices,
+                                   const weight_t* __restrict__ values,
+                                   const weight_t* __restrict__ degrees,
+                                   const weight_t* __restrict__ commDegrees,
+                                   weight_t twoM,
+                                   const vertex_t* __restrict__ clusters,
+                                   vertex_t* __restrict__ clusters_out,
+                                   vertex_t* __restrict__ moved)
+{
+  extern __shared__ unsigned char refine_smem[];
+  weight_t* wComm = reinterpret_cast<weight_t*>(refine_smem);
+
+  for (vertex_t v = blockIdx.x; v < n; v += gridDim.x) {
+    for (vertex_t c = threadIdx.x; c < k; c += blockDim.x)
+      wComm[c] = 0;
+    __syncthreads();
+
+    for (vertex_t e = row_offsets[v] + threadIdx.x; e < row_offsets[v + 1]; e += blockDim.x) {
+      vertex_t j = col_indices[e];
+      if (j != v) atomicAdd(wComm + clusters[j], values[e]);
+    }
+    __syncthreads();
+
+    if (threadIdx.x == 0) {
+      vertex_t cur  = clusters[v];
+      vertex_t best = cur;
+      weight_t bestGain =
+        wComm[cur] - degrees[v] * (commDegrees[cur] - degrees[v]) / twoM;
+      for (vertex_t c = 0; c < k; ++c) {
+        if (c == cur) continue;
+        weight_t gain = wComm[c] - degrees[v] * commDegrees[c] / twoM;
+        if (gain > bestGain) {
+          bestGain = gain;
+          best     = c;
+        }
+      }
+      clusters_out[v] = best;
+      if (best != cur) atomicAdd(moved, 1);
+    }
+    __syncthreads();
+  }
+}
+
+/**
+ *  @brief One level of heavy-edge matching graph contraction.
+ *    Each vertex proposes its heaviest neighbor; mutual proposals are
+ *    contracted into a coarse vertex, everything else stays a
+ *    singleton. The coarse CSR aggregates parallel edges and keeps
+ *    self-loops so degree masses (and the modularity objective) are
+ *    preserved.
+ *  @tparam vertex_t the type of data used for indexing.
+ *  @tparam weight_t the type of data used for edge weights.
+ */
+template <typename vertex_t, typename weight_t>
+struct coarse_level_t {
+  coarse_level_t(handle_t const& handle, vertex_t n_fine, vertex_t n_coarse, vertex_t nnz)
+    : map(handle, n_fine),
+      row_offsets(handle, n_coarse + 1),
+      col_indices(handle, nnz),
+      values(handle, nnz),
+      n_coarse_(n_coarse),
+      nnz_(nnz)
+  {
+  }
+
+  matrix::vector_t<vertex_t> map;  // fine vertex -> coarse vertex
+  matrix::vector_t<vertex_t> row_offsets;
+  matrix::vector_t<vertex_t> col_indices;
+  matrix::vector_t<weight_t> values;
+  vertex_t n_coarse_;
+  vertex_t nnz_;
+};
+
+/**
+ *  @brief Contract a graph by one heavy-edge matching level.
+ *  @tparam vertex_t the type of data used for indexing.
+ *  @tparam weight_t the type of data used for edge weights.
+ *  @param handle the raft handle.
+ *  @param n Number of vertices.
+ *  @param nnz Number of edges (CSR entries).
+ *  @param row_offsets (Input, device memory, n+1 entries) CSR row
+ *    offsets.
+ *  @param col_indices (Input, device memory, nnz entries) CSR column
+ *    indices.
+ *  @param values (Input, device memory, nnz entries) CSR edge weights.
+ *  @return the coarse level (fine-to-coarse map plus coarse CSR).
+ */
+template <typename vertex_t, typename weight_t>
+std::unique_ptr<coarse_level_t<vertex_t, weight_t>> coarsen_graph(
+  handle_t const& handle,
+  vertex_t n,
+  vertex_t nnz,
+  const vertex_t* __restrict__ row_offsets,
+  const vertex_t* __restrict__ col_indices,
+  const weight_t* __restrict__ values)
+{
+  auto stream             = handle.get_stream();
+  auto thrust_exec_policy = handle.get_thrust_policy();
+
+  constexpr unsigned int blockSize = 256;
+  unsigned int gridSize = std::min(65535u, (static_cast<unsigned>(n) + blockSize - 1) / blockSize);
+
+  // Heavy-edge matching: propose, handshake, label pairs by their
+  // smaller endpoint
+  matrix::vector_t<vertex_t> proposal(handle, n);
+  matrix::vector_t<vertex_t> labels(handle, n);
+  matchProposals<<<gridSize, blockSize, 0, stream>>>(
+    n, row_offsets, col_indices, values, proposal.raw());
+  RAFT_CHECK_CUDA(stream);
+  matchResolve<<<gridSize, blockSize, 0, stream>>>(n, proposal.raw(), labels.raw());
+  RAFT_CHECK_CUDA(stream);
+  thrust::transform(thrust_exec_policy,
+                    thrust::device_pointer_cast(labels.raw()),
+                    thrust::device_pointer_cast(labels.raw() + n),
+                    thrust::counting_iterator<vertex_t>(0),
+                    thrust::device_pointer_cast(labels.raw()),
+                    thrust::minimum<vertex_t>());
+  RAFT_CHECK_CUDA(stream);
+
+  // Relabel pair representatives to consecutive coarse vertex ids
+  matrix::vector_t<vertex_t> reps(handle, n);
+  matrix::vector_t<vertex_t> map(handle, n);
+  RAFT_CUDA_TRY(cudaMemcpyAsync(
+    reps.raw(), labels.raw(), n * sizeof(vertex_t), cudaMemcpyDeviceToDevice, stream));
+  thrust::sort(thrust_exec_policy,
+               thrust::device_pointer_cast(reps.raw()),
+               thrust::device_pointer_cast(reps.raw() + n));
+  auto reps_end     = thrust::unique(thrust_exec_policy,
+                                 thrust::device_pointer_cast(reps.raw()),
+                                 thrust::device_pointer_cast(reps.raw() + n));
+  vertex_t n_coarse = reps_end - thrust::device_pointer_cast(reps.raw());
+  thrust::lower_bound(thrust_exec_policy,
+                      thrust::device_pointer_cast(reps.raw()),
+                      reps_end,
+                      thrust::device_pointer_cast(labels.raw()),
+                      thrust::device_pointer_cast(labels.raw() + n),
+                      thrust::device_pointer_cast(map.raw()));
+  RAFT_CHECK_CUDA(stream);
+
+  // Map edge endpoints and aggregate parallel edges
+  matrix::vector_t<vertex_t> rows_c(handle, nnz);
+  matrix::vector_t<vertex_t> cols_c(handle, nnz);
+  matrix::vector_t<weight_t> vals_c(handle, nnz);
+  mapEdgeEndpoints<<<gridSize, blockSize, 0, stream>>>(
+    n, row_offsets, col_indices, map.raw(), rows_c.raw(), cols_c.raw());
+  RAFT_CHECK_CUDA(stream);
+  RAFT_CUDA_TRY(cudaMemcpyAsync(
+    vals_c.raw(), values, nnz * sizeof(weight_t), cudaMemcpyDeviceToDevice, stream));
+
+  auto keys_begin = thrust::make_zip_iterator(
+    thrust::make_tuple(thrust::device_pointer_cast(rows_c.raw()),
+                       thrust::device_pointer_cast(cols_c.raw())));
+  thrust::sort_by_key(thrust_exec_policy,
+                      keys_begin,
+                      keys_begin + nnz,
+                      thrust::device_pointer_cast(vals_c.raw()));
+  RAFT_CHECK_CUDA(stream);
+
+  matrix::vector_t<vertex_t> rows_out(handle, nnz);
+  matrix::vector_t<vertex_t> cols_out(handle, nnz);
+  matrix::vector_t<weight_t> vals_out(handle, nnz);
+  auto keys_out = thrust::make_zip_iterator(
+    thrust::make_tuple(thrust::device_pointer_cast(rows_out.raw()),
+                       thrust::device_pointer_cast(cols_out.raw())));
+  auto ends       = thrust::reduce_by_key(thrust_exec_policy,
+                                    keys_begin,
+                                    keys_begin + nnz,
+                                    thrust::device_pointer_cast(vals_c.raw()),
+                                    keys_out,
+                                    thrust::device_pointer_cast(vals_out.raw()));
+  vertex_t nnz_c  = ends.second - thrust::device_pointer_cast(vals_out.raw());
+  RAFT_CHECK_CUDA(stream);
+
+  // Assemble the coarse level: CSR offsets from the sorted COO rows
+  auto level = std::make_unique<coarse_level_t<vertex_t, weight_t>>(handle, n, n_coarse, nnz_c);
+  RAFT_CUDA_TRY(cudaMemcpyAsync(
+    level->map.raw(), map.raw(), n * sizeof(vertex_t), cudaMemcpyDeviceToDevice, stream));
+  sparse::convert::sorted_coo_to_csr(
+    rows_out.raw(), static_cast<int>(nnz_c), level->row_offsets.raw(), static_cast<int>(n_coarse), stream);
+  raft::update_device(level->row_offsets.raw() + n_coarse, &nnz_c, 1, stream);
+  RAFT_CUDA_TRY(cudaMemcpyAsync(level->col_indices.raw(),
+                                cols_out.raw(),
+                                nnz_c * sizeof(vertex_t),
+                                cudaMemcpyDeviceToDevice,
+                                stream));
+  RAFT_CUDA_TRY(cudaMemcpyAsync(level->values.raw(),
+                                vals_out.raw(),
+                                nnz_c * sizeof(weight_t),
+                                cudaMemcpyDeviceToDevice,
+                                stream));
+  // nnz_c is uploaded asynchronously from the stack above
+  RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+
+  return level;
+}
+
+/**
+ *  @brief Local-moving refinement of a cluster assignment.
+ *    Runs up to nSweeps Jacobi-style sweeps in which each vertex moves
+ *    to the community (out of a fixed set of k) with the best
+ *    modularity gain; stops early when a sweep moves no vertex.
+ *  @tparam vertex_t the type of data used for indexing.
+ *  @tparam weight_t the type of data used for edge weights.
+ *  @param handle the raft handle.
+ *  @param n Number of vertices.
+ *  @param k Number of communities.
+ *  @param row_offsets (Input, device memory, n+1 entries) CSR row
+ *    offsets.
+ *  @param col_indices (Input, device memory, nnz entries) CSR column
+ *    indices.
+ *  @param values (Input, device memory, nnz entries) CSR edge weights.
+ *  @param nSweeps Maximum number of refinement sweeps.
+ *  @param clusters (Input/output, device memory, n entries) Cluster
+ *    assignments.
+ */
+template <typename vertex_t, typename weight_t>
+void refine_clusters(handle_t const& handle,
+                     vertex_t n,
+                     vertex_t k,
+                     const vertex_t* __restrict__ row_offsets,
+                     const vertex_t* __restrict__ col_indices,
+                     const weight_t* __restrict__ values,
+                     vertex_t nSweeps,
+                     vertex_t* __restrict__ clusters)
+{
+  auto stream             = handle.get_stream();
+  auto thrust_exec_policy = handle.get_thrust_policy();
+
+  constexpr unsigned int blockSize = 128;
+  unsigned int gridSize            = std::min(65535u, static_cast<unsigned>(n));
+
+  matrix::vector_t<weight_t> degrees(handle, n);
+  matrix::vector_t<weight_t> commDeg(handle, k);
+  matrix::vector_t<vertex_t> clustersNew(handle, n);
+  matrix::vector_t<vertex_t> moved(handle, 1);
+
+  unsigned int gridSizeDeg = std::min(65535u, (static_cast<unsigned>(n) + 255) / 256);
+  vertexDegrees<<<gridSizeDeg, 256, 0, stream>>>(n, row_offsets, values, degrees.raw());
+  RAFT_CHECK_CUDA(stream);
+  weight_t twoM = thrust::reduce(thrust_exec_policy,
+                                 thrust::device_pointer_cast(degrees.raw()),
+                                 thrust::device_pointer_cast(degrees.raw() + n));
+  if (twoM <= 0) return;
+
+  for (vertex_t sweep = 0; sweep < nSweeps; ++sweep) {
+    RAFT_CUDA_TRY(cudaMemsetAsync(commDeg.raw(), 0, k * sizeof(weight_t), stream));
+    communityDegrees<<<gridSizeDeg, 256, 0, stream>>>(n, degrees.raw(), clusters, commDeg.raw());
+    RAFT_CHECK_CUDA(stream);
+    RAFT_CUDA_TRY(cudaMemsetAsync(moved.raw(), 0, sizeof(vertex_t), stream));
+
+    refineSweep<<<gridSize, blockSize, k * sizeof(weight_t), stream>>>(n,
+                                                                       k,
+                                                                       row_offsets,
+                                                                       col_indices,
+                                                                       values,
+                                                                       degrees.raw(),
+                                                                       commDeg.raw(),
+                                                                       twoM,
+                                                                       clusters,
+                                                                       clustersNew.raw(),
+                                                                       moved.raw());
+    RAFT_CHECK_CUDA(stream);
+    RAFT_CUDA_TRY(cudaMemcpyAsync(
+      clusters, clustersNew.raw(), n * sizeof(vertex_t), cudaMemcpyDeviceToDevice, stream));
+
+    vertex_t movedHost = 0;
+    raft::update_host(&movedHost, moved.raw(), 1, stream);
+    RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+    if (movedHost == 0) break;
+  }
+}
+
+}  // namespace detail
+}  // namespace spectral
+}  // namespace raft
@@ -27,6 +27,8 @@
 #include <thrust/system/cuda/execution_policy.h>
 
 #include <algorithm>
+#include <memory>
+#include <type_traits>
 
 // =========================================================
 // Useful macros
@@ -58,6 +60,42 @@ static __global__ void diagmv(IndexType_ n,
   }
 }
 
+// Down-convert array to single precision:
+//
+template <typename IndexType_, typename ValueType_>
+static __global__ void to_float(IndexType_ n, const ValueType_* __restrict__ in, float* __restrict__ out)
+{
+  IndexType_ i = threadIdx.x + blockIdx.x * blockDim.x;
+  while (i < n) {
+    out[i] = static_cast<float>(in[i]);
+    i += blockDim.x * gridDim.x;
+  }
+}
+
+// CSR SpMV with single-precision storage and full-precision
+// accumulation: y = alpha*A*x + beta*y, with the matrix values and the
+// input vector read in fp32 and the row sums accumulated in ValueType_:
+//
+template <typename IndexType_, typename ValueType_>
+static __global__ void csrmv_fp32_storage(IndexType_ nrows,
+                                          const IndexType_* __restrict__ row_offsets,
+                                          const IndexType_* __restrict__ col_indices,
+                                          const float* __restrict__ values,
+                                          const float* __restrict__ x,
+                                          ValueType_ alpha,
+                                          ValueType_ beta,
+                                          ValueType_* __restrict__ y)
+{
+  IndexType_ row = threadIdx.x + blockIdx.x * blockDim.x;
+  while (row < nrows) {
+    ValueType_ sum = 0;
+    for (IndexType_ j = row_offsets[row]; j < row_offsets[row + 1]; ++j)
+      sum += static_cast<ValueType_>(values[j]) * static_cast<ValueType_>(x[col_indices[j]]);
+    y[row] = (beta == 0 ? alpha * sum : alpha * sum + beta * y[row]);
+    row += blockDim.x * gridDim.x;
+  }
+}
+
 // specifies type of algorithm used
 // for SpMv:
 //
@@ -143,6 +181,7 @@ struct sparse_matrix_t {
       ncols_(ncols),
       nnz_(nnz)
   {
+    create_spmv_descr();
   }
 
   sparse_matrix_t(handle_t const& raft_handle,
@@ -159,6 +198,7 @@ struct sparse_matrix_t {
       ncols_(nrows),
       nnz_(nnz)
   {
+    create_spmv_descr();
   }
 
   template <typename CSRView>
@@ -171,10 +211,23 @@ struct sparse_matrix_t {
       ncols_(csr_view.number_of_vertices),
       nnz_(csr_view.number_of_edges)
   {
+    create_spmv_descr();
+  }
+
+  // virtual because used as base for following matrix types
+  //
+  virtual ~sparse_matrix_t(void)
+  {
+#if not defined CUDA_ENFORCE_LOWER and CUDA_VER_10_1_UP
+    // cannot throw from a destructor; a failed destroy only leaks the
+    // descriptor
+    //
+    if (spmv_mat_descr_ != nullptr) cusparseDestroySpMat(spmv_mat_descr_);
+#endif
   }
 
-  virtual ~sparse_matrix_t(void) =
-    default;  // virtual because used as base for following matrix types
+  sparse_matrix_t(sparse_matrix_t const&) = delete;
+  sparse_matrix_t& operator=(sparse_matrix_t const&) = delete;
 
   // y = alpha*A*x + beta*y
   //(Note: removed const-ness of x, because CUDA 11 SpMV
@@ -197,6 +250,20 @@ struct sparse_matrix_t {
     auto cusparse_h = handle_.get_cusparse_handle();
     auto stream     = handle_.get_stream();
 
+    // single-precision storage path: matrix values and input vector are
+    // read in fp32, row sums are accumulated in value_type
+    //
+    if (values_fp32_ && !transpose) {
+      constexpr unsigned int BLOCK_SIZE = 1024;
+      auto grid_x = std::min<unsigned int>((ncols_ + BLOCK_SIZE - 1) / BLOCK_SIZE, 65535);
+      to_float<<<grid_x, BLOCK_SIZE, 0, stream>>>(ncols_, x, x_fp32_->data());
+      auto grid_y = std::min<unsigned int>((nrows_ + BLOCK_SIZE - 1) / BLOCK_SIZE, 65535);
+      csrmv_fp32_storage<<<grid_y, BLOCK_SIZE, 0, stream>>>(
+        nrows_, row_offsets_, col_indices_, values_fp32_->data(), x_fp32_->data(), alpha, beta, y);
+      RAFT_CHECK_CUDA(stream);
+      return;
+    }
+
     cusparseOperation_t trans = transpose ? CUSPARSE_OPERATION_TRANSPOSE :  // transpose
                                   CUSPARSE_OPERATION_NON_TRANSPOSE;         // non-transpose
 
@@ -206,19 +273,10 @@ struct sparse_matrix_t {
 
     cusparseSpMVAlg_t spmv_alg = translate_algorithm(alg);
 
-    // create descriptors:
-    //(below casts are necessary, because
-    // cusparseCreateCsr(...) takes non-const
-    // void*; the casts should be harmless)
+    // matrix descriptor is created once at construction; only the dense
+    // vector descriptors (cheap, host-side) are per-call:
     //
-    cusparseSpMatDescr_t matA;
-    RAFT_CUSPARSE_TRY(raft::sparse::detail::cusparsecreatecsr(&matA,
-                                                              nrows_,
-                                                              ncols_,
-                                                              nnz_,
-                                                              const_cast<index_type*>(row_offsets_),
-                                                              const_cast<index_type*>(col_indices_),
-                                                              const_cast<value_type*>(values_)));
+    RAFT_EXPECTS(spmv_mat_descr_ != nullptr, "Invalid matrix for SpMV.");
 
     cusparseDnVecDescr_t vecX;
     RAFT_CUSPARSE_TRY(raft::sparse::detail::cusparsecreatednvec(&vecX, size_x, x));
@@ -230,23 +288,32 @@ struct sparse_matrix_t {
     //
     size_t bufferSize;
     RAFT_CUSPARSE_TRY(raft::sparse::detail::cusparsespmv_buffersize(
-      cusparse_h, trans, &alpha, matA, vecX, &beta, vecY, spmv_alg, &bufferSize, stream));
+      cusparse_h, trans, &alpha, spmv_mat_descr_, vecX, &beta, vecY, spmv_alg, &bufferSize, stream));
 
-    // allocate external buffer:
+    // (re)allocate external buffer only when it grows; steady-state
+    // iterations (e.g. Lanczos) reuse the same allocation:
     //
-    vector_t<value_type> external_buffer(handle_, bufferSize);
+    if (!spmv_buffer_ || spmv_buffer_->size() < bufferSize)
+      spmv_buffer_.reset(new rmm::device_uvector<char>(bufferSize, stream));
 
     // finally perform SpMV:
     //
-    RAFT_CUSPARSE_TRY(raft::sparse::detail::cusparsespmv(
-      cusparse_h, trans, &alpha, matA, vecX, &beta, vecY, spmv_alg, external_buffer.raw(), stream));
+    RAFT_CUSPARSE_TRY(raft::sparse::detail::cusparsespmv(cusparse_h,
+                                                         trans,
+                                                         &alpha,
+                                                         spmv_mat_descr_,
+                                                         vecX,
+                                                         &beta,
+                                                         vecY,
+                                                         spmv_alg,
+                                                         spmv_buffer_->data(),
+                                                         stream));
 
     // free descriptors:
     //(TODO: maybe wrap them in a RAII struct?)
     //
     RAFT_CUSPARSE_TRY(cusparseDestroyDnVec(vecY));
     RAFT_CUSPARSE_TRY(cusparseDestroyDnVec(vecX));
-    RAFT_CUSPARSE_TRY(cusparseDestroySpMat(matA));
 #else
     RAFT_CUSPARSE_TRY(
       raft::sparse::detail::cusparsesetpointermode(cusparse_h, CUSPARSE_POINTER_MODE_HOST, stream));
@@ -276,6 +343,27 @@ struct sparse_matrix_t {
 #endif
   }
 
+  // Keep a single-precision copy of the matrix values and route
+  // non-transposed SpMV through it, with row sums still accumulated in
+  // value_type; halves the value/vector memory traffic of each product.
+  // No-op when value_type is already single precision or the matrix is
+  // empty; transposed products keep using the full-precision values.
+  //
+  void enable_fp32_values(void)
+  {
+    if (values_fp32_ || std::is_same<value_type, float>::value || values_ == nullptr || nnz_ <= 0)
+      return;
+
+    auto stream = handle_.get_stream();
+    values_fp32_.reset(new rmm::device_uvector<float>(nnz_, stream));
+    x_fp32_.reset(new rmm::device_uvector<float>(ncols_, stream));
+
+    constexpr unsigned int BLOCK_SIZE = 1024;
+    auto grid = std::min<unsigned int>((nnz_ + BLOCK_SIZE - 1) / BLOCK_SIZE, 65535);
+    to_float<<<grid, BLOCK_SIZE, 0, stream>>>(nnz_, values_, values_fp32_->data());
+    RAFT_CHECK_CUDA(stream);
+  }
+
   handle_t const& get_handle(void) const { return handle_; }
 
 #if not defined CUDA_ENFORCE_LOWER and CUDA_VER_10_1_UP
@@ -299,6 +387,38 @@ struct sparse_matrix_t {
   index_type const nrows_;
   index_type const ncols_;
   index_type const nnz_;
+
+ protected:
+  // create the cusparse matrix descriptor once, up-front; mv() then only
+  // creates the cheap dense vector descriptors per call
+  //
+  void create_spmv_descr(void)
+  {
+#if not defined CUDA_ENFORCE_LOWER and CUDA_VER_10_1_UP
+    if (row_offsets_ == nullptr || col_indices_ == nullptr || values_ == nullptr || nnz_ <= 0)
+      return;
+
+    //(below casts are necessary, because
+    // cusparseCreateCsr(...) takes non-const
+    // void*; the casts should be harmless)
+    //
+    RAFT_CUSPARSE_TRY(
+      raft::sparse::detail::cusparsecreatecsr(&spmv_mat_descr_,
+                                              nrows_,
+                                              ncols_,
+                                              nnz_,
+                                              const_cast<index_type*>(row_offsets_),
+                                              const_cast<index_type*>(col_indices_),
+                                              const_cast<value_type*>(values_)));
+#endif
+  }
+
+#if not defined CUDA_ENFORCE_LOWER and CUDA_VER_10_1_UP
+  cusparseSpMatDescr_t spmv_mat_descr_{nullptr};
+  mutable std::unique_ptr<rmm::device_uvector<char>> spmv_buffer_{};
+#endif
+  std::unique_ptr<rmm::device_uvector<float>> values_fp32_{};
+  mutable std::unique_ptr<rmm::device_uvector<float>> x_fp32_{};
 };
 
 template <typename index_type, typename value_type>
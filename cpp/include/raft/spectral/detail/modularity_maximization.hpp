@@ -21,13 +21,17 @@
 
 #include <cuda.h>
 #include <thrust/fill.h>
+#include <thrust/gather.h>
 #include <thrust/reduce.h>
 #include <thrust/transform.h>
 
+#include <memory>
 #include <tuple>
+#include <vector>
 
 #include <raft/linalg/detail/cublas_wrappers.hpp>
 #include <raft/spectral/cluster_solvers.cuh>
+#include <raft/spectral/detail/coarsen.cuh>
 #include <raft/spectral/detail/spectral_util.cuh>
 #include <raft/spectral/eigen_solvers.cuh>
 #include <raft/spectral/matrix_wrappers.hpp>
@@ -128,6 +132,108 @@ std::tuple<vertex_t, weight_t, vertex_t> modularity_maximization(
 
   return stats;
 }
+/** Compute partition for a weighted undirected graph with a multilevel
+ *  scheme. The graph is repeatedly contracted by heavy-edge matching
+ *  until it falls below minVertices (or the matching stalls), the
+ *  spectral modularity maximization above runs on the coarsest graph,
+ *  and the resulting clustering is projected back level by level with a
+ *  few local-moving refinement sweeps at each level. This trades a
+ *  small amount of modularity for running the eigensolver on a graph
+ *  that is orders of magnitude smaller.
+ *
+ *  @param G Weighted graph in CSR format
+ *  @param clusters (Output, device memory, n entries) Cluster
+ *    assignments.
+ *  @param eigVals (Output, device memory, nEigVecs entries) Eigenvalues
+ *    of the coarsest modularity matrix.
+ *  @param eigVecs (Output, device memory, n*nEigVecs entries)
+ *    Eigenvector workspace; only the leading n_coarse rows are
+ *    meaningful on exit.
+ *  @param minVertices Stop coarsening once the graph has at most this
+ *    many vertices.
+ *  @param maxLevels Maximum number of coarsening levels.
+ *  @param refineSweeps Maximum number of refinement sweeps per level.
+ *  @return statistics of the coarsest-level solve (# iters eigen
+ *    solver, cluster solver residual, # iters cluster solver).
+ */
+template <typename vertex_t, typename weight_t, typename EigenSolver, typename ClusterSolver>
+std::tuple<vertex_t, weight_t, vertex_t> modularity_maximization_multilevel(
+  handle_t const& handle,
+  raft::spectral::matrix::sparse_matrix_t<vertex_t, weight_t> const& csr_m,
+  EigenSolver const& eigen_solver,
+  ClusterSolver const& cluster_solver,
+  vertex_t* __restrict__ clusters,
+  weight_t* eigVals,
+  weight_t* eigVecs,
+  vertex_t minVertices  = 4096,
+  vertex_t maxLevels    = 20,
+  vertex_t refineSweeps = 2)
+{
+  RAFT_EXPECTS(clusters != nullptr, "Null clusters buffer.");
+  RAFT_EXPECTS(eigVals != nullptr, "Null eigVals buffer.");
+  RAFT_EXPECTS(eigVecs != nullptr, "Null eigVecs buffer.");
+
+  auto stream             = handle.get_stream();
+  auto thrust_exec_policy = handle.get_thrust_policy();
+
+  vertex_t n = csr_m.nrows_;
+
+  // Coarsen until the graph is small enough for the direct solver;
+  // stop early when matching barely shrinks the graph (dense cores)
+  using level_t = coarse_level_t<vertex_t, weight_t>;
+  std::vector<std::unique_ptr<level_t>> levels;
+  vertex_t n_cur               = n;
+  vertex_t nnz_cur             = csr_m.nnz_;
+  vertex_t const* row_offsets  = csr_m.row_offsets_;
+  vertex_t const* col_indices  = csr_m.col_indices_;
+  weight_t const* values       = csr_m.values_;
+  while (static_cast<vertex_t>(levels.size()) < maxLevels && n_cur > minVertices) {
+    auto level = coarsen_graph(handle, n_cur, nnz_cur, row_offsets, col_indices, values);
+    if (level->n_coarse_ > (9 * n_cur) / 10) break;
+    n_cur       = level->n_coarse_;
+    nnz_cur     = level->nnz_;
+    row_offsets = level->row_offsets.raw();
+    col_indices = level->col_indices.raw();
+    values      = level->values.raw();
+    levels.push_back(std::move(level));
+  }
+
+  if (levels.empty())
+    return modularity_maximization(
+      handle, csr_m, eigen_solver, cluster_solver, clusters, eigVals, eigVecs);
+
+  // Solve on the coarsest graph; the caller's n-sized buffers are
+  // large enough since n_cur < n
+  raft::spectral::matrix::sparse_matrix_t<vertex_t, weight_t> coarse_m{
+    handle, row_offsets, col_indices, values, n_cur, nnz_cur};
+  auto stats = modularity_maximization(
+    handle, coarse_m, eigen_solver, cluster_solver, clusters, eigVals, eigVecs);
+
+  // Project the clustering back through the levels, refining at each
+  auto k = static_cast<vertex_t>(cluster_solver.get_config().n_clusters);
+  raft::spectral::matrix::vector_t<vertex_t> fineClusters(handle, n);
+  for (auto it = levels.rbegin(); it != levels.rend(); ++it) {
+    bool finest         = (std::next(it) == levels.rend());
+    vertex_t n_fine     = finest ? n : (*std::next(it))->n_coarse_;
+    auto const* fine_ro = finest ? csr_m.row_offsets_ : (*std::next(it))->row_offsets.raw();
+    auto const* fine_ci = finest ? csr_m.col_indices_ : (*std::next(it))->col_indices.raw();
+    auto const* fine_v  = finest ? csr_m.values_ : (*std::next(it))->values.raw();
+
+    thrust::gather(thrust_exec_policy,
+                   thrust::device_pointer_cast((*it)->map.raw()),
+                   thrust::device_pointer_cast((*it)->map.raw() + n_fine),
+                   thrust::device_pointer_cast(clusters),
+                   thrust::device_pointer_cast(fineClusters.raw()));
+    RAFT_CHECK_CUDA(stream);
+    RAFT_CUDA_TRY(cudaMemcpyAsync(
+      clusters, fineClusters.raw(), n_fine * sizeof(vertex_t), cudaMemcpyDeviceToDevice, stream));
+
+    refine_clusters(handle, n_fine, k, fine_ro, fine_ci, fine_v, refineSweeps, clusters);
+  }
+
+  return stats;
+}
+
 //===================================================
 // Analysis of graph partition
 // =========================================================
@@ -111,6 +111,55 @@ std::tuple<vertex_t, weight_t, vertex_t> partition(
   return stats;
 }
 
+/// Compute spectral graph partition with a warm-started eigensolver
+/** Overload taking the eigenvector block of a previous partition of a
+ *  slightly different graph (same vertex set) as the initial subspace
+ *  for the eigensolver; see the public wrapper for details. Requires an
+ *  eigensolver whose solve_smallest_eigenvectors accepts an initial
+ *  block (e.g. lobpcg_solver_t).
+ */
+template <typename vertex_t, typename weight_t, typename EigenSolver, typename ClusterSolver>
+std::tuple<vertex_t, weight_t, vertex_t> partition(
+  handle_t const& handle,
+  spectral::matrix::sparse_matrix_t<vertex_t, weight_t> const& csr_m,
+  EigenSolver const& eigen_solver,
+  ClusterSolver const& cluster_solver,
+  vertex_t* __restrict__ clusters,
+  weight_t* eigVals,
+  weight_t* eigVecs,
+  weight_t const* eigVecs_init)
+{
+  RAFT_EXPECTS(clusters != nullptr, "Null clusters buffer.");
+  RAFT_EXPECTS(eigVals != nullptr, "Null eigVals buffer.");
+  RAFT_EXPECTS(eigVecs != nullptr, "Null eigVecs buffer.");
+  RAFT_EXPECTS(eigVecs_init != nullptr, "Null eigVecs_init buffer.");
+
+  std::tuple<vertex_t, weight_t, vertex_t> stats;
+
+  vertex_t n = csr_m.nrows_;
+
+  laplacian_matrix_t<vertex_t, weight_t> L{handle, csr_m};
+
+  auto eigen_config = eigen_solver.get_config();
+  auto nEigVecs     = eigen_config.n_eigVecs;
+
+  // Compute smallest eigenvalues and eigenvectors, starting the block
+  // iteration from the previous embedding
+  std::get<0>(stats) =
+    eigen_solver.solve_smallest_eigenvectors(handle, L, eigVals, eigVecs, eigVecs_init);
+
+  // Whiten eigenvector matrix
+  transform_eigen_matrix(handle, n, nEigVecs, eigVecs);
+
+  // Find partition clustering
+  auto pair_cluster = cluster_solver.solve(handle, n, nEigVecs, eigVecs, clusters);
+
+  std::get<1>(stats) = pair_cluster.first;
+  std::get<2>(stats) = pair_cluster.second;
+
+  return stats;
+}
+
 // =========================================================
 // Analysis of graph partition
 // =========================================================
@@ -57,6 +57,53 @@ std::tuple<vertex_t, weight_t, vertex_t> modularity_maximization(
     modularity_maximization<vertex_t, weight_t, EigenSolver, ClusterSolver>(
       handle, csr_m, eigen_solver, cluster_solver, clusters, eigVals, eigVecs);
 }
+/** Compute partition for a weighted undirected graph with a multilevel
+ *  scheme: coarsen by heavy-edge matching, run the spectral solver on
+ *  the coarsest graph, then project the clustering back with local
+ *  refinement sweeps at each level. Much faster than
+ *  modularity_maximization on large graphs at a small modularity cost.
+ *
+ *  @param handle raft handle for managing expensive resources
+ *  @param csr_m Weighted graph in CSR format
+ *  @param eigen_solver Eigensolver implementation
+ *  @param cluster_solver Cluster solver implementation
+ *  @param clusters (Output, device memory, n entries) Partition
+ *    assignments.
+ *  @param eigVals Output eigenvalue array pointer on device
+ *  @param eigVecs Output eigenvector array pointer on device
+ *  @param minVertices Stop coarsening once the graph has at most this
+ *    many vertices.
+ *  @param maxLevels Maximum number of coarsening levels.
+ *  @param refineSweeps Maximum number of refinement sweeps per level.
+ *  @return statistics of the coarsest-level solve: number of
+ *    eigensolver iterations, cluster solver residual and iterations.
+ */
+template <typename vertex_t, typename weight_t, typename EigenSolver, typename ClusterSolver>
+std::tuple<vertex_t, weight_t, vertex_t> modularity_maximization_multilevel(
+  handle_t const& handle,
+  matrix::sparse_matrix_t<vertex_t, weight_t> const& csr_m,
+  EigenSolver const& eigen_solver,
+  ClusterSolver const& cluster_solver,
+  vertex_t* __restrict__ clusters,
+  weight_t* eigVals,
+  weight_t* eigVecs,
+  vertex_t minVertices  = 4096,
+  vertex_t maxLevels    = 20,
+  vertex_t refineSweeps = 2)
+{
+  return raft::spectral::detail::
+    modularity_maximization_multilevel<vertex_t, weight_t, EigenSolver, ClusterSolver>(
+      handle,
+      csr_m,
+      eigen_solver,
+      cluster_solver,
+      clusters,
+      eigVals,
+      eigVecs,
+      minVertices,
+      maxLevels,
+      refineSweeps);
+}
 //===================================================
 // Analysis of graph partition
 // =========================================================
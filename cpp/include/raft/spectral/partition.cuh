@@ -59,6 +59,42 @@ std::tuple<vertex_t, weight_t, vertex_t> partition(
     handle, csr_m, eigen_solver, cluster_solver, clusters, eigVals, eigVecs);
 }
 
+/// Compute spectral graph partition with a warm-started eigensolver
+/** Overload for incremental re-partitioning: the eigenvector block of a
+ *  previous partition of a slightly different graph (same vertex set)
+ *  seeds the eigensolver's subspace, so small graph updates converge in
+ *  a handful of iterations instead of a cold start from random vectors.
+ *  Requires an eigensolver whose solve_smallest_eigenvectors accepts an
+ *  initial block (e.g. lobpcg_solver_t); the whitened eigVecs output of
+ *  the previous call may be passed back directly.
+ *
+ *  @param handle raft handle for managing expensive resources
+ *  @param csr_m Weighted graph in CSR format
+ *  @param eigen_solver Eigensolver implementation
+ *  @param cluster_solver Cluster solver implementation
+ *  @param clusters (Output, device memory, n entries) Partition
+ *    assignments.
+ *  @param eigVals Output eigenvalue array pointer on device
+ *  @param eigVecs Output eigenvector array pointer on device
+ *  @param eigVecs_init (Input, device memory, n*nEigVecs entries)
+ *    Previous eigenvector block used as the initial subspace.
+ *  @return statistics: number of eigensolver iterations, .
+ */
+template <typename vertex_t, typename weight_t, typename EigenSolver, typename ClusterSolver>
+std::tuple<vertex_t, weight_t, vertex_t> partition(
+  handle_t const& handle,
+  matrix::sparse_matrix_t<vertex_t, weight_t> const& csr_m,
+  EigenSolver const& eigen_solver,
+  ClusterSolver const& cluster_solver,
+  vertex_t* __restrict__ clusters,
+  weight_t* eigVals,
+  weight_t* eigVecs,
+  weight_t const* eigVecs_init)
+{
+  return raft::spectral::detail::partition<vertex_t, weight_t, EigenSolver, ClusterSolver>(
+    handle, csr_m, eigen_solver, cluster_solver, clusters, eigVals, eigVecs, eigVecs_init);
+}
+
 // =========================================================
 // Analysis of graph partition
 // =========================================================
@@ -48,6 +48,64 @@ double adjusted_rand_index(const T* firstClusterArray,
   return detail::compute_adjusted_rand_index(firstClusterArray, secondClusterArray, size, stream);
 }
 
+/**
+ * @brief Adjusted Rand index computed through a sparse contingency matrix
+ *
+ * Produces the same score as `adjusted_rand_index` but never materializes
+ * the nClasses^2 dense contingency matrix, so it stays usable when comparing
+ * clusterings with very many classes (e.g. 100k clusters). The cost is
+ * linear in the number of distinct label pairs instead of quadratic in the
+ * number of classes.
+ *
+ * @tparam T data-type for input label arrays
+ * @tparam MathT integral data-type used for computing n-choose-r
+ * @param firstClusterArray: the array of classes
+ * @param secondClusterArray: the array of classes
+ * @param size: the size of the data points of type int
+ * @param stream: the cudaStream object
+ */
+template <typename T, typename MathT = int>
+double adjusted_rand_index_sparse(const T* firstClusterArray,
+                                  const T* secondClusterArray,
+                                  int size,
+                                  cudaStream_t stream)
+{
+  return detail::compute_adjusted_rand_index_sparse<T, MathT>(
+    firstClusterArray, secondClusterArray, size, stream);
+}
+
+/**
+ * @brief Adjusted Rand index computed through a hashed contingency map
+ *
+ * Produces the same score as `adjusted_rand_index` but counts the
+ * (label_a, label_b) pairs in a device hash map with warp-aggregated
+ * atomics, so memory scales with the number of distinct pairs rather than
+ * nClasses^2 and no sort of the pair keys is needed. This is the preferred
+ * variant for very large inputs with very many clusters.
+ *
+ * @tparam T data-type for input label arrays
+ * @tparam MathT integral data-type used for computing n-choose-r; must
+ *         support device atomicAdd
+ * @param firstClusterArray: the array of classes
+ * @param secondClusterArray: the array of classes
+ * @param size: the size of the data points of type int
+ * @param stream: the cudaStream object
+ * @param max_distinct_pairs: upper bound on the number of distinct label
+ *        pairs used to size the hash map; 0 defaults to `size`. An
+ *        underestimate raises a `raft::exception` rather than corrupting
+ *        the result
+ */
+template <typename T, typename MathT = int>
+double adjusted_rand_index_hashed(const T* firstClusterArray,
+                                  const T* secondClusterArray,
+                                  int size,
+                                  cudaStream_t stream,
+                                  int max_distinct_pairs = 0)
+{
+  return detail::compute_adjusted_rand_index_hashed<T, MathT>(
+    firstClusterArray, secondClusterArray, size, stream, max_distinct_pairs);
+}
+
 };  // end namespace stats
 };  // end namespace raft
 
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __COLUMN_SUMMARY_H
+#define __COLUMN_SUMMARY_H
+
+#pragma once
+
+#include "detail/column_summary.cuh"
+
+namespace raft::stats {
+
+/**
+ * @brief Compute min, max, mean and variance for each column of a given matrix
+ * in a single pass over the data.
+ *
+ * Equivalent to running `minmax` followed by `meanvar`, but the matrix is read
+ * exactly once; since all of these kernels are memory-bound, this roughly
+ * halves the cost of a typical feature-scaling preflight.
+ *
+ * @tparam Type the data type
+ * @tparam IdxType Integer type used for addressing
+ * @param [out] min the output minimum vector of size D
+ * @param [out] max the output maximum vector of size D
+ * @param [out] mean the output mean vector of size D
+ * @param [out] var the output variance vector of size D
+ * @param [in] data the input matrix of size [N, D]
+ * @param [in] D number of columns of data
+ * @param [in] N number of rows of data
+ * @param [in] sample whether to evaluate sample variance or not. In other words, whether to
+ * normalize the variance using N-1 or N, for true or false respectively.
+ * @param [in] rowMajor whether the input data is row- or col-major, for true or false respectively.
+ * @param [in] stream
+ */
+template <typename Type, typename IdxType = int>
+void column_summary(Type* min,
+                    Type* max,
+                    Type* mean,
+                    Type* var,
+                    const Type* data,
+                    IdxType D,
+                    IdxType N,
+                    bool sample,
+                    bool rowMajor,
+                    cudaStream_t stream)
+{
+  detail::column_summary(min, max, mean, var, data, D, N, sample, rowMajor, stream);
+}
+
+};  // namespace raft::stats
+
+#endif
@@ -46,6 +46,13 @@ enum HistType {
   HistTypeSmemBits16 = 16,
   /** use only global atomics */
   HistTypeGmem,
+  /**
+   * privatized copies of the histogram in global memory, one per group of
+   * thread blocks, merged at the end. Use this when the number of bins is too
+   * large for any of the shared mem based approaches, as it keeps the atomic
+   * contention on a given bin roughly constant as the bin count grows.
+   */
+  HistTypeGmemPriv,
   /** uses shared mem atomics to reduce global traffic */
   HistTypeSmem,
   /**
@@ -100,6 +100,36 @@ void contingencyMatrix(const T* groundTruth,
                                      maxLabel);
 }
 
+/**
+ * @brief construct a sparse (COO) contingency matrix given input ground truth
+ *        and prediction labels. Unlike `contingencyMatrix`, the dense
+ *        nClasses x nClasses matrix is never materialized, so this remains
+ *        viable for very high label cardinalities where the dense matrix
+ *        would be mostly zeros. Memory cost is O(nSamples).
+ * @tparam T label type
+ * @tparam OutT output count type
+ * @param groundTruth: device 1-d array for ground truth (num of rows)
+ * @param predictedLabel: device 1-d array for prediction (num of columns)
+ * @param nSamples: number of elements in input array
+ * @param outCOO: output COO matrix, allocated by this function
+ *                (nnz <= min(nSamples, nClasses^2))
+ * @param stream: cuda stream for execution
+ * @param minLabel: Optional, min value in input ground truth array
+ * @param maxLabel: Optional, max value in input ground truth array
+ */
+template <typename T, typename OutT = int>
+void contingencyMatrixSparse(const T* groundTruth,
+                             const T* predictedLabel,
+                             int nSamples,
+                             raft::sparse::COO<OutT, int>& outCOO,
+                             cudaStream_t stream,
+                             T minLabel = std::numeric_limits<T>::max(),
+                             T maxLabel = std::numeric_limits<T>::max())
+{
+  detail::contingencyMatrixSparse<T, OutT>(
+    groundTruth, predictedLabel, nSamples, outCOO, stream, minLabel, maxLabel);
+}
+
 };  // namespace stats
 };  // namespace raft
 
@@ -57,6 +57,61 @@ void cov(const raft::handle_t& handle,
 {
   detail::cov(handle, covar, data, mu, D, N, sample, rowMajor, stable, stream);
 }
+
+/**
+ * @brief Accumulate a batch of samples into a running covariance accumulator
+ *
+ * Streaming counterpart of `cov` for datasets too large to keep resident:
+ * feed the samples batch by batch through `cov_update`, which adds the raw
+ * product X^T.X of the batch onto `covar` via a rank-k (syrk) update, then
+ * call `cov_finalize` once with the overall mean (e.g. accumulated with
+ * `meanvar_update`) to obtain the covariance matrix.
+ *
+ * @tparam Type the data type
+ * @param handle the raft handle
+ * @param covar the D x D accumulator; must be zeroed before the first batch
+ * @param data the batch of samples (not modified)
+ * @param D number of columns of data
+ * @param N number of rows in this batch
+ * @param rowMajor whether the input data is row or col major
+ * @param stream cuda stream
+ */
+template <typename Type>
+void cov_update(const raft::handle_t& handle,
+                Type* covar,
+                const Type* data,
+                std::size_t D,
+                std::size_t N,
+                bool rowMajor,
+                cudaStream_t stream)
+{
+  detail::cov_update(handle, covar, data, D, N, rowMajor, stream);
+}
+
+/**
+ * @brief Finalize a covariance accumulator built by `cov_update`
+ *
+ * Applies the mean correction and normalization in place:
+ * covar = (X^T.X - N * mu.mu^T) / (N - 1 or N). Being a single-pass
+ * formulation, it is numerically less stable than `cov` with stable=true when
+ * the means are large compared to the spread of the data.
+ *
+ * @tparam Type the data type
+ * @param covar the accumulator; overwritten with the covariance matrix
+ * @param mu mean vector over all samples fed to `cov_update`
+ * @param D number of columns of data
+ * @param N total number of samples across all batches
+ * @param sample whether to evaluate sample covariance or not. In other words,
+ * whether to normalize the output using N-1 or N, for true or false,
+ * respectively
+ * @param stream cuda stream
+ */
+template <typename Type>
+void cov_finalize(
+  Type* covar, const Type* mu, std::size_t D, std::size_t N, bool sample, cudaStream_t stream)
+{
+  detail::cov_finalize(covar, mu, D, N, sample, stream);
+}
 };  // end namespace stats
 };  // end namespace raft
 
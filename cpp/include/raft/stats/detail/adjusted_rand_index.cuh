@@ -27,6 +27,7 @@
 #include <math.h>
 #include <raft/cuda_utils.cuh>
 #include <raft/cudart_utils.h>
+#include <raft/interruptible.hpp>
 #include <raft/linalg/map_then_reduce.cuh>
 #include <raft/linalg/reduce.cuh>
 #include <raft/stats/histogram.cuh>
@@ -196,6 +197,313 @@ double compute_adjusted_rand_index(const T* firstClusterArray,
     return 0;
 }
 
+/**
+ * @brief Adjusted Rand index via a sparse (COO) contingency matrix
+ *
+ * Equivalent to `compute_adjusted_rand_index` but never materializes the
+ * nClasses^2 dense contingency matrix: the pair counts come from
+ * `contingencyMatrixSparse` and the marginals a/b are simply the per-label
+ * bincounts of the two input arrays, so the cost is linear in the number of
+ * distinct label pairs instead of quadratic in the number of classes.
+ *
+ * @tparam T data-type for input label arrays
+ * @tparam MathT integral data-type used for computing n-choose-r
+ * @param firstClusterArray: the array of classes
+ * @param secondClusterArray: the array of classes
+ * @param size: the size of the data points of type int
+ * @param stream: the cudaStream object
+ */
+template <typename T, typename MathT = int>
+double compute_adjusted_rand_index_sparse(const T* firstClusterArray,
+                                          const T* secondClusterArray,
+                                          int size,
+                                          cudaStream_t stream)
+{
+  ASSERT(size >= 2, "Rand Index for size less than 2 not defined!");
+  T minFirst, maxFirst, minSecond, maxSecond;
+  auto nUniqFirst      = countUnique(firstClusterArray, size, minFirst, maxFirst, stream);
+  auto nUniqSecond     = countUnique(secondClusterArray, size, minSecond, maxSecond, stream);
+  auto lowerLabelRange = std::min(minFirst, minSecond);
+  auto upperLabelRange = std::max(maxFirst, maxSecond);
+  auto nClasses        = int(upperLabelRange - lowerLabelRange + 1);
+  // degenerate case of single cluster or clusters each with just one element
+  if (nUniqFirst == nUniqSecond) {
+    if (nUniqFirst == 1 || nUniqFirst == size) return 1.0;
+  }
+  raft::sparse::COO<MathT, int> contingencyCOO(stream);
+  contingencyMatrixSparse<T, MathT>(firstClusterArray,
+                                    secondClusterArray,
+                                    size,
+                                    contingencyCOO,
+                                    stream,
+                                    lowerLabelRange,
+                                    upperLabelRange);
+  rmm::device_scalar<MathT> d_aCTwoSum(stream);
+  rmm::device_scalar<MathT> d_bCTwoSum(stream);
+  rmm::device_scalar<MathT> d_nChooseTwoSum(stream);
+  MathT h_aCTwoSum, h_bCTwoSum, h_nChooseTwoSum;
+  RAFT_CUDA_TRY(cudaMemsetAsync(d_aCTwoSum.data(), 0, sizeof(MathT), stream));
+  RAFT_CUDA_TRY(cudaMemsetAsync(d_bCTwoSum.data(), 0, sizeof(MathT), stream));
+  RAFT_CUDA_TRY(cudaMemsetAsync(d_nChooseTwoSum.data(), 0, sizeof(MathT), stream));
+  // calculating the sum of NijC2 over the stored pairs only
+  if (contingencyCOO.nnz > 0) {
+    raft::linalg::mapThenSumReduce<MathT, nCTwo<MathT>>(d_nChooseTwoSum.data(),
+                                                        contingencyCOO.nnz,
+                                                        nCTwo<MathT>(),
+                                                        stream,
+                                                        contingencyCOO.vals(),
+                                                        contingencyCOO.vals());
+  }
+  // the marginals of the contingency matrix are the per-label bincounts of
+  // the inputs, so no row/column reduction of the matrix is needed
+  rmm::device_uvector<int> a(nClasses, stream);
+  rmm::device_uvector<int> b(nClasses, stream);
+  raft::stats::histogram<T, int>(raft::stats::HistTypeAuto,
+                                 a.data(),
+                                 nClasses,
+                                 firstClusterArray,
+                                 size,
+                                 1,
+                                 stream,
+                                 Binner<T, int>(lowerLabelRange));
+  raft::stats::histogram<T, int>(raft::stats::HistTypeAuto,
+                                 b.data(),
+                                 nClasses,
+                                 secondClusterArray,
+                                 size,
+                                 1,
+                                 stream,
+                                 Binner<T, int>(lowerLabelRange));
+  // calculating the sum of number of unordered pairs for every element in a
+  raft::linalg::mapThenSumReduce<int, nCTwo<MathT>>(
+    d_aCTwoSum.data(), nClasses, nCTwo<MathT>(), stream, a.data());
+  // calculating the sum of number of unordered pairs for every element of b
+  raft::linalg::mapThenSumReduce<int, nCTwo<MathT>>(
+    d_bCTwoSum.data(), nClasses, nCTwo<MathT>(), stream, b.data());
+  // updating in the host memory
+  raft::update_host(&h_nChooseTwoSum, d_nChooseTwoSum.data(), 1, stream);
+  raft::update_host(&h_aCTwoSum, d_aCTwoSum.data(), 1, stream);
+  raft::update_host(&h_bCTwoSum, d_bCTwoSum.data(), 1, stream);
+  raft::interruptible::synchronize(stream);
+  // calculating the ARI
+  auto nChooseTwo    = double(size) * double(size - 1) / 2.0;
+  auto expectedIndex = double(h_aCTwoSum) * double(h_bCTwoSum) / double(nChooseTwo);
+  auto maxIndex      = (double(h_bCTwoSum) + double(h_aCTwoSum)) / 2.0;
+  auto index         = double(h_nChooseTwoSum);
+  if (maxIndex - expectedIndex)
+    return (index - expectedIndex) / (maxIndex - expectedIndex);
+  else
+    return 0;
+}
+
+/** slot marker for unoccupied entries of the pair-count hash map */
+constexpr unsigned long long kEmptyPairKey = 0xffffffffffffffffull;
+
+/** murmur3 64-bit finalizer; spreads consecutive pair keys across the table */
+DI unsigned long long mixPairKey(unsigned long long k)
+{
+  k ^= k >> 33;
+  k *= 0xff51afd7ed558ccdull;
+  k ^= k >> 33;
+  k *= 0xc4ceb9fe1a85ec53ull;
+  k ^= k >> 33;
+  return k;
+}
+
+/** linear-probing insert-or-add into the (key, count) open addressing map */
+template <typename MathT>
+DI void insertPairCount(unsigned long long* keys,
+                        MathT* counts,
+                        int capacity,
+                        unsigned long long key,
+                        MathT count,
+                        int* overflow)
+{
+  int slot = int(mixPairKey(key) & (unsigned long long)(capacity - 1));
+  // the probe count is bounded by the table size: when every slot holds some
+  // other key the caller's max_distinct_pairs underestimated the distinct
+  // pair count, and spinning further would hang the device instead of
+  // surfacing the error, so raise the overflow flag and bail out
+  for (int probe = 0; probe < capacity; probe++) {
+    unsigned long long prev = atomicCAS(keys + slot, kEmptyPairKey, key);
+    if (prev == kEmptyPairKey || prev == key) {
+      atomicAdd(counts + slot, count);
+      return;
+    }
+    slot = (slot + 1) & (capacity - 1);
+  }
+  atomicExch(overflow, 1);
+}
+
+/**
+ * Counts (label_a, label_b) co-occurrences into a hash map. Lanes holding the
+ * same pair aggregate within the warp first so each distinct pair costs one
+ * atomic per warp instead of one per element.
+ */
+template <typename T, typename MathT>
+__global__ void hashedContingencyKernel(const T* firstClusterArray,
+                                        const T* secondClusterArray,
+                                        int size,
+                                        unsigned long long* keys,
+                                        MathT* counts,
+                                        int capacity,
+                                        T lowerLabelRange,
+                                        int* overflow)
+{
+  int i           = blockIdx.x * blockDim.x + threadIdx.x;
+  int stride      = gridDim.x * blockDim.x;
+  int roundedSize = raft::alignTo(size, raft::WarpSize);
+  // the rounded bound keeps whole warps in the loop so the sync intrinsics below are legal
+  for (; i < roundedSize; i += stride) {
+    bool valid      = i < size;
+    unsigned active = __ballot_sync(0xffffffffu, valid);
+    if (!valid) { continue; }
+    auto key = (static_cast<unsigned long long>(firstClusterArray[i] - lowerLabelRange) << 32) |
+               static_cast<unsigned long long>(
+                 static_cast<unsigned int>(secondClusterArray[i] - lowerLabelRange));
+#if __CUDA_ARCH__ >= 700
+    unsigned peers = __match_any_sync(active, key);
+#else
+    unsigned peers = 0;
+    unsigned unmatched = active;
+    while (true) {
+      int first                = __ffs(unmatched) - 1;
+      unsigned long long other = __shfl_sync(unmatched, key, first);
+      bool is_peer             = (key == other);
+      peers                    = __ballot_sync(unmatched, is_peer);
+      if (is_peer) { break; }
+      unmatched ^= peers;
+    }
+#endif
+    if (raft::laneId() == __ffs(peers) - 1) {
+      insertPairCount(keys, counts, capacity, key, MathT(__popc(peers)), overflow);
+    }
+  }
+}
+
+/**
+ * @brief Adjusted Rand index via a hashed contingency map
+ *
+ * Equivalent to `compute_adjusted_rand_index` but counts (label_a, label_b)
+ * pairs in a device hash map with warp-aggregated atomics, so memory is
+ * proportional to the number of distinct pairs rather than nClasses^2 and
+ * billion-element clusterings with millions of clusters stay feasible.
+ *
+ * @tparam T data-type for input label arrays
+ * @tparam MathT integral data-type used for computing n-choose-r; must
+ *         support device atomicAdd
+ * @param firstClusterArray: the array of classes
+ * @param secondClusterArray: the array of classes
+ * @param size: the size of the data points of type int
+ * @param stream: the cudaStream object
+ * @param max_distinct_pairs: upper bound on the number of distinct
+ *        (label_a, label_b) pairs; sizes the hash map at twice this bound.
+ *        0 defaults to `size`, which is always safe but allocates
+ *        proportionally to the input. An underestimate is detected (the map
+ *        overflows) and raises a `raft::exception` rather than corrupting
+ *        the result
+ */
+template <typename T, typename MathT = int>
+double compute_adjusted_rand_index_hashed(const T* firstClusterArray,
+                                          const T* secondClusterArray,
+                                          int size,
+                                          cudaStream_t stream,
+                                          int max_distinct_pairs = 0)
+{
+  ASSERT(size >= 2, "Rand Index for size less than 2 not defined!");
+  if (max_distinct_pairs == 0) { max_distinct_pairs = size; }
+  ASSERT(max_distinct_pairs <= size, "max_distinct_pairs cannot exceed the number of elements");
+  T minFirst, maxFirst, minSecond, maxSecond;
+  auto nUniqFirst      = countUnique(firstClusterArray, size, minFirst, maxFirst, stream);
+  auto nUniqSecond     = countUnique(secondClusterArray, size, minSecond, maxSecond, stream);
+  auto lowerLabelRange = std::min(minFirst, minSecond);
+  auto upperLabelRange = std::max(maxFirst, maxSecond);
+  auto nClasses        = int(upperLabelRange - lowerLabelRange + 1);
+  // degenerate case of single cluster or clusters each with just one element
+  if (nUniqFirst == nUniqSecond) {
+    if (nUniqFirst == 1 || nUniqFirst == size) return 1.0;
+  }
+  // power-of-two capacity at a load factor of at most 0.5
+  int capacity = 1;
+  while (capacity < 2 * max_distinct_pairs) {
+    capacity <<= 1;
+  }
+  rmm::device_uvector<unsigned long long> keys(capacity, stream);
+  rmm::device_uvector<MathT> counts(capacity, stream);
+  rmm::device_scalar<int> overflow(stream);
+  RAFT_CUDA_TRY(
+    cudaMemsetAsync(keys.data(), 0xff, capacity * sizeof(unsigned long long), stream));
+  RAFT_CUDA_TRY(cudaMemsetAsync(counts.data(), 0, capacity * sizeof(MathT), stream));
+  RAFT_CUDA_TRY(cudaMemsetAsync(overflow.data(), 0, sizeof(int), stream));
+  static const int block = 128;
+  hashedContingencyKernel<T, MathT>
+    <<<raft::ceildiv(size, block), block, 0, stream>>>(firstClusterArray,
+                                                       secondClusterArray,
+                                                       size,
+                                                       keys.data(),
+                                                       counts.data(),
+                                                       capacity,
+                                                       lowerLabelRange,
+                                                       overflow.data());
+  RAFT_CUDA_TRY(cudaGetLastError());
+  rmm::device_scalar<MathT> d_aCTwoSum(stream);
+  rmm::device_scalar<MathT> d_bCTwoSum(stream);
+  rmm::device_scalar<MathT> d_nChooseTwoSum(stream);
+  MathT h_aCTwoSum, h_bCTwoSum, h_nChooseTwoSum;
+  RAFT_CUDA_TRY(cudaMemsetAsync(d_aCTwoSum.data(), 0, sizeof(MathT), stream));
+  RAFT_CUDA_TRY(cudaMemsetAsync(d_bCTwoSum.data(), 0, sizeof(MathT), stream));
+  RAFT_CUDA_TRY(cudaMemsetAsync(d_nChooseTwoSum.data(), 0, sizeof(MathT), stream));
+  // empty slots hold a zero count and contribute nothing to the sum of NijC2
+  raft::linalg::mapThenSumReduce<MathT, nCTwo<MathT>>(
+    d_nChooseTwoSum.data(), capacity, nCTwo<MathT>(), stream, counts.data(), counts.data());
+  // the marginals of the contingency matrix are the per-label bincounts of
+  // the inputs, so the map never needs to be reduced by row or column
+  rmm::device_uvector<int> a(nClasses, stream);
+  rmm::device_uvector<int> b(nClasses, stream);
+  raft::stats::histogram<T, int>(raft::stats::HistTypeAuto,
+                                 a.data(),
+                                 nClasses,
+                                 firstClusterArray,
+                                 size,
+                                 1,
+                                 stream,
+                                 Binner<T, int>(lowerLabelRange));
+  raft::stats::histogram<T, int>(raft::stats::HistTypeAuto,
+                                 b.data(),
+                                 nClasses,
+                                 secondClusterArray,
+                                 size,
+                                 1,
+                                 stream,
+                                 Binner<T, int>(lowerLabelRange));
+  // calculating the sum of number of unordered pairs for every element in a
+  raft::linalg::mapThenSumReduce<int, nCTwo<MathT>>(
+    d_aCTwoSum.data(), nClasses, nCTwo<MathT>(), stream, a.data());
+  // calculating the sum of number of unordered pairs for every element of b
+  raft::linalg::mapThenSumReduce<int, nCTwo<MathT>>(
+    d_bCTwoSum.data(), nClasses, nCTwo<MathT>(), stream, b.data());
+  // updating in the host memory
+  int h_overflow;
+  raft::update_host(&h_nChooseTwoSum, d_nChooseTwoSum.data(), 1, stream);
+  raft::update_host(&h_aCTwoSum, d_aCTwoSum.data(), 1, stream);
+  raft::update_host(&h_bCTwoSum, d_bCTwoSum.data(), 1, stream);
+  raft::update_host(&h_overflow, overflow.data(), 1, stream);
+  raft::interruptible::synchronize(stream);
+  ASSERT(h_overflow == 0,
+         "adjusted_rand_index: the pair-count hash map overflowed; "
+         "max_distinct_pairs (%d) underestimates the number of distinct label pairs",
+         max_distinct_pairs);
+  // calculating the ARI
+  auto nChooseTwo    = double(size) * double(size - 1) / 2.0;
+  auto expectedIndex = double(h_aCTwoSum) * double(h_bCTwoSum) / double(nChooseTwo);
+  auto maxIndex      = (double(h_bCTwoSum) + double(h_aCTwoSum)) / 2.0;
+  auto index         = double(h_nChooseTwoSum);
+  if (maxIndex - expectedIndex)
+    return (index - expectedIndex) / (maxIndex - expectedIndex);
+  else
+    return 0;
+}
+
 };  // end namespace detail
 };  // end namespace stats
 };  // end namespace raft
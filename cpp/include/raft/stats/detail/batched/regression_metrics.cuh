@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/cuda_utils.cuh>
+#include <raft/cudart_utils.h>
+
+#include <cub/cub.cuh>
+
+namespace raft {
+namespace stats {
+namespace batched {
+namespace detail {
+
+/**
+ * One block per model: reduce the model's residuals once and derive MAE, MSE
+ * and R-squared from the same sums, so scoring a whole ensemble costs a
+ * single kernel launch instead of one launch (and host sync) per model.
+ */
+template <typename T, typename IdxT, int TPB>
+__global__ void __launch_bounds__(TPB) regression_metrics_batched_kernel(
+  const T* y, const T* y_hat, IdxT n_samples, T* d_mae, T* d_mse, T* d_r2)
+{
+  using BlockReduce = cub::BlockReduce<T, TPB>;
+  __shared__ typename BlockReduce::TempStorage shm;
+
+  const T* b_y     = y + (size_t)blockIdx.x * n_samples;
+  const T* b_y_hat = y_hat + (size_t)blockIdx.x * n_samples;
+  T sum_abs        = T(0);
+  T sum_sq         = T(0);
+  T sum_y          = T(0);
+  T sum_yy         = T(0);
+  for (IdxT i = threadIdx.x; i < n_samples; i += TPB) {
+    T yi   = b_y[i];
+    T diff = yi - b_y_hat[i];
+    sum_abs += raft::myAbs(diff);
+    sum_sq += diff * diff;
+    sum_y += yi;
+    sum_yy += yi * yi;
+  }
+  sum_abs = BlockReduce(shm).Sum(sum_abs);
+  __syncthreads();
+  sum_sq = BlockReduce(shm).Sum(sum_sq);
+  __syncthreads();
+  sum_y = BlockReduce(shm).Sum(sum_y);
+  __syncthreads();
+  sum_yy = BlockReduce(shm).Sum(sum_yy);
+  if (threadIdx.x == 0) {
+    T n               = T(n_samples);
+    d_mae[blockIdx.x] = sum_abs / n;
+    d_mse[blockIdx.x] = sum_sq / n;
+    // total sum of squares around the mean, without a separate mean pass
+    T ssto           = sum_yy - (sum_y * sum_y) / n;
+    d_r2[blockIdx.x] = T(1) - sum_sq / ssto;
+  }
+}
+
+/**
+ * @brief Compute MAE, MSE and R-squared for a batch of models in one pass
+ *
+ * @param[in]  d_y          Ground-truth response variables; the series of each
+ *                          model is stored contiguously,
+ *                          size [batch_size, n_samples] (device)
+ * @param[in]  d_y_hat      Predicted response variables, same layout (device)
+ * @param[in]  batch_size   Number of models in the batch
+ * @param[in]  n_samples    Number of samples in each series. Should be > 0
+ * @param[out] d_mae        Mean absolute error for each model (device)
+ * @param[out] d_mse        Mean squared error for each model (device)
+ * @param[out] d_r2         R-squared score for each model (device)
+ * @param[in]  stream       CUDA stream
+ */
+template <typename T, typename IdxT>
+void regression_metrics(const T* d_y,
+                        const T* d_y_hat,
+                        IdxT batch_size,
+                        IdxT n_samples,
+                        T* d_mae,
+                        T* d_mse,
+                        T* d_r2,
+                        cudaStream_t stream)
+{
+  static const int TPB = 256;
+  regression_metrics_batched_kernel<T, IdxT, TPB>
+    <<<batch_size, TPB, 0, stream>>>(d_y, d_y_hat, n_samples, d_mae, d_mse, d_r2);
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
+}
+
+}  // namespace detail
+}  // namespace batched
+}  // namespace stats
+}  // namespace raft
@@ -18,6 +18,7 @@
 
 #include "../silhouette_score.cuh"
 #include <raft/cuda_utils.cuh>
+#include <raft/distance/distance.cuh>
 #include <raft/device_atomics.cuh>
 #include <rmm/device_uvector.hpp>
 #include <rmm/exec_policy.hpp>
@@ -138,9 +139,14 @@ rmm::device_uvector<value_t> get_pairwise_distance(const raft::handle_t& handle,
                                                    cudaStream_t stream)
 {
   rmm::device_uvector<value_t> distances(n_left_rows * n_right_rows, stream);
-
-  raft::distance::pairwise_distance(
-    handle, left_begin, right_begin, distances.data(), n_left_rows, n_right_rows, n_cols, metric);
+  rmm::device_uvector<char> workspace(0, stream);
+
+  // enqueue the tile on its own pool stream: the public pairwise_distance
+  // wrapper would run on the handle's main stream, serializing all tiles and
+  // racing with the a/b accumulation that follows on this stream
+  raft::distance::detail::pairwise_distance_dispatch<value_t, value_idx>(
+    left_begin, right_begin, distances.data(), n_left_rows, n_right_rows, n_cols, workspace, metric,
+    stream, true);
 
   return distances;
 }
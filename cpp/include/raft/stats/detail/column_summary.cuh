@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/cuda_utils.cuh>
+#include <raft/stats/detail/meanvar.cuh>
+
+#include <limits>
+
+namespace raft::stats::detail {
+
+/**
+ * Accumulator fusing the per-column statistics needed by feature-scaling
+ * preflight: min, max, mean and variance in one record, so the matrix is
+ * traversed exactly once instead of once per statistic.
+ *
+ * Combination is associative and commutative (the mean/variance part is the
+ * `mean_var` monoid, min/max are trivially so), hence records can be merged
+ * in any reduction order.
+ */
+template <typename T>
+class col_summary {
+ private:
+  mean_var<T> mv_;
+  T min_;
+  T max_;
+
+ public:
+  /** Monoidal neutral. */
+  HDI col_summary()
+    : mv_(), min_(std::numeric_limits<T>::max()), max_(-std::numeric_limits<T>::max())
+  {
+  }
+  /** Lift a single value. */
+  HDI explicit col_summary(T x) : mv_(x), min_(x), max_(x) {}
+
+  friend HDI auto operator+(col_summary<T> a, col_summary<T> const& b) -> col_summary<T>
+  {
+    a += b;
+    return a;
+  }
+
+  HDI auto operator+=(col_summary<T> const& b) & -> col_summary<T>&
+  {
+    mv_ += b.mv_;
+    min_ = raft::myMin(min_, b.min_);
+    max_ = raft::myMax(max_, b.max_);
+    return *this;
+  }
+
+  HDI auto min() const -> T { return min_; }
+  HDI auto max() const -> T { return max_; }
+  HDI auto mean() const -> T { return mv_.mean(); }
+  HDI auto var(bool sample) const -> T { return mv_.var(sample); }
+
+  HDI void load(volatile col_summary<T>* address)
+  {
+    mv_.load(&address->mv_);
+    min_ = address->min_;
+    max_ = address->max_;
+  }
+
+  HDI void store(volatile col_summary<T>* address)
+  {
+    mv_.store(&address->mv_);
+    address->min_ = min_;
+    address->max_ = max_;
+  }
+};
+
+/**
+ * column_summary kernel - row-major version
+ *
+ * Same structure as `meanvar_kernel_rowmajor`: a warp of threads (dimension X)
+ * covers adjacent columns, dimension Y strides over rows, partial records are
+ * tree-reduced in shared memory and merged into the global aggregates under a
+ * per-column-group lock.
+ *
+ * @tparam T element type
+ * @tparam I indexing type
+ * @tparam BlockSize must be equal to blockDim.x * blockDim.y * blockDim.z
+ * @param data input data
+ * @param sums summary records -- output
+ * @param locks guards for updating the summary records
+ * @param len total length of input data (N * D)
+ * @param D number of columns in the input data.
+ */
+template <typename T, typename I, int BlockSize>
+__global__ void __launch_bounds__(BlockSize) column_summary_kernel_rowmajor(
+  const T* data, volatile col_summary<T>* sums, int* locks, I len, I D)
+{
+  // read the data
+  const I col = threadIdx.x + blockDim.x * blockIdx.x;
+  col_summary<T> thread_data;
+  if (col < D) {
+    const I step = D * blockDim.y * gridDim.y;
+    for (I i = col + D * (threadIdx.y + blockDim.y * blockIdx.y); i < len; i += step) {
+      thread_data += col_summary<T>(data[i]);
+    }
+  }
+
+  // aggregate within block
+  if (blockDim.y > 1) {
+    __shared__ uint8_t shm_bytes[BlockSize * sizeof(col_summary<T>)];
+    auto shm = (col_summary<T>*)shm_bytes;
+    int tid  = threadIdx.x + threadIdx.y * blockDim.x;
+    shm[tid] = thread_data;
+    for (int bs = BlockSize >> 1; bs >= blockDim.x; bs = bs >> 1) {
+      __syncthreads();
+      if (tid < bs) { shm[tid] += shm[tid + bs]; }
+    }
+    thread_data = shm[tid];
+  }
+
+  // aggregate across blocks
+  if (threadIdx.y == 0) {
+    int* lock = locks + blockIdx.x;
+    if (threadIdx.x == 0 && col < D) {
+      while (atomicCAS(lock, 0, 1) == 1) {
+        __threadfence();
+      }
+    }
+    __syncthreads();
+    if (col < D) {
+      __threadfence();
+      col_summary<T> global_data;
+      global_data.load(sums + col);
+      global_data += thread_data;
+      global_data.store(sums + col);
+      __threadfence();
+    }
+    __syncthreads();
+    if (threadIdx.x == 0 && col < D) { __stwt(lock, 0); }
+  }
+}
+
+template <typename T, typename I, int BlockSize>
+__global__ void __launch_bounds__(BlockSize) column_summary_kernel_colmajor(
+  T* min, T* max, T* mean, T* var, const T* data, I D, I N, bool sample)
+{
+  using BlockReduce = cub::BlockReduce<col_summary<T>, BlockSize>;
+  __shared__ typename BlockReduce::TempStorage shm;
+
+  const T* block_data = data + N * blockIdx.x;
+  col_summary<T> thread_data;
+  for (I i = threadIdx.x; i < N; i += BlockSize) {
+    thread_data += col_summary<T>(block_data[i]);
+  }
+  col_summary<T> acc = BlockReduce(shm).Sum(thread_data);
+  if (threadIdx.x == 0) {
+    min[blockIdx.x]  = acc.min();
+    max[blockIdx.x]  = acc.max();
+    mean[blockIdx.x] = acc.mean();
+    var[blockIdx.x]  = acc.var(sample);
+  }
+}
+
+/** Fill the aggregates with the monoidal neutral (memset(0) is not neutral
+ *  for the min/max part). */
+template <typename T, typename I>
+__global__ void column_summary_kernel_init(volatile col_summary<T>* sums, I D)
+{
+  I i = threadIdx.x + blockDim.x * blockIdx.x;
+  if (i >= D) return;
+  col_summary<T>().store(sums + i);
+}
+
+template <typename T, typename I>
+__global__ void column_summary_kernel_fill(
+  T* min, T* max, T* mean, T* var, const col_summary<T>* aggr, I D, bool sample)
+{
+  I i = threadIdx.x + blockDim.x * blockIdx.x;
+  if (i >= D) return;
+  auto x  = aggr[i];
+  min[i]  = x.min();
+  max[i]  = x.max();
+  mean[i] = x.mean();
+  var[i]  = x.var(sample);
+}
+
+template <typename T, typename I = int, int BlockSize = 256>
+void column_summary(T* min,
+                    T* max,
+                    T* mean,
+                    T* var,
+                    const T* data,
+                    I D,
+                    I N,
+                    bool sample,
+                    bool rowMajor,
+                    cudaStream_t stream)
+{
+  if (rowMajor) {
+    static_assert(BlockSize >= WarpSize, "Block size must be not smaller than the warp size.");
+    const dim3 bs(WarpSize, BlockSize / WarpSize, 1);
+    dim3 gs(raft::ceildiv<decltype(bs.x)>(D, bs.x), raft::ceildiv<decltype(bs.y)>(N, bs.y), 1);
+
+    // Don't create more blocks than necessary to occupy the GPU
+    int occupancy;
+    RAFT_CUDA_TRY(cudaOccupancyMaxActiveBlocksPerMultiprocessor(
+      &occupancy, column_summary_kernel_rowmajor<T, I, BlockSize>, BlockSize, 0));
+    gs.y =
+      std::min(gs.y, raft::ceildiv<decltype(gs.y)>(occupancy * getMultiProcessorCount(), gs.x));
+
+    // Global memory: one col_summary<T> for each column
+    //                one lock per all blocks working on the same set of columns
+    rmm::device_buffer buf(sizeof(col_summary<T>) * D + sizeof(int) * gs.x, stream);
+    RAFT_CUDA_TRY(cudaMemsetAsync(buf.data(), 0, buf.size(), stream));
+    col_summary<T>* sums = static_cast<col_summary<T>*>(buf.data());
+    int* locks           = static_cast<int*>(static_cast<void*>(sums + D));
+    column_summary_kernel_init<T, I>
+      <<<raft::ceildiv<I>(D, BlockSize), BlockSize, 0, stream>>>(sums, D);
+
+    const uint64_t len = uint64_t(D) * uint64_t(N);
+    ASSERT(len <= uint64_t(std::numeric_limits<I>::max()), "N * D does not fit the indexing type");
+    column_summary_kernel_rowmajor<T, I, BlockSize>
+      <<<gs, bs, 0, stream>>>(data, sums, locks, len, D);
+    column_summary_kernel_fill<T, I><<<raft::ceildiv<I>(D, BlockSize), BlockSize, 0, stream>>>(
+      min, max, mean, var, sums, D, sample);
+  } else {
+    column_summary_kernel_colmajor<T, I, BlockSize>
+      <<<D, BlockSize, 0, stream>>>(min, max, mean, var, data, D, N, sample);
+  }
+  RAFT_CHECK_CUDA(stream);
+}
+
+};  // namespace raft::stats::detail
@@ -18,6 +18,9 @@
 
 #include <raft/cuda_utils.cuh>
 #include <raft/cudart_utils.h>
+#include <raft/sparse/coo.hpp>
+#include <rmm/device_scalar.hpp>
+#include <rmm/device_uvector.hpp>
 
 #include <thrust/device_ptr.h>
 #include <thrust/execution_policy.h>
@@ -27,6 +30,7 @@
 #include <cub/cub.cuh>
 
 #include <math.h>
+#include <stdint.h>
 
 namespace raft {
 namespace stats {
@@ -235,6 +239,124 @@ size_t getContingencyMatrixWorkspaceSize(int nSamples,
   return workspaceSize;
 }
 
+template <typename T>
+__global__ void devEncodePairKeys(
+  const T* groundTruth, const T* predicted, int nSamples, uint64_t* keys, T minLabel, uint64_t nClasses)
+{
+  int elementId = threadIdx.x + blockDim.x * blockIdx.x;
+  if (elementId < nSamples) {
+    keys[elementId] = uint64_t(groundTruth[elementId] - minLabel) * nClasses +
+                      uint64_t(predicted[elementId] - minLabel);
+  }
+}
+
+template <typename OutT>
+__global__ void devDecodePairKeys(
+  const uint64_t* keys, const OutT* counts, int nnz, int* rows, int* cols, OutT* vals, uint64_t nClasses)
+{
+  int elementId = threadIdx.x + blockDim.x * blockIdx.x;
+  if (elementId < nnz) {
+    rows[elementId] = int(keys[elementId] / nClasses);
+    cols[elementId] = int(keys[elementId] % nClasses);
+    vals[elementId] = counts[elementId];
+  }
+}
+
+/**
+ * @brief construct a sparse (COO) contingency matrix given input ground truth
+ *        and prediction labels. The dense nClasses x nClasses matrix is never
+ *        materialized: each (groundTruth, predicted) pair is encoded into a
+ *        64-bit key, the keys are sorted and run-length encoded, and the runs
+ *        become the COO entries. Memory cost is O(nSamples), so this stays
+ *        viable when nClasses is in the hundreds of thousands and the dense
+ *        matrix would be mostly zeros.
+ * @tparam T label type
+ * @tparam OutT output count type
+ * @param groundTruth: device 1-d array for ground truth (num of rows)
+ * @param predictedLabel: device 1-d array for prediction (num of columns)
+ * @param nSamples: number of elements in input array
+ * @param outCOO: output COO matrix; allocated by this function
+ *                (nnz <= min(nSamples, nClasses^2))
+ * @param stream: cuda stream for execution
+ * @param minLabel: Optional, min value in input ground truth array
+ * @param maxLabel: Optional, max value in input ground truth array
+ */
+template <typename T, typename OutT = int>
+void contingencyMatrixSparse(const T* groundTruth,
+                             const T* predictedLabel,
+                             int nSamples,
+                             raft::sparse::COO<OutT, int>& outCOO,
+                             cudaStream_t stream,
+                             T minLabel = std::numeric_limits<T>::max(),
+                             T maxLabel = std::numeric_limits<T>::max())
+{
+  if (minLabel == std::numeric_limits<T>::max() || maxLabel == std::numeric_limits<T>::max()) {
+    getInputClassCardinality<T>(groundTruth, nSamples, stream, minLabel, maxLabel);
+  }
+  auto nClasses = uint64_t(maxLabel - minLabel + 1);
+
+  static const int block = 128;
+  rmm::device_uvector<uint64_t> keys(nSamples, stream);
+  rmm::device_uvector<uint64_t> sortedKeys(nSamples, stream);
+  devEncodePairKeys<T><<<raft::ceildiv(nSamples, block), block, 0, stream>>>(
+    groundTruth, predictedLabel, nSamples, keys.data(), minLabel, nClasses);
+  RAFT_CUDA_TRY(cudaGetLastError());
+
+  // only the bits actually covered by the key range need sorting
+  int bitsToSort     = 0;
+  uint64_t maxKey    = nClasses * nClasses - 1;
+  while (maxKey >> bitsToSort) {
+    ++bitsToSort;
+  }
+  size_t tmpStorageBytes = 0;
+  RAFT_CUDA_TRY(cub::DeviceRadixSort::SortKeys(
+    nullptr, tmpStorageBytes, keys.data(), sortedKeys.data(), nSamples, 0, bitsToSort, stream));
+  rmm::device_uvector<char> cubWorkspace(tmpStorageBytes, stream);
+  RAFT_CUDA_TRY(cub::DeviceRadixSort::SortKeys(cubWorkspace.data(),
+                                               tmpStorageBytes,
+                                               keys.data(),
+                                               sortedKeys.data(),
+                                               nSamples,
+                                               0,
+                                               bitsToSort,
+                                               stream));
+
+  rmm::device_uvector<uint64_t> uniqueKeys(nSamples, stream);
+  rmm::device_uvector<OutT> counts(nSamples, stream);
+  rmm::device_scalar<int> dNnz(stream);
+  tmpStorageBytes = 0;
+  RAFT_CUDA_TRY(cub::DeviceRunLengthEncode::Encode(nullptr,
+                                                   tmpStorageBytes,
+                                                   sortedKeys.data(),
+                                                   uniqueKeys.data(),
+                                                   counts.data(),
+                                                   dNnz.data(),
+                                                   nSamples,
+                                                   stream));
+  cubWorkspace.resize(tmpStorageBytes, stream);
+  RAFT_CUDA_TRY(cub::DeviceRunLengthEncode::Encode(cubWorkspace.data(),
+                                                   tmpStorageBytes,
+                                                   sortedKeys.data(),
+                                                   uniqueKeys.data(),
+                                                   counts.data(),
+                                                   dNnz.data(),
+                                                   nSamples,
+                                                   stream));
+  int nnz = dNnz.value(stream);
+
+  outCOO.allocate(nnz, int(nClasses), false, stream);
+  if (nnz > 0) {
+    devDecodePairKeys<OutT><<<raft::ceildiv(nnz, block), block, 0, stream>>>(uniqueKeys.data(),
+                                                                             counts.data(),
+                                                                             nnz,
+                                                                             outCOO.rows(),
+                                                                             outCOO.cols(),
+                                                                             outCOO.vals(),
+                                                                             nClasses);
+    RAFT_CUDA_TRY(cudaGetLastError());
+  }
+}
+
 /**
  * @brief contruct contingency matrix given input ground truth and prediction
  *        labels. Users should call function getInputClassCardinality to find
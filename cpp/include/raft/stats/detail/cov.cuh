@@ -16,12 +16,50 @@
 
 #pragma once
 
+#include <raft/cuda_utils.cuh>
 #include <raft/linalg/gemm.cuh>
 #include <raft/stats/mean_center.cuh>
 
 namespace raft {
 namespace stats {
 namespace detail {
+
+/**
+ * @brief Mirror the lower triangle written by syrk into the upper one
+ *
+ * syrk only touches one triangle of the output; the public cov contract is a
+ * full D x D matrix, so copy the computed triangle across the diagonal.
+ * Triangles are named in the cublas column-major view, i.e. the lower
+ * triangle lives at covar[c * D + r] for r > c.
+ */
+template <typename Type>
+__global__ void covSymmetrizeLowerKernel(Type* covar, std::size_t D)
+{
+  std::size_t c = threadIdx.x + std::size_t(blockIdx.x) * blockDim.x;
+  std::size_t r = threadIdx.y + std::size_t(blockIdx.y) * blockDim.y;
+  if (r >= D || c >= r) return;
+  covar[r * D + c] = covar[c * D + r];
+}
+
+/**
+ * @brief Turn an accumulated raw product X^T.X into a covariance matrix
+ *
+ * Applies the mean correction and the 1/(N-1) (or 1/N) scaling to the lower
+ * triangle and mirrors the result into the upper one in the same pass:
+ *   covar = scale * (X^T.X - nTotal * mu.mu^T)
+ */
+template <typename Type>
+__global__ void covFinalizeKernel(
+  Type* covar, const Type* mu, std::size_t D, Type nTotal, Type scale)
+{
+  std::size_t c = threadIdx.x + std::size_t(blockIdx.x) * blockDim.x;
+  std::size_t r = threadIdx.y + std::size_t(blockIdx.y) * blockDim.y;
+  if (r >= D || c > r) return;
+  Type val         = (covar[c * D + r] - nTotal * mu[r] * mu[c]) * scale;
+  covar[c * D + r] = val;
+  if (r != c) { covar[r * D + c] = val; }
+}
+
 /**
  * @brief Compute covariance of the input matrix
  *
@@ -63,33 +101,113 @@ void cov(const raft::handle_t& handle,
     raft::stats::meanCenter(data, data, mu, D, N, rowMajor, true, stream);
     Type alpha = Type(1) / (sample ? Type(N - 1) : Type(N));
     Type beta  = Type(0);
-    if (rowMajor) {
-      // #TODO: Call from public API when ready
-      RAFT_CUBLAS_TRY(raft::linalg::detail::cublasgemm(cublas_h,
-                                                       CUBLAS_OP_N,
-                                                       CUBLAS_OP_T,
-                                                       D,
-                                                       D,
-                                                       N,
-                                                       &alpha,
-                                                       data,
-                                                       D,
-                                                       data,
-                                                       D,
-                                                       &beta,
-                                                       covar,
-                                                       D,
-                                                       stream));
-    } else {
-      raft::linalg::gemm(
-        handle, data, N, D, data, covar, D, D, CUBLAS_OP_T, CUBLAS_OP_N, alpha, beta, stream);
-    }
+    // the output is symmetric, so a rank-k update computing only one triangle
+    // does the job at half the FLOPs of the previous full gemm
+    // #TODO: Call from public API when ready
+    RAFT_CUBLAS_TRY(raft::linalg::detail::cublassyrk(cublas_h,
+                                                     CUBLAS_FILL_MODE_LOWER,
+                                                     rowMajor ? CUBLAS_OP_N : CUBLAS_OP_T,
+                                                     D,
+                                                     N,
+                                                     &alpha,
+                                                     data,
+                                                     rowMajor ? D : N,
+                                                     &beta,
+                                                     covar,
+                                                     D,
+                                                     stream));
+    static const int TileDim = 32;
+    dim3 blk(TileDim, TileDim);
+    dim3 grid(raft::ceildiv<std::size_t>(D, TileDim), raft::ceildiv<std::size_t>(D, TileDim));
+    covSymmetrizeLowerKernel<Type><<<grid, blk, 0, stream>>>(covar, D);
   } else {
     ///@todo: implement this using cutlass + customized epilogue!
     ASSERT(false, "cov: Implement stable=false case!");
   }
   RAFT_CUDA_TRY(cudaPeekAtLastError());
 }
+
+/**
+ * @brief Accumulate the raw product X^T.X of a batch of samples into covar
+ *
+ * Together with cov_finalize this computes the covariance of a dataset that
+ * is fed batch-by-batch, without ever holding all samples resident: each call
+ * adds the rank-N update of its batch onto the running D x D accumulator via
+ * syrk (half the FLOPs of a full gemm, only one triangle is touched until
+ * cov_finalize mirrors it).
+ *
+ * @tparam Type the data type
+ * @param handle the raft handle
+ * @param covar the D x D accumulator; must be zeroed (e.g. cudaMemsetAsync)
+ * before the first batch
+ * @param data the batch of samples (not modified, not mean-centered)
+ * @param D number of columns of data
+ * @param N number of rows in this batch
+ * @param rowMajor whether the input data is row or col major
+ * @param stream cuda stream
+ */
+template <typename Type>
+void cov_update(const raft::handle_t& handle,
+                Type* covar,
+                const Type* data,
+                std::size_t D,
+                std::size_t N,
+                bool rowMajor,
+                cudaStream_t stream)
+{
+  cublasHandle_t cublas_h = handle.get_cublas_handle();
+  Type alpha              = Type(1);
+  Type beta               = Type(1);
+  RAFT_CUBLAS_TRY(raft::linalg::detail::cublassyrk(cublas_h,
+                                                   CUBLAS_FILL_MODE_LOWER,
+                                                   rowMajor ? CUBLAS_OP_N : CUBLAS_OP_T,
+                                                   D,
+                                                   N,
+                                                   &alpha,
+                                                   data,
+                                                   rowMajor ? D : N,
+                                                   &beta,
+                                                   covar,
+                                                   D,
+                                                   stream));
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
+}
+
+/**
+ * @brief Turn the accumulator built by cov_update into the covariance matrix
+ *
+ * Applies the mean correction covar = (X^T.X - N * mu.mu^T) / (N - 1 or N)
+ * and fills in the full symmetric output. Note that unlike the stable path of
+ * cov, the mean is subtracted after the product, so the result is more
+ * sensitive to cancellation when the means are large compared to the spread
+ * of the data.
+ *
+ * @tparam Type the data type
+ * @param covar the D x D accumulator holding the raw product; overwritten
+ * with the covariance matrix
+ * @param mu mean vector over all samples fed to cov_update
+ * @param D number of columns of data
+ * @param N total number of samples across all batches
+ * @param sample whether to evaluate sample covariance or not. In other words,
+ * whether to normalize the output using N-1 or N, for true or false,
+ * respectively
+ * @param stream cuda stream
+ */
+template <typename Type>
+void cov_finalize(Type* covar,
+                  const Type* mu,
+                  std::size_t D,
+                  std::size_t N,
+                  bool sample,
+                  cudaStream_t stream)
+{
+  Type scale               = Type(1) / (sample ? Type(N - 1) : Type(N));
+  static const int TileDim = 32;
+  dim3 blk(TileDim, TileDim);
+  dim3 grid(raft::ceildiv<std::size_t>(D, TileDim), raft::ceildiv<std::size_t>(D, TileDim));
+  covFinalizeKernel<Type><<<grid, blk, 0, stream>>>(covar, mu, D, Type(N), scale);
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
+}
 };  // end namespace detail
 };  // end namespace stats
 };  // end namespace raft
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/**
+ * @file distribution_metrics.cuh
+ * @brief Computes entropy, KL divergence and mutual information of two
+ * labelings from a single shared contingency matrix, instead of rebuilding
+ * per-metric histograms for each score.
+ */
+
+#pragma once
+
+#include <cub/cub.cuh>
+#include <math.h>
+#include <raft/cuda_utils.cuh>
+#include <raft/cudart_utils.h>
+#include <raft/interruptible.hpp>
+#include <raft/linalg/reduce.cuh>
+#include <raft/stats/contingency_matrix.cuh>
+#include <rmm/device_uvector.hpp>
+
+namespace raft {
+namespace stats {
+namespace detail {
+
+/** All divergence scores produced by one fused pass over the label pair. */
+struct distribution_metrics_t {
+  /** entropy of the first labeling in nats */
+  double entropy_first;
+  /** entropy of the second labeling in nats */
+  double entropy_second;
+  /** KL(P_first || P_second) over the label marginals */
+  double kl_divergence;
+  /** mutual information of the two labelings */
+  double mutual_info;
+};
+
+/**
+ * @brief fused epilogue over the contingency matrix: every thread owns one
+ * cell for the mutual information term, and the j == 0 column of threads
+ * additionally folds the marginal-only terms (entropies, KL divergence) so
+ * all four scores come out of the single launch.
+ *
+ * @param dContingencyMatrix: the contingency matrix corresponding to the two clusters
+ * @param a: the row wise sum of the contingency matrix (bin counts of the first array)
+ * @param b: the column wise sum of the contingency matrix (bin counts of the second array)
+ * @param numUniqueClasses: number of unique classes
+ * @param size: number of elements in the input arrays
+ * @param d_out: [entropy_first, entropy_second, kl_divergence, mutual_info]
+ */
+template <int BLOCK_DIM_X, int BLOCK_DIM_Y>
+__global__ void distribution_metrics_kernel(const int* dContingencyMatrix,
+                                            const int* a,
+                                            const int* b,
+                                            int numUniqueClasses,
+                                            int size,
+                                            double* d_out)
+{
+  int j = threadIdx.x + blockIdx.x * blockDim.x;
+  int i = threadIdx.y + blockIdx.y * blockDim.y;
+
+  double localHa = 0.0, localHb = 0.0, localKL = 0.0, localMI = 0.0;
+
+  if (i < numUniqueClasses && j < numUniqueClasses && a[i] * b[j] != 0 &&
+      dContingencyMatrix[i * numUniqueClasses + j] != 0) {
+    localMI += (double(dContingencyMatrix[i * numUniqueClasses + j])) *
+               (log(double(size) * double(dContingencyMatrix[i * numUniqueClasses + j])) -
+                log(double(a[i] * b[j])));
+  }
+
+  if (i < numUniqueClasses && j == 0 && blockIdx.x == 0) {
+    double pa = double(a[i]) / size;
+    double pb = double(b[i]) / size;
+    if (pa) {
+      localHa = -pa * log(pa);
+      localKL = pa * (log(pa) - log(pb));
+    }
+    if (pb) { localHb = -pb * log(pb); }
+  }
+
+  typedef cub::BlockReduce<double, BLOCK_DIM_X, cub::BLOCK_REDUCE_WARP_REDUCTIONS, BLOCK_DIM_Y>
+    BlockReduce;
+  __shared__ typename BlockReduce::TempStorage temp_storage;
+
+  double locals[4] = {localHa, localHb, localKL, localMI};
+#pragma unroll
+  for (int m = 0; m < 4; m++) {
+    double blockSum = BlockReduce(temp_storage).Sum(locals[m]);
+    __syncthreads();
+    if (threadIdx.x == 0 && threadIdx.y == 0) { raft::myAtomicAdd(d_out + m, blockSum); }
+  }
+}
+
+/**
+ * @brief Computes entropy of both labelings, KL divergence of their label
+ * distributions, and mutual information in one pass: the contingency matrix
+ * and its marginals are built once and a single fused kernel produces all
+ * four scores.
+ *
+ * @tparam T data-type for input label arrays
+ * @param firstClusterArray: the array of classes of type T
+ * @param secondClusterArray: the array of classes of type T
+ * @param size: the size of the data points of type int
+ * @param lowerLabelRange: the lower bound of the range of labels
+ * @param upperLabelRange: the upper bound of the range of labels
+ * @param stream: the cudaStream object
+ */
+template <typename T>
+distribution_metrics_t distribution_metrics(const T* firstClusterArray,
+                                            const T* secondClusterArray,
+                                            int size,
+                                            T lowerLabelRange,
+                                            T upperLabelRange,
+                                            cudaStream_t stream)
+{
+  int numUniqueClasses = upperLabelRange - lowerLabelRange + 1;
+
+  // the contingency matrix is the only structure built from the raw labels
+  rmm::device_uvector<int> dContingencyMatrix(numUniqueClasses * numUniqueClasses, stream);
+  RAFT_CUDA_TRY(cudaMemsetAsync(
+    dContingencyMatrix.data(), 0, numUniqueClasses * numUniqueClasses * sizeof(int), stream));
+
+  size_t workspaceSz = raft::stats::getContingencyMatrixWorkspaceSize(
+    size, firstClusterArray, stream, lowerLabelRange, upperLabelRange);
+  rmm::device_uvector<char> pWorkspace(workspaceSz, stream);
+
+  raft::stats::contingencyMatrix(firstClusterArray,
+                                 secondClusterArray,
+                                 (int)size,
+                                 (int*)dContingencyMatrix.data(),
+                                 stream,
+                                 (void*)pWorkspace.data(),
+                                 workspaceSz,
+                                 lowerLabelRange,
+                                 upperLabelRange);
+
+  // the marginals double as the per-labeling histograms
+  rmm::device_uvector<int> a(numUniqueClasses, stream);
+  rmm::device_uvector<int> b(numUniqueClasses, stream);
+  rmm::device_uvector<double> d_out(4, stream);
+  RAFT_CUDA_TRY(cudaMemsetAsync(a.data(), 0, numUniqueClasses * sizeof(int), stream));
+  RAFT_CUDA_TRY(cudaMemsetAsync(b.data(), 0, numUniqueClasses * sizeof(int), stream));
+  RAFT_CUDA_TRY(cudaMemsetAsync(d_out.data(), 0, 4 * sizeof(double), stream));
+
+  raft::linalg::reduce<int, int, int>(
+    a.data(), dContingencyMatrix.data(), numUniqueClasses, numUniqueClasses, 0, true, true, stream);
+  raft::linalg::reduce<int, int, int>(b.data(),
+                                      dContingencyMatrix.data(),
+                                      numUniqueClasses,
+                                      numUniqueClasses,
+                                      0,
+                                      true,
+                                      false,
+                                      stream);
+
+  static dim3 BLOCK_DIM(16, 16, 1);
+  dim3 numBlocks(raft::ceildiv<int>(numUniqueClasses, BLOCK_DIM.x),
+                 raft::ceildiv<int>(numUniqueClasses, BLOCK_DIM.y));
+  distribution_metrics_kernel<16, 16><<<numBlocks, BLOCK_DIM, 0, stream>>>(
+    dContingencyMatrix.data(), a.data(), b.data(), numUniqueClasses, size, d_out.data());
+  RAFT_CUDA_TRY(cudaGetLastError());
+
+  double h_out[4];
+  raft::update_host(h_out, d_out.data(), 4, stream);
+  raft::interruptible::synchronize(stream);
+
+  distribution_metrics_t metrics;
+  metrics.entropy_first  = h_out[0];
+  metrics.entropy_second = h_out[1];
+  metrics.kl_divergence  = h_out[2];
+  metrics.mutual_info    = h_out[3] / size;
+  return metrics;
+}
+
+};  // end namespace detail
+};  // end namespace stats
+};  // end namespace raft
@@ -19,8 +19,10 @@
 #include <raft/common/seive.hpp>
 #include <raft/cuda_utils.cuh>
 #include <raft/cudart_utils.h>
+#include <raft/device_atomics.cuh>
 #include <raft/stats/common.hpp>
 #include <raft/vectorized.cuh>
+#include <rmm/device_uvector.hpp>
 #include <stdint.h>
 
 // This file is a shameless amalgamation of independent works done by
@@ -75,14 +77,7 @@ __global__ void gmemHistKernel(
   auto op = [=] __device__(int binId, IdxT row, IdxT col) {
     if (row >= nrows) return;
     auto binOffset = col * nbins;
-#if __CUDA_ARCH__ < 700
-    raft::myAtomicAdd(bins + binOffset + binId, 1);
-#else
-    auto amask  = __activemask();
-    auto mask   = __match_any_sync(amask, binId);
-    auto leader = __ffs(mask) - 1;
-    if (raft::laneId() == leader) { raft::myAtomicAdd(bins + binOffset + binId, __popc(mask)); }
-#endif  // __CUDA_ARCH__
+    raft::aggregated_atomic_add(bins + binOffset + binId, 1);
   };
   histCoreOp<DataT, BinnerOp, IdxT, VecLen>(data, nrows, nbins, binner, op, blockIdx.y);
 }
@@ -102,6 +97,68 @@ void gmemHist(int* bins,
     <<<blks, ThreadsPerBlock, 0, stream>>>(bins, data, nrows, nbins, binner);
 }
 
+template <typename DataT, typename BinnerOp, typename IdxT, int VecLen>
+__global__ void gmemPrivHistKernel(
+  int* pbins, const DataT* data, IdxT nrows, IdxT nbins, BinnerOp binner, int nCopies)
+{
+  auto copy = int(blockIdx.x) % nCopies;
+  auto op   = [=] __device__(int binId, IdxT row, IdxT col) {
+    if (row >= nrows) return;
+    auto binOffset = (col * nCopies + copy) * nbins;
+    raft::aggregated_atomic_add(pbins + binOffset + binId, 1);
+  };
+  histCoreOp<DataT, BinnerOp, IdxT, VecLen>(data, nrows, nbins, binner, op, blockIdx.y);
+}
+
+template <typename IdxT>
+__global__ void gmemPrivMergeKernel(int* bins, const int* pbins, IdxT nbins, int nCopies)
+{
+  IdxT col    = blockIdx.y;
+  IdxT tid    = threadIdx.x + IdxT(blockDim.x) * blockIdx.x;
+  IdxT stride = IdxT(blockDim.x) * gridDim.x;
+  for (auto i = tid; i < nbins; i += stride) {
+    int sum = 0;
+    for (int c = 0; c < nCopies; ++c) {
+      sum += pbins[(col * nCopies + c) * nbins + i];
+    }
+    bins[col * nbins + i] += sum;
+  }
+}
+
+template <typename DataT, typename BinnerOp, typename IdxT, int VecLen>
+void gmemPrivHist(int* bins,
+                  IdxT nbins,
+                  const DataT* data,
+                  IdxT nrows,
+                  IdxT ncols,
+                  BinnerOp binner,
+                  cudaStream_t stream)
+{
+  auto blks = computeGridDim<IdxT, VecLen>(
+    nrows, ncols, (const void*)gmemPrivHistKernel<DataT, BinnerOp, IdxT, VecLen>);
+  // each copy is only touched by its own group of blocks, so the atomic
+  // contention on a given bin drops by the number of copies. Cap the copies
+  // both by their usefulness (one per block at most) and by their footprint.
+  static const int maxCopies       = 32;
+  static const size_t maxPrivBytes = 256 * 1024 * 1024;
+  size_t copyBytes                 = size_t(ncols) * nbins * sizeof(int);
+  auto budgetCopies                = std::max<size_t>(size_t(1), maxPrivBytes / copyBytes);
+  int nCopies                      = std::min<int>(blks.x, maxCopies);
+  if (size_t(nCopies) > budgetCopies) { nCopies = int(budgetCopies); }
+  if (nCopies <= 1) {
+    // a single copy degenerates to plain global atomics
+    gmemHist<DataT, BinnerOp, IdxT, VecLen>(bins, nbins, data, nrows, ncols, binner, stream);
+    return;
+  }
+  rmm::device_uvector<int> pbins(size_t(nCopies) * ncols * nbins, stream);
+  RAFT_CUDA_TRY(cudaMemsetAsync(pbins.data(), 0, pbins.size() * sizeof(int), stream));
+  gmemPrivHistKernel<DataT, BinnerOp, IdxT, VecLen>
+    <<<blks, ThreadsPerBlock, 0, stream>>>(pbins.data(), data, nrows, nbins, binner, nCopies);
+  dim3 mergeBlks(int(raft::ceildiv<IdxT>(nbins, ThreadsPerBlock)), ncols);
+  gmemPrivMergeKernel<IdxT>
+    <<<mergeBlks, ThreadsPerBlock, 0, stream>>>(bins, pbins.data(), nbins, nCopies);
+}
+
 template <typename DataT, typename BinnerOp, typename IdxT, int VecLen, bool UseMatchAny>
 __global__ void smemHistKernel(
   int* bins, const DataT* data, IdxT nrows, IdxT nbins, BinnerOp binner)
@@ -113,20 +170,11 @@ __global__ void smemHistKernel(
   __syncthreads();
   auto op = [=] __device__(int binId, IdxT row, IdxT col) {
     if (row >= nrows) return;
-#if __CUDA_ARCH__ < 700
-    raft::myAtomicAdd<unsigned int>(sbins + binId, 1);
-#else
     if (UseMatchAny) {
-      auto amask  = __activemask();
-      auto mask   = __match_any_sync(amask, binId);
-      auto leader = __ffs(mask) - 1;
-      if (raft::laneId() == leader) {
-        raft::myAtomicAdd<unsigned int>(sbins + binId, __popc(mask));
-      }
+      raft::aggregated_atomic_add(sbins + binId, 1u);
     } else {
       raft::myAtomicAdd<unsigned int>(sbins + binId, 1);
     }
-#endif  // __CUDA_ARCH__
   };
   IdxT col = blockIdx.y;
   histCoreOp<DataT, BinnerOp, IdxT, VecLen>(data, nrows, nbins, binner, op, col);
@@ -373,6 +421,9 @@ void histogramVecLen(HistType type,
     case HistTypeGmem:
       gmemHist<DataT, BinnerOp, IdxT, VecLen>(bins, nbins, data, nrows, ncols, binner, stream);
       break;
+    case HistTypeGmemPriv:
+      gmemPrivHist<DataT, BinnerOp, IdxT, VecLen>(bins, nbins, data, nrows, ncols, binner, stream);
+      break;
     case HistTypeSmem:
       smemHist<DataT, BinnerOp, IdxT, VecLen, false>(
         bins, nbins, data, nrows, ncols, binner, stream);
@@ -450,7 +501,9 @@ HistType selectBestHistAlgo(IdxT nbins)
     requiredSize       = raft::alignTo<size_t>(nBytesForBins, sizeof(unsigned));
     if (requiredSize <= smem) { return static_cast<HistType>(bits); }
   }
-  return HistTypeGmem;
+  // for bin counts beyond even the packed smem variants, privatized gmem
+  // copies keep the atomic contention per bin flat as nbins grows
+  return HistTypeGmemPriv;
 }
 
 /**
@@ -33,6 +33,8 @@ class mean_var {
   HDI mean_var() : w(0.0), m(0.0), s(0.0) {}
   /** Lift a single value. */
   HDI explicit mean_var(T x) : w(1.0), m(x), s(0.0) {}
+  /** Lift a single weighted value (frequency-weight semantics). */
+  HDI mean_var(T x, T weight) : w(weight), m(x), s(0.0) {}
 
   /**
    * Monoidal binary op: combine means and vars of two sets.
@@ -192,6 +194,103 @@ __global__ void meanvar_kernel_fill(T* mean, T* var, const mean_var<T>* aggr, I
   var[i]  = x.var(sample);
 }
 
+/**
+ * Like `meanvar_kernel_colmajor`, but merges the per-column aggregates into a
+ * persistent state instead of writing out the final mean/var. Exactly one
+ * block works on a column, so no locking is needed.
+ */
+template <typename T, typename I, int BlockSize>
+__global__ void __launch_bounds__(BlockSize)
+  meanvar_kernel_colmajor_update(volatile mean_var<T>* mvs, const T* data, I D, I N)
+{
+  using BlockReduce = cub::BlockReduce<mean_var<T>, BlockSize>;
+  __shared__ typename BlockReduce::TempStorage shm;
+
+  const T* block_data = data + N * blockIdx.x;
+  mean_var<T> thread_data;
+  for (I i = threadIdx.x; i < N; i += BlockSize) {
+    thread_data += mean_var<T>(block_data[i]);
+  }
+  mean_var<T> acc = BlockReduce(shm).Sum(thread_data);
+  if (threadIdx.x == 0) {
+    mean_var<T> global_data;
+    global_data.load(mvs + blockIdx.x);
+    global_data += acc;
+    global_data.store(mvs + blockIdx.x);
+  }
+}
+
+/**
+ * Accumulator state for computing mean and variance over a stream of batches.
+ *
+ * Holds one `mean_var<T>` per column (count, mean and M2 fused in one record)
+ * plus the locks used by the row-major kernel. Batches may arrive in
+ * arbitrarily many `meanvar_update` calls; since `mean_var` combination is
+ * associative, the finalized result is identical to a single pass over the
+ * concatenated data, without ever materializing it.
+ */
+template <typename T, typename I = int>
+class meanvar_state {
+ public:
+  meanvar_state(I D, cudaStream_t stream)
+    : D_(D), buf_(sizeof(mean_var<T>) * D + sizeof(int) * raft::ceildiv<I>(D, I(WarpSize)), stream)
+  {
+    reset(stream);
+  }
+
+  /** Drop all batches accumulated so far. */
+  void reset(cudaStream_t stream)
+  {
+    RAFT_CUDA_TRY(cudaMemsetAsync(buf_.data(), 0, buf_.size(), stream));
+  }
+
+  I cols() const { return D_; }
+  mean_var<T>* aggregates() { return static_cast<mean_var<T>*>(buf_.data()); }
+  int* locks() { return static_cast<int*>(static_cast<void*>(aggregates() + D_)); }
+
+ private:
+  I D_;
+  rmm::device_buffer buf_;
+};
+
+template <typename T, typename I = int, int BlockSize = 256>
+void meanvar_update(
+  meanvar_state<T, I>& state, const T* data, I N, bool rowMajor, cudaStream_t stream)
+{
+  const I D = state.cols();
+  if (N <= 0) return;
+  if (rowMajor) {
+    static_assert(BlockSize >= WarpSize, "Block size must be not smaller than the warp size.");
+    const dim3 bs(WarpSize, BlockSize / WarpSize, 1);
+    dim3 gs(raft::ceildiv<decltype(bs.x)>(D, bs.x), raft::ceildiv<decltype(bs.y)>(N, bs.y), 1);
+
+    // Don't create more blocks than necessary to occupy the GPU
+    int occupancy;
+    RAFT_CUDA_TRY(cudaOccupancyMaxActiveBlocksPerMultiprocessor(
+      &occupancy, meanvar_kernel_rowmajor<T, I, BlockSize>, BlockSize, 0));
+    gs.y =
+      std::min(gs.y, raft::ceildiv<decltype(gs.y)>(occupancy * getMultiProcessorCount(), gs.x));
+
+    const uint64_t len = uint64_t(D) * uint64_t(N);
+    ASSERT(len <= uint64_t(std::numeric_limits<I>::max()), "N * D does not fit the indexing type");
+    meanvar_kernel_rowmajor<T, I, BlockSize>
+      <<<gs, bs, 0, stream>>>(data, state.aggregates(), state.locks(), len, D);
+  } else {
+    meanvar_kernel_colmajor_update<T, I, BlockSize>
+      <<<D, BlockSize, 0, stream>>>(state.aggregates(), data, D, N);
+  }
+  RAFT_CHECK_CUDA(stream);
+}
+
+template <typename T, typename I = int, int BlockSize = 256>
+void meanvar_finalize(meanvar_state<T, I>& state, T* mean, T* var, bool sample, cudaStream_t stream)
+{
+  const I D = state.cols();
+  meanvar_kernel_fill<T, I><<<raft::ceildiv<I>(D, BlockSize), BlockSize, 0, stream>>>(
+    mean, var, state.aggregates(), D, sample);
+  RAFT_CHECK_CUDA(stream);
+}
+
 template <typename T, typename I = int, int BlockSize = 256>
 void meanvar(
   T* mean, T* var, const T* data, I D, I N, bool sample, bool rowMajor, cudaStream_t stream)
@@ -32,6 +32,7 @@
 #include <raft/interruptible.hpp>
 #include <raft/linalg/reduce.cuh>
 #include <raft/stats/contingency_matrix.cuh>
+#include <raft/stats/histogram.cuh>
 #include <rmm/device_scalar.hpp>
 #include <rmm/device_uvector.hpp>
 
@@ -174,6 +175,127 @@ double mutual_info_score(const T* firstClusterArray,
   return h_MI / size;
 }
 
+/**
+ * @brief kernel to calculate the mutual info score from a COO contingency matrix
+ * @param rows: row indices of the non-zero contingency matrix entries
+ * @param cols: column indices of the non-zero contingency matrix entries
+ * @param vals: counts of the non-zero contingency matrix entries
+ * @param nnz: number of non-zero entries
+ * @param a: bin counts of the first cluster array
+ * @param b: bin counts of the second cluster array
+ * @param size: the total number of data points
+ * @param d_MI: pointer to the device memory that stores the aggreggate mutual information
+ */
+template <int TPB>
+__global__ void mutual_info_coo_kernel(const int* rows,
+                                       const int* cols,
+                                       const int* vals,
+                                       int nnz,
+                                       const int* a,
+                                       const int* b,
+                                       int size,
+                                       double* d_MI)
+{
+  int idx = threadIdx.x + blockIdx.x * blockDim.x;
+
+  double localMI = 0.0;
+
+  if (idx < nnz && vals[idx] != 0) {
+    double nij = double(vals[idx]);
+    double ab  = double(a[rows[idx]]) * double(b[cols[idx]]);
+    if (ab != 0) { localMI = nij * (log(double(size) * nij) - log(ab)); }
+  }
+
+  typedef cub::BlockReduce<double, TPB> BlockReduce;
+  __shared__ typename BlockReduce::TempStorage temp_storage;
+  localMI = BlockReduce(temp_storage).Sum(localMI);
+  __syncthreads();
+
+  if (threadIdx.x == 0) { raft::myAtomicAdd(d_MI, localMI); }
+}
+
+/**
+ * @brief Mutual information via a sparse (COO) contingency matrix
+ *
+ * Equivalent to `mutual_info_score` but never materializes the dense
+ * numUniqueClasses^2 contingency matrix: only the non-zero pair counts are
+ * visited, and the marginals come from per-label bincounts of the inputs,
+ * so the cost is linear in the number of distinct label pairs.
+ *
+ * @param firstClusterArray: the array of classes of type T
+ * @param secondClusterArray: the array of classes of type T
+ * @param size: the size of the data points of type int
+ * @param lowerLabelRange: the lower bound of the range of labels
+ * @param upperLabelRange: the upper bound of the range of labels
+ * @param stream: the cudaStream object
+ */
+template <typename T>
+double mutual_info_score_sparse(const T* firstClusterArray,
+                                const T* secondClusterArray,
+                                int size,
+                                T lowerLabelRange,
+                                T upperLabelRange,
+                                cudaStream_t stream)
+{
+  int numUniqueClasses = upperLabelRange - lowerLabelRange + 1;
+
+  // calculating the sparse contingency matrix
+  raft::sparse::COO<int, int> contingencyCOO(stream);
+  raft::stats::contingencyMatrixSparse(firstClusterArray,
+                                       secondClusterArray,
+                                       (int)size,
+                                       contingencyCOO,
+                                       stream,
+                                       lowerLabelRange,
+                                       upperLabelRange);
+
+  // the marginals of the contingency matrix are the per-label bincounts of
+  // the inputs, so no row/column reduction of the matrix is needed
+  rmm::device_uvector<int> a(numUniqueClasses, stream);
+  rmm::device_uvector<int> b(numUniqueClasses, stream);
+  raft::stats::histogram<T, int>(
+    raft::stats::HistTypeAuto,
+    a.data(),
+    numUniqueClasses,
+    firstClusterArray,
+    size,
+    1,
+    stream,
+    [lowerLabelRange] __device__(T val, int row, int col) { return int(val - lowerLabelRange); });
+  raft::stats::histogram<T, int>(
+    raft::stats::HistTypeAuto,
+    b.data(),
+    numUniqueClasses,
+    secondClusterArray,
+    size,
+    1,
+    stream,
+    [lowerLabelRange] __device__(T val, int row, int col) { return int(val - lowerLabelRange); });
+
+  rmm::device_scalar<double> d_MI(stream);
+  RAFT_CUDA_TRY(cudaMemsetAsync(d_MI.data(), 0, sizeof(double), stream));
+
+  static const int TPB = 256;
+  if (contingencyCOO.nnz > 0) {
+    mutual_info_coo_kernel<TPB><<<raft::ceildiv(contingencyCOO.nnz, TPB), TPB, 0, stream>>>(
+      contingencyCOO.rows(),
+      contingencyCOO.cols(),
+      contingencyCOO.vals(),
+      contingencyCOO.nnz,
+      a.data(),
+      b.data(),
+      size,
+      d_MI.data());
+    RAFT_CUDA_TRY(cudaGetLastError());
+  }
+
+  double h_MI = d_MI.value(stream);
+
+  raft::interruptible::synchronize(stream);
+
+  return h_MI / size;
+}
+
 };  // end namespace detail
 };  // end namespace stats
 };  // end namespace raft
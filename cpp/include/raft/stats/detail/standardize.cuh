@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <raft/cuda_utils.cuh>
+#include <raft/linalg/matrix_vector_op.cuh>
+#include <raft/linalg/unary_op.cuh>
+#include <raft/stats/detail/meanvar.cuh>
+
+namespace raft {
+namespace stats {
+namespace detail {
+
+/**
+ * Weighted variant of `meanvar_kernel_rowmajor`: every row carries a
+ * weight, lifted into the `mean_var` monoid as a frequency weight.
+ * Assumptions as in the unweighted kernel (blockDim.x == WarpSize,
+ * X along columns, Y along rows).
+ */
+template <typename T, typename I, int BlockSize>
+__global__ void __launch_bounds__(BlockSize) weighted_meanvar_kernel_rowmajor(
+  const T* data, const T* weights, volatile mean_var<T>* mvs, int* locks, I N, I D)
+{
+  // read the data
+  const I col = threadIdx.x + blockDim.x * blockIdx.x;
+  mean_var<T> thread_data;
+  if (col < D) {
+    const I rstep = blockDim.y * gridDim.y;
+    for (I r = threadIdx.y + blockDim.y * blockIdx.y; r < N; r += rstep) {
+      thread_data += mean_var<T>(data[col + D * r], weights[r]);
+    }
+  }
+
+  // aggregate within block
+  if (blockDim.y > 1) {
+    __shared__ uint8_t shm_bytes[BlockSize * sizeof(mean_var<T>)];
+    auto shm = (mean_var<T>*)shm_bytes;
+    int tid  = threadIdx.x + threadIdx.y * blockDim.x;
+    shm[tid] = thread_data;
+    for (int bs = BlockSize >> 1; bs >= blockDim.x; bs = bs >> 1) {
+      __syncthreads();
+      if (tid < bs) { shm[tid] += shm[tid + bs]; }
+    }
+    thread_data = shm[tid];
+  }
+
+  // aggregate across blocks
+  if (threadIdx.y == 0) {
+    int* lock = locks + blockIdx.x;
+    if (threadIdx.x == 0 && col < D) {
+      while (atomicCAS(lock, 0, 1) == 1) {
+        __threadfence();
+      }
+    }
+    __syncthreads();
+    if (col < D) {
+      __threadfence();
+      mean_var<T> global_data;
+      global_data.load(mvs + col);
+      global_data += thread_data;
+      global_data.store(mvs + col);
+      __threadfence();
+    }
+    __syncthreads();
+    if (threadIdx.x == 0 && col < D) { __stwt(lock, 0); }
+  }
+}
+
+/** Weighted variant of `meanvar_kernel_colmajor`. */
+template <typename T, typename I, int BlockSize>
+__global__ void __launch_bounds__(BlockSize) weighted_meanvar_kernel_colmajor(
+  T* mean, T* var, const T* data, const T* weights, I D, I N, bool sample)
+{
+  using BlockReduce = cub::BlockReduce<mean_var<T>, BlockSize>;
+  __shared__ typename BlockReduce::TempStorage shm;
+
+  const T* block_data = data + N * blockIdx.x;
+  mean_var<T> thread_data;
+  for (I i = threadIdx.x; i < N; i += BlockSize) {
+    thread_data += mean_var<T>(block_data[i], weights[i]);
+  }
+  mean_var<T> acc = BlockReduce(shm).Sum(thread_data);
+  if (threadIdx.x == 0) {
+    mean[blockIdx.x] = acc.mean();
+    var[blockIdx.x]  = acc.var(sample);
+  }
+}
+
+/**
+ * Single-sweep weighted mean and variance for each column, the weighted
+ * counterpart of `meanvar`. Weights are interpreted as frequency
+ * weights: the result matches an unweighted pass over data with every
+ * row repeated `weights[row]` times.
+ */
+template <typename T, typename I = int, int BlockSize = 256>
+void weightedMeanVar(T* mean,
+                     T* var,
+                     const T* data,
+                     const T* weights,
+                     I D,
+                     I N,
+                     bool sample,
+                     bool rowMajor,
+                     cudaStream_t stream)
+{
+  if (rowMajor) {
+    static_assert(BlockSize >= WarpSize, "Block size must be not smaller than the warp size.");
+    const dim3 bs(WarpSize, BlockSize / WarpSize, 1);
+    dim3 gs(raft::ceildiv<decltype(bs.x)>(D, bs.x), raft::ceildiv<decltype(bs.y)>(N, bs.y), 1);
+
+    // Don't create more blocks than necessary to occupy the GPU
+    int occupancy;
+    RAFT_CUDA_TRY(cudaOccupancyMaxActiveBlocksPerMultiprocessor(
+      &occupancy, weighted_meanvar_kernel_rowmajor<T, I, BlockSize>, BlockSize, 0));
+    gs.y =
+      std::min(gs.y, raft::ceildiv<decltype(gs.y)>(occupancy * getMultiProcessorCount(), gs.x));
+
+    // Global memory: one mean_var<T> for each column
+    //                one lock per all blocks working on the same set of columns
+    rmm::device_buffer buf(sizeof(mean_var<T>) * D + sizeof(int) * gs.x, stream);
+    RAFT_CUDA_TRY(cudaMemsetAsync(buf.data(), 0, buf.size(), stream));
+    mean_var<T>* mvs = static_cast<mean_var<T>*>(buf.data());
+    int* locks       = static_cast<int*>(static_cast<void*>(mvs + D));
+
+    weighted_meanvar_kernel_rowmajor<T, I, BlockSize>
+      <<<gs, bs, 0, stream>>>(data, weights, mvs, locks, N, D);
+    meanvar_kernel_fill<T, I>
+      <<<raft::ceildiv<I>(D, BlockSize), BlockSize, 0, stream>>>(mean, var, mvs, D, sample);
+  } else {
+    weighted_meanvar_kernel_colmajor<T, I, BlockSize>
+      <<<D, BlockSize, 0, stream>>>(mean, var, data, weights, D, N, sample);
+  }
+  RAFT_CHECK_CUDA(stream);
+}
+
+/**
+ * Fused standardization: per-column (optionally weighted) mean and
+ * variance in one sweep, then center+scale applied in a second sweep.
+ * No intermediate matrix is materialized; `out` may alias `data` for
+ * in-place operation. Columns with zero variance are only centered.
+ */
+template <typename Type, typename IdxType = int, int BlockSize = 256>
+void standardize(Type* out,
+                 const Type* data,
+                 Type* mu,
+                 Type* stddev,
+                 IdxType D,
+                 IdxType N,
+                 bool sample,
+                 bool rowMajor,
+                 cudaStream_t stream,
+                 const Type* weights = nullptr)
+{
+  // first sweep: column statistics (stddev temporarily holds the variance)
+  if (weights == nullptr) {
+    meanvar<Type, IdxType, BlockSize>(mu, stddev, data, D, N, sample, rowMajor, stream);
+  } else {
+    weightedMeanVar<Type, IdxType, BlockSize>(
+      mu, stddev, data, weights, D, N, sample, rowMajor, stream);
+  }
+  raft::linalg::unaryOp(
+    stddev, stddev, D, [] __device__(Type v) { return raft::mySqrt(v); }, stream);
+
+  // second sweep: center and scale in one pass over the matrix
+  raft::linalg::matrixVectorOp(
+    out,
+    data,
+    mu,
+    stddev,
+    D,
+    N,
+    rowMajor,
+    true,
+    [] __device__(Type a, Type b, Type c) { return c > Type(0) ? (a - b) / c : a - b; },
+    stream);
+}
+
+};  // end namespace detail
+};  // end namespace stats
+};  // end namespace raft
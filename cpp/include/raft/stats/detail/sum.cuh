@@ -18,6 +18,7 @@
 
 #include <raft/cuda_utils.cuh>
 #include <raft/linalg/eltwise.cuh>
+#include <raft/vectorized.cuh>
 
 #include <cub/cub.cuh>
 
@@ -61,6 +62,173 @@ __global__ void sumKernelColMajor(Type* mu, const Type* data, IdxType D, IdxType
   if (threadIdx.x == 0) { mu[blockIdx.x] = acc; }
 }
 
+/**
+ * Neumaier variant of the Kahan compensated addition: unlike plain Kahan it
+ * keeps the compensation valid regardless of which operand is larger, so the
+ * running error stays O(eps) instead of O(N * eps) for adversarial orderings.
+ */
+template <typename Type>
+DI void kahanAdd(Type& sum, Type& comp, Type val)
+{
+  Type t = sum + val;
+  if (raft::myAbs(sum) >= raft::myAbs(val)) {
+    comp += (sum - t) + val;
+  } else {
+    comp += (val - t) + sum;
+  }
+  sum = t;
+}
+
+/**
+ * Compensated row-major sum kernel.
+ *
+ * Each thread owns VecLen adjacent columns, loaded with a single vectorized
+ * read per row, and keeps a (sum, compensation) pair per column in registers.
+ * Only the long per-thread accumulation needs compensation; the handful of
+ * partials merged through shared/global atomics contribute O(blocks * eps)
+ * which is negligible next to the O(N) pass they summarize.
+ *
+ * Requires D % VecLen == 0 (the host code falls back to VecLen = 1 otherwise).
+ */
+template <typename Type, typename IdxType, int TPB, int ColsPerBlk, int VecLen>
+__global__ void sumKahanKernelRowMajor(Type* mu, const Type* data, IdxType D, IdxType N)
+{
+  constexpr int ColGroupsPerBlk   = ColsPerBlk / VecLen;
+  constexpr int RowsPerBlkPerIter = TPB / ColGroupsPerBlk;
+  IdxType thisColId               = threadIdx.x % ColGroupsPerBlk;
+  IdxType thisRowId               = threadIdx.x / ColGroupsPerBlk;
+  IdxType colId        = (thisColId + ((IdxType)blockIdx.y * ColGroupsPerBlk)) * VecLen;
+  IdxType rowId        = thisRowId + ((IdxType)blockIdx.x * RowsPerBlkPerIter);
+  const IdxType stride = RowsPerBlkPerIter * gridDim.x;
+  Type thread_sum[VecLen];
+  Type thread_comp[VecLen];
+#pragma unroll
+  for (int j = 0; j < VecLen; j++) {
+    thread_sum[j]  = Type(0);
+    thread_comp[j] = Type(0);
+  }
+  if (colId < D) {
+    raft::TxN_t<Type, VecLen> vec;
+    for (IdxType i = rowId; i < N; i += stride) {
+      vec.load(data, i * D + colId);
+#pragma unroll
+      for (int j = 0; j < VecLen; j++) {
+        kahanAdd(thread_sum[j], thread_comp[j], vec.val.data[j]);
+      }
+    }
+  }
+  __shared__ Type ssum[ColsPerBlk];
+  __shared__ Type scomp[ColsPerBlk];
+  if (threadIdx.x < ColsPerBlk) {
+    ssum[threadIdx.x]  = Type(0);
+    scomp[threadIdx.x] = Type(0);
+  }
+  __syncthreads();
+  if (colId < D) {
+#pragma unroll
+    for (int j = 0; j < VecLen; j++) {
+      raft::myAtomicAdd(ssum + thisColId * VecLen + j, thread_sum[j]);
+      raft::myAtomicAdd(scomp + thisColId * VecLen + j, thread_comp[j]);
+    }
+  }
+  __syncthreads();
+  if (threadIdx.x < ColsPerBlk) {
+    IdxType col = (IdxType)blockIdx.y * ColsPerBlk + threadIdx.x;
+    if (col < D) { raft::myAtomicAdd(mu + col, ssum[threadIdx.x] + scomp[threadIdx.x]); }
+  }
+}
+
+/**
+ * Compensated col-major sum kernel: one block per column, vectorized loads
+ * along the contiguous column, per-thread (sum, compensation) pairs reduced
+ * via cub.
+ *
+ * Requires N % VecLen == 0 (the host code falls back to VecLen = 1 otherwise).
+ */
+template <typename Type, typename IdxType, int TPB, int VecLen>
+__global__ void sumKahanKernelColMajor(Type* mu, const Type* data, IdxType D, IdxType N)
+{
+  typedef cub::BlockReduce<Type, TPB> BlockReduce;
+  __shared__ typename BlockReduce::TempStorage temp_storage;
+  Type thread_sum  = Type(0);
+  Type thread_comp = Type(0);
+  IdxType colStart = N * blockIdx.x;
+  IdxType numVecs  = N / VecLen;
+  raft::TxN_t<Type, VecLen> vec;
+  for (IdxType i = threadIdx.x; i < numVecs; i += TPB) {
+    vec.load(data, colStart + i * VecLen);
+#pragma unroll
+    for (int j = 0; j < VecLen; j++) {
+      kahanAdd(thread_sum, thread_comp, vec.val.data[j]);
+    }
+  }
+  Type block_sum = BlockReduce(temp_storage).Sum(thread_sum);
+  __syncthreads();
+  Type block_comp = BlockReduce(temp_storage).Sum(thread_comp);
+  if (threadIdx.x == 0) { mu[blockIdx.x] = block_sum + block_comp; }
+}
+
+template <typename Type, typename IdxType, int TPB, int ColsPerBlk, int VecLen>
+void sumKahanRowMajorLaunch(
+  Type* output, const Type* input, IdxType D, IdxType N, cudaStream_t stream)
+{
+  static const int RowsPerThread   = 4;
+  static const int ColGroupsPerBlk = ColsPerBlk / VecLen;
+  static const int RowsPerBlk      = (TPB / ColGroupsPerBlk) * RowsPerThread;
+  // cap the number of row-blocks: fewer, longer compensated per-thread runs
+  // mean fewer uncompensated cross-block merges
+  dim3 grid(std::min(raft::ceildiv(N, (IdxType)RowsPerBlk), (IdxType)1024),
+            raft::ceildiv(D, (IdxType)ColsPerBlk));
+  RAFT_CUDA_TRY(cudaMemsetAsync(output, 0, sizeof(Type) * D, stream));
+  sumKahanKernelRowMajor<Type, IdxType, TPB, ColsPerBlk, VecLen>
+    <<<grid, TPB, 0, stream>>>(output, input, D, N);
+}
+
+/**
+ * @brief Kahan/Neumaier-compensated column-wise sum
+ *
+ * Same contract as `sum`, but the per-thread accumulation carries a running
+ * compensation term, so the result keeps near-fp64 accuracy in fp32 (error
+ * independent of N instead of growing with it) while reading the data once at
+ * fp32 bandwidth. The contiguous dimension is loaded through `TxN_t`
+ * vectorized reads whenever its extent and the base pointer allow it.
+ */
+template <typename Type, typename IdxType = int>
+void sumKahan(
+  Type* output, const Type* input, IdxType D, IdxType N, bool rowMajor, cudaStream_t stream)
+{
+  static const int TPB        = 256;
+  static const int ColsPerBlk = 32;
+  // the contiguous dimension must be a multiple of the vector length (in
+  // bytes) and the base pointer aligned accordingly, or vectorized loads would
+  // misalign; dispatching on bytes keeps each Type instantiated only at the
+  // vector widths `TxN_t` actually provides (e.g. double has no 4-wide IO type)
+  size_t bytes  = sizeof(Type) * size_t(rowMajor ? D : N);
+  uint64_t addr = uint64_t(input);
+  if (rowMajor) {
+    if (16 / sizeof(Type) && bytes % 16 == 0 && addr % 16 == 0) {
+      sumKahanRowMajorLaunch<Type, IdxType, TPB, ColsPerBlk, 16 / sizeof(Type)>(
+        output, input, D, N, stream);
+    } else if (8 / sizeof(Type) && bytes % 8 == 0 && addr % 8 == 0) {
+      sumKahanRowMajorLaunch<Type, IdxType, TPB, ColsPerBlk, 8 / sizeof(Type)>(
+        output, input, D, N, stream);
+    } else {
+      sumKahanRowMajorLaunch<Type, IdxType, TPB, ColsPerBlk, 1>(output, input, D, N, stream);
+    }
+  } else {
+    if (16 / sizeof(Type) && bytes % 16 == 0 && addr % 16 == 0) {
+      sumKahanKernelColMajor<Type, IdxType, TPB, 16 / sizeof(Type)>
+        <<<D, TPB, 0, stream>>>(output, input, D, N);
+    } else if (8 / sizeof(Type) && bytes % 8 == 0 && addr % 8 == 0) {
+      sumKahanKernelColMajor<Type, IdxType, TPB, 8 / sizeof(Type)>
+        <<<D, TPB, 0, stream>>>(output, input, D, N);
+    } else {
+      sumKahanKernelColMajor<Type, IdxType, TPB, 1><<<D, TPB, 0, stream>>>(output, input, D, N);
+    }
+  }
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
+}
+
 template <typename Type, typename IdxType = int>
 void sum(Type* output, const Type* input, IdxType D, IdxType N, bool rowMajor, cudaStream_t stream)
 {
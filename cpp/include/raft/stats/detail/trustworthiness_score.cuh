@@ -214,6 +214,127 @@ double trustworthiness_score(const raft::handle_t& h,
   return t;
 }
 
+/**
+ * @brief Precompute the original-space neighbor ranks used by the
+ * trustworthiness score
+ *
+ * Row i of the resulting table holds the rank of every sample in i's
+ * original-space distance order. The table only depends on X, so when the
+ * same dataset is scored against many embeddings (e.g. once per training
+ * epoch) it can be built once, serialized by the caller as a plain n * n
+ * device buffer, and reused via `trustworthiness_score_precomputed`.
+ *
+ * @param h Raft handle
+ * @param X[in]: Data in original dimension
+ * @param n: Number of samples
+ * @param m: Number of features in high/original dimension
+ * @param[out] lookup_table: Neighbor rank table (size n * n)
+ * @param batchSize Batch size
+ */
+template <typename math_t, raft::distance::DistanceType distance_type>
+void trustworthiness_precompute(const raft::handle_t& h,
+                                const math_t* X,
+                                int n,
+                                int m,
+                                int* lookup_table,
+                                int batchSize = 512)
+{
+  cudaStream_t stream = h.get_stream();
+
+  const int PAIRWISE_ALLOC = batchSize * n;
+  rmm::device_uvector<int> X_ind(PAIRWISE_ALLOC, stream);
+  rmm::device_uvector<math_t> X_dist(PAIRWISE_ALLOC, stream);
+
+  int toDo = n;
+  while (toDo > 0) {
+    int curBatchSize = min(toDo, batchSize);
+
+    // Takes at most batchSize vectors at a time
+    raft::distance::pairwise_distance(
+      h, &X[(n - toDo) * m], X, X_dist.data(), curBatchSize, n, m, distance_type);
+
+    size_t colSortWorkspaceSize = 0;
+    bool bAllocWorkspace        = false;
+
+    raft::matrix::sort_cols_per_row(X_dist.data(),
+                                    X_ind.data(),
+                                    curBatchSize,
+                                    n,
+                                    bAllocWorkspace,
+                                    nullptr,
+                                    colSortWorkspaceSize,
+                                    stream);
+
+    if (bAllocWorkspace) {
+      rmm::device_uvector<char> sortColsWorkspace(colSortWorkspaceSize, stream);
+
+      raft::matrix::sort_cols_per_row(X_dist.data(),
+                                      X_ind.data(),
+                                      curBatchSize,
+                                      n,
+                                      bAllocWorkspace,
+                                      sortColsWorkspace.data(),
+                                      colSortWorkspaceSize,
+                                      stream);
+    }
+
+    int work     = curBatchSize * n;
+    int n_blocks = raft::ceildiv(work, N_THREADS);
+    build_lookup_table<<<n_blocks, N_THREADS, 0, stream>>>(
+      &lookup_table[(n - toDo) * n], X_ind.data(), n, work);
+    RAFT_CUDA_TRY(cudaPeekAtLastError());
+
+    toDo -= curBatchSize;
+  }
+}
+
+/**
+ * @brief Compute the trustworthiness score against a precomputed rank table
+ *
+ * The per-call cost is only the embedded-space kNN plus the rank
+ * reduction; the expensive original-space pairwise distances live in the
+ * table built by `trustworthiness_precompute`.
+ *
+ * @param h Raft handle
+ * @param[in] lookup_table: Neighbor rank table from trustworthiness_precompute (size n * n)
+ * @param X_embedded[in]: Data in target dimension (embedding)
+ * @param n: Number of samples
+ * @param d: Number of features in low/embedded dimension
+ * @param n_neighbors Number of neighbors considered by trustworthiness score
+ * @return Trustworthiness score
+ */
+template <typename math_t, raft::distance::DistanceType distance_type>
+double trustworthiness_score_precomputed(const raft::handle_t& h,
+                                         const int* lookup_table,
+                                         math_t* X_embedded,
+                                         int n,
+                                         int d,
+                                         int n_neighbors)
+{
+  cudaStream_t stream = h.get_stream();
+
+  const int KNN_ALLOC = n * (n_neighbors + 1);
+  rmm::device_uvector<int64_t> emb_ind(KNN_ALLOC, stream);
+  rmm::device_uvector<math_t> emb_dist(KNN_ALLOC, stream);
+
+  run_knn<distance_type>(h, X_embedded, n, d, n_neighbors + 1, emb_ind.data(), emb_dist.data());
+
+  rmm::device_scalar<double> t_dbuf(stream);
+  RAFT_CUDA_TRY(cudaMemsetAsync(t_dbuf.data(), 0, sizeof(double), stream));
+
+  int work     = n * (n_neighbors + 1);
+  int n_blocks = raft::ceildiv(work, N_THREADS);
+  compute_rank<<<n_blocks, N_THREADS, 0, stream>>>(
+    t_dbuf.data(), lookup_table, emb_ind.data(), n, n_neighbors + 1, work);
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
+
+  double t = t_dbuf.value(stream);
+
+  t = 1.0 - ((2.0 / ((n * n_neighbors) * ((2.0 * n) - (3.0 * n_neighbors) - 1.0))) * t);
+
+  return t;
+}
+
 }  // namespace detail
 }  // namespace stats
 }  // namespace raft
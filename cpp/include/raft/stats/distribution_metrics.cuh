@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/**
+ * @file distribution_metrics.cuh
+ * @brief Computes entropy, KL divergence and mutual information of two
+ * labelings from a single shared contingency matrix, instead of rebuilding
+ * per-metric histograms for each score.
+ */
+#ifndef __DISTRIBUTION_METRICS_H
+#define __DISTRIBUTION_METRICS_H
+
+#pragma once
+
+#include <raft/stats/detail/distribution_metrics.cuh>
+
+namespace raft {
+namespace stats {
+
+using detail::distribution_metrics_t;
+
+/**
+ * @brief Computes all divergence metrics of a pair of labelings in one pass
+ *
+ * Builds the contingency matrix once and derives the entropy of each
+ * labeling, the KL divergence of their label distributions and the mutual
+ * information from it in a single fused reduction, matching the scores of
+ * the individual `entropy`, `kl_divergence` and `mutual_info_score`
+ * functions at a third of the data passes.
+ *
+ * @tparam T data-type for input label arrays
+ * @param firstClusterArray: the array of classes of type T
+ * @param secondClusterArray: the array of classes of type T
+ * @param size: the size of the data points of type int
+ * @param lowerLabelRange: the lower bound of the range of labels
+ * @param upperLabelRange: the upper bound of the range of labels
+ * @param stream: the cudaStream object
+ * @return all four scores in a distribution_metrics_t
+ */
+template <typename T>
+distribution_metrics_t distribution_metrics(const T* firstClusterArray,
+                                            const T* secondClusterArray,
+                                            int size,
+                                            T lowerLabelRange,
+                                            T upperLabelRange,
+                                            cudaStream_t stream)
+{
+  return detail::distribution_metrics(
+    firstClusterArray, secondClusterArray, size, lowerLabelRange, upperLabelRange, stream);
+}
+
+};  // end namespace stats
+};  // end namespace raft
+
+#endif
@@ -55,6 +55,66 @@ void meanvar(Type* mean,
   detail::meanvar(mean, var, data, D, N, sample, rowMajor, stream);
 }
 
+/**
+ * @brief Opaque per-column accumulator state for computing mean and variance
+ * incrementally over a stream of batches.
+ *
+ * Construct it with the number of columns, feed batches of rows with
+ * `meanvar_update`, and produce the statistics with `meanvar_finalize`.
+ * The result is identical to running `meanvar` once over the concatenated
+ * batches, so arbitrarily large streams cost one pass over the data and no
+ * concatenation buffer.
+ *
+ * @tparam Type the data type
+ * @tparam IdxType Integer type used for addressing
+ */
+template <typename Type, typename IdxType = int>
+using meanvar_state = detail::meanvar_state<Type, IdxType>;
+
+/**
+ * @brief Merge one batch of data into a `meanvar_state`.
+ *
+ * @tparam Type the data type
+ * @tparam IdxType Integer type used for addressing
+ * @param [inout] state the accumulator state (determines the column count D)
+ * @param [in] data the input batch of size [N, D]
+ * @param [in] N number of rows in this batch
+ * @param [in] rowMajor whether the batch is row- or col-major, for true or false respectively.
+ * @param [in] stream
+ */
+template <typename Type, typename IdxType = int>
+void meanvar_update(meanvar_state<Type, IdxType>& state,
+                    const Type* data,
+                    IdxType N,
+                    bool rowMajor,
+                    cudaStream_t stream)
+{
+  detail::meanvar_update(state, data, N, rowMajor, stream);
+}
+
+/**
+ * @brief Produce mean and variance from the batches accumulated in a
+ * `meanvar_state`.
+ *
+ * The state is left untouched, so it is valid to keep feeding batches and
+ * finalize again later.
+ *
+ * @tparam Type the data type
+ * @tparam IdxType Integer type used for addressing
+ * @param [inout] state the accumulator state
+ * @param [out] mean the output mean vector of size D
+ * @param [out] var the output variance vector of size D
+ * @param [in] sample whether to evaluate sample variance or not. In other words, whether to
+ * normalize the variance using N-1 or N, for true or false respectively.
+ * @param [in] stream
+ */
+template <typename Type, typename IdxType = int>
+void meanvar_finalize(
+  meanvar_state<Type, IdxType>& state, Type* mean, Type* var, bool sample, cudaStream_t stream)
+{
+  detail::meanvar_finalize(state, mean, var, sample, stream);
+}
+
 };  // namespace raft::stats
 
 #endif
@@ -46,6 +46,32 @@ double mutual_info_score(const T* firstClusterArray,
     firstClusterArray, secondClusterArray, size, lowerLabelRange, upperLabelRange, stream);
 }
 
+/**
+ * @brief Mutual information computed through a sparse contingency matrix
+ *
+ * Produces the same score as `mutual_info_score` but never materializes the
+ * dense contingency matrix, so it stays usable for very high label
+ * cardinalities. The cost is linear in the number of distinct label pairs.
+ *
+ * @param firstClusterArray: the array of classes of type T
+ * @param secondClusterArray: the array of classes of type T
+ * @param size: the size of the data points of type int
+ * @param lowerLabelRange: the lower bound of the range of labels
+ * @param upperLabelRange: the upper bound of the range of labels
+ * @param stream: the cudaStream object
+ */
+template <typename T>
+double mutual_info_score_sparse(const T* firstClusterArray,
+                                const T* secondClusterArray,
+                                int size,
+                                T lowerLabelRange,
+                                T upperLabelRange,
+                                cudaStream_t stream)
+{
+  return detail::mutual_info_score_sparse(
+    firstClusterArray, secondClusterArray, size, lowerLabelRange, upperLabelRange, stream);
+}
+
 };  // end namespace stats
 };  // end namespace raft
 
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <raft/stats/detail/batched/regression_metrics.cuh>
 #include <raft/stats/detail/scores.cuh>
 
 namespace raft {
@@ -49,6 +50,40 @@ void regression_metrics(const T* predictions,
   detail::regression_metrics(
     predictions, ref_predictions, n, stream, mean_abs_error, mean_squared_error, median_abs_error);
 }
+
+/**
+ * @brief Compute MAE, MSE and R-squared for a whole batch of models at once
+ *
+ * Scores every model of an ensemble (e.g. an ARIMA grid search) in a single
+ * kernel launch instead of one `regression_metrics`/`r2_score` call per
+ * model, and leaves the results on the device so model selection does not
+ * have to synchronize per model.
+ *
+ * @tparam T: data type for predictions (e.g., float or double for regression).
+ * @tparam IdxT: integer type used for addressing.
+ * @param[in] d_y: ground-truth response variables; the series of each model is
+ * stored contiguously, size [batch_size, n_samples] (device).
+ * @param[in] d_y_hat: predicted response variables, same layout (device).
+ * @param[in] batch_size: number of models in the batch.
+ * @param[in] n_samples: number of samples in each series. Should be > 0.
+ * @param[out] d_mae: mean absolute error for each model, size batch_size (device).
+ * @param[out] d_mse: mean squared error for each model, size batch_size (device).
+ * @param[out] d_r2: R-squared score for each model, size batch_size (device).
+ * @param[in] stream: cuda stream.
+ */
+template <typename T, typename IdxT>
+void regression_metrics_batched(const T* d_y,
+                                const T* d_y_hat,
+                                IdxT batch_size,
+                                IdxT n_samples,
+                                T* d_mae,
+                                T* d_mse,
+                                T* d_r2,
+                                cudaStream_t stream)
+{
+  batched::detail::regression_metrics(
+    d_y, d_y_hat, batch_size, n_samples, d_mae, d_mse, d_r2, stream);
+}
 }  // namespace stats
 }  // namespace raft
 
@@ -20,5 +20,7 @@
 
 #include <raft/distance/specializations.cuh>
 #include <raft/spatial/knn/specializations.cuh>
+#include <raft/stats/specializations/detail/histogram.cuh>
+#include <raft/stats/specializations/detail/silhouette_score.cuh>
 
 #endif
\ No newline at end of file
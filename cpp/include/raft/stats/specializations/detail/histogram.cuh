@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <raft/stats/common.hpp>
+#include <raft/stats/detail/histogram.cuh>
+
+namespace raft {
+namespace stats {
+namespace detail {
+extern template void histogram<float, int, IdentityBinner<float, int>>(
+  HistType type,
+  int* bins,
+  int nbins,
+  const float* data,
+  int nrows,
+  int ncols,
+  cudaStream_t stream,
+  IdentityBinner<float, int> binner);
+
+extern template void histogram<float, std::int64_t, IdentityBinner<float, std::int64_t>>(
+  HistType type,
+  int* bins,
+  std::int64_t nbins,
+  const float* data,
+  std::int64_t nrows,
+  std::int64_t ncols,
+  cudaStream_t stream,
+  IdentityBinner<float, std::int64_t> binner);
+
+extern template void histogram<double, int, IdentityBinner<double, int>>(
+  HistType type,
+  int* bins,
+  int nbins,
+  const double* data,
+  int nrows,
+  int ncols,
+  cudaStream_t stream,
+  IdentityBinner<double, int> binner);
+
+extern template void histogram<double, std::int64_t, IdentityBinner<double, std::int64_t>>(
+  HistType type,
+  int* bins,
+  std::int64_t nbins,
+  const double* data,
+  std::int64_t nrows,
+  std::int64_t ncols,
+  cudaStream_t stream,
+  IdentityBinner<double, std::int64_t> binner);
+}  // namespace detail
+}  // namespace stats
+}  // namespace raft
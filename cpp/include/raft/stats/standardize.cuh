@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __STANDARDIZE_H
+#define __STANDARDIZE_H
+
+#pragma once
+
+#include "detail/standardize.cuh"
+
+namespace raft {
+namespace stats {
+
+/**
+ * @brief Standardize the columns of a matrix: subtract the (optionally
+ * weighted) column mean and divide by the column standard deviation.
+ *
+ * The whole operation takes two sweeps over the matrix: one fused sweep
+ * computing mean and variance of every column, and one sweep applying
+ * center+scale. Compare with running `mean`/`weightedMean`, `stddev`,
+ * `meanCenter` and a divide separately, which reads the matrix four
+ * times and writes an intermediate centered matrix that the scale step
+ * immediately re-reads. `out` may be the same buffer as `data` for
+ * in-place operation. Columns with zero variance are only centered.
+ *
+ * @tparam Type the data type
+ * @tparam IdxType Integer type used for addressing
+ * @param [out] out the output standardized matrix of size [N, D]
+ * @param [in] data the input matrix of size [N, D]
+ * @param [out] mu the output mean vector of size D
+ * @param [out] stddev the output standard deviation vector of size D
+ * @param [in] D number of columns of data
+ * @param [in] N number of rows of data
+ * @param [in] sample whether to evaluate sample standard deviation or not. In other
+ * words, whether to normalize the variance using N-1 or N, for true or false respectively.
+ * @param [in] rowMajor whether the input data is row- or col-major, for true or false respectively.
+ * @param [in] stream cuda stream to launch work on
+ * @param [in] weights optional per-row frequency weights of size N; when nullptr
+ * all rows count equally
+ */
+template <typename Type, typename IdxType = int>
+void standardize(Type* out,
+                 const Type* data,
+                 Type* mu,
+                 Type* stddev,
+                 IdxType D,
+                 IdxType N,
+                 bool sample,
+                 bool rowMajor,
+                 cudaStream_t stream,
+                 const Type* weights = nullptr)
+{
+  detail::standardize(out, data, mu, stddev, D, N, sample, rowMajor, stream, weights);
+}
+
+};  // namespace stats
+};  // namespace raft
+
+#endif
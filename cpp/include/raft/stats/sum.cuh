@@ -46,6 +46,31 @@ void sum(Type* output, const Type* input, IdxType D, IdxType N, bool rowMajor, c
   detail::sum(output, input, D, N, rowMajor, stream);
 }
 
+/**
+ * @brief Compute sum of the input matrix with Kahan/Neumaier compensation
+ *
+ * Same contract as `sum`, but each accumulator carries a running compensation
+ * term, so the rounding error stays bounded independently of N instead of
+ * growing with it. Use it when summing many values in fp32 where a plain
+ * accumulation would lose digits; it reads the data once at full bandwidth,
+ * with vectorized loads along the contiguous dimension where alignment allows.
+ *
+ * @tparam Type the data type
+ * @tparam IdxType Integer type used to for addressing
+ * @param output the output mean vector
+ * @param input the input matrix
+ * @param D number of columns of data
+ * @param N number of rows of data
+ * @param rowMajor whether the input data is row or col major
+ * @param stream cuda stream where to launch work
+ */
+template <typename Type, typename IdxType = int>
+void sumKahan(
+  Type* output, const Type* input, IdxType D, IdxType N, bool rowMajor, cudaStream_t stream)
+{
+  detail::sumKahan(output, input, D, N, rowMajor, stream);
+}
+
 };  // end namespace stats
 };  // end namespace raft
 
@@ -48,6 +48,55 @@ double trustworthiness_score(const raft::handle_t& h,
   return detail::trustworthiness_score<math_t, distance_type>(
     h, X, X_embedded, n, m, d, n_neighbors, batchSize);
 }
+
+/**
+ * @brief Precompute the original-space neighbor ranks for trustworthiness scoring
+ *
+ * The table only depends on the original data, so when the same dataset is
+ * scored against many embeddings (e.g. once per training epoch) it can be
+ * built once, serialized by the caller as a plain n * n device buffer, and
+ * reused via `trustworthiness_score_precomputed`.
+ *
+ * @param[in] h: raft handle
+ * @param[in] X: Data in original dimension
+ * @param[in] n: Number of samples
+ * @param[in] m: Number of features in high/original dimension
+ * @param[out] lookup_table: Neighbor rank table (size n * n)
+ * @param[in] batchSize Batch size
+ */
+template <typename math_t, raft::distance::DistanceType distance_type>
+void trustworthiness_precompute(
+  const raft::handle_t& h, const math_t* X, int n, int m, int* lookup_table, int batchSize = 512)
+{
+  detail::trustworthiness_precompute<math_t, distance_type>(h, X, n, m, lookup_table, batchSize);
+}
+
+/**
+ * @brief Compute the trustworthiness score against a precomputed rank table
+ *
+ * Only computes the embedded-space kNN per call; combined with
+ * `trustworthiness_precompute` this makes repeated scoring of the same
+ * dataset much cheaper than `trustworthiness_score`.
+ *
+ * @param[in] h: raft handle
+ * @param[in] lookup_table: Neighbor rank table from trustworthiness_precompute (size n * n)
+ * @param[in] X_embedded: Data in target dimension (embedding)
+ * @param[in] n: Number of samples
+ * @param[in] d: Number of features in low/embedded dimension
+ * @param[in] n_neighbors Number of neighbors considered by trustworthiness score
+ * @return[out] Trustworthiness score
+ */
+template <typename math_t, raft::distance::DistanceType distance_type>
+double trustworthiness_score_precomputed(const raft::handle_t& h,
+                                         const int* lookup_table,
+                                         math_t* X_embedded,
+                                         int n,
+                                         int d,
+                                         int n_neighbors)
+{
+  return detail::trustworthiness_score_precomputed<math_t, distance_type>(
+    h, lookup_table, X_embedded, n, d, n_neighbors);
+}
 }  // namespace stats
 }  // namespace raft
 
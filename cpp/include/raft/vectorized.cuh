@@ -17,6 +17,7 @@
 #pragma once
 
 #include "cuda_utils.cuh"
+#include <cuda_bf16.h>
 #include <cuda_fp16.h>
 
 namespace raft {
@@ -146,6 +147,34 @@ struct IOType<__half2, 4> {
   typedef uint4 Type;
 };
 template <>
+struct IOType<nv_bfloat16, 1> {
+  typedef nv_bfloat16 Type;
+};
+template <>
+struct IOType<nv_bfloat16, 2> {
+  typedef nv_bfloat162 Type;
+};
+template <>
+struct IOType<nv_bfloat16, 4> {
+  typedef uint2 Type;
+};
+template <>
+struct IOType<nv_bfloat16, 8> {
+  typedef uint4 Type;
+};
+template <>
+struct IOType<nv_bfloat162, 1> {
+  typedef nv_bfloat162 Type;
+};
+template <>
+struct IOType<nv_bfloat162, 2> {
+  typedef uint2 Type;
+};
+template <>
+struct IOType<nv_bfloat162, 4> {
+  typedef uint4 Type;
+};
+template <>
 struct IOType<int32_t, 1> {
   typedef int32_t Type;
 };
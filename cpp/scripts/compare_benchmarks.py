@@ -0,0 +1,130 @@
+# Copyright (c) 2022, NVIDIA CORPORATION.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Compare two google-benchmark JSON result files and fail on regressions.
+
+The result files are produced by the benchmark binaries themselves, e.g.
+
+    bench_raft --benchmark_out=baseline.json --benchmark_out_format=json
+    # ... build the contender ...
+    bench_raft --benchmark_out=contender.json --benchmark_out_format=json
+    python cpp/scripts/compare_benchmarks.py baseline.json contender.json
+
+Benchmark cases are matched by their full name (which encodes the
+cartesian_registrar parameter indices). For every matched case the relative
+change of the measured time is printed; the script exits non-zero if any
+case slowed down by more than the threshold. Counters (including the
+dev_mem_peak / kern:* counters emitted by the fixture) are printed for
+context but only gate when requested with --counter.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load_results(path):
+    """Return {name: benchmark_record}, preferring median aggregates."""
+    with open(path) as f:
+        data = json.load(f)
+    out = {}
+    for bench in data.get('benchmarks', []):
+        name = bench['name']
+        run_type = bench.get('run_type', 'iteration')
+        if run_type == 'aggregate':
+            if bench.get('aggregate_name') != 'median':
+                continue
+            name = bench.get('run_name', name)
+        elif name in out:
+            continue  # keep the first (or the median aggregate) per case
+        out[name] = bench
+    return out
+
+
+def relative_change(base, cont):
+    if base == 0:
+        return 0.0 if cont == 0 else float('inf')
+    return (cont - base) / base
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('baseline', help='baseline results (JSON)')
+    parser.add_argument('contender', help='contender results (JSON)')
+    parser.add_argument('-t', '--threshold', type=float, default=0.05,
+                        help='relative slowdown that fails the comparison '
+                             '(default: 0.05 = 5%%)')
+    parser.add_argument('--metric', default='real_time',
+                        choices=['real_time', 'cpu_time'],
+                        help='time field to compare (default: real_time)')
+    parser.add_argument('--counter', action='append', default=[],
+                        help='also gate on this counter (e.g. dev_mem_peak); '
+                             'may be given multiple times')
+    args = parser.parse_args()
+
+    baseline = load_results(args.baseline)
+    contender = load_results(args.contender)
+
+    common = sorted(set(baseline) & set(contender))
+    only_base = sorted(set(baseline) - set(contender))
+    only_cont = sorted(set(contender) - set(baseline))
+
+    if not common:
+        print('error: no common benchmark cases between the two files',
+              file=sys.stderr)
+        return 2
+
+    regressions = []
+    name_w = max(len(n) for n in common)
+    print(f'{"benchmark":{name_w}}  {"baseline":>12}  {"contender":>12}  {"change":>8}')
+    for name in common:
+        base = baseline[name]
+        cont = contender[name]
+        change = relative_change(base[args.metric], cont[args.metric])
+        unit = base.get('time_unit', 'ns')
+        flag = ''
+        if change > args.threshold:
+            flag = '  REGRESSED'
+            regressions.append((name, args.metric, change))
+        print(f'{name:{name_w}}  {base[args.metric]:>10.3f}{unit}  '
+              f'{cont[args.metric]:>10.3f}{unit}  {change:>+7.1%}{flag}')
+        for counter in args.counter:
+            if counter not in base or counter not in cont:
+                continue
+            cchange = relative_change(base[counter], cont[counter])
+            if cchange > args.threshold:
+                regressions.append((name, counter, cchange))
+                print(f'{"":{name_w}}  {counter}: {base[counter]:.3g} -> '
+                      f'{cont[counter]:.3g} ({cchange:+.1%})  REGRESSED')
+
+    for name in only_base:
+        print(f'warning: {name} only in baseline', file=sys.stderr)
+    for name in only_cont:
+        print(f'warning: {name} only in contender', file=sys.stderr)
+
+    if regressions:
+        print(f'\n{len(regressions)} regression(s) past the '
+              f'{args.threshold:.1%} threshold:', file=sys.stderr)
+        for name, metric, change in regressions:
+            print(f'  {name} [{metric}]: {change:+.1%}', file=sys.stderr)
+        return 1
+
+    print(f'\nno regressions past the {args.threshold:.1%} threshold '
+          f'({len(common)} cases compared)')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
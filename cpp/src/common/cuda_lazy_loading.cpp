@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+
+namespace {
+
+/*
+ * Compiled into the raft shared libraries when RAFT_CUDA_LAZY_LOADING is
+ * enabled. The constructor runs when the library is loaded, i.e. before any
+ * CUDA call can have initialized the driver, and opts the process into lazy
+ * module loading (CUDA 11.7+): device code is then loaded per kernel on
+ * first use instead of all fatbins at context creation, which is where the
+ * multi-second cold start of binaries linking the compiled specializations
+ * comes from. An explicit CUDA_MODULE_LOADING setting in the environment
+ * takes precedence. Kernels can be loaded ahead of first use with
+ * raft/common/prewarm.hpp.
+ */
+__attribute__((constructor)) void set_lazy_module_loading()
+{
+  setenv("CUDA_MODULE_LOADING", "LAZY", /* no overwrite */ 0);
+}
+
+}  // namespace
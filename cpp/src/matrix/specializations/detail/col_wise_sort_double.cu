@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+
+#include <raft/matrix/detail/columnWiseSort.cuh>
+
+namespace raft {
+namespace matrix {
+namespace detail {
+template void sortColumnsPerRow<double, int>(const double* in,
+                                             int* out,
+                                             int n_rows,
+                                             int n_columns,
+                                             bool& bAllocWorkspace,
+                                             void* workspacePtr,
+                                             size_t& workspaceSize,
+                                             cudaStream_t stream,
+                                             double* sortedKeys);
+
+template void sortColumnsPerRow<double, std::int64_t>(const double* in,
+                                                      std::int64_t* out,
+                                                      int n_rows,
+                                                      int n_columns,
+                                                      bool& bAllocWorkspace,
+                                                      void* workspacePtr,
+                                                      size_t& workspaceSize,
+                                                      cudaStream_t stream,
+                                                      double* sortedKeys);
+}  // namespace detail
+}  // namespace matrix
+}  // namespace raft
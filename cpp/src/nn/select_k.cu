@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <raft/handle.hpp>
+#include <raft/spatial/knn/knn.cuh>
+
+namespace raft::spatial::knn::runtime {
+
+void select_k(raft::handle_t const& handle,
+              const float* in_keys,
+              const int* in_values,
+              size_t n_inputs,
+              size_t input_len,
+              float* out_keys,
+              int* out_values,
+              bool select_min,
+              int k)
+{
+  raft::spatial::knn::select_k<int, float>(in_keys,
+                                           in_values,
+                                           n_inputs,
+                                           input_len,
+                                           out_keys,
+                                           out_values,
+                                           select_min,
+                                           k,
+                                           handle.get_stream());
+}
+
+void select_k(raft::handle_t const& handle,
+              const double* in_keys,
+              const int* in_values,
+              size_t n_inputs,
+              size_t input_len,
+              double* out_keys,
+              int* out_values,
+              bool select_min,
+              int k)
+{
+  raft::spatial::knn::select_k<int, double>(in_keys,
+                                            in_values,
+                                            n_inputs,
+                                            input_len,
+                                            out_keys,
+                                            out_values,
+                                            select_min,
+                                            k,
+                                            handle.get_stream());
+}
+
+}  // namespace raft::spatial::knn::runtime
@@ -33,7 +33,8 @@ template void fusedL2Knn<long, float, false>(size_t D,
                                              bool rowMajorIndex,
                                              bool rowMajorQuery,
                                              cudaStream_t stream,
-                                             raft::distance::DistanceType metric);
+                                             raft::distance::DistanceType metric,
+                                             const float* index_norms);
 };  // namespace detail
 };  // namespace knn
 };  // namespace spatial
@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <raft/stats/common.hpp>
+#include <raft/stats/detail/histogram.cuh>
+
+namespace raft {
+namespace stats {
+namespace detail {
+template void histogram<double, int, IdentityBinner<double, int>>(
+  HistType type,
+  int* bins,
+  int nbins,
+  const double* data,
+  int nrows,
+  int ncols,
+  cudaStream_t stream,
+  IdentityBinner<double, int> binner);
+}  // namespace detail
+}  // namespace stats
+}  // namespace raft
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+
+#include <raft/stats/detail/batched/silhouette_score.cuh>
+#include <raft/stats/detail/silhouette_score.cuh>
+
+namespace raft {
+namespace stats {
+namespace detail {
+template double silhouette_score<double, int>(const raft::handle_t& handle,
+                                              double* X_in,
+                                              int nRows,
+                                              int nCols,
+                                              int* labels,
+                                              int nLabels,
+                                              double* silhouette_scorePerSample,
+                                              cudaStream_t stream,
+                                              raft::distance::DistanceType metric);
+}  // namespace detail
+
+namespace batched {
+namespace detail {
+template double silhouette_score<double, std::int64_t, int>(const raft::handle_t& handle,
+                                                            double* X,
+                                                            std::int64_t n_rows,
+                                                            std::int64_t n_cols,
+                                                            int* y,
+                                                            int n_labels,
+                                                            double* scores,
+                                                            std::int64_t chunk,
+                                                            raft::distance::DistanceType metric);
+}  // namespace detail
+}  // namespace batched
+}  // namespace stats
+}  // namespace raft
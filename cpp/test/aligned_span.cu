@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test_utils.h"
+#include <gtest/gtest.h>
+#include <raft/core/aligned_span.hpp>
+#include <raft/core/handle.hpp>
+#include <raft/cudart_utils.h>
+#include <raft/linalg/binary_op.cuh>
+#include <rmm/device_uvector.hpp>
+
+#include <vector>
+
+namespace raft {
+
+struct aligned_add_op {
+  __device__ float operator()(float a, float b) const { return a + b; }
+};
+
+TEST(AlignedSpan, Construction)
+{
+  alignas(16) float buf[16];
+  auto s = make_host_aligned_span<16>(buf, 16);
+  ASSERT_EQ(s.data(), buf);
+  ASSERT_EQ(s.size(), 16u);
+  static_assert(decltype(s)::alignment == 16, "alignment must be carried by the type");
+
+  // offsetting by one element breaks 16B alignment
+  EXPECT_THROW((make_host_aligned_span<16>(buf + 1, 15)), raft::exception);
+  // ... but still satisfies the element alignment
+  EXPECT_NO_THROW((make_host_aligned_span<4>(buf + 1, 15)));
+
+  // conversion to a weaker (divisor) alignment is implicit
+  host_aligned_span<float, 8> weaker = s;
+  ASSERT_EQ(weaker.data(), s.data());
+}
+
+TEST(AlignedSpan, BinaryOp)
+{
+  raft::handle_t handle;
+  auto stream = handle.get_stream();
+  // 1000 is not a multiple of the float4 vector width; exercises the tail path
+  for (size_t len : {1024u, 1000u}) {
+    std::vector<float> h_in1(len), h_in2(len);
+    for (size_t i = 0; i < len; i++) {
+      h_in1[i] = float(i);
+      h_in2[i] = float(3 * i);
+    }
+    rmm::device_uvector<float> in1(len, stream), in2(len, stream), out(len, stream);
+    raft::update_device(in1.data(), h_in1.data(), len, stream);
+    raft::update_device(in2.data(), h_in2.data(), len, stream);
+
+    linalg::binaryOp<16, float>(make_device_aligned_span<16>(out.data(), len),
+                                make_device_aligned_span<16, const float>(in1.data(), len),
+                                make_device_aligned_span<16, const float>(in2.data(), len),
+                                aligned_add_op{},
+                                stream);
+
+    std::vector<float> h_out(len);
+    raft::update_host(h_out.data(), out.data(), len, stream);
+    handle.sync_stream();
+    for (size_t i = 0; i < len; i++) {
+      ASSERT_EQ(h_in1[i] + h_in2[i], h_out[i]) << "at index " << i << " (len " << len << ")";
+    }
+  }
+}
+
+}  // namespace raft
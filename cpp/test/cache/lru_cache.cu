@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <raft/cache/lru_cache.cuh>
+
+#include "../test_utils.h"
+#include <raft/cudart_utils.h>
+#include <raft/handle.hpp>
+
+#include <rmm/device_uvector.hpp>
+
+#include <cuda_fp16.h>
+
+#include <vector>
+
+namespace raft {
+namespace cache {
+
+// fills the tile with vec[i] = key * n_vec + i, so every key has a unique,
+// easily checkable vector
+void compute_vecs(const int* keys, int n, int n_vec, float* tile, cudaStream_t stream)
+{
+  std::vector<int> keys_h(n);
+  raft::update_host(keys_h.data(), keys, n, stream);
+  RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+  std::vector<float> tile_h(n * n_vec);
+  for (int k = 0; k < n; k++) {
+    for (int i = 0; i < n_vec; i++) {
+      tile_h[k * n_vec + i] = keys_h[k] * n_vec + i;
+    }
+  }
+  raft::update_device(tile, tile_h.data(), n * n_vec, stream);
+}
+
+class LruCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override { stream = handle.get_stream(); }
+
+  void expect_vecs(const float* out, const std::vector<int>& keys)
+  {
+    std::vector<float> out_h(keys.size() * n_vec);
+    raft::update_host(out_h.data(), out, out_h.size(), stream);
+    RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+    for (size_t k = 0; k < keys.size(); k++) {
+      for (int i = 0; i < n_vec; i++) {
+        ASSERT_EQ(out_h[k * n_vec + i], keys[k] * n_vec + i) << "key " << keys[k] << " elem " << i;
+      }
+    }
+  }
+
+  raft::handle_t handle;
+  cudaStream_t stream;
+  int n_vec = 10;
+};
+
+TEST_F(LruCacheTest, GetOrCompute)
+{
+  lru_cache<float, 4> cache(handle, n_vec, 1);
+  ASSERT_GT(cache.size(), 0);
+
+  std::vector<int> keys_h{12, 3, 7, 3, 25, 7};
+  int n = keys_h.size();
+  rmm::device_uvector<int> keys(n, stream);
+  rmm::device_uvector<float> out(n * n_vec, stream);
+  raft::update_device(keys.data(), keys_h.data(), n, stream);
+
+  auto compute = [this](const int* keys, int n, float* tile) {
+    compute_vecs(keys, n, n_vec, tile, stream);
+  };
+
+  cache.get_or_compute(handle, keys.data(), n, out.data(), compute);
+  expect_vecs(out.data(), keys_h);
+
+  // duplicates within a batch hit the entry stored by the same lookup's time
+  // stamp only on the next call; the second call must be all hits
+  cache.get_or_compute(handle, keys.data(), n, out.data(), compute);
+  expect_vecs(out.data(), keys_h);
+
+  cache_stats s = cache.stats(stream);
+  ASSERT_EQ(s.n_hits + s.n_misses, static_cast<size_t>(2 * n));
+  ASSERT_EQ(s.n_hits, static_cast<size_t>(n));
+  ASSERT_EQ(s.n_evictions, 0u);
+  ASSERT_DOUBLE_EQ(s.hit_rate(), 0.5);
+}
+
+TEST_F(LruCacheTest, Eviction)
+{
+  // a single set of 4 entries: 1 MiB / (n_vec * 4B * 4) rounded down with
+  // n_vec chosen so that exactly one set fits
+  int big_n_vec = 64 * 1024;
+  lru_cache<float, 4> cache(handle, big_n_vec, 1);
+  ASSERT_EQ(cache.size(), 4);
+
+  auto compute = [&](const int* keys, int n, float* tile) {
+    compute_vecs(keys, n, big_n_vec, tile, stream);
+  };
+
+  rmm::device_uvector<int> keys(8, stream);
+  rmm::device_uvector<float> out(8 * (size_t)big_n_vec, stream);
+
+  std::vector<int> first{0, 1, 2, 3};
+  raft::update_device(keys.data(), first.data(), 4, stream);
+  cache.get_or_compute(handle, keys.data(), 4, out.data(), compute);
+  ASSERT_EQ(cache.stats(stream).n_evictions, 0u);
+
+  // 4 new keys must evict the previous occupants of the (only) set
+  std::vector<int> second{4, 5, 6, 7};
+  raft::update_device(keys.data(), second.data(), 4, stream);
+  cache.get_or_compute(handle, keys.data(), 4, out.data(), compute);
+
+  cache_stats s = cache.stats(stream);
+  ASSERT_EQ(s.n_evictions, 4u);
+  ASSERT_EQ(s.n_hits, 0u);
+
+  cache.clear_stats(stream);
+  s = cache.stats(stream);
+  ASSERT_EQ(s.n_hits + s.n_misses + s.n_evictions, 0u);
+}
+
+TEST_F(LruCacheTest, HalfStorage)
+{
+  // same memory budget, half storage: twice the capacity of the fp32 cache
+  lru_cache<float, 4> cache32(handle, n_vec, 1);
+  lru_cache<float, 4, __half> cache16(handle, n_vec, 1);
+  ASSERT_EQ(cache16.size(), 2 * cache32.size());
+
+  std::vector<int> keys_h{1, 2, 3, 4};
+  int n = keys_h.size();
+  rmm::device_uvector<int> keys(n, stream);
+  rmm::device_uvector<float> out(n * n_vec, stream);
+  raft::update_device(keys.data(), keys_h.data(), n, stream);
+
+  auto compute = [this](const int* keys, int n, float* tile) {
+    compute_vecs(keys, n, n_vec, tile, stream);
+  };
+
+  cache16.get_or_compute(handle, keys.data(), n, out.data(), compute);
+  cache16.get_or_compute(handle, keys.data(), n, out.data(), compute);
+  ASSERT_EQ(cache16.stats(stream).n_hits, static_cast<size_t>(n));
+
+  // values are small integers, exactly representable in fp16
+  expect_vecs(out.data(), keys_h);
+}
+
+TEST_F(LruCacheTest, LookupAssignStore)
+{
+  lru_cache<float, 4> cache(handle, n_vec, 1);
+
+  std::vector<int> keys_h{5, 11, 17};
+  int n = keys_h.size();
+  rmm::device_uvector<int> keys(n, stream);
+  rmm::device_uvector<int> cache_idx(n, stream);
+  raft::update_device(keys.data(), keys_h.data(), n, stream);
+
+  int n_cached = -1;
+  cache.lookup(keys.data(), n, cache_idx.data(), &n_cached, stream);
+  ASSERT_EQ(n_cached, 0);
+
+  cache.assign_cache_idx(keys.data(), n, cache_idx.data(), stream);
+  rmm::device_uvector<float> tile(n * n_vec, stream);
+  compute_vecs(keys.data(), n, n_vec, tile.data(), stream);
+  cache.store_vecs(tile.data(), n, cache_idx.data(), stream);
+
+  // now every key must be found, and get_vecs must return the stored data
+  raft::update_device(keys.data(), keys_h.data(), n, stream);
+  cache.lookup(keys.data(), n, cache_idx.data(), &n_cached, stream);
+  ASSERT_EQ(n_cached, n);
+
+  rmm::device_uvector<float> out(n * n_vec, stream);
+  cache.get_vecs(cache_idx.data(), n, out.data(), stream);
+  std::vector<int> keys_after(n);
+  raft::update_host(keys_after.data(), keys.data(), n, stream);
+  RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+  expect_vecs(out.data(), keys_after);
+}
+
+};  // namespace cache
+};  // namespace raft
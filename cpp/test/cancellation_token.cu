@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <raft/core/cancellation_token.cuh>
+#include <raft/cudart_utils.h>
+#include <rmm/cuda_stream.hpp>
+#include <thread>
+
+namespace raft {
+
+// Spins until the token is cancelled, then records how it left the loop.
+__global__ void spin_until_cancelled(cancellation_view cancel, int* out)
+{
+  while (!cancel.cancelled()) {
+#if __CUDA_ARCH__ >= 700
+    __nanosleep(1000);
+#endif
+  }
+  *out = 1;
+}
+
+TEST(Raft, CancellationTokenHost)
+{
+  cancellation_token token;
+  ASSERT_FALSE(token.is_cancelled());
+  token.cancel();
+  ASSERT_TRUE(token.is_cancelled());
+  token.reset();
+  ASSERT_FALSE(token.is_cancelled());
+
+  // a default view never reports cancellation
+  ASSERT_EQ(cancellation_view{}.flag, nullptr);
+}
+
+TEST(Raft, CancellationTokenDevice)
+{
+  cancellation_token token;
+  rmm::cuda_stream stream;
+
+  int* out;
+  RAFT_CUDA_TRY(cudaMalloc(&out, sizeof(int)));
+  RAFT_CUDA_TRY(cudaMemsetAsync(out, 0, sizeof(int), stream.value()));
+
+  // the kernel can only terminate by observing the cancelled flag
+  spin_until_cancelled<<<1, 1, 0, stream.value()>>>(token.view(), out);
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  ASSERT_EQ(cudaStreamQuery(stream.value()), cudaErrorNotReady);
+  token.cancel();
+
+  RAFT_CUDA_TRY(cudaStreamSynchronize(stream.value()));
+  int host_out = 0;
+  raft::update_host(&host_out, out, 1, stream.value());
+  RAFT_CUDA_TRY(cudaStreamSynchronize(stream.value()));
+  ASSERT_EQ(host_out, 1);
+  RAFT_CUDA_TRY(cudaFree(out));
+}
+
+}  // namespace raft
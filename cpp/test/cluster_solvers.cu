@@ -98,6 +98,9 @@ TEST(Raft, ModularitySolvers)
   EXPECT_ANY_THROW(spectral::modularity_maximization(
     h, sm, eig_solver, cluster_solver, clusters, eigvals, eigvecs));
 
+  EXPECT_ANY_THROW(spectral::modularity_maximization_multilevel(
+    h, sm, eig_solver, cluster_solver, clusters, eigvals, eigvecs));
+
   value_type modularity{0};
   EXPECT_ANY_THROW(spectral::analyzeModularity(h, sm, k, clusters, modularity));
 }
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <raft/common/gather.cuh>
+#include <raft/common/scatter.cuh>
+
+#include "../test_utils.h"
+#include <raft/cudart_utils.h>
+#include <raft/handle.hpp>
+
+#include <rmm/device_uvector.hpp>
+
+#include <numeric>
+#include <vector>
+
+namespace raft {
+
+class GatherScatterTest : public ::testing::Test {
+ protected:
+  void SetUp() override { stream = handle.get_stream(); }
+
+  std::vector<float> fetch(const rmm::device_uvector<float>& d)
+  {
+    std::vector<float> h(d.size());
+    raft::update_host(h.data(), d.data(), d.size(), stream);
+    RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+    return h;
+  }
+
+  raft::handle_t handle;
+  cudaStream_t stream;
+};
+
+TEST_F(GatherScatterTest, Gather)
+{
+  int len = 16;
+  std::vector<float> in_h(len);
+  std::iota(in_h.begin(), in_h.end(), 100.f);
+  std::vector<int> idx_h{3, 1, 0, 2, 7, 6, 5, 4, 15, 14, 13, 12, 8, 9, 10, 11};
+
+  rmm::device_uvector<float> in(len, stream), out(len, stream);
+  rmm::device_uvector<int> idx(len, stream);
+  raft::update_device(in.data(), in_h.data(), len, stream);
+  raft::update_device(idx.data(), idx_h.data(), len, stream);
+
+  raft::gather(out.data(), in.data(), idx.data(), len, stream);
+
+  auto out_h = fetch(out);
+  for (int i = 0; i < len; i++) {
+    ASSERT_EQ(out_h[i], in_h[idx_h[i]]) << "at " << i;
+  }
+}
+
+TEST_F(GatherScatterTest, GatherRows)
+{
+  int n_rows_in = 8, n_cols = 4, n_rows = 3;
+  std::vector<float> in_h(n_rows_in * n_cols);
+  std::iota(in_h.begin(), in_h.end(), 0.f);
+  std::vector<int> idx_h{6, 1, 3};
+
+  rmm::device_uvector<float> in(in_h.size(), stream), out(n_rows * n_cols, stream);
+  rmm::device_uvector<int> idx(n_rows, stream);
+  raft::update_device(in.data(), in_h.data(), in_h.size(), stream);
+  raft::update_device(idx.data(), idx_h.data(), n_rows, stream);
+
+  raft::gather_rows(out.data(), in.data(), n_cols, idx.data(), n_rows, stream);
+
+  auto out_h = fetch(out);
+  for (int i = 0; i < n_rows; i++) {
+    for (int k = 0; k < n_cols; k++) {
+      ASSERT_EQ(out_h[i * n_cols + k], in_h[idx_h[i] * n_cols + k]) << "row " << i << " col " << k;
+    }
+  }
+}
+
+TEST_F(GatherScatterTest, GatherRowsSortedFastPath)
+{
+  // contiguous sorted indices take the memcpy fast path
+  int n_rows_in = 8, n_cols = 4, n_rows = 3;
+  std::vector<float> in_h(n_rows_in * n_cols);
+  std::iota(in_h.begin(), in_h.end(), 0.f);
+  std::vector<int> idx_h{2, 3, 4};
+
+  rmm::device_uvector<float> in(in_h.size(), stream), out(n_rows * n_cols, stream);
+  rmm::device_uvector<int> idx(n_rows, stream);
+  raft::update_device(in.data(), in_h.data(), in_h.size(), stream);
+  raft::update_device(idx.data(), idx_h.data(), n_rows, stream);
+
+  raft::gather_rows(out.data(), in.data(), n_cols, idx.data(), n_rows, stream, true);
+
+  auto out_h = fetch(out);
+  for (int i = 0; i < n_rows * n_cols; i++) {
+    ASSERT_EQ(out_h[i], in_h[2 * n_cols + i]) << "at " << i;
+  }
+}
+
+TEST_F(GatherScatterTest, ScatterRows)
+{
+  int n_rows_out = 8, n_cols = 4, n_rows = 3;
+  std::vector<float> in_h(n_rows * n_cols);
+  std::iota(in_h.begin(), in_h.end(), 0.f);
+  std::vector<int> idx_h{5, 0, 7};
+
+  rmm::device_uvector<float> in(in_h.size(), stream), out(n_rows_out * n_cols, stream);
+  rmm::device_uvector<int> idx(n_rows, stream);
+  RAFT_CUDA_TRY(cudaMemsetAsync(out.data(), 0, out.size() * sizeof(float), stream));
+  raft::update_device(in.data(), in_h.data(), in_h.size(), stream);
+  raft::update_device(idx.data(), idx_h.data(), n_rows, stream);
+
+  raft::scatter_rows(out.data(), in.data(), n_cols, idx.data(), n_rows, stream);
+
+  auto out_h = fetch(out);
+  for (int i = 0; i < n_rows; i++) {
+    for (int k = 0; k < n_cols; k++) {
+      ASSERT_EQ(out_h[idx_h[i] * n_cols + k], in_h[i * n_cols + k]) << "row " << i << " col " << k;
+    }
+  }
+}
+
+}  // namespace raft
@@ -107,4 +107,20 @@ TEST_F(loggerTest, flush)
   ASSERT_EQ(1, flushCount);
 }
 
+TEST_F(loggerTest, async)
+{
+  std::string testMsg = "This is an async info message";
+  logger::get(RAFT_NAME).set_callback(exampleCallback);
+  logger::get(RAFT_NAME).set_async(true);
+  ASSERT_TRUE(logger::get(RAFT_NAME).is_async());
+
+  RAFT_LOG_INFO(testMsg.c_str());
+  // flush drains the ring before returning, so the record must be delivered
+  logger::get(RAFT_NAME).flush();
+  ASSERT_TRUE(check_if_logged(testMsg, RAFT_LEVEL_INFO));
+
+  logger::get(RAFT_NAME).set_async(false);
+  ASSERT_FALSE(logger::get(RAFT_NAME).is_async());
+}
+
 }  // namespace raft
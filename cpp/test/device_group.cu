@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <raft/core/device_group.hpp>
+#include <raft/cudart_utils.h>
+
+#include <rmm/device_uvector.hpp>
+
+#include <numeric>
+#include <vector>
+
+namespace raft {
+
+TEST(DeviceGroup, BroadcastAndScatter)
+{
+  device_group group;
+
+  constexpr size_t n_rows    = 64;
+  constexpr size_t row_width = 16;
+  constexpr size_t n         = n_rows * row_width;
+
+  std::vector<float> h_src(n);
+  std::iota(h_src.begin(), h_src.end(), 0.0f);
+
+  // source lives on the root rank's device
+  scoped_device root_dev(group.device_id(0));
+  rmm::device_uvector<float> src(n, group.handle(0).get_stream());
+  raft::update_device(src.data(), h_src.data(), n, group.handle(0).get_stream());
+  group.handle(0).sync_stream();
+
+  // per-rank destinations, allocated on each member's own device
+  std::vector<std::unique_ptr<rmm::device_uvector<float>>> bcast_bufs, scatter_bufs;
+  std::vector<float*> bcast_ptrs, scatter_ptrs;
+  for (size_t rank = 0; rank < group.size(); rank++) {
+    scoped_device dev(group.device_id(rank));
+    auto stream = group.handle(rank).get_stream();
+    bcast_bufs.push_back(std::make_unique<rmm::device_uvector<float>>(n, stream));
+    scatter_bufs.push_back(std::make_unique<rmm::device_uvector<float>>(n, stream));
+    bcast_ptrs.push_back(bcast_bufs.back()->data());
+    scatter_ptrs.push_back(scatter_bufs.back()->data());
+  }
+
+  group.broadcast(src.data(), n, 0, bcast_ptrs);
+  group.scatter_rows(src.data(), n_rows, row_width, 0, scatter_ptrs);
+  group.sync_all();
+
+  for (size_t rank = 0; rank < group.size(); rank++) {
+    scoped_device dev(group.device_id(rank));
+    auto stream = group.handle(rank).get_stream();
+
+    std::vector<float> h_bcast(n);
+    raft::update_host(h_bcast.data(), bcast_ptrs[rank], n, stream);
+    group.handle(rank).sync_stream();
+    ASSERT_EQ(h_src, h_bcast) << "rank " << rank;
+
+    auto range       = group.row_range(rank, n_rows);
+    size_t range_len = (range.second - range.first) * row_width;
+    std::vector<float> h_scatter(range_len);
+    raft::update_host(h_scatter.data(), scatter_ptrs[rank], range_len, stream);
+    group.handle(rank).sync_stream();
+    for (size_t i = 0; i < range_len; i++) {
+      ASSERT_EQ(h_src[range.first * row_width + i], h_scatter[i]);
+    }
+  }
+}
+
+TEST(DeviceGroup, ParallelForEach)
+{
+  device_group group;
+
+  std::vector<int> visited(group.size(), -1);
+  group.parallel_for_each([&](size_t rank, handle_t& handle) {
+    int dev;
+    RAFT_CUDA_TRY(cudaGetDevice(&dev));
+    EXPECT_EQ(dev, group.device_id(rank));
+
+    // enqueue and complete some real work on the member's stream
+    rmm::device_uvector<int> buf(1024, handle.get_stream());
+    RAFT_CUDA_TRY(cudaMemsetAsync(buf.data(), 0, 1024 * sizeof(int), handle.get_stream()));
+    handle.sync_stream();
+    visited[rank] = dev;
+  });
+
+  for (size_t rank = 0; rank < group.size(); rank++) {
+    ASSERT_EQ(visited[rank], group.device_id(rank));
+  }
+}
+
+TEST(DeviceGroup, RowRangeCoversAll)
+{
+  device_group group({0});
+  auto range = group.row_range(0, 100);
+  ASSERT_EQ(range.first, 0u);
+  ASSERT_EQ(range.second, 100u);
+}
+
+}  // namespace raft
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils.h"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <raft/cudart_utils.h>
+#include <raft/distance/distance.cuh>
+#include <raft/random/rng.cuh>
+#include <rmm/device_uvector.hpp>
+#include <vector>
+
+namespace raft {
+namespace distance {
+
+// the runtime pairwise_distance entry routes row-major L2 distances at the
+// prebuilt embedding dims (64, 96, 128, 256) through the fixed-dimension
+// kernels; validate those against a host reference, with odd m/n covering
+// the partial-tile boundaries
+template <typename T>
+struct FixedDimInputs {
+  T tolerance;
+  int m, n, k;
+  raft::distance::DistanceType metric;
+  unsigned long long int seed;
+};
+
+template <typename T>
+::std::ostream& operator<<(::std::ostream& os, const FixedDimInputs<T>& p)
+{
+  return os << "m=" << p.m << " n=" << p.n << " k=" << p.k << " metric=" << int(p.metric);
+}
+
+template <typename T>
+class FixedDimDistanceTest : public ::testing::TestWithParam<FixedDimInputs<T>> {
+ public:
+  FixedDimDistanceTest()
+    : params(::testing::TestWithParam<FixedDimInputs<T>>::GetParam()),
+      stream(handle.get_stream()),
+      x(params.m * params.k, stream),
+      y(params.n * params.k, stream),
+      dist(params.m * params.n, stream)
+  {
+  }
+
+ protected:
+  void SetUp() override
+  {
+    raft::random::RngState r(params.seed);
+    uniform(handle, r, x.data(), x.size(), T(-1.0), T(1.0));
+    uniform(handle, r, y.data(), y.size(), T(-1.0), T(1.0));
+
+    rmm::device_uvector<char> workspace(0, stream);
+    pairwise_distance(handle,
+                      x.data(),
+                      y.data(),
+                      dist.data(),
+                      params.m,
+                      params.n,
+                      params.k,
+                      workspace,
+                      params.metric);
+
+    std::vector<T> h_x(x.size()), h_y(y.size());
+    raft::update_host(h_x.data(), x.data(), h_x.size(), stream);
+    raft::update_host(h_y.data(), y.data(), h_y.size(), stream);
+    handle.sync_stream(stream);
+
+    const bool sqrt = params.metric == raft::distance::DistanceType::L2SqrtExpanded ||
+                      params.metric == raft::distance::DistanceType::L2SqrtUnexpanded;
+    h_ref.resize(size_t(params.m) * params.n);
+    for (int i = 0; i < params.m; i++) {
+      for (int j = 0; j < params.n; j++) {
+        T acc = T(0);
+        for (int l = 0; l < params.k; l++) {
+          T diff = h_x[i * params.k + l] - h_y[j * params.k + l];
+          acc += diff * diff;
+        }
+        h_ref[size_t(i) * params.n + j] = sqrt ? std::sqrt(acc) : acc;
+      }
+    }
+  }
+
+ protected:
+  FixedDimInputs<T> params;
+  raft::handle_t handle;
+  cudaStream_t stream = 0;
+  rmm::device_uvector<T> x, y, dist;
+  std::vector<T> h_ref;
+};
+
+// m * n stays above the tiny-input host fallback threshold so the requests
+// actually reach the device dispatch
+const std::vector<FixedDimInputs<float>> inputsf = {
+  {0.001f, 301, 267, 64, raft::distance::DistanceType::L2Expanded, 1234ULL},
+  {0.001f, 400, 251, 96, raft::distance::DistanceType::L2SqrtExpanded, 1234ULL},
+  {0.001f, 265, 256, 128, raft::distance::DistanceType::L2Unexpanded, 1234ULL},
+  {0.001f, 300, 300, 256, raft::distance::DistanceType::L2SqrtUnexpanded, 1234ULL},
+};
+typedef FixedDimDistanceTest<float> FixedDimDistanceTestF;
+TEST_P(FixedDimDistanceTestF, Result)
+{
+  ASSERT_TRUE(raft::devArrMatchHost(h_ref.data(),
+                                    dist.data(),
+                                    size_t(params.m) * params.n,
+                                    raft::CompareApprox<float>(params.tolerance)));
+}
+INSTANTIATE_TEST_CASE_P(FixedDimDistanceTests, FixedDimDistanceTestF, ::testing::ValuesIn(inputsf));
+
+// double has no prebuilt dim-256 tile (shared memory limit); 128 covers the
+// largest double specialization
+const std::vector<FixedDimInputs<double>> inputsd = {
+  {1e-6, 301, 267, 64, raft::distance::DistanceType::L2Expanded, 1234ULL},
+  {1e-6, 265, 256, 128, raft::distance::DistanceType::L2SqrtUnexpanded, 1234ULL},
+};
+typedef FixedDimDistanceTest<double> FixedDimDistanceTestD;
+TEST_P(FixedDimDistanceTestD, Result)
+{
+  ASSERT_TRUE(raft::devArrMatchHost(h_ref.data(),
+                                    dist.data(),
+                                    size_t(params.m) * params.n,
+                                    raft::CompareApprox<double>(params.tolerance)));
+}
+INSTANTIATE_TEST_CASE_P(FixedDimDistanceTests, FixedDimDistanceTestD, ::testing::ValuesIn(inputsd));
+
+}  // end namespace distance
+}  // end namespace raft
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils.h"
+#include <gtest/gtest.h>
+#include <raft/cudart_utils.h>
+#include <raft/distance/distance.cuh>
+#include <raft/random/rng.cuh>
+
+#include <cmath>
+#include <vector>
+
+namespace raft {
+namespace distance {
+
+template <typename DataT>
+struct SymmetricDistInputs {
+  DataT tolerance;
+  int n, k;
+  raft::distance::DistanceType metric;
+  bool mirror;
+  unsigned long long int seed;
+};
+
+// the symmetric self-join driver must reproduce the rectangular call: the
+// full matrix when mirroring, the upper triangle otherwise
+template <typename DataT>
+class SymmetricDistTest : public ::testing::TestWithParam<SymmetricDistInputs<DataT>> {
+ public:
+  SymmetricDistTest()
+    : params(::testing::TestWithParam<SymmetricDistInputs<DataT>>::GetParam()),
+      stream(handle.get_stream()),
+      x(params.n * params.k, stream),
+      dist_act(params.n * params.n, stream),
+      dist_exp(params.n * params.n, stream)
+  {
+  }
+
+ protected:
+  void SetUp() override
+  {
+    int n = params.n, k = params.k;
+
+    raft::random::RngState r(params.seed);
+    uniform(handle, r, x.data(), n * k, DataT(-1.0), DataT(1.0));
+
+    rmm::device_uvector<char> workspace(0, stream);
+    pairwise_distance(
+      handle, x.data(), x.data(), dist_exp.data(), n, n, k, workspace, params.metric, true);
+
+    pairwise_distance_symmetric(
+      handle, x.data(), dist_act.data(), n, k, params.metric, params.mirror);
+    RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+  }
+
+  bool match()
+  {
+    int n = params.n;
+    if (params.mirror) {
+      return devArrMatch(
+        dist_exp.data(), dist_act.data(), n * n, CompareApprox<DataT>(params.tolerance));
+    }
+    // only the upper triangle is defined
+    std::vector<DataT> h_exp(n * n), h_act(n * n);
+    raft::update_host(h_exp.data(), dist_exp.data(), n * n, stream);
+    raft::update_host(h_act.data(), dist_act.data(), n * n, stream);
+    RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+    for (int i = 0; i < n; i++) {
+      for (int j = i; j < n; j++) {
+        if (std::abs(h_exp[i * n + j] - h_act[i * n + j]) > params.tolerance) { return false; }
+      }
+    }
+    return true;
+  }
+
+ protected:
+  raft::handle_t handle;
+  cudaStream_t stream;
+
+  SymmetricDistInputs<DataT> params;
+  rmm::device_uvector<DataT> x, dist_act, dist_exp;
+};
+
+const std::vector<SymmetricDistInputs<float>> inputsf = {
+  {0.001f, 512, 32, raft::distance::DistanceType::L2Unexpanded, true, 1234ULL},
+  {0.001f, 512, 32, raft::distance::DistanceType::L2Unexpanded, false, 1234ULL},
+  {0.001f, 1500, 67, raft::distance::DistanceType::L2SqrtUnexpanded, true, 1234ULL},
+  {0.001f, 1500, 67, raft::distance::DistanceType::L1, true, 1234ULL},
+  {0.001f, 2050, 16, raft::distance::DistanceType::Linf, true, 1234ULL},
+};
+
+const std::vector<SymmetricDistInputs<double>> inputsd = {
+  {1e-6, 512, 32, raft::distance::DistanceType::L2Unexpanded, true, 1234ULL},
+  {1e-6, 1500, 67, raft::distance::DistanceType::L1, true, 1234ULL},
+  {1e-6, 1500, 67, raft::distance::DistanceType::L2SqrtUnexpanded, false, 1234ULL},
+};
+
+typedef SymmetricDistTest<float> SymmetricDistTestF;
+TEST_P(SymmetricDistTestF, Result) { ASSERT_TRUE(match()); }
+
+typedef SymmetricDistTest<double> SymmetricDistTestD;
+TEST_P(SymmetricDistTestD, Result) { ASSERT_TRUE(match()); }
+
+INSTANTIATE_TEST_SUITE_P(SymmetricDistTests, SymmetricDistTestF, ::testing::ValuesIn(inputsf));
+INSTANTIATE_TEST_SUITE_P(SymmetricDistTests, SymmetricDistTestD, ::testing::ValuesIn(inputsd));
+
+}  // namespace distance
+}  // namespace raft
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils.h"
+#include <gtest/gtest.h>
+#include <raft/cudart_utils.h>
+#include <raft/distance/distance.cuh>
+#include <raft/random/rng.cuh>
+
+#include <cmath>
+#include <vector>
+
+namespace raft {
+namespace distance {
+
+template <typename DataT>
+struct WeightedL2Inputs {
+  DataT tolerance;
+  int m, n, k;
+  bool sqrt, isRowMajor;
+  unsigned long long int seed;
+};
+
+template <typename DataT>
+class WeightedL2Test : public ::testing::TestWithParam<WeightedL2Inputs<DataT>> {
+ public:
+  WeightedL2Test()
+    : params(::testing::TestWithParam<WeightedL2Inputs<DataT>>::GetParam()),
+      stream(handle.get_stream()),
+      x(params.m * params.k, stream),
+      y(params.n * params.k, stream),
+      weights(params.k, stream),
+      dist_act(params.m * params.n, stream),
+      dist_exp(params.m * params.n, stream)
+  {
+  }
+
+ protected:
+  void SetUp() override
+  {
+    int m = params.m, n = params.n, k = params.k;
+
+    raft::random::RngState r(params.seed);
+    uniform(handle, r, x.data(), m * k, DataT(-1.0), DataT(1.0));
+    uniform(handle, r, y.data(), n * k, DataT(-1.0), DataT(1.0));
+    uniform(handle, r, weights.data(), k, DataT(0.1), DataT(2.0));
+
+    std::vector<DataT> h_x(m * k), h_y(n * k), h_w(k), h_dist(m * n);
+    raft::update_host(h_x.data(), x.data(), m * k, stream);
+    raft::update_host(h_y.data(), y.data(), n * k, stream);
+    raft::update_host(h_w.data(), weights.data(), k, stream);
+    RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+
+    auto xat = [&](int i, int kk) { return params.isRowMajor ? h_x[i * k + kk] : h_x[kk * m + i]; };
+    auto yat = [&](int j, int kk) { return params.isRowMajor ? h_y[j * k + kk] : h_y[kk * n + j]; };
+    for (int i = 0; i < m; i++) {
+      for (int j = 0; j < n; j++) {
+        DataT acc = 0;
+        for (int kk = 0; kk < k; kk++) {
+          DataT diff = xat(i, kk) - yat(j, kk);
+          acc += h_w[kk] * diff * diff;
+        }
+        if (params.sqrt) { acc = std::sqrt(acc); }
+        h_dist[params.isRowMajor ? i * n + j : j * m + i] = acc;
+      }
+    }
+    raft::update_device(dist_exp.data(), h_dist.data(), m * n, stream);
+
+    weighted_l2_distance(handle,
+                         x.data(),
+                         y.data(),
+                         weights.data(),
+                         dist_act.data(),
+                         m,
+                         n,
+                         k,
+                         params.sqrt,
+                         params.isRowMajor);
+    RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+  }
+
+ protected:
+  raft::handle_t handle;
+  cudaStream_t stream;
+
+  WeightedL2Inputs<DataT> params;
+  rmm::device_uvector<DataT> x, y, weights, dist_act, dist_exp;
+};
+
+const std::vector<WeightedL2Inputs<float>> inputsf = {
+  {0.003f, 128, 64, 32, false, true, 1234ULL},
+  {0.003f, 128, 64, 32, true, true, 1234ULL},
+  {0.003f, 1024, 256, 67, false, true, 1234ULL},
+  {0.003f, 1024, 256, 67, true, true, 1234ULL},
+  {0.003f, 128, 64, 32, false, false, 1234ULL},
+  {0.003f, 1024, 256, 67, true, false, 1234ULL}};
+
+const std::vector<WeightedL2Inputs<double>> inputsd = {
+  {1e-6, 128, 64, 32, false, true, 1234ULL},
+  {1e-6, 128, 64, 32, true, true, 1234ULL},
+  {1e-6, 1024, 256, 67, false, true, 1234ULL},
+  {1e-6, 1024, 256, 67, true, false, 1234ULL}};
+
+typedef WeightedL2Test<float> WeightedL2TestF;
+TEST_P(WeightedL2TestF, Result)
+{
+  ASSERT_TRUE(devArrMatch(dist_exp.data(),
+                          dist_act.data(),
+                          params.m * params.n,
+                          CompareApprox<float>(params.tolerance)));
+}
+
+typedef WeightedL2Test<double> WeightedL2TestD;
+TEST_P(WeightedL2TestD, Result)
+{
+  ASSERT_TRUE(devArrMatch(dist_exp.data(),
+                          dist_act.data(),
+                          params.m * params.n,
+                          CompareApprox<double>(params.tolerance)));
+}
+
+INSTANTIATE_TEST_SUITE_P(WeightedL2Tests, WeightedL2TestF, ::testing::ValuesIn(inputsf));
+INSTANTIATE_TEST_SUITE_P(WeightedL2Tests, WeightedL2TestD, ::testing::ValuesIn(inputsd));
+
+}  // namespace distance
+}  // namespace raft
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils.h"
+#include <gtest/gtest.h>
+#include <raft/cudart_utils.h>
+#include <raft/distance/masked_distance.cuh>
+#include <raft/random/rng.cuh>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace raft {
+namespace distance {
+
+template <typename DataT>
+struct MaskedDistanceInputs {
+  DataT tolerance;
+  int m, n, k, cands_per_row;
+  raft::distance::DistanceType metric;
+  unsigned long long int seed;
+};
+
+template <typename DataT>
+class MaskedDistanceTest : public ::testing::TestWithParam<MaskedDistanceInputs<DataT>> {
+ public:
+  MaskedDistanceTest()
+    : params(::testing::TestWithParam<MaskedDistanceInputs<DataT>>::GetParam()),
+      stream(handle.get_stream()),
+      x(params.m * params.k, stream),
+      y(params.n * params.k, stream),
+      indptr(params.m + 1, stream),
+      indices(params.m * params.cands_per_row, stream),
+      dist(params.m * params.cands_per_row, stream)
+  {
+  }
+
+ protected:
+  void SetUp() override
+  {
+    int m   = params.m;
+    int n   = params.n;
+    int k   = params.k;
+    int nnz = m * params.cands_per_row;
+
+    raft::random::RngState r(params.seed);
+    uniform(handle, r, x.data(), m * k, DataT(-1.0), DataT(1.0));
+    uniform(handle, r, y.data(), n * k, DataT(-1.0), DataT(1.0));
+
+    // candidate lists: cands_per_row random rows of y per query
+    std::mt19937 gen(params.seed);
+    std::uniform_int_distribution<int> col(0, n - 1);
+    std::vector<int> h_indptr(m + 1);
+    std::vector<int> h_indices(nnz);
+    for (int i = 0; i <= m; i++) {
+      h_indptr[i] = i * params.cands_per_row;
+    }
+    for (int i = 0; i < nnz; i++) {
+      h_indices[i] = col(gen);
+    }
+    raft::update_device(indptr.data(), h_indptr.data(), m + 1, stream);
+    raft::update_device(indices.data(), h_indices.data(), nnz, stream);
+
+    masked_pairwise_distance<DataT, int>(handle,
+                                         x.data(),
+                                         y.data(),
+                                         m,
+                                         n,
+                                         k,
+                                         indptr.data(),
+                                         indices.data(),
+                                         nnz,
+                                         dist.data(),
+                                         params.metric);
+
+    // host reference
+    std::vector<DataT> h_x(m * k), h_y(n * k);
+    raft::update_host(h_x.data(), x.data(), m * k, stream);
+    raft::update_host(h_y.data(), y.data(), n * k, stream);
+    RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+    dist_ref.resize(nnz);
+    for (int i = 0; i < m; i++) {
+      for (int idx = h_indptr[i]; idx < h_indptr[i + 1]; idx++) {
+        int j = h_indices[idx];
+        double acc = 0, xn = 0, yn = 0;
+        for (int d = 0; d < k; d++) {
+          double xv = h_x[i * k + d], yv = h_y[j * k + d];
+          switch (params.metric) {
+            case raft::distance::DistanceType::L1: acc += std::abs(xv - yv); break;
+            case raft::distance::DistanceType::InnerProduct: acc += xv * yv; break;
+            case raft::distance::DistanceType::CosineExpanded:
+              acc += xv * yv;
+              xn += xv * xv;
+              yn += yv * yv;
+              break;
+            default: acc += (xv - yv) * (xv - yv); break;
+          }
+        }
+        if (params.metric == raft::distance::DistanceType::L2SqrtExpanded ||
+            params.metric == raft::distance::DistanceType::L2SqrtUnexpanded) {
+          acc = std::sqrt(acc);
+        } else if (params.metric == raft::distance::DistanceType::CosineExpanded) {
+          acc = 1.0 - acc / (std::sqrt(xn) * std::sqrt(yn));
+        }
+        dist_ref[idx] = DataT(acc);
+      }
+    }
+  }
+
+ protected:
+  raft::handle_t handle;
+  cudaStream_t stream;
+  MaskedDistanceInputs<DataT> params;
+  rmm::device_uvector<DataT> x;
+  rmm::device_uvector<DataT> y;
+  rmm::device_uvector<int> indptr;
+  rmm::device_uvector<int> indices;
+  rmm::device_uvector<DataT> dist;
+  std::vector<DataT> dist_ref;
+};
+
+const std::vector<MaskedDistanceInputs<float>> inputsf = {
+  {0.001f, 128, 1024, 32, 200, raft::distance::DistanceType::L2Expanded, 1234ULL},
+  {0.001f, 128, 1024, 32, 200, raft::distance::DistanceType::L2SqrtExpanded, 1234ULL},
+  {0.001f, 64, 512, 77, 100, raft::distance::DistanceType::CosineExpanded, 1234ULL},
+  {0.001f, 64, 512, 77, 100, raft::distance::DistanceType::InnerProduct, 1234ULL},
+  {0.001f, 33, 200, 130, 17, raft::distance::DistanceType::L1, 1234ULL},
+};
+typedef MaskedDistanceTest<float> MaskedDistanceTestF;
+TEST_P(MaskedDistanceTestF, Result)
+{
+  ASSERT_TRUE(devArrMatchHost(dist_ref.data(),
+                              dist.data(),
+                              dist_ref.size(),
+                              raft::CompareApprox<float>(params.tolerance),
+                              stream));
+}
+INSTANTIATE_TEST_CASE_P(MaskedDistanceTests, MaskedDistanceTestF, ::testing::ValuesIn(inputsf));
+
+const std::vector<MaskedDistanceInputs<double>> inputsd = {
+  {1e-6, 128, 1024, 32, 200, raft::distance::DistanceType::L2Expanded, 1234ULL},
+  {1e-6, 64, 512, 77, 100, raft::distance::DistanceType::CosineExpanded, 1234ULL},
+};
+typedef MaskedDistanceTest<double> MaskedDistanceTestD;
+TEST_P(MaskedDistanceTestD, Result)
+{
+  ASSERT_TRUE(devArrMatchHost(dist_ref.data(),
+                              dist.data(),
+                              dist_ref.size(),
+                              raft::CompareApprox<double>(params.tolerance),
+                              stream));
+}
+INSTANTIATE_TEST_CASE_P(MaskedDistanceTests, MaskedDistanceTestD, ::testing::ValuesIn(inputsd));
+
+}  // namespace distance
+}  // namespace raft
@@ -72,6 +72,14 @@ TEST(Raft, EigenSolvers)
   EXPECT_ANY_THROW(eig_solver.solve_smallest_eigenvectors(h, sm1, eigvals, eigvecs));
 
   EXPECT_ANY_THROW(eig_solver.solve_largest_eigenvectors(h, sm1, eigvals, eigvecs));
+
+  lobpcg_solver_t<index_type, value_type> block_eig_solver{cfg};
+
+  EXPECT_ANY_THROW(block_eig_solver.solve_smallest_eigenvectors(h, sm1, eigvals, eigvecs));
+
+  value_type* eigvecs_init{nullptr};
+  EXPECT_ANY_THROW(
+    block_eig_solver.solve_smallest_eigenvectors(h, sm1, eigvals, eigvecs, eigvecs_init));
 }
 
 TEST(Raft, SpectralSolvers)
@@ -116,6 +124,11 @@ TEST(Raft, SpectralSolvers)
   EXPECT_ANY_THROW(
     spectral::partition(h, sm, eig_solver, cluster_solver, clusters, eigvals, eigvecs));
 
+  lobpcg_solver_t<index_type, value_type> block_eig_solver{eig_cfg};
+  value_type* eigvecs_init{nullptr};
+  EXPECT_ANY_THROW(spectral::partition(
+    h, sm, block_eig_solver, cluster_solver, clusters, eigvals, eigvecs, eigvecs_init));
+
   value_type edgeCut{0};
   value_type cost{0};
   EXPECT_ANY_THROW(spectral::analyzePartition(h, sm, k, clusters, edgeCut, cost));
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <raft/core/event_pool.hpp>
+#include <raft/core/handle.hpp>
+#include <raft/cudart_utils.h>
+
+#include <thread>
+#include <vector>
+
+namespace raft {
+
+TEST(EventPool, ReusesReleasedEvents)
+{
+  event_pool pool;
+  auto ev = pool.acquire();
+  ASSERT_NE(ev, nullptr);
+  pool.release(ev);
+  // the pool was otherwise empty, so the next checkout must hand the
+  // same event back instead of creating a new one
+  ASSERT_EQ(ev, pool.acquire());
+  pool.release(ev);
+}
+
+TEST(EventPool, PooledEventRaii)
+{
+  event_pool pool;
+  cudaEvent_t seen;
+  {
+    pooled_event ev(pool);
+    seen = ev.value();
+    ASSERT_NE(seen, nullptr);
+  }
+  // returned on scope exit
+  ASSERT_EQ(seen, pool.acquire());
+  pool.release(seen);
+}
+
+TEST(EventPool, RecordAndWait)
+{
+  handle_t handle;
+  pooled_event ev(handle.get_event_pool());
+  RAFT_CUDA_TRY(cudaEventRecord(ev, handle.get_stream()));
+  RAFT_CUDA_TRY(cudaStreamWaitEvent(handle.get_stream(), ev, 0));
+  handle.sync_stream();
+}
+
+TEST(EventPool, ConcurrentCheckout)
+{
+  event_pool pool;
+  std::vector<std::thread> workers;
+  for (int t = 0; t < 8; t++) {
+    workers.emplace_back([&]() {
+      for (int i = 0; i < 200; i++) {
+        pooled_event ev(pool);
+        ASSERT_NE(ev.value(), nullptr);
+      }
+    });
+  }
+  for (auto& w : workers) {
+    w.join();
+  }
+}
+
+}  // namespace raft
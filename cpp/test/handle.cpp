@@ -51,6 +51,26 @@ TEST(Raft, Handle)
   RAFT_CUDA_TRY(cudaStreamDestroy(stream));
 }
 
+TEST(Raft, HandleHighPriorityStream)
+{
+  handle_t h;
+
+  // the lane is created lazily and cached on first use
+  auto hp_stream = h.get_high_priority_stream();
+  ASSERT_NE(h.get_stream(), hp_stream);
+  ASSERT_EQ(hp_stream, h.get_high_priority_stream());
+
+  // the lane must run at the greatest priority the device supports
+  int least_priority, greatest_priority, stream_priority;
+  RAFT_CUDA_TRY(cudaDeviceGetStreamPriorityRange(&least_priority, &greatest_priority));
+  RAFT_CUDA_TRY(cudaStreamGetPriority(hp_stream.value(), &stream_priority));
+  ASSERT_EQ(greatest_priority, stream_priority);
+
+  ASSERT_EQ(h.get_stream(), h.get_execution_stream(execution_lane::DEFAULT));
+  ASSERT_EQ(hp_stream, h.get_execution_stream(execution_lane::HIGH_PRIORITY));
+  h.sync_stream(hp_stream);
+}
+
 TEST(Raft, GetHandleFromPool)
 {
   constexpr std::size_t n_streams = 4;
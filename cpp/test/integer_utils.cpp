@@ -36,4 +36,30 @@ TEST(Raft, is_a_power_of_two)
   ASSERT_EQ(raft::is_a_power_of_two((1 << 5) + 1), false);
 }
 
+TEST(Raft, fast_div_mod)
+{
+  uint32_t divisors[] = {1, 2, 3, 5, 7, 19, 32, 100, 255, 256, 257, 1000003, (1u << 30) - 1};
+  uint32_t dividends[] = {0, 1, 2, 31, 32, 33, 12345, (1u << 20) + 7, (1u << 31) - 2, (1u << 31) - 1};
+  for (auto d : divisors) {
+    raft::fast_div_mod fdm(d);
+    for (auto n : dividends) {
+      ASSERT_EQ(n / d, fdm.div(n)) << "div: " << n << " / " << d;
+      ASSERT_EQ(n % d, fdm.mod(n)) << "mod: " << n << " % " << d;
+      uint32_t q, r;
+      fdm.divmod(n, q, r);
+      ASSERT_EQ(n / d, q);
+      ASSERT_EQ(n % d, r);
+    }
+  }
+  // 64-bit dividends beyond 2^31 take the hardware-division fallback
+  raft::fast_div_mod fdm(12345);
+  uint64_t big = (uint64_t{1} << 40) + 999;
+  uint64_t q, r;
+  fdm.divmod(big, q, r);
+  ASSERT_EQ(big / 12345, q);
+  ASSERT_EQ(big % 12345, r);
+
+  ASSERT_THROW(raft::fast_div_mod(0), std::invalid_argument);
+}
+
 }  // namespace raft
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils.h"
+#include <gtest/gtest.h>
+#include <raft/cudart_utils.h>
+#include <raft/handle.hpp>
+#include <raft/io/gds_loader.hpp>
+
+#include <rmm/device_uvector.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace raft {
+namespace io {
+
+class GDSLoaderTest : public ::testing::Test {
+ protected:
+  void SetUp() override
+  {
+    path_ = ::testing::TempDir() + "raft_gds_loader_test.bin";
+
+    dataset_header header{};
+    header.magic      = dataset_header::kMagic;
+    header.version    = dataset_header::kVersion;
+    header.dtype_size = sizeof(float);
+    header.rank       = 2;
+    header.extent[0]  = n_rows;
+    header.extent[1]  = n_cols;
+
+    payload.resize(n_rows * n_cols);
+    std::iota(payload.begin(), payload.end(), 1.0f);
+
+    std::ofstream os(path_, std::ios::binary);
+    os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    os.write(reinterpret_cast<const char*>(payload.data()), payload.size() * sizeof(float));
+  }
+
+  void TearDown() override { std::remove(path_.c_str()); }
+
+  static constexpr size_t n_rows = 10;
+  static constexpr size_t n_cols = 8;
+
+  std::string path_;
+  std::vector<float> payload;
+};
+
+TEST_F(GDSLoaderTest, Header)
+{
+  auto header = read_header(path_);
+  ASSERT_EQ(header.rank, 2u);
+  ASSERT_EQ(header.dtype_size, sizeof(float));
+  ASSERT_EQ(header.extent[0], n_rows);
+  ASSERT_EQ(header.extent[1], n_cols);
+}
+
+TEST_F(GDSLoaderTest, LoadMatrix)
+{
+  raft::handle_t handle;
+  auto stream = handle.get_stream();
+
+  auto mat = load_matrix<float>(handle, path_);
+  ASSERT_EQ((size_t)mat.extent(0), n_rows);
+  ASSERT_EQ((size_t)mat.extent(1), n_cols);
+
+  rmm::device_uvector<float> expected(payload.size(), stream);
+  raft::update_device(expected.data(), payload.data(), payload.size(), stream);
+  ASSERT_TRUE(raft::devArrMatch<float>(
+    expected.data(), mat.data(), payload.size(), raft::Compare<float>(), stream));
+}
+
+TEST_F(GDSLoaderTest, RawReadAtOffset)
+{
+  raft::handle_t handle;
+  auto stream = handle.get_stream();
+
+  // read the second row only
+  rmm::device_uvector<float> row(n_cols, stream);
+  read(handle, path_, sizeof(dataset_header) + n_cols * sizeof(float), row.data(), n_cols);
+
+  rmm::device_uvector<float> expected(n_cols, stream);
+  raft::update_device(expected.data(), payload.data() + n_cols, n_cols, stream);
+  ASSERT_TRUE(
+    raft::devArrMatch<float>(expected.data(), row.data(), n_cols, raft::Compare<float>(), stream));
+}
+
+TEST_F(GDSLoaderTest, WrongDtypeThrows)
+{
+  raft::handle_t handle;
+  ASSERT_THROW(load_matrix<double>(handle, path_), raft::exception);
+}
+
+}  // namespace io
+}  // namespace raft
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils.h"
+#include <gtest/gtest.h>
+#include <raft/cudart_utils.h>
+#include <raft/handle.hpp>
+#include <raft/io/serialize.hpp>
+#include <raft/sparse/coo.hpp>
+
+#include <cstdio>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace raft {
+namespace io {
+
+TEST(SerializeTest, DenseMatrixRoundTrip)
+{
+  raft::handle_t handle;
+  auto stream = handle.get_stream();
+
+  constexpr size_t n_rows = 7;
+  constexpr size_t n_cols = 5;
+
+  std::vector<float> h_data(n_rows * n_cols);
+  std::iota(h_data.begin(), h_data.end(), 0.0f);
+
+  auto mat = raft::make_device_matrix<float>(handle, n_rows, n_cols);
+  raft::update_device(mat.data(), h_data.data(), h_data.size(), stream);
+  handle.sync_stream();
+
+  std::string path = ::testing::TempDir() + "raft_serialize_dense_test.bin";
+  serialize(handle, path, mat);
+
+  auto restored = deserialize_matrix<float>(handle, path);
+  ASSERT_EQ(restored.extent(0), mat.extent(0));
+  ASSERT_EQ(restored.extent(1), mat.extent(1));
+  ASSERT_TRUE(raft::devArrMatch<float>(
+    mat.data(), restored.data(), h_data.size(), raft::Compare<float>(), stream));
+
+  std::remove(path.c_str());
+}
+
+TEST(SerializeTest, CooRoundTrip)
+{
+  raft::handle_t handle;
+  auto stream = handle.get_stream();
+
+  std::vector<int> rows_h   = {0, 0, 1, 2, 2};
+  std::vector<int> cols_h   = {1, 2, 0, 0, 1};
+  std::vector<float> vals_h = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+
+  raft::sparse::COO<float> coo(stream, 5, 3, 3, false);
+  raft::update_device(coo.rows(), rows_h.data(), 5, stream);
+  raft::update_device(coo.cols(), cols_h.data(), 5, stream);
+  raft::update_device(coo.vals(), vals_h.data(), 5, stream);
+  coo.sorted = true;
+  coo.unique = true;
+  handle.sync_stream();
+
+  std::string path = ::testing::TempDir() + "raft_serialize_coo_test.bin";
+  serialize(handle, path, coo);
+
+  raft::sparse::COO<float> restored(stream);
+  deserialize(handle, path, restored);
+
+  ASSERT_EQ(restored.nnz, coo.nnz);
+  ASSERT_EQ(restored.n_rows, coo.n_rows);
+  ASSERT_EQ(restored.n_cols, coo.n_cols);
+
+  // invariant flags survive the round trip
+  ASSERT_TRUE(restored.sorted);
+  ASSERT_TRUE(restored.unique);
+
+  ASSERT_TRUE(
+    raft::devArrMatch<int>(coo.rows(), restored.rows(), coo.nnz, raft::Compare<int>(), stream));
+  ASSERT_TRUE(
+    raft::devArrMatch<int>(coo.cols(), restored.cols(), coo.nnz, raft::Compare<int>(), stream));
+  ASSERT_TRUE(
+    raft::devArrMatch<float>(coo.vals(), restored.vals(), coo.nnz, raft::Compare<float>(), stream));
+
+  std::remove(path.c_str());
+}
+
+TEST(SerializeTest, TypeMismatchThrows)
+{
+  raft::handle_t handle;
+  auto stream = handle.get_stream();
+
+  auto vec = raft::make_device_vector<float>(handle, 16);
+  RAFT_CUDA_TRY(cudaMemsetAsync(vec.data(), 0, 16 * sizeof(float), stream));
+  handle.sync_stream();
+
+  std::string path = ::testing::TempDir() + "raft_serialize_vec_test.bin";
+  serialize(handle, path, vec);
+
+  ASSERT_THROW(deserialize_vector<double>(handle, path), raft::exception);
+  // rank mismatch is also rejected
+  ASSERT_THROW(deserialize_matrix<float>(handle, path), raft::exception);
+
+  auto restored = deserialize_vector<float>(handle, path);
+  ASSERT_EQ((size_t)restored.extent(0), (size_t)16);
+
+  std::remove(path.c_str());
+}
+
+}  // namespace io
+}  // namespace raft
@@ -68,6 +68,21 @@ class MergeLabelsTest : public ::testing::TestWithParam<MergeLabelsInputs<Index_
       expected.data(), labels_a.data(), params.N, raft::Compare<Index_>(), stream));
   }
 
+  void RunCoop()
+  {
+    raft::update_device(labels_a.data(), params.labels_a.data(), params.N, stream);
+    raft::update_device(labels_b.data(), params.labels_b.data(), params.N, stream);
+    raft::update_device(expected.data(), params.expected.data(), params.N, stream);
+    raft::update_device(mask.data(), reinterpret_cast<bool*>(params.mask.data()), params.N, stream);
+
+    merge_labels_coop(
+      labels_a.data(), labels_b.data(), mask.data(), R.data(), m.data(), params.N, stream);
+
+    cudaStreamSynchronize(stream);
+    ASSERT_TRUE(raft::devArrMatch<Index_>(
+      expected.data(), labels_a.data(), params.N, raft::Compare<Index_>(), stream));
+  }
+
  protected:
   raft::handle_t handle;
   cudaStream_t stream;
@@ -79,9 +94,11 @@ class MergeLabelsTest : public ::testing::TestWithParam<MergeLabelsInputs<Index_
 
 using MergeLabelsTestI = MergeLabelsTest<int>;
 TEST_P(MergeLabelsTestI, Result) { Run(); }
+TEST_P(MergeLabelsTestI, ResultCoop) { RunCoop(); }
 
 using MergeLabelsTestL = MergeLabelsTest<int64_t>;
 TEST_P(MergeLabelsTestL, Result) { Run(); }
+TEST_P(MergeLabelsTestL, ResultCoop) { RunCoop(); }
 
 constexpr int MAX32     = std::numeric_limits<int>::max();
 constexpr int64_t MAX64 = std::numeric_limits<int64_t>::max();
@@ -30,6 +30,7 @@
 #include <omp.h>
 #include <raft/lap/lap.cuh>
 #include <random>
+#include <vector>
 
 #define PROBLEMSIZE  1000  // Number of rows/columns
 #define BATCHSIZE    10    // Number of problems in the batch
@@ -109,6 +110,111 @@ void hungarian_test(int problemsize,
   delete[] h_cost;
 }
 
+// Solves the same batch of small problems with the host-driven solver and
+// the single-launch device-resident solver, and checks that both reach the
+// same optimal objective (the optimum is unique even when the assignments
+// are not).
+template <typename vertex_t, typename weight_t>
+void hungarian_small_test(int problemsize, int costrange, int batchsize, weight_t epsilon)
+{
+  raft::handle_t handle;
+
+  std::vector<weight_t> h_cost(batchsize * problemsize * problemsize);
+
+  generateProblem(h_cost.data(), batchsize, problemsize, costrange);
+
+  rmm::device_uvector<weight_t> elements_v(batchsize * problemsize * problemsize,
+                                           handle.get_stream());
+  rmm::device_uvector<vertex_t> row_assignment_v(batchsize * problemsize, handle.get_stream());
+  rmm::device_uvector<vertex_t> col_assignment_v(batchsize * problemsize, handle.get_stream());
+
+  raft::update_device(
+    elements_v.data(), h_cost.data(), batchsize * problemsize * problemsize, handle.get_stream());
+
+  raft::lap::LinearAssignmentProblem<vertex_t, weight_t> lpx(
+    handle, problemsize, batchsize, epsilon);
+  lpx.solve(elements_v.data(), row_assignment_v.data(), col_assignment_v.data());
+
+  std::vector<weight_t> ref_obj(batchsize);
+  for (int k = 0; k < batchsize; k++) {
+    ref_obj[k] = lpx.getPrimalObjectiveValue(k);
+  }
+
+  raft::lap::LinearAssignmentProblem<vertex_t, weight_t> lps(
+    handle, problemsize, batchsize, epsilon);
+  lps.solveSmall(elements_v.data(), row_assignment_v.data(), col_assignment_v.data());
+
+  std::vector<vertex_t> h_row_assignment(batchsize * problemsize);
+  raft::update_host(h_row_assignment.data(),
+                    row_assignment_v.data(),
+                    batchsize * problemsize,
+                    handle.get_stream());
+  handle.sync_stream();
+
+  for (int k = 0; k < batchsize; k++) {
+    // both solvers must agree on the optimum, and the small solver's primal
+    // and dual objectives must match at optimality
+    EXPECT_EQ(ref_obj[k], lps.getPrimalObjectiveValue(k)) << "subproblem " << k;
+    EXPECT_EQ(lps.getPrimalObjectiveValue(k), lps.getDualObjectiveValue(k)) << "subproblem " << k;
+
+    // the returned assignment must be a permutation with the claimed cost
+    std::vector<bool> seen(problemsize, false);
+    weight_t assigned_cost{0};
+    for (int i = 0; i < problemsize; i++) {
+      vertex_t j = h_row_assignment[k * problemsize + i];
+      ASSERT_TRUE(j >= 0 && j < problemsize);
+      ASSERT_FALSE(seen[j]);
+      seen[j] = true;
+      assigned_cost += h_cost[long(k) * problemsize * problemsize + i * problemsize + j];
+    }
+    EXPECT_EQ(assigned_cost, lps.getPrimalObjectiveValue(k)) << "subproblem " << k;
+  }
+}
+
+// Solves a batch, perturbs a few percent of the cost entries as in a
+// frame-to-frame tracking workload, and checks that a warm-started solve of
+// the perturbed batch reaches the same optimum as a cold solve.
+template <typename vertex_t, typename weight_t>
+void hungarian_warm_test(int problemsize, int costrange, int batchsize, weight_t epsilon)
+{
+  raft::handle_t handle;
+
+  long N2 = long(batchsize) * problemsize * problemsize;
+  std::vector<weight_t> h_cost(N2);
+
+  generateProblem(h_cost.data(), batchsize, problemsize, costrange);
+
+  rmm::device_uvector<weight_t> elements_v(N2, handle.get_stream());
+  rmm::device_uvector<vertex_t> row_assignment_v(batchsize * problemsize, handle.get_stream());
+  rmm::device_uvector<vertex_t> col_assignment_v(batchsize * problemsize, handle.get_stream());
+
+  raft::update_device(elements_v.data(), h_cost.data(), N2, handle.get_stream());
+
+  raft::lap::LinearAssignmentProblem<vertex_t, weight_t> lpx(
+    handle, problemsize, batchsize, epsilon);
+  lpx.solve(elements_v.data(), row_assignment_v.data(), col_assignment_v.data());
+
+  // perturb ~5% of the entries
+  std::uniform_real_distribution<float> pick(0.0f, 1.0f);
+  std::uniform_int_distribution<int> distribution(0, costrange);
+  for (long i = 0; i < N2; i++) {
+    if (pick(generator) < 0.05f) { h_cost[i] = (weight_t)distribution(generator); }
+  }
+  raft::update_device(elements_v.data(), h_cost.data(), N2, handle.get_stream());
+
+  raft::lap::LinearAssignmentProblem<vertex_t, weight_t> lp_cold(
+    handle, problemsize, batchsize, epsilon);
+  lp_cold.solve(elements_v.data(), row_assignment_v.data(), col_assignment_v.data());
+
+  lpx.solveWarm(elements_v.data(), row_assignment_v.data(), col_assignment_v.data());
+
+  for (int k = 0; k < batchsize; k++) {
+    EXPECT_EQ(lp_cold.getPrimalObjectiveValue(k), lpx.getPrimalObjectiveValue(k))
+      << "subproblem " << k;
+    EXPECT_EQ(lpx.getPrimalObjectiveValue(k), lpx.getDualObjectiveValue(k)) << "subproblem " << k;
+  }
+}
+
 TEST(Raft, HungarianIntFloat)
 {
   hungarian_test<int, float>(
@@ -143,4 +249,17 @@ TEST(Raft, HungarianLongLong)
   hungarian_test<long, long>(PROBLEMSIZE, COSTRANGE, PROBLEMCOUNT, REPETITIONS, BATCHSIZE, long{0});
 }
 
+TEST(Raft, HungarianSmallIntFloat) { hungarian_small_test<int, float>(64, 1000, 200, float{1e-6}); }
+
+TEST(Raft, HungarianWarmIntFloat) { hungarian_warm_test<int, float>(200, 1000, 10, float{1e-6}); }
+
+TEST(Raft, HungarianWarmIntLong) { hungarian_warm_test<int, long>(200, 1000, 10, long{0}); }
+
+TEST(Raft, HungarianSmallIntLong) { hungarian_small_test<int, long>(33, 1000, 200, long{0}); }
+
+TEST(Raft, HungarianSmallLongDouble)
+{
+  hungarian_small_test<long, double>(17, 1000, 500, double{1e-6});
+}
+
 }  // namespace raft
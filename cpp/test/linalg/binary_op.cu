@@ -148,5 +148,41 @@ class BinaryOpAlignment : public ::testing::Test {
 typedef ::testing::Types<float, double> FloatTypes;
 TYPED_TEST_CASE(BinaryOpAlignment, FloatTypes);
 TYPED_TEST(BinaryOpAlignment, Misaligned) { this->Misaligned(); }
+
+TEST(BinaryOpStridedView, SubmatrixWindow)
+{
+  raft::handle_t handle;
+  auto stream = handle.get_stream();
+  // operate on a 6x5 window inside 8x7 row-major matrices
+  constexpr int big_rows = 8, big_cols = 7;
+  constexpr int n_rows = 6, n_cols = 5;
+  constexpr int len = big_rows * big_cols;
+  std::vector<float> h_in1(len), h_in2(len), h_out(len, -1.0f);
+  for (int i = 0; i < len; i++) {
+    h_in1[i] = float(i);
+    h_in2[i] = float(2 * i);
+  }
+  rmm::device_uvector<float> in1(len, stream), in2(len, stream), out(len, stream);
+  raft::update_device(in1.data(), h_in1.data(), len, stream);
+  raft::update_device(in2.data(), h_in2.data(), len, stream);
+  raft::update_device(out.data(), h_out.data(), len, stream);
+
+  auto v_in1 = raft::make_device_strided_matrix_view(in1.data() + 1, n_rows, n_cols, big_cols);
+  auto v_in2 = raft::make_device_strided_matrix_view(in2.data() + 1, n_rows, n_cols, big_cols);
+  auto v_out = raft::make_device_strided_matrix_view(out.data() + 1, n_rows, n_cols, big_cols);
+  binary_op(
+    handle, v_in1, v_in2, v_out, [] __device__(float a, float b) { return a + b; });
+
+  raft::update_host(h_out.data(), out.data(), len, stream);
+  handle.sync_stream();
+  for (int r = 0; r < big_rows; r++) {
+    for (int c = 0; c < big_cols; c++) {
+      int i = r * big_cols + c;
+      bool in_window = r < n_rows && c >= 1 && c < 1 + n_cols;
+      float expect   = in_window ? h_in1[i] + h_in2[i] : -1.0f;
+      ASSERT_EQ(expect, h_out[i]) << "at (" << r << ", " << c << ")";
+    }
+  }
+}
 }  // namespace linalg
 }  // namespace raft
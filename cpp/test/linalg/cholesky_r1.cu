@@ -97,6 +97,57 @@ class CholeskyR1Test : public ::testing::Test {
     }
   }
 
+  void testRkUpdate()
+  {
+    int n = n_rows * n_rows;
+    // Size workspace for the blocked update (potrf scratch + devInfo)
+    int n_bytes = 0;
+    raft::linalg::choleskyRankKUpdate(this->handle,
+                                      L.data(),
+                                      n_rows,
+                                      n_rows,
+                                      n_rows,
+                                      nullptr,
+                                      &n_bytes,
+                                      CUBLAS_FILL_MODE_LOWER,
+                                      handle.get_stream());
+    workspace.resize(std::max((size_t)n_bytes, (size_t)Lwork), handle.get_stream());
+
+    std::vector<cublasFillMode_t> fillmode{CUBLAS_FILL_MODE_LOWER, CUBLAS_FILL_MODE_UPPER};
+    for (auto uplo : fillmode) {
+      for (int k : {1, 2, 4}) {
+        std::stringstream ss;
+        ss << "Block size " << k << ((uplo == CUBLAS_FILL_MODE_LOWER) ? ", lower" : ", upper");
+        SCOPED_TRACE(ss.str());
+
+        raft::copy(L.data(), G.data(), n, handle.get_stream());
+        // Incremental Cholesky factorization using rank k updates.
+        for (int rank = k; rank <= n_rows; rank += k) {
+          raft::linalg::choleskyRankKUpdate(
+            handle, L.data(), rank, k, n_rows, workspace.data(), &n_bytes, uplo, handle.get_stream());
+        }
+
+        // Expected solution using Cholesky factorization from scratch
+        raft::copy(L_exp.data(), G.data(), n, handle.get_stream());
+        RAFT_CUSOLVER_TRY(raft::linalg::detail::cusolverDnpotrf(solver_handle,
+                                                                uplo,
+                                                                n_rows,
+                                                                L_exp.data(),
+                                                                n_rows,
+                                                                (math_t*)workspace.data(),
+                                                                Lwork,
+                                                                devInfo.data(),
+                                                                handle.get_stream()));
+
+        ASSERT_TRUE(raft::devArrMatch(L_exp.data(),
+                                      L.data(),
+                                      n_rows * n_rows,
+                                      raft::CompareApprox<math_t>(3e-3),
+                                      handle.get_stream()));
+      }
+    }
+  }
+
   void testR1Error()
   {
     raft::update_device(G.data(), G2_host, 4, handle.get_stream());
@@ -143,6 +194,7 @@ typedef ::testing::Types<float, double> FloatTypes;
 TYPED_TEST_CASE(CholeskyR1Test, FloatTypes);
 
 TYPED_TEST(CholeskyR1Test, update) { this->testR1Update(); }
+TYPED_TEST(CholeskyR1Test, rankKUpdate) { this->testRkUpdate(); }
 TYPED_TEST(CholeskyR1Test, throwError) { this->testR1Error(); }
 
 };  // namespace linalg
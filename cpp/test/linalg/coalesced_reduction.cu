@@ -91,12 +91,18 @@ class coalescedReductionTest : public ::testing::TestWithParam<coalescedReductio
 const std::vector<coalescedReductionInputs<float>> inputsf = {{0.000002f, 1024, 32, 1234ULL},
                                                               {0.000002f, 1024, 64, 1234ULL},
                                                               {0.000002f, 1024, 128, 1234ULL},
-                                                              {0.000002f, 1024, 256, 1234ULL}};
+                                                              {0.000002f, 1024, 256, 1234ULL},
+                                                              // multi-block wide-row path,
+                                                              // vectorized and scalar tails
+                                                              {0.0001f, 64, 16384, 1234ULL},
+                                                              {0.0001f, 64, 16386, 1234ULL}};
 
 const std::vector<coalescedReductionInputs<double>> inputsd = {{0.000000001, 1024, 32, 1234ULL},
                                                                {0.000000001, 1024, 64, 1234ULL},
                                                                {0.000000001, 1024, 128, 1234ULL},
-                                                               {0.000000001, 1024, 256, 1234ULL}};
+                                                               {0.000000001, 1024, 256, 1234ULL},
+                                                               {0.000000001, 64, 16384, 1234ULL},
+                                                               {0.000000001, 64, 16386, 1234ULL}};
 
 typedef coalescedReductionTest<float> coalescedReductionTestF;
 TEST_P(coalescedReductionTestF, Result)
@@ -270,5 +270,109 @@ INSTANTIATE_TEST_SUITE_P(EigTests, EigTestVecJacobiF, ::testing::ValuesIn(inputs
 
 INSTANTIATE_TEST_SUITE_P(EigTests, EigTestVecJacobiD, ::testing::ValuesIn(inputsd2));
 
+template <typename T>
+class EigBatchedTest : public ::testing::TestWithParam<EigInputs<T>> {
+ public:
+  EigBatchedTest()
+    : params(::testing::TestWithParam<EigInputs<T>>::GetParam()),
+      stream(handle.get_stream()),
+      cov_matrices(batch_size * params.len, stream),
+      eig_vectors(batch_size * params.len, stream),
+      eig_vectors_ref(params.len, stream),
+      eig_vals(batch_size * params.n_col, stream),
+      eig_vals_ref(params.n_col, stream)
+  {
+  }
+
+ protected:
+  void SetUp() override
+  {
+    T cov_matrix_h[] = {
+      1.0, 0.9, 0.81, 0.729, 0.9, 1.0, 0.9, 0.81, 0.81, 0.9, 1.0, 0.9, 0.729, 0.81, 0.9, 1.0};
+    ASSERT(params.len == 16, "This test only works with 4x4 matrices!");
+    for (int b = 0; b < batch_size; b++) {
+      raft::update_device(cov_matrices.data() + b * params.len, cov_matrix_h, params.len, stream);
+    }
+
+    T eig_vectors_ref_h[] = {0.2790,
+                             -0.6498,
+                             0.6498,
+                             -0.2789,
+                             -0.5123,
+                             0.4874,
+                             0.4874,
+                             -0.5123,
+                             0.6498,
+                             0.2789,
+                             -0.2789,
+                             -0.6498,
+                             0.4874,
+                             0.5123,
+                             0.5123,
+                             0.4874};
+    T eig_vals_ref_h[]    = {0.0614, 0.1024, 0.3096, 3.5266};
+
+    raft::update_device(eig_vectors_ref.data(), eig_vectors_ref_h, params.len, stream);
+    raft::update_device(eig_vals_ref.data(), eig_vals_ref_h, params.n_col, stream);
+
+    eig_batched(handle,
+                cov_matrices.data(),
+                params.n_row,
+                batch_size,
+                eig_vectors.data(),
+                eig_vals.data(),
+                stream);
+
+    handle.sync_stream(stream);
+  }
+
+ protected:
+  raft::handle_t handle;
+  cudaStream_t stream;
+
+  EigInputs<T> params;
+  int batch_size = 10;
+
+  rmm::device_uvector<T> cov_matrices, eig_vectors, eig_vectors_ref, eig_vals, eig_vals_ref;
+};
+
+typedef EigBatchedTest<float> EigBatchedTestF;
+TEST_P(EigBatchedTestF, Result)
+{
+  for (int b = 0; b < batch_size; b++) {
+    ASSERT_TRUE(raft::devArrMatch(eig_vals_ref.data(),
+                                  eig_vals.data() + b * params.n_col,
+                                  params.n_col,
+                                  raft::CompareApproxAbs<float>(params.tolerance),
+                                  stream));
+    ASSERT_TRUE(raft::devArrMatch(eig_vectors_ref.data(),
+                                  eig_vectors.data() + b * params.len,
+                                  params.len,
+                                  raft::CompareApproxAbs<float>(params.tolerance),
+                                  stream));
+  }
+}
+
+typedef EigBatchedTest<double> EigBatchedTestD;
+TEST_P(EigBatchedTestD, Result)
+{
+  for (int b = 0; b < batch_size; b++) {
+    ASSERT_TRUE(raft::devArrMatch(eig_vals_ref.data(),
+                                  eig_vals.data() + b * params.n_col,
+                                  params.n_col,
+                                  raft::CompareApproxAbs<double>(params.tolerance),
+                                  stream));
+    ASSERT_TRUE(raft::devArrMatch(eig_vectors_ref.data(),
+                                  eig_vectors.data() + b * params.len,
+                                  params.len,
+                                  raft::CompareApproxAbs<double>(params.tolerance),
+                                  stream));
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(EigTests, EigBatchedTestF, ::testing::ValuesIn(inputsf2));
+
+INSTANTIATE_TEST_SUITE_P(EigTests, EigBatchedTestD, ::testing::ValuesIn(inputsd2));
+
 }  // namespace linalg
 }  // namespace raft
@@ -164,5 +164,117 @@ INSTANTIATE_TEST_SUITE_P(GemvTests, GemvTestF, ::testing::ValuesIn(inputsf));
 
 INSTANTIATE_TEST_SUITE_P(GemvTests, GemvTestD, ::testing::ValuesIn(inputsd));
 
+template <typename T>
+struct GemvBatchedInputs {
+  int n_rows;
+  int n_cols;
+  int batch_count;
+  bool trans_a;
+  unsigned long long int seed;
+};
+
+template <typename T>
+class GemvBatchedTest : public ::testing::TestWithParam<GemvBatchedInputs<T>> {
+ protected:
+  GemvBatchedInputs<T> params;
+  rmm::device_uvector<T> refy;  // Reference result for comparison
+  rmm::device_uvector<T> y;     // Computed result
+  size_t yElems{};
+
+ public:
+  GemvBatchedTest()
+    : testing::TestWithParam<GemvBatchedInputs<T>>(),
+      refy(0, rmm::cuda_stream_default),
+      y(0, rmm::cuda_stream_default)
+  {
+    rmm::cuda_stream_default.synchronize();
+  }
+
+ protected:
+  void SetUp() override
+  {
+    params = ::testing::TestWithParam<GemvBatchedInputs<T>>::GetParam();
+
+    raft::handle_t handle;
+    cudaStream_t stream = handle.get_stream();
+
+    raft::random::RngState r(params.seed);
+
+    size_t strideA = size_t(params.n_rows) * params.n_cols;
+    size_t strideX = params.trans_a ? params.n_rows : params.n_cols;
+    size_t strideY = params.trans_a ? params.n_cols : params.n_rows;
+    yElems         = strideY * params.batch_count;
+
+    rmm::device_uvector<T> A(strideA * params.batch_count, stream);
+    rmm::device_uvector<T> x(strideX * params.batch_count, stream);
+    refy.resize(yElems, stream);
+    y.resize(yElems, stream);
+
+    uniform(handle, r, x.data(), x.size(), T(-10.0), T(10.0));
+    uniform(handle, r, A.data(), A.size(), T(-10.0), T(10.0));
+
+    // Reference: one scalar gemv per batch member
+    for (int i = 0; i < params.batch_count; i++) {
+      gemv(handle,
+           A.data() + i * strideA,
+           params.n_rows,
+           params.n_cols,
+           params.n_rows,
+           x.data() + i * strideX,
+           refy.data() + i * strideY,
+           params.trans_a,
+           stream);
+    }
+
+    gemv_batched(handle,
+                 A.data(),
+                 params.n_rows,
+                 params.n_cols,
+                 int64_t(strideA),
+                 x.data(),
+                 int64_t(strideX),
+                 y.data(),
+                 int64_t(strideY),
+                 params.trans_a,
+                 T(1),
+                 T(0),
+                 params.batch_count,
+                 stream);
+    handle.sync_stream();
+  }
+
+  void TearDown() override {}
+};
+
+const std::vector<GemvBatchedInputs<float>> inputsf_batched = {{16, 16, 33, false, 4720ULL},
+                                                               {16, 16, 33, true, 4721ULL},
+                                                               {60, 12, 100, false, 4722ULL},
+                                                               {12, 60, 100, true, 4723ULL},
+                                                               {128, 32, 7, false, 4724ULL}};
+
+const std::vector<GemvBatchedInputs<double>> inputsd_batched = {{16, 16, 33, false, 5720ULL},
+                                                                {16, 16, 33, true, 5721ULL},
+                                                                {60, 12, 100, false, 5722ULL},
+                                                                {12, 60, 100, true, 5723ULL},
+                                                                {128, 32, 7, true, 5724ULL}};
+
+typedef GemvBatchedTest<float> GemvBatchedTestF;
+TEST_P(GemvBatchedTestF, Result)
+{
+  ASSERT_TRUE(
+    raft::devArrMatch(refy.data(), y.data(), yElems, raft::CompareApprox<float>(1e-4)));
+}
+
+typedef GemvBatchedTest<double> GemvBatchedTestD;
+TEST_P(GemvBatchedTestD, Result)
+{
+  ASSERT_TRUE(
+    raft::devArrMatch(refy.data(), y.data(), yElems, raft::CompareApprox<double>(1e-6)));
+}
+
+INSTANTIATE_TEST_SUITE_P(GemvBatchedTests, GemvBatchedTestF, ::testing::ValuesIn(inputsf_batched));
+
+INSTANTIATE_TEST_SUITE_P(GemvBatchedTests, GemvBatchedTestD, ::testing::ValuesIn(inputsd_batched));
+
 }  // end namespace linalg
 }  // end namespace raft
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils.h"
+#include <gtest/gtest.h>
+#include <raft/cudart_utils.h>
+#include <raft/linalg/lazy_eltwise.cuh>
+#include <raft/random/rng.cuh>
+
+#include <cmath>
+#include <vector>
+
+namespace raft {
+namespace linalg {
+
+template <typename T>
+struct LazyEltwiseInputs {
+  T tolerance;
+  size_t len;
+  unsigned long long int seed;
+};
+
+template <typename T>
+class LazyEltwiseTest : public ::testing::TestWithParam<LazyEltwiseInputs<T>> {
+ public:
+  LazyEltwiseTest()
+    : params(::testing::TestWithParam<LazyEltwiseInputs<T>>::GetParam()),
+      stream(handle.get_stream()),
+      a(params.len, stream),
+      b(params.len, stream),
+      c(params.len, stream),
+      out(params.len, stream),
+      ref(params.len, stream)
+  {
+  }
+
+ protected:
+  void SetUp() override
+  {
+    auto len = params.len;
+    raft::random::RngState r(params.seed);
+    uniform(handle, r, a.data(), len, T(-1.0), T(1.0));
+    uniform(handle, r, b.data(), len, T(-1.0), T(1.0));
+    uniform(handle, r, c.data(), len, T(0.5), T(2.0));
+
+    std::vector<T> h_a(len), h_b(len), h_c(len), h_ref(len);
+    raft::update_host(h_a.data(), a.data(), len, stream);
+    raft::update_host(h_b.data(), b.data(), len, stream);
+    raft::update_host(h_c.data(), c.data(), len, stream);
+    RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+
+    // the full chain: multiply, add, divide, abs, power, sqrt in one pass
+    for (size_t i = 0; i < len; i++) {
+      T v      = std::abs((h_a[i] * h_b[i] + T(1.5)) / h_c[i]);
+      h_ref[i] = std::sqrt(std::pow(v, T(2.0)) + h_c[i]);
+    }
+    raft::update_device(ref.data(), h_ref.data(), len, stream);
+
+    auto v = lazy_abs((lazy(a.data()) * lazy(b.data()) + T(1.5)) / lazy(c.data()));
+    lazy_eval(out.data(), len, lazy_sqrt(lazy_power(v, T(2.0)) + lazy(c.data())), stream);
+    RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+  }
+
+ protected:
+  raft::handle_t handle;
+  cudaStream_t stream;
+
+  LazyEltwiseInputs<T> params;
+  rmm::device_uvector<T> a, b, c, out, ref;
+};
+
+const std::vector<LazyEltwiseInputs<float>> inputsf = {{0.0001f, 1024 * 1024, 1234ULL},
+                                                       {0.0001f, 1024 * 1024 + 17, 1234ULL},
+                                                       {0.0001f, 1027, 1234ULL}};
+
+const std::vector<LazyEltwiseInputs<double>> inputsd = {{1e-8, 1024 * 1024, 1234ULL},
+                                                        {1e-8, 1027, 1234ULL}};
+
+typedef LazyEltwiseTest<float> LazyEltwiseTestF;
+TEST_P(LazyEltwiseTestF, Result)
+{
+  ASSERT_TRUE(
+    devArrMatch(ref.data(), out.data(), params.len, CompareApprox<float>(params.tolerance)));
+}
+
+typedef LazyEltwiseTest<double> LazyEltwiseTestD;
+TEST_P(LazyEltwiseTestD, Result)
+{
+  ASSERT_TRUE(
+    devArrMatch(ref.data(), out.data(), params.len, CompareApprox<double>(params.tolerance)));
+}
+
+INSTANTIATE_TEST_SUITE_P(LazyEltwiseTests, LazyEltwiseTestF, ::testing::ValuesIn(inputsf));
+INSTANTIATE_TEST_SUITE_P(LazyEltwiseTests, LazyEltwiseTestD, ::testing::ValuesIn(inputsd));
+
+}  // namespace linalg
+}  // namespace raft
@@ -165,6 +165,36 @@ class MapGenericReduceTest : public ::testing::Test {
     EXPECT_TRUE(raft::devArrMatch(
       OutType(5), output.data(), 1, raft::Compare<OutType>(), handle.get_stream()));
   }
+  void testMulti()
+  {
+    auto op = [] __device__(InType in) { return in; };
+
+    rmm::device_scalar<OutType> out_min(handle.get_stream());
+    rmm::device_scalar<OutType> out_max(handle.get_stream());
+    rmm::device_scalar<OutType> out_sum(handle.get_stream());
+    rmm::device_scalar<OutType> out_sum_ref(handle.get_stream());
+
+    mapThenSumReduce(out_sum_ref.data(), input.size(), op, handle.get_stream(), input.data());
+
+    // min, max and sum of the same buffer in a single pass
+    mapThenReduceMulti(
+      input.size(),
+      handle.get_stream(),
+      input.data(),
+      makeMapReduceOp(out_min.data(), OutType(std::numeric_limits<InType>::max()), op, cub::Min()),
+      makeMapReduceOp(out_max.data(), OutType(std::numeric_limits<InType>::min()), op, cub::Max()),
+      makeMapReduceOp(out_sum.data(), OutType(0), op, raft::Sum<OutType>()));
+
+    EXPECT_TRUE(raft::devArrMatch(
+      OutType(1), out_min.data(), 1, raft::Compare<OutType>(), handle.get_stream()));
+    EXPECT_TRUE(raft::devArrMatch(
+      OutType(5), out_max.data(), 1, raft::Compare<OutType>(), handle.get_stream()));
+    EXPECT_TRUE(raft::devArrMatch(out_sum_ref.data(),
+                                  out_sum.data(),
+                                  1,
+                                  raft::CompareApprox<OutType>(0.0001),
+                                  handle.get_stream()));
+  }
 
  protected:
   raft::handle_t handle;
@@ -181,5 +211,6 @@ using IoTypePair =
 TYPED_TEST_CASE(MapGenericReduceTest, IoTypePair);
 TYPED_TEST(MapGenericReduceTest, min) { this->testMin(); }
 TYPED_TEST(MapGenericReduceTest, max) { this->testMax(); }
+TYPED_TEST(MapGenericReduceTest, multi) { this->testMulti(); }
 }  // end namespace linalg
 }  // end namespace raft
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils.h"
+#include <gtest/gtest.h>
+#include <raft/cudart_utils.h>
+#include <raft/linalg/persistent_op.cuh>
+#include <rmm/device_uvector.hpp>
+
+#include <vector>
+
+namespace raft {
+namespace linalg {
+
+struct add_op {
+  __device__ float operator()(float a, float b) const { return a + b; }
+};
+
+TEST(PersistentOp, ManySmallBinaryOps)
+{
+  raft::handle_t handle;
+  auto stream = handle.get_stream();
+
+  constexpr int chunk  = 2048;
+  constexpr int n_ops  = 500;  // more ops than the ring capacity below
+  constexpr size_t len = size_t(chunk) * n_ops;
+
+  std::vector<float> h_in1(len), h_in2(len);
+  for (size_t i = 0; i < len; i++) {
+    h_in1[i] = float(i % 1024);
+    h_in2[i] = float(i % 512);
+  }
+  rmm::device_uvector<float> in1(len, stream), in2(len, stream), out(len, stream);
+  raft::update_device(in1.data(), h_in1.data(), len, stream);
+  raft::update_device(in2.data(), h_in2.data(), len, stream);
+  handle.sync_stream();
+
+  {
+    persistent_binary_op<float, add_op> batch(handle, add_op{}, 128);
+    for (int i = 0; i < n_ops; i++) {
+      size_t offset = size_t(i) * chunk;
+      batch.enqueue(out.data() + offset, in1.data() + offset, in2.data() + offset, chunk);
+    }
+    batch.drain();
+    ASSERT_EQ(n_ops, int(batch.submitted()));
+    // the kernel exits when the object goes out of scope, releasing the stream
+  }
+
+  std::vector<float> h_out(len);
+  raft::update_host(h_out.data(), out.data(), len, stream);
+  handle.sync_stream();
+  for (size_t i = 0; i < len; i++) {
+    ASSERT_EQ(h_in1[i] + h_in2[i], h_out[i]) << "at index " << i;
+  }
+}
+
+TEST(PersistentOp, EmptyAndZeroLength)
+{
+  raft::handle_t handle;
+  rmm::device_uvector<float> buf(16, handle.get_stream());
+  persistent_binary_op<float, add_op> batch(handle, add_op{});
+  batch.enqueue(buf.data(), buf.data(), buf.data(), 0);  // silently skipped
+  ASSERT_EQ(0, int(batch.submitted()));
+  batch.drain();  // no-op when nothing was enqueued
+}
+
+}  // namespace linalg
+}  // namespace raft
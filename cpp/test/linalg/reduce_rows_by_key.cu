@@ -258,5 +258,24 @@ INSTANTIATE_TEST_CASE_P(ReduceRowTests,
                         ReduceRowTestManyClusters,
                         ::testing::ValuesIn(inputsf_many_cluster));
 
+// ReduceRowTestPrivatized
+// 60000 Obs, 19 cols, 8192 clusters - key count beyond the shared-memory
+// block budget, exercising the privatized single-pass path with hot-key
+// staging
+const std::vector<ReduceRowsInputs<float>> inputsf_privatized = {
+  {0.0001f, 60000, 19, 8192, 1234ULL, false},
+  {0.0001f, 60000, 19, 8192, 1234ULL, true, 4.0}};
+typedef ReduceRowTest<float> ReduceRowTestPrivatized;
+TEST_P(ReduceRowTestPrivatized, Result)
+{
+  ASSERT_TRUE(raft::devArrMatch(out_ref.data(),
+                                out.data(),
+                                params.cols * params.nkeys,
+                                raft::CompareApprox<float>(params.tolerance)));
+}
+INSTANTIATE_TEST_CASE_P(ReduceRowTests,
+                        ReduceRowTestPrivatized,
+                        ::testing::ValuesIn(inputsf_privatized));
+
 }  // end namespace linalg
 }  // end namespace raft
@@ -331,5 +331,126 @@ INSTANTIATE_TEST_CASE_P(RsvdTests, RsvdTestSquareMatrixNormF, ::testing::ValuesI
 
 INSTANTIATE_TEST_CASE_P(RsvdTests, RsvdTestSquareMatrixNormD, ::testing::ValuesIn(inputs_dx));
 
+template <typename T>
+struct RsvdHostInputs {
+  T tolerance;
+  int n_row;
+  int n_col;
+  int k;
+  int panel_rows;
+  unsigned long long int seed;
+};
+
+template <typename T>
+::std::ostream& operator<<(::std::ostream& os, const RsvdHostInputs<T>& dims)
+{
+  return os;
+}
+
+template <typename T>
+class RsvdHostTest : public ::testing::TestWithParam<RsvdHostInputs<T>> {
+ protected:
+  RsvdHostTest() : S(0, stream), V(0, stream), S_ref(0, stream), U_ref(0, stream), V_ref(0, stream)
+  {
+  }
+
+  void SetUp() override
+  {
+    raft::handle_t handle;
+    stream = handle.get_stream();
+
+    params = ::testing::TestWithParam<RsvdHostInputs<T>>::GetParam();
+    raft::random::RngState r(params.seed);
+    int m = params.n_row, n = params.n_col, k = params.k;
+
+    rmm::device_uvector<T> A(m * n, stream);
+    normal(handle, r, A.data(), m * n, T(0), T(1));
+
+    A_host.resize(m * n);
+    U_host.resize(m * k);
+    raft::update_host(A_host.data(), A.data(), m * n, stream);
+
+    // in-core reference via the same Gram-based decomposition
+    S_ref.resize(n, stream);
+    U_ref.resize(m * n, stream);
+    V_ref.resize(n * n, stream);
+    svdEig(handle, A.data(), m, n, S_ref.data(), U_ref.data(), V_ref.data(), true, stream);
+
+    S.resize(k, stream);
+    V.resize(n * k, stream);
+    rsvdFixedRankHost(handle,
+                      A_host.data(),
+                      (std::size_t)m,
+                      (std::size_t)n,
+                      S.data(),
+                      U_host.data(),
+                      V.data(),
+                      (std::size_t)k,
+                      true,
+                      stream,
+                      (std::size_t)params.panel_rows);
+    handle.sync_stream(stream);
+  }
+
+ protected:
+  cudaStream_t stream = 0;
+  RsvdHostInputs<T> params;
+  std::vector<T> A_host, U_host;
+  rmm::device_uvector<T> S, V, S_ref, U_ref, V_ref;
+};
+
+const std::vector<RsvdHostInputs<float>> inputs_host_fx = {
+  {0.001f, 512, 32, 8, 100, 4321ULL},  // ragged last panel
+  {0.001f, 512, 32, 8, 128, 4321ULL},  // even panels
+  {0.001f, 512, 32, 8, 512, 4321ULL}   // single panel
+};
+
+const std::vector<RsvdHostInputs<double>> inputs_host_dx = {
+  {0.00001, 512, 32, 8, 100, 4321ULL},
+  {0.00001, 512, 32, 8, 128, 4321ULL},
+  {0.00001, 512, 32, 8, 512, 4321ULL}};
+
+typedef RsvdHostTest<float> RsvdHostTestF;
+TEST_P(RsvdHostTestF, Result)
+{
+  ASSERT_TRUE(devArrMatch(
+    S_ref.data(), S.data(), params.k, raft::CompareApprox<float>(params.tolerance), stream));
+  ASSERT_TRUE(devArrMatch(V_ref.data(),
+                          V.data(),
+                          params.n_col * params.k,
+                          raft::CompareApproxAbs<float>(params.tolerance),
+                          stream));
+  rmm::device_uvector<float> U(params.n_row * params.k, stream);
+  raft::update_device(U.data(), U_host.data(), U.size(), stream);
+  ASSERT_TRUE(devArrMatch(U_ref.data(),
+                          U.data(),
+                          params.n_row * params.k,
+                          raft::CompareApproxAbs<float>(params.tolerance),
+                          stream));
+}
+
+typedef RsvdHostTest<double> RsvdHostTestD;
+TEST_P(RsvdHostTestD, Result)
+{
+  ASSERT_TRUE(devArrMatch(
+    S_ref.data(), S.data(), params.k, raft::CompareApprox<double>(params.tolerance), stream));
+  ASSERT_TRUE(devArrMatch(V_ref.data(),
+                          V.data(),
+                          params.n_col * params.k,
+                          raft::CompareApproxAbs<double>(params.tolerance),
+                          stream));
+  rmm::device_uvector<double> U(params.n_row * params.k, stream);
+  raft::update_device(U.data(), U_host.data(), U.size(), stream);
+  ASSERT_TRUE(devArrMatch(U_ref.data(),
+                          U.data(),
+                          params.n_row * params.k,
+                          raft::CompareApproxAbs<double>(params.tolerance),
+                          stream));
+}
+
+INSTANTIATE_TEST_CASE_P(RsvdTests, RsvdHostTestF, ::testing::ValuesIn(inputs_host_fx));
+
+INSTANTIATE_TEST_CASE_P(RsvdTests, RsvdHostTestD, ::testing::ValuesIn(inputs_host_dx));
+
 }  // end namespace linalg
 }  // end namespace raft
@@ -20,6 +20,7 @@
 #include <raft/cudart_utils.h>
 #include <raft/linalg/svd.cuh>
 #include <raft/matrix/matrix.cuh>
+#include <raft/random/rng.cuh>
 
 namespace raft {
 namespace linalg {
@@ -159,6 +160,172 @@ TEST_P(SvdTestRightVecD, Result)
                                 raft::CompareApproxAbs<double>(params.tolerance)));
 }
 
+template <typename T>
+struct SvdPolarInputs {
+  T tolerance;
+  int n_row;
+  int n_col;
+  unsigned long long int seed;
+};
+
+// the polar/Newton path must reproduce the singular values of the QR solver
+// and yield singular vectors that reconstruct the input
+template <typename T>
+class SvdPolarTest : public ::testing::TestWithParam<SvdPolarInputs<T>> {
+ public:
+  SvdPolarTest()
+    : params(::testing::TestWithParam<SvdPolarInputs<T>>::GetParam()),
+      stream(handle.get_stream()),
+      data(params.n_row * params.n_col, stream),
+      data_qr(params.n_row * params.n_col, stream),
+      U(params.n_row * params.n_col, stream),
+      V(params.n_col * params.n_col, stream),
+      sing_vals(params.n_col, stream),
+      sing_vals_ref(params.n_col, stream)
+  {
+  }
+
+ protected:
+  void SetUp() override
+  {
+    int m = params.n_row, n = params.n_col;
+
+    raft::random::RngState r(params.seed);
+    uniform(handle, r, data.data(), m * n, T(-1.0), T(1.0));
+    raft::copy(data_qr.data(), data.data(), m * n, stream);
+
+    // svdQR overwrites its input, so the reference runs on the copy
+    rmm::device_uvector<T> U_qr(m * n, stream);
+    rmm::device_uvector<T> V_qr(n * n, stream);
+    svdQR(handle,
+          data_qr.data(),
+          m,
+          n,
+          sing_vals_ref.data(),
+          U_qr.data(),
+          V_qr.data(),
+          true,
+          true,
+          true,
+          stream);
+
+    svdPolar(handle, data.data(), m, n, sing_vals.data(), U.data(), V.data(), true, true, stream);
+    handle.sync_stream(stream);
+  }
+
+  bool reconstructs()
+  {
+    return evaluateSVDByL2Norm(handle,
+                               data.data(),
+                               U.data(),
+                               sing_vals.data(),
+                               V.data(),
+                               params.n_row,
+                               params.n_col,
+                               params.n_col,
+                               params.tolerance,
+                               stream);
+  }
+
+ protected:
+  raft::handle_t handle;
+  cudaStream_t stream;
+
+  SvdPolarInputs<T> params;
+  rmm::device_uvector<T> data, data_qr, U, V, sing_vals, sing_vals_ref;
+};
+
+const std::vector<SvdPolarInputs<float>> polar_inputsf = {{0.001f, 256, 64, 1234ULL},
+                                                          {0.001f, 100, 25, 1234ULL}};
+const std::vector<SvdPolarInputs<double>> polar_inputsd = {{1e-6, 256, 64, 1234ULL}};
+
+typedef SvdPolarTest<float> SvdPolarTestF;
+TEST_P(SvdPolarTestF, Result)
+{
+  ASSERT_TRUE(raft::devArrMatch(sing_vals_ref.data(),
+                                sing_vals.data(),
+                                params.n_col,
+                                raft::CompareApproxAbs<float>(params.tolerance)));
+  ASSERT_TRUE(reconstructs());
+}
+
+typedef SvdPolarTest<double> SvdPolarTestD;
+TEST_P(SvdPolarTestD, Result)
+{
+  ASSERT_TRUE(raft::devArrMatch(sing_vals_ref.data(),
+                                sing_vals.data(),
+                                params.n_col,
+                                raft::CompareApproxAbs<double>(params.tolerance)));
+  ASSERT_TRUE(reconstructs());
+}
+
+INSTANTIATE_TEST_SUITE_P(SvdTests, SvdPolarTestF, ::testing::ValuesIn(polar_inputsf));
+INSTANTIATE_TEST_SUITE_P(SvdTests, SvdPolarTestD, ::testing::ValuesIn(polar_inputsd));
+
+// each matrix of the batched Jacobi decomposition must match the per-matrix
+// QR singular values
+template <typename T>
+class SvdJacobiBatchedTest : public ::testing::Test {
+ protected:
+  void SetUp() override
+  {
+    constexpr int m = 16, n = 8, batch = 12;
+    auto stream = handle.get_stream();
+
+    rmm::device_uvector<T> data(m * n * batch, stream);
+    rmm::device_uvector<T> U(m * m * batch, stream);
+    rmm::device_uvector<T> V(n * n * batch, stream);
+    rmm::device_uvector<T> sing_vals(n * batch, stream);
+    rmm::device_uvector<T> sing_vals_ref(n * batch, stream);
+
+    raft::random::RngState r(42ULL);
+    uniform(handle, r, data.data(), m * n * batch, T(-1.0), T(1.0));
+
+    rmm::device_uvector<T> data_qr(m * n, stream);
+    rmm::device_uvector<T> U_qr(m * n, stream);
+    rmm::device_uvector<T> V_qr(n * n, stream);
+    for (int b = 0; b < batch; b++) {
+      raft::copy(data_qr.data(), data.data() + b * m * n, m * n, stream);
+      svdQR(handle,
+            data_qr.data(),
+            m,
+            n,
+            sing_vals_ref.data() + b * n,
+            U_qr.data(),
+            V_qr.data(),
+            true,
+            true,
+            true,
+            stream);
+    }
+
+    svdJacobiBatched(handle,
+                     data.data(),
+                     m,
+                     n,
+                     batch,
+                     sing_vals.data(),
+                     U.data(),
+                     V.data(),
+                     T(1.e-7),
+                     15,
+                     stream);
+    handle.sync_stream(stream);
+
+    match = raft::devArrMatch(
+      sing_vals_ref.data(), sing_vals.data(), n * batch, raft::CompareApproxAbs<T>(T(0.001)));
+  }
+
+  raft::handle_t handle;
+  bool match = false;
+};
+
+typedef SvdJacobiBatchedTest<float> SvdJacobiBatchedTestF;
+TEST_F(SvdJacobiBatchedTestF, Result) { ASSERT_TRUE(match); }
+
+typedef SvdJacobiBatchedTest<double> SvdJacobiBatchedTestD;
+TEST_F(SvdJacobiBatchedTestD, Result) { ASSERT_TRUE(match); }
+
 INSTANTIATE_TEST_SUITE_P(SvdTests, SvdTestValF, ::testing::ValuesIn(inputsf2));
 
 INSTANTIATE_TEST_SUITE_P(SvdTests, SvdTestValD, ::testing::ValuesIn(inputsd2));
@@ -24,6 +24,9 @@
 
 #include <rmm/device_uvector.hpp>
 
+#include <cstdlib>
+#include <vector>
+
 namespace raft {
 namespace linalg {
 
@@ -113,5 +116,92 @@ INSTANTIATE_TEST_SUITE_P(TransposeTests, TransposeTestValF, ::testing::ValuesIn(
 
 INSTANTIATE_TEST_SUITE_P(TransposeTests, TransposeTestValD, ::testing::ValuesIn(inputsd2));
 
+template <typename T>
+struct TransposeRectInputs {
+  int n_row;
+  int n_col;
+  unsigned long long int seed;
+};
+
+template <typename T>
+::std::ostream& operator<<(::std::ostream& os, const TransposeRectInputs<T>& dims)
+{
+  return os;
+}
+
+template <typename T>
+class TransposeRectTest : public ::testing::TestWithParam<TransposeRectInputs<T>> {
+ public:
+  TransposeRectTest()
+    : params(::testing::TestWithParam<TransposeRectInputs<T>>::GetParam()),
+      stream(handle.get_stream()),
+      data((size_t)params.n_row * params.n_col, stream),
+      data_trans_ref((size_t)params.n_row * params.n_col, stream),
+      data_trans((size_t)params.n_row * params.n_col, stream)
+  {
+  }
+
+ protected:
+  void SetUp() override
+  {
+    int m      = params.n_row;
+    int n      = params.n_col;
+    size_t len = (size_t)m * n;
+
+    std::vector<T> data_h(len);
+    std::vector<T> ref_h(len);
+    std::srand(params.seed);
+    for (size_t i = 0; i < len; i++) {
+      data_h[i] = (T)(std::rand() % 1000);
+    }
+    for (int c = 0; c < n; c++) {
+      for (int r = 0; r < m; r++) {
+        ref_h[(size_t)r * n + c] = data_h[(size_t)c * m + r];
+      }
+    }
+    raft::update_device(data.data(), data_h.data(), len, stream);
+    raft::update_device(data_trans_ref.data(), ref_h.data(), len, stream);
+
+    transpose(handle, data.data(), data_trans.data(), m, n, stream);
+    transpose(data.data(), m, n, stream);
+    handle.sync_stream(stream);
+  }
+
+ protected:
+  raft::handle_t handle;
+  cudaStream_t stream;
+
+  TransposeRectInputs<T> params;
+  rmm::device_uvector<T> data, data_trans, data_trans_ref;
+};
+
+const std::vector<TransposeRectInputs<float>> inputs_rect_f = {
+  {65, 37, 1234ULL}, {32, 64, 1234ULL}, {100, 100, 1234ULL}, {3, 129, 1234ULL}};
+
+const std::vector<TransposeRectInputs<double>> inputs_rect_d = {
+  {65, 37, 1234ULL}, {32, 64, 1234ULL}, {100, 100, 1234ULL}, {3, 129, 1234ULL}};
+
+typedef TransposeRectTest<float> TransposeRectTestF;
+TEST_P(TransposeRectTestF, Result)
+{
+  size_t len = (size_t)params.n_row * params.n_col;
+  ASSERT_TRUE(
+    raft::devArrMatch(data_trans_ref.data(), data_trans.data(), len, raft::Compare<float>()));
+  ASSERT_TRUE(raft::devArrMatch(data_trans_ref.data(), data.data(), len, raft::Compare<float>()));
+}
+
+typedef TransposeRectTest<double> TransposeRectTestD;
+TEST_P(TransposeRectTestD, Result)
+{
+  size_t len = (size_t)params.n_row * params.n_col;
+  ASSERT_TRUE(
+    raft::devArrMatch(data_trans_ref.data(), data_trans.data(), len, raft::Compare<double>()));
+  ASSERT_TRUE(raft::devArrMatch(data_trans_ref.data(), data.data(), len, raft::Compare<double>()));
+}
+
+INSTANTIATE_TEST_SUITE_P(TransposeTests, TransposeRectTestF, ::testing::ValuesIn(inputs_rect_f));
+
+INSTANTIATE_TEST_SUITE_P(TransposeTests, TransposeRectTestD, ::testing::ValuesIn(inputs_rect_d));
+
 }  // end namespace linalg
 }  // end namespace raft
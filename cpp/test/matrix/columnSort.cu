@@ -162,5 +162,87 @@ TEST_P(ColumnSortF, Result)
 
 INSTANTIATE_TEST_CASE_P(ColumnSortTests, ColumnSortF, ::testing::ValuesIn(inputsf1));
 
+template <typename T>
+class ColumnSortHandle : public ::testing::TestWithParam<columnSort<T>> {
+ protected:
+  ColumnSortHandle()
+    : stream(handle.get_stream()),
+      keyIn(0, stream),
+      keySorted(0, stream),
+      keySortGolden(0, stream),
+      valueOut(0, stream),
+      goldenValOut(0, stream)
+  {
+  }
+
+  void SetUp() override
+  {
+    params  = ::testing::TestWithParam<columnSort<T>>::GetParam();
+    int len = params.n_row * params.n_col;
+    keyIn.resize(len, stream);
+    valueOut.resize(len, stream);
+    goldenValOut.resize(len, stream);
+    if (params.testKeys) {
+      keySorted.resize(len, stream);
+      keySortGolden.resize(len, stream);
+    }
+
+    std::vector<T> vals(len);
+    std::vector<int> cValGolden(len);
+    std::iota(vals.begin(), vals.end(), 1.0f);
+    std::random_shuffle(vals.begin(), vals.end());
+
+    std::vector<T> cKeyGolden(len);
+
+    for (int i = 0; i < params.n_row; i++) {
+      std::vector<T> tmp(vals.begin() + i * params.n_col, vals.begin() + (i + 1) * params.n_col);
+      auto cpuOut = sort_indexes(tmp);
+      std::copy((*cpuOut).begin(), (*cpuOut).end(), cValGolden.begin() + i * params.n_col);
+      delete cpuOut;
+
+      if (params.testKeys) {
+        std::sort(tmp.begin(), tmp.end());
+        std::copy(tmp.begin(), tmp.end(), cKeyGolden.begin() + i * params.n_col);
+      }
+    }
+
+    raft::update_device(keyIn.data(), &vals[0], len, stream);
+    raft::update_device(goldenValOut.data(), &cValGolden[0], len, stream);
+
+    if (params.testKeys) raft::update_device(keySortGolden.data(), &cKeyGolden[0], len, stream);
+
+    // run twice: the second call reuses the workspace retained by the arena
+    sort_cols_per_row(
+      handle, keyIn.data(), valueOut.data(), params.n_row, params.n_col, keySorted.data());
+    sort_cols_per_row(
+      handle, keyIn.data(), valueOut.data(), params.n_row, params.n_col, keySorted.data());
+    handle.sync_stream();
+  }
+
+ protected:
+  raft::handle_t handle;
+  cudaStream_t stream;
+  columnSort<T> params;
+  rmm::device_uvector<T> keyIn, keySorted, keySortGolden;
+  rmm::device_uvector<int> valueOut, goldenValOut;  // valueOut are indexes
+};
+
+typedef ColumnSortHandle<float> ColumnSortHandleF;
+TEST_P(ColumnSortHandleF, Result)
+{
+  ASSERT_TRUE(devArrMatch(valueOut.data(),
+                          goldenValOut.data(),
+                          params.n_row * params.n_col,
+                          raft::CompareApprox<float>(params.tolerance)));
+  if (params.testKeys) {
+    ASSERT_TRUE(devArrMatch(keySorted.data(),
+                            keySortGolden.data(),
+                            params.n_row * params.n_col,
+                            raft::CompareApprox<float>(params.tolerance)));
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(ColumnSortTests, ColumnSortHandleF, ::testing::ValuesIn(inputsf1));
+
 }  // end namespace matrix
 }  // end namespace raft
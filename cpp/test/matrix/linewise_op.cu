@@ -16,8 +16,11 @@
 
 #include "../linalg/matrix_vector_op.cuh"
 #include "../test_utils.h"
+#include <cuda_bf16.h>
+#include <cuda_fp16.h>
 #include <cuda_profiler_api.h>
 #include <gtest/gtest.h>
+#include <vector>
 #include <raft/common/nvtx.hpp>
 #include <raft/cudart_utils.h>
 #include <raft/linalg/matrix_vector_op.cuh>
@@ -73,6 +76,26 @@ struct LinewiseTest : public ::testing::TestWithParam<typename ParamsReader::Par
     matrix::linewiseOp(out, in, lineLen, nLines, alongLines, f, stream, vec1, vec2);
   }
 
+  void runLinewiseChainSum(T* out,
+                           const T* in,
+                           const I lineLen,
+                           const I nLines,
+                           const bool alongLines,
+                           const T* vec1,
+                           const T* vec2)
+  {
+    auto f1 = [] __device__(T a, T b) -> T { return a + b; };
+    auto f2 = [] __device__(T a, T b) -> T { return a + b; };
+    matrix::linewiseOpChain(out,
+                            in,
+                            lineLen,
+                            nLines,
+                            alongLines,
+                            stream,
+                            matrix::makeLinewiseStage(f1, vec1),
+                            matrix::makeLinewiseStage(f2, vec2));
+  }
+
   rmm::device_uvector<T> genData(size_t workSizeBytes)
   {
     raft::random::RngState r(params.seed);
@@ -171,6 +194,18 @@ struct LinewiseTest : public ::testing::TestWithParam<typename ParamsReader::Par
                 << " with two vecs;  lineLen: " << lineLen << "; nLines " << nLines;
             if (!r) break;
           }
+          {
+            common::nvtx::range vecs_scope("chain of two stages");
+            runLinewiseChainSum(out, in, lineLen, nLines, alongRows, vec1, vec2);
+          }
+          if (params.checkCorrectness) {
+            linalg::naiveMatVec(
+              blob_val.data(), in, vec1, vec2, lineLen, nLines, true, alongRows, T(1), stream);
+            r = devArrMatch(blob_val.data(), out, n * m, CompareApprox<T>(params.tolerance))
+                << " " << (alongRows ? "alongRows" : "acrossRows")
+                << " with a chain of two stages;  lineLen: " << lineLen << "; nLines " << nLines;
+            if (!r) break;
+          }
         }
       }
     }
@@ -273,5 +308,46 @@ TEST_IT(run, Gigabyte, double, int);
 TEST_IT(run, TenGigs, float, uint64_t);
 TEST_IT(run, TenGigs, double, uint64_t);
 
+// 16-bit types ride the full 128-bit IO path (TxN_t<__half, 8> and
+// TxN_t<nv_bfloat16, 8>); arithmetic goes through float so the test compiles
+// for every supported arch.
+template <typename T>
+struct halfish_add_op {
+  __device__ T operator()(T a, T b) const { return T(float(a) + float(b)); }
+};
+
+template <typename T>
+void runLinewise16BitSum()
+{
+  raft::handle_t handle;
+  auto stream = handle.get_stream();
+  constexpr int lineLen = 256;  // 512 bytes per line: keeps every line 16B-aligned
+  constexpr int nLines  = 8;
+  constexpr int len     = lineLen * nLines;
+  std::vector<T> h_in(len), h_vec(lineLen);
+  for (int i = 0; i < len; i++) {
+    h_in[i] = T(float(i % 64));  // exactly representable in 16 bits
+  }
+  for (int i = 0; i < lineLen; i++) {
+    h_vec[i] = T(float(i % 32));
+  }
+  rmm::device_uvector<T> in(len, stream), vec(lineLen, stream), out(len, stream);
+  raft::update_device(in.data(), h_in.data(), len, stream);
+  raft::update_device(vec.data(), h_vec.data(), lineLen, stream);
+
+  matrix::linewiseOp(
+    out.data(), in.data(), lineLen, nLines, true, halfish_add_op<T>{}, stream, vec.data());
+
+  std::vector<T> h_out(len);
+  raft::update_host(h_out.data(), out.data(), len, stream);
+  handle.sync_stream();
+  for (int i = 0; i < len; i++) {
+    ASSERT_EQ(float(h_in[i]) + float(h_vec[i % lineLen]), float(h_out[i])) << "at index " << i;
+  }
+}
+
+TEST(LinewiseOp16Bit, Half) { runLinewise16BitSum<__half>(); }
+TEST(LinewiseOp16Bit, Bfloat16) { runLinewise16BitSum<nv_bfloat16>(); }
+
 }  // namespace matrix
 }  // end namespace raft
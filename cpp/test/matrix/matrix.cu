@@ -173,5 +173,76 @@ using TypeTuple = ::testing::Types<std::tuple<float, int, int>,
 
 TYPED_TEST_CASE(MatrixCopyRowsTest, TypeTuple);
 TYPED_TEST(MatrixCopyRowsTest, CopyRows) { this->testCopyRows(); }
+
+template <typename T>
+class MatrixGatherRowsTest : public ::testing::Test {
+  using in_t  = typename std::tuple_element<0, T>::type;
+  using out_t = typename std::tuple_element<1, T>::type;
+
+ protected:
+  MatrixGatherRowsTest()
+    : stream(handle.get_stream()),
+      input(n_cols * n_rows, stream),
+      indices(n_selected, stream),
+      output(n_cols * n_selected, stream)
+  {
+    raft::update_device(indices.data(), indices_host, n_selected, stream);
+    thrust::counting_iterator<int> first(0);
+    thrust::device_ptr<in_t> ptr(input.data());
+    thrust::copy(handle.get_thrust_policy(), first, first + n_cols * n_rows, ptr);
+  }
+
+  void testGatherTransform()
+  {
+    gatherRows(
+      output.data(),
+      input.data(),
+      n_cols,
+      indices.data(),
+      n_selected,
+      [] __device__(in_t v) { return out_t(2) * out_t(v); },
+      stream);
+    std::vector<out_t> exp(n_selected * n_cols);
+    for (int i = 0; i < n_selected; i++)
+      for (int k = 0; k < n_cols; k++)
+        exp[i * n_cols + k] = out_t(2) * out_t(indices_host[i] * n_cols + k);
+    EXPECT_TRUE(raft::devArrMatchHost(
+      exp.data(), output.data(), n_selected * n_cols, raft::Compare<out_t>(), stream));
+  }
+
+  void testGatherConvert()
+  {
+    gatherRows(output.data(), input.data(), n_cols, indices.data(), n_selected, stream);
+    std::vector<out_t> exp(n_selected * n_cols);
+    for (int i = 0; i < n_selected; i++)
+      for (int k = 0; k < n_cols; k++)
+        exp[i * n_cols + k] = out_t(indices_host[i] * n_cols + k);
+    EXPECT_TRUE(raft::devArrMatchHost(
+      exp.data(), output.data(), n_selected * n_cols, raft::Compare<out_t>(), stream));
+  }
+
+ protected:
+  raft::handle_t handle;
+  cudaStream_t stream;
+
+  // odd column count on purpose: exercises the non-vectorized path as well
+  int n_rows     = 10;
+  int n_cols     = 3;
+  int n_selected = 5;
+
+  int indices_host[5] = {0, 3, 4, 7, 9};
+  rmm::device_uvector<in_t> input;
+  rmm::device_uvector<out_t> output;
+  rmm::device_uvector<int> indices;
+};
+
+using GatherTypeTuple = ::testing::Types<std::tuple<float, float>,
+                                         std::tuple<float, double>,
+                                         std::tuple<double, double>,
+                                         std::tuple<int, float>>;
+
+TYPED_TEST_CASE(MatrixGatherRowsTest, GatherTypeTuple);
+TYPED_TEST(MatrixGatherRowsTest, GatherTransform) { this->testGatherTransform(); }
+TYPED_TEST(MatrixGatherRowsTest, GatherConvert) { this->testGatherConvert(); }
 }  // namespace matrix
 }  // namespace raft
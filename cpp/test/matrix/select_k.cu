@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils.h"
+
+#include <raft/matrix/select_k.cuh>
+#include <raft/random/rng.hpp>
+
+#include <rmm/device_uvector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+#include <vector>
+
+namespace raft {
+namespace matrix {
+
+struct SelectKInputs {
+  size_t batch_size;
+  size_t len;
+  int k;
+  bool select_min;
+};
+
+::std::ostream& operator<<(::std::ostream& os, const SelectKInputs& p)
+{
+  return os << "batch_size: " << p.batch_size << ", len: " << p.len << ", k: " << p.k
+            << ", select_min: " << p.select_min;
+}
+
+template <typename T>
+class SelectKTest : public ::testing::TestWithParam<SelectKInputs> {
+ protected:
+  void SetUp() override
+  {
+    auto params = ::testing::TestWithParam<SelectKInputs>::GetParam();
+    auto stream = handle.get_stream();
+
+    rmm::device_uvector<T> in(params.batch_size * params.len, stream);
+    rmm::device_uvector<T> out(params.batch_size * params.k, stream);
+    rmm::device_uvector<int> out_idx(params.batch_size * params.k, stream);
+
+    raft::random::Rng r(42);
+    r.uniform(in.data(), in.size(), T(-1.0), T(1.0), stream);
+
+    std::vector<T> h_in(in.size());
+    update_host(h_in.data(), in.data(), in.size(), stream);
+    handle.sync_stream();
+
+    select_k<T, int>(in.data(),
+                     nullptr,
+                     params.batch_size,
+                     params.len,
+                     params.k,
+                     out.data(),
+                     out_idx.data(),
+                     params.select_min,
+                     stream);
+
+    std::vector<T> h_out(out.size());
+    update_host(h_out.data(), out.data(), out.size(), stream);
+    handle.sync_stream();
+
+    // compare the selected set (sorted) against a CPU reference per row
+    for (size_t i = 0; i < params.batch_size; i++) {
+      std::vector<T> row(h_in.begin() + i * params.len, h_in.begin() + (i + 1) * params.len);
+      if (params.select_min) {
+        std::sort(row.begin(), row.end());
+      } else {
+        std::sort(row.begin(), row.end(), std::greater<T>());
+      }
+      std::vector<T> selected(h_out.begin() + i * params.k, h_out.begin() + (i + 1) * params.k);
+      if (params.select_min) {
+        std::sort(selected.begin(), selected.end());
+      } else {
+        std::sort(selected.begin(), selected.end(), std::greater<T>());
+      }
+      for (int j = 0; j < params.k; j++) {
+        ASSERT_EQ(row[j], selected[j]) << "batch " << i << ", position " << j;
+      }
+    }
+  }
+
+  raft::handle_t handle;
+};
+
+// shapes chosen to exercise all dispatch branches: faiss (tiny batch, short
+// rows), warpsort (small k / short rows) and radix (long rows, large k)
+const std::vector<SelectKInputs> inputs = {{4, 1024, 8, true},
+                                           {4, 1024, 8, false},
+                                           {100, 10000, 16, true},
+                                           {100, 100000, 64, true},
+                                           {10, 100000, 200, true},
+                                           {10, 100000, 512, false}};
+
+using SelectKTestF = SelectKTest<float>;
+TEST_P(SelectKTestF, Result) {}
+
+INSTANTIATE_TEST_CASE_P(SelectKTests, SelectKTestF, ::testing::ValuesIn(inputs));
+
+TEST(SelectKAutoTune, MeasuresAndCaches)
+{
+  raft::handle_t handle;
+  auto stream = handle.get_stream();
+
+  const size_t batch_size = 10;
+  const size_t len        = 5000;
+  const int k             = 32;
+
+  rmm::device_uvector<float> in(batch_size * len, stream);
+  rmm::device_uvector<float> out(batch_size * k, stream);
+  rmm::device_uvector<int> out_idx(batch_size * k, stream);
+  raft::random::Rng r(137);
+  r.uniform(in.data(), in.size(), -1.0f, 1.0f, stream);
+
+  std::vector<float> h_in(in.size());
+  update_host(h_in.data(), in.data(), in.size(), stream);
+  handle.sync_stream();
+
+  // first call measures the candidates; the table must know the class after
+  select_k_auto<float, int>(
+    in.data(), nullptr, batch_size, len, k, out.data(), out_idx.data(), true, stream);
+  auto cls = detail::select_k_tuner::classify(batch_size, len, k);
+  detail::select_k_algo algo;
+  ASSERT_TRUE(detail::select_k_tuner::instance().lookup(cls, &algo));
+
+  // the cached dispatch must produce the correct selection
+  select_k_auto<float, int>(
+    in.data(), nullptr, batch_size, len, k, out.data(), out_idx.data(), true, stream);
+  std::vector<float> h_out(out.size());
+  update_host(h_out.data(), out.data(), out.size(), stream);
+  handle.sync_stream();
+  for (size_t i = 0; i < batch_size; i++) {
+    std::vector<float> selected(h_in.begin() + i * len, h_in.begin() + (i + 1) * len);
+    std::partial_sort(selected.begin(), selected.begin() + k, selected.end());
+    std::vector<float> row(h_out.begin() + i * k, h_out.begin() + (i + 1) * k);
+    std::sort(row.begin(), row.end());
+    for (int j = 0; j < k; j++) {
+      ASSERT_EQ(row[j], selected[j]) << "batch " << i << ", position " << j;
+    }
+  }
+}
+
+TEST(SelectKAutoTune, CacheFileRoundTrip)
+{
+  // write an entry through the cache file, then read it back
+  auto path = std::string("select_k_tuning_test.txt");
+  std::remove(path.c_str());
+
+  select_k_set_tuning_cache(path);
+  auto cls = detail::select_k_tuner::shape_class{0, 64, 8192, 64};
+  detail::select_k_tuner::instance().record(cls, detail::select_k_algo::WARP_SORT);
+
+  // re-loading the same file must yield the recorded entry
+  select_k_set_tuning_cache(path);
+  detail::select_k_algo algo;
+  ASSERT_TRUE(detail::select_k_tuner::instance().lookup(cls, &algo));
+  ASSERT_EQ(algo, detail::select_k_algo::WARP_SORT);
+  std::remove(path.c_str());
+}
+
+}  // namespace matrix
+}  // namespace raft
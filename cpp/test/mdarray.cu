@@ -381,10 +381,39 @@ void test_factory_methods()
     ASSERT_EQ(view(0), 17.0);
   }
 }
+
+void test_pinned_managed_factory_methods()
+{
+  // pinned host matrix: host-accessible, registered with the driver
+  {
+    auto pinned = make_pinned_matrix<float>(2, 2);
+    static_assert(pinned.rank() == 2);
+    pinned(0, 0) = 17.0;
+    ASSERT_EQ(pinned(0, 0), 17.0);
+
+    cudaPointerAttributes attr;
+    RAFT_CUDA_TRY(cudaPointerGetAttributes(&attr, pinned.data()));
+    ASSERT_EQ(attr.type, cudaMemoryTypeHost);
+  }
+  // managed vector: usable from both host and device code paths
+  {
+    raft::handle_t handle{};
+    auto managed = make_managed_vector<float>(16, handle.get_stream());
+    static_assert(managed.rank() == 1);
+    thrust::sequence(handle.get_thrust_policy(), managed.data(), managed.data() + managed.size());
+    handle.sync_stream();
+
+    cudaPointerAttributes attr;
+    RAFT_CUDA_TRY(cudaPointerGetAttributes(&attr, managed.data()));
+    ASSERT_EQ(attr.type, cudaMemoryTypeManaged);
+  }
+}
 }  // anonymous namespace
 
 TEST(MDArray, Factory) { test_factory_methods(); }
 
+TEST(MDArray, PinnedManagedFactory) { test_pinned_managed_factory_methods(); }
+
 namespace {
 template <typename T, typename LayoutPolicy>
 void check_matrix_layout(device_matrix_view<T, LayoutPolicy> in)
@@ -513,4 +542,36 @@ void test_mdarray_unravel()
 }  // anonymous namespace
 
 TEST(MDArray, Unravel) { test_mdarray_unravel(); }
+
+namespace {
+void test_reinterpret_view()
+{
+  // host: pairs of 32-bit values viewed as one 64-bit value each
+  auto h = make_host_vector<uint32_t>(8);
+  for (size_t i = 0; i < h.size(); ++i) {
+    h(i) = uint32_t(i);
+  }
+  auto h64 = reinterpret_view<uint64_t>(h);
+  ASSERT_EQ(h64.extent(0), 4ul);
+  ASSERT_EQ(static_cast<void*>(h64.data()), static_cast<void*>(h.data()));
+
+  // device: flat and shaped views share the buffer, no copy involved
+  handle_t handle;
+  auto d    = make_device_matrix<float>(handle, 4, 6);
+  auto flat = reinterpret_view<float2>(d);
+  ASSERT_EQ(flat.extent(0), 12ul);
+  ASSERT_EQ(static_cast<void*>(flat.data()), static_cast<void*>(d.data()));
+  auto shaped = reinterpret_view<float2>(d, 4, 3);
+  ASSERT_EQ(shaped.extent(0), 4ul);
+  ASSERT_EQ(shaped.extent(1), 3ul);
+
+  // size validation: 3 floats do not make a whole number of doubles,
+  // and a 4x3 float2 matrix does not fit into fewer bytes than it needs
+  auto odd = make_host_vector<float>(3);
+  ASSERT_THROW(reinterpret_view<double>(odd), raft::exception);
+  ASSERT_THROW(reinterpret_view<float2>(d, 5, 3), raft::exception);
+}
+}  // anonymous namespace
+
+TEST(MDArray, ReinterpretView) { test_reinterpret_view(); }
 }  // namespace raft
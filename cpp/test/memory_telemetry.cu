@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <raft/handle.hpp>
+
+#include <rmm/device_uvector.hpp>
+
+namespace raft {
+
+TEST(MemoryTelemetry, ScopedAttribution)
+{
+  handle_t handle;
+  auto stream = handle.get_stream();
+
+  handle.enable_memory_telemetry();
+  auto* telemetry = handle.get_memory_telemetry();
+  ASSERT_NE(nullptr, telemetry);
+
+  {
+    memory_scope scope("stage_a");
+    rmm::device_uvector<float> buf(1024, stream);
+
+    auto stats = telemetry->get_stats("stage_a");
+    EXPECT_EQ(stats.current_bytes, 1024 * sizeof(float));
+    EXPECT_EQ(stats.peak_bytes, 1024 * sizeof(float));
+    EXPECT_EQ(stats.n_allocations, 1u);
+  }
+
+  // current drops with the buffer, the peak is retained
+  auto stats = telemetry->get_stats("stage_a");
+  EXPECT_EQ(stats.current_bytes, 0u);
+  EXPECT_EQ(stats.peak_bytes, 1024 * sizeof(float));
+
+  {
+    memory_scope scope("stage_b");
+    rmm::device_uvector<float> buf(2048, stream);
+  }
+  EXPECT_EQ(telemetry->get_stats("stage_b").peak_bytes, 2048 * sizeof(float));
+
+  // the grand total spans both scopes
+  EXPECT_GE(telemetry->get_stats("*").peak_bytes, 2048 * sizeof(float));
+  EXPECT_EQ(telemetry->get_all_stats().count("stage_a"), 1u);
+
+  handle.disable_memory_telemetry();
+  EXPECT_EQ(nullptr, handle.get_memory_telemetry());
+}
+
+TEST(MemoryTelemetry, NestingAndUnscoped)
+{
+  handle_t handle;
+  auto stream = handle.get_stream();
+
+  handle.enable_memory_telemetry();
+  auto* telemetry = handle.get_memory_telemetry();
+
+  // allocations outside any scope land under ""
+  { rmm::device_uvector<char> buf(256, stream); }
+  EXPECT_EQ(telemetry->get_stats("").peak_bytes, 256u);
+
+  // nested scopes attribute to the innermost name
+  {
+    memory_scope outer("outer");
+    memory_scope inner("inner");
+    rmm::device_uvector<char> buf(512, stream);
+  }
+  EXPECT_EQ(telemetry->get_stats("inner").peak_bytes, 512u);
+  EXPECT_EQ(telemetry->get_stats("outer").peak_bytes, 0u);
+
+  handle.disable_memory_telemetry();
+}
+
+}  // namespace raft
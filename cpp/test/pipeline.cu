@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test_utils.h"
+#include <gtest/gtest.h>
+#include <raft/core/pipeline.hpp>
+#include <raft/cudart_utils.h>
+#include <raft/handle.hpp>
+#include <raft/linalg/binary_op.cuh>
+#include <raft/linalg/unary_op.cuh>
+
+#include <rmm/cuda_stream_pool.hpp>
+#include <rmm/device_uvector.hpp>
+
+namespace raft {
+
+TEST(PipelineTest, Chain)
+{
+  handle_t handle(rmm::cuda_stream_per_thread, std::make_shared<rmm::cuda_stream_pool>(4));
+  auto stream = handle.get_stream();
+
+  constexpr int n = 1024;
+  rmm::device_uvector<float> x(n, stream);
+
+  pipeline p(handle);
+  auto fill = p.add_stage([&](rmm::cuda_stream_view s) {
+    linalg::unaryOp(
+      x.data(), x.data(), n, [] __device__(float) { return 1.0f; }, s.value());
+  });
+  auto add = p.add_stage(
+    [&](rmm::cuda_stream_view s) {
+      linalg::unaryOp(
+        x.data(), x.data(), n, [] __device__(float v) { return v + 1.0f; }, s.value());
+    },
+    {fill});
+  p.add_stage(
+    [&](rmm::cuda_stream_view s) {
+      linalg::unaryOp(
+        x.data(), x.data(), n, [] __device__(float v) { return v * 2.0f; }, s.value());
+    },
+    {add});
+  p.wait();
+
+  rmm::device_uvector<float> expected(n, stream);
+  linalg::unaryOp(
+    expected.data(), expected.data(), n, [] __device__(float) { return 4.0f; }, stream);
+  ASSERT_TRUE(devArrMatch<float>(expected.data(), x.data(), n, Compare<float>(), stream));
+}
+
+TEST(PipelineTest, Diamond)
+{
+  handle_t handle(rmm::cuda_stream_per_thread, std::make_shared<rmm::cuda_stream_pool>(4));
+  auto stream = handle.get_stream();
+
+  constexpr int n = 1024;
+  rmm::device_uvector<float> x(n, stream);
+  rmm::device_uvector<float> y(n, stream);
+  rmm::device_uvector<float> z(n, stream);
+
+  pipeline p(handle);
+  // two independent producers overlap on different pool streams
+  auto fx = p.add_stage([&](rmm::cuda_stream_view s) {
+    linalg::unaryOp(
+      x.data(), x.data(), n, [] __device__(float) { return 1.0f; }, s.value());
+  });
+  auto fy = p.add_stage([&](rmm::cuda_stream_view s) {
+    linalg::unaryOp(
+      y.data(), y.data(), n, [] __device__(float) { return 2.0f; }, s.value());
+  });
+  p.add_stage(
+    [&](rmm::cuda_stream_view s) {
+      linalg::binaryOp(
+        z.data(),
+        x.data(),
+        y.data(),
+        n,
+        [] __device__(float a, float b) { return a + b; },
+        s.value());
+    },
+    {fx, fy});
+  p.wait();
+
+  rmm::device_uvector<float> expected(n, stream);
+  linalg::unaryOp(
+    expected.data(), expected.data(), n, [] __device__(float) { return 3.0f; }, stream);
+  ASSERT_TRUE(devArrMatch<float>(expected.data(), z.data(), n, Compare<float>(), stream));
+}
+
+TEST(PipelineTest, NoStreamPoolFallback)
+{
+  // without a pool every stage runs on the main stream
+  handle_t handle;
+  auto stream = handle.get_stream();
+
+  constexpr int n = 256;
+  rmm::device_uvector<int> x(n, stream);
+  RAFT_CUDA_TRY(cudaMemsetAsync(x.data(), 0, n * sizeof(int), stream));
+
+  pipeline p(handle);
+  auto inc = p.add_stage([&](rmm::cuda_stream_view s) {
+    linalg::unaryOp(
+      x.data(), x.data(), n, [] __device__(int v) { return v + 1; }, s.value());
+  });
+  p.add_stage(
+    [&](rmm::cuda_stream_view s) {
+      linalg::unaryOp(
+        x.data(), x.data(), n, [] __device__(int v) { return v * 3; }, s.value());
+    },
+    {inc});
+  p.wait();
+
+  rmm::device_uvector<int> expected(n, stream);
+  linalg::unaryOp(
+    expected.data(), expected.data(), n, [] __device__(int) { return 3; }, stream);
+  ASSERT_TRUE(devArrMatch<int>(expected.data(), x.data(), n, Compare<int>(), stream));
+}
+
+}  // namespace raft
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <raft/core/handle.hpp>
+#include <raft/core/profiler.hpp>
+#include <rmm/device_uvector.hpp>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace raft {
+
+namespace {
+
+__global__ void spin_kernel(const int* in, int* out, int n)
+{
+  int acc = 0;
+  for (int i = 0; i < n; i++) {
+    acc += in[i];
+  }
+  *out = acc;
+}
+
+struct recording_observer : public profiler_observer {
+  void on_primitive(const char* name, cudaStream_t stream, float elapsed_ms) override
+  {
+    std::lock_guard<std::mutex> _(mutex);
+    names.push_back(name);
+    elapsed.push_back(elapsed_ms);
+  }
+
+  std::mutex mutex;
+  std::vector<std::string> names;
+  std::vector<float> elapsed;
+};
+
+void run_instrumented(const handle_t& handle, const char* name, const int* in, int* out, int n)
+{
+  profiling_scope prof_scope(handle.get_profiler(), name, handle.get_stream());
+  spin_kernel<<<1, 1, 0, handle.get_stream()>>>(in, out, n);
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
+}
+
+}  // namespace
+
+TEST(Raft, ProfilerNoObserver)
+{
+  handle_t handle;
+  ASSERT_EQ(nullptr, handle.get_profiler());
+  rmm::device_uvector<int> buf(1024, handle.get_stream());
+  // a null profiler must be a no-op
+  run_instrumented(handle, "noop", buf.data(), buf.data(), 1024);
+  handle.flush_profiler();
+  handle.sync_stream();
+}
+
+TEST(Raft, ProfilerObserver)
+{
+  handle_t handle;
+  auto observer = std::make_shared<recording_observer>();
+  handle.set_profiler_observer(observer);
+  ASSERT_NE(nullptr, handle.get_profiler());
+
+  rmm::device_uvector<int> buf(1 << 20, handle.get_stream());
+  constexpr int n_calls = 8;
+  for (int i = 0; i < n_calls; i++) {
+    run_instrumented(handle, "spin", buf.data(), buf.data(), 1 << 20);
+  }
+  handle.flush_profiler();
+
+  ASSERT_EQ(n_calls, int(observer->names.size()));
+  for (int i = 0; i < n_calls; i++) {
+    ASSERT_EQ("spin", observer->names[i]);
+    ASSERT_GT(observer->elapsed[i], 0.0f);
+  }
+
+  // detaching stops the reporting
+  handle.set_profiler_observer(nullptr);
+  ASSERT_EQ(nullptr, handle.get_profiler());
+  run_instrumented(handle, "spin", buf.data(), buf.data(), 1 << 20);
+  handle.flush_profiler();
+  handle.sync_stream();
+  ASSERT_EQ(n_calls, int(observer->names.size()));
+}
+
+}  // namespace raft
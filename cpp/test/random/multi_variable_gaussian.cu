@@ -272,6 +272,128 @@ const std::vector<MVGInputs<double>> inputsd = {
   // Correlation::UNCORRELATED, 10, 3000000, 6ULL}
 };
 
+template <typename T>
+struct MVGBatchedInputs {
+  T tolerance;
+  int dim, nPoints, batchSize;
+  unsigned long long int seed;
+};
+
+template <typename T>
+::std::ostream& operator<<(::std::ostream& os, const MVGBatchedInputs<T>& dims)
+{
+  return os;
+}
+
+template <typename T>
+class MVGBatchedTest : public ::testing::TestWithParam<MVGBatchedInputs<T>> {
+ protected:
+  MVGBatchedTest()
+    : P_d(0, handle.get_stream()),
+      x_d(0, handle.get_stream()),
+      X_d(0, handle.get_stream()),
+      Rand_cov(0, handle.get_stream()),
+      Rand_mean(0, handle.get_stream())
+  {
+  }
+
+  void SetUp() override
+  {
+    params    = ::testing::TestWithParam<MVGBatchedInputs<T>>::GetParam();
+    dim       = params.dim;
+    nPoints   = params.nPoints;
+    batchSize = params.batchSize;
+    tolerance = params.tolerance;
+
+    auto cublasH = handle.get_cublas_handle();
+    auto stream  = handle.get_stream();
+
+    P.resize(dim * dim * batchSize);
+    x.resize(dim * batchSize);
+    P_d.resize(dim * dim * batchSize, stream);
+    x_d.resize(dim * batchSize, stream);
+    X_d.resize(dim * nPoints * batchSize, stream);
+    Rand_cov.resize(dim * dim * batchSize, stream);
+    Rand_mean.resize(dim * batchSize, stream);
+
+    // generating a random mean and +ve definite symm covariance per batch
+    // member, same construction as in MVGTest
+    srand(params.seed);
+    std::default_random_engine generator(params.seed);
+    std::uniform_real_distribution<T> distribution(0.0, 1.0);
+    for (int b = 0; b < batchSize; b++) {
+      T* Pb = P.data() + b * dim * dim;
+      for (int j = 0; j < dim; j++) {
+        x.data()[b * dim + j] = rand() % 100 + 5.0f;
+        for (int i = 0; i < j + 1; i++) {
+          T k                 = distribution(generator);
+          Pb[IDX2C(i, j, dim)] = k;
+          Pb[IDX2C(j, i, dim)] = k;
+          if (i == j) Pb[IDX2C(i, j, dim)] += dim;
+        }
+      }
+    }
+
+    raft::update_device(P_d.data(), P.data(), dim * dim * batchSize, stream);
+    raft::update_device(x_d.data(), x.data(), dim * batchSize, stream);
+
+    // decompose once, then sample all distributions in one shot
+    mvg_b = new multi_variable_gaussian_batched<T>(handle, dim, batchSize);
+    mvg_b->set_covariance(P_d.data());
+    mvg_b->give_gaussian(nPoints, X_d.data(), x_d.data());
+
+    // empirical mean and covariance of every batch member
+    RAFT_CUDA_TRY(cudaMemset(Rand_mean.data(), 0, dim * batchSize * sizeof(T)));
+    dim3 block = (64);
+    for (int b = 0; b < batchSize; b++) {
+      T* Xb         = X_d.data() + b * dim * nPoints;
+      T* Rand_meanb = Rand_mean.data() + b * dim;
+      dim3 grid     = (raft::ceildiv(nPoints * dim, (int)block.x));
+      En_KF_accumulate<<<grid, block, 0, stream>>>(nPoints, dim, Xb, Rand_meanb);
+      RAFT_CUDA_TRY(cudaPeekAtLastError());
+      grid = (raft::ceildiv(dim, (int)block.x));
+      En_KF_normalize<<<grid, block, 0, stream>>>(nPoints, dim, Rand_meanb);
+      RAFT_CUDA_TRY(cudaPeekAtLastError());
+      grid = (raft::ceildiv(dim * nPoints, (int)block.x));
+      En_KF_dif<<<grid, block, 0, stream>>>(nPoints, dim, Xb, Rand_meanb, Xb);
+      RAFT_CUDA_TRY(cudaPeekAtLastError());
+
+      T alfa = 1.0 / (nPoints - 1), beta = 0.0;
+      RAFT_CUBLAS_TRY(raft::linalg::detail::cublasgemm(cublasH,
+                                                       CUBLAS_OP_N,
+                                                       CUBLAS_OP_T,
+                                                       dim,
+                                                       dim,
+                                                       nPoints,
+                                                       &alfa,
+                                                       Xb,
+                                                       dim,
+                                                       Xb,
+                                                       dim,
+                                                       &beta,
+                                                       Rand_cov.data() + b * dim * dim,
+                                                       dim,
+                                                       stream));
+    }
+  }
+
+  void TearDown() override { delete mvg_b; }
+
+ protected:
+  MVGBatchedInputs<T> params;
+  std::vector<T> P, x;
+  rmm::device_uvector<T> P_d, x_d, X_d, Rand_cov, Rand_mean;
+  int dim, nPoints, batchSize;
+  multi_variable_gaussian_batched<T>* mvg_b = NULL;
+  T tolerance;
+  raft::handle_t handle;
+};  // end of MVGBatchedTest class
+
+const std::vector<MVGBatchedInputs<float>> inputsf_batched = {{0.3f, 4, 30000, 32, 6ULL},
+                                                              {0.3f, 16, 30000, 8, 6ULL}};
+const std::vector<MVGBatchedInputs<double>> inputsd_batched = {{0.25, 4, 100000, 32, 6ULL},
+                                                               {0.25, 16, 100000, 8, 6ULL}};
+
 // make the tests
 typedef MVGTest<float> MVGTestF;
 typedef MVGTest<double> MVGTestD;
@@ -308,8 +430,49 @@ TEST_P(MVGTestD, CovIsCorrectD)
     << " in CovIsCorrect";
 }
 
+typedef MVGBatchedTest<float> MVGBatchedTestF;
+typedef MVGBatchedTest<double> MVGBatchedTestD;
+TEST_P(MVGBatchedTestF, MeanIsCorrectF)
+{
+  EXPECT_TRUE(raft::devArrMatch(x_d.data(),
+                                Rand_mean.data(),
+                                dim * batchSize,
+                                raft::CompareApprox<float>(tolerance),
+                                handle.get_stream()))
+    << " in MeanIsCorrect";
+}
+TEST_P(MVGBatchedTestF, CovIsCorrectF)
+{
+  EXPECT_TRUE(raft::devArrMatch(P_d.data(),
+                                Rand_cov.data(),
+                                dim * dim * batchSize,
+                                raft::CompareApprox<float>(tolerance),
+                                handle.get_stream()))
+    << " in CovIsCorrect";
+}
+TEST_P(MVGBatchedTestD, MeanIsCorrectD)
+{
+  EXPECT_TRUE(raft::devArrMatch(x_d.data(),
+                                Rand_mean.data(),
+                                dim * batchSize,
+                                raft::CompareApprox<double>(tolerance),
+                                handle.get_stream()))
+    << " in MeanIsCorrect";
+}
+TEST_P(MVGBatchedTestD, CovIsCorrectD)
+{
+  EXPECT_TRUE(raft::devArrMatch(P_d.data(),
+                                Rand_cov.data(),
+                                dim * dim * batchSize,
+                                raft::CompareApprox<double>(tolerance),
+                                handle.get_stream()))
+    << " in CovIsCorrect";
+}
+
 // call the tests
 INSTANTIATE_TEST_CASE_P(MVGTests, MVGTestF, ::testing::ValuesIn(inputsf));
 INSTANTIATE_TEST_CASE_P(MVGTests, MVGTestD, ::testing::ValuesIn(inputsd));
+INSTANTIATE_TEST_CASE_P(MVGTests, MVGBatchedTestF, ::testing::ValuesIn(inputsf_batched));
+INSTANTIATE_TEST_CASE_P(MVGTests, MVGBatchedTestD, ::testing::ValuesIn(inputsd_batched));
 
 };  // end of namespace raft::random
\ No newline at end of file
@@ -232,5 +232,140 @@ TEST_P(PermTestD, Result)
 }
 INSTANTIATE_TEST_CASE_P(PermTests, PermTestD, ::testing::ValuesIn(inputsd));
 
+template <typename T>
+class PermFeistelTest : public ::testing::TestWithParam<PermInputs<T>> {
+ protected:
+  PermFeistelTest()
+    : in(0, handle.get_stream()), out(0, handle.get_stream()), outPerms(0, handle.get_stream())
+  {
+  }
+
+  void SetUp() override
+  {
+    auto stream = handle.get_stream();
+    params      = ::testing::TestWithParam<PermInputs<T>>::GetParam();
+    // forcefully set needPerms, since we need it for unit-testing!
+    if (params.needShuffle) { params.needPerms = true; }
+    raft::random::RngState r(params.seed);
+    int N   = params.N;
+    int D   = params.D;
+    int len = N * D;
+    if (params.needPerms) {
+      outPerms.resize(N, stream);
+      outPerms_ptr = outPerms.data();
+    }
+    if (params.needShuffle) {
+      in.resize(len, stream);
+      out.resize(len, stream);
+      in_ptr  = in.data();
+      out_ptr = out.data();
+      uniform(handle, r, in_ptr, len, T(-1.0), T(1.0));
+    }
+    permute_feistel(outPerms_ptr, out_ptr, in_ptr, D, N, params.rowMajor, stream);
+    handle.sync_stream();
+  }
+
+ protected:
+  raft::handle_t handle;
+  PermInputs<T> params;
+  rmm::device_uvector<T> in, out;
+  T* in_ptr  = nullptr;
+  T* out_ptr = nullptr;
+  rmm::device_uvector<int> outPerms;
+  int* outPerms_ptr = nullptr;
+};
+
+typedef PermFeistelTest<float> PermFeistelTestF;
+TEST_P(PermFeistelTestF, Result)
+{
+  if (params.needPerms) {
+    ASSERT_TRUE(devArrMatchRange(outPerms_ptr, params.N, 0, raft::Compare<int>()));
+  }
+  if (params.needShuffle) {
+    ASSERT_TRUE(devArrMatchShuffle(
+      outPerms_ptr, out_ptr, in_ptr, params.D, params.N, params.rowMajor, raft::Compare<float>()));
+  }
+}
+INSTANTIATE_TEST_CASE_P(PermTests, PermFeistelTestF, ::testing::ValuesIn(inputsf));
+
+typedef PermFeistelTest<double> PermFeistelTestD;
+TEST_P(PermFeistelTestD, Result)
+{
+  if (params.needPerms) {
+    ASSERT_TRUE(devArrMatchRange(outPerms_ptr, params.N, 0, raft::Compare<int>()));
+  }
+  if (params.needShuffle) {
+    ASSERT_TRUE(devArrMatchShuffle(
+      outPerms_ptr, out_ptr, in_ptr, params.D, params.N, params.rowMajor, raft::Compare<double>()));
+  }
+}
+INSTANTIATE_TEST_CASE_P(PermTests, PermFeistelTestD, ::testing::ValuesIn(inputsd));
+
+struct PermBatchedInputs {
+  int N, D, B;
+  bool rowMajor;
+  unsigned long long int seed;
+};
+
+::std::ostream& operator<<(::std::ostream& os, const PermBatchedInputs& dims) { return os; }
+
+template <typename T>
+class PermBatchedTest : public ::testing::TestWithParam<PermBatchedInputs> {
+ protected:
+  PermBatchedTest()
+    : in(0, handle.get_stream()), out(0, handle.get_stream()), outPerms(0, handle.get_stream())
+  {
+  }
+
+  void SetUp() override
+  {
+    auto stream = handle.get_stream();
+    params      = GetParam();
+    raft::random::RngState r(params.seed);
+    size_t len = size_t(params.N) * params.D * params.B;
+    outPerms.resize(size_t(params.N) * params.B, stream);
+    in.resize(len, stream);
+    out.resize(len, stream);
+    uniform(handle, r, in.data(), len, T(-1.0), T(1.0));
+    permute_batched_feistel(
+      outPerms.data(), out.data(), in.data(), params.D, params.N, params.B, params.rowMajor, stream);
+    handle.sync_stream();
+  }
+
+ protected:
+  raft::handle_t handle;
+  PermBatchedInputs params;
+  rmm::device_uvector<T> in, out;
+  rmm::device_uvector<int> outPerms;
+};
+
+const std::vector<PermBatchedInputs> inputs_batched = {
+  {128, 1, 64, true, 1234ULL},
+  {1024, 4, 16, true, 1234567890ULL},
+  {1000, 3, 7, false, 1234ULL},
+};
+
+typedef PermBatchedTest<float> PermBatchedTestF;
+TEST_P(PermBatchedTestF, Result)
+{
+  for (int b = 0; b < params.B; b++) {
+    const int* perms = outPerms.data() + size_t(b) * params.N;
+    const float* bin = in.data() + size_t(b) * params.N * params.D;
+    const float* bout = out.data() + size_t(b) * params.N * params.D;
+    ASSERT_TRUE(devArrMatchRange(perms, params.N, 0, raft::Compare<int>())) << "batch " << b;
+    ASSERT_TRUE(devArrMatchShuffle(
+      perms, bout, bin, params.D, params.N, params.rowMajor, raft::Compare<float>()))
+      << "batch " << b;
+  }
+
+  // arrays must get independent permutations, not B copies of one
+  std::vector<int> p0(params.N), p1(params.N);
+  raft::update_host(p0.data(), outPerms.data(), params.N, handle.get_stream());
+  raft::update_host(p1.data(), outPerms.data() + params.N, params.N, handle.get_stream());
+  handle.sync_stream();
+  ASSERT_NE(p0, p1);
+}
+INSTANTIATE_TEST_CASE_P(PermTests, PermBatchedTestF, ::testing::ValuesIn(inputs_batched));
+
 }  // end namespace random
 }  // end namespace raft
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils.h"
+#include <gtest/gtest.h>
+#include <raft/cudart_utils.h>
+#include <raft/random/rng.cuh>
+
+namespace raft {
+namespace random {
+
+// The consume variants must hand out exactly the sequence the storing
+// variants would have written: same seed, same launch geometry, same
+// per-thread generator. So a consumer that just stores its argument has
+// to reproduce the generated buffer bit for bit.
+
+struct RngConsumeInputs {
+  int len;
+  GeneratorType gtype;
+  unsigned long long int seed;
+};
+
+::std::ostream& operator<<(::std::ostream& os, const RngConsumeInputs& d)
+{
+  return os << "len: " << d.len << "; gtype: " << int(d.gtype);
+}
+
+class RngConsumeTest : public ::testing::TestWithParam<RngConsumeInputs> {
+ public:
+  RngConsumeTest()
+    : params(::testing::TestWithParam<RngConsumeInputs>::GetParam()),
+      stream(handle.get_stream()),
+      exp(params.len, stream),
+      act(params.len, stream),
+      mask_exp(params.len, stream),
+      mask_act(params.len, stream)
+  {
+  }
+
+ protected:
+  raft::handle_t handle;
+  cudaStream_t stream;
+
+  RngConsumeInputs params;
+  rmm::device_uvector<float> exp, act;
+  rmm::device_uvector<bool> mask_exp, mask_act;
+};
+
+TEST_P(RngConsumeTest, Uniform)
+{
+  RngState r1(params.seed, params.gtype);
+  uniform(handle, r1, exp.data(), params.len, -1.0f, 1.0f);
+
+  RngState r2(params.seed, params.gtype);
+  float* out = act.data();
+  uniform_consume<float>(
+    handle, r2, [out] __device__(float val, int idx) { out[idx] = val; }, params.len, -1.0f, 1.0f);
+
+  ASSERT_TRUE(devArrMatch(exp.data(), act.data(), params.len, Compare<float>()));
+}
+
+TEST_P(RngConsumeTest, Normal)
+{
+  RngState r1(params.seed, params.gtype);
+  normal(handle, r1, exp.data(), params.len, 0.5f, 2.0f);
+
+  RngState r2(params.seed, params.gtype);
+  float* out = act.data();
+  normal_consume<float>(
+    handle, r2, [out] __device__(float val, int idx) { out[idx] = val; }, params.len, 0.5f, 2.0f);
+
+  ASSERT_TRUE(devArrMatch(exp.data(), act.data(), params.len, Compare<float>()));
+}
+
+TEST_P(RngConsumeTest, Bernoulli)
+{
+  RngState r1(params.seed, params.gtype);
+  bernoulli(handle, r1, mask_exp.data(), params.len, 0.7f);
+
+  RngState r2(params.seed, params.gtype);
+  bool* out = mask_act.data();
+  bernoulli_consume(
+    handle, r2, [out] __device__(bool val, int idx) { out[idx] = val; }, params.len, 0.7f);
+
+  ASSERT_TRUE(devArrMatch(mask_exp.data(), mask_act.data(), params.len, Compare<bool>()));
+}
+
+const std::vector<RngConsumeInputs> inputs = {{1024, GeneratorType::GenPhilox, 1234ULL},
+                                              {1024 * 1024 + 17, GeneratorType::GenPhilox, 1234ULL},
+                                              {1024, GeneratorType::GenPC, 1234ULL},
+                                              {1024 * 1024 + 17, GeneratorType::GenPC, 1234ULL}};
+
+INSTANTIATE_TEST_SUITE_P(RngConsumeTests, RngConsumeTest, ::testing::ValuesIn(inputs));
+
+}  // namespace random
+}  // namespace raft
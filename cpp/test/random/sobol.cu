@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils.h"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <raft/cudart_utils.h>
+#include <raft/handle.hpp>
+#include <raft/random/sobol.cuh>
+#include <rmm/device_uvector.hpp>
+#include <vector>
+
+namespace raft {
+namespace random {
+
+template <typename T>
+struct SobolInputs {
+  T tolerance;
+  int n_points, n_dims;
+  T mu, sigma;
+  uint64_t seed;
+};
+
+template <typename T>
+::std::ostream& operator<<(::std::ostream& os, const SobolInputs<T>& dims)
+{
+  return os;
+}
+
+template <typename T>
+class SobolTest : public ::testing::TestWithParam<SobolInputs<T>> {
+ public:
+  SobolTest()
+    : params(::testing::TestWithParam<SobolInputs<T>>::GetParam()),
+      stream(handle.get_stream()),
+      uniform_d(size_t(params.n_points) * params.n_dims, stream),
+      normal_d(size_t(params.n_points) * params.n_dims, stream)
+  {
+  }
+
+ protected:
+  void SetUp() override
+  {
+    RngState r(params.seed);
+    sobol_uniform(handle, r, uniform_d.data(), params.n_points, params.n_dims);
+    sobol_normal(handle, r, normal_d.data(), params.n_points, params.n_dims, params.mu,
+                 params.sigma);
+    h_uniform.resize(uniform_d.size());
+    h_normal.resize(normal_d.size());
+    raft::update_host(h_uniform.data(), uniform_d.data(), uniform_d.size(), stream);
+    raft::update_host(h_normal.data(), normal_d.data(), normal_d.size(), stream);
+    handle.sync_stream(stream);
+  }
+
+ protected:
+  raft::handle_t handle;
+  cudaStream_t stream;
+
+  SobolInputs<T> params;
+  rmm::device_uvector<T> uniform_d, normal_d;
+  std::vector<T> h_uniform, h_normal;
+};
+
+typedef SobolTest<float> SobolTestF;
+typedef SobolTest<double> SobolTestD;
+
+const std::vector<SobolInputs<float>> inputsf = {
+  {0.005f, 16 * 1024, 1, 1.f, 2.f, 1234ULL},
+  {0.005f, 16 * 1024, 8, 1.f, 2.f, 1234ULL},
+  {0.005f, 64 * 1024, 32, -1.f, 0.5f, 42ULL},
+};
+const std::vector<SobolInputs<double>> inputsd = {
+  {0.005, 16 * 1024, 1, 1.0, 2.0, 1234ULL},
+  {0.005, 16 * 1024, 8, 1.0, 2.0, 1234ULL},
+  {0.005, 64 * 1024, 32, -1.0, 0.5, 42ULL},
+};
+
+// every coordinate must lie strictly inside the unit interval, and the
+// low-discrepancy property makes the per-dimension sample moments converge
+// much faster than for pseudo-random draws, so tight tolerances are fine
+// already at these sample counts
+TEST_P(SobolTestF, Uniform)
+{
+  for (int d = 0; d < params.n_dims; ++d) {
+    double sum = 0.0, sum_sq = 0.0;
+    for (int i = 0; i < params.n_points; ++i) {
+      auto val = h_uniform[size_t(d) * params.n_points + i];
+      ASSERT_TRUE(val > 0.f && val < 1.f) << "out-of-range value @dim=" << d << " val=" << val;
+      sum += val;
+      sum_sq += double(val) * val;
+    }
+    ASSERT_NEAR(sum / params.n_points, 0.5, params.tolerance) << "@dim=" << d;
+    // estimate of the integral of x^2 over [0, 1]
+    ASSERT_NEAR(sum_sq / params.n_points, 1.0 / 3.0, params.tolerance) << "@dim=" << d;
+  }
+}
+
+TEST_P(SobolTestF, Normal)
+{
+  for (int d = 0; d < params.n_dims; ++d) {
+    double sum = 0.0, sum_sq = 0.0;
+    for (int i = 0; i < params.n_points; ++i) {
+      auto val = h_normal[size_t(d) * params.n_points + i];
+      sum += val;
+      sum_sq += double(val) * val;
+    }
+    double mean = sum / params.n_points;
+    double var  = sum_sq / params.n_points - mean * mean;
+    ASSERT_NEAR(mean, params.mu, params.sigma * params.tolerance * 10) << "@dim=" << d;
+    ASSERT_NEAR(std::sqrt(var), params.sigma, params.sigma * params.tolerance * 10)
+      << "@dim=" << d;
+  }
+}
+
+TEST_P(SobolTestD, Uniform)
+{
+  for (int d = 0; d < params.n_dims; ++d) {
+    double sum = 0.0, sum_sq = 0.0;
+    for (int i = 0; i < params.n_points; ++i) {
+      auto val = h_uniform[size_t(d) * params.n_points + i];
+      ASSERT_TRUE(val > 0.0 && val < 1.0) << "out-of-range value @dim=" << d << " val=" << val;
+      sum += val;
+      sum_sq += val * val;
+    }
+    ASSERT_NEAR(sum / params.n_points, 0.5, params.tolerance) << "@dim=" << d;
+    // estimate of the integral of x^2 over [0, 1]
+    ASSERT_NEAR(sum_sq / params.n_points, 1.0 / 3.0, params.tolerance) << "@dim=" << d;
+  }
+}
+
+TEST_P(SobolTestD, Normal)
+{
+  for (int d = 0; d < params.n_dims; ++d) {
+    double sum = 0.0, sum_sq = 0.0;
+    for (int i = 0; i < params.n_points; ++i) {
+      auto val = h_normal[size_t(d) * params.n_points + i];
+      sum += val;
+      sum_sq += val * val;
+    }
+    double mean = sum / params.n_points;
+    double var  = sum_sq / params.n_points - mean * mean;
+    ASSERT_NEAR(mean, params.mu, params.sigma * params.tolerance * 10) << "@dim=" << d;
+    ASSERT_NEAR(std::sqrt(var), params.sigma, params.sigma * params.tolerance * 10)
+      << "@dim=" << d;
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(SobolTests, SobolTestF, ::testing::ValuesIn(inputsf));
+INSTANTIATE_TEST_SUITE_P(SobolTests, SobolTestD, ::testing::ValuesIn(inputsd));
+
+}  // namespace random
+}  // namespace raft
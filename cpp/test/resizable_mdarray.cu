@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <raft/core/resizable_mdarray.hpp>
+#include <raft/cudart_utils.h>
+#include <raft/handle.hpp>
+#include <rmm/device_uvector.hpp>
+#include <vector>
+
+namespace raft {
+
+TEST(ResizableMdarray, AppendRows)
+{
+  raft::handle_t handle;
+  auto stream = handle.get_stream();
+
+  constexpr size_t n_cols    = 4;
+  constexpr size_t n_batches = 16;
+  constexpr size_t batch     = 3;
+
+  auto mat = make_resizable_device_matrix<float>(handle, 0, n_cols);
+  ASSERT_EQ(mat.n_rows(), 0u);
+  ASSERT_EQ(mat.n_cols(), n_cols);
+
+  std::vector<float> h_all;
+  rmm::device_uvector<float> d_batch(batch * n_cols, stream);
+  size_t n_reallocs = 0;
+  for (size_t b = 0; b < n_batches; b++) {
+    std::vector<float> h_batch(batch * n_cols);
+    for (size_t i = 0; i < h_batch.size(); i++) {
+      h_batch[i] = float(b * 100 + i);
+    }
+    h_all.insert(h_all.end(), h_batch.begin(), h_batch.end());
+    raft::update_device(d_batch.data(), h_batch.data(), h_batch.size(), stream);
+
+    const float* before = mat.data();
+    mat.append_rows(d_batch.data(), batch, stream);
+    if (mat.data() != before) { n_reallocs++; }
+  }
+
+  ASSERT_EQ(mat.n_rows(), n_batches * batch);
+  ASSERT_GE(mat.capacity_rows(), mat.n_rows());
+  // geometric growth: far fewer reallocations than appends
+  ASSERT_LT(n_reallocs, n_batches / 2);
+
+  std::vector<float> h_out(mat.size());
+  raft::update_host(h_out.data(), mat.data(), mat.size(), stream);
+  handle.sync_stream(stream);
+  ASSERT_EQ(h_out, h_all);
+}
+
+TEST(ResizableMdarray, ReserveAvoidsCopies)
+{
+  raft::handle_t handle;
+  auto stream = handle.get_stream();
+
+  auto mat = make_resizable_device_matrix<int>(handle, 0, 8);
+  mat.reserve_rows(100, stream);
+  const int* ptr = mat.data();
+
+  rmm::device_uvector<int> d_rows(10 * 8, stream);
+  RAFT_CUDA_TRY(cudaMemsetAsync(d_rows.data(), 0, d_rows.size() * sizeof(int), stream));
+  for (int b = 0; b < 10; b++) {
+    mat.append_rows(d_rows.data(), 10, stream);
+    ASSERT_EQ(mat.data(), ptr);  // no reallocation within reserved capacity
+  }
+  ASSERT_EQ(mat.n_rows(), 100u);
+
+  // shrinking only changes the extents
+  mat.resize_rows(10, stream);
+  ASSERT_EQ(mat.n_rows(), 10u);
+  ASSERT_EQ(mat.data(), ptr);
+  ASSERT_EQ(mat.view().extent(0), 10u);
+}
+
+}  // namespace raft
@@ -341,5 +341,83 @@ TEST_P(ConnectComponentsTestF_Int, Result)
 INSTANTIATE_TEST_CASE_P(ConnectComponentsTest,
                         ConnectComponentsTestF_Int,
                         ::testing::ValuesIn(fix_conn_inputsf2));
+
+template <typename value_idx, typename value_t>
+class ConnectComponentsBatchedTest
+  : public ::testing::TestWithParam<ConnectComponentsInputs<value_t, value_idx>> {
+ protected:
+  void batchedTest()
+  {
+    raft::handle_t handle;
+
+    auto stream = handle.get_stream();
+
+    params = ::testing::TestWithParam<ConnectComponentsInputs<value_t, value_idx>>::GetParam();
+
+    rmm::device_uvector<value_t> data(params.n_row * params.n_col, stream);
+    raft::copy(data.data(), params.data.data(), data.size(), stream);
+
+    // a fixed (arbitrary) component labeling: processing the query rows in
+    // small batches must produce the same cross-component edges as a single
+    // full pass
+    std::vector<value_idx> colors_h(params.n_row);
+    for (value_idx i = 0; i < params.n_row; i++) {
+      colors_h[i] = i % 3;
+    }
+    rmm::device_uvector<value_idx> colors(params.n_row, stream);
+    raft::update_device(colors.data(), colors_h.data(), params.n_row, stream);
+
+    raft::linkage::FixConnectivitiesRedOp<value_idx, value_t> red_op(colors.data(), params.n_row);
+
+    raft::sparse::COO<value_t, value_idx> out_full(stream);
+    raft::linkage::connect_components<value_idx, value_t>(
+      handle, out_full, data.data(), colors.data(), params.n_row, params.n_col, red_op);
+
+    raft::sparse::COO<value_t, value_idx> out_batched(stream);
+    raft::linkage::connect_components<value_idx, value_t>(
+      handle,
+      out_batched,
+      data.data(),
+      colors.data(),
+      params.n_row,
+      params.n_col,
+      red_op,
+      raft::distance::DistanceType::L2SqrtExpanded,
+      7);
+
+    handle.sync_stream(stream);
+
+    nnz_match = out_full.nnz == out_batched.nnz;
+    edges_match =
+      nnz_match &&
+      raft::devArrMatch<value_idx>(
+        out_full.rows(), out_batched.rows(), out_full.nnz, raft::Compare<value_idx>()) &&
+      raft::devArrMatch<value_idx>(
+        out_full.cols(), out_batched.cols(), out_full.nnz, raft::Compare<value_idx>()) &&
+      raft::devArrMatch<value_t>(
+        out_full.vals(), out_batched.vals(), out_full.nnz, raft::CompareApprox<value_t>(1e-4));
+  }
+
+  void SetUp() override { batchedTest(); }
+
+  void TearDown() override {}
+
+ protected:
+  ConnectComponentsInputs<value_t, value_idx> params;
+
+  bool nnz_match;
+  bool edges_match;
+};
+
+typedef ConnectComponentsBatchedTest<int, float> ConnectComponentsBatchedTestF_Int;
+TEST_P(ConnectComponentsBatchedTestF_Int, Result)
+{
+  EXPECT_TRUE(nnz_match);
+  EXPECT_TRUE(edges_match);
+}
+
+INSTANTIATE_TEST_CASE_P(ConnectComponentsBatchedTest,
+                        ConnectComponentsBatchedTestF_Int,
+                        ::testing::ValuesIn(fix_conn_inputsf2));
 };  // namespace sparse
 };  // end namespace raft
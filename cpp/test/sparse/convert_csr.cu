@@ -167,5 +167,53 @@ INSTANTIATE_TEST_CASE_P(SparseConvertCSRTest,
                         CSRAdjGraphTestL,
                         ::testing::ValuesIn(csradjgraph_inputs_l));
 
+/******************************* adj degree ********************************/
+
+template <typename Index_>
+class AdjDegreeTest : public CSRAdjGraphTest<Index_> {
+ public:
+  void RunDegree()
+  {
+    auto& params = this->params;
+    auto stream  = this->stream;
+
+    raft::update_device(this->adj.data(),
+                        reinterpret_cast<bool*>(params.adj.data()),
+                        params.n_rows * params.n_cols,
+                        stream);
+
+    // expected counts are the consecutive differences of row_ind plus the
+    // nnz tail for the last row
+    std::vector<Index_> counts_h(params.n_rows);
+    for (Index_ i = 0; i < params.n_rows; i++) {
+      Index_ stop = i < params.n_rows - 1 ? params.row_ind[i + 1] : (Index_)params.verify.size();
+      counts_h[i] = stop - params.row_ind[i];
+    }
+
+    rmm::device_uvector<Index_> counts(params.n_rows, stream);
+    rmm::device_uvector<Index_> counts_verify(params.n_rows, stream);
+    raft::update_device(counts_verify.data(), counts_h.data(), params.n_rows, stream);
+
+    convert::adj_degree(
+      (const bool*)this->adj.data(), params.n_rows, params.n_cols, counts.data(), stream);
+
+    ASSERT_TRUE(raft::devArrMatch<Index_>(
+      counts_verify.data(), counts.data(), params.n_rows, raft::Compare<Index_>()));
+  }
+};
+
+using AdjDegreeTestI = AdjDegreeTest<int>;
+TEST_P(AdjDegreeTestI, Result) { RunDegree(); }
+
+using AdjDegreeTestL = AdjDegreeTest<int64_t>;
+TEST_P(AdjDegreeTestL, Result) { RunDegree(); }
+
+INSTANTIATE_TEST_CASE_P(SparseConvertCSRTest,
+                        AdjDegreeTestI,
+                        ::testing::ValuesIn(csradjgraph_inputs_i));
+INSTANTIATE_TEST_CASE_P(SparseConvertCSRTest,
+                        AdjDegreeTestL,
+                        ::testing::ValuesIn(csradjgraph_inputs_l));
+
 }  // namespace sparse
 }  // namespace raft
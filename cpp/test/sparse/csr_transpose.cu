@@ -106,17 +106,21 @@ class CSRTransposeTest : public ::testing::TestWithParam<CSRTransposeInputs<valu
 
     make_data();
 
-    raft::sparse::linalg::csr_transpose(handle,
-                                        indptr.data(),
-                                        indices.data(),
-                                        data.data(),
-                                        out_indptr.data(),
-                                        out_indices.data(),
-                                        out_data.data(),
-                                        params.nrows,
-                                        params.ncols,
-                                        params.nnz,
-                                        stream);
+    // transpose twice: the second call runs against the handle's cached
+    // workspace sizing and must produce the same result
+    for (int i = 0; i < 2; i++) {
+      raft::sparse::linalg::csr_transpose(handle,
+                                          indptr.data(),
+                                          indices.data(),
+                                          data.data(),
+                                          out_indptr.data(),
+                                          out_indices.data(),
+                                          out_data.data(),
+                                          params.nrows,
+                                          params.ncols,
+                                          params.nnz,
+                                          stream);
+    }
 
     handle.sync_stream(stream);
   }
@@ -54,6 +54,7 @@ struct InputConfiguration {
 
 using dense_smem_strategy_t = detail::dense_smem_strategy<int, float, 1024>;
 using hash_strategy_t       = detail::hash_strategy<int, float, 1024>;
+using merge_path_strategy_t = detail::merge_path_strategy<int, float, 1024>;
 
 template <typename value_idx, typename value_t, typename strategy_t>
 struct SparseDistanceCOOSPMVInputs {
@@ -90,7 +91,9 @@ class SparseDistanceCOOSPMVTest
     return strategy_t(dist_config, params.capacity_threshold, params.map_size);
   }
 
-  template <typename U, std::enable_if_t<std::is_same_v<U, dense_smem_strategy_t>>* = nullptr>
+  template <typename U,
+            std::enable_if_t<std::is_same_v<U, dense_smem_strategy_t> ||
+                             std::is_same_v<U, merge_path_strategy_t>>* = nullptr>
   U make_strategy()
   {
     return strategy_t(dist_config);
@@ -255,6 +258,17 @@ const InputConfiguration<int, float> input_inner_product = {
   raft::distance::DistanceType::InnerProduct,
   0.0};
 
+// rows with almost entirely disjoint column sets, exercising the bloom
+// signature pruning of the hash strategy
+const InputConfiguration<int, float> input_inner_product_disjoint = {
+  16,
+  {0, 2, 4, 6, 8},
+  {0, 4, 1, 9, 2, 12, 0, 15},
+  {1.0f, 2.0f, 1.0f, 2.0f, 1.0f, 2.0f, 3.0f, 2.0f},
+  {5.0, 0.0, 0.0, 3.0, 0.0, 5.0, 0.0, 0.0, 0.0, 0.0, 5.0, 0.0, 3.0, 0.0, 0.0, 13.0},
+  raft::distance::DistanceType::InnerProduct,
+  0.0};
+
 const InputConfiguration<int, float> input_l2_unexpanded = {
   2,
   {0, 2, 4, 6, 8},
@@ -667,6 +681,8 @@ INSTANTIATE_TEST_CASE_P(SparseDistanceCOOSPMVTests,
 const std::vector<SparseDistanceCOOSPMVInputs<int, float, hash_strategy_t>> inputs_hash_strategy = {
   {input_inner_product},
   {input_inner_product, 0.5, 2},
+  {input_inner_product_disjoint},
+  {input_inner_product_disjoint, 0.5, 2},
   {input_l2_unexpanded},
   {input_l2_unexpanded, 0.5, 2},
   {input_canberra},
@@ -688,6 +704,22 @@ INSTANTIATE_TEST_CASE_P(SparseDistanceCOOSPMVTests,
                         SparseDistanceCOOSPMVTestHashStrategyF,
                         ::testing::ValuesIn(inputs_hash_strategy));
 
+// test merge path strategy
+const std::vector<SparseDistanceCOOSPMVInputs<int, float, merge_path_strategy_t>>
+  inputs_merge_path_strategy = {{input_inner_product},
+                                {input_l2_unexpanded},
+                                {input_canberra},
+                                {input_lp_unexpanded},
+                                {input_linf},
+                                {input_l1}};
+
+typedef SparseDistanceCOOSPMVTest<int, float, merge_path_strategy_t>
+  SparseDistanceCOOSPMVTestMergePathStrategyF;
+TEST_P(SparseDistanceCOOSPMVTestMergePathStrategyF, Result) { compare(); }
+INSTANTIATE_TEST_CASE_P(SparseDistanceCOOSPMVTests,
+                        SparseDistanceCOOSPMVTestMergePathStrategyF,
+                        ::testing::ValuesIn(inputs_merge_path_strategy));
+
 };  // namespace distance
 };  // end namespace sparse
 };  // end namespace raft
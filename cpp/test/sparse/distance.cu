@@ -191,6 +191,13 @@ const std::vector<SparseDistanceInputs<int, float>> inputs_i32_f = {
    {5.0, 5.0, 5.0, 5.0, 5.0, 5.0, 5.0, 5.0, 5.0, 5.0, 5.0, 5.0, 5.0, 5.0, 5.0, 5.0},
    raft::distance::DistanceType::InnerProduct,
    0.0},
+  {10000,  // density under the SpGEMM threshold
+   {0, 1, 2, 2, 3},
+   {17, 17, 9999},
+   {2.0f, 3.0f, 4.0f},
+   {4.0, 6.0, 0.0, 0.0, 6.0, 9.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 16.0},
+   raft::distance::DistanceType::InnerProduct,
+   0.0},
   {2,
    {0, 2, 4, 6, 8},
    {0, 1, 0, 1, 0, 1, 0, 1},  // indices
@@ -111,5 +111,50 @@ TEST_P(COORemoveZeros, Result)
 
 INSTANTIATE_TEST_CASE_P(SparseFilterTests, COORemoveZeros, ::testing::ValuesIn(inputsf));
 
+TEST(COOFilter, ThresholdAndDegreeCap)
+{
+  raft::handle_t h;
+  auto stream = h.get_stream();
+
+  // row-sorted 5x5 graph; fuse "weight >= 0.4" with a degree cap of 2
+  constexpr int nnz     = 10;
+  int in_rows_h[nnz]    = {0, 0, 0, 0, 1, 1, 2, 4, 4, 4};
+  int in_cols_h[nnz]    = {0, 1, 2, 4, 0, 1, 2, 1, 2, 4};
+  float in_vals_h[nnz]  = {0.0f, 0.9f, 0.5f, 0.45f, 0.6f, 0.1f, 0.7f, 0.3f, 0.8f, 0.95f};
+
+  COO<float> in(stream, nnz, 5, 5);
+  raft::update_device(in.rows(), in_rows_h, nnz, stream);
+  raft::update_device(in.cols(), in_cols_h, nnz, stream);
+  raft::update_device(in.vals(), in_vals_h, nnz, stream);
+
+  // row 0 has three passing edges but only the first two survive the cap
+  constexpr int out_nnz  = 6;
+  int out_rows_h[out_nnz]   = {0, 0, 1, 2, 4, 4};
+  int out_cols_h[out_nnz]   = {1, 2, 0, 2, 2, 4};
+  float out_vals_h[out_nnz] = {0.9f, 0.5f, 0.6f, 0.7f, 0.8f, 0.95f};
+
+  COO<float> out_ref(stream, out_nnz, 5, 5);
+  raft::update_device(out_ref.rows(), out_rows_h, out_nnz, stream);
+  raft::update_device(out_ref.cols(), out_cols_h, out_nnz, stream);
+  raft::update_device(out_ref.vals(), out_vals_h, out_nnz, stream);
+
+  COO<float> out(stream);
+  rmm::device_uvector<int> workspace(0, stream);
+  op::coo_filter<float>(
+    &in,
+    &out,
+    [] __device__(int, int, float val) { return val >= 0.4f; },
+    2,
+    workspace,
+    stream);
+  RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+
+  ASSERT_EQ(out.nnz, out_nnz);
+  ASSERT_TRUE(raft::devArrMatch<int>(out_ref.rows(), out.rows(), out_nnz, raft::Compare<int>()));
+  ASSERT_TRUE(raft::devArrMatch<int>(out_ref.cols(), out.cols(), out_nnz, raft::Compare<int>()));
+  ASSERT_TRUE(
+    raft::devArrMatch<float>(out_ref.vals(), out.vals(), out_nnz, raft::Compare<float>()));
+}
+
 }  // namespace sparse
 }  // namespace raft
@@ -17,6 +17,7 @@
 #include "../test_utils.h"
 #include <gtest/gtest.h>
 #include <raft/cudart_utils.h>
+#include <raft/random/rng.cuh>
 #include <rmm/device_scalar.hpp>
 #include <rmm/device_uvector.hpp>
 
@@ -125,5 +126,67 @@ INSTANTIATE_TEST_CASE_P(KNNGraphTest,
                         KNNGraphTestF_int,
                         ::testing::ValuesIn(knn_graph_inputs_fint));
 
+struct KNNGraphApproxInputs {
+  int m;
+  int n;
+  unsigned long long int seed;
+};
+
+/**
+ * The approximate builder must produce a symmetric graph bounded by the
+ * same shape as the exact one.
+ */
+class KNNGraphApproxTest : public ::testing::TestWithParam<KNNGraphApproxInputs> {
+ protected:
+  void SetUp() override
+  {
+    auto params = GetParam();
+    auto stream = handle.get_stream();
+
+    rmm::device_uvector<float> X(params.m * params.n, stream);
+    raft::random::RngState r(params.seed);
+    uniform(handle, r, X.data(), params.m * params.n, -1.0f, 1.0f);
+
+    raft::sparse::COO<float, int> out(stream);
+    raft::sparse::selection::knn_graph(handle,
+                                       X.data(),
+                                       (size_t)params.m,
+                                       (size_t)params.n,
+                                       raft::distance::DistanceType::L2Unexpanded,
+                                       out,
+                                       15,
+                                       0,
+                                       raft::sparse::selection::NN_DESCENT);
+
+    rmm::device_scalar<int> sum(stream);
+    sum.set_value_to_zero_async(stream);
+    assert_symmetry<<<raft::ceildiv(out.nnz, 256), 256, 0, stream>>>(
+      out.rows(), out.cols(), out.vals(), out.nnz, sum.data());
+
+    sum_h = sum.value(stream);
+    nnz_h = out.nnz;
+    k     = std::min(params.m, std::max(2, (int)floor(log2((double)params.m)) + 15));
+    m     = params.m;
+    handle.sync_stream(stream);
+  }
+
+ protected:
+  raft::handle_t handle;
+  int sum_h, nnz_h, k, m;
+};
+
+TEST_P(KNNGraphApproxTest, Result)
+{
+  ASSERT_TRUE(nnz_h <= m * k * 2);
+  ASSERT_TRUE(sum_h == 0);
+}
+
+const std::vector<KNNGraphApproxInputs> knn_graph_approx_inputs = {{2000, 8, 1234ULL},
+                                                                   {5000, 32, 31ULL}};
+
+INSTANTIATE_TEST_CASE_P(KNNGraphTest,
+                        KNNGraphApproxTest,
+                        ::testing::ValuesIn(knn_graph_approx_inputs));
+
 }  // namespace sparse
 }  // namespace raft
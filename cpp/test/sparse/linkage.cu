@@ -423,4 +423,131 @@ typedef LinkageTest<float, int> LinkageTestF_Int;
 TEST_P(LinkageTestF_Int, Result) { EXPECT_TRUE(score == 1.0); }
 
 INSTANTIATE_TEST_CASE_P(LinkageTest, LinkageTestF_Int, ::testing::ValuesIn(linkage_inputsf2));
+
+// the batched connectivities graph must produce the same clustering as the
+// single-pass one
+template <typename T, typename IdxT>
+class LinkageBatchedTest : public ::testing::TestWithParam<LinkageInputs<T, IdxT>> {
+ public:
+  LinkageBatchedTest()
+    : params(::testing::TestWithParam<LinkageInputs<T, IdxT>>::GetParam()),
+      stream(handle.get_stream()),
+      labels(params.n_row, stream),
+      labels_ref(params.n_row, stream)
+  {
+  }
+
+ protected:
+  void basicTest()
+  {
+    rmm::device_uvector<T> data(params.n_row * params.n_col, stream);
+
+    raft::copy(data.data(), params.data.data(), data.size(), stream);
+    raft::copy(labels_ref.data(), params.expected_labels.data(), params.n_row, stream);
+
+    raft::hierarchy::linkage_output<IdxT, T> out_arrs;
+    out_arrs.labels = labels.data();
+
+    rmm::device_uvector<IdxT> out_children(params.n_row * 2, stream);
+
+    out_arrs.children = out_children.data();
+
+    // force several uneven batches
+    size_t batch_size = params.n_row / 3 + 1;
+
+    raft::handle_t handle;
+    raft::hierarchy::single_linkage<IdxT, T, raft::hierarchy::LinkageDistance::KNN_GRAPH>(
+      handle,
+      data.data(),
+      params.n_row,
+      params.n_col,
+      raft::distance::DistanceType::L2SqrtExpanded,
+      &out_arrs,
+      params.c,
+      params.n_clusters,
+      batch_size);
+
+    handle.sync_stream(stream);
+
+    score = compute_rand_index(labels.data(), labels_ref.data(), params.n_row, stream);
+  }
+
+  void SetUp() override { basicTest(); }
+
+ protected:
+  raft::handle_t handle;
+  cudaStream_t stream;
+
+  LinkageInputs<T, IdxT> params;
+  rmm::device_uvector<IdxT> labels, labels_ref;
+  double score;
+};
+
+typedef LinkageBatchedTest<float, int> LinkageBatchedTestF_Int;
+TEST_P(LinkageBatchedTestF_Int, Result) { EXPECT_TRUE(score == 1.0); }
+
+INSTANTIATE_TEST_CASE_P(LinkageBatchedTest,
+                        LinkageBatchedTestF_Int,
+                        ::testing::ValuesIn(linkage_inputsf2));
+
+// adaptive density mode: c estimated from sampled local-scale statistics
+template <typename T, typename IdxT>
+class LinkageAutoCTest : public ::testing::TestWithParam<LinkageInputs<T, IdxT>> {
+ public:
+  LinkageAutoCTest()
+    : params(::testing::TestWithParam<LinkageInputs<T, IdxT>>::GetParam()),
+      stream(handle.get_stream()),
+      labels(params.n_row, stream),
+      labels_ref(params.n_row, stream)
+  {
+  }
+
+ protected:
+  void basicTest()
+  {
+    rmm::device_uvector<T> data(params.n_row * params.n_col, stream);
+
+    raft::copy(data.data(), params.data.data(), data.size(), stream);
+    raft::copy(labels_ref.data(), params.expected_labels.data(), params.n_row, stream);
+
+    raft::hierarchy::linkage_output<IdxT, T> out_arrs;
+    out_arrs.labels = labels.data();
+
+    rmm::device_uvector<IdxT> out_children(params.n_row * 2, stream);
+
+    out_arrs.children = out_children.data();
+
+    raft::handle_t handle;
+    raft::hierarchy::single_linkage<IdxT, T, raft::hierarchy::LinkageDistance::KNN_GRAPH>(
+      handle,
+      data.data(),
+      params.n_row,
+      params.n_col,
+      raft::distance::DistanceType::L2SqrtExpanded,
+      &out_arrs,
+      raft::hierarchy::LINKAGE_AUTO_C,
+      params.n_clusters);
+
+    handle.sync_stream(stream);
+
+    score = compute_rand_index(labels.data(), labels_ref.data(), params.n_row, stream);
+  }
+
+  void SetUp() override { basicTest(); }
+
+ protected:
+  raft::handle_t handle;
+  cudaStream_t stream;
+
+  LinkageInputs<T, IdxT> params;
+  rmm::device_uvector<IdxT> labels, labels_ref;
+  double score;
+};
+
+typedef LinkageAutoCTest<float, int> LinkageAutoCTestF_Int;
+TEST_P(LinkageAutoCTestF_Int, Result) { EXPECT_TRUE(score == 1.0); }
+
+INSTANTIATE_TEST_CASE_P(LinkageAutoCTest,
+                        LinkageAutoCTestF_Int,
+                        ::testing::ValuesIn(linkage_inputsf2));
 }  // end namespace raft
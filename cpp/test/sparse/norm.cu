@@ -23,8 +23,11 @@
 #include <raft/sparse/csr.hpp>
 #include <raft/sparse/linalg/norm.cuh>
 
+#include <cmath>
+#include <cstdlib>
 #include <iostream>
 #include <limits>
+#include <vector>
 
 namespace raft {
 namespace sparse {
@@ -123,5 +126,95 @@ INSTANTIATE_TEST_CASE_P(SparseNormTest,
                         CSRRowNormalizeTestD,
                         ::testing::ValuesIn(csrnormalize_inputs_d));
 
+// fused generic-norm normalization: random skewed rows against a host
+// reference, both out-of-place and in-place
+template <typename Type_f>
+struct CSRRowNormalizeFusedInputs {
+  Type_f tolerance;
+  raft::linalg::NormType norm;
+  int n_rows, max_degree;
+  bool in_place;
+  unsigned long long int seed;
+};
+
+template <typename Type_f>
+class CSRRowNormalizeFusedTest
+  : public ::testing::TestWithParam<CSRRowNormalizeFusedInputs<Type_f>> {
+ protected:
+  void Run()
+  {
+    auto params = ::testing::TestWithParam<CSRRowNormalizeFusedInputs<Type_f>>::GetParam();
+    raft::handle_t handle;
+    auto stream = handle.get_stream();
+
+    // heavily skewed degrees: most rows tiny, a few holding most nonzeros
+    std::srand(params.seed);
+    std::vector<int> h_ia(params.n_rows);
+    std::vector<Type_f> h_vals;
+    int off = 0;
+    for (int i = 0; i < params.n_rows; ++i) {
+      h_ia[i]    = off;
+      int degree = (i % 37 == 0) ? params.max_degree : std::rand() % 4;
+      for (int d = 0; d < degree; ++d) {
+        h_vals.push_back(Type_f(std::rand()) / RAND_MAX - Type_f(0.5));
+      }
+      off += degree;
+    }
+    int nnz = h_vals.size();
+
+    std::vector<Type_f> h_ref(nnz);
+    for (int i = 0; i < params.n_rows; ++i) {
+      int start = h_ia[i], stop = i < params.n_rows - 1 ? h_ia[i + 1] : nnz;
+      Type_f acc = 0;
+      for (int j = start; j < stop; ++j) {
+        acc += params.norm == raft::linalg::L1Norm ? std::abs(h_vals[j]) : h_vals[j] * h_vals[j];
+      }
+      Type_f norm = params.norm == raft::linalg::L1Norm ? acc : std::sqrt(acc);
+      for (int j = start; j < stop; ++j) {
+        h_ref[j] = norm != 0 ? h_vals[j] / norm : Type_f(0);
+      }
+    }
+
+    rmm::device_uvector<int> ia(params.n_rows, stream);
+    rmm::device_uvector<Type_f> vals(nnz, stream), ref(nnz, stream), result(nnz, stream);
+    raft::update_device(ia.data(), h_ia.data(), params.n_rows, stream);
+    raft::update_device(vals.data(), h_vals.data(), nnz, stream);
+    raft::update_device(ref.data(), h_ref.data(), nnz, stream);
+
+    auto* out = params.in_place ? vals.data() : result.data();
+    linalg::csr_row_normalize<Type_f>(
+      ia.data(), vals.data(), nnz, params.n_rows, out, params.norm, stream);
+    RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+
+    ASSERT_TRUE(raft::devArrMatch<Type_f>(
+      ref.data(), out, nnz, raft::CompareApprox<Type_f>(params.tolerance)));
+  }
+};
+
+using CSRRowNormalizeFusedTestF = CSRRowNormalizeFusedTest<float>;
+TEST_P(CSRRowNormalizeFusedTestF, Result) { Run(); }
+
+using CSRRowNormalizeFusedTestD = CSRRowNormalizeFusedTest<double>;
+TEST_P(CSRRowNormalizeFusedTestD, Result) { Run(); }
+
+const std::vector<CSRRowNormalizeFusedInputs<float>> csrnormalize_fused_inputs_f = {
+  {1e-5, raft::linalg::L2Norm, 1024, 700, false, 42ULL},
+  {1e-5, raft::linalg::L2Norm, 1024, 700, true, 42ULL},
+  {1e-5, raft::linalg::L1Norm, 1024, 700, false, 42ULL},
+  // low mean degree takes the thread-per-row path
+  {1e-5, raft::linalg::L2Norm, 4096, 16, false, 42ULL},
+};
+const std::vector<CSRRowNormalizeFusedInputs<double>> csrnormalize_fused_inputs_d = {
+  {1e-10, raft::linalg::L2Norm, 1024, 700, false, 42ULL},
+  {1e-10, raft::linalg::L1Norm, 1024, 700, true, 42ULL},
+};
+
+INSTANTIATE_TEST_CASE_P(SparseNormTest,
+                        CSRRowNormalizeFusedTestF,
+                        ::testing::ValuesIn(csrnormalize_fused_inputs_f));
+INSTANTIATE_TEST_CASE_P(SparseNormTest,
+                        CSRRowNormalizeFusedTestD,
+                        ::testing::ValuesIn(csrnormalize_fused_inputs_d));
+
 }  // namespace sparse
 }  // namespace raft
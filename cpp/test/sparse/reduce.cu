@@ -85,6 +85,38 @@ class SparseReduceTest : public ::testing::TestWithParam<SparseReduceInputs<valu
       out_cols.data(), out.cols(), out.nnz, raft::Compare<value_idx>()));
     ASSERT_TRUE(
       raft::devArrMatch<value_t>(out_vals.data(), out.vals(), out.nnz, raft::Compare<value_t>()));
+
+    // flag-aware overload: the test inputs are pre-sorted, so mark the flag
+    // and verify the same reduction falls out
+    raft::sparse::COO<value_t, value_idx> in_coo(stream,
+                                                 (value_idx)params.in_rows.size(),
+                                                 (value_idx)params.m,
+                                                 (value_idx)params.n,
+                                                 false);
+    raft::copy_async(in_coo.rows(), in_rows.data(), params.in_rows.size(), stream);
+    raft::copy_async(in_coo.cols(), in_cols.data(), params.in_cols.size(), stream);
+    raft::copy_async(in_coo.vals(), in_vals.data(), params.in_vals.size(), stream);
+    in_coo.sorted = true;
+
+    raft::sparse::COO<value_t, value_idx> out2(stream);
+    raft::sparse::op::max_duplicates(handle, out2, in_coo);
+    ASSERT_TRUE(out2.sorted);
+    ASSERT_TRUE(out2.unique);
+    ASSERT_TRUE(raft::devArrMatch<value_idx>(
+      out_rows.data(), out2.rows(), out2.nnz, raft::Compare<value_idx>()));
+    ASSERT_TRUE(raft::devArrMatch<value_idx>(
+      out_cols.data(), out2.cols(), out2.nnz, raft::Compare<value_idx>()));
+    ASSERT_TRUE(
+      raft::devArrMatch<value_t>(out_vals.data(), out2.vals(), out2.nnz, raft::Compare<value_t>()));
+
+    // a duplicate-free input passes straight through
+    raft::sparse::COO<value_t, value_idx> out3(stream);
+    raft::sparse::op::max_duplicates(handle, out3, out2);
+    ASSERT_EQ(out3.nnz, out2.nnz);
+    ASSERT_TRUE(raft::devArrMatch<value_idx>(
+      out_rows.data(), out3.rows(), out3.nnz, raft::Compare<value_idx>()));
+    ASSERT_TRUE(
+      raft::devArrMatch<value_t>(out_vals.data(), out3.vals(), out3.nnz, raft::Compare<value_t>()));
   }
 
   void TearDown() override {}
@@ -21,7 +21,10 @@
 
 #include <raft/sparse/op/sort.cuh>
 
+#include <algorithm>
 #include <iostream>
+#include <numeric>
+#include <random>
 
 namespace raft {
 namespace sparse {
@@ -88,5 +91,104 @@ TEST_P(COOSort, Result)
 
 INSTANTIATE_TEST_CASE_P(SparseSortTest, COOSort, ::testing::ValuesIn(inputsf));
 
+// large enough to exercise the segmented radix sort path
+const std::vector<SparseSortInput<float>> inputsf_large = {{500, 600, 150000, 1234ULL}};
+
+typedef SparseSortTest<float> COOSortLarge;
+TEST_P(COOSortLarge, Result)
+{
+  params = ::testing::TestWithParam<SparseSortInput<float>>::GetParam();
+  raft::handle_t h;
+  auto stream = h.get_stream();
+
+  // sample distinct (row, col) pairs so the expected ordering is unique
+  std::mt19937 gen(params.seed);
+  std::vector<int> linear(params.m * params.n);
+  std::iota(linear.begin(), linear.end(), 0);
+  std::shuffle(linear.begin(), linear.end(), gen);
+  linear.resize(params.nnz);
+
+  std::vector<int> in_rows_h(params.nnz), in_cols_h(params.nnz);
+  std::vector<float> in_vals_h(params.nnz);
+  for (int i = 0; i < params.nnz; i++) {
+    in_rows_h[i] = linear[i] / params.n;
+    in_cols_h[i] = linear[i] % params.n;
+    in_vals_h[i] = static_cast<float>(i);
+  }
+
+  rmm::device_uvector<int> in_rows(params.nnz, stream);
+  rmm::device_uvector<int> in_cols(params.nnz, stream);
+  rmm::device_uvector<float> in_vals(params.nnz, stream);
+  raft::update_device(in_rows.data(), in_rows_h.data(), params.nnz, stream);
+  raft::update_device(in_cols.data(), in_cols_h.data(), params.nnz, stream);
+  raft::update_device(in_vals.data(), in_vals_h.data(), params.nnz, stream);
+
+  op::coo_sort(
+    params.m, params.n, params.nnz, in_rows.data(), in_cols.data(), in_vals.data(), stream);
+
+  // expected ordering from a host sort over the combined (row, col) key
+  std::sort(linear.begin(), linear.end());
+  std::vector<int> exp_rows_h(params.nnz), exp_cols_h(params.nnz);
+  for (int i = 0; i < params.nnz; i++) {
+    exp_rows_h[i] = linear[i] / params.n;
+    exp_cols_h[i] = linear[i] % params.n;
+  }
+
+  rmm::device_uvector<int> exp_rows(params.nnz, stream);
+  rmm::device_uvector<int> exp_cols(params.nnz, stream);
+  raft::update_device(exp_rows.data(), exp_rows_h.data(), params.nnz, stream);
+  raft::update_device(exp_cols.data(), exp_cols_h.data(), params.nnz, stream);
+
+  ASSERT_TRUE(raft::devArrMatch<int>(
+    exp_rows.data(), in_rows.data(), params.nnz, raft::Compare<int>(), stream));
+  ASSERT_TRUE(raft::devArrMatch<int>(
+    exp_cols.data(), in_cols.data(), params.nnz, raft::Compare<int>(), stream));
+
+  // the values must have followed their keys
+  std::vector<float> out_vals_h(params.nnz);
+  raft::update_host(out_vals_h.data(), in_vals.data(), params.nnz, stream);
+  RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+  for (int i = 0; i < params.nnz; i++) {
+    int idx = exp_rows_h[i] * params.n + exp_cols_h[i];
+    ASSERT_EQ(in_rows_h[(int)out_vals_h[i]] * params.n + in_cols_h[(int)out_vals_h[i]], idx);
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(SparseSortTest, COOSortLarge, ::testing::ValuesIn(inputsf_large));
+
+TEST(COOSortFlags, SortedFlag)
+{
+  raft::handle_t h;
+  auto stream = h.get_stream();
+
+  std::vector<int> rows_h     = {2, 0, 1};
+  std::vector<int> cols_h     = {0, 1, 2};
+  std::vector<float> vals_h   = {1.0f, 2.0f, 3.0f};
+  std::vector<int> exp_rows_h = {0, 1, 2};
+
+  COO<float> in(stream, 3, 3, 3, false);
+  ASSERT_FALSE(in.sorted);
+  ASSERT_FALSE(in.unique);
+  raft::update_device(in.rows(), rows_h.data(), 3, stream);
+  raft::update_device(in.cols(), cols_h.data(), 3, stream);
+  raft::update_device(in.vals(), vals_h.data(), 3, stream);
+
+  op::coo_sort(&in, stream);
+  ASSERT_TRUE(in.sorted);
+
+  // a second call trusts the flag and leaves the (sorted) data untouched
+  op::coo_sort(&in, stream);
+
+  rmm::device_uvector<int> exp_rows(3, stream);
+  raft::update_device(exp_rows.data(), exp_rows_h.data(), 3, stream);
+  ASSERT_TRUE(
+    raft::devArrMatch<int>(exp_rows.data(), in.rows(), 3, raft::Compare<int>(), stream));
+
+  // reallocation invalidates the established invariants
+  in.allocate(3, 3, 3, false, stream);
+  ASSERT_FALSE(in.sorted);
+  ASSERT_FALSE(in.unique);
+}
+
 }  // namespace sparse
 }  // namespace raft
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <raft/sparse/op/row_op.cuh>
+#include <raft/sparse/structure_stats.cuh>
+
+#include "../test_utils.h"
+#include <raft/cudart_utils.h>
+
+#include <vector>
+
+namespace raft {
+namespace sparse {
+
+/** Builds the CSR row offsets for the given row lengths and computes stats. */
+template <typename Index_>
+structure_stats_t<Index_> stats_of(raft::handle_t& handle, const std::vector<Index_>& row_lens)
+{
+  auto stream = handle.get_stream();
+  std::vector<Index_> h_indptr(row_lens.size() + 1, 0);
+  for (size_t i = 0; i < row_lens.size(); i++) {
+    h_indptr[i + 1] = h_indptr[i] + row_lens[i];
+  }
+  rmm::device_uvector<Index_> indptr(h_indptr.size(), stream);
+  raft::update_device(indptr.data(), h_indptr.data(), h_indptr.size(), stream);
+  return compute_structure_stats(
+    indptr.data(), Index_(row_lens.size()), h_indptr.back(), stream);
+}
+
+TEST(StructureStats, Uniform)
+{
+  raft::handle_t handle;
+  std::vector<int> row_lens(100, 4);
+  auto stats = stats_of(handle, row_lens);
+
+  EXPECT_EQ(stats.n_rows, 100);
+  EXPECT_EQ(stats.nnz, 400);
+  EXPECT_EQ(stats.max_row_len, 4);
+  EXPECT_EQ(stats.p99_row_len, 4);
+  EXPECT_DOUBLE_EQ(stats.mean_row_len, 4.0);
+  EXPECT_NEAR(stats.row_len_std, 0.0, 1e-9);
+  EXPECT_FALSE(stats.has_high_row_length_variance());
+}
+
+TEST(StructureStats, Skewed)
+{
+  raft::handle_t handle;
+  // a single power-law hub row among unit-length rows
+  std::vector<int> row_lens(100, 1);
+  row_lens[42] = 1000;
+  auto stats   = stats_of(handle, row_lens);
+
+  EXPECT_EQ(stats.nnz, 1099);
+  EXPECT_EQ(stats.max_row_len, 1000);
+  EXPECT_EQ(stats.p99_row_len, 1000);
+  EXPECT_NEAR(stats.mean_row_len, 10.99, 1e-9);
+  EXPECT_TRUE(stats.has_high_row_length_variance());
+}
+
+TEST(StructureStats, Empty)
+{
+  raft::handle_t handle;
+  auto stats = stats_of(handle, std::vector<int>{});
+
+  EXPECT_EQ(stats.n_rows, 0);
+  EXPECT_EQ(stats.nnz, 0);
+  EXPECT_EQ(stats.max_row_len, 0);
+  EXPECT_FALSE(stats.has_high_row_length_variance());
+}
+
+TEST(StructureStats, RowOpDispatch)
+{
+  raft::handle_t handle;
+  auto stream = handle.get_stream();
+
+  // skewed lengths exercise the small-block launch; the result must match
+  // the default launch shape exactly
+  std::vector<int> h_indptr{0, 6, 7, 8, 9};
+  const int n_rows = 4;
+  const int nnz    = 9;
+  rmm::device_uvector<int> indptr(h_indptr.size(), stream);
+  raft::update_device(indptr.data(), h_indptr.data(), h_indptr.size(), stream);
+
+  auto stats = compute_structure_stats(indptr.data(), n_rows, nnz, stream);
+  EXPECT_TRUE(stats.has_high_row_length_variance());
+
+  rmm::device_uvector<int> expected(nnz, stream);
+  rmm::device_uvector<int> result(nnz, stream);
+  int* d_expected = expected.data();
+  int* d_result   = result.data();
+  op::csr_row_op<int>(
+    indptr.data(),
+    n_rows,
+    nnz,
+    [d_expected] __device__(int row, int start_idx, int stop_idx) {
+      for (int i = start_idx; i < stop_idx; i++)
+        d_expected[i] = row;
+    },
+    stream);
+  op::csr_row_op<int>(
+    indptr.data(),
+    n_rows,
+    nnz,
+    stats,
+    [d_result] __device__(int row, int start_idx, int stop_idx) {
+      for (int i = start_idx; i < stop_idx; i++)
+        d_result[i] = row;
+    },
+    stream);
+
+  ASSERT_TRUE(
+    raft::devArrMatch<int>(expected.data(), result.data(), nnz, raft::Compare<int>(), stream));
+}
+
+}  // namespace sparse
+}  // namespace raft
@@ -25,6 +25,9 @@
 #include "../test_utils.h"
 
 #include <iostream>
+#include <map>
+#include <utility>
+#include <vector>
 
 namespace raft {
 namespace sparse {
@@ -109,7 +112,9 @@ class SparseSymmetrizeTest
     assert_symmetry<<<raft::ceildiv(out.nnz, 256), 256, 0, stream>>>(
       out.rows(), out.cols(), out.vals(), out.nnz, sum.data());
 
-    sum_h = sum.value(stream);
+    sum_h   = sum.value(stream);
+    out_nnz = out.nnz;
+    in_nnz  = nnz;
     handle.sync_stream(stream);
   }
 
@@ -122,6 +127,7 @@ class SparseSymmetrizeTest
   rmm::device_uvector<value_t> data;
 
   value_idx sum_h;
+  value_idx out_nnz, in_nnz;
 
   SparseSymmetrizeInputs<value_idx, value_t> params;
 };
@@ -209,11 +215,61 @@ const std::vector<SparseSymmetrizeInputs<int, float>> symm_inputs_fint = {
 };
 
 typedef SparseSymmetrizeTest<int, float> SparseSymmetrizeTestF_int;
-TEST_P(SparseSymmetrizeTestF_int, Result) { ASSERT_TRUE(sum_h == 0); }
+TEST_P(SparseSymmetrizeTestF_int, Result)
+{
+  ASSERT_TRUE(sum_h == 0);
+
+  // edges with a reciprocal are merged, so the output can never exceed
+  // the input plus one mirror per edge
+  ASSERT_LE(out_nnz, 2 * in_nnz);
+}
 
 INSTANTIATE_TEST_CASE_P(SparseSymmetrizeTest,
                         SparseSymmetrizeTestF_int,
                         ::testing::ValuesIn(symm_inputs_fint));
 
+// literal duplicate (row, col) entries must merge to their max before the
+// reciprocal lookups, matching the old concat + max_duplicates contract
+TEST(SparseSymmetrize, DuplicateEntries)
+{
+  raft::handle_t handle;
+  auto stream = handle.get_stream();
+
+  // (0, 1) appears twice; (1, 0) is its reciprocal; (2, 0) has no reciprocal
+  int nnz                 = 4;
+  std::vector<int> rows_h = {0, 0, 1, 2};
+  std::vector<int> cols_h = {1, 1, 0, 0};
+  std::vector<float> vals_h = {1.0f, 3.0f, 2.0f, 4.0f};
+
+  rmm::device_uvector<int> rows(nnz, stream);
+  rmm::device_uvector<int> cols(nnz, stream);
+  rmm::device_uvector<float> vals(nnz, stream);
+  raft::update_device(rows.data(), rows_h.data(), nnz, stream);
+  raft::update_device(cols.data(), cols_h.data(), nnz, stream);
+  raft::update_device(vals.data(), vals_h.data(), nnz, stream);
+
+  raft::sparse::COO<float, int> out(stream);
+  raft::sparse::linalg::symmetrize(
+    handle, rows.data(), cols.data(), vals.data(), 3, 3, size_t(nnz), out);
+
+  std::vector<int> out_rows(out.nnz), out_cols(out.nnz);
+  std::vector<float> out_vals(out.nnz);
+  raft::update_host(out_rows.data(), out.rows(), out.nnz, stream);
+  raft::update_host(out_cols.data(), out.cols(), out.nnz, stream);
+  raft::update_host(out_vals.data(), out.vals(), out.nnz, stream);
+  handle.sync_stream(stream);
+
+  // the duplicate merges to 3.0, the reciprocal pair resolves to
+  // max(3.0, 2.0) in both directions, and (2, 0) gains its mirror
+  std::map<std::pair<int, int>, float> expected = {
+    {{0, 1}, 3.0f}, {{1, 0}, 3.0f}, {{2, 0}, 4.0f}, {{0, 2}, 4.0f}};
+  ASSERT_EQ(out.nnz, int(expected.size()));
+  for (int i = 0; i < out.nnz; i++) {
+    auto it = expected.find({out_rows[i], out_cols[i]});
+    ASSERT_TRUE(it != expected.end());
+    ASSERT_EQ(it->second, out_vals[i]);
+  }
+}
+
 }  // namespace sparse
 }  // namespace raft
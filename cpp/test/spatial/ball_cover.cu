@@ -324,7 +324,71 @@ class BallCoverAllKNNTest : public ::testing::TestWithParam<BallCoverInputs> {
   BallCoverInputs params;
 };
 
+// the reciprocal candidate merge only adds exact candidates, so exact
+// queries must return the same neighborhoods with it on or off
+template <typename value_idx, typename value_t>
+class BallCoverAllKNNReciprocalTest : public ::testing::TestWithParam<BallCoverInputs> {
+ protected:
+  void basicTest()
+  {
+    params = ::testing::TestWithParam<BallCoverInputs>::GetParam();
+    raft::handle_t handle;
+
+    uint32_t k         = params.k;
+    uint32_t n_centers = 25;
+    auto metric        = params.metric;
+
+    rmm::device_uvector<value_t> X(params.n_rows * params.n_cols, handle.get_stream());
+    rmm::device_uvector<uint32_t> Y(params.n_rows, handle.get_stream());
+
+    raft::random::make_blobs(
+      X.data(), Y.data(), params.n_rows, params.n_cols, n_centers, handle.get_stream());
+
+    rmm::device_uvector<value_idx> I_rec(params.n_rows * k, handle.get_stream());
+    rmm::device_uvector<value_t> D_rec(params.n_rows * k, handle.get_stream());
+    rmm::device_uvector<value_idx> I_base(params.n_rows * k, handle.get_stream());
+    rmm::device_uvector<value_t> D_base(params.n_rows * k, handle.get_stream());
+
+    {
+      BallCoverIndex<value_idx, value_t> index(
+        handle, X.data(), params.n_rows, params.n_cols, metric);
+      raft::spatial::knn::rbc_all_knn_query(
+        handle, index, k, I_rec.data(), D_rec.data(), true, params.weight, true);
+    }
+    {
+      BallCoverIndex<value_idx, value_t> index(
+        handle, X.data(), params.n_rows, params.n_cols, metric);
+      raft::spatial::knn::rbc_all_knn_query(
+        handle, index, k, I_base.data(), D_base.data(), true, params.weight, false);
+    }
+    handle.sync_stream();
+
+    rmm::device_uvector<uint32_t> discrepancies(params.n_rows, handle.get_stream());
+    thrust::fill(handle.get_thrust_policy(),
+                 discrepancies.data(),
+                 discrepancies.data() + discrepancies.size(),
+                 0);
+    uint32_t res = count_discrepancies(I_base.data(),
+                                       I_rec.data(),
+                                       D_base.data(),
+                                       D_rec.data(),
+                                       params.n_rows,
+                                       k,
+                                       discrepancies.data(),
+                                       handle.get_stream());
+    ASSERT_TRUE(res <= 5);
+  }
+
+  void SetUp() override {}
+
+  void TearDown() override {}
+
+ protected:
+  BallCoverInputs params;
+};
+
 typedef BallCoverAllKNNTest<int64_t, float> BallCoverAllKNNTestF;
+typedef BallCoverAllKNNReciprocalTest<int64_t, float> BallCoverAllKNNReciprocalTestF;
 typedef BallCoverKNNQueryTest<int64_t, float> BallCoverKNNQueryTestF;
 
 const std::vector<BallCoverInputs> ballcover_inputs = {
@@ -341,11 +405,15 @@ const std::vector<BallCoverInputs> ballcover_inputs = {
 INSTANTIATE_TEST_CASE_P(BallCoverAllKNNTest,
                         BallCoverAllKNNTestF,
                         ::testing::ValuesIn(ballcover_inputs));
+INSTANTIATE_TEST_CASE_P(BallCoverAllKNNReciprocalTest,
+                        BallCoverAllKNNReciprocalTestF,
+                        ::testing::ValuesIn(ballcover_inputs));
 INSTANTIATE_TEST_CASE_P(BallCoverKNNQueryTest,
                         BallCoverKNNQueryTestF,
                         ::testing::ValuesIn(ballcover_inputs));
 
 TEST_P(BallCoverAllKNNTestF, Fit) { basicTest(); }
+TEST_P(BallCoverAllKNNReciprocalTestF, Fit) { basicTest(); }
 TEST_P(BallCoverKNNQueryTestF, Fit) { basicTest(); }
 
 }  // namespace knn
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils.h"
+#include <gtest/gtest.h>
+#include <raft/cudart_utils.h>
+#include <raft/random/rng.cuh>
+#include <raft/spatial/knn/dynamic_index.cuh>
+#include <raft/spatial/knn/knn.cuh>
+
+#include <cstdint>
+#include <set>
+#include <vector>
+
+namespace raft {
+namespace spatial {
+namespace knn {
+
+/** Reference distances: brute force over a host-filtered copy of the corpus. */
+void live_rows_reference(raft::handle_t& handle,
+                         const std::vector<float>& h_data,
+                         const std::set<int64_t>& removed,
+                         int dim,
+                         const float* queries,
+                         int n_queries,
+                         int k,
+                         raft::distance::DistanceType metric,
+                         rmm::device_uvector<float>& ref_D)
+{
+  auto stream = handle.get_stream();
+  std::vector<float> h_live;
+  for (size_t row = 0; row < h_data.size() / dim; row++) {
+    if (removed.count(int64_t(row)) == 0) {
+      for (int j = 0; j < dim; j++) {
+        h_live.push_back(h_data[row * dim + j]);
+      }
+    }
+  }
+  const int n_live = h_live.size() / dim;
+  rmm::device_uvector<float> live(h_live.size(), stream);
+  raft::update_device(live.data(), h_live.data(), h_live.size(), stream);
+
+  rmm::device_uvector<int64_t> ref_I(size_t(n_queries) * k, stream);
+  std::vector<float*> input{live.data()};
+  std::vector<int> sizes{n_live};
+  brute_force_knn(handle,
+                  input,
+                  sizes,
+                  dim,
+                  const_cast<float*>(queries),
+                  n_queries,
+                  ref_I.data(),
+                  ref_D.data(),
+                  k,
+                  true,
+                  true,
+                  nullptr,
+                  metric);
+}
+
+TEST(DynamicIndex, BruteForceAddRemoveCompact)
+{
+  raft::handle_t handle;
+  auto stream = handle.get_stream();
+
+  constexpr int64_t n_rows  = 600;
+  constexpr int dim         = 8;
+  constexpr int n_queries   = 20;
+  constexpr int k           = 10;
+  const auto metric         = raft::distance::DistanceType::L2Expanded;
+
+  rmm::device_uvector<float> data(n_rows * dim, stream);
+  rmm::device_uvector<float> queries(n_queries * dim, stream);
+  raft::random::RngState r(37);
+  uniform(handle, r, data.data(), data.size(), -1.0f, 1.0f);
+  uniform(handle, r, queries.data(), queries.size(), -1.0f, 1.0f);
+  std::vector<float> h_data(data.size());
+  raft::update_host(h_data.data(), data.data(), data.size(), stream);
+  handle.sync_stream(stream);
+
+  // append in two batches, then tombstone every seventh row
+  dynamic_brute_force_index<float, int64_t> index(handle, metric, dim);
+  brute_force_add(handle, index, data.data(), int64_t(400));
+  brute_force_add(handle, index, data.data() + 400 * dim, int64_t(n_rows - 400));
+  ASSERT_EQ(index.size, n_rows);
+
+  std::vector<int64_t> h_removed;
+  for (int64_t i = 0; i < n_rows; i += 7) {
+    h_removed.push_back(i);
+  }
+  rmm::device_uvector<int64_t> removed(h_removed.size(), stream);
+  raft::update_device(removed.data(), h_removed.data(), h_removed.size(), stream);
+  brute_force_remove(handle, index, removed.data(), int64_t(h_removed.size()));
+  ASSERT_EQ(index.n_deleted, int64_t(h_removed.size()));
+
+  // removing the same rows again must not change the tombstone count
+  brute_force_remove(handle, index, removed.data(), int64_t(h_removed.size()));
+  ASSERT_EQ(index.n_deleted, int64_t(h_removed.size()));
+
+  rmm::device_uvector<int64_t> res_I(size_t(n_queries) * k, stream);
+  rmm::device_uvector<float> res_D(size_t(n_queries) * k, stream);
+  brute_force_search(handle, index, queries.data(), n_queries, res_I.data(), res_D.data(), k);
+
+  std::set<int64_t> removed_set(h_removed.begin(), h_removed.end());
+  rmm::device_uvector<float> ref_D(size_t(n_queries) * k, stream);
+  live_rows_reference(
+    handle, h_data, removed_set, dim, queries.data(), n_queries, k, metric, ref_D);
+  ASSERT_TRUE(devArrMatch(
+    ref_D.data(), res_D.data(), size_t(n_queries) * k, raft::CompareApprox<float>(1e-4f), stream));
+
+  // no tombstoned row may be reported
+  std::vector<int64_t> h_res_I(res_I.size());
+  raft::update_host(h_res_I.data(), res_I.data(), res_I.size(), stream);
+  handle.sync_stream(stream);
+  for (auto id : h_res_I) {
+    ASSERT_EQ(removed_set.count(id), 0u);
+  }
+
+  // compaction drops the tombstones but must not change the distances
+  brute_force_compact(handle, index);
+  ASSERT_EQ(index.n_deleted, int64_t(0));
+  ASSERT_EQ(index.size, n_rows - int64_t(h_removed.size()));
+  brute_force_search(handle, index, queries.data(), n_queries, res_I.data(), res_D.data(), k);
+  ASSERT_TRUE(devArrMatch(
+    ref_D.data(), res_D.data(), size_t(n_queries) * k, raft::CompareApprox<float>(1e-4f), stream));
+}
+
+TEST(DynamicIndex, BallCoverAddRemoveRebuild)
+{
+  raft::handle_t handle;
+  auto stream = handle.get_stream();
+
+  constexpr uint32_t n_base   = 500;
+  constexpr uint32_t n_tail   = 100;
+  constexpr int dim           = 2;
+  constexpr uint32_t n_query  = 25;
+  constexpr uint32_t k        = 8;
+  const auto metric           = raft::distance::DistanceType::Haversine;
+
+  rmm::device_uvector<float> data((n_base + n_tail) * dim, stream);
+  rmm::device_uvector<float> queries(n_query * dim, stream);
+  raft::random::RngState r(38);
+  uniform(handle, r, data.data(), data.size(), -1.0f, 1.0f);
+  uniform(handle, r, queries.data(), queries.size(), -1.0f, 1.0f);
+  std::vector<float> h_data(data.size());
+  raft::update_host(h_data.data(), data.data(), data.size(), stream);
+  handle.sync_stream(stream);
+
+  dynamic_ball_cover_index<int64_t, float> index(handle, metric, dim);
+  rbc_rebuild(handle, index, data.data(), n_base);
+  rbc_add_points(handle, index, data.data() + n_base * dim, n_tail);
+  ASSERT_EQ(index.n_tail, n_tail);
+
+  // tombstone rows in both the base and the tail
+  std::vector<int64_t> h_removed;
+  for (int64_t i = 3; i < int64_t(n_base + n_tail); i += 15) {
+    h_removed.push_back(i);
+  }
+  rmm::device_uvector<int64_t> removed(h_removed.size(), stream);
+  raft::update_device(removed.data(), h_removed.data(), h_removed.size(), stream);
+  rbc_remove_points(handle, index, removed.data(), int64_t(h_removed.size()));
+  ASSERT_EQ(index.n_deleted, uint32_t(h_removed.size()));
+
+  rmm::device_uvector<int64_t> res_I(size_t(n_query) * k, stream);
+  rmm::device_uvector<float> res_D(size_t(n_query) * k, stream);
+  rbc_knn_query(handle, index, k, queries.data(), n_query, res_I.data(), res_D.data());
+
+  std::set<int64_t> removed_set(h_removed.begin(), h_removed.end());
+  rmm::device_uvector<float> ref_D(size_t(n_query) * k, stream);
+  live_rows_reference(
+    handle, h_data, removed_set, dim, queries.data(), int(n_query), int(k), metric, ref_D);
+  ASSERT_TRUE(devArrMatch(
+    ref_D.data(), res_D.data(), size_t(n_query) * k, raft::CompareApprox<float>(1e-4f), stream));
+
+  std::vector<int64_t> h_res_I(res_I.size());
+  raft::update_host(h_res_I.data(), res_I.data(), res_I.size(), stream);
+  handle.sync_stream(stream);
+  for (auto id : h_res_I) {
+    ASSERT_EQ(removed_set.count(id), 0u);
+  }
+
+  // rebuilding folds the tail, drops the tombstones and preserves the results
+  rbc_rebuild(handle, index);
+  ASSERT_EQ(index.n_tail, uint32_t(0));
+  ASSERT_EQ(index.n_deleted, uint32_t(0));
+  ASSERT_EQ(index.n_base, n_base + n_tail - uint32_t(h_removed.size()));
+  rbc_knn_query(handle, index, k, queries.data(), n_query, res_I.data(), res_D.data());
+  ASSERT_TRUE(devArrMatch(
+    ref_D.data(), res_D.data(), size_t(n_query) * k, raft::CompareApprox<float>(1e-4f), stream));
+}
+
+}  // namespace knn
+}  // namespace spatial
+}  // namespace raft
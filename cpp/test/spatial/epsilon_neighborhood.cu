@@ -15,8 +15,10 @@
  */
 
 #include "../test_utils.h"
+#include <algorithm>
 #include <gtest/gtest.h>
 #include <memory>
+#include <vector>
 #include <raft/cudart_utils.h>
 #include <raft/random/make_blobs.cuh>
 #include <raft/spatial/knn/epsilon_neighborhood.cuh>
@@ -108,6 +110,126 @@ TEST_P(EpsNeighTestFI, Result)
 }
 INSTANTIATE_TEST_CASE_P(EpsNeighTests, EpsNeighTestFI, ::testing::ValuesIn(inputsfi));
 
+// a multi-epsilon call must match the corresponding single-epsilon calls
+// bit for bit, for every threshold
+typedef EpsNeighTest<float, int> EpsNeighMultiTestFI;
+TEST_P(EpsNeighMultiTestFI, Result)
+{
+  std::vector<float> h_eps = {param.eps * param.eps * 0.25f,
+                              param.eps * param.eps,
+                              param.eps * param.eps * 4.f};
+  int n_eps = h_eps.size();
+  rmm::device_uvector<float> eps(n_eps, stream);
+  raft::update_device(eps.data(), h_eps.data(), n_eps, stream);
+
+  rmm::device_uvector<bool> adj_multi(n_eps * param.n_row * batchSize, stream);
+  rmm::device_uvector<int> vd_multi(n_eps * (batchSize + 1), stream);
+  RAFT_CUDA_TRY(
+    cudaMemsetAsync(vd_multi.data(), 0, vd_multi.size() * sizeof(int), stream));
+  epsUnexpL2SqMultiNeighborhood<float, int>(adj_multi.data(),
+                                            vd_multi.data(),
+                                            data.data(),
+                                            data.data(),
+                                            param.n_row,
+                                            batchSize,
+                                            param.n_col,
+                                            eps.data(),
+                                            n_eps,
+                                            stream);
+
+  for (int e = 0; e < n_eps; ++e) {
+    RAFT_CUDA_TRY(cudaMemsetAsync(adj.data(), 0, sizeof(bool) * param.n_row * batchSize, stream));
+    RAFT_CUDA_TRY(cudaMemsetAsync(vd.data(), 0, sizeof(int) * (batchSize + 1), stream));
+    epsUnexpL2SqNeighborhood<float, int>(adj.data(),
+                                         vd.data(),
+                                         data.data(),
+                                         data.data(),
+                                         param.n_row,
+                                         batchSize,
+                                         param.n_col,
+                                         h_eps[e],
+                                         stream);
+    ASSERT_TRUE(raft::devArrMatch(adj.data(),
+                                  adj_multi.data() + e * param.n_row * batchSize,
+                                  param.n_row * batchSize,
+                                  raft::Compare<bool>(),
+                                  stream))
+      << "eps plane " << e;
+    ASSERT_TRUE(raft::devArrMatch(vd.data(),
+                                  vd_multi.data() + e * (batchSize + 1),
+                                  batchSize + 1,
+                                  raft::Compare<int>(),
+                                  stream))
+      << "vd plane " << e;
+  }
+}
+
+const std::vector<EpsInputs<float, int>> inputs_multi_fi = {
+  {1500, 16, 5, 1, 2.f},
+  {1400, 17, 5, 1, 2.f},
+  {2000, 32, 10, 1, 2.f},
+};
+INSTANTIATE_TEST_CASE_P(EpsNeighMultiTests,
+                        EpsNeighMultiTestFI,
+                        ::testing::ValuesIn(inputs_multi_fi));
+
+// the CSR output must contain exactly the true entries of the dense adjacency
+typedef EpsNeighTest<float, int> EpsNeighCsrTestFI;
+TEST_P(EpsNeighCsrTestFI, Result)
+{
+  RAFT_CUDA_TRY(cudaMemsetAsync(adj.data(), 0, sizeof(bool) * param.n_row * batchSize, stream));
+  epsUnexpL2SqNeighborhood<float, int>(adj.data(),
+                                       nullptr,
+                                       data.data(),
+                                       data.data(),
+                                       param.n_row,
+                                       batchSize,
+                                       param.n_col,
+                                       param.eps * param.eps,
+                                       stream);
+
+  rmm::device_uvector<int> indptr(param.n_row + 1, stream);
+  rmm::device_uvector<int> adj_cols(0, stream);
+  epsUnexpL2SqNeighborhoodCsr<float, int>(indptr.data(),
+                                          adj_cols,
+                                          data.data(),
+                                          data.data(),
+                                          param.n_row,
+                                          batchSize,
+                                          param.n_col,
+                                          param.eps * param.eps,
+                                          stream);
+
+  std::vector<uint8_t> h_adj(param.n_row * batchSize);
+  std::vector<int> h_indptr(param.n_row + 1);
+  std::vector<int> h_cols(adj_cols.size());
+  raft::update_host(reinterpret_cast<uint8_t*>(h_adj.data()),
+                    reinterpret_cast<uint8_t*>(adj.data()),
+                    h_adj.size(),
+                    stream);
+  raft::update_host(h_indptr.data(), indptr.data(), h_indptr.size(), stream);
+  raft::update_host(h_cols.data(), adj_cols.data(), h_cols.size(), stream);
+  RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+
+  for (int i = 0; i < param.n_row; ++i) {
+    std::vector<int> dense_cols;
+    for (int j = 0; j < batchSize; ++j) {
+      if (h_adj[i * batchSize + j]) { dense_cols.push_back(j); }
+    }
+    std::vector<int> csr_cols(h_cols.begin() + h_indptr[i], h_cols.begin() + h_indptr[i + 1]);
+    std::sort(csr_cols.begin(), csr_cols.end());
+    ASSERT_EQ(dense_cols, csr_cols) << "row " << i;
+  }
+  ASSERT_EQ(h_indptr[param.n_row], static_cast<int>(h_cols.size()));
+}
+
+const std::vector<EpsInputs<float, int>> inputs_csr_fi = {
+  {1500, 16, 5, 1, 2.f},
+  {1400, 17, 5, 1, 2.f},
+  {2000, 32, 10, 1, 2.f},
+};
+INSTANTIATE_TEST_CASE_P(EpsNeighCsrTests, EpsNeighCsrTestFI, ::testing::ValuesIn(inputs_csr_fi));
+
 };  // namespace knn
 };  // namespace spatial
 };  // namespace raft
@@ -130,6 +130,9 @@ class FusedL2KNNTest : public ::testing::TestWithParam<FusedL2KNNInputs> {
  protected:
   void testBruteForce()
   {
+    if (k_ > detail::fusedL2KnnMaxK()) {
+      GTEST_SKIP() << "k exceeds the fused kernel limit on this device";
+    }
     launchFaissBfknn();
     detail::fusedL2Knn(dim,
                        raft_indices_.data(),
@@ -224,6 +227,9 @@ const std::vector<FusedL2KNNInputs> inputs = {
   {1000, 10000, 32, 50, raft::distance::DistanceType::L2Expanded},
   {10000, 40000, 32, 30, raft::distance::DistanceType::L2Expanded},
   {131072, 131072, 8, 60, raft::distance::DistanceType::L2Expanded},
+  {100, 1000, 16, 100, raft::distance::DistanceType::L2Expanded},
+  {1000, 10000, 32, 100, raft::distance::DistanceType::L2Expanded},
+  {100, 10000, 16, 256, raft::distance::DistanceType::L2Expanded},
   // L2 unexpanded
   {100, 1000, 16, 10, raft::distance::DistanceType::L2Unexpanded},
   {1000, 10000, 16, 10, raft::distance::DistanceType::L2Unexpanded},
@@ -232,7 +238,18 @@ const std::vector<FusedL2KNNInputs> inputs = {
   {1000, 10000, 16, 50, raft::distance::DistanceType::L2Unexpanded},
   {1000, 10000, 32, 50, raft::distance::DistanceType::L2Unexpanded},
   {10000, 40000, 32, 30, raft::distance::DistanceType::L2Unexpanded},
-  {131072, 131072, 8, 60, raft::distance::DistanceType::L2Unexpanded}};
+  {131072, 131072, 8, 60, raft::distance::DistanceType::L2Unexpanded},
+  {100, 1000, 16, 100, raft::distance::DistanceType::L2Unexpanded},
+  {1000, 10000, 32, 256, raft::distance::DistanceType::L2Unexpanded},
+  // inner product
+  {100, 1000, 16, 10, raft::distance::DistanceType::InnerProduct},
+  {256, 256, 30, 10, raft::distance::DistanceType::InnerProduct},
+  {1000, 10000, 16, 10, raft::distance::DistanceType::InnerProduct},
+  {100, 1000, 16, 50, raft::distance::DistanceType::InnerProduct},
+  {1000, 10000, 32, 50, raft::distance::DistanceType::InnerProduct},
+  {10000, 40000, 32, 30, raft::distance::DistanceType::InnerProduct},
+  {100, 1000, 16, 100, raft::distance::DistanceType::InnerProduct},
+  {1000, 10000, 32, 256, raft::distance::DistanceType::InnerProduct}};
 
 typedef FusedL2KNNTest<float> FusedL2KNNTestF;
 TEST_P(FusedL2KNNTestF, FusedBruteForce) { this->testBruteForce(); }
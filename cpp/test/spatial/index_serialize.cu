@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils.h"
+#include <gtest/gtest.h>
+#include <raft/cudart_utils.h>
+#include <raft/random/rng.cuh>
+#include <raft/spatial/knn/ball_cover.cuh>
+#include <raft/spatial/knn/ball_cover_serialize.hpp>
+#include <raft/spatial/knn/ivf_flat.cuh>
+#include <raft/spatial/knn/ivf_flat_serialize.hpp>
+
+#include <sstream>
+#include <vector>
+
+namespace raft {
+namespace spatial {
+namespace knn {
+
+TEST(IndexSerialize, BallCoverRoundTrip)
+{
+  raft::handle_t handle;
+  auto stream = handle.get_stream();
+
+  constexpr uint32_t n_rows    = 500;
+  constexpr uint32_t n_queries = 25;
+  constexpr uint32_t k         = 8;
+  const auto metric            = raft::distance::DistanceType::Haversine;
+
+  rmm::device_uvector<float> X(n_rows * 2, stream);
+  rmm::device_uvector<float> queries(n_queries * 2, stream);
+  raft::random::RngState r(17);
+  uniform(handle, r, X.data(), X.size(), -1.0f, 1.0f);
+  uniform(handle, r, queries.data(), queries.size(), -1.0f, 1.0f);
+
+  BallCoverIndex<int64_t, float> built(handle, X.data(), n_rows, 2, metric);
+  rbc_build_index(handle, built);
+
+  std::stringstream ss(std::ios::in | std::ios::out | std::ios::binary);
+  rbc_serialize(built, ss);
+
+  BallCoverIndex<int64_t, float> loaded(handle, X.data(), n_rows, 2, metric);
+  rbc_deserialize(loaded, ss);
+  ASSERT_TRUE(loaded.is_index_trained());
+
+  rmm::device_uvector<int64_t> inds_a(n_queries * k, stream);
+  rmm::device_uvector<float> dists_a(n_queries * k, stream);
+  rmm::device_uvector<int64_t> inds_b(n_queries * k, stream);
+  rmm::device_uvector<float> dists_b(n_queries * k, stream);
+  rbc_knn_query(handle, built, k, queries.data(), n_queries, inds_a.data(), dists_a.data());
+  rbc_knn_query(handle, loaded, k, queries.data(), n_queries, inds_b.data(), dists_b.data());
+
+  ASSERT_TRUE(
+    devArrMatch(inds_a.data(), inds_b.data(), n_queries * k, raft::Compare<int64_t>(), stream));
+  ASSERT_TRUE(
+    devArrMatch(dists_a.data(), dists_b.data(), n_queries * k, raft::Compare<float>(), stream));
+}
+
+TEST(IndexSerialize, BallCoverMismatchThrows)
+{
+  raft::handle_t handle;
+  auto stream = handle.get_stream();
+
+  rmm::device_uvector<float> X(200 * 2, stream);
+  raft::random::RngState r(18);
+  uniform(handle, r, X.data(), X.size(), -1.0f, 1.0f);
+
+  BallCoverIndex<int64_t, float> built(
+    handle, X.data(), 200, 2, raft::distance::DistanceType::Haversine);
+  rbc_build_index(handle, built);
+  std::stringstream ss(std::ios::in | std::ios::out | std::ios::binary);
+  rbc_serialize(built, ss);
+
+  // same data but a different metric: the header check must reject the file
+  BallCoverIndex<int64_t, float> wrong(
+    handle, X.data(), 200, 2, raft::distance::DistanceType::L2SqrtExpanded);
+  ASSERT_THROW(rbc_deserialize(wrong, ss), raft::exception);
+}
+
+TEST(IndexSerialize, IvfFlatRoundTrip)
+{
+  raft::handle_t handle;
+  auto stream = handle.get_stream();
+
+  constexpr int n_rows    = 2000;
+  constexpr int n_queries = 32;
+  constexpr int dim       = 16;
+  constexpr int k         = 10;
+
+  rmm::device_uvector<float> database(n_rows * dim, stream);
+  rmm::device_uvector<float> queries(n_queries * dim, stream);
+  raft::random::RngState r(19);
+  uniform(handle, r, database.data(), database.size(), -1.0f, 1.0f);
+  uniform(handle, r, queries.data(), queries.size(), -1.0f, 1.0f);
+
+  ivf_flat::index_params ip;
+  ip.n_lists = 32;
+  auto built = ivf_flat::build<float, int64_t>(
+    handle, ip, database.data(), int64_t(n_rows), dim, raft::distance::DistanceType::L2Expanded);
+
+  std::stringstream ss(std::ios::in | std::ios::out | std::ios::binary);
+  ivf_flat::serialize(handle, built, ss);
+  auto loaded = ivf_flat::deserialize<float, int64_t>(handle, ss);
+
+  ASSERT_EQ(loaded.n_lists, built.n_lists);
+  ASSERT_EQ(loaded.dim, built.dim);
+  ASSERT_EQ(loaded.size, built.size);
+
+  ivf_flat::search_params sp;
+  sp.n_probes = 32;
+  rmm::device_uvector<int64_t> inds_a(n_queries * k, stream);
+  rmm::device_uvector<float> dists_a(n_queries * k, stream);
+  rmm::device_uvector<int64_t> inds_b(n_queries * k, stream);
+  rmm::device_uvector<float> dists_b(n_queries * k, stream);
+  ivf_flat::search<float, int64_t>(
+    handle, sp, built, queries.data(), n_queries, k, inds_a.data(), dists_a.data());
+  ivf_flat::search<float, int64_t>(
+    handle, sp, loaded, queries.data(), n_queries, k, inds_b.data(), dists_b.data());
+
+  ASSERT_TRUE(
+    devArrMatch(inds_a.data(), inds_b.data(), n_queries * k, raft::Compare<int64_t>(), stream));
+  ASSERT_TRUE(
+    devArrMatch(dists_a.data(), dists_b.data(), n_queries * k, raft::Compare<float>(), stream));
+}
+
+}  // namespace knn
+}  // namespace spatial
+}  // namespace raft
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils.h"
+#include <gtest/gtest.h>
+#include <raft/cudart_utils.h>
+#include <raft/random/rng.cuh>
+#include <raft/spatial/knn/ivf_pq.cuh>
+
+#include <algorithm>
+#include <numeric>
+#include <unordered_set>
+#include <vector>
+
+namespace raft {
+namespace spatial {
+namespace knn {
+
+struct IvfPqInputs {
+  double min_recall;
+  int n_rows, n_queries, dim, k;
+  uint32_t pq_dim;
+  uint32_t n_lists, n_probes;
+  raft::distance::DistanceType metric;
+  unsigned long long int seed;
+};
+
+class IvfPqTest : public ::testing::TestWithParam<IvfPqInputs> {
+ public:
+  IvfPqTest()
+    : params(::testing::TestWithParam<IvfPqInputs>::GetParam()),
+      stream(handle.get_stream()),
+      database(params.n_rows * params.dim, stream),
+      queries(params.n_queries * params.dim, stream),
+      neighbors(params.n_queries * params.k, stream),
+      distances(params.n_queries * params.k, stream)
+  {
+  }
+
+ protected:
+  void SetUp() override
+  {
+    raft::random::RngState r(params.seed);
+    uniform(handle, r, database.data(), params.n_rows * params.dim, -1.0f, 1.0f);
+    uniform(handle, r, queries.data(), params.n_queries * params.dim, -1.0f, 1.0f);
+
+    ivf_pq::index_params ip;
+    ip.n_lists = params.n_lists;
+    ip.pq_dim  = params.pq_dim;
+    auto idx   = ivf_pq::build<int64_t>(
+      handle, ip, database.data(), int64_t(params.n_rows), params.dim, params.metric);
+
+    ivf_pq::search_params sp;
+    sp.n_probes = params.n_probes;
+    ivf_pq::search<int64_t>(handle,
+                            sp,
+                            idx,
+                            queries.data(),
+                            params.n_queries,
+                            params.k,
+                            neighbors.data(),
+                            distances.data());
+
+    generateGoldenResult();
+    RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+  }
+
+  // exhaustive host reference; PQ distances are approximations, so unlike
+  // IVF-Flat the returned distances cannot be matched directly -- the quality
+  // criterion is the recall of the returned ids against the true top-k
+  void generateGoldenResult()
+  {
+    std::vector<float> h_db(params.n_rows * params.dim);
+    std::vector<float> h_q(params.n_queries * params.dim);
+    raft::update_host(h_db.data(), database.data(), h_db.size(), stream);
+    raft::update_host(h_q.data(), queries.data(), h_q.size(), stream);
+    RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+
+    ref_ids.resize(size_t(params.n_queries) * params.k);
+    std::vector<std::pair<double, int64_t>> row(params.n_rows);
+    for (int q = 0; q < params.n_queries; q++) {
+      for (int i = 0; i < params.n_rows; i++) {
+        double acc = 0;
+        for (int d = 0; d < params.dim; d++) {
+          double diff = h_q[q * params.dim + d] - h_db[i * params.dim + d];
+          acc += diff * diff;
+        }
+        row[i] = {acc, int64_t(i)};
+      }
+      std::partial_sort(row.begin(), row.begin() + params.k, row.end());
+      for (int j = 0; j < params.k; j++) {
+        ref_ids[size_t(q) * params.k + j] = row[j].second;
+      }
+    }
+  }
+
+  double evalRecall()
+  {
+    std::vector<int64_t> h_neighbors(neighbors.size());
+    raft::update_host(h_neighbors.data(), neighbors.data(), h_neighbors.size(), stream);
+    RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+
+    size_t matched = 0;
+    for (int q = 0; q < params.n_queries; q++) {
+      std::unordered_set<int64_t> truth(ref_ids.begin() + size_t(q) * params.k,
+                                        ref_ids.begin() + size_t(q + 1) * params.k);
+      for (int j = 0; j < params.k; j++) {
+        if (truth.count(h_neighbors[size_t(q) * params.k + j]) > 0) { matched++; }
+      }
+    }
+    return double(matched) / double(size_t(params.n_queries) * params.k);
+  }
+
+ protected:
+  raft::handle_t handle;
+  cudaStream_t stream;
+  IvfPqInputs params;
+  rmm::device_uvector<float> database;
+  rmm::device_uvector<float> queries;
+  rmm::device_uvector<int64_t> neighbors;
+  rmm::device_uvector<float> distances;
+  std::vector<int64_t> ref_ids;
+};
+
+// with n_probes == n_lists every list is scanned, so the recall loss is pure
+// quantization error; the probing cases tolerate the extra IVF loss
+const std::vector<IvfPqInputs> inputs = {
+  {0.7, 2000, 50, 16, 10, 8, 32, 32, raft::distance::DistanceType::L2Expanded, 1234ULL},
+  {0.7, 2000, 50, 16, 10, 8, 32, 32, raft::distance::DistanceType::L2SqrtExpanded, 1234ULL},
+  {0.7, 2000, 50, 16, 10, 8, 32, 32, raft::distance::DistanceType::L2Unexpanded, 1234ULL},
+  {0.9, 2000, 50, 16, 10, 16, 32, 32, raft::distance::DistanceType::L2SqrtUnexpanded, 1234ULL},
+  {0.5, 5000, 100, 16, 10, 8, 64, 16, raft::distance::DistanceType::L2Expanded, 42ULL},
+};
+
+TEST_P(IvfPqTest, Recall) { ASSERT_GE(evalRecall(), params.min_recall); }
+INSTANTIATE_TEST_CASE_P(IvfPqTests, IvfPqTest, ::testing::ValuesIn(inputs));
+
+// the fused scan keeps the full LUT (pq_dim * 256 floats) plus the query
+// residual in shared memory; at sub_dim == 1 that fits for pq_dim == 47 and
+// overflows the 48 KiB static limit at 48, which search must reject cleanly
+TEST(IvfPq, SharedMemoryBoundary)
+{
+  raft::handle_t handle;
+  auto stream = handle.get_stream();
+
+  ivf_pq::index_params ip;
+  ip.n_lists = 8;
+  ivf_pq::search_params sp;
+  sp.n_probes = 8;
+
+  raft::random::RngState r(1234ULL);
+  const int n_rows    = 512;
+  const int n_queries = 4;
+  const int k         = 5;
+
+  for (uint32_t dim : {47u, 48u}) {
+    rmm::device_uvector<float> database(n_rows * dim, stream);
+    rmm::device_uvector<float> queries(n_queries * dim, stream);
+    uniform(handle, r, database.data(), database.size(), -1.0f, 1.0f);
+    uniform(handle, r, queries.data(), queries.size(), -1.0f, 1.0f);
+    rmm::device_uvector<int64_t> neighbors(n_queries * k, stream);
+    rmm::device_uvector<float> distances(n_queries * k, stream);
+
+    ip.pq_dim = dim;  // sub_dim == 1
+    auto idx  = ivf_pq::build<int64_t>(handle, ip, database.data(), int64_t(n_rows), dim);
+    if (dim == 47) {
+      ivf_pq::search<int64_t>(
+        handle, sp, idx, queries.data(), n_queries, k, neighbors.data(), distances.data());
+      RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+    } else {
+      ASSERT_THROW(
+        ivf_pq::search<int64_t>(
+          handle, sp, idx, queries.data(), n_queries, k, neighbors.data(), distances.data()),
+        raft::exception);
+    }
+  }
+}
+
+}  // namespace knn
+}  // namespace spatial
+}  // namespace raft
@@ -27,6 +27,7 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <iostream>
 #include <vector>
@@ -202,6 +203,259 @@ TEST_P(KNNTestFuint32_t, BruteForce) { this->testBruteForce(); }
 INSTANTIATE_TEST_CASE_P(KNNTest, KNNTestFint64_t, ::testing::ValuesIn(inputs));
 INSTANTIATE_TEST_CASE_P(KNNTest, KNNTestFuint32_t, ::testing::ValuesIn(inputs));
 
+TEST(KNNTest, HostResidentIndex)
+{
+  raft::handle_t handle;
+  auto stream = handle.get_stream();
+
+  constexpr int n_index  = 1500;
+  constexpr int n_query  = 20;
+  constexpr int d        = 8;
+  constexpr int k        = 16;
+  // small tiles force several chunks through the streaming merge path
+  constexpr int64_t tile = 256;
+
+  std::vector<float> h_index(n_index * d);
+  std::vector<float> h_query(n_query * d);
+  for (size_t i = 0; i < h_index.size(); i++) {
+    h_index[i] = float((i * 9973 + 7) % 1000) / 250.0f - 2.0f;
+  }
+  for (size_t i = 0; i < h_query.size(); i++) {
+    h_query[i] = float((i * 7877 + 3) % 1000) / 250.0f - 2.0f;
+  }
+
+  rmm::device_uvector<float> index(h_index.size(), stream);
+  rmm::device_uvector<float> query(h_query.size(), stream);
+  raft::update_device(index.data(), h_index.data(), h_index.size(), stream);
+  raft::update_device(query.data(), h_query.data(), h_query.size(), stream);
+
+  // reference: the device-resident path on the same data
+  rmm::device_uvector<int64_t> ref_I(n_query * k, stream);
+  rmm::device_uvector<float> ref_D(n_query * k, stream);
+  std::vector<float*> input{index.data()};
+  std::vector<int> sizes{n_index};
+  brute_force_knn(handle,
+                  input,
+                  sizes,
+                  d,
+                  query.data(),
+                  n_query,
+                  ref_I.data(),
+                  ref_D.data(),
+                  k,
+                  true,
+                  true,
+                  nullptr,
+                  raft::distance::DistanceType::L2Expanded);
+
+  rmm::device_uvector<int64_t> host_I(n_query * k, stream);
+  rmm::device_uvector<float> host_D(n_query * k, stream);
+  brute_force_knn_host(handle,
+                       h_index.data(),
+                       int64_t(n_index),
+                       d,
+                       query.data(),
+                       n_query,
+                       host_I.data(),
+                       host_D.data(),
+                       k,
+                       raft::distance::DistanceType::L2Expanded,
+                       2.0f,
+                       tile);
+
+  ASSERT_TRUE(devArrMatch(ref_I.data(), host_I.data(), n_query * k, raft::Compare<int64_t>()));
+  ASSERT_TRUE(
+    devArrMatch(ref_D.data(), host_D.data(), n_query * k, raft::CompareApprox<float>(1e-4f)));
+}
+
+TEST(KNNTest, PrenormalizedCosineIndex)
+{
+  raft::handle_t handle;
+  auto stream = handle.get_stream();
+
+  constexpr int n_index  = 100;
+  constexpr int n_query  = 10;
+  constexpr int d        = 8;
+  constexpr int k        = 5;
+  const auto metric      = raft::distance::DistanceType::CosineExpanded;
+
+  std::vector<float> h_index(n_index * d);
+  std::vector<float> h_query(n_query * d);
+  for (size_t i = 0; i < h_index.size(); i++) {
+    h_index[i] = float((i * 7901 + 13) % 1000) / 250.0f - 2.0f;
+  }
+  for (size_t i = 0; i < h_query.size(); i++) {
+    h_query[i] = float((i * 6053 + 41) % 1000) / 250.0f - 2.0f;
+  }
+
+  rmm::device_uvector<float> index(h_index.size(), stream);
+  rmm::device_uvector<float> query(h_query.size(), stream);
+  raft::update_device(index.data(), h_index.data(), h_index.size(), stream);
+  raft::update_device(query.data(), h_query.data(), h_query.size(), stream);
+
+  rmm::device_uvector<int64_t> ref_I(n_query * k, stream);
+  rmm::device_uvector<float> ref_D(n_query * k, stream);
+  std::vector<float*> input{index.data()};
+  std::vector<int> sizes{n_index};
+  brute_force_knn(handle,
+                  input,
+                  sizes,
+                  d,
+                  query.data(),
+                  n_query,
+                  ref_I.data(),
+                  ref_D.data(),
+                  k,
+                  true,
+                  true,
+                  nullptr,
+                  metric);
+
+  // normalize a copy of the index once, then search with the per-call index
+  // preprocessing skipped; the results must match the reference
+  rmm::device_uvector<float> index_pre(h_index.size(), stream);
+  raft::copy(index_pre.data(), index.data(), index.size(), stream);
+  std::vector<float*> input_pre{index_pre.data()};
+  prepare_brute_force_index(handle, input_pre, sizes, d, metric);
+
+  rmm::device_uvector<int64_t> pre_I(n_query * k, stream);
+  rmm::device_uvector<float> pre_D(n_query * k, stream);
+  brute_force_knn(handle,
+                  input_pre,
+                  sizes,
+                  d,
+                  query.data(),
+                  n_query,
+                  pre_I.data(),
+                  pre_D.data(),
+                  k,
+                  true,
+                  true,
+                  nullptr,
+                  metric,
+                  2.0f,
+                  true);
+
+  ASSERT_TRUE(devArrMatch(ref_I.data(), pre_I.data(), n_query * k, raft::Compare<int64_t>()));
+  ASSERT_TRUE(
+    devArrMatch(ref_D.data(), pre_D.data(), n_query * k, raft::CompareApprox<float>(1e-4f)));
+}
+
+TEST(KNNTest, ClassifyVote)
+{
+  raft::handle_t handle;
+  auto stream = handle.get_stream();
+
+  constexpr int n_index  = 200;
+  constexpr int n_query  = 50;
+  constexpr int k        = 7;
+  constexpr int n_unique = 4;
+  // sorted distinct labels; y stores the raw label values
+  const std::vector<int> h_unique{-1, 2, 5, 9};
+
+  std::vector<int> h_y(n_index);
+  std::vector<int64_t> h_I(n_query * k);
+  std::vector<float> h_D(n_query * k);
+  for (int i = 0; i < n_index; i++) {
+    h_y[i] = h_unique[(i * 131 + 7) % n_unique];
+  }
+  for (int i = 0; i < n_query * k; i++) {
+    h_I[i] = (i * 37 + 11) % n_index;
+    // weights 2/4/8 are exactly representable, so the vote sums do not depend
+    // on the accumulation order
+    h_D[i] = 1.0f / float(2 << (i % 3));
+  }
+
+  rmm::device_uvector<int> y(n_index, stream);
+  rmm::device_uvector<int> unique_labels(n_unique, stream);
+  rmm::device_uvector<int64_t> I(h_I.size(), stream);
+  rmm::device_uvector<float> D(h_D.size(), stream);
+  rmm::device_uvector<int> out(n_query, stream);
+  raft::update_device(y.data(), h_y.data(), h_y.size(), stream);
+  raft::update_device(unique_labels.data(), h_unique.data(), h_unique.size(), stream);
+  raft::update_device(I.data(), h_I.data(), h_I.size(), stream);
+  raft::update_device(D.data(), h_D.data(), h_D.size(), stream);
+
+  for (bool weighted : {false, true}) {
+    std::vector<int> h_expected(n_query);
+    for (int q = 0; q < n_query; q++) {
+      float votes[n_unique] = {0.f, 0.f, 0.f, 0.f};
+      for (int j = 0; j < k; j++) {
+        const int lbl = h_y[h_I[q * k + j]];
+        const int c = std::lower_bound(h_unique.begin(), h_unique.end(), lbl) - h_unique.begin();
+        votes[c] += weighted ? 1.0f / h_D[q * k + j] : 1.0f;
+      }
+      int best = 0;
+      for (int c = 1; c < n_unique; c++) {
+        if (votes[c] > votes[best]) { best = c; }
+      }
+      h_expected[q] = h_unique[best];
+    }
+
+    rmm::device_uvector<int> expected(n_query, stream);
+    raft::update_device(expected.data(), h_expected.data(), h_expected.size(), stream);
+    knn_classify(handle,
+                 out.data(),
+                 I.data(),
+                 D.data(),
+                 y.data(),
+                 unique_labels.data(),
+                 n_unique,
+                 n_query,
+                 k,
+                 weighted);
+    ASSERT_TRUE(devArrMatch(expected.data(), out.data(), n_query, raft::Compare<int>(), stream));
+  }
+}
+
+TEST(KNNTest, RegressMean)
+{
+  raft::handle_t handle;
+  auto stream = handle.get_stream();
+
+  constexpr int n_index = 200;
+  constexpr int n_query = 50;
+  constexpr int k       = 7;
+
+  std::vector<float> h_y(n_index);
+  std::vector<int64_t> h_I(n_query * k);
+  std::vector<float> h_D(n_query * k);
+  for (int i = 0; i < n_index; i++) {
+    h_y[i] = float((i * 131 + 7) % 100) / 10.0f;
+  }
+  for (int i = 0; i < n_query * k; i++) {
+    h_I[i] = (i * 37 + 11) % n_index;
+    h_D[i] = 0.5f + float((i * 53 + 3) % 32) / 16.0f;
+  }
+
+  rmm::device_uvector<float> y(n_index, stream);
+  rmm::device_uvector<int64_t> I(h_I.size(), stream);
+  rmm::device_uvector<float> D(h_D.size(), stream);
+  rmm::device_uvector<float> out(n_query, stream);
+  raft::update_device(y.data(), h_y.data(), h_y.size(), stream);
+  raft::update_device(I.data(), h_I.data(), h_I.size(), stream);
+  raft::update_device(D.data(), h_D.data(), h_D.size(), stream);
+
+  for (bool weighted : {false, true}) {
+    std::vector<float> h_expected(n_query);
+    for (int q = 0; q < n_query; q++) {
+      float sum_wy = 0.f, sum_w = 0.f;
+      for (int j = 0; j < k; j++) {
+        const float w = weighted ? 1.0f / h_D[q * k + j] : 1.0f;
+        sum_wy += w * h_y[h_I[q * k + j]];
+        sum_w += w;
+      }
+      h_expected[q] = sum_wy / sum_w;
+    }
+
+    rmm::device_uvector<float> expected(n_query, stream);
+    raft::update_device(expected.data(), h_expected.data(), h_expected.size(), stream);
+    knn_regress(handle, out.data(), I.data(), D.data(), y.data(), n_query, k, weighted);
+    ASSERT_TRUE(devArrMatch(
+      expected.data(), out.data(), n_query, raft::CompareApprox<float>(1e-4f), stream));
+  }
+}
+
 }  // namespace knn
 }  // namespace spatial
 }  // namespace raft
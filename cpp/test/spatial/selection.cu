@@ -23,6 +23,7 @@
 #include "../test_utils.h"
 
 #include <raft/sparse/detail/utils.h>
+#include <raft/spatial/knn/detail/topk/select_k_epilogue.cuh>
 #include <raft/spatial/knn/knn.cuh>
 #if defined RAFT_NN_COMPILED
 #include <raft/spatial/knn/specializations.cuh>
@@ -345,7 +346,8 @@ INSTANTIATE_TEST_CASE_P(SelectionTest,
                                          testing::Values(knn::SelectKAlgo::FAISS,
                                                          knn::SelectKAlgo::RADIX_8_BITS,
                                                          knn::SelectKAlgo::RADIX_11_BITS,
-                                                         knn::SelectKAlgo::WARP_SORT)));
+                                                         knn::SelectKAlgo::WARP_SORT,
+                                                         knn::SelectKAlgo::HOST)));
 
 template <knn::SelectKAlgo RefAlgo>
 struct with_ref {
@@ -470,4 +472,50 @@ INSTANTIATE_TEST_CASE_P(SelectionTest,
 //                         testing::Combine(inputs_random_largek,
 //                                          testing::Values(knn::SelectKAlgo::RADIX_11_BITS)));
 
+// One warp selects the top-k of one row fed through the epilogue tile by
+// tile, the way a tile-producing distance kernel would use it.
+template <int Capacity>
+__global__ void select_k_epilogue_kernel(
+  const float* in, int len, int tile_len, int k, float* out, int* out_idx)
+{
+  knn::detail::topk::select_k_epilogue<Capacity, true, float, int> top_k(k);
+  for (int off = 0; off < len; off += tile_len) {
+    top_k.consume_tile(in + off, min(tile_len, len - off), off);
+  }
+  top_k.finish(out, out_idx);
+}
+
+TEST(SelectionTest, SelectKEpilogue)
+{
+  constexpr int len      = 1000;
+  constexpr int tile_len = 128;
+  constexpr int k        = 16;
+  auto stream            = rmm::cuda_stream_default;
+
+  raft::random::Rng rng(42);
+  rmm::device_uvector<float> in_d(len, stream);
+  rng.uniform(in_d.data(), len, -1.0f, 1.0f, stream);
+  std::vector<float> in_h(len);
+  update_host(in_h.data(), in_d.data(), len, stream);
+
+  rmm::device_uvector<float> out_d(k, stream);
+  rmm::device_uvector<int> out_idx_d(k, stream);
+  select_k_epilogue_kernel<32><<<1, WarpSize, 0, stream.value()>>>(
+    in_d.data(), len, tile_len, k, out_d.data(), out_idx_d.data());
+  RAFT_CUDA_TRY(cudaPeekAtLastError());
+
+  std::vector<float> out_h(k);
+  std::vector<int> out_idx_h(k);
+  update_host(out_h.data(), out_d.data(), k, stream);
+  update_host(out_idx_h.data(), out_idx_d.data(), k, stream);
+  stream.synchronize();
+
+  std::vector<float> ref(in_h);
+  std::partial_sort(ref.begin(), ref.begin() + k, ref.end());
+  for (int i = 0; i < k; i++) {
+    ASSERT_EQ(out_h[i], ref[i]) << "at " << i;
+    ASSERT_EQ(in_h[out_idx_h[i]], out_h[i]) << "at " << i;
+  }
+}
+
 }  // namespace raft::spatial::selection
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils.h"
+#include <gtest/gtest.h>
+#include <raft/cudart_utils.h>
+#include <raft/random/rng.cuh>
+#include <raft/spatial/knn/sq8.cuh>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace raft {
+namespace spatial {
+namespace knn {
+
+struct Sq8Inputs {
+  float tolerance;
+  int n_rows, n_queries, dim, k;
+  // 0 lists selects the flat index; otherwise an IVF index probed exhaustively
+  uint32_t n_lists;
+  raft::distance::DistanceType metric;
+  unsigned long long int seed;
+};
+
+class Sq8Test : public ::testing::TestWithParam<Sq8Inputs> {
+ public:
+  Sq8Test()
+    : params(::testing::TestWithParam<Sq8Inputs>::GetParam()),
+      stream(handle.get_stream()),
+      database(params.n_rows * params.dim, stream),
+      queries(params.n_queries * params.dim, stream),
+      neighbors(params.n_queries * params.k, stream),
+      distances(params.n_queries * params.k, stream)
+  {
+  }
+
+ protected:
+  void SetUp() override
+  {
+    raft::random::RngState r(params.seed);
+    uniform(handle, r, database.data(), params.n_rows * params.dim, -1.0f, 1.0f);
+    uniform(handle, r, queries.data(), params.n_queries * params.dim, -1.0f, 1.0f);
+
+    if (params.n_lists == 0) {
+      auto idx = sq8::build<int64_t>(
+        handle, database.data(), int64_t(params.n_rows), params.dim, params.metric);
+      sq8::search<int64_t>(handle,
+                           idx,
+                           queries.data(),
+                           params.n_queries,
+                           params.k,
+                           neighbors.data(),
+                           distances.data());
+    } else {
+      ivf_flat::index_params ip;
+      ip.n_lists = params.n_lists;
+      auto idx   = sq8::build_ivf<int64_t>(
+        handle, ip, database.data(), int64_t(params.n_rows), params.dim, params.metric);
+      ivf_flat::search_params sp;
+      sp.n_probes = params.n_lists;
+      sq8::search_ivf<int64_t>(handle,
+                               sp,
+                               idx,
+                               queries.data(),
+                               params.n_queries,
+                               params.k,
+                               neighbors.data(),
+                               distances.data());
+    }
+
+    generateGoldenResult();
+    RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+  }
+
+  // host reference over the quantize/dequantize round trip of the database:
+  // this replicates the device quantizer exactly, so the distances must match
+  // up to fp accumulation order
+  void generateGoldenResult()
+  {
+    std::vector<float> h_db(params.n_rows * params.dim);
+    std::vector<float> h_q(params.n_queries * params.dim);
+    raft::update_host(h_db.data(), database.data(), h_db.size(), stream);
+    raft::update_host(h_q.data(), queries.data(), h_q.size(), stream);
+    RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+
+    // per-dimension min / step, then the round trip
+    for (int d = 0; d < params.dim; d++) {
+      float lo = h_db[d];
+      float hi = h_db[d];
+      for (int i = 1; i < params.n_rows; i++) {
+        lo = std::min(lo, h_db[i * params.dim + d]);
+        hi = std::max(hi, h_db[i * params.dim + d]);
+      }
+      const float step = hi - lo > 0 ? (hi - lo) / 255.0f : 1.0f;
+      for (int i = 0; i < params.n_rows; i++) {
+        float& v     = h_db[i * params.dim + d];
+        const float q = std::min(std::max((v - lo) / step, 0.0f), 255.0f);
+        v             = lo + step * float(std::lround(q));
+      }
+    }
+
+    bool inner_prod = params.metric == raft::distance::DistanceType::InnerProduct;
+    dist_ref.resize(params.n_queries * params.k);
+    std::vector<float> row(params.n_rows);
+    for (int q = 0; q < params.n_queries; q++) {
+      for (int i = 0; i < params.n_rows; i++) {
+        double acc = 0;
+        for (int d = 0; d < params.dim; d++) {
+          double xv = h_q[q * params.dim + d];
+          double yv = h_db[i * params.dim + d];
+          acc += inner_prod ? xv * yv : (xv - yv) * (xv - yv);
+        }
+        row[i] = float(acc);
+      }
+      std::sort(row.begin(), row.end());
+      if (inner_prod) { std::reverse(row.begin(), row.end()); }
+      for (int j = 0; j < params.k; j++) {
+        float d = row[j];
+        if (params.metric == raft::distance::DistanceType::L2SqrtExpanded ||
+            params.metric == raft::distance::DistanceType::L2SqrtUnexpanded) {
+          d = std::sqrt(d);
+        }
+        dist_ref[q * params.k + j] = d;
+      }
+    }
+  }
+
+ protected:
+  raft::handle_t handle;
+  cudaStream_t stream;
+  Sq8Inputs params;
+  rmm::device_uvector<float> database;
+  rmm::device_uvector<float> queries;
+  rmm::device_uvector<int64_t> neighbors;
+  rmm::device_uvector<float> distances;
+  std::vector<float> dist_ref;
+};
+
+const std::vector<Sq8Inputs> inputs = {
+  // flat
+  {0.001f, 3000, 50, 16, 10, 0, raft::distance::DistanceType::L2Expanded, 1234ULL},
+  {0.001f, 3000, 50, 16, 10, 0, raft::distance::DistanceType::L2SqrtExpanded, 1234ULL},
+  {0.001f, 1000, 20, 33, 8, 0, raft::distance::DistanceType::InnerProduct, 1234ULL},
+  // flat, large enough to take the chunked multi-part path
+  {0.001f, 70000, 10, 8, 16, 0, raft::distance::DistanceType::L2Expanded, 42ULL},
+  // ivf, probing every list so the result is exact over the quantized data
+  {0.001f, 2000, 50, 16, 10, 32, raft::distance::DistanceType::L2Expanded, 1234ULL},
+  {0.001f, 1000, 20, 33, 8, 25, raft::distance::DistanceType::InnerProduct, 1234ULL},
+};
+
+TEST_P(Sq8Test, Result)
+{
+  ASSERT_TRUE(devArrMatchHost(dist_ref.data(),
+                              distances.data(),
+                              dist_ref.size(),
+                              raft::CompareApprox<float>(params.tolerance),
+                              stream));
+}
+INSTANTIATE_TEST_CASE_P(Sq8Tests, Sq8Test, ::testing::ValuesIn(inputs));
+
+}  // namespace knn
+}  // namespace spatial
+}  // namespace raft
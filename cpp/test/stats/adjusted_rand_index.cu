@@ -63,6 +63,10 @@ class adjustedRandIndexTest : public ::testing::TestWithParam<adjustedRandIndexP
     // allocating and initializing memory to the GPU
     computed_adjusted_rand_index = adjusted_rand_index<T, MathT>(
       firstClusterArray.data(), secondClusterArray.data(), nElements, stream);
+    computed_adjusted_rand_index_sparse = adjusted_rand_index_sparse<T, MathT>(
+      firstClusterArray.data(), secondClusterArray.data(), nElements, stream);
+    computed_adjusted_rand_index_hashed = adjusted_rand_index_hashed<T, MathT>(
+      firstClusterArray.data(), secondClusterArray.data(), nElements, stream);
   }
 
   void TearDown() override { RAFT_CUDA_TRY(cudaStreamDestroy(stream)); }
@@ -140,8 +144,10 @@ class adjustedRandIndexTest : public ::testing::TestWithParam<adjustedRandIndexP
   rmm::device_uvector<T> firstClusterArray;
   rmm::device_uvector<T> secondClusterArray;
   int nElements                       = 0;
-  double truth_adjusted_rand_index    = 0;
-  double computed_adjusted_rand_index = 0;
+  double truth_adjusted_rand_index           = 0;
+  double computed_adjusted_rand_index        = 0;
+  double computed_adjusted_rand_index_sparse = 0;
+  double computed_adjusted_rand_index_hashed = 0;
   cudaStream_t stream                 = 0;
 };
 
@@ -187,6 +193,14 @@ TEST_P(ARI_ii, Result)
 {
   ASSERT_NEAR(computed_adjusted_rand_index, truth_adjusted_rand_index, params.tolerance);
 }
+TEST_P(ARI_ii, SparseResult)
+{
+  ASSERT_NEAR(computed_adjusted_rand_index_sparse, truth_adjusted_rand_index, params.tolerance);
+}
+TEST_P(ARI_ii, HashedResult)
+{
+  ASSERT_NEAR(computed_adjusted_rand_index_hashed, truth_adjusted_rand_index, params.tolerance);
+}
 INSTANTIATE_TEST_CASE_P(adjusted_rand_index, ARI_ii, ::testing::ValuesIn(inputs));
 
 typedef adjustedRandIndexTest<int, unsigned long long> ARI_il;
@@ -194,8 +208,38 @@ TEST_P(ARI_il, Result)
 {
   ASSERT_NEAR(computed_adjusted_rand_index, truth_adjusted_rand_index, params.tolerance);
 }
+TEST_P(ARI_il, SparseResult)
+{
+  ASSERT_NEAR(computed_adjusted_rand_index_sparse, truth_adjusted_rand_index, params.tolerance);
+}
+TEST_P(ARI_il, HashedResult)
+{
+  ASSERT_NEAR(computed_adjusted_rand_index_hashed, truth_adjusted_rand_index, params.tolerance);
+}
 INSTANTIATE_TEST_CASE_P(adjusted_rand_index, ARI_il, ::testing::ValuesIn(inputs));
 INSTANTIATE_TEST_CASE_P(adjusted_rand_index_large, ARI_il, ::testing::ValuesIn(large_inputs));
 
+// an underestimated max_distinct_pairs must surface as an exception, not a
+// device hang: 64 distinct label pairs cannot fit a map sized for 2
+TEST(adjustedRandIndexHashed, Overflow)
+{
+  cudaStream_t stream;
+  RAFT_CUDA_TRY(cudaStreamCreate(&stream));
+  const int nElements = 64;
+  std::vector<int> arr1(nElements), arr2(nElements);
+  for (int i = 0; i < nElements; i++) {
+    arr1[i] = i % 8;
+    arr2[i] = i / 8;
+  }
+  rmm::device_uvector<int> firstClusterArray(nElements, stream);
+  rmm::device_uvector<int> secondClusterArray(nElements, stream);
+  raft::update_device(firstClusterArray.data(), arr1.data(), nElements, stream);
+  raft::update_device(secondClusterArray.data(), arr2.data(), nElements, stream);
+  ASSERT_THROW(adjusted_rand_index_hashed<int, int>(
+                 firstClusterArray.data(), secondClusterArray.data(), nElements, stream, 2),
+               raft::exception);
+  RAFT_CUDA_TRY(cudaStreamDestroy(stream));
+}
+
 }  // end namespace stats
 }  // end namespace raft
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils.h"
+#include <gtest/gtest.h>
+#include <raft/cudart_utils.h>
+#include <raft/random/rng.cuh>
+#include <raft/stats/column_summary.cuh>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace raft {
+namespace stats {
+
+template <typename T>
+struct ColumnSummaryInputs {
+  T mean, stddev;
+  int rows, cols;
+  bool sample, rowMajor;
+  unsigned long long int seed;
+  static const int N_SIGMAS = 6;
+
+  T mean_tol() const { return T(N_SIGMAS) * stddev / sqrt(T(rows)); }
+
+  T var_tol() const
+  {
+    return T(N_SIGMAS) * stddev * stddev * sqrt(T(2.0) / T(std::max(1, rows - 1)));
+  }
+};
+
+template <typename T>
+::std::ostream& operator<<(::std::ostream& os, const ColumnSummaryInputs<T>& ps)
+{
+  return os << "rows: " << ps.rows << "; cols: " << ps.cols << "; "
+            << (ps.rowMajor ? "row-major" : "col-major");
+}
+
+template <typename T>
+class ColumnSummaryTest : public ::testing::TestWithParam<ColumnSummaryInputs<T>> {
+ public:
+  ColumnSummaryTest()
+    : params(::testing::TestWithParam<ColumnSummaryInputs<T>>::GetParam()),
+      stream(handle.get_stream()),
+      data(params.rows * params.cols, stream),
+      min_act(params.cols, stream),
+      max_act(params.cols, stream),
+      mean_act(params.cols, stream),
+      vars_act(params.cols, stream),
+      min_ref(params.cols, std::numeric_limits<T>::max()),
+      max_ref(params.cols, -std::numeric_limits<T>::max())
+  {
+  }
+
+ protected:
+  void SetUp() override
+  {
+    random::RngState r(params.seed);
+    normal(handle, r, data.data(), params.cols * params.rows, params.mean, params.stddev);
+    column_summary(min_act.data(),
+                   max_act.data(),
+                   mean_act.data(),
+                   vars_act.data(),
+                   data.data(),
+                   params.cols,
+                   params.rows,
+                   params.sample,
+                   params.rowMajor,
+                   stream);
+
+    // min/max reference on the host (the order of combination does not affect
+    // them, so the match must be exact)
+    std::vector<T> h_data(params.rows * params.cols);
+    raft::update_host(h_data.data(), data.data(), h_data.size(), stream);
+    RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+    for (int i = 0; i < params.rows; i++) {
+      for (int j = 0; j < params.cols; j++) {
+        T val = params.rowMajor ? h_data[size_t(i) * params.cols + j]
+                                : h_data[size_t(j) * params.rows + i];
+        min_ref[j] = std::min(min_ref[j], val);
+        max_ref[j] = std::max(max_ref[j], val);
+      }
+    }
+  }
+
+ protected:
+  raft::handle_t handle;
+  cudaStream_t stream;
+
+  ColumnSummaryInputs<T> params;
+  rmm::device_uvector<T> data, min_act, max_act, mean_act, vars_act;
+  std::vector<T> min_ref, max_ref;
+};
+
+const std::vector<ColumnSummaryInputs<float>> inputsf = {
+  {1.f, 2.f, 1024, 32, true, false, 1234ULL},    {1.f, 2.f, 1024, 64, true, false, 1234ULL},
+  {1.f, 2.f, 1024, 128, true, false, 1234ULL},   {1.f, 2.f, 1024, 256, true, false, 1234ULL},
+  {-1.f, 2.f, 1024, 32, false, false, 1234ULL},  {-1.f, 2.f, 1024, 257, false, false, 1234ULL},
+  {1.f, 2.f, 1024, 32, true, true, 1234ULL},     {1.f, 2.f, 1024, 64, true, true, 1234ULL},
+  {1.f, 2.f, 1024, 128, true, true, 1234ULL},    {1.f, 2.f, 1024, 256, true, true, 1234ULL},
+  {-1.f, 2.f, 1024, 257, false, true, 1234ULL},  {-1.f, 2.f, 700, 13, false, true, 1234ULL},
+  {10.f, 2.f, 500000, 811, false, true, 1234ULL}};
+
+const std::vector<ColumnSummaryInputs<double>> inputsd = {
+  {1.0, 2.0, 1024, 32, true, false, 1234ULL},
+  {1.0, 2.0, 1024, 128, true, false, 1234ULL},
+  {-1.0, 2.0, 1024, 256, false, false, 1234ULL},
+  {1.0, 2.0, 1024, 32, true, true, 1234ULL},
+  {1.0, 2.0, 1024, 128, true, true, 1234ULL},
+  {-1.0, 2.0, 1024, 257, false, true, 1234ULL}};
+
+typedef ColumnSummaryTest<float> ColumnSummaryTestF;
+TEST_P(ColumnSummaryTestF, Result)
+{
+  ASSERT_TRUE(
+    devArrMatchHost(min_ref.data(), min_act.data(), params.cols, Compare<float>(), stream));
+  ASSERT_TRUE(
+    devArrMatchHost(max_ref.data(), max_act.data(), params.cols, Compare<float>(), stream));
+  ASSERT_TRUE(devArrMatch(
+    params.mean, mean_act.data(), params.cols, CompareApprox<float>(params.mean_tol()), stream));
+  ASSERT_TRUE(devArrMatch(params.stddev * params.stddev,
+                          vars_act.data(),
+                          params.cols,
+                          CompareApproxNoScaling<float>(params.var_tol()),
+                          stream));
+}
+
+typedef ColumnSummaryTest<double> ColumnSummaryTestD;
+TEST_P(ColumnSummaryTestD, Result)
+{
+  ASSERT_TRUE(
+    devArrMatchHost(min_ref.data(), min_act.data(), params.cols, Compare<double>(), stream));
+  ASSERT_TRUE(
+    devArrMatchHost(max_ref.data(), max_act.data(), params.cols, Compare<double>(), stream));
+  ASSERT_TRUE(devArrMatch(
+    params.mean, mean_act.data(), params.cols, CompareApprox<double>(params.mean_tol()), stream));
+  ASSERT_TRUE(devArrMatch(params.stddev * params.stddev,
+                          vars_act.data(),
+                          params.cols,
+                          CompareApproxNoScaling<double>(params.var_tol()),
+                          stream));
+}
+
+INSTANTIATE_TEST_SUITE_P(ColumnSummaryTests, ColumnSummaryTestF, ::testing::ValuesIn(inputsf));
+
+INSTANTIATE_TEST_SUITE_P(ColumnSummaryTests, ColumnSummaryTestD, ::testing::ValuesIn(inputsd));
+
+}  // end namespace stats
+}  // end namespace raft
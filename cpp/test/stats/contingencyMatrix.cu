@@ -140,6 +140,37 @@ class ContingencyMatrixTest : public ::testing::TestWithParam<ContingencyMatrixP
                                   raft::Compare<T>()));
   }
 
+  void RunSparseTest()
+  {
+    raft::sparse::COO<int, int> cooOut(stream);
+    raft::stats::contingencyMatrixSparse(
+      dY.data(), dYHat.data(), params.nElements, cooOut, stream, minLabel, maxLabel);
+    raft::interruptible::synchronize(stream);
+
+    std::vector<int> rows(cooOut.nnz), cols(cooOut.nnz), vals(cooOut.nnz);
+    raft::update_host(rows.data(), cooOut.rows(), cooOut.nnz, stream);
+    raft::update_host(cols.data(), cooOut.cols(), cooOut.nnz, stream);
+    raft::update_host(vals.data(), cooOut.vals(), cooOut.nnz, stream);
+    raft::interruptible::synchronize(stream);
+
+    // scatter the COO entries into a dense matrix and compare to the golden one
+    std::vector<int> hDense(numUniqueClasses * numUniqueClasses, 0);
+    for (int k = 0; k < cooOut.nnz; k++) {
+      ASSERT_GE(rows[k], 0);
+      ASSERT_LT(rows[k], numUniqueClasses);
+      ASSERT_GE(cols[k], 0);
+      ASSERT_LT(cols[k], numUniqueClasses);
+      hDense[rows[k] * numUniqueClasses + cols[k]] += vals[k];
+    }
+    raft::update_device(
+      dComputedOutput.data(), hDense.data(), numUniqueClasses * numUniqueClasses, stream);
+    raft::interruptible::synchronize(stream);
+    ASSERT_TRUE(raft::devArrMatch(dComputedOutput.data(),
+                                  dGoldenOutput.data(),
+                                  numUniqueClasses * numUniqueClasses,
+                                  raft::Compare<T>()));
+  }
+
   ContingencyMatrixParam params;
   int numUniqueClasses = -1;
   T minLabel, maxLabel;
@@ -167,6 +198,7 @@ const std::vector<ContingencyMatrixParam> inputs = {
 
 typedef ContingencyMatrixTest<int> ContingencyMatrixTestS;
 TEST_P(ContingencyMatrixTestS, Result) { RunTest(); }
+TEST_P(ContingencyMatrixTestS, SparseResult) { RunSparseTest(); }
 INSTANTIATE_TEST_CASE_P(ContingencyMatrix, ContingencyMatrixTestS, ::testing::ValuesIn(inputs));
 }  // namespace stats
 }  // namespace raft
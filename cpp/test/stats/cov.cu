@@ -15,6 +15,7 @@
  */
 
 #include "../test_utils.h"
+#include <algorithm>
 #include <gtest/gtest.h>
 #include <raft/cudart_utils.h>
 #include <raft/random/rng.cuh>
@@ -181,5 +182,103 @@ INSTANTIATE_TEST_CASE_P(CovTests, CovTestSmallF, ::testing::ValuesIn(inputsf));
 
 INSTANTIATE_TEST_CASE_P(CovTests, CovTestSmallD, ::testing::ValuesIn(inputsd));
 
+template <typename T>
+class CovIncTest : public ::testing::TestWithParam<CovInputs<T>> {
+ protected:
+  CovIncTest() : data(0, stream), mean_act(0, stream), cov_ref(0, stream), cov_act(0, stream) {}
+
+  void SetUp() override
+  {
+    raft::handle_t handle;
+    cudaStream_t stream = handle.get_stream();
+
+    params   = ::testing::TestWithParam<CovInputs<T>>::GetParam();
+    int rows = params.rows, cols = params.cols;
+    auto len = rows * cols;
+    data.resize(len, stream);
+    mean_act.resize(cols, stream);
+    cov_ref.resize(cols * cols, stream);
+    cov_act.resize(cols * cols, stream);
+
+    raft::random::RngState r(params.seed);
+    normal(handle, r, data.data(), len, params.mean, params.var);
+    raft::stats::mean(
+      mean_act.data(), data.data(), cols, rows, params.sample, params.rowMajor, stream);
+
+    // reference result from the one-shot path (on a copy, since cov
+    // mean-centers its input)
+    rmm::device_uvector<T> data_copy(len, stream);
+    raft::copy(data_copy.data(), data.data(), len, stream);
+    cov(handle,
+        cov_ref.data(),
+        data_copy.data(),
+        mean_act.data(),
+        cols,
+        rows,
+        params.sample,
+        params.rowMajor,
+        true,
+        stream);
+
+    RAFT_CUDA_TRY(cudaMemsetAsync(cov_act.data(), 0, cov_act.size() * sizeof(T), stream));
+    if (params.rowMajor) {
+      // feed the rows in three uneven batches
+      int chunk = (rows + 2) / 3;
+      for (int done = 0; done < rows; done += chunk) {
+        int n = std::min(chunk, rows - done);
+        cov_update(
+          handle, cov_act.data(), data.data() + size_t(done) * cols, cols, n, true, stream);
+      }
+    } else {
+      // a row slice of a col-major matrix is not contiguous; feed it whole
+      cov_update(handle, cov_act.data(), data.data(), cols, rows, false, stream);
+    }
+    cov_finalize(cov_act.data(), mean_act.data(), cols, rows, params.sample, stream);
+  }
+
+ protected:
+  CovInputs<T> params;
+  rmm::device_uvector<T> data, mean_act, cov_ref, cov_act;
+  cudaStream_t stream = 0;
+};
+
+const std::vector<CovInputs<float>> inputsf_inc = {
+  {0.01f, 0.5f, 2.f, 4 * 1024, 32, true, false, true, 1234ULL},
+  {0.01f, 0.5f, 2.f, 4 * 1024, 64, true, false, true, 1234ULL},
+  {0.01f, -0.5f, 2.f, 4 * 1024, 128, false, false, true, 1234ULL},
+  {0.01f, 0.5f, 2.f, 4 * 1024, 32, true, true, true, 1234ULL},
+  {0.01f, 0.5f, 2.f, 4 * 1024, 64, true, true, true, 1234ULL},
+  {0.01f, -0.5f, 2.f, 4 * 1024, 128, false, true, true, 1234ULL}};
+
+const std::vector<CovInputs<double>> inputsd_inc = {
+  {0.001, 1.0, 2.0, 32 * 1024, 32, true, false, true, 1234ULL},
+  {0.001, -1.0, 2.0, 32 * 1024, 128, false, false, true, 1234ULL},
+  {0.001, 1.0, 2.0, 32 * 1024, 32, true, true, true, 1234ULL},
+  {0.001, -1.0, 2.0, 32 * 1024, 128, false, true, true, 1234ULL}};
+
+typedef CovIncTest<float> CovIncTestF;
+TEST_P(CovIncTestF, Result)
+{
+  ASSERT_TRUE(raft::devArrMatch(cov_ref.data(),
+                                cov_act.data(),
+                                params.cols,
+                                params.cols,
+                                raft::CompareApprox<float>(params.tolerance)));
+}
+
+typedef CovIncTest<double> CovIncTestD;
+TEST_P(CovIncTestD, Result)
+{
+  ASSERT_TRUE(raft::devArrMatch(cov_ref.data(),
+                                cov_act.data(),
+                                params.cols,
+                                params.cols,
+                                raft::CompareApprox<double>(params.tolerance)));
+}
+
+INSTANTIATE_TEST_CASE_P(CovTests, CovIncTestF, ::testing::ValuesIn(inputsf_inc));
+
+INSTANTIATE_TEST_CASE_P(CovTests, CovIncTestD, ::testing::ValuesIn(inputsd_inc));
+
 }  // namespace stats
 }  // namespace raft
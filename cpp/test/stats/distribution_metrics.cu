@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils.h"
+#include <gtest/gtest.h>
+#include <raft/cudart_utils.h>
+#include <raft/stats/distribution_metrics.cuh>
+#include <raft/stats/entropy.cuh>
+#include <raft/stats/mutual_info_score.cuh>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace raft {
+namespace stats {
+
+struct distributionMetricsParam {
+  int nElements;
+  int lowerLabelRange;
+  int upperLabelRange;
+  double tolerance;
+};
+
+class distributionMetricsTest : public ::testing::TestWithParam<distributionMetricsParam> {
+ protected:
+  void SetUp() override
+  {
+    params      = ::testing::TestWithParam<distributionMetricsParam>::GetParam();
+    auto stream = handle.get_stream();
+    int n       = params.nElements;
+
+    std::vector<int> firstH(n), secondH(n);
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<int> dis(params.lowerLabelRange, params.upperLabelRange);
+    for (int i = 0; i < n; i++) {
+      firstH[i]  = dis(gen);
+      secondH[i] = dis(gen);
+    }
+
+    rmm::device_uvector<int> first(n, stream);
+    rmm::device_uvector<int> second(n, stream);
+    raft::update_device(first.data(), firstH.data(), n, stream);
+    raft::update_device(second.data(), secondH.data(), n, stream);
+
+    computed = distribution_metrics(first.data(),
+                                    second.data(),
+                                    n,
+                                    params.lowerLabelRange,
+                                    params.upperLabelRange,
+                                    stream);
+
+    // references from the standalone metrics
+    ref_entropy_first =
+      entropy(first.data(), n, params.lowerLabelRange, params.upperLabelRange, stream);
+    ref_entropy_second =
+      entropy(second.data(), n, params.lowerLabelRange, params.upperLabelRange, stream);
+    ref_mutual_info = mutual_info_score(
+      first.data(), second.data(), n, params.lowerLabelRange, params.upperLabelRange, stream);
+
+    // host KL over the label marginals
+    int nClasses = params.upperLabelRange - params.lowerLabelRange + 1;
+    std::vector<double> pa(nClasses, 0.0), pb(nClasses, 0.0);
+    for (int i = 0; i < n; i++) {
+      pa[firstH[i] - params.lowerLabelRange] += 1.0 / n;
+      pb[secondH[i] - params.lowerLabelRange] += 1.0 / n;
+    }
+    ref_kl = 0.0;
+    for (int c = 0; c < nClasses; c++) {
+      if (pa[c]) { ref_kl += pa[c] * (std::log(pa[c]) - std::log(pb[c])); }
+    }
+  }
+
+  raft::handle_t handle;
+  distributionMetricsParam params;
+  distribution_metrics_t computed;
+  double ref_entropy_first, ref_entropy_second, ref_mutual_info, ref_kl;
+};
+
+const std::vector<distributionMetricsParam> inputs = {
+  {199, 1, 10, 1e-6}, {2000, 0, 99, 1e-6}, {100000, 10, 30, 1e-6}};
+
+TEST_P(distributionMetricsTest, Result)
+{
+  ASSERT_NEAR(computed.entropy_first, ref_entropy_first, params.tolerance);
+  ASSERT_NEAR(computed.entropy_second, ref_entropy_second, params.tolerance);
+  ASSERT_NEAR(computed.mutual_info, ref_mutual_info, params.tolerance);
+  ASSERT_NEAR(computed.kl_divergence, ref_kl, params.tolerance);
+}
+INSTANTIATE_TEST_CASE_P(distribution_metrics,
+                        distributionMetricsTest,
+                        ::testing::ValuesIn(inputs));
+
+}  // end namespace stats
+}  // end namespace raft
@@ -111,6 +111,19 @@ const std::vector<HistInputs> inputs = {
   {oneM + 2, 21, 2 * oneM, false, HistTypeGmem, 0, 2 * oneM, 1234ULL},
   {oneM + 2, 21, 2 * oneM, true, HistTypeGmem, 1000, 50, 1234ULL},
 
+  {oneM, 1, 2 * oneM, false, HistTypeGmemPriv, 0, 2 * oneM, 1234ULL},
+  {oneM, 1, 2 * oneM, true, HistTypeGmemPriv, 1000, 50, 1234ULL},
+  {oneM + 1, 1, 2 * oneM, false, HistTypeGmemPriv, 0, 2 * oneM, 1234ULL},
+  {oneM + 1, 1, 2 * oneM, true, HistTypeGmemPriv, 1000, 50, 1234ULL},
+  {oneM + 2, 1, 2 * oneM, false, HistTypeGmemPriv, 0, 2 * oneM, 1234ULL},
+  {oneM + 2, 1, 2 * oneM, true, HistTypeGmemPriv, 1000, 50, 1234ULL},
+  {oneM, 21, 2 * oneM, false, HistTypeGmemPriv, 0, 2 * oneM, 1234ULL},
+  {oneM, 21, 2 * oneM, true, HistTypeGmemPriv, 1000, 50, 1234ULL},
+  {oneM + 1, 21, 2 * oneM, false, HistTypeGmemPriv, 0, 2 * oneM, 1234ULL},
+  {oneM + 1, 21, 2 * oneM, true, HistTypeGmemPriv, 1000, 50, 1234ULL},
+  {oneM + 2, 21, 2 * oneM, false, HistTypeGmemPriv, 0, 2 * oneM, 1234ULL},
+  {oneM + 2, 21, 2 * oneM, true, HistTypeGmemPriv, 1000, 50, 1234ULL},
+
   {oneM, 1, 2 * oneK, false, HistTypeSmem, 0, 2 * oneK, 1234ULL},
   {oneM, 1, 2 * oneK, true, HistTypeSmem, 1000, 50, 1234ULL},
   {oneM + 1, 1, 2 * oneK, false, HistTypeSmem, 0, 2 * oneK, 1234ULL},
@@ -146,5 +146,90 @@ INSTANTIATE_TEST_SUITE_P(MeanVarTests, MeanVarTestF, ::testing::ValuesIn(inputsf
 
 INSTANTIATE_TEST_SUITE_P(MeanVarTests, MeanVarTestD, ::testing::ValuesIn(inputsd));
 
+template <typename T>
+class MeanVarIncTest : public ::testing::TestWithParam<MeanVarInputs<T>> {
+ public:
+  MeanVarIncTest()
+    : params(::testing::TestWithParam<MeanVarInputs<T>>::GetParam()),
+      stream(handle.get_stream()),
+      data(params.rows * params.cols, stream),
+      mean_act(params.cols, stream),
+      vars_act(params.cols, stream)
+  {
+  }
+
+ protected:
+  void SetUp() override
+  {
+    random::RngState r(params.seed);
+    normal(handle, r, data.data(), params.cols * params.rows, params.mean, params.stddev);
+    meanvar_state<T> state(params.cols, stream);
+    if (params.rowMajor) {
+      // feed the rows in three uneven batches
+      int chunk = (params.rows + 2) / 3;
+      for (int done = 0; done < params.rows; done += chunk) {
+        int n = std::min(chunk, params.rows - done);
+        meanvar_update(state, data.data() + size_t(done) * params.cols, n, true, stream);
+      }
+    } else {
+      // a row slice of a col-major matrix is not contiguous; feed it whole
+      meanvar_update(state, data.data(), params.rows, false, stream);
+    }
+    meanvar_finalize(state, mean_act.data(), vars_act.data(), params.sample, stream);
+    RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+  }
+
+ protected:
+  raft::handle_t handle;
+  cudaStream_t stream;
+
+  MeanVarInputs<T> params;
+  rmm::device_uvector<T> data, mean_act, vars_act;
+};
+
+const std::vector<MeanVarInputs<float>> inputsf_inc = {
+  {1.f, 2.f, 1024, 32, true, true, 1234ULL},
+  {1.f, 2.f, 1024, 256, true, true, 1234ULL},
+  {-1.f, 2.f, 700, 13, false, true, 1234ULL},
+  {10.f, 2.f, 500000, 811, false, true, 1234ULL},
+  {1.f, 2.f, 1024, 32, true, false, 1234ULL},
+  {-1.f, 2.f, 1024, 256, false, false, 1234ULL}};
+
+const std::vector<MeanVarInputs<double>> inputsd_inc = {
+  {1.0, 2.0, 1024, 32, true, true, 1234ULL},
+  {1.0, 2.0, 1024, 256, true, true, 1234ULL},
+  {-1.0, 2.0, 1024, 32, false, false, 1234ULL},
+  {-1.0, 2.0, 1024, 256, false, false, 1234ULL}};
+
+typedef MeanVarIncTest<float> MeanVarIncTestF;
+TEST_P(MeanVarIncTestF, Result)
+{
+  ASSERT_TRUE(devArrMatch(
+    params.mean, mean_act.data(), params.cols, CompareApprox<float>(params.mean_tol()), stream));
+
+  ASSERT_TRUE(devArrMatch(params.stddev * params.stddev,
+                          vars_act.data(),
+                          params.cols,
+                          CompareApproxNoScaling<float>(params.var_tol()),
+                          stream));
+}
+
+typedef MeanVarIncTest<double> MeanVarIncTestD;
+TEST_P(MeanVarIncTestD, Result)
+{
+  ASSERT_TRUE(devArrMatch(
+    params.mean, mean_act.data(), params.cols, CompareApprox<double>(params.mean_tol()), stream));
+
+  ASSERT_TRUE(devArrMatch(params.stddev * params.stddev,
+                          vars_act.data(),
+                          params.cols,
+                          CompareApproxNoScaling<double>(params.var_tol()),
+                          stream));
+}
+
+INSTANTIATE_TEST_SUITE_P(MeanVarTests, MeanVarIncTestF, ::testing::ValuesIn(inputsf_inc));
+
+INSTANTIATE_TEST_SUITE_P(MeanVarTests, MeanVarIncTestD, ::testing::ValuesIn(inputsd_inc));
+
 }  // end namespace stats
 }  // end namespace raft
@@ -123,6 +123,13 @@ class mutualInfoTest : public ::testing::TestWithParam<mutualInfoParam> {
                                                         lowerLabelRange,
                                                         upperLabelRange,
                                                         stream);
+
+    computedmutualInfoSparse = raft::stats::mutual_info_score_sparse(firstClusterArray.data(),
+                                                                     secondClusterArray.data(),
+                                                                     nElements,
+                                                                     lowerLabelRange,
+                                                                     upperLabelRange,
+                                                                     stream);
   }
 
   // the destructor
@@ -132,8 +139,9 @@ class mutualInfoTest : public ::testing::TestWithParam<mutualInfoParam> {
   mutualInfoParam params;
   T lowerLabelRange, upperLabelRange;
   int nElements             = 0;
-  double truthmutualInfo    = 0;
-  double computedmutualInfo = 0;
+  double truthmutualInfo          = 0;
+  double computedmutualInfo       = 0;
+  double computedmutualInfoSparse = 0;
   cudaStream_t stream       = 0;
 };
 
@@ -157,6 +165,10 @@ TEST_P(mutualInfoTestClass, Result)
 {
   ASSERT_NEAR(computedmutualInfo, truthmutualInfo, params.tolerance);
 }
+TEST_P(mutualInfoTestClass, SparseResult)
+{
+  ASSERT_NEAR(computedmutualInfoSparse, truthmutualInfo, params.tolerance);
+}
 INSTANTIATE_TEST_CASE_P(mutualInfo, mutualInfoTestClass, ::testing::ValuesIn(inputs));
 
 }  // end namespace stats
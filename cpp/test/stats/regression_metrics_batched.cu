@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <test_utils.h>
+
+#include <raft/stats/regression_metrics.cuh>
+
+#include <raft/cudart_utils.h>
+#include <raft/handle.hpp>
+#include <rmm/device_uvector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace raft {
+namespace stats {
+
+template <typename T>
+void naive_reg_metrics(T* h_mae,
+                       T* h_mse,
+                       T* h_r2,
+                       const T* h_y,
+                       const T* h_y_hat,
+                       int batch_size,
+                       int n_samples)
+{
+  for (int bid = 0; bid < batch_size; bid++) {
+    const T* y     = h_y + bid * n_samples;
+    const T* y_hat = h_y_hat + bid * n_samples;
+    T sum_abs = 0, sum_sq = 0, mean = 0;
+    for (int i = 0; i < n_samples; i++) {
+      T diff = y[i] - y_hat[i];
+      sum_abs += std::abs(diff);
+      sum_sq += diff * diff;
+      mean += y[i];
+    }
+    mean /= n_samples;
+    T ssto = 0;
+    for (int i = 0; i < n_samples; i++) {
+      ssto += (y[i] - mean) * (y[i] - mean);
+    }
+    h_mae[bid] = sum_abs / n_samples;
+    h_mse[bid] = sum_sq / n_samples;
+    h_r2[bid]  = T(1) - sum_sq / ssto;
+  }
+}
+
+template <typename T>
+struct BatchedRegMetricsInputs {
+  int batch_size;
+  int n_samples;
+  T tolerance;
+};
+
+template <typename T>
+class BatchedRegMetricsTest : public ::testing::TestWithParam<BatchedRegMetricsInputs<T>> {
+ public:
+  BatchedRegMetricsTest()
+    : params(::testing::TestWithParam<BatchedRegMetricsInputs<T>>::GetParam()),
+      stream(handle.get_stream()),
+      mae_d(params.batch_size, stream),
+      mse_d(params.batch_size, stream),
+      r2_d(params.batch_size, stream)
+  {
+  }
+
+ protected:
+  void SetUp() override
+  {
+    int len = params.batch_size * params.n_samples;
+    std::vector<T> y_h(len), y_hat_h(len);
+    mae_h.resize(params.batch_size);
+    mse_h.resize(params.batch_size);
+    r2_h.resize(params.batch_size);
+    rmm::device_uvector<T> y_d(len, stream);
+    rmm::device_uvector<T> y_hat_d(len, stream);
+
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_real_distribution<T> udis(-1.0, 1.0);
+    for (int i = 0; i < len; i++) {
+      y_h[i]     = udis(gen);
+      y_hat_h[i] = y_h[i] + T(0.1) * udis(gen);
+    }
+
+    raft::update_device(y_d.data(), y_h.data(), len, stream);
+    raft::update_device(y_hat_d.data(), y_hat_h.data(), len, stream);
+
+    regression_metrics_batched(y_d.data(),
+                               y_hat_d.data(),
+                               params.batch_size,
+                               params.n_samples,
+                               mae_d.data(),
+                               mse_d.data(),
+                               r2_d.data(),
+                               stream);
+
+    naive_reg_metrics(mae_h.data(),
+                      mse_h.data(),
+                      r2_h.data(),
+                      y_h.data(),
+                      y_hat_h.data(),
+                      params.batch_size,
+                      params.n_samples);
+
+    RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+  }
+
+ protected:
+  raft::handle_t handle;
+  cudaStream_t stream = 0;
+  BatchedRegMetricsInputs<T> params;
+  rmm::device_uvector<T> mae_d, mse_d, r2_d;
+  std::vector<T> mae_h, mse_h, r2_h;
+};
+
+const std::vector<BatchedRegMetricsInputs<double>> inputsd = {
+  {1, 52, 1e-6}, {10, 100, 1e-6}, {67, 350, 1e-6}, {1000, 33, 1e-6}};
+
+const std::vector<BatchedRegMetricsInputs<float>> inputsf = {
+  {1, 52, 1e-3}, {10, 100, 1e-3}, {67, 350, 1e-3}, {1000, 33, 1e-3}};
+
+using BatchedRegMetricsTestD = BatchedRegMetricsTest<double>;
+using BatchedRegMetricsTestF = BatchedRegMetricsTest<float>;
+TEST_P(BatchedRegMetricsTestD, Result)
+{
+  ASSERT_TRUE(devArrMatchHost(mae_h.data(),
+                              mae_d.data(),
+                              params.batch_size,
+                              raft::CompareApprox<double>(params.tolerance),
+                              stream));
+  ASSERT_TRUE(devArrMatchHost(mse_h.data(),
+                              mse_d.data(),
+                              params.batch_size,
+                              raft::CompareApprox<double>(params.tolerance),
+                              stream));
+  ASSERT_TRUE(devArrMatchHost(r2_h.data(),
+                              r2_d.data(),
+                              params.batch_size,
+                              raft::CompareApprox<double>(params.tolerance),
+                              stream));
+}
+TEST_P(BatchedRegMetricsTestF, Result)
+{
+  ASSERT_TRUE(devArrMatchHost(mae_h.data(),
+                              mae_d.data(),
+                              params.batch_size,
+                              raft::CompareApprox<float>(params.tolerance),
+                              stream));
+  ASSERT_TRUE(devArrMatchHost(mse_h.data(),
+                              mse_d.data(),
+                              params.batch_size,
+                              raft::CompareApprox<float>(params.tolerance),
+                              stream));
+  ASSERT_TRUE(devArrMatchHost(r2_h.data(),
+                              r2_d.data(),
+                              params.batch_size,
+                              raft::CompareApprox<float>(params.tolerance),
+                              stream));
+}
+
+INSTANTIATE_TEST_CASE_P(BatchedRegMetricsTests, BatchedRegMetricsTestD, ::testing::ValuesIn(inputsd));
+INSTANTIATE_TEST_CASE_P(BatchedRegMetricsTests, BatchedRegMetricsTestF, ::testing::ValuesIn(inputsf));
+
+}  // namespace stats
+}  // namespace raft
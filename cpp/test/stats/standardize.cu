@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils.h"
+#include <gtest/gtest.h>
+#include <raft/cudart_utils.h>
+#include <raft/random/rng.cuh>
+#include <raft/stats/standardize.cuh>
+
+#include <cmath>
+#include <vector>
+
+namespace raft {
+namespace stats {
+
+template <typename T>
+struct StandardizeInputs {
+  T tolerance;
+  int rows, cols;
+  bool weighted, sample, rowMajor;
+  unsigned long long int seed;
+};
+
+template <typename T>
+::std::ostream& operator<<(::std::ostream& os, const StandardizeInputs<T>& ps)
+{
+  return os << "rows: " << ps.rows << "; cols: " << ps.cols
+            << (ps.weighted ? "; weighted" : "; unweighted")
+            << (ps.rowMajor ? "; row-major" : "; col-major");
+}
+
+template <typename T>
+class StandardizeTest : public ::testing::TestWithParam<StandardizeInputs<T>> {
+ public:
+  StandardizeTest()
+    : params(::testing::TestWithParam<StandardizeInputs<T>>::GetParam()),
+      stream(handle.get_stream()),
+      data(params.rows * params.cols, stream),
+      weights(params.rows, stream),
+      out_act(params.rows * params.cols, stream),
+      out_exp(params.rows * params.cols, stream),
+      mu_act(params.cols, stream),
+      std_act(params.cols, stream)
+  {
+  }
+
+ protected:
+  void SetUp() override
+  {
+    int rows = params.rows, cols = params.cols, len = rows * cols;
+    random::RngState r(params.seed);
+    uniform(handle, r, data.data(), len, T(-1.0), T(1.0));
+    uniform(handle, r, weights.data(), rows, T(0.5), T(2.0));
+
+    std::vector<T> h_data(len), h_weights(rows), h_out(len);
+    raft::update_host(h_data.data(), data.data(), len, stream);
+    raft::update_host(h_weights.data(), weights.data(), rows, stream);
+    RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+    if (!params.weighted) { std::fill(h_weights.begin(), h_weights.end(), T(1.0)); }
+
+    // host reference: weighted column stats, then center+scale
+    auto at = [&](int i, int j) {
+      return params.rowMajor ? h_data[i * cols + j] : h_data[j * rows + i];
+    };
+    for (int j = 0; j < cols; j++) {
+      T ws = T(0), mu = T(0);
+      for (int i = 0; i < rows; i++) {
+        ws += h_weights[i];
+        mu += h_weights[i] * at(i, j);
+      }
+      mu /= ws;
+      T var = T(0);
+      for (int i = 0; i < rows; i++) {
+        var += h_weights[i] * (at(i, j) - mu) * (at(i, j) - mu);
+      }
+      var /= params.sample ? ws - T(1.0) : ws;
+      T sigma = std::sqrt(var);
+      for (int i = 0; i < rows; i++) {
+        auto idx   = params.rowMajor ? i * cols + j : j * rows + i;
+        h_out[idx] = (at(i, j) - mu) / sigma;
+      }
+    }
+    raft::update_device(out_exp.data(), h_out.data(), len, stream);
+
+    standardize(out_act.data(),
+                data.data(),
+                mu_act.data(),
+                std_act.data(),
+                cols,
+                rows,
+                params.sample,
+                params.rowMajor,
+                stream,
+                params.weighted ? weights.data() : nullptr);
+    RAFT_CUDA_TRY(cudaStreamSynchronize(stream));
+  }
+
+ protected:
+  raft::handle_t handle;
+  cudaStream_t stream;
+
+  StandardizeInputs<T> params;
+  rmm::device_uvector<T> data, weights, out_act, out_exp, mu_act, std_act;
+};
+
+const std::vector<StandardizeInputs<float>> inputsf = {
+  {0.002f, 1024, 32, false, true, true, 1234ULL},
+  {0.002f, 1024, 64, false, false, true, 1234ULL},
+  {0.002f, 1024, 32, false, true, false, 1234ULL},
+  {0.002f, 1024, 128, true, true, true, 1234ULL},
+  {0.002f, 1024, 64, true, false, false, 1234ULL},
+  {0.002f, 700, 13, true, true, true, 1234ULL}};
+
+const std::vector<StandardizeInputs<double>> inputsd = {
+  {1e-8, 1024, 32, false, true, true, 1234ULL},
+  {1e-8, 1024, 64, false, false, true, 1234ULL},
+  {1e-8, 1024, 32, false, true, false, 1234ULL},
+  {1e-8, 1024, 128, true, true, true, 1234ULL},
+  {1e-8, 1024, 64, true, false, false, 1234ULL},
+  {1e-8, 700, 13, true, true, true, 1234ULL}};
+
+typedef StandardizeTest<float> StandardizeTestF;
+TEST_P(StandardizeTestF, Result)
+{
+  ASSERT_TRUE(devArrMatch(out_exp.data(),
+                          out_act.data(),
+                          params.rows * params.cols,
+                          CompareApprox<float>(params.tolerance)));
+}
+
+typedef StandardizeTest<double> StandardizeTestD;
+TEST_P(StandardizeTestD, Result)
+{
+  ASSERT_TRUE(devArrMatch(out_exp.data(),
+                          out_act.data(),
+                          params.rows * params.cols,
+                          CompareApprox<double>(params.tolerance)));
+}
+
+INSTANTIATE_TEST_SUITE_P(StandardizeTests, StandardizeTestF, ::testing::ValuesIn(inputsf));
+INSTANTIATE_TEST_SUITE_P(StandardizeTests, StandardizeTestD, ::testing::ValuesIn(inputsd));
+
+}  // namespace stats
+}  // namespace raft
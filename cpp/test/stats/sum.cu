@@ -25,6 +25,8 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 namespace raft {
 namespace stats {
 
@@ -104,5 +106,77 @@ INSTANTIATE_TEST_CASE_P(SumTests, SumTestF, ::testing::ValuesIn(inputsf));
 
 INSTANTIATE_TEST_CASE_P(SumTests, SumTestD, ::testing::ValuesIn(inputsd));
 
+template <typename T>
+class SumKahanTest : public ::testing::TestWithParam<SumInputs<T>> {
+ public:
+  SumKahanTest()
+    : params(::testing::TestWithParam<SumInputs<T>>::GetParam()),
+      stream(handle.get_stream()),
+      rows(params.rows),
+      cols(params.cols),
+      data(rows * cols, stream),
+      sum_act_cm(cols, stream),
+      sum_act_rm(cols, stream)
+  {
+  }
+
+ protected:
+  void SetUp() override
+  {
+    int len = rows * cols;
+
+    // 0.1 is not exactly representable, so a long plain fp32 accumulation
+    // drifts while the compensated one must not
+    std::vector<T> data_h(len, T(0.1));
+    raft::update_device(data.data(), data_h.data(), len, stream);
+    sumKahan(sum_act_cm.data(), data.data(), cols, rows, false, stream);
+    sumKahan(sum_act_rm.data(), data.data(), cols, rows, true, stream);
+    handle.sync_stream(stream);
+  }
+
+ protected:
+  raft::handle_t handle;
+  cudaStream_t stream;
+
+  SumInputs<T> params;
+  int rows, cols;
+  rmm::device_uvector<T> data, sum_act_cm, sum_act_rm;
+};
+
+// odd column counts exercise the non-vectorized fallback of the row-major path
+const std::vector<SumInputs<float>> inputsf_kahan = {{0.0001f, 1024, 32, 1234ULL},
+                                                     {0.0001f, 1024, 256, 1234ULL},
+                                                     {0.0001f, 500000, 34, 1234ULL},
+                                                     {0.0001f, 500000, 37, 1234ULL}};
+
+const std::vector<SumInputs<double>> inputsd_kahan = {{0.0000001, 1024, 32, 1234ULL},
+                                                      {0.0000001, 1024, 256, 1234ULL},
+                                                      {0.0000001, 500000, 34, 1234ULL},
+                                                      {0.0000001, 500000, 37, 1234ULL}};
+
+typedef SumKahanTest<float> SumKahanTestF;
+TEST_P(SumKahanTestF, Result)
+{
+  float expected = float(double(params.rows) * 0.1);
+  ASSERT_TRUE(raft::devArrMatch(
+    expected, sum_act_cm.data(), params.cols, raft::CompareApprox<float>(params.tolerance)));
+  ASSERT_TRUE(raft::devArrMatch(
+    expected, sum_act_rm.data(), params.cols, raft::CompareApprox<float>(params.tolerance)));
+}
+
+typedef SumKahanTest<double> SumKahanTestD;
+TEST_P(SumKahanTestD, Result)
+{
+  double expected = double(params.rows) * 0.1;
+  ASSERT_TRUE(raft::devArrMatch(
+    expected, sum_act_cm.data(), params.cols, raft::CompareApprox<double>(params.tolerance)));
+  ASSERT_TRUE(raft::devArrMatch(
+    expected, sum_act_rm.data(), params.cols, raft::CompareApprox<double>(params.tolerance)));
+}
+
+INSTANTIATE_TEST_CASE_P(SumTests, SumKahanTestF, ::testing::ValuesIn(inputsf_kahan));
+
+INSTANTIATE_TEST_CASE_P(SumTests, SumKahanTestD, ::testing::ValuesIn(inputsd_kahan));
+
 }  // end namespace stats
 }  // end namespace raft
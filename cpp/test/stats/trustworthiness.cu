@@ -324,6 +324,14 @@ class TrustworthinessScoreTest : public ::testing::Test {
     // euclidean test
     score = trustworthiness_score<float, raft::distance::DistanceType::L2SqrtUnexpanded>(
       handle, d_X.data(), d_X_embedded.data(), 50, 30, 8, 5);
+
+    // the precomputed path must reproduce the one-shot score exactly
+    rmm::device_uvector<int> lookup_table(50 * 50, stream);
+    trustworthiness_precompute<float, raft::distance::DistanceType::L2SqrtUnexpanded>(
+      handle, d_X.data(), 50, 30, lookup_table.data());
+    score_precomputed =
+      trustworthiness_score_precomputed<float, raft::distance::DistanceType::L2SqrtUnexpanded>(
+        handle, lookup_table.data(), d_X_embedded.data(), 50, 8, 5);
   }
 
   void SetUp() override { basicTest(); }
@@ -332,9 +340,14 @@ class TrustworthinessScoreTest : public ::testing::Test {
 
  protected:
   double score;
+  double score_precomputed;
 };
 
 typedef TrustworthinessScoreTest TrustworthinessScoreTestF;
 TEST_F(TrustworthinessScoreTestF, Result) { ASSERT_TRUE(0.9375 < score && score < 0.9379); }
+TEST_F(TrustworthinessScoreTestF, PrecomputedResult)
+{
+  ASSERT_NEAR(score_precomputed, score, 1e-9);
+}
 };  // namespace stats
 };  // namespace raft
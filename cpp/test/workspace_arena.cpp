@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2022, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <raft/handle.hpp>
+
+namespace raft {
+
+TEST(Raft, WorkspaceArenaGrowAndReuse)
+{
+  handle_t h;
+  auto stream = h.get_stream();
+  auto& arena = h.get_workspace_arena();
+
+  // first allocation grows the backing buffer
+  auto* p0 = h.get_workspace(1 << 20, stream);
+  ASSERT_NE(nullptr, p0);
+  ASSERT_GE(arena.capacity(), static_cast<std::size_t>(1 << 20));
+  h.return_workspace(p0, 1 << 20, stream);
+
+  // same-size allocation is served from the retained buffer
+  auto* p1 = h.get_workspace(1 << 20, stream);
+  ASSERT_EQ(p0, p1);
+  ASSERT_GE(arena.capacity(), static_cast<std::size_t>(1 << 20));
+  h.return_workspace(p1, 1 << 20, stream);
+}
+
+TEST(Raft, WorkspaceArenaStacked)
+{
+  handle_t h;
+  auto stream = h.get_stream();
+  auto& arena = h.get_workspace_arena();
+
+  {
+    workspace_chunk outer(arena, 4096, stream);
+    workspace_chunk inner(arena, 4096, stream);
+    ASSERT_NE(outer.data(), inner.data());
+    // sub-allocations keep the arena's alignment guarantee
+    ASSERT_EQ(0u, reinterpret_cast<std::uintptr_t>(outer.data()) % workspace_arena::alignment);
+    ASSERT_EQ(0u, reinterpret_cast<std::uintptr_t>(inner.data()) % workspace_arena::alignment);
+  }
+
+  // overflow path: request more while a chunk is live than the buffer holds
+  {
+    workspace_chunk small(arena, 256, stream);
+    workspace_chunk big(arena, arena.capacity() + 4096, stream);
+    ASSERT_NE(nullptr, big.data());
+  }
+
+  arena.release(stream);
+  ASSERT_EQ(0u, arena.capacity());
+}
+
+}  // namespace raft
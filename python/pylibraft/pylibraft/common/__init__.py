@@ -13,3 +13,6 @@
 # limitations under the License.
 #
 
+
+from .cuda import Stream
+from .handle import Handle
@@ -0,0 +1,155 @@
+#
+# Copyright (c) 2022, NVIDIA CORPORATION.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# cython: profile=False
+# distutils: language = c++
+# cython: embedsignature = True
+# cython: language_level = 3
+
+import numpy as np
+
+from libc.stdint cimport uintptr_t
+from cython.operator cimport dereference as deref
+
+from libcpp cimport bool
+from pylibraft.common import Handle
+from pylibraft.common.handle cimport handle_t
+
+
+cdef extern from "raft_nn/select_k.hpp" \
+        namespace "raft::spatial::knn::runtime":
+
+    cdef void c_select_k "raft::spatial::knn::runtime::select_k" (
+        const handle_t &handle,
+        const float *in_keys,
+        const int *in_values,
+        size_t n_inputs,
+        size_t input_len,
+        float *out_keys,
+        int *out_values,
+        bool select_min,
+        int k)
+
+    cdef void c_select_k "raft::spatial::knn::runtime::select_k" (
+        const handle_t &handle,
+        const double *in_keys,
+        const int *in_values,
+        size_t n_inputs,
+        size_t input_len,
+        double *out_keys,
+        int *out_values,
+        bool select_min,
+        int k)
+
+
+def select_k(in_keys, out_keys, out_values, k, select_min=True, handle=None):
+    """
+    Select the k smallest (or largest) keys in each row of a row-major
+    matrix of keys, writing the selected keys and their source column
+    indices to the outputs.
+
+    Parameters
+    ----------
+
+    in_keys : CUDA array interface compliant matrix shape (n_rows, n_cols)
+    out_keys : Writable CUDA array interface matrix shape (n_rows, k)
+    out_values : Writable CUDA array interface matrix of int32,
+        shape (n_rows, k)
+    k : number of elements to select per row
+    select_min : select the smallest k when True, the largest otherwise
+    handle : Optional pylibraft.common.Handle to reuse streams across
+        calls. When omitted a handle is created and synchronized before
+        this function returns.
+
+    Examples
+    --------
+
+    .. code-block:: python
+
+        import cupy as cp
+
+        from pylibraft.common import Handle
+        from pylibraft.neighbors import select_k
+
+        n_rows, n_cols, k = 100, 1024, 32
+
+        keys = cp.random.random_sample((n_rows, n_cols),
+                                       dtype=cp.float32)
+        out_keys = cp.empty((n_rows, k), dtype=cp.float32)
+        out_values = cp.empty((n_rows, k), dtype=cp.int32)
+
+        handle = Handle()
+        select_k(keys, out_keys, out_values, k, handle=handle)
+
+        # the call is enqueued on the handle's stream; sync before
+        # consuming the outputs on the host
+        handle.sync()
+   """
+
+    keys_cai = in_keys.__cuda_array_interface__
+    out_keys_cai = out_keys.__cuda_array_interface__
+    out_values_cai = out_values.__cuda_array_interface__
+
+    n_rows = keys_cai["shape"][0]
+    n_cols = keys_cai["shape"][1]
+
+    if out_keys_cai["shape"] != (n_rows, k):
+        raise ValueError("out_keys must have shape (n_rows, k)")
+    if out_values_cai["shape"] != (n_rows, k):
+        raise ValueError("out_values must have shape (n_rows, k)")
+
+    keys_dt = np.dtype(keys_cai["typestr"])
+    out_keys_dt = np.dtype(out_keys_cai["typestr"])
+    out_values_dt = np.dtype(out_values_cai["typestr"])
+
+    if keys_dt != out_keys_dt:
+        raise ValueError("in_keys and out_keys must have the same dtype")
+    if out_values_dt != np.int32:
+        raise ValueError("out_values must be int32")
+
+    keys_ptr = <uintptr_t>keys_cai["data"][0]
+    out_keys_ptr = <uintptr_t>out_keys_cai["data"][0]
+    out_values_ptr = <uintptr_t>out_values_cai["data"][0]
+
+    sync_handle = handle is None
+    handle = handle if handle is not None else Handle()
+
+    cdef handle_t *h = <handle_t*><size_t>handle.getHandle()
+
+    if keys_dt == np.float32:
+        c_select_k(deref(h),
+                   <const float*> keys_ptr,
+                   <const int*> NULL,
+                   <size_t>n_rows,
+                   <size_t>n_cols,
+                   <float*> out_keys_ptr,
+                   <int*> out_values_ptr,
+                   <bool>select_min,
+                   <int>k)
+    elif keys_dt == np.float64:
+        c_select_k(deref(h),
+                   <const double*> keys_ptr,
+                   <const int*> NULL,
+                   <size_t>n_rows,
+                   <size_t>n_cols,
+                   <double*> out_keys_ptr,
+                   <int*> out_values_ptr,
+                   <bool>select_min,
+                   <int>k)
+    else:
+        raise ValueError("dtype %s not supported" % keys_dt)
+
+    if sync_handle:
+        handle.sync()
@@ -0,0 +1,81 @@
+# Copyright (c) 2022, NVIDIA CORPORATION.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import pytest
+import numpy as np
+
+import rmm
+
+from pylibraft.common import Handle
+from pylibraft.neighbors import select_k
+
+
+class TestDeviceBuffer:
+
+    def __init__(self, ndarray, order):
+        self.ndarray_ = ndarray
+        self.device_buffer_ = \
+            rmm.DeviceBuffer.to_device(ndarray.ravel(order=order).tobytes())
+
+    @property
+    def __cuda_array_interface__(self):
+        device_cai = self.device_buffer_.__cuda_array_interface__
+        host_cai = self.ndarray_.__array_interface__.copy()
+        host_cai["data"] = (device_cai["data"][0], device_cai["data"][1])
+
+        return host_cai
+
+    def copy_to_host(self):
+        return np.frombuffer(self.device_buffer_.tobytes(),
+                             dtype=self.ndarray_.dtype,
+                             like=self.ndarray_)\
+            .astype(self.ndarray_.dtype)\
+            .reshape(self.ndarray_.shape)
+
+
+@pytest.mark.parametrize("n_rows", [32])
+@pytest.mark.parametrize("n_cols", [512])
+@pytest.mark.parametrize("k", [1, 16])
+@pytest.mark.parametrize("select_min", [True, False])
+@pytest.mark.parametrize("use_handle", [True, False])
+@pytest.mark.parametrize("dtype", [np.float32, np.float64])
+def test_select_k(n_rows, n_cols, k, select_min, use_handle, dtype):
+    keys = np.random.random_sample((n_rows, n_cols)).astype(dtype)
+
+    out_keys = np.zeros((n_rows, k), dtype=dtype)
+    out_values = np.zeros((n_rows, k), dtype=np.int32)
+
+    keys_device = TestDeviceBuffer(keys, "C")
+    out_keys_device = TestDeviceBuffer(out_keys, "C")
+    out_values_device = TestDeviceBuffer(out_values, "C")
+
+    handle = Handle() if use_handle else None
+    select_k(keys_device, out_keys_device, out_values_device, k,
+             select_min=select_min, handle=handle)
+    if handle is not None:
+        handle.sync()
+
+    actual_keys = out_keys_device.copy_to_host()
+    actual_values = out_values_device.copy_to_host()
+
+    order = np.argsort(keys if select_min else -keys, axis=1)
+    expected_keys = np.take_along_axis(keys, order, axis=1)[:, :k]
+
+    assert np.allclose(np.sort(expected_keys, axis=1),
+                       np.sort(actual_keys, axis=1), rtol=1e-6)
+
+    # the returned indices must point back at the returned keys
+    gathered = np.take_along_axis(keys, actual_values, axis=1)
+    assert np.allclose(gathered, actual_keys, rtol=1e-6)